@@ -86,9 +86,11 @@ class PyROOTApplication(object):
             self._inputhook_config()
         else:
             # Python in script mode, start a separate thread for the event processing
+            # The events are not processed while the main thread runs C++ code without the GIL
+            from ROOT.pythonization._releasegil import released_gil_calls
             def _process_root_events(self):
                 while self.keep_polling:
-                    gSystem.ProcessEvents()
+                    released_gil_calls.run_if_idle(gSystem.ProcessEvents)
                     time.sleep(0.01)
             import threading
             self.keep_polling = True # Used to shut down the thread safely at teardown time
@@ -9,6 +9,7 @@ from cppyy import cppdef
 from libROOTPythonizations import gROOT, CreateBufferFromAddress
 
 from ._application import PyROOTApplication
+from ._vectorize import _Vectorize
 _numba_pyversion = (2, 7, 5)
 if sys.version_info[:3] > _numba_pyversion:
     # Python <= 2.7.5 cannot use exec in an inner function
@@ -247,6 +248,7 @@ class ROOTFacade(types.ModuleType):
         try:
             from libROOTPythonizations import AsRVec
             ns.AsRVec = AsRVec
+            ns.Vectorize = staticmethod(_Vectorize)
         except:
             raise Exception('Failed to pythonize the namespace VecOps')
         del type(self).VecOps
@@ -259,6 +261,9 @@ class ROOTFacade(types.ModuleType):
         try:
             from libROOTPythonizations import MakeNumpyDataFrame
             ns.MakeNumpyDataFrame = MakeNumpyDataFrame
+            # Run the event loops without holding the GIL
+            from .pythonization._releasegil import _release_gil
+            ns.RunGraphs = _release_gil(ns.RunGraphs)
         except:
             raise Exception('Failed to pythonize the namespace RDF')
         del type(self).RDF
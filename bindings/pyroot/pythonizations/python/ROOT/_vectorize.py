@@ -0,0 +1,216 @@
+from cppyy import gbl as gbl_namespace
+from cppyy import addressof
+import re
+
+
+# Map of the supported C++ fundamental types to numpy dtypes
+_dtypes = {
+        'float': 'float32',
+        'double': 'float64',
+        'short': 'int16',
+        'unsigned short': 'uint16',
+        'int': 'int32',
+        'unsigned int': 'uint32',
+        'long': 'int64',
+        'unsigned long': 'uint64',
+        'long long': 'int64',
+        'unsigned long long': 'uint64'
+        }
+
+# Keywords which can end the name of a fundamental type
+_type_keywords = ['char', 'short', 'int', 'long', 'float', 'double', 'bool', 'unsigned', 'signed', 'const']
+
+# Cache of the jitted loop wrappers, indexed by their C++ code
+_wrappers = {}
+
+
+def _normalize_type(t):
+    '''
+    Strip qualifiers and references from a C++ typename
+    '''
+    t = t.strip()
+    t = re.sub(r'\bconst\b', '', t).replace('&', '')
+    t = re.sub(r'\bsigned\s+(char)\b', r'\1', t)
+    t = re.sub(r'\b(long long|long|short|unsigned)\s+int\b', r'\1', t)
+    return ' '.join(t.split())
+
+
+def _split_arguments(args):
+    '''
+    Split the argument list of a C++ signature at the top-level commas
+    '''
+    result = []
+    depth = 0
+    current = ''
+    for c in args:
+        if c in '<([':
+            depth += 1
+        elif c in '>)]':
+            depth -= 1
+        if c == ',' and depth == 0:
+            result.append(current)
+            current = ''
+        else:
+            current += c
+    if current.strip():
+        result.append(current)
+    return result
+
+
+def _parse_signature(func):
+    '''
+    Get full name, input types and return type of a cppyy function from its signature
+
+    Only functions with a single overload can be inspected, since the overload to be
+    used in the loop has to be known before the wrapper is jitted.
+    '''
+    doc = getattr(func, '__doc__', None)
+    signatures = [s for s in (doc or '').split('\n') if s.strip()]
+    if len(signatures) != 1:
+        raise Exception(
+                'Cannot infer the signature of {}, which has {} overloads. Please give the input and return types.'.format(
+                    getattr(func, '__name__', func), len(signatures)))
+    signature = signatures[0].replace('operator()', 'operator_call')
+    m = re.match(r'\s*(?:static\s+)?(.*?)\s*([\w:<>,]*\w)\((.*)\)', signature)
+    if not m:
+        raise Exception('Failed to parse the signature {}'.format(signatures[0]))
+    return_type, name, args = m.groups()
+    input_types = []
+    for arg in _split_arguments(args):
+        words = arg.split('=')[0].split()
+        # drop the name of the argument if given
+        if len(words) > 1 and re.match(r'^\w+$', words[-1]) and not words[-1] in _type_keywords:
+            words = words[:-1]
+        input_types.append(' '.join(words))
+    return name, input_types, return_type
+
+
+def _Vectorize(func, input_types=None, return_type=None):
+    '''
+    Create a ufunc-like Python callable evaluating a C++ function over numpy arrays
+
+    Calling a C++ function from Python with cppyy converts the arguments and the return value
+    of each single call, which dominates the runtime if the function is evaluated for many
+    values. This function jits with cling a loop over contiguous buffers calling the given
+    C++ function and returns a Python callable, which passes numpy arrays in a single call
+    to the loop. The C++ loop is executed without holding the GIL, so that other Python
+    threads can progress during the evaluation.
+
+    The function can be given as
+      - the name of a C++ function or of any other C++ callable, e.g. "ROOT::Math::gaussian_pdf"
+        or a lambda "[](double x) { return x * x; }",
+      - a cppyy function, e.g. ROOT.TMath.Erf,
+      - a bound method of a C++ object, e.g. f.Eval for a TF1 f,
+      - a C++ object with a call operator.
+
+    The input types and the return type can be omitted if the function is given as a cppyy
+    function or method with a single overload, in which case they are taken from its signature.
+    Supported are the fundamental arithmetic types. Note that default arguments are part of the
+    signature, so that they have to be passed as well, e.g. as scalars.
+
+    The returned callable takes one argument per input type. Each argument can be a numpy array
+    or any object convertible to one, which is converted to the dtype of the C++ type if needed.
+    All arguments with more than one element must have the same shape, while scalars and arrays
+    with a single element are broadcast. The result is a numpy array with this shape. The jitted
+    C++ code is accessible by the attribute __cpp_wrapper__.
+
+    ~~~{.py}
+    import ROOT, numpy as np
+    pdf = ROOT.VecOps.Vectorize('ROOT::Math::gaussian_pdf', ['double', 'double', 'double'], 'double')
+    y = pdf(np.linspace(-5, 5, 10000000), 1.0, 0.0)
+    ~~~
+    '''
+    try:
+        import numpy as np
+    except:
+        raise Exception('Failed to import numpy')
+
+    # Find the C++ expression to be called in the loop
+    self_obj = None
+    self_type = None
+    if isinstance(func, str):
+        callee = '({})'.format(func)
+    else:
+        self_obj = getattr(func, '__self__', None)
+        if self_obj is None:
+            self_obj = getattr(func, 'im_self', None)
+        if self_obj is not None:
+            # bound method of a C++ object
+            self_type = type(self_obj).__cpp_name__
+            callee = 'obj.{}'.format(func.__name__)
+        elif hasattr(type(func), '__cpp_name__'):
+            # C++ object with a call operator
+            self_obj = func
+            self_type = type(func).__cpp_name__
+            callee = 'obj'
+        else:
+            # free function, the full name is taken from its signature
+            callee = None
+        if input_types is None or return_type is None or callee is None:
+            name, parsed_input_types, parsed_return_type = _parse_signature(
+                    getattr(type(func), '__call__', None) if callee == 'obj' else func)
+            if callee is None:
+                callee = name
+            if input_types is None:
+                input_types = parsed_input_types
+            if return_type is None:
+                return_type = parsed_return_type
+    if input_types is None or return_type is None:
+        raise Exception('The input and return types are required for a function given by name')
+
+    input_types = [_normalize_type(t) for t in input_types]
+    return_type = _normalize_type(return_type)
+    for t in input_types + [return_type]:
+        if not t in _dtypes:
+            raise Exception(
+                    'Type {} is not supported for vectorization. Valid types are {}'.format(t, list(_dtypes.keys())))
+
+    # Jit the loop over the buffers. Scalar arguments are broadcast by a stride of zero.
+    nargs = len(input_types)
+    params = ['const {} *x{}'.format(t, i) for i, t in enumerate(input_types)]
+    params += ['{} *out'.format(return_type), 'std::size_t n']
+    params += ['std::size_t s{}'.format(i) for i in range(nargs)]
+    if self_obj is not None:
+        params += ['std::uintptr_t self']
+    call_args = ', '.join(['x{0}[i * s{0}]'.format(i) for i in range(nargs)])
+    body = '   for (std::size_t i = 0; i < n; ++i)\n      out[i] = {}({});\n'.format(callee, call_args)
+    if self_obj is not None:
+        body = '   auto &obj = *reinterpret_cast<{} *>(self);\n'.format(self_type) + body
+    code = 'void {{name}}({})\n{{{{\n{}}}}}\n'.format(', '.join(params), body.replace('{', '{{').replace('}', '}}'))
+
+    if not code in _wrappers:
+        name = 'vectorize_{}'.format(len(_wrappers))
+        cpp_wrapper = 'namespace ROOT {{\nnamespace Internal {{\nnamespace Vectorize {{\n{}}}\n}}\n}}\n'.format(
+                code.format(name=name))
+        if not gbl_namespace.gInterpreter.Declare('#include <cstddef>\n#include <cstdint>\n' + cpp_wrapper):
+            raise Exception('Failed to jit the vectorized wrapper:\n{}'.format(cpp_wrapper))
+        wrapper = getattr(gbl_namespace.ROOT.Internal.Vectorize, name)
+        wrapper.__release_gil__ = True
+        _wrappers[code] = (wrapper, cpp_wrapper)
+    wrapper, cpp_wrapper = _wrappers[code]
+
+    in_dtypes = [np.dtype(_dtypes[t]) for t in input_types]
+    out_dtype = np.dtype(_dtypes[return_type])
+
+    def vectorized(*args):
+        if len(args) != nargs:
+            raise TypeError('Vectorized function takes {} arguments ({} given)'.format(nargs, len(args)))
+        arrays = [np.ascontiguousarray(a, dtype=d) for a, d in zip(args, in_dtypes)]
+        shape = ()
+        for a in arrays:
+            if a.size == 1:
+                continue
+            if shape and a.shape != shape:
+                raise ValueError('Arguments have different shapes {} and {}'.format(shape, a.shape))
+            shape = a.shape
+        out = np.empty(shape, dtype=out_dtype)
+        if out.size == 0:
+            return out
+        strides = [0 if a.size == 1 else 1 for a in arrays]
+        extra = [addressof(self_obj)] if self_obj is not None else []
+        wrapper(*(arrays + [out, out.size] + strides + extra))
+        return out
+
+    vectorized.__cpp_wrapper__ = cpp_wrapper
+    vectorized.__name__ = 'vectorized'
+    return vectorized
@@ -87,6 +87,66 @@ def RDataFrameAsNumpy(df, columns=None, exclude=None):
     return py_arrays
 
 
+def RDataFrameAsArrow(df, columns=None, exclude=None):
+    """Read-out the RDataFrame as a pyarrow Table.
+
+    The values of the columns are collected in Arrow record batches by the ToArrow
+    action of the RDataFrame, one batch per processing slot, and the batches are
+    handed over to pyarrow through the Arrow C data interface without copying them.
+    Columns of fundamental types and of std::string become primitive and string
+    arrays, collections of these such as RVec<float> become list arrays.
+
+    The reading is performed in multiple threads if the implicit multi-threading of
+    ROOT is enabled. In that case the order of the rows of the table is not the
+    order of the entries of the dataset.
+
+    Note that this is an instant action of the RDataFrame graph and will trigger the
+    event-loop.
+
+    Parameters:
+        columns: If None return all branches as columns, otherwise specify names in iterable.
+        exclude: Exclude branches from selection.
+
+    Returns:
+        pyarrow.Table: Table with one column per selected column of the dataframe
+    """
+    # Import pyarrow lazily
+    try:
+        import pyarrow
+        from pyarrow.cffi import ffi
+    except:
+        raise ImportError("Failed to import pyarrow during call of RDataFrame.AsArrow.")
+
+    from cppyy.gbl import std
+    from cppyy.gbl.ROOT.Internal.RDF import ExportArrowBatch
+
+    # Find all column names in the dataframe if no column are specified
+    if not columns:
+        columns = [str(c) for c in df.GetColumnNames()]
+
+    # Exclude the specified columns
+    if exclude == None:
+        exclude = []
+    columns = [col for col in columns if not col in exclude]
+
+    column_names = std.vector["std::string"]()
+    for column in columns:
+        column_names.push_back(column)
+    batches = df.ToArrow(column_names).GetValue()
+
+    # Move the batches to pyarrow: the release callbacks of the exported structs free the C++ buffers
+    py_batches = []
+    for i in range(batches.GetNBatches()):
+        c_array = ffi.new("struct ArrowArray*")
+        c_schema = ffi.new("struct ArrowSchema*")
+        array_address = int(ffi.cast("uintptr_t", c_array))
+        schema_address = int(ffi.cast("uintptr_t", c_schema))
+        ExportArrowBatch(batches, i, array_address, schema_address)
+        py_batches.append(pyarrow.RecordBatch._import_from_c(array_address, schema_address))
+
+    return pyarrow.Table.from_batches(py_batches)
+
+
 def _histo_profile(self, fixed_args, *args):
     # Check wheter the user called one of the HistoXD or ProfileXD methods
     # of RDataFrame with a tuple as first argument; in that case,
@@ -136,6 +196,9 @@ def pythonize_rdataframe(klass, name):
         # Add asNumpy feature
         klass.AsNumpy = RDataFrameAsNumpy
 
+        # Add asArrow feature
+        klass.AsArrow = RDataFrameAsArrow
+
         # Replace the implementation of the following RDF methods
         # to convert a tuple argument into a model object
         methods_with_TModel = {
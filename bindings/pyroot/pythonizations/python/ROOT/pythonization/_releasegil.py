@@ -0,0 +1,135 @@
+################################################################################
+# Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.                      #
+# All rights reserved.                                                         #
+#                                                                              #
+# For the licensing terms see $ROOTSYS/LICENSE.                                #
+# For the list of contributors see $ROOTSYS/README/CREDITS.                    #
+################################################################################
+
+from ROOT import pythonization
+import threading
+
+
+# Methods which can run for a long time in C++ and are called without holding the GIL,
+# so that other Python threads can progress in the meantime. Methods which can call
+# back into Python objects deriving from C++ classes, e.g. TTree::Process with a
+# selector implemented in Python, are not part of the list, since the dispatch to
+# Python does not reacquire the GIL. Callables passed as C++ functions do.
+_long_running_methods = {
+    'TTree': ['Draw', 'Project', 'CopyTree', 'Fit'],
+    'TChain': ['Draw', 'Merge'],
+    'TH1': ['Fit'],
+    'TGraph': ['Fit'],
+    'TGraph2D': ['Fit'],
+    'TMultiGraph': ['Fit'],
+    'TDirectoryFile': ['Write', 'ReadAll'],
+    'TFile': ['Write', 'Close', 'ReadAll'],
+    'TFileMerger': ['Merge', 'PartialMerge'],
+}
+
+# Same as above for class templates, indexed by the prefix of the name of their instantiations
+_long_running_template_methods = {
+    'ROOT::RDF::RResultPtr<': ['GetValue'],
+}
+
+
+class _ReleasedGILCalls(object):
+    '''
+    Count the calls into C++ which are in progress without the GIL
+
+    The thread processing the ROOT events in Python scripts must not run concurrently
+    to these calls, since most of ROOT is not thread-safe, see _application.py.
+    '''
+
+    def __init__(self):
+        self._lock = threading.Lock()
+        self._count = 0
+
+    def __enter__(self):
+        with self._lock:
+            self._count += 1
+
+    def __exit__(self, *args):
+        with self._lock:
+            self._count -= 1
+
+    def run_if_idle(self, func):
+        '''
+        Call func unless a call without the GIL is in progress
+        '''
+        with self._lock:
+            if self._count == 0:
+                func()
+
+
+released_gil_calls = _ReleasedGILCalls()
+
+
+def _release_gil(method):
+    # Mark the overloads of method as releasing the GIL and return a wrapper
+    # which tracks the calls in progress.
+    # Parameters:
+    # method: cppyy overload, either a method or a free function
+    try:
+        method.__release_gil__ = True
+    except AttributeError:
+        # method templates do not support releasing the GIL
+        return method
+
+    def _call_without_gil(*args, **kwargs):
+        with released_gil_calls:
+            return method(*args, **kwargs)
+
+    _call_without_gil.__name__ = method.__name__
+    _call_without_gil.__doc__ = method.__doc__
+    return _call_without_gil
+
+
+def _RResultPtrAsFuture(self, executor=None):
+    """Get the value of the result in a separate thread as an asyncio future.
+
+    The event loop of the computation graph, if not already run, is run in a thread
+    of the given executor, by default the one of the asyncio event loop, without
+    holding the GIL. This allows to await results of several RDataFrames concurrently,
+    provided that ROOT.EnableThreadSafety() was called. Results of the same computation
+    graph can be awaited concurrently as well, the event loop is run once for all.
+
+    Parameters:
+        executor: concurrent.futures.Executor running the event loop, None for the default one.
+
+    Returns:
+        asyncio.Future: Future with the value of the result
+    """
+    import asyncio
+    return asyncio.get_event_loop().run_in_executor(executor, self.GetValue)
+
+
+def _RResultPtrAwait(self):
+    # Make RResultPtr awaitable with asyncio, running the event loop in the
+    # default executor of the asyncio event loop.
+    return self.AsFuture().__await__()
+
+
+@pythonization()
+def pythonize_releasegil(klass, name):
+    # Parameters:
+    # klass: class to be pythonized
+    # name: string containing the name of the class
+
+    methods = _long_running_methods.get(name, [])
+    for prefix, template_methods in _long_running_template_methods.items():
+        if name.startswith(prefix):
+            methods = template_methods
+
+    for method_name in methods:
+        # Methods found in a base class are already wrapped there, since the
+        # bases are pythonized first
+        method = getattr(klass, method_name, None)
+        if hasattr(method, '__release_gil__'):
+            setattr(klass, method_name, _release_gil(method))
+
+    if name.startswith('ROOT::RDF::RResultPtr<'):
+        klass.AsFuture = _RResultPtrAsFuture
+        klass.__await__ = _RResultPtrAwait
+
+    return True
@@ -88,24 +88,30 @@ def RTensorGetitem(self, idx):
             isSlice = True
             start = 0 if x.start is None else x.start
             stop = shape[i] if x.stop is None else x.stop
+            if start < 0:
+                start += shape[i]
             if stop < 0:
                 stop += shape[i]
-            if x.step != None:
-                raise Exception("RTensor does not support slices with step size unequal 1.")
-            idx[i] = slice(start, stop, None)
+            stop = min(stop, shape[i])
+            step = 1 if x.step is None else x.step
+            if step < 1:
+                raise Exception("RTensor does not support slices with negative step size.")
+            idx[i] = slice(start, stop, step)
         else:
             if x < 0:
                 idx[i] += shape[i]
 
-    # If a slice is requested, return a new RTensor
+    # If a slice is requested, return a new RTensor viewing the same memory
     if isSlice:
         idxVec = cppyy.gbl.std.vector("vector<size_t>")(len(idx))
         for i, x in enumerate(idx):
-            idxVec[i].resize(2)
             if type(x) == slice:
+                idxVec[i].resize(3)
                 idxVec[i][0] = x.start
                 idxVec[i][1] = x.stop
+                idxVec[i][2] = x.step
             else:
+                idxVec[i].resize(2)
                 idxVec[i][0] = x
                 idxVec[i][1] = x + 1
         return self.Slice(idxVec)
@@ -0,0 +1,90 @@
+import unittest
+import ROOT
+import sys
+
+
+class RDataFrameReleaseGIL(unittest.TestCase):
+    """
+    Tests for running the event loop of RDataFrame without holding the GIL
+    and for awaiting results with asyncio.
+    """
+
+    @classmethod
+    def setUpClass(cls):
+        ROOT.EnableThreadSafety()
+
+    def test_getvalue(self):
+        """
+        Test that GetValue is pythonized and gives the result
+        """
+        df = ROOT.RDataFrame(100).Define("x", "(int)rdfentry_")
+        s = df.Sum("x")
+        self.assertEqual(s.GetValue(), 4950)
+        self.assertEqual(df.GetNRuns(), 1)
+
+    def test_threads(self):
+        """
+        Test that results of different computation graphs can be obtained from Python threads
+        """
+        import threading
+        results = [ROOT.RDataFrame(1000 * (i + 1)).Count() for i in range(4)]
+        values = [None] * len(results)
+
+        def get(i):
+            values[i] = results[i].GetValue()
+
+        threads = [threading.Thread(target=get, args=(i,)) for i in range(len(results))]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        self.assertEqual(values, [1000, 2000, 3000, 4000])
+
+    @unittest.skipIf(sys.version_info < (3, 5), "asyncio with async/await requires Python 3.5")
+    def test_asyncio(self):
+        """
+        Test awaiting results of the same and of different computation graphs
+        """
+        import asyncio
+        df1 = ROOT.RDataFrame(10).Define("x", "(double)rdfentry_")
+        df2 = ROOT.RDataFrame(20)
+        s = df1.Sum("x")
+        m = df1.Max("x")
+        c = df2.Count()
+
+        code = '''
+async def gather_results(s, m, c):
+    return await asyncio.gather(s, m, c)
+'''
+        scope = {'asyncio': asyncio}
+        exec(code, scope)
+        loop = asyncio.new_event_loop()
+        try:
+            asyncio.set_event_loop(loop)
+            values = loop.run_until_complete(scope['gather_results'](s, m, c))
+        finally:
+            loop.close()
+        self.assertEqual(list(values), [45., 9., 20])
+        self.assertEqual(df1.GetNRuns(), 1)
+        self.assertEqual(df2.GetNRuns(), 1)
+
+    @unittest.skipIf(sys.version_info < (3, 4), "asyncio requires Python 3.4")
+    def test_asfuture(self):
+        """
+        Test getting a result as future with a given executor
+        """
+        import asyncio
+        from concurrent.futures import ThreadPoolExecutor
+        c = ROOT.RDataFrame(42).Count()
+        loop = asyncio.new_event_loop()
+        try:
+            asyncio.set_event_loop(loop)
+            with ThreadPoolExecutor(max_workers=2) as executor:
+                value = loop.run_until_complete(c.AsFuture(executor))
+        finally:
+            loop.close()
+        self.assertEqual(value, 42)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -262,3 +262,21 @@ class NumpyCompliance(unittest.TestCase):
             self.assertEqual(i, j)
         self.assertEqual(x4[0], y4[0])
         self.assertEqual(x4[1], y4[1])
+
+    def test_sliceWithStep(self):
+        """
+        Test slicing with steps, which returns a view on the same memory
+        """
+        shape = ROOT.std.vector("size_t")((3, 4))
+        x = RTensor("float")(shape)
+        y = np.asarray(x)
+        y[:] = np.arange(12).reshape(3, 4)
+
+        x1 = x[::2,1::2]
+        y1 = y[::2,1::2]
+        for i, j in zip(x1.GetShape(), y1.shape):
+            self.assertEqual(i, j)
+        self.assertTrue(np.array_equal(np.asarray(x1), y1))
+
+        np.asarray(x1)[1,1] = -1
+        self.assertEqual(y[2,3], -1)
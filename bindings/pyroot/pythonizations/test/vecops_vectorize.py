@@ -0,0 +1,74 @@
+import unittest
+import ROOT
+import numpy as np
+
+
+ROOT.gInterpreter.Declare('''
+float vectorize_test_scale(float x, int n) { return x * n; }
+
+struct VectorizeTestFunctor {
+   double fOffset = 0;
+   double operator()(double x) const { return x + fOffset; }
+};
+''')
+
+
+class Vectorize(unittest.TestCase):
+    """
+    Tests for the Vectorize feature evaluating C++ functions over numpy arrays
+    in a jitted loop.
+    """
+
+    # Tests
+    def test_name(self):
+        f = ROOT.VecOps.Vectorize('ROOT::Math::gaussian_pdf', ['double', 'double', 'double'], 'double')
+        x = np.linspace(-5, 5, 1001)
+        y = f(x, 2.0, 1.0)
+        self.assertEqual(y.dtype, np.float64)
+        self.assertEqual(y.shape, x.shape)
+        for i in [0, 123, 500, 1000]:
+            self.assertAlmostEqual(y[i], ROOT.Math.gaussian_pdf(x[i], 2.0, 1.0))
+
+    def test_lambda(self):
+        f = ROOT.VecOps.Vectorize('[](double x, double y) { return x * y; }', ['double', 'double'], 'double')
+        x = np.arange(10, dtype='float64')
+        y = np.arange(10, 20, dtype='float64')
+        np.testing.assert_array_equal(f(x, y), x * y)
+
+    def test_signature(self):
+        f = ROOT.VecOps.Vectorize(ROOT.vectorize_test_scale)
+        x = np.arange(12, dtype='float64').reshape(3, 4)
+        y = f(x, 3)
+        self.assertEqual(y.dtype, np.float32)
+        self.assertEqual(y.shape, (3, 4))
+        np.testing.assert_array_equal(y, (x * 3).astype('float32'))
+
+    def test_method(self):
+        tf = ROOT.TF1('vectorize_test_tf1', 'x*x', -10, 10)
+        f = ROOT.VecOps.Vectorize(tf.Eval, ['double', 'double', 'double', 'double'], 'double')
+        x = np.linspace(-10, 10, 100)
+        np.testing.assert_allclose(f(x, 0, 0, 0), x * x)
+
+    def test_functor(self):
+        functor = ROOT.VectorizeTestFunctor()
+        functor.fOffset = 2.5
+        f = ROOT.VecOps.Vectorize(functor)
+        x = np.arange(5, dtype='float64')
+        np.testing.assert_array_equal(f(x), x + 2.5)
+
+    def test_list_input(self):
+        f = ROOT.VecOps.Vectorize('[](int x) { return 2 * x; }', ['int'], 'int')
+        np.testing.assert_array_equal(f([1, 2, 3]), np.array([2, 4, 6], dtype='int32'))
+
+    def test_shape_mismatch(self):
+        f = ROOT.VecOps.Vectorize('[](double x, double y) { return x + y; }', ['double', 'double'], 'double')
+        with self.assertRaises(ValueError):
+            f(np.zeros(3), np.zeros(4))
+
+    def test_unsupported_type(self):
+        with self.assertRaises(Exception):
+            ROOT.VecOps.Vectorize('[](std::string s) { return s.size(); }', ['std::string'], 'std::size_t')
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,59 @@
+# Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.
+# All rights reserved.
+#
+# For the licensing terms see $ROOTSYS/LICENSE.
+# For the list of contributors see $ROOTSYS/README/CREDITS.
+
+#.rst:
+# FindLibDeflate
+# --------------
+#
+# Find the libdeflate library header and define variables.
+#
+# Imported Targets
+# ^^^^^^^^^^^^^^^^
+#
+# This module defines :prop_tgt:`IMPORTED` target ``LibDeflate::LibDeflate``,
+# if libdeflate has been found
+#
+# Result Variables
+# ^^^^^^^^^^^^^^^^
+#
+# This module defines the following variables:
+#
+# ::
+#
+#   LIBDEFLATE_FOUND          - True if libdeflate is found.
+#   LIBDEFLATE_INCLUDE_DIRS   - Where to find libdeflate.h
+#   LIBDEFLATE_LIBRARIES      - The libdeflate library path
+
+# Find header files
+find_path(LIBDEFLATE_INCLUDE_DIR libdeflate.h)
+
+# Find a libdeflate version
+if(LIBDEFLATE_INCLUDE_DIR AND EXISTS "${LIBDEFLATE_INCLUDE_DIR}/libdeflate.h")
+  file(READ "${LIBDEFLATE_INCLUDE_DIR}/libdeflate.h" CONTENT)
+  string(REGEX MATCH "define LIBDEFLATE_VERSION_STRING[ \t]*\"([0-9.]+)\"" VERSION_REGEX "${CONTENT}")
+  set(LIBDEFLATE_VERSION ${CMAKE_MATCH_1})
+endif()
+
+# Find library
+find_library(LIBDEFLATE_LIBRARIES NAMES deflate libdeflate)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(LibDeflate
+  REQUIRED_VARS LIBDEFLATE_LIBRARIES LIBDEFLATE_INCLUDE_DIR
+  VERSION_VAR LIBDEFLATE_VERSION)
+
+mark_as_advanced(LIBDEFLATE_INCLUDE_DIR LIBDEFLATE_LIBRARIES)
+
+if(LIBDEFLATE_FOUND)
+  set(LIBDEFLATE_INCLUDE_DIRS "${LIBDEFLATE_INCLUDE_DIR}")
+
+  if(NOT TARGET LibDeflate::LibDeflate)
+    add_library(LibDeflate::LibDeflate UNKNOWN IMPORTED)
+    set_target_properties(LibDeflate::LibDeflate PROPERTIES
+      IMPORTED_LOCATION "${LIBDEFLATE_LIBRARIES}"
+      INTERFACE_INCLUDE_DIRECTORIES "${LIBDEFLATE_INCLUDE_DIRS}")
+  endif()
+endif()
@@ -131,8 +131,10 @@ ROOT_BUILD_OPTION(fcgi OFF "Enable FastCGI suppport in HTTP server")
 ROOT_BUILD_OPTION(imt ON "Enable support for implicit multi-threading via Intel® Thread Bulding Blocks (TBB)")
 ROOT_BUILD_OPTION(jemalloc OFF "Use jemalloc memory allocator")
 ROOT_BUILD_OPTION(libcxx OFF "Build using libc++")
+ROOT_BUILD_OPTION(libdeflate OFF "Use libdeflate for the (byte-compatible) ZLIB compression algorithm")
 ROOT_BUILD_OPTION(macos_native OFF "Disable looking for libraries, includes and binaries in locations other than a native installation (MacOS only)")
 ROOT_BUILD_OPTION(mathmore ON "Build libMathMore extended math library (requires GSL)")
+ROOT_BUILD_OPTION(matrix_lapack OFF "Use an external BLAS/LAPACK library for the large matrices of libMatrix")
 ROOT_BUILD_OPTION(memory_termination OFF "Free internal ROOT memory before process termination (experimental, used for leak checking)")
 ROOT_BUILD_OPTION(memstat OFF "Build memory statistics utility (helps to detect memory leaks)")
 ROOT_BUILD_OPTION(mlp ON "Enable support for TMultilayerPerceptron classes' federation")
@@ -162,6 +164,7 @@ ROOT_BUILD_OPTION(soversion OFF "Set version number in sonames (recommended)")
 ROOT_BUILD_OPTION(sqlite ON "Enable support for SQLite")
 ROOT_BUILD_OPTION(ssl ON "Enable support for SSL encryption via OpenSSL")
 ROOT_BUILD_OPTION(tcmalloc OFF "Use tcmalloc memory allocator")
+ROOT_BUILD_OPTION(tracing ON "Enable the scoped tracing of ROOT internals, active at runtime if ROOT_TRACE is set")
 ROOT_BUILD_OPTION(tmva ON "Build TMVA multi variate analysis library")
 ROOT_BUILD_OPTION(tmva-cpu ON "Build TMVA with CPU support for deep learning (requires BLAS)")
 ROOT_BUILD_OPTION(tmva-gpu OFF "Build TMVA with GPU support for deep learning (requries CUDA)")
@@ -182,6 +185,7 @@ ROOT_BUILD_OPTION(xrootd ON "Enable support for XRootD file server and client")
 ROOT_BUILD_OPTION(xproofd OFF "Enable LEGACY support for XProofD file server and client (requires XRootD v4 with private-devel)")
 
 option(all "Enable all optional components by default" OFF)
+option(benchmarks "Build the micro benchmarks with Google Benchmark, run them with 'ctest -L benchmark'" OFF)
 option(clingtest "Enable cling tests (Note: that this makes llvm/clang symbols visible in libCling)" OFF)
 option(fail-on-missing "Fail at configure time if a required package cannot be found" OFF)
 option(gminimal "Enable only required options by default, but include X11" OFF)
@@ -362,7 +366,7 @@ set(webgui_defvalue ${root7_defvalue})
 ROOT_APPLY_OPTIONS()
 
 #---roottest option implies testing
-if(roottest OR rootbench)
+if(roottest OR rootbench OR benchmarks)
   set(testing ON CACHE BOOL "" FORCE)
 endif()
 
@@ -427,6 +427,16 @@ if(dataframe)
 else()
   set(hasdataframe undef)
 endif()
+if(clad)
+  set(hasclad define)
+else()
+  set(hasclad undef)
+endif()
+if(tracing)
+  set(hastracing define)
+else()
+  set(hastracing undef)
+endif()
 if(dev)
   set(use_less_includes define)
 else()
@@ -446,6 +456,11 @@ if(ZLIB_CF)
 else()
   set(usecloudflarezlib undef)
 endif()
+if(libdeflate)
+  set(haslibdeflate define)
+else()
+  set(haslibdeflate undef)
+endif()
 if(runtime_cxxmodules)
   set(usecxxmodules define)
 else()
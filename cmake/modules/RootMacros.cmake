@@ -1696,6 +1696,39 @@ function(ROOT_ADD_GTEST test_suite)
   )
 endfunction()
 
+#----------------------------------------------------------------------------
+# function ROOT_ADD_BENCHMARK(<benchmark> source1 source2... COPY_TO_BUILDDIR file1 file2 LIBRARIES lib1 lib2)
+#
+# Build a micro benchmark based on Google Benchmark and add it as test with the label
+# "benchmark", if ROOT is configured with -Dbenchmarks=ON. The benchmarks run one after
+# the other with 'ctest -L benchmark' and write their results in JSON format into
+# ${CMAKE_BINARY_DIR}/benchmarks/<benchmark>.json, which can be compared between two
+# builds with the script tools/compare.py of Google Benchmark.
+#
+function(ROOT_ADD_BENCHMARK benchmark)
+  if(NOT benchmarks)
+    return()
+  endif()
+  CMAKE_PARSE_ARGUMENTS(ARG "" "" "COPY_TO_BUILDDIR;LIBRARIES" ${ARGN})
+
+  ROOT_GET_SOURCES(source_files . ${ARG_UNPARSED_ARGUMENTS})
+  ROOT_EXECUTABLE(${benchmark} ${source_files} LIBRARIES ${ARG_LIBRARIES})
+  target_link_libraries(${benchmark} benchmark_main benchmark)
+  target_include_directories(${benchmark} PRIVATE ${CMAKE_CURRENT_BINARY_DIR})
+
+  file(MAKE_DIRECTORY ${CMAKE_BINARY_DIR}/benchmarks)
+  ROOT_PATH_TO_STRING(mangled_name ${benchmark} PATH_SEPARATOR_REPLACEMENT "-")
+  ROOT_ADD_TEST(
+    benchmark${mangled_name}
+    COMMAND ${benchmark} --benchmark_out=${CMAKE_BINARY_DIR}/benchmarks/${benchmark}.json
+                         --benchmark_out_format=json
+    WORKING_DIR ${CMAKE_CURRENT_BINARY_DIR}
+    COPY_TO_BUILDDIR ${ARG_COPY_TO_BUILDDIR}
+    RUN_SERIAL
+    LABELS benchmark
+  )
+endfunction()
+
 
 #----------------------------------------------------------------------------
 # ROOT_ADD_TEST_SUBDIRECTORY( <name> )
@@ -65,6 +65,20 @@ if(builtin_zlib)
   add_subdirectory(builtins/zlib)
 endif()
 
+#---Check for libdeflate-------------------------------------------------------------
+if(libdeflate)
+  message(STATUS "Looking for libdeflate")
+  if(fail-on-missing)
+    find_package(LibDeflate REQUIRED)
+  else()
+    find_package(LibDeflate)
+    if(NOT LIBDEFLATE_FOUND)
+      message(STATUS "libdeflate not found. Switching off libdeflate option")
+      set(libdeflate OFF CACHE BOOL "Disabled because libdeflate not found (${libdeflate_description})" FORCE)
+    endif()
+  endif()
+endif()
+
 #---Check for Unuran ------------------------------------------------------------------
 if(unuran AND NOT builtin_unuran)
   message(STATUS "Looking for Unuran")
@@ -746,22 +760,37 @@ if(builtin_fftw3)
   set(FFTW_VERSION 3.3.8)
   message(STATUS "Downloading and building FFTW version ${FFTW_VERSION}")
   set(FFTW_LIBRARIES ${CMAKE_BINARY_DIR}/lib/libfftw3.a)
+  set(FFTW_THREADS_LIBRARY ${CMAKE_BINARY_DIR}/lib/libfftw3_threads.a)
   ExternalProject_Add(
     FFTW3
     URL ${lcgpackages}/fftw-${FFTW_VERSION}.tar.gz
     URL_HASH SHA256=6113262f6e92c5bd474f2875fa1b01054c4ad5040f6b0da7c03c98821d9ae303
     INSTALL_DIR ${CMAKE_BINARY_DIR}
-    CONFIGURE_COMMAND ./configure --prefix=<INSTALL_DIR>
+    CONFIGURE_COMMAND ./configure --prefix=<INSTALL_DIR> --enable-threads
     BUILD_COMMAND make CFLAGS=-fPIC
     LOG_DOWNLOAD 1 LOG_CONFIGURE 1 LOG_BUILD 1 LOG_INSTALL 1
     BUILD_IN_SOURCE 1
-    BUILD_BYPRODUCTS ${FFTW_LIBRARIES}
+    BUILD_BYPRODUCTS ${FFTW_LIBRARIES} ${FFTW_THREADS_LIBRARY}
   )
   set(FFTW_INCLUDE_DIR ${CMAKE_BINARY_DIR}/include)
   set(FFTW3_TARGET FFTW3)
   set(fftw3 ON CACHE BOOL "Enabled because builtin_fftw3 requested (${fftw3_description})" FORCE)
 endif()
 
+#---Check for an external BLAS/LAPACK library for libMatrix---------------------------
+if(matrix_lapack)
+  message(STATUS "Looking for LAPACK")
+  find_package(LAPACK)
+  if(NOT LAPACK_FOUND)
+    if(fail-on-missing)
+      message(FATAL_ERROR "LAPACK libraries not found and they are required (matrix_lapack option enabled)")
+    else()
+      message(STATUS "LAPACK not found. Switching OFF 'matrix_lapack' option")
+      set(matrix_lapack OFF CACHE BOOL "Disabled because LAPACK not found (${matrix_lapack_description})" FORCE)
+    endif()
+  endif()
+endif()
+
 #---Check for fitsio-------------------------------------------------------------------
 if(fitsio OR builtin_cfitsio)
   if(builtin_cfitsio)
@@ -959,6 +988,17 @@ if(arrow)
     endif()
   endif()
 
+  #---The Parquet library is part of Arrow, it is needed by RParquetDS
+  if(ARROW_FOUND)
+    find_path(PARQUET_INCLUDE_DIR parquet/arrow/reader.h HINTS ${ARROW_INCLUDE_DIR})
+    find_library(PARQUET_SHARED_LIB parquet HINTS ${ARROW_LIB_DIR})
+    if(PARQUET_INCLUDE_DIR AND PARQUET_SHARED_LIB)
+      set(PARQUET_FOUND TRUE)
+    else()
+      message(STATUS "Apache Parquet not found in the Arrow installation, RParquetDS will not be built")
+    endif()
+  endif()
+
 endif()
 
 #---Check for cling and llvm --------------------------------------------------------
@@ -1690,6 +1730,64 @@ if (testing)
 
 endif()
 
+#---Download googlebenchmark---------------------------------------------------------
+if (benchmarks)
+  set(_gbench_byproduct_binary_dir
+    ${CMAKE_CURRENT_BINARY_DIR}/googlebenchmark-prefix/src/googlebenchmark-build)
+  set(_gbench_byproducts
+    ${_gbench_byproduct_binary_dir}/src/${CMAKE_STATIC_LIBRARY_PREFIX}benchmark${CMAKE_STATIC_LIBRARY_SUFFIX}
+    ${_gbench_byproduct_binary_dir}/src/${CMAKE_STATIC_LIBRARY_PREFIX}benchmark_main${CMAKE_STATIC_LIBRARY_SUFFIX}
+    )
+
+  if(MSVC)
+    set(EXTRA_GBENCH_OPTS
+      -DCMAKE_ARCHIVE_OUTPUT_DIRECTORY_RELEASE:PATH=${_gbench_byproduct_binary_dir}/src/
+      BUILD_COMMAND ${CMAKE_COMMAND} --build <BINARY_DIR> --config Release)
+  endif()
+
+  ExternalProject_Add(
+    googlebenchmark
+    GIT_REPOSITORY https://github.com/google/benchmark.git
+    GIT_SHALLOW 1
+    GIT_TAG v1.5.2
+    UPDATE_COMMAND ""
+    CMAKE_ARGS -G ${CMAKE_GENERATOR}
+                  -DCMAKE_BUILD_TYPE=Release
+                  -DCMAKE_C_COMPILER=${CMAKE_C_COMPILER}
+                  -DCMAKE_C_FLAGS=${CMAKE_C_FLAGS}
+                  -DCMAKE_CXX_COMPILER=${CMAKE_CXX_COMPILER}
+                  -DCMAKE_CXX_FLAGS=${ROOT_EXTERNAL_CXX_FLAGS}
+                  -DCMAKE_AR=${CMAKE_AR}
+                  -DBENCHMARK_ENABLE_TESTING=OFF
+                  -DBENCHMARK_ENABLE_INSTALL=OFF
+                  ${EXTRA_GBENCH_OPTS}
+    # Disable install step
+    INSTALL_COMMAND ""
+    BUILD_BYPRODUCTS ${_gbench_byproducts}
+    # Wrap download, configure and build steps in a script to log output
+    LOG_DOWNLOAD ON
+    LOG_CONFIGURE ON
+    LOG_BUILD ON)
+
+  ExternalProject_Get_Property(googlebenchmark source_dir)
+  set(GBENCHMARK_INCLUDE_DIR ${source_dir}/include)
+  # Create the directory. Prevents bug https://gitlab.kitware.com/cmake/cmake/issues/15052
+  file(MAKE_DIRECTORY ${GBENCHMARK_INCLUDE_DIR})
+
+  foreach(lib benchmark benchmark_main)
+    add_library(${lib} IMPORTED STATIC GLOBAL)
+    set_target_properties(${lib} PROPERTIES
+      IMPORTED_LOCATION ${_gbench_byproduct_binary_dir}/src/${CMAKE_STATIC_LIBRARY_PREFIX}${lib}${CMAKE_STATIC_LIBRARY_SUFFIX}
+    )
+    add_dependencies(${lib} googlebenchmark)
+  endforeach()
+  set_property(TARGET benchmark APPEND PROPERTY INTERFACE_INCLUDE_DIRECTORIES ${GBENCHMARK_INCLUDE_DIR})
+  set_property(TARGET benchmark APPEND PROPERTY INTERFACE_LINK_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+  if(MSVC)
+    set_property(TARGET benchmark APPEND PROPERTY INTERFACE_LINK_LIBRARIES shlwapi)
+  endif()
+endif()
+
 #------------------------------------------------------------------------------------
 if(webgui)
   ExternalProject_Add(
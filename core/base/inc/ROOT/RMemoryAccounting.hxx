@@ -0,0 +1,88 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RMemoryAccounting
+#define ROOT_RMemoryAccounting
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class TObject;
+
+namespace ROOT {
+namespace Experimental {
+
+/**
+\class ROOT::Experimental::RMemoryAccounting
+\ingroup Base
+Breakdown of the live memory of a process by ROOT subsystem and by class.
+
+The subsystems account their memory in per-thread counters, which are always active and
+cost one thread-local addition per allocation of a basket, page or histogram array:
+ - kBaskets: the basket buffers of the trees, as counted for TTree::SetMaxVirtualSize()
+ - kPagePools: the pages of RNTuple
+ - kHistograms: the storage of the TArray classes, i.e. the bins of the TH1 histograms
+ - kInterpreter: the memory of the clang AST, queried from the interpreter
+
+The breakdown by class samples the construction of the TObjects on the heap: on average one
+object in every `interval` constructed objects is remembered until its destruction. The class of
+the sampled objects is only resolved by GetClassUsage(), so that sampling costs one thread-local
+counter decrement per TObject construction. Unlike gObjectTable, the sampling is thread-safe and
+does not allocate memory when objects are created or deleted.
+
+Sampling is started with EnableSampling() or with the resource `Root.MemoryAccounting`, which
+gives the sampling interval. The usage can be printed, obtained as JSON, or read at the
+`memory.json` address of a THttpServer.
+*/
+
+class RMemoryAccounting {
+   friend class ::TObject;
+
+public:
+   enum class ESubsystem { kBaskets, kPagePools, kHistograms, kInterpreter };
+   static constexpr std::size_t kNSubsystems = 4;
+   static constexpr unsigned int kDefaultSamplingInterval = 1000;
+
+   /// Function returning the current memory of a subsystem that cannot count its allocations
+   using Probe_t = std::int64_t (*)();
+
+   /// Estimated memory used by a subsystem or by the objects of a class
+   struct RUsage {
+      std::string fName;
+      std::int64_t fBytes = 0;
+      std::int64_t fCount = 0; ///< Estimated number of live objects, for the classes
+   };
+
+private:
+   static std::atomic<bool> fgIsSampling;
+
+   static void SampleObject(TObject *obj);
+   static void ForgetObject(TObject *obj);
+
+public:
+   static void Add(ESubsystem subsystem, std::int64_t bytes);
+   static void SetProbe(ESubsystem subsystem, Probe_t probe);
+   static const char *GetSubsystemName(ESubsystem subsystem);
+
+   static void EnableSampling(unsigned int interval = kDefaultSamplingInterval);
+   static void DisableSampling();
+   static bool IsSampling() { return fgIsSampling.load(std::memory_order_relaxed); }
+
+   static std::vector<RUsage> GetSubsystemUsage();
+   static std::vector<RUsage> GetClassUsage();
+   static std::string GetJSON();
+   static void Print();
+};
+
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
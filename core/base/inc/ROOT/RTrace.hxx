@@ -0,0 +1,103 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RTrace
+#define ROOT_RTrace
+
+#include "RConfigure.h"
+#include "DllImport.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+\file ROOT/RTrace.hxx
+\ingroup Base
+Scoped tracing of the time spent in ROOT internals, with a common timeline for all the threads.
+
+A scope is instrumented with
+~~~{.cpp}
+   R__TRACE_SCOPE("io", "TFile::ReadBuffer");
+~~~
+where the category and the name must be string literals (or have static storage duration).
+Tracing is started when the environment variable `ROOT_TRACE` is set to the name of the trace
+file, or with Enable(). Each thread records the completed scopes into its own ring buffer,
+which keeps the latest kBufferCapacity scopes. The trace file is written at the end of the
+process or by Disable(), in the Chrome trace event format, which can be opened with
+chrome://tracing or https://ui.perfetto.dev.
+
+Without tracing enabled, a scope costs a single relaxed atomic load. With the build option
+`tracing=OFF` the macro expands to nothing.
+*/
+
+namespace ROOT {
+namespace Internal {
+namespace Trace {
+
+/// Number of scopes kept per thread
+constexpr std::size_t kBufferCapacity = 1 << 16;
+
+R__EXTERN std::atomic<bool> gTraceActive;
+
+/// Whether the completed scopes are currently recorded
+inline bool IsActive()
+{
+   return gTraceActive.load(std::memory_order_relaxed);
+}
+
+/// Nanoseconds of a monotonic clock
+inline std::uint64_t Now()
+{
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void Record(const char *category, const char *name, std::uint64_t start, std::uint64_t end);
+void Enable(const char *fileName);
+void Disable();
+bool WriteTrace(const char *fileName);
+
+/// Record the time from its construction to its destruction, if tracing is active at construction
+class RTraceScope {
+   const char *fCategory;
+   const char *fName;
+   std::uint64_t fStart = 0;
+
+public:
+   RTraceScope(const char *category, const char *name) : fCategory(category), fName(name)
+   {
+      if (IsActive())
+         fStart = Now();
+   }
+   ~RTraceScope()
+   {
+      if (fStart)
+         Record(fCategory, fName, fStart, Now());
+   }
+   RTraceScope(const RTraceScope &) = delete;
+   RTraceScope &operator=(const RTraceScope &) = delete;
+};
+
+} // namespace Trace
+} // namespace Internal
+} // namespace ROOT
+
+#ifdef R__HAS_TRACING
+#define R__TRACE_CONCAT_IMPL(a, b) a##b
+#define R__TRACE_CONCAT(a, b) R__TRACE_CONCAT_IMPL(a, b)
+#define R__TRACE_SCOPE(category, name) \
+   ::ROOT::Internal::Trace::RTraceScope R__TRACE_CONCAT(R__traceScope, __LINE__)(category, name)
+#else
+#define R__TRACE_SCOPE(category, name) \
+   do {                                \
+   } while (false)
+#endif
+
+#endif
@@ -26,6 +26,12 @@
 #undef RemoveDirectory
 #endif
 
+namespace ROOT {
+namespace Experimental {
+class RMemoryAccounting;
+}
+}
+
 class TList;
 class TBrowser;
 class TBuffer;
@@ -41,7 +47,7 @@ private:
    UInt_t         fBits;       ///< bit field status word
 
    static Long_t  fgDtorOnly;    ///< object for which to call dtor only (i.e. no delete)
-   static Bool_t  fgObjectStat;  ///< if true keep track of objects in TObjectTable
+   static Bool_t  fgObjectStat;  ///< if true call AddToTObjectTable() in the constructor
 
    static void AddToTObjectTable(TObject *);
 
@@ -211,6 +217,7 @@ public:
    static void      SetObjectStat(Bool_t stat);
 
    friend class TClonesArray; // needs to reset kNotDeleted in fBits
+   friend class ROOT::Experimental::RMemoryAccounting; // enables the constructor hook for sampling
 
    ClassDef(TObject,1)  //Basic ROOT object
 };
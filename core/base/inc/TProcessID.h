@@ -31,7 +31,9 @@ class TObjArray;
 #endif
 
 #include <atomic>
+#include <memory>
 #include <type_traits>
+#include <vector>
 
 class TExMap;
 
@@ -81,6 +83,7 @@ protected:
    std::atomic_int    fCount;                           //!Reference count to this object (from TFile)
    ROOT::Internal::TAtomicPointer<TObjArray*> fObjects; //!Array pointing to the referenced objects
    std::atomic_flag   fLock;                            //!Spin lock for initialization of fObjects
+   std::vector<std::unique_ptr<TObjArray>> fRetiredObjects; //!Tables replaced by a larger one, kept for the concurrent readers
 
    static TProcessID *fgPID;      //Pointer to current session ProcessID
    static TObjArray  *fgPIDs;     //Table of ProcessIDs
@@ -77,6 +77,12 @@ namespace Internal {
       TParBranchProcessingRAII()  { EnableParBranchProcessing();  }
       ~TParBranchProcessingRAII() { DisableParBranchProcessing(); }
    };
+
+   // Run func(i, arg) for all i in [0, n), on the implicit MT pool if enabled
+   void ImplicitMTForEach(UInt_t n, void (*func)(UInt_t, void *), void *arg);
+
+   // Report the time spent in a phase of ROOT's initialization, if ROOT_STARTUP_TRACE is set
+   void TraceStartup(const char *phase);
 } } // End ROOT::Internal
 
 namespace ROOT {
@@ -89,6 +95,26 @@ namespace ROOT {
    void DisableImplicitMT();
    Bool_t IsImplicitMTEnabled();
    UInt_t GetThreadPoolSize();
+
+   // Skip the registration of new objects with directories and global lists (see TLightweightObjectsGuard)
+   Bool_t IsLightweightObjectsMode();
+
+   /// \brief Scope in which the objects created and deleted by the current thread skip ROOT's bookkeeping.
+   ///
+   /// While an instance is alive, histograms are not added to gDirectory (as
+   /// with TH1::AddDirectory(kFALSE)) and functions are not added to
+   /// gROOT->GetListOfFunctions() (as with TF1::DefaultAddToGlobalList(kFALSE)).
+   /// Destroying such unregistered objects within the scope does not take the
+   /// global ROOT locks either. The objects must not be registered by hand.
+   /// The mode is per thread; guards can be nested.
+   class TLightweightObjectsGuard {
+      Bool_t fOldMode;
+   public:
+      TLightweightObjectsGuard(Bool_t lightweight = kTRUE);
+      ~TLightweightObjectsGuard();
+      TLightweightObjectsGuard(const TLightweightObjectsGuard &) = delete;
+      TLightweightObjectsGuard &operator=(const TLightweightObjectsGuard &) = delete;
+   };
 }
 
 class TROOT : public TDirectory {
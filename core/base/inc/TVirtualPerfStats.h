@@ -63,6 +63,11 @@ public:
 
    virtual void UnzipEvent(TObject *tree, Long64_t pos, Double_t start, Int_t complen, Int_t objlen) = 0;
 
+   // Per-branch events, only sent to the perf stats of a TTree (see TTree::SetPerfStats)
+   virtual void BasketReadEvent(TBranch * /*branch*/, Int_t /*nbytes*/, Double_t /*start*/, Bool_t /*fromCache*/) {}
+   virtual void BasketUnzipEvent(TBranch * /*branch*/, Double_t /*start*/, Int_t /*complen*/, Int_t /*objlen*/) {}
+   virtual void BranchStreamEvent(TBranch * /*branch*/, Double_t /*start*/) {}
+
    virtual void RateEvent(Double_t proctime, Double_t deltatime,
                           Long64_t eventsprocessed, Long64_t bytesRead) = 0;
 
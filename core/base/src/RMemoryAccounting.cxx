@@ -0,0 +1,376 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RMemoryAccounting.hxx"
+#include "TClass.h"
+#include "TClassEdit.h"
+#include "TObject.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <typeinfo>
+
+std::atomic<bool> ROOT::Experimental::RMemoryAccounting::fgIsSampling{false};
+
+namespace {
+
+using RMemoryAccounting = ROOT::Experimental::RMemoryAccounting;
+
+/// Bytes allocated minus bytes freed by one thread. Only the owning thread writes the counters,
+/// the frees of memory allocated by another thread make them negative.
+struct RThreadCounters {
+   std::atomic<std::int64_t> fBytes[RMemoryAccounting::kNSubsystems] = {};
+};
+
+struct RCounterRegistry {
+   std::mutex fMutex;
+   std::vector<std::unique_ptr<RThreadCounters>> fCounters;
+   std::atomic<RMemoryAccounting::Probe_t> fProbes[RMemoryAccounting::kNSubsystems] = {};
+
+   RThreadCounters *AddThread()
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fCounters.emplace_back(new RThreadCounters);
+      return fCounters.back().get();
+   }
+};
+
+/// The registry is never deleted, as memory is released during the destruction of static objects
+RCounterRegistry &GetCounterRegistry()
+{
+   static RCounterRegistry *registry = new RCounterRegistry;
+   return *registry;
+}
+
+/// The sampled objects are kept in open addressing hash tables, split in shards to reduce lock contention
+constexpr std::size_t kNShards = 64;
+constexpr std::size_t kShardCapacity = 1024;
+constexpr std::size_t kShardMaxSamples = kShardCapacity * 3 / 4;
+
+struct RSampleShard {
+   std::mutex fMutex;
+   std::size_t fNSamples = 0;
+   TObject *fSlots[kShardCapacity] = {};
+};
+
+std::atomic<RSampleShard *> gShards{nullptr};
+std::atomic<std::int64_t> gNSamples{0};
+std::atomic<std::int64_t> gNDropped{0};
+std::atomic<unsigned int> gSamplingInterval{RMemoryAccounting::kDefaultSamplingInterval};
+
+std::uint64_t HashPointer(const void *ptr)
+{
+   std::uint64_t h = reinterpret_cast<std::uintptr_t>(ptr);
+   h ^= h >> 33;
+   h *= 0xff51afd7ed558ccdULL;
+   h ^= h >> 33;
+   return h;
+}
+
+RSampleShard &GetShard(std::uint64_t hash)
+{
+   return gShards.load(std::memory_order_acquire)[hash % kNShards];
+}
+
+std::size_t GetHomeSlot(std::uint64_t hash)
+{
+   return (hash / kNShards) % kShardCapacity;
+}
+
+/// Number of object constructions until the next sample, drawn uniformly around the sampling
+/// interval so that periodic allocation patterns do not bias the estimate
+struct RSamplingCountdown {
+   std::uint64_t fRandomState;
+   std::int64_t fCountdown;
+
+   RSamplingCountdown()
+      : fRandomState(HashPointer(this) ^ std::chrono::steady_clock::now().time_since_epoch().count()),
+        fCountdown(Draw())
+   {
+   }
+
+   std::int64_t Draw()
+   {
+      fRandomState ^= fRandomState << 13;
+      fRandomState ^= fRandomState >> 7;
+      fRandomState ^= fRandomState << 17;
+      const std::uint64_t interval = gSamplingInterval.load(std::memory_order_relaxed);
+      return 1 + fRandomState % (2 * interval - 1);
+   }
+};
+
+std::string EscapeJSON(const std::string &str)
+{
+   std::string res;
+   for (auto c : str) {
+      if (c == '"' || c == '\\')
+         res += '\\';
+      res += c;
+   }
+   return res;
+}
+
+void SortByBytes(std::vector<RMemoryAccounting::RUsage> &usage)
+{
+   std::sort(usage.begin(), usage.end(),
+             [](const RMemoryAccounting::RUsage &a, const RMemoryAccounting::RUsage &b) { return a.fBytes > b.fBytes; });
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Account bytes allocated (or, if negative, freed) by a subsystem.
+
+void ROOT::Experimental::RMemoryAccounting::Add(ESubsystem subsystem, std::int64_t bytes)
+{
+   thread_local RThreadCounters *counters = GetCounterRegistry().AddThread();
+   auto &counter = counters->fBytes[static_cast<std::size_t>(subsystem)];
+   counter.store(counter.load(std::memory_order_relaxed) + bytes, std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the function queried for the memory of a subsystem, in addition to its counted allocations.
+
+void ROOT::Experimental::RMemoryAccounting::SetProbe(ESubsystem subsystem, Probe_t probe)
+{
+   GetCounterRegistry().fProbes[static_cast<std::size_t>(subsystem)] = probe;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the name of a subsystem, as used by Print() and GetJSON().
+
+const char *ROOT::Experimental::RMemoryAccounting::GetSubsystemName(ESubsystem subsystem)
+{
+   switch (subsystem) {
+   case ESubsystem::kBaskets: return "baskets";
+   case ESubsystem::kPagePools: return "page pools";
+   case ESubsystem::kHistograms: return "histograms";
+   case ESubsystem::kInterpreter: return "interpreter";
+   }
+   return "";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start sampling the constructions of TObjects on the heap, with on average one sample
+/// every interval constructions. If sampling is already active, only change the interval.
+
+void ROOT::Experimental::RMemoryAccounting::EnableSampling(unsigned int interval)
+{
+   static std::mutex mutex;
+   std::lock_guard<std::mutex> lock(mutex);
+   if (!gShards)
+      gShards = new RSampleShard[kNShards];
+   gSamplingInterval = std::max(interval, 1u);
+   TObject::fgObjectStat = kTRUE;
+   fgIsSampling = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stop sampling and forget the sampled objects. The destructor of TObject keeps checking
+/// for sampled objects, which costs one atomic load per destruction.
+
+void ROOT::Experimental::RMemoryAccounting::DisableSampling()
+{
+   fgIsSampling = false;
+   auto shards = gShards.load();
+   if (!shards)
+      return;
+   for (std::size_t i = 0; i < kNShards; ++i) {
+      std::lock_guard<std::mutex> lock(shards[i].fMutex);
+      gNSamples -= shards[i].fNSamples;
+      shards[i].fNSamples = 0;
+      std::fill(std::begin(shards[i].fSlots), std::end(shards[i].fSlots), nullptr);
+   }
+   gNDropped = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Called by the TObject constructors while sampling.
+
+void ROOT::Experimental::RMemoryAccounting::SampleObject(TObject *obj)
+{
+   if (!IsSampling() || !obj->IsOnHeap())
+      return;
+   thread_local RSamplingCountdown countdown;
+   if (--countdown.fCountdown > 0)
+      return;
+   countdown.fCountdown = countdown.Draw();
+
+   const auto hash = HashPointer(obj);
+   auto &shard = GetShard(hash);
+   std::lock_guard<std::mutex> lock(shard.fMutex);
+   if (shard.fNSamples >= kShardMaxSamples) {
+      ++gNDropped;
+      return;
+   }
+   auto slot = GetHomeSlot(hash);
+   while (shard.fSlots[slot])
+      slot = (slot + 1) % kShardCapacity;
+   shard.fSlots[slot] = obj;
+   ++shard.fNSamples;
+   ++gNSamples;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Called by the TObject destructor, removes the object if it was sampled.
+
+void ROOT::Experimental::RMemoryAccounting::ForgetObject(TObject *obj)
+{
+   if (gNSamples.load(std::memory_order_relaxed) == 0)
+      return;
+
+   const auto hash = HashPointer(obj);
+   auto &shard = GetShard(hash);
+   std::lock_guard<std::mutex> lock(shard.fMutex);
+   auto slot = GetHomeSlot(hash);
+   while (shard.fSlots[slot] != obj) {
+      if (!shard.fSlots[slot])
+         return;
+      slot = (slot + 1) % kShardCapacity;
+   }
+
+   // Shift back the following entries of the probe sequence, so that no tombstones are needed
+   auto next = slot;
+   while (true) {
+      next = (next + 1) % kShardCapacity;
+      if (!shard.fSlots[next])
+         break;
+      const auto home = GetHomeSlot(HashPointer(shard.fSlots[next]));
+      const bool movable = (slot <= next) ? (home <= slot || home > next) : (home <= slot && home > next);
+      if (movable) {
+         shard.fSlots[slot] = shard.fSlots[next];
+         slot = next;
+      }
+   }
+   shard.fSlots[slot] = nullptr;
+   --shard.fNSamples;
+   --gNSamples;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the memory of all the subsystems, in the order of ESubsystem.
+
+std::vector<ROOT::Experimental::RMemoryAccounting::RUsage> ROOT::Experimental::RMemoryAccounting::GetSubsystemUsage()
+{
+   std::vector<RUsage> usage(kNSubsystems);
+   auto &registry = GetCounterRegistry();
+   {
+      std::lock_guard<std::mutex> lock(registry.fMutex);
+      for (const auto &counters : registry.fCounters) {
+         for (std::size_t i = 0; i < kNSubsystems; ++i)
+            usage[i].fBytes += counters->fBytes[i].load(std::memory_order_relaxed);
+      }
+   }
+   for (std::size_t i = 0; i < kNSubsystems; ++i) {
+      usage[i].fName = GetSubsystemName(static_cast<ESubsystem>(i));
+      if (auto probe = registry.fProbes[i].load())
+         usage[i].fBytes += probe();
+   }
+   return usage;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the estimated number and size of the live objects of each sampled class, largest first.
+/// The size of an object is the size of its class, without the memory it owns.
+
+std::vector<ROOT::Experimental::RMemoryAccounting::RUsage> ROOT::Experimental::RMemoryAccounting::GetClassUsage()
+{
+   std::vector<RUsage> usage;
+   auto shards = gShards.load();
+   if (!shards)
+      return usage;
+
+   // The dynamic type is read with the shard locked, which keeps the objects alive. The classes are
+   // only looked up afterwards, as TClass::GetClass can take the interpreter lock, which may be held
+   // by a thread constructing an object.
+   std::map<const std::type_info *, std::int64_t> nSamplesPerType;
+   for (std::size_t i = 0; i < kNShards; ++i) {
+      std::lock_guard<std::mutex> lock(shards[i].fMutex);
+      for (auto obj : shards[i].fSlots) {
+         if (obj)
+            ++nSamplesPerType[&typeid(*obj)];
+      }
+   }
+
+   const std::int64_t interval = gSamplingInterval;
+   std::map<std::string, RUsage> usagePerClass;
+   for (const auto &typeAndSamples : nSamplesPerType) {
+      TClass *cl = TClass::GetClass(*typeAndSamples.first, kTRUE, kTRUE);
+      std::string name;
+      if (cl) {
+         name = cl->GetName();
+      } else {
+         int errorCode = 0;
+         char *demangled = TClassEdit::DemangleTypeIdName(*typeAndSamples.first, errorCode);
+         name = demangled ? demangled : typeAndSamples.first->name();
+         std::free(demangled);
+      }
+      auto &classUsage = usagePerClass[name];
+      classUsage.fName = name;
+      classUsage.fCount += typeAndSamples.second * interval;
+      classUsage.fBytes += typeAndSamples.second * interval * (cl ? cl->Size() : 0);
+   }
+   for (auto &classUsage : usagePerClass)
+      usage.emplace_back(std::move(classUsage.second));
+   SortByBytes(usage);
+   return usage;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the subsystem and class usage as a JSON object.
+
+std::string ROOT::Experimental::RMemoryAccounting::GetJSON()
+{
+   std::string json = "{\"subsystems\":[";
+   const char *sep = "";
+   for (const auto &usage : GetSubsystemUsage()) {
+      json += sep;
+      json += "{\"name\":\"" + usage.fName + "\",\"bytes\":" + std::to_string(usage.fBytes) + "}";
+      sep = ",";
+   }
+   json += "],\"sampling\":";
+   json += IsSampling() ? "true" : "false";
+   json += ",\"interval\":" + std::to_string(gSamplingInterval.load());
+   json += ",\"dropped\":" + std::to_string(gNDropped.load());
+   json += ",\"classes\":[";
+   sep = "";
+   for (const auto &usage : GetClassUsage()) {
+      json += sep;
+      json += "{\"name\":\"" + EscapeJSON(usage.fName) + "\",\"count\":" + std::to_string(usage.fCount) +
+              ",\"bytes\":" + std::to_string(usage.fBytes) + "}";
+      sep = ",";
+   }
+   json += "]}";
+   return json;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the subsystem and class usage.
+
+void ROOT::Experimental::RMemoryAccounting::Print()
+{
+   printf("\nMemory by subsystem\n");
+   printf("===================\n");
+   for (const auto &usage : GetSubsystemUsage())
+      printf("%-30s %15lld bytes\n", usage.fName.c_str(), (long long)usage.fBytes);
+
+   if (!gShards)
+      return;
+   printf("\nMemory by class, sampled every %u objects\n", gSamplingInterval.load());
+   printf("==========================================\n");
+   printf("%-30s %12s %15s\n", "class", "objects", "bytes");
+   for (const auto &usage : GetClassUsage())
+      printf("%-30s %12lld %15lld\n", usage.fName.c_str(), (long long)usage.fCount, (long long)usage.fBytes);
+   if (auto nDropped = gNDropped.load())
+      printf("%lld samples were dropped from the full sample table\n", (long long)nDropped);
+}
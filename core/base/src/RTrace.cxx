@@ -0,0 +1,191 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RTrace.hxx"
+#include "TError.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef R__WIN32
+#include <process.h>
+#define getpid() _getpid()
+#else
+#include <unistd.h>
+#endif
+
+std::atomic<bool> ROOT::Internal::Trace::gTraceActive{false};
+
+namespace {
+
+struct RTraceEvent {
+   const char *fCategory;
+   const char *fName;
+   std::uint64_t fStart;
+   std::uint64_t fEnd;
+};
+
+/// Ring buffer of the completed scopes of one thread. The mutex is only contended while the trace is written.
+struct RThreadBuffer {
+   std::mutex fMutex;
+   std::vector<RTraceEvent> fEvents;
+   std::uint64_t fNEvents = 0; ///< Number of events recorded, of which the last kBufferCapacity are kept
+   unsigned int fThreadId;
+
+   explicit RThreadBuffer(unsigned int threadId) : fEvents(ROOT::Internal::Trace::kBufferCapacity), fThreadId(threadId)
+   {
+   }
+};
+
+struct RTraceRegistry {
+   std::mutex fMutex;
+   std::vector<std::unique_ptr<RThreadBuffer>> fBuffers;
+   std::string fFileName;          ///< File written at the end of the process or by Disable()
+   std::uint64_t fStartTime = 0;   ///< Origin of the time stamps in the trace file
+   bool fAtExitRegistered = false;
+
+   RThreadBuffer *AddThread()
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fBuffers.emplace_back(new RThreadBuffer(fBuffers.size() + 1));
+      return fBuffers.back().get();
+   }
+};
+
+/// The registry is never deleted, as threads can record scopes during the destruction of static objects
+RTraceRegistry &GetRegistry()
+{
+   static RTraceRegistry *registry = new RTraceRegistry;
+   return *registry;
+}
+
+std::string EscapeJSON(const char *str)
+{
+   std::string res;
+   for (; *str; ++str) {
+      if (*str == '"' || *str == '\\')
+         res += '\\';
+      if (static_cast<unsigned char>(*str) >= 0x20)
+         res += *str;
+   }
+   return res;
+}
+
+void WriteAtExit()
+{
+   ROOT::Internal::Trace::Disable();
+}
+
+/// Start tracing if the environment variable ROOT_TRACE gives a file name
+struct RTraceFromEnv {
+   RTraceFromEnv()
+   {
+      const char *fileName = std::getenv("ROOT_TRACE");
+      if (fileName && *fileName)
+         ROOT::Internal::Trace::Enable(fileName);
+   }
+} gTraceFromEnv;
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a completed scope to the ring buffer of the calling thread.
+
+void ROOT::Internal::Trace::Record(const char *category, const char *name, std::uint64_t start, std::uint64_t end)
+{
+   if (!IsActive())
+      return;
+   thread_local RThreadBuffer *buffer = GetRegistry().AddThread();
+   std::lock_guard<std::mutex> lock(buffer->fMutex);
+   buffer->fEvents[buffer->fNEvents++ % kBufferCapacity] = {category, name, start, end};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start recording the instrumented scopes. The trace is written to fileName
+/// by Disable(), which is called at the end of the process.
+
+void ROOT::Internal::Trace::Enable(const char *fileName)
+{
+   auto &registry = GetRegistry();
+   {
+      std::lock_guard<std::mutex> lock(registry.fMutex);
+      registry.fFileName = fileName ? fileName : "";
+      if (!registry.fStartTime)
+         registry.fStartTime = Now();
+      if (!registry.fAtExitRegistered) {
+         std::atexit(WriteAtExit);
+         registry.fAtExitRegistered = true;
+      }
+   }
+   gTraceActive = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stop recording and write the trace to the file given to Enable(), if any.
+
+void ROOT::Internal::Trace::Disable()
+{
+   if (!gTraceActive.exchange(false))
+      return;
+   auto &registry = GetRegistry();
+   std::string fileName;
+   {
+      std::lock_guard<std::mutex> lock(registry.fMutex);
+      fileName = registry.fFileName;
+   }
+   if (!fileName.empty())
+      WriteTrace(fileName.c_str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the scopes recorded so far in the Chrome trace event format, with
+/// time stamps in microseconds since tracing was first enabled.
+/// Returns false if the file cannot be written.
+
+bool ROOT::Internal::Trace::WriteTrace(const char *fileName)
+{
+   std::unique_ptr<FILE, decltype(&std::fclose)> file(std::fopen(fileName, "w"), &std::fclose);
+   if (!file) {
+      ::Error("ROOT::Internal::Trace::WriteTrace", "cannot open trace file %s", fileName);
+      return false;
+   }
+
+   auto &registry = GetRegistry();
+   std::lock_guard<std::mutex> lock(registry.fMutex);
+   const auto pid = getpid();
+   std::uint64_t nDropped = 0;
+   const char *sep = "";
+   std::fprintf(file.get(), "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+   for (auto &buffer : registry.fBuffers) {
+      std::lock_guard<std::mutex> bufferLock(buffer->fMutex);
+      std::fprintf(file.get(), "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%u,"
+                               "\"args\":{\"name\":\"ROOT thread %u\"}}",
+                   sep, int(pid), buffer->fThreadId, buffer->fThreadId);
+      sep = ",";
+      const std::uint64_t first = buffer->fNEvents > kBufferCapacity ? buffer->fNEvents - kBufferCapacity : 0;
+      nDropped += first;
+      for (auto i = first; i < buffer->fNEvents; ++i) {
+         const auto &event = buffer->fEvents[i % kBufferCapacity];
+         const double ts = event.fStart > registry.fStartTime ? (event.fStart - registry.fStartTime) * 1e-3 : 0.;
+         std::fprintf(file.get(), ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                                  "\"pid\":%d,\"tid\":%u}",
+                      EscapeJSON(event.fName).c_str(), EscapeJSON(event.fCategory).c_str(), ts,
+                      (event.fEnd - event.fStart) * 1e-3, int(pid), buffer->fThreadId);
+      }
+   }
+   std::fprintf(file.get(), "\n]}\n");
+
+   if (nDropped)
+      ::Warning("ROOT::Internal::Trace::WriteTrace", "%llu early scopes were dropped from the full ring buffers",
+                (unsigned long long)nDropped);
+   return !std::ferror(file.get());
+}
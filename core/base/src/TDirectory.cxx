@@ -237,7 +237,7 @@ void TDirectory::Browse(TBrowser *b)
 
 void TDirectory::BuildDirectory(TFile* /*motherFile*/, TDirectory* motherDir)
 {
-   fList       = new THashList(100,50);
+   fList       = new THashList(100,3);
    fList->UseRWLock();
    fMother     = motherDir;
    SetBit(kCanDelete);
@@ -50,10 +50,15 @@ class hierarchies (watch out for overlaps).
 #include "TMemberInspector.h"
 #include "TRefTable.h"
 #include "TProcessID.h"
+#include "ROOT/RMemoryAccounting.hxx"
 
 Long_t TObject::fgDtorOnly = 0;
 Bool_t TObject::fgObjectStat = kTRUE;
 
+// Whether the objects are kept in the TObjectTable. fgObjectStat is also set while the
+// construction of objects is sampled by ROOT::Experimental::RMemoryAccounting.
+static Bool_t gFillObjectTable = kTRUE;
+
 ClassImp(TObject);
 
 
@@ -87,17 +92,22 @@ TObject::~TObject()
 
    fBits &= ~kNotDeleted;
 
-   if (fgObjectStat && gObjectTable) gObjectTable->RemoveQuietly(this);
+   if (fgObjectStat) {
+      if (gFillObjectTable && gObjectTable) gObjectTable->RemoveQuietly(this);
+      ROOT::Experimental::RMemoryAccounting::ForgetObject(this);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Private helper function which will dispatch to
-/// TObjectTable::AddObj.
+/// TObjectTable::AddObj and to the sampling of RMemoryAccounting.
 /// Included here to avoid circular dependency between header files.
 
 void TObject::AddToTObjectTable(TObject *op)
 {
-   TObjectTable::AddObj(op);
+   ROOT::Experimental::RMemoryAccounting::SampleObject(op);
+   if (gFillObjectTable)
+      TObjectTable::AddObj(op);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -963,14 +973,15 @@ void TObject::Obsolete(const char *method, const char *asOfVers, const char *rem
 
 Bool_t TObject::GetObjectStat()
 {
-   return fgObjectStat;
+   return gFillObjectTable;
 }
 ////////////////////////////////////////////////////////////////////////////////
 /// Turn on/off tracking of objects in the TObjectTable.
 
 void TObject::SetObjectStat(Bool_t stat)
 {
-   fgObjectStat = stat;
+   gFillObjectTable = stat;
+   fgObjectStat = stat || ROOT::Experimental::RMemoryAccounting::IsSampling();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
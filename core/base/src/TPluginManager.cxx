@@ -97,7 +97,12 @@ TFile, TSQLServer, TGrid, etc. functionality.
 #include "TObjArray.h"
 #include "ThreadLocalStorage.h"
 
+#include <cctype>
+#include <fstream>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
 
 TPluginManager *gPluginMgr;   // main plugin manager created in TROOT
 
@@ -108,6 +113,111 @@ static bool &TPH__IsReadingDirs() {
    return readingDirs;
 }
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Parse a plugin macro that only consists of `gPluginMgr->AddHandler()` calls
+/// with string literal arguments, as most macros in `$ROOTSYS/etc/plugins` do,
+/// and return the arguments of each call in `handlers`. Return false if the
+/// macro contains anything else, in which case it must be interpreted.
+
+bool ParseHandlerMacro(const char *path, std::vector<std::vector<std::string>> &handlers)
+{
+   std::ifstream file(path);
+   if (!file)
+      return false;
+   std::stringstream buffer;
+   buffer << file.rdbuf();
+   const std::string text = buffer.str();
+
+   // remove the comments
+   std::string code;
+   for (std::size_t i = 0; i < text.size(); ++i) {
+      if (text.compare(i, 2, "//") == 0) {
+         i = text.find('\n', i);
+         if (i == std::string::npos)
+            break;
+      } else if (text.compare(i, 2, "/*") == 0) {
+         i = text.find("*/", i + 2);
+         if (i == std::string::npos)
+            return false;
+         ++i;
+         code += ' ';
+         continue;
+      } else if (text[i] == '"') {
+         // copy string literals verbatim, they can contain "//"
+         const auto end = text.find('"', i + 1);
+         if (end == std::string::npos)
+            return false;
+         code.append(text, i, end - i + 1);
+         i = end;
+         continue;
+      }
+      code += text[i];
+   }
+
+   std::size_t pos = 0;
+   auto skipSpaces = [&]() {
+      while (pos < code.size() && std::isspace(code[pos]))
+         ++pos;
+   };
+   auto expect = [&](const char *token) {
+      skipSpaces();
+      const auto len = strlen(token);
+      if (code.compare(pos, len, token) != 0)
+         return false;
+      pos += len;
+      return true;
+   };
+   auto parseIdentifier = [&]() {
+      skipSpaces();
+      const auto start = pos;
+      while (pos < code.size() && (std::isalnum(code[pos]) || code[pos] == '_'))
+         ++pos;
+      return pos > start;
+   };
+   // a string literal, or adjacent ones, without escape sequences
+   auto parseString = [&](std::string &str) {
+      skipSpaces();
+      if (pos >= code.size() || code[pos] != '"')
+         return false;
+      str.clear();
+      while (pos < code.size() && code[pos] == '"') {
+         const auto end = code.find('"', pos + 1);
+         str.append(code, pos + 1, end - pos - 1);
+         if (str.find('\\') != std::string::npos)
+            return false;
+         pos = end + 1;
+         skipSpaces();
+      }
+      return true;
+   };
+
+   if (!expect("void") || !parseIdentifier() || !expect("(") || !expect(")") || !expect("{"))
+      return false;
+   while (!expect("}")) {
+      if (!expect("gPluginMgr") || !expect("->") || !expect("AddHandler") || !expect("("))
+         return false;
+      std::vector<std::string> args(1);
+      while (true) {
+         if (!parseString(args.back()))
+            return false;
+         if (expect(")"))
+            break;
+         if (!expect(","))
+            return false;
+         args.emplace_back();
+      }
+      if (!expect(";") || args.size() < 4 || args.size() > 6)
+         return false;
+      handlers.emplace_back(std::move(args));
+   }
+   skipSpaces();
+   return pos == code.size();
+}
+
+} // unnamed namespace
+
 ClassImp(TPluginHandler);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -412,12 +522,23 @@ void TPluginManager::LoadHandlerMacros(const char *path)
       while ((s = (TObjString*)next())) {
          if (gDebug > 1)
             Info("LoadHandlerMacros", "   plugin macro: %s", s->String().Data());
+         // only start the interpreter for the macros that do more than adding handlers
+         std::vector<std::vector<std::string>> handlers;
+         if (ParseHandlerMacro(s->String(), handlers)) {
+            for (auto &h : handlers) {
+               h.resize(6);
+               AddHandler(h[0].c_str(), h[1].c_str(), h[2].c_str(), h[3].c_str(), h[4].c_str(),
+                          h[5].empty() ? s->String().Data() : h[5].c_str());
+            }
+            continue;
+         }
          Long_t res;
          if ((res = gROOT->Macro(s->String(), 0, kFALSE)) < 0) {
             Error("LoadHandlerMacros", "pluging macro %s returned %ld",
                   s->String().Data(), res);
          }
       }
+      ROOT::Internal::TraceStartup(TString::Format("plugin macros in %s", path));
    }
    gSystem->FreeDirectory(dirp);
 }
@@ -431,7 +552,9 @@ void TPluginManager::LoadHandlerMacros(const char *path)
 /// the directory must have the name NameSpace@@BaseClass as : is a reserved
 /// pathname character on some operating systems. Macros not beginning with
 /// 'P' and ending with ".C" are ignored. If base is specified only plugin
-/// macros for that base class are loaded. The macros typically
+/// macros for that base class are loaded. Macros that only consist of
+/// AddHandler() calls with string literal arguments are parsed directly,
+/// the others are executed by the interpreter. The macros typically
 /// should look like:
 /// ~~~ {.cpp}
 ///   void P10_TDCacheFile()
@@ -539,7 +662,7 @@ void TPluginManager::AddHandler(const char *base, const char *regexp,
    // make sure there is no previous handler for the same case
    RemoveHandler(base, regexp);
 
-   if (TPH__IsReadingDirs())
+   if (TPH__IsReadingDirs() && !origin)
       origin = gInterpreter->GetCurrentMacroName();
 
    TPluginHandler *h = new TPluginHandler(base, regexp, className,
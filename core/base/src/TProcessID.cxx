@@ -39,6 +39,13 @@ its own fUniqueID to find the pointer to the referenced object.
 See TProcessID::GetObjectWithID and PutObjectWithID.
 
 When a referenced object is deleted, its slot in fObjects is set to null.
+
+The lookups done when resolving a TRef take no lock, so that threads reading
+referenced objects do not serialize on them: the TProcessIDs whose index fits
+in the unique ID of the objects are found in a lock-free table, the validity of
+a TProcessID is cached per thread, and a table of objects that must grow is
+replaced by a larger copy, the previous one being kept until the TProcessID is
+deleted so that a concurrent GetObjectWithID() never reads freed memory.
 //
 See also TProcessUUID: a specialized TProcessID to manage the single list
 of TUUIDs.
@@ -52,6 +59,8 @@ of TUUIDs.
 #include "TError.h"
 #include "snprintf.h"
 
+#include <algorithm>
+
 TObjArray  *TProcessID::fgPIDs   = nullptr; //pointer to the list of TProcessID
 TProcessID *TProcessID::fgPID    = nullptr; //pointer to the TProcessID of the current session
 std::atomic_uint TProcessID::fgNumber(0); //Current referenced object instance count
@@ -59,9 +68,17 @@ TExMap     *TProcessID::fgObjPIDs = nullptr; //Table (pointer,pids)
 
 ClassImp(TProcessID);
 
-static std::atomic<TProcessID *> gIsValidCache;
-using PIDCacheContent_t = std::pair<Int_t, TProcessID*>;
-static std::atomic<PIDCacheContent_t *> gGetProcessWithUIDCache;
+namespace {
+
+/// TProcessIDs with the indices 0 to 254 in fgPIDs, i.e. the ones encoded in the
+/// unique ID of the objects. A slot is filled under the read lock of gCoreMutex and
+/// cleared under its write lock, when the TProcessID is deleted.
+std::atomic<TProcessID *> gPIDTable[255];
+
+/// Incremented when a TProcessID is deleted, to invalidate the per thread caches of IsValid()
+std::atomic<UInt_t> gPIDGeneration(0);
+
+} // anonymous namespace
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Return hash value for this object.
@@ -97,17 +114,14 @@ TProcessID::~TProcessID()
    delete fObjects;
    fObjects = 0;
 
-   TProcessID *This = this; // We need a referencable value for the 1st argument
-   gIsValidCache.compare_exchange_strong(This, nullptr);
-
-   auto current = gGetProcessWithUIDCache.load();
-   if (current && current->second == this) {
-      gGetProcessWithUIDCache.compare_exchange_strong(current, nullptr);
-      delete current;
-   }
-
    R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
+   for (auto &slot : gPIDTable) {
+      TProcessID *This = this; // We need a referencable value for the 1st argument
+      slot.compare_exchange_strong(This, nullptr);
+   }
    fgPIDs->Remove(this);
+   // after the removal, so that IsValid() cannot cache this TProcessID again
+   ++gPIDGeneration;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -206,6 +220,8 @@ void TProcessID::Cleanup()
    R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
    fgPIDs->Delete();
+   for (auto &slot : gPIDTable)
+      slot = nullptr;
    gROOT->GetListOfCleanups()->Remove(fgPIDs);
    delete fgPIDs;
    fgPIDs = 0;
@@ -229,6 +245,7 @@ void TProcessID::Clear(Option_t *)
       }
    }
    delete fObjects; fObjects = 0;
+   fRetiredObjects.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -275,17 +292,13 @@ TProcessID *TProcessID::GetProcessWithUID(UInt_t uid, const void *obj)
       pid = fgObjPIDs->GetValue(hash,(Long_t)obj);
       return (TProcessID*)fgPIDs->At(pid);
    } else {
-      auto current = gGetProcessWithUIDCache.load();
-      if (current && current->first == pid)
-         return current->second;
+      if (auto res = gPIDTable[pid].load(std::memory_order_acquire))
+         return res;
 
       R__READ_LOCKGUARD(ROOT::gCoreMutex);
-      auto res = (TProcessID*)fgPIDs->At(pid);
-
-      auto next = new PIDCacheContent_t(pid, res);
-      auto old = gGetProcessWithUIDCache.exchange(next);
-      delete old;
-
+      auto res = fgPIDs ? (TProcessID*)fgPIDs->At(pid) : nullptr;
+      if (res)
+         gPIDTable[pid].store(res, std::memory_order_release);
       return res;
    }
 }
@@ -333,8 +346,9 @@ TObject *TProcessID::GetObjectWithID(UInt_t uidd)
 {
    Int_t uid = uidd & 0xffffff;  //take only the 24 lower bits
 
-   if (fObjects==0 || uid >= fObjects->GetSize()) return 0;
-   return fObjects->UncheckedAt(uid);
+   TObjArray *objects = fObjects;
+   if (objects==0 || uid >= objects->GetSize()) return 0;
+   return objects->UncheckedAt(uid);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -356,21 +370,33 @@ TObjArray *TProcessID::GetPIDs()
 
 ////////////////////////////////////////////////////////////////////////////////
 /// static function. return kTRUE if pid is a valid TProcessID
+/// The last TProcessIDs found valid by a thread are cached without lock
+/// until a TProcessID is deleted.
 
 Bool_t TProcessID::IsValid(TProcessID *pid)
 {
-   if (gIsValidCache == pid)
-      return kTRUE;
+   struct TValidCache {
+      TProcessID *fPIDs[4] = {nullptr, nullptr, nullptr, nullptr};
+      UInt_t fGeneration = 0;
+      UInt_t fNext = 0;
+   };
+   thread_local TValidCache cache;
+
+   const UInt_t generation = gPIDGeneration.load(std::memory_order_acquire);
+   if (cache.fGeneration != generation) {
+      cache = TValidCache();
+      cache.fGeneration = generation;
+   }
+   for (auto valid : cache.fPIDs) {
+      if (valid && valid == pid)
+         return kTRUE;
+   }
 
    R__READ_LOCKGUARD(ROOT::gCoreMutex);
 
    if (fgPIDs==0) return kFALSE;
-   if (fgPIDs->IndexOf(pid) >= 0) {
-      gIsValidCache = pid;
-      return kTRUE;
-   }
-    if (pid == (TProcessID*)gROOT->GetUUIDs()) {
-      gIsValidCache = pid;
+   if (fgPIDs->IndexOf(pid) >= 0 || pid == (TProcessID*)gROOT->GetUUIDs()) {
+      cache.fPIDs[cache.fNext++ % 4] = pid;
       return kTRUE;
    }
    return kFALSE;
@@ -387,7 +413,17 @@ void TProcessID::PutObjectWithID(TObject *obj, UInt_t uid)
    if (uid == 0) uid = obj->GetUniqueID() & 0xffffff;
 
    if (!fObjects) fObjects = new TObjArray(100);
-   fObjects->AddAtAndExpand(obj,uid);
+   if (Int_t(uid) >= fObjects->GetSize()) {
+      // Replace the table by a larger copy instead of expanding it in place,
+      // as GetObjectWithID() may be reading it from another thread
+      TObjArray *objects = fObjects;
+      auto grown = new TObjArray(std::max(2 * objects->GetSize(), Int_t(uid) + 1));
+      for (Int_t i = 0; i <= objects->GetLast(); ++i)
+         grown->AddAt(objects->UncheckedAt(i), i);
+      fObjects = grown;
+      fRetiredObjects.emplace_back(objects);
+   }
+   fObjects->AddAt(obj,uid);
 
    obj->SetBit(kMustCleanup);
    if ( (obj->GetUniqueID()&0xff000000)==0xff000000 ) {
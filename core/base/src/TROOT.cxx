@@ -67,6 +67,7 @@ of a main program creating an interactive version is shown below:
 */
 
 #include <ROOT/RConfig.hxx>
+#include <ROOT/RMemoryAccounting.hxx>
 #include <ROOT/TErrorDefaultHandler.hxx>
 #include "RConfigure.h"
 #include "RConfigOptions.h"
@@ -75,6 +76,8 @@ of a main program creating an interactive version is shown below:
 #include <string>
 #include <map>
 #include <cstdlib>
+#include <chrono>
+#include <mutex>
 #ifdef WIN32
 #include <io.h>
 #include "Windows4Root.h"
@@ -132,6 +135,7 @@ FARPROC dlsym(void *library, const char *function_name)
 #include "TGlobal.h"
 #include "TFunction.h"
 #include "TVirtualPad.h"
+#include "TVirtualPS.h"
 #include "TBrowser.h"
 #include "TSystemDirectory.h"
 #include "TApplication.h"
@@ -433,6 +437,34 @@ namespace Internal {
 #endif
    }
 
+   //////////////////////////////////////////////////////////////////////////////
+   /// If the environment variable ROOT_STARTUP_TRACE is set, print to stderr the
+   /// time elapsed since the construction of gROOT started and since the previous
+   /// phase, e.g. to track regressions of the startup time:
+   /// ~~~
+   /// $ ROOT_STARTUP_TRACE=1 root -b -q
+   /// [ROOT startup]      0.0 ms (+    0.0 ms) start of TROOT::TROOT
+   /// [ROOT startup]      2.1 ms (+    2.1 ms) TROOT::InitSystem
+   /// ...
+   /// ~~~
+   void TraceStartup(const char *phase)
+   {
+      using Clock_t = std::chrono::steady_clock;
+      // gSystem might not exist yet
+      static const bool enabled = getenv("ROOT_STARTUP_TRACE") != nullptr;
+      if (!enabled)
+         return;
+      static std::mutex mutex;
+      std::lock_guard<std::mutex> lock(mutex);
+      static const Clock_t::time_point start = Clock_t::now();
+      static Clock_t::time_point last = start;
+      const auto now = Clock_t::now();
+      fprintf(stderr, "[ROOT startup] %8.1f ms (+%7.1f ms) %s\n",
+              std::chrono::duration<double, std::milli>(now - start).count(),
+              std::chrono::duration<double, std::milli>(now - last).count(), phase);
+      last = now;
+   }
+
    //////////////////////////////////////////////////////////////////////////////
    /// Returns true if parallel branch processing is enabled.
    Bool_t IsParBranchProcessingEnabled()
@@ -457,6 +489,28 @@ namespace Internal {
       return isImplicitMTEnabled;
    }
 
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Call func(i, arg) for every i in [0, n). The calls are distributed over
+   /// the implicit multi-threading pool if IMT is enabled, and done one after
+   /// the other in the calling thread otherwise. Allows libraries that cannot
+   /// depend on libImt, e.g. the compression code of libCore, to run
+   /// independent tasks in parallel.
+   void ImplicitMTForEach(UInt_t n, void (*func)(UInt_t, void *), void *arg)
+   {
+#ifdef R__USE_IMT
+      if (n > 1 && IsImplicitMTEnabledImpl()) {
+         static void (*sym)(UInt_t, void (*)(UInt_t, void *), void *) =
+            (void (*)(UInt_t, void (*)(UInt_t, void *), void *))GetSymInLibImt("ROOT_TImplicitMT_ForEach");
+         if (sym) {
+            sym(n, func, arg);
+            return;
+         }
+      }
+#endif
+      for (UInt_t i = 0; i < n; ++i)
+         func(i, arg);
+   }
+
 } // end of Internal sub namespace
 // back to ROOT namespace
 
@@ -480,12 +534,15 @@ namespace Internal {
    /// - concurrent calls to the interpreter through gInterpreter
    /// - concurrent loading of ROOT plug-ins
    ///
-   /// In addition, gDirectory, gFile and gPad become a thread-local variable.
+   /// In addition, gDirectory, gFile, gPad and gVirtualPS become a thread-local variable.
    /// In all threads, gDirectory defaults to gROOT, a singleton which supports thread-safe insertion and deletion of contents.
-   /// gFile and gPad default to nullptr, as it is for single-thread programs.
+   /// gFile, gPad and gVirtualPS default to nullptr, as it is for single-thread programs.
    ///
-   /// The ROOT graphics subsystem is not made thread-safe by this method. In particular drawing or printing different
-   /// canvases from different threads (and analogous operations such as invoking `Draw` on a `TObject`) is not thread-safe.
+   /// The ROOT graphics subsystem is not made thread-safe by this method, with one exception: in batch mode, canvases
+   /// created, drawn and saved to image, SVG, PDF or PostScript files by one thread can be processed at the same time
+   /// as the ones of other threads, e.g. to produce many plots with ROOT::TThreadExecutor. Objects must not be shared
+   /// between the canvases of different threads. Interactive drawing of different canvases from different threads
+   /// (and analogous operations such as invoking `Draw` on a `TObject` with a graphics backend) is not thread-safe.
    ///
    /// Note that there is no `DisableThreadSafety()`. ROOT's thread-safety features cannot be disabled once activated.
    // clang-format on
@@ -577,6 +634,35 @@ namespace Internal {
    {
       return GetThreadPoolSize();
    }
+
+   static Bool_t &GetLightweightObjectsMode()
+   {
+      TTHREAD_TLS(Bool_t) lightweight = kFALSE;
+      return lightweight;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Returns true if the current thread is within the scope of a
+   /// TLightweightObjectsGuard requesting lightweight objects.
+   Bool_t IsLightweightObjectsMode()
+   {
+      return GetLightweightObjectsMode();
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Switch the lightweight objects mode of the current thread on (or off,
+   /// if `lightweight` is false) until the destruction of the guard.
+   TLightweightObjectsGuard::TLightweightObjectsGuard(Bool_t lightweight) : fOldMode(GetLightweightObjectsMode())
+   {
+      GetLightweightObjectsMode() = lightweight;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Restore the lightweight objects mode in use before the guard was created.
+   TLightweightObjectsGuard::~TLightweightObjectsGuard()
+   {
+      GetLightweightObjectsMode() = fOldMode;
+   }
 } // end of ROOT namespace
 
 TROOT *ROOT::Internal::gROOTLocal = ROOT::GetROOT();
@@ -648,6 +734,8 @@ TROOT::TROOT(const char *name, const char *title, VoidFuncPtr_t *initfunc)
 
    R__LOCKGUARD(gROOTMutex);
 
+   ROOT::Internal::TraceStartup("start of TROOT::TROOT");
+
    ROOT::Internal::gROOTLocal = this;
    gDirectory = 0;
 
@@ -663,6 +751,7 @@ TROOT::TROOT(const char *name, const char *title, VoidFuncPtr_t *initfunc)
 
    // Initialize Operating System interface
    InitSystem();
+   ROOT::Internal::TraceStartup("TROOT::InitSystem");
 
    // Initialize static directory functions
    GetRootSys();
@@ -709,6 +798,7 @@ TROOT::TROOT(const char *name, const char *title, VoidFuncPtr_t *initfunc)
    if (!dlsym(RTLD_DEFAULT, "usedToIdentifyRootClingByDlSym")) {
       // initialize plugin manager early
       fPluginManager->LoadHandlersFromEnv(gEnv);
+      ROOT::Internal::TraceStartup("plugin handlers from the rootrc files");
    }
 
    TSystemDirectory *workdir = new TSystemDirectory("workdir", gSystem->WorkingDirectory());
@@ -843,6 +933,7 @@ TROOT::TROOT(const char *name, const char *title, VoidFuncPtr_t *initfunc)
    atexit(CleanUpROOTAtExit);
 
    ROOT::Internal::gGetROOT = &ROOT::Internal::GetROOT2;
+   ROOT::Internal::TraceStartup("end of TROOT::TROOT");
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1732,6 +1823,7 @@ TCollection *TROOT::GetListOfGlobals(Bool_t load)
 
       TGlobalMappedFunction::MakeFunctor("gPad", "TVirtualPad*", TVirtualPad::Pad);
       TGlobalMappedFunction::MakeFunctor("gVirtualX", "TVirtualX*", TVirtualX::Instance);
+      TGlobalMappedFunction::MakeFunctor("gVirtualPS", "TVirtualPS*", TVirtualPS::PS);
       TGlobalMappedFunction::MakeFunctor("gDirectory", "TDirectory*", TDirectory::CurrentDirectory);
 
       // Don't let TGlobalMappedFunction delete our globals, now that we take them.
@@ -1986,6 +2078,8 @@ void TROOT::InitSystem()
       { TUrl dummy("/dummy"); }
 #endif
       TObject::SetObjectStat(gEnv->GetValue("Root.ObjectStat", 0));
+      if (Int_t interval = gEnv->GetValue("Root.MemoryAccounting", 0))
+         ROOT::Experimental::RMemoryAccounting::EnableSampling(interval);
    }
 }
 
@@ -2028,6 +2122,7 @@ void TROOT::InitInterpreter()
          exit(1);
       }
       dlerror();   // reset error message
+      ROOT::Internal::TraceStartup("load libRIO and libCling");
    } else {
       gInterpreterLib = RTLD_DEFAULT;
    }
@@ -2066,6 +2161,7 @@ void TROOT::InitInterpreter()
       nullptr};
 
    fInterpreter = CreateInterpreter(gInterpreterLib, interpArgs);
+   ROOT::Internal::TraceStartup("TCling::TCling");
 
    fCleanups->Add(fInterpreter);
    fInterpreter->SetBit(kMustCleanup);
@@ -2093,8 +2189,10 @@ void TROOT::InitInterpreter()
                                    li->fHasCxxModule);
    }
    GetModuleHeaderInfoBuffer().clear();
+   ROOT::Internal::TraceStartup("registration of the dictionaries");
 
    fInterpreter->Initialize();
+   ROOT::Internal::TraceStartup("TCling::Initialize");
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -381,10 +381,9 @@ TObject *TRef::GetObject() const
    if (!TProcessID::IsValid(fPID)) return 0;
    UInt_t uid = GetUniqueID();
 
-   //the reference may be in the TRefTable
+   //the reference may be in the TRefTable, which is the one of the calling thread
    TRefTable *table = TRefTable::GetRefTable();
    if (table) {
-      R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
       table->SetUID(uid, fPID);
       table->Notify();
    }
@@ -0,0 +1,85 @@
+#include "gtest/gtest.h"
+
+#include "ROOT/RMemoryAccounting.hxx"
+#include "TArrayD.h"
+#include "TNamed.h"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ROOT::Experimental::RMemoryAccounting;
+
+static std::int64_t GetSubsystemBytes(RMemoryAccounting::ESubsystem subsystem)
+{
+   return RMemoryAccounting::GetSubsystemUsage()[static_cast<std::size_t>(subsystem)].fBytes;
+}
+
+static std::int64_t GetClassCount(const std::string &className)
+{
+   for (const auto &usage : RMemoryAccounting::GetClassUsage()) {
+      if (usage.fName == className)
+         return usage.fCount;
+   }
+   return 0;
+}
+
+TEST(RMemoryAccounting, Subsystems)
+{
+   const auto kHistograms = RMemoryAccounting::ESubsystem::kHistograms;
+   const auto before = GetSubsystemBytes(kHistograms);
+   {
+      TArrayD array(1000);
+      EXPECT_EQ(before + 8000, GetSubsystemBytes(kHistograms));
+      array.Set(500);
+      EXPECT_EQ(before + 4000, GetSubsystemBytes(kHistograms));
+   }
+   EXPECT_EQ(before, GetSubsystemBytes(kHistograms));
+
+   // Memory freed by another thread than the one that allocated it
+   auto array = std::make_unique<TArrayD>(100);
+   std::thread([&array] { array.reset(); }).join();
+   EXPECT_EQ(before, GetSubsystemBytes(kHistograms));
+
+   EXPECT_STREQ("histograms", RMemoryAccounting::GetSubsystemName(kHistograms));
+}
+
+TEST(RMemoryAccounting, Sampling)
+{
+   RMemoryAccounting::EnableSampling(1);
+   ASSERT_TRUE(RMemoryAccounting::IsSampling());
+   const auto before = GetClassCount("TNamed");
+
+   std::vector<std::unique_ptr<TNamed>> objects;
+   for (int i = 0; i < 10; ++i)
+      objects.emplace_back(new TNamed("name", "title"));
+   TNamed onStack("name", "title");
+   EXPECT_EQ(before + 10, GetClassCount("TNamed"));
+
+   objects.resize(4);
+   EXPECT_EQ(before + 4, GetClassCount("TNamed"));
+
+   // Objects constructed and destroyed by several threads
+   std::vector<std::thread> threads;
+   for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([] {
+         for (int i = 0; i < 1000; ++i) {
+            auto obj = new TNamed("name", "title");
+            delete obj;
+         }
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+   EXPECT_EQ(before + 4, GetClassCount("TNamed"));
+
+   const auto json = RMemoryAccounting::GetJSON();
+   EXPECT_NE(std::string::npos, json.find("\"name\":\"TNamed\""));
+   EXPECT_NE(std::string::npos, json.find("\"name\":\"histograms\""));
+
+   RMemoryAccounting::DisableSampling();
+   EXPECT_FALSE(RMemoryAccounting::IsSampling());
+   EXPECT_EQ(0, GetClassCount("TNamed"));
+   objects.clear();
+}
@@ -33,6 +33,7 @@ class TArray {
 protected:
    Bool_t        BoundsOk(const char *where, Int_t at) const;
    Bool_t        OutOfBoundsError(const char *where, Int_t i) const;
+   static void   AccountStorage(Long64_t nbytes);
 
 public:
    Int_t     fN;            //Number of array elements
@@ -48,6 +48,7 @@ private:
    Int_t       GetHashValue(const char *str) const { return ::Hash(str) % fSize; }
 
    void        AddImpl(Int_t slot, TObject *object);
+   void        AutoRehash(Int_t entries);
 
    THashTable(const THashTable&);             // not implemented
    THashTable& operator=(const THashTable&);  // not implemented
@@ -48,7 +48,6 @@ protected:
    TObject          *fOwner;      //Object owning this TRefTable
    std::vector<std::string> fProcessGUIDs; // UUIDs of TProcessIDs used in fParentIDs
    std::vector<Int_t> fMapPIDtoInternal;   //! cache of pid to index in fProcessGUIDs
-   static TRefTable *fgRefTable;  //Pointer to current TRefTable
 
    Int_t              AddInternalIdxForPID(TProcessID* procid);
    virtual Int_t      ExpandForIID(Int_t iid, Int_t newsize);
@@ -20,6 +20,7 @@ Data member is public for historical reasons.
 #include "TError.h"
 #include "TClass.h"
 #include "TBuffer.h"
+#include "ROOT/RMemoryAccounting.hxx"
 
 
 ClassImp(TArray);
@@ -33,6 +34,16 @@ Bool_t TArray::OutOfBoundsError(const char *where, Int_t i) const
    return kFALSE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Account nbytes allocated (or freed, if negative) for the array elements. The
+/// arrays are accounted as histogram memory by ROOT::Experimental::RMemoryAccounting,
+/// as they mainly hold the bin contents and errors of the TH1 histograms.
+
+void TArray::AccountStorage(Long64_t nbytes)
+{
+   ROOT::Experimental::RMemoryAccounting::Add(ROOT::Experimental::RMemoryAccounting::ESubsystem::kHistograms, nbytes);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read TArray object from buffer. Simplified version of
 /// TBuffer::ReadObject (does not keep track of multiple
@@ -70,6 +70,7 @@ TArrayC &TArrayC::operator=(const TArrayC &rhs)
 
 TArrayC::~TArrayC()
 {
+   if (fArray) AccountStorage(-fN * Long64_t(sizeof(Char_t)));
    delete [] fArray;
    fArray = 0;
 }
@@ -80,11 +81,14 @@ TArrayC::~TArrayC()
 
 void TArrayC::Adopt(Int_t n, Char_t *arr)
 {
-   if (fArray)
+   if (fArray) {
+      AccountStorage(-fN * Long64_t(sizeof(Char_t)));
       delete [] fArray;
+   }
 
    fN     = n;
    fArray = arr;
+   if (fArray) AccountStorage(fN * Long64_t(sizeof(Char_t)));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -109,6 +113,7 @@ void TArrayC::Set(Int_t n)
       Char_t *temp = fArray;
       if (n != 0) {
          fArray = new Char_t[n];
+         AccountStorage(n * Long64_t(sizeof(Char_t)));
          if (n < fN) memcpy(fArray,temp, n*sizeof(Char_t));
          else {
             memcpy(fArray,temp,fN*sizeof(Char_t));
@@ -117,7 +122,10 @@ void TArrayC::Set(Int_t n)
       } else {
          fArray = 0;
       }
-      if (fN) delete [] temp;
+      if (temp) {
+         AccountStorage(-fN * Long64_t(sizeof(Char_t)));
+         delete [] temp;
+      }
       fN = n;
    }
 }
@@ -129,13 +137,17 @@ void TArrayC::Set(Int_t n)
 void TArrayC::Set(Int_t n, const Char_t *array)
 {
    if (fArray && fN != n) {
+      AccountStorage(-fN * Long64_t(sizeof(Char_t)));
       delete [] fArray;
       fArray = 0;
    }
    fN = n;
    if (fN == 0) return;
    if (array == 0) return;
-   if (!fArray) fArray = new Char_t[fN];
+   if (!fArray) {
+      fArray = new Char_t[fN];
+      AccountStorage(fN * Long64_t(sizeof(Char_t)));
+   }
    memmove(fArray, array, n*sizeof(Char_t));
 }
 
@@ -70,6 +70,7 @@ TArrayD &TArrayD::operator=(const TArrayD &rhs)
 
 TArrayD::~TArrayD()
 {
+   if (fArray) AccountStorage(-fN * Long64_t(sizeof(Double_t)));
    delete [] fArray;
    fArray = 0;
 }
@@ -80,11 +81,14 @@ TArrayD::~TArrayD()
 
 void TArrayD::Adopt(Int_t n, Double_t *arr)
 {
-   if (fArray)
+   if (fArray) {
+      AccountStorage(-fN * Long64_t(sizeof(Double_t)));
       delete [] fArray;
+   }
 
    fN     = n;
    fArray = arr;
+   if (fArray) AccountStorage(fN * Long64_t(sizeof(Double_t)));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -110,6 +114,7 @@ void TArrayD::Set(Int_t n)
       Double_t *temp = fArray;
       if (n != 0) {
          fArray = new Double_t[n];
+         AccountStorage(n * Long64_t(sizeof(Double_t)));
          if (n < fN) memcpy(fArray,temp, n*sizeof(Double_t));
          else {
             memcpy(fArray,temp,fN*sizeof(Double_t));
@@ -118,7 +123,10 @@ void TArrayD::Set(Int_t n)
       } else {
          fArray = 0;
       }
-      if (fN) delete [] temp;
+      if (temp) {
+         AccountStorage(-fN * Long64_t(sizeof(Double_t)));
+         delete [] temp;
+      }
       fN = n;
    }
 }
@@ -130,13 +138,17 @@ void TArrayD::Set(Int_t n)
 void TArrayD::Set(Int_t n, const Double_t *array)
 {
    if (fArray && fN != n) {
+      AccountStorage(-fN * Long64_t(sizeof(Double_t)));
       delete [] fArray;
       fArray = 0;
    }
    fN = n;
    if (fN == 0) return;
    if (array == 0) return;
-   if (!fArray) fArray = new Double_t[fN];
+   if (!fArray) {
+      fArray = new Double_t[fN];
+      AccountStorage(fN * Long64_t(sizeof(Double_t)));
+   }
    memmove(fArray, array, n*sizeof(Double_t));
 }
 
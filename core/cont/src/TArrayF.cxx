@@ -70,6 +70,7 @@ TArrayF &TArrayF::operator=(const TArrayF &rhs)
 
 TArrayF::~TArrayF()
 {
+   if (fArray) AccountStorage(-fN * Long64_t(sizeof(Float_t)));
    delete [] fArray;
    fArray = 0;
 }
@@ -80,11 +81,14 @@ TArrayF::~TArrayF()
 
 void TArrayF::Adopt(Int_t n, Float_t *arr)
 {
-   if (fArray)
+   if (fArray) {
+      AccountStorage(-fN * Long64_t(sizeof(Float_t)));
       delete [] fArray;
+   }
 
    fN     = n;
    fArray = arr;
+   if (fArray) AccountStorage(fN * Long64_t(sizeof(Float_t)));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -109,6 +113,7 @@ void TArrayF::Set(Int_t n)
       Float_t *temp = fArray;
       if (n != 0) {
          fArray = new Float_t[n];
+         AccountStorage(n * Long64_t(sizeof(Float_t)));
          if (n < fN) memcpy(fArray,temp, n*sizeof(Float_t));
          else {
             memcpy(fArray,temp,fN*sizeof(Float_t));
@@ -117,7 +122,10 @@ void TArrayF::Set(Int_t n)
       } else {
          fArray = 0;
       }
-      if (fN) delete [] temp;
+      if (temp) {
+         AccountStorage(-fN * Long64_t(sizeof(Float_t)));
+         delete [] temp;
+      }
       fN = n;
    }
 }
@@ -129,13 +137,17 @@ void TArrayF::Set(Int_t n)
 void TArrayF::Set(Int_t n, const Float_t *array)
 {
    if (fArray && fN != n) {
+      AccountStorage(-fN * Long64_t(sizeof(Float_t)));
       delete [] fArray;
       fArray = 0;
    }
    fN = n;
    if (fN == 0) return;
    if (array == 0) return;
-   if (!fArray) fArray = new Float_t[fN];
+   if (!fArray) {
+      fArray = new Float_t[fN];
+      AccountStorage(fN * Long64_t(sizeof(Float_t)));
+   }
    memmove(fArray, array, n*sizeof(Float_t));
 }
 
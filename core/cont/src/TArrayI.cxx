@@ -70,6 +70,7 @@ TArrayI &TArrayI::operator=(const TArrayI &rhs)
 
 TArrayI::~TArrayI()
 {
+   if (fArray) AccountStorage(-fN * Long64_t(sizeof(Int_t)));
    delete [] fArray;
    fArray = 0;
 }
@@ -80,11 +81,14 @@ TArrayI::~TArrayI()
 
 void TArrayI::Adopt(Int_t n, Int_t *arr)
 {
-   if (fArray)
+   if (fArray) {
+      AccountStorage(-fN * Long64_t(sizeof(Int_t)));
       delete [] fArray;
+   }
 
    fN     = n;
    fArray = arr;
+   if (fArray) AccountStorage(fN * Long64_t(sizeof(Int_t)));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -109,6 +113,7 @@ void TArrayI::Set(Int_t n)
       Int_t *temp = fArray;
       if (n != 0) {
          fArray = new Int_t[n];
+         AccountStorage(n * Long64_t(sizeof(Int_t)));
          if (n < fN) memcpy(fArray,temp, n*sizeof(Int_t));
          else {
             memcpy(fArray,temp,fN*sizeof(Int_t));
@@ -117,7 +122,10 @@ void TArrayI::Set(Int_t n)
       } else {
          fArray = 0;
       }
-      if (fN) delete [] temp;
+      if (temp) {
+         AccountStorage(-fN * Long64_t(sizeof(Int_t)));
+         delete [] temp;
+      }
       fN = n;
    }
 }
@@ -129,13 +137,17 @@ void TArrayI::Set(Int_t n)
 void TArrayI::Set(Int_t n, const Int_t *array)
 {
    if (fArray && fN != n) {
+      AccountStorage(-fN * Long64_t(sizeof(Int_t)));
       delete [] fArray;
       fArray = 0;
    }
    fN = n;
    if (fN == 0) return;
    if (array == 0) return;
-   if (!fArray) fArray = new Int_t[fN];
+   if (!fArray) {
+      fArray = new Int_t[fN];
+      AccountStorage(fN * Long64_t(sizeof(Int_t)));
+   }
    memmove(fArray, array, n*sizeof(Int_t));
 }
 
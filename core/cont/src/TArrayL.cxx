@@ -70,6 +70,7 @@ TArrayL &TArrayL::operator=(const TArrayL &rhs)
 
 TArrayL::~TArrayL()
 {
+   if (fArray) AccountStorage(-fN * Long64_t(sizeof(Long_t)));
    delete [] fArray;
    fArray = 0;
 }
@@ -80,11 +81,14 @@ TArrayL::~TArrayL()
 
 void TArrayL::Adopt(Int_t n, Long_t *arr)
 {
-   if (fArray)
+   if (fArray) {
+      AccountStorage(-fN * Long64_t(sizeof(Long_t)));
       delete [] fArray;
+   }
 
    fN     = n;
    fArray = arr;
+   if (fArray) AccountStorage(fN * Long64_t(sizeof(Long_t)));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -109,6 +113,7 @@ void TArrayL::Set(Int_t n)
       Long_t *temp = fArray;
       if (n != 0) {
          fArray = new Long_t[n];
+         AccountStorage(n * Long64_t(sizeof(Long_t)));
          if (n < fN) memcpy(fArray,temp, n*sizeof(Long_t));
          else {
             memcpy(fArray,temp,fN*sizeof(Long_t));
@@ -117,7 +122,10 @@ void TArrayL::Set(Int_t n)
       } else {
          fArray = 0;
       }
-      if (fN) delete [] temp;
+      if (temp) {
+         AccountStorage(-fN * Long64_t(sizeof(Long_t)));
+         delete [] temp;
+      }
       fN = n;
    }
 }
@@ -129,13 +137,17 @@ void TArrayL::Set(Int_t n)
 void TArrayL::Set(Int_t n, const Long_t *array)
 {
    if (fArray && fN != n) {
+      AccountStorage(-fN * Long64_t(sizeof(Long_t)));
       delete [] fArray;
       fArray = 0;
    }
    fN = n;
    if (fN == 0) return;
    if (array == 0) return;
-   if (!fArray) fArray = new Long_t[fN];
+   if (!fArray) {
+      fArray = new Long_t[fN];
+      AccountStorage(fN * Long64_t(sizeof(Long_t)));
+   }
    memmove(fArray, array, n*sizeof(Long_t));
 }
 
@@ -70,6 +70,7 @@ TArrayL64 &TArrayL64::operator=(const TArrayL64 &rhs)
 
 TArrayL64::~TArrayL64()
 {
+   if (fArray) AccountStorage(-fN * Long64_t(sizeof(Long64_t)));
    delete [] fArray;
    fArray = 0;
 }
@@ -80,11 +81,14 @@ TArrayL64::~TArrayL64()
 
 void TArrayL64::Adopt(Int_t n, Long64_t *arr)
 {
-   if (fArray)
+   if (fArray) {
+      AccountStorage(-fN * Long64_t(sizeof(Long64_t)));
       delete [] fArray;
+   }
 
    fN     = n;
    fArray = arr;
+   if (fArray) AccountStorage(fN * Long64_t(sizeof(Long64_t)));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -109,6 +113,7 @@ void TArrayL64::Set(Int_t n)
       Long64_t *temp = fArray;
       if (n != 0) {
          fArray = new Long64_t[n];
+         AccountStorage(n * Long64_t(sizeof(Long64_t)));
          if (n < fN) memcpy(fArray,temp, n*sizeof(Long64_t));
          else {
             memcpy(fArray,temp,fN*sizeof(Long64_t));
@@ -117,7 +122,10 @@ void TArrayL64::Set(Int_t n)
       } else {
          fArray = 0;
       }
-      if (fN) delete [] temp;
+      if (temp) {
+         AccountStorage(-fN * Long64_t(sizeof(Long64_t)));
+         delete [] temp;
+      }
       fN = n;
    }
 }
@@ -129,13 +137,17 @@ void TArrayL64::Set(Int_t n)
 void TArrayL64::Set(Int_t n, const Long64_t *array)
 {
    if (fArray && fN != n) {
+      AccountStorage(-fN * Long64_t(sizeof(Long64_t)));
       delete [] fArray;
       fArray = 0;
    }
    fN = n;
    if (fN == 0) return;
    if (array == 0) return;
-   if (!fArray) fArray = new Long64_t[fN];
+   if (!fArray) {
+      fArray = new Long64_t[fN];
+      AccountStorage(fN * Long64_t(sizeof(Long64_t)));
+   }
    memmove(fArray, array, n*sizeof(Long64_t));
 }
 
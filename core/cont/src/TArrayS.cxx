@@ -70,6 +70,7 @@ TArrayS &TArrayS::operator=(const TArrayS &rhs)
 
 TArrayS::~TArrayS()
 {
+   if (fArray) AccountStorage(-fN * Long64_t(sizeof(Short_t)));
    delete [] fArray;
    fArray = 0;
 }
@@ -80,11 +81,14 @@ TArrayS::~TArrayS()
 
 void TArrayS::Adopt(Int_t n, Short_t *arr)
 {
-   if (fArray)
+   if (fArray) {
+      AccountStorage(-fN * Long64_t(sizeof(Short_t)));
       delete [] fArray;
+   }
 
    fN     = n;
    fArray = arr;
+   if (fArray) AccountStorage(fN * Long64_t(sizeof(Short_t)));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -109,6 +113,7 @@ void TArrayS::Set(Int_t n)
       Short_t *temp = fArray;
       if (n != 0) {
          fArray = new Short_t[n];
+         AccountStorage(n * Long64_t(sizeof(Short_t)));
          if (n < fN) memcpy(fArray,temp, n*sizeof(Short_t));
          else {
             memcpy(fArray,temp,fN*sizeof(Short_t));
@@ -117,7 +122,10 @@ void TArrayS::Set(Int_t n)
       } else {
          fArray = 0;
       }
-      if (fN) delete [] temp;
+      if (temp) {
+         AccountStorage(-fN * Long64_t(sizeof(Short_t)));
+         delete [] temp;
+      }
       fN = n;
    }
 }
@@ -129,13 +137,17 @@ void TArrayS::Set(Int_t n)
 void TArrayS::Set(Int_t n, const Short_t *array)
 {
    if (fArray && fN != n) {
+      AccountStorage(-fN * Long64_t(sizeof(Short_t)));
       delete [] fArray;
       fArray = 0;
    }
    fN = n;
    if (fN == 0) return;
    if (array == 0) return;
-   if (!fArray) fArray = new Short_t[fN];
+   if (!fArray) {
+      fArray = new Short_t[fN];
+      AccountStorage(fN * Long64_t(sizeof(Short_t)));
+   }
    memmove(fArray, array, n*sizeof(Short_t));
 }
 
@@ -31,8 +31,8 @@ ClassImp(THashList);
 /// (i.e. number of slots), by default kInitHashTableCapacity = 17, and
 /// rehash is the value at which a rehash will be triggered. I.e. when the
 /// average size of the linked lists at a slot becomes longer than rehash
-/// then the hashtable will be resized and refilled to reduce the collision
-/// rate to about 1. The higher the collision rate, i.e. the longer the
+/// then the hashtable will be resized to twice the number of entries and
+/// refilled to reduce the collision rate below 1. The higher the collision rate, i.e. the longer the
 /// linked lists, the longer lookup will take. If rehash=0 the table will
 /// NOT automatically be rehashed. Use Rehash() for manual rehashing.
 ///
@@ -34,8 +34,8 @@ ClassImp(THashTable);
 /// (i.e. number of slots), by default kInitHashTableCapacity = 17, and
 /// rehashlevel is the value at which a rehash will be triggered. I.e. when
 /// the average size of the linked lists at a slot becomes longer than
-/// rehashlevel then the hashtable will be resized and refilled to reduce
-/// the collision rate to about 1. The higher the collision rate, i.e. the
+/// rehashlevel then the hashtable will be resized to twice the number of
+/// entries and refilled to reduce the collision rate below 1. The higher the collision rate, i.e. the
 /// longer the linked lists, the longer lookup will take. If rehashlevel=0
 /// the table will NOT automatically be rehashed. Use Rehash() for manual
 /// rehashing.
@@ -85,6 +85,17 @@ void THashTable::AddImpl(Int_t slot, TObject *obj)
    ++fEntries;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Rehash triggered by the rehash level. The table is resized to twice the
+/// number of entries, so that the collision rate drops well below 1 and the
+/// number of rehashes stays logarithmic in the number of entries, instead of
+/// refilling a table whose linked lists are about to grow again.
+
+void THashTable::AutoRehash(Int_t entries)
+{
+   Rehash(2 * entries);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Add object to the hash table. Its position in the table will be
 /// determined by the value returned by its Hash() function.
@@ -100,7 +111,7 @@ void THashTable::Add(TObject *obj)
    AddImpl(slot,obj);
 
    if (fRehashLevel && AverageCollisions() > fRehashLevel)
-      Rehash(fEntries);
+      AutoRehash(fEntries);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -128,7 +139,7 @@ void THashTable::AddBefore(const TObject *before, TObject *obj)
    fEntries++;
 
    if (fRehashLevel && AverageCollisions() > fRehashLevel)
-      Rehash(fEntries);
+      AutoRehash(fEntries);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -145,7 +156,7 @@ void THashTable::AddAll(const TCollection *col)
    Int_t sumEntries=fEntries+col->GetEntries();
    Bool_t rehashBefore=fRehashLevel && (sumEntries > fSize*fRehashLevel);
    if (rehashBefore)
-      Rehash(sumEntries);
+      AutoRehash(sumEntries);
 
    // prevent Add from Rehashing
    Int_t saveRehashLevel=fRehashLevel;
@@ -157,7 +168,7 @@ void THashTable::AddAll(const TCollection *col)
    // If we didn't Rehash before, we might have to do it
    // now, due to a non-perfect hash function.
    if (!rehashBefore && fRehashLevel && AverageCollisions() > fRehashLevel)
-      Rehash(fEntries);
+      AutoRehash(fEntries);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -35,6 +35,11 @@ all known TProcessIDs in fProcessGUIDs; the index of a TProcessID in
 this vector defines the index of the auto-loading info in fParentIDs
 for that TProcessID. The mapping of TProcessID* to index is cached
 for quick non-persistent lookup.
+
+The current TRefTable, used by TRef::GetObject to load the branch of a
+referenced object, is kept per thread, so that threads reading different
+trees (or clones of a tree) each resolve their references in their own
+TRefTable, without lock.
 */
 
 #include "TRefTable.h"
@@ -42,8 +47,52 @@ for quick non-persistent lookup.
 #include "TObjArray.h"
 #include "TProcessID.h"
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+/// The current TRefTable of a thread. The slots of all the threads are registered,
+/// so that a TRefTable being deleted can be removed from all of them.
+struct TCurrentRefTable;
+
+struct TCurrentRefTableRegistry {
+   std::mutex fMutex;
+   std::vector<TCurrentRefTable *> fSlots;
+};
+
+/// The registry is never deleted, as threads can exit during the destruction of static objects
+TCurrentRefTableRegistry &GetRegistry()
+{
+   static TCurrentRefTableRegistry *registry = new TCurrentRefTableRegistry;
+   return *registry;
+}
+
+struct TCurrentRefTable {
+   std::atomic<TRefTable *> fTable;
 
-TRefTable *TRefTable::fgRefTable = 0;
+   TCurrentRefTable() : fTable(nullptr)
+   {
+      auto &registry = GetRegistry();
+      std::lock_guard<std::mutex> lock(registry.fMutex);
+      registry.fSlots.push_back(this);
+   }
+   ~TCurrentRefTable()
+   {
+      auto &registry = GetRegistry();
+      std::lock_guard<std::mutex> lock(registry.fMutex);
+      registry.fSlots.erase(std::find(registry.fSlots.begin(), registry.fSlots.end(), this));
+   }
+};
+
+TCurrentRefTable &GetCurrent()
+{
+   thread_local TCurrentRefTable current;
+   return current;
+}
+
+} // anonymous namespace
 
 ClassImp(TRefTable);
 ////////////////////////////////////////////////////////////////////////////////
@@ -52,7 +101,7 @@ ClassImp(TRefTable);
 TRefTable::TRefTable() : fNumPIDs(0), fAllocSize(0), fN(0), fParentIDs(0), fParentID(-1),
                          fDefaultSize(10), fUID(0), fUIDContext(0), fSize(0), fParents(0), fOwner(0)
 {
-   fgRefTable   = this;
+   SetRefTable(this);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -62,7 +111,7 @@ TRefTable::TRefTable(TObject *owner, Int_t size) :
      fNumPIDs(0), fAllocSize(0), fN(0), fParentIDs(0), fParentID(-1),
      fDefaultSize(size<10 ? 10 : size), fUID(0), fUIDContext(0), fSize(0), fParents(new TObjArray(1)), fOwner(owner)
 {
-   fgRefTable   = this;
+   SetRefTable(this);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -77,7 +126,13 @@ TRefTable::~TRefTable()
    }
    delete [] fParentIDs;
    delete fParents;
-   if (fgRefTable == this) fgRefTable = 0;
+
+   auto &registry = GetRegistry();
+   std::lock_guard<std::mutex> lock(registry.fMutex);
+   for (auto slot : registry.fSlots) {
+      TRefTable *This = this; // We need a referencable value for the 1st argument
+      slot->fTable.compare_exchange_strong(This, nullptr);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -282,11 +337,11 @@ Int_t TRefTable::GetInternalIdxForPID(Int_t pid) const
 
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Static function returning the current TRefTable.
+/// Static function returning the current TRefTable of the calling thread.
 
 TRefTable *TRefTable::GetRefTable()
 {
-   return fgRefTable;
+   return GetCurrent().fTable.load(std::memory_order_relaxed);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -378,11 +433,12 @@ Int_t TRefTable::SetParent(const TObject* parent, Int_t branchID)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Static function setting the current TRefTable.
+/// Static function setting the current TRefTable of the calling thread.
+/// Each thread reading a tree with references uses the TRefTable of its own tree.
 
 void TRefTable::SetRefTable(TRefTable *table)
 {
-   fgRefTable = table;
+   GetCurrent().fTable.store(table, std::memory_order_relaxed);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,43 @@
+#include "THashList.h"
+#include "THashTable.h"
+#include "TNamed.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+// The table grows automatically once the rehash level is reached, keeping lookups correct and collisions low.
+TEST(THashTable, AutoRehash)
+{
+   THashTable table(17, 2);
+   table.SetOwner();
+   const int n = 10000;
+   for (int i = 0; i < n; ++i)
+      table.Add(new TNamed(("obj" + std::to_string(i)).c_str(), ""));
+
+   EXPECT_EQ(table.GetSize(), n);
+   EXPECT_LE(table.AverageCollisions(), 2.f);
+   for (int i = 0; i < n; i += 97) {
+      const auto name = "obj" + std::to_string(i);
+      auto obj = table.FindObject(name.c_str());
+      ASSERT_NE(obj, nullptr);
+      EXPECT_EQ(name, obj->GetName());
+   }
+   EXPECT_EQ(table.FindObject("obj-1"), nullptr);
+}
+
+// The list keeps the insertion order across the automatic rehashes of its table.
+TEST(THashList, AutoRehashKeepsOrder)
+{
+   THashList list(17, 2);
+   list.SetOwner();
+   const int n = 1000;
+   for (int i = 0; i < n; ++i)
+      list.Add(new TNamed(("obj" + std::to_string(i)).c_str(), ""));
+
+   int i = 0;
+   for (auto obj : list)
+      EXPECT_EQ("obj" + std::to_string(i++), obj->GetName());
+   EXPECT_EQ(i, n);
+   EXPECT_NE(list.FindObject("obj500"), nullptr);
+}
@@ -0,0 +1,94 @@
+#include "TNamed.h"
+#include "TProcessID.h"
+#include "TRef.h"
+#include "TRefTable.h"
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Each thread has its own current TRefTable
+TEST(TRefTable, CurrentPerThread)
+{
+   auto mainTable = std::make_unique<TRefTable>(nullptr, 10);
+   EXPECT_EQ(TRefTable::GetRefTable(), mainTable.get());
+
+   std::thread thread([&mainTable]() {
+      EXPECT_EQ(TRefTable::GetRefTable(), nullptr);
+      TRefTable threadTable(nullptr, 10);
+      EXPECT_EQ(TRefTable::GetRefTable(), &threadTable);
+      TRefTable::SetRefTable(mainTable.get());
+      EXPECT_EQ(TRefTable::GetRefTable(), mainTable.get());
+   });
+   thread.join();
+   EXPECT_EQ(TRefTable::GetRefTable(), mainTable.get());
+
+   mainTable.reset();
+   EXPECT_EQ(TRefTable::GetRefTable(), nullptr);
+}
+
+// A deleted TRefTable is no longer the current table of any thread
+TEST(TRefTable, DeletedInOtherThread)
+{
+   auto table = std::make_unique<TRefTable>(nullptr, 10);
+   std::atomic<int> step(0);
+   std::thread thread([&]() {
+      TRefTable::SetRefTable(table.get());
+      step = 1;
+      while (step != 2)
+         std::this_thread::yield();
+      EXPECT_EQ(TRefTable::GetRefTable(), nullptr);
+   });
+   while (step != 1)
+      std::this_thread::yield();
+   table.reset();
+   step = 2;
+   thread.join();
+}
+
+// References are resolved concurrently while new objects are referenced
+TEST(TProcessID, ConcurrentGetObject)
+{
+   ROOT::EnableThreadSafety();
+   ASSERT_NE(gROOT, nullptr); // creates the TProcessID of the session
+
+   const int n = 1000;
+   std::vector<std::unique_ptr<TNamed>> objects;
+   std::vector<TRef> refs;
+   for (int i = 0; i < n; ++i) {
+      objects.emplace_back(new TNamed("obj", ""));
+      refs.emplace_back(objects.back().get());
+   }
+
+   std::atomic<bool> done(false);
+   std::thread writer([&done]() {
+      // grow the table of objects of the session TProcessID
+      std::vector<std::unique_ptr<TNamed>> more;
+      for (int i = 0; i < 100000; ++i) {
+         more.emplace_back(new TNamed("more", ""));
+         TProcessID::AssignID(more.back().get());
+      }
+      done = true;
+   });
+
+   std::vector<std::thread> readers;
+   std::atomic<int> nErrors(0);
+   for (int t = 0; t < 4; ++t) {
+      readers.emplace_back([&]() {
+         do {
+            for (int i = 0; i < n; ++i) {
+               if (refs[i].GetObject() != objects[i].get())
+                  ++nErrors;
+            }
+         } while (!done);
+      });
+   }
+   writer.join();
+   for (auto &reader : readers)
+      reader.join();
+   EXPECT_EQ(nErrors, 0);
+}
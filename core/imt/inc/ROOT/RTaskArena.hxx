@@ -15,8 +15,9 @@
 //                                                                      //
 // This file implements the method to initialize and retrieve ROOT's    //
 // global task arena, together with a method to check for active        //
-// CPU bandwith control, and a class to wrap the tbb task arena with    //
-// the purpose of keeping tbb off the installed headers                 //
+// CPU bandwith control and for the NUMA topology, and a class to wrap //
+// the tbb task arena with the purpose of keeping tbb off the installed //
+// headers                                                              //
 //                                                                      //
 //////////////////////////////////////////////////////////////////////////
 
@@ -25,6 +26,7 @@
 
 #include "RConfigure.h"
 #include <memory>
+#include <vector>
 
 // exclude in case ROOT does not have IMT support
 #ifndef R__USE_IMT
@@ -54,6 +56,14 @@ namespace Internal {
 ////////////////////////////////////////////////////////////////////////////////
 int LogicalCPUBandwithControl();
 
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the logical cores of each NUMA domain of the machine.
+///
+///  - On linux, reads the core lists of the nodes in /sys/devices/system/node
+///  - Otherwise, or if the topology cannot be read, returns an empty vector
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::vector<int>> NUMADomainCores();
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Wrapper for tbb::task_arena.
@@ -65,12 +75,16 @@ class RTaskArenaWrapper {
 public:
    ~RTaskArenaWrapper(); // necessary to set size back to zero
    static unsigned TaskArenaSize(); // A static getter lets us check for RTaskArenaWrapper's existence
+   static unsigned NUMADomains(); // Number of NUMA domains the workers are pinned to, 0 if they are not pinned
    tbb::task_arena &Access();
 private:
+   class RNUMAPinning; // keeps the workers of the arena in their NUMA domain, see RTaskArena.cxx
    RTaskArenaWrapper(unsigned maxConcurrency = 0);
    friend std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> GetGlobalTaskArena(unsigned maxConcurrency);
    std::unique_ptr<tbb::task_arena> fTBBArena;
+   std::unique_ptr<RNUMAPinning> fNUMAPinning;
    static unsigned fNWorkers;
+   static unsigned fNNUMADomains;
 };
 
 
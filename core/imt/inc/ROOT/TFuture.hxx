@@ -16,8 +16,15 @@
 
 #include "ROOT/TTaskGroup.hxx"
 
-#include <type_traits>
+#include <atomic>
+#include <functional>
 #include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 // exclude in case ROOT does not have IMT support
 #ifndef R__USE_IMT
@@ -33,33 +40,117 @@ namespace ROOT {
 namespace Experimental {
 template <typename T>
 class TFuture;
+
+////////////////////////////////////////////////////////////////////////////////
+/// A token to request the cancellation of the continuations of TFutures.
+/// Copies share the same state: cancelling one cancels them all. The continuations
+/// scheduled with the token that did not start yet are not executed, and their futures
+/// hold a std::runtime_error instead. Running tasks can poll IsCancellationRequested()
+/// to stop early.
+class TCancellationToken {
+   std::shared_ptr<std::atomic<bool>> fCancelled = std::make_shared<std::atomic<bool>>(false);
+
+public:
+   void Cancel() { *fCancelled = true; }
+   bool IsCancellationRequested() const { return *fCancelled; }
+};
 }
 
 namespace Detail {
+////////////////////////////////////////////////////////////////////////////////
+/// The callbacks to invoke when the value of a TFuture is ready. They are invoked by the
+/// task that computed the value, right after it, so that no thread blocks on the future.
+class TFutureContinuations {
+   std::mutex fMutex;
+   bool fReady = false;
+   std::vector<std::function<void()>> fCallbacks;
+
+public:
+   /// Invoke the callback when the value is ready, or right away if it already is.
+   void Add(std::function<void()> callback)
+   {
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         if (!fReady) {
+            fCallbacks.emplace_back(std::move(callback));
+            return;
+         }
+      }
+      callback();
+   }
+
+   void SetReady()
+   {
+      std::vector<std::function<void()>> callbacks;
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fReady = true;
+         std::swap(callbacks, fCallbacks);
+      }
+      for (auto &callback : callbacks)
+         callback();
+   }
+};
+
 template <typename T>
 class TFutureImpl {
    template <typename V>
    friend class Experimental::TFuture;
+   template <typename V>
+   friend class TFutureImpl;
 
 protected:
    using TTaskGroup = Experimental::TTaskGroup;
    std::future<T> fStdFut;
-   std::unique_ptr<TTaskGroup> fTg{nullptr};
-
-   TFutureImpl(std::future<T> &&fut, std::unique_ptr<TTaskGroup> &&tg) : fStdFut(std::move(fut))
+   std::shared_ptr<TTaskGroup> fTg{nullptr};
+   /// Invoked when the value is ready: null if the future was built from a std::future
+   std::shared_ptr<TFutureContinuations> fContinuations{nullptr};
+   /// Wait for the futures this one is a continuation of, so that its task is scheduled
+   std::function<void()> fWaitPredecessors;
+
+   TFutureImpl(std::future<T> &&fut, std::shared_ptr<TTaskGroup> tg,
+               std::shared_ptr<TFutureContinuations> continuations, std::function<void()> waitPredecessors = {})
+      : fStdFut(std::move(fut)), fTg(std::move(tg)), fContinuations(std::move(continuations)),
+        fWaitPredecessors(std::move(waitPredecessors))
    {
-      fTg = std::move(tg);
-   };
+   }
    TFutureImpl(){};
 
    TFutureImpl(std::future<T> &&fut) : fStdFut(std::move(fut)) {}
 
-   TFutureImpl(TFutureImpl<T> &&other) : fStdFut(std::move(other.fStdFut)), fTg(std::move(other.fTg)) {}
+   TFutureImpl(TFutureImpl<T> &&other)
+      : fStdFut(std::move(other.fStdFut)), fTg(std::move(other.fTg)),
+        fContinuations(std::move(other.fContinuations)), fWaitPredecessors(std::move(other.fWaitPredecessors))
+   {
+   }
 
    TFutureImpl &operator=(std::future<T> &&other) { fStdFut = std::move(other); }
 
    TFutureImpl<T> &operator=(TFutureImpl<T> &&other) = default;
 
+   /// Invoke the callback when the value is ready, from the task that computed it.
+   /// The value of futures built from a std::future is considered ready.
+   void OnReady(std::function<void()> callback)
+   {
+      if (fContinuations)
+         fContinuations->Add(std::move(callback));
+      else
+         callback();
+   }
+
+   /// Return a function that waits for this future, which stays valid when the future is moved.
+   std::function<void()> GetWait() const
+   {
+      auto tg = fTg;
+      auto waitPredecessors = fWaitPredecessors;
+      return [tg, waitPredecessors]() {
+         if (waitPredecessors)
+            waitPredecessors();
+         if (tg)
+            tg->Wait();
+      };
+   }
+
 public:
    TFutureImpl<T> &operator=(TFutureImpl<T> &other) = delete;
 
@@ -67,11 +158,17 @@ public:
 
    void wait()
    {
+      if (fWaitPredecessors)
+         fWaitPredecessors();
       if (fTg)
          fTg->Wait();
    }
 
    bool valid() const { return fStdFut.valid(); };
+
+   template <class Function>
+   Experimental::TFuture<typename std::result_of<typename std::decay<Function>::type(Experimental::TFuture<T>)>::type>
+   Then(Function &&f, const Experimental::TCancellationToken &token = Experimental::TCancellationToken());
 };
 }
 
@@ -85,10 +182,17 @@ class TFuture final : public ROOT::Detail::TFutureImpl<T> {
    friend TFuture<
       typename std::result_of<typename std::decay<Function>::type(typename std::decay<Args>::type...)>::type>
    Async(Function &&f, Args &&... args);
+   template <typename V>
+   friend class ROOT::Detail::TFutureImpl;
+   template <typename V>
+   friend TFuture<std::vector<TFuture<V>>> WhenAll(std::vector<TFuture<V>> &&futures);
 
 private:
-   TFuture(std::future<T> &&fut, std::unique_ptr<TTaskGroup> &&tg)
-      : ROOT::Detail::TFutureImpl<T>(std::forward<std::future<T>>(fut), std::move(tg)){};
+   TFuture(std::future<T> &&fut, std::shared_ptr<TTaskGroup> tg,
+           std::shared_ptr<ROOT::Detail::TFutureContinuations> continuations,
+           std::function<void()> waitPredecessors = {})
+      : ROOT::Detail::TFutureImpl<T>(std::forward<std::future<T>>(fut), std::move(tg), std::move(continuations),
+                                      std::move(waitPredecessors)){};
 
 public:
    TFuture(std::future<T> &&fut) : ROOT::Detail::TFutureImpl<T>(std::forward<std::future<T>>(fut)){};
@@ -107,10 +211,17 @@ class TFuture<void> final : public ROOT::Detail::TFutureImpl<void> {
    friend TFuture<
       typename std::result_of<typename std::decay<Function>::type(typename std::decay<Args>::type...)>::type>
    Async(Function &&f, Args &&... args);
+   template <typename V>
+   friend class ROOT::Detail::TFutureImpl;
+   template <typename V>
+   friend TFuture<std::vector<TFuture<V>>> WhenAll(std::vector<TFuture<V>> &&futures);
 
 private:
-   TFuture(std::future<void> &&fut, std::unique_ptr<TTaskGroup> &&tg)
-      : ROOT::Detail::TFutureImpl<void>(std::forward<std::future<void>>(fut), std::move(tg)){};
+   TFuture(std::future<void> &&fut, std::shared_ptr<TTaskGroup> tg,
+           std::shared_ptr<ROOT::Detail::TFutureContinuations> continuations,
+           std::function<void()> waitPredecessors = {})
+      : ROOT::Detail::TFutureImpl<void>(std::forward<std::future<void>>(fut), std::move(tg), std::move(continuations),
+                                      std::move(waitPredecessors)){};
 
 public:
    TFuture(std::future<void> &&fut) : ROOT::Detail::TFutureImpl<void>(std::forward<std::future<void>>(fut)){};
@@ -128,10 +239,17 @@ class TFuture<T &> final : public ROOT::Detail::TFutureImpl<T &> {
    friend TFuture<
       typename std::result_of<typename std::decay<Function>::type(typename std::decay<Args>::type...)>::type>
    Async(Function &&f, Args &&... args);
+   template <typename V>
+   friend class ROOT::Detail::TFutureImpl;
+   template <typename V>
+   friend TFuture<std::vector<TFuture<V>>> WhenAll(std::vector<TFuture<V>> &&futures);
 
 private:
-   TFuture(std::future<T &> &&fut, std::unique_ptr<TTaskGroup> &&tg)
-      : ROOT::Detail::TFutureImpl<T &>(std::forward<std::future<T &>>(fut), std::move(tg)){};
+   TFuture(std::future<T &> &&fut, std::shared_ptr<TTaskGroup> tg,
+           std::shared_ptr<ROOT::Detail::TFutureContinuations> continuations,
+           std::function<void()> waitPredecessors = {})
+      : ROOT::Detail::TFutureImpl<T &>(std::forward<std::future<T &>>(fut), std::move(tg), std::move(continuations),
+                                      std::move(waitPredecessors)){};
 
 public:
    TFuture(std::future<T &> &&fut) : ROOT::Detail::TFutureImpl<T &>(std::forward<std::future<T &>>(fut)){};
@@ -144,6 +262,9 @@ public:
 };
 /// \endcond
 
+template <typename V>
+TFuture<std::vector<TFuture<V>>> WhenAll(std::vector<TFuture<V>> &&futures);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Runs a function asynchronously potentially in a new thread and returns a
 /// ROOT TFuture that will hold the result.
@@ -158,13 +279,104 @@ Async(Function &&f, Args &&... args)
    using Ret_t = typename std::result_of<typename std::decay<Function>::type(typename std::decay<Args>::type...)>::type;
 
    auto thisPt = std::make_shared<std::packaged_task<Ret_t()>>(std::bind(f, args...));
-   std::unique_ptr<ROOT::Experimental::TTaskGroup> tg(new ROOT::Experimental::TTaskGroup());
-   tg->Run([thisPt]() { (*thisPt)(); });
-
-   return ROOT::Experimental::TFuture<Ret_t>(thisPt->get_future(), std::move(tg));
+   auto tg = std::make_shared<ROOT::Experimental::TTaskGroup>();
+   auto continuations = std::make_shared<ROOT::Detail::TFutureContinuations>();
+   tg->Run([thisPt, continuations]() {
+      (*thisPt)();
+      continuations->SetReady();
+   });
+
+   return ROOT::Experimental::TFuture<Ret_t>(thisPt->get_future(), std::move(tg), std::move(continuations));
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns a TFuture that is ready when all the given futures are, and holds them.
+/// No thread blocks in the meantime: the last of the futures to be ready schedules the
+/// completion. Futures built from a std::future are considered ready.
+template <typename V>
+TFuture<std::vector<TFuture<V>>> WhenAll(std::vector<TFuture<V>> &&futures)
+{
+   using Ret_t = std::vector<TFuture<V>>;
+
+   auto futs = std::make_shared<Ret_t>(std::move(futures));
+   std::vector<std::function<void()>> waits;
+   for (auto &fut : *futs)
+      waits.emplace_back(fut.GetWait());
+   auto waitAll = [waits]() {
+      for (auto &wait : waits)
+         wait();
+   };
+
+   auto thisPt = std::make_shared<std::packaged_task<Ret_t()>>([futs]() { return std::move(*futs); });
+   auto tg = std::make_shared<ROOT::Experimental::TTaskGroup>();
+   auto continuations = std::make_shared<ROOT::Detail::TFutureContinuations>();
+   auto schedule = [thisPt, tg, continuations]() {
+      tg->Run([thisPt, continuations]() {
+         (*thisPt)();
+         continuations->SetReady();
+      });
+   };
+
+   if (futs->empty()) {
+      schedule();
+   } else {
+      auto nPending = std::make_shared<std::atomic<std::size_t>>(futs->size());
+      for (auto &fut : *futs) {
+         fut.OnReady([nPending, schedule]() {
+            if (--*nPending == 0)
+               schedule();
+         });
+      }
+   }
+
+   return TFuture<Ret_t>(thisPt->get_future(), std::move(tg), std::move(continuations), std::move(waitAll));
 }
+} // namespace Experimental
+
+namespace Detail {
+////////////////////////////////////////////////////////////////////////////////
+/// Schedules a continuation: f is executed asynchronously once the value of this
+/// future is ready, and receives this future, which is then invalid for the caller.
+/// The continuation is scheduled by the task that computed the value, hence no thread
+/// blocks in the meantime and continuations can be chained into a pipeline:
+/// ~~~{.cpp}
+/// auto stats = Async(openFile, name)
+///                 .Then([](TFuture<TFile *> f) { return readMetadata(f.get()); })
+///                 .Then([](TFuture<Metadata> f) { return process(f.get()); });
+/// ~~~
+/// If the token is cancelled before f starts, f is not executed and the returned future
+/// holds a std::runtime_error. Exceptions thrown by the previous stages are rethrown by
+/// the get() of the future f receives.
+template <typename T>
+template <class Function>
+Experimental::TFuture<typename std::result_of<typename std::decay<Function>::type(Experimental::TFuture<T>)>::type>
+TFutureImpl<T>::Then(Function &&f, const Experimental::TCancellationToken &token)
+{
+   using Ret_t = typename std::result_of<typename std::decay<Function>::type(Experimental::TFuture<T>)>::type;
+   using Fut_t = Experimental::TFuture<T>;
+
+   auto waitPredecessor = GetWait();
+   auto predecessor = std::make_shared<Fut_t>(std::move(static_cast<Fut_t &>(*this)));
+   typename std::decay<Function>::type func(std::forward<Function>(f));
+   auto thisPt = std::make_shared<std::packaged_task<Ret_t()>>([predecessor, func, token]() mutable -> Ret_t {
+      if (token.IsCancellationRequested())
+         throw std::runtime_error("TFuture::Then: the continuation was cancelled.");
+      return func(std::move(*predecessor));
+   });
+   auto tg = std::make_shared<TTaskGroup>();
+   auto continuations = std::make_shared<TFutureContinuations>();
+   predecessor->OnReady([thisPt, tg, continuations]() {
+      tg->Run([thisPt, continuations]() {
+         (*thisPt)();
+         continuations->SetReady();
+      });
+   });
+
+   return Experimental::TFuture<Ret_t>(thisPt->get_future(), std::move(tg), std::move(continuations),
+                                       std::move(waitPredecessor));
 }
+} // namespace Detail
+} // namespace ROOT
 
 #endif
 #endif
\ No newline at end of file
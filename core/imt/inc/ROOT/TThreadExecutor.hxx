@@ -26,14 +26,20 @@
 #include "RTaskArena.hxx"
 #include "TError.h"
 #include <functional>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <numeric>
+#include <utility>
 
 
 namespace ROOT {
 
    class TThreadExecutor: public TExecutor<TThreadExecutor> {
    public:
+      /// Pass as nChunks to let the scheduler size the chunks at run time, see SetGrainSize
+      static constexpr unsigned kAutoChunks = std::numeric_limits<unsigned>::max();
 
       explicit TThreadExecutor(UInt_t nThreads = 0u);
 
@@ -84,8 +90,13 @@ namespace ROOT {
       using TExecutor<TThreadExecutor>::Reduce;
       template<class T, class BINARYOP> auto Reduce(const std::vector<T> &objs, BINARYOP redfunc) -> decltype(redfunc(objs.front(), objs.front()));
       template<class T, class R> auto Reduce(const std::vector<T> &objs, R redfunc) -> decltype(redfunc(objs));
+      template<class T, class BINARYOP> auto TreeReduce(std::vector<T> objs, BINARYOP redfunc) -> decltype(redfunc(objs.front(), objs.front()));
+      template<class T, class R> auto TreeReduce(std::vector<T> objs, R redfunc) -> decltype(redfunc(objs));
 
       unsigned GetPoolSize();
+      /// Set the minimum number of elements of the chunks formed with kAutoChunks
+      void SetGrainSize(unsigned grainSize) { fGrainSize = grainSize > 0 ? grainSize : 1; }
+      unsigned GetGrainSize() const { return fGrainSize; }
 
    protected:
       template<class F, class R, class Cond = noReferenceCond<F>>
@@ -99,12 +110,20 @@ namespace ROOT {
 
    private:
       void   ParallelFor(unsigned start, unsigned end, unsigned step, const std::function<void(unsigned int i)> &f);
+      void   ParallelForChunks(unsigned nElements, const std::function<void(unsigned begin, unsigned end)> &f);
+      template<class T, class G, class R>
+      std::vector<T> MapChunks(unsigned nElements, G getResult, R redfunc);
+      template<class T, class R>
+      static auto Combine(R &redfunc, T a, T b) -> decltype(redfunc(a, b));
+      template<class T, class R>
+      static auto Combine(R &redfunc, T a, T b) -> decltype(redfunc(std::vector<T>{}));
       double ParallelReduce(const std::vector<double> &objs, const std::function<double(double a, double b)> &redfunc);
       float  ParallelReduce(const std::vector<float> &objs, const std::function<float(float a, float b)> &redfunc);
       template<class T, class R>
       auto SeqReduce(const std::vector<T> &objs, R redfunc) -> decltype(redfunc(objs));
 
       std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> fTaskArenaW = nullptr;
+      unsigned fGrainSize = 1; ///< Minimum number of elements of the chunks formed with kAutoChunks
    };
 
    /************ TEMPLATE METHODS IMPLEMENTATION ******************/
@@ -119,6 +138,13 @@ namespace ROOT {
          ParallelFor(0U, nTimes, 1, [&](unsigned int){func();});
          return;
       }
+      if (nChunks == kAutoChunks) {
+         ParallelForChunks(nTimes, [&](unsigned begin, unsigned end) {
+            for (auto i = begin; i < end; ++i)
+               func();
+         });
+         return;
+      }
 
       unsigned step = (nTimes + nChunks - 1) / nChunks;
       auto lambda = [&](unsigned int i)
@@ -139,6 +165,15 @@ namespace ROOT {
          ParallelFor(*args.begin(), *args.end(), args.step(), [&](unsigned int i){func(i);});
          return;
       }
+      if (nChunks == kAutoChunks) {
+         const auto first = *args.begin();
+         const auto seqStep = args.step();
+         ParallelForChunks(args.size(), [&](unsigned begin, unsigned end) {
+            for (auto i = begin; i < end; ++i)
+               func(first + i * seqStep);
+         });
+         return;
+      }
       unsigned start = *args.begin();
       unsigned end = *args.end();
       unsigned seqStep = args.step();
@@ -174,6 +209,13 @@ namespace ROOT {
          ParallelFor(0U, nToProcess, 1, [&](unsigned int i){func(args[i]);});
          return;
       }
+      if (nChunks == kAutoChunks) {
+         ParallelForChunks(nToProcess, [&](unsigned begin, unsigned end) {
+            for (auto i = begin; i < end; ++i)
+               func(args[i]);
+         });
+         return;
+      }
 
       unsigned step = (nToProcess + nChunks - 1) / nChunks; //ceiling the division
       auto lambda = [&](unsigned int i)
@@ -194,6 +236,13 @@ namespace ROOT {
          ParallelFor(0U, nToProcess, 1, [&](unsigned int i){func(args[i]);});
          return;
       }
+      if (nChunks == kAutoChunks) {
+         ParallelForChunks(nToProcess, [&](unsigned begin, unsigned end) {
+            for (auto i = begin; i < end; ++i)
+               func(args[i]);
+         });
+         return;
+      }
 
       unsigned step = (nToProcess + nChunks - 1) / nChunks; //ceiling the division
       auto lambda = [&](unsigned int i)
@@ -254,6 +303,10 @@ namespace ROOT {
       {
          return Map(func, nTimes);
       }
+      if (nChunks == kAutoChunks) {
+         using retType = decltype(func());
+         return MapChunks<retType>(nTimes, [&](unsigned) { return func(); }, redfunc);
+      }
 
       unsigned step = (nTimes + nChunks - 1) / nChunks;
       // Avoid empty chunks
@@ -308,6 +361,12 @@ namespace ROOT {
       {
          return Map(func, args);
       }
+      if (nChunks == kAutoChunks) {
+         const auto first = *args.begin();
+         const auto seqStep = args.step();
+         using retType = decltype(func(first));
+         return MapChunks<retType>(args.size(), [&](unsigned i) { return func(first + i * seqStep); }, redfunc);
+      }
 
       unsigned start = *args.begin();
       unsigned end = *args.end();
@@ -343,6 +402,10 @@ namespace ROOT {
       {
          return Map(func, args);
       }
+      if (nChunks == kAutoChunks) {
+         using retType = decltype(func(args.front()));
+         return MapChunks<retType>(args.size(), [&](unsigned i) { return func(args[i]); }, redfunc);
+      }
 
       unsigned int nToProcess = args.size();
       unsigned step = (nToProcess + nChunks - 1) / nChunks; //ceiling the division
@@ -386,6 +449,9 @@ namespace ROOT {
    /// "squash" the vector returned by Map into a single object by merging,
    /// adding, mixing the elements of the vector.\n
    /// The fourth argument indicates the number of chunks we want to divide our work in.
+   /// With kAutoChunks, the scheduler sizes the chunks at run time, and each chunk combines the result of each
+   /// execution with its partial result as soon as it is available, passing the two to redfunc: only one partial
+   /// result per chunk is kept, never a vector with the results of all executions.
    template<class F, class R, class Cond>
    auto TThreadExecutor::MapReduce(F func, unsigned nTimes, R redfunc) -> typename std::result_of<F()>::type {
       return Reduce(Map(func, nTimes), redfunc);
@@ -439,6 +505,79 @@ namespace ROOT {
       return SeqReduce(objs, redfunc);
    }
 
+   //////////////////////////////////////////////////////////////////////////
+   /// "Reduce" an std::vector into a single object in log2(N) rounds of pairwise reductions by passing a
+   /// binary operator as the second argument. The reductions of each round run in parallel, which is faster than
+   /// Reduce for objects that are expensive to combine, e.g. the partial results of MapReduce when they are large
+   /// histograms: `pool.TreeReduce(pool.Map(func, args), redfunc)`.
+   /// The elements are combined in their order, and each element is passed to redfunc as the first argument at most
+   /// once per round, so redfunc can update and return its first argument.
+   template<class T, class BINARYOP>
+   auto TThreadExecutor::TreeReduce(std::vector<T> objs, BINARYOP redfunc) -> decltype(redfunc(objs.front(), objs.front()))
+   {
+      // check we can apply reduce to objs
+      static_assert(std::is_same<decltype(redfunc(objs.front(), objs.front())), T>::value, "redfunc does not have the correct signature");
+      if (objs.empty())
+         return T{};
+      const unsigned nObjs = objs.size();
+      for (unsigned step = 1; step < nObjs; step *= 2) {
+         ParallelFor(0U, nObjs - step, 2 * step, [&](unsigned int i) { objs[i] = redfunc(objs[i], objs[i + step]); });
+      }
+      return std::move(objs.front());
+   }
+
+   //////////////////////////////////////////////////////////////////////////
+   /// "Reduce" an std::vector into a single object in log2(N) rounds of pairwise reductions by passing a
+   /// function as the second argument defining the reduction operation: each reduction passes it two elements.
+   /// See the overload taking a binary operator.
+   template<class T, class R>
+   auto TThreadExecutor::TreeReduce(std::vector<T> objs, R redfunc) -> decltype(redfunc(objs))
+   {
+      // check we can apply reduce to objs
+      static_assert(std::is_same<decltype(redfunc(objs)), T>::value, "redfunc does not have the correct signature");
+      return TreeReduce(std::move(objs), [&redfunc](const T &a, const T &b) { return redfunc(std::vector<T>{a, b}); });
+   }
+
+   //////////////////////////////////////////////////////////////////////////
+   /// Combine the results of the chunks of [0, nElements) formed with kAutoChunks: `getResult(i)` is the result of
+   /// the execution i. Return the partial results of the chunks in the order of their elements.
+   template<class T, class G, class R>
+   std::vector<T> TThreadExecutor::MapChunks(unsigned nElements, G getResult, R redfunc)
+   {
+      std::map<unsigned, T> partialResults; // by first element of the chunk
+      std::mutex partialResultsMutex;
+      ParallelForChunks(nElements, [&](unsigned begin, unsigned end) {
+         T partialResult = getResult(begin);
+         for (auto i = begin + 1; i < end; ++i)
+            partialResult = Combine(redfunc, std::move(partialResult), getResult(i));
+         std::lock_guard<std::mutex> lock(partialResultsMutex);
+         partialResults.emplace(begin, std::move(partialResult));
+      });
+      std::vector<T> reslist;
+      reslist.reserve(partialResults.size());
+      for (auto &partialResult : partialResults)
+         reslist.emplace_back(std::move(partialResult.second));
+      return reslist;
+   }
+
+   /// Combine two results with a binary redfunc
+   template<class T, class R>
+   auto TThreadExecutor::Combine(R &redfunc, T a, T b) -> decltype(redfunc(a, b))
+   {
+      return redfunc(a, b);
+   }
+
+   /// Combine two results with a redfunc that reduces a vector
+   template<class T, class R>
+   auto TThreadExecutor::Combine(R &redfunc, T a, T b) -> decltype(redfunc(std::vector<T>{}))
+   {
+      std::vector<T> pair;
+      pair.reserve(2);
+      pair.emplace_back(std::move(a));
+      pair.emplace_back(std::move(b));
+      return redfunc(pair);
+   }
+
    template<class T, class R>
    auto TThreadExecutor::SeqReduce(const std::vector<T> &objs, R redfunc) -> decltype(redfunc(objs))
    {
@@ -20,6 +20,7 @@
 
 #include "TError.h"
 #include "ROOT/RTaskArena.hxx"
+#include "ROOT/TThreadExecutor.hxx"
 #include <atomic>
 
 static std::shared_ptr<ROOT::Internal::RTaskArenaWrapper> &R__GetTaskArena4IMT()
@@ -79,3 +80,9 @@ extern "C" bool ROOT_TImplicitMT_IsParBranchProcessingEnabled()
 {
    return GetParBranchProcessingCount() > 0;
 };
+
+extern "C" void ROOT_TImplicitMT_ForEach(UInt_t n, void (*func)(UInt_t, void *), void *arg)
+{
+   ROOT::TThreadExecutor pool;
+   pool.Foreach([func, arg](UInt_t i) { func(i, arg); }, ROOT::TSeqU(n));
+};
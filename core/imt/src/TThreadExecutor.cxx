@@ -147,6 +147,21 @@ void TThreadExecutor::ParallelFor(unsigned int start, unsigned int end, unsigned
    });
 }
 
+//////////////////////////////////////////////////////////////////////////
+/// Run f on chunks of [0, nElements) sized at run time by tbb::auto_partitioner, which splits the range further only
+/// when idle threads steal work, and never below the grain size. Tiny elements are then grouped in few tasks, while
+/// expensive ones are spread over all threads.
+void TThreadExecutor::ParallelForChunks(unsigned nElements, const std::function<void(unsigned begin, unsigned end)> &f)
+{
+   fTaskArenaW->Access().execute([&] {
+      tbb::this_task_arena::isolate([&] {
+         tbb::parallel_for(tbb::blocked_range<unsigned>(0U, nElements, fGrainSize),
+                           [&f](const tbb::blocked_range<unsigned> &r) { f(r.begin(), r.end()); },
+                           tbb::auto_partitioner());
+      });
+   });
+}
+
 double TThreadExecutor::ParallelReduce(const std::vector<double> &objs,
                                        const std::function<double(double a, double b)> &redfunc)
 {
@@ -3,6 +3,8 @@
 #include "ROOT/TThreadExecutor.hxx"
 #include <fstream>
 #include <random>
+#include <set>
+#include <stdlib.h> // setenv
 #include <thread>
 #include "gtest/gtest.h"
 #include "tbb/task_arena.h"
@@ -71,6 +73,34 @@ TEST(RTaskArena, KeepSize)
    ASSERT_EQ(ROOT::Internal::RTaskArenaWrapper::TaskArenaSize(), nCores);
 }
 
+TEST(RTaskArena, NUMADomainCores)
+{
+   std::set<int> cores;
+   for (const auto &domain : ROOT::Internal::NUMADomainCores()) {
+      EXPECT_FALSE(domain.empty());
+      for (auto core : domain)
+         EXPECT_TRUE(cores.insert(core).second) << "core " << core << " is in two NUMA domains";
+   }
+}
+
+#ifdef R__LINUX
+TEST(RTaskArena, NUMAPinning)
+{
+   setenv("ROOT_IMT_NUMA", "1", 1);
+   const auto nDomains = ROOT::Internal::NUMADomainCores().size();
+   {
+      auto gTAInstance = ROOT::Internal::GetGlobalTaskArena();
+      EXPECT_EQ(ROOT::Internal::RTaskArenaWrapper::NUMADomains(), nDomains > 1 ? nDomains : 0u);
+      ROOT::TThreadExecutor threadExecutor;
+      const auto squares = threadExecutor.Map([](int i) { return i * i; }, ROOT::TSeqI(1000));
+      for (auto i = 0; i < 1000; ++i)
+         EXPECT_EQ(squares[i], i * i);
+   }
+   unsetenv("ROOT_IMT_NUMA");
+   EXPECT_EQ(ROOT::Internal::RTaskArenaWrapper::NUMADomains(), 0u);
+}
+#endif
+
 ////////////////////////////////////////////////////////////////////////
 // Integration Tests
 
@@ -1,7 +1,10 @@
 #include "TROOT.h"
 #include "ROOT/TFuture.hxx"
 
+#include <atomic>
 #include <future>
+#include <stdexcept>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -50,4 +53,69 @@ TEST(TFuture, BuildFromAsync_void)
    f.get();
 }
 
+TEST(TFuture, Then)
+{
+   auto f = Async([]() { return 1; }).Then([](TFuture<int> prev) { return prev.get() + 1; }).Then([](TFuture<int> prev) {
+      return 2. * prev.get();
+   });
+   ASSERT_DOUBLE_EQ(4., f.get());
+}
+
+TEST(TFuture, ThenFromSTLFuture)
+{
+   TFuture<int> f = std::async([]() { return 1; });
+   auto g = f.Then([](TFuture<int> prev) { return prev.get() + 1; });
+   ASSERT_FALSE(f.valid());
+   ASSERT_EQ(2, g.get());
+}
+
+TEST(TFuture, Then_void)
+{
+   std::atomic<int> n{0};
+   auto f = Async([&n]() { ++n; }).Then([&n](TFuture<void> prev) {
+      prev.get();
+      ++n;
+   });
+   f.get();
+   ASSERT_EQ(2, n.load());
+}
+
+TEST(TFuture, ThenPropagatesExceptions)
+{
+   auto f = Async([]() -> int { throw std::runtime_error("stage failed"); }).Then([](TFuture<int> prev) {
+      return prev.get() + 1;
+   });
+   ASSERT_THROW(f.get(), std::runtime_error);
+}
+
+TEST(TFuture, ThenCancelled)
+{
+   TCancellationToken token;
+   std::atomic<bool> ran{false};
+   std::promise<void> release;
+   auto released = release.get_future().share();
+   auto f = Async([released]() { released.wait(); }).Then([&ran](TFuture<void>) { ran = true; }, token);
+   token.Cancel();
+   release.set_value();
+   ASSERT_THROW(f.get(), std::runtime_error);
+   ASSERT_FALSE(ran);
+}
+
+TEST(TFuture, WhenAll)
+{
+   std::vector<TFuture<int>> futures;
+   for (int i = 0; i < 10; ++i)
+      futures.emplace_back(Async([i]() { return i; }));
+   auto sum = WhenAll(std::move(futures)).Then([](TFuture<std::vector<TFuture<int>>> all) {
+      int s = 0;
+      for (auto &f : all.get())
+         s += f.get();
+      return s;
+   });
+   ASSERT_EQ(45, sum.get());
+
+   auto none = WhenAll(std::vector<TFuture<int>>());
+   ASSERT_TRUE(none.get().empty());
+}
+
 #endif
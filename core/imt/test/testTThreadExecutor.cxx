@@ -0,0 +1,92 @@
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#ifdef R__USE_IMT
+
+TEST(TThreadExecutor, TreeReduce)
+{
+   ROOT::TThreadExecutor pool(4);
+   for (auto n : {0u, 1u, 2u, 3u, 7u, 64u, 100u}) {
+      std::vector<int> v(n);
+      std::iota(v.begin(), v.end(), 1);
+      EXPECT_EQ(int(n * (n + 1) / 2), pool.TreeReduce(v, [](int a, int b) { return a + b; })) << n;
+      EXPECT_EQ(int(n * (n + 1) / 2),
+                pool.TreeReduce(v, [](const std::vector<int> &pair) { return pair[0] + pair[1]; }))
+         << n;
+   }
+}
+
+TEST(TThreadExecutor, TreeReduceKeepsOrder)
+{
+   ROOT::TThreadExecutor pool(4);
+   std::vector<std::string> letters;
+   for (char c = 'a'; c <= 'z'; ++c)
+      letters.emplace_back(1, c);
+   EXPECT_EQ("abcdefghijklmnopqrstuvwxyz",
+             pool.TreeReduce(letters, [](const std::string &a, const std::string &b) { return a + b; }));
+}
+
+TEST(TThreadExecutor, TreeReduceMappedResults)
+{
+   ROOT::TThreadExecutor pool(4);
+   auto partials = pool.Map([](int i) { return std::vector<double>(1000, i); }, ROOT::TSeqI(16));
+   auto sum = pool.TreeReduce(partials, [](std::vector<double> &a, const std::vector<double> &b) -> std::vector<double> {
+      for (auto i = 0u; i < a.size(); ++i)
+         a[i] += b[i];
+      return std::move(a);
+   });
+   ASSERT_EQ(1000u, sum.size());
+   for (auto x : sum)
+      EXPECT_DOUBLE_EQ(120., x);
+}
+
+TEST(TThreadExecutor, AutoChunksForeach)
+{
+   ROOT::TThreadExecutor pool(4);
+   for (auto grainSize : {1u, 7u, 1000u}) {
+      pool.SetGrainSize(grainSize);
+      std::vector<std::atomic<int>> counts(100);
+      for (auto &c : counts)
+         c = 0;
+      pool.Foreach([&](unsigned i) { ++counts[i]; }, ROOT::TSeqU(100), ROOT::TThreadExecutor::kAutoChunks);
+      for (auto &c : counts)
+         EXPECT_EQ(1, c.load()) << grainSize;
+
+      std::atomic<int> nCalls{0};
+      pool.Foreach([&] { ++nCalls; }, 57, ROOT::TThreadExecutor::kAutoChunks);
+      EXPECT_EQ(57, nCalls.load()) << grainSize;
+   }
+}
+
+TEST(TThreadExecutor, AutoChunksMapReduce)
+{
+   ROOT::TThreadExecutor pool(4);
+   pool.SetGrainSize(3);
+   auto add = [](double a, double b) { return a + b; };
+   EXPECT_DOUBLE_EQ(328350., pool.MapReduce([](int i) { return double(i * i); }, ROOT::TSeqI(100), add,
+                                            ROOT::TThreadExecutor::kAutoChunks));
+   EXPECT_DOUBLE_EQ(100., pool.MapReduce([] { return 1.; }, 100, add, ROOT::TThreadExecutor::kAutoChunks));
+   std::vector<int> v(100);
+   std::iota(v.begin(), v.end(), 0);
+   auto addAll = [](const std::vector<int> &ints) { return std::accumulate(ints.begin(), ints.end(), 0); };
+   EXPECT_EQ(328350, pool.MapReduce([](int i) { return i * i; }, v, addAll, ROOT::TThreadExecutor::kAutoChunks));
+
+   // the partial results of the chunks keep the order of the elements
+   std::vector<std::string> letters;
+   for (char c = 'a'; c <= 'z'; ++c)
+      letters.emplace_back(1, c);
+   auto concat = [](const std::vector<std::string> &strings) {
+      return std::accumulate(strings.begin(), strings.end(), std::string());
+   };
+   EXPECT_EQ("abcdefghijklmnopqrstuvwxyz",
+             pool.MapReduce([](const std::string &s) { return s; }, letters, concat, ROOT::TThreadExecutor::kAutoChunks));
+}
+
+#endif
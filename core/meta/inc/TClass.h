@@ -47,6 +47,7 @@ class TMethod;
 class TRealData;
 class TBuffer;
 class TVirtualStreamerInfo;
+class TFile;
 class TVirtualCollectionProxy;
 class TMethodCall;
 class TVirtualIsAProxy;
@@ -230,6 +231,7 @@ private:
    mutable std::atomic<Bool_t> fCanLoadClassInfo;    //!Indicates whether the ClassInfo is supposed to be available.
    mutable std::atomic<Bool_t> fIsOffsetStreamerSet; //!saved remember if fOffsetStreamer has been set.
    mutable std::atomic<Bool_t> fVersionUsed;         //!Indicates whether GetClassVersion has been called
+   mutable std::atomic<Bool_t> fHasPendingStreamerInfos; //!Indicates whether a file registered StreamerInfos for this class that are not processed yet
 
    enum class ERuntimeProperties : UChar_t {
       kNotInitialized = 0,
@@ -299,6 +301,10 @@ private:
    static TDeclNameRegistry fNoInfoOrEmuOrFwdDeclNameRegistry; // Store decl names of the forwardd and no info instances
    static Bool_t HasNoInfoOrEmuOrFwdDeclaredDecl(const char*);
 
+   static std::atomic<Int_t> fgNPendingStreamerInfos; //Number of StreamerInfos registered by AddPendingStreamerInfo and not yet processed
+   static Bool_t LoadPendingStreamerInfos(const char *name);
+   void          LoadPendingStreamerInfos() const;
+
    // Internal status bits, set and reset only during initialization and thus under the protection of the global lock.
    enum { kLoading = kReservedLoading, kUnloading = kReservedLoading };
    // Internal streamer type.
@@ -440,7 +446,12 @@ public:
    TClassStreamer    *GetStreamer() const;
    ClassStreamerFunc_t GetStreamerFunc() const;
    ClassConvStreamerFunc_t GetConvStreamerFunc() const;
-   const TObjArray          *GetStreamerInfos() const { return fStreamerInfo; }
+   const TObjArray          *GetStreamerInfos() const
+   {
+      if (fHasPendingStreamerInfos)
+         LoadPendingStreamerInfos();
+      return fStreamerInfo;
+   }
    TVirtualStreamerInfo     *GetStreamerInfo(Int_t version=0) const;
    TVirtualStreamerInfo     *GetStreamerInfoAbstractEmulated(Int_t version=0) const;
    TVirtualStreamerInfo     *FindStreamerInfoAbstractEmulated(UInt_t checksum) const;
@@ -522,6 +533,8 @@ public:
    static void           AddClassToDeclIdMap(TDictionary::DeclId_t id, TClass* cl);
    static void           RemoveClass(TClass *cl);
    static void           RemoveClassDeclId(TDictionary::DeclId_t id);
+   static void           AddPendingStreamerInfo(TVirtualStreamerInfo *info, TFile *file);
+   static void           RemovePendingStreamerInfos(TFile *file);
    static TClass        *GetClass(const char *name, Bool_t load = kTRUE, Bool_t silent = kFALSE);
    static TClass        *GetClass(const std::type_info &typeinfo, Bool_t load = kTRUE, Bool_t silent = kFALSE);
    static TClass        *GetClass(ClassInfo_t *info, Bool_t load = kTRUE, Bool_t silent = kFALSE);
@@ -86,6 +86,7 @@ In order to access the name of a class within the ROOT type system, the method T
 #include "TThreadSlots.h"
 #include "ThreadLocalStorage.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cctype>
 #include <set>
@@ -169,6 +170,26 @@ namespace {
 }
 
 std::atomic<Int_t> TClass::fgClassCount;
+std::atomic<Int_t> TClass::fgNPendingStreamerInfos;
+
+namespace {
+
+   // A StreamerInfo read from a file opened with lazy StreamerInfo processing,
+   // waiting for its class to be used (see TFile::SetReadStreamerInfoLazy).
+   struct TPendingStreamerInfo {
+      TVirtualStreamerInfo *fInfo;
+      TFile                *fFile;
+   };
+
+   using PendingStreamerInfos_t = std::map<std::string, std::vector<TPendingStreamerInfo>>;
+
+   PendingStreamerInfos_t &GetPendingStreamerInfos()
+   {
+      static PendingStreamerInfos_t gPendingStreamerInfos;
+      return gPendingStreamerInfos;
+   }
+
+}
 
 // Implementation of the TDeclNameRegistry
 
@@ -473,6 +494,93 @@ DeclIdMap_t *TClass::GetDeclIdMap() {
 #endif
 }
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Lock-free cache in front of the list of classes and of the type_info map,
+/// used by TClass::GetClass for the classes that have a dictionary (see
+/// TClass::IsLoaded), such that their lookup does not take ROOT::gCoreMutex.
+///
+/// Each table is an open addressing hash table of a fixed size; a class that
+/// does not find a free slot within kMaxProbes slots is simply not cached.
+/// The entries are added and removed with compare-and-swap operations; a
+/// lookup that misses falls back to the regular, locked, search.
+
+class TClassLookupCache {
+   static constexpr UInt_t kSize = 4096; // must be a power of 2
+   static constexpr UInt_t kMaxProbes = 8;
+
+   std::atomic<TClass *> fByName[kSize];
+   std::atomic<TClass *> fByTypeInfo[kSize];
+
+   static UInt_t Hash(const char *name) { return TString::Hash(name, strlen(name)); }
+
+   static void Add(std::atomic<TClass *> *table, UInt_t hash, TClass *cl)
+   {
+      for (UInt_t i = 0; i < kMaxProbes; ++i) {
+         auto &slot = table[(hash + i) & (kSize - 1)];
+         TClass *expected = nullptr;
+         if (slot.compare_exchange_strong(expected, cl, std::memory_order_release, std::memory_order_relaxed) ||
+             expected == cl)
+            return;
+      }
+   }
+
+   static void Remove(std::atomic<TClass *> *table, UInt_t hash, TClass *cl)
+   {
+      for (UInt_t i = 0; i < kMaxProbes; ++i) {
+         TClass *expected = cl;
+         table[(hash + i) & (kSize - 1)].compare_exchange_strong(expected, nullptr, std::memory_order_relaxed);
+      }
+   }
+
+public:
+   /// Return the cached class called `name`, or nullptr.
+   TClass *Find(const char *name) const
+   {
+      const UInt_t hash = Hash(name);
+      for (UInt_t i = 0; i < kMaxProbes; ++i) {
+         TClass *cl = fByName[(hash + i) & (kSize - 1)].load(std::memory_order_acquire);
+         if (cl && cl->IsLoaded() && strcmp(cl->GetName(), name) == 0)
+            return cl;
+      }
+      return nullptr;
+   }
+
+   /// Return the cached class with the type_info `typeinfo`, or nullptr.
+   TClass *Find(const std::type_info &typeinfo) const
+   {
+      const UInt_t hash = Hash(typeinfo.name());
+      for (UInt_t i = 0; i < kMaxProbes; ++i) {
+         TClass *cl = fByTypeInfo[(hash + i) & (kSize - 1)].load(std::memory_order_acquire);
+         if (cl && cl->IsLoaded() && cl->GetTypeInfo() && *cl->GetTypeInfo() == typeinfo)
+            return cl;
+      }
+      return nullptr;
+   }
+
+   /// Cache `cl`, which must have a dictionary.
+   void Add(TClass *cl)
+   {
+      Add(fByName, Hash(cl->GetName()), cl);
+      if (cl->GetTypeInfo())
+         Add(fByTypeInfo, Hash(cl->GetTypeInfo()->name()), cl);
+   }
+
+   /// Remove `cl` from the cache; must be called before `cl` is unloaded or deleted.
+   void Remove(TClass *cl)
+   {
+      Remove(fByName, Hash(cl->GetName()), cl);
+      if (cl->GetTypeInfo())
+         Remove(fByTypeInfo, Hash(cl->GetTypeInfo()->name()), cl);
+   }
+};
+
+// Zero-initialized: no entry is set before the first lookup.
+TClassLookupCache gClassLookupCache;
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// static: Add a class to the list and map of classes.
 
@@ -488,6 +596,9 @@ void TClass::AddClass(TClass *cl)
    if (cl->fClassInfo) {
       GetDeclIdMap()->Add((void*)(cl->fClassInfo), cl);
    }
+   if (fgNPendingStreamerInfos && GetPendingStreamerInfos().count(cl->GetName())) {
+      cl->fHasPendingStreamerInfos = kTRUE;
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -506,6 +617,7 @@ void TClass::RemoveClass(TClass *oldcl)
 {
    if (!oldcl) return;
 
+   gClassLookupCache.Remove(oldcl);
    R__LOCKGUARD(gInterpreterMutex);
    gROOT->GetListOfClasses()->Remove(oldcl);
    if (oldcl->GetTypeInfo()) {
@@ -524,6 +636,91 @@ void TClass::RemoveClassDeclId(TDictionary::DeclId_t id)
    GetDeclIdMap()->Remove(id);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// static: Register a StreamerInfo read from 'file' whose processing (see
+/// TVirtualStreamerInfo::BuildCheck) is postponed until the class it describes
+/// is looked up for the first time, via TClass::GetClass or via one of
+/// the StreamerInfo accessors of the TClass object.
+/// The StreamerInfo is owned by the registry until it is processed.
+
+void TClass::AddPendingStreamerInfo(TVirtualStreamerInfo *info, TFile *file)
+{
+   if (!info) return;
+
+   R__LOCKGUARD(gInterpreterMutex);
+   GetPendingStreamerInfos()[info->GetName()].push_back({info, file});
+   ++fgNPendingStreamerInfos;
+   TClass *cl = (TClass*)gROOT->GetListOfClasses()->FindObject(info->GetName());
+   if (cl) {
+      cl->fHasPendingStreamerInfos = kTRUE;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// static: Delete the StreamerInfos registered by 'file' and not processed yet.
+/// To be called when the file is closed: nothing can be read from it anymore.
+
+void TClass::RemovePendingStreamerInfos(TFile *file)
+{
+   if (!fgNPendingStreamerInfos) return;
+
+   R__LOCKGUARD(gInterpreterMutex);
+   auto &pending = GetPendingStreamerInfos();
+   for (auto iter = pending.begin(); iter != pending.end();) {
+      auto &infos = iter->second;
+      auto first = std::remove_if(infos.begin(), infos.end(), [file](const TPendingStreamerInfo &entry) {
+         if (entry.fFile != file)
+            return false;
+         delete entry.fInfo;
+         return true;
+      });
+      fgNPendingStreamerInfos -= (infos.end() - first);
+      infos.erase(first, infos.end());
+      if (infos.empty())
+         iter = pending.erase(iter);
+      else
+         ++iter;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// static: Process the StreamerInfos registered via AddPendingStreamerInfo
+/// for the class 'name', if any. Returns true if there was any.
+
+Bool_t TClass::LoadPendingStreamerInfos(const char *name)
+{
+   if (!fgNPendingStreamerInfos) return kFALSE;
+
+   R__LOCKGUARD(gInterpreterMutex);
+   auto &pending = GetPendingStreamerInfos();
+   auto iter = pending.find(name);
+   if (iter == pending.end()) return kFALSE;
+
+   // BuildCheck may look up this class again: take the entries out first.
+   std::vector<TPendingStreamerInfo> infos;
+   infos.swap(iter->second);
+   pending.erase(iter);
+   fgNPendingStreamerInfos -= infos.size();
+
+   for (auto &entry : infos) {
+      entry.fInfo->BuildCheck(entry.fFile);
+      // BuildCheck found an equivalent StreamerInfo, this one is not needed.
+      if (entry.fInfo->TestBit(TObject::kCanDelete))
+         delete entry.fInfo;
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Process the StreamerInfos that files registered for this class.
+
+void TClass::LoadPendingStreamerInfos() const
+{
+   R__LOCKGUARD(gInterpreterMutex);
+   fHasPendingStreamerInfos = kFALSE;
+   LoadPendingStreamerInfos(GetName());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Indirect call to the implementation of ShowMember allowing [forward]
 /// declaration with out a full definition of the TClass class.
@@ -1049,7 +1246,7 @@ TClass::TClass() :
    fMerge(0), fResetAfterMerge(0), fNew(0), fNewArray(0), fDelete(0), fDeleteArray(0),
    fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fConvStreamerFunc(0), fSizeof(-1),
    fCanSplit(-1), fProperty(0), fClassProperty(0), fHasRootPcmInfo(kFALSE), fCanLoadClassInfo(kFALSE),
-   fIsOffsetStreamerSet(kFALSE), fVersionUsed(kFALSE), fRuntimeProperties(0), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
+   fIsOffsetStreamerSet(kFALSE), fVersionUsed(kFALSE), fHasPendingStreamerInfos(kFALSE), fRuntimeProperties(0), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
    fState(kNoInfo),
    fCurrentInfo(0), fLastReadInfo(0), fRefProxy(0),
    fSchemaRules(0), fStreamerImpl(&TClass::StreamerDefault)
@@ -1087,7 +1284,7 @@ TClass::TClass(const char *name, Bool_t silent) :
    fMerge(0), fResetAfterMerge(0), fNew(0), fNewArray(0), fDelete(0), fDeleteArray(0),
    fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fConvStreamerFunc(0), fSizeof(-1),
    fCanSplit(-1), fProperty(0), fClassProperty(0), fHasRootPcmInfo(kFALSE), fCanLoadClassInfo(kFALSE),
-   fIsOffsetStreamerSet(kFALSE), fVersionUsed(kFALSE), fRuntimeProperties(0), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
+   fIsOffsetStreamerSet(kFALSE), fVersionUsed(kFALSE), fHasPendingStreamerInfos(kFALSE), fRuntimeProperties(0), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
    fState(kNoInfo),
    fCurrentInfo(0), fLastReadInfo(0), fRefProxy(0),
    fSchemaRules(0), fStreamerImpl(&TClass::StreamerDefault)
@@ -1134,7 +1331,7 @@ TClass::TClass(const char *name, Version_t cversion, Bool_t silent) :
    fMerge(0), fResetAfterMerge(0), fNew(0), fNewArray(0), fDelete(0), fDeleteArray(0),
    fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fConvStreamerFunc(0), fSizeof(-1),
    fCanSplit(-1), fProperty(0), fClassProperty(0), fHasRootPcmInfo(kFALSE), fCanLoadClassInfo(kFALSE),
-   fIsOffsetStreamerSet(kFALSE), fVersionUsed(kFALSE), fRuntimeProperties(0), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
+   fIsOffsetStreamerSet(kFALSE), fVersionUsed(kFALSE), fHasPendingStreamerInfos(kFALSE), fRuntimeProperties(0), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
    fState(kNoInfo),
    fCurrentInfo(0), fLastReadInfo(0), fRefProxy(0),
    fSchemaRules(0), fStreamerImpl(&TClass::StreamerDefault)
@@ -1161,7 +1358,7 @@ TClass::TClass(const char *name, Version_t cversion, EState theState, Bool_t sil
    fMerge(0), fResetAfterMerge(0), fNew(0), fNewArray(0), fDelete(0), fDeleteArray(0),
    fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fConvStreamerFunc(0), fSizeof(-1),
    fCanSplit(-1), fProperty(0), fClassProperty(0), fHasRootPcmInfo(kFALSE), fCanLoadClassInfo(kFALSE),
-   fIsOffsetStreamerSet(kFALSE), fVersionUsed(kFALSE), fRuntimeProperties(0), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
+   fIsOffsetStreamerSet(kFALSE), fVersionUsed(kFALSE), fHasPendingStreamerInfos(kFALSE), fRuntimeProperties(0), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
    fState(theState),
    fCurrentInfo(0), fLastReadInfo(0), fRefProxy(0),
    fSchemaRules(0), fStreamerImpl(&TClass::StreamerDefault)
@@ -1205,7 +1402,7 @@ TClass::TClass(ClassInfo_t *classInfo, Version_t cversion,
    fMerge(0), fResetAfterMerge(0), fNew(0), fNewArray(0), fDelete(0), fDeleteArray(0),
    fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fConvStreamerFunc(0), fSizeof(-1),
    fCanSplit(-1), fProperty(0), fClassProperty(0), fHasRootPcmInfo(kFALSE), fCanLoadClassInfo(kFALSE),
-   fIsOffsetStreamerSet(kFALSE), fVersionUsed(kFALSE), fRuntimeProperties(0), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
+   fIsOffsetStreamerSet(kFALSE), fVersionUsed(kFALSE), fHasPendingStreamerInfos(kFALSE), fRuntimeProperties(0), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
    fState(kNoInfo),
    fCurrentInfo(0), fLastReadInfo(0), fRefProxy(0),
    fSchemaRules(0), fStreamerImpl(&TClass::StreamerDefault)
@@ -1255,7 +1452,7 @@ TClass::TClass(const char *name, Version_t cversion,
    fMerge(0), fResetAfterMerge(0), fNew(0), fNewArray(0), fDelete(0), fDeleteArray(0),
    fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fConvStreamerFunc(0), fSizeof(-1),
    fCanSplit(-1), fProperty(0), fClassProperty(0), fHasRootPcmInfo(kFALSE), fCanLoadClassInfo(kFALSE),
-   fIsOffsetStreamerSet(kFALSE), fVersionUsed(kFALSE), fRuntimeProperties(0), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
+   fIsOffsetStreamerSet(kFALSE), fVersionUsed(kFALSE), fHasPendingStreamerInfos(kFALSE), fRuntimeProperties(0), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
    fState(kNoInfo),
    fCurrentInfo(0), fLastReadInfo(0), fRefProxy(0),
    fSchemaRules(0), fStreamerImpl(&TClass::StreamerDefault)
@@ -1286,7 +1483,7 @@ TClass::TClass(const char *name, Version_t cversion,
    fMerge(0), fResetAfterMerge(0), fNew(0), fNewArray(0), fDelete(0), fDeleteArray(0),
    fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fConvStreamerFunc(0), fSizeof(-1),
    fCanSplit(-1), fProperty(0), fClassProperty(0), fHasRootPcmInfo(kFALSE), fCanLoadClassInfo(kFALSE),
-   fIsOffsetStreamerSet(kFALSE), fVersionUsed(kFALSE), fRuntimeProperties(0), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
+   fIsOffsetStreamerSet(kFALSE), fVersionUsed(kFALSE), fHasPendingStreamerInfos(kFALSE), fRuntimeProperties(0), fOffsetStreamer(0), fStreamerType(TClass::kDefault),
    fState(kHasTClassInit),
    fCurrentInfo(0), fLastReadInfo(0), fRefProxy(0),
    fSchemaRules(0), fStreamerImpl(&TClass::StreamerDefault)
@@ -1612,6 +1809,8 @@ void TClass::Init(const char *name, Version_t cversion,
 
 TClass::~TClass()
 {
+   gClassLookupCache.Remove(this);
+
    R__LOCKGUARD(gInterpreterMutex);
 
    // Remove from the typedef hashtables.
@@ -2932,15 +3131,30 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
 
    if (!gROOT->GetListOfClasses())  return 0;
 
+   // Lock-free lookup of the classes with a dictionary that were found before.
+   TClass *cl = gClassLookupCache.Find(name);
+   if (cl) return cl;
+
    // FindObject will take the read lock before actually getting the
    // TClass pointer so we will need not get a partially initialized
    // object.
-   TClass *cl = (TClass*)gROOT->GetListOfClasses()->FindObject(name);
+   cl = (TClass*)gROOT->GetListOfClasses()->FindObject(name);
 
    // Early return to release the lock without having to execute the
    // long-ish normalization.
+   if (cl && cl->IsLoaded() && !cl->TestBit(kUnloading)) {
+      gClassLookupCache.Add(cl);
+      return cl;
+   }
    if (cl && (cl->IsLoaded() || cl->TestBit(kUnloading))) return cl;
 
+   // The class might be described by a StreamerInfo of a file whose
+   // StreamerInfo record is processed lazily; this creates the TClass.
+   if (!cl && LoadPendingStreamerInfos(name)) {
+      cl = (TClass*)gROOT->GetListOfClasses()->FindObject(name);
+      if (cl && (cl->IsLoaded() || cl->TestBit(kUnloading))) return cl;
+   }
+
    R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
    // Now that we got the write lock, another thread may have constructed the
@@ -3146,12 +3360,20 @@ TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t /*
    if (!gROOT->GetListOfClasses())
       return 0;
 
+   // Lock-free lookup of the classes with a dictionary that were found before.
+   TClass* cl = gClassLookupCache.Find(typeinfo);
+   if (cl) return cl;
+
    //protect access to TROOT::GetIdMap
    R__READ_LOCKGUARD(ROOT::gCoreMutex);
 
-   TClass* cl = GetIdMap()->Find(typeinfo.name());
+   cl = GetIdMap()->Find(typeinfo.name());
 
-   if (cl && cl->IsLoaded()) return cl;
+   if (cl && cl->IsLoaded()) {
+      if (!cl->TestBit(kUnloading))
+         gClassLookupCache.Add(cl);
+      return cl;
+   }
 
    R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
 
@@ -4503,6 +4725,9 @@ Int_t TClass::GetNmethods()
 
 TVirtualStreamerInfo* TClass::GetStreamerInfo(Int_t version /* = 0 */) const
 {
+   if (fHasPendingStreamerInfos)
+      LoadPendingStreamerInfos();
+
    TVirtualStreamerInfo *sinfo = fLastReadInfo;
 
    // Version 0 is special, it means the currently loaded version.
@@ -6079,6 +6304,7 @@ void TClass::SetUnloaded()
       return;
    }
    SetBit(kUnloading);
+   gClassLookupCache.Remove(this);
 
    //R__ASSERT(fState == kLoaded);
    if (fState != kLoaded) {
@@ -6795,6 +7021,9 @@ void TClass::SetDirectoryAutoAdd(ROOT::DirAutoAdd_t autoAddFunc)
 
 TVirtualStreamerInfo *TClass::FindStreamerInfo(UInt_t checksum) const
 {
+   if (fHasPendingStreamerInfos)
+      LoadPendingStreamerInfos();
+
    TVirtualStreamerInfo *guess = fLastReadInfo;
    if (guess && guess->GetCheckSum() == checksum) {
       return guess;
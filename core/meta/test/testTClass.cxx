@@ -1,9 +1,15 @@
 #include "TClass.h"
 #include "THashTable.h"
 #include "TInterpreter.h"
+#include "TNamed.h"
+#include "TROOT.h"
 
 #include "gtest/gtest.h"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 TEST(TClass, DictCheck)
 {
    gInterpreter->ProcessLine(".L stlDictCheck.h+");
@@ -22,3 +28,29 @@ TEST(TClass, DictCheck)
 
    EXPECT_STREQ(errMsg.c_str(), "Missing dictionary for C, ") << errMsg;
 }
+
+TEST(TClass, GetClassFromThreads)
+{
+   ROOT::EnableThreadSafety();
+   TClass *byName = TClass::GetClass("TNamed");
+   ASSERT_NE(nullptr, byName);
+   EXPECT_EQ(byName, TClass::GetClass(typeid(TNamed)));
+
+   std::vector<std::thread> threads;
+   std::atomic<int> nMismatches{0};
+   for (int t = 0; t < 8; ++t) {
+      threads.emplace_back([&]() {
+         for (int i = 0; i < 10000; ++i) {
+            if (TClass::GetClass("TNamed") != byName || TClass::GetClass(typeid(TNamed)) != byName)
+               ++nMismatches;
+         }
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+   EXPECT_EQ(0, nMismatches);
+
+   // Other spellings of the name still go through the normalization.
+   EXPECT_EQ(byName, TClass::GetClass("class TNamed"));
+   EXPECT_EQ(nullptr, TClass::GetClass("TNamedDoesNotExist"));
+}
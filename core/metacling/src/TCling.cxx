@@ -20,6 +20,8 @@ clang/LLVM technology.
 #include "TCling.h"
 
 #include "ROOT/FoundationUtils.hxx"
+#include "ROOT/RMemoryAccounting.hxx"
+#include "ROOT/RTrace.hxx"
 
 #include "TClingBaseClassInfo.h"
 #include "TClingCallFunc.h"
@@ -88,6 +90,7 @@ clang/LLVM technology.
 #include "clang/AST/RecursiveASTVisitor.h"
 #include "clang/AST/Type.h"
 #include "clang/Basic/SourceLocation.h"
+#include "clang/Basic/SourceManager.h"
 #include "clang/Basic/Specifiers.h"
 #include "clang/Basic/TargetInfo.h"
 #include "clang/CodeGen/ModuleBuilder.h"
@@ -118,6 +121,7 @@ clang/LLVM technology.
 #include "llvm/IR/Module.h"
 
 #include "llvm/Support/DynamicLibrary.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
@@ -1541,6 +1545,8 @@ TCling::TCling(const char *name, const char *title, const char* const argv[])
    fMetaProcessor = llvm::make_unique<cling::MetaProcessor>(*fInterpreter, fMPOuts);
 
    RegisterCxxModules(*fInterpreter);
+   ROOT::Internal::TraceStartup(fCxxModulesEnabled ? "cling::Interpreter and C++ modules" : "cling::Interpreter and PCH");
+
    RegisterPreIncludedHeaders(*fInterpreter);
 
    // We are now ready (enough is loaded) to init the list of opaque typedefs.
@@ -1585,6 +1591,19 @@ TCling::TCling(const char *name, const char *title, const char* const argv[])
       // Initialize the dyld for the llvmLazyFunctionCreator.
       DLM.initializeDyld(ShouldPermanentlyIgnore);
       fInterpreter->installLazyFunctionCreator(llvmLazyFunctionCreator);
+
+      // The memory of the interpreter is dominated by the AST and the source buffers, which clang
+      // allocates from its own arenas; their size is queried when the memory usage is requested.
+      using ROOT::Experimental::RMemoryAccounting;
+      RMemoryAccounting::SetProbe(RMemoryAccounting::ESubsystem::kInterpreter, []() -> std::int64_t {
+         auto cling = static_cast<TCling *>(gCling);
+         if (!cling || cling->fIsShuttingDown)
+            return 0;
+         R__LOCKGUARD(gInterpreterMutex);
+         const clang::ASTContext &C = cling->fInterpreter->getCI()->getASTContext();
+         return C.getASTAllocatedMemory() + C.getSideTableAllocatedMemory() +
+                C.getSourceManager().getContentCacheSize();
+      });
    }
 }
 
@@ -1599,6 +1618,8 @@ TCling::~TCling()
    if (!IsFromRootCling())
       GetInterpreterImpl()->runAtExitFuncs();
    fIsShuttingDown = true;
+   ROOT::Experimental::RMemoryAccounting::SetProbe(ROOT::Experimental::RMemoryAccounting::ESubsystem::kInterpreter,
+                                                   nullptr);
    delete fMapfile;
    delete fRootmapFiles;
    delete fTemporaries;
@@ -1624,8 +1645,10 @@ void TCling::Initialize()
    // Note this call must happen before the first call to LoadLibraryMap.
    assert(GetRootMapFiles() == 0 && "Must be called before LoadLibraryMap!");
    TClass::ReadRules(); // Read the default customization rules ...
+   ROOT::Internal::TraceStartup("TClass::ReadRules");
 
    LoadLibraryMap();
+   ROOT::Internal::TraceStartup("rootmap files");
    SetClassAutoLoading(true);
 }
 
@@ -1840,6 +1863,19 @@ void TCling::LoadPCM(std::string pcmFileNameFullPath)
       Fatal("LoadPCM", "The file %s is not a ROOT as was expected\n", pcmFileName.Data());
       return;
    }
+
+   // Map the PCM read-only instead of reading it through TFile: its pages are then backed by
+   // the page cache and shared by all the processes loading the same dictionaries on the node.
+   auto pcmBuffer = llvm::MemoryBuffer::getFile(pcmFileNameFullPath, /*FileSize=*/-1,
+                                                /*RequiresNullTerminator=*/false);
+   if (pcmBuffer) {
+      TMemFile::ZeroCopyView_t range{(*pcmBuffer)->getBufferStart(), (*pcmBuffer)->getBufferSize()};
+      std::string RDictFileOpts = pcmFileNameFullPath + "?filetype=pcm";
+      TMemFile pcmMemFile(RDictFileOpts.c_str(), range);
+      LoadPCMImpl(pcmMemFile);
+      return;
+   }
+
    TFile pcmFile(pcmFileName + "?filetype=pcm", "READ");
    LoadPCMImpl(pcmFile);
 }
@@ -2403,6 +2439,7 @@ bool TCling::DiagnoseIfInterpreterException(const std::exception &e) const
 
 Long_t TCling::ProcessLine(const char* line, EErrorCode* error/*=0*/)
 {
+   R__TRACE_SCOPE("jit", "TCling::ProcessLine");
    // Copy the passed line, it comes from a static buffer in TApplication
    // which can be reentered through the Cling evaluation routines,
    // which would overwrite the static buffer and we would forget what we
@@ -2995,6 +3032,7 @@ void TCling::ClearStack()
 
 bool TCling::Declare(const char* code)
 {
+   R__TRACE_SCOPE("jit", "TCling::Declare");
    R__LOCKGUARD_CLING(gInterpreterMutex);
 
    SuspendAutoLoadingRAII autoLoadOff(this);
@@ -6246,6 +6284,7 @@ UInt_t TCling::AutoParseImplRecurse(const char *cls, bool topLevel)
 
 Int_t TCling::AutoParse(const char *cls)
 {
+   R__TRACE_SCOPE("jit", "TCling::AutoParse");
    if (llvm::StringRef(cls).contains("(lambda)"))
       return 0;
 
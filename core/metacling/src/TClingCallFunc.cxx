@@ -65,6 +65,9 @@ C++ interpreter and the Clang C++ compiler, not CINT.
 
 #include "clang/Sema/SemaInternal.h"
 
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
 #include <map>
 #include <string>
 #include <sstream>
@@ -77,10 +80,44 @@ using namespace std;
 static unsigned long long gWrapperSerial = 0LL;
 static const string kIndentString("   ");
 
+// The wrappers are keyed by canonical declaration, so that all the redeclarations of a function or a class
+// (e.g. one from the PCH and one from a header parsed later) share a single compiled wrapper.
 static map<const FunctionDecl *, void *> gWrapperStore;
 static map<const Decl *, void *> gCtorWrapperStore;
 static map<const Decl *, void *> gDtorWrapperStore;
 
+namespace {
+/// Counts and times the wrapper compilations, the most expensive step of a first call through TClingCallFunc.
+/// The summary is printed at exit if the environment variable ROOT_CALLFUNC_STATS is set.
+struct TWrapperStats {
+   unsigned long long fNCompiled = 0; ///< Wrappers successfully compiled
+   unsigned long long fNFailed = 0;   ///< Wrappers that failed to compile
+   unsigned long long fNReused = 0;   ///< Lookups served by an already compiled wrapper
+   double fSeconds = 0.;              ///< Time spent compiling wrappers
+
+   ~TWrapperStats()
+   {
+      if (!std::getenv("ROOT_CALLFUNC_STATS"))
+         return;
+      fprintf(stderr,
+              "TClingCallFunc: %llu wrappers compiled in %.3f s (%.3f ms each), %llu failed, %llu reused\n",
+              fNCompiled, fSeconds, fNCompiled ? 1e3 * fSeconds / fNCompiled : 0., fNFailed, fNReused);
+   }
+};
+}
+
+static TWrapperStats gWrapperStats;
+
+template <class Store, class Key>
+static void *FindWrapper(Store &store, Key *D)
+{
+   auto I = store.find(D->getCanonicalDecl());
+   if (I == store.end())
+      return nullptr;
+   ++gWrapperStats.fNReused;
+   return I->second;
+}
+
 static
 inline
 void
@@ -264,8 +301,18 @@ size_t TClingCallFunc::CalculateMinRequiredArguments()
 void *TClingCallFunc::compile_wrapper(const string &wrapper_name, const string &wrapper,
                                       bool withAccessControl/*=true*/)
 {
-   return fInterp->compileFunction(wrapper_name, wrapper, false /*ifUnique*/,
-                                   withAccessControl);
+   const auto start = std::chrono::steady_clock::now();
+   void *F = fInterp->compileFunction(wrapper_name, wrapper, false /*ifUnique*/,
+                                      withAccessControl);
+   const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   gWrapperStats.fSeconds += seconds;
+   if (F)
+      ++gWrapperStats.fNCompiled;
+   else
+      ++gWrapperStats.fNFailed;
+   if (gDebug > 5)
+      ::Info("TClingCallFunc::compile_wrapper", "compiled %s in %.3f ms", wrapper_name.c_str(), 1e3 * seconds);
+   return F;
 }
 
 void TClingCallFunc::collect_type_info(QualType &QT, ostringstream &typedefbuf, std::ostringstream &callbuf,
@@ -1093,7 +1140,7 @@ tcling_callfunc_Wrapper_t TClingCallFunc::make_wrapper()
    //
    void *F = compile_wrapper(wrapper_name, wrapper);
    if (F) {
-      gWrapperStore.insert(make_pair(FD, F));
+      gWrapperStore.insert(make_pair(FD->getCanonicalDecl(), F));
    } else {
       ::Error("TClingCallFunc::make_wrapper",
             "Failed to compile\n  ==== SOURCE BEGIN ====\n%s\n  ==== SOURCE END ====",
@@ -1303,7 +1350,7 @@ tcling_callfunc_ctor_Wrapper_t TClingCallFunc::make_ctor_wrapper(const TClingCla
    void *F = compile_wrapper(wrapper_name, wrapper,
                              /*withAccessControl=*/false);
    if (F) {
-      gCtorWrapperStore.insert(make_pair(info->GetDecl(), F));
+      gCtorWrapperStore.insert(make_pair(info->GetDecl()->getCanonicalDecl(), F));
    } else {
       ::Error("TClingCallFunc::make_ctor_wrapper",
             "Failed to compile\n  ==== SOURCE BEGIN ====\n%s\n  ==== SOURCE END ====",
@@ -1467,7 +1514,7 @@ TClingCallFunc::make_dtor_wrapper(const TClingClassInfo *info)
    void *F = compile_wrapper(wrapper_name, wrapper,
                              /*withAccessControl=*/false);
    if (F) {
-      gDtorWrapperStore.insert(make_pair(info->GetDecl(), F));
+      gDtorWrapperStore.insert(make_pair(info->GetDecl()->getCanonicalDecl(), F));
    } else {
       ::Error("TClingCallFunc::make_dtor_wrapper",
             "Failed to compile\n  ==== SOURCE BEGIN ====\n%s\n  ==== SOURCE END ====",
@@ -2162,12 +2209,9 @@ void *TClingCallFunc::ExecDefaultConstructor(const TClingClassInfo *info,
       //         info->Name());
       //   return 0;
       //}
-      auto I = gCtorWrapperStore.find(D);
-      if (I != gCtorWrapperStore.end()) {
-         wrapper = (tcling_callfunc_ctor_Wrapper_t) I->second;
-      } else {
+      wrapper = (tcling_callfunc_ctor_Wrapper_t) FindWrapper(gCtorWrapperStore, D);
+      if (!wrapper)
          wrapper = make_ctor_wrapper(info, kind, type_name);
-      }
    }
    if (!wrapper) {
       ::Error("TClingCallFunc::ExecDefaultConstructor",
@@ -2191,12 +2235,9 @@ void TClingCallFunc::ExecDestructor(const TClingClassInfo *info, void *address /
    {
       R__LOCKGUARD_CLING(gInterpreterMutex);
       const Decl *D = info->GetDecl();
-      map<const Decl *, void *>::iterator I = gDtorWrapperStore.find(D);
-      if (I != gDtorWrapperStore.end()) {
-         wrapper = (tcling_callfunc_dtor_Wrapper_t) I->second;
-      } else {
+      wrapper = (tcling_callfunc_dtor_Wrapper_t) FindWrapper(gDtorWrapperStore, D);
+      if (!wrapper)
          wrapper = make_dtor_wrapper(info);
-      }
    }
    if (!wrapper) {
       ::Error("TClingCallFunc::ExecDestructor",
@@ -2242,12 +2283,9 @@ void *TClingCallFunc::InterfaceMethod()
       const FunctionDecl *decl = GetDecl();
 
       R__LOCKGUARD_CLING(gInterpreterMutex);
-      map<const FunctionDecl *, void *>::iterator I = gWrapperStore.find(decl);
-      if (I != gWrapperStore.end()) {
-         fWrapper = (tcling_callfunc_Wrapper_t) I->second;
-      } else {
+      fWrapper = (tcling_callfunc_Wrapper_t) FindWrapper(gWrapperStore, decl);
+      if (!fWrapper)
          fWrapper = make_wrapper();
-      }
    }
    return (void *)fWrapper;
 }
@@ -2271,12 +2309,9 @@ TInterpreter::CallFuncIFacePtr_t TClingCallFunc::IFacePtr()
       const FunctionDecl *decl = GetDecl();
 
       R__LOCKGUARD_CLING(gInterpreterMutex);
-      map<const FunctionDecl *, void *>::iterator I = gWrapperStore.find(decl);
-      if (I != gWrapperStore.end()) {
-         fWrapper = (tcling_callfunc_Wrapper_t) I->second;
-      } else {
+      fWrapper = (tcling_callfunc_Wrapper_t) FindWrapper(gWrapperStore, decl);
+      if (!fWrapper)
          fWrapper = make_wrapper();
-      }
 
       fReturnIsRecordType = decl->getReturnType().getCanonicalType()->isRecordType();
    }
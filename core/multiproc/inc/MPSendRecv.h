@@ -53,6 +53,12 @@ int MPSend(TSocket *s, unsigned code, T obj);
 
 MPCodeBufPair MPRecv(TSocket *s);
 
+// Send a code and an object already streamed in objBuf, through shared memory if it is large.
+int MPSendObjBuf(TSocket *s, unsigned code, const TBufferFile &objBuf);
+
+void MPSetShmThreshold(ULong_t nBytes);
+ULong_t MPGetShmThreshold();
+
 
 //this version reads classes from the message
 template<class T, typename std::enable_if<std::is_class<T>::value>::type * = nullptr>
@@ -84,6 +90,7 @@ T ReadBuffer(TBufferFile *buf);
 /// cling can be sent using MPSend(). User-defined types can be made available to
 /// cling via a call like `gSystem->ProcessLine("#include \"header.h\"")`.
 /// Pointer types cannot be sent via MPSend() (with the exception of const char*).
+/// Objects larger than MPGetShmThreshold() are passed in a shared memory segment, see MPSendObjBuf().
 /// \param s a pointer to a valid TSocket. No validity checks are performed\n
 /// \param code the code to be sent
 /// \param obj the object to be sent
@@ -98,11 +105,7 @@ int MPSend(TSocket *s, unsigned code, T obj)
    }
    TBufferFile objBuf(TBuffer::kWrite);
    objBuf.WriteObjectAny(&obj, c);
-   TBufferFile wBuf(TBuffer::kWrite);
-   wBuf.WriteUInt(code);
-   wBuf.WriteULong(objBuf.Length());
-   wBuf.WriteBuf(objBuf.Buffer(), objBuf.Length());
-   return s->SendRaw(wBuf.Buffer(), wBuf.Length());
+   return MPSendObjBuf(s, code, objBuf);
 }
 
 /// \cond
@@ -137,14 +140,7 @@ int MPSend(TSocket *s, unsigned code, T obj)
    TBufferFile objBuf(TBuffer::kWrite);
    if(obj != nullptr)
       objBuf.WriteObjectAny(obj, obj->IsA());
-
-   //write everything together in a buffer
-   TBufferFile wBuf(TBuffer::kWrite);
-   wBuf.WriteUInt(code);
-   wBuf.WriteULong(objBuf.Length());
-   if(objBuf.Length())
-      wBuf.WriteBuf(objBuf.Buffer(), objBuf.Length());
-   return s->SendRaw(wBuf.Buffer(), wBuf.Length());
+   return MPSendObjBuf(s, code, objBuf);
 }
 
 /// \endcond
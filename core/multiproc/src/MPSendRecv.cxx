@@ -12,7 +12,91 @@
 #include "MPSendRecv.h"
 #include "TBufferFile.h"
 #include "MPCode.h"
+#include <atomic>
+#include <cstdio> //snprintf
+#include <cstring> //memcpy
 #include <memory> //unique_ptr
+#include <fcntl.h> //O_* constants
+#include <sys/mman.h> //shm_open, mmap
+#include <unistd.h> //ftruncate, close, getpid
+
+namespace {
+
+/// Set on the code of the messages that carry the name of a shared memory segment instead of their object
+constexpr unsigned kShmCodeBit = 1u << 31;
+/// Maximum length of the name of a shared memory segment, including the trailing \0
+constexpr int kShmNameSize = 64;
+
+std::atomic<ULong_t> gShmThreshold{1024 * 1024};
+
+/// A TBufferFile that reads an object from a mapped shared memory segment, and unmaps it when destroyed.
+class TMPShmBuffer : public TBufferFile {
+   void *fAddr;
+   size_t fSize;
+
+public:
+   TMPShmBuffer(void *addr, size_t size) : TBufferFile(TBuffer::kRead, size, addr, false), fAddr(addr), fSize(size) {}
+   ~TMPShmBuffer() { munmap(fAddr, fSize); }
+};
+
+//////////////////////////////////////////////////////////////////////////
+/// Copy the object in a new shared memory segment and send its name and size on the socket.
+/// Return -1 without sending anything if the segment could not be created.
+int SendShm(TSocket *s, unsigned code, const TBufferFile &objBuf)
+{
+   static std::atomic<unsigned> nSegments{0};
+   const size_t size = objBuf.Length();
+   char name[kShmNameSize];
+   snprintf(name, kShmNameSize, "/rootmp.%d.%u", getpid(), nSegments++);
+   int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+   if (fd < 0)
+      return -1;
+   void *addr = MAP_FAILED;
+   if (ftruncate(fd, size) == 0)
+      addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   close(fd);
+   if (addr == MAP_FAILED) {
+      shm_unlink(name);
+      return -1;
+   }
+   memcpy(addr, objBuf.Buffer(), size);
+   munmap(addr, size);
+
+   TBufferFile nameBuf(TBuffer::kWrite);
+   nameBuf.WriteULong(size);
+   nameBuf.WriteString(name);
+   TBufferFile wBuf(TBuffer::kWrite);
+   wBuf.WriteUInt(code | kShmCodeBit);
+   wBuf.WriteULong(nameBuf.Length());
+   wBuf.WriteBuf(nameBuf.Buffer(), nameBuf.Length());
+   const int nBytes = s->SendRaw(wBuf.Buffer(), wBuf.Length());
+   if (nBytes <= 0)
+      shm_unlink(name); // nobody will ever read it
+   return nBytes;
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Map the shared memory segment named in the message sent by SendShm and remove its name, so that it is freed
+/// as soon as it is unmapped. Return nullptr if the segment could not be mapped.
+std::unique_ptr<TBufferFile> RecvShm(TBufferFile &nameBuf)
+{
+   ULong_t size;
+   nameBuf.ReadULong(size);
+   char name[kShmNameSize];
+   nameBuf.ReadString(name, kShmNameSize);
+   int fd = shm_open(name, O_RDONLY, 0);
+   if (fd < 0)
+      return nullptr;
+   shm_unlink(name);
+   // a private mapping, so that the buffer can be written to without affecting the segment
+   void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (addr == MAP_FAILED)
+      return nullptr;
+   return std::unique_ptr<TBufferFile>(new TMPShmBuffer(addr, size));
+}
+
+} // namespace
 
 //////////////////////////////////////////////////////////////////////////
 /// Send a message with the specified code on the specified socket.
@@ -82,5 +166,61 @@ MPCodeBufPair MPRecv(TSocket *s)
       objBuf.reset(new TBufferFile(TBuffer::kRead, classBufSize, classBuf, true)); //the buffer is deleted by TBuffer's dtor
    }
 
+   if (code & kShmCodeBit) {
+      code &= ~kShmCodeBit;
+      objBuf = RecvShm(*objBuf);
+      if (!objBuf)
+         return std::make_pair(MPCode::kRecvError, nullptr);
+   }
+
    return std::make_pair(code, std::move(objBuf));
 }
+
+
+//////////////////////////////////////////////////////////////////////////
+/// Send a message with a code and an object already streamed in a TBufferFile.
+/// If the object is larger than MPGetShmThreshold(), it is copied in a POSIX
+/// shared memory segment and only the name of the segment is sent on the socket:
+/// MPRecv() then reads the object directly from the mapped segment, instead of
+/// receiving it from the socket into a new buffer. The segment is freed as soon
+/// as the received buffer is destroyed. If the segment cannot be created, e.g.
+/// because /dev/shm is full, the object is sent on the socket.
+/// \param s a pointer to a valid TSocket. No validity checks are performed\n
+/// \param code the code to be sent
+/// \param objBuf the streamed object to be sent, or an empty buffer
+/// \return the number of bytes sent, as per TSocket::SendRaw
+int MPSendObjBuf(TSocket *s, unsigned code, const TBufferFile &objBuf)
+{
+   const ULong_t threshold = gShmThreshold;
+   if (threshold > 0 && ULong_t(objBuf.Length()) >= threshold) {
+      const int nBytes = SendShm(s, code, objBuf);
+      if (nBytes >= 0)
+         return nBytes;
+   }
+
+   TBufferFile wBuf(TBuffer::kWrite);
+   wBuf.WriteUInt(code);
+   wBuf.WriteULong(objBuf.Length());
+   if (objBuf.Length())
+      wBuf.WriteBuf(objBuf.Buffer(), objBuf.Length());
+   return s->SendRaw(wBuf.Buffer(), wBuf.Length());
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// Set the size in bytes above which MPSend() passes objects in shared memory
+/// rather than on the socket, 1 MB by default. 0 disables the shared memory
+/// transport. It must be called before the workers are forked to affect the
+/// results they send.
+void MPSetShmThreshold(ULong_t nBytes)
+{
+   gShmThreshold = nBytes;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+/// Return the size in bytes above which MPSend() passes objects in shared memory.
+ULong_t MPGetShmThreshold()
+{
+   return gShmThreshold;
+}
@@ -11,6 +11,7 @@
  *************************************************************************/
 
 #include "ROOT/TProcessExecutor.hxx"
+#include "TClass.h"
 
 //////////////////////////////////////////////////////////////////////////
 ///
@@ -53,7 +54,14 @@
 /// in a lambda or via std::bind to give it the right signature.\n
 /// **Note:** the user should take care of initializing random seeds differently in each
 /// process (e.g. using the process id in the seed). Otherwise several parallel executions
-/// might generate the same sequence of pseudo-random numbers.
+/// might generate the same sequence of pseudo-random numbers.\n
+/// **Note:** results larger than MPGetShmThreshold() (1 MB by default) are passed from the
+/// workers through POSIX shared memory instead of the sockets, and read by the client
+/// without further copies. The threshold can be changed with MPSetShmThreshold().\n
+/// **Note:** the workers are forked from the client session and share its memory
+/// until they modify it. Dictionaries that are only loaded by the workers, on first
+/// use of their classes, are instead loaded and initialized again by each of them.
+/// Preload() loads them once in the client, before the workers are forked.
 ///
 /// #### Return value:
 /// An std::vector. The elements in the container
@@ -91,6 +99,23 @@ TProcessExecutor::TProcessExecutor(unsigned nWorkers) : TMPClient(nWorkers)
    Reset();
 }
 
+//////////////////////////////////////////////////////////////////////////
+/// Load the dictionaries of the given classes, and build their TClass and
+/// streamer info, in this process. Called before Map or MapReduce, this
+/// initializes the interpreter and dictionary state once: the forked workers
+/// share it with the client instead of each building its own copy.
+void TProcessExecutor::Preload(const std::vector<std::string> &classNames)
+{
+   for (const auto &name : classNames) {
+      TClass *cl = TClass::GetClass(name.c_str());
+      if (!cl) {
+         Warning("TProcessExecutor::Preload", "[W][C] Unknown class %s", name.c_str());
+         continue;
+      }
+      cl->GetStreamerInfo();
+   }
+}
+
 //////////////////////////////////////////////////////////////////////////
 /// Reset TProcessExecutor's state.
 void TProcessExecutor::Reset()
@@ -19,6 +19,7 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <functional>
 #include <thread>
 #include <unordered_map>
 
@@ -85,20 +86,52 @@ struct UniqueLockRecurseCount {
    size_t &GetLocalReadersCount(local_t &local) { return local->fReadersCount; }
 };
 
+/// Trackers of the re-entries in the lock that do not rely on thread local
+/// storage. The per-thread read counts live in a fixed-size table of slots
+/// claimed (once and for all) by each thread with a compare-and-swap, such
+/// that the read lock does not need to take the internal mutex of the lock.
+/// Only once all slots are in use do the read counts of the additional
+/// threads go to a map protected by the internal mutex.
 struct RecurseCounts {
    using Hint_t = TVirtualRWMutex::Hint_t;
    using ReaderColl_t = std::unordered_map<std::thread::id, size_t>;
-   size_t fWriteRecurse; ///<! Number of re-entry in the lock by the same thread.
+
+   static constexpr size_t kNSlots = 128; ///< Number of threads whose read count does not need the mutex.
+
+   /// Read count of one thread; on its own cache line to not share it with other threads.
+   struct alignas(64) ReaderSlot {
+      std::atomic<std::thread::id> fThread{std::thread::id()}; ///<! Thread owning this slot, if any
+      size_t fCount = 0;                                       ///<! Number of read locks held by fThread
+   };
+
+   size_t fWriteRecurse = 0; ///<! Number of re-entry in the lock by the same thread.
 
    std::thread::id fWriterThread; ///<! Holder of the write lock
-   ReaderColl_t fReadersCount;    ///<! Set of reader thread ids
+   ReaderSlot fSlots[kNSlots];    ///<! Read counts of the first kNSlots threads
+   ReaderColl_t fReadersCount;    ///<! Read counts of the other threads, protected by the internal mutex
 
    using local_t = std::thread::id;
 
    local_t GetLocal() const { return std::this_thread::get_id(); }
 
+   /// Return the slot read count of the thread `local`, claiming a slot if
+   /// needed, or nullptr if all slots are owned by other threads.
+   size_t *FindSlotCount(local_t &local)
+   {
+      const size_t start = std::hash<std::thread::id>()(local);
+      for (size_t i = 0; i < kNSlots; ++i) {
+         auto &slot = fSlots[(start + i) % kNSlots];
+         auto owner = slot.fThread.load(std::memory_order_acquire);
+         if (owner == std::thread::id() && slot.fThread.compare_exchange_strong(owner, local))
+            return &slot.fCount;
+         if (owner == local)
+            return &slot.fCount;
+      }
+      return nullptr;
+   }
+
    Hint_t *IncrementReadCount(local_t &local) {
-      auto &count = fReadersCount[local];
+      auto &count = GetLocalReadersCount(local);
       ++(count);
       return reinterpret_cast<TVirtualRWMutex::Hint_t *>(&count);
    }
@@ -106,12 +139,16 @@ struct RecurseCounts {
    template <typename MutexT>
    Hint_t *IncrementReadCount(local_t &local, MutexT &mutex)
    {
+      if (auto count = FindSlotCount(local)) {
+         ++(*count);
+         return reinterpret_cast<TVirtualRWMutex::Hint_t *>(count);
+      }
       std::unique_lock<MutexT> lock(mutex);
       return IncrementReadCount(local);
    }
 
    Hint_t *DecrementReadCount(local_t &local) {
-      auto &count = fReadersCount[local];
+      auto &count = GetLocalReadersCount(local);
       --count;
       return reinterpret_cast<TVirtualRWMutex::Hint_t *>(&count);
    }
@@ -119,12 +156,16 @@ struct RecurseCounts {
    template <typename MutexT>
    Hint_t *DecrementReadCount(local_t &local, MutexT &mutex)
    {
+      if (auto count = FindSlotCount(local)) {
+         --(*count);
+         return reinterpret_cast<TVirtualRWMutex::Hint_t *>(count);
+      }
       std::unique_lock<MutexT> lock(mutex);
       return DecrementReadCount(local);
    }
 
    void ResetReadCount(local_t &local, int newvalue) {
-      fReadersCount[local] = newvalue;
+      GetLocalReadersCount(local) = newvalue;
    }
 
    bool IsCurrentWriter(local_t &local) const { return fWriterThread == local; }
@@ -143,7 +184,14 @@ struct RecurseCounts {
 
    void ResetIsWriter(local_t & /* local */) { fWriterThread = std::thread::id(); }
 
-   size_t &GetLocalReadersCount(local_t &local) { return fReadersCount[local]; }
+   /// Return the read count of the thread `local`; the internal mutex must be
+   /// held unless the thread owns a slot.
+   size_t &GetLocalReadersCount(local_t &local)
+   {
+      if (auto count = FindSlotCount(local))
+         return *count;
+      return fReadersCount[local];
+   }
 
 
 };
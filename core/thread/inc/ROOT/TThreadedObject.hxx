@@ -130,6 +130,44 @@ namespace ROOT {
          }
          target->Merge(&objTList);
       }
+
+      template<class T>
+      using PairMergeFunctionType = std::function<void(std::shared_ptr<T>, std::shared_ptr<T>)>;
+
+      /// Runs a function on each index in [0, n), possibly concurrently, e.g. with ROOT::TThreadExecutor::Foreach
+      using ForeachFunctionType = std::function<void(unsigned, const std::function<void(unsigned)> &)>;
+
+      /// Merge a TObject into another
+      template<class T>
+      void MergeTObjectPair(std::shared_ptr<T> target, std::shared_ptr<T> source)
+      {
+         TList objTList;
+         objTList.Add(source.get());
+         target->Merge(&objTList);
+      }
+
+      /// Merge the objects into the first one in log2(N) rounds: in the round of a given step, the object at index
+      /// i + step is merged into the one at index i, for all i multiple of 2 * step. The merges of a round are
+      /// independent and are run with `foreach`, or in sequence if it is empty.
+      template<class T>
+      void TreeMergeObjects(std::vector<std::shared_ptr<T>> &objs, const ForeachFunctionType &foreach,
+                            const PairMergeFunctionType<T> &mergePair)
+      {
+         const unsigned nObjs = objs.size();
+         for (unsigned step = 1; step < nObjs; step *= 2) {
+            const unsigned nPairs = (nObjs + step - 1) / (2 * step);
+            const std::function<void(unsigned)> mergePairAt = [&objs, &mergePair, step](unsigned pair) {
+               const auto i = 2 * step * pair;
+               mergePair(objs[i], objs[i + step]);
+            };
+            if (foreach) {
+               foreach(nPairs, mergePairAt);
+            } else {
+               for (auto pair = 0u; pair < nPairs; ++pair)
+                  mergePairAt(pair);
+            }
+         }
+      }
    } // end of namespace TThreadedObjectUtils
 
    /**
@@ -322,6 +360,69 @@ namespace ROOT {
          return std::unique_ptr<T>(targetPtr);
       }
 
+      /// Merge all the thread private objects in log2(N) rounds of pairwise merges. The merges of a round are
+      /// independent: if `foreach` runs them in parallel, merging takes about as long as log2(N) merges of two objects
+      /// instead of N. Like Merge, it can be called once and collapses all objects into the one at slot 0.
+      /// ~~~{.cpp}
+      /// ROOT::TThreadExecutor pool;
+      /// auto foreach = [&pool](unsigned n, const std::function<void(unsigned)> &f) { pool.Foreach(f, ROOT::TSeqU(n)); };
+      /// auto h = tthreadedHisto.TreeMerge(foreach);
+      /// ~~~
+      std::shared_ptr<T> TreeMerge(TThreadedObjectUtils::ForeachFunctionType foreach = nullptr,
+                                   TThreadedObjectUtils::PairMergeFunctionType<T> mergePair = TThreadedObjectUtils::MergeTObjectPair<T>)
+      {
+         if (fIsMerged) {
+            Warning("TThreadedObject::TreeMerge", "This object was already merged. Returning the previous result.");
+            return fObjPointers[0];
+         }
+         std::vector<std::shared_ptr<T>> objs;
+         for (auto &obj : fObjPointers)
+            if (obj)
+               objs.emplace_back(obj);
+         if (!objs.empty()) {
+            TThreadedObjectUtils::TreeMergeObjects(objs, foreach, mergePair);
+            fObjPointers[0] = objs[0];
+         }
+         fIsMerged = true;
+         return fObjPointers[0];
+      }
+
+      /// Merge all the thread private objects in log2(N) rounds of pairwise merges like TreeMerge, without modifying
+      /// them: can be called many times. The first round merges each pair of objects into a copy of its first object,
+      /// so that half of the objects are copied, and the next rounds merge these copies.
+      std::unique_ptr<T> SnapshotTreeMerge(TThreadedObjectUtils::ForeachFunctionType foreach = nullptr,
+                                           TThreadedObjectUtils::PairMergeFunctionType<T> mergePair = TThreadedObjectUtils::MergeTObjectPair<T>)
+      {
+         if (fIsMerged) {
+            Warning("TThreadedObject::SnapshotTreeMerge", "This object was already merged. Returning the previous result.");
+            return std::unique_ptr<T>(Internal::TThreadedObjectUtils::Cloner<T>::Clone(fObjPointers[0].get()));
+         }
+         std::vector<std::shared_ptr<T>> objs;
+         for (auto &obj : fObjPointers)
+            if (obj)
+               objs.emplace_back(obj);
+         if (objs.empty())
+            return std::unique_ptr<T>(Internal::TThreadedObjectUtils::Cloner<T>::Clone(fModel.get()));
+
+         const unsigned nPairs = (objs.size() + 1) / 2;
+         std::vector<std::unique_ptr<T>> copies(nPairs);
+         std::vector<std::shared_ptr<T>> partials(nPairs);
+         const std::function<void(unsigned)> mergeFirstPair = [&](unsigned pair) {
+            copies[pair].reset(Internal::TThreadedObjectUtils::Cloner<T>::Clone(objs[2 * pair].get()));
+            partials[pair] = std::shared_ptr<T>(copies[pair].get(), [](T *) {});
+            if (2 * pair + 1 < objs.size())
+               mergePair(partials[pair], objs[2 * pair + 1]);
+         };
+         if (foreach) {
+            foreach(nPairs, mergeFirstPair);
+         } else {
+            for (auto pair = 0u; pair < nPairs; ++pair)
+               mergeFirstPair(pair);
+         }
+         TThreadedObjectUtils::TreeMergeObjects(partials, foreach, mergePair);
+         return std::move(copies[0]);
+      }
+
    private:
       std::unique_ptr<T> fModel;                         ///< Use to store a "model" of the object
       // std::deque's guarantee that references to the elements are not invalidated when appending new slots
@@ -566,3 +566,9 @@ TEST(RWLock, LargeconcurrentReadsAndWritesTL)
 {
    concurrentReadsAndWrites(gRWMutexTL, 10, 20, gRepetition / 10000);
 }
+
+TEST(RWLock, concurrentReadsAndWritesManyThreads)
+{
+   // More reader threads than the read count slots of RecurseCounts
+   concurrentReadsAndWrites(gRWMutexStd, 4, 2 * ROOT::Internal::RecurseCounts::kNSlots, 20);
+}
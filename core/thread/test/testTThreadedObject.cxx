@@ -5,6 +5,7 @@
 #include "gtest/gtest.h"
 
 #include <condition_variable>
+#include <functional>
 #include <mutex>
 #include <thread>
 
@@ -128,6 +129,41 @@ TEST(TThreadedObject, SnapshotMerge)
    EXPECT_TRUE(hsum1 != hsum0);
 }
 
+/// Run the merges of each round in their own threads
+void ForeachInThreads(unsigned n, const std::function<void(unsigned)> &f)
+{
+   std::vector<std::thread> threads;
+   for (auto i = 0u; i < n; ++i)
+      threads.emplace_back(f, i);
+   for (auto &t : threads)
+      t.join();
+}
+
+TEST(TThreadedObject, TreeMerge)
+{
+   TH1::AddDirectory(false);
+
+   const auto nSlots = 7u;
+   TH1F expected("h", "h", 64, -4, 4);
+   ROOT::TThreadedObject<TH1F> tto(ROOT::TNumSlots{nSlots}, "h", "h", 64, -4, 4);
+   for (auto slot = 0u; slot < nSlots; ++slot) {
+      gRandom->SetSeed(slot + 1);
+      tto.GetAtSlot(slot)->FillRandom("gaus", 100);
+      gRandom->SetSeed(slot + 1);
+      expected.FillRandom("gaus", 100);
+   }
+
+   auto snapshot = tto.SnapshotTreeMerge(ForeachInThreads);
+   IsHistEqual(*snapshot, expected);
+   // the snapshot did not modify the thread private objects
+   auto sequentialSnapshot = tto.SnapshotTreeMerge();
+   IsHistEqual(*sequentialSnapshot, expected);
+
+   auto hsum = tto.TreeMerge(ForeachInThreads);
+   IsHistEqual(*hsum, expected);
+   EXPECT_EQ(hsum, tto.GetAtSlot(0));
+}
+
 TEST(TThreadedObject, GrowSlots)
 {
    // create a TThreadedObject with 3 slots...
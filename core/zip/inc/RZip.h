@@ -17,6 +17,8 @@
 #ifndef ROOT_RZip
 #define ROOT_RZip
 
+#include <cstddef>
+
 extern "C" unsigned long R__crc32(unsigned long crc, const unsigned char* buf, unsigned int len);
 
 extern "C" unsigned long R__memcompress(char *tgt, unsigned long tgtsize, char *src, unsigned long srcsize);
@@ -33,6 +35,31 @@ extern "C" void R__unzip(int *srcsize, unsigned char *src, int *tgtsize, unsigne
 
 extern "C" int R__unzip_header(int *srcsize, unsigned char *src, int *tgtsize);
 
+/**
+ * Variants using a trained compression dictionary; only ZSTD makes use of it.  Buffers compressed by
+ * R__zipMultipleAlgorithmDict need the same dictionary in R__unzipDict, see R__unzip_needs_dict.
+ */
+extern "C" void R__zipMultipleAlgorithmDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep,
+                                            ROOT::RCompressionSetting::EAlgorithm::EValues, const char *dict,
+                                            int dictsize);
+
+extern "C" void R__unzipDict(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep,
+                             const char *dict, int dictsize);
+
+extern "C" int R__unzip_needs_dict(int srcsize, unsigned char *src);
+
+extern "C" int R__trainDictZSTD(char *dict, int dictcapacity, const char *samples, const size_t *samplesizes,
+                                unsigned int nsamples);
+
+/**
+ * Compress or decompress a buffer of any size as a sequence of blocks of at most kMAXZIPBUF bytes, in parallel
+ * if implicit multi-threading is enabled. The format is the same as the one of consecutive R__zip calls.
+ */
+extern "C" int R__zipMultipleAlgorithmBlocks(int cxlevel, int srcsize, char *src, int tgtsize, char *tgt,
+                                             ROOT::RCompressionSetting::EAlgorithm::EValues);
+
+extern "C" int R__unzipBlocks(int srcsize, unsigned char *src, int tgtsize, unsigned char *tgt);
+
 enum { kMAXZIPBUF = 0xffffff };
 
 #endif
@@ -16,8 +16,22 @@
 
 #include "zlib.h"
 
+#ifdef R__HAS_LIBDEFLATE
+#include "libdeflate.h"
+#include <cstdlib>
+#endif
+
 #include <cstdio>
 #include <cassert>
+#include <cstring>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+// Defined in TROOT.cxx: runs func(i, arg) for i in [0, n) on the implicit MT pool
+void ImplicitMTForEach(unsigned int n, void (*func)(unsigned int, void *), void *arg);
+}
+}
 
 // The size of the ROOT block framing headers for compression:
 // - 3 bytes to identify the compression algorithm and version.
@@ -110,6 +124,31 @@ void R__zipMultipleAlgorithm(int cxlevel, int *srcsize, char *src, int *tgtsize,
   }
 }
 
+/* As R__zipMultipleAlgorithm, but ZSTD compression uses the dictionary dict  */
+/* of size dictsize (see R__trainDictZSTD); the output buffer then can only be */
+/* decompressed by R__unzipDict with the same dictionary. Other algorithms and */
+/* a null dict fall back to R__zipMultipleAlgorithm.                          */
+void R__zipMultipleAlgorithmDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep,
+                                 ROOT::RCompressionSetting::EAlgorithm::EValues compressionAlgorithm,
+                                 const char *dict, int dictsize)
+{
+  if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kUseGlobal) {
+    compressionAlgorithm = R__ZipMode;
+  }
+
+  if (!dict || dictsize <= 0 || compressionAlgorithm != ROOT::RCompressionSetting::EAlgorithm::kZSTD) {
+     R__zipMultipleAlgorithm(cxlevel, srcsize, src, tgtsize, tgt, irep, compressionAlgorithm);
+     return;
+  }
+
+  if (*srcsize < 1 + HDRSIZE + 1 || cxlevel <= 0) {
+     *irep = 0;
+     return;
+  }
+
+  R__zipZSTDDict(cxlevel, srcsize, src, tgtsize, tgt, irep, dict, dictsize);
+}
+
   // The very old algorithm for backward compatibility
   // 0 for selecting with R__ZipMode in a backward compatible way
   // 3 for selecting in other cases
@@ -174,14 +213,87 @@ static void R__zipOld(int cxlevel, int *srcsize, char *src, int *tgtsize, char *
 /**
  * Compress buffer contents using the venerable zlib algorithm.
  */
+#ifdef R__HAS_LIBDEFLATE
+/* ===========================================================================
+   libdeflate provides SIMD-accelerated, runtime-dispatched implementations of
+   deflate and inflate. It produces and reads standard zlib streams, such that
+   files are compatible either way, but the compressed bytes differ from the
+   ones of zlib. Setting the environment variable ROOT_ZLIB_BACKEND=zlib selects
+   zlib for both directions at runtime.
+*/
+static bool R__UseLibDeflate()
+{
+   static const bool useLibDeflate = [] {
+      const char *backend = getenv("ROOT_ZLIB_BACKEND");
+      return !backend || strcmp(backend, "zlib") != 0;
+   }();
+   return useLibDeflate;
+}
+
+namespace {
+/* The (de)compressors are expensive to create: keep one per thread */
+struct RLibDeflateState {
+   int fLevel = 0;
+   libdeflate_compressor *fCompressor = nullptr;
+   libdeflate_decompressor *fDecompressor = nullptr;
+
+   ~RLibDeflateState()
+   {
+      if (fCompressor)
+         libdeflate_free_compressor(fCompressor);
+      if (fDecompressor)
+         libdeflate_free_decompressor(fDecompressor);
+   }
+
+   libdeflate_compressor *GetCompressor(int level)
+   {
+      if (fCompressor && fLevel != level) {
+         libdeflate_free_compressor(fCompressor);
+         fCompressor = nullptr;
+      }
+      if (!fCompressor) {
+         fCompressor = libdeflate_alloc_compressor(level);
+         fLevel = level;
+      }
+      return fCompressor;
+   }
+
+   libdeflate_decompressor *GetDecompressor()
+   {
+      if (!fDecompressor)
+         fDecompressor = libdeflate_alloc_decompressor();
+      return fDecompressor;
+   }
+};
+}
+
+static RLibDeflateState &R__GetLibDeflateState()
+{
+   thread_local RLibDeflateState state;
+   return state;
+}
+#endif
+
+static void R__writeZLIBHeader(char *tgt, unsigned l_in_size, unsigned l_out_size)
+{
+    tgt[0] = 'Z';               /* Signature ZLib */
+    tgt[1] = 'L';
+    tgt[2] = (char) Z_DEFLATED;
+
+    tgt[3] = (char)(l_out_size & 0xff);
+    tgt[4] = (char)((l_out_size >> 8) & 0xff);
+    tgt[5] = (char)((l_out_size >> 16) & 0xff);
+
+    tgt[6] = (char)(l_in_size & 0xff);         /* decompressed size */
+    tgt[7] = (char)((l_in_size >> 8) & 0xff);
+    tgt[8] = (char)((l_in_size >> 16) & 0xff);
+}
+
 static void R__zipZLIB(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
 {
   int err;
-  int method   = Z_DEFLATED;
 
     z_stream stream;
-    //Don't use the globals but want name similar to help see similarities in code
-    unsigned l_in_size, l_out_size;
     *irep = 0;
 
     if (*tgtsize <= 0) {
@@ -193,6 +305,24 @@ static void R__zipZLIB(int cxlevel, int *srcsize, char *src, int *tgtsize, char
        return;
     }
 
+    if (cxlevel > 9) cxlevel = 9;
+
+#ifdef R__HAS_LIBDEFLATE
+    if (R__UseLibDeflate()) {
+       if (*tgtsize <= HDRSIZE)
+          return;
+       if (libdeflate_compressor *compressor = R__GetLibDeflateState().GetCompressor(cxlevel)) {
+          size_t nout = libdeflate_zlib_compress(compressor, src, (size_t)(*srcsize), &tgt[HDRSIZE],
+                                                 (size_t)(*tgtsize - HDRSIZE));
+          if (nout == 0) /* does not fit */
+             return;
+          R__writeZLIBHeader(tgt, (unsigned)(*srcsize), (unsigned)nout);
+          *irep = (int)nout + HDRSIZE;
+          return;
+       }
+    }
+#endif
+
     stream.next_in   = (Bytef*)src;
     stream.avail_in  = (uInt)(*srcsize);
 
@@ -203,7 +333,6 @@ static void R__zipZLIB(int cxlevel, int *srcsize, char *src, int *tgtsize, char
     stream.zfree     = (free_func)0;
     stream.opaque    = (voidpf)0;
 
-    if (cxlevel > 9) cxlevel = 9;
     err = deflateInit(&stream, cxlevel);
     if (err != Z_OK) {
        printf("error %d in deflateInit (zlib)\n",err);
@@ -219,19 +348,7 @@ static void R__zipZLIB(int cxlevel, int *srcsize, char *src, int *tgtsize, char
 
     err = deflateEnd(&stream);
 
-    tgt[0] = 'Z';               /* Signature ZLib */
-    tgt[1] = 'L';
-    tgt[2] = (char) method;
-
-    l_in_size   = (unsigned) (*srcsize);
-    l_out_size  = stream.total_out;             /* compressed size */
-    tgt[3] = (char)(l_out_size & 0xff);
-    tgt[4] = (char)((l_out_size >> 8) & 0xff);
-    tgt[5] = (char)((l_out_size >> 16) & 0xff);
-
-    tgt[6] = (char)(l_in_size & 0xff);         /* decompressed size */
-    tgt[7] = (char)((l_in_size >> 8) & 0xff);
-    tgt[8] = (char)((l_in_size >> 16) & 0xff);
+    R__writeZLIBHeader(tgt, (unsigned)(*srcsize), stream.total_out);
 
     *irep = stream.total_out + HDRSIZE;
     return;
@@ -318,7 +435,7 @@ int R__unzip_header(int *srcsize, uch *src, int *tgtsize)
  ***********************************************************************/
 // N.B. (Brian) - I have kept the original note out of complete awe of the
 // age of the original code...
-void R__unzip(int *srcsize, uch *src, int *tgtsize, uch *tgt, int *irep)
+static void R__unzipImpl(int *srcsize, uch *src, int *tgtsize, uch *tgt, int *irep, const char *dict, int dictsize)
 {
    long isize;
    uch *ibufptr, *obufptr;
@@ -366,7 +483,15 @@ void R__unzip(int *srcsize, uch *src, int *tgtsize, uch *tgt, int *irep)
       R__unzipLZ4(srcsize, src, tgtsize, tgt, irep);
       return;
    } else if (is_valid_header_zstd(src)) {
-      R__unzipZSTD(srcsize, src, tgtsize, tgt, irep);
+      if (R__getDictIDZSTD(*srcsize, src)) {
+         if (!dict) {
+            fprintf(stderr, "R__unzip: buffer was compressed with a dictionary\n");
+            return;
+         }
+         R__unzipZSTDDict(srcsize, src, tgtsize, tgt, irep, dict, dictsize);
+      } else {
+         R__unzipZSTD(srcsize, src, tgtsize, tgt, irep);
+      }
       return;
    }
 
@@ -388,11 +513,179 @@ void R__unzip(int *srcsize, uch *src, int *tgtsize, uch *tgt, int *irep)
    *irep = isize;
 }
 
+void R__unzip(int *srcsize, uch *src, int *tgtsize, uch *tgt, int *irep)
+{
+   R__unzipImpl(srcsize, src, tgtsize, tgt, irep, nullptr, 0);
+}
+
+/* As R__unzip, with the dictionary needed by buffers from                */
+/* R__zipMultipleAlgorithmDict; buffers compressed without a dictionary   */
+/* are decompressed as by R__unzip.                                       */
+void R__unzipDict(int *srcsize, uch *src, int *tgtsize, uch *tgt, int *irep, const char *dict, int dictsize)
+{
+   R__unzipImpl(srcsize, src, tgtsize, tgt, irep, dict, dictsize);
+}
+
+/* Return 1 if the compressed buffer src can only be decompressed with a  */
+/* dictionary, i.e. by R__unzipDict.                                     */
+int R__unzip_needs_dict(int srcsize, uch *src)
+{
+   if (srcsize < HDRSIZE || !is_valid_header_zstd(src))
+      return 0;
+   return R__getDictIDZSTD(srcsize, src) != 0;
+}
+
+namespace {
+struct RZipBlock {
+   char *fSrc;
+   int fSrcSize;
+   char *fTgt;
+   int fNout;
+};
+
+struct RZipBlocks {
+   int fCxLevel;
+   ROOT::RCompressionSetting::EAlgorithm::EValues fAlgorithm;
+   RZipBlock *fBlocks;
+};
+
+struct RUnzipBlock {
+   uch *fSrc;
+   int fSrcSize;
+   uch *fTgt;
+   int fTgtSize;
+   int fNout;
+};
+}
+
+static void R__zipBlock(unsigned int i, void *arg)
+{
+   RZipBlocks *task = static_cast<RZipBlocks *>(arg);
+   RZipBlock &block = task->fBlocks[i];
+   int tgtsize = block.fSrcSize;
+   R__zipMultipleAlgorithm(task->fCxLevel, &block.fSrcSize, block.fSrc, &tgtsize, block.fTgt, &block.fNout,
+                           task->fAlgorithm);
+}
+
+static void R__unzipBlock(unsigned int i, void *arg)
+{
+   RUnzipBlock &block = static_cast<RUnzipBlock *>(arg)[i];
+   R__unzip(&block.fSrcSize, block.fSrc, &block.fTgtSize, block.fTgt, &block.fNout);
+}
+
+/* Compress the srcsize bytes of src into tgt, in independent blocks of at    */
+/* most kMAXZIPBUF bytes each prefixed by its own header, as expected by      */
+/* R__unzipBlocks. The blocks are compressed in parallel if implicit multi-   */
+/* threading is enabled. tgtsize must be at least srcsize. Returns the size   */
+/* of the compressed data, or 0 if it would not be smaller than srcsize.      */
+int R__zipMultipleAlgorithmBlocks(int cxlevel, int srcsize, char *src, int tgtsize, char *tgt,
+                                  ROOT::RCompressionSetting::EAlgorithm::EValues compressionAlgorithm)
+{
+   if (srcsize <= 0 || tgtsize < srcsize)
+      return 0;
+
+   if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kUseGlobal)
+      compressionAlgorithm = R__ZipMode;
+
+   // Every block is compressed in place, at its offset in src: as the output of
+   // a block is smaller than its input, the blocks can be compacted afterwards.
+   const int nblocks = 1 + (srcsize - 1) / kMAXZIPBUF;
+   std::vector<RZipBlock> blocks(nblocks);
+   for (int i = 0; i < nblocks; ++i) {
+      const int offset = i * kMAXZIPBUF;
+      blocks[i] = {src + offset, (i == nblocks - 1) ? srcsize - offset : kMAXZIPBUF, tgt + offset, 0};
+   }
+
+   RZipBlocks task{cxlevel, compressionAlgorithm, blocks.data()};
+   // The very old algorithm keeps global state
+   if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kOldCompressionAlgo ||
+       compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kUseGlobal) {
+      for (int i = 0; i < nblocks; ++i)
+         R__zipBlock(i, &task);
+   } else {
+      ROOT::Internal::ImplicitMTForEach(nblocks, R__zipBlock, &task);
+   }
+
+   int nout = 0;
+   for (int i = 0; i < nblocks; ++i) {
+      if (blocks[i].fNout == 0)
+         return 0;
+      if (blocks[i].fTgt != tgt + nout)
+         memmove(tgt + nout, blocks[i].fTgt, blocks[i].fNout);
+      nout += blocks[i].fNout;
+   }
+   return (nout < srcsize) ? nout : 0;
+}
+
+/* Decompress the consecutive compressed blocks found in the srcsize bytes   */
+/* of src into tgt, until tgtsize bytes are decompressed. Blocks in the      */
+/* standard formats are decompressed in parallel if implicit multi-threading */
+/* is enabled. Returns the number of decompressed bytes, 0 in case of error. */
+int R__unzipBlocks(int srcsize, uch *src, int tgtsize, uch *tgt)
+{
+   std::vector<RUnzipBlock> blocks;
+   bool hasOld = false;
+   int nin = 0;
+   int nout = 0;
+   while (nout < tgtsize && nin + HDRSIZE <= srcsize) {
+      RUnzipBlock block{src + nin, 0, tgt + nout, 0, 0};
+      if (R__unzip_header(&block.fSrcSize, block.fSrc, &block.fTgtSize) != 0)
+         break;
+      hasOld = hasOld || is_valid_header_old(block.fSrc);
+      nin += block.fSrcSize;
+      nout += block.fTgtSize;
+      blocks.push_back(block);
+   }
+   if (blocks.empty())
+      return 0;
+
+   if (hasOld || blocks.size() == 1 || nout > tgtsize) {
+      // Same as the historical loop: the very old format can produce a few more bytes than the
+      // header announces, so the blocks are placed one after the other as they are decompressed.
+      nout = 0;
+      for (auto &block : blocks) {
+         block.fTgt = tgt + nout;
+         R__unzipBlock(0, &block);
+         if (!block.fNout)
+            return 0;
+         nout += block.fNout;
+         if (nout >= tgtsize)
+            break;
+      }
+      return nout;
+   }
+
+   ROOT::Internal::ImplicitMTForEach(blocks.size(), R__unzipBlock, blocks.data());
+   nout = 0;
+   for (const auto &block : blocks) {
+      if (!block.fNout)
+         return 0;
+      nout += block.fNout;
+   }
+   return nout;
+}
+
 void R__unzipZLIB(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep)
 {
      z_stream stream; /* decompression stream */
      int err = 0;
 
+#ifdef R__HAS_LIBDEFLATE
+     if (R__UseLibDeflate()) {
+        if (libdeflate_decompressor *decompressor = R__GetLibDeflateState().GetDecompressor()) {
+           size_t nout = 0;
+           libdeflate_result res = libdeflate_zlib_decompress(decompressor, &src[HDRSIZE], (size_t)(*srcsize - HDRSIZE),
+                                                              tgt, (size_t)(*tgtsize), &nout);
+           if (res != LIBDEFLATE_SUCCESS) {
+              fprintf(stderr, "R__unzip: error %d in libdeflate_zlib_decompress\n", (int)res);
+              return;
+           }
+           *irep = (int)nout;
+           return;
+        }
+     }
+#endif
+
      stream.next_in = (Bytef *)(&src[HDRSIZE]);
      stream.avail_in = (uInt)(*srcsize) - HDRSIZE;
      stream.next_out = (Bytef *)tgt;
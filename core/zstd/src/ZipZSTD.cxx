@@ -22,14 +22,35 @@ static const int kHeaderSize = 9;
 
 static const size_t errorCodeSmallBuffer = (size_t)-70;
 
-void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
+/// The contexts are kept per thread and reused, as creating them for each buffer
+/// costs more than compressing or decompressing small buffers like network messages.
+static ZSTD_CCtx *R__getZSTDCCtx()
 {
     using Ctx_ptr = std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)>;
-    Ctx_ptr fCtx{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+    thread_local Ctx_ptr fCtx{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+    return fCtx.get();
+}
+
+static ZSTD_DCtx *R__getZSTDDCtx()
+{
+    using Ctx_ptr = std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>;
+    thread_local Ctx_ptr fCtx{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+    return fCtx.get();
+}
+
+static void R__zipZSTDImpl(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, const char *dict,
+                           int dictsize)
+{
+    ZSTD_CCtx *ctx = R__getZSTDCCtx();
 
     *irep = 0;
 
-    size_t retval = ZSTD_compressCCtx(fCtx.get(),
+    size_t retval = dict ? ZSTD_compress_usingDict(ctx,
+                                        &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
+                                        src, static_cast<size_t>(*srcsize),
+                                        dict, static_cast<size_t>(dictsize),
+                                        2*cxlevel)
+                         : ZSTD_compressCCtx(ctx,
                                         &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
                                         src, static_cast<size_t>(*srcsize),
                                         2*cxlevel);
@@ -58,10 +79,23 @@ void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, i
     tgt[8] = (inflate_size >> 16) & 0xff;
 }
 
-void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep)
+void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
 {
-    using Ctx_ptr = std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>;
-    Ctx_ptr fCtx{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+    R__zipZSTDImpl(cxlevel, srcsize, src, tgtsize, tgt, irep, nullptr, 0);
+}
+
+/// Compress with a dictionary trained by R__trainDictZSTD(); the buffer can only be
+/// decompressed by R__unzipZSTDDict() with the same dictionary.
+void R__zipZSTDDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, const char *dict,
+                    int dictsize)
+{
+    R__zipZSTDImpl(cxlevel, srcsize, src, tgtsize, tgt, irep, dict, dictsize);
+}
+
+static void R__unzipZSTDImpl(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep,
+                             const char *dict, int dictsize)
+{
+    ZSTD_DCtx *ctx = R__getZSTDDCtx();
     *irep = 0;
 
     if (R__unlikely(src[0] != 'Z' || src[1] != 'S')) {
@@ -77,7 +111,11 @@ void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char
       return;
     }
 
-    size_t retval = ZSTD_decompressDCtx(fCtx.get(),
+    size_t retval = dict ? ZSTD_decompress_usingDict(ctx,
+                                        (char *)tgt, static_cast<size_t>(*tgtsize),
+                                        (char *)&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize),
+                                        dict, static_cast<size_t>(dictsize))
+                         : ZSTD_decompressDCtx(ctx,
                                         (char *)tgt, static_cast<size_t>(*tgtsize),
                                         (char *)&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize));
 
@@ -95,3 +133,35 @@ void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char
         *irep = retval;
     }
 }
+
+void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep)
+{
+    R__unzipZSTDImpl(srcsize, src, tgtsize, tgt, irep, nullptr, 0);
+}
+
+void R__unzipZSTDDict(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep, const char *dict,
+                      int dictsize)
+{
+    R__unzipZSTDImpl(srcsize, src, tgtsize, tgt, irep, dict, dictsize);
+}
+
+/// Return the ID of the dictionary needed to decompress the ROOT-framed ZSTD
+/// buffer src, or 0 if it is compressed without a dictionary.
+unsigned int R__getDictIDZSTD(int srcsize, const unsigned char *src)
+{
+    if (srcsize <= kHeaderSize)
+        return 0;
+    return ZSTD_getDictID_fromFrame(&src[kHeaderSize], static_cast<size_t>(srcsize - kHeaderSize));
+}
+
+/// Train a dictionary of at most dictcapacity bytes from the nsamples buffers
+/// concatenated in samples, of sizes samplesizes. Returns the size of the
+/// dictionary or 0 if no dictionary could be trained, e.g. for too little data.
+int R__trainDictZSTD(char *dict, int dictcapacity, const char *samples, const size_t *samplesizes,
+                     unsigned int nsamples)
+{
+    size_t retval = ZDICT_trainFromBuffer(dict, static_cast<size_t>(dictcapacity), samples, samplesizes, nsamples);
+    if (ZDICT_isError(retval))
+        return 0;
+    return static_cast<int>(retval);
+}
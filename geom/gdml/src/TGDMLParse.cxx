@@ -151,8 +151,8 @@ TGDMLParse::TGDMLParse()
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Creates the new instance of the XMLEngine called 'gdml', using the filename >>
-/// then parses the file and creates the DOM tree. Then passes the DOM to the
-/// next function to translate it.
+/// then reads the file and passes its DOM nodes to the next function to
+/// translate them.
 
 TGeoVolume *TGDMLParse::GDMLReadFile(const char *filename)
 {
@@ -160,28 +160,58 @@ TGeoVolume *TGDMLParse::GDMLReadFile(const char *filename)
    TXMLEngine *gdml = new TXMLEngine;
    gdml->SetSkipComments(kTRUE);
 
-   // Now try to parse xml file
-   XMLDocPointer_t gdmldoc = gdml->ParseFile(filename);
-   if (gdmldoc == 0) {
-      delete gdml;
-      return 0;
-   } else {
+   fFileEngine[fFILENO] = gdml;
+   fStartFile = filename;
+   fCurrentFile = filename;
+
+   // Now try to read xml file
+   const char *world = ParseGDMLFile(gdml, filename);
 
-      // take access to main node
-      XMLNodePointer_t mainnode = gdml->DocGetRootElement(gdmldoc);
+   // Release memory before exit
+   delete gdml;
+
+   return world ? fWorld : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reads the GDML file with the reader of the XML engine. Instead of building
+/// the DOM tree of the complete file, every definition in the sections of the
+/// file (constant, material, solid, volume, ...) is read together with its
+/// children and passed to ParseGDML. Only one definition at a time is kept in
+/// memory, which matters for large geometries.
+/// Returns the name of the world volume or 0 if the file cannot be read.
+
+const char *TGDMLParse::ParseGDMLFile(TXMLEngine *gdml, const char *filename)
+{
+   XMLReaderPointer_t reader = gdml->NewReader(filename);
+   if (reader == 0)
+      return 0;
 
-      fFileEngine[fFILENO] = gdml;
-      fStartFile = filename;
-      fCurrentFile = filename;
+   Int_t event = 0;
+   while ((event = gdml->ReadNext(reader)) > 0) {
+      if (event != TXMLEngine::kXMLStartElement)
+         continue;
 
-      // display recursively all nodes and subnodes
-      ParseGDML(gdml, mainnode);
+      // the main node and the sections only contain definitions
+      const char *name = gdml->GetNodeName(gdml->GetReaderNode(reader));
+      Int_t depth = gdml->GetReaderDepth(reader);
+      if ((depth == 1) || ((depth == 2) && ((strcmp(name, "define") == 0) || (strcmp(name, "materials") == 0) ||
+                                            (strcmp(name, "solids") == 0) || (strcmp(name, "structure") == 0))))
+         continue;
 
-      // Release memory before exit
-      gdml->FreeDoc(gdmldoc);
-      delete gdml;
+      XMLNodePointer_t node = gdml->ReadSubtree(reader);
+      if (node == 0)
+         break;
+      ParseGDML(gdml, node);
+      gdml->FreeNode(node);
    }
-   return fWorld;
+
+   gdml->FreeReader(reader);
+
+   if (event < 0)
+      return 0;
+
+   return fWorldName;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1788,20 +1818,18 @@ XMLNodePointer_t TGDMLParse::VolProcess(TXMLEngine *gdml, XMLNodePointer_t node)
 
                TXMLEngine *gdml2 = new TXMLEngine;
                gdml2->SetSkipComments(kTRUE);
-               XMLDocPointer_t filedoc1 = gdml2->ParseFile(fCurrentFile);
-               if (filedoc1 == 0) {
-                  Fatal("VolProcess", "Bad filename given %s", fCurrentFile);
-               }
-               // take access to main node
-               XMLNodePointer_t mainnode2 = gdml2->DocGetRootElement(filedoc1);
-               // increase depth counter + add DOM pointer
+               // increase depth counter + add engine pointer
                fFILENO = fFILENO + 1;
                fFileEngine[fFILENO] = gdml2;
 
                if (ffilemap.find(fCurrentFile) != ffilemap.end()) {
                   volref = ffilemap[fCurrentFile];
                } else {
-                  volref = ParseGDML(gdml2, mainnode2);
+                  const char *filevolref = ParseGDMLFile(gdml2, fCurrentFile);
+                  if (filevolref == 0) {
+                     Fatal("VolProcess", "Bad filename given %s", fCurrentFile);
+                  }
+                  volref = filevolref;
                   ffilemap[fCurrentFile] = volref;
                }
 
@@ -1817,9 +1845,8 @@ XMLNodePointer_t TGDMLParse::VolProcess(TXMLEngine *gdml, XMLNodePointer_t node)
                fCurrentFile = prevfile;
 
                lv = fvolmap[volref.Data()];
-               // File tree complete - Release memory before exit
+               // File complete - Release memory before exit
 
-               gdml->FreeDoc(filedoc1);
                delete gdml2;
             } else if (tempattr == "position") {
                attr = gdml->GetFirstAttr(subchild);
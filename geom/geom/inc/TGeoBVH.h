@@ -0,0 +1,205 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TGeoBVH
+#define ROOT_TGeoBVH
+
+#include "Rtypes.h"
+
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////
+//                                                                        //
+// TGeoBVH - bounding volume hierarchy over the bounding boxes of the     //
+//   daughters of a volume, given in the reference frame of the mother.   //
+//   The tree is built top-down with the surface area heuristic and is    //
+//   used by the voxel finder and the navigator to select the candidate   //
+//   daughters for point location, distance and safety queries in         //
+//   logarithmic instead of linear time.                                  //
+//                                                                        //
+////////////////////////////////////////////////////////////////////////////
+
+class TGeoBVH
+{
+public:
+   struct Node_t {
+      Double_t fMin[3];  // lower corner of the bounding box of the node
+      Double_t fMax[3];  // upper corner of the bounding box of the node
+      Int_t    fFirst;   // first index in the list of daughters for a leaf, index of the left child otherwise
+      Int_t    fCount;   // number of daughters of a leaf, 0 for an inner node
+   };
+
+private:
+   std::vector<Node_t>   fNodes;    // nodes of the tree, the root being the first one
+   std::vector<Int_t>    fIndices;  // daughter indices ordered by leaf
+   std::vector<Double_t> fBounds;   // lower and upper corners of the daughter boxes
+
+   static const Int_t    kMaxDepth = 64;   // maximum depth of the tree, defining the size of the traversal stacks
+   static const Int_t    kMaxLeafSize = 4; // leaves are split further if they exceed this size and the split pays off
+   static const Int_t    kNbins = 12;      // number of bins used to evaluate the split candidates
+
+   void                  BuildNode(Int_t inode, Int_t first, Int_t count, Int_t depth, std::vector<Double_t> &centers);
+
+   static Double_t       SafetyToBox(const Double_t *point, const Double_t *min, const Double_t *max);
+   static Bool_t         CrossBox(const Double_t *point, const Double_t *invdir, const Double_t *min,
+                                  const Double_t *max, Double_t step, Double_t &tenter);
+
+public:
+   TGeoBVH() {}
+   TGeoBVH(const Double_t *boxes, Int_t nd) { Build(boxes, nd); }
+
+   void                  Build(const Double_t *boxes, Int_t nd);
+   Int_t                 GetNdaughters() const { return (Int_t)fIndices.size(); }
+   Int_t                 GetNnodes() const { return (Int_t)fNodes.size(); }
+   Int_t                 GetContaining(const Double_t *point, Int_t *list) const;
+
+   template <typename Func>
+   Double_t              Safety(const Double_t *point, Double_t safmax, Func &&safety) const;
+   template <typename Func>
+   void                  ForEachCrossed(const Double_t *point, const Double_t *dir, const Double_t &step, Func &&dist) const;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Squared distance from a point to an axis aligned box, 0 if the point is inside.
+
+inline Double_t TGeoBVH::SafetyToBox(const Double_t *point, const Double_t *min, const Double_t *max)
+{
+   Double_t d2 = 0.;
+   for (Int_t i = 0; i < 3; i++) {
+      Double_t d = 0.;
+      if (point[i] < min[i])      d = min[i] - point[i];
+      else if (point[i] > max[i]) d = point[i] - max[i];
+      d2 += d * d;
+   }
+   return d2;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Check if a ray crosses an axis aligned box before step. The entry distance
+/// is 0 if the point is inside the box.
+
+inline Bool_t TGeoBVH::CrossBox(const Double_t *point, const Double_t *invdir, const Double_t *min,
+                                const Double_t *max, Double_t step, Double_t &tenter)
+{
+   Double_t tmin = 0.;
+   Double_t tmax = step;
+   for (Int_t i = 0; i < 3; i++) {
+      Double_t t1 = (min[i] - point[i]) * invdir[i];
+      Double_t t2 = (max[i] - point[i]) * invdir[i];
+      // a ray parallel to the slab gives infinities of the same sign if it is outside, NaN if it is on a plane
+      if (t1 != t1 || t2 != t2) continue;
+      if (t1 > t2) { Double_t t = t1; t1 = t2; t2 = t; }
+      if (t1 > tmin) tmin = t1;
+      if (t2 < tmax) tmax = t2;
+      if (tmin > tmax) return kFALSE;
+   }
+   tenter = tmin;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the minimum of safmax and of the safety to all daughters, calling
+/// safety(id) only for the daughters having their bounding box closer than the
+/// current minimum. Nodes are visited closest first and the traversal stops as
+/// soon as the minimum drops to 0.
+
+template <typename Func>
+Double_t TGeoBVH::Safety(const Double_t *point, Double_t safmax, Func &&safety) const
+{
+   if (fNodes.empty() || safmax <= 0.) return safmax;
+   Int_t stack[kMaxDepth];
+   Double_t dstack[kMaxDepth];
+   Int_t nstack = 0;
+   stack[nstack] = 0;
+   dstack[nstack++] = SafetyToBox(point, fNodes[0].fMin, fNodes[0].fMax);
+   while (nstack) {
+      nstack--;
+      if (dstack[nstack] >= safmax * safmax) continue;
+      const Node_t &node = fNodes[stack[nstack]];
+      if (node.fCount) {
+         for (Int_t i = node.fFirst; i < node.fFirst + node.fCount; i++) {
+            Int_t id = fIndices[i];
+            const Double_t *bounds = &fBounds[6 * id];
+            if (SafetyToBox(point, bounds, bounds + 3) >= safmax * safmax) continue;
+            Double_t safe = safety(id);
+            if (safe < safmax) safmax = safe;
+            if (safmax <= 0.) return 0.;
+         }
+         continue;
+      }
+      const Node_t &left = fNodes[node.fFirst];
+      const Node_t &right = fNodes[node.fFirst + 1];
+      Double_t dleft = SafetyToBox(point, left.fMin, left.fMax);
+      Double_t dright = SafetyToBox(point, right.fMin, right.fMax);
+      // push the farther child first, so that the closer one is processed next
+      if (dleft < dright) {
+         stack[nstack] = node.fFirst + 1; dstack[nstack++] = dright;
+         stack[nstack] = node.fFirst;     dstack[nstack++] = dleft;
+      } else {
+         stack[nstack] = node.fFirst;     dstack[nstack++] = dleft;
+         stack[nstack] = node.fFirst + 1; dstack[nstack++] = dright;
+      }
+   }
+   return safmax;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Call dist(id) for all daughters having their bounding box crossed by the
+/// ray before step. The daughters are visited roughly front to back and the
+/// boxes entered beyond the current value of step are skipped, so dist is
+/// expected to reduce step (passed by reference) when a closer boundary is found.
+
+template <typename Func>
+void TGeoBVH::ForEachCrossed(const Double_t *point, const Double_t *dir, const Double_t &step, Func &&dist) const
+{
+   if (fNodes.empty()) return;
+   Double_t invdir[3];
+   for (Int_t i = 0; i < 3; i++) invdir[i] = 1. / dir[i];
+   Double_t tenter, tleft, tright;
+   if (!CrossBox(point, invdir, fNodes[0].fMin, fNodes[0].fMax, step, tenter)) return;
+   Int_t stack[kMaxDepth];
+   Double_t tstack[kMaxDepth];
+   Int_t nstack = 0;
+   stack[nstack] = 0;
+   tstack[nstack++] = tenter;
+   while (nstack) {
+      nstack--;
+      if (tstack[nstack] >= step) continue;
+      const Node_t &node = fNodes[stack[nstack]];
+      if (node.fCount) {
+         for (Int_t i = node.fFirst; i < node.fFirst + node.fCount; i++) {
+            Int_t id = fIndices[i];
+            const Double_t *bounds = &fBounds[6 * id];
+            if (!CrossBox(point, invdir, bounds, bounds + 3, step, tenter)) continue;
+            dist(id);
+         }
+         continue;
+      }
+      const Node_t &left = fNodes[node.fFirst];
+      const Node_t &right = fNodes[node.fFirst + 1];
+      Bool_t hitleft = CrossBox(point, invdir, left.fMin, left.fMax, step, tleft);
+      Bool_t hitright = CrossBox(point, invdir, right.fMin, right.fMax, step, tright);
+      if (hitleft && hitright) {
+         if (tleft < tright) {
+            stack[nstack] = node.fFirst + 1; tstack[nstack++] = tright;
+            stack[nstack] = node.fFirst;     tstack[nstack++] = tleft;
+         } else {
+            stack[nstack] = node.fFirst;     tstack[nstack++] = tleft;
+            stack[nstack] = node.fFirst + 1; tstack[nstack++] = tright;
+         }
+      } else if (hitleft) {
+         stack[nstack] = node.fFirst;     tstack[nstack++] = tleft;
+      } else if (hitright) {
+         stack[nstack] = node.fFirst + 1; tstack[nstack++] = tright;
+      }
+   }
+}
+
+#endif
@@ -0,0 +1,116 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TGeoFlatGeometry
+#define ROOT_TGeoFlatGeometry
+
+#include "Rtypes.h"
+
+#include <unordered_map>
+#include <vector>
+
+class TGeoVolume;
+class TGeoNode;
+class TGeoShape;
+class TGeoMatrix;
+class TGeoVoxelFinder;
+struct TGeoStateInfo;
+
+////////////////////////////////////////////////////////////////////////////
+//                                                                        //
+// TGeoFlatGeometry - read-only flattened copy of the logical hierarchy   //
+//   of a closed geometry, used by the navigator to locate points. The    //
+//   daughters of each volume are stored contiguously together with the  //
+//   shape, volume index and 3x4 transformation of the node, so that the  //
+//   descent does not go through the daughter arrays and the virtual      //
+//   matrix calls of the nodes.                                           //
+//                                                                        //
+////////////////////////////////////////////////////////////////////////////
+
+class TGeoFlatGeometry
+{
+public:
+   enum ETransform {
+      kIdentity    = 0,  // no transformation
+      kTranslation = 1,  // translation only
+      kGeneral     = 2,  // rotation (or reflection) and translation
+      kGeneric     = 3   // scaling, delegated to the matrix of the node
+   };
+
+   struct Volume_t {
+      TGeoVolume      *fVolume;     // logical volume
+      TGeoVoxelFinder *fVoxels;     // voxels of the volume, if any
+      Int_t            fFirst;      // index of the first daughter in the node array
+      Int_t            fNdaughters; // number of daughters
+      Bool_t           fFlat;       // the daughters can be searched without the general algorithm
+   };
+
+   struct Node_t {
+      TGeoNode        *fNode;       // logical node
+      TGeoShape       *fShape;      // shape of the daughter volume
+      TGeoMatrix      *fMatrix;     // matrix of the node, used for kGeneric transformations
+      Double_t         fRot[9];     // rotation part of the transformation
+      Double_t         fTr[3];      // translation part of the transformation
+      Int_t            fVolume;     // index of the daughter volume
+      Int_t            fKind;       // type of transformation
+   };
+
+private:
+   std::vector<Volume_t>   fVolumes;       // flattened volumes, the top one being the first
+   std::vector<Node_t>     fNodes;         // daughters of all volumes, contiguous per volume
+   std::unordered_map<const TGeoVolume *, Int_t> fVolumeIndex; // index of a volume in fVolumes
+
+   Int_t                   AddVolume(TGeoVolume *vol);
+   inline void             MasterToLocal(const Node_t &node, const Double_t *master, Double_t *local) const;
+   static void             MasterToLocalGeneric(const Node_t &node, const Double_t *master, Double_t *local);
+
+public:
+   TGeoFlatGeometry(TGeoVolume *top);
+
+   Int_t                   GetNvolumes() const { return (Int_t)fVolumes.size(); }
+   Int_t                   GetNnodes() const { return (Int_t)fNodes.size(); }
+   Int_t                   GetVolumeIndex(const TGeoVolume *vol) const;
+   Bool_t                  IsFlat(Int_t ivol) const { return fVolumes[ivol].fFlat; }
+
+   Int_t                   Locate(Int_t ivol, const Double_t *point, const TGeoNode *skipnode, Int_t *path,
+                                  Int_t maxdepth, TGeoStateInfo &td, Bool_t &complete) const;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert a point from the frame of the mother to the one of the daughter.
+
+inline void TGeoFlatGeometry::MasterToLocal(const Node_t &node, const Double_t *master, Double_t *local) const
+{
+   switch (node.fKind) {
+      case kIdentity:
+         local[0] = master[0];
+         local[1] = master[1];
+         local[2] = master[2];
+         break;
+      case kTranslation:
+         local[0] = master[0] - node.fTr[0];
+         local[1] = master[1] - node.fTr[1];
+         local[2] = master[2] - node.fTr[2];
+         break;
+      case kGeneral: {
+         const Double_t mt0 = master[0] - node.fTr[0];
+         const Double_t mt1 = master[1] - node.fTr[1];
+         const Double_t mt2 = master[2] - node.fTr[2];
+         local[0] = mt0 * node.fRot[0] + mt1 * node.fRot[3] + mt2 * node.fRot[6];
+         local[1] = mt0 * node.fRot[1] + mt1 * node.fRot[4] + mt2 * node.fRot[7];
+         local[2] = mt0 * node.fRot[2] + mt1 * node.fRot[5] + mt2 * node.fRot[8];
+         break;
+      }
+      default:
+         MasterToLocalGeneric(node, master, local);
+   }
+}
+
+#endif
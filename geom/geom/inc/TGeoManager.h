@@ -35,6 +35,7 @@ class TGeoShape;
 class TVirtualGeoPainter;
 class THashList;
 class TGeoParallelWorld;
+class TGeoFlatGeometry;
 class TGeoRegion;
 class TGDMLMatrix;
 class TGeoOpticalSurface;
@@ -150,6 +151,7 @@ private :
    Int_t                 fRaytraceMode;     //! Raytrace mode: 0=normal, 1=pass through, 2=transparent
    Bool_t                fUsePWNav;         // Activate usage of parallel world in navigation
    TGeoParallelWorld    *fParallelWorld;    // Parallel world
+   TGeoFlatGeometry     *fFlatGeometry;     //! Flattened geometry used for point location
    ConstPropMap_t        fProperties;       // Map of user-defined constant properties
 //--- private methods
    Bool_t                IsLoopingVolumes() const     {return fLoopVolumes;}
@@ -596,6 +598,11 @@ public:
    void                  SetUseParallelWorldNav(Bool_t flag);
    Bool_t                IsParallelWorldNav() const {return fUsePWNav;}
 
+   //--- flattened geometry for point location
+   TGeoFlatGeometry     *BuildFlatGeometry();
+   void                  ClearFlatGeometry();
+   TGeoFlatGeometry     *GetFlatGeometry() const {return fFlatGeometry;}
+
    ClassDef(TGeoManager, 17)          // geometry manager
 };
 
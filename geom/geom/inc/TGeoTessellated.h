@@ -15,6 +15,9 @@
 #include "TGeoVector3.h"
 #include "TGeoTypedefs.h"
 #include "TGeoBBox.h"
+#include "TGeoBVH.h"
+
+#include <memory>
 
 class TGeoFacet {
    using Vertex_t = Tessellated::Vertex_t;
@@ -115,6 +118,14 @@ private:
    bool fClosedBody = false;        // The faces are making a closed body
    std::vector<Vertex_t> fVertices; // List of vertices
    std::vector<TGeoFacet> fFacets;  // List of facets
+   std::vector<Vertex_t> fNormals;  //! Outward normals of the facets
+   std::unique_ptr<TGeoBVH> fBVH;   //! Bounding volume hierarchy of the facets
+   double fCapacity = 0.;           //! Volume enclosed by the facets
+
+   void BuildBVH();
+   double FirstCrossedFacet(const double *point, const double *dir, double stepmax, int orientation,
+                            int &ifacet) const;
+   double NearestFacet(const double *point, int &ifacet) const;
 
 public:
    // constructors
@@ -124,6 +135,7 @@ public:
    // destructor
    virtual ~TGeoTessellated() {}
 
+   virtual double Capacity() const;
    void ComputeBBox();
    void CloseShape(bool check = true, bool fixFlipped = true, bool verbose = true);
 
@@ -142,6 +154,20 @@ public:
    const Vertex_t &GetVertex(int i) { return fVertices[i]; }
 
    virtual void AfterStreamer();
+   virtual void ComputeNormal(const double *point, const double *dir, double *norm);
+   virtual void ComputeNormal_v(const double *points, const double *dirs, double *norms, int vecsize);
+   virtual bool Contains(const double *point) const;
+   virtual void Contains_v(const double *points, bool *inside, int vecsize) const;
+   virtual double DistFromInside(const double *point, const double *dir, int iact = 1, double step = TGeoShape::Big(),
+                                 double *safe = nullptr) const;
+   virtual void DistFromInside_v(const double *points, const double *dirs, double *dists, int vecsize,
+                                 double *step) const;
+   virtual double DistFromOutside(const double *point, const double *dir, int iact = 1,
+                                  double step = TGeoShape::Big(), double *safe = nullptr) const;
+   virtual void DistFromOutside_v(const double *points, const double *dirs, double *dists, int vecsize,
+                                  double *step) const;
+   virtual double Safety(const double *point, bool in = true) const;
+   virtual void Safety_v(const double *points, const bool *inside, double *safe, int vecsize) const;
    virtual int DistancetoPrimitive(int, int) { return 99999; }
    virtual const TBuffer3D &GetBuffer3D(int reqSections, Bool_t localFrame) const;
    virtual void GetMeshNumbers(int &nvert, int &nsegs, int &npols) const;
@@ -161,7 +187,7 @@ public:
    /// Flip all facets
    void FlipFacets()
    {
-      for (auto facet : fFacets)
+      for (auto &facet : fFacets)
          facet.Flip();
    }
 
@@ -15,6 +15,7 @@
 #include "TObject.h"
 
 class TGeoVolume;
+class TGeoBVH;
 struct TGeoStateInfo;
 
 class TGeoVoxelFinder : public TObject
@@ -65,6 +66,11 @@ protected:
    UChar_t          *fIndcX;          //[fNx] array of slices bits on X
    UChar_t          *fIndcY;          //[fNy] array of slices bits on Y
    UChar_t          *fIndcZ;          //[fNz] array of slices bits on Z
+   TGeoBVH          *fBVH;            //! bounding volume hierarchy of the daughter boxes, if worth it
+
+   static Int_t      fgBVHMinDaughters; // minimum number of daughters for using a bounding volume hierarchy
+
+   void                BuildBVH();
 
    void                BuildVoxelLimits();
    Int_t              *GetExtraX(Int_t islice, Bool_t left, Int_t &nextra) const;
@@ -104,6 +110,9 @@ public :
    Bool_t              IsInvalid() const {return TObject::TestBit(kGeoInvalidVoxels);}
    Bool_t              NeedRebuild() const {return TObject::TestBit(kGeoRebuildVoxels);}
    Double_t           *GetBoxes() const {return fBoxes;}
+   TGeoBVH            *GetBVH() const {return fBVH;}
+   static Int_t        GetBVHMinDaughters() {return fgBVHMinDaughters;}
+   static void         SetBVHMinDaughters(Int_t nd) {fgBVHMinDaughters = nd;}
    Bool_t              IsSafeVoxel(const Double_t *point, Int_t inode, Double_t minsafe) const;
    virtual void        Print(Option_t *option="") const;
    void                PrintVoxelLimits(const Double_t *point) const;
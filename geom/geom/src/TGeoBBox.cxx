@@ -1048,10 +1048,23 @@ void TGeoBBox::FillBuffer3D(TBuffer3D & buffer, Int_t reqSections, Bool_t localF
 /// Check the inside status for each of the points in the array.
 /// Input: Array of point coordinates + vector size
 /// Output: Array of Booleans for the inside of each point
+///
+/// The vectorized methods of the box work directly on the box parameters, without
+/// a virtual call per point. Derived shapes which do not override them evaluate
+/// their own scalar methods.
 
 void TGeoBBox::Contains_v(const Double_t *points, Bool_t *inside, Int_t vecsize) const
 {
-   for (Int_t i=0; i<vecsize; i++) inside[i] = Contains(&points[3*i]);
+   if (IsA() != TGeoBBox::Class()) {
+      for (Int_t i=0; i<vecsize; i++) inside[i] = Contains(&points[3*i]);
+      return;
+   }
+   const Double_t dx = fDX, dy = fDY, dz = fDZ;
+   const Double_t ox = fOrigin[0], oy = fOrigin[1], oz = fOrigin[2];
+   for (Int_t i=0; i<vecsize; i++) {
+      const Double_t *point = &points[3*i];
+      inside[i] = (TMath::Abs(point[0]-ox) <= dx) & (TMath::Abs(point[1]-oy) <= dy) & (TMath::Abs(point[2]-oz) <= dz);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1069,7 +1082,25 @@ void TGeoBBox::ComputeNormal_v(const Double_t *points, const Double_t *dirs, Dou
 
 void TGeoBBox::DistFromInside_v(const Double_t *points, const Double_t *dirs, Double_t *dists, Int_t vecsize, Double_t* step) const
 {
-   for (Int_t i=0; i<vecsize; i++) dists[i] = DistFromInside(&points[3*i], &dirs[3*i], 3, step[i]);
+   if (IsA() != TGeoBBox::Class()) {
+      for (Int_t i=0; i<vecsize; i++) dists[i] = DistFromInside(&points[3*i], &dirs[3*i], 3, step[i]);
+      return;
+   }
+   const Double_t par[3] = {fDX, fDY, fDZ};
+   for (Int_t i=0; i<vecsize; i++) {
+      const Double_t *point = &points[3*i];
+      const Double_t *dir = &dirs[3*i];
+      Double_t smin = TGeoShape::Big();
+      Bool_t outside = kFALSE;
+      for (Int_t j=0; j<3; j++) {
+         if (dir[j] == 0) continue;
+         const Double_t newpt = point[j] - fOrigin[j];
+         const Double_t s = (dir[j] > 0) ? (par[j]-newpt)/dir[j] : -(par[j]+newpt)/dir[j];
+         outside |= (s < 0);
+         if (s < smin) smin = s;
+      }
+      dists[i] = outside ? 0.0 : smin;
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1077,7 +1108,11 @@ void TGeoBBox::DistFromInside_v(const Double_t *points, const Double_t *dirs, Do
 
 void TGeoBBox::DistFromOutside_v(const Double_t *points, const Double_t *dirs, Double_t *dists, Int_t vecsize, Double_t* step) const
 {
-   for (Int_t i=0; i<vecsize; i++) dists[i] = DistFromOutside(&points[3*i], &dirs[3*i], 3, step[i]);
+   if (IsA() != TGeoBBox::Class()) {
+      for (Int_t i=0; i<vecsize; i++) dists[i] = DistFromOutside(&points[3*i], &dirs[3*i], 3, step[i]);
+      return;
+   }
+   for (Int_t i=0; i<vecsize; i++) dists[i] = TGeoBBox::DistFromOutside(&points[3*i], &dirs[3*i], 3, step[i]);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1087,5 +1122,19 @@ void TGeoBBox::DistFromOutside_v(const Double_t *points, const Double_t *dirs, D
 
 void TGeoBBox::Safety_v(const Double_t *points, const Bool_t *inside, Double_t *safe, Int_t vecsize) const
 {
-   for (Int_t i=0; i<vecsize; i++) safe[i] = Safety(&points[3*i], inside[i]);
+   if (IsA() != TGeoBBox::Class()) {
+      for (Int_t i=0; i<vecsize; i++) safe[i] = Safety(&points[3*i], inside[i]);
+      return;
+   }
+   const Double_t dx = fDX, dy = fDY, dz = fDZ;
+   const Double_t ox = fOrigin[0], oy = fOrigin[1], oz = fOrigin[2];
+   for (Int_t i=0; i<vecsize; i++) {
+      const Double_t *point = &points[3*i];
+      // the safety from outside is the negative of the one from inside
+      const Double_t sign = inside[i] ? 1. : -1.;
+      const Double_t safx = sign * (dx - TMath::Abs(point[0]-ox));
+      const Double_t safy = sign * (dy - TMath::Abs(point[1]-oy));
+      const Double_t safz = sign * (dz - TMath::Abs(point[2]-oz));
+      safe[i] = inside[i] ? TMath::Min(safx, TMath::Min(safy, safz)) : TMath::Max(safx, TMath::Max(safy, safz));
+   }
 }
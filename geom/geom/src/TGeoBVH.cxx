@@ -0,0 +1,210 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TGeoBVH
+\ingroup Geometry_classes
+
+Bounding volume hierarchy over the bounding boxes of the daughters of a
+volume, in the reference frame of the mother and in the format of
+TGeoVoxelFinder::GetBoxes(), i.e. (dx, dy, dz, ox, oy, oz) for each daughter.
+
+The tree is a binary tree of axis aligned boxes built top-down: each node is
+split along the axis and position minimizing the surface area heuristic,
+evaluated on a fixed number of bins of the box centers. The voxel finder builds
+it for volumes with many daughters, where it replaces the linear loops over the
+daughter boxes done for the safety and the candidate lookup.
+*/
+
+#include "TGeoBVH.h"
+
+#include "TGeoShape.h"
+
+#include <algorithm>
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the hierarchy for nd daughter boxes. The boxes are enlarged by the
+/// geometrical tolerance, so that points on the boundary of a daughter are
+/// still found inside its box.
+
+void TGeoBVH::Build(const Double_t *boxes, Int_t nd)
+{
+   fNodes.clear();
+   fIndices.resize(nd);
+   fBounds.resize(6 * nd);
+   if (nd <= 0) return;
+   std::vector<Double_t> centers(3 * nd);
+   Double_t tol = TGeoShape::Tolerance();
+   for (Int_t id = 0; id < nd; id++) {
+      fIndices[id] = id;
+      for (Int_t i = 0; i < 3; i++) {
+         Double_t half = boxes[6 * id + i] + tol;
+         Double_t center = boxes[6 * id + 3 + i];
+         fBounds[6 * id + i] = center - half;
+         fBounds[6 * id + 3 + i] = center + half;
+         centers[3 * id + i] = center;
+      }
+   }
+   fNodes.reserve(2 * nd);
+   fNodes.push_back(Node_t());
+   BuildNode(0, 0, nd, 0, centers);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the node inode for the daughters fIndices[first, first+count) and
+/// build its subtree.
+
+void TGeoBVH::BuildNode(Int_t inode, Int_t first, Int_t count, Int_t depth, std::vector<Double_t> &centers)
+{
+   Double_t min[3], max[3], cmin[3], cmax[3];
+   for (Int_t i = 0; i < 3; i++) {
+      min[i] = cmin[i] = TGeoShape::Big();
+      max[i] = cmax[i] = -TGeoShape::Big();
+   }
+   for (Int_t k = first; k < first + count; k++) {
+      Int_t id = fIndices[k];
+      for (Int_t i = 0; i < 3; i++) {
+         min[i] = std::min(min[i], fBounds[6 * id + i]);
+         max[i] = std::max(max[i], fBounds[6 * id + 3 + i]);
+         cmin[i] = std::min(cmin[i], centers[3 * id + i]);
+         cmax[i] = std::max(cmax[i], centers[3 * id + i]);
+      }
+   }
+   for (Int_t i = 0; i < 3; i++) {
+      fNodes[inode].fMin[i] = min[i];
+      fNodes[inode].fMax[i] = max[i];
+   }
+   fNodes[inode].fFirst = first;
+   fNodes[inode].fCount = count;
+   // the traversal stacks grow by one entry per level
+   if (count <= 2 || depth >= kMaxDepth - 2) return;
+
+   auto area = [](const Double_t *bmin, const Double_t *bmax) {
+      Double_t dx = bmax[0] - bmin[0], dy = bmax[1] - bmin[1], dz = bmax[2] - bmin[2];
+      return dx * dy + dy * dz + dz * dx;
+   };
+
+   // Evaluate the surface area heuristic for the splits between the bins of the centers
+   Int_t bestAxis = -1;
+   Int_t bestBin = 0;
+   Double_t bestCost = TGeoShape::Big();
+   for (Int_t axis = 0; axis < 3; axis++) {
+      Double_t extent = cmax[axis] - cmin[axis];
+      if (extent <= 0.) continue;
+      Int_t binCount[kNbins] = {0};
+      Double_t binMin[kNbins][3], binMax[kNbins][3];
+      for (Int_t b = 0; b < kNbins; b++) {
+         for (Int_t i = 0; i < 3; i++) {
+            binMin[b][i] = TGeoShape::Big();
+            binMax[b][i] = -TGeoShape::Big();
+         }
+      }
+      for (Int_t k = first; k < first + count; k++) {
+         Int_t id = fIndices[k];
+         Int_t b = std::min(kNbins - 1, Int_t(kNbins * (centers[3 * id + axis] - cmin[axis]) / extent));
+         binCount[b]++;
+         for (Int_t i = 0; i < 3; i++) {
+            binMin[b][i] = std::min(binMin[b][i], fBounds[6 * id + i]);
+            binMax[b][i] = std::max(binMax[b][i], fBounds[6 * id + 3 + i]);
+         }
+      }
+      // Sweep from the right to get the area and count right of each split, then from the left
+      Double_t rightArea[kNbins];
+      Int_t rightCount[kNbins];
+      Double_t accMin[3], accMax[3];
+      Int_t acc = 0;
+      for (Int_t i = 0; i < 3; i++) {
+         accMin[i] = TGeoShape::Big();
+         accMax[i] = -TGeoShape::Big();
+      }
+      for (Int_t b = kNbins - 1; b > 0; b--) {
+         acc += binCount[b];
+         for (Int_t i = 0; i < 3; i++) {
+            accMin[i] = std::min(accMin[i], binMin[b][i]);
+            accMax[i] = std::max(accMax[i], binMax[b][i]);
+         }
+         rightCount[b] = acc;
+         rightArea[b] = acc ? area(accMin, accMax) : 0.;
+      }
+      acc = 0;
+      for (Int_t i = 0; i < 3; i++) {
+         accMin[i] = TGeoShape::Big();
+         accMax[i] = -TGeoShape::Big();
+      }
+      for (Int_t b = 0; b < kNbins - 1; b++) {
+         acc += binCount[b];
+         for (Int_t i = 0; i < 3; i++) {
+            accMin[i] = std::min(accMin[i], binMin[b][i]);
+            accMax[i] = std::max(accMax[i], binMax[b][i]);
+         }
+         if (!acc || !rightCount[b + 1]) continue;
+         Double_t cost = acc * area(accMin, accMax) + rightCount[b + 1] * rightArea[b + 1];
+         if (cost < bestCost) {
+            bestCost = cost;
+            bestAxis = axis;
+            bestBin = b;
+         }
+      }
+   }
+   // All centers coincide: no split can separate the daughters
+   if (bestAxis < 0) return;
+   // Keep small leaves if the split does not reduce the expected number of tested daughters
+   Double_t parentArea = area(min, max);
+   if (count <= kMaxLeafSize && (parentArea <= 0. || bestCost / parentArea + 1. >= count)) return;
+
+   Double_t extent = cmax[bestAxis] - cmin[bestAxis];
+   auto middle = std::partition(fIndices.begin() + first, fIndices.begin() + first + count, [&](Int_t id) {
+      return std::min(kNbins - 1, Int_t(kNbins * (centers[3 * id + bestAxis] - cmin[bestAxis]) / extent)) <= bestBin;
+   });
+   Int_t nleft = middle - (fIndices.begin() + first);
+   // Inner node: the children are stored next to each other, the left one at fFirst
+   fNodes[inode].fCount = 0;
+   Int_t ileft = fNodes.size();
+   fNodes[inode].fFirst = ileft;
+   fNodes.push_back(Node_t());
+   fNodes.push_back(Node_t());
+   BuildNode(ileft, first, nleft, depth + 1, centers);
+   BuildNode(ileft + 1, first + nleft, count - nleft, depth + 1, centers);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill list with the indices of the daughters having their bounding box
+/// containing the point, in increasing order. The list has to hold at least
+/// GetNdaughters() elements. Returns the number of daughters found.
+
+Int_t TGeoBVH::GetContaining(const Double_t *point, Int_t *list) const
+{
+   if (fNodes.empty()) return 0;
+   Int_t n = 0;
+   Int_t stack[kMaxDepth];
+   Int_t nstack = 0;
+   stack[nstack++] = 0;
+   while (nstack) {
+      const Node_t &node = fNodes[stack[--nstack]];
+      if (point[0] < node.fMin[0] || point[0] > node.fMax[0] || point[1] < node.fMin[1] ||
+          point[1] > node.fMax[1] || point[2] < node.fMin[2] || point[2] > node.fMax[2])
+         continue;
+      if (!node.fCount) {
+         stack[nstack++] = node.fFirst;
+         stack[nstack++] = node.fFirst + 1;
+         continue;
+      }
+      for (Int_t i = node.fFirst; i < node.fFirst + node.fCount; i++) {
+         Int_t id = fIndices[i];
+         const Double_t *bounds = &fBounds[6 * id];
+         if (point[0] < bounds[0] || point[0] > bounds[3] || point[1] < bounds[1] ||
+             point[1] > bounds[4] || point[2] < bounds[2] || point[2] > bounds[5])
+            continue;
+         list[n++] = id;
+      }
+   }
+   // keep the order of the voxel candidate lists, which the overlap handling relies on
+   std::sort(list, list + n);
+   return n;
+}
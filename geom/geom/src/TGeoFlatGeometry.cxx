@@ -0,0 +1,167 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TGeoFlatGeometry
+\ingroup Geometry_classes
+
+Read-only flattened representation of the logical hierarchy of a closed
+geometry, built on demand by TGeoManager::BuildFlatGeometry().
+
+Each logical volume is stored once, with its daughters kept contiguously
+in a single array. A daughter entry holds the shape of the daughter volume,
+the index of the daughter volume and the transformation of the node split
+in a 3x3 rotation and a translation, so that locating a point descends the
+hierarchy with inlined transformations instead of going through the daughter
+arrays of the volumes and the virtual methods of the matrices.
+
+Only the volumes for which the search of the daughters is unambiguous are
+handled: divided volumes, assemblies and volumes with overlapping daughters
+are left to the general algorithm of TGeoNavigator::SearchNode(), which takes
+over at the first such volume met during the descent.
+*/
+
+#include "TGeoFlatGeometry.h"
+
+#include "TGeoMatrix.h"
+#include "TGeoNode.h"
+#include "TGeoShape.h"
+#include "TGeoVolume.h"
+#include "TGeoVoxelFinder.h"
+
+#include <cstring>
+
+////////////////////////////////////////////////////////////////////////////////
+/// Flatten the hierarchy of volumes below top.
+
+TGeoFlatGeometry::TGeoFlatGeometry(TGeoVolume *top)
+{
+   if (top) AddVolume(top);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a volume and, recursively, its daughter volumes. Returns the index of
+/// the volume.
+
+Int_t TGeoFlatGeometry::AddVolume(TGeoVolume *vol)
+{
+   auto it = fVolumeIndex.find(vol);
+   if (it != fVolumeIndex.end()) return it->second;
+   Int_t ivol = (Int_t)fVolumes.size();
+   fVolumeIndex[vol] = ivol;
+   Int_t nd = vol->GetNdaughters();
+   Bool_t flat = !vol->GetFinder() && !vol->IsAssembly();
+   for (Int_t i = 0; i < nd && flat; i++) {
+      TGeoNode *node = vol->GetNode(i);
+      if (node->IsOverlapping() || node->IsOffset() || node->GetVolume()->IsAssembly()) flat = kFALSE;
+   }
+   Int_t first = (Int_t)fNodes.size();
+   fVolumes.push_back({vol, vol->GetVoxels(), first, nd, flat});
+   fNodes.resize(first + nd);
+   for (Int_t i = 0; i < nd; i++) {
+      TGeoNode *node = vol->GetNode(i);
+      Node_t &fnode = fNodes[first + i];
+      memset(&fnode, 0, sizeof(Node_t));
+      fnode.fNode = node;
+      fnode.fShape = node->GetVolume()->GetShape();
+      fnode.fKind = kGeneric;
+      // the matrices of division cells are computed on the fly, they are not needed
+      // since divided volumes are not searched here
+      if (!flat) continue;
+      TGeoMatrix *matrix = node->GetMatrix();
+      fnode.fMatrix = matrix;
+      if (matrix->IsIdentity()) {
+         fnode.fKind = kIdentity;
+      } else if (!matrix->IsScale()) {
+         fnode.fKind = matrix->IsRotation() ? kGeneral : kTranslation;
+         memcpy(fnode.fTr, matrix->GetTranslation(), 3 * sizeof(Double_t));
+         memcpy(fnode.fRot, matrix->GetRotationMatrix(), 9 * sizeof(Double_t));
+      }
+   }
+   // the node array may be reallocated while adding the daughter volumes
+   for (Int_t i = 0; i < nd; i++) {
+      Int_t idaughter = AddVolume(vol->GetNode(i)->GetVolume());
+      fNodes[first + i].fVolume = idaughter;
+   }
+   return ivol;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Convert a point from the frame of the mother to the one of the daughter
+/// using the matrix of the node.
+
+void TGeoFlatGeometry::MasterToLocalGeneric(const Node_t &node, const Double_t *master, Double_t *local)
+{
+   node.fMatrix->MasterToLocal(master, local);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Index of a volume in the flattened geometry, -1 if it is not part of it.
+
+Int_t TGeoFlatGeometry::GetVolumeIndex(const TGeoVolume *vol) const
+{
+   auto it = fVolumeIndex.find(vol);
+   return (it == fVolumeIndex.end()) ? -1 : it->second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Descend from the volume ivol, the point being given in its local frame and
+/// known to be inside it, down to the deepest daughter containing the point.
+/// The daughter skipnode is not checked at the first level. The indices of the
+/// daughters crossed are stored in path and their number is returned. The
+/// flag complete is false if the descent stopped at a volume which has to be
+/// searched with the general algorithm, or because maxdepth was reached.
+
+Int_t TGeoFlatGeometry::Locate(Int_t ivol, const Double_t *point, const TGeoNode *skipnode, Int_t *path,
+                               Int_t maxdepth, TGeoStateInfo &td, Bool_t &complete) const
+{
+   Double_t local[3], next[3];
+   memcpy(local, point, 3 * sizeof(Double_t));
+   Int_t depth = 0;
+   complete = kTRUE;
+   while (1) {
+      const Volume_t &volume = fVolumes[ivol];
+      if (!volume.fNdaughters) return depth;
+      if (!volume.fFlat || depth >= maxdepth) {
+         complete = kFALSE;
+         return depth;
+      }
+      const Node_t *nodes = &fNodes[volume.fFirst];
+      const TGeoNode *skip = (depth) ? nullptr : skipnode;
+      Int_t found = -1;
+      if (volume.fVoxels) {
+         Int_t ncheck = 0;
+         Int_t *check_list = volume.fVoxels->GetCheckList(local, ncheck, td);
+         for (Int_t i = 0; i < ncheck; i++) {
+            const Node_t &node = nodes[check_list[i]];
+            if (node.fNode == skip) continue;
+            MasterToLocal(node, local, next);
+            if (node.fShape->Contains(next)) {
+               found = check_list[i];
+               break;
+            }
+         }
+      } else {
+         for (Int_t i = 0; i < volume.fNdaughters; i++) {
+            const Node_t &node = nodes[i];
+            if (node.fNode == skip) continue;
+            MasterToLocal(node, local, next);
+            if (node.fShape->Contains(next)) {
+               found = i;
+               break;
+            }
+         }
+      }
+      if (found < 0) return depth;
+      path[depth++] = found;
+      ivol = nodes[found].fVolume;
+      memcpy(local, next, 3 * sizeof(Double_t));
+   }
+   return depth;
+}
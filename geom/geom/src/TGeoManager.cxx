@@ -234,6 +234,7 @@ in order to enhance rays.
 \image html geom_random2.jpg
 */
 
+#include <atomic>
 #include <cstdlib>
 #include <iostream>
 #include <fstream>
@@ -280,6 +281,7 @@ in order to enhance rays.
 #include "TMath.h"
 #include "TEnv.h"
 #include "TGeoParallelWorld.h"
+#include "TGeoFlatGeometry.h"
 #include "TGeoRegion.h"
 #include "TGDMLMatrix.h"
 #include "TGeoOpticalSurface.h"
@@ -291,6 +293,18 @@ TGeoManager *gGeoManager = nullptr;
 ClassImp(TGeoManager);
 
 std::mutex TGeoManager::fgMutex;
+
+namespace {
+// The navigators and thread ordinals are cached per thread, so that the lookups in the maps
+// (done under lock) happen only once per thread. Any change invalidating the cached values
+// increments the corresponding generation, which makes the threads refresh their cache once.
+std::atomic<UInt_t> gNavigatorsGeneration(0);
+std::atomic<UInt_t> gThreadIdsGeneration(0);
+// Protects the map of thread ordinals. It is separate from fgMutex, since the thread ordinal
+// is requested while holding fgMutex, e.g. when a navigator is created.
+std::mutex gThreadIdsMutex;
+} // namespace
+
 Bool_t TGeoManager::fgLock            = kFALSE;
 Bool_t TGeoManager::fgLockNavigators  = kFALSE;
 Int_t  TGeoManager::fgVerboseLevel    = 1;
@@ -381,6 +395,7 @@ TGeoManager::TGeoManager()
       fMaxThreads = 0;
       fUsePWNav = kFALSE;
       fParallelWorld = 0;
+      fFlatGeometry = 0;
       ClearThreadsMap();
    } else {
       Init();
@@ -487,6 +502,7 @@ void TGeoManager::Init()
    fMaxThreads = 0;
    fUsePWNav = kFALSE;
    fParallelWorld = 0;
+   fFlatGeometry = 0;
    ClearThreadsMap();
 }
 
@@ -541,6 +557,7 @@ TGeoManager::~TGeoManager()
       delete [] fValuePNEId;
    }
    delete fParallelWorld;
+   delete fFlatGeometry;
    fIsGeomCleaning = kFALSE;
    gGeoIdentity = 0;
    gGeoManager = 0;
@@ -727,25 +744,35 @@ TGeoNavigator *TGeoManager::AddNavigator()
    }
    TGeoNavigator *nav = array->AddNavigator();
    if (fClosed) nav->GetCache()->BuildInfoBranch();
+   gNavigatorsGeneration++;
    if (fMultiThread) fgMutex.unlock();
    return nav;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Returns current navigator for the calling thread.
+/// Returns current navigator for the calling thread. In multi-threaded mode the
+/// navigator is cached in thread local storage, so that the map of navigators is
+/// looked up under lock only the first time and after the navigators changed.
 
 TGeoNavigator *TGeoManager::GetCurrentNavigator() const
 {
+   TTHREAD_TLS(const TGeoManager*) tmanager = 0;
+   TTHREAD_TLS(UInt_t) tgeneration = 0;
    TTHREAD_TLS(TGeoNavigator*) tnav = 0;
    if (!fMultiThread) return fCurrentNavigator;
-   TGeoNavigator *nav = tnav; // TTHREAD_TLS_GET(TGeoNavigator*,tnav);
-   if (nav) return nav;
+   TGeoNavigator *cached = tnav;
+   const TGeoManager *cachedmanager = tmanager;
+   UInt_t cachedgeneration = tgeneration;
+   if (cached && cachedmanager == this &&
+       cachedgeneration == gNavigatorsGeneration.load(std::memory_order_acquire)) return cached;
+   std::lock_guard<std::mutex> lock(fgMutex);
    std::thread::id threadId = std::this_thread::get_id();
    NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
    if (it == fNavigators.end()) return 0;
-   TGeoNavigatorArray *array = it->second;
-   nav = array->GetCurrentNavigator();
-   tnav = nav; // TTHREAD_TLS_SET(TGeoNavigator*,tnav,nav);
+   TGeoNavigator *nav = it->second->GetCurrentNavigator();
+   tmanager = this;
+   tgeneration = gNavigatorsGeneration.load(std::memory_order_relaxed);
+   tnav = nav;
    return nav;
 }
 
@@ -754,6 +781,8 @@ TGeoNavigator *TGeoManager::GetCurrentNavigator() const
 
 TGeoNavigatorArray *TGeoManager::GetListOfNavigators() const
 {
+   std::unique_lock<std::mutex> lock(fgMutex, std::defer_lock);
+   if (fMultiThread) lock.lock();
    std::thread::id threadId = std::this_thread::get_id();
    NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
    if (it == fNavigators.end()) return 0;
@@ -766,6 +795,8 @@ TGeoNavigatorArray *TGeoManager::GetListOfNavigators() const
 
 Bool_t TGeoManager::SetCurrentNavigator(Int_t index)
 {
+   std::unique_lock<std::mutex> lock(fgMutex, std::defer_lock);
+   if (fMultiThread) lock.lock();
    std::thread::id threadId = std::this_thread::get_id();
    NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
    if (it == fNavigators.end()) {
@@ -780,6 +811,7 @@ Bool_t TGeoManager::SetCurrentNavigator(Int_t index)
       std::cout << "  thread id: " << threadId << std::endl;
       return kFALSE;
    }
+   gNavigatorsGeneration++;
    if (!fMultiThread) fCurrentNavigator = nav;
    return kTRUE;
 }
@@ -805,6 +837,7 @@ void TGeoManager::ClearNavigators()
       if (arr) delete arr;
    }
    fNavigators.clear();
+   gNavigatorsGeneration++;
    if (fMultiThread) fgMutex.unlock();
 }
 
@@ -820,6 +853,7 @@ void TGeoManager::RemoveNavigator(const TGeoNavigator *nav)
          if ((TGeoNavigator*)arr->Remove((TObject*)nav)) {
             delete nav;
             if (!arr->GetEntries()) fNavigators.erase(it);
+            gNavigatorsGeneration++;
             if (fMultiThread) fgMutex.unlock();
             return;
          }
@@ -891,10 +925,10 @@ void TGeoManager::CreateThreadData() const
 void TGeoManager::ClearThreadsMap()
 {
    if (gGeoManager && !gGeoManager->IsMultiThread()) return;
-   fgMutex.lock();
+   std::lock_guard<std::mutex> lock(gThreadIdsMutex);
    if (!fgThreadId->empty()) fgThreadId->clear();
    fgNumThreads = 0;
-   fgMutex.unlock();
+   gThreadIdsGeneration++;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -904,18 +938,23 @@ void TGeoManager::ClearThreadsMap()
 Int_t TGeoManager::ThreadId()
 {
    TTHREAD_TLS(Int_t) tid = -1;
-   Int_t ttid = tid; // TTHREAD_TLS_GET(Int_t,tid);
-   if (ttid > -1) return ttid;
+   TTHREAD_TLS(UInt_t) tgeneration = 0;
+   Int_t ttid = tid;
+   UInt_t cachedgeneration = tgeneration;
+   if (ttid > -1 && cachedgeneration == gThreadIdsGeneration.load(std::memory_order_acquire)) return ttid;
    if (gGeoManager && !gGeoManager->IsMultiThread()) return 0;
    std::thread::id threadId = std::this_thread::get_id();
+   // The map may be updated concurrently by other threads
+   std::lock_guard<std::mutex> lock(gThreadIdsMutex);
+   tgeneration = gThreadIdsGeneration.load(std::memory_order_relaxed);
    TGeoManager::ThreadsMapIt_t it = fgThreadId->find(threadId);
-   if (it != fgThreadId->end()) return it->second;
-   // Map needs to be updated.
-   fgMutex.lock();
-   (*fgThreadId)[threadId] = fgNumThreads;
-   tid = fgNumThreads; // TTHREAD_TLS_SET(Int_t,tid,fgNumThreads);
-   ttid = fgNumThreads++;
-   fgMutex.unlock();
+   if (it != fgThreadId->end()) {
+      ttid = it->second;
+   } else {
+      (*fgThreadId)[threadId] = fgNumThreads;
+      ttid = fgNumThreads++;
+   }
+   tid = ttid;
    return ttid;
 }
 
@@ -4006,6 +4045,38 @@ void TGeoManager::SetUseParallelWorldNav(Bool_t flag)
    if (fParallelWorld->CloseGeometry()) fUsePWNav=kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Build a read-only flattened copy of the logical hierarchy of the closed
+/// geometry, used by the navigators to locate points without going through the
+/// daughter arrays and the matrices of the nodes at each level. The volumes
+/// which are divided, are assemblies or have overlapping daughters are still
+/// searched with the general algorithm. The flattened geometry is not updated
+/// when the geometry changes and is dropped by the alignment of physical nodes,
+/// so it has to be built again afterwards.
+
+TGeoFlatGeometry *TGeoManager::BuildFlatGeometry()
+{
+   if (!fClosed) {
+      Error("BuildFlatGeometry", "The geometry must be closed first");
+      return 0;
+   }
+   delete fFlatGeometry;
+   fFlatGeometry = new TGeoFlatGeometry(fTopVolume);
+   if (fgVerboseLevel>0) Info("BuildFlatGeometry", "%d volumes and %d nodes flattened",
+                              fFlatGeometry->GetNvolumes(), fFlatGeometry->GetNnodes());
+   return fFlatGeometry;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the flattened geometry, the navigators using again the logical
+/// hierarchy only.
+
+void TGeoManager::ClearFlatGeometry()
+{
+   delete fFlatGeometry;
+   fFlatGeometry = 0;
+}
+
 TGeoManager::EDefaultUnits TGeoManager::GetDefaultUnits()
 {
   return fgDefaultUnits;
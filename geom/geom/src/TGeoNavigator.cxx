@@ -39,10 +39,15 @@ gGeoManager->SetCurrentNavigator(0);
 #include "TGeoVolume.h"
 #include "TGeoPatternFinder.h"
 #include "TGeoVoxelFinder.h"
+#include "TGeoBVH.h"
+#include "TGeoFlatGeometry.h"
 #include "TMath.h"
 #include "TGeoParallelWorld.h"
 #include "TGeoPhysicalNode.h"
 
+#include <memory>
+#include <vector>
+
 static Double_t gTolerance = TGeoShape::Tolerance();
 const char *kGeoOutsidePath = " ";
 const Int_t kN3 = 3*sizeof(Double_t);
@@ -1040,6 +1045,94 @@ TGeoNode *TGeoNavigator::FindNextBoundary(Double_t stepmax, const char *path, Bo
    return fNextNode;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the next boundaries for a basket of tracks located in the same logical volume.
+///
+/// Input:
+///  - vol: volume containing all the tracks
+///  - points, dirs: arrays of 3*ntracks coordinates of the points and directions,
+///    in the local frame of the volume
+///  - steps: proposed step limit for each track
+///
+/// Output:
+///  - steps: distance to the next boundary, if smaller than the proposed step
+///  - idaughters: index of the daughter node entered after the step, -1 if the
+///    track exits the volume or if the proposed step is not limited by a daughter
+///  - safeties: optional, safe distance of each track in the volume
+///
+/// The daughters are processed one after the other for all the tracks, which
+/// allows the vectorized shape methods (DistFromInside_v, DistFromOutside_v,
+/// Safety_v) to process the whole basket. The state of the navigator is not
+/// changed. Assemblies are not resolved: idaughters refers to the direct daughter
+/// of the volume. Returns the number of tracks entering a daughter.
+
+Int_t TGeoNavigator::FindNextBoundary_v(TGeoVolume *vol, const Double_t *points, const Double_t *dirs, Int_t ntracks,
+                                        Double_t *steps, Int_t *idaughters, Double_t *safeties) const
+{
+   if (!vol || ntracks<=0) return 0;
+   std::vector<Double_t> dist(ntracks);
+   std::unique_ptr<Bool_t[]> inside(new Bool_t[ntracks]);
+
+   // Distance to exit the volume
+   TGeoShape *shape = vol->GetShape();
+   shape->DistFromInside_v(points, dirs, dist.data(), ntracks, steps);
+   for (Int_t i=0; i<ntracks; i++) {
+      if (dist[i] < steps[i]) steps[i] = dist[i];
+      idaughters[i] = -1;
+   }
+   if (safeties) {
+      for (Int_t i=0; i<ntracks; i++) inside[i] = kTRUE;
+      shape->Safety_v(points, inside.get(), safeties, ntracks);
+   }
+
+   // Distance to enter the daughters
+   Int_t nd = vol->GetNdaughters();
+   if (!nd || (fGeometry->IsActivityEnabled() && !vol->IsActiveDaughters())) {
+      if (safeties) for (Int_t i=0; i<ntracks; i++) safeties[i] = TMath::Max(safeties[i], 0.);
+      return 0;
+   }
+   std::vector<Double_t> lpoints(3*ntracks), ldirs(3*ntracks), dsafe;
+   if (safeties) dsafe.resize(ntracks);
+   for (Int_t id=0; id<nd; id++) {
+      TGeoNode *current = vol->GetNode(id);
+      TGeoVolume *dvol = current->GetVolume();
+      if (fGeometry->IsActivityEnabled() && !dvol->IsActive()) continue;
+      TGeoMatrix *matrix = current->GetMatrix();
+      for (Int_t i=0; i<ntracks; i++) {
+         matrix->MasterToLocal(&points[3*i], &lpoints[3*i]);
+         matrix->MasterToLocalVect(&dirs[3*i], &ldirs[3*i]);
+      }
+      TGeoShape *dshape = dvol->GetShape();
+      dshape->DistFromOutside_v(lpoints.data(), ldirs.data(), dist.data(), ntracks, steps);
+      if (current->IsOverlapping()) {
+         // tracks deep inside an overlapping daughter do not enter it, as in FindNextDaughterBoundary
+         dshape->Contains_v(lpoints.data(), inside.get(), ntracks);
+         for (Int_t i=0; i<ntracks; i++) {
+            if (inside[i] && dshape->Safety(&lpoints[3*i], kTRUE) > gTolerance) dist[i] = TGeoShape::Big();
+         }
+      }
+      for (Int_t i=0; i<ntracks; i++) {
+         if (dist[i] < steps[i]-gTolerance) {
+            steps[i] = dist[i];
+            idaughters[i] = id;
+         }
+      }
+      if (safeties) {
+         for (Int_t i=0; i<ntracks; i++) inside[i] = kFALSE;
+         dshape->Safety_v(lpoints.data(), inside.get(), dsafe.data(), ntracks);
+         for (Int_t i=0; i<ntracks; i++) {
+            if (dsafe[i] < safeties[i]) safeties[i] = dsafe[i];
+         }
+      }
+   }
+   Int_t nentering = 0;
+   for (Int_t i=0; i<ntracks; i++) {
+      if (idaughters[i] >= 0) nentering++;
+      if (safeties && safeties[i] < 0) safeties[i] = 0.;
+   }
+   return nentering;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Computes as fStep the distance to next daughter of the current volume.
 /// The point and direction must be converted in the coordinate system of the current volume.
@@ -1164,6 +1257,50 @@ TGeoNode *TGeoNavigator::FindNextDaughterBoundary(Double_t *point, Double_t *dir
       if (vol->IsAssembly()) ((TGeoVolumeAssembly*)vol)->SetNextNodeIndex(idaughter);
       return nodefound;
    }
+   // many daughters: check the ones with the bounding box crossed before the current step
+   if (voxels->NeedRebuild()) {
+      voxels->Voxelize();
+      vol->FindOverlaps();
+   }
+   TGeoBVH *bvh = voxels->GetBVH();
+   if (bvh) {
+      bvh->ForEachCrossed(point, dir, fStep, [&](Int_t id) {
+         current = vol->GetNode(id);
+         if (fGeometry->IsActivityEnabled() && !current->GetVolume()->IsActive()) return;
+         current->cd();
+         current->MasterToLocal(point, lpoint);
+         current->MasterToLocalVect(dir, ldir);
+         if (current->IsOverlapping() && current->GetVolume()->Contains(lpoint) &&
+             current->GetVolume()->GetShape()->Safety(lpoint, kTRUE) > gTolerance) return;
+         snext = current->GetVolume()->GetShape()->DistFromOutside(lpoint, ldir, 3, fStep);
+         if (snext<fStep-gTolerance) {
+            if (idebug>4) {
+               printf("   -> to: %s shape %s snext=%g\n", current->GetName(),
+                      current->GetVolume()->GetShape()->ClassName(), snext);
+            }
+            indnext = current->GetVolume()->GetNextNodeIndex();
+            if (compmatrix) {
+               fCurrentMatrix->CopyFrom(fGlobalMatrix);
+               fCurrentMatrix->Multiply(current->GetMatrix());
+            }
+            fIsStepExiting  = kFALSE;
+            fIsStepEntering = kTRUE;
+            fStep=snext;
+            fNextNode = current;
+            nodefound = fNextNode;
+            idaughter = id;
+            while (indnext>=0) {
+               current = current->GetDaughter(indnext);
+               if (compmatrix) fCurrentMatrix->Multiply(current->GetMatrix());
+               fNextNode = current;
+               nodefound = current;
+               indnext = current->GetVolume()->GetNextNodeIndex();
+            }
+         }
+      });
+      if (vol->IsAssembly()) ((TGeoVolumeAssembly*)vol)->SetNextNodeIndex(idaughter);
+      return nodefound;
+   }
    // if current volume is voxelized, first get current voxel
    Int_t ncheck = 0;
    Int_t sumchecked = 0;
@@ -1790,6 +1927,22 @@ Double_t TGeoNavigator::Safety(Bool_t inside)
       }
    }
 
+   //---> many daughters: visit only the ones with bounding boxes closer than the safety
+   TGeoBVH *bvh = voxels->GetBVH();
+   if (bvh) {
+      fSafety = bvh->Safety(point, fSafety, [&](Int_t idaughter) {
+         Double_t safd = ((TGeoNode*)nodes->UncheckedAt(idaughter))->Safety(point, kFALSE);
+         return (safd < gTolerance) ? 0. : safd;
+      });
+      if (fSafety <= 0) {
+         fSafety = 0;
+         fIsOnBoundary = kTRUE;
+         return fSafety;
+      }
+      if (fNmany && !inside) SafetyOverlaps();
+      return fSafety;
+   }
+
    //---> check fast unsafe voxels
    Double_t *boxes = voxels->GetBoxes();
    for (id=0; id<nd; id++) {
@@ -1990,6 +2143,26 @@ TGeoNode *TGeoNavigator::SearchNode(Bool_t downwards, const TGeoNode *skipnode)
    if (!nd) return fCurrentNode;
    if (fGeometry->IsActivityEnabled() && !vol->IsActiveDaughters()) return fCurrentNode;
 
+   // use the flattened geometry to descend through the volumes having
+   // non-overlapping daughters, the deepest one reached being searched below
+   TGeoFlatGeometry *flat = fGeometry->GetFlatGeometry();
+   if (flat && !fGeometry->IsActivityEnabled()) {
+      Int_t ivol = flat->GetVolumeIndex(vol);
+      if (ivol >= 0 && flat->IsFlat(ivol)) {
+         const Int_t kMaxFlatDepth = 64;
+         Int_t path[kMaxFlatDepth];
+         Bool_t complete;
+         Int_t depth = flat->Locate(ivol, point, skipnode, path, kMaxFlatDepth, *fCache->GetInfo(), complete);
+         fCache->ReleaseInfo();
+         for (Int_t i=0; i<depth; i++) CdDown(path[i]);
+         if (depth) fIsSameLocation = kFALSE;
+         if (complete) return fCurrentNode;
+         // the current node is known to contain the point
+         fForcedNode = 0;
+         return SearchNode(kTRUE, fCurrentNode);
+      }
+   }
+
    TGeoPatternFinder *finder = vol->GetFinder();
    // point is inside the current node
    // first check if inside a division
@@ -327,6 +327,8 @@ Bool_t TGeoPhysicalNode::Align(TGeoMatrix *newmat, TGeoShape *newshape, Bool_t c
          gGeoManager->SetCheckedNode(0);
       }
    }
+   // The flattened geometry refers to the replaced node and matrix
+   gGeoManager->ClearFlatGeometry();
    // Clean current matrices from cache
    gGeoManager->CdTop();
    SetAligned(kTRUE);
@@ -14,8 +14,13 @@
 \ingroup Geometry_classes
 
 Tessellated solid class. It is composed by a set of planar faces having triangular or
-quadrilateral shape. The class does not provide navigation functionality, it just wraps the data
-for the composing faces.
+quadrilateral shape.
+
+Once the shape is closed, a bounding volume hierarchy (TGeoBVH) of the facets is built and used
+by the navigation methods, so that Contains(), DistFromInside(), DistFromOutside() and Safety()
+only test the facets close to the point or crossed by the ray. The navigation is meaningful for
+closed bodies made of planar facets, the quadrilateral facets being split in two triangles.
+The outward direction of the normals is deduced from the sign of the enclosed volume.
 */
 
 #include <iostream>
@@ -30,6 +35,7 @@ for the composing faces.
 #include "TBuffer3DTypes.h"
 #include "TMath.h"
 
+#include <algorithm>
 #include <array>
 #include <vector>
 
@@ -37,6 +43,77 @@ ClassImp(TGeoTessellated)
 
    using Vertex_t = Tessellated::Vertex_t;
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Distance along the ray to the triangle (v0, v1, v2), using the Moller-Trumbore
+/// algorithm. Returns false if the ray misses the triangle or is parallel to it.
+/// The edges are enlarged by a small relative tolerance, so that rays through an
+/// edge shared by two facets do not leak through the mesh.
+
+bool IntersectTriangle(const double *point, const double *dir, const Vertex_t &v0, const Vertex_t &v1,
+                       const Vertex_t &v2, double &dist)
+{
+   constexpr double kEdgeTolerance = 1.e-9;
+   const Vertex_t d(dir[0], dir[1], dir[2]);
+   const Vertex_t e1 = v1 - v0;
+   const Vertex_t e2 = v2 - v0;
+   const Vertex_t p = Vertex_t::Cross(d, e2);
+   const double det = e1.Dot(p);
+   if (TMath::Abs(det) < 1.e-30)
+      return false;
+   const double invdet = 1. / det;
+   const Vertex_t s = Vertex_t(point[0], point[1], point[2]) - v0;
+   const double u = s.Dot(p) * invdet;
+   if (u < -kEdgeTolerance || u > 1. + kEdgeTolerance)
+      return false;
+   const Vertex_t q = Vertex_t::Cross(s, e1);
+   const double v = d.Dot(q) * invdet;
+   if (v < -kEdgeTolerance || u + v > 1. + kEdgeTolerance)
+      return false;
+   dist = e2.Dot(q) * invdet;
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Squared distance from a point to the triangle (a, b, c), computed from the closest
+/// point of the triangle in terms of its barycentric coordinates.
+
+double DistanceToTriangle2(const Vertex_t &p, const Vertex_t &a, const Vertex_t &b, const Vertex_t &c)
+{
+   const Vertex_t ab = b - a;
+   const Vertex_t ac = c - a;
+   const Vertex_t ap = p - a;
+   const double d1 = ab.Dot(ap);
+   const double d2 = ac.Dot(ap);
+   if (d1 <= 0. && d2 <= 0.)
+      return ap.Mag2(); // vertex a
+   const Vertex_t bp = p - b;
+   const double d3 = ab.Dot(bp);
+   const double d4 = ac.Dot(bp);
+   if (d3 >= 0. && d4 <= d3)
+      return bp.Mag2(); // vertex b
+   const double vc = d1 * d4 - d3 * d2;
+   if (vc <= 0. && d1 >= 0. && d3 <= 0.)
+      return (ap - ab * (d1 / (d1 - d3))).Mag2(); // edge ab
+   const Vertex_t cp = p - c;
+   const double d5 = ab.Dot(cp);
+   const double d6 = ac.Dot(cp);
+   if (d6 >= 0. && d5 <= d6)
+      return cp.Mag2(); // vertex c
+   const double vb = d5 * d2 - d1 * d6;
+   if (vb <= 0. && d2 >= 0. && d6 <= 0.)
+      return (ap - ac * (d2 / (d2 - d6))).Mag2(); // edge ac
+   const double va = d3 * d6 - d5 * d4;
+   if (va <= 0. && (d4 - d3) >= 0. && (d5 - d6) >= 0.)
+      return (bp - (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)))).Mag2(); // edge bc
+   // inside the face
+   const double denom = 1. / (va + vb + vc);
+   return (ap - ab * (vb * denom) - ac * (vc * denom)).Mag2();
+}
+
+} // namespace
+
 std::ostream &operator<<(std::ostream &os, TGeoFacet const &facet)
 {
    os << "{";
@@ -208,9 +285,10 @@ TGeoTessellated::TGeoTessellated(const char *name, const std::vector<Vertex_t> &
 void TGeoTessellated::AfterStreamer()
 {
    // The pointer to the array of vertices is not streamed so update it to facets
-   for (auto facet : fFacets)
+   for (auto &facet : fFacets)
       facet.SetVertices(&fVertices);
    fDefined = true;
+   BuildBVH();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -332,14 +410,14 @@ void TGeoTessellated::CloseShape(bool check, bool fixFlipped, bool verbose)
 
    if (fVertices.size() > 0) {
       fDefined = true;
-      if (!check)
-         return;
-
-      // Check facets
-      for (auto &facet : fFacets) {
-         facet.Check();
+      if (check) {
+         // Check facets
+         for (auto &facet : fFacets) {
+            facet.Check();
+         }
+         fClosedBody = CheckClosure(fixFlipped, verbose);
       }
-      fClosedBody = CheckClosure(fixFlipped, verbose);
+      BuildBVH();
       return;
    }
 
@@ -411,15 +489,266 @@ void TGeoTessellated::CloseShape(bool check, bool fixFlipped, bool verbose)
    fNvert = fVertices.size();
    fNfacets = fFacets.size();
    fDefined = true;
-   if (!check)
+   if (check) {
+      // Check facets
+      for (auto &facet : fFacets) {
+         facet.Check();
+      }
+      fClosedBody = CheckClosure(fixFlipped, verbose);
+   }
+   BuildBVH();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the outward normals and the bounding volume hierarchy of the facets,
+/// used by the navigation methods.
+
+void TGeoTessellated::BuildBVH()
+{
+   const int nfacets = fFacets.size();
+   fNormals.resize(nfacets);
+   std::vector<double> boxes(6 * nfacets);
+   double volume = 0.;
+   bool degenerated;
+   for (int i = 0; i < nfacets; ++i) {
+      const TGeoFacet &facet = fFacets[i];
+      fNormals[i] = facet.ComputeNormal(degenerated);
+      double vmin[3], vmax[3];
+      for (int j = 0; j < 3; ++j)
+         vmin[j] = vmax[j] = facet.GetVertex(0)[j];
+      for (int k = 1; k < facet.GetNvert(); ++k) {
+         for (int j = 0; j < 3; ++j) {
+            vmin[j] = TMath::Min(vmin[j], facet.GetVertex(k)[j]);
+            vmax[j] = TMath::Max(vmax[j], facet.GetVertex(k)[j]);
+         }
+         // Signed volume of the tetrahedra made by the origin and the triangles of the facet
+         if (k < facet.GetNvert() - 1)
+            volume += Vertex_t::Cross(facet.GetVertex(k), facet.GetVertex(k + 1)).Dot(facet.GetVertex(0)) / 6.;
+      }
+      for (int j = 0; j < 3; ++j) {
+         boxes[6 * i + j] = 0.5 * (vmax[j] - vmin[j]);
+         boxes[6 * i + 3 + j] = 0.5 * (vmax[j] + vmin[j]);
+      }
+   }
+   // The facets are oriented consistently, but not necessarily outwards
+   if (volume < 0.) {
+      for (auto &normal : fNormals)
+         normal *= -1.;
+   }
+   fCapacity = TMath::Abs(volume);
+   if (!fBVH)
+      fBVH.reset(new TGeoBVH());
+   fBVH->Build(boxes.data(), nfacets);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Distance along the ray to the closest facet crossed before stepmax, in the
+/// direction given by orientation: 1 for exiting, -1 for entering, 0 for any
+/// of them. The index of the facet is returned in ifacet, -1 if there is none.
+
+double TGeoTessellated::FirstCrossedFacet(const double *point, const double *dir, double stepmax, int orientation,
+                                          int &ifacet) const
+{
+   const double tolerance = TGeoShape::Tolerance();
+   double snext = stepmax;
+   ifacet = -1;
+   fBVH->ForEachCrossed(point, dir, snext, [&](int i) {
+      const double cosa = fNormals[i][0] * dir[0] + fNormals[i][1] * dir[1] + fNormals[i][2] * dir[2];
+      if (orientation * cosa < 0. || (!orientation && cosa == 0.))
+         return;
+      const TGeoFacet &facet = fFacets[i];
+      double dist;
+      for (int k = 1; k < facet.GetNvert() - 1; ++k) {
+         if (!IntersectTriangle(point, dir, facet.GetVertex(0), facet.GetVertex(k), facet.GetVertex(k + 1), dist))
+            continue;
+         if (dist > -tolerance && dist < snext) {
+            snext = dist;
+            ifacet = i;
+         }
+         break;
+      }
+   });
+   return TMath::Max(snext, 0.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Distance from the point to the closest facet, which index is returned in ifacet.
+
+double TGeoTessellated::NearestFacet(const double *point, int &ifacet) const
+{
+   const Vertex_t p(point[0], point[1], point[2]);
+   double nearest = TGeoShape::Big();
+   ifacet = -1;
+   fBVH->Safety(point, nearest, [&](int i) {
+      const TGeoFacet &facet = fFacets[i];
+      double dist2 = TGeoShape::Big();
+      for (int k = 1; k < facet.GetNvert() - 1; ++k)
+         dist2 = TMath::Min(
+            dist2, DistanceToTriangle2(p, facet.GetVertex(0), facet.GetVertex(k), facet.GetVertex(k + 1)));
+      const double dist = TMath::Sqrt(dist2);
+      if (dist < nearest) {
+         nearest = dist;
+         ifacet = i;
+      }
+      return dist;
+   });
+   return nearest;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Volume enclosed by the facets
+
+double TGeoTessellated::Capacity() const
+{
+   if (!fBVH)
+      return TGeoBBox::Capacity();
+   return fCapacity;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the normal of the closest facet, pointing in the same hemisphere as dir
+
+void TGeoTessellated::ComputeNormal(const double *point, const double *dir, double *norm)
+{
+   int ifacet = -1;
+   if (fBVH)
+      NearestFacet(point, ifacet);
+   if (ifacet < 0) {
+      TGeoBBox::ComputeNormal(point, dir, norm);
       return;
+   }
+   fNormals[ifacet].CopyTo(norm);
+   if (norm[0] * dir[0] + norm[1] * dir[1] + norm[2] * dir[2] < 0.) {
+      for (int i = 0; i < 3; ++i)
+         norm[i] = -norm[i];
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the normal for an array of points and directions
+
+void TGeoTessellated::ComputeNormal_v(const double *points, const double *dirs, double *norms, int vecsize)
+{
+   for (int i = 0; i < vecsize; ++i)
+      ComputeNormal(&points[3 * i], &dirs[3 * i], &norms[3 * i]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Check if the point is inside the solid: the first facet crossed by a ray
+/// starting from the point is exiting the solid.
+
+bool TGeoTessellated::Contains(const double *point) const
+{
+   if (!TGeoBBox::Contains(point))
+      return false;
+   if (!fBVH)
+      return true;
+   // A direction not aligned with the axes, to avoid grazing the facets of axis aligned meshes
+   static const double dir[3] = {0.5773502691896257, 0.5773502691896258, 0.5773502691896259};
+   int ifacet;
+   FirstCrossedFacet(point, dir, TGeoShape::Big(), 0, ifacet);
+   if (ifacet < 0)
+      return false;
+   return (fNormals[ifacet][0] * dir[0] + fNormals[ifacet][1] * dir[1] + fNormals[ifacet][2] * dir[2]) > 0.;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Check the containment of an array of points
+
+void TGeoTessellated::Contains_v(const double *points, bool *inside, int vecsize) const
+{
+   for (int i = 0; i < vecsize; ++i)
+      inside[i] = Contains(&points[3 * i]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the distance from an inside point to the first facet exiting the solid
 
-   // Check facets
-   for (auto &facet : fFacets) {
-      facet.Check();
+double TGeoTessellated::DistFromInside(const double *point, const double *dir, int iact, double step,
+                                       double *safe) const
+{
+   if (!fBVH)
+      return TGeoBBox::DistFromInside(point, dir, iact, step, safe);
+   if (iact < 3 && safe) {
+      *safe = Safety(point, true);
+      if (iact == 0)
+         return TGeoShape::Big();
+      if (iact == 1 && step < *safe)
+         return TGeoShape::Big();
    }
+   int ifacet;
+   double snext = FirstCrossedFacet(point, dir, TGeoShape::Big(), 1, ifacet);
+   // No exiting facet: the point is on the boundary or outside
+   if (ifacet < 0)
+      return 0.;
+   return snext;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the distance from inside for an array of points and directions
 
-   fClosedBody = CheckClosure(fixFlipped, verbose);
+void TGeoTessellated::DistFromInside_v(const double *points, const double *dirs, double *dists, int vecsize,
+                                       double *step) const
+{
+   for (int i = 0; i < vecsize; ++i)
+      dists[i] = DistFromInside(&points[3 * i], &dirs[3 * i], 3, step[i]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the distance from an outside point to the first facet entering the solid
+
+double TGeoTessellated::DistFromOutside(const double *point, const double *dir, int iact, double step,
+                                        double *safe) const
+{
+   if (!fBVH)
+      return TGeoBBox::DistFromOutside(point, dir, iact, step, safe);
+   if (iact < 3 && safe) {
+      *safe = Safety(point, false);
+      if (iact == 0)
+         return TGeoShape::Big();
+      if (iact == 1 && step < *safe)
+         return TGeoShape::Big();
+   }
+   // The bounding box is checked first, it is cheap and most of the rays miss the solid
+   const double sbox = TGeoBBox::DistFromOutside(point, dir, fDX, fDY, fDZ, fOrigin, step);
+   if (sbox >= step || sbox >= TGeoShape::Big())
+      return TGeoShape::Big();
+   int ifacet;
+   double snext = FirstCrossedFacet(point, dir, step, -1, ifacet);
+   if (ifacet < 0)
+      return TGeoShape::Big();
+   return snext;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the distance from outside for an array of points and directions
+
+void TGeoTessellated::DistFromOutside_v(const double *points, const double *dirs, double *dists, int vecsize,
+                                        double *step) const
+{
+   for (int i = 0; i < vecsize; ++i)
+      dists[i] = DistFromOutside(&points[3 * i], &dirs[3 * i], 3, step[i]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Safe distance from the point to the closest facet. The computation is the
+/// same for inside and outside points.
+
+double TGeoTessellated::Safety(const double *point, bool in) const
+{
+   if (!fBVH)
+      return TGeoBBox::Safety(point, in);
+   int ifacet;
+   return NearestFacet(point, ifacet);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the safe distance for an array of points
+
+void TGeoTessellated::Safety_v(const double *points, const bool *inside, double *safe, int vecsize) const
+{
+   for (int i = 0; i < vecsize; ++i)
+      safe[i] = Safety(&points[3 * i], inside[i]);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -30,9 +30,12 @@ Full description with examples and pictures
 #include "TGeoNode.h"
 #include "TGeoManager.h"
 #include "TGeoStateInfo.h"
+#include "TGeoBVH.h"
 
 ClassImp(TGeoVoxelFinder);
 
+Int_t TGeoVoxelFinder::fgBVHMinDaughters = 32;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor
 
@@ -71,6 +74,7 @@ TGeoVoxelFinder::TGeoVoxelFinder()
    fNsliceX = 0;
    fNsliceY = 0;
    fNsliceZ = 0;
+   fBVH     = 0;
    memset(fPriority, 0, 3*sizeof(Int_t));
    SetInvalid(kFALSE);
 }
@@ -117,6 +121,7 @@ TGeoVoxelFinder::TGeoVoxelFinder(TGeoVolume *vol)
    fNsliceX = 0;
    fNsliceY = 0;
    fNsliceZ = 0;
+   fBVH     = 0;
    memset(fPriority, 0, 3*sizeof(Int_t));
    SetNeedRebuild();
 }
@@ -149,6 +154,28 @@ TGeoVoxelFinder::~TGeoVoxelFinder()
    if (fExtraY) delete [] fExtraY;
    if (fExtraZ) delete [] fExtraZ;
 //   printf("IndX IndY IndZ...\n");
+   delete fBVH;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the bounding volume hierarchy of the daughter boxes if the volume has
+/// at least GetBVHMinDaughters() daughters, otherwise delete it. With many
+/// daughters the hierarchy replaces the loops over all daughter boxes done by
+/// the navigator for the safety and the candidates crossed by a ray, and it
+/// gives exact bounding box candidates for the point location, which the voxels
+/// only narrow down to the candidates of a slice when the daughters are
+/// rotated or overlap. A value of 0 or less for the minimum disables it.
+
+void TGeoVoxelFinder::BuildBVH()
+{
+   Int_t nd = fNboxes/6;
+   if (!fBoxes || fgBVHMinDaughters <= 0 || nd < fgBVHMinDaughters) {
+      delete fBVH;
+      fBVH = 0;
+      return;
+   }
+   if (!fBVH) fBVH = new TGeoBVH();
+   fBVH->Build(fBoxes, nd);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1208,6 +1235,11 @@ Int_t *TGeoVoxelFinder::GetCheckList(const Double_t *point, Int_t &nelem, TGeoSt
       Voxelize();
       fVolume->FindOverlaps();
    }
+   if (fBVH) {
+      // only the daughters having their bounding box containing the point
+      nelem = fBVH->GetContaining(point, td.fVoxCheckList);
+      return (nelem) ? td.fVoxCheckList : 0;
+   }
    if (fVolume->GetNdaughters() == 1) {
       if (fXb) {
          if (point[0]<fXb[0] || point[0]>fXb[1]) return 0;
@@ -2229,6 +2261,7 @@ void TGeoVoxelFinder::Voxelize(Option_t * /*option*/)
    }
    BuildVoxelLimits();
    SortAll();
+   BuildBVH();
    SetNeedRebuild(kFALSE);
 }
 ////////////////////////////////////////////////////////////////////////////////
@@ -2241,6 +2274,7 @@ void TGeoVoxelFinder::Streamer(TBuffer &R__b)
       Version_t R__v = R__b.ReadVersion(&R__s, &R__c);
       if (R__v > 2) {
          R__b.ReadClassBuffer(TGeoVoxelFinder::Class(), this, R__v, R__s, R__c);
+         BuildBVH();
          return;
       }
       // Process old versions of the voxel finder. Just read the data
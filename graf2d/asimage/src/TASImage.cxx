@@ -78,6 +78,7 @@ ROOT tutorials: `$ROOTSYS/tutorials/image/`
 #include "TPoint.h"
 #include "TFrame.h"
 #include "TTF.h"
+#include "TVirtualMutex.h"
 #include "TRandom.h"
 #include <iostream>
 #include "THashTable.h"
@@ -499,7 +500,7 @@ void TASImage::ReadImage(const char *filename, EImageFileTypes /*type*/)
    // suppress the "root : looking for image ..." messages
    set_output_threshold(0);
 
-   static ASImageImportParams iparams;
+   ASImageImportParams iparams{};
    iparams.flags = 0;
    iparams.width = 0;
    iparams.height = 0;
@@ -683,9 +684,8 @@ void TASImage::WriteImage(const char *file, EImageFileTypes type)
    EImageQuality quality = GetImageQuality();
    MapQuality(quality, aquality);
 
-   static TString fname;
-   fname = file;
-   static ASImageExportParams parms;
+   TString fname = file;
+   ASImageExportParams parms{};
    ASImage *im = fScaledImage ? fScaledImage->fImage : fImage;
 
    switch (type) {
@@ -2196,6 +2196,8 @@ void TASImage::GetZoomPosition(UInt_t &x, UInt_t &y, UInt_t &w, UInt_t &h) const
 
 Bool_t TASImage::InitVisual()
 {
+   R__LOCKGUARD(gROOTMutex);
+
    Display *disp;
 
    Bool_t inbatch = fgVisual && (fgVisual->dpy == (void*)1); // was in batch
@@ -2587,6 +2589,9 @@ void TASImage::DrawText(Int_t x, Int_t y, const char *text, Int_t size,
    ASImage *text_im = 0;
    Bool_t ttfont = kFALSE;
 
+   // the TTF interface and the font manager are shared by all images
+   R__LOCKGUARD2(gTTFMutex);
+
    if (!InitVisual()) {
       Warning("DrawText", "Visual not initiated");
       return;
@@ -5824,6 +5829,8 @@ void TASImage::DrawText(TText *text, Int_t x, Int_t y)
       BeginPaint();
    }
 
+   R__LOCKGUARD2(gTTFMutex);
+
    if (!TTF::IsInitialized()) TTF::Init();
 
    // set text font
@@ -5955,6 +5962,8 @@ void TASImage::DrawText(TText *text, Int_t x, Int_t y)
 void TASImage::DrawTextTTF(Int_t x, Int_t y, const char *text, Int_t size,
                            UInt_t color, const char *font_name, Float_t angle)
 {
+   R__LOCKGUARD2(gTTFMutex);
+
    if (!TTF::IsInitialized()) TTF::Init();
 
    TTF::SetTextFont(font_name);
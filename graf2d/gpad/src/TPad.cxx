@@ -4183,7 +4183,7 @@ void TPad::PaintLine(Double_t x1, Double_t y1, Double_t x2, Double_t y2)
 
 void TPad::PaintLineNDC(Double_t u1, Double_t v1,Double_t u2, Double_t v2)
 {
-   static Double_t xw[2], yw[2];
+   Double_t xw[2], yw[2];
    if (!gPad->IsBatch())
       GetPainter()->DrawLineNDC(u1, v1, u2, v2);
 
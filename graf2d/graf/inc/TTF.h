@@ -48,6 +48,7 @@ extern "C" {
 class TGX11TTF;
 class TGWin32;
 class TMathTextRenderer;
+class TVirtualMutex;
 
 
 class TTF {
@@ -128,4 +129,6 @@ public:
    ClassDef(TTF,0)  //Interface to TTF font handling
 };
 
+R__EXTERN TVirtualMutex *gTTFMutex;
+
 #endif
@@ -21,6 +21,7 @@
 #include "TVirtualPS.h"
 #include "TVirtualX.h"
 #include "TText.h"
+#include "TVirtualMutex.h"
 
 #include "../../../graf2d/mathtext/inc/mathtext.h"
 #include "../../../graf2d/mathtext/inc/mathrender.h"
@@ -404,6 +405,8 @@ void TMathText::
 Render(const Double_t x, const Double_t y, const Double_t size,
       const Double_t angle, const Char_t *t, const Int_t /*length*/)
 {
+   R__LOCKGUARD2(gTTFMutex);
+
    const mathtext::math_text_t math_text(t);
    TMathTextRenderer *renderer = (TMathTextRenderer *)fRenderer;
 
@@ -419,6 +422,8 @@ GetSize(Double_t &x0, Double_t &y0, Double_t &x1, Double_t &y1,
       const Double_t size, const Double_t angle, const Char_t *t,
       const Int_t /*length*/)
 {
+   R__LOCKGUARD2(gTTFMutex);
+
    const mathtext::math_text_t math_text(t);
    TMathTextRenderer *renderer = (TMathTextRenderer *)fRenderer;
 
@@ -453,6 +458,8 @@ GetAlignPoint(Double_t &x0, Double_t &y0,
            const Char_t *t, const Int_t /*length*/,
            const Short_t align)
 {
+   R__LOCKGUARD2(gTTFMutex);
+
    const mathtext::math_text_t math_text(t);
    TMathTextRenderer *renderer = (TMathTextRenderer *)fRenderer;
 
@@ -13,6 +13,11 @@
 \ingroup BasicGraphics
 
 Interface to the freetype 2 library.
+
+The state of the interface (current font, size, rotation and glyphs) is
+global. Sequences of calls setting and using this state, e.g. from
+TText::GetTextExtent or TASImage::DrawText, have to hold gTTFMutex when
+ROOT::EnableThreadSafety() was called.
 */
 
 #  include <ft2build.h>
@@ -24,12 +29,15 @@ Interface to the freetype 2 library.
 #include "TEnv.h"
 #include "TMath.h"
 #include "TError.h"
+#include "TVirtualMutex.h"
 
 // to scale fonts to the same size as the old TT version
 const Float_t kScale = 0.93376068;
 
 TTF gCleanupTTF; // Allows to call "Cleanup" at the end of the session
 
+TVirtualMutex *gTTFMutex = nullptr;
+
 Bool_t         TTF::fgInit           = kFALSE;
 Bool_t         TTF::fgSmoothing      = kTRUE;
 Bool_t         TTF::fgKerning        = kTRUE;
@@ -64,6 +72,9 @@ TTF::~TTF()
 
 void TTF::Init()
 {
+   R__LOCKGUARD2(gTTFMutex);
+
+   if (fgInit) return;
    fgInit = kTRUE;
 
    // initialize FTF library
@@ -125,7 +125,7 @@ void TImageDump::DrawBox(Double_t x1, Double_t y1, Double_t x2, Double_t  y2)
 
    fImage->BeginPaint();
 
-   static Double_t x[4], y[4];
+   Double_t x[4], y[4];
    Int_t ix1 = x1 < x2 ? XtoPixel(x1) : XtoPixel(x2);
    Int_t ix2 = x1 < x2 ? XtoPixel(x2) : XtoPixel(x1);
    Int_t iy1 = y1 < y2 ? YtoPixel(y1) : YtoPixel(y2);
@@ -292,7 +292,7 @@ void TImageDump::DrawPolyMarker(Int_t n, Double_t *xw, Double_t *yw)
 
    fMarkerStyle = TMath::Abs(fMarkerStyle);
    Int_t ms = TAttMarker::GetMarkerStyleBase(fMarkerStyle);
-   static TPoint pt[20];
+   TPoint pt[20];
 
    if (ms == 4)
       ms = 24;
@@ -656,15 +656,15 @@ void TImageDump::DrawPS(Int_t nn, Double_t *x, Double_t *y)
    fasi = fFillStyle%1000;
 
    Short_t px1, py1, px2, py2;
-   static const UInt_t gCachePtSize = 200;
-   static TPoint gPointCache[gCachePtSize];
+   const UInt_t gCachePtSize = 200;
+   TPoint gPointCache[gCachePtSize];
    Bool_t del = kTRUE;
 
 
    // SetLineStyle
    Int_t ndashes = 0;
    char *dash = 0;
-   static char dashList[10];
+   char dashList[10];
    Int_t dashLength = 0;
    Int_t dashSize = 0;
 
@@ -889,15 +889,16 @@ void TImageDump::Text(Double_t x, Double_t y, const wchar_t *chars)
 
 
 ////////////////////////// CellArray code ////////////////////////////////////
-static UInt_t *gCellArrayColors = 0;
-static Int_t   gCellArrayN = 0;
-static Int_t   gCellArrayW = 0;
-static Int_t   gCellArrayH = 0;
-static Int_t   gCellArrayX1 = 0;
-static Int_t   gCellArrayX2 = 0;
-static Int_t   gCellArrayY1 = 0;
-static Int_t   gCellArrayY2 = 0;
-static Int_t   gCellArrayIdx = 0;
+// the cell array is filled by consecutive calls, possibly for different images in different threads
+static thread_local UInt_t *gCellArrayColors = 0;
+static thread_local Int_t   gCellArrayN = 0;
+static thread_local Int_t   gCellArrayW = 0;
+static thread_local Int_t   gCellArrayH = 0;
+static thread_local Int_t   gCellArrayX1 = 0;
+static thread_local Int_t   gCellArrayX2 = 0;
+static thread_local Int_t   gCellArrayY1 = 0;
+static thread_local Int_t   gCellArrayY2 = 0;
+static thread_local Int_t   gCellArrayIdx = 0;
 
 ////////////////////////////////////////////////////////////////////////////////
 ///cell array begin
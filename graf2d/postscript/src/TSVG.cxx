@@ -210,7 +210,7 @@ void TSVG::Off()
 
 void TSVG::DrawBox(Double_t x1, Double_t y1, Double_t x2, Double_t  y2)
 {
-   static Double_t x[4], y[4];
+   Double_t x[4], y[4];
    Double_t ix1 = XtoSVG(TMath::Min(x1,x2));
    Double_t ix2 = XtoSVG(TMath::Max(x1,x2));
    Double_t iy1 = YtoSVG(TMath::Min(y1,y2));
@@ -291,7 +291,7 @@ void TSVG::DrawBox(Double_t x1, Double_t y1, Double_t x2, Double_t  y2)
 void TSVG::DrawFrame(Double_t xl, Double_t yl, Double_t xt, Double_t  yt,
                             Int_t mode, Int_t border, Int_t dark, Int_t light)
 {
-   static Double_t xps[7], yps[7];
+   Double_t xps[7], yps[7];
    Int_t i;
    Double_t ixd0, iyd0, ixdi, iydi, ix, iy;
    Int_t idx, idy;
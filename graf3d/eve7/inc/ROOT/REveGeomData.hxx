@@ -18,6 +18,7 @@
 #include <string>
 #include <functional>
 #include <memory>
+#include <unordered_map>
 
 class TGeoNode;
 class TGeoManager;
@@ -80,6 +81,8 @@ class RGeomRawRenderInfo : public RGeomRenderInfo  {
 public:
    // render data, equivalent of REveElement::WriteCoreJson
    int sz[3]={0,0, 0};        ///< fRenderData: [SizeV(), SizeN(), SizeI()];
+   int fmt{0};                ///< REveRenderData::ECompact_e flags used to encode raw data
+   float range[6]={0,0,0,0,0,0}; ///< for quantized vertices: minimal x,y,z and quantization steps
    std::vector<unsigned char> raw;  ///< raw shape data with render information, JSON_base64
    virtual ~RGeomRawRenderInfo() = default;
 };
@@ -169,6 +172,7 @@ class REveGeomDescription {
       int nfaces{0};                               ///<! number of faces in render data
       RGeomRawRenderInfo fRawInfo;                 ///<! raw render info
       RGeomShapeRenderInfo fShapeInfo;             ///<! shape itself as info
+      int fSameRaw{-1};                            ///<! id of shape with identical raw info, which is used instead
       ShapeDescr(TGeoShape *s) : fShape(s) {}
 
       bool has_shape() const { return nfaces == 1; }
@@ -187,6 +191,7 @@ class REveGeomDescription {
          nfaces = 0;
          fShapeInfo.shape = nullptr;
          fRawInfo.raw.clear();
+         fSameRaw = -1;
       }
    };
 
@@ -195,12 +200,15 @@ class REveGeomDescription {
 
    std::vector<int> fSortMap;       ///<! nodes in order large -> smaller volume
    std::vector<ShapeDescr> fShapes; ///<! shapes with created descriptions
+   std::unordered_map<TGeoShape *, int> fShapesMap;  ///<! index of shapes in fShapes
+   std::unordered_multimap<std::size_t, int> fRawMap; ///<! shapes with raw info, indexed by hash of raw data
 
    std::string fDrawJson;           ///<! JSON with main nodes drawn by client
    int fDrawIdCut{0};               ///<! sortid used for selection of most-significant nodes
    int fActualLevel{0};             ///<! level can be reduced when selecting nodes
    bool fPreferredOffline{false};   ///<! indicates that full description should be provided to client
    int fJsonComp{0};                ///<! default JSON compression
+   bool fQuantize{false};           ///<! quantize vertices and normals of meshes build on server
 
    REveGeomConfig fCfg;             ///<! configuration parameter editable from GUI
 
@@ -218,6 +226,8 @@ class REveGeomDescription {
 
    ShapeDescr &MakeShapeDescr(TGeoShape *shape);
 
+   RGeomRenderInfo *GetRndrInfo(ShapeDescr &descr);
+
    void CopyMaterialProperties(TGeoVolume *vol, REveGeomNode &node);
 
    void CollectNodes(REveGeomDrawing &drawing);
@@ -298,6 +308,11 @@ public:
    /** Returns JSON compression level for data transfer */
    int GetJsonComp() const  { return fJsonComp; }
 
+   /** Quantize vertices to 16 bits and normals to 8 bits in meshes build on server, must be set before drawing */
+   void SetQuantizeMeshes(bool on = true) { fQuantize = on; }
+   /** Returns true if meshes build on server are quantized */
+   bool IsQuantizeMeshes() const { return fQuantize; }
+
    /** Set draw options as string for JSROOT TGeoPainter */
    void SetDrawOptions(const std::string &opt = "") { fCfg.drawopt = opt; }
    /** Returns draw options, used for JSROOT TGeoPainter */
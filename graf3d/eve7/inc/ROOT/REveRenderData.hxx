@@ -34,6 +34,14 @@ public:
 
    enum Primitive_e { GL_POINTS = 0, GL_LINES, GL_LINE_LOOP, GL_LINE_STRIP, GL_TRIANGLES };
 
+   // If ECompact_e is changed, change also decoding in GeomViewer.controller.js.
+
+   enum ECompact_e {
+      kShortIndex = 1,      ///< indices stored as 16-bit unsigned integers
+      kQuantizedVertex = 2, ///< vertices stored as 16-bit unsigned integers in the bounding box
+      kQuantizedNormal = 4  ///< normals stored as 8-bit signed integers, scaled by 127
+   };
+
    REveRenderData() = default;
    REveRenderData(const std::string &func, int size_vert = 0, int size_norm = 0, int size_idx = 0);
 
@@ -98,6 +106,10 @@ public:
    int GetBinarySize() { return (SizeV() + SizeN() + SizeT()) * sizeof(float) + SizeI() * sizeof(int); }
 
    int Write(char *msg, int maxlen);
+
+   int GetCompactFlags(bool quantize) const;
+   int GetCompactSize(int flags) const;
+   int WriteCompact(char *msg, int maxlen, int flags, float *range) const;
 };
 
 } // namespace Experimental
@@ -609,18 +609,22 @@ std::string ROOT::Experimental::REveGeomDescription::ProcessBrowserRequest(const
 
 ROOT::Experimental::REveGeomDescription::ShapeDescr &ROOT::Experimental::REveGeomDescription::FindShapeDescr(TGeoShape *shape)
 {
-   for (auto &descr : fShapes)
-      if (descr.fShape == shape)
-         return descr;
+   auto iter = fShapesMap.find(shape);
+   if (iter != fShapesMap.end())
+      return fShapes[iter->second];
 
    fShapes.emplace_back(shape);
    auto &elem = fShapes.back();
    elem.id = fShapes.size() - 1;
+   fShapesMap[shape] = elem.id;
    return elem;
 }
 
 /////////////////////////////////////////////////////////////////////
 /// Find description object and create render information
+/// Meshes are build once per TGeoShape. When different shapes produce identical
+/// mesh, all of them refer to the raw info of the first one, so that the mesh
+/// is transferred only once and each visible node only provides its placement.
 
 ROOT::Experimental::REveGeomDescription::ShapeDescr &
 ROOT::Experimental::REveGeomDescription::MakeShapeDescr(TGeoShape *shape)
@@ -660,12 +664,33 @@ ROOT::Experimental::REveGeomDescription::MakeShapeDescr(TGeoShape *shape)
 
          elem.nfaces = poly->GetNumFaces();
 
-         elem.fRawInfo.raw.resize(rd.GetBinarySize());
-         rd.Write( reinterpret_cast<char *>(elem.fRawInfo.raw.data()), elem.fRawInfo.raw.size() );
-         elem.fRawInfo.sz[0] = rd.SizeV();
-         elem.fRawInfo.sz[1] = rd.SizeN();
-         elem.fRawInfo.sz[2] = rd.SizeI();
+         auto &ri = elem.fRawInfo;
+
+         ri.fmt = rd.GetCompactFlags(IsQuantizeMeshes());
+         ri.raw.resize(rd.GetCompactSize(ri.fmt));
+         rd.WriteCompact(reinterpret_cast<char *>(ri.raw.data()), ri.raw.size(), ri.fmt, ri.range);
+         ri.sz[0] = rd.SizeV();
+         ri.sz[1] = rd.SizeN();
+         ri.sz[2] = rd.SizeI();
+
+         // FNV-1a hash of the raw data to find identical meshes
+         std::size_t hash = 14695981039346656037ull;
+         for (auto b : ri.raw)
+            hash = (hash ^ b) * 1099511628211ull;
+
+         auto range = fRawMap.equal_range(hash);
+         for (auto iter = range.first; iter != range.second; ++iter) {
+            auto &other = fShapes[iter->second].fRawInfo;
+            if ((other.fmt == ri.fmt) && std::equal(ri.sz, ri.sz + 3, other.sz) &&
+                std::equal(ri.range, ri.range + 6, other.range) && (other.raw == ri.raw)) {
+               elem.fSameRaw = iter->second;
+               ri.raw.clear();
+               break;
+            }
+         }
 
+         if (elem.fSameRaw < 0)
+            fRawMap.emplace(hash, elem.id);
       }
    }
 
@@ -712,6 +737,18 @@ void ROOT::Experimental::REveGeomDescription::ResetRndrInfos()
 {
    for (auto &s: fShapes)
       s.reset();
+   fRawMap.clear();
+}
+
+/////////////////////////////////////////////////////////////////////
+/// Provide render info for visible item, shared with other shapes when meshes are identical
+
+ROOT::Experimental::RGeomRenderInfo *ROOT::Experimental::REveGeomDescription::GetRndrInfo(ShapeDescr &descr)
+{
+   if (descr.has_raw() && (descr.fSameRaw >= 0))
+      return &fShapes[descr.fSameRaw].fRawInfo;
+
+   return descr.rndr_info();
 }
 
 /////////////////////////////////////////////////////////////////////
@@ -798,7 +835,7 @@ bool ROOT::Experimental::REveGeomDescription::CollectVisibles()
 
          auto &sd = MakeShapeDescr(volume->GetShape());
 
-         item.ri = sd.rndr_info();
+         item.ri = GetRndrInfo(sd);
          if (sd.has_shape()) has_shape = true;
       }
       return true;
@@ -987,7 +1024,7 @@ int ROOT::Experimental::REveGeomDescription::SearchVisibles(const std::string &f
 
       auto &sd = MakeShapeDescr(volume->GetShape());
 
-      item.ri = sd.rndr_info();
+      item.ri = GetRndrInfo(sd);
       if (sd.has_shape()) has_shape = true;
       return true;
    });
@@ -1197,7 +1234,7 @@ bool ROOT::Experimental::REveGeomDescription::ProduceDrawingFor(int nodeid, std:
 
    // assign shape data
    for (auto &item : drawing.visibles) {
-      item.ri = sd.rndr_info();
+      item.ri = GetRndrInfo(sd);
       if (sd.has_shape()) has_shape = true;
       if (sd.has_raw()) has_raw = true;
    }
@@ -1299,7 +1336,7 @@ std::unique_ptr<ROOT::Experimental::REveGeomNodeInfo> ROOT::Experimental::REveGe
 
          auto &shape_descr = MakeShapeDescr(shape);
 
-         res->ri = shape_descr.rndr_info(); // temporary pointer, can be used preserved for short time
+         res->ri = GetRndrInfo(shape_descr); // temporary pointer, can be used preserved for short time
       }
    }
 
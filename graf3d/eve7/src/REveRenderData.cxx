@@ -12,6 +12,9 @@
 #include <ROOT/REveRenderData.hxx>
 #include <ROOT/REveUtil.hxx>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 
@@ -80,3 +83,121 @@ void REveRenderData::SetMatrix(const double *arr)
       fMatrix.push_back(arr[i]);
    }
 }
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// Return the ECompact_e flags which can be used to write this render data.
+/// Indices are shortened when all of them fit into 16 bits, which is lossless.
+/// Vertices and normals are only quantized on request.
+
+int REveRenderData::GetCompactFlags(bool quantize) const
+{
+   int flags = 0;
+
+   if (!fIndexBuffer.empty() &&
+       (*std::min_element(fIndexBuffer.begin(), fIndexBuffer.end()) >= 0) &&
+       (*std::max_element(fIndexBuffer.begin(), fIndexBuffer.end()) <= 0xffff))
+      flags |= kShortIndex;
+
+   if (quantize) {
+      if (fVertexBuffer.size() >= 3)
+         flags |= kQuantizedVertex;
+      if (!fNormalBuffer.empty())
+         flags |= kQuantizedNormal;
+   }
+
+   return flags;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// Size of the binary buffer produced by WriteCompact() with the given flags
+
+int REveRenderData::GetCompactSize(int flags) const
+{
+   auto align4 = [](int len) { return (len + 3) & ~3; };
+
+   int size = SizeT() * sizeof(float);
+   size += align4(SizeV() * ((flags & kQuantizedVertex) ? sizeof(std::uint16_t) : sizeof(float)));
+   size += align4(SizeN() * ((flags & kQuantizedNormal) ? sizeof(std::int8_t) : sizeof(float)));
+   size += SizeI() * ((flags & kShortIndex) ? sizeof(std::uint16_t) : sizeof(int));
+
+   return size;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// Write render data to binary buffer, in the same order as Write() but with the
+/// ECompact_e representations selected by flags. Each buffer starts at 4-byte boundary.
+/// For quantized vertices, range is filled with the minimal coordinates and the
+/// quantization steps along x, y and z: coordinate = range[i] + range[3+i] * value
+
+int REveRenderData::WriteCompact(char *msg, int maxlen, int flags, float *range) const
+{
+   static const REveException eh("REveRenderData::WriteCompact ");
+
+   if (GetCompactSize(flags) > maxlen)
+      throw eh + "output buffer does not have enough memory";
+
+   int off{0};
+
+   auto append = [&](const void *buf, int len) {
+      memcpy(msg + off, buf, len);
+      off += len;
+   };
+
+   auto align = [&]() {
+      while (off % 4)
+         msg[off++] = 0;
+   };
+
+   if (!fMatrix.empty())
+      append(&fMatrix[0], fMatrix.size() * sizeof(float));
+
+   if (!fVertexBuffer.empty()) {
+      if (flags & kQuantizedVertex) {
+         float vmin[3], vmax[3];
+         for (int i = 0; i < 3; ++i)
+            vmin[i] = vmax[i] = fVertexBuffer[i];
+         for (std::size_t n = 3; n + 2 < fVertexBuffer.size(); n += 3)
+            for (int i = 0; i < 3; ++i) {
+               vmin[i] = std::min(vmin[i], fVertexBuffer[n + i]);
+               vmax[i] = std::max(vmax[i], fVertexBuffer[n + i]);
+            }
+         for (int i = 0; i < 3; ++i) {
+            range[i] = vmin[i];
+            range[3 + i] = (vmax[i] > vmin[i]) ? (vmax[i] - vmin[i]) / 0xffff : 1.f;
+         }
+         for (std::size_t n = 0; n < fVertexBuffer.size(); ++n) {
+            int i = n % 3;
+            auto q = static_cast<std::uint16_t>(std::lround((fVertexBuffer[n] - range[i]) / range[3 + i]));
+            append(&q, sizeof(q));
+         }
+      } else {
+         append(&fVertexBuffer[0], fVertexBuffer.size() * sizeof(float));
+      }
+      align();
+   }
+
+   if (!fNormalBuffer.empty()) {
+      if (flags & kQuantizedNormal) {
+         for (auto n : fNormalBuffer) {
+            auto q = static_cast<std::int8_t>(std::lround(std::max(-1.f, std::min(1.f, n)) * 127));
+            append(&q, sizeof(q));
+         }
+      } else {
+         append(&fNormalBuffer[0], fNormalBuffer.size() * sizeof(float));
+      }
+      align();
+   }
+
+   if (!fIndexBuffer.empty()) {
+      if (flags & kShortIndex) {
+         for (auto i : fIndexBuffer) {
+            auto q = static_cast<std::uint16_t>(i);
+            append(&q, sizeof(q));
+         }
+      } else {
+         append(&fIndexBuffer[0], fIndexBuffer.size() * sizeof(int));
+      }
+   }
+
+   return off;
+}
@@ -94,6 +94,8 @@
 #pragma link C++ class TNDArrayT<ULong_t>+;
 #pragma link C++ class TNDArrayT<UInt_t>+;
 #pragma link C++ class TNDArrayT<UShort_t>+;
+#pragma link C++ class TNDArrayBlockT<Float_t>+;
+#pragma link C++ class TNDArrayBlockT<Double_t>+;
 #pragma link C++ class TNDArrayRef<Float_t>+;
 //#pragma link C++ class TNDArrayRef<Float16_t>+;
 #pragma link C++ class TNDArrayRef<Double_t>+;
@@ -137,6 +139,8 @@
 #pragma link C++ class THnT<ULong_t>+;
 #pragma link C++ class THnT<UInt_t>+;
 #pragma link C++ class THnT<UShort_t>+;
+#pragma link C++ class THnBlockT<Float_t>+;
+#pragma link C++ class THnBlockT<Double_t>+;
 #pragma link C++ class THnSparse+;
 #pragma link C++ class THnSparseT<TArrayD>+;
 #pragma link C++ class THnSparseT<TArrayF>+;
@@ -179,6 +183,8 @@
 #pragma link C++ typedef THnSparseS;
 #pragma link C++ typedef THnSparseC;
 
+#pragma link C++ typedef THnBlockD;
+#pragma link C++ typedef THnBlockF;
 #pragma link C++ typedef THnD;
 #pragma link C++ typedef THnF;
 #pragma link C++ typedef THnL;
@@ -197,6 +203,8 @@
 #pragma link C++ class THnSparseS;
 #pragma link C++ class THnSparseC;
 
+#pragma link C++ class THnBlockD;
+#pragma link C++ class THnBlockF;
 #pragma link C++ class THnD;
 #pragma link C++ class THnF;
 #pragma link C++ class THnL;
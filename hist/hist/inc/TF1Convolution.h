@@ -12,10 +12,12 @@
 #define ROOT_TF1Convolution__
 
 #include "TF1AbsComposition.h"
+#include <complex>
 #include <memory>
 #include <vector>
 #include "TF1.h"
 #include "TGraph.h"
+#include "TVirtualFFT.h"
 
 class TF1Convolution : public TF1AbsComposition {
    std::unique_ptr<TF1> fFunction1;    ///< First function to be convolved
@@ -35,11 +37,20 @@ class TF1Convolution : public TF1AbsComposition {
    Int_t    fNofPoints;                  ///< Number of point for FFT array
    Bool_t   fFlagFFT;                    ///< Choose FFT or numerical convolution
    Bool_t fFlagGraph = false;            ///<! Tells if the graph is already done or not
+   Bool_t fFlagFFT1 = false;             ///<! Tells if the transform of the first function is up to date
+   Bool_t fFlagFFT2 = false;             ///<! Tells if the transform of the second function is up to date
+   std::vector<std::complex<Double_t>> fFFT1; ///<! Transform of the first function
+   std::vector<std::complex<Double_t>> fFFT2; ///<! Transform of the second function
+   std::unique_ptr<TVirtualFFT> fFFTForward;  ///<! Forward transform of fNofPoints points
+   std::unique_ptr<TVirtualFFT> fFFTInverse;  ///<! Inverse transform of fNofPoints points
 
    Double_t EvalNumConv(Double_t t);
    Double_t EvalFFTConv(Double_t t);
+   Double_t EvalGraphConv(Double_t t) const;
    void     InitializeDataMembers(TF1* function1, TF1* function2, Bool_t useFFT);
+   void     InvalidateFFT();
    void     MakeFFTConv();
+   void     TransformFunction(TF1 &function, Double_t shift, std::vector<std::complex<Double_t>> &transform);
 
 public:
    TF1Convolution();
@@ -71,6 +82,7 @@ public:
    void Update();
 
    Double_t operator()(const Double_t *x, const Double_t *p);
+   void EvalBatch(Int_t n, const Double_t *x, Double_t *result, const Double_t *p = nullptr);
 
    void Copy(TObject &obj) const;
 
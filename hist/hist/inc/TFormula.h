@@ -127,7 +127,7 @@ private:
       return std::string(fClingName.Data()) + "_grad";
    }
    bool HasGradientGenerationFailed() const {
-      return !fGradMethod && !fGradGenerationInput.empty();
+      return !fGradFuncPtr && !fGradGenerationInput.empty();
    }
 
 protected:
@@ -187,6 +187,8 @@ public:
    void           AddVariable(const TString &name, Double_t value = 0);
    void           AddVariables(const TString *vars, const Int_t size);
    Int_t          Compile(const char *expression="");
+   static Bool_t  DeferCompilation(Bool_t on = kTRUE);
+   static Bool_t  CompileDeferred();
    virtual void   Copy(TObject &f1) const;
    virtual void   Clear(Option_t * option="");
    Double_t       Eval(Double_t x) const;
@@ -199,6 +201,9 @@ public:
    /// \returns true if a gradient was generated and GradientPar can be called.
    bool GenerateGradientPar();
 
+   /// \returns true if the gradient with respect to the parameters has been generated (see GenerateGradientPar).
+   bool HasGeneratedGradient() const { return fGradFuncPtr != nullptr; }
+
    /// Compute the gradient employing automatic differentiation.
    ///
    /// \param[in] x - The given variables, if nullptr the already stored
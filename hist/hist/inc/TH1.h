@@ -53,6 +53,10 @@ class TCollection;
 class TVirtualFFT;
 class TVirtualHistPainter;
 
+namespace ROOT {
+class TH1ConcurrentFillManager;
+}
+
 
 class TH1 : public TNamed, public TAttLine, public TAttFill, public TAttMarker {
 
@@ -82,6 +86,7 @@ public:
    };
 
    friend class TH1Merger;
+   friend class ROOT::TH1ConcurrentFillManager;
 
 protected:
     Int_t         fNcells;          ///< number of bins(1D), cells (2D) +U/Overflows
@@ -113,6 +118,7 @@ protected:
     static Int_t  fgBufferSize;     ///<!default buffer size for automatic histograms
     static Bool_t fgAddDirectory;   ///<!flag to add histograms to the directory
     static Bool_t fgStatOverflows;  ///<!flag to use under/overflows in statistics
+    static constexpr Int_t kFillNBatchSize = 256; ///<!number of entries whose bins are found together by FillN
     static Bool_t fgDefaultSumw2;   ///<!flag to call TH1::Sumw2 automatically at histogram creation time
 
 public:
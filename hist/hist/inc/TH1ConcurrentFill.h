@@ -0,0 +1,117 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TH1ConcurrentFill
+#define ROOT_TH1ConcurrentFill
+
+#include "TH1.h"
+
+#include <mutex>
+#include <vector>
+
+namespace ROOT {
+
+class TH1ConcurrentFiller;
+
+/**
+\class ROOT::TH1ConcurrentFillManager
+\ingroup Hist
+\brief Allows several threads to fill the same TH1, TH2 or TH3 without a lock and without a copy of the
+histogram per thread.
+
+Each thread fills through its own TH1ConcurrentFiller, obtained with MakeFiller(). Two modes are available:
+ - kAtomic: the bin contents (and sums of squares of weights) are updated in place with atomic operations. No
+   memory is needed besides the histogram. Requires Double_t or Float_t bin contents (e.g. TH1D, TH2F, TH3D).
+ - kSharded: each filler accumulates the bin contents in its own partial arrays, added to the histogram when
+   it is flushed. Fillers never contend on a bin, at the cost of one array of bins per filler.
+
+In both modes the statistics (sums of weights, of weight*x, ..., and the number of entries) are accumulated per
+filler and added to the histogram, under a lock, when the filler is flushed or destroyed. Once all fillers are
+flushed, the histogram is identical to one filled sequentially.
+
+The histogram must not be read, filled or modified otherwise while fillers are in use. The axes cannot be
+extended while filling: this is disabled for the lifetime of the manager. A fill buffer is emptied and removed.
+~~~{.cpp}
+TH2D h("h", "h", 1000, 0., 1., 1000, 0., 1.);
+ROOT::TH1ConcurrentFillManager manager(h);
+ROOT::TThreadExecutor pool;
+pool.Foreach([&](unsigned int i) {
+   auto filler = manager.MakeFiller();
+   for (auto &p : GetPoints(i))
+      filler.Fill(p.x, p.y);
+}, ROOT::TSeqU(nTasks));
+~~~
+*/
+class TH1ConcurrentFillManager {
+public:
+   enum class EMode { kAtomic, kSharded };
+
+private:
+   friend class TH1ConcurrentFiller;
+
+   TH1 &fHist;
+   EMode fMode;
+   Int_t fDimension;
+   UInt_t fCanExtend;                  ///< The axes that could be extended before the manager was created
+   Bool_t fStatOverflows;              ///< Whether the under/overflows enter the statistics
+   Double_t *fContentD = nullptr;      ///< The bin contents in atomic mode, if stored as Double_t
+   Float_t *fContentF = nullptr;       ///< The bin contents in atomic mode, if stored as Float_t
+   Double_t *fSumw2 = nullptr;         ///< The sums of squares of weights, if stored
+   std::mutex fMutex;                  ///< Protects the merging of the fillers into the histogram
+
+   void Merge(TH1ConcurrentFiller &filler);
+
+public:
+   TH1ConcurrentFillManager(TH1 &hist, EMode mode = EMode::kAtomic);
+   TH1ConcurrentFillManager(const TH1ConcurrentFillManager &) = delete;
+   TH1ConcurrentFillManager &operator=(const TH1ConcurrentFillManager &) = delete;
+   ~TH1ConcurrentFillManager();
+
+   TH1ConcurrentFiller MakeFiller();
+   EMode GetMode() const { return fMode; }
+   TH1 &GetHist() const { return fHist; }
+};
+
+/**
+\class ROOT::TH1ConcurrentFiller
+\ingroup Hist
+\brief Fills the histogram of a TH1ConcurrentFillManager from one thread.
+
+The arguments of Fill() are interpreted as for TH1::Fill(), TH2::Fill() or TH3::Fill(), according to the
+dimension of the histogram. A filler must only be used by one thread at a time. It is flushed when destroyed.
+*/
+class TH1ConcurrentFiller {
+   friend class TH1ConcurrentFillManager;
+
+   TH1ConcurrentFillManager *fManager;
+   std::vector<Double_t> fContents; ///< Partial bin contents, in sharded mode
+   std::vector<Double_t> fSumw2;    ///< Partial sums of squares of weights, in sharded mode
+   Double_t fStats[TH1::kNstat];    ///< Partial statistics, laid out as in TH1::GetStats()
+   Double_t fEntries = 0.;          ///< Partial number of entries
+
+   explicit TH1ConcurrentFiller(TH1ConcurrentFillManager &manager);
+   Int_t DoFill(Double_t x, Double_t y, Double_t z, Double_t w);
+
+public:
+   TH1ConcurrentFiller(TH1ConcurrentFiller &&other);
+   TH1ConcurrentFiller(const TH1ConcurrentFiller &) = delete;
+   TH1ConcurrentFiller &operator=(const TH1ConcurrentFiller &) = delete;
+   ~TH1ConcurrentFiller() { Flush(); }
+
+   Int_t Fill(Double_t x);
+   Int_t Fill(Double_t x, Double_t yw);
+   Int_t Fill(Double_t x, Double_t y, Double_t zw);
+   Int_t Fill(Double_t x, Double_t y, Double_t z, Double_t w);
+   void Flush();
+};
+
+} // namespace ROOT
+
+#endif
@@ -86,7 +86,7 @@ public:
       // return the bin index.
       GetArray().AddAt(bin, w);
       if (GetCalculateErrors()) {
-         fSumw2.AddAt(bin, w * w);
+         GetSumw2Array().AddAt(bin, w * w);
       }
       FillBinBase(w);
    }
@@ -101,7 +101,7 @@ public:
    }
    void SetBinError2(Long64_t bin, Double_t e2) {
       if (!GetCalculateErrors()) Sumw2();
-      fSumw2.At(bin) = e2;
+      GetSumw2Array().SetAsDouble(bin, e2);
    }
    void AddBinContent(const Int_t* idx, Double_t v = 1.) {
       // Forwards to THnBase::SetBinContent().
@@ -112,7 +112,7 @@ public:
       GetArray().AddAt(bin, v);
    }
    void AddBinError2(Long64_t bin, Double_t e2) {
-      fSumw2.At(bin) += e2;
+      GetSumw2Array().AddAt(bin, e2);
    }
    Double_t GetBinContent(const Int_t *idx) const {
       // Forwards to THnBase::GetBinContent() overload.
@@ -133,11 +133,13 @@ public:
       return GetArray().AtAsDouble(bin);
    }
    Double_t GetBinError2(Long64_t linidx) const {
-      return GetCalculateErrors() ? fSumw2.At(linidx) : GetBinContent(linidx);
+      return GetCalculateErrors() ? GetSumw2Array().AtAsDouble(linidx) : GetBinContent(linidx);
    }
 
    virtual const TNDArray& GetArray() const = 0;
    virtual TNDArray& GetArray() = 0;
+   virtual const TNDArray& GetSumw2Array() const { return fSumw2; }
+   virtual TNDArray& GetSumw2Array() { return fSumw2; }
 
    void Sumw2();
 
@@ -237,6 +239,74 @@ protected:
    ClassDef(THnT, 1); // multi-dimensional histogram with templated storage
 };
 
+//______________________________________________________________________________
+/** \class THnBlockT
+ Implementation of THn with block-sparse storage, for histograms with many
+ bins of which only a fraction is ever filled, e.g. 1000x1000x1000 bins.
+
+ The bin contents and, if errors are calculated, the sums of squared weights
+ are stored in TNDArrayBlockT: blocks of consecutive bins (512 by default) are
+ allocated when one of their bins is first filled. Until then a block costs
+ the size of an empty std::vector. The sums of squared weights are always
+ stored as Double_t, also for THnBlockF.
+
+ Typedefs exist for the floating point types:
+
+ Templated name        |     Typedef   |    Bin content type
+ ----------------------|---------------|--------------------
+   THnBlockT<Float_t>  |   THnBlockF   |     Float_t
+   THnBlockT<Double_t> |   THnBlockD   |     Double_t
+
+ All functionality and the interfaces to be used are in THn. The memory used
+ grows with the number of blocks that contain filled bins; operations looping
+ over all bins (e.g. Scale()) do not allocate blocks whose contents stay 0.
+*/
+
+template <typename T>
+class THnBlockT: public THn {
+public:
+   THnBlockT() {}
+   THnBlockT(const char* name, const char* title,
+             Int_t dim, const Int_t* nbins,
+             const Double_t* xmin, const Double_t* xmax,
+             Int_t blockSize = TNDArrayBlockT<T>::kDefaultBlockSize):
+   THn(name, title, dim, nbins, xmin, xmax),
+   fArray(dim, nbins, true, blockSize),
+   fSumw2Blocks(dim, nbins, true, blockSize) {}
+   const TNDArray& GetArray() const { return fArray; }
+   TNDArray& GetArray() { return fArray; }
+   const TNDArray& GetSumw2Array() const { return fSumw2Blocks; }
+   TNDArray& GetSumw2Array() { return fSumw2Blocks; }
+
+   /// Number of blocks of bin contents that are allocated.
+   Long64_t GetNblocksAllocated() const { return fArray.GetNblocksAllocated(); }
+
+   /// Enable calculation of errors, initializing them from the allocated
+   /// blocks of bin contents only.
+   void Sumw2() {
+      if (!GetCalculateErrors()) {
+         fTsumw2 = 0.;
+      }
+      fSumw2Blocks.Reset();
+      const Long64_t nbins = GetNbins();
+      const Int_t blockSize = fArray.GetBlockSize();
+      for (Long64_t first = 0; first < nbins; first += blockSize) {
+         if (!fArray.IsBlockAllocated(first)) continue;
+         const Long64_t last = (first + blockSize < nbins) ? first + blockSize : nbins;
+         for (Long64_t ibin = first; ibin < last; ++ibin)
+            fSumw2Blocks.SetAsDouble(ibin, fArray.At(ibin));
+      }
+   }
+
+protected:
+   TNDArrayBlockT<T> fArray; // bin content
+   TNDArrayBlockT<Double_t> fSumw2Blocks; // bin error
+   ClassDef(THnBlockT, 1); // multi-dimensional histogram with block-sparse storage
+};
+
+typedef THnBlockT<Float_t>  THnBlockF;
+typedef THnBlockT<Double_t> THnBlockD;
+
 typedef THnT<Float_t>  THnF;
 typedef THnT<Double_t> THnD;
 typedef THnT<Char_t>   THnC;
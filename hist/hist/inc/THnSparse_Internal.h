@@ -23,6 +23,8 @@
 
 #include "TObject.h"
 
+#include <vector>
+
 class TBrowser;
 class TH1;
 class THnSparse;
@@ -65,5 +67,89 @@ class THnSparseArrayChunk: public TObject {
 
    ClassDef(THnSparseArrayChunk, 1); // chunks of linearized bins
 };
+
+////////////////////////////////////////////////////////////////////////////////
+/// Maps the hashes of the compact bin coordinates of a THnSparse to its bin
+/// indices. It is a flat hash table with open addressing and linear probing,
+/// with a power of two number of slots, each holding a hash and an index.
+/// Several bins can have the same hash: Find() checks each candidate with the
+/// given predicate, which compares the coordinates of the bins.
+
+class THnSparseBinIndexMap {
+ private:
+   struct Slot_t {
+      ULong64_t fHash;
+      Long64_t  fIndex; // -1 for an empty slot
+   };
+
+   std::vector<Slot_t> fSlots;
+   Long64_t fSize = 0;   // number of bins stored
+   Int_t    fShift = 64; // 64 - log2(number of slots)
+
+   /// Fibonacci hashing: spreads the linearized coordinates used as "perfect"
+   /// hashes by THnSparse over the whole table.
+   ULong64_t FirstSlot(ULong64_t hash) const { return (hash * 0x9E3779B97F4A7C15ull) >> fShift; }
+
+   void Insert(ULong64_t hash, Long64_t index) {
+      const ULong64_t mask = fSlots.size() - 1;
+      ULong64_t slot = FirstSlot(hash);
+      while (fSlots[slot].fIndex >= 0)
+         slot = (slot + 1) & mask;
+      fSlots[slot].fHash = hash;
+      fSlots[slot].fIndex = index;
+   }
+
+   /// Rehash into a table of 2^log2Slots slots.
+   void Rehash(Int_t log2Slots) {
+      std::vector<Slot_t> old;
+      old.swap(fSlots);
+      fSlots.assign(1ull << log2Slots, Slot_t{0, -1});
+      fShift = 64 - log2Slots;
+      for (auto &s : old)
+         if (s.fIndex >= 0)
+            Insert(s.fHash, s.fIndex);
+   }
+
+ public:
+   Long64_t GetSize() const { return fSize; }
+   Long64_t Capacity() const { return fSlots.size(); }
+   Long64_t GetMemorySize() const { return fSlots.size() * sizeof(Slot_t); }
+
+   void Clear() {
+      std::vector<Slot_t>().swap(fSlots);
+      fSize = 0;
+      fShift = 64;
+   }
+
+   /// Make room for nbins bins without rehashing, with a load factor of at most 0.7.
+   void Reserve(Long64_t nbins) {
+      Int_t log2Slots = 4;
+      while ((1ll << log2Slots) * 7 < nbins * 10)
+         ++log2Slots;
+      if ((1ull << log2Slots) > fSlots.size())
+         Rehash(log2Slots);
+   }
+
+   void Add(ULong64_t hash, Long64_t index) {
+      if ((fSize + 1) * 10 > Capacity() * 7)
+         Rehash(fSlots.empty() ? 4 : 65 - fShift);
+      Insert(hash, index);
+      ++fSize;
+   }
+
+   /// Return the index of the bin with the given hash for which match(index)
+   /// is true, or -1 if there is none.
+   template <class MATCH>
+   Long64_t Find(ULong64_t hash, MATCH match) const {
+      if (fSlots.empty())
+         return -1;
+      const ULong64_t mask = fSlots.size() - 1;
+      for (ULong64_t slot = FirstSlot(hash); fSlots[slot].fIndex >= 0; slot = (slot + 1) & mask)
+         if (fSlots[slot].fHash == hash && match(fSlots[slot].fIndex))
+            return fSlots[slot].fIndex;
+      return -1;
+   }
+};
+
 #endif // ROOT_THnSparse_Internal
 
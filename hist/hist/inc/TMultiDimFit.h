@@ -128,6 +128,7 @@ public:
    virtual ~TMultiDimFit();
 
    virtual void     AddRow(const Double_t *x, Double_t D, Double_t E=0);
+   virtual void     AddRows(const Double_t *x, const Double_t *D, const Double_t *E, Int_t nRows);
    virtual void     AddTestRow(const Double_t *x, Double_t D, Double_t E=0);
    virtual void     Browse(TBrowser* b);
    virtual void     Clear(Option_t *option=""); // *MENU*
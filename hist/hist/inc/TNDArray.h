@@ -15,6 +15,8 @@
 #include "TObject.h"
 #include "TError.h"
 
+#include <vector>
+
 //////////////////////////////////////////////////////////////////////////
 //                                                                      //
 // TNDArray                                                             //
@@ -190,6 +192,96 @@ protected:
    ClassDef(TNDArrayT, 1); // N-dimensional array
 };
 
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TNDArrayBlockT                                                       //
+//                                                                      //
+// N-Dim array class with block-sparse storage.                         //
+//                                                                      //
+// The linear bin range is split into blocks of fBlockSize consecutive  //
+// bins (by default 512, i.e. 8*8*8), each allocated when data is first //
+// written into it. Blocks that are never written cost one empty        //
+// vector. Writing 0 into a block that is not allocated does not        //
+// allocate it. AddAt() adds in double precision and converts the sum   //
+// to T, with a single rounding.                                        //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+class TNDArrayBlockT: public TNDArray {
+public:
+   enum { kDefaultBlockSize = 512 };
+
+   TNDArrayBlockT(): fBlockSize(kDefaultBlockSize) {}
+   TNDArrayBlockT(Int_t ndim, const Int_t* nbins, bool addOverflow = false,
+                  Int_t blockSize = kDefaultBlockSize):
+   TNDArray(ndim, nbins, addOverflow), fBlockSize(blockSize) {
+      fBlocks.resize((fSizes[0] + fBlockSize - 1) / fBlockSize);
+   }
+
+   void Init(Int_t ndim, const Int_t* nbins, bool addOverflow = false) {
+      TNDArray::Init(ndim, nbins, addOverflow);
+      fBlocks.clear();
+      fBlocks.resize((fSizes[0] + fBlockSize - 1) / fBlockSize);
+   }
+
+   void Reset(Option_t* /*option*/ = "") {
+      // Reset the content, releasing all blocks
+      for (auto &block: fBlocks)
+         std::vector<T>().swap(block);
+   }
+
+   Int_t GetBlockSize() const { return fBlockSize; }
+   Long64_t GetNblocks() const { return fBlocks.size(); }
+   Long64_t GetNblocksAllocated() const {
+      Long64_t n = 0;
+      for (const auto &block: fBlocks)
+         n += !block.empty();
+      return n;
+   }
+   Bool_t IsBlockAllocated(ULong64_t linidx) const {
+      return !fBlocks[linidx / fBlockSize].empty();
+   }
+
+   T At(const Int_t* idx) const {
+      return At(GetBin(idx));
+   }
+   T& At(const Int_t* idx) {
+      return At(GetBin(idx));
+   }
+   T At(ULong64_t linidx) const {
+      const std::vector<T> &block = fBlocks[linidx / fBlockSize];
+      if (block.empty()) return T();
+      return block[linidx % fBlockSize];
+   }
+   T& At(ULong64_t linidx) {
+      return Block(linidx)[linidx % fBlockSize];
+   }
+   Double_t AtAsDouble(ULong64_t linidx) const {
+      return At(linidx);
+   }
+   void SetAsDouble(ULong64_t linidx, Double_t value) {
+      if (value == 0. && !IsBlockAllocated(linidx)) return;
+      At(linidx) = (T) value;
+   }
+   void AddAt(ULong64_t linidx, Double_t value) {
+      if (value == 0.) return;
+      T& v = At(linidx);
+      v = (T) (v + value);
+   }
+private:
+   std::vector<T>& Block(ULong64_t linidx) {
+      std::vector<T> &block = fBlocks[linidx / fBlockSize];
+      if (block.empty()) block.resize(fBlockSize);
+      return block;
+   }
+
+protected:
+   Int_t fBlockSize; // number of bins per block
+   std::vector<std::vector<T> > fBlocks; // blocks of data, empty until written
+   ClassDef(TNDArrayBlockT, 1); // N-dimensional array with block-sparse storage
+};
+
 // FIXME: Remove once we implement https://sft.its.cern.ch/jira/browse/ROOT-6284
 // When building with -fmodules, it instantiates all pending instantiations,
 // instead of delaying them until the end of the translation unit.
@@ -45,6 +45,7 @@ protected:
    TPrincipal(const TPrincipal&);
    TPrincipal& operator=(const TPrincipal&);
 
+   void        AddMoments(Long64_t n, const Double_t *mean, const Double_t *m2);
    void        MakeNormalised();
    void        MakeRealCode(const char *filename, const char *prefix, Option_t *option="");
 
@@ -54,6 +55,7 @@ public:
    TPrincipal(Int_t nVariables, Option_t *opt="ND");
 
    virtual void       AddRow(const Double_t *x);
+   virtual void       AddRows(const Double_t *x, Int_t nRows);
    virtual void       Browse(TBrowser *b);
    virtual void       Clear(Option_t *option="");
    const TMatrixD    *GetCovarianceMatrix() const {return &fCovarianceMatrix;}
@@ -69,6 +71,7 @@ public:
    virtual void       MakeHistograms(const char *name = "pca", Option_t *option="epsdx"); // *MENU*
    virtual void       MakeMethods(const char *classname = "PCA", Option_t *option=""); // *MENU*
    virtual void       MakePrincipals();            // *MENU*
+   Long64_t           Merge(TCollection *list);
    virtual void       P2X(const Double_t *p, Double_t *x, Int_t nTest);
    virtual void       Print(Option_t *opt="MSE") const;         // *MENU*
    virtual void       SumOfSquareResiduals(const Double_t *x, Double_t *s);
@@ -66,6 +66,7 @@ public:
    virtual Double_t GetXmax()  const {return fXmax;}
    virtual void     Paint(Option_t *option="");
    virtual Double_t Eval(Double_t x) const=0;
+   virtual void     EvalBatch(Int_t n, const Double_t *x, Double_t *result) const;
    virtual void     SaveAs(const char * /*filename*/,Option_t * /*option*/) const {;}
    void             SetNpx(Int_t n) {fNpx=n;}
 
@@ -234,7 +235,9 @@ public:
    TSpline3(const TSpline3&);
    TSpline3& operator=(const TSpline3&);
    Int_t    FindX(Double_t x) const;
+   Int_t    FindX(Double_t x, Int_t hint) const;
    Double_t Eval(Double_t x) const;
+   void     EvalBatch(Int_t n, const Double_t *x, Double_t *result) const;
    Double_t Derivative(Double_t x) const;
    virtual ~TSpline3() {if (fPoly) delete [] fPoly;}
    void GetCoeff(Int_t i, Double_t &x, Double_t &y, Double_t &b,
@@ -295,7 +298,9 @@ public:
    TSpline5(const TSpline5&);
    TSpline5& operator=(const TSpline5&);
    Int_t    FindX(Double_t x) const;
+   Int_t    FindX(Double_t x, Int_t hint) const;
    Double_t Eval(Double_t x) const;
+   void     EvalBatch(Int_t n, const Double_t *x, Double_t *result) const;
    Double_t Derivative(Double_t x) const;
    virtual ~TSpline5() {if (fPoly) delete [] fPoly;}
    void GetCoeff(Int_t i, Double_t &x, Double_t &y, Double_t &b,
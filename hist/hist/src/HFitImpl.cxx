@@ -62,6 +62,8 @@ namespace HFit {
 
    void CheckGraphFitOptions(Foption_t &fitOption);
 
+   void GenerateGradient(TF1 *f1);
+
 
    void GetDrawingRange(TH1 * h1, ROOT::Fit::DataRange & range);
    void GetDrawingRange(TGraph * gr, ROOT::Fit::DataRange & range);
@@ -232,6 +234,8 @@ TFitResultPtr HFit::Fit(FitObject * h1, TF1 *f1 , Foption_t & fitOption , const
 
    // set the fit function
    // if option grad is specified use gradient
+   if (fitOption.Gradient)
+      GenerateGradient(f1);
    if ( (linear || fitOption.Gradient) )
       fitter->SetFunction(ROOT::Math::WrappedMultiTF1(*f1));
 #ifdef R__HAS_VECCORE
@@ -811,6 +815,19 @@ void HFit::CheckGraphFitOptions(Foption_t & foption) {
    return;
 }
 
+void HFit::GenerateGradient(TF1 *f1) {
+   // with option "G", generate the gradient of a function defined by a formula with respect to the parameters
+   // using automatic differentiation (clad), so that TF1::GradientPar computes it exactly instead of with
+   // 4 evaluations of the function per parameter. If it cannot be generated, the numerical gradient is used.
+#ifdef R__HAS_CLAD
+   TFormula *formula = f1->GetFormula();
+   if (formula && !formula->IsVectorized() && !formula->HasGeneratedGradient())
+      formula->GenerateGradientPar();
+#else
+   (void)f1;
+#endif
+}
+
 // implementation of unbin fit function (defined in HFitInterface)
 
 TFitResultPtr ROOT::Fit::UnBinFit(ROOT::Fit::UnBinData * data, TF1 * fitfunc, Foption_t & fitOption , const ROOT::Math::MinimizerOptions & minOption) {
@@ -844,6 +861,7 @@ TFitResultPtr ROOT::Fit::UnBinFit(ROOT::Fit::UnBinData * data, TF1 * fitfunc, Fo
    // need to create a wrapper for an automatic  normalized TF1 ???
    if ( fitOption.Gradient ) {
       assert ( (int) dim == fitfunc->GetNdim() );
+      HFit::GenerateGradient(fitfunc);
       fitter->SetFunction(ROOT::Math::WrappedMultiTF1(*fitfunc) );
    }
    else
@@ -434,6 +434,34 @@ Int_t TAxis::FindFixBin(Double_t x) const
    return bin;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Find the bin numbers of the n abscissas x[0], x[stride], ..., x[(n-1)*stride]
+/// and store them in bins[0], ..., bins[n-1].
+///
+/// Identical to calling TAxis::FindFixBin for each abscissa. For fixed bin
+/// sizes the loop has no branch and is vectorized by the compiler.
+
+void TAxis::FindFixBins(Int_t n, const Double_t *x, Int_t *bins, Int_t stride) const
+{
+   if (fXbins.fN) {
+      for (Int_t i = 0; i < n; ++i)
+         bins[i] = FindFixBin(x[i * stride]);
+      return;
+   }
+   const Double_t xmin = fXmin;
+   const Double_t xmax = fXmax;
+   const Int_t nbins = fNbins;
+   for (Int_t i = 0; i < n; ++i) {
+      const Double_t xi = x[i * stride];
+      const Bool_t underflow = xi < xmin;
+      const Bool_t overflow = !(xi < xmax) && !underflow; // also catches NaN
+      // compute the bin of an in-range abscissa, so that the conversion to int is always defined
+      const Double_t xin = (underflow || overflow) ? xmin : xi;
+      const Int_t bin = 1 + int(nbins * (xin - xmin) / (xmax - xmin));
+      bins[i] = underflow ? 0 : (overflow ? nbins + 1 : bin);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return label for bin
 
@@ -9,6 +9,7 @@
  * For the list of contributors see $ROOTSYS/README/CREDITS.             *
  *************************************************************************/
 
+#include <algorithm>
 #include <iostream>
 #include "strlcpy.h"
 #include "snprintf.h"
@@ -790,7 +791,7 @@ TF1::TF1(const char *name, ROOT::Math::ParamFunctor f, Double_t xmin, Double_t x
 void TF1::DoInitialize(EAddToList addToGlobalList)
 {
    // add to global list of functions if default adding is on OR if bit is set
-   bool doAdd = ((addToGlobalList == EAddToList::kDefault && fgAddToGlobList)
+   bool doAdd = ((addToGlobalList == EAddToList::kDefault && fgAddToGlobList && !ROOT::IsLightweightObjectsMode())
                  || addToGlobalList == EAddToList::kAdd);
    if (doAdd && gROOT) {
       SetBit(kNotGlobal, kFALSE);
@@ -945,7 +946,7 @@ TF1::~TF1()
    if (fMethodCall) delete fMethodCall;
 
    // this was before in TFormula destructor
-   {
+   if (!TestBit(kNotGlobal) || !ROOT::IsLightweightObjectsMode()) {
       R__LOCKGUARD(gROOTMutex);
       if (gROOT) gROOT->GetListOfFunctions()->Remove(this);
    }
@@ -1539,6 +1540,54 @@ Double_t TF1::EvalPar(const Double_t *x, const Double_t *params)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the function at n points, for the same parameters, and store the
+/// values in out.
+///
+/// The coordinates are given dimension by dimension: x[j*n + i] is the
+/// coordinate j of point i, i.e. x holds the n values of the first coordinate,
+/// followed by the n values of the second one, and so on. For a 1-D function
+/// x is simply the array of the n points.
+/// If params is omitted or equal 0, the internal values of the parameters are
+/// used, as in EvalPar().
+///
+/// Vectorized functions (see IsVectorized()) are evaluated on as many points at
+/// once as fit in a ROOT::Double_v; the others are evaluated point by point.
+
+void TF1::EvalBatch(const Double_t *x, Double_t *out, std::size_t n, const Double_t *params)
+{
+   const Int_t ndim = fNdim > 0 ? fNdim : 1;
+   std::size_t i = 0;
+
+#ifdef R__HAS_VECCORE
+   if (IsVectorized()) {
+      constexpr std::size_t vecSize = vecCore::VectorSize<ROOT::Double_v>();
+      std::vector<ROOT::Double_v> xv(ndim);
+      const Bool_t normalize = fNormalized && fNormIntegral != 0;
+      for (; i + vecSize <= n; i += vecSize) {
+         for (Int_t j = 0; j < ndim; ++j)
+            vecCore::Load<ROOT::Double_v>(xv[j], x + j * n + i);
+         ROOT::Double_v result = EvalPar(xv.data(), params);
+         if (normalize)
+            result = result / fNormIntegral;
+         vecCore::Store<ROOT::Double_v>(result, out + i);
+      }
+   }
+#endif
+
+   // the remaining points, one by one
+   if (i == n)
+      return;
+   std::vector<Double_t> point(ndim);
+   if (fType == EFType::kInterpreted)
+      InitArgs(point.data(), params ? params : GetParameters());
+   for (; i < n; ++i) {
+      for (Int_t j = 0; j < ndim; ++j)
+         point[j] = x[j * n + i];
+      out[i] = EvalPar(point.data(), params);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action corresponding to one event.
 ///
@@ -2462,10 +2511,26 @@ Double_t TF1::GradientPar(Int_t ipar, const Double_t *x, Double_t eps)
 /// default value of eps = 0.01
 /// Method is the same as in Derivative() function
 ///
+/// If the function is defined by a formula whose gradient has been generated with
+/// automatic differentiation (see TFormula::GenerateGradientPar()), the exact gradient is
+/// computed instead, and eps is not used. This is the case when fitting with the option "G".
+///
 /// If a parameter is fixed, the gradient on this parameter = 0
 
 void TF1::GradientPar(const Double_t *x, Double_t *grad, Double_t eps)
 {
+   if (fFormula && fFormula->HasGeneratedGradient()) {
+      // the generated function adds the derivatives to the result
+      std::fill(grad, grad + fNpar, 0.);
+      fFormula->GradientPar(x, grad);
+      for (Int_t ipar = 0; ipar < fNpar; ipar++) {
+         Double_t al, bl;
+         GetParLimits(ipar, al, bl);
+         if (al * bl != 0 && al >= bl)
+            grad[ipar] = 0;
+      }
+      return;
+   }
    GradientParTempl<Double_t>(x, grad, eps);
 }
 
@@ -3044,7 +3109,6 @@ void TF1::Paint(Option_t *choptin)
 TH1   *TF1::DoCreateHistogram(Double_t xmin, Double_t  xmax, Bool_t recreate)
 {
    Int_t i;
-   Double_t xv[1];
 
    TH1 *histogram = 0;
 
@@ -3113,11 +3177,10 @@ TH1   *TF1::DoCreateHistogram(Double_t xmin, Double_t  xmax, Bool_t recreate)
    histogram->GetYaxis()->SetTitle(ytitle.Data());
    Double_t *parameters = GetParameters();
 
-   InitArgs(xv, parameters);
-   for (i = 1; i <= fNpx; i++) {
-      xv[0] = histogram->GetBinCenter(i);
-      histogram->SetBinContent(i, EvalPar(xv, parameters));
-   }
+   std::vector<Double_t> centers(fNpx), values(fNpx);
+   for (i = 1; i <= fNpx; i++) centers[i - 1] = histogram->GetBinCenter(i);
+   EvalBatch(centers.data(), values.data(), fNpx, parameters);
+   for (i = 1; i <= fNpx; i++) histogram->SetBinContent(i, values[i - 1]);
 
    // Copy Function attributes to histogram attributes.
    histogram->SetBit(TH1::kNoStats);
@@ -36,6 +36,11 @@ approximately zero at the end of the range. If they are significantly different
 a spill over will occur on the other side (e.g right side).
 If no function range is given by default the function1 range + 10% is used
 One should use also a not too small number of points for the DFT (a minimum of 1000).  By default 10000 points are used.
+
+The transforms of the two functions are cached separately: when only the parameters of one function change, as in a
+fit where the parameters of the resolution model are fixed, only the transform of that function is recomputed. The
+result of the convolution is interpolated on the grid of the transform, which is also used by EvalBatch() to evaluate
+many points at once.
 */
 
 ClassImp(TF1Convolution);
@@ -246,54 +251,76 @@ TF1Convolution &TF1Convolution::operator=(const TF1Convolution &rhs)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Perform the FFT of the two functions
+/// Mark the transforms of both functions and the convolution graph as out of date
+
+void TF1Convolution::InvalidateFFT()
+{
+   fFlagGraph = false;
+   fFlagFFT1 = false;
+   fFlagFFT2 = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sample a function, shifted by `shift`, on the grid of the convolution and
+/// store its transform
+
+void TF1Convolution::TransformFunction(TF1 &function, Double_t shift, std::vector<std::complex<Double_t>> &transform)
+{
+   for (int i=0; i<fNofPoints; i++)
+   {
+      Double_t x = fXmin + (fXmax-fXmin)/(fNofPoints-1)*i - shift;
+      fFFTForward -> SetPoint(i, function.EvalPar(&x, nullptr));
+   }
+   fFFTForward -> Transform();
+
+   transform.resize(fNofPoints/2 + 1);
+   Double_t re, im;
+   for (int i=0; i<=fNofPoints/2; i++)
+   {
+      fFFTForward -> GetPointComplex(i, re, im);
+      transform[i] = std::complex<Double_t>(re, im);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Perform the FFT of the two functions.
+/// The transform of a function is only recomputed if its parameters, the range or
+/// the number of points have changed since it was last computed.
 
 void TF1Convolution::MakeFFTConv()
 {
    if (gDebug)
       Info("MakeFFTConv","Making FFT convolution using %d points in range [%g,%g]",fNofPoints,fXmin,fXmax);
 
-   std::vector < Double_t > x  (fNofPoints);
-   std::vector < Double_t > in1(fNofPoints);
-   std::vector < Double_t > in2(fNofPoints);
-
-   TVirtualFFT *fft1 = TVirtualFFT::FFT(1, &fNofPoints, "R2C K");
-   TVirtualFFT *fft2 = TVirtualFFT::FFT(1, &fNofPoints, "R2C K");
-   if (fft1 == nullptr || fft2 == nullptr) {
+   if (!fFFTForward || !fFFTInverse) {
+      fFFTForward = std::unique_ptr<TVirtualFFT>(TVirtualFFT::FFT(1, &fNofPoints, "R2C K"));
+      fFFTInverse = std::unique_ptr<TVirtualFFT>(TVirtualFFT::FFT(1, &fNofPoints, "C2R K"));
+      fFlagFFT1 = false;
+      fFlagFFT2 = false;
+   }
+   if (fFFTForward == nullptr || fFFTInverse == nullptr) {
       Warning("MakeFFTConv","Cannot use FFT, probably FFTW package is not available. Switch to numerical convolution");
       fFlagFFT = false;
       return;
    }
 
+   if (!fFlagFFT1) {
+      TransformFunction(*fFunction1, 0., fFFT1);
+      fFlagFFT1 = true;
+   }
    // apply a shift in order to have the second function centered around middle of the range of the convolution
-   Double_t shift2 = 0.5*(fXmin+fXmax);
-   Double_t x2;
-   for (int i=0; i<fNofPoints; i++)
-   {
-      x[i]   = fXmin + (fXmax-fXmin)/(fNofPoints-1)*i;
-      x2     = x[i] - shift2;
-      in1[i] = fFunction1 -> EvalPar( &x[i], nullptr);
-      in2[i] = fFunction2 -> EvalPar( &x2, nullptr);
-      fft1  -> SetPoint(i, in1[i]);
-      fft2  -> SetPoint(i, in2[i]);
+   if (!fFlagFFT2) {
+      TransformFunction(*fFunction2, 0.5*(fXmin+fXmax), fFFT2);
+      fFlagFFT2 = true;
    }
-   fft1 -> Transform();
-   fft2 -> Transform();
 
    //inverse transformation of the product
-
-   TVirtualFFT *fftinverse = TVirtualFFT::FFT(1, &fNofPoints, "C2R K");
-   Double_t re1, re2, im1, im2, out_re, out_im;
-
-   for (int i=0;i<=fNofPoints/2.;i++)
+   for (int i=0;i<=fNofPoints/2;i++)
    {
-      fft1 -> GetPointComplex(i,re1,im1);
-      fft2 -> GetPointComplex(i,re2,im2);
-      out_re = re1*re2 - im1*im2;
-      out_im = re1*im2 + re2*im1;
-      fftinverse -> SetPoint(i, out_re, out_im);
+      const std::complex<Double_t> out = fFFT1[i] * fFFT2[i];
+      fFFTInverse -> SetPoint(i, out.real(), out.imag());
    }
-   fftinverse -> Transform();
+   fFFTInverse -> Transform();
 
    // fill a graph with the result of the convolution
    if (!fGraphConv)
@@ -305,15 +332,29 @@ void TF1Convolution::MakeFFTConv()
       int j = i + fNofPoints/2;
       if (j >= fNofPoints) j -= fNofPoints;
       // need to normalize by dividing by the number of points and multiply by the bin width = Range/Number of points
-      fGraphConv->SetPoint(i, x[i], fftinverse->GetPointReal(j)*(fXmax-fXmin)/(fNofPoints*fNofPoints) );
+      fGraphConv->SetPoint(i, fXmin + (fXmax-fXmin)/(fNofPoints-1)*i,
+                           fFFTInverse->GetPointReal(j)*(fXmax-fXmin)/(fNofPoints*fNofPoints) );
    }
    fGraphConv->SetBit(TGraph::kIsSortedX); // indicate that points are sorted in X to speed up TGraph::Eval
    fFlagGraph = true; // we can use the graph
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Linear interpolation of the convolution graph, as TGraph::Eval, using the
+/// fact that the points are equidistant to find the closest ones directly.
 
-   // delete the fft objects
-   delete fft1;
-   delete fft2;
-   delete fftinverse; 
+Double_t TF1Convolution::EvalGraphConv(Double_t t) const
+{
+   const Int_t n = fGraphConv->GetN();
+   const Double_t *x = fGraphConv->GetX();
+   const Double_t *y = fGraphConv->GetY();
+   if (n < 2)
+      return n == 1 ? y[0] : 0.;
+   // outside of the range, the first or last two points are extrapolated
+   const Double_t pos = (t - x[0]) / (x[n-1] - x[0]) * (n - 1);
+   Int_t low = pos > 0 ? Int_t(pos) : 0;
+   if (low > n - 2) low = n - 2;
+   return y[low] + (t - x[low]) * (y[low+1] - y[low]) / (x[low+1] - x[low]);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -322,8 +363,8 @@ Double_t TF1Convolution::EvalFFTConv(Double_t t)
 {
    if (!fFlagGraph)  MakeFFTConv();
    // if cannot make FFT use numconv
-   if (fGraphConv)
-      return  fGraphConv -> Eval(t);
+   if (fGraphConv && fFlagGraph)
+      return EvalGraphConv(t);
    else
 
       return EvalNumConv(t);
@@ -366,6 +407,23 @@ Double_t TF1Convolution::operator()(const Double_t *x, const Double_t *p)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the convolution at the n points x, with the parameters p if given.
+/// With FFT, the convolution is computed once and then interpolated at each point.
+
+void TF1Convolution::EvalBatch(Int_t n, const Double_t *x, Double_t *result, const Double_t *p)
+{
+   if (p) TF1Convolution::SetParameters(p);
+   if (fFlagFFT && !fFlagGraph) MakeFFTConv();
+   if (fFlagFFT && fFlagGraph) {
+      for (Int_t i = 0; i < n; ++i)
+         result[i] = EvalGraphConv(x[i]);
+   } else {
+      for (Int_t i = 0; i < n; ++i)
+         result[i] = EvalNumConv(x[i]);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void TF1Convolution::SetNofPointsFFT(Int_t n)
@@ -373,19 +431,23 @@ void TF1Convolution::SetNofPointsFFT(Int_t n)
    if (n<0) return;
    fNofPoints = n;
    if (fGraphConv) fGraphConv -> Set(fNofPoints);
-   fFlagGraph = false; // to indicate we need to re-do the graph
+   // the transforms are made again for the new number of points
+   fFFTForward.reset();
+   fFFTInverse.reset();
+   InvalidateFFT(); // to indicate we need to re-do the graph
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void TF1Convolution::SetParameters(const Double_t *params)
 {
-   bool equalParams = true;
+   bool equalParams1 = true;
    for (int i=0; i<fNofParams1; i++) {
       fFunction1->SetParameter(i, params[i]);
-      equalParams &= (fParams1[i] == params[i]);
+      equalParams1 &= (fParams1[i] == params[i]);
       fParams1[i] = params[i];
    }
+   bool equalParams2 = true;
    Int_t k       = 0;
    Int_t offset  = 0;
    Int_t offset2 = 0;
@@ -399,12 +461,15 @@ void TF1Convolution::SetParameters(const Double_t *params)
          continue;
       }
       fFunction2->SetParameter(k, params[i - offset2]);
-      equalParams &= (fParams2[k - offset2] == params[i - offset2]);
+      equalParams2 &= (fParams2[k - offset2] == params[i - offset2]);
       fParams2[k - offset2] = params[i - offset2];
       k++;
    }
 
-   if (!equalParams) fFlagGraph = false; // to indicate we need to re-do the convolution
+   // only the transform of the function whose parameters have changed is recomputed
+   if (!equalParams1) fFlagFFT1 = false;
+   if (!equalParams2) fFlagFFT2 = false;
+   if (!equalParams1 || !equalParams2) fFlagGraph = false; // to indicate we need to re-do the convolution
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -424,7 +489,7 @@ void TF1Convolution::SetExtraRange(Double_t percentage)
    double range = fXmax = fXmin;
    fXmin -= percentage * range;
    fXmax += percentage * range;
-   fFlagGraph = false;  // to indicate we need to re-do the convolution
+   InvalidateFFT();  // to indicate we need to re-do the convolution
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -446,7 +511,7 @@ void TF1Convolution::SetRange(Double_t a, Double_t b)
       // add a spill over of 10% in this case
       SetExtraRange(0.1);
    }
-   fFlagGraph = false;  // to indicate we need to re-do the convolution
+   InvalidateFFT();  // to indicate we need to re-do the convolution
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -464,6 +529,7 @@ void TF1Convolution::Update()
 {
    fFunction1->Update();
    fFunction2->Update();
+   InvalidateFFT();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -479,6 +545,10 @@ void TF1Convolution::Copy(TObject &obj) const
    ((TF1Convolution &)obj).fNofPoints = fNofPoints;
    ((TF1Convolution &)obj).fFlagFFT = fFlagFFT;
    ((TF1Convolution &)obj).fFlagGraph = false; // since we're not copying the graph
+   ((TF1Convolution &)obj).fFlagFFT1 = false;  // nor the transforms
+   ((TF1Convolution &)obj).fFlagFFT2 = false;
+   ((TF1Convolution &)obj).fFFTForward.reset();
+   ((TF1Convolution &)obj).fFFTInverse.reset();
 
    // copy vectors
    ((TF1Convolution &)obj).fParams1 = fParams1;
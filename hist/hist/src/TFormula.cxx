@@ -21,6 +21,7 @@
 #include "TInterpreterValue.h"
 #include "TFormula.h"
 #include "TRegexp.h"
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <iostream>
@@ -212,6 +213,27 @@ static const TString gNamePrefix = "TFormula__";
 //static std::unordered_map<std::string,  TInterpreter::CallFuncIFacePtr_t::Generic_t> gClingFunctions = std::unordered_map<TString,  TInterpreter::CallFuncIFacePtr_t::Generic_t>();
 static std::unordered_map<std::string,  void *> gClingFunctions = std::unordered_map<std::string,  void * >();
 
+// static map of the function pointers of the generated gradients, keyed by the name of the gradient function
+static std::unordered_map<std::string, void *> gClingGradFunctions;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the key of the compiled function of a formula in gClingFunctions: the processed (normalised)
+/// expression followed by the number of variables and parameters, which fix the signature of the function, and
+/// by whether it is vectorized. All TFormula objects with the same key share the same compiled function.
+
+static std::string GetClingFunctionKey(const std::string &formula, Int_t ndim, Int_t npar, Bool_t vectorized)
+{
+   std::string key = formula;
+   key += " (ndim=" + std::to_string(ndim) + ",npar=" + std::to_string(npar) + ")";
+   if (vectorized)
+      key += " (vectorized)";
+   return key;
+}
+
+// formulas whose compilation is deferred (see TFormula::DeferCompilation), protected by gROOTMutex
+static bool gDeferCompilation = false;
+static std::vector<TFormula *> gDeferredFormulas;
+
 static void R__v5TFormulaUpdater(Int_t nobjects, TObject **from, TObject **to)
 {
    auto **fromv5 = (ROOT::v5::TFormula **)from;
@@ -421,6 +443,12 @@ TFormula::~TFormula()
       gROOT->GetListOfFunctions()->Remove(this);
    }
 
+   if (fLazyInitialization) {
+      R__LOCKGUARD(gROOTMutex);
+      gDeferredFormulas.erase(std::remove(gDeferredFormulas.begin(), gDeferredFormulas.end(), this),
+                              gDeferredFormulas.end());
+   }
+
    if (fMethod) {
       fMethod->Delete();
    }
@@ -635,6 +663,78 @@ Int_t TFormula::Compile(const char *expression)
    return (ret) ? 0 : 1;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Defer the compilation of the formulas created from now on, if `on` is true.
+/// Each formula is compiled by Cling in its own transaction, which dominates the time needed to build many
+/// formulas (e.g. the TF1s of a large fit model). When deferred, the formulas are instead compiled together in a
+/// single transaction, by CompileDeferred() or by the first evaluation of any of them.
+/// Until then IsValid() returns false for them.
+/// Returns the previous setting.
+
+Bool_t TFormula::DeferCompilation(Bool_t on)
+{
+   R__LOCKGUARD(gROOTMutex);
+   Bool_t previous = gDeferCompilation;
+   gDeferCompilation = on;
+   return previous;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compile in a single Cling transaction all the formulas whose compilation was deferred.
+/// If the code of some formula is invalid, all of them are compiled one by one, so that only the invalid ones
+/// fail. Returns true if all the formulas could be compiled.
+
+Bool_t TFormula::CompileDeferred()
+{
+   R__LOCKGUARD(gROOTMutex);
+   std::vector<TFormula *> formulas;
+   formulas.swap(gDeferredFormulas);
+
+   TString code;
+   std::set<TString> declared;
+   for (auto formula : formulas) {
+      if (formula->fClingInitialized || !formula->fReadyToExecute || formula->fClingInput.IsNull())
+         continue;
+      if (gClingFunctions.find(formula->fSavedInputFormula) != gClingFunctions.end())
+         continue;
+      if (declared.insert(formula->fClingName).second)
+         code += formula->fClingInput + "\n";
+   }
+
+   bool declaredAll = true;
+   if (!code.IsNull()) {
+      ROOT::GetROOT();
+      R__ASSERT(gCling);
+      // trigger autoloading / autoparsing (ROOT-9840), as in InputFormulaIntoCling()
+      gCling->ProcessLine("namespace ROOT_TFormula_triggerAutoParse {\n" + code + "\n}");
+      declaredAll = gCling->Declare("#pragma cling optimize(2)\n" + code);
+   }
+
+   bool ok = true;
+   for (auto formula : formulas) {
+      if (formula->fClingInitialized || !formula->fReadyToExecute || formula->fClingInput.IsNull())
+         continue;
+      formula->fLazyInitialization = false;
+      auto funcit = gClingFunctions.find(formula->fSavedInputFormula);
+      if (funcit != gClingFunctions.end()) {
+         formula->fFuncPtr = (TFormula::CallFuncSignature)funcit->second;
+         formula->fClingInitialized = true;
+         continue;
+      }
+      if (declaredAll)
+         formula->fClingInitialized = formula->PrepareEvalMethod();
+      else
+         formula->InputFormulaIntoCling();
+      if (formula->fClingInitialized) {
+         gClingFunctions.insert(std::make_pair(formula->fSavedInputFormula, (void *)formula->fFuncPtr));
+      } else {
+         formula->Error("CompileDeferred", "Error compiling formula expression in Cling");
+         ok = false;
+      }
+   }
+   return ok;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void TFormula::Copy(TObject &obj) const
 {
@@ -687,6 +787,11 @@ void TFormula::Copy(TObject &obj) const
    fnew.fClingName = fClingName;
    fnew.fSavedInputFormula = fSavedInputFormula;
    fnew.fLazyInitialization = fLazyInitialization;
+   if (fLazyInitialization) {
+      R__LOCKGUARD(gROOTMutex);
+      if (std::find(gDeferredFormulas.begin(), gDeferredFormulas.end(), this) != gDeferredFormulas.end())
+         gDeferredFormulas.push_back(&fnew);
+   }
 
    // case of function based on a C++  expression (lambda's) which is ready to be compiled
    if (fLambdaPtr && TestBit(TFormula::kLambda)) {
@@ -2273,11 +2378,9 @@ void TFormula::ProcessFormula(TString &formula)
          // and also formula is same as FClingInput typically and it will be modified
          std::string inputFormula(formula.Data());
 
-         // The name we really use for the unordered map will have a flag that
-         // says whether the formula is vectorized
-         std::string inputFormulaVecFlag = inputFormula;
-         if (fVectorized)
-            inputFormulaVecFlag += " (vectorized)";
+         // The name we really use for the unordered map also has the number of variables and parameters
+         // and a flag that says whether the formula is vectorized
+         std::string inputFormulaVecFlag = GetClingFunctionKey(inputFormula, fNdim, fNpar, fVectorized);
 
          TString argType = fVectorized ? "ROOT::Double_v" : "Double_t";
 
@@ -2330,6 +2433,11 @@ void TFormula::ProcessFormula(TString &formula)
          // }
 
          if (inputIntoCling) {
+            if (gDeferCompilation && !fLazyInitialization) {
+               // compiled later together with the other deferred formulas, see CompileDeferred()
+               fLazyInitialization = true;
+               gDeferredFormulas.push_back(this);
+            }
             if (!fLazyInitialization) {
                InputFormulaIntoCling();
                if (fClingInitialized) {
@@ -3154,9 +3262,19 @@ static bool functionExists(const string &Name) {
 bool TFormula::GenerateGradientPar()
 {
    // We already have generated the gradient.
-   if (fGradMethod)
+   if (fGradFuncPtr)
       return true;
 
+   // Reuse the gradient generated for another TFormula with the same expression, which has the same cling name.
+   {
+      R__LOCKGUARD(gROOTMutex);
+      auto funcit = gClingGradFunctions.find(GetGradientFuncName());
+      if (funcit != gClingGradFunctions.end()) {
+         fGradFuncPtr = (CallFuncSignature)funcit->second;
+         return true;
+      }
+   }
+
    if (!HasGradientGenerationFailed()) {
       // FIXME: Move this elsewhere
       if (!TFormula::fIsCladRuntimeIncluded) {
@@ -3188,6 +3306,10 @@ bool TFormula::GenerateGradientPar()
                                   GradFuncName.c_str(),
                                   fVectorized, /*IsGradient*/ true);
       fGradFuncPtr = prepareFuncPtr(fGradMethod.get());
+      if (fGradFuncPtr) {
+         R__LOCKGUARD(gROOTMutex);
+         gClingGradFunctions.insert(std::make_pair(GradFuncName, (void *)fGradFuncPtr));
+      }
       return true;
    }
    return false;
@@ -3460,7 +3582,12 @@ void TFormula::ReInitializeEvalMethod() {
          return; 
       }
    }
-   // compile now formula using cling
+   // compile now formula using cling, together with all the other deferred ones
+   if (std::find(gDeferredFormulas.begin(), gDeferredFormulas.end(), this) != gDeferredFormulas.end()) {
+      CompileDeferred();
+      if (fClingInitialized)
+         return;
+   }
    InputFormulaIntoCling();
    if (fClingInitialized && !fLazyInitialization) Info("ReInitializeEvalMethod", "Formula is now properly initialized !!");
    fLazyInitialization = false;
@@ -36,6 +36,9 @@
 #include <iostream>
 #include <fstream>
 #include <cstring>
+#include <algorithm>
+#include <memory>
+#include <vector>
 
 #include "HFitInterface.h"
 #include "Fit/DataRange.h"
@@ -45,6 +48,52 @@ extern void H1LeastSquareSeqnd(Int_t n, Double_t *a, Int_t idim, Int_t &ifail, I
 
 ClassImp(TGraph);
 
+namespace {
+
+/// Splines built by TGraph::Eval with option "S" for the last graphs evaluated by a thread,
+/// each with a copy of the points it was built from
+struct TGraphSplineCache {
+   static const Int_t kSize = 4;
+   struct Entry {
+      std::vector<Double_t> fX;
+      std::vector<Double_t> fY;
+      std::unique_ptr<TSpline3> fSpline;
+   };
+   Entry fEntries[kSize];
+   Int_t fNext = 0;
+};
+
+/// Return the spline through the n points (x,y), which is only built if the
+/// points differ from the ones of the splines kept by the calling thread.
+const TSpline3 &GetCachedSpline(Int_t n, const Double_t *x, const Double_t *y)
+{
+   thread_local TGraphSplineCache cache;
+   for (auto &entry : cache.fEntries) {
+      if (entry.fSpline && entry.fX.size() == size_t(n) && std::equal(x, x + n, entry.fX.begin()) &&
+          std::equal(y, y + n, entry.fY.begin()))
+         return *entry.fSpline;
+   }
+
+   auto &entry = cache.fEntries[cache.fNext];
+   cache.fNext = (cache.fNext + 1) % TGraphSplineCache::kSize;
+   entry.fX.assign(x, x + n);
+   entry.fY.assign(y, y + n);
+
+   // points must be sorted before using a TSpline
+   std::vector<Double_t> xsort(n);
+   std::vector<Double_t> ysort(n);
+   std::vector<Int_t> indxsort(n);
+   TMath::Sort(n, x, &indxsort[0], false);
+   for (Int_t i = 0; i < n; ++i) {
+      xsort[i] = x[indxsort[i]];
+      ysort[i] = y[indxsort[i]];
+   }
+   entry.fSpline.reset(new TSpline3("", &xsort[0], &ysort[0], n));
+   return *entry.fSpline;
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 
 /** \class TGraph
@@ -868,7 +917,8 @@ void TGraph::DrawPanel()
 ///    extrapolation is computed.
 ///  - if spline==0 and option="S" a TSpline3 object is created using this graph
 ///    and the interpolated value from the spline is returned.
-///    the internally created spline is deleted on return.
+///    The internally created spline is kept by the calling thread, together with a
+///    copy of the points, and it is only rebuilt when the points of the graph change.
 ///  - if spline is specified, it is used to return the interpolated value.
 ///
 ///   If the points are sorted in X a binary search is used (significantly faster)
@@ -889,24 +939,9 @@ Double_t TGraph::Eval(Double_t x, TSpline *spline, Option_t *option) const
    if (option && *option) {
       TString opt = option;
       opt.ToLower();
-      // create a TSpline every time when using option "s" and no spline pointer is given
-      if (opt.Contains("s")) {
-
-         // points must be sorted before using a TSpline
-         std::vector<Double_t> xsort(fNpoints);
-         std::vector<Double_t> ysort(fNpoints);
-         std::vector<Int_t> indxsort(fNpoints);
-         TMath::Sort(fNpoints, fX, &indxsort[0], false);
-         for (Int_t i = 0; i < fNpoints; ++i) {
-            xsort[i] = fX[ indxsort[i] ];
-            ysort[i] = fY[ indxsort[i] ];
-         }
-
-         // spline interpolation creating a new spline
-         TSpline3 s("", &xsort[0], &ysort[0], fNpoints);
-         Double_t result = s.Eval(x);
-         return result;
-      }
+      // use the cached spline of the current points when using option "s" and no spline pointer is given
+      if (opt.Contains("s"))
+         return GetCachedSpline(fNpoints, fX, fY).Eval(x);
    }
    //linear interpolation
    //In case x is < fX[0] or > fX[fNpoints-1] return the extrapolated point
@@ -26,10 +26,12 @@
 #include "strtok.h"
 #include "snprintf.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cassert>
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 #include "HFitInterface.h"
 #include "Fit/DataRange.h"
@@ -1195,21 +1197,25 @@ TH2D *TGraph2D::GetHistogram(Option_t *option)
    Double_t dx = (hxmax - hxmin) / fNpx;
    Double_t dy = (hymax - hymin) / fNpy;
 
-   Double_t x, y, z;
-
-   for (Int_t ix = 1; ix <= fNpx; ix++) {
-      x  = hxmin + (ix - 0.5) * dx;
-      for (Int_t iy = 1; iy <= fNpy; iy++) {
-         y  = hymin + (iy - 0.5) * dy;
-         // do interpolation
-         if (oldInterp)
-            z  = ((TGraphDelaunay*)fDelaunay)->ComputeZ(x, y);
-         else
-            z  = ((TGraphDelaunay2D*)fDelaunay)->ComputeZ(x, y);
-
-         fHistogram->Fill(x, y, z);
+   // interpolate all the bin centres at once, which lets the new interpolation
+   // reuse the triangle of the previous bin and run in parallel
+   const Int_t nbins = fNpx * fNpy;
+   std::vector<Double_t> x(nbins), y(nbins), z(nbins);
+   for (Int_t ix = 1, i = 0; ix <= fNpx; ix++) {
+      for (Int_t iy = 1; iy <= fNpy; iy++, i++) {
+         x[i] = hxmin + (ix - 0.5) * dx;
+         y[i] = hymin + (iy - 0.5) * dy;
       }
    }
+   if (oldInterp) {
+      for (Int_t i = 0; i < nbins; i++)
+         z[i] = ((TGraphDelaunay*)fDelaunay)->ComputeZ(x[i], y[i]);
+   } else {
+      ((TGraphDelaunay2D*)fDelaunay)->ComputeZ(nbins, x.data(), y.data(), z.data());
+   }
+
+   for (Int_t i = 0; i < nbins; i++)
+      fHistogram->Fill(x[i], y[i], z[i]);
 
 
    if (fMinimum != -1111) fHistogram->SetMinimum(fMinimum);
@@ -1335,6 +1341,32 @@ Double_t TGraph2D::Interpolate(Double_t x, Double_t y)
    return TMath::QuietNaN();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Finds the z values at the n positions (x[i],y[i]) thanks to the Delaunay
+/// interpolation. With the default interpolation, the search of the triangle
+/// of a point starts from the triangle of the previous point, which is faster
+/// than Interpolate(Double_t, Double_t) for close consecutive points, and the
+/// points are interpolated in parallel if implicit multi-threading is enabled.
+
+void TGraph2D::Interpolate(Int_t n, const Double_t *x, const Double_t *y, Double_t *z)
+{
+   if (n <= 0) return;
+   if (fNpoints <= 0) {
+      Error("Interpolate", "Empty TGraph2D");
+      std::fill(z, z + n, 0.);
+      return;
+   }
+
+   // the first point sets up the interpolator
+   z[0] = Interpolate(x[0], y[0]);
+   if (fDelaunay && fDelaunay->IsA() == TGraphDelaunay2D::Class()) {
+      ((TGraphDelaunay2D*)fDelaunay)->ComputeZ(n - 1, x + 1, y + 1, z + 1);
+   } else {
+      for (Int_t i = 1; i < n; i++)
+         z[i] = Interpolate(x[i], y[i]);
+   }
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Paints this 2D graph with its current attributes
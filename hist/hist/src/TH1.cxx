@@ -51,6 +51,7 @@
 #include "Math/QuantFuncMathCore.h"
 
 #include "TH1Merger.h"
+#include "TH1Helper.h"
 
 /** \addtogroup Hist
 @{
@@ -585,7 +586,8 @@ TH1::~TH1()
    delete[] fBuffer;
    fBuffer = 0;
    if (fFunctions) {
-      R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
+      // A histogram outside of any directory deleted in lightweight mode is not reachable by other threads.
+      ROOT::TWriteLockGuard guard((fDirectory || !ROOT::IsLightweightObjectsMode()) ? ROOT::gCoreMutex : nullptr);
 
       fFunctions->SetBit(kInvalidObject);
       TObject* obj = 0;
@@ -704,7 +706,7 @@ TH1::TH1(const TH1 &h) : TNamed(), TAttLine(), TAttFill(), TAttMarker()
 
 Bool_t TH1::AddDirectoryStatus()
 {
-   return fgAddDirectory;
+   return fgAddDirectory && !ROOT::IsLightweightObjectsMode();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -932,9 +934,13 @@ Bool_t TH1::Add(const TH1 *h1, Double_t c1)
    Double_t c1sq = c1 * c1;
    Double_t factsq = factor * factor;
 
-   for (Int_t bin = 0; bin < fNcells; ++bin) {
+   // normal case of addition between histograms, directly on the arrays of bin contents when possible
+   const Bool_t average = this->TestBit(kIsAverage) && h1->TestBit(kIsAverage);
+   const Bool_t done = !average && ROOT::TH1Helper::Add(*this, *h1, c1 * factor, c1sq * factsq);
+
+   for (Int_t bin = 0; bin < fNcells && !done; ++bin) {
       //special case where histograms have the kIsAverage bit set
-      if (this->TestBit(kIsAverage) && h1->TestBit(kIsAverage)) {
+      if (average) {
          Double_t y1 = h1->RetrieveBinContent(bin);
          Double_t y2 = this->RetrieveBinContent(bin);
          Double_t e1sq = h1->GetBinErrorSqUnchecked(bin);
@@ -1170,7 +1176,7 @@ Bool_t TH1::Add(const TH1 *h1, const TH1 *h2, Double_t c1, Double_t c2)
             fSumw2.fArray[i] = err2;
          }
       }
-   } else { // case of simple histogram addition
+   } else if (!ROOT::TH1Helper::Add(*this, *h1, *h2, c1, c2)) { // case of simple histogram addition
       Double_t c1sq = c1 * c1;
       Double_t c2sq = c2 * c2;
       for (Int_t i = 0; i < fNcells; ++i) { // Loop on cells (bins including underflows/overflows)
@@ -1375,13 +1381,8 @@ Int_t TH1::BufferEmpty(Int_t action)
    }
    if (CanExtendAllAxes() || (fXaxis.GetXmax() <= fXaxis.GetXmin())) {
       //find min, max of entries in buffer
-      Double_t xmin = fBuffer[2];
-      Double_t xmax = xmin;
-      for (Int_t i=1;i<nbentries;i++) {
-         Double_t x = fBuffer[2*i+2];
-         if (x < xmin) xmin = x;
-         if (x > xmax) xmax = x;
-      }
+      Double_t xmin, xmax;
+      ROOT::TH1Helper::FindRange(nbentries, &fBuffer[2], 2, xmin, xmax);
       if (fXaxis.GetXmax() <= fXaxis.GetXmin()) {
          Int_t rc = -1;
          if (TestBit(TH1::kAutoBinPTwo)) {
@@ -2650,7 +2651,7 @@ void TH1::Copy(TObject &obj) const
    // will be added to gDirectory independently of the fDirectory stored.
    // and if the AddDirectoryStatus() is false it will not be added to
    // any directory (fDirectory = 0)
-   if (fgAddDirectory && gDirectory) {
+   if (AddDirectoryStatus() && gDirectory) {
       gDirectory->Append(&obj);
       ((TH1&)obj).fFunctions->UseRWLock();
       ((TH1&)obj).fDirectory = gDirectory;
@@ -2845,7 +2846,11 @@ Bool_t TH1::Divide(const TH1 *h1)
    //    Create Sumw2 if h1 has Sumw2 set
    if (fSumw2.fN == 0 && h1->GetSumw2N() != 0) Sumw2();
 
-   //   - Loop on bins (including underflows/overflows)
+   //   - Loop on bins (including underflows/overflows), directly on the arrays of bin contents when possible
+   if (ROOT::TH1Helper::Divide(*this, *h1)) {
+      ResetStats();
+      return kTRUE;
+   }
    for (Int_t i = 0; i < fNcells; ++i) {
       Double_t c0 = RetrieveBinContent(i);
       Double_t c1 = h1->RetrieveBinContent(i);
@@ -3404,28 +3409,51 @@ void TH1::FillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride
 
 void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride)
 {
-   Int_t bin,i;
-
    fEntries += ntimes;
-   Double_t ww = 1;
-   Int_t nbins   = fXaxis.GetNbins();
-   ntimes *= stride;
-   for (i=0;i<ntimes;i+=stride) {
-      bin =fXaxis.FindBin(x[i]);
-      if (bin <0) continue;
-      if (w) ww = w[i];
-      if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
-      if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
-      AddBinContent(bin, ww);
-      if (bin == 0 || bin > nbins) {
-         if (!GetStatOverflowsBehaviour()) continue;
+   // the sums of squares of weights must exist before any bin is filled
+   if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+      for (Int_t i = 0; i < ntimes; ++i) {
+         if (w[i * stride] != 1.) {
+            Sumw2();
+            break;
+         }
       }
-      Double_t z= ww;
-      fTsumw   += z;
-      fTsumw2  += z*z;
-      fTsumwx  += z*x[i];
-      fTsumwx2 += z*x[i]*x[i];
    }
+
+   // Unless filling can extend the axis (which changes the bin numbers), the bins are found in batches.
+   const Bool_t canExtend = fXaxis.CanExtend() && !fXaxis.IsAlphanumeric();
+   const Int_t nbins = fXaxis.GetNbins();
+   const Bool_t statOverflows = GetStatOverflowsBehaviour();
+   Double_t tsumw = fTsumw, tsumw2 = fTsumw2, tsumwx = fTsumwx, tsumwx2 = fTsumwx2;
+   Int_t bins[kFillNBatchSize];
+   for (Int_t first = 0; first < ntimes; first += kFillNBatchSize) {
+      const Int_t n = TMath::Min(kFillNBatchSize, ntimes - first);
+      const Double_t *xb = x + first * stride;
+      const Double_t *wb = w ? w + first * stride : nullptr;
+      if (canExtend) {
+         for (Int_t i = 0; i < n; ++i)
+            bins[i] = fXaxis.FindBin(xb[i * stride]);
+      } else {
+         fXaxis.FindFixBins(n, xb, bins, stride);
+      }
+      for (Int_t i = 0; i < n; ++i) {
+         const Int_t bin = bins[i];
+         if (bin < 0) continue;
+         const Double_t ww = wb ? wb[i * stride] : 1.;
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin, ww);
+         if ((bin == 0 || bin > nbins) && !statOverflows) continue;
+         const Double_t xi = xb[i * stride];
+         tsumw   += ww;
+         tsumw2  += ww*ww;
+         tsumwx  += ww*xi;
+         tsumwx2 += ww*xi*xi;
+      }
+   }
+   fTsumw = tsumw;
+   fTsumw2 = tsumw2;
+   fTsumwx = tsumwx;
+   fTsumwx2 = tsumwx2;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3858,6 +3886,9 @@ TFitResultPtr TH1::Fit(const char *fname ,Option_t *option ,Option_t *goption, D
 ///          It uses the IMPROVE command of TMinuit (see TMinuit::mnimpr).
 ///          This algorithm attempts to improve the found local minimum by searching for a
 ///          better one.
+///        - "G"  Use the gradient of the function with respect to the parameters in the minimization
+///          (see TF1::GradientPar). For a function defined by a formula, the gradient is generated
+///          with automatic differentiation (clad) when ROOT is built with it.
 ///        - "R"  Use the Range specified in the function range
 ///        - "N"  Do not store the graphics function, do not draw
 ///        - "0"  Do not plot the result of the fit. By default the fitted function
@@ -5752,7 +5783,11 @@ Bool_t TH1::Multiply(const TH1 *h1)
    SetMinimum();
    SetMaximum();
 
-   //   - Loop on bins (including underflows/overflows)
+   //   - Loop on bins (including underflows/overflows), directly on the arrays of bin contents when possible
+   if (ROOT::TH1Helper::Multiply(*this, *h1)) {
+      ResetStats();
+      return kTRUE;
+   }
    for (Int_t i = 0; i < fNcells; ++i) {
       Double_t c0 = RetrieveBinContent(i);
       Double_t c1 = h1->RetrieveBinContent(i);
@@ -6253,8 +6288,10 @@ void TH1::Scale(Double_t c1, Option_t *option)
    if (opt.Contains("width")) Add(this, this, c1, -1);
    else {
       if (fBuffer) BufferEmpty(1);
-      for(Int_t i = 0; i < fNcells; ++i) UpdateBinContent(i, c1 * RetrieveBinContent(i));
-      if (fSumw2.fN) for(Int_t i = 0; i < fNcells; ++i) fSumw2.fArray[i] *= (c1 * c1); // update errors
+      if (!ROOT::TH1Helper::Scale(*this, c1)) {
+         for(Int_t i = 0; i < fNcells; ++i) UpdateBinContent(i, c1 * RetrieveBinContent(i));
+         if (fSumw2.fN) for(Int_t i = 0; i < fNcells; ++i) fSumw2.fArray[i] *= (c1 * c1); // update errors
+      }
       // update global histograms statistics
       Double_t s[kNstat] = {0};
       GetStats(s);
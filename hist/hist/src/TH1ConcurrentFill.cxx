@@ -0,0 +1,248 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TH1ConcurrentFill.h"
+#include "TH2.h"
+#include "TH3.h"
+#include "TError.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+/// Add value to target, which may be updated concurrently by other threads.
+template <typename T>
+void AtomicAdd(T &target, T value)
+{
+   static_assert(sizeof(std::atomic<T>) == sizeof(T), "std::atomic<T> must have the layout of T");
+   auto &a = reinterpret_cast<std::atomic<T> &>(target);
+   T old = a.load(std::memory_order_relaxed);
+   while (!a.compare_exchange_weak(old, old + value, std::memory_order_relaxed))
+      ;
+}
+
+} // anonymous namespace
+
+using ROOT::TH1ConcurrentFillManager;
+using ROOT::TH1ConcurrentFiller;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare hist for concurrent filling in the given mode.
+/// If the mode is kAtomic but the bin contents are neither Double_t nor Float_t, kSharded is used instead.
+/// The sums of squares of weights are created, unless TH1::kIsNotW is set, since any filler may fill with
+/// weights other than 1.
+
+TH1ConcurrentFillManager::TH1ConcurrentFillManager(TH1 &hist, EMode mode)
+   : fHist(hist), fMode(mode), fDimension(hist.GetDimension())
+{
+   if (hist.InheritsFrom("TProfile") || hist.InheritsFrom("TProfile2D") || hist.InheritsFrom("TProfile3D") ||
+       hist.InheritsFrom("TH2Poly"))
+      throw std::runtime_error(std::string("TH1ConcurrentFillManager: concurrent filling of a ") +
+                               hist.ClassName() + " is not supported.");
+
+   if (hist.GetBufferSize())
+      hist.BufferEmpty(1);
+   fCanExtend = hist.SetCanExtend(TH1::kNoAxis);
+   fStatOverflows = hist.GetStatOverflowsBehaviour();
+   if (!hist.GetSumw2N() && !hist.TestBit(TH1::kIsNotW))
+      hist.Sumw2();
+   if (hist.GetSumw2N())
+      fSumw2 = hist.GetSumw2()->GetArray();
+
+   if (fMode == EMode::kAtomic) {
+      if (auto arrayD = dynamic_cast<TArrayD *>(&hist))
+         fContentD = arrayD->GetArray();
+      else if (auto arrayF = dynamic_cast<TArrayF *>(&hist))
+         fContentF = arrayF->GetArray();
+      else {
+         ::Warning("TH1ConcurrentFillManager", "the bin contents of %s are neither Double_t nor Float_t, "
+                   "using the sharded mode", hist.GetName());
+         fMode = EMode::kSharded;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Restore the extension of the axes of the histogram.
+
+TH1ConcurrentFillManager::~TH1ConcurrentFillManager()
+{
+   fHist.SetCanExtend(fCanExtend);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a new filler, to be used by a single thread.
+
+TH1ConcurrentFiller TH1ConcurrentFillManager::MakeFiller()
+{
+   return TH1ConcurrentFiller(*this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the partial bin contents and statistics of filler to the histogram, and reset them.
+
+void TH1ConcurrentFillManager::Merge(TH1ConcurrentFiller &filler)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+
+   if (fMode == EMode::kSharded) {
+      const auto ncells = filler.fContents.size();
+      for (std::size_t bin = 0; bin < ncells; ++bin) {
+         if (filler.fContents[bin] != 0.)
+            fHist.AddBinContent(bin, filler.fContents[bin]);
+         if (fSumw2)
+            fSumw2[bin] += filler.fSumw2[bin];
+      }
+      std::fill(filler.fContents.begin(), filler.fContents.end(), 0.);
+      std::fill(filler.fSumw2.begin(), filler.fSumw2.end(), 0.);
+   }
+
+   const Double_t *s = filler.fStats;
+   fHist.fEntries += filler.fEntries;
+   fHist.fTsumw += s[0];
+   fHist.fTsumw2 += s[1];
+   fHist.fTsumwx += s[2];
+   fHist.fTsumwx2 += s[3];
+   if (fDimension == 2) {
+      auto &h2 = static_cast<TH2 &>(fHist);
+      h2.fTsumwy += s[4];
+      h2.fTsumwy2 += s[5];
+      h2.fTsumwxy += s[6];
+   } else if (fDimension == 3) {
+      auto &h3 = static_cast<TH3 &>(fHist);
+      h3.fTsumwy += s[4];
+      h3.fTsumwy2 += s[5];
+      h3.fTsumwxy += s[6];
+      h3.fTsumwz += s[7];
+      h3.fTsumwz2 += s[8];
+      h3.fTsumwxz += s[9];
+      h3.fTsumwyz += s[10];
+   }
+   std::fill(std::begin(filler.fStats), std::end(filler.fStats), 0.);
+   filler.fEntries = 0.;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TH1ConcurrentFiller::TH1ConcurrentFiller(TH1ConcurrentFillManager &manager) : fManager(&manager)
+{
+   std::fill(std::begin(fStats), std::end(fStats), 0.);
+   if (manager.fMode == TH1ConcurrentFillManager::EMode::kSharded) {
+      fContents.assign(manager.fHist.GetNcells(), 0.);
+      if (manager.fSumw2)
+         fSumw2.assign(manager.fHist.GetNcells(), 0.);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TH1ConcurrentFiller::TH1ConcurrentFiller(TH1ConcurrentFiller &&other)
+   : fManager(other.fManager), fContents(std::move(other.fContents)), fSumw2(std::move(other.fSumw2)),
+     fEntries(other.fEntries)
+{
+   std::copy(std::begin(other.fStats), std::end(other.fStats), std::begin(fStats));
+   other.fManager = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the bin contents and the statistics filled so far to the histogram.
+
+void TH1ConcurrentFiller::Flush()
+{
+   if (fManager)
+      fManager->Merge(*this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill x with weight w, as TH1::Fill(x, w), TH2::Fill(x, y, w) and TH3::Fill(x, y, z, w) do.
+
+Int_t TH1ConcurrentFiller::DoFill(Double_t x, Double_t y, Double_t z, Double_t w)
+{
+   auto &m = *fManager;
+   const TH1 &h = m.fHist;
+   const Int_t binx = h.GetXaxis()->FindFixBin(x);
+   const Int_t biny = m.fDimension > 1 ? h.GetYaxis()->FindFixBin(y) : 0;
+   const Int_t binz = m.fDimension > 2 ? h.GetZaxis()->FindFixBin(z) : 0;
+   const Int_t bin = h.GetBin(binx, biny, binz);
+
+   fEntries++;
+   if (m.fMode == TH1ConcurrentFillManager::EMode::kSharded) {
+      fContents[bin] += w;
+      if (m.fSumw2)
+         fSumw2[bin] += w * w;
+   } else {
+      if (m.fContentD)
+         AtomicAdd(m.fContentD[bin], w);
+      else
+         AtomicAdd(m.fContentF[bin], Float_t(w));
+      if (m.fSumw2)
+         AtomicAdd(m.fSumw2[bin], w * w);
+   }
+
+   if (!m.fStatOverflows) {
+      if (binx == 0 || binx > h.GetXaxis()->GetNbins())
+         return -1;
+      if (m.fDimension > 1 && (biny == 0 || biny > h.GetYaxis()->GetNbins()))
+         return -1;
+      if (m.fDimension > 2 && (binz == 0 || binz > h.GetZaxis()->GetNbins()))
+         return -1;
+   }
+   fStats[0] += w;
+   fStats[1] += w * w;
+   fStats[2] += w * x;
+   fStats[3] += w * x * x;
+   if (m.fDimension > 1) {
+      fStats[4] += w * y;
+      fStats[5] += w * y * y;
+      fStats[6] += w * x * y;
+   }
+   if (m.fDimension > 2) {
+      fStats[7] += w * z;
+      fStats[8] += w * z * z;
+      fStats[9] += w * x * z;
+      fStats[10] += w * y * z;
+   }
+   return bin;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill x with weight 1 (1D histograms).
+
+Int_t TH1ConcurrentFiller::Fill(Double_t x)
+{
+   return DoFill(x, 0., 0., 1.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill x with weight yw (1D histograms) or (x, yw) with weight 1 (2D histograms).
+
+Int_t TH1ConcurrentFiller::Fill(Double_t x, Double_t yw)
+{
+   return fManager->fDimension == 1 ? DoFill(x, 0., 0., yw) : DoFill(x, yw, 0., 1.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill (x, y) with weight zw (2D histograms) or (x, y, zw) with weight 1 (3D histograms).
+
+Int_t TH1ConcurrentFiller::Fill(Double_t x, Double_t y, Double_t zw)
+{
+   return fManager->fDimension == 2 ? DoFill(x, y, 0., zw) : DoFill(x, y, zw, 1.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill (x, y, z) with weight w (3D histograms).
+
+Int_t TH1ConcurrentFiller::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
+{
+   return DoFill(x, y, z, w);
+}
@@ -0,0 +1,313 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// helper functions used internally by TH1 and TH1Merger to loop over the cells of
+// histograms whose contents are a plain array of Double_t or Float_t, and by the
+// BufferEmpty() methods of TH1, TH2 and TH3 to find the range of the buffered entries
+
+#ifndef ROOT_TH1Helper
+#define ROOT_TH1Helper
+
+#include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace ROOT {
+
+namespace TH1Helper {
+
+/// Minimum number of cells processed by a thread, when the loops over the cells are split among the threads of the
+/// implicit multi-threading pool.
+constexpr Int_t kMinCellsPerThread = 1 << 18;
+
+/// Number of cells to which all inputs are added in turn when merging, small enough for them to stay in the cache.
+constexpr Int_t kMergeBlockSize = 2048;
+
+/// Return the contents of h, indexed by global bin, if h is a TH1D, TH2D or TH3D (T = Double_t) or a TH1F, TH2F or
+/// TH3F (T = Float_t), and nullptr otherwise. Derived classes are excluded on purpose: they may store or interpret
+/// their contents differently (e.g. the profiles).
+template <typename T>
+T *GetContents(const TH1 &h);
+
+template <>
+inline Double_t *GetContents<Double_t>(const TH1 &h)
+{
+   TClass *cl = h.IsA();
+   if (cl != TH1D::Class() && cl != TH2D::Class() && cl != TH3D::Class())
+      return nullptr;
+   return const_cast<Double_t *>(dynamic_cast<const TArrayD &>(h).GetArray());
+}
+
+template <>
+inline Float_t *GetContents<Float_t>(const TH1 &h)
+{
+   TClass *cl = h.IsA();
+   if (cl != TH1F::Class() && cl != TH2F::Class() && cl != TH3F::Class())
+      return nullptr;
+   return const_cast<Float_t *>(dynamic_cast<const TArrayF &>(h).GetArray());
+}
+
+/// Call func(begin, end) on ranges of cells covering [0, ncells). The ranges are processed in parallel if implicit
+/// multi-threading is enabled and there are enough cells.
+template <typename F>
+void ForEachCellRange(Int_t ncells, F func)
+{
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && ncells >= 2 * kMinCellsPerThread) {
+      ROOT::TThreadExecutor pool;
+      const unsigned nChunks = std::min<unsigned>(pool.GetPoolSize(), ncells / kMinCellsPerThread);
+      const Int_t chunkSize = (ncells + nChunks - 1) / nChunks;
+      auto processChunk = [&](unsigned chunk) {
+         const Int_t begin = chunk * chunkSize;
+         func(begin, std::min(ncells, begin + chunkSize));
+      };
+      pool.Foreach(processChunk, ROOT::TSeq<unsigned>(nChunks));
+      return;
+   }
+#endif
+   func(0, ncells);
+}
+
+/// Find the minimum and maximum of the n values values[i * stride], e.g. one coordinate of the entries of the buffer
+/// of a histogram. Ranges of values are scanned in parallel if implicit multi-threading is enabled and there are
+/// enough values. As in a scan with `if (x < min) min = x;`, NaNs are ignored unless the first value is a NaN.
+inline void FindRange(Int_t n, const Double_t *values, Int_t stride, Double_t &min, Double_t &max)
+{
+   min = max = values[0];
+   std::mutex mutex;
+   ForEachCellRange(n, [&](Int_t begin, Int_t end) {
+      Double_t lo = values[Long64_t(begin) * stride];
+      Double_t hi = lo;
+      // kept free of branches so that the compiler vectorizes it
+      for (Int_t i = begin + 1; i < end; ++i) {
+         const Double_t x = values[Long64_t(i) * stride];
+         lo = x < lo ? x : lo;
+         hi = x > hi ? x : hi;
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      min = lo < min ? lo : min;
+      max = hi > max ? hi : max;
+   });
+}
+
+/// Return the sums of squares of weights of h, or nullptr if they are not stored.
+inline Double_t *GetSumw2(const TH1 &h)
+{
+   return h.GetSumw2N() ? const_cast<Double_t *>(h.GetSumw2()->GetArray()) : nullptr;
+}
+
+// The functions below implement the loops over the cells of TH1::Add(), TH1::Multiply(), TH1::Divide(),
+// TH1::Scale() and TH1Merger on the arrays of contents and of sums of squares of weights. They return false, and do
+// nothing, unless all histograms have contents of the same type, Double_t or Float_t (see GetContents()). If a source
+// histogram has no sums of squares of weights its contents are used instead, as in TH1::GetBinErrorSqUnchecked().
+// The loops are kept free of calls so that the compiler vectorizes them.
+
+template <typename T>
+bool DoAdd(TH1 &dst, const TH1 &src, Double_t c, Double_t csq)
+{
+   T *d = GetContents<T>(dst);
+   const T *s = GetContents<T>(src);
+   if (!d || !s)
+      return false;
+   Double_t *dw = GetSumw2(dst);
+   const Double_t *sw = GetSumw2(src);
+   ForEachCellRange(dst.GetNcells(), [=](Int_t begin, Int_t end) {
+      for (Int_t i = begin; i < end; ++i)
+         d[i] += T(c * s[i]);
+      if (dw && sw) {
+         for (Int_t i = begin; i < end; ++i)
+            dw[i] += csq * sw[i];
+      } else if (dw) {
+         for (Int_t i = begin; i < end; ++i)
+            dw[i] += csq * s[i];
+      }
+   });
+   return true;
+}
+
+/// dst += c * src, and the sums of squares of weights of dst += csq * those of src.
+inline bool Add(TH1 &dst, const TH1 &src, Double_t c, Double_t csq)
+{
+   return DoAdd<Double_t>(dst, src, c, csq) || DoAdd<Float_t>(dst, src, c, csq);
+}
+
+template <typename T>
+bool DoAdd(TH1 &dst, const TH1 &src1, const TH1 &src2, Double_t c1, Double_t c2)
+{
+   T *d = GetContents<T>(dst);
+   const T *s1 = GetContents<T>(src1);
+   const T *s2 = GetContents<T>(src2);
+   if (!d || !s1 || !s2)
+      return false;
+   Double_t *dw = GetSumw2(dst);
+   const Double_t *sw1 = GetSumw2(src1);
+   const Double_t *sw2 = GetSumw2(src2);
+   const Double_t c1sq = c1 * c1;
+   const Double_t c2sq = c2 * c2;
+   ForEachCellRange(dst.GetNcells(), [=](Int_t begin, Int_t end) {
+      for (Int_t i = begin; i < end; ++i) {
+         const Double_t b1 = s1[i];
+         const Double_t b2 = s2[i];
+         const Double_t e1sq = sw1 ? sw1[i] : b1;
+         const Double_t e2sq = sw2 ? sw2[i] : b2;
+         d[i] = T(c1 * b1 + c2 * b2);
+         if (dw)
+            dw[i] = c1sq * e1sq + c2sq * e2sq;
+      }
+   });
+   return true;
+}
+
+/// dst = c1 * src1 + c2 * src2
+inline bool Add(TH1 &dst, const TH1 &src1, const TH1 &src2, Double_t c1, Double_t c2)
+{
+   return DoAdd<Double_t>(dst, src1, src2, c1, c2) || DoAdd<Float_t>(dst, src1, src2, c1, c2);
+}
+
+template <typename T>
+bool DoAdd(TH1 &dst, const std::vector<const TH1 *> &srcs)
+{
+   T *d = GetContents<T>(dst);
+   if (!d)
+      return false;
+   std::vector<const T *> s;
+   std::vector<const Double_t *> sw;
+   for (auto src : srcs) {
+      s.push_back(GetContents<T>(*src));
+      sw.push_back(GetSumw2(*src));
+      if (!s.back())
+         return false;
+   }
+   Double_t *dw = GetSumw2(dst);
+   ForEachCellRange(dst.GetNcells(), [&](Int_t begin, Int_t end) {
+      for (Int_t blockBegin = begin; blockBegin < end; blockBegin += kMergeBlockSize) {
+         const Int_t blockEnd = std::min(end, blockBegin + kMergeBlockSize);
+         for (std::size_t j = 0; j < s.size(); ++j) {
+            const T *sj = s[j];
+            const Double_t *swj = sw[j];
+            for (Int_t i = blockBegin; i < blockEnd; ++i)
+               d[i] += sj[i];
+            if (dw && swj) {
+               for (Int_t i = blockBegin; i < blockEnd; ++i)
+                  dw[i] += swj[i];
+            } else if (dw) {
+               for (Int_t i = blockBegin; i < blockEnd; ++i)
+                  dw[i] += sj[i];
+            }
+         }
+      }
+   });
+   return true;
+}
+
+/// dst += the sum of srcs, in a single pass over the cells of dst: the inputs are added in turn to a block of cells
+/// before moving to the next one.
+inline bool Add(TH1 &dst, const std::vector<const TH1 *> &srcs)
+{
+   return DoAdd<Double_t>(dst, srcs) || DoAdd<Float_t>(dst, srcs);
+}
+
+template <typename T>
+bool DoMultiply(TH1 &dst, const TH1 &src)
+{
+   T *d = GetContents<T>(dst);
+   const T *s = GetContents<T>(src);
+   if (!d || !s)
+      return false;
+   Double_t *dw = GetSumw2(dst);
+   const Double_t *sw = GetSumw2(src);
+   ForEachCellRange(dst.GetNcells(), [=](Int_t begin, Int_t end) {
+      for (Int_t i = begin; i < end; ++i) {
+         const Double_t c0 = d[i];
+         const Double_t c1 = s[i];
+         const Double_t e1sq = sw ? sw[i] : c1;
+         d[i] = T(c0 * c1);
+         if (dw)
+            dw[i] = dw[i] * c1 * c1 + e1sq * c0 * c0;
+      }
+   });
+   return true;
+}
+
+/// dst *= src
+inline bool Multiply(TH1 &dst, const TH1 &src)
+{
+   return DoMultiply<Double_t>(dst, src) || DoMultiply<Float_t>(dst, src);
+}
+
+template <typename T>
+bool DoDivide(TH1 &dst, const TH1 &src)
+{
+   T *d = GetContents<T>(dst);
+   const T *s = GetContents<T>(src);
+   if (!d || !s)
+      return false;
+   Double_t *dw = GetSumw2(dst);
+   const Double_t *sw = GetSumw2(src);
+   ForEachCellRange(dst.GetNcells(), [=](Int_t begin, Int_t end) {
+      for (Int_t i = begin; i < end; ++i) {
+         const Double_t c0 = d[i];
+         const Double_t c1 = s[i];
+         const Double_t e1sq = sw ? sw[i] : c1;
+         const Double_t c1sq = c1 * c1;
+         d[i] = c1 ? T(c0 / c1) : T(0);
+         if (dw)
+            dw[i] = c1 ? (dw[i] * c1sq + e1sq * c0 * c0) / (c1sq * c1sq) : 0.;
+      }
+   });
+   return true;
+}
+
+/// dst /= src, where the cells with a null divisor are set to 0
+inline bool Divide(TH1 &dst, const TH1 &src)
+{
+   return DoDivide<Double_t>(dst, src) || DoDivide<Float_t>(dst, src);
+}
+
+template <typename T>
+bool DoScale(TH1 &dst, Double_t c)
+{
+   T *d = GetContents<T>(dst);
+   if (!d)
+      return false;
+   Double_t *dw = GetSumw2(dst);
+   const Double_t csq = c * c;
+   ForEachCellRange(dst.GetNcells(), [=](Int_t begin, Int_t end) {
+      for (Int_t i = begin; i < end; ++i)
+         d[i] = T(c * d[i]);
+      if (dw) {
+         for (Int_t i = begin; i < end; ++i)
+            dw[i] *= csq;
+      }
+   });
+   return true;
+}
+
+/// dst *= c
+inline bool Scale(TH1 &dst, Double_t c)
+{
+   return DoScale<Double_t>(dst, c) || DoScale<Float_t>(dst, c);
+}
+
+} // namespace TH1Helper
+
+} // namespace ROOT
+
+#endif
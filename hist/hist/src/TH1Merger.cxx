@@ -1,6 +1,7 @@
 // Helper clas implementing some of the TH1 functionality
 
 #include "TH1Merger.h"
+#include "TH1Helper.h"
 #include "TH1.h"
 #include "TH2.h"
 #include "TH3.h"
@@ -11,6 +12,7 @@
 #include <iostream>
 #include <limits>
 #include <utility>
+#include <vector>
 
 #define PRINTRANGE(a, b, bn)                                                                                          \
    Printf(" base: %f %f %d, %s: %f %f %d", a->GetXmin(), a->GetXmax(), a->GetNbins(), bn, b->GetXmin(), b->GetXmax(), \
@@ -751,6 +753,7 @@ Bool_t TH1Merger::SameAxesMerge() {
    fH0->GetStats(totstats);
    Double_t nentries = fH0->GetEntries();
    
+   std::vector<const TH1 *> inputs;
    TIter next(&fInputList); 
    while (TH1* hist=(TH1*)next()) {
       // process only if the histogram has limits; otherwise it was processed before
@@ -767,18 +770,23 @@ Bool_t TH1Merger::SameAxesMerge() {
       for (Int_t i=0; i<TH1::kNstat; i++)
          totstats[i] += stats[i];
       nentries += hist->GetEntries();
+      inputs.push_back(hist);
+   }
 
-         //Int_t nx = hist->GetXaxis()->GetNbins();
+   // add all histograms in one pass over the bins if their contents are stored in arrays of the same type
+   if (!ROOT::TH1Helper::Add(*fH0, inputs)) {
+      for (auto hist : inputs) {
          // loop on bins of the histogram and do the merge
-      for (Int_t ibin = 0; ibin < hist->fNcells; ibin++) {
+         for (Int_t ibin = 0; ibin < hist->fNcells; ibin++) {
 
-         Double_t cu = hist->RetrieveBinContent(ibin);
-         Double_t e1sq = TMath::Abs(cu);
-         if (fH0->fSumw2.fN) e1sq= hist->GetBinErrorSqUnchecked(ibin);
+            Double_t cu = hist->RetrieveBinContent(ibin);
+            Double_t e1sq = TMath::Abs(cu);
+            if (fH0->fSumw2.fN) e1sq= hist->GetBinErrorSqUnchecked(ibin);
 
-         fH0->AddBinContent(ibin,cu);
-         if (fH0->fSumw2.fN) fH0->fSumw2.fArray[ibin] += e1sq;
+            fH0->AddBinContent(ibin,cu);
+            if (fH0->fSumw2.fN) fH0->fSumw2.fArray[ibin] += e1sq;
 
+         }
       }
    }
    //copy merged stats
@@ -21,6 +21,7 @@
 #include "TMatrixFBase.h"
 #include "TMatrixDBase.h"
 #include "THLimitsFinder.h"
+#include "TH1Helper.h"
 #include "TError.h"
 #include "TMath.h"
 #include "TObjString.h"
@@ -200,18 +201,9 @@ Int_t TH2::BufferEmpty(Int_t action)
 
    if (CanExtendAllAxes() || fXaxis.GetXmax() <= fXaxis.GetXmin() || fYaxis.GetXmax() <= fYaxis.GetXmin()) {
       //find min, max of entries in buffer
-      Double_t xmin = fBuffer[2];
-      Double_t xmax = xmin;
-      Double_t ymin = fBuffer[3];
-      Double_t ymax = ymin;
-      for (Int_t i=1;i<nbentries;i++) {
-         Double_t x = fBuffer[3*i+2];
-         if (x < xmin) xmin = x;
-         if (x > xmax) xmax = x;
-         Double_t y = fBuffer[3*i+3];
-         if (y < ymin) ymin = y;
-         if (y > ymax) ymax = y;
-      }
+      Double_t xmin, xmax, ymin, ymax;
+      ROOT::TH1Helper::FindRange(nbentries, &fBuffer[2], 3, xmin, xmax);
+      ROOT::TH1Helper::FindRange(nbentries, &fBuffer[3], 3, ymin, ymax);
       if (fXaxis.GetXmax() <= fXaxis.GetXmin() || fYaxis.GetXmax() <= fYaxis.GetXmin()) {
          THLimitsFinder::GetLimitsFinder()->FindGoodLimits(this,xmin,xmax,ymin,ymax);
       } else {
@@ -226,10 +218,9 @@ Int_t TH2::BufferEmpty(Int_t action)
       }
    }
 
+   // FillN does not put the entries back in the buffer since fBuffer is zero
    fBuffer = 0;
-   for (Int_t i=0;i<nbentries;i++) {
-      Fill(buffer[3*i+2],buffer[3*i+3],buffer[3*i+1]);
-   }
+   FillN(nbentries,&buffer[2],&buffer[3],&buffer[1],3);
    fBuffer = buffer;
 
    if (action > 0) { delete [] fBuffer; fBuffer = 0; fBufferSize = 0;}
@@ -553,31 +544,61 @@ void TH2::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double
          return;
    }
 
-   Double_t ww = 1;
-   for (i=ifirst;i<ntimes;i+=stride) {
-      fEntries++;
-      binx = fXaxis.FindBin(x[i]);
-      biny = fYaxis.FindBin(y[i]);
-      if (binx <0 || biny <0) continue;
-      bin  = biny*(fXaxis.GetNbins()+2) + binx;
-      if (w) ww = w[i];
-      if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
-      if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
-      AddBinContent(bin,ww);
-      if (binx == 0 || binx > fXaxis.GetNbins()) {
-         if (!GetStatOverflowsBehaviour()) continue;
+   ntimes = (ntimes - ifirst) / stride;
+   x += ifirst;
+   y += ifirst;
+   if (w) w += ifirst;
+   fEntries += ntimes;
+   // the sums of squares of weights must exist before any bin is filled
+   if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+      for (i = 0; i < ntimes; ++i) {
+         if (w[i * stride] != 1.) {
+            Sumw2();
+            break;
+         }
+      }
+   }
+
+   // Unless filling can extend an axis (which changes the bin numbers), the bins are found in batches.
+   const Bool_t canExtend = (fXaxis.CanExtend() && !fXaxis.IsAlphanumeric()) ||
+                            (fYaxis.CanExtend() && !fYaxis.IsAlphanumeric());
+   const Bool_t statOverflows = GetStatOverflowsBehaviour();
+   Int_t binsx[kFillNBatchSize], binsy[kFillNBatchSize];
+   for (Int_t first = 0; first < ntimes; first += kFillNBatchSize) {
+      const Int_t n = TMath::Min(kFillNBatchSize, ntimes - first);
+      const Double_t *xb = x + first * stride;
+      const Double_t *yb = y + first * stride;
+      const Double_t *wb = w ? w + first * stride : nullptr;
+      if (!canExtend) {
+         fXaxis.FindFixBins(n, xb, binsx, stride);
+         fYaxis.FindFixBins(n, yb, binsy, stride);
       }
-      if (biny == 0 || biny > fYaxis.GetNbins()) {
-         if (!GetStatOverflowsBehaviour()) continue;
+      for (i = 0; i < n; ++i) {
+         const Double_t xi = xb[i * stride];
+         const Double_t yi = yb[i * stride];
+         if (canExtend) {
+            // extending an axis renumbers the bins: find them one entry at a time
+            binsx[i] = fXaxis.FindBin(xi);
+            binsy[i] = fYaxis.FindBin(yi);
+         }
+         binx = binsx[i];
+         biny = binsy[i];
+         if (binx <0 || biny <0) continue;
+         bin  = biny*(fXaxis.GetNbins()+2) + binx;
+         const Double_t ww = wb ? wb[i * stride] : 1.;
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin,ww);
+         if (binx == 0 || binx > fXaxis.GetNbins() || biny == 0 || biny > fYaxis.GetNbins()) {
+            if (!statOverflows) continue;
+         }
+         fTsumw   += ww;
+         fTsumw2  += ww*ww;
+         fTsumwx  += ww*xi;
+         fTsumwx2 += ww*xi*xi;
+         fTsumwy  += ww*yi;
+         fTsumwy2 += ww*yi*yi;
+         fTsumwxy += ww*xi*yi;
       }
-      Double_t z= ww; //(ww > 0 ? ww : -ww);
-      fTsumw   += z;
-      fTsumw2  += z*z;
-      fTsumwx  += z*x[i];
-      fTsumwx2 += z*x[i]*x[i];
-      fTsumwy  += z*y[i];
-      fTsumwy2 += z*y[i]*y[i];
-      fTsumwxy += z*x[i]*y[i];
    }
 }
 
@@ -17,9 +17,163 @@
 #include "TList.h"
 #include "TMath.h"
 #include <cassert>
+#include <vector>
 
 ClassImp(TH2Poly);
 
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Quadtree over the bounding boxes of the bins of a TH2Poly, which finds the
+/// bin containing a point. Nodes are split where bins are dense, down to a few
+/// bins per leaf, so that large and small bins are both found quickly.
+///
+/// A bin is stored in the node whose area it covers completely, or else in the
+/// leaves it overlaps. The bins of a node are sorted by bin number: along the
+/// path from the root to the leaf of the point, the first bin of a node that
+/// contains the point is thus the first added among those of the node.
+
+class TH2PolyBinIndex {
+   struct Entry {
+      Double_t fXmin, fXmax, fYmin, fYmax; ///< Bounding box of the bin
+      Int_t fNumber;                       ///< Bin number
+      TH2PolyBin *fBin;
+   };
+   struct Node {
+      Double_t fXmid, fYmid; ///< Where the node is split into four children
+      Int_t fFirstChild;     ///< Index of the first of the four children, or -1 for a leaf
+      Int_t fBegin, fEnd;    ///< Range of the entries of the node in fEntries
+   };
+
+   static constexpr Int_t kMaxLeafSize = 8;
+   static constexpr Int_t kMaxDepth = 16;
+
+   Int_t fNBins;
+   std::vector<Node> fNodes;
+   std::vector<Entry> fEntries;
+
+   void Build(Int_t node, Double_t xmin, Double_t xmax, Double_t ymin, Double_t ymax, const std::vector<Entry> &bins,
+              const std::vector<Int_t> &candidates, Int_t depth);
+
+public:
+   TH2PolyBinIndex(TList *bins, Int_t nbins, Double_t xmin, Double_t xmax, Double_t ymin, Double_t ymax);
+   Int_t GetNBins() const { return fNBins; }
+   TH2PolyBin *FindBin(Double_t x, Double_t y) const;
+};
+
+constexpr Int_t TH2PolyBinIndex::kMaxLeafSize;
+constexpr Int_t TH2PolyBinIndex::kMaxDepth;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Builds the index of the bins (of which there are nbins) overlapping the
+/// rectangle [xmin, xmax] x [ymin, ymax].
+
+TH2PolyBinIndex::TH2PolyBinIndex(TList *bins, Int_t nbins, Double_t xmin, Double_t xmax, Double_t ymin, Double_t ymax)
+   : fNBins(nbins)
+{
+   std::vector<Entry> entries;
+   std::vector<Int_t> candidates;
+   if (bins) {
+      TIter next(bins);
+      while (auto bin = (TH2PolyBin *)next()) {
+         if (!bin->GetPolygon())
+            continue;
+         entries.push_back({bin->GetXMin(), bin->GetXMax(), bin->GetYMin(), bin->GetYMax(), bin->GetBinNumber(), bin});
+         const Entry &e = entries.back();
+         if (e.fXmin <= xmax && e.fXmax >= xmin && e.fYmin <= ymax && e.fYmax >= ymin)
+            candidates.push_back(entries.size() - 1);
+      }
+   }
+   fNodes.push_back(Node());
+   Build(0, xmin, xmax, ymin, ymax, entries, candidates, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stores the candidates, which overlap the area of the node, in the node or
+/// in its descendants.
+
+void TH2PolyBinIndex::Build(Int_t node, Double_t xmin, Double_t xmax, Double_t ymin, Double_t ymax,
+                            const std::vector<Entry> &bins, const std::vector<Int_t> &candidates, Int_t depth)
+{
+   const Double_t xmid = 0.5 * (xmin + xmax);
+   const Double_t ymid = 0.5 * (ymin + ymax);
+
+   // the bins covering the node are kept here, the others are split among the children
+   std::vector<Int_t> covering, rest;
+   for (auto i : candidates) {
+      const Entry &e = bins[i];
+      if (e.fXmin <= xmin && e.fXmax >= xmax && e.fYmin <= ymin && e.fYmax >= ymax)
+         covering.push_back(i);
+      else
+         rest.push_back(i);
+   }
+
+   std::vector<Int_t> children[4];
+   Bool_t split = (Int_t)rest.size() > kMaxLeafSize && depth < kMaxDepth;
+   if (split) {
+      for (auto i : rest) {
+         const Entry &e = bins[i];
+         for (Int_t k = 0; k < 4; ++k) {
+            const Bool_t overlapsX = (k & 1) ? e.fXmax >= xmid : e.fXmin <= xmid;
+            const Bool_t overlapsY = (k & 2) ? e.fYmax >= ymid : e.fYmin <= ymid;
+            if (overlapsX && overlapsY)
+               children[k].push_back(i);
+         }
+      }
+      const std::size_t nChildEntries =
+         children[0].size() + children[1].size() + children[2].size() + children[3].size();
+      // do not split if it mostly replicates the bins
+      split = nChildEntries < 2 * rest.size();
+   }
+
+   const std::vector<Int_t> &stored = split ? covering : candidates;
+   fNodes[node].fXmid = xmid;
+   fNodes[node].fYmid = ymid;
+   fNodes[node].fFirstChild = -1;
+   fNodes[node].fBegin = fEntries.size();
+   for (auto i : stored)
+      fEntries.push_back(bins[i]);
+   fNodes[node].fEnd = fEntries.size();
+   if (!split)
+      return;
+
+   const Int_t firstChild = fNodes.size();
+   fNodes[node].fFirstChild = firstChild;
+   fNodes.resize(fNodes.size() + 4);
+   for (Int_t k = 0; k < 4; ++k) {
+      Build(firstChild + k, (k & 1) ? xmid : xmin, (k & 1) ? xmax : xmid, (k & 2) ? ymid : ymin,
+            (k & 2) ? ymax : ymid, bins, children[k], depth + 1);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the first added bin containing (x,y), or nullptr if there is none.
+
+TH2PolyBin *TH2PolyBinIndex::FindBin(Double_t x, Double_t y) const
+{
+   const Entry *found = nullptr;
+   Int_t node = 0;
+   while (true) {
+      const Node &n = fNodes[node];
+      for (Int_t i = n.fBegin; i < n.fEnd; ++i) {
+         const Entry &e = fEntries[i];
+         if (found && e.fNumber >= found->fNumber)
+            break;
+         if (x >= e.fXmin && x <= e.fXmax && y >= e.fYmin && y <= e.fYmax && e.fBin->IsInside(x, y)) {
+            found = &e;
+            break;
+         }
+      }
+      if (n.fFirstChild < 0)
+         return found ? found->fBin : nullptr;
+      node = n.fFirstChild + (x >= n.fXmid ? 1 : 0) + (y >= n.fYmid ? 2 : 0);
+   }
+}
+
+} // namespace Internal
+} // namespace ROOT
+
 /** \class TH2Poly
     \ingroup Hist
 2D Histogram with Polygonal Bins
@@ -139,6 +293,17 @@ filling, it also adds a constant time delay into the code. When `Fill()`
 is to be called many times, it is more efficient to divide the histogram into
 a large number cells. However, if the histogram is to be filled only a few
 times, it is better to divide into a small number of cells.
+
+## Spatial index
+A uniform partition suits bins of similar sizes. When the bins have very
+different sizes, as in detector maps, most cells are either empty or
+intersect many bins. `Fill()`, `FillN()` and `FindBin()` therefore search the
+bins with an adaptive spatial index (a quadtree), whatever the partition: it
+stores the bounding box of each bin and splits its nodes where bins are
+dense, down to a few bins per node. `IsInside()` is then only called for the
+few bins whose bounding box contains the point. The index is built at the
+first search after bins were added, in a time proportional to the number of
+bins (times the depth of the tree).
 */
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -186,6 +351,7 @@ TH2Poly::~TH2Poly()
    delete[] fCells;
    delete[] fIsEmpty;
    delete[] fCompletelyInside;
+   delete fBinIndex;
    // delete at the end the bin List since it owns the objects
    delete fBins;
 }
@@ -256,6 +422,10 @@ Int_t TH2Poly::AddBin(TObject *poly)
    // Adds the bin to the partition matrix
    AddBinToPartition(bin);
 
+   // The index is rebuilt at the next search
+   delete fBinIndex;
+   fBinIndex = nullptr;
+
    return ibin;
 }
 
@@ -470,6 +640,10 @@ void TH2Poly::ChangePartition(Int_t n, Int_t m)
    while((obj = next())){   // Loop over bins and add them to the partition
       AddBinToPartition((TH2PolyBin*) obj);
    }
+
+   // The limits may have changed: the index is rebuilt at the next search
+   delete fBinIndex;
+   fBinIndex = nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -555,36 +729,31 @@ Int_t TH2Poly::FindBin(Double_t x, Double_t y, Double_t)
    else if (x > fXaxis.GetXmin()) overflow += -1;
    if (overflow != -5) return overflow;
 
-   // Finds the cell (x,y) coordinates belong to
-   Int_t n = (Int_t)(floor((x-fXaxis.GetXmin())/fStepX));
-   Int_t m = (Int_t)(floor((y-fYaxis.GetXmin())/fStepY));
-
-   // Make sure the array indices are correct.
-   if (n>=fCellX) n = fCellX-1;
-   if (m>=fCellY) m = fCellY-1;
-   if (n<0)       n = 0;
-   if (m<0)       m = 0;
+   TH2PolyBin *bin = FindBinInIndex(x, y);
 
-   if (fIsEmpty[n+fCellX*m]) return -5;
-
-   TH2PolyBin *bin;
+   // If the search has not returned a bin, the point must be on "the sea"
+   return bin ? bin->GetBinNumber() : -5;
+}
 
-   TIter next(&fCells[n+fCellX*m]);
-   TObject *obj;
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the first added bin containing (x,y), which must be within the
+/// histogram limits, or nullptr if there is none. The bins are searched with a
+/// spatial index of their bounding boxes, built at the first search after bins
+/// were added.
 
-   // Search for the bin in the cell
-   while ((obj=next())) {
-      bin  = (TH2PolyBin*)obj;
-      if (bin->IsInside(x,y)) return bin->GetBinNumber();
+TH2PolyBin *TH2Poly::FindBinInIndex(Double_t x, Double_t y)
+{
+   if (!fBinIndex || fBinIndex->GetNBins() != GetNumberOfBins()) {
+      delete fBinIndex;
+      fBinIndex = new ROOT::Internal::TH2PolyBinIndex(fBins, GetNumberOfBins(), fXaxis.GetXmin(), fXaxis.GetXmax(),
+                                                      fYaxis.GetXmin(), fYaxis.GetXmax());
    }
-
-   // If the search has not returned a bin, the point must be on "the sea"
-   return -5;
+   return fBinIndex->FindBin(x, y);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment the bin containing (x,y) by 1.
-/// Uses the partitioning algorithm.
+/// Uses the spatial index of the bins.
 
 Int_t TH2Poly::Fill(Double_t x, Double_t y)
 {
@@ -593,7 +762,7 @@ Int_t TH2Poly::Fill(Double_t x, Double_t y)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment the bin containing (x,y) by w.
-/// Uses the partitioning algorithm.
+/// Uses the spatial index of the bins.
 
 Int_t TH2Poly::Fill(Double_t x, Double_t y, Double_t w)
 {
@@ -621,57 +790,33 @@ Int_t TH2Poly::Fill(Double_t x, Double_t y, Double_t w)
       return overflow;
    }
 
-   // Finds the cell (x,y) coordinates belong to
-   Int_t n = (Int_t)(floor((x-fXaxis.GetXmin())/fStepX));
-   Int_t m = (Int_t)(floor((y-fYaxis.GetXmin())/fStepY));
-
-   // Make sure the array indices are correct.
-   if (n>=fCellX) n = fCellX-1;
-   if (m>=fCellY) m = fCellY-1;
-   if (n<0)       n = 0;
-   if (m<0)       m = 0;
-
-   if (fIsEmpty[n+fCellX*m]) {
+   TH2PolyBin *bin = FindBinInIndex(x, y);
+   if (!bin) {
       fOverflow[4]+= w;
       if (fSumw2.fN) fSumw2.fArray[4] += w*w;
       return -5;
    }
 
-   TH2PolyBin *bin;
-   Int_t bi;
-
-   TIter next(&fCells[n+fCellX*m]);
-   TObject *obj;
-
-   while ((obj=next())) {
-      bin  = (TH2PolyBin*)obj;
-      // needs to account offset in array for overflow bins
-      bi = bin->GetBinNumber()-1+kNOverflow;
-      if (bin->IsInside(x,y)) {
-         bin->Fill(w);
+   // needs to account offset in array for overflow bins
+   Int_t bi = bin->GetBinNumber()-1+kNOverflow;
+   bin->Fill(w);
 
-         // Statistics
-         fTsumw   = fTsumw + w;
-         fTsumw2  = fTsumw2 + w*w;
-         fTsumwx  = fTsumwx + w*x;
-         fTsumwx2 = fTsumwx2 + w*x*x;
-         fTsumwy  = fTsumwy + w*y;
-         fTsumwy2 = fTsumwy2 + w*y*y;
-         if (fSumw2.fN) {
-            assert(bi < fSumw2.fN);
-            fSumw2.fArray[bi] += w*w;
-         }
-         fEntries++;
-
-         SetBinContentChanged(kTRUE);
-
-         return bin->GetBinNumber();
-      }
+   // Statistics
+   fTsumw   = fTsumw + w;
+   fTsumw2  = fTsumw2 + w*w;
+   fTsumwx  = fTsumwx + w*x;
+   fTsumwx2 = fTsumwx2 + w*x*x;
+   fTsumwy  = fTsumwy + w*y;
+   fTsumwy2 = fTsumwy2 + w*y*y;
+   if (fSumw2.fN) {
+      assert(bi < fSumw2.fN);
+      fSumw2.fArray[bi] += w*w;
    }
+   fEntries++;
+
+   SetBinContentChanged(kTRUE);
 
-   fOverflow[4]+= w;
-   if (fSumw2.fN) fSumw2.fArray[4] += w*w;
-   return -5;
+   return bin->GetBinNumber();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -705,14 +850,22 @@ Int_t TH2Poly::Fill(const char* name, Double_t w)
 ///                      (array size must be ntimes*stride)
 /// \param [in] x:       array of x values to be histogrammed
 /// \param [in] y:       array of y values to be histogrammed
-/// \param [in] w:       array of weights
+/// \param [in] w:       array of weights, or nullptr for weights of 1
 /// \param [in] stride:  step size through arrays x, y and w
 
 void TH2Poly::FillN(Int_t ntimes, const Double_t* x, const Double_t* y,
                                const Double_t* w, Int_t stride)
 {
-   for (int i = 0; i < ntimes; i += stride) {
-      Fill(x[i], y[i], w[i]);
+   if (fNcells <= kNOverflow) return;
+
+   // derived classes may fill differently (e.g. TProfile2Poly), otherwise
+   // the virtual call is skipped
+   const Bool_t derived = IsA() != TH2Poly::Class();
+   for (Int_t i = 0; i < ntimes; ++i) {
+      const Int_t j = i * stride;
+      const Double_t wj = w ? w[j] : 1.;
+      if (derived) Fill(x[j], y[j], wj);
+      else         TH2Poly::Fill(x[j], y[j], wj);
    }
 }
 
@@ -986,6 +1139,7 @@ void TH2Poly::Initialize(Double_t xlow, Double_t xup,
    fDimension = 2;  //The dimension of the histogram
 
    fBins   = 0;
+   fBinIndex = nullptr;
    fNcells = kNOverflow;
 
    // Sets the boundaries of the histogram
@@ -20,6 +20,7 @@
 #include "TVirtualPad.h"
 #include "TVirtualHistPainter.h"
 #include "THLimitsFinder.h"
+#include "TH1Helper.h"
 #include "TRandom.h"
 #include "TError.h"
 #include "TMath.h"
@@ -199,23 +200,10 @@ Int_t TH3::BufferEmpty(Int_t action)
       fYaxis.GetXmax() <= fYaxis.GetXmin() ||
       fZaxis.GetXmax() <= fZaxis.GetXmin()) {
          //find min, max of entries in buffer
-         Double_t xmin = fBuffer[2];
-         Double_t xmax = xmin;
-         Double_t ymin = fBuffer[3];
-         Double_t ymax = ymin;
-         Double_t zmin = fBuffer[4];
-         Double_t zmax = zmin;
-         for (Int_t i=1;i<nbentries;i++) {
-            Double_t x = fBuffer[4*i+2];
-            if (x < xmin) xmin = x;
-            if (x > xmax) xmax = x;
-            Double_t y = fBuffer[4*i+3];
-            if (y < ymin) ymin = y;
-            if (y > ymax) ymax = y;
-            Double_t z = fBuffer[4*i+4];
-            if (z < zmin) zmin = z;
-            if (z > zmax) zmax = z;
-         }
+         Double_t xmin, xmax, ymin, ymax, zmin, zmax;
+         ROOT::TH1Helper::FindRange(nbentries, &fBuffer[2], 4, xmin, xmax);
+         ROOT::TH1Helper::FindRange(nbentries, &fBuffer[3], 4, ymin, ymax);
+         ROOT::TH1Helper::FindRange(nbentries, &fBuffer[4], 4, zmin, zmax);
          if (fXaxis.GetXmax() <= fXaxis.GetXmin() || fYaxis.GetXmax() <= fYaxis.GetXmin() || fZaxis.GetXmax() <= fZaxis.GetXmin()) {
             THLimitsFinder::GetLimitsFinder()->FindGoodLimits(this,xmin,xmax,ymin,ymax,zmin,zmax);
          } else {
@@ -231,11 +219,9 @@ Int_t TH3::BufferEmpty(Int_t action)
             fBufferSize = keep;
          }
    }
+   // FillN does not put the entries back in the buffer since fBuffer is zero
    fBuffer = 0;
-
-   for (Int_t i=0;i<nbentries;i++) {
-      Fill(buffer[4*i+2],buffer[4*i+3],buffer[4*i+4],buffer[4*i+1]);
-   }
+   FillN(nbentries,&buffer[2],&buffer[3],&buffer[4],&buffer[1],4);
    fBuffer = buffer;
 
    if (action > 0) { delete [] fBuffer; fBuffer = 0; fBufferSize = 0;}
@@ -648,6 +634,112 @@ Int_t TH3::Fill(Double_t x, Double_t y, const char *namez, Double_t w)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a 3-D histogram with an array of values and weights.
+///
+///  - ntimes:  number of entries in arrays x, y, z and w (array size must be ntimes*stride)
+///  - x:       array of x values to be histogrammed
+///  - y:       array of y values to be histogrammed
+///  - z:       array of z values to be histogrammed
+///  - w:       array of weights
+///  - stride:  step size through arrays x, y, z and w
+///
+///   - If the weight is not equal to 1, the storage of the sum of squares of
+///     weights is automatically triggered and the sum of the squares of weights is incremented
+///     by w[i]^2 in the bin corresponding to x[i],y[i],z[i].
+///   - If w is NULL each entry is assumed a weight=1
+///
+/// Unless an axis can be extended, the bins are found in batches of entries.
+
+void TH3::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w, Int_t stride)
+{
+   Int_t binx, biny, binz, bin, i;
+   Int_t ifirst = 0;
+
+   //If a buffer is activated, fill buffer
+   if (fBuffer) {
+      for (i=0;i<ntimes;i++) {
+         if (!fBuffer) break; // buffer can be deleted in BufferFill when is empty
+         BufferFill(x[i*stride],y[i*stride],z[i*stride],w ? w[i*stride] : 1.);
+      }
+      // fill the remaining entries if the buffer has been deleted
+      if (i < ntimes && fBuffer==0)
+         ifirst = i;
+      else
+         return;
+   }
+
+   ntimes -= ifirst;
+   x += ifirst * stride;
+   y += ifirst * stride;
+   z += ifirst * stride;
+   if (w) w += ifirst * stride;
+   fEntries += ntimes;
+   // the sums of squares of weights must exist before any bin is filled
+   if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+      for (i = 0; i < ntimes; ++i) {
+         if (w[i * stride] != 1.) {
+            Sumw2();
+            break;
+         }
+      }
+   }
+
+   // Unless filling can extend an axis (which changes the bin numbers), the bins are found in batches.
+   const Bool_t canExtend = (fXaxis.CanExtend() && !fXaxis.IsAlphanumeric()) ||
+                            (fYaxis.CanExtend() && !fYaxis.IsAlphanumeric()) ||
+                            (fZaxis.CanExtend() && !fZaxis.IsAlphanumeric());
+   const Bool_t statOverflows = GetStatOverflowsBehaviour();
+   Int_t binsx[kFillNBatchSize], binsy[kFillNBatchSize], binsz[kFillNBatchSize];
+   for (Int_t first = 0; first < ntimes; first += kFillNBatchSize) {
+      const Int_t n = TMath::Min(kFillNBatchSize, ntimes - first);
+      const Double_t *xb = x + first * stride;
+      const Double_t *yb = y + first * stride;
+      const Double_t *zb = z + first * stride;
+      const Double_t *wb = w ? w + first * stride : nullptr;
+      if (!canExtend) {
+         fXaxis.FindFixBins(n, xb, binsx, stride);
+         fYaxis.FindFixBins(n, yb, binsy, stride);
+         fZaxis.FindFixBins(n, zb, binsz, stride);
+      }
+      for (i = 0; i < n; ++i) {
+         const Double_t xi = xb[i * stride];
+         const Double_t yi = yb[i * stride];
+         const Double_t zi = zb[i * stride];
+         if (canExtend) {
+            // extending an axis renumbers the bins: find them one entry at a time
+            binsx[i] = fXaxis.FindBin(xi);
+            binsy[i] = fYaxis.FindBin(yi);
+            binsz[i] = fZaxis.FindBin(zi);
+         }
+         binx = binsx[i];
+         biny = binsy[i];
+         binz = binsz[i];
+         if (binx <0 || biny <0 || binz<0) continue;
+         bin  =  binx + (fXaxis.GetNbins()+2)*(biny + (fYaxis.GetNbins()+2)*binz);
+         const Double_t ww = wb ? wb[i * stride] : 1.;
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin,ww);
+         if (binx == 0 || binx > fXaxis.GetNbins() || biny == 0 || biny > fYaxis.GetNbins() ||
+             binz == 0 || binz > fZaxis.GetNbins()) {
+            if (!statOverflows) continue;
+         }
+         fTsumw   += ww;
+         fTsumw2  += ww*ww;
+         fTsumwx  += ww*xi;
+         fTsumwx2 += ww*xi*xi;
+         fTsumwy  += ww*yi;
+         fTsumwy2 += ww*yi*yi;
+         fTsumwxy += ww*xi*yi;
+         fTsumwz  += ww*zi;
+         fTsumwz2 += ww*zi*zi;
+         fTsumwxz += ww*xi*zi;
+         fTsumwyz += ww*yi*zi;
+      }
+   }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Fill histogram following distribution in function fname.
 ///
@@ -214,9 +214,10 @@ void THn::Sumw2() {
    }
    // fill sumw2 array with current content
    TNDArray & content = GetArray();
+   TNDArray & sumw2 = GetSumw2Array();
    Long64_t nbins = GetNbins();
    for (Long64_t ibin = 0; ibin < nbins; ++ibin)
-      fSumw2.At(ibin) = content.AtAsDouble(ibin);
+      sumw2.SetAsDouble(ibin, content.AtAsDouble(ibin));
 }
 
 
@@ -236,7 +237,7 @@ void THn::InitStorage(Int_t* nbins, Int_t /*chunkSize*/)
 {
    fCoordBuf = new Int_t[fNdimensions]();
    GetArray().Init(fNdimensions, nbins, true /*addOverflow*/);
-   fSumw2.Init(fNdimensions, nbins, true /*addOverflow*/);
+   GetSumw2Array().Init(fNdimensions, nbins, true /*addOverflow*/);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -245,5 +246,5 @@ void THn::InitStorage(Int_t* nbins, Int_t /*chunkSize*/)
 void THn::Reset(Option_t* option /*= ""*/)
 {
    GetArray().Reset(option);
-   fSumw2.Reset(option);
+   GetSumw2Array().Reset(option);
 }
@@ -22,6 +22,12 @@
  
  The algorithm is briefly described in (4). A binned version is also implemented to address the 
  performance issue due to its data size dependance.
+
+ With the binned version, the estimate can be computed at all bin centres at once as the convolution of the bin
+ counts with the kernel, using a FFT (see TKDE::SetUseFFT). With a fixed bandwidth the estimate is then
+ interpolated linearly between the bin centres, otherwise the FFT is used to compute the pilot estimate of the
+ adaptive bandwidths. Several points can be evaluated with TKDE::GetValues, in parallel if implicit
+ multi-threading is enabled.
  */
 
 
@@ -30,6 +36,7 @@
 #include <numeric>
 #include <limits>
 #include <cassert>
+#include <memory>
 
 #include "Math/Error.h"
 #include "TMath.h"
@@ -41,8 +48,15 @@
 #include "TF1.h"
 #include "TH1.h"
 #include "TVirtualPad.h"
+#include "TVirtualFFT.h"
+#include "TROOT.h"
 #include "TKDE.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
 
 ClassImp(TKDE);
 
@@ -50,10 +64,14 @@ class TKDE::TKernel {
    TKDE* fKDE;
    UInt_t fNWeights; // Number of kernel weights (bandwidth as vectorized for binning)
    std::vector<Double_t> fWeights; // Kernel weights (bandwidth)
+   std::vector<Double_t> fBinnedValues; // Estimate at the bin centres computed with a FFT, empty if not used
+   Double_t Evaluate(Double_t x) const;
 public:
    TKernel(Double_t weight, TKDE* kde);
    void ComputeAdaptiveWeights();
+   Bool_t ComputeBinnedValues();
    Double_t operator()(Double_t x) const;
+   void Evaluate(UInt_t n, const Double_t* x, Double_t* y) const;
    Double_t GetWeight(Double_t x) const;
    Double_t GetFixedWeight() const;
    const std::vector<Double_t> & GetAdaptiveWeights() const;
@@ -78,7 +96,7 @@ TKDE::TKDE() :
    fApproximateBias(nullptr),
    fGraph(nullptr),
    fUseMirroring(false), fMirrorLeft(false), fMirrorRight(false), fAsymLeft(false), fAsymRight(false),
-   fUseBins(false), fNewData(false), fUseMinMaxFromData(false),
+   fUseBins(false), fNewData(false), fUseMinMaxFromData(false), fUseFFT(false),
    fNBins(0), fNEvents(0), fSumOfCounts(0), fUseBinsNEvents(0),
    fMean(0.),fSigma(0.), fSigmaRob(0.), fXMin(0.), fXMax(0.),
    fRho(0.), fAdaptiveBandwidthFactor(0.), fWeightSize(0)
@@ -111,6 +129,7 @@ void TKDE::Instantiate(KernelFunction_Ptr kernfunc, UInt_t events, const Double_
    fNewData = false;
    fUseMirroring = false; fMirrorLeft = false; fMirrorRight = false;
    fAsymLeft = false; fAsymRight = false; 
+   fUseFFT = false;
    fNBins = events < 10000 ? 100 : events / 10;
    fNEvents = events;
    fUseBinsNEvents = 10000;
@@ -396,6 +415,16 @@ void TKDE::SetRange(Double_t xMin, Double_t xMax) {
    SetKernel();
 }
 
+void TKDE::SetUseFFT(Bool_t on) {
+   // Sets User option for computing the binned estimate with a FFT convolution of the bin counts with the kernel,
+   // in O(M log M) instead of O(M^2) operations for M bins. It is used only with the binned option and without
+   // asymmetric mirroring. With a fixed bandwidth the estimate is interpolated linearly between the bin centres.
+   // With an adaptive bandwidth the FFT is used for the pilot (fixed bandwidth) estimate only.
+   // Requires the FFTW plugin of TVirtualFFT: if it is not available the estimate is computed directly.
+   fUseFFT = on;
+   SetKernel();
+}
+
 // private methods
 
 void TKDE::SetUseBins() {
@@ -570,6 +599,9 @@ void TKDE::SetKernel() {
    weight *= fRho * fCanonicalBandwidths[fKernelType] / fCanonicalBandwidths[kGaussian];
    if (fKernel) delete fKernel;
    fKernel = new TKernel(weight, this);
+   if (fUseFFT && fUseBins && !fAsymLeft && !fAsymRight && n > 1 && fBinCount.size() == n) {
+      fKernel->ComputeBinnedValues();
+   }
    if (fIteration == kAdaptive) {
       fKernel->ComputeAdaptiveWeights();
    }
@@ -699,6 +731,20 @@ Double_t TKDE::operator()(Double_t x) const {
    return (*fKernel)(x);
 }
 
+void TKDE::GetValues(UInt_t n, const Double_t* x, Double_t* y) const {
+   // Returns in y the kernel density estimate at the n points x.
+   // The points are evaluated in parallel if implicit multi-threading is enabled, unless the kernel is user defined
+   if (!fKernel) {
+      (const_cast<TKDE*>(this))->ReInit();
+      // in case of failed re-initialization
+      if (!fKernel) {
+         std::fill(y, y + n, TMath::QuietNaN());
+         return;
+      }
+   }
+   fKernel->Evaluate(n, x, y);
+}
+
 Double_t TKDE::GetMean() const {
    // return the mean of the data
    if (fNewData) (const_cast<TKDE*>(this))->InitFromNewData();
@@ -731,11 +777,21 @@ void TKDE::TKernel::ComputeAdaptiveWeights() {
    unsigned int n = fKDE->fData.size();
    assert( n == weights.size() );
    bool useDataWeights = (fKDE->fBinCount.size() == n); 
+   // pilot estimate, with the fixed bandwidth, at the data points
+   std::vector<Double_t> pilot;
+   if (fBinnedValues.size() == n) {
+      pilot.swap(fBinnedValues);
+   } else {
+      pilot.resize(n);
+      Evaluate(n, fKDE->fData.data(), pilot.data());
+   }
+   // the binned values are not valid with the adaptive bandwidths
+   fBinnedValues.clear();
    Double_t f = 0.0;
    for (unsigned int i = 0; i < n; ++i) { 
 //   for (; weight != weights.end(); ++weight, ++data, ++dataW) {
       if (useDataWeights && fKDE->fBinCount[i] <= 0) continue;  // skip negative or null weights
-      f = (*fKDE->fKernel)(fKDE->fData[i]);
+      f = pilot[i];
       if (f <= 0)
          fKDE->Warning("ComputeAdativeWeights","function value is zero or negative for x = %f w = %f",
                        fKDE->fData[i],(useDataWeights) ? fKDE->fBinCount[i] : 1.);
@@ -768,7 +824,7 @@ void TKDE::SetBinCountData() {
    // Returns the bins' count from the data for using with the binned option
    // or set the bin count to the weights in case of weighted data
    if (fUseBins) { 
-      fBinCount.resize(fNBins);
+      fBinCount.assign(fNBins, 0.0);
       fSumOfCounts = 0;
       // case of weighted events 
       if (!fEventWeights.empty() ) { 
@@ -870,7 +926,9 @@ TGraphErrors* TKDE::GetGraphWithErrors(UInt_t npx, double xmin, double xmax) {
    Double_t* ey = new Double_t[n + 1];
    for (UInt_t i = 0; i <= n; ++i) {
       x[i] = xmin + i * (xmax - xmin) / n;
-      y[i] = (*this)(x[i]);
+   }
+   GetValues(n + 1, x, y);
+   for (UInt_t i = 0; i <= n; ++i) {
       ex[i] = 0;
       ey[i] = this->GetError(x[i]);
    }
@@ -930,8 +988,105 @@ const std::vector<Double_t> & TKDE::TKernel::GetAdaptiveWeights() const {
    return fWeights;
 }
 
+Bool_t TKDE::TKernel::ComputeBinnedValues() {
+   // Computes the estimate with the fixed bandwidth at the bin centres, as the convolution of the bin counts with
+   // the kernel sampled at the distances between the bin centres, using a FFT. Returns false if the FFT is not
+   // available.
+   const std::vector<Double_t> &centres = fKDE->fData;
+   const Int_t m = centres.size();
+   const Double_t binWidth = centres[1] - centres[0];
+   const Double_t weight = fWeights[0];
+   // number of bins on each side of a bin where the kernel is not null
+   Int_t l = m - 1;
+   if (fKDE->fKernelType != kUserDefined) {
+      const Double_t support = (fKDE->fKernelType == kGaussian) ? 9. : 1.;
+      l = std::min(l, Int_t(std::ceil(support * weight / binWidth)));
+   }
+   // the transforms are long enough for the bins with a count not to wrap around onto the first ones
+   Int_t size = m + l;
+
+   std::unique_ptr<TVirtualFFT> fftCounts(TVirtualFFT::FFT(1, &size, "R2C ES K"));
+   std::unique_ptr<TVirtualFFT> fftKernel(TVirtualFFT::FFT(1, &size, "R2C ES K"));
+   std::unique_ptr<TVirtualFFT> fftInverse(TVirtualFFT::FFT(1, &size, "C2R ES K"));
+   if (!fftCounts || !fftKernel || !fftInverse) {
+      fKDE->Warning("ComputeBinnedValues", "Cannot use FFT, probably FFTW package is not available. "
+                    "Switch to direct evaluation");
+      return kFALSE;
+   }
+   for (Int_t i = 0; i < size; ++i) {
+      fftCounts->SetPoint(i, i < m ? fKDE->fBinCount[i] : 0.);
+      fftKernel->SetPoint(i, 0.);
+   }
+   // kernel at distance d, stored at index d for d >= 0 and size + d for d < 0
+   for (Int_t d = 0; d <= l; ++d) {
+      const Double_t k = (*fKDE->fKernelFunction)(d * binWidth / weight) / weight;
+      fftKernel->SetPoint(d, k);
+      if (d > 0)
+         fftKernel->SetPoint(size - d, (*fKDE->fKernelFunction)(-d * binWidth / weight) / weight);
+   }
+   fftCounts->Transform();
+   fftKernel->Transform();
+   Double_t re1, im1, re2, im2;
+   for (Int_t i = 0; i <= size / 2; ++i) {
+      fftCounts->GetPointComplex(i, re1, im1);
+      fftKernel->GetPointComplex(i, re2, im2);
+      fftInverse->SetPoint(i, re1 * re2 - im1 * im2, re1 * im2 + re2 * im1);
+   }
+   fftInverse->Transform();
+
+   // the inverse transform is not normalized
+   const Double_t norm = 1. / (size * fKDE->fSumOfCounts);
+   fBinnedValues.resize(m);
+   for (Int_t i = 0; i < m; ++i) {
+      // remove the negative round-off errors of the tails
+      fBinnedValues[i] = std::max(0., fftInverse->GetPointReal(i) * norm);
+   }
+   return kTRUE;
+}
+
+void TKDE::TKernel::Evaluate(UInt_t n, const Double_t* x, Double_t* y) const {
+   // Evaluates the kernel density estimate at n points, in parallel if implicit multi-threading is enabled.
+   // User defined kernels are always evaluated sequentially, since they may not be thread safe
+   auto evaluateRange = [&](UInt_t begin, UInt_t end) {
+      for (UInt_t i = begin; i < end; ++i)
+         y[i] = Evaluate(x[i]);
+   };
+#ifdef R__USE_IMT
+   // minimum number of kernel evaluations done by a task
+   const Double_t kMinTermsPerTask = 1 << 20;
+   const Double_t nTerms = fBinnedValues.empty() ? Double_t(n) * fKDE->fData.size() : n;
+   if (ROOT::IsImplicitMTEnabled() && fKDE->fKernelType != kUserDefined && nTerms >= 2 * kMinTermsPerTask) {
+      ROOT::TThreadExecutor pool;
+      const UInt_t nChunks = std::min<Double_t>(std::min(pool.GetPoolSize(), n), nTerms / kMinTermsPerTask);
+      const UInt_t chunkSize = (n + nChunks - 1) / nChunks;
+      auto evaluateChunk = [&](UInt_t chunk) {
+         const UInt_t begin = chunk * chunkSize;
+         evaluateRange(begin, std::min(n, begin + chunkSize));
+      };
+      pool.Foreach(evaluateChunk, ROOT::TSeq<UInt_t>(nChunks));
+      return;
+   }
+#endif
+   evaluateRange(0, n);
+}
+
 Double_t TKDE::TKernel::operator()(Double_t x) const {
    // The internal class's unary function: returns the kernel density estimate
+   return Evaluate(x);
+}
+
+Double_t TKDE::TKernel::Evaluate(Double_t x) const {
+   // Returns the kernel density estimate, interpolated between the bin centres if it was computed with a FFT
+   if (!fBinnedValues.empty()) {
+      const std::vector<Double_t> &centres = fKDE->fData;
+      const Double_t t = (x - centres.front()) / (centres[1] - centres[0]);
+      const Int_t m = fBinnedValues.size();
+      if (t >= 0. && t <= m - 1) {
+         const Int_t i = std::min(Int_t(t), m - 2);
+         const Double_t frac = t - i;
+         return (1. - frac) * fBinnedValues[i] + frac * fBinnedValues[i + 1];
+      }
+   }
    Double_t result(0.0);
    UInt_t n = fKDE->fData.size();
    // case of bins or weighted data 
@@ -676,6 +676,29 @@ void TMultiDimFit::AddRow(const Double_t *x, Double_t D, Double_t E)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add nRows rows to the training sample, as TMultiDimFit::AddRow. The
+/// variable j of row i is `x[i * fNVariables + j]`, its dependent quantity
+/// is D[i] and its square error E[i]. E can be null if no errors are given.
+/// The storage of the sample is extended once for all the rows.
+
+void TMultiDimFit::AddRows(const Double_t *x, const Double_t *D, const Double_t *E, Int_t nRows)
+{
+   if (!x || !D || nRows <= 0)
+      return;
+
+   const Int_t nTot = fSampleSize + nRows;
+   if (nTot > fQuantity.GetNrows()) {
+      fQuantity.ResizeTo(nTot);
+      fSqError.ResizeTo(nTot);
+   }
+   if (nTot * fNVariables > fVariables.GetNrows())
+      fVariables.ResizeTo(nTot * fNVariables);
+
+   for (Int_t i = 0; i < nRows; i++)
+      AddRow(x + Long64_t(i) * fNVariables, D[i], E ? E[i] : 0);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Add a row consisting of fNVariables independent variables, the
 /// known, dependent quantity, and optionally, the square error in
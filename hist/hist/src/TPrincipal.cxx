@@ -204,6 +204,27 @@ This is an orthogonal transformation, or rotation, of the pattern
 space and feature selection results in ignoring certain coordinates
 in the transformed space.
 
+Large samples are better added with TPrincipal::AddRows, which computes
+the moments of blocks of rows, in parallel if implicit multi-threading is
+enabled, and merges them with the running moments. The TPrincipal objects
+filled by different threads can be combined with TPrincipal::Merge, e.g.
+when filling one object per slot of an RDataFrame:
+~~~ {.cpp}
+   ROOT::RDataFrame df("tree", "file.root");
+   std::vector<std::unique_ptr<TPrincipal>> pcas;
+   for (unsigned int i = 0; i < df.GetNSlots(); ++i)
+      pcas.emplace_back(new TPrincipal(2, "N"));
+   df.ForeachSlot([&](unsigned int slot, double x, double y) {
+      const double row[] = {x, y};
+      pcas[slot]->AddRow(row);
+   }, {"x", "y"});
+   TList others;
+   for (unsigned int i = 1; i < pcas.size(); ++i)
+      others.Add(pcas[i].get());
+   pcas[0]->Merge(&others);
+   pcas[0]->MakePrincipals();
+~~~
+
 Christian Holm August 2000, CERN
 */
 
@@ -220,6 +241,14 @@ Christian Holm August 2000, CERN
 #include "TROOT.h"
 #include "Riostream.h"
 
+#include <algorithm>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
 
 ClassImp(TPrincipal);
 
@@ -451,6 +480,158 @@ void TPrincipal::AddRow(const Double_t *p)
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add nRows data points, stored one after the other in x, i.e. the
+/// variable j of row i is `x[i * fNumberOfVariables + j]`.
+///
+/// The result is the same as calling TPrincipal::AddRow for each row, but
+/// the mean values and the covariances of blocks of rows are computed first
+/// and then merged with the ones of the previous rows. The blocks are
+/// processed in parallel if implicit multi-threading is enabled.
+
+void TPrincipal::AddRows(const Double_t *x, Int_t nRows)
+{
+   if (!x || nRows <= 0)
+      return;
+
+   const Int_t nVar = fNumberOfVariables;
+   const Int_t nM2 = nVar * (nVar + 1) / 2;
+
+   // Two-pass computation of the mean values and of the co-moments, i.e.
+   // the sums of the products of the deviations from the mean, of the rows
+   // [begin, end), the co-moments being stored as a packed lower triangle
+   auto computeMoments = [=](Int_t begin, Int_t end, Double_t *mean, Double_t *m2) {
+      std::fill(mean, mean + nVar, 0.);
+      std::fill(m2, m2 + nM2, 0.);
+      for (Int_t r = begin; r < end; r++)
+         for (Int_t i = 0; i < nVar; i++)
+            mean[i] += x[Long64_t(r) * nVar + i];
+      for (Int_t i = 0; i < nVar; i++)
+         mean[i] /= (end - begin);
+      std::vector<Double_t> d(nVar);
+      for (Int_t r = begin; r < end; r++) {
+         for (Int_t i = 0; i < nVar; i++)
+            d[i] = x[Long64_t(r) * nVar + i] - mean[i];
+         for (Int_t i = 0, k = 0; i < nVar; i++)
+            for (Int_t j = 0; j <= i; j++, k++)
+               m2[k] += d[i] * d[j];
+      }
+   };
+
+   // Number of rows of a block, which bounds the loss of precision of its first pass
+   const Int_t kBlockSize = 1 << 16;
+   const Int_t nBlocks = (nRows + kBlockSize - 1) / kBlockSize;
+   std::vector<Double_t> means(Long64_t(nBlocks) * nVar);
+   std::vector<Double_t> m2s(Long64_t(nBlocks) * nM2);
+   auto computeBlock = [&](Int_t block) {
+      computeMoments(block * kBlockSize, std::min(nRows, (block + 1) * kBlockSize),
+                     &means[Long64_t(block) * nVar], &m2s[Long64_t(block) * nM2]);
+   };
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && nBlocks > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(computeBlock, ROOT::TSeq<Int_t>(nBlocks));
+   } else
+#endif
+   {
+      for (Int_t block = 0; block < nBlocks; block++)
+         computeBlock(block);
+   }
+
+   // Merge the blocks in order, so that the result does not depend on the threads
+   for (Int_t block = 0; block < nBlocks; block++) {
+      const Int_t n = std::min(nRows, (block + 1) * kBlockSize) - block * kBlockSize;
+      AddMoments(n, &means[Long64_t(block) * nVar], &m2s[Long64_t(block) * nM2]);
+   }
+
+   if (!fStoreData)
+      return;
+   Int_t size = fUserData.GetNrows();
+   if (fNumberOfDataPoints * fNumberOfVariables > size)
+      fUserData.ResizeTo(std::max(fNumberOfDataPoints * fNumberOfVariables, size + size/2));
+   std::copy(x, x + Long64_t(nRows) * nVar,
+             fUserData.GetMatrixArray() + Long64_t(fNumberOfDataPoints - nRows) * nVar);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge the mean values and the co-moments (the sums of the products of the
+/// deviations from the mean, as a packed lower triangle) of n data points
+/// into the mean values and the covariance matrix, with the pairwise update
+/// of Chan, Golub and LeVeque.
+
+void TPrincipal::AddMoments(Long64_t n, const Double_t *mean, const Double_t *m2)
+{
+   if (n <= 0)
+      return;
+
+   const Long64_t nA = fNumberOfDataPoints;
+   const Double_t nTot = nA + n;
+   std::vector<Double_t> delta(fNumberOfVariables);
+   for (Int_t i = 0; i < fNumberOfVariables; i++) {
+      delta[i] = mean[i] - (nA ? fMeanValues(i) : 0.);
+      fMeanValues(i) = nA ? fMeanValues(i) + delta[i] * n / nTot : mean[i];
+   }
+
+   const Double_t cor = Double_t(nA) * n / nTot;
+   for (Int_t i = 0, k = 0; i < fNumberOfVariables; i++) {
+      for (Int_t j = 0; j <= i; j++, k++) {
+         // The covariance matrix is the co-moment divided by the number of points
+         fCovarianceMatrix(i,j) = (fCovarianceMatrix(i,j) * nA + m2[k] + delta[i] * delta[j] * cor) / nTot;
+      }
+   }
+
+   fNumberOfDataPoints += n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge the data points of the TPrincipal objects in list into this one.
+/// They must have the same number of variables, and their principal
+/// components must not be computed yet. Returns the total number of data points.
+
+Long64_t TPrincipal::Merge(TCollection *list)
+{
+   if (!list)
+      return fNumberOfDataPoints;
+
+   const Int_t nM2 = fNumberOfVariables * (fNumberOfVariables + 1) / 2;
+   std::vector<Double_t> mean(fNumberOfVariables), m2(nM2);
+   TIter next(list);
+   while (TObject *obj = next()) {
+      TPrincipal *other = dynamic_cast<TPrincipal *>(obj);
+      if (!other || other == this)
+         continue;
+      if (other->fNumberOfVariables != fNumberOfVariables) {
+         Error("Merge", "Cannot merge %s with %d variables into %s with %d variables", other->GetName(),
+               other->fNumberOfVariables, GetName(), fNumberOfVariables);
+         return -1;
+      }
+      const Int_t nOther = other->fNumberOfDataPoints;
+      if (nOther == 0)
+         continue;
+
+      for (Int_t i = 0, k = 0; i < fNumberOfVariables; i++) {
+         mean[i] = other->fMeanValues(i);
+         for (Int_t j = 0; j <= i; j++, k++)
+            m2[k] = other->fCovarianceMatrix(i,j) * nOther;
+      }
+      AddMoments(nOther, mean.data(), m2.data());
+
+      if (fStoreData && other->fStoreData) {
+         Int_t size = fUserData.GetNrows();
+         if (fNumberOfDataPoints * fNumberOfVariables > size)
+            fUserData.ResizeTo(std::max(fNumberOfDataPoints * fNumberOfVariables, size + size/2));
+         std::copy(other->fUserData.GetMatrixArray(),
+                   other->fUserData.GetMatrixArray() + Long64_t(nOther) * fNumberOfVariables,
+                   fUserData.GetMatrixArray() + Long64_t(fNumberOfDataPoints - nOther) * fNumberOfVariables);
+      } else if (fStoreData) {
+         Warning("Merge", "%s does not store its data, the data of %s is incomplete", other->GetName(), GetName());
+         fStoreData = kFALSE;
+      }
+   }
+   return fNumberOfDataPoints;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Browse the TPrincipal object in the TBrowser.
 
@@ -85,6 +85,17 @@ TSpline& TSpline::operator=(const TSpline &sp)
    return *this;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate this spline at the n points x, storing the values in result.
+/// The derived classes reuse the interval of a point as starting point for the search
+/// of the next one, which is faster than calling Eval() for sorted or clustered points.
+
+void TSpline::EvalBatch(Int_t n, const Double_t *x, Double_t *result) const
+{
+   for (Int_t i = 0; i < n; ++i)
+      result[i] = Eval(x[i]);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Draw this function with its current attributes.
 ///
@@ -780,6 +791,22 @@ Int_t TSpline3::FindX(Double_t x) const
    return klow;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Find X, starting from the interval hint, e.g. the interval of the previous point.
+/// The interval hint and the next one are tested before falling back to the
+/// binary search, and the result is the same as FindX(x).
+
+Int_t TSpline3::FindX(Double_t x, Int_t hint) const
+{
+   if (!fKstep && x > fXmin && x < fXmax && hint >= 0 && hint < fNp-1 && x > fPoly[hint].X()) {
+      if (x <= fPoly[hint+1].X())
+         return hint;
+      if (hint+2 < fNp && x <= fPoly[hint+2].X())
+         return hint+1;
+   }
+   return FindX(x);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Eval this spline at x.
 
@@ -790,6 +817,39 @@ Double_t TSpline3::Eval(Double_t x) const
    return fPoly[klow].Eval(x);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Eval this spline at the n points x, storing the values in result.
+/// The search of the interval of each point starts from the interval of the
+/// previous point. The coefficients of the polynomials are gathered by blocks
+/// of points, so that the compiler can vectorize their evaluation.
+
+void TSpline3::EvalBatch(Int_t n, const Double_t *x, Double_t *result) const
+{
+   const Int_t kBlock = 64;
+   Double_t x0[kBlock], y[kBlock], b[kBlock], c[kBlock], d[kBlock];
+   Int_t hint = 0;
+   for (Int_t start = 0; start < n; start += kBlock) {
+      const Int_t m = TMath::Min(kBlock, n-start);
+      const Double_t *xb = x+start;
+      for (Int_t i = 0; i < m; ++i) {
+         hint = FindX(xb[i], hint);
+         Int_t klow = hint;
+         if (klow >= fNp-1 && fNp > 1) klow = fNp-2;
+         TSplinePoly3 &poly = fPoly[klow];
+         x0[i] = poly.X();
+         y[i] = poly.Y();
+         b[i] = poly.B();
+         c[i] = poly.C();
+         d[i] = poly.D();
+      }
+      Double_t *rb = result+start;
+      for (Int_t i = 0; i < m; ++i) {
+         const Double_t dx = xb[i]-x0[i];
+         rb[i] = y[i]+dx*(b[i]+dx*(c[i]+dx*d[i]));
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Derivative.
 
@@ -1556,6 +1616,22 @@ Int_t TSpline5::FindX(Double_t x) const
    return klow;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Find X, starting from the interval hint, e.g. the interval of the previous point.
+/// The interval hint and the next one are tested before falling back to the
+/// binary search, and the result is the same as FindX(x).
+
+Int_t TSpline5::FindX(Double_t x, Int_t hint) const
+{
+   if (!fKstep && x > fXmin && x < fXmax && hint >= 0 && hint < fNp-1 && x > fPoly[hint].X()) {
+      if (x <= fPoly[hint+1].X())
+         return hint;
+      if (hint+2 < fNp && x <= fPoly[hint+2].X())
+         return hint+1;
+   }
+   return FindX(x);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Eval this spline at x.
 
@@ -1565,6 +1641,39 @@ Double_t TSpline5::Eval(Double_t x) const
    return fPoly[klow].Eval(x);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Eval this spline at the n points x, storing the values in result.
+/// The search of the interval of each point starts from the interval of the
+/// previous point. The coefficients of the polynomials are gathered by blocks
+/// of points, so that the compiler can vectorize their evaluation.
+
+void TSpline5::EvalBatch(Int_t n, const Double_t *x, Double_t *result) const
+{
+   const Int_t kBlock = 64;
+   Double_t x0[kBlock], y[kBlock], b[kBlock], c[kBlock], d[kBlock], e[kBlock], f[kBlock];
+   Int_t hint = 0;
+   for (Int_t start = 0; start < n; start += kBlock) {
+      const Int_t m = TMath::Min(kBlock, n-start);
+      const Double_t *xb = x+start;
+      for (Int_t i = 0; i < m; ++i) {
+         hint = FindX(xb[i], hint);
+         TSplinePoly5 &poly = fPoly[hint];
+         x0[i] = poly.X();
+         y[i] = poly.Y();
+         b[i] = poly.B();
+         c[i] = poly.C();
+         d[i] = poly.D();
+         e[i] = poly.E();
+         f[i] = poly.F();
+      }
+      Double_t *rb = result+start;
+      for (Int_t i = 0; i < m; ++i) {
+         const Double_t dx = xb[i]-x0[i];
+         rb[i] = y[i]+dx*(b[i]+dx*(c[i]+dx*(d[i]+dx*(e[i]+dx*f[i]))));
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Derivative.
 
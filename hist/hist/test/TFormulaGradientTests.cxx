@@ -21,6 +21,7 @@
 #include <TFormula.h>
 #include <TF1.h>
 #include <TFitResult.h>
+#include <TH1.h>
 
 TEST(TFormulaGradientPar, Sanity)
 {
@@ -82,8 +83,10 @@ TEST(TFormulaGradientPar, GausCrossCheck)
    TFormula::GradientStorage result_clad(3);
    h->GetFormula()->GradientPar(x, result_clad);
 
+   // TF1::GradientPar(x, grad) returns the generated gradient, compare with the numerical derivatives
    TFormula::GradientStorage result_num(3);
-   h->GradientPar(x, result_num.data());
+   for (int i = 0; i < 3; ++i)
+      result_num[i] = h->GradientPar(i, x);
 
    ASSERT_FLOAT_EQ(result_num[0], result_clad[0]);
    ASSERT_FLOAT_EQ(result_num[1], result_clad[1]);
@@ -99,8 +102,10 @@ TEST(TFormulaGradientPar, BreitWignerCrossCheck)
    TFormula::GradientStorage result_clad(3);
    TFormula* formula = h->GetFormula();
    formula->GradientPar(x, result_clad);
+   // TF1::GradientPar(x, grad) returns the generated gradient, compare with the numerical derivatives
    TFormula::GradientStorage result_num(3);
-   h->GradientPar(x, result_num.data());
+   for (int i = 0; i < 3; ++i)
+      result_num[i] = h->GradientPar(i, x);
 
    ASSERT_FLOAT_EQ(result_num[0], result_clad[0]);
    ASSERT_FLOAT_EQ(result_num[1], result_clad[1]);
@@ -116,8 +121,10 @@ TEST(TFormulaGradientPar, BreitWignerCrossCheckAccuracyDemo)
    TFormula::GradientStorage result_clad(3);
    TFormula* formula = h->GetFormula();
    formula->GradientPar(x, result_clad);
+   // TF1::GradientPar(x, grad) returns the generated gradient, compare with the numerical derivatives
    TFormula::GradientStorage result_num(3);
-   h->GradientPar(x, result_num.data());
+   for (int i = 0; i < 3; ++i)
+      result_num[i] = h->GradientPar(i, x);
 
    // This is a classical example why clad is better.
    // The gradient with respect to gamma leads to a cancellation when gamma is
@@ -129,6 +136,68 @@ TEST(TFormulaGradientPar, BreitWignerCrossCheckAccuracyDemo)
    EXPECT_NEAR(0, result_num[2], /*abs_error*/1e-13);
 }
 
+// Formulas with the same expression share the compiled function and its gradient
+TEST(TFormulaGradientPar, SharedExpression)
+{
+   TFormula f1("f1", "[0]*x*x+[1]*std::exp([2]*x)");
+   TFormula f2("f2", "[0]*x*x+[1]*std::exp([2]*x)");
+   f1.SetParameters(1., 2., 0.5);
+   f2.SetParameters(3., 1., -1.);
+   double x[] = {2.};
+   TFormula::GradientStorage result1(3), result2(3);
+   ASSERT_TRUE(f1.GenerateGradientPar());
+   ASSERT_TRUE(f2.GenerateGradientPar());
+   f1.GradientPar(x, result1);
+   f2.GradientPar(x, result2);
+
+   EXPECT_EQ(f1.GetGradientFormula(), f2.GetGradientFormula());
+   EXPECT_FLOAT_EQ(4., result1[0]);
+   EXPECT_FLOAT_EQ(std::exp(1.), result1[1]);
+   EXPECT_FLOAT_EQ(2. * 2. * std::exp(1.), result1[2]);
+   EXPECT_FLOAT_EQ(4., result2[0]);
+   EXPECT_FLOAT_EQ(std::exp(-2.), result2[1]);
+   EXPECT_FLOAT_EQ(2. * std::exp(-2.), result2[2]);
+}
+
+// Once the gradient of the formula is generated, TF1::GradientPar returns it (0 for the fixed parameters)
+TEST(TFormulaGradientPar, TF1GradientPar)
+{
+   TF1 f("f", "[0]*x*x+[1]*std::exp([2]*x)");
+   f.SetParameters(1., 2., 0.5);
+   f.FixParameter(0, 1.);
+   ASSERT_TRUE(f.GetFormula()->GenerateGradientPar());
+   ASSERT_TRUE(f.GetFormula()->HasGeneratedGradient());
+   double x[] = {2.};
+   double grad[3] = {-1., -1., -1.};
+   f.GradientPar(x, grad);
+   EXPECT_EQ(0., grad[0]);
+   EXPECT_FLOAT_EQ(std::exp(1.), grad[1]);
+   EXPECT_FLOAT_EQ(2. * 2. * std::exp(1.), grad[2]);
+}
+
+// The fits with option "G" use the gradient generated by clad
+TEST(TFormulaGradientPar, FitWithGradient)
+{
+   TH1D h("h", "h", 50, -5, 5);
+   TF1 g("g", "gaus", -5, 5);
+   g.SetParameters(100., 0.5, 1.2);
+   h.FillRandom("g", 10000);
+
+   TF1 f1("f1", "[0]*exp(-0.5*((x-[1])/[2])^2)", -5, 5);
+   f1.SetParameters(200., 0., 1.);
+   auto r1 = h.Fit(&f1, "S Q N");
+   TF1 f2("f2", "[0]*exp(-0.5*((x-[1])/[2])^2)", -5, 5);
+   f2.SetParameters(200., 0., 1.);
+   auto r2 = h.Fit(&f2, "S Q N G");
+
+   EXPECT_TRUE(f2.GetFormula()->HasGeneratedGradient());
+   ASSERT_EQ(0, r1->Status());
+   ASSERT_EQ(0, r2->Status());
+   for (int i = 0; i < 3; ++i)
+      EXPECT_NEAR(r1->Parameter(i), r2->Parameter(i), 1e-3 * r1->ParError(i));
+   EXPECT_NEAR(r1->Chi2(), r2->Chi2(), 1e-6 * r1->Chi2());
+}
+
 // FIXME: Add more: crystalball, cheb3, bigaus?
 
 // FIXME: Disable because of a known failure in -Druntime_cxxmodules=On.
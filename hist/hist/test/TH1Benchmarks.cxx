@@ -0,0 +1,87 @@
+#include "TH1.h"
+#include "TH2.h"
+#include "TRandom3.h"
+
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+// Fixed dataset of gaussian distributed values, a part of which is in the underflow and overflow bins
+static const std::vector<double> &GetValues()
+{
+   static std::vector<double> values = [] {
+      std::vector<double> v(1 << 20);
+      TRandom3 rnd(42);
+      for (auto &x : v)
+         x = rnd.Gaus(0, 3);
+      return v;
+   }();
+   return values;
+}
+
+static void BM_TH1D_Fill(benchmark::State &state)
+{
+   const auto &values = GetValues();
+   TH1D h("h", "h", state.range(0), -10, 10);
+   h.SetDirectory(nullptr);
+   for (auto _ : state) {
+      for (auto x : values)
+         h.Fill(x);
+   }
+   state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_TH1D_Fill)->Arg(100)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+static void BM_TH1D_FillWeighted(benchmark::State &state)
+{
+   const auto &values = GetValues();
+   TH1D h("h", "h", state.range(0), -10, 10);
+   h.SetDirectory(nullptr);
+   for (auto _ : state) {
+      for (auto x : values)
+         h.Fill(x, 0.5);
+   }
+   state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_TH1D_FillWeighted)->Arg(100)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+static void BM_TH1D_FillN(benchmark::State &state)
+{
+   const auto &values = GetValues();
+   TH1D h("h", "h", state.range(0), -10, 10);
+   h.SetDirectory(nullptr);
+   for (auto _ : state)
+      h.FillN(values.size(), values.data(), nullptr);
+   state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_TH1D_FillN)->Arg(100)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+static void BM_TH1D_FillVariableBins(benchmark::State &state)
+{
+   const auto &values = GetValues();
+   const Int_t nbins = state.range(0);
+   std::vector<double> edges(nbins + 1);
+   for (Int_t i = 0; i <= nbins; ++i)
+      edges[i] = -10. + 20. * (i * i) / (nbins * nbins);
+   TH1D h("h", "h", nbins, edges.data());
+   h.SetDirectory(nullptr);
+   for (auto _ : state) {
+      for (auto x : values)
+         h.Fill(x);
+   }
+   state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_TH1D_FillVariableBins)->Arg(100)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+static void BM_TH2D_Fill(benchmark::State &state)
+{
+   const auto &values = GetValues();
+   TH2D h("h", "h", state.range(0), -10, 10, state.range(0), -10, 10);
+   h.SetDirectory(nullptr);
+   for (auto _ : state) {
+      for (std::size_t i = 0; i + 1 < values.size(); i += 2)
+         h.Fill(values[i], values[i + 1]);
+   }
+   state.SetItemsProcessed(state.iterations() * (values.size() / 2));
+}
+BENCHMARK(BM_TH2D_Fill)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
@@ -1,9 +1,12 @@
 #include "gtest/gtest.h"
 
 #include "THn.h"
+#include "THnSparse.h"
 #include "TH1.h"
 #include "TH2.h"
 
+#include <vector>
+
 // Filling THn
 TEST(THn, Fill) {
    Int_t bins[2] = {2, 3};
@@ -111,3 +114,72 @@ TEST(THn, Projection) {
    }
 
 }
+
+// Filling THnSparse, with coordinates that fit in 8 bytes and with coordinates that do not
+TEST(THnSparse, FillAndFind) {
+   for (Int_t ndim : {3, 12}) {
+      std::vector<Int_t> bins(ndim, 100);
+      std::vector<Double_t> xmin(ndim, 0.);
+      std::vector<Double_t> xmax(ndim, 100.);
+      THnSparseD hs("hs", "hs", ndim, bins.data(), xmin.data(), xmax.data(), 256);
+
+      // the first two coordinates make the bins distinct
+      auto coordinate = [](Int_t i, Int_t d) {
+         return d == 0 ? i % 100 : d == 1 ? (i / 100) % 100 : (i * (d + 7) + d * d) % 100;
+      };
+      const Int_t n = 5000;
+      std::vector<Double_t> x(ndim);
+      for (Int_t i = 0; i < n; ++i) {
+         for (Int_t d = 0; d < ndim; ++d)
+            x[d] = coordinate(i, d) + 0.5;
+         hs.Fill(x.data(), 1. + i % 3);
+      }
+      EXPECT_EQ(n, hs.GetNbins());
+
+      for (Int_t i = 0; i < n; i += 37) {
+         std::vector<Int_t> coord(ndim);
+         for (Int_t d = 0; d < ndim; ++d)
+            coord[d] = coordinate(i, d) + 1;
+         EXPECT_DOUBLE_EQ(1. + i % 3, hs.GetBinContent(coord.data()));
+      }
+      std::vector<Int_t> empty(ndim, 100);
+      EXPECT_EQ(-1, hs.GetBin(empty.data(), kFALSE));
+   }
+}
+
+// THnBlockF behaves as THnF, and only allocates the blocks that are filled
+TEST(THnBlock, FillSparseRegion) {
+   Int_t bins[3] = {200, 200, 200};
+   Double_t xmin[3] = {0., 0., 0.};
+   Double_t xmax[3] = {200., 200., 200.};
+   THnBlockF hb("hb", "hb", 3, bins, xmin, xmax);
+   hb.Sumw2();
+   EXPECT_EQ(0, hb.GetNblocksAllocated());
+
+   Double_t x[3];
+   for (Int_t i = 0; i < 100; ++i) {
+      x[0] = 100.5;
+      x[1] = 50.5 + i % 10;
+      x[2] = 10.5 + i;
+      hb.Fill(x, 0.5);
+   }
+   EXPECT_EQ(100, hb.GetEntries());
+   EXPECT_LE(hb.GetNblocksAllocated(), 20);
+
+   Int_t idx[3] = {101, 51, 11};
+   EXPECT_FLOAT_EQ(0.5, hb.GetBinContent(idx));
+   EXPECT_FLOAT_EQ(0.5, hb.GetBinError(idx));
+   idx[0] = 1;
+   EXPECT_FLOAT_EQ(0., hb.GetBinContent(idx));
+
+   const Long64_t allocated = hb.GetNblocksAllocated();
+   hb.Scale(2.);
+   EXPECT_EQ(allocated, hb.GetNblocksAllocated());
+   idx[0] = 101;
+   EXPECT_FLOAT_EQ(1., hb.GetBinContent(idx));
+   EXPECT_FLOAT_EQ(1., hb.GetBinError(idx));
+
+   hb.Reset();
+   EXPECT_EQ(0, hb.GetNblocksAllocated());
+   EXPECT_FLOAT_EQ(0., hb.GetBinContent(idx));
+}
@@ -1,9 +1,99 @@
 #include "gtest/gtest.h"
 
 #include "TFormula.h"
+#include "TF1.h"
+#include "TF2.h"
+
+#include <cmath>
+#include <vector>
 
 // Test that autoloading works (ROOT-9840)
 TEST(TFormula, Interp)
 {
   TFormula f("func", "TGeoBBox::DeclFileLine()");
 }
+
+// Test that formulas whose compilation is deferred are compiled together
+TEST(TFormula, DeferCompilation)
+{
+   const bool previous = TFormula::DeferCompilation();
+   TFormula f1("f1", "[0]*x+[1]*7", false);
+   TFormula f2("f2", "[0]*x*x", false);
+   TFormula f3("f3", "[0]*x+[1]*7", false);
+   TFormula::DeferCompilation(previous);
+   EXPECT_FALSE(f1.IsValid());
+
+   EXPECT_TRUE(TFormula::CompileDeferred());
+   EXPECT_TRUE(f1.IsValid());
+   EXPECT_TRUE(f2.IsValid());
+   EXPECT_TRUE(f3.IsValid());
+   f1.SetParameters(2., 1.);
+   f2.SetParameter(0, 3.);
+   f3.SetParameters(1., 1.);
+   EXPECT_DOUBLE_EQ(f1.Eval(2.), 11.);
+   EXPECT_DOUBLE_EQ(f2.Eval(2.), 12.);
+   EXPECT_DOUBLE_EQ(f3.Eval(2.), 9.);
+}
+
+// Test that the first evaluation of a deferred formula compiles it
+TEST(TFormula, DeferCompilationEval)
+{
+   const bool previous = TFormula::DeferCompilation();
+   TFormula f("f", "[0]+x*x*x", false);
+   TFormula::DeferCompilation(previous);
+   f.SetParameter(0, 1.);
+   EXPECT_DOUBLE_EQ(f.Eval(2.), 9.);
+   EXPECT_TRUE(f.IsValid());
+}
+
+// Formulas with the same expression share the compiled function but keep their own parameters
+TEST(TFormula, SharedExpression)
+{
+   TFormula f1("f1", "[0]*x+[1]");
+   TFormula f2("f2", "[0]*x+[1]");
+   f1.SetParameters(2., 1.);
+   f2.SetParameters(-1., 3.);
+   EXPECT_DOUBLE_EQ(f1.Eval(2.), 5.);
+   EXPECT_DOUBLE_EQ(f2.Eval(2.), 1.);
+   f1.SetParameter(1, 0.);
+   EXPECT_DOUBLE_EQ(f1.Eval(2.), 4.);
+   EXPECT_DOUBLE_EQ(f2.Eval(2.), 1.);
+}
+
+static double Gauss1D(double *x, double *p)
+{
+   return p[0] * std::exp(-0.5 * x[0] * x[0] / (p[1] * p[1]));
+}
+
+// EvalBatch gives the same values as EvalPar, for compiled and formula-based functions
+TEST(TF1, EvalBatch)
+{
+   const std::size_t n = 37;
+   std::vector<double> x(2 * n), out(n);
+   for (std::size_t i = 0; i < n; ++i) {
+      x[i] = -3. + 0.17 * i;
+      x[n + i] = 2. - 0.11 * i;
+   }
+   const double params[] = {2., 1.5};
+
+   TF1 f1("f1", Gauss1D, -5., 5., 2);
+   f1.SetParameters(1., 1.);
+   f1.EvalBatch(x.data(), out.data(), n, params);
+   for (std::size_t i = 0; i < n; ++i)
+      EXPECT_DOUBLE_EQ(f1.EvalPar(&x[i], params), out[i]);
+
+   TF2 f2("f2", "[0]*x*y+[1]*sin(y)", -5., 5., -5., 5.);
+   f2.SetParameters(params);
+   f2.EvalBatch(x.data(), out.data(), n);
+   for (std::size_t i = 0; i < n; ++i) {
+      const double point[] = {x[i], x[n + i]};
+      EXPECT_DOUBLE_EQ(f2.EvalPar(point, params), out[i]);
+   }
+
+#ifdef R__HAS_VECCORE
+   f2.SetVectorized(true);
+   f2.EvalBatch(x.data(), out.data(), n, params);
+   for (std::size_t i = 0; i < n; ++i)
+      EXPECT_NEAR(params[0] * x[i] * x[n + i] + params[1] * std::sin(x[n + i]), out[i], 1e-12);
+#endif
+}
@@ -0,0 +1,44 @@
+#include "TGraph2D.h"
+#include "TH2.h"
+#include "TRandom3.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+// Test that the batch interpolation gives the same values as the interpolation point by point
+TEST(TGraph2D, InterpolateBatch)
+{
+   TRandom3 rnd(1);
+   TGraph2D g(2000);
+   for (int i = 0; i < 2000; ++i) {
+      const double x = rnd.Uniform(-3, 3);
+      const double y = rnd.Uniform(-3, 3);
+      g.SetPoint(i, x, y, std::sin(x) * std::cos(y));
+   }
+
+   // a grid larger than the hull, to have points outside of it
+   std::vector<double> x, y;
+   for (int ix = 0; ix < 150; ++ix) {
+      for (int iy = 0; iy < 150; ++iy) {
+         x.push_back(-3.5 + 7. * (ix + 0.5) / 150);
+         y.push_back(-3.5 + 7. * (iy + 0.5) / 150);
+      }
+   }
+   std::vector<double> z(x.size());
+   g.Interpolate(x.size(), x.data(), y.data(), z.data());
+   for (std::size_t i = 0; i < x.size(); ++i)
+      EXPECT_NEAR(z[i], g.Interpolate(x[i], y[i]), 1.E-12) << "at (" << x[i] << "," << y[i] << ")";
+
+   // the histogram of the graph is filled with the batch interpolation
+   TH2D *h = g.GetHistogram();
+   ASSERT_NE(h, nullptr);
+   for (int ix = 1; ix <= h->GetNbinsX(); ix += 7) {
+      for (int iy = 1; iy <= h->GetNbinsY(); iy += 7) {
+         const double xc = h->GetXaxis()->GetBinCenter(ix);
+         const double yc = h->GetYaxis()->GetBinCenter(iy);
+         EXPECT_NEAR(h->GetBinContent(ix, iy), g.Interpolate(xc, yc), 1.E-12);
+      }
+   }
+}
@@ -2,6 +2,18 @@
 
 #include "TH1.h"
 #include "TH1F.h"
+#include "TH2.h"
+#include "TH3.h"
+#include "TF1.h"
+#include "TList.h"
+#include "TROOT.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 // StatOverflows TH1
 TEST(TH1, StatOverflows)
@@ -30,3 +42,202 @@ TEST(TH1, StatOverflows)
    EXPECT_EQ(TH1::EStatOverflows::kConsider, h1.GetStatOverflows());
    EXPECT_EQ(TH1::EStatOverflows::kNeutral,  h2.GetStatOverflows());
 }
+
+TEST(TH1, LightweightObjects)
+{
+   {
+      ROOT::TLightweightObjectsGuard guard;
+      EXPECT_TRUE(ROOT::IsLightweightObjectsMode());
+      EXPECT_FALSE(TH1::AddDirectoryStatus());
+
+      TH1F h("hLightweight", "", 10, 0, 10);
+      EXPECT_EQ(nullptr, h.GetDirectory());
+      std::unique_ptr<TH1> clone(static_cast<TH1 *>(h.Clone("hLightweightClone")));
+      EXPECT_EQ(nullptr, clone->GetDirectory());
+
+      TF1 f("fLightweight", "x*[0]", 0, 10);
+      EXPECT_EQ(nullptr, gROOT->GetListOfFunctions()->FindObject("fLightweight"));
+
+      {
+         ROOT::TLightweightObjectsGuard regular(kFALSE);
+         EXPECT_FALSE(ROOT::IsLightweightObjectsMode());
+      }
+      EXPECT_TRUE(ROOT::IsLightweightObjectsMode());
+   }
+   EXPECT_FALSE(ROOT::IsLightweightObjectsMode());
+
+   TH1F h("hRegular", "", 10, 0, 10);
+   EXPECT_EQ(gDirectory, h.GetDirectory());
+}
+
+// TAxis::FindFixBins agrees with TAxis::FindFixBin, for fixed and variable bins
+TEST(TAxis, FindFixBins)
+{
+   const std::vector<double> x{-10., 0., 0.1, 0.5, 0.99999, 1., 3.3, 9.999, 10., 11., std::nan("")};
+   std::vector<int> bins(x.size());
+   TAxis fixed(10, 0., 10.);
+   fixed.FindFixBins(x.size(), x.data(), bins.data());
+   for (size_t i = 0; i < x.size(); ++i)
+      EXPECT_EQ(fixed.FindFixBin(x[i]), bins[i]) << "x = " << x[i];
+
+   const double edges[] = {0., 0.5, 1., 5., 10.};
+   TAxis variable(4, edges);
+   variable.FindFixBins(x.size(), x.data(), bins.data());
+   for (size_t i = 0; i < x.size(); ++i)
+      EXPECT_EQ(variable.FindFixBin(x[i]), bins[i]) << "x = " << x[i];
+}
+
+// FillN gives the same histogram as a loop of Fill
+TEST(TH1, FillN)
+{
+   const int n = 1000;
+   std::vector<double> x(n), y(n), z(n), w(n);
+   for (int i = 0; i < n; ++i) {
+      x[i] = (i % 23) * 0.5 - 1.;
+      y[i] = (i % 17) * 0.5 - 1.;
+      z[i] = (i % 13) * 0.5 - 1.;
+      w[i] = 1. + i % 3;
+   }
+
+   TH1D h1("h1", "h1", 10, 0., 10.), r1("r1", "r1", 10, 0., 10.);
+   TH2D h2("h2", "h2", 10, 0., 10., 5, 0., 5.), r2("r2", "r2", 10, 0., 10., 5, 0., 5.);
+   TH3D h3("h3", "h3", 4, 0., 4., 4, 0., 4., 4, 0., 4.), r3("r3", "r3", 4, 0., 4., 4, 0., 4., 4, 0., 4.);
+   h1.FillN(n, x.data(), w.data());
+   h2.FillN(n, x.data(), y.data(), w.data());
+   h3.FillN(n, x.data(), y.data(), z.data(), w.data());
+   for (int i = 0; i < n; ++i) {
+      r1.Fill(x[i], w[i]);
+      r2.Fill(x[i], y[i], w[i]);
+      r3.Fill(x[i], y[i], z[i], w[i]);
+   }
+
+   const std::vector<std::pair<TH1 *, TH1 *>> pairs{{&h1, &r1}, {&h2, &r2}, {&h3, &r3}};
+   for (auto &p : pairs) {
+      EXPECT_EQ(p.first->GetEntries(), p.second->GetEntries());
+      for (int bin = 0; bin < p.first->GetNcells(); ++bin) {
+         EXPECT_EQ(p.first->GetBinContent(bin), p.second->GetBinContent(bin));
+         EXPECT_EQ(p.first->GetBinError(bin), p.second->GetBinError(bin));
+      }
+      Double_t stats[TH1::kNstat], refStats[TH1::kNstat];
+      p.first->GetStats(stats);
+      p.second->GetStats(refStats);
+      for (int i = 0; i < 11; ++i)
+         EXPECT_EQ(stats[i], refStats[i]);
+   }
+}
+
+// Add, Multiply, Divide, Scale and Merge of histograms with the same binning, which work on the arrays of contents
+TEST(TH1, ArrayOperations)
+{
+   TH2D a("a", "a", 6, 0., 6., 4, 0., 4.), b("b", "b", 6, 0., 6., 4, 0., 4.);
+   TH2F f("f", "f", 6, 0., 6., 4, 0., 4.);
+   a.Sumw2();
+   for (int i = 0; i < 200; ++i) {
+      a.Fill((i % 8) - 1., (i % 6) - 1., 1. + i % 3);
+      b.Fill((i % 7) - 1., (i % 5) - 1., 2.);
+      f.Fill((i % 8) - 1., (i % 6) - 1.);
+   }
+   const int ncells = a.GetNcells();
+   auto content = [](const TH1 &h, int bin) { return h.GetBinContent(bin); };
+   auto errorSq = [](const TH1 &h, int bin) { return h.GetBinError(bin) * h.GetBinError(bin); };
+
+   std::unique_ptr<TH1> sum(static_cast<TH1 *>(a.Clone("sum")));
+   sum->Add(&b, 2.);
+   std::unique_ptr<TH1> sum2(static_cast<TH1 *>(a.Clone("sum2")));
+   sum2->Add(&a, &b, 0.5, 3.);
+   std::unique_ptr<TH1> product(static_cast<TH1 *>(a.Clone("product")));
+   product->Multiply(&b);
+   std::unique_ptr<TH1> ratio(static_cast<TH1 *>(a.Clone("ratio")));
+   ratio->Divide(&b);
+   std::unique_ptr<TH1> scaled(static_cast<TH1 *>(a.Clone("scaled")));
+   scaled->Scale(0.25);
+   for (int bin = 0; bin < ncells; ++bin) {
+      const double ca = content(a, bin), cb = content(b, bin);
+      const double ea = errorSq(a, bin), eb = errorSq(b, bin);
+      EXPECT_DOUBLE_EQ(ca + 2. * cb, content(*sum, bin));
+      EXPECT_NEAR(ea + 4. * eb, errorSq(*sum, bin), 1e-9 * (ea + 4. * eb));
+      EXPECT_DOUBLE_EQ(0.5 * ca + 3. * cb, content(*sum2, bin));
+      EXPECT_NEAR(0.25 * ea + 9. * eb, errorSq(*sum2, bin), 1e-9 * (0.25 * ea + 9. * eb));
+      EXPECT_DOUBLE_EQ(ca * cb, content(*product, bin));
+      EXPECT_NEAR(ea * cb * cb + eb * ca * ca, errorSq(*product, bin), 1e-9 * (ea * cb * cb + eb * ca * ca));
+      EXPECT_DOUBLE_EQ(cb ? ca / cb : 0., content(*ratio, bin));
+      EXPECT_DOUBLE_EQ(0.25 * ca, content(*scaled, bin));
+      EXPECT_NEAR(ea / 16., errorSq(*scaled, bin), 1e-9 * ea);
+   }
+   EXPECT_DOUBLE_EQ(0.25 * a.GetSumOfWeights(), scaled->GetSumOfWeights());
+
+   // merging several histograms at once
+   std::vector<std::unique_ptr<TH2F>> inputs;
+   TList list;
+   for (int i = 0; i < 5; ++i) {
+      inputs.emplace_back(static_cast<TH2F *>(f.Clone(("f" + std::to_string(i)).c_str())));
+      inputs.back()->Scale(i + 1.);
+      list.Add(inputs.back().get());
+   }
+   std::unique_ptr<TH2F> merged(static_cast<TH2F *>(f.Clone("merged")));
+   merged->Reset();
+   merged->Merge(&list);
+   EXPECT_DOUBLE_EQ(5 * f.GetEntries(), merged->GetEntries());
+   for (int bin = 0; bin < ncells; ++bin) {
+      EXPECT_FLOAT_EQ(15. * content(f, bin), content(*merged, bin));
+      EXPECT_NEAR(55. * errorSq(f, bin), errorSq(*merged, bin), 1e-5 * errorSq(f, bin));
+   }
+}
+
+// Emptying a buffer with automatic binning gives the same histograms as filling the entries once the axes are known,
+// also for buffers large enough to be scanned in parallel
+TEST(TH1, BufferEmptyAutoBinning)
+{
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   const int n = 1 << 20;
+   std::vector<double> x(n), y(n), z(n), w(n);
+   for (int i = 0; i < n; ++i) {
+      x[i] = std::sin(0.001 * i) * 10.;
+      y[i] = (i % 101) * 0.25 - 3.;
+      z[i] = (i % 7) * 2.;
+      w[i] = 1. + i % 3;
+   }
+
+   TH1D h1("h1", "h1", 50, 0., 0.);
+   TH2D h2("h2", "h2", 20, 0., 0., 20, 0., 0.);
+   TH3D h3("h3", "h3", 5, 0., 0., 5, 0., 0., 5, 0., 0.);
+   h1.SetBuffer(n);
+   h2.SetBuffer(n);
+   h3.SetBuffer(n);
+   for (int i = 0; i < n; ++i) {
+      h1.Fill(x[i], w[i]);
+      h2.Fill(x[i], y[i], w[i]);
+      h3.Fill(x[i], y[i], z[i], w[i]);
+   }
+   h1.BufferEmpty(1);
+   h2.BufferEmpty(1);
+   h3.BufferEmpty(1);
+
+   const auto minmax = std::minmax_element(x.begin(), x.end());
+   EXPECT_LE(h1.GetXaxis()->GetXmin(), *minmax.first);
+   EXPECT_GT(h1.GetXaxis()->GetXmax(), *minmax.second);
+
+   std::unique_ptr<TH1> r1(static_cast<TH1 *>(h1.Clone("r1")));
+   std::unique_ptr<TH1> r2(static_cast<TH1 *>(h2.Clone("r2")));
+   std::unique_ptr<TH1> r3(static_cast<TH1 *>(h3.Clone("r3")));
+   r1->Reset();
+   r2->Reset();
+   r3->Reset();
+   for (int i = 0; i < n; ++i) {
+      r1->Fill(x[i], w[i]);
+      static_cast<TH2 *>(r2.get())->Fill(x[i], y[i], w[i]);
+      static_cast<TH3 *>(r3.get())->Fill(x[i], y[i], z[i], w[i]);
+   }
+
+   const std::vector<std::pair<TH1 *, TH1 *>> pairs{{&h1, r1.get()}, {&h2, r2.get()}, {&h3, r3.get()}};
+   for (auto &p : pairs) {
+      EXPECT_EQ(p.first->GetEntries(), p.second->GetEntries());
+      for (int bin = 0; bin < p.first->GetNcells(); ++bin)
+         EXPECT_EQ(p.first->GetBinContent(bin), p.second->GetBinContent(bin));
+   }
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+}
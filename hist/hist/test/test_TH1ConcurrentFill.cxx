@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+
+#include "TH1ConcurrentFill.h"
+#include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
+
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int kNThreads = 4;
+const int kNFills = 10000;
+
+// Values exactly representable in binary, so that the sums do not depend on the order of the fills.
+double Value(int thread, int i, int k)
+{
+   return ((thread * 7 + i * 3 + k) % 24) * 0.5 - 1.;
+}
+
+template <class HIST, class FILL>
+void CheckConcurrentFill(HIST &h, HIST &reference, ROOT::TH1ConcurrentFillManager::EMode mode, FILL fill)
+{
+   reference.Sumw2();
+   for (int t = 0; t < kNThreads; ++t)
+      for (int i = 0; i < kNFills; ++i)
+         fill(reference, t, i);
+
+   {
+      ROOT::TH1ConcurrentFillManager manager(h, mode);
+      std::vector<std::thread> threads;
+      for (int t = 0; t < kNThreads; ++t) {
+         threads.emplace_back([&manager, fill, t] {
+            auto filler = manager.MakeFiller();
+            for (int i = 0; i < kNFills; ++i)
+               fill(filler, t, i);
+         });
+      }
+      for (auto &thread : threads)
+         thread.join();
+   }
+
+   EXPECT_EQ(h.GetEntries(), reference.GetEntries());
+   for (int bin = 0; bin < h.GetNcells(); ++bin) {
+      EXPECT_EQ(h.GetBinContent(bin), reference.GetBinContent(bin));
+      EXPECT_EQ(h.GetBinError(bin), reference.GetBinError(bin));
+   }
+   Double_t stats[TH1::kNstat], referenceStats[TH1::kNstat];
+   h.GetStats(stats);
+   reference.GetStats(referenceStats);
+   for (int i = 0; i < 11; ++i)
+      EXPECT_EQ(stats[i], referenceStats[i]);
+}
+
+struct Fill1D {
+   template <class H>
+   void operator()(H &hist, int t, int i) const { hist.Fill(Value(t, i, 0), (i % 3) + 1.); }
+};
+
+struct Fill2D {
+   template <class H>
+   void operator()(H &hist, int t, int i) const { hist.Fill(Value(t, i, 0), Value(t, i, 1)); }
+};
+
+struct Fill3D {
+   template <class H>
+   void operator()(H &hist, int t, int i) const { hist.Fill(Value(t, i, 0), Value(t, i, 1), Value(t, i, 2), 2.); }
+};
+
+} // anonymous namespace
+
+TEST(TH1ConcurrentFill, Atomic1D)
+{
+   TH1D h("h", "h", 10, 0., 10.);
+   TH1D reference("ref", "ref", 10, 0., 10.);
+   CheckConcurrentFill(h, reference, ROOT::TH1ConcurrentFillManager::EMode::kAtomic, Fill1D());
+}
+
+TEST(TH1ConcurrentFill, Sharded2D)
+{
+   TH2F h("h", "h", 10, 0., 10., 5, 0., 5.);
+   TH2F reference("ref", "ref", 10, 0., 10., 5, 0., 5.);
+   CheckConcurrentFill(h, reference, ROOT::TH1ConcurrentFillManager::EMode::kSharded, Fill2D());
+}
+
+TEST(TH1ConcurrentFill, Atomic3D)
+{
+   TH3D h("h", "h", 4, 0., 4., 4, 0., 4., 4, 0., 4.);
+   TH3D reference("ref", "ref", 4, 0., 4., 4, 0., 4., 4, 0., 4.);
+   CheckConcurrentFill(h, reference, ROOT::TH1ConcurrentFillManager::EMode::kAtomic, Fill3D());
+}
+
+TEST(TH1ConcurrentFill, IntegerContentsAreSharded)
+{
+   TH1I h("h", "h", 10, 0., 10.);
+   ROOT::TH1ConcurrentFillManager manager(h);
+   EXPECT_EQ(manager.GetMode(), ROOT::TH1ConcurrentFillManager::EMode::kSharded);
+}
@@ -0,0 +1,82 @@
+// test TH2Poly finding the bins of points, with bins of very different sizes
+
+#include "gtest/gtest.h"
+
+#include "TH2Poly.h"
+#include "TList.h"
+#include "TRandom3.h"
+
+#include <vector>
+
+// Returns the first bin containing (x,y), looping over all bins
+static Int_t FindBinBruteForce(TH2Poly &h2p, Double_t x, Double_t y)
+{
+   for (auto obj : *h2p.GetBins()) {
+      auto bin = static_cast<TH2PolyBin *>(obj);
+      if (bin->IsInside(x, y))
+         return bin->GetBinNumber();
+   }
+   return -5;
+}
+
+TEST(TH2Poly, FindBin)
+{
+   TH2Poly h2p("h2p", "h2p", 0., 100., 0., 100.);
+   TRandom3 rndm(1);
+   // many small bins, a few large ones overlapping them, and some diamonds
+   for (Int_t i = 0; i < 2000; ++i) {
+      const Double_t size = (i % 100 == 0) ? 20. : 0.1 + rndm.Uniform();
+      const Double_t x = rndm.Uniform(100.), y = rndm.Uniform(100.);
+      if (i % 3 == 0) {
+         Double_t px[] = {x, x + size, x, x - size, x};
+         Double_t py[] = {y - size, y, y + size, y, y - size};
+         h2p.AddBin(5, px, py);
+      } else {
+         h2p.AddBin(x, y, x + size, y + size);
+      }
+   }
+
+   for (Int_t i = 0; i < 20000; ++i) {
+      const Double_t x = rndm.Uniform(100.), y = rndm.Uniform(100.);
+      EXPECT_EQ(FindBinBruteForce(h2p, x, y), h2p.FindBin(x, y));
+   }
+   EXPECT_EQ(-1, h2p.FindBin(-1., 101.));
+   EXPECT_EQ(-9, h2p.FindBin(101., -1.));
+
+   // bins added after a search are found
+   h2p.AddBin(-10., -10., 0.5, 0.5);
+   EXPECT_NE(-5, h2p.FindBin(0.25, 0.25));
+   EXPECT_EQ(FindBinBruteForce(h2p, 0.25, 0.25), h2p.FindBin(0.25, 0.25));
+}
+
+TEST(TH2Poly, FillN)
+{
+   TH2Poly h1("h1", "h1", 0., 10., 0., 10.), h2("h2", "h2", 0., 10., 0., 10.);
+   for (Int_t i = 0; i < 10; ++i) {
+      for (Int_t j = 0; j < 10; ++j) {
+         h1.AddBin(i, j, i + 1, j + 1);
+         h2.AddBin(i, j, i + 1, j + 1);
+      }
+   }
+
+   TRandom3 rndm(2);
+   const Int_t n = 1000;
+   // the points are interleaved with values that are skipped, to test the stride
+   std::vector<Double_t> x(2 * n), y(2 * n), w(2 * n);
+   for (Int_t i = 0; i < 2 * n; ++i) {
+      x[i] = rndm.Uniform(-1., 11.);
+      y[i] = rndm.Uniform(-1., 11.);
+      w[i] = rndm.Uniform(0.5, 2.);
+   }
+   h1.FillN(n, x.data(), y.data(), w.data(), 2);
+   for (Int_t i = 0; i < n; ++i)
+      h2.Fill(x[2 * i], y[2 * i], w[2 * i]);
+
+   EXPECT_EQ(h2.GetEntries(), h1.GetEntries());
+   for (Int_t bin = -9; bin <= h1.GetNumberOfBins(); ++bin) {
+      if (bin == 0)
+         continue;
+      EXPECT_DOUBLE_EQ(h2.GetBinContent(bin), h1.GetBinContent(bin));
+      EXPECT_DOUBLE_EQ(h2.GetBinError(bin), h1.GetBinError(bin));
+   }
+}
@@ -0,0 +1,75 @@
+#include "TPrincipal.h"
+#include "TList.h"
+#include "TRandom3.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+namespace {
+
+std::vector<double> MakeRows(int nRows, int nVar)
+{
+   TRandom3 rnd(1);
+   std::vector<double> rows(nRows * nVar);
+   for (int r = 0; r < nRows; ++r) {
+      const double common = rnd.Gaus(0, 1);
+      for (int i = 0; i < nVar; ++i)
+         rows[r * nVar + i] = 100. + i + (i + 1) * common + rnd.Gaus(0, 0.5);
+   }
+   return rows;
+}
+
+void ExpectSameMoments(const TPrincipal &a, const TPrincipal &b, int nVar)
+{
+   for (int i = 0; i < nVar; ++i) {
+      EXPECT_NEAR((*a.GetMeanValues())(i), (*b.GetMeanValues())(i), 1.E-9);
+      for (int j = 0; j <= i; ++j)
+         EXPECT_NEAR((*a.GetCovarianceMatrix())(i, j), (*b.GetCovarianceMatrix())(i, j), 1.E-9);
+   }
+}
+
+} // namespace
+
+// Test that adding the rows in batch gives the same moments as adding them one by one
+TEST(TPrincipal, AddRows)
+{
+   const int nVar = 4;
+   const int nRows = 100000;
+   const auto rows = MakeRows(nRows, nVar);
+
+   TPrincipal serial(nVar, "D");
+   for (int r = 0; r < nRows; ++r)
+      serial.AddRow(&rows[r * nVar]);
+
+   TPrincipal batch(nVar, "D");
+   batch.AddRow(&rows[0]);
+   batch.AddRows(&rows[nVar], nRows - 1);
+
+   ExpectSameMoments(serial, batch, nVar);
+   for (int r = 0; r < nRows; r += 997)
+      for (int i = 0; i < nVar; ++i)
+         EXPECT_EQ(batch.GetRow(r)[i], rows[r * nVar + i]);
+}
+
+// Test that merging the objects filled with parts of the rows gives the same moments
+TEST(TPrincipal, Merge)
+{
+   const int nVar = 3;
+   const int nRows = 30000;
+   const auto rows = MakeRows(nRows, nVar);
+
+   TPrincipal all(nVar, "");
+   all.AddRows(rows.data(), nRows);
+
+   TPrincipal first(nVar, ""), second(nVar, ""), third(nVar, "");
+   first.AddRows(rows.data(), 1000);
+   second.AddRows(&rows[1000 * nVar], 20000);
+   third.AddRows(&rows[21000 * nVar], nRows - 21000);
+   TList others;
+   others.Add(&second);
+   others.Add(&third);
+   EXPECT_EQ(first.Merge(&others), nRows);
+
+   ExpectSameMoments(all, first, nVar);
+}
@@ -0,0 +1,94 @@
+#include "TGraph.h"
+#include "TRandom3.h"
+#include "TSpline.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Knots at non equidistant positions, points outside the knots and on the knots
+static std::vector<double> MakeKnots()
+{
+   std::vector<double> knots;
+   for (int i = 0; i < 50; ++i)
+      knots.push_back(0.1 * i * i);
+   return knots;
+}
+
+static std::vector<double> MakePoints(const std::vector<double> &knots, bool sorted)
+{
+   TRandom3 rnd(1);
+   std::vector<double> x;
+   for (int i = 0; i < 10000; ++i)
+      x.push_back(rnd.Uniform(-10, knots.back() + 10));
+   x.insert(x.end(), knots.begin(), knots.end());
+   if (sorted)
+      std::sort(x.begin(), x.end());
+   return x;
+}
+
+template <class Spline>
+static void CheckEvalBatch(const Spline &spline, const std::vector<double> &x)
+{
+   std::vector<double> res(x.size());
+   spline.EvalBatch(x.size(), x.data(), res.data());
+   for (std::size_t i = 0; i < x.size(); ++i)
+      EXPECT_DOUBLE_EQ(spline.Eval(x[i]), res[i]) << "at x = " << x[i];
+}
+
+TEST(TSpline, EvalBatch3)
+{
+   auto knots = MakeKnots();
+   std::vector<double> y;
+   for (auto k : knots)
+      y.push_back(std::sin(0.3 * k));
+   TSpline3 spline("spline", knots.data(), y.data(), knots.size());
+   for (bool sorted : {true, false})
+      CheckEvalBatch(spline, MakePoints(knots, sorted));
+   for (auto k : MakePoints(knots, false))
+      EXPECT_EQ(spline.FindX(k), spline.FindX(k, 10));
+}
+
+TEST(TSpline, EvalBatch5)
+{
+   auto knots = MakeKnots();
+   std::vector<double> y;
+   for (auto k : knots)
+      y.push_back(std::sin(0.3 * k));
+   TSpline5 spline("spline", knots.data(), y.data(), knots.size());
+   for (bool sorted : {true, false})
+      CheckEvalBatch(spline, MakePoints(knots, sorted));
+}
+
+TEST(TSpline, EvalBatchEquidistant)
+{
+   std::vector<double> y;
+   for (int i = 0; i < 50; ++i)
+      y.push_back(std::cos(0.2 * i));
+   TSpline3 spline("spline", 0., 10., y.data(), y.size());
+   CheckEvalBatch(spline, MakePoints({0., 10.}, true));
+}
+
+// TGraph::Eval with option "S" reuses its spline until the points change
+TEST(TSpline, GraphEvalCache)
+{
+   TGraph g(20);
+   for (int i = 0; i < 20; ++i)
+      g.SetPoint(i, 19 - i, std::sqrt(19. - i));
+
+   std::vector<double> xs, ys;
+   for (int i = 0; i < 20; ++i) {
+      xs.push_back(i);
+      ys.push_back(std::sqrt(i));
+   }
+   TSpline3 spline("spline", xs.data(), ys.data(), xs.size());
+   EXPECT_NEAR(2., g.Eval(4., nullptr, "S"), 1e-12);
+   EXPECT_DOUBLE_EQ(spline.Eval(4.5), g.Eval(4.5, nullptr, "S"));
+
+   g.SetPoint(15, 4, 10.);
+   EXPECT_NEAR(10., g.Eval(4., nullptr, "S"), 1e-12);
+   g.GetY()[15] = 20.;
+   EXPECT_NEAR(20., g.Eval(4., nullptr, "S"), 1e-12);
+}
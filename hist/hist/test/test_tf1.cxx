@@ -1,10 +1,12 @@
 #include "TF1.h"
 #include "TF1NormSum.h"
+#include "TF1Convolution.h"
 #include "TObjString.h"
 #include "TObjArray.h"
 
 #include "gtest/gtest.h"
 
+#include <cmath>
 #include <iostream>
 
 using namespace std;
@@ -198,6 +200,36 @@ TEST(TF1, CopyClone)
    test_copyClone();
 }
 
+// Test that the transforms cached by TF1Convolution follow the changes of the parameters
+TEST(TF1, ConvCachedTransforms)
+{
+   TF1Convolution conv("expo", "gaus", -10, 10, true);
+   conv.SetNofPointsFFT(1000);
+   TF1 f("f", conv, -10, 10, conv.GetNpar());
+   f.SetParameters(1., -0.2, 1., 0., 1.);
+   f.Eval(0.);
+
+   // change the parameters of each function in turn, only its transform is recomputed
+   const std::vector<std::vector<double>> parSets = {{1., -0.5, 1., 0., 1.}, {1., -0.5, 1., 1., 0.5}, {2., 0.1, 3., -1., 2.}};
+   for (const auto &pars : parSets) {
+      f.SetParameters(pars.data());
+      TF1Convolution fresh("expo", "gaus", -10, 10, true);
+      fresh.SetNofPointsFFT(1000);
+      TF1 g("g", fresh, -10, 10, fresh.GetNpar());
+      g.SetParameters(pars.data());
+      for (double x = -8.; x < 8.; x += 0.7)
+         EXPECT_NEAR(f.Eval(x), g.Eval(x), 1.E-10 * std::abs(g.Eval(x)) + 1.E-12);
+
+      // the batch evaluation interpolates the same grid
+      std::vector<double> xs, ys(40);
+      for (int i = 0; i < 40; ++i)
+         xs.push_back(-9.5 + 0.5 * i);
+      conv.EvalBatch(xs.size(), xs.data(), ys.data(), pars.data());
+      for (int i = 0; i < 40; ++i)
+         EXPECT_DOUBLE_EQ(ys[i], conv(&xs[i], pars.data()));
+   }
+}
+
 TEST(TF1, Constructors)
 {
 
@@ -209,3 +209,29 @@ TEST(TKDE, tkde_io_binned)
    }
 }
 
+
+/// The binned estimate computed with a FFT agrees with the direct one
+TEST(TKDE, tkde_binned_fft)
+{
+   const int n = 20000;
+   std::vector<double> v(n);
+   for (int i = 0; i < n; ++i)
+      v[i] = (i < 0.2 * n) ? gRandom->Gaus(10, 1) : gRandom->Gaus(10, 4);
+   std::vector<double> x;
+   for (double xi = 0.05; xi < 20.; xi += 0.37)
+      x.push_back(xi);
+   std::vector<double> y(x.size());
+
+   for (auto iteration : {"Fixed", "Adaptive"}) {
+      TString opt = TString::Format("KernelType:Gaussian;Iteration:%s;Mirror:noMirror;Binning:ForcedBinning", iteration);
+      TKDE direct(n, v.data(), 0., 20., opt, 1);
+      TKDE fft(n, v.data(), 0., 20., opt, 1);
+      fft.SetUseFFT();
+      fft.GetValues(x.size(), x.data(), y.data());
+      for (size_t i = 0; i < x.size(); ++i) {
+         const double expected = direct(x[i]);
+         EXPECT_NEAR(expected, fft(x[i]), 1.E-3 * expected + 1.E-9);
+         EXPECT_DOUBLE_EQ(fft(x[i]), y[i]);
+      }
+   }
+}
@@ -35,6 +35,7 @@ public:
    virtual ~TGraphPainter();
 
    void           ComputeLogs(Int_t npoints, Int_t opt);
+   Int_t          DecimatePolyLine(Int_t npoints, Double_t *x, Double_t *y);
    virtual Int_t  DistancetoPrimitiveHelper(TGraph *theGraph, Int_t px, Int_t py);
    virtual void   DrawPanelHelper(TGraph *theGraph);
    virtual void   ExecuteEventHelper(TGraph *theGraph, Int_t event, Int_t px, Int_t py);
@@ -58,10 +59,12 @@ public:
    virtual void   SetHighlight(TGraph *theGraph);
    void           Smooth(TGraph *theGraph, Int_t npoints, Double_t *x, Double_t *y, Int_t drawtype);
    static void    SetMaxPointsPerLine(Int_t maxp=50);
+   static void    SetDecimation(Int_t ncolumns=1);
 
 protected:
 
    static Int_t   fgMaxPointsPerLine;  //Number of points per chunks' line when drawing a graph.
+   static Int_t   fgDecimation;        //Number of columns per pixel used to reduce lines with many points, 0 disables it.
 
    ClassDef(TGraphPainter,0)  // TGraph painter
 };
@@ -40,6 +40,7 @@
 
 Double_t *gxwork, *gywork, *gxworkl, *gyworkl;
 Int_t TGraphPainter::fgMaxPointsPerLine = 50;
+Int_t TGraphPainter::fgDecimation = 1;
 
 static Int_t    gHighlightPoint  = -1;         // highlight point of graph
 static TGraph  *gHighlightGraph  = nullptr;    // pointer to graph with highlight point
@@ -67,6 +68,7 @@ ClassImp(TGraphPainter);
 - [Reverse graphs' axis](#GP06)
 - [Graphs in logarithmic scale](#GP07)
 - [Highlight mode for graph](#GP08)
+- [Graphs with many points](#GP09)
 
 
 ### <a name="GP00"></a> Introduction
@@ -631,6 +633,26 @@ NOTE all parameters of user function are taken from
 
 For more complex demo please see for example `$ROOTSYS/tutorials/math/hlquantiles.C` file.
 
+### <a name="GP09"></a> Graphs with many points
+
+When a graph with increasing X values is drawn as a simple line (option `L`),
+or a histogram is drawn with the default option, and the line has many more
+points than there are pixels along the X axis of the pad, the line is reduced
+before painting. For each column of pixels only the first, the last, the lowest
+and the highest points are kept, in their original order. The resulting
+line covers exactly the same pixels as the full one, but the painting time and
+the size of the PostScript, PDF or SVG output grow with the width of the pad
+instead of the number of points.
+
+Since the reduction is done at the resolution of the pad, zooming deeply into a
+vector output file may show the difference. The number of columns per pixel can
+be increased, or the reduction disabled, with:
+
+~~~ {.cpp}
+    TGraphPainter::SetDecimation(4); // four columns per pixel
+    TGraphPainter::SetDecimation(0); // all the points are painted
+~~~
+
 */
 
 
@@ -682,6 +704,62 @@ void TGraphPainter::ComputeLogs(Int_t npoints, Int_t opt)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Reduce a polyline given in pad coordinates, with increasing X values, to at
+/// most four points per column of pixels of the pad: the first, the lowest, the
+/// highest and the last point of each column are kept, in their original order.
+/// The reduced line covers the same pixels as the original one.
+///
+/// The kept points are moved to the beginning of `x` and `y` and their number
+/// is returned. Nothing is done if the line has less than four points per
+/// column, if the X values are not increasing or if `fgDecimation` is 0.
+
+Int_t TGraphPainter::DecimatePolyLine(Int_t npoints, Double_t *x, Double_t *y)
+{
+   if (fgDecimation <= 0 || !gPad) return npoints;
+   Double_t xmin = gPad->GetX1();
+   Double_t xmax = gPad->GetX2();
+   Int_t width = gPad->XtoAbsPixel(xmax) - gPad->XtoAbsPixel(xmin);
+   if (width <= 0 || xmax <= xmin) return npoints;
+   Double_t ncolumns = (Double_t)width*fgDecimation;
+   if (npoints <= 4*ncolumns) return npoints;
+
+   Int_t i;
+   for (i=1; i<npoints; i++) {
+      if (x[i] < x[i-1]) return npoints;
+   }
+
+   Double_t scale = ncolumns/(xmax-xmin);
+   Int_t nkept = 0;
+   Int_t first = 0;
+   while (first < npoints) {
+      Double_t column = TMath::Floor((x[first]-xmin)*scale);
+      Int_t imin = first, imax = first, last = first;
+      while (last+1 < npoints && TMath::Floor((x[last+1]-xmin)*scale) == column) {
+         last++;
+         if (y[last] < y[imin]) imin = last;
+         if (y[last] > y[imax]) imax = last;
+      }
+      Int_t kept[4] = {first, TMath::Min(imin,imax), TMath::Max(imin,imax), last};
+      Double_t xkept[4], ykept[4];
+      Int_t k, nk = 0;
+      for (k=0; k<4; k++) {
+         if (nk && kept[k] == kept[k-1]) continue;
+         xkept[nk] = x[kept[k]];
+         ykept[nk] = y[kept[k]];
+         nk++;
+      }
+      for (k=0; k<nk; k++) {
+         x[nkept] = xkept[k];
+         y[nkept] = ykept[k];
+         nkept++;
+      }
+      first = last+1;
+   }
+   return nkept;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Compute distance from point px,py to a graph.
 ///
@@ -1467,7 +1545,7 @@ void TGraphPainter::PaintGraph(TGraph *theGraph, Int_t npoints, const Double_t *
                }
                if (optionLine) {
                   if (TMath::Abs(theGraph->GetLineWidth())>99) PaintPolyLineHatches(theGraph, npt, gxworkl, gyworkl);
-                  gPad->PaintPolyLine(npt,gxworkl,gyworkl);
+                  gPad->PaintPolyLine(DecimatePolyLine(npt,gxworkl,gyworkl),gxworkl,gyworkl);
                }
             }
             gxwork[0] = gxwork[npt-1];  gywork[0] = gywork[npt-1];
@@ -1991,6 +2069,7 @@ void TGraphPainter::PaintGrapHist(TGraph *theGraph, Int_t npoints, const Double_
                   if (gxwork[nbpoints] < gPad->GetUxmax()) nbpoints++;
                }
 
+               nbpoints = DecimatePolyLine(nbpoints,&gxworkl[point1],&gyworkl[point1]);
                gPad->PaintPolyLine(nbpoints,&gxworkl[point1],&gyworkl[point1],noClip);
                continue;
             }
@@ -4950,3 +5029,16 @@ void TGraphPainter::SetMaxPointsPerLine(Int_t maxp)
    fgMaxPointsPerLine = maxp;
    if (maxp < 50) fgMaxPointsPerLine = 50;
 }
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Static function to set `fgDecimation`, the number of columns per pixel used
+/// to reduce the lines having many more points than the pad has pixels along
+/// the X axis, see [Graphs with many points](#GP09). 0 disables the reduction,
+/// all the points are then painted.
+
+void TGraphPainter::SetDecimation(Int_t ncolumns)
+{
+   fgDecimation = ncolumns;
+   if (ncolumns < 0) fgDecimation = 0;
+}
@@ -35,7 +35,12 @@ private:
 
 public:
    RHistBufferedFillBase() {}
-   ~RHistBufferedFillBase() { toDerived().Flush(); }
+   RHistBufferedFillBase(RHistBufferedFillBase &&other)
+      : fCursor(other.fCursor), fXBuf(other.fXBuf), fWBuf(other.fWBuf)
+   {
+      other.fCursor = 0;
+   }
+   ~RHistBufferedFillBase() { Flush(); }
 
    DERIVED &toDerived() { return *static_cast<DERIVED *>(this); }
    const DERIVED &toDerived() const { return *static_cast<const DERIVED *>(this); }
@@ -59,7 +64,8 @@ public:
    }
 
    void Flush() {
-      toDerived().FlushImpl();
+      if (fCursor > 0)
+         toDerived().FlushImpl();
       fCursor = 0;
    }
 };
@@ -93,6 +99,8 @@ private:
 
 public:
    RHistBufferedFill(Hist_t &hist): fHist{hist} {}
+   RHistBufferedFill(RHistBufferedFill &&) = default;
+   ~RHistBufferedFill() { this->Flush(); }
 
    void FillN(const std::span<const CoordArray_t> xN, const std::span<const Weight_t> weightN)
    {
@@ -17,9 +17,16 @@
 #define ROOT7_RHistConcurrentFill
 
 #include "ROOT/RSpan.hxx"
+#include "ROOT/RHist.hxx"
 #include "ROOT/RHistBufferedFill.hxx"
+#include "ROOT/RLogger.hxx"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <mutex>
+#include <type_traits>
 
 namespace ROOT {
 namespace Experimental {
@@ -27,39 +34,157 @@ namespace Experimental {
 template <class HIST, int SIZE>
 class RHistConcurrentFillManager;
 
+namespace Internal {
+
+/// Whether the bins of `HIST` can be filled in place with atomic operations:
+/// only the bin contents and the sums of squared weights are updated per bin.
+template <class HIST>
+struct RHistCanFillAtomic: std::false_type {};
+
+template <int DIMENSIONS, class PRECISION>
+struct RHistCanFillAtomic<RHist<DIMENSIONS, PRECISION, RHistStatContent>>
+   : std::integral_constant<bool, std::is_arithmetic<PRECISION>::value> {};
+
+template <int DIMENSIONS, class PRECISION>
+struct RHistCanFillAtomic<RHist<DIMENSIONS, PRECISION, RHistStatContent, RHistStatUncertainty>>
+   : std::integral_constant<bool, std::is_arithmetic<PRECISION>::value> {};
+
+/// Add `value` to `target`, which may be updated concurrently by other threads.
+template <class T>
+void AtomicAdd(T &target, T value)
+{
+   static_assert(sizeof(std::atomic<T>) == sizeof(T), "std::atomic<T> must have the layout of T");
+   auto &a = reinterpret_cast<std::atomic<T> &>(target);
+   T old = a.load(std::memory_order_relaxed);
+   while (!a.compare_exchange_weak(old, old + value, std::memory_order_relaxed))
+      ;
+}
+
+/// Atomically add `weight` to the content of bin `binidx`.
+template <int DIMENSIONS, class PRECISION, class STORAGE>
+void AtomicFill(Detail::RHistData<DIMENSIONS, PRECISION, STORAGE, RHistStatContent> &data, int binidx,
+                PRECISION weight)
+{
+   AtomicAdd(static_cast<RHistStatContent<DIMENSIONS, PRECISION> &>(data).GetBinContent(binidx), weight);
+}
+
+/// Atomically add `weight` to the content of bin `binidx`, and its square to the
+/// sum of squared weights of that bin.
+template <int DIMENSIONS, class PRECISION, class STORAGE>
+void AtomicFill(Detail::RHistData<DIMENSIONS, PRECISION, STORAGE, RHistStatContent, RHistStatUncertainty> &data,
+                int binidx, PRECISION weight)
+{
+   AtomicAdd(static_cast<RHistStatContent<DIMENSIONS, PRECISION> &>(data).GetBinContent(binidx), weight);
+   AtomicAdd(static_cast<RHistStatUncertainty<DIMENSIONS, PRECISION> &>(data).GetSumOfSquaredWeights(binidx),
+             weight * weight);
+}
+
+/// Fallback for statistics that cannot be filled atomically; never called, as
+/// `RHistCanFillAtomic` is false for them.
+template <class DATA, class WEIGHT>
+void AtomicFill(DATA &, int, WEIGHT)
+{}
+
+/// Add `n` entries to `data`, which counts them.
+template <class DATA>
+void AddEntries(DATA &data, int64_t n, std::true_type /*hasEntries*/)
+{
+   data.AddEntries(n);
+}
+
+/// Version of `AddEntries()` for statistics that do not count entries.
+template <class DATA>
+void AddEntries(DATA &, int64_t, std::false_type /*hasEntries*/)
+{}
+
+} // namespace Internal
+
 /**
  \class RHistConcurrentFiller
  Buffers a thread's Fill calls and submits them to the
  RHistConcurrentFillManager. Enables multi-threaded filling.
+
+ In `kSharded` mode, the filler owns a copy of the histogram with empty bins,
+ filled without any synchronization and added to the histogram when the filler
+ is flushed or destroyed. In `kAtomic` mode, the bins of the histogram are
+ filled in place and only the number of entries is added on flush.
  **/
 
 template <class HIST, int SIZE>
 class RHistConcurrentFiller: public Internal::RHistBufferedFillBase<RHistConcurrentFiller<HIST, SIZE>, HIST, SIZE> {
+   using Base_t = Internal::RHistBufferedFillBase<RHistConcurrentFiller<HIST, SIZE>, HIST, SIZE>;
+
    RHistConcurrentFillManager<HIST, SIZE> &fManager;
+   std::unique_ptr<HIST> fShard; ///< The partial histogram, in `kSharded` mode
+   int64_t fNEntries = 0;        ///< The entries filled since the last flush, in `kAtomic` and `kSharded` modes
 
 public:
    using CoordArray_t = typename HIST::CoordArray_t;
    using Weight_t = typename HIST::Weight_t;
 
-   RHistConcurrentFiller(RHistConcurrentFillManager<HIST, SIZE> &manager): fManager(manager) {}
+   RHistConcurrentFiller(RHistConcurrentFillManager<HIST, SIZE> &manager): fManager(manager)
+   {
+      if (manager.GetMode() == RHistConcurrentFillManager<HIST, SIZE>::EMode::kSharded)
+         fShard = manager.MakeShard();
+   }
+   RHistConcurrentFiller(RHistConcurrentFiller &&other)
+      : Base_t(std::move(other)), fManager(other.fManager), fShard(std::move(other.fShard)),
+        fNEntries(other.fNEntries)
+   {
+      other.fNEntries = 0;
+   }
+   ~RHistConcurrentFiller() { Flush(); }
 
    /// Thread-specific HIST::Fill().
-   using Internal::RHistBufferedFillBase<RHistConcurrentFiller<HIST, SIZE>, HIST, SIZE>::Fill;
+   using Base_t::Fill;
 
    /// Thread-specific HIST::FillN().
    void FillN(const std::span<const CoordArray_t> xN, const std::span<const Weight_t> weightN)
    {
-      fManager.FillN(xN, weightN);
+      if (fShard) {
+         fShard->FillN(xN, weightN);
+         fNEntries += xN.size();
+      } else if (fManager.GetMode() == RHistConcurrentFillManager<HIST, SIZE>::EMode::kAtomic) {
+         fNEntries += fManager.AtomicFillN(xN, weightN.data());
+      } else {
+         fManager.FillN(xN, weightN);
+      }
    }
 
    /// Thread-specific HIST::FillN().
-   void FillN(const std::span<const CoordArray_t> xN) { fManager.FillN(xN); }
+   void FillN(const std::span<const CoordArray_t> xN)
+   {
+      if (fShard) {
+         fShard->FillN(xN);
+         fNEntries += xN.size();
+      } else if (fManager.GetMode() == RHistConcurrentFillManager<HIST, SIZE>::EMode::kAtomic) {
+         fNEntries += fManager.AtomicFillN(xN, nullptr);
+      } else {
+         fManager.FillN(xN);
+      }
+   }
+
+   /// Fill the buffered points, and add the partial histogram or number of
+   /// entries of this filler to the histogram.
+   void Flush()
+   {
+      Base_t::Flush();
+      if (!fNEntries)
+         return;
+      if (fShard) {
+         fManager.Merge(fShard.get(), 0);
+         RHistConcurrentFillManager<HIST, SIZE>::ClearShard(*fShard);
+      } else {
+         fManager.Merge(nullptr, fNEntries);
+      }
+      fNEntries = 0;
+   }
 
    static constexpr int GetNDim() { return HIST::GetNDim(); }
 
 private:
-   friend class Internal::RHistBufferedFillBase<RHistConcurrentFiller<HIST, SIZE>, HIST, SIZE>;
-   void FlushImpl() { fManager.FillN(this->GetCoords(), this->GetWeights()); }
+   friend Base_t;
+   void FlushImpl() { FillN(this->GetCoords(), this->GetWeights()); }
 };
 
 /**
@@ -68,9 +193,18 @@ private:
 
  The HIST template can be a RHist instance. This class hands out
  RHistConcurrentFiller objects that can concurrently fill the histogram. They
- buffer calls to Fill() until the buffer is full, and then swap the buffer
- with that of the RHistConcurrentFillManager. The manager than fills the
- histogram.
+ buffer calls to Fill() until the buffer is full, and then fill the histogram
+ according to the mode of the manager:
+  - `kLocked`: the buffer is filled into the histogram under a lock.
+  - `kAtomic`: the bins are found without a lock, and filled in place with
+    atomic additions. Only available for histograms storing bin contents and
+    possibly uncertainties (e.g. `RH2D`); `kSharded` is used otherwise.
+  - `kSharded`: each filler fills its own partial histogram, added to the
+    histogram under a lock when the filler is flushed or destroyed. Fillers never
+    contend, at the cost of a copy of the bins per filler.
+
+ In `kAtomic` and `kSharded` modes the histogram is only complete once all
+ fillers are flushed or destroyed. The axes must not grow while filling.
  **/
 
 template <class HIST, int SIZE = 1024>
@@ -82,15 +216,71 @@ public:
    using CoordArray_t = typename HIST::CoordArray_t;
    using Weight_t = typename HIST::Weight_t;
 
+   enum class EMode { kLocked, kAtomic, kSharded };
+
 private:
    HIST &fHist;
+   EMode fMode;
    std::mutex fFillMutex; // should become a spin lock
 
+   /// Empty the bins and statistics of `shard`.
+   static void ClearShard(HIST &shard)
+   {
+      auto &impl = *shard.GetImpl();
+      impl.GetStat() = typename std::decay<decltype(impl.GetStat())>::type(impl.GetNBinsNoOver(),
+                                                                            impl.GetNOverflowBins());
+   }
+
+   /// Return a copy of the histogram with empty bins, to be filled by a filler.
+   std::unique_ptr<HIST> MakeShard()
+   {
+      std::lock_guard<std::mutex> lockGuard(fFillMutex);
+      std::unique_ptr<HIST> shard(new HIST(fHist));
+      ClearShard(*shard);
+      return shard;
+   }
+
+   /// Fill the points `xN` with the weights `weightsOrNull` (1 if `nullptr`)
+   /// with atomic additions, and return the number of points filled.
+   int64_t AtomicFillN(const std::span<const CoordArray_t> xN, const Weight_t *weightsOrNull)
+   {
+      constexpr size_t kChunkSize = 256;
+      int bins[kChunkSize];
+      auto &impl = *fHist.GetImpl();
+      for (size_t begin = 0; begin < xN.size(); begin += kChunkSize) {
+         const size_t n = std::min(kChunkSize, xN.size() - begin);
+         impl.GetBinIndicesAndGrow(std::span<const CoordArray_t>(xN.data() + begin, n), bins);
+         for (size_t i = 0; i < n; ++i)
+            Internal::AtomicFill(impl.GetStat(), bins[i], weightsOrNull ? weightsOrNull[begin + i] : (Weight_t)1);
+      }
+      return xN.size();
+   }
+
+   /// Add the partial histogram `shard` (if any) and `nEntries` entries to the histogram.
+   void Merge(const HIST *shard, int64_t nEntries)
+   {
+      std::lock_guard<std::mutex> lockGuard(fFillMutex);
+      if (shard)
+         Add(fHist, *shard);
+      auto &stat = fHist.GetImpl()->GetStat();
+      using Stat_t = typename std::decay<decltype(stat)>::type;
+      Internal::AddEntries(stat, nEntries,
+                           std::is_base_of<RHistStatContent<HIST::GetNDim(), Weight_t>, Stat_t>());
+   }
+
 public:
-   RHistConcurrentFillManager(HIST &hist): fHist(hist) {}
+   RHistConcurrentFillManager(HIST &hist, EMode mode = EMode::kLocked): fHist(hist), fMode(mode)
+   {
+      if (fMode == EMode::kAtomic && !Internal::RHistCanFillAtomic<HIST>::value) {
+         R__WARNING_HERE("HIST") << "The statistics of this histogram cannot be filled atomically, using kSharded.";
+         fMode = EMode::kSharded;
+      }
+   }
 
    RHistConcurrentFiller<HIST, SIZE> MakeFiller() { return RHistConcurrentFiller<HIST, SIZE>{*this}; }
 
+   EMode GetMode() const { return fMode; }
+
    /// Thread-specific HIST::FillN().
    void FillN(const std::span<const CoordArray_t> xN, const std::span<const Weight_t> weightN)
    {
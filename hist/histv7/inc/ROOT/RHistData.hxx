@@ -120,6 +120,10 @@ public:
    /// calls to Fill().
    int64_t GetEntries() const { return fEntries; }
 
+   /// Add `n` to the number of entries, for entries whose bin contents were
+   /// filled by other means than `Fill()`.
+   void AddEntries(int64_t n) { fEntries += n; }
+
    /// Get the number of bins exluding under- and overflow.
    size_t sizeNoOver() const noexcept { return fBinContent.size(); }
 
@@ -16,9 +16,11 @@
 #ifndef ROOT7_RHistImpl
 #define ROOT7_RHistImpl
 
+#include <algorithm>
 #include <cassert>
 #include <cctype>
 #include <functional>
+#include <type_traits>
 #include "ROOT/RSpan.hxx"
 #include "ROOT/RTupleApply.hxx"
 
@@ -103,6 +105,9 @@ public:
    /// Given the coordinate `x`, determine the index of the bin, possibly
    /// growing axes for which `x` is out of range.
    virtual int GetBinIndexAndGrow(const CoordArray_t &x) const = 0;
+   /// Given the coordinates `xN`, determine the indices of their bins into
+   /// `binsN`, as `GetBinIndexAndGrow()` does for each of them.
+   virtual void GetBinIndicesAndGrow(const std::span<const CoordArray_t> xN, int *binsN) const = 0;
 
    /// Given the local per-axis bins `x`, determine the index of the bin.
    virtual int GetBinIndexFromLocalBins(const BinArray_t &x) const = 0;
@@ -679,6 +684,63 @@ struct RFindLocalBins {
    }
 };
 
+/// Add to `bins[i]` the zero-based regular bin of `coords[i]` on axis `iAxis`,
+/// times `stride`, or set `bins[i]` to -1 if the coordinate is not in a regular
+/// bin of the axis or if `bins[i]` is already -1. Version for any axis type.
+template <class AXIS, class COORD>
+void FindRegularBinsN(int *bins, const COORD *coords, std::size_t n, int iAxis, int stride, const AXIS &axis,
+                      std::false_type /*isEquidistant*/)
+{
+   for (std::size_t i = 0; i < n; ++i) {
+      if (bins[i] < 0)
+         continue;
+      const int bin = axis.FindBin(coords[i][iAxis]);
+      bins[i] = (bin >= 1) ? bins[i] + (bin - 1) * stride : -1;
+   }
+}
+
+/// Version of `FindRegularBinsN()` for equidistant axes: the bins are computed
+/// inline, as in `RAxisEquidistant::FindBin()`, in a loop without branches
+/// that the compiler can vectorize.
+template <class AXIS, class COORD>
+void FindRegularBinsN(int *bins, const COORD *coords, std::size_t n, int iAxis, int stride, const AXIS &axis,
+                      std::true_type /*isEquidistant*/)
+{
+   const double low = axis.GetMinimum();
+   const double invBinWidth = axis.GetInverseBinWidth();
+   const double lastBin = axis.GetLastBin();
+   for (std::size_t i = 0; i < n; ++i) {
+      // one-based, as in RAxisBase::AdjustOverflowBinNumber()
+      const double rawbin = (coords[i][iAxis] - low) * invBinWidth + 1.;
+      const bool regular = bins[i] >= 0 && rawbin >= 1. && rawbin < lastBin + 1.;
+      bins[i] = regular ? bins[i] + ((int)rawbin - 1) * stride : -1;
+   }
+}
+
+/// Recursively computes the zero-based global bin index of points that are in
+/// regular bins on all axes, or -1 for the other points.
+template <int I, int NDIMS, typename COORD, class AXES>
+struct RFindRegularBinsN;
+
+template <int NDIMS, typename COORD, class AXES>
+struct RFindRegularBinsN<-1, NDIMS, COORD, AXES> {
+   void operator()(int * /*bins*/, const COORD * /*coords*/, std::size_t /*n*/, const AXES & /*axes*/,
+                   int /*stride*/) const
+   {}
+};
+
+template <int I, int NDIMS, typename COORD, class AXES>
+struct RFindRegularBinsN {
+   void operator()(int *bins, const COORD *coords, std::size_t n, const AXES &axes, int stride) const
+   {
+      constexpr const int thisAxis = NDIMS - I - 1;
+      const auto &axis = std::get<thisAxis>(axes);
+      using Axis_t = typename std::decay<decltype(axis)>::type;
+      FindRegularBinsN(bins, coords, n, thisAxis, stride, axis, std::is_base_of<RAxisEquidistant, Axis_t>());
+      RFindRegularBinsN<I - 1, NDIMS, COORD, AXES>()(bins, coords, n, axes, stride * axis.GetNBinsNoOver());
+   }
+};
+
 /// Recursively converts local axis bins from the standard `kUnderflowBin`/`kOverflowBin` for
 /// under/overflow bin indexing convention, to the corresponding bin coordinates.
 template <int I, int NDIMS, typename BINS, typename COORD, class AXES>
@@ -1000,6 +1062,19 @@ public:
       return ret;
    }
 
+   /// Get the bin indices for the given coordinates `xN`, as `GetBinIndexAndGrow()`
+   /// does. The bins are found axis by axis in loops over the points, computed
+   /// inline for equidistant axes; only the points that are not in a regular
+   /// bin go through `GetBinIndexAndGrow()`.
+   void GetBinIndicesAndGrow(const std::span<const CoordArray_t> xN, int *binsN) const final
+   {
+      std::fill(binsN, binsN + xN.size(), 0);
+      Internal::RFindRegularBinsN<DATA::GetNDim() - 1, DATA::GetNDim(), CoordArray_t, decltype(fAxes)>()(
+         binsN, xN.data(), xN.size(), fAxes, 1);
+      for (size_t i = 0; i < xN.size(); ++i)
+         binsN[i] = (binsN[i] >= 0) ? binsN[i] + 1 : GetBinIndexAndGrow(xN[i]);
+   }
+
    /// Get the bin index for the given local per-axis bin indices `x`, using
    /// `ComputeGlobalBin()`.
    int GetBinIndexFromLocalBins(const BinArray_t &x) const final
@@ -1057,9 +1132,7 @@ public:
       }
 #endif
 
-      for (size_t i = 0; i < xN.size(); ++i) {
-         Fill(xN[i], weightN[i]);
-      }
+      DoFillN(xN, weightN.data());
    }
 
    /// Fill an array of `weightN` to the bins specified by coordinates `xN`.
@@ -1067,8 +1140,21 @@ public:
    /// at the coordinate `xN[i]`
    void FillN(const std::span<const CoordArray_t> xN) final
    {
-      for (auto &&x: xN) {
-         Fill(x);
+      DoFillN(xN, nullptr);
+   }
+
+   /// Fill the points `xN` with the weights `weightN`, or 1 if `weightN` is
+   /// `nullptr`. The bins of a chunk of points are found with
+   /// `GetBinIndicesAndGrow()` before the points are filled.
+   void DoFillN(const std::span<const CoordArray_t> xN, const Weight_t *weightN)
+   {
+      constexpr size_t kChunkSize = 256;
+      int bins[kChunkSize];
+      for (size_t begin = 0; begin < xN.size(); begin += kChunkSize) {
+         const size_t n = std::min(kChunkSize, xN.size() - begin);
+         GetBinIndicesAndGrow(std::span<const CoordArray_t>(xN.data() + begin, n), bins);
+         for (size_t i = 0; i < n; ++i)
+            this->GetStat().Fill(xN[begin + i], bins[i], weightN ? weightN[begin + i] : (Weight_t)1);
       }
    }
 
@@ -5,16 +5,21 @@
 /// \author Axel Naumann <axel@cern.ch>
 
 #include "TRandom3.h"
+#include <algorithm>
 #include <vector>
 #include <chrono>
 #include <iostream>
+#include <thread>
+#include <utility>
 
 #include "TH1.h"
 #include "TH2.h"
 #include "TH3.h"
+#include "TH1ConcurrentFill.h"
 
 #include "ROOT/RHist.hxx"
 #include "ROOT/RHistBufferedFill.hxx"
+#include "ROOT/RHistConcurrentFill.hxx"
 
 using namespace ROOT;
 using namespace std;
@@ -737,6 +742,67 @@ void speedtest<float, 1>(size_t count)
    R6::Dim<DataType_t, kNDim>::II::Execute<R6::Dim<DataType_t, kNDim>::fill>(input, minVal, maxVal);
 }
 
+/// Fill a 2D histogram of doubles from `nThreads` threads, each filling its
+/// share of `input` through `fillChunk(begin, end)`.
+template <class FILLCHUNK>
+void concurrentFill(const char *title, std::vector<double> &input, unsigned nThreads, FILLCHUNK fillChunk)
+{
+   const size_t nPoints = input.size() / 2;
+   Timer t(title, nPoints);
+   std::vector<std::thread> threads;
+   for (unsigned i = 0; i < nThreads; ++i)
+      threads.emplace_back(fillChunk, nPoints * i / nThreads, nPoints * (i + 1) / nThreads);
+   for (auto &thr : threads)
+      thr.join();
+}
+
+void concurrentspeedtest(size_t count)
+{
+   using Hist_t = Experimental::RH2D;
+   using Manager_t = Experimental::RHistConcurrentFillManager<Hist_t>;
+
+   TH1::AddDirectory(kFALSE);
+
+   std::vector<double> input(count);
+   double minVal = -5.0;
+   double maxVal = +5.0;
+   GenerateInput(input, minVal, maxVal, 0);
+   minVal *= 0.9;
+   maxVal *= 0.9;
+
+   const unsigned nThreads = std::max(1u, std::thread::hardware_concurrency());
+   cout << '\n' << nThreads << " threads\n";
+
+   const std::pair<Manager_t::EMode, const char *> modes[] = {
+      {Manager_t::EMode::kLocked, "R7 2D concurrent fills (locked) "},
+      {Manager_t::EMode::kAtomic, "R7 2D concurrent fills (atomic) "},
+      {Manager_t::EMode::kSharded, "R7 2D concurrent fills (sharded)"}};
+   for (const auto &mode : modes) {
+      Hist_t hist({100, minVal, maxVal}, {5, minVal, maxVal});
+      Manager_t manager(hist, mode.first);
+      concurrentFill(mode.second, input, nThreads, [&](size_t begin, size_t end) {
+         auto filler = manager.MakeFiller();
+         for (size_t i = begin; i < end; ++i)
+            filler.Fill({input[2 * i], input[2 * i + 1]});
+      });
+   }
+
+   const std::pair<TH1ConcurrentFillManager::EMode, const char *> modesR6[] = {
+      {TH1ConcurrentFillManager::EMode::kAtomic, "R6 2D concurrent fills (atomic) "},
+      {TH1ConcurrentFillManager::EMode::kSharded, "R6 2D concurrent fills (sharded)"}};
+   for (const auto &mode : modesR6) {
+      TH2D hist("concurrent", "concurrent", 100, minVal, maxVal, 5, minVal, maxVal);
+      TH1ConcurrentFillManager manager(hist, mode.first);
+      concurrentFill(mode.second, input, nThreads, [&](size_t begin, size_t end) {
+         auto filler = manager.MakeFiller();
+         for (size_t i = begin; i < end; ++i)
+            filler.Fill(input[2 * i], input[2 * i + 1]);
+      });
+   }
+
+   cout << '\n';
+}
+
 void histspeedtest(size_t iter = 1e6, int what = 255)
 {
    if (what & 1)
@@ -747,6 +813,8 @@ void histspeedtest(size_t iter = 1e6, int what = 255)
       speedtest<double, 1>(iter);
    if (what & 8)
       speedtest<float, 1>(iter);
+   if (what & 16)
+      concurrentspeedtest(iter);
 }
 
 int main(int argc, char **argv)
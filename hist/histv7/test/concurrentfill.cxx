@@ -143,3 +143,62 @@ TEST(ConcurrentFillTest, FillFlush)
    EXPECT_EQ(0, (int)Filler_1.GetCoords().size());
    EXPECT_EQ(0, (int)Filler_2.GetCoords().size());
 }
+
+using Manager_t = Experimental::RHistConcurrentFillManager<Experimental::RH2D>;
+
+void concurrentHistFill(Experimental::RH2D &hist, Manager_t::EMode mode)
+{
+   Manager_t fillMgr(hist, mode);
+
+   std::array<std::thread, 4> threads;
+
+   for (auto &thr : threads) {
+      thr = std::thread(fillWithWeights, fillMgr.MakeFiller());
+   }
+
+   for (auto &thr : threads)
+      thr.join();
+}
+
+// Test that the atomic and sharded modes fill the same histogram as the locked mode
+TEST(ConcurrentFillTest, Modes)
+{
+   Experimental::RH2D histLocked{{100, 0., 1.}, {{0., 1., 2., 3., 10.}}};
+   concurrentHistFill(histLocked, Manager_t::EMode::kLocked);
+
+   for (auto mode : {Manager_t::EMode::kAtomic, Manager_t::EMode::kSharded}) {
+      Experimental::RH2D hist{{100, 0., 1.}, {{0., 1., 2., 3., 10.}}};
+      concurrentHistFill(hist, mode);
+      EXPECT_EQ(histLocked.GetEntries(), hist.GetEntries());
+      const auto &implLocked = *histLocked.GetImpl();
+      const auto &impl = *hist.GetImpl();
+      for (int bin = -impl.GetNOverflowBins(); bin <= impl.GetNBinsNoOver(); ++bin) {
+         if (bin == 0)
+            continue;
+         EXPECT_DOUBLE_EQ(implLocked.GetBinContentAsDouble(bin), impl.GetBinContentAsDouble(bin));
+         EXPECT_DOUBLE_EQ(implLocked.GetBinUncertainty(bin), impl.GetBinUncertainty(bin));
+      }
+   }
+}
+
+// Test that the sharded mode only fills the histogram on flush
+TEST(ConcurrentFillTest, ShardedFlush)
+{
+   Experimental::RH2D hist{{100, 0., 1.}, {{0., 1., 2., 3., 10.}}};
+   Manager_t fillMgr(hist, Manager_t::EMode::kSharded);
+
+   Filler_t filler = fillMgr.MakeFiller();
+   filler.Fill({0.1111, 4.22}, .42f);
+   filler.FillN({{0.1111, 4.22}, {0.3333, 4.44}});
+   EXPECT_EQ(0, hist.GetEntries());
+
+   filler.Flush();
+   EXPECT_EQ(3, hist.GetEntries());
+   EXPECT_FLOAT_EQ(1.42f, hist.GetBinContent({0.1111, 4.22}));
+   EXPECT_FLOAT_EQ(1.f, hist.GetBinContent({0.3333, 4.44}));
+
+   filler.Fill({0.3333, 4.44});
+   filler.Flush();
+   EXPECT_EQ(4, hist.GetEntries());
+   EXPECT_FLOAT_EQ(2.f, hist.GetBinContent({0.3333, 4.44}));
+}
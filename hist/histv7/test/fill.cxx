@@ -629,3 +629,30 @@ TEST(HistFillTest, FillN3DCoordsWeightsUncertainty)
    EXPECT_FLOAT_EQ(std::sqrt(weight2 * weight2), hist.GetBinUncertainty({0.2222, 4.33, 7.11}));
    EXPECT_FLOAT_EQ(std::sqrt((weight3 * weight3) + (weight2 * weight2)), hist.GetBinUncertainty({0.3333, 4.11, 7.22}));
 }
+
+// Test that FillN() of many points, in and out of the axes ranges, fills the same bins as Fill()
+TEST(HistFillTest, FillNSameAsFill)
+{
+   ROOT::Experimental::RH2D histFill({10, 0., 1.}, {{0., 1., 2., 5., 10.}});
+   ROOT::Experimental::RH2D histFillN({10, 0., 1.}, {{0., 1., 2., 5., 10.}});
+
+   std::vector<ROOT::Experimental::RH2D::CoordArray_t> coords;
+   std::vector<double> weights;
+   for (int i = 0; i < 1000; ++i) {
+      coords.push_back({-0.5 + 0.002 * i, -1. + 0.013 * i});
+      weights.push_back(0.5 + i % 7);
+   }
+   for (size_t i = 0; i < coords.size(); ++i)
+      histFill.Fill(coords[i], weights[i]);
+   histFillN.FillN(coords, weights);
+
+   EXPECT_EQ(histFill.GetEntries(), histFillN.GetEntries());
+   const auto &implFill = *histFill.GetImpl();
+   const auto &implFillN = *histFillN.GetImpl();
+   for (int bin = -implFill.GetNOverflowBins(); bin <= implFill.GetNBinsNoOver(); ++bin) {
+      if (bin == 0)
+         continue;
+      EXPECT_DOUBLE_EQ(implFill.GetBinContentAsDouble(bin), implFillN.GetBinContentAsDouble(bin));
+      EXPECT_DOUBLE_EQ(implFill.GetBinUncertainty(bin), implFillN.GetBinUncertainty(bin));
+   }
+}
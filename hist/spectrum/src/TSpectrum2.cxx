@@ -44,11 +44,110 @@
 #include "TList.h"
 #include "TH1.h"
 #include "TMath.h"
+#include "TSpectrumParallel.h"
+
+#include <algorithm>
+#include <vector>
+
 #define PEAK_WINDOW 1024
 
 Int_t TSpectrum2::fgIterations    = 3;
 Int_t TSpectrum2::fgAverageWindow = 3;
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// One clipping step of the SNIP algorithm (see TSpectrum2::Background) with the
+/// window (r1, r2): the new values of the channels [xmin, xmax) x [r2, ssizey - r2)
+/// of spectrum are written in work. The inner loop runs on the contiguous y channels,
+/// so that it can be vectorized. With clipPositive, the clipped values must be positive.
+
+template <typename T>
+void SnipClip(T **spectrum, T **work, Int_t xmin, Int_t xmax, Int_t ssizey, Int_t r1, Int_t r2, Int_t filterType,
+              Bool_t clipPositive = kTRUE)
+{
+   for (Int_t x = xmin; x < xmax; x++) {
+      const T *sm = spectrum[x - r1];
+      const T *s0 = spectrum[x];
+      const T *sp = spectrum[x + r1];
+      T *w = work[x];
+      if (filterType == TSpectrum2::kBackSuccessiveFiltering) {
+         for (Int_t y = r2; y < ssizey - r2; y++) {
+            const T a = s0[y];
+            const T p1 = sm[y - r2];
+            const T p2 = sm[y + r2];
+            const T p3 = sp[y - r2];
+            const T p4 = sp[y + r2];
+            T s1 = s0[y - r2];
+            T s2 = sm[y];
+            T s3 = sp[y];
+            T s4 = s0[y + r2];
+            s2 = std::max(s2, (p1 + p2) / T(2));
+            s1 = std::max(s1, (p1 + p3) / T(2));
+            s4 = std::max(s4, (p2 + p4) / T(2));
+            s3 = std::max(s3, (p3 + p4) / T(2));
+            s1 = s1 - (p1 + p3) / T(2);
+            s2 = s2 - (p1 + p2) / T(2);
+            s3 = s3 - (p3 + p4) / T(2);
+            s4 = s4 - (p2 + p4) / T(2);
+            const T b = (s1 + s4) / T(2) + (s2 + s3) / T(2) + (p1 + p2 + p3 + p4) / T(4);
+            w[y] = (b < a && (b > 0 || !clipPositive)) ? b : a;
+         }
+      } else {
+         for (Int_t y = r2; y < ssizey - r2; y++) {
+            const T a = s0[y];
+            const T b = -(sm[y - r2] + sm[y + r2] + sp[y - r2] + sp[y + r2]) / 4 +
+                        (s0[y - r2] + sm[y] + sp[y] + s0[y + r2]) / 2;
+            w[y] = (b < a && (b > 0 || !clipPositive)) ? b : a;
+         }
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Implementation of TSpectrum2::Background, for spectra of Double_t or Float_t.
+/// Each clipping step is computed in parallel on ranges of x channels when the
+/// implicit multithreading is enabled.
+
+template <typename T>
+const char *SnipBackground(T **spectrum, Int_t ssizex, Int_t ssizey, Int_t numberIterationsX, Int_t numberIterationsY,
+                           Int_t direction, Int_t filterType)
+{
+   if (ssizex <= 0 || ssizey <= 0)
+      return "Wrong parameters";
+   if (numberIterationsX < 1 || numberIterationsY < 1)
+      return "Width of Clipping Window Must Be Positive";
+   if (ssizex < 2 * numberIterationsX + 1
+        || ssizey < 2 * numberIterationsY + 1)
+      return ("Too Large Clipping Window");
+   if ((direction != TSpectrum2::kBackIncreasingWindow && direction != TSpectrum2::kBackDecreasingWindow) ||
+       (filterType != TSpectrum2::kBackSuccessiveFiltering && filterType != TSpectrum2::kBackOneStepFiltering))
+      return 0;
+   std::vector<T> workData((size_t)ssizex * ssizey);
+   std::vector<T *> work(ssizex);
+   for (Int_t x = 0; x < ssizex; x++)
+      work[x] = workData.data() + (size_t)x * ssizey;
+   const Int_t sampling = std::max(numberIterationsX, numberIterationsY);
+   for (Int_t step = 1; step <= sampling; step++) {
+      const Int_t i = (direction == TSpectrum2::kBackIncreasingWindow) ? step : sampling + 1 - step;
+      const Int_t r1 = std::min(i, numberIterationsX);
+      const Int_t r2 = std::min(i, numberIterationsY);
+      // the one step filtering updates only the channels at distance i from the edges
+      const Int_t c1 = (filterType == TSpectrum2::kBackSuccessiveFiltering) ? r1 : i;
+      const Int_t c2 = (filterType == TSpectrum2::kBackSuccessiveFiltering) ? r2 : i;
+      TSpectrumParallel::ForEachRange(r1, ssizex - r1, 30. * ssizey, [&](Int_t xmin, Int_t xmax) {
+         SnipClip(spectrum, work.data(), xmin, xmax, ssizey, r1, r2, filterType);
+      });
+      TSpectrumParallel::ForEachRange(c1, ssizex - c1, ssizey, [&](Int_t xmin, Int_t xmax) {
+         for (Int_t x = xmin; x < xmax; x++)
+            std::copy(work[x] + c2, work[x] + ssizey - c2, spectrum[x] + c2);
+      });
+   }
+   return 0;
+}
+
+} // namespace
+
 ClassImp(TSpectrum2);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -371,173 +470,22 @@ const char *TSpectrum2::Background(Double_t **spectrum,
                        Int_t direction,
                        Int_t filterType)
 {
-   Int_t i, x, y, sampling, r1, r2;
-   Double_t a, b, p1, p2, p3, p4, s1, s2, s3, s4;
-   if (ssizex <= 0 || ssizey <= 0)
-      return "Wrong parameters";
-   if (numberIterationsX < 1 || numberIterationsY < 1)
-      return "Width of Clipping Window Must Be Positive";
-   if (ssizex < 2 * numberIterationsX + 1
-        || ssizey < 2 * numberIterationsY + 1)
-      return ("Too Large Clipping Window");
-   Double_t **working_space = new Double_t*[ssizex];
-   for (i = 0; i < ssizex; i++)
-      working_space[i] = new Double_t[ssizey];
-   sampling =
-       (Int_t) TMath::Max(numberIterationsX, numberIterationsY);
-   if (direction == kBackIncreasingWindow) {
-      if (filterType == kBackSuccessiveFiltering) {
-         for (i = 1; i <= sampling; i++) {
-            r1 = (Int_t) TMath::Min(i, numberIterationsX), r2 =
-                (Int_t) TMath::Min(i, numberIterationsY);
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
-                  a = spectrum[x][y];
-                  p1 = spectrum[x - r1][y - r2];
-                  p2 = spectrum[x - r1][y + r2];
-                  p3 = spectrum[x + r1][y - r2];
-                  p4 = spectrum[x + r1][y + r2];
-                  s1 = spectrum[x][y - r2];
-                  s2 = spectrum[x - r1][y];
-                  s3 = spectrum[x + r1][y];
-                  s4 = spectrum[x][y + r2];
-                  b = (p1 + p2) / 2.0;
-                  if (b > s2)
-                     s2 = b;
-                  b = (p1 + p3) / 2.0;
-                  if (b > s1)
-                     s1 = b;
-                  b = (p2 + p4) / 2.0;
-                  if (b > s4)
-                     s4 = b;
-                  b = (p3 + p4) / 2.0;
-                  if (b > s3)
-                     s3 = b;
-                  s1 = s1 - (p1 + p3) / 2.0;
-                  s2 = s2 - (p1 + p2) / 2.0;
-                  s3 = s3 - (p3 + p4) / 2.0;
-                  s4 = s4 - (p2 + p4) / 2.0;
-                  b = (s1 + s4) / 2.0 + (s2 + s3) / 2.0 + (p1 + p2 +
-                                                            p3 +
-                                                            p4) / 4.0;
-                  if (b < a && b > 0)
-                     a = b;
-                  working_space[x][y] = a;
-               }
-            }
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
-                  spectrum[x][y] = working_space[x][y];
-               }
-            }
-         }
-      }
-
-      else if (filterType == kBackOneStepFiltering) {
-         for (i = 1; i <= sampling; i++) {
-            r1 = (Int_t) TMath::Min(i, numberIterationsX), r2 =
-                (Int_t) TMath::Min(i, numberIterationsY);
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
-                  a = spectrum[x][y];
-                  b = -(spectrum[x - r1][y - r2] +
-                         spectrum[x - r1][y + r2] + spectrum[x + r1][y -
-                                                                     r2]
-                         + spectrum[x + r1][y + r2]) / 4 +
-                      (spectrum[x][y - r2] + spectrum[x - r1][y] +
-                       spectrum[x + r1][y] + spectrum[x][y + r2]) / 2;
-                  if (b < a && b > 0)
-                     a = b;
-                  working_space[x][y] = a;
-               }
-            }
-            for (y = i; y < ssizey - i; y++) {
-               for (x = i; x < ssizex - i; x++) {
-                  spectrum[x][y] = working_space[x][y];
-               }
-            }
-         }
-      }
-   }
+   return SnipBackground(spectrum, ssizex, ssizey, numberIterationsX, numberIterationsY, direction, filterType);
+}
 
-   else if (direction == kBackDecreasingWindow) {
-      if (filterType == kBackSuccessiveFiltering) {
-         for (i = sampling; i >= 1; i--) {
-            r1 = (Int_t) TMath::Min(i, numberIterationsX), r2 =
-                (Int_t) TMath::Min(i, numberIterationsY);
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
-                  a = spectrum[x][y];
-                  p1 = spectrum[x - r1][y - r2];
-                  p2 = spectrum[x - r1][y + r2];
-                  p3 = spectrum[x + r1][y - r2];
-                  p4 = spectrum[x + r1][y + r2];
-                  s1 = spectrum[x][y - r2];
-                  s2 = spectrum[x - r1][y];
-                  s3 = spectrum[x + r1][y];
-                  s4 = spectrum[x][y + r2];
-                  b = (p1 + p2) / 2.0;
-                  if (b > s2)
-                     s2 = b;
-                  b = (p1 + p3) / 2.0;
-                  if (b > s1)
-                     s1 = b;
-                  b = (p2 + p4) / 2.0;
-                  if (b > s4)
-                     s4 = b;
-                  b = (p3 + p4) / 2.0;
-                  if (b > s3)
-                     s3 = b;
-                  s1 = s1 - (p1 + p3) / 2.0;
-                  s2 = s2 - (p1 + p2) / 2.0;
-                  s3 = s3 - (p3 + p4) / 2.0;
-                  s4 = s4 - (p2 + p4) / 2.0;
-                  b = (s1 + s4) / 2.0 + (s2 + s3) / 2.0 + (p1 + p2 +
-                                                            p3 +
-                                                            p4) / 4.0;
-                  if (b < a && b > 0)
-                     a = b;
-                  working_space[x][y] = a;
-               }
-            }
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
-                  spectrum[x][y] = working_space[x][y];
-               }
-            }
-         }
-      }
+////////////////////////////////////////////////////////////////////////////////
+/// Same as the Double_t version of Background, in single precision: the SIMD
+/// instructions process twice more channels at once, and the spectrum needs half
+/// the memory.
 
-      else if (filterType == kBackOneStepFiltering) {
-         for (i = sampling; i >= 1; i--) {
-            r1 = (Int_t) TMath::Min(i, numberIterationsX), r2 =
-                (Int_t) TMath::Min(i, numberIterationsY);
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
-                  a = spectrum[x][y];
-                  b = -(spectrum[x - r1][y - r2] +
-                         spectrum[x - r1][y + r2] + spectrum[x + r1][y -
-                                                                     r2]
-                         + spectrum[x + r1][y + r2]) / 4 +
-                      (spectrum[x][y - r2] + spectrum[x - r1][y] +
-                       spectrum[x + r1][y] + spectrum[x][y + r2]) / 2;
-                  if (b < a && b > 0)
-                     a = b;
-                  working_space[x][y] = a;
-               }
-            }
-            for (y = i; y < ssizey - i; y++) {
-               for (x = i; x < ssizex - i; x++) {
-                  spectrum[x][y] = working_space[x][y];
-               }
-            }
-         }
-      }
-   }
-   for (i = 0; i < ssizex; i++)
-      delete[]working_space[i];
-   delete[]working_space;
-   return 0;
+const char *TSpectrum2::Background(Float_t **spectrum,
+                       Int_t ssizex, Int_t ssizey,
+                       Int_t numberIterationsX,
+                       Int_t numberIterationsY,
+                       Int_t direction,
+                       Int_t filterType)
+{
+   return SnipBackground(spectrum, ssizex, ssizey, numberIterationsX, numberIterationsY, direction, filterType);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1093,14 +1041,13 @@ Int_t TSpectrum2::SearchHighRes(Double_t **source, Double_t **dest, Int_t ssizex
 {
    Int_t number_of_iterations = (Int_t)(4 * sigma + 0.5);
    Int_t k, lindex, priz;
-   Double_t lda, ldb, ldc, area, maximum;
+   Double_t lda, ldb, area, maximum;
    Int_t xmin, xmax, l, peak_index = 0, ssizex_ext = ssizex + 4 * number_of_iterations, ssizey_ext = ssizey + 4 * number_of_iterations, shift = 2 * number_of_iterations;
    Int_t ymin, ymax, i, j;
    Double_t a, b, ax, ay, maxch, plocha = 0;
    Double_t nom, nip, nim, sp, sm, spx, spy, smx, smy;
-   Double_t p1, p2, p3, p4, s1, s2, s3, s4;
-   Int_t x, y;
-   Int_t lhx, lhy, i1, i2, j1, j2, k1, k2, i1min, i1max, i2min, i2max, j1min, j1max, j2min, j2max, positx, posity;
+   Int_t x;
+   Int_t lhx, lhy, i1, i2, j1, i1min, i1max, i2min, i2max, positx, posity;
    if (sigma < 1) {
       Error("SearchHighRes", "Invalid sigma, must be greater than or equal to 1");
       return 0;
@@ -1173,45 +1120,18 @@ Int_t TSpectrum2::SearchHighRes(Double_t **source, Double_t **dest, Int_t ssizex
       }
    }
    if(backgroundRemove == true){
+      // the spectrum is in the second block of columns of working_space, the clipped values in the first one
+      std::vector<Double_t *> spectrum(ssizex_ext);
+      for(x = 0; x < ssizex_ext; x++)
+         spectrum[x] = working_space[x] + ssizey_ext;
       for(i = 1; i <= number_of_iterations; i++){
-         for(y = i; y < ssizey_ext - i; y++){
-            for(x = i; x < ssizex_ext - i; x++){
-               a = working_space[x][y + ssizey_ext];
-               p1 = working_space[x - i][y + ssizey_ext - i];
-               p2 = working_space[x - i][y + ssizey_ext + i];
-               p3 = working_space[x + i][y + ssizey_ext - i];
-               p4 = working_space[x + i][y + ssizey_ext + i];
-               s1 = working_space[x][y + ssizey_ext - i];
-               s2 = working_space[x - i][y + ssizey_ext];
-               s3 = working_space[x + i][y + ssizey_ext];
-               s4 = working_space[x][y + ssizey_ext + i];
-               b = (p1 + p2) / 2.0;
-               if(b > s2)
-                  s2 = b;
-               b = (p1 + p3) / 2.0;
-               if(b > s1)
-                  s1 = b;
-               b = (p2 + p4) / 2.0;
-               if(b > s4)
-                  s4 = b;
-               b = (p3 + p4) / 2.0;
-               if(b > s3)
-                  s3 = b;
-               s1 = s1 - (p1 + p3) / 2.0;
-               s2 = s2 - (p1 + p2) / 2.0;
-               s3 = s3 - (p3 + p4) / 2.0;
-               s4 = s4 - (p2 + p4) / 2.0;
-               b = (s1 + s4) / 2.0 + (s2 + s3) / 2.0 + (p1 + p2 + p3 + p4) / 4.0;
-               if(b < a)
-                  a = b;
-               working_space[x][y] = a;
-            }
-         }
-         for(y = i;y < ssizey_ext - i; y++){
-            for(x = i; x < ssizex_ext - i; x++){
-               working_space[x][y + ssizey_ext] = working_space[x][y];
-            }
-         }
+         TSpectrumParallel::ForEachRange(i, ssizex_ext - i, 30. * ssizey_ext, [&](Int_t xmin, Int_t xmax) {
+            SnipClip(spectrum.data(), working_space, xmin, xmax, ssizey_ext, i, i, kBackSuccessiveFiltering, kFALSE);
+         });
+         TSpectrumParallel::ForEachRange(i, ssizex_ext - i, ssizey_ext, [&](Int_t xmin, Int_t xmax) {
+            for (Int_t xc = xmin; xc < xmax; xc++)
+               std::copy(working_space[xc] + i, working_space[xc] + ssizey_ext - i, spectrum[xc] + i);
+         });
       }
       for(j = 0;j < ssizey_ext; j++){
          for(i = 0; i < ssizex_ext; i++){
@@ -1489,36 +1409,36 @@ Int_t TSpectrum2::SearchHighRes(Double_t **source, Double_t **dest, Int_t ssizex
 
    i1min = -i,i1max = i;
    i2min = -j,i2max = j;
-   for(i2 = i2min; i2 <= i2max; i2++){
-      for(i1 = i1min; i1 <= i1max; i1++){
-         ldc = 0;
-         j2min = -i2;
-         if(j2min < 0)
-            j2min = 0;
-
-         j2max = lhy - 1 - i2;
-         if(j2max > lhy - 1)
-            j2max = lhy - 1;
-
-         for(j2 = j2min; j2 <= j2max; j2++){
-            j1min = -i1;
-            if(j1min < 0)
-               j1min = 0;
-
-            j1max = lhx - 1 - i1;
-            if(j1max > lhx - 1)
-               j1max = lhx - 1;
-
-            for(j1 = j1min; j1 <= j1max; j1++){
-               lda = working_space[j1][j2];
-               ldb = working_space[i1 + j1][i2 + j2];
-               ldc = ldc + lda * ldb;
+   // the elements are independent: they are computed in parallel on ranges of i1
+   TSpectrumParallel::ForEachRange(i1min, i1max + 1, Double_t(i2max - i2min + 1) * lhx * lhy, [&](Int_t first, Int_t last) {
+      for(Int_t ii1 = first; ii1 < last; ii1++){
+         for(Int_t ii2 = i2min; ii2 <= i2max; ii2++){
+            Double_t sum = 0;
+            Int_t jj2min = -ii2;
+            if(jj2min < 0)
+               jj2min = 0;
+
+            Int_t jj2max = lhy - 1 - ii2;
+            if(jj2max > lhy - 1)
+               jj2max = lhy - 1;
+
+            for(Int_t jj2 = jj2min; jj2 <= jj2max; jj2++){
+               Int_t jj1min = -ii1;
+               if(jj1min < 0)
+                  jj1min = 0;
+
+               Int_t jj1max = lhx - 1 - ii1;
+               if(jj1max > lhx - 1)
+                  jj1max = lhx - 1;
+
+               for(Int_t jj1 = jj1min; jj1 <= jj1max; jj1++)
+                  sum = sum + working_space[jj1][jj2] * working_space[ii1 + jj1][ii2 + jj2];
             }
+            const Int_t kk = (ii1 + ssizex_ext) / ssizex_ext;
+            working_space[(ii1 + ssizex_ext) % ssizex_ext][ii2 + ssizey_ext + 10 * ssizey_ext + kk * 2 * ssizey_ext] = sum;
          }
-         k = (i1 + ssizex_ext) / ssizex_ext;
-         working_space[(i1 + ssizex_ext) % ssizex_ext][i2 + ssizey_ext + 10 * ssizey_ext + k * 2 * ssizey_ext] = ldc;
       }
-   }
+   });
    //calculate at*y and write into p
    i = lhx - 1;
    if(i > ssizex_ext)
@@ -1530,23 +1450,22 @@ Int_t TSpectrum2::SearchHighRes(Double_t **source, Double_t **dest, Int_t ssizex
 
    i2min = -j,i2max = ssizey_ext + j - 1;
    i1min = -i,i1max = ssizex_ext + i - 1;
-   for(i2 = i2min; i2 <= i2max; i2++){
-      for(i1=i1min;i1<=i1max;i1++){
-         ldc=0;
-         for(j2 = 0; j2 <= (lhy - 1); j2++){
-            for(j1 = 0; j1 <= (lhx - 1); j1++){
-               k2 = i2 + j2,k1 = i1 + j1;
-               if(k2 >= 0 && k2 < ssizey_ext && k1 >= 0 && k1 < ssizex_ext){
-                  lda = working_space[j1][j2];
-                  ldb = working_space[k1][k2 + 14 * ssizey_ext];
-                  ldc = ldc + lda * ldb;
+   TSpectrumParallel::ForEachRange(i1min, i1max + 1, Double_t(i2max - i2min + 1) * lhx * lhy, [&](Int_t first, Int_t last) {
+      for(Int_t ii1 = first; ii1 < last; ii1++){
+         for(Int_t ii2 = i2min; ii2 <= i2max; ii2++){
+            Double_t sum = 0;
+            for(Int_t jj2 = 0; jj2 <= (lhy - 1); jj2++){
+               for(Int_t jj1 = 0; jj1 <= (lhx - 1); jj1++){
+                  const Int_t kk2 = ii2 + jj2, kk1 = ii1 + jj1;
+                  if(kk2 >= 0 && kk2 < ssizey_ext && kk1 >= 0 && kk1 < ssizex_ext)
+                     sum = sum + working_space[jj1][jj2] * working_space[kk1][kk2 + 14 * ssizey_ext];
                }
             }
+            const Int_t kk = (ii1 + ssizex_ext) / ssizex_ext;
+            working_space[(ii1 + ssizex_ext) % ssizex_ext][ii2 + ssizey_ext + ssizey_ext + kk * 3 * ssizey_ext] = sum;
          }
-         k = (i1 + ssizex_ext) / ssizex_ext;
-         working_space[(i1 + ssizex_ext) % ssizex_ext][i2 + ssizey_ext + ssizey_ext + k * 3 * ssizey_ext] = ldc;
       }
-   }
+   });
    //move matrix p
    for(i2 = 0; i2 < ssizey_ext; i2++){
       for(i1 = 0; i1 < ssizex_ext; i1++){
@@ -1563,55 +1482,56 @@ Int_t TSpectrum2::SearchHighRes(Double_t **source, Double_t **dest, Int_t ssizex
       }
    }
    //START OF ITERATIONS
+   // the Gold iterations: the new value of each channel depends only on the values of the previous iteration, the
+   // channels are computed in parallel on ranges of i1. The rows of the matrix b=ht*h are looked up once per j1.
+   std::vector<const Double_t *> bRows(2 * lhx - 1);
+   for(j1 = -(lhx - 1); j1 <= lhx - 1; j1++){
+      k = (j1 + ssizex_ext) / ssizex_ext;
+      bRows[j1 + lhx - 1] = working_space[(j1 + ssizex_ext) % ssizex_ext] + ssizey_ext + 10 * ssizey_ext + k * 2 * ssizey_ext;
+   }
    for(lindex = 0; lindex < deconIterations; lindex++){
-      for(i2 = 0; i2 < ssizey_ext; i2++){
-         for(i1 = 0; i1 < ssizex_ext; i1++){
-            lda = working_space[i1][i2 + ssizey_ext];
-            ldc = working_space[i1][i2 + 14 * ssizey_ext];
-            if(lda > 0.000001 && ldc > 0.000001){
-               ldb=0;
-               j2min=i2;
-               if(j2min > lhy - 1)
-                  j2min = lhy - 1;
-
-               j2min = -j2min;
-               j2max = ssizey_ext - i2 - 1;
-               if(j2max > lhy - 1)
-                  j2max = lhy - 1;
-
-               j1min = i1;
-               if(j1min > lhx - 1)
-                  j1min = lhx - 1;
-
-               j1min = -j1min;
-               j1max = ssizex_ext - i1 - 1;
-               if(j1max > lhx - 1)
-                  j1max = lhx - 1;
-
-               for(j2 = j2min; j2 <= j2max; j2++){
-                  for(j1 = j1min; j1 <= j1max; j1++){
-                     k = (j1 + ssizex_ext) / ssizex_ext;
-                     ldc = working_space[(j1 + ssizex_ext) % ssizex_ext][j2 + ssizey_ext + 10 * ssizey_ext + k * 2 * ssizey_ext];
-                     lda = working_space[i1 + j1][i2 + j2 + ssizey_ext];
-                     ldb = ldb + lda * ldc;
+      TSpectrumParallel::ForEachRange(0, ssizex_ext, Double_t(ssizey_ext) * lhx * lhy, [&](Int_t first, Int_t last) {
+         for(Int_t ii1 = first; ii1 < last; ii1++){
+            for(Int_t ii2 = 0; ii2 < ssizey_ext; ii2++){
+               Double_t x1 = working_space[ii1][ii2 + ssizey_ext];
+               const Double_t p = working_space[ii1][ii2 + 14 * ssizey_ext];
+               if(x1 > 0.000001 && p > 0.000001){
+                  Double_t sum = 0;
+                  Int_t jj2min = ii2;
+                  if(jj2min > lhy - 1)
+                     jj2min = lhy - 1;
+
+                  jj2min = -jj2min;
+                  Int_t jj2max = ssizey_ext - ii2 - 1;
+                  if(jj2max > lhy - 1)
+                     jj2max = lhy - 1;
+
+                  Int_t jj1min = ii1;
+                  if(jj1min > lhx - 1)
+                     jj1min = lhx - 1;
+
+                  jj1min = -jj1min;
+                  Int_t jj1max = ssizex_ext - ii1 - 1;
+                  if(jj1max > lhx - 1)
+                     jj1max = lhx - 1;
+
+                  for(Int_t jj2 = jj2min; jj2 <= jj2max; jj2++){
+                     for(Int_t jj1 = jj1min; jj1 <= jj1max; jj1++)
+                        sum = sum + working_space[ii1 + jj1][ii2 + jj2 + ssizey_ext] * bRows[jj1 + lhx - 1][jj2];
+                  }
+                  if(p * x1 != 0 && sum != 0){
+                     x1 = x1 * p / sum;
                   }
-               }
-               lda = working_space[i1][i2 + ssizey_ext];
-               ldc = working_space[i1][i2 + 14 * ssizey_ext];
-               if(ldc * lda != 0 && ldb != 0){
-                  lda =lda * ldc / ldb;
-               }
 
-               else
-                  lda=0;
-               working_space[i1][i2 + 2 * ssizey_ext] = lda;
+                  else
+                     x1 = 0;
+                  working_space[ii1][ii2 + 2 * ssizey_ext] = x1;
+               }
             }
          }
-      }
-      for(i2 = 0; i2 < ssizey_ext; i2++){
-         for(i1 = 0; i1 < ssizex_ext; i1++)
-            working_space[i1][i2 + ssizey_ext] = working_space[i1][i2 + 2 * ssizey_ext];
-      }
+      });
+      for(i1 = 0; i1 < ssizex_ext; i1++)
+         std::copy(working_space[i1] + 2 * ssizey_ext, working_space[i1] + 3 * ssizey_ext, working_space[i1] + ssizey_ext);
    }
    //looking for maximum
    maximum=0;
@@ -48,8 +48,168 @@
 #include "TSpectrum3.h"
 #include "TH1.h"
 #include "TMath.h"
+#include "TSpectrumParallel.h"
+
+#include <algorithm>
+#include <vector>
+
 #define PEAK_WINDOW 1024
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// One clipping step of the SNIP algorithm (see TSpectrum3::Background) with the
+/// window (q1, q2, q3): the new values of the channels [xmin, xmax) x [q2, ssizey - q2)
+/// x [q3, ssizez - q3) of spectrum, read at z + zoffset, are written in work. The inner
+/// loop runs on the contiguous z channels, so that it can be vectorized.
+
+template <typename T>
+void SnipClip3(T ***spectrum, T ***work, Int_t xmin, Int_t xmax, Int_t ssizey, Int_t ssizez, Int_t q1, Int_t q2,
+               Int_t q3, Int_t filterType, Int_t zoffset = 0)
+{
+   for (Int_t x = xmin; x < xmax; x++) {
+      for (Int_t y = q2; y < ssizey - q2; y++) {
+         // rows of the neighbours at (x - q1, x, x + q1) x (y - q2, y, y + q2)
+         const T *mm = spectrum[x - q1][y - q2] + zoffset;
+         const T *m0 = spectrum[x - q1][y] + zoffset;
+         const T *mp = spectrum[x - q1][y + q2] + zoffset;
+         const T *zm = spectrum[x][y - q2] + zoffset;
+         const T *z0 = spectrum[x][y] + zoffset;
+         const T *zp = spectrum[x][y + q2] + zoffset;
+         const T *pm = spectrum[x + q1][y - q2] + zoffset;
+         const T *p0 = spectrum[x + q1][y] + zoffset;
+         const T *pp = spectrum[x + q1][y + q2] + zoffset;
+         T *w = work[x][y];
+         for (Int_t z = q3; z < ssizez - q3; z++) {
+            const T a = z0[z];
+            const T p1 = pp[z - q3];
+            const T p2 = mp[z - q3];
+            const T p3 = pm[z - q3];
+            const T p4 = mm[z - q3];
+            const T p5 = pp[z + q3];
+            const T p6 = mp[z + q3];
+            const T p7 = pm[z + q3];
+            const T p8 = mm[z + q3];
+            T s1 = p0[z - q3];
+            T s2 = zp[z - q3];
+            T s3 = m0[z - q3];
+            T s4 = zm[z - q3];
+            T s5 = p0[z + q3];
+            T s6 = zp[z + q3];
+            T s7 = m0[z + q3];
+            T s8 = zm[z + q3];
+            T s9 = mp[z];
+            T s10 = mm[z];
+            T s11 = pp[z];
+            T s12 = pm[z];
+            T r1 = z0[z - q3];
+            T r2 = z0[z + q3];
+            T r3 = m0[z];
+            T r4 = p0[z];
+            T r5 = zp[z];
+            T r6 = zm[z];
+            if (filterType == TSpectrum3::kBackSuccessiveFiltering) {
+               s1 = std::max(s1, (p1 + p3) / T(2));
+               s2 = std::max(s2, (p1 + p2) / T(2));
+               s3 = std::max(s3, (p2 + p4) / T(2));
+               s4 = std::max(s4, (p3 + p4) / T(2));
+               s5 = std::max(s5, (p5 + p7) / T(2));
+               s6 = std::max(s6, (p5 + p6) / T(2));
+               s7 = std::max(s7, (p6 + p8) / T(2));
+               s8 = std::max(s8, (p7 + p8) / T(2));
+               s9 = std::max(s9, (p2 + p6) / T(2));
+               s10 = std::max(s10, (p4 + p8) / T(2));
+               s11 = std::max(s11, (p1 + p5) / T(2));
+               s12 = std::max(s12, (p3 + p7) / T(2));
+               s1 = s1 - (p1 + p3) / T(2);
+               s2 = s2 - (p1 + p2) / T(2);
+               s3 = s3 - (p2 + p4) / T(2);
+               s4 = s4 - (p3 + p4) / T(2);
+               s5 = s5 - (p5 + p7) / T(2);
+               s6 = s6 - (p5 + p6) / T(2);
+               s7 = s7 - (p6 + p8) / T(2);
+               s8 = s8 - (p7 + p8) / T(2);
+               s9 = s9 - (p2 + p6) / T(2);
+               s10 = s10 - (p4 + p8) / T(2);
+               s11 = s11 - (p1 + p5) / T(2);
+               s12 = s12 - (p3 + p7) / T(2);
+               const T b1 = (s1 + s3) / T(2) + (s2 + s4) / T(2) + (p1 + p2 + p3 + p4) / T(4);
+               const T b2 = (s5 + s7) / T(2) + (s6 + s8) / T(2) + (p5 + p6 + p7 + p8) / T(4);
+               const T b3 = (s3 + s7) / T(2) + (s9 + s10) / T(2) + (p2 + p4 + p6 + p8) / T(4);
+               const T b4 = (s1 + s5) / T(2) + (s11 + s12) / T(2) + (p1 + p3 + p5 + p7) / T(4);
+               const T b5 = (s9 + s11) / T(2) + (s2 + s6) / T(2) + (p1 + p2 + p5 + p6) / T(4);
+               const T b6 = (s4 + s8) / T(2) + (s10 + s12) / T(2) + (p3 + p4 + p7 + p8) / T(4);
+               r1 = std::max(r1, b1) - b1;
+               r2 = std::max(r2, b2) - b2;
+               r3 = std::max(r3, b3) - b3;
+               r4 = std::max(r4, b4) - b4;
+               r5 = std::max(r5, b5) - b5;
+               r6 = std::max(r6, b6) - b6;
+               const T b = (r1 + r2) / T(2) + (r3 + r4) / T(2) + (r5 + r6) / T(2) + (s1 + s3 + s5 + s7) / T(4) +
+                           (s2 + s4 + s6 + s8) / T(4) + (s9 + s10 + s11 + s12) / T(4) +
+                           (p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / T(8);
+               w[z] = (b < a) ? b : a;
+            } else {
+               const T b = (p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8 -
+                           (s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 4 +
+                           (r1 + r2 + r3 + r4 + r5 + r6) / 2;
+               const T c = -(s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 4 +
+                           (r1 + r2 + r3 + r4 + r5 + r6) / 2;
+               const T d = -(p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8 +
+                           (s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 12;
+               w[z] = (b < a && b >= 0 && c >= 0 && d >= 0) ? b : a;
+            }
+         }
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Implementation of TSpectrum3::Background, for spectra of Double_t or Float_t.
+/// Each clipping step is computed in parallel on ranges of x channels when the
+/// implicit multithreading is enabled.
+
+template <typename T>
+const char *SnipBackground3(T ***spectrum, Int_t ssizex, Int_t ssizey, Int_t ssizez, Int_t numberIterationsX,
+                            Int_t numberIterationsY, Int_t numberIterationsZ, Int_t direction, Int_t filterType)
+{
+   if (ssizex <= 0 || ssizey <= 0 || ssizez <= 0)
+      return "Wrong parameters";
+   if (numberIterationsX < 1 || numberIterationsY < 1 || numberIterationsZ < 1)
+      return "Width of Clipping Window Must Be Positive";
+   if (ssizex < 2 * numberIterationsX + 1 || ssizey < 2 * numberIterationsY + 1 || ssizey < 2 * numberIterationsZ + 1)
+      return ("Too Large Clipping Window");
+   if ((direction != TSpectrum3::kBackIncreasingWindow && direction != TSpectrum3::kBackDecreasingWindow) ||
+       (filterType != TSpectrum3::kBackSuccessiveFiltering && filterType != TSpectrum3::kBackOneStepFiltering))
+      return 0;
+   std::vector<T> workData((size_t)ssizex * ssizey * ssizez);
+   std::vector<T *> workRows((size_t)ssizex * ssizey);
+   std::vector<T **> work(ssizex);
+   for (Int_t x = 0; x < ssizex; x++) {
+      work[x] = workRows.data() + (size_t)x * ssizey;
+      for (Int_t y = 0; y < ssizey; y++)
+         work[x][y] = workData.data() + ((size_t)x * ssizey + y) * ssizez;
+   }
+   const Int_t sampling = std::max(std::max(numberIterationsX, numberIterationsY), numberIterationsZ);
+   for (Int_t step = 1; step <= sampling; step++) {
+      const Int_t i = (direction == TSpectrum3::kBackIncreasingWindow) ? step : sampling + 1 - step;
+      const Int_t q1 = std::min(i, numberIterationsX);
+      const Int_t q2 = std::min(i, numberIterationsY);
+      const Int_t q3 = std::min(i, numberIterationsZ);
+      TSpectrumParallel::ForEachRange(q1, ssizex - q1, 100. * ssizey * ssizez, [&](Int_t xmin, Int_t xmax) {
+         SnipClip3(spectrum, work.data(), xmin, xmax, ssizey, ssizez, q1, q2, q3, filterType);
+      });
+      TSpectrumParallel::ForEachRange(q1, ssizex - q1, 1. * ssizey * ssizez, [&](Int_t xmin, Int_t xmax) {
+         for (Int_t x = xmin; x < xmax; x++)
+            for (Int_t y = q2; y < ssizey - q2; y++)
+               std::copy(work[x][y] + q3, work[x][y] + ssizez - q3, spectrum[x][y] + q3);
+      });
+   }
+   return 0;
+}
+
+} // namespace
+
 ClassImp(TSpectrum3);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -389,380 +549,25 @@ const char *TSpectrum3::Background(Double_t***spectrum,
                        Int_t direction,
                        Int_t filterType)
 {
-   Int_t i, j, x, y, z, sampling, q1, q2, q3;
-   Double_t a, b, c, d, p1, p2, p3, p4, p5, p6, p7, p8, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12, r1, r2, r3, r4, r5, r6;
-   if (ssizex <= 0 || ssizey <= 0 || ssizez <= 0)
-      return "Wrong parameters";
-   if (numberIterationsX < 1 || numberIterationsY < 1 || numberIterationsZ < 1)
-      return "Width of Clipping Window Must Be Positive";
-   if (ssizex < 2 * numberIterationsX + 1 || ssizey < 2 * numberIterationsY + 1 || ssizey < 2 * numberIterationsZ + 1)
-      return ("Too Large Clipping Window");
-   Double_t*** working_space=new Double_t**[ssizex];
-   for(i=0;i<ssizex;i++){
-      working_space[i] =new Double_t*[ssizey];
-      for(j=0;j<ssizey;j++)
-         working_space[i][j]=new Double_t[ssizez];
-   }
-   sampling =(Int_t) TMath::Max(numberIterationsX, numberIterationsY);
-   sampling =(Int_t) TMath::Max(sampling, numberIterationsZ);
-   if (direction == kBackIncreasingWindow) {
-      if (filterType == kBackSuccessiveFiltering) {
-         for (i = 1; i <= sampling; i++) {
-            q1 = (Int_t) TMath::Min(i, numberIterationsX), q2 =(Int_t) TMath::Min(i, numberIterationsY), q3 =(Int_t) TMath::Min(i, numberIterationsZ);
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     a = spectrum[x][y][z];
-                     p1 = spectrum[x + q1][y + q2][z - q3];
-                     p2 = spectrum[x - q1][y + q2][z - q3];
-                     p3 = spectrum[x + q1][y - q2][z - q3];
-                     p4 = spectrum[x - q1][y - q2][z - q3];
-                     p5 = spectrum[x + q1][y + q2][z + q3];
-                     p6 = spectrum[x - q1][y + q2][z + q3];
-                     p7 = spectrum[x + q1][y - q2][z + q3];
-                     p8 = spectrum[x - q1][y - q2][z + q3];
-                     s1 = spectrum[x + q1][y     ][z - q3];
-                     s2 = spectrum[x     ][y + q2][z - q3];
-                     s3 = spectrum[x - q1][y     ][z - q3];
-                     s4 = spectrum[x     ][y - q2][z - q3];
-                     s5 = spectrum[x + q1][y     ][z + q3];
-                     s6 = spectrum[x     ][y + q2][z + q3];
-                     s7 = spectrum[x - q1][y     ][z + q3];
-                     s8 = spectrum[x     ][y - q2][z + q3];
-                     s9 = spectrum[x - q1][y + q2][z     ];
-                     s10 = spectrum[x - q1][y - q2][z     ];
-                     s11 = spectrum[x + q1][y + q2][z     ];
-                     s12 = spectrum[x + q1][y - q2][z     ];
-                     r1 = spectrum[x     ][y     ][z - q3];
-                     r2 = spectrum[x     ][y     ][z + q3];
-                     r3 = spectrum[x - q1][y     ][z     ];
-                     r4 = spectrum[x + q1][y     ][z     ];
-                     r5 = spectrum[x     ][y + q2][z     ];
-                     r6 = spectrum[x     ][y - q2][z     ];
-                     b = (p1 + p3) / 2.0;
-                     if(b > s1)
-                        s1 = b;
-                     b = (p1 + p2) / 2.0;
-                     if(b > s2)
-                        s2 = b;
-                     b = (p2 + p4) / 2.0;
-                     if(b > s3)
-                        s3 = b;
-                     b = (p3 + p4) / 2.0;
-                     if(b > s4)
-                        s4 = b;
-                     b = (p5 + p7) / 2.0;
-                     if(b > s5)
-                        s5 = b;
-                     b = (p5 + p6) / 2.0;
-                     if(b > s6)
-                        s6 = b;
-                     b = (p6 + p8) / 2.0;
-                     if(b > s7)
-                        s7 = b;
-                     b = (p7 + p8) / 2.0;
-                     if(b > s8)
-                        s8 = b;
-                     b = (p2 + p6) / 2.0;
-                     if(b > s9)
-                        s9 = b;
-                     b = (p4 + p8) / 2.0;
-                     if(b > s10)
-                        s10 = b;
-                     b = (p1 + p5) / 2.0;
-                     if(b > s11)
-                        s11 = b;
-                     b = (p3 + p7) / 2.0;
-                     if(b > s12)
-                        s12 = b;
-                     s1 = s1 - (p1 + p3) / 2.0;
-                     s2 = s2 - (p1 + p2) / 2.0;
-                     s3 = s3 - (p2 + p4) / 2.0;
-                     s4 = s4 - (p3 + p4) / 2.0;
-                     s5 = s5 - (p5 + p7) / 2.0;
-                     s6 = s6 - (p5 + p6) / 2.0;
-                     s7 = s7 - (p6 + p8) / 2.0;
-                     s8 = s8 - (p7 + p8) / 2.0;
-                     s9 = s9 - (p2 + p6) / 2.0;
-                     s10 = s10 - (p4 + p8) / 2.0;
-                     s11 = s11 - (p1 + p5) / 2.0;
-                     s12 = s12 - (p3 + p7) / 2.0;
-                     b = (s1 + s3) / 2.0 + (s2 + s4) / 2.0 + (p1 + p2 + p3 + p4) / 4.0;
-                     if(b > r1)
-                        r1 = b;
-                     b = (s5 + s7) / 2.0 + (s6 + s8) / 2.0 + (p5 + p6 + p7 + p8) / 4.0;
-                     if(b > r2)
-                        r2 = b;
-                     b = (s3 + s7) / 2.0 + (s9 + s10) / 2.0 + (p2 + p4 + p6 + p8) / 4.0;
-                     if(b > r3)
-                        r3 = b;
-                     b = (s1 + s5) / 2.0 + (s11 + s12) / 2.0 + (p1 + p3 + p5 + p7) / 4.0;
-                     if(b > r4)
-                        r4 = b;
-                     b = (s9 + s11) / 2.0 + (s2 + s6) / 2.0 + (p1 + p2 + p5 + p6) / 4.0;
-                     if(b > r5)
-                        r5 = b;
-                     b = (s4 + s8) / 2.0 + (s10 + s12) / 2.0 + (p3 + p4 + p7 + p8) / 4.0;
-                     if(b > r6)
-                        r6 = b;
-                     r1 = r1 - ((s1 + s3) / 2.0 + (s2 + s4) / 2.0 + (p1 + p2 + p3 + p4) / 4.0);
-                     r2 = r2 - ((s5 + s7) / 2.0 + (s6 + s8) / 2.0 + (p5 + p6 + p7 + p8) / 4.0);
-                     r3 = r3 - ((s3 + s7) / 2.0 + (s9 + s10) / 2.0 + (p2 + p4 + p6 + p8) / 4.0);
-                     r4 = r4 - ((s1 + s5) / 2.0 + (s11 + s12) / 2.0 + (p1 + p3 + p5 + p7) / 4.0);
-                     r5 = r5 - ((s9 + s11) / 2.0 + (s2 + s6) / 2.0 + (p1 + p2 + p5 + p6) / 4.0);
-                     r6 = r6 - ((s4 + s8) / 2.0 + (s10 + s12) / 2.0 + (p3 + p4 + p7 + p8) / 4.0);
-                     b = (r1 + r2) / 2.0 + (r3 + r4) / 2.0 + (r5 + r6) / 2.0 + (s1 + s3 + s5 + s7) / 4.0 + (s2 + s4 + s6 + s8) / 4.0 + (s9 + s10 + s11 + s12) / 4.0 + (p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8.0;
-                     if(b < a)
-                        a = b;
-                     working_space[x][y][z] = a;
-                  }
-               }
-            }
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     spectrum[x][y][z] = working_space[x][y][z];
-                  }
-               }
-            }
-         }
-      }
-
-      else if (filterType == kBackOneStepFiltering) {
-         for (i = 1; i <= sampling; i++) {
-            q1 = (Int_t) TMath::Min(i, numberIterationsX), q2 =(Int_t) TMath::Min(i, numberIterationsY), q3 =(Int_t) TMath::Min(i, numberIterationsZ);
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     a = spectrum[x][y][z];
-                     p1 = spectrum[x + q1][y + q2][z - q3];
-                     p2 = spectrum[x - q1][y + q2][z - q3];
-                     p3 = spectrum[x + q1][y - q2][z - q3];
-                     p4 = spectrum[x - q1][y - q2][z - q3];
-                     p5 = spectrum[x + q1][y + q2][z + q3];
-                     p6 = spectrum[x - q1][y + q2][z + q3];
-                     p7 = spectrum[x + q1][y - q2][z + q3];
-                     p8 = spectrum[x - q1][y - q2][z + q3];
-                     s1 = spectrum[x + q1][y     ][z - q3];
-                     s2 = spectrum[x     ][y + q2][z - q3];
-                     s3 = spectrum[x - q1][y     ][z - q3];
-                     s4 = spectrum[x     ][y - q2][z - q3];
-                     s5 = spectrum[x + q1][y     ][z + q3];
-                     s6 = spectrum[x     ][y + q2][z + q3];
-                     s7 = spectrum[x - q1][y     ][z + q3];
-                     s8 = spectrum[x     ][y - q2][z + q3];
-                     s9 = spectrum[x - q1][y + q2][z     ];
-                     s10 = spectrum[x - q1][y - q2][z     ];
-                     s11 = spectrum[x + q1][y + q2][z     ];
-                     s12 = spectrum[x + q1][y - q2][z     ];
-                     r1 = spectrum[x     ][y     ][z - q3];
-                     r2 = spectrum[x     ][y     ][z + q3];
-                     r3 = spectrum[x - q1][y     ][z     ];
-                     r4 = spectrum[x + q1][y     ][z     ];
-                     r5 = spectrum[x     ][y + q2][z     ];
-                     r6 = spectrum[x     ][y - q2][z     ];
-                     b=(p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8 - (s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 4 + (r1 + r2 + r3 + r4 + r5 + r6) / 2;
-                     c = -(s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 4 + (r1 + r2 + r3 + r4 + r5 + r6) / 2;
-                     d = -(p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8 + (s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 12;
-                     if(b < a && b >= 0 && c >=0 && d >= 0)
-                        a = b;
-                     working_space[x][y][z] = a;
-                  }
-               }
-            }
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     spectrum[x][y][z] = working_space[x][y][z];
-                  }
-               }
-            }
-         }
-      }
-   }
+   return SnipBackground3(spectrum, ssizex, ssizey, ssizez, numberIterationsX, numberIterationsY, numberIterationsZ,
+                          direction, filterType);
+}
 
-   else if (direction == kBackDecreasingWindow) {
-      if (filterType == kBackSuccessiveFiltering) {
-         for (i = sampling; i >= 1; i--) {
-            q1 = (Int_t) TMath::Min(i, numberIterationsX), q2 =(Int_t) TMath::Min(i, numberIterationsY), q3 =(Int_t) TMath::Min(i, numberIterationsZ);
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     a = spectrum[x][y][z];
-                     p1 = spectrum[x + q1][y + q2][z - q3];
-                     p2 = spectrum[x - q1][y + q2][z - q3];
-                     p3 = spectrum[x + q1][y - q2][z - q3];
-                     p4 = spectrum[x - q1][y - q2][z - q3];
-                     p5 = spectrum[x + q1][y + q2][z + q3];
-                     p6 = spectrum[x - q1][y + q2][z + q3];
-                     p7 = spectrum[x + q1][y - q2][z + q3];
-                     p8 = spectrum[x - q1][y - q2][z + q3];
-                     s1 = spectrum[x + q1][y     ][z - q3];
-                     s2 = spectrum[x     ][y + q2][z - q3];
-                     s3 = spectrum[x - q1][y     ][z - q3];
-                     s4 = spectrum[x     ][y - q2][z - q3];
-                     s5 = spectrum[x + q1][y     ][z + q3];
-                     s6 = spectrum[x     ][y + q2][z + q3];
-                     s7 = spectrum[x - q1][y     ][z + q3];
-                     s8 = spectrum[x     ][y - q2][z + q3];
-                     s9 = spectrum[x - q1][y + q2][z     ];
-                     s10 = spectrum[x - q1][y - q2][z     ];
-                     s11 = spectrum[x + q1][y + q2][z     ];
-                     s12 = spectrum[x + q1][y - q2][z     ];
-                     r1 = spectrum[x     ][y     ][z - q3];
-                     r2 = spectrum[x     ][y     ][z + q3];
-                     r3 = spectrum[x - q1][y     ][z     ];
-                     r4 = spectrum[x + q1][y     ][z     ];
-                     r5 = spectrum[x     ][y + q2][z     ];
-                     r6 = spectrum[x     ][y - q2][z     ];
-                     b = (p1 + p3) / 2.0;
-                     if(b > s1)
-                        s1 = b;
-                     b = (p1 + p2) / 2.0;
-                     if(b > s2)
-                        s2 = b;
-                     b = (p2 + p4) / 2.0;
-                     if(b > s3)
-                        s3 = b;
-                     b = (p3 + p4) / 2.0;
-                     if(b > s4)
-                        s4 = b;
-                     b = (p5 + p7) / 2.0;
-                     if(b > s5)
-                        s5 = b;
-                     b = (p5 + p6) / 2.0;
-                     if(b > s6)
-                        s6 = b;
-                     b = (p6 + p8) / 2.0;
-                     if(b > s7)
-                        s7 = b;
-                     b = (p7 + p8) / 2.0;
-                     if(b > s8)
-                        s8 = b;
-                     b = (p2 + p6) / 2.0;
-                     if(b > s9)
-                        s9 = b;
-                     b = (p4 + p8) / 2.0;
-                     if(b > s10)
-                        s10 = b;
-                     b = (p1 + p5) / 2.0;
-                     if(b > s11)
-                        s11 = b;
-                     b = (p3 + p7) / 2.0;
-                     if(b > s12)
-                        s12 = b;
-                     s1 = s1 - (p1 + p3) / 2.0;
-                     s2 = s2 - (p1 + p2) / 2.0;
-                     s3 = s3 - (p2 + p4) / 2.0;
-                     s4 = s4 - (p3 + p4) / 2.0;
-                     s5 = s5 - (p5 + p7) / 2.0;
-                     s6 = s6 - (p5 + p6) / 2.0;
-                     s7 = s7 - (p6 + p8) / 2.0;
-                     s8 = s8 - (p7 + p8) / 2.0;
-                     s9 = s9 - (p2 + p6) / 2.0;
-                     s10 = s10 - (p4 + p8) / 2.0;
-                     s11 = s11 - (p1 + p5) / 2.0;
-                     s12 = s12 - (p3 + p7) / 2.0;
-                     b = (s1 + s3) / 2.0 + (s2 + s4) / 2.0 + (p1 + p2 + p3 + p4) / 4.0;
-                     if(b > r1)
-                        r1 = b;
-                     b = (s5 + s7) / 2.0 + (s6 + s8) / 2.0 + (p5 + p6 + p7 + p8) / 4.0;
-                     if(b > r2)
-                        r2 = b;
-                     b = (s3 + s7) / 2.0 + (s9 + s10) / 2.0 + (p2 + p4 + p6 + p8) / 4.0;
-                     if(b > r3)
-                        r3 = b;
-                     b = (s1 + s5) / 2.0 + (s11 + s12) / 2.0 + (p1 + p3 + p5 + p7) / 4.0;
-                     if(b > r4)
-                        r4 = b;
-                     b = (s9 + s11) / 2.0 + (s2 + s6) / 2.0 + (p1 + p2 + p5 + p6) / 4.0;
-                     if(b > r5)
-                        r5 = b;
-                     b = (s4 + s8) / 2.0 + (s10 + s12) / 2.0 + (p3 + p4 + p7 + p8) / 4.0;
-                     if(b > r6)
-                        r6 = b;
-                     r1 = r1 - ((s1 + s3) / 2.0 + (s2 + s4) / 2.0 + (p1 + p2 + p3 + p4) / 4.0);
-                     r2 = r2 - ((s5 + s7) / 2.0 + (s6 + s8) / 2.0 + (p5 + p6 + p7 + p8) / 4.0);
-                     r3 = r3 - ((s3 + s7) / 2.0 + (s9 + s10) / 2.0 + (p2 + p4 + p6 + p8) / 4.0);
-                     r4 = r4 - ((s1 + s5) / 2.0 + (s11 + s12) / 2.0 + (p1 + p3 + p5 + p7) / 4.0);
-                     r5 = r5 - ((s9 + s11) / 2.0 + (s2 + s6) / 2.0 + (p1 + p2 + p5 + p6) / 4.0);
-                     r6 = r6 - ((s4 + s8) / 2.0 + (s10 + s12) / 2.0 + (p3 + p4 + p7 + p8) / 4.0);
-                     b = (r1 + r2) / 2.0 + (r3 + r4) / 2.0 + (r5 + r6) / 2.0 + (s1 + s3 + s5 + s7) / 4.0 + (s2 + s4 + s6 + s8) / 4.0 + (s9 + s10 + s11 + s12) / 4.0 + (p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8.0;
-                     if(b < a)
-                        a = b;
-                     working_space[x][y][z] = a;
-                  }
-               }
-            }
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     spectrum[x][y][z] = working_space[x][y][z];
-                  }
-               }
-            }
-         }
-      }
+////////////////////////////////////////////////////////////////////////////////
+/// Same as the Double_t version of Background, in single precision: the SIMD
+/// instructions process twice more channels at once, and the spectrum needs half
+/// the memory.
 
-      else if (filterType == kBackOneStepFiltering) {
-         for (i = sampling; i >= 1; i--) {
-            q1 = (Int_t) TMath::Min(i, numberIterationsX), q2 =(Int_t) TMath::Min(i, numberIterationsY), q3 =(Int_t) TMath::Min(i, numberIterationsZ);
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     a = spectrum[x][y][z];
-                     p1 = spectrum[x + q1][y + q2][z - q3];
-                     p2 = spectrum[x - q1][y + q2][z - q3];
-                     p3 = spectrum[x + q1][y - q2][z - q3];
-                     p4 = spectrum[x - q1][y - q2][z - q3];
-                     p5 = spectrum[x + q1][y + q2][z + q3];
-                     p6 = spectrum[x - q1][y + q2][z + q3];
-                     p7 = spectrum[x + q1][y - q2][z + q3];
-                     p8 = spectrum[x - q1][y - q2][z + q3];
-                     s1 = spectrum[x + q1][y     ][z - q3];
-                     s2 = spectrum[x     ][y + q2][z - q3];
-                     s3 = spectrum[x - q1][y     ][z - q3];
-                     s4 = spectrum[x     ][y - q2][z - q3];
-                     s5 = spectrum[x + q1][y     ][z + q3];
-                     s6 = spectrum[x     ][y + q2][z + q3];
-                     s7 = spectrum[x - q1][y     ][z + q3];
-                     s8 = spectrum[x     ][y - q2][z + q3];
-                     s9 = spectrum[x - q1][y + q2][z     ];
-                     s10 = spectrum[x - q1][y - q2][z     ];
-                     s11 = spectrum[x + q1][y + q2][z     ];
-                     s12 = spectrum[x + q1][y - q2][z     ];
-                     r1 = spectrum[x     ][y     ][z - q3];
-                     r2 = spectrum[x     ][y     ][z + q3];
-                     r3 = spectrum[x - q1][y     ][z     ];
-                     r4 = spectrum[x + q1][y     ][z     ];
-                     r5 = spectrum[x     ][y + q2][z     ];
-                     r6 = spectrum[x     ][y - q2][z     ];
-                     b = (p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8 - (s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 4 + (r1 + r2 + r3 + r4 + r5 + r6) / 2;
-                     c = -(s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 4+(r1 + r2 + r3 + r4 + r5 + r6) / 2;
-                     d = -(p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8)/8 + (s1 + s2 + s3 + s4 + s5 + s6 + s7 + s8 + s9 + s10 + s11 + s12) / 12;
-                     if(b < a && b >= 0 && c >=0 && d >= 0)
-                        a = b;
-                     working_space[x][y][z] = a;
-                  }
-               }
-            }
-            for (z = q3; z < ssizez - q3; z++) {
-               for (y = q2; y < ssizey - q2; y++) {
-                  for (x = q1; x < ssizex - q1; x++) {
-                     spectrum[x][y][z] = working_space[x][y][z];
-                  }
-               }
-            }
-         }
-      }
-   }
-   for(i = 0;i < ssizex; i++){
-      for(j = 0;j < ssizey; j++)
-         delete[] working_space[i][j];
-      delete[] working_space[i];
-   }
-   delete[] working_space;
-   return 0;
+const char *TSpectrum3::Background(Float_t***spectrum,
+                       Int_t ssizex, Int_t ssizey, Int_t ssizez,
+                       Int_t numberIterationsX,
+                       Int_t numberIterationsY,
+                       Int_t numberIterationsZ,
+                       Int_t direction,
+                       Int_t filterType)
+{
+   return SnipBackground3(spectrum, ssizex, ssizey, ssizez, numberIterationsX, numberIterationsY, numberIterationsZ,
+                          direction, filterType);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1956,10 +1761,8 @@ Int_t TSpectrum3::SearchHighRes(const Double_t***source,Double_t***dest, Int_t s
    Int_t ymin,ymax,zmin,zmax,i,j;
    Double_t a,b,maxch,plocha = 0,plocha_markov = 0;
    Double_t nom,nip,nim,sp,sm,spx,spy,smx,smy,spz,smz;
-   Double_t p1,p2,p3,p4,p5,p6,p7,p8,s1,s2,s3,s4,s5,s6,s7,s8,s9,s10,s11,s12,r1,r2,r3,r4,r5,r6;
-   Int_t x,y,z;
    Double_t pocet_sigma = 5;
-   Int_t lhx,lhy,lhz,i1,i2,i3,j1,j2,j3,k1,k2,k3,i1min,i1max,i2min,i2max,i3min,i3max,j1min,j1max,j2min,j2max,j3min,j3max,positx,posity,positz;
+   Int_t lhx,lhy,lhz,i1,i2,i3,i1min,i1max,i2min,i2max,i3min,i3max,positx,posity,positz;
    if(sigma < 1){
       Error("SearchHighRes", "Invalid sigma, must be greater than or equal to 1");
       return 0;
@@ -2109,142 +1912,16 @@ Int_t TSpectrum3::SearchHighRes(const Double_t***source,Double_t***dest, Int_t s
       }
    }
    if(backgroundRemove == true){
+      // the spectrum is in the second block of z channels of working_space, the clipped values in the first one
       for(i = 1;i <= number_of_iterations; i++){
-        for(z = i;z < sizez_ext - i; z++){
-           for(y = i;y < sizey_ext - i; y++){
-             for(x = i;x < sizex_ext - i; x++){
-               a = working_space[x][y][z + sizez_ext];
-                  p1 = working_space[x + i][y + i][z - i + sizez_ext];
-                  p2 = working_space[x - i][y + i][z - i + sizez_ext];
-                  p3 = working_space[x + i][y - i][z - i + sizez_ext];
-                  p4 = working_space[x - i][y - i][z - i + sizez_ext];
-                  p5 = working_space[x + i][y + i][z + i + sizez_ext];
-                  p6 = working_space[x - i][y + i][z + i + sizez_ext];
-                  p7 = working_space[x + i][y - i][z + i + sizez_ext];
-                  p8 = working_space[x - i][y - i][z + i + sizez_ext];
-                  s1 = working_space[x + i][y    ][z - i + sizez_ext];
-                  s2 = working_space[x    ][y + i][z - i + sizez_ext];
-                  s3 = working_space[x - i][y    ][z - i + sizez_ext];
-                  s4 = working_space[x    ][y - i][z - i + sizez_ext];
-                  s5 = working_space[x + i][y    ][z + i + sizez_ext];
-                  s6 = working_space[x    ][y + i][z + i + sizez_ext];
-                  s7 = working_space[x - i][y    ][z + i + sizez_ext];
-                  s8 = working_space[x    ][y - i][z + i + sizez_ext];
-                  s9 = working_space[x - i][y + i][z     + sizez_ext];
-                  s10 = working_space[x - i][y - i][z     +sizez_ext];
-                  s11 = working_space[x + i][y + i][z     +sizez_ext];
-                  s12 = working_space[x + i][y - i][z     +sizez_ext];
-                  r1 = working_space[x    ][y    ][z - i + sizez_ext];
-                  r2 = working_space[x    ][y    ][z + i + sizez_ext];
-                  r3 = working_space[x - i][y    ][z     + sizez_ext];
-                  r4 = working_space[x + i][y    ][z     + sizez_ext];
-                  r5 = working_space[x    ][y + i][z     + sizez_ext];
-                  r6 = working_space[x    ][y - i][z     + sizez_ext];
-                  b = (p1 + p3) / 2.0;
-                  if(b > s1)
-                     s1 = b;
-
-                  b = (p1 + p2) / 2.0;
-                  if(b > s2)
-                     s2 = b;
-
-                  b = (p2 + p4) / 2.0;
-                  if(b > s3)
-                     s3 = b;
-
-                  b = (p3 + p4) / 2.0;
-                  if(b > s4)
-                     s4 = b;
-
-                  b = (p5 + p7) / 2.0;
-                  if(b > s5)
-                     s5 = b;
-
-                  b = (p5 + p6) / 2.0;
-                  if(b > s6)
-                     s6 = b;
-
-                  b = (p6 + p8) / 2.0;
-                  if(b > s7)
-                     s7 = b;
-
-                  b = (p7 + p8) / 2.0;
-                  if(b > s8)
-                     s8 = b;
-
-                  b = (p2 + p6) / 2.0;
-                  if(b > s9)
-                     s9 = b;
-
-                  b = (p4 + p8) / 2.0;
-                  if(b > s10)
-                     s10 = b;
-
-                  b = (p1 + p5) / 2.0;
-                  if(b > s11)
-                     s11 = b;
-
-                  b = (p3 + p7) / 2.0;
-                  if(b > s12)
-                     s12 = b;
-
-                  s1 = s1 - (p1 + p3) / 2.0;
-                  s2 = s2 - (p1 + p2) / 2.0;
-                  s3 = s3 - (p2 + p4) / 2.0;
-                  s4 = s4 - (p3 + p4) / 2.0;
-                  s5 = s5 - (p5 + p7) / 2.0;
-                  s6 = s6 - (p5 + p6) / 2.0;
-                  s7 = s7 - (p6 + p8) / 2.0;
-                  s8 = s8 - (p7 + p8) / 2.0;
-                  s9 = s9 - (p2 + p6) / 2.0;
-                  s10 = s10 - (p4 + p8) / 2.0;
-                  s11 = s11 - (p1 + p5) / 2.0;
-                  s12 = s12 - (p3 + p7) / 2.0;
-                  b = (s1 + s3) / 2.0 + (s2 + s4) / 2.0 + (p1 + p2 + p3 + p4) / 4.0;
-                  if(b > r1)
-                     r1 = b;
-
-                  b = (s5 + s7) / 2.0 + (s6 + s8) / 2.0 + (p5 + p6 + p7 + p8) / 4.0;
-                  if(b > r2)
-                     r2 = b;
-
-                  b = (s3 + s7) / 2.0 + (s9 + s10) / 2.0 + (p2 + p4 + p6 + p8) / 4.0;
-                  if(b > r3)
-                     r3 = b;
-
-                  b = (s1 + s5) / 2.0 + (s11 + s12) / 2.0 + (p1 + p3 + p5 + p7) / 4.0;
-                  if(b > r4)
-                     r4 = b;
-
-                  b = (s9 + s11) / 2.0 + (s2 + s6) / 2.0 + (p1 + p2 + p5 + p6) / 4.0;
-                  if(b > r5)
-                     r5 = b;
-
-                  b = (s4 + s8) / 2.0 + (s10 + s12) / 2.0 + (p3 + p4 + p7 + p8) / 4.0;
-                  if(b > r6)
-                     r6 = b;
-
-                  r1 = r1 - ((s1 + s3) / 2.0 + (s2 + s4) / 2.0 + (p1 + p2 + p3 + p4) / 4.0);
-                  r2 = r2 - ((s5 + s7) / 2.0 + (s6 + s8) / 2.0 + (p5 + p6 + p7 + p8) / 4.0);
-                  r3 = r3 - ((s3 + s7) / 2.0 + (s9 + s10) / 2.0 + (p2 + p4 + p6 + p8) / 4.0);
-                  r4 = r4 - ((s1 + s5) / 2.0 + (s11 + s12) / 2.0 + (p1 + p3 + p5 + p7) / 4.0);
-                  r5 = r5 - ((s9 + s11) / 2.0 + (s2 + s6) / 2.0 + (p1 + p2 + p5 + p6) / 4.0);
-                  r6 = r6 - ((s4 + s8) / 2.0 + (s10 + s12) / 2.0 + (p3 + p4 + p7 + p8) / 4.0);
-                  b = (r1 + r2) / 2.0 + (r3 + r4) / 2.0 + (r5 + r6) / 2.0 + (s1 + s3 + s5 + s7) / 4.0 + (s2 + s4 + s6 + s8) / 4.0 + (s9 + s10 + s11 + s12) / 4.0 + (p1 + p2 + p3 + p4 + p5 + p6 + p7 + p8) / 8.0;
-                  if(b < a)
-                     a = b;
-
-                  working_space[x][y][z] = a;
-               }
-            }
-         }
-         for(z = i;z < sizez_ext - i; z++){
-            for(y = i;y < sizey_ext - i; y++){
-               for(x = i;x < sizex_ext - i; x++){
-                  working_space[x][y][z + sizez_ext] = working_space[x][y][z];
-               }
-            }
-         }
+         TSpectrumParallel::ForEachRange(i, sizex_ext - i, 100. * sizey_ext * sizez_ext, [&](Int_t xlow, Int_t xup) {
+            SnipClip3(working_space, working_space, xlow, xup, sizey_ext, sizez_ext, i, i, i, kBackSuccessiveFiltering, sizez_ext);
+         });
+         TSpectrumParallel::ForEachRange(i, sizex_ext - i, 1. * sizey_ext * sizez_ext, [&](Int_t xlow, Int_t xup) {
+            for (Int_t xc = xlow; xc < xup; xc++)
+               for (Int_t yc = i; yc < sizey_ext - i; yc++)
+                  std::copy(working_space[xc][yc] + i, working_space[xc][yc] + sizez_ext - i, working_space[xc][yc] + sizez_ext + i);
+         });
       }
       for(k = 0;k < sizez_ext; k++){
          for(j = 0;j < sizey_ext; j++){
@@ -2946,76 +2623,75 @@ Int_t TSpectrum3::SearchHighRes(const Double_t***source,Double_t***dest, Int_t s
       }
    }
    //calculate ht*y and write into p
-   for (i3 = 0; i3 < sizez_ext; i3++) {
-      for (i2 = 0; i2 < sizey_ext; i2++) {
-         for (i1 = 0; i1 < sizex_ext; i1++) {
-            ldc = 0;
-            for (j3 = 0; j3 <= (lhz - 1); j3++) {
-               for (j2 = 0; j2 <= (lhy - 1); j2++) {
-                  for (j1 = 0; j1 <= (lhx - 1); j1++) {
-                     k3 = i3 + j3, k2 = i2 + j2, k1 = i1 + j1;
-                     if (k3 >= 0 && k3 < sizez_ext && k2 >= 0 && k2 < sizey_ext && k1 >= 0 && k1 < sizex_ext) {
-                        lda = working_space[j1][j2][j3];
-                        ldb = working_space[k1][k2][k3+2*sizez_ext];
-                        ldc = ldc + lda * ldb;
+   // the elements are independent: they are computed in parallel on ranges of i1
+   TSpectrumParallel::ForEachRange(0, sizex_ext, Double_t(sizey_ext) * sizez_ext * lhx * lhy * lhz, [&](Int_t first, Int_t last) {
+      for (Int_t ii1 = first; ii1 < last; ii1++) {
+         for (Int_t ii2 = 0; ii2 < sizey_ext; ii2++) {
+            for (Int_t ii3 = 0; ii3 < sizez_ext; ii3++) {
+               Double_t sum = 0;
+               for (Int_t jj3 = 0; jj3 <= (lhz - 1); jj3++) {
+                  for (Int_t jj2 = 0; jj2 <= (lhy - 1); jj2++) {
+                     for (Int_t jj1 = 0; jj1 <= (lhx - 1); jj1++) {
+                        const Int_t kk3 = ii3 + jj3, kk2 = ii2 + jj2, kk1 = ii1 + jj1;
+                        if (kk3 >= 0 && kk3 < sizez_ext && kk2 >= 0 && kk2 < sizey_ext && kk1 >= 0 && kk1 < sizex_ext)
+                           sum = sum + working_space[jj1][jj2][jj3] * working_space[kk1][kk2][kk3 + 2 * sizez_ext];
                      }
                   }
                }
+               working_space[ii1][ii2][ii3 + sizez_ext] = sum;
             }
-            working_space[i1][i2][i3 + sizez_ext] = ldc;
          }
       }
-   }
+   });
 //calculate b=ht*h
    i1min = -(lhx - 1), i1max = lhx - 1;
    i2min = -(lhy - 1), i2max = lhy - 1;
    i3min = -(lhz - 1), i3max = lhz - 1;
-   for (i3 = i3min; i3 <= i3max; i3++) {
-      for (i2 = i2min; i2 <= i2max; i2++) {
-         for (i1 = i1min; i1 <= i1max; i1++) {
-            ldc = 0;
-            j3min = -i3;
-            if (j3min < 0)
-               j3min = 0;
-
-            j3max = lhz - 1 - i3;
-            if (j3max > lhz - 1)
-               j3max = lhz - 1;
-
-            for (j3 = j3min; j3 <= j3max; j3++) {
-               j2min = -i2;
-               if (j2min < 0)
-                  j2min = 0;
-
-               j2max = lhy - 1 - i2;
-               if (j2max > lhy - 1)
-                  j2max = lhy - 1;
-
-               for (j2 = j2min; j2 <= j2max; j2++) {
-                  j1min = -i1;
-                  if (j1min < 0)
-                     j1min = 0;
-
-                  j1max = lhx - 1 - i1;
-                  if (j1max > lhx - 1)
-                     j1max = lhx - 1;
-
-                  for (j1 = j1min; j1 <= j1max; j1++) {
-                     lda = working_space[j1][j2][j3];
-                     if (i1 + j1 < sizex_ext && i2 + j2 < sizey_ext)
-                        ldb = working_space[i1 + j1][i2 + j2][i3 + j3];
-
-                     else
-                        ldb = 0;
-
-                     ldc = ldc + lda * ldb;
+   TSpectrumParallel::ForEachRange(i1min, i1max + 1, Double_t(i2max - i2min + 1) * (i3max - i3min + 1) * lhx * lhy * lhz, [&](Int_t first, Int_t last) {
+      for (Int_t ii1 = first; ii1 < last; ii1++) {
+         for (Int_t ii2 = i2min; ii2 <= i2max; ii2++) {
+            for (Int_t ii3 = i3min; ii3 <= i3max; ii3++) {
+               Double_t sum = 0;
+               Int_t jj3min = -ii3;
+               if (jj3min < 0)
+                  jj3min = 0;
+
+               Int_t jj3max = lhz - 1 - ii3;
+               if (jj3max > lhz - 1)
+                  jj3max = lhz - 1;
+
+               for (Int_t jj3 = jj3min; jj3 <= jj3max; jj3++) {
+                  Int_t jj2min = -ii2;
+                  if (jj2min < 0)
+                     jj2min = 0;
+
+                  Int_t jj2max = lhy - 1 - ii2;
+                  if (jj2max > lhy - 1)
+                     jj2max = lhy - 1;
+
+                  for (Int_t jj2 = jj2min; jj2 <= jj2max; jj2++) {
+                     Int_t jj1min = -ii1;
+                     if (jj1min < 0)
+                        jj1min = 0;
+
+                     Int_t jj1max = lhx - 1 - ii1;
+                     if (jj1max > lhx - 1)
+                        jj1max = lhx - 1;
+
+                     for (Int_t jj1 = jj1min; jj1 <= jj1max; jj1++) {
+                        Double_t hh = 0;
+                        if (ii1 + jj1 < sizex_ext && ii2 + jj2 < sizey_ext)
+                           hh = working_space[ii1 + jj1][ii2 + jj2][ii3 + jj3];
+
+                        sum = sum + working_space[jj1][jj2][jj3] * hh;
+                     }
                   }
                }
+               working_space[ii1 - i1min][ii2 - i2min][ii3 - i3min + 2 * sizez_ext ] = sum;
             }
-            working_space[i1 - i1min][i2 - i2min][i3 - i3min + 2 * sizez_ext ] = ldc;
          }
       }
-   }
+   });
 //initialization in x1 cube
    for (i3 = 0; i3 < sizez_ext; i3++) {
       for (i2 = 0; i2 < sizey_ext; i2++) {
@@ -3027,66 +2703,66 @@ Int_t TSpectrum3::SearchHighRes(const Double_t***source,Double_t***dest, Int_t s
    }
 
 //START OF ITERATIONS
+   // the Gold iterations: the new value of each channel depends only on the values of the previous iteration, the
+   // channels are computed in parallel on ranges of i1
    for (lindex=0;lindex<deconIterations;lindex++){
-      for (i3 = 0; i3 < sizez_ext; i3++) {
-         for (i2 = 0; i2 < sizey_ext; i2++) {
-            for (i1 = 0; i1 < sizex_ext; i1++) {
-               if (TMath::Abs(working_space[i1][i2][i3 + 3 * sizez_ext])>1e-6 && TMath::Abs(working_space[i1][i2][i3 + 1 * sizez_ext])>1e-6){
-                  ldb = 0;
-                  j3min = i3;
-                  if (j3min > lhz - 1)
-                     j3min = lhz - 1;
-
-                  j3min = -j3min;
-                  j3max = sizez_ext - i3 - 1;
-                  if (j3max > lhz - 1)
-                     j3max = lhz - 1;
-
-                  j2min = i2;
-                  if (j2min > lhy - 1)
-                     j2min = lhy - 1;
-
-                  j2min = -j2min;
-                  j2max = sizey_ext - i2 - 1;
-                  if (j2max > lhy - 1)
-                     j2max = lhy - 1;
-
-                  j1min = i1;
-                  if (j1min > lhx - 1)
-                     j1min = lhx - 1;
-
-                  j1min = -j1min;
-                  j1max = sizex_ext - i1 - 1;
-                  if (j1max > lhx - 1)
-                     j1max = lhx - 1;
-
-                  for (j3 = j3min; j3 <= j3max; j3++) {
-                     for (j2 = j2min; j2 <= j2max; j2++) {
-                        for (j1 = j1min; j1 <= j1max; j1++) {
-                           ldc =  working_space[j1 - i1min][j2 - i2min][j3 - i3min + 2 * sizez_ext];
-                           lda = working_space[i1 + j1][i2 + j2][i3 + j3 + 3 * sizez_ext];
-                           ldb = ldb + lda * ldc;
+      TSpectrumParallel::ForEachRange(0, sizex_ext, Double_t(sizey_ext) * sizez_ext * lhx * lhy * lhz, [&](Int_t first, Int_t last) {
+         for (Int_t ii1 = first; ii1 < last; ii1++) {
+            for (Int_t ii2 = 0; ii2 < sizey_ext; ii2++) {
+               for (Int_t ii3 = 0; ii3 < sizez_ext; ii3++) {
+                  Double_t x1 = working_space[ii1][ii2][ii3 + 3 * sizez_ext];
+                  const Double_t p = working_space[ii1][ii2][ii3 + 1 * sizez_ext];
+                  if (TMath::Abs(x1)>1e-6 && TMath::Abs(p)>1e-6){
+                     Double_t sum = 0;
+                     Int_t jj3min = ii3;
+                     if (jj3min > lhz - 1)
+                        jj3min = lhz - 1;
+
+                     jj3min = -jj3min;
+                     Int_t jj3max = sizez_ext - ii3 - 1;
+                     if (jj3max > lhz - 1)
+                        jj3max = lhz - 1;
+
+                     Int_t jj2min = ii2;
+                     if (jj2min > lhy - 1)
+                        jj2min = lhy - 1;
+
+                     jj2min = -jj2min;
+                     Int_t jj2max = sizey_ext - ii2 - 1;
+                     if (jj2max > lhy - 1)
+                        jj2max = lhy - 1;
+
+                     Int_t jj1min = ii1;
+                     if (jj1min > lhx - 1)
+                        jj1min = lhx - 1;
+
+                     jj1min = -jj1min;
+                     Int_t jj1max = sizex_ext - ii1 - 1;
+                     if (jj1max > lhx - 1)
+                        jj1max = lhx - 1;
+
+                     for (Int_t jj3 = jj3min; jj3 <= jj3max; jj3++) {
+                        for (Int_t jj2 = jj2min; jj2 <= jj2max; jj2++) {
+                           for (Int_t jj1 = jj1min; jj1 <= jj1max; jj1++)
+                              sum = sum + working_space[ii1 + jj1][ii2 + jj2][ii3 + jj3 + 3 * sizez_ext] *
+                                             working_space[jj1 - i1min][jj2 - i2min][jj3 - i3min + 2 * sizez_ext];
                         }
                      }
-                  }
-                  lda = working_space[i1][i2][i3 + 3 * sizez_ext];
-                  ldc = working_space[i1][i2][i3 + 1 * sizez_ext];
-                  if (ldc * lda != 0 && ldb != 0) {
-                     lda = lda * ldc / ldb;
-                  }
+                     if (p * x1 != 0 && sum != 0) {
+                        x1 = x1 * p / sum;
+                     }
 
-                  else
-                     lda = 0;
-                  working_space[i1][i2][i3 + 4 * sizez_ext] = lda;
+                     else
+                        x1 = 0;
+                     working_space[ii1][ii2][ii3 + 4 * sizez_ext] = x1;
+                  }
                }
             }
          }
-      }
-      for (i3 = 0; i3 < sizez_ext; i3++) {
-         for (i2 = 0; i2 < sizey_ext; i2++) {
-            for (i1 = 0; i1 < sizex_ext; i1++)
-               working_space[i1][i2][i3 + 3 * sizez_ext] = working_space[i1][i2][i3 + 4 * sizez_ext];
-         }
+      });
+      for (i1 = 0; i1 < sizex_ext; i1++) {
+         for (i2 = 0; i2 < sizey_ext; i2++)
+            std::copy(working_space[i1][i2] + 4 * sizez_ext, working_space[i1][i2] + 5 * sizez_ext, working_space[i1][i2] + 3 * sizez_ext);
       }
    }
 //write back resulting spectrum
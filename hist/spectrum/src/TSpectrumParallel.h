@@ -0,0 +1,72 @@
+// @(#)root/spectrum:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TSpectrumParallel
+#define ROOT_TSpectrumParallel
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TSpectrumParallel                                                    //
+//                                                                      //
+// Internal helper of TSpectrum2 and TSpectrum3 to run the loops over   //
+// the channels of a spectrum in parallel, when the implicit            //
+// multithreading of ROOT is enabled. The loops are split on their      //
+// outermost index, the x channel: each channel is computed as in the   //
+// serial loop, so that the results do not depend on the number of     //
+// threads.                                                             //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+
+namespace TSpectrumParallel {
+
+/// minimal number of operations of a loop run in parallel
+const Double_t kMinWork = 1e6;
+
+/// Call func(begin, end) on consecutive ranges covering [first, last), in parallel if the implicit
+/// multithreading is enabled and the loop, with about workPerItem operations per index, is large enough.
+/// The calls for different indices must be independent.
+template <class F>
+void ForEachRange(Int_t first, Int_t last, Double_t workPerItem, F func)
+{
+   const Int_t n = last - first;
+   if (n <= 0)
+      return;
+#ifdef R__USE_IMT
+   if (n > 1 && ROOT::IsImplicitMTEnabled() && n * workPerItem >= kMinWork) {
+      const Int_t nChunks = std::min<Int_t>(n, 4 * ROOT::GetThreadPoolSize());
+      const Int_t chunkSize = (n + nChunks - 1) / nChunks;
+      auto runChunk = [&](Int_t ichunk) {
+         const Int_t begin = first + ichunk * chunkSize;
+         const Int_t end = std::min(begin + chunkSize, last);
+         if (begin < end)
+            func(begin, end);
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(runChunk, ROOT::TSeqI(nChunks));
+      return;
+   }
+#else
+   (void)workPerItem;
+#endif
+   func(first, last);
+}
+
+} // namespace TSpectrumParallel
+
+#endif
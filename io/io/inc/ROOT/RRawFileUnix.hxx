@@ -17,24 +17,35 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 
 namespace ROOT {
 namespace Internal {
 
+class RIoUring;
+
 /**
  * \class RRawFileUnix RRawFileUnix.hxx
  * \ingroup IO
  *
  * The RRawFileUnix class uses POSIX calls to read from a mounted file system. Thus the path name can refer,
  * for instance, to a named pipe instead of a regular file.
+ *
+ * On Linux, vector reads are submitted in batches through io_uring, if the kernel supports it, such that
+ * many reads are in flight at the same time. Otherwise, vector reads fall back to a loop of pread() calls.
  */
 class RRawFileUnix : public RRawFile {
 private:
    int fFileDes;
+   /// Submission and completion queues of the batched vector reads, created by the first ReadV()
+   std::unique_ptr<RIoUring> fIoUring; //!
+   /// Set once it is known whether io_uring can be used
+   bool fIoUringChecked = false;
 
 protected:
    void OpenImpl() final;
    size_t ReadAtImpl(void *buffer, size_t nbytes, std::uint64_t offset) final;
+   void ReadVImpl(RIOVec *ioVec, unsigned int nReq) final;
    std::uint64_t GetSizeImpl() final;
    void *MapImpl(size_t nbytes, std::uint64_t offset, std::uint64_t &mapdOffset) final;
    void UnmapImpl(void *region, size_t nbytes) final;
@@ -15,6 +15,7 @@
 #include "TFileMerger.h"
 #include "TMemFile.h"
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -36,6 +37,12 @@ class TBufferMergerFile;
  * socket, TBufferMerger uses threads that each write to a
  * TBufferMergerFile, which in turn push data into a queue
  * managed by the TBufferMerger.
+ *
+ * The buffers are turned into in-memory files by the writer threads
+ * themselves, so that only the actual merging into the output file
+ * is serialized. To bound the memory used by the queue, see
+ * SetQueueLimit(); GetPeakQueueSize(), GetNMerges(), GetMergeTime()
+ * and GetWaitTime() tell how well the output keeps up with the writers.
  */
 
 class TBufferMerger {
@@ -70,9 +77,27 @@ public:
    /** Returns the number of buffers currently in the queue. */
    size_t GetQueueSize() const;
 
+   /** Returns the largest number of buffers that were queued at the same time. */
+   size_t GetPeakQueueSize() const;
+
+   /** Returns the number of merges into the output file done so far. */
+   size_t GetNMerges() const { return fNMerges; }
+
+   /** Returns the total time in seconds spent merging into the output file. */
+   double GetMergeTime() const { return fMergeTime; }
+
+   /** Returns the longest time in seconds a single merge took. */
+   double GetMaxMergeTime() const { return fMaxMergeTime; }
+
+   /** Returns the total time in seconds writer threads were blocked by the queue limit. */
+   double GetWaitTime() const { return fWaitTime; }
+
    /** Returns the current value of the auto save setting in bytes (default = 0). */
    size_t GetAutoSave() const;
 
+   /** Returns the current queue limit in bytes (default = 0, no limit). */
+   size_t GetQueueLimit() const;
+
    /** Returns the current merge options. */
    const char* GetMergeOptions();
 
@@ -86,6 +111,15 @@ public:
     */
    void SetAutoSave(size_t size);
 
+   /** By default, the merge queue grows without bounds if the output cannot
+    *  keep up with the writer threads. This function sets the number of
+    *  queued bytes above which a TBufferMergerFile::Write() blocks until the
+    *  ongoing merge is finished, and then merges the queue itself.
+    *  A limit of 0 disables the back-pressure. A limit smaller than the auto
+    *  save setting makes the latter ineffective.
+    */
+   void SetQueueLimit(size_t size);
+
    /** Sets the merge options. SetMergeOptions("fast") will disable
     * recompression of input data into the output if they have different
     * compression settings.
@@ -108,14 +142,21 @@ private:
    void Init(std::unique_ptr<TFile>);
 
    void Merge();
+   void MergeImpl();
    void Push(TBufferFile *buffer);
 
    size_t fAutoSave{0};                                          //< AutoSave only every fAutoSave bytes
+   size_t fQueueLimit{0};                                        //< Block writers above fQueueLimit buffered bytes
    size_t fBuffered{0};                                          //< Number of bytes currently buffered
+   size_t fPeakQueueSize{0};                                     //< Largest number of queued buffers
+   std::atomic<size_t> fNMerges{0};                              //< Number of merges done
+   std::atomic<double> fMergeTime{0.};                           //< Total time spent merging, in seconds
+   std::atomic<double> fMaxMergeTime{0.};                        //< Longest merge, in seconds
+   std::atomic<double> fWaitTime{0.};                            //< Total time writers waited for the queue limit
    TFileMerger fMerger{false, false};                            //< TFileMerger used to merge all buffers
    std::mutex fMergeMutex;                                       //< Mutex used to lock fMerger
-   std::mutex fQueueMutex;                                       //< Mutex used to lock fQueue
-   std::queue<TBufferFile *> fQueue;                             //< Queue to which data is pushed and merged
+   mutable std::mutex fQueueMutex;                               //< Mutex used to lock fQueue
+   std::queue<TMemFile *> fQueue;                                //< Queue to which data is pushed and merged
    std::vector<std::weak_ptr<TBufferMergerFile>> fAttachedFiles; //< Attached files
 };
 
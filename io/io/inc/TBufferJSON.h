@@ -16,6 +16,7 @@
 #include "TString.h"
 
 #include <deque>
+#include <iosfwd>
 #include <memory>
 #include <string>
 #include <vector>
@@ -58,6 +59,8 @@ public:
    Bool_t IsSkipClassInfo(const TClass *cl) const;
 
    TString StoreObject(const void *obj, const TClass *cl);
+   Bool_t StoreObject(std::ostream &out, const void *obj, const TClass *cl);
+   Bool_t StoreObject(std::string &out, const void *obj, const TClass *cl);
    void *RestoreObject(const char *str, TClass **cl);
 
    static TString ConvertToJSON(const TObject *obj, Int_t compact = 0, const char *member_name = nullptr);
@@ -67,6 +70,7 @@ public:
 
    static Int_t ExportToFile(const char *filename, const TObject *obj, const char *option = nullptr);
    static Int_t ExportToFile(const char *filename, const void *obj, const TClass *cl, const char *option = nullptr);
+   static Bool_t ExportToStream(std::ostream &out, const void *obj, const TClass *cl, Int_t compact = 0);
 
    static TObject *ConvertFromJSON(const char *str);
    static void *ConvertFromJSONAny(const char *str, TClass **cl = nullptr);
@@ -295,6 +299,8 @@ protected:
    void *JsonReadObject(void *obj, const TClass *objClass = nullptr, TClass **readClass = nullptr);
 
    void AppendOutput(const char *line0, const char *line1 = nullptr);
+   void FlushOutput(Bool_t final = kFALSE);
+   Bool_t StoreObjectToSink(const void *obj, const TClass *cl);
 
    void JsonPushValue();
 
@@ -317,6 +323,9 @@ protected:
    TString fOutBuffer;                 ///<!  main output buffer for json code
    TString *fOutput{nullptr};          ///<!  current output buffer for json code
    TString fValue;                     ///<!  buffer for current value
+   std::ostream *fOutStream{nullptr};  ///<!  stream fOutBuffer is flushed to while the JSON code is produced
+   std::string *fOutString{nullptr};   ///<!  string fOutBuffer is flushed to while the JSON code is produced
+   Long64_t fOutFlushed{0};            ///<!  number of bytes of fOutBuffer already flushed
    unsigned fJsonrCnt{0};              ///<!  counter for all objects, used for referencing
    std::deque<std::unique_ptr<TJSONStackObj>> fStack; ///<!  hierarchy of currently streamed element
    Int_t fCompact{0};                  ///<!  0 - no any compression, 1 - no spaces in the begin, 2 - no new lines, 3 - no spaces at all
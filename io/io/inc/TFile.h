@@ -23,6 +23,7 @@
 
 #include <atomic>
 #include <string>
+#include <vector>
 
 #include "Compression.h"
 #include "TDirectoryFile.h"
@@ -54,6 +55,7 @@ class TFilePrefetch;
 class TFile : public TDirectoryFile {
   friend class TDirectoryFile;
   friend class TFilePrefetch;
+  friend class TFileCacheWrite;
 // TODO: We need to make sure only one TBasket is being written at a time
 // if we are writing multiple baskets in parallel.
 #ifdef R__USE_IMT
@@ -106,12 +108,15 @@ protected:
    Bool_t           fInitDone{kFALSE};        ///<!True if the file has been initialized
    Bool_t           fMustFlush{kTRUE};        ///<!True if the file buffers must be flushed
    Bool_t           fIsPcmFile{kFALSE};       ///<!True if the file is a ROOT pcm file.
+   Bool_t           fHasPendingInfo{kFALSE};  ///<!True if StreamerInfos of this file are registered for lazy processing
    TFileOpenHandle *fAsyncHandle{nullptr};    ///<!For proper automatic cleanup
    EAsyncOpenStatus fAsyncOpenStatus{kAOSNotAsync}; ///<!Status of an asynchronous open request
    TUrl             fUrl;                     ///<!URL of file
 
    TList           *fInfoCache{nullptr};      ///<!Cached list of the streamer infos in this file
    TList           *fOpenPhases{nullptr};     ///<!Time info about open phases
+   std::vector<char> fOpenPrefetch;           ///<!End of a remote file, read together with the header by Init()
+   Long64_t         fOpenPrefetchPos{0};      ///<!Position of fOpenPrefetch in the file
 
 #ifdef R__USE_IMT
    std::mutex                                 fWriteMutex;  ///<!Lock for writing baskets / keys into the file.
@@ -131,12 +136,15 @@ protected:
    static std::atomic<Long64_t>  fgFileCounter;           ///<Counter for all opened files
    static std::atomic<Int_t>     fgReadCalls;             ///<Number of bytes read from all TFile objects
    static Int_t     fgReadaheadSize;         ///<Readahead buffer size
+   static Int_t     fgOpenPrefetchSize;      ///<Size of the end of remote files read together with their header
    static Bool_t    fgReadInfo;              ///<if true (default) ReadStreamerInfo is called when opening a file
+   static Bool_t    fgReadInfoLazy;          ///<if true, ReadStreamerInfo postpones the processing of the StreamerInfos of read-only files
 
    virtual EAsyncOpenStatus GetAsyncOpenStatus() { return fAsyncOpenStatus; }
    virtual void        Init(Bool_t create);
            Bool_t      FlushWriteCache();
            Int_t       ReadBufferViaCache(char *buf, Int_t len);
+           Bool_t      ReadHeaderAndPrefetch(char *header, Int_t len);
            Int_t       WriteBufferViaCache(const char *buf, Int_t len);
 
    ////////////////////////////////////////////////////////////////////////////////
@@ -310,13 +318,17 @@ public:
    static Long64_t     GetFileBytesWritten();
    static Int_t        GetFileReadCalls();
    static Int_t        GetReadaheadSize();
+   static Int_t        GetOpenPrefetchSize();
 
    static void         SetFileBytesRead(Long64_t bytes = 0);
    static void         SetFileBytesWritten(Long64_t bytes = 0);
    static void         SetFileReadCalls(Int_t readcalls = 0);
    static void         SetReadaheadSize(Int_t bufsize = 256000);
+   static void         SetOpenPrefetchSize(Int_t bytes = 262144);
    static void         SetReadStreamerInfo(Bool_t readinfo=kTRUE);
    static Bool_t       GetReadStreamerInfo();
+   static void         SetReadStreamerInfoLazy(Bool_t lazy=kTRUE);
+   static Bool_t       GetReadStreamerInfoLazy();
 
    static Long64_t     GetFileCounter();
    static void         IncrementFileCounter();
@@ -18,13 +18,25 @@ class TFile;
 
 class TFileCacheWrite : public TObject {
 
+public:
+   /// When the data written in the background is synced to the storage
+   enum ESyncPolicy {
+      kSyncNone = 0,       ///< Left to the operating system, and to TFile::Flush()
+      kSyncEachBuffer = 1  ///< After each buffer written in the background
+   };
+
 protected:
+   struct RAsyncWriter;
+
    Long64_t      fSeekStart;      ///< Seek value of first block in cache
    Int_t         fBufferSize;     ///< Allocated size of fBuffer
    Int_t         fNtot;           ///< Total size of cached blocks
    TFile        *fFile;           ///< Pointer to file
    char         *fBuffer;         ///< [fBufferSize] buffer of contiguous prefetched blocks
    Bool_t        fRecursive;      ///< flag to avoid recursive calls
+   RAsyncWriter *fAsyncWriter = nullptr; ///<! Thread writing the full buffers in the background, if any
+
+   Bool_t        FlushBuffer(Bool_t wait);
 
 private:
    TFileCacheWrite(const TFileCacheWrite &) = delete;            //cannot be copied
@@ -36,8 +48,10 @@ public:
    virtual ~TFileCacheWrite();
    virtual Bool_t      Flush();
    virtual Int_t       GetBytesInCache() const { return fNtot; }
+   Bool_t              IsAsync() const { return fAsyncWriter != nullptr; }
    virtual void        Print(Option_t *option="") const;
    virtual Int_t       ReadBuffer(char *buf, Long64_t pos, Int_t len);
+   Bool_t              SetAsync(Bool_t async, ESyncPolicy policy = kSyncNone);
    virtual Int_t       WriteBuffer(const char *buf, Long64_t pos, Int_t len);
    virtual void        SetFile(TFile *file);
 
@@ -43,12 +43,17 @@ private:
    std::condition_variable fReadBlockAdded; // signal the addition of a new red block
    TSemaphore *fSemChangeFile;     // semaphore used when changin a file in TChain
    TString     fPathCache;         // path to the cache directory
+   Long64_t    fCacheMaxSize;      // maximum size of the cache directory in bytes, 0 for no limit
+   Long64_t    fCacheSize;         // estimated size of the cache directory in bytes
    TStopwatch  fWaitTime;          // time wating to prefetch a buffer (in usec)
    Bool_t      fThreadJoined;      // mark if async thread was joined
    std::atomic<Bool_t> fPrefetchFinished;  // true if prefetching is over
 
    static TThread::VoidRtnFunc_t ThreadProc(void*);  //create a joinable worker thread
 
+   TString   GetBlockCachePath(TFPBlock*);
+   void      EvictFromCache();
+
 public:
    TFilePrefetch(TFile*);
    virtual ~TFilePrefetch();
@@ -68,6 +73,8 @@ public:
    Int_t     ThreadStart();
 
    Bool_t    SetCache(const char*);
+   void      SetCacheMaxSize(Long64_t size);
+   Long64_t  GetCacheMaxSize() const { return fCacheMaxSize; }
    Bool_t    CheckBlockInCache(char*&, TFPBlock*);
    char     *GetBlockFromCache(const char*, Int_t);
    void      SaveBlockInCache(TFPBlock*);
@@ -14,8 +14,10 @@
 
 #include "TError.h"
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
+#include <exception>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -25,10 +27,207 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+// IORING_OP_READ is an enum value; IORING_FEAT_RW_CUR_POS was introduced by the same kernel version (5.6)
+#if defined(IORING_FEAT_RW_CUR_POS) && defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define R__HAS_IO_URING
+#endif
+#endif
+#endif
+
 namespace {
 constexpr int kDefaultBlockSize = 4096; // If fstat() does not provide a block size hint, use this value instead
 } // anonymous namespace
 
+namespace ROOT {
+namespace Internal {
+
+#ifdef R__HAS_IO_URING
+
+/**
+ * \class RIoUring
+ * \ingroup IO
+ *
+ * A minimal io_uring ring, driven directly through the system calls, for batches of reads from one file.
+ */
+class RIoUring {
+private:
+   static constexpr unsigned kQueueDepth = 128;
+
+   int fRingFd = -1;
+   void *fSqRing = MAP_FAILED;
+   void *fCqRing = MAP_FAILED;
+   std::size_t fSqRingSize = 0;
+   std::size_t fCqRingSize = 0;
+   io_uring_sqe *fSqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+   std::size_t fSqesSize = 0;
+
+   unsigned fSqEntries = 0;
+   unsigned fCqEntries = 0;
+   unsigned *fSqHead = nullptr;
+   unsigned *fSqTail = nullptr;
+   unsigned *fSqMask = nullptr;
+   unsigned *fSqArray = nullptr;
+   unsigned *fCqHead = nullptr;
+   unsigned *fCqTail = nullptr;
+   unsigned *fCqMask = nullptr;
+   io_uring_cqe *fCqes = nullptr;
+
+   template <typename T>
+   static T *At(void *ring, unsigned offset)
+   {
+      return reinterpret_cast<T *>(static_cast<unsigned char *>(ring) + offset);
+   }
+
+public:
+   RIoUring()
+   {
+      io_uring_params params;
+      memset(&params, 0, sizeof(params));
+      fRingFd = syscall(__NR_io_uring_setup, kQueueDepth, &params);
+      if (fRingFd < 0)
+         return;
+      // Kernels before 5.6 do not support IORING_OP_READ
+      if (!(params.features & IORING_FEAT_RW_CUR_POS))
+         return;
+
+      fSqEntries = params.sq_entries;
+      fCqEntries = params.cq_entries;
+      fSqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+      fCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+      bool singleMmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+      singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+#endif
+      if (singleMmap)
+         fSqRingSize = fCqRingSize = std::max(fSqRingSize, fCqRingSize);
+
+      fSqRing = mmap(nullptr, fSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fRingFd,
+                     IORING_OFF_SQ_RING);
+      if (fSqRing == MAP_FAILED)
+         return;
+      if (singleMmap) {
+         fCqRing = fSqRing;
+      } else {
+         fCqRing = mmap(nullptr, fCqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fRingFd,
+                        IORING_OFF_CQ_RING);
+         if (fCqRing == MAP_FAILED)
+            return;
+      }
+      fSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+      fSqes = static_cast<io_uring_sqe *>(
+         mmap(nullptr, fSqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fRingFd, IORING_OFF_SQES));
+      if (fSqes == MAP_FAILED)
+         return;
+
+      fSqHead = At<unsigned>(fSqRing, params.sq_off.head);
+      fSqTail = At<unsigned>(fSqRing, params.sq_off.tail);
+      fSqMask = At<unsigned>(fSqRing, params.sq_off.ring_mask);
+      fSqArray = At<unsigned>(fSqRing, params.sq_off.array);
+      fCqHead = At<unsigned>(fCqRing, params.cq_off.head);
+      fCqTail = At<unsigned>(fCqRing, params.cq_off.tail);
+      fCqMask = At<unsigned>(fCqRing, params.cq_off.ring_mask);
+      fCqes = At<io_uring_cqe>(fCqRing, params.cq_off.cqes);
+   }
+
+   RIoUring(const RIoUring &) = delete;
+   RIoUring &operator=(const RIoUring &) = delete;
+
+   ~RIoUring()
+   {
+      if (fSqes != MAP_FAILED)
+         munmap(fSqes, fSqesSize);
+      if (fCqRing != MAP_FAILED && fCqRing != fSqRing)
+         munmap(fCqRing, fCqRingSize);
+      if (fSqRing != MAP_FAILED)
+         munmap(fSqRing, fSqRingSize);
+      // Closing the ring waits for the requests still in flight
+      if (fRingFd >= 0)
+         close(fRingFd);
+   }
+
+   /// Whether the kernel supports io_uring and the ring could be set up
+   bool IsValid() const { return fCqes != nullptr; }
+
+   /// Read all the requests, keeping up to the queue depth of them in flight. Requests that fail or that are
+   /// only partially served are handled by `fallback(req)`, which is given the request updated with the bytes
+   /// read so far. Returns false if the ring cannot be used anymore, errno is then set. If the fallback throws,
+   /// the reads in flight are waited for before the exception is passed on.
+   template <typename FallbackT>
+   bool ReadV(int fd, RRawFile::RIOVec *ioVec, unsigned int nReq, FallbackT &&fallback)
+   {
+      std::exception_ptr error;
+      unsigned int nSubmitted = 0;
+      unsigned int nCompleted = 0;
+      while (nCompleted < nReq) {
+         // Queue as many reads as both the submission and the completion queue can hold
+         unsigned sqTail = *fSqTail;
+         const unsigned sqHead = __atomic_load_n(fSqHead, __ATOMIC_ACQUIRE);
+         while ((nSubmitted < nReq) && (sqTail - sqHead < fSqEntries) && (nSubmitted - nCompleted < fCqEntries)) {
+            const unsigned idx = sqTail & *fSqMask;
+            io_uring_sqe *sqe = &fSqes[idx];
+            memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = IORING_OP_READ;
+            sqe->fd = fd;
+            sqe->off = ioVec[nSubmitted].fOffset;
+            sqe->addr = reinterpret_cast<std::uint64_t>(ioVec[nSubmitted].fBuffer);
+            sqe->len = ioVec[nSubmitted].fSize;
+            sqe->user_data = nSubmitted;
+            fSqArray[idx] = idx;
+            ++sqTail;
+            ++nSubmitted;
+         }
+         __atomic_store_n(fSqTail, sqTail, __ATOMIC_RELEASE);
+
+         const unsigned toSubmit = sqTail - __atomic_load_n(fSqHead, __ATOMIC_ACQUIRE);
+         if (syscall(__NR_io_uring_enter, fRingFd, toSubmit, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0) {
+            if (errno == EINTR || errno == EAGAIN)
+               continue;
+            return false;
+         }
+
+         unsigned cqHead = *fCqHead;
+         const unsigned cqTail = __atomic_load_n(fCqTail, __ATOMIC_ACQUIRE);
+         for (; cqHead != cqTail; ++cqHead, ++nCompleted) {
+            const io_uring_cqe &cqe = fCqes[cqHead & *fCqMask];
+            RRawFile::RIOVec &req = ioVec[cqe.user_data];
+            req.fOutBytes = (cqe.res > 0) ? cqe.res : 0;
+            // A read of 0 bytes means end of file
+            if (!error && (cqe.res < 0 || (cqe.res > 0 && req.fOutBytes < req.fSize))) {
+               try {
+                  fallback(req);
+               } catch (...) {
+                  error = std::current_exception();
+                  // Do not queue more reads, only collect the ones in flight
+                  nReq = nSubmitted;
+               }
+            }
+         }
+         __atomic_store_n(fCqHead, cqHead, __ATOMIC_RELEASE);
+      }
+      if (error)
+         std::rethrow_exception(error);
+      return true;
+   }
+};
+
+#else
+
+class RIoUring {
+public:
+   bool IsValid() const { return false; }
+   template <typename FallbackT>
+   bool ReadV(int, RRawFile::RIOVec *, unsigned int, FallbackT &&) { return false; }
+};
+
+#endif
+
+} // namespace Internal
+} // namespace ROOT
+
 ROOT::Internal::RRawFileUnix::RRawFileUnix(std::string_view url, ROptions options)
    : RRawFile(url, options), fFileDes(-1)
 {
@@ -113,6 +312,31 @@ size_t ROOT::Internal::RRawFileUnix::ReadAtImpl(void *buffer, size_t nbytes, std
    return total_bytes;
 }
 
+void ROOT::Internal::RRawFileUnix::ReadVImpl(RIOVec *ioVec, unsigned int nReq)
+{
+   if (!fIoUringChecked) {
+      fIoUringChecked = true;
+      auto ring = std::make_unique<RIoUring>();
+      if (ring->IsValid())
+         fIoUring = std::move(ring);
+   }
+   if (!fIoUring || nReq < 2) {
+      RRawFile::ReadVImpl(ioVec, nReq);
+      return;
+   }
+
+   // Failed and short reads are completed, or reported, by pread()
+   auto fallback = [this](RIOVec &req) {
+      req.fOutBytes += ReadAtImpl(static_cast<unsigned char *>(req.fBuffer) + req.fOutBytes, req.fSize - req.fOutBytes,
+                                  req.fOffset + req.fOutBytes);
+   };
+   if (!fIoUring->ReadV(fFileDes, ioVec, nReq, fallback)) {
+      const std::string error = strerror(errno);
+      fIoUring.reset();
+      throw std::runtime_error("Cannot read from '" + fUrl + "', error: " + error);
+   }
+}
+
 void ROOT::Internal::RRawFileUnix::UnmapImpl(void *region, size_t nbytes)
 {
    int rv = munmap(region, nbytes);
@@ -44,6 +44,119 @@ The concrete implementation of TBuffer for writing/reading to/from a ROOT file o
 #include "Bswapcpy.h"
 #endif
 
+#if defined(R__BYTESWAP) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define R__BSWAP_X86
+#include <immintrin.h>
+#elif defined(R__BYTESWAP) && defined(__GNUC__) && defined(__aarch64__)
+#define R__BSWAP_NEON
+#include <arm_neon.h>
+#endif
+
+#ifdef R__BYTESWAP
+namespace {
+
+#ifdef R__BSWAP_X86
+// Byte shuffles reversing the bytes of each 2, 4 or 8 byte element. The indices are relative
+// to each 16 byte lane, as for _mm256_shuffle_epi8.
+const unsigned char gBswapMask16[32] = {1,  0, 3,  2,  5,  4,  7,  6,  9,  8, 11, 10, 13, 12, 15, 14,
+                                        1,  0, 3,  2,  5,  4,  7,  6,  9,  8, 11, 10, 13, 12, 15, 14};
+const unsigned char gBswapMask32[32] = {3,  2, 1,  0,  7,  6,  5,  4, 11, 10,  9,  8, 15, 14, 13, 12,
+                                        3,  2, 1,  0,  7,  6,  5,  4, 11, 10,  9,  8, 15, 14, 13, 12};
+const unsigned char gBswapMask64[32] = {7,  6, 5,  4,  3,  2,  1,  0, 15, 14, 13, 12, 11, 10,  9,  8,
+                                        7,  6, 5,  4,  3,  2,  1,  0, 15, 14, 13, 12, 11, 10,  9,  8};
+
+__attribute__((target("avx2"))) Int_t R__BswapCopyAVX2(char *to, const char *from, Int_t nbytes,
+                                                       const unsigned char *mask)
+{
+   const __m256i shuffle = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(mask));
+   Int_t i = 0;
+   for (; i + 32 <= nbytes; i += 32) {
+      const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(from + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(to + i), _mm256_shuffle_epi8(v, shuffle));
+   }
+   return i;
+}
+
+__attribute__((target("ssse3"))) Int_t R__BswapCopySSSE3(char *to, const char *from, Int_t nbytes,
+                                                         const unsigned char *mask)
+{
+   const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i *>(mask));
+   Int_t i = 0;
+   for (; i + 16 <= nbytes; i += 16) {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(from + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(to + i), _mm_shuffle_epi8(v, shuffle));
+   }
+   return i;
+}
+#endif
+
+#ifdef R__BSWAP_NEON
+Int_t R__BswapCopyNEON(char *to, const char *from, Int_t nbytes, Int_t size)
+{
+   Int_t i = 0;
+   for (; i + 16 <= nbytes; i += 16) {
+      uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t *>(from + i));
+      v = (size == 2) ? vrev16q_u8(v) : ((size == 4) ? vrev32q_u8(v) : vrev64q_u8(v));
+      vst1q_u8(reinterpret_cast<uint8_t *>(to + i), v);
+   }
+   return i;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy as much as possible of the `nbytes` bytes at `from` to `to` with vector
+/// instructions, reversing the byte order of each element of `size` (2, 4 or 8)
+/// bytes. On x86 the instruction set (AVX2 or SSSE3) is picked at run time.
+/// Returns the number of bytes copied, a multiple of `size`; the caller copies
+/// the remaining elements.
+
+Int_t R__BswapCopyBulk(char *to, const char *from, Int_t nbytes, Int_t size)
+{
+#if defined(R__BSWAP_X86)
+   static const bool hasAVX2 = (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+   static const bool hasSSSE3 = (__builtin_cpu_init(), __builtin_cpu_supports("ssse3"));
+   const unsigned char *mask = (size == 2) ? gBswapMask16 : ((size == 4) ? gBswapMask32 : gBswapMask64);
+   Int_t done = 0;
+   if (hasAVX2)
+      done = R__BswapCopyAVX2(to, from, nbytes, mask);
+   if (hasSSSE3)
+      done += R__BswapCopySSSE3(to + done, from + done, nbytes - done, mask);
+   return done;
+#elif defined(R__BSWAP_NEON)
+   return R__BswapCopyNEON(to, from, nbytes, size);
+#else
+   (void)to; (void)from; (void)nbytes; (void)size;
+   return 0;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read `n` elements from `buf` in network byte order into `x` and advance `buf`.
+
+template <typename T>
+inline void R__FromBufArray(char *&buf, T *x, Int_t n)
+{
+   const Int_t done = R__BswapCopyBulk(reinterpret_cast<char *>(x), buf, n * sizeof(T), sizeof(T)) / sizeof(T);
+   buf += done * sizeof(T);
+   for (Int_t i = done; i < n; i++)
+      frombuf(buf, &x[i]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the `n` elements of `x` to `buf` in network byte order and advance `buf`.
+
+template <typename T>
+inline void R__ToBufArray(char *&buf, const T *x, Int_t n)
+{
+   const Int_t done = R__BswapCopyBulk(buf, reinterpret_cast<const char *>(x), n * sizeof(T), sizeof(T)) / sizeof(T);
+   buf += done * sizeof(T);
+   for (Int_t i = done; i < n; i++)
+      tobuf(buf, x[i]);
+}
+
+} // anonymous namespace
+#endif
+
 
 const UInt_t kNewClassTag       = 0xFFFFFFFF;
 const UInt_t kClassMask         = 0x80000000;  // OR the class index with this
@@ -765,8 +878,7 @@ Int_t TBufferFile::ReadArray(Short_t *&h)
    bswapcpy16(h, fBufCur, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
+   R__FromBufArray(fBufCur, h, n);
 # endif
 #else
    memcpy(h, fBufCur, l);
@@ -798,8 +910,7 @@ Int_t TBufferFile::ReadArray(Int_t *&ii)
    bswapcpy32(ii, fBufCur, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
+   R__FromBufArray(fBufCur, ii, n);
 # endif
 #else
    memcpy(ii, fBufCur, l);
@@ -853,8 +964,7 @@ Int_t TBufferFile::ReadArray(Long64_t *&ll)
    if (!ll) ll = new Long64_t[n];
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   R__FromBufArray(fBufCur, ll, n);
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -885,8 +995,7 @@ Int_t TBufferFile::ReadArray(Float_t *&f)
    bswapcpy32(f, fBufCur, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
+   R__FromBufArray(fBufCur, f, n);
 # endif
 #else
    memcpy(f, fBufCur, l);
@@ -914,8 +1023,7 @@ Int_t TBufferFile::ReadArray(Double_t *&d)
    if (!d) d = new Double_t[n];
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   R__FromBufArray(fBufCur, d, n);
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1038,8 +1146,7 @@ Int_t TBufferFile::ReadStaticArray(Short_t *h)
    bswapcpy16(h, fBufCur, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
+   R__FromBufArray(fBufCur, h, n);
 # endif
 #else
    memcpy(h, fBufCur, l);
@@ -1070,8 +1177,7 @@ Int_t TBufferFile::ReadStaticArray(Int_t *ii)
    bswapcpy32(ii, fBufCur, n);
    fBufCur += sizeof(Int_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
+   R__FromBufArray(fBufCur, ii, n);
 # endif
 #else
    memcpy(ii, fBufCur, l);
@@ -1123,8 +1229,7 @@ Int_t TBufferFile::ReadStaticArray(Long64_t *ll)
    if (!ll) return 0;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   R__FromBufArray(fBufCur, ll, n);
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -1154,8 +1259,7 @@ Int_t TBufferFile::ReadStaticArray(Float_t *f)
    bswapcpy32(f, fBufCur, n);
    fBufCur += sizeof(Float_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
+   R__FromBufArray(fBufCur, f, n);
 # endif
 #else
    memcpy(f, fBufCur, l);
@@ -1182,8 +1286,7 @@ Int_t TBufferFile::ReadStaticArray(Double_t *d)
    if (!d) return 0;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   R__FromBufArray(fBufCur, d, n);
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1304,8 +1407,7 @@ void TBufferFile::ReadFastArray(Short_t *h, Int_t n)
    bswapcpy16(h, fBufCur, n);
    fBufCur += sizeof(Short_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &h[i]);
+   R__FromBufArray(fBufCur, h, n);
 # endif
 #else
    memcpy(h, fBufCur, l);
@@ -1326,8 +1428,7 @@ void TBufferFile::ReadFastArray(Int_t *ii, Int_t n)
    bswapcpy32(ii, fBufCur, n);
    fBufCur += sizeof(Int_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ii[i]);
+   R__FromBufArray(fBufCur, ii, n);
 # endif
 #else
    memcpy(ii, fBufCur, l);
@@ -1360,8 +1461,7 @@ void TBufferFile::ReadFastArray(Long64_t *ll, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &ll[i]);
+   R__FromBufArray(fBufCur, ll, n);
 #else
    memcpy(ll, fBufCur, l);
    fBufCur += l;
@@ -1381,8 +1481,7 @@ void TBufferFile::ReadFastArray(Float_t *f, Int_t n)
    bswapcpy32(f, fBufCur, n);
    fBufCur += sizeof(Float_t)*n;
 # else
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &f[i]);
+   R__FromBufArray(fBufCur, f, n);
 # endif
 #else
    memcpy(f, fBufCur, l);
@@ -1399,8 +1498,7 @@ void TBufferFile::ReadFastArray(Double_t *d, Int_t n)
    if (l <= 0 || l > fBufSize) return;
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      frombuf(fBufCur, &d[i]);
+   R__FromBufArray(fBufCur, d, n);
 #else
    memcpy(d, fBufCur, l);
    fBufCur += l;
@@ -1420,7 +1518,7 @@ void TBufferFile::ReadFastArrayFloat16(Float_t *f, Int_t n, TStreamerElement *el
       Double_t xmin = ele->GetXmin();
       Double_t factor = ele->GetFactor();
       for (int j=0;j < n; j++) {
-         UInt_t aint; *this >> aint; f[j] = (Float_t)(aint/factor + xmin);
+         UInt_t aint; frombuf(fBufCur, &aint); f[j] = (Float_t)(aint/factor + xmin);
       }
    } else {
       Int_t i;
@@ -1436,8 +1534,8 @@ void TBufferFile::ReadFastArrayFloat16(Float_t *f, Int_t n, TStreamerElement *el
       UChar_t  theExp;
       UShort_t theMan;
       for (i = 0; i < n; i++) {
-         *this >> theExp;
-         *this >> theMan;
+         frombuf(fBufCur, &theExp);
+         frombuf(fBufCur, &theMan);
          fIntValue = theExp;
          fIntValue <<= 23;
          fIntValue |= (theMan & ((1<<(nbits+1))-1)) <<(23-nbits);
@@ -1457,7 +1555,7 @@ void TBufferFile::ReadFastArrayWithFactor(Float_t *ptr, Int_t n, Double_t factor
 
    //a range was specified. We read an integer and convert it back to a float
    for (int j=0;j < n; j++) {
-      UInt_t aint; *this >> aint; ptr[j] = (Float_t)(aint/factor + minvalue);
+      UInt_t aint; frombuf(fBufCur, &aint); ptr[j] = (Float_t)(aint/factor + minvalue);
    }
 }
 
@@ -1479,8 +1577,8 @@ void TBufferFile::ReadFastArrayWithNbits(Float_t *ptr, Int_t n, Int_t nbits)
    UChar_t  theExp;
    UShort_t theMan;
    for (Int_t i = 0; i < n; i++) {
-      *this >> theExp;
-      *this >> theMan;
+      frombuf(fBufCur, &theExp);
+      frombuf(fBufCur, &theMan);
       fIntValue = theExp;
       fIntValue <<= 23;
       fIntValue |= (theMan & ((1<<(nbits+1))-1)) <<(23-nbits);
@@ -1502,7 +1600,7 @@ void TBufferFile::ReadFastArrayDouble32(Double_t *d, Int_t n, TStreamerElement *
       Double_t xmin = ele->GetXmin();
       Double_t factor = ele->GetFactor();
       for (int j=0;j < n; j++) {
-         UInt_t aint; *this >> aint; d[j] = (Double_t)(aint/factor + xmin);
+         UInt_t aint; frombuf(fBufCur, &aint); d[j] = (Double_t)(aint/factor + xmin);
       }
    } else {
       Int_t i;
@@ -1512,7 +1610,7 @@ void TBufferFile::ReadFastArrayDouble32(Double_t *d, Int_t n, TStreamerElement *
          //we read a float and convert it to double
          Float_t afloat;
          for (i = 0; i < n; i++) {
-            *this >> afloat;
+            frombuf(fBufCur, &afloat);
             d[i] = (Double_t)afloat;
          }
       } else {
@@ -1525,8 +1623,8 @@ void TBufferFile::ReadFastArrayDouble32(Double_t *d, Int_t n, TStreamerElement *
          UChar_t  theExp;
          UShort_t theMan;
          for (i = 0; i < n; i++) {
-            *this >> theExp;
-            *this >> theMan;
+            frombuf(fBufCur, &theExp);
+            frombuf(fBufCur, &theMan);
             fIntValue = theExp;
             fIntValue <<= 23;
             fIntValue |= (theMan & ((1<<(nbits+1))-1)) <<(23-nbits);
@@ -1547,7 +1645,7 @@ void TBufferFile::ReadFastArrayWithFactor(Double_t *d, Int_t n, Double_t factor,
 
    //a range was specified. We read an integer and convert it back to a double.
    for (int j=0;j < n; j++) {
-      UInt_t aint; *this >> aint; d[j] = (Double_t)(aint/factor + minvalue);
+      UInt_t aint; frombuf(fBufCur, &aint); d[j] = (Double_t)(aint/factor + minvalue);
    }
 }
 
@@ -1563,7 +1661,7 @@ void TBufferFile::ReadFastArrayWithNbits(Double_t *d, Int_t n, Int_t nbits)
       //we read a float and convert it to double
       Float_t afloat;
       for (Int_t i = 0; i < n; i++) {
-         *this >> afloat;
+         frombuf(fBufCur, &afloat);
          d[i] = (Double_t)afloat;
       }
    } else {
@@ -1576,8 +1674,8 @@ void TBufferFile::ReadFastArrayWithNbits(Double_t *d, Int_t n, Int_t nbits)
       UChar_t  theExp;
       UShort_t theMan;
       for (Int_t i = 0; i < n; i++) {
-         *this >> theExp;
-         *this >> theMan;
+         frombuf(fBufCur, &theExp);
+         frombuf(fBufCur, &theMan);
          fIntValue = theExp;
          fIntValue <<= 23;
          fIntValue |= (theMan & ((1<<(nbits+1))-1)) <<(23-nbits);
@@ -1737,8 +1835,7 @@ void TBufferFile::WriteArray(const Short_t *h, Int_t n)
    bswapcpy16(fBufCur, h, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, h[i]);
+   R__ToBufArray(fBufCur, h, n);
 # endif
 #else
    memcpy(fBufCur, h, l);
@@ -1767,8 +1864,7 @@ void TBufferFile::WriteArray(const Int_t *ii, Int_t n)
    bswapcpy32(fBufCur, ii, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ii[i]);
+   R__ToBufArray(fBufCur, ii, n);
 # endif
 #else
    memcpy(fBufCur, ii, l);
@@ -1831,8 +1927,7 @@ void TBufferFile::WriteArray(const Long64_t *ll, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ll[i]);
+   R__ToBufArray(fBufCur, ll, n);
 #else
    memcpy(fBufCur, ll, l);
    fBufCur += l;
@@ -1860,8 +1955,7 @@ void TBufferFile::WriteArray(const Float_t *f, Int_t n)
    bswapcpy32(fBufCur, f, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, f[i]);
+   R__ToBufArray(fBufCur, f, n);
 # endif
 #else
    memcpy(fBufCur, f, l);
@@ -1886,8 +1980,7 @@ void TBufferFile::WriteArray(const Double_t *d, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, d[i]);
+   R__ToBufArray(fBufCur, d, n);
 #else
    memcpy(fBufCur, d, l);
    fBufCur += l;
@@ -2003,8 +2096,7 @@ void TBufferFile::WriteFastArray(const Short_t *h, Int_t n)
    bswapcpy16(fBufCur, h, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, h[i]);
+   R__ToBufArray(fBufCur, h, n);
 # endif
 #else
    memcpy(fBufCur, h, l);
@@ -2027,8 +2119,7 @@ void TBufferFile::WriteFastArray(const Int_t *ii, Int_t n)
    bswapcpy32(fBufCur, ii, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ii[i]);
+   R__ToBufArray(fBufCur, ii, n);
 # endif
 #else
    memcpy(fBufCur, ii, l);
@@ -2075,8 +2166,7 @@ void TBufferFile::WriteFastArray(const Long64_t *ll, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, ll[i]);
+   R__ToBufArray(fBufCur, ll, n);
 #else
    memcpy(fBufCur, ll, l);
    fBufCur += l;
@@ -2098,8 +2188,7 @@ void TBufferFile::WriteFastArray(const Float_t *f, Int_t n)
    bswapcpy32(fBufCur, f, n);
    fBufCur += l;
 # else
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, f[i]);
+   R__ToBufArray(fBufCur, f, n);
 # endif
 #else
    memcpy(fBufCur, f, l);
@@ -2118,8 +2207,7 @@ void TBufferFile::WriteFastArray(const Double_t *d, Int_t n)
    if (fBufCur + l > fBufMax) AutoExpand(fBufSize+l);
 
 #ifdef R__BYTESWAP
-   for (int i = 0; i < n; i++)
-      tobuf(fBufCur, d[i]);
+   R__ToBufArray(fBufCur, d, n);
 #else
    memcpy(fBufCur, d, l);
    fBufCur += l;
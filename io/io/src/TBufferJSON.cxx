@@ -100,6 +100,7 @@ class Container {
 #include <memory>
 #include <cstdlib>
 #include <fstream>
+#include <ostream>
 
 #include <ROOT/RMakeUnique.hxx>
 
@@ -701,20 +702,87 @@ TString TBufferJSON::ConvertToJSON(const void *obj, const TClass *cl, Int_t comp
 
 TString TBufferJSON::StoreObject(const void *obj, const TClass *cl)
 {
-   if (IsWriting()) {
+   StoreObjectToSink(obj, cl);
 
-      InitMap();
+   return fOutBuffer.Length() ? fOutBuffer : fValue;
+}
 
-      PushStack(); // dummy stack entry to avoid extra checks in the beginning
+////////////////////////////////////////////////////////////////////////////////
+/// Store provided object as JSON structure into the stream `out`
+/// In contrast to the TString version, the JSON code is written to the stream in
+/// chunks while it is produced, without keeping the complete document in memory.
+/// Returns kFALSE if the object could not be stored or the stream is in error state.
+/// As for StoreObject(), the method can be called only once for a TBufferJSON instance.
 
-      JsonWriteObject(obj, cl);
+Bool_t TBufferJSON::StoreObject(std::ostream &out, const void *obj, const TClass *cl)
+{
+   fOutStream = &out;
+   Bool_t res = StoreObjectToSink(obj, cl);
+   fOutStream = nullptr;
+   return res && out.good();
+}
 
-      PopStack();
-   } else {
+////////////////////////////////////////////////////////////////////////////////
+/// Store provided object as JSON structure, appending the JSON code to `out`
+/// While the JSON code is produced, it is moved in chunks into `out`, such that
+/// only one copy of the complete document exists in memory
+
+Bool_t TBufferJSON::StoreObject(std::string &out, const void *obj, const TClass *cl)
+{
+   fOutString = &out;
+   Bool_t res = StoreObjectToSink(obj, cl);
+   fOutString = nullptr;
+   return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Produce the JSON code of the object, flushing it to the configured output sink
+
+Bool_t TBufferJSON::StoreObjectToSink(const void *obj, const TClass *cl)
+{
+   if (!IsWriting()) {
       Error("StoreObject", "Can not store object into TBuffer for reading");
+      return kFALSE;
    }
 
-   return fOutBuffer.Length() ? fOutBuffer : fValue;
+   InitMap();
+
+   PushStack(); // dummy stack entry to avoid extra checks in the beginning
+
+   JsonWriteObject(obj, cl);
+
+   PopStack();
+
+   FlushOutput(kTRUE);
+
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the content of the main output buffer to the output stream or string
+/// Only done when the output goes into the main buffer: the JSON code of objects
+/// stored in separate buffers may be post-processed before being appended.
+/// With `final`, the resulting value is written when the object did not produce
+/// any output in the main buffer, as StoreObject() returns it in this case.
+
+void TBufferJSON::FlushOutput(Bool_t final)
+{
+   if (!fOutStream && !fOutString)
+      return;
+
+   if (final && (fOutFlushed == 0) && (fOutBuffer.Length() == 0))
+      fOutBuffer = fValue;
+
+   if ((fOutput != &fOutBuffer) || (fOutBuffer.Length() == 0))
+      return;
+
+   if (fOutStream)
+      fOutStream->write(fOutBuffer.Data(), fOutBuffer.Length());
+   else
+      fOutString->append(fOutBuffer.Data(), fOutBuffer.Length());
+
+   fOutFlushed += fOutBuffer.Length();
+   fOutBuffer.Clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -745,9 +813,37 @@ TString TBufferJSON::ConvertToJSON(const void *ptr, TDataMember *member, Int_t c
    return buf.JsonWriteMember(ptr, member, mcl, arraylen);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Convert object of any class to JSON and write it directly into the output stream
+/// The JSON code is flushed to the stream in chunks while the object is converted,
+/// therefore the complete JSON string never has to be kept in memory
+/// See TBufferJSON::ConvertToJSON() for the meaning of the compact parameter
+/// Returns kFALSE if the stream is not usable after the conversion
+
+Bool_t TBufferJSON::ExportToStream(std::ostream &out, const void *obj, const TClass *cl, Int_t compact)
+{
+   if (!cl)
+      return kFALSE;
+
+   TClass *clActual = obj ? cl->GetActualClass(obj) : nullptr;
+   const void *actualStart = obj;
+   if (clActual && (clActual != cl)) {
+      actualStart = (char *)obj - clActual->GetBaseClassOffset(cl);
+   } else {
+      clActual = const_cast<TClass *>(cl);
+   }
+
+   TBufferJSON buf;
+
+   buf.SetCompact(compact);
+
+   return buf.StoreObject(out, actualStart, clActual) && out.good();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Convert object into JSON and store in text file
 /// Returns size of the produce file
+/// Plain JSON files are written while the object is converted, see ExportToStream()
 /// Used in TObject::SaveAs()
 
 Int_t TBufferJSON::ExportToFile(const char *filename, const TObject *obj, const char *option)
@@ -759,67 +855,70 @@ Int_t TBufferJSON::ExportToFile(const char *filename, const TObject *obj, const
    if (option && (*option >= '0') && (*option <= '3'))
       compact = TString(option).Atoi();
 
+   if (!strstr(filename, ".json.gz")) {
+      std::ofstream ofs(filename);
+      if (!TBufferJSON::ExportToStream(ofs, obj, TObject::Class(), compact))
+         return 0;
+      return ofs.tellp();
+   }
+
    TString json = TBufferJSON::ConvertToJSON(obj, compact);
 
    std::ofstream ofs(filename);
 
-   if (strstr(filename, ".json.gz")) {
-      const char *objbuf = json.Data();
-      Long_t objlen = json.Length();
+   const char *objbuf = json.Data();
+   Long_t objlen = json.Length();
 
-      unsigned long objcrc = R__crc32(0, NULL, 0);
-      objcrc = R__crc32(objcrc, (const unsigned char *)objbuf, objlen);
+   unsigned long objcrc = R__crc32(0, NULL, 0);
+   objcrc = R__crc32(objcrc, (const unsigned char *)objbuf, objlen);
 
-      // 10 bytes (ZIP header), compressed data, 8 bytes (CRC and original length)
-      Int_t buflen = 10 + objlen + 8;
-      if (buflen < 512)
-         buflen = 512;
+   // 10 bytes (ZIP header), compressed data, 8 bytes (CRC and original length)
+   Int_t buflen = 10 + objlen + 8;
+   if (buflen < 512)
+      buflen = 512;
 
-      char *buffer = (char *)malloc(buflen);
-      if (!buffer)
-         return 0; // failure
+   char *buffer = (char *)malloc(buflen);
+   if (!buffer)
+      return 0; // failure
 
-      char *bufcur = buffer;
+   char *bufcur = buffer;
 
-      *bufcur++ = 0x1f; // first byte of ZIP identifier
-      *bufcur++ = 0x8b; // second byte of ZIP identifier
-      *bufcur++ = 0x08; // compression method
-      *bufcur++ = 0x00; // FLAG - empty, no any file names
-      *bufcur++ = 0;    // empty timestamp
-      *bufcur++ = 0;    //
-      *bufcur++ = 0;    //
-      *bufcur++ = 0;    //
-      *bufcur++ = 0;    // XFL (eXtra FLags)
-      *bufcur++ = 3;    // OS   3 means Unix
-      // strcpy(bufcur, "item.json");
-      // bufcur += strlen("item.json")+1;
+   *bufcur++ = 0x1f; // first byte of ZIP identifier
+   *bufcur++ = 0x8b; // second byte of ZIP identifier
+   *bufcur++ = 0x08; // compression method
+   *bufcur++ = 0x00; // FLAG - empty, no any file names
+   *bufcur++ = 0;    // empty timestamp
+   *bufcur++ = 0;    //
+   *bufcur++ = 0;    //
+   *bufcur++ = 0;    //
+   *bufcur++ = 0;    // XFL (eXtra FLags)
+   *bufcur++ = 3;    // OS   3 means Unix
+   // strcpy(bufcur, "item.json");
+   // bufcur += strlen("item.json")+1;
 
-      char dummy[8];
-      memcpy(dummy, bufcur - 6, 6);
+   char dummy[8];
+   memcpy(dummy, bufcur - 6, 6);
 
-      // R__memcompress fills first 6 bytes with own header, therefore just overwrite them
-      unsigned long ziplen = R__memcompress(bufcur - 6, objlen + 6, (char *)objbuf, objlen);
+   // R__memcompress fills first 6 bytes with own header, therefore just overwrite them
+   unsigned long ziplen = R__memcompress(bufcur - 6, objlen + 6, (char *)objbuf, objlen);
 
-      memcpy(bufcur - 6, dummy, 6);
+   memcpy(bufcur - 6, dummy, 6);
 
-      bufcur += (ziplen - 6); // jump over compressed data (6 byte is extra ROOT header)
+   bufcur += (ziplen - 6); // jump over compressed data (6 byte is extra ROOT header)
 
-      *bufcur++ = objcrc & 0xff; // CRC32
-      *bufcur++ = (objcrc >> 8) & 0xff;
-      *bufcur++ = (objcrc >> 16) & 0xff;
-      *bufcur++ = (objcrc >> 24) & 0xff;
+   *bufcur++ = objcrc & 0xff; // CRC32
+   *bufcur++ = (objcrc >> 8) & 0xff;
+   *bufcur++ = (objcrc >> 16) & 0xff;
+   *bufcur++ = (objcrc >> 24) & 0xff;
 
-      *bufcur++ = objlen & 0xff;         // original data length
-      *bufcur++ = (objlen >> 8) & 0xff;  // original data length
-      *bufcur++ = (objlen >> 16) & 0xff; // original data length
-      *bufcur++ = (objlen >> 24) & 0xff; // original data length
+   *bufcur++ = objlen & 0xff;         // original data length
+   *bufcur++ = (objlen >> 8) & 0xff;  // original data length
+   *bufcur++ = (objlen >> 16) & 0xff; // original data length
+   *bufcur++ = (objlen >> 24) & 0xff; // original data length
 
-      ofs.write(buffer, bufcur - buffer);
+   ofs.write(buffer, bufcur - buffer);
 
-      free(buffer);
-   } else {
-      ofs << json.Data();
-   }
+   free(buffer);
 
    ofs.close();
 
@@ -829,6 +928,7 @@ Int_t TBufferJSON::ExportToFile(const char *filename, const TObject *obj, const
 ////////////////////////////////////////////////////////////////////////////////
 /// Convert object into JSON and store in text file
 /// Returns size of the produce file
+/// Plain JSON files are written while the object is converted, see ExportToStream()
 
 Int_t TBufferJSON::ExportToFile(const char *filename, const void *obj, const TClass *cl, const char *option)
 {
@@ -839,67 +939,70 @@ Int_t TBufferJSON::ExportToFile(const char *filename, const void *obj, const TCl
    if (option && (*option >= '0') && (*option <= '3'))
       compact = TString(option).Atoi();
 
+   if (!strstr(filename, ".json.gz")) {
+      std::ofstream ofs(filename);
+      if (!TBufferJSON::ExportToStream(ofs, obj, cl, compact))
+         return 0;
+      return ofs.tellp();
+   }
+
    TString json = TBufferJSON::ConvertToJSON(obj, cl, compact);
 
    std::ofstream ofs(filename);
 
-   if (strstr(filename, ".json.gz")) {
-      const char *objbuf = json.Data();
-      Long_t objlen = json.Length();
+   const char *objbuf = json.Data();
+   Long_t objlen = json.Length();
 
-      unsigned long objcrc = R__crc32(0, NULL, 0);
-      objcrc = R__crc32(objcrc, (const unsigned char *)objbuf, objlen);
+   unsigned long objcrc = R__crc32(0, NULL, 0);
+   objcrc = R__crc32(objcrc, (const unsigned char *)objbuf, objlen);
 
-      // 10 bytes (ZIP header), compressed data, 8 bytes (CRC and original length)
-      Int_t buflen = 10 + objlen + 8;
-      if (buflen < 512)
-         buflen = 512;
+   // 10 bytes (ZIP header), compressed data, 8 bytes (CRC and original length)
+   Int_t buflen = 10 + objlen + 8;
+   if (buflen < 512)
+      buflen = 512;
 
-      char *buffer = (char *)malloc(buflen);
-      if (!buffer)
-         return 0; // failure
+   char *buffer = (char *)malloc(buflen);
+   if (!buffer)
+      return 0; // failure
 
-      char *bufcur = buffer;
+   char *bufcur = buffer;
 
-      *bufcur++ = 0x1f; // first byte of ZIP identifier
-      *bufcur++ = 0x8b; // second byte of ZIP identifier
-      *bufcur++ = 0x08; // compression method
-      *bufcur++ = 0x00; // FLAG - empty, no any file names
-      *bufcur++ = 0;    // empty timestamp
-      *bufcur++ = 0;    //
-      *bufcur++ = 0;    //
-      *bufcur++ = 0;    //
-      *bufcur++ = 0;    // XFL (eXtra FLags)
-      *bufcur++ = 3;    // OS   3 means Unix
-      // strcpy(bufcur, "item.json");
-      // bufcur += strlen("item.json")+1;
+   *bufcur++ = 0x1f; // first byte of ZIP identifier
+   *bufcur++ = 0x8b; // second byte of ZIP identifier
+   *bufcur++ = 0x08; // compression method
+   *bufcur++ = 0x00; // FLAG - empty, no any file names
+   *bufcur++ = 0;    // empty timestamp
+   *bufcur++ = 0;    //
+   *bufcur++ = 0;    //
+   *bufcur++ = 0;    //
+   *bufcur++ = 0;    // XFL (eXtra FLags)
+   *bufcur++ = 3;    // OS   3 means Unix
+   // strcpy(bufcur, "item.json");
+   // bufcur += strlen("item.json")+1;
 
-      char dummy[8];
-      memcpy(dummy, bufcur - 6, 6);
+   char dummy[8];
+   memcpy(dummy, bufcur - 6, 6);
 
-      // R__memcompress fills first 6 bytes with own header, therefore just overwrite them
-      unsigned long ziplen = R__memcompress(bufcur - 6, objlen + 6, (char *)objbuf, objlen);
+   // R__memcompress fills first 6 bytes with own header, therefore just overwrite them
+   unsigned long ziplen = R__memcompress(bufcur - 6, objlen + 6, (char *)objbuf, objlen);
 
-      memcpy(bufcur - 6, dummy, 6);
+   memcpy(bufcur - 6, dummy, 6);
 
-      bufcur += (ziplen - 6); // jump over compressed data (6 byte is extra ROOT header)
+   bufcur += (ziplen - 6); // jump over compressed data (6 byte is extra ROOT header)
 
-      *bufcur++ = objcrc & 0xff; // CRC32
-      *bufcur++ = (objcrc >> 8) & 0xff;
-      *bufcur++ = (objcrc >> 16) & 0xff;
-      *bufcur++ = (objcrc >> 24) & 0xff;
+   *bufcur++ = objcrc & 0xff; // CRC32
+   *bufcur++ = (objcrc >> 8) & 0xff;
+   *bufcur++ = (objcrc >> 16) & 0xff;
+   *bufcur++ = (objcrc >> 24) & 0xff;
 
-      *bufcur++ = objlen & 0xff;         // original data length
-      *bufcur++ = (objlen >> 8) & 0xff;  // original data length
-      *bufcur++ = (objlen >> 16) & 0xff; // original data length
-      *bufcur++ = (objlen >> 24) & 0xff; // original data length
+   *bufcur++ = objlen & 0xff;         // original data length
+   *bufcur++ = (objlen >> 8) & 0xff;  // original data length
+   *bufcur++ = (objlen >> 16) & 0xff; // original data length
+   *bufcur++ = (objlen >> 24) & 0xff; // original data length
 
-      ofs.write(buffer, bufcur - buffer);
+   ofs.write(buffer, bufcur - buffer);
 
-      free(buffer);
-   } else {
-      ofs << json.Data();
-   }
+   free(buffer);
 
    ofs.close();
 
@@ -1157,6 +1260,9 @@ TJSONStackObj *TBufferJSON::PopStack()
 
 void TBufferJSON::AppendOutput(const char *line0, const char *line1)
 {
+   // chunk size when streaming the JSON code into a stream or string
+   const Ssiz_t kFlushSize = 64 * 1024;
+
    if (line0)
       fOutput->Append(line0);
 
@@ -1172,6 +1278,9 @@ void TBufferJSON::AppendOutput(const char *line0, const char *line1)
          fOutput->Append(line1);
       }
    }
+
+   if ((fOutput == &fOutBuffer) && (fOutBuffer.Length() >= kFlushSize))
+      FlushOutput();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
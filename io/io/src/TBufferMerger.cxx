@@ -16,6 +16,8 @@
 #include "TROOT.h"
 #include "TVirtualMutex.h"
 
+#include <algorithm>
+#include <chrono>
 #include <utility>
 
 namespace ROOT {
@@ -62,19 +64,47 @@ std::shared_ptr<TBufferMergerFile> TBufferMerger::GetFile()
 
 size_t TBufferMerger::GetQueueSize() const
 {
+   std::lock_guard<std::mutex> lock(fQueueMutex);
    return fQueue.size();
 }
 
+size_t TBufferMerger::GetPeakQueueSize() const
+{
+   std::lock_guard<std::mutex> lock(fQueueMutex);
+   return fPeakQueueSize;
+}
+
 void TBufferMerger::Push(TBufferFile *buffer)
 {
+   const size_t size = buffer->BufferSize();
+
+   // Reading the keys of the buffer is done here, in the writer thread,
+   // such that only the merge itself happens under fMergeMutex
+   TMemFile *memfile;
+   {
+      TDirectory::TContext ctxt;
+      memfile = new TMemFile(fMerger.GetOutputFileName(), std::unique_ptr<TBufferFile>{buffer});
+   }
+
+   size_t buffered;
    {
       std::lock_guard<std::mutex> lock(fQueueMutex);
-      fBuffered += buffer->BufferSize();
-      fQueue.push(buffer);
+      fBuffered += size;
+      fQueue.push(memfile);
+      fPeakQueueSize = std::max(fPeakQueueSize, fQueue.size());
+      buffered = fBuffered;
    }
 
-   if (fBuffered > fAutoSave)
+   if (fQueueLimit && buffered > fQueueLimit) {
+      // Back-pressure: wait for the ongoing merge to finish, then merge what
+      // has accumulated in the meantime, unless another writer already did
+      auto start = std::chrono::steady_clock::now();
+      std::lock_guard<std::mutex> lock(fMergeMutex);
+      fWaitTime = fWaitTime + std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      MergeImpl();
+   } else if (buffered > fAutoSave) {
       Merge();
+   }
 }
 
 size_t TBufferMerger::GetAutoSave() const
@@ -93,6 +123,16 @@ void TBufferMerger::SetAutoSave(size_t size)
    fAutoSave = size;
 }
 
+size_t TBufferMerger::GetQueueLimit() const
+{
+   return fQueueLimit;
+}
+
+void TBufferMerger::SetQueueLimit(size_t size)
+{
+   fQueueLimit = size;
+}
+
 void TBufferMerger::SetMergeOptions(const TString& options)
 {
    fMerger.SetMergeOptions(options);
@@ -101,24 +141,39 @@ void TBufferMerger::SetMergeOptions(const TString& options)
 void TBufferMerger::Merge()
 {
    if (fMergeMutex.try_lock()) {
-      std::queue<TBufferFile *> queue;
-      {
-         std::lock_guard<std::mutex> q(fQueueMutex);
-         std::swap(queue, fQueue);
-         fBuffered = 0;
-      }
-
-      while (!queue.empty()) {
-         std::unique_ptr<TBufferFile> buffer{queue.front()};
-         fMerger.AddAdoptFile(new TMemFile(fMerger.GetOutputFileName(), std::move(buffer)));
-         queue.pop();
-      }
-
-      fMerger.PartialMerge();
-      fMerger.Reset();
+      MergeImpl();
       fMergeMutex.unlock();
    }
 }
 
+void TBufferMerger::MergeImpl()
+{
+   std::queue<TMemFile *> queue;
+   {
+      std::lock_guard<std::mutex> q(fQueueMutex);
+      std::swap(queue, fQueue);
+      fBuffered = 0;
+   }
+
+   if (queue.empty())
+      return;
+
+   auto start = std::chrono::steady_clock::now();
+
+   while (!queue.empty()) {
+      fMerger.AddAdoptFile(queue.front());
+      queue.pop();
+   }
+
+   fMerger.PartialMerge();
+   fMerger.Reset();
+
+   const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   ++fNMerges;
+   fMergeTime = fMergeTime + elapsed;
+   if (elapsed > fMaxMergeTime)
+      fMaxMergeTime = elapsed;
+}
+
 } // namespace Experimental
 } // namespace ROOT
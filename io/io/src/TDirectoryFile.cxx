@@ -319,8 +319,8 @@ void TDirectoryFile::BuildDirectoryFile(TFile* motherFile, TDirectory* motherDir
    fSeekDir    = 0;
    fSeekParent = 0;
    fSeekKeys   = 0;
-   fList       = new THashList(100,50);
-   fKeys       = new THashList(100,50);
+   fList       = new THashList(100,3);
+   fKeys       = new THashList(100,3);
    fList->UseRWLock();
    fMother     = motherDir;
    fFile       = motherFile ? motherFile : TFile::CurrentFile();
@@ -788,17 +788,13 @@ TKey *TDirectoryFile::FindKeyAny(const char *keyname) const
 
    DecodeNameCycle(keyname, name, cycle, kMaxLen);
 
-   TIter next(GetListOfKeys());
-   TKey *key;
-   while ((key = (TKey *) next())) {
-      if (!strcmp(name, key->GetName()))
-         if ((cycle == 9999) || (cycle >= key->GetCycle()))  {
-            const_cast<TDirectoryFile*>(this)->cd(); // may be we should not make cd ???
-            return key;
-         }
+   TKey *key = GetKey(name, cycle);
+   if (key) {
+      const_cast<TDirectoryFile*>(this)->cd(); // may be we should not make cd ???
+      return key;
    }
    //try with subdirectories
-   next.Reset();
+   TIter next(GetListOfKeys());
    while ((key = (TKey *) next())) {
       //if (!strcmp(key->GetClassName(),"TDirectory")) {
       if (strstr(key->GetClassName(),"TDirectory")) {
@@ -832,17 +828,11 @@ TObject *TDirectoryFile::FindObjectAny(const char *aname) const
 
    DecodeNameCycle(aname, name, cycle, kMaxLen);
 
-   TIter next(GetListOfKeys());
-   TKey *key;
    //may be a key in the current directory
-   while ((key = (TKey *) next())) {
-      if (!strcmp(name, key->GetName())) {
-         if (cycle == 9999)             return key->ReadObj();
-         if (cycle >= key->GetCycle())  return key->ReadObj();
-      }
-   }
+   TKey *key = GetKey(name, cycle);
+   if (key) return key->ReadObj();
    //try with subdirectories
-   next.Reset();
+   TIter next(GetListOfKeys());
    while ((key = (TKey *) next())) {
       //if (!strcmp(key->GetClassName(),"TDirectory")) {
       if (strstr(key->GetClassName(),"TDirectory")) {
@@ -946,8 +936,9 @@ TObject *TDirectoryFile::Get(const char *namecycle)
 
 //*-*---------------------Case of Key---------------------
 //                        ===========
+   // Only the keys hashed to the same slot as the name need to be looked at
    TKey *key;
-   TIter nextkey(GetListOfKeys());
+   TIter nextkey(fKeys ? ((THashList *)fKeys)->GetListForObject(namobj) : nullptr);
    while ((key = (TKey *) nextkey())) {
       if (strcmp(namobj,key->GetName()) == 0) {
          if ((cycle == 9999) || (cycle == key->GetCycle())) {
@@ -1066,8 +1057,9 @@ void *TDirectoryFile::GetObjectChecked(const char *namecycle, const TClass* expe
 //*-*---------------------Case of Key---------------------
 //                        ===========
    void *idcur = nullptr;
+   // Only the keys hashed to the same slot as the name need to be looked at
    TKey *key;
-   TIter nextkey(GetListOfKeys());
+   TIter nextkey(fKeys ? ((THashList *)fKeys)->GetListForObject(namobj) : nullptr);
    while ((key = (TKey *) nextkey())) {
       if (strcmp(namobj,key->GetName()) == 0) {
          if ((cycle == 9999) || (cycle == key->GetCycle())) {
@@ -1388,6 +1380,9 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
 
       TKey *key;
       frombuf(buffer, &nkeys);
+      // Size the hash table once for all the keys rather than growing it while adding them
+      if (nkeys > fKeys->GetSize())
+         ((THashList *)fKeys)->Rehash(nkeys);
       for (Int_t i = 0; i < nkeys; i++) {
          key = new TKey(this);
          key->ReadKeyBuffer(buffer);
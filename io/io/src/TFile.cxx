@@ -129,6 +129,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TObjString.h"
 #include "TStopwatch.h"
 #include "compiledata.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <set>
@@ -138,6 +139,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TGlobal.h"
 #include "ROOT/RMakeUnique.hxx"
 #include "ROOT/RConcurrentHashColl.hxx"
+#include "ROOT/RTrace.hxx"
 
 using std::sqrt;
 
@@ -146,7 +148,9 @@ std::atomic<Long64_t> TFile::fgBytesWrite{0};
 std::atomic<Long64_t> TFile::fgFileCounter{0};
 std::atomic<Int_t>    TFile::fgReadCalls{0};
 Int_t    TFile::fgReadaheadSize = 256000;
+Int_t    TFile::fgOpenPrefetchSize = 262144;
 Bool_t   TFile::fgReadInfo = kTRUE;
+Bool_t   TFile::fgReadInfoLazy = kFALSE;
 TList   *TFile::fgAsyncOpenRequests = nullptr;
 TString  TFile::fgCacheFileDir;
 Bool_t   TFile::fgCacheFileForce = kFALSE;
@@ -622,9 +626,7 @@ void TFile::Init(Bool_t create)
       //*-*----------------UPDATE
       //char *header = new char[kBEGIN];
       char *header = new char[kBEGIN+200];
-      Seek(0);                                 // NOLINT: silence clang-tidy warnings
-      //ReadBuffer(header, kBEGIN);
-      if (ReadBuffer(header, kBEGIN+200)) {    // NOLINT: silence clang-tidy warnings
+      if (ReadHeaderAndPrefetch(header, kBEGIN+200)) {    // NOLINT: silence clang-tidy warnings
          // ReadBuffer returns kTRUE in case of failure.
          Error("Init","%s failed to read the file type data.",
                GetName());
@@ -897,6 +899,8 @@ void TFile::Close(Option_t *option)
       WriteStreamerInfo();
    }
 
+   std::vector<char>().swap(fOpenPrefetch);
+
    // Finish any concurrent I/O operations before we close the file handles.
    if (fCacheRead) fCacheRead->Close();
    {
@@ -914,6 +918,12 @@ void TFile::Close(Option_t *option)
    fMustFlush = kFALSE; // Make sure there is only one Flush.
    TDirectoryFile::Close(option);
 
+   if (fHasPendingInfo) {
+      // Nothing is going to be read from this file anymore.
+      TClass::RemovePendingStreamerInfos(this);
+      fHasPendingInfo = kFALSE;
+   }
+
    if (IsWritable()) {
       TFree *f1 = (TFree*)fFree->First();
       if (f1) {
@@ -1584,6 +1594,7 @@ void TFile::Print(Option_t *option) const
 
 Bool_t TFile::ReadBuffer(char *buf, Long64_t pos, Int_t len)
 {
+   R__TRACE_SCOPE("io", "TFile::ReadBuffer");
    if (IsOpen()) {
 
       SetOffset(pos);
@@ -1634,6 +1645,7 @@ Bool_t TFile::ReadBuffer(char *buf, Long64_t pos, Int_t len)
 
 Bool_t TFile::ReadBuffer(char *buf, Int_t len)
 {
+   R__TRACE_SCOPE("io", "TFile::ReadBuffer");
    if (IsOpen()) {
 
       Int_t st;
@@ -1685,6 +1697,7 @@ Bool_t TFile::ReadBuffer(char *buf, Int_t len)
 
 Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
 {
+   R__TRACE_SCOPE("io", "TFile::ReadBuffers");
    // called with buf=0, from TFileCacheRead to pass list of readahead buffers
    if (!buf) {
       for (Int_t j = 0; j < nbuf; j++) {
@@ -1745,6 +1758,37 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the first len bytes of the file into header.
+///
+/// For a remote file opened for reading, the last GetOpenPrefetchSize() bytes
+/// of the file are read in the same vectored request and kept in memory.
+/// The end of the file usually holds the keys and the StreamerInfo records
+/// read by Init(), as well as the objects written last, e.g. the TTree
+/// headers: reading them then takes no further round trip to the server.
+/// Returns kTRUE in case of failure, like ReadBuffer().
+
+Bool_t TFile::ReadHeaderAndPrefetch(char *header, Int_t len)
+{
+   const Bool_t isLocal = !strcmp(fUrl.GetProtocol(), "file");
+   const Long64_t size = (fgOpenPrefetchSize > 0 && !fWritable && !fArchive && !isLocal) ? GetSize() : -1;
+   if (size <= len) {
+      Seek(0);                                 // NOLINT: silence clang-tidy warnings
+      return ReadBuffer(header, len);          // NOLINT: silence clang-tidy warnings
+   }
+
+   const Int_t tailLen = (Int_t)std::min<Long64_t>(fgOpenPrefetchSize, size - len);
+   std::vector<char> buffer(len + tailLen);
+   Long64_t pos[2] = {0, size - tailLen};
+   Int_t lens[2] = {len, tailLen};
+   if (ReadBuffers(buffer.data(), pos, lens, 2))
+      return kTRUE;
+   memcpy(header, buffer.data(), len);
+   fOpenPrefetch.assign(buffer.begin() + len, buffer.end());
+   fOpenPrefetchPos = pos[1];
+   return kFALSE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read buffer via cache.
 ///
@@ -1754,6 +1798,11 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
 Int_t TFile::ReadBufferViaCache(char *buf, Int_t len)
 {
    Long64_t off = GetRelOffset();
+   if (buf && off >= fOpenPrefetchPos && off + len <= fOpenPrefetchPos + (Long64_t)fOpenPrefetch.size()) {
+      memcpy(buf, &fOpenPrefetch[off - fOpenPrefetchPos], len);
+      SetOffset(off + len);
+      return 1;
+   }
    if (fCacheRead) {
       Int_t st = fCacheRead->ReadBuffer(buf, off, len);
       if (st < 0)
@@ -2102,6 +2151,16 @@ Int_t TFile::ReOpen(Option_t *mode)
       }
       SetWritable(kTRUE);
 
+      // The end of the file read when opening it is going to be rewritten
+      std::vector<char>().swap(fOpenPrefetch);
+
+      if (fHasPendingInfo) {
+         // Writing requires all the StreamerInfos of the file to be known.
+         TClass::RemovePendingStreamerInfos(this);
+         fHasPendingInfo = kFALSE;
+         ReadStreamerInfo();
+      }
+
       fFree = new TList;
       if (fSeekFree > fBEGIN)
          ReadFree();
@@ -3511,6 +3570,10 @@ void TFile::ReadStreamerInfo()
       }
    }
 
+   // The StreamerInfos of a read-only file are only needed to read its content,
+   // so their processing can wait until their class is used.
+   const Bool_t lazy = fgReadInfoLazy && !IsWritable();
+
    // loop on all TStreamerInfo classes
    for (int mode=0;mode<2; ++mode) {
       // In order for the collection proxy to be initialized properly, we need
@@ -3557,6 +3620,13 @@ void TFile::ReadStreamerInfo()
          if ( (!isstl && mode ==0) || (isstl && mode ==1) ) {
                // Skip the STL container the first time around
                // Skip the regular classes the second time around;
+            if (lazy) {
+               // TClass now owns the StreamerInfo and calls BuildCheck when needed.
+               TClass::AddPendingStreamerInfo(info, this);
+               fHasPendingInfo = kTRUE;
+               lnk = lnk->Next();
+               continue;
+            }
             info->BuildCheck(this);
             Int_t uid = info->GetNumber();
             Int_t asize = fClassIndex->GetSize();
@@ -3577,7 +3647,8 @@ void TFile::ReadStreamerInfo()
 #ifdef R__USE_IMT
    // We are done processing the record, let future calls and other threads that it
    // has been done.
-   fgTsSIHashes.Insert(listRetcode.fHash);
+   if (!lazy)
+      fgTsSIHashes.Insert(listRetcode.fHash);
 #endif
 }
 
@@ -3607,6 +3678,35 @@ Bool_t TFile::GetReadStreamerInfo()
    return fgReadInfo;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Specify if the processing of the streamerinfos of files opened for reading
+/// is postponed until their class is used.
+///
+/// If fgReadInfoLazy is false (default) TFile::ReadStreamerInfo checks all
+/// the TStreamerInfo of the file against the classes in memory when opening
+/// the file, which includes the loading of the class dictionaries and the
+/// creation of emulated classes for all the classes described in the file.
+/// If it is true, each TStreamerInfo of a read-only file is only checked
+/// when its class is first looked up, e.g. when the first object of this
+/// class is read; the TStreamerInfos of classes that are never used are
+/// deleted when the file is closed. This speeds up the opening of files
+/// describing many classes of which only a few are read.
+
+void TFile::SetReadStreamerInfoLazy(Bool_t lazy)
+{
+   fgReadInfoLazy = lazy;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// If the processing of the streamerinfos of read-only files is postponed.
+///
+/// See TFile::SetReadStreamerInfoLazy for more documentation.
+
+Bool_t TFile::GetReadStreamerInfoLazy()
+{
+   return fgReadInfoLazy;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Show the StreamerInfo of all classes written to this file.
 
@@ -4150,6 +4250,13 @@ TFile *TFile::Open(const char *url, Option_t *options, const char *ftitle,
    if (type != kLocal && type != kFile &&
        f && f->IsWritable() && !f->IsRaw()) {
       new TFileCacheWrite(f, 1);
+   } else if (f && f->IsWritable() && !f->IsRaw() && gEnv->GetValue("TFile.AsyncWriteCache", 0) != 0) {
+      // local file written in the background, e.g. on a network file system
+      TFileCacheWrite *cache = new TFileCacheWrite(f, gEnv->GetValue("TFile.AsyncWriteCache.Size", 1));
+      auto policy = gEnv->GetValue("TFile.AsyncWriteCache.Sync", 0) ? TFileCacheWrite::kSyncEachBuffer
+                                                                    : TFileCacheWrite::kSyncNone;
+      if (!cache->SetAsync(kTRUE, policy))
+         f->SetCacheWrite(nullptr);
    }
 
    return f;
@@ -4444,6 +4551,22 @@ Int_t TFile::GetReadaheadSize()
 //______________________________________________________________________________
 void TFile::SetReadaheadSize(Int_t bytes) { fgReadaheadSize = bytes; }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Static function returning the number of bytes at the end of remote files
+/// that are read together with their header when they are opened.
+
+Int_t TFile::GetOpenPrefetchSize()
+{
+   return fgOpenPrefetchSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of bytes at the end of remote files that are read together
+/// with their header when they are opened, see TFile::ReadHeaderAndPrefetch.
+/// 0 disables this prefetching.
+
+void TFile::SetOpenPrefetchSize(Int_t bytes) { fgOpenPrefetchSize = bytes; }
+
 //______________________________________________________________________________
 void TFile::SetFileBytesRead(Long64_t bytes) { fgBytesRead = bytes; }
 
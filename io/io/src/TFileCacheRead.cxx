@@ -764,7 +764,8 @@ Int_t TFileCacheRead::SetBufferSize(Int_t buffersize)
 /// If 'setPrefetching', enable the asynchronous prefetching
 /// (using TFilePrefetch) and if the gEnv and rootrc
 /// variable Cache.Directory is set, also enable the local
-/// caching of the prefetched blocks.
+/// caching of the prefetched blocks. The size of the local cache is
+/// limited to Cache.MaxSize bytes, if set.
 /// if 'setPrefetching', the old prefetcher is enabled is
 /// the gEnv and rootrc variable is TFile.AsyncReading
 
@@ -785,9 +786,11 @@ void TFileCacheRead::SetEnablePrefetchingImpl(Bool_t setPrefetching)
    if (!fPrefetch && fEnablePrefetching) {
       fPrefetch = new TFilePrefetch(fFile);
       const char* cacheDir = gEnv->GetValue("Cache.Directory", "");
-      if (strcmp(cacheDir, ""))
+      if (strcmp(cacheDir, "")) {
+        fPrefetch->SetCacheMaxSize((Long64_t)gEnv->GetValue("Cache.MaxSize", 0.));
         if (!fPrefetch->SetCache((char*) cacheDir))
            fprintf(stderr, "Error while trying to set the cache directory: %s.\n", cacheDir);
+      }
       if (fPrefetch->ThreadStart()){
          fprintf(stderr,"Error stating prefetching thread. Disabling prefetching.\n");
          fEnablePrefetching = 0;
@@ -23,14 +23,151 @@ TXNetFile and TWebFile (via TFile::WriteBuffers()).
 
 The write cache is automatically created when writing a remote file
 (created in TFile::Open()).
+
+With SetAsync(), the full buffers of a local file are written by a
+background thread while the next buffer is being filled, so that the
+thread filling the cache only waits for the I/O when both buffers are
+full. The buffers are then sized to a multiple of the optimal I/O size of
+the storage, which matters on network file systems (e.g. Lustre or EOS
+mounted with FUSE). When the resource `TFile.AsyncWriteCache` is set,
+TFile::Open() also creates such a cache for local files, with the sync
+policy given by `TFile.AsyncWriteCache.Sync` (see ESyncPolicy).
 */
 
 
 #include "TFile.h"
 #include "TFileCacheWrite.h"
+#include "TError.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <cerrno>
+#include <cstring>
+#include <sys/stat.h>
+#ifndef WIN32
+#include <unistd.h>
+#endif
 
 ClassImp(TFileCacheWrite);
 
+/// Thread writing the full buffers of the cache, one at a time.
+struct TFileCacheWrite::RAsyncWriter {
+   std::mutex fMutex;
+   std::condition_variable fCond;
+   std::thread fThread;
+   ESyncPolicy fPolicy;
+   char *fBuffer;      ///< Buffer being written, of the size of the cache
+   Int_t fFd = -1;     ///< File descriptor to write fBuffer to
+   Long64_t fSeek = 0; ///< Position of fBuffer in the file
+   Int_t fLen = 0;     ///< Number of bytes of fBuffer to write, 0 when the writer is idle
+   Bool_t fError = kFALSE; ///< A background write failed; sticky
+   Bool_t fStop = kFALSE;
+
+   RAsyncWriter(Int_t bufferSize, ESyncPolicy policy) : fPolicy(policy), fBuffer(new char[bufferSize])
+   {
+      fThread = std::thread([this]() { Run(); });
+   }
+
+   ~RAsyncWriter()
+   {
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fStop = kTRUE;
+      }
+      fCond.notify_all();
+      fThread.join();
+      delete[] fBuffer;
+   }
+
+   void Run()
+   {
+      std::unique_lock<std::mutex> lock(fMutex);
+      while (true) {
+         fCond.wait(lock, [this]() { return fLen > 0 || fStop; });
+         if (fLen == 0)
+            return;
+         const Int_t fd = fFd;
+         const Long64_t seek = fSeek;
+         const Int_t len = fLen;
+         lock.unlock();
+         const Bool_t ok = Write(fd, seek, len);
+         lock.lock();
+         if (!ok)
+            fError = kTRUE;
+         fLen = 0;
+         fCond.notify_all();
+      }
+   }
+
+   Bool_t Write(Int_t fd, Long64_t seek, Int_t len)
+   {
+#ifndef WIN32
+      Int_t done = 0;
+      while (done < len) {
+         ssize_t siz = ::pwrite(fd, fBuffer + done, len - done, seek + done);
+         if (siz < 0 && errno == EINTR)
+            continue;
+         if (siz <= 0) {
+            ::Error("TFileCacheWrite::RAsyncWriter", "error writing %d bytes at %lld in the background: %s", len,
+                    seek, std::strerror(errno));
+            return kFALSE;
+         }
+         done += siz;
+      }
+      if (fPolicy == kSyncEachBuffer && ::fsync(fd) < 0) {
+         ::Error("TFileCacheWrite::RAsyncWriter", "error syncing the data written in the background: %s",
+                 std::strerror(errno));
+         return kFALSE;
+      }
+      return kTRUE;
+#else
+      (void)fd; (void)seek; (void)len;
+      return kFALSE;
+#endif
+   }
+
+   /// Wait until the buffer handed over last is written.
+   /// Returns kTRUE if any background write failed.
+   Bool_t Wait()
+   {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fCond.wait(lock, [this]() { return fLen == 0; });
+      return fError;
+   }
+
+   /// Hand over a full buffer, which is swapped with the one of the writer.
+   /// The writer must be idle.
+   void Start(char *&buffer, Int_t fd, Long64_t seek, Int_t len)
+   {
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         std::swap(buffer, fBuffer);
+         fFd = fd;
+         fSeek = seek;
+         fLen = len;
+      }
+      fCond.notify_all();
+   }
+
+   /// Copy data being written; returns -1 if not available, waiting for the write
+   /// to finish if the data is only partially in the buffer being written.
+   Int_t ReadBuffer(char *buf, Long64_t pos, Int_t len)
+   {
+      std::unique_lock<std::mutex> lock(fMutex);
+      if (fLen == 0 || pos >= fSeek + fLen || pos + len <= fSeek)
+         return -1;
+      if (pos >= fSeek && pos + len <= fSeek + fLen) {
+         // The writer only reads its buffer, which is not swapped while we hold the lock
+         memcpy(buf, fBuffer + pos - fSeek, len);
+         return 0;
+      }
+      fCond.wait(lock, [this]() { return fLen == 0; });
+      return -1;
+   }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default Constructor.
 
@@ -69,15 +206,43 @@ TFileCacheWrite::TFileCacheWrite(TFile *file, Int_t buffersize)
 
 TFileCacheWrite::~TFileCacheWrite()
 {
+   // The writer finishes the buffer handed over last before stopping
+   delete fAsyncWriter;
    delete [] fBuffer;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Flush the current write buffer to the file.
+/// Flush the current write buffer to the file, and wait for the
+/// background writes to complete.
 /// Returns kTRUE in case of error.
 
 Bool_t TFileCacheWrite::Flush()
 {
+   return FlushBuffer(kTRUE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Flush the current write buffer to the file. With a background writer,
+/// only wait for the write to complete if wait is kTRUE.
+/// Returns kTRUE in case of error, including the errors of previous
+/// background writes.
+
+Bool_t TFileCacheWrite::FlushBuffer(Bool_t wait)
+{
+   if (fAsyncWriter) {
+      Bool_t status = kFALSE;
+      if (fNtot) {
+         // The buffers are written one after the other, in the order of the calls
+         status = fAsyncWriter->Wait();
+         fAsyncWriter->Start(fBuffer, fFile->fD, fSeekStart, fNtot);
+         fFile->fBytesWrite += fNtot;
+         TFile::fgBytesWrite += fNtot;
+         fNtot = 0;
+      }
+      if (wait)
+         status = fAsyncWriter->Wait() || status;
+      return status;
+   }
    if (!fNtot) return kFALSE;
    fFile->Seek(fSeekStart);
    //printf("Flushing buffer at fSeekStart=%lld, fNtot=%d\n",fSeekStart,fNtot);
@@ -96,6 +261,8 @@ void TFileCacheWrite::Print(Option_t *option) const
    TString opt = option;
    printf("Write cache for file %s\n",fFile->GetName());
    printf("Size of write cache: %d bytes to be written at %lld\n",fNtot,fSeekStart);
+   if (fAsyncWriter)
+      printf("Full buffers of %d bytes are written in the background\n",fBufferSize);
    opt.ToLower();
 }
 
@@ -107,11 +274,60 @@ void TFileCacheWrite::Print(Option_t *option) const
 
 Int_t TFileCacheWrite::ReadBuffer(char *buf, Long64_t pos, Int_t len)
 {
-   if (pos < fSeekStart || pos+len > fSeekStart+fNtot) return -1;
+   if (pos < fSeekStart || pos+len > fSeekStart+fNtot) {
+      // The data might also be in the buffer being written in the background
+      return fAsyncWriter ? fAsyncWriter->ReadBuffer(buf, pos, len) : -1;
+   }
    memcpy(buf,fBuffer+pos-fSeekStart,len);
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Write the full buffers in a background thread (async = kTRUE), or in the
+/// calling thread (async = kFALSE, the default).
+///
+/// Only supported for local files, opened through the POSIX interface
+/// (including network file systems mounted locally). When writing in the
+/// background, the buffer size is rounded up to a multiple of the optimal
+/// I/O size reported for the file, and a second buffer of the same size is
+/// allocated. The policy tells whether the data is synced to the storage
+/// after each buffer, or only when the file is flushed or closed.
+///
+/// Returns kFALSE if the writes cannot be done in the background.
+
+Bool_t TFileCacheWrite::SetAsync(Bool_t async, ESyncPolicy policy)
+{
+   if (fAsyncWriter) {
+      if (FlushBuffer(kTRUE)) return kFALSE;
+      delete fAsyncWriter;
+      fAsyncWriter = nullptr;
+   }
+   if (!async) return kTRUE;
+#ifndef WIN32
+   // Other TFile classes do not write through a file descriptor
+   if (!fFile || fFile->IsA() != TFile::Class() || fFile->fD < 0) return kFALSE;
+
+   struct stat st;
+   if (::fstat(fFile->fD, &st) == 0 && st.st_blksize > 0) {
+      Long64_t blksize = st.st_blksize;
+      Long64_t size = ((fBufferSize + blksize - 1) / blksize) * blksize;
+      if (size != fBufferSize && size < kMaxInt) {
+         char *buffer = new char[size];
+         memcpy(buffer, fBuffer, fNtot);
+         delete [] fBuffer;
+         fBuffer = buffer;
+         fBufferSize = size;
+      }
+   }
+   fAsyncWriter = new RAsyncWriter(fBufferSize, policy);
+   if (gDebug > 0) Info("SetAsync","Writing buffers of %d bytes in the background",fBufferSize);
+   return kTRUE;
+#else
+   (void)policy;
+   return kFALSE;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Write buffer at position pos in the write buffer.
 /// The function returns 1 if the buffer has been successfully entered into the write buffer.
@@ -126,10 +342,11 @@ Int_t TFileCacheWrite::WriteBuffer(const char *buf, Long64_t pos, Int_t len)
 
    if (fSeekStart + fNtot != pos) {
       //we must flush the current cache
-      if (Flush()) return -1; //failure
+      if (FlushBuffer(kFALSE)) return -1; //failure
    }
    if (fNtot + len >= fBufferSize) {
-      if (Flush()) return -1; //failure
+      // Before a direct write, the background writes must be complete
+      if (FlushBuffer(len >= fBufferSize)) return -1; //failure
       if (len >= fBufferSize) {
          //buffer larger than the cache itself: direct write to file
          fRecursive = kTRUE;
@@ -152,5 +369,11 @@ Int_t TFileCacheWrite::WriteBuffer(const char *buf, Long64_t pos, Int_t len)
 
 void TFileCacheWrite::SetFile(TFile *file)
 {
+   if (fAsyncWriter) {
+      // Let the background write complete, the new file is written synchronously
+      fAsyncWriter->Wait();
+      delete fAsyncWriter;
+      fAsyncWriter = nullptr;
+   }
    fFile = file;
 }
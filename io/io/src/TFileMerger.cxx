@@ -49,6 +49,8 @@ to be merged, like the standalone hadd program.
 #endif
 
 #include <cstring>
+#include <utility>
+#include <vector>
 
 ClassImp(TFileMerger);
 
@@ -410,16 +412,21 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
       info.fOptions.Append(" fast");
    }
 
-   TFile      *current_file;
-   TDirectory *current_sourcedir;
-   if (type & kIncremental) {
-      current_file      = 0;
-      current_sourcedir = target;
-   } else {
-      current_file      = (TFile*)sourcelist->First();
-      current_sourcedir = current_file->GetDirectory(path);
+   // Resolve the directory of each source once: the loops over the sources done for
+   // every object then neither search sourcelist (TList::After is linear) nor parse path.
+   std::vector<std::pair<TFile *, TDirectory *>> sources;
+   sources.reserve(sourcelist->GetSize());
+   for (auto source : *sourcelist) {
+      auto file = static_cast<TFile *>(source);
+      sources.emplace_back(file, file->GetDirectory(path));
    }
-   while (current_file || current_sourcedir) {
+   const Int_t nsources = sources.size();
+
+   // Index of the source whose keys are scanned; -1 is the target for an incremental merge.
+   Int_t icurrent = (type & kIncremental) ? -1 : 0;
+   while (icurrent < nsources) {
+      TFile      *current_file      = icurrent < 0 ? nullptr : sources[icurrent].first;
+      TDirectory *current_sourcedir = icurrent < 0 ? target : sources[icurrent].second;
       // When current_sourcedir != 0 and current_file == 0 we are going over the target
       // for an incremental merge.
       if (current_sourcedir && (current_file == 0 || current_sourcedir != target)) {
@@ -554,18 +561,19 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
 
                TList inputs;
                Bool_t oneGo = fHistoOneGo && cl->InheritsFrom(R__TH1_Class);
+               // Number of inputs read before calling Merge, 0 for all of them
+               Int_t batchSize = oneGo ? fMergeBatchSize : 1;
+               ROOT::MergeFunc_t func = cl->GetMerge();
 
                // Loop over all source files and merge same-name object
-               TFile *nextsource = current_file ? (TFile*)sourcelist->After( current_file ) : (TFile*)sourcelist->First();
-               if (nextsource == 0) {
+               if (icurrent + 1 >= nsources) {
                   // There is only one file in the list
-                  ROOT::MergeFunc_t func = cl->GetMerge();
                   func(obj, &inputs, &info);
                   info.fIsFirst = kFALSE;
                } else {
-                  do {
-                     // make sure we are at the correct directory level by cd'ing to path
-                     TDirectory *ndir = nextsource->GetDirectory(path);
+                  for (Int_t isource = icurrent + 1; isource < nsources; ++isource) {
+                     TFile *nextsource = sources[isource].first;
+                     TDirectory *ndir = sources[isource].second;
                      if (ndir) {
                         // For consistency (and persformance), we reset the MustCleanup be also for those
                         // 'key' retrieved indirectly.
@@ -577,7 +585,6 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                            if (!hobj) {
                               Info("MergeRecursive", "could not read object for key {%s, %s}; skipping file %s",
                                    key->GetName(), key->GetTitle(), nextsource->GetName());
-                              nextsource = (TFile*)sourcelist->After(nextsource);
                               continue;
                            }
                            // Set ownership for collections
@@ -586,8 +593,7 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                            }
                            hobj->ResetBit(kMustCleanup);
                            inputs.Add(hobj);
-                           if (!oneGo) {
-                              ROOT::MergeFunc_t func = cl->GetMerge();
+                           if (batchSize > 0 && inputs.GetSize() >= batchSize) {
                               Long64_t result = func(obj, &inputs, &info);
                               info.fIsFirst = kFALSE;
                               if (result < 0) {
@@ -598,11 +604,9 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                            }
                         }
                      }
-                     nextsource = (TFile*)sourcelist->After( nextsource );
-                  } while (nextsource);
+                  }
                   // Merge the list, if still to be done
-                  if (oneGo || info.fIsFirst) {
-                     ROOT::MergeFunc_t func = cl->GetMerge();
+                  if (inputs.GetSize() > 0 || info.fIsFirst) {
                      func(obj, &inputs, &info);
                      info.fIsFirst = kFALSE;
                      inputs.Delete();
@@ -620,8 +624,7 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                listHargs.Form("(TCollection*)0x%lx,(TFileMergeInfo*)0x%lx", (ULong_t)&listH,(ULong_t)&info);
 
                // Loop over all source files and merge same-name object
-               TFile *nextsource = current_file ? (TFile*)sourcelist->After( current_file ) : (TFile*)sourcelist->First();
-               if (nextsource == 0) {
+               if (icurrent + 1 >= nsources) {
                   // There is only one file in the list
                   Int_t error = 0;
                   obj->Execute("Merge", listHargs.Data(), &error);
@@ -631,9 +634,9 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                            obj->GetName(), key->GetName());
                   }
                } else {
-                  while (nextsource) {
-                     // make sure we are at the correct directory level by cd'ing to path
-                     TDirectory *ndir = nextsource->GetDirectory(path);
+                  for (Int_t isource = icurrent + 1; isource < nsources; ++isource) {
+                     TFile *nextsource = sources[isource].first;
+                     TDirectory *ndir = sources[isource].second;
                      if (ndir) {
                         // For consistency (and persformance), we reset the MustCleanup be also for those
                         // 'key' retrieved indirectly.
@@ -645,7 +648,6 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                            if (!hobj) {
                               Info("MergeRecursive", "could not read object for key {%s, %s}; skipping file %s",
                                    key->GetName(), key->GetTitle(), nextsource->GetName());
-                              nextsource = (TFile*)sourcelist->After(nextsource);
                               continue;
                            }
                            // Set ownership for collections
@@ -664,7 +666,6 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                            listH.Delete();
                         }
                      }
-                     nextsource = (TFile*)sourcelist->After( nextsource );
                   }
                   // Merge the list, if still to be done
                   if (info.fIsFirst) {
@@ -686,8 +687,7 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                listHargs.Form("((TCollection*)0x%lx)", (ULong_t)&listH);
 
                // Loop over all source files and merge same-name object
-               TFile *nextsource = current_file ? (TFile*)sourcelist->After( current_file ) : (TFile*)sourcelist->First();
-               if (nextsource == 0) {
+               if (icurrent + 1 >= nsources) {
                   // There is only one file in the list
                   Int_t error = 0;
                   obj->Execute("Merge", listHargs.Data(), &error);
@@ -696,9 +696,9 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                            obj->GetName(), key->GetName());
                   }
                } else {
-                  while (nextsource) {
-                     // make sure we are at the correct directory level by cd'ing to path
-                     TDirectory *ndir = nextsource->GetDirectory(path);
+                  for (Int_t isource = icurrent + 1; isource < nsources; ++isource) {
+                     TFile *nextsource = sources[isource].first;
+                     TDirectory *ndir = sources[isource].second;
                      if (ndir) {
                         // For consistency (and persformance), we reset the MustCleanup be also for those
                         // 'key' retrieved indirectly.
@@ -710,7 +710,6 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                            if (!hobj) {
                               Info("MergeRecursive", "could not read object for key {%s, %s}; skipping file %s",
                                    key->GetName(), key->GetTitle(), nextsource->GetName());
-                              nextsource = (TFile*)sourcelist->After(nextsource);
                               continue;
                            }
                            // Set ownership for collections
@@ -729,7 +728,6 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                            listH.Delete();
                         }
                      }
-                     nextsource = (TFile*)sourcelist->After( nextsource );
                   }
                   // Merge the list, if still to be done
                   if (info.fIsFirst) {
@@ -771,16 +769,14 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                // Let's also delete the directory from the other source (thanks to the 'allNames'
                // mechanism above we will not process the directories when tranversing the next
                // files).
-               TFile *nextsource = current_file ? (TFile*)sourcelist->After( current_file ) : (TFile*)sourcelist->First();
-               while (nextsource) {
-                  TDirectory *ndir = nextsource->GetDirectory(dirpath);
+               for (Int_t isource = icurrent + 1; isource < nsources; ++isource) {
+                  TDirectory *ndir = sources[isource].first->GetDirectory(dirpath);
                   // For consistency (and persformance), we reset the MustCleanup be also for those
                   // 'key' retrieved indirectly.
                   if (ndir) {
                      ndir->ResetBit(kMustCleanup);
                      delete ndir;
                   }
-                  nextsource = (TFile*)sourcelist->After( nextsource );
                }
             } else if (cl->InheritsFrom( TCollection::Class() )) {
                // Don't overwrite, if the object were not merged.
@@ -807,12 +803,7 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
             info.Reset();
          } // while ( ( TKey *key = (TKey*)nextkey() ) )
       }
-      current_file = current_file ? (TFile*)sourcelist->After(current_file) : (TFile*)sourcelist->First();
-      if (current_file) {
-         current_sourcedir = current_file->GetDirectory(path);
-      } else {
-         current_sourcedir = 0;
-      }
+      ++icurrent;
    }
    // save modifications to the target directory.
    if (!(type&kIncremental)) {
@@ -1014,6 +1005,20 @@ void TFileMerger::SetMaxOpenedFiles(Int_t newmax)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Limit the number of input histograms held in memory when the histograms are
+/// merged in one go (see the histoOneGo argument of the constructor).
+///
+/// With a size of N, the histograms read from the inputs are passed to Merge()
+/// in lists of at most N elements, so that merging many inputs does not keep
+/// one copy of each histogram in memory. A size of 0 (the default) merges all
+/// the inputs with a single call to Merge().
+
+void TFileMerger::SetMergeBatchSize(Int_t size)
+{
+   fMergeBatchSize = size > 0 ? size : 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the prefix to be used when printing informational message.
 
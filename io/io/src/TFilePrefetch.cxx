@@ -19,12 +19,15 @@
 #include "TFPBlock.h"
 #include "strlcpy.h"
 
+#include <algorithm>
 #include <string>
 #include <sstream>
 #include <cstdio>
 #include <cstdlib>
 #include <cctype>
 #include <cassert>
+#include <ctime>
+#include <vector>
 
 static const int kMAX_READ_SIZE    = 2;   //maximum size of the read list of blocks
 
@@ -47,6 +50,14 @@ processing considerably decreases. Besides the prefetching
 mechanisms there is also a local caching option which can be
 enabled by the user. Both capabilities are disabled by default
 and must be explicitly enabled by the user.
+
+The cache directory may be shared by several processes, e.g. all the
+jobs of a worker node reading the same remote files: blocks are
+identified by the file name and the block layout, and they are written
+to a temporary file that is renamed into place, so that a block never
+shows up partially written. With SetCacheMaxSize() (or the rootrc
+variable Cache.MaxSize) the least recently used blocks are removed
+from the cache once it grows beyond the given size.
 */
 
 
@@ -56,6 +67,8 @@ and must be explicitly enabled by the user.
 TFilePrefetch::TFilePrefetch(TFile* file) :
   fFile(file),
   fConsumer(0),
+  fCacheMaxSize(0),
+  fCacheSize(0),
   fThreadJoined(kTRUE),
   fPrefetchFinished(kFALSE)
 {
@@ -108,9 +121,11 @@ void TFilePrefetch::WaitFinishPrefetch()
 void TFilePrefetch::ReadAsync(TFPBlock* block, Bool_t &inCache)
 {
    char* path = 0;
+   char* buffer = 0;
 
-   if (CheckBlockInCache(path, block)){
-      block->SetBuffer(GetBlockFromCache(path, block->GetDataSize()));
+   // The cached block may have been evicted by another process in the meantime
+   if (CheckBlockInCache(path, block) && (buffer = GetBlockFromCache(path, block->GetDataSize()))) {
+      block->SetBuffer(buffer);
       inCache = kTRUE;
    }
    else{
@@ -392,53 +407,58 @@ Int_t TFilePrefetch::SumHex(const char *hex)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Test if the block is in cache.
+/// Return the path of the cache file of a block.
+///
+/// The file name is the MD5 of the name of the file and of the positions and
+/// lengths of the pieces of the block; the sub-directory is the sum of its
+/// hex digits modulo 16.
 
-Bool_t TFilePrefetch::CheckBlockInCache(char*& path, TFPBlock* block)
+TString TFilePrefetch::GetBlockCachePath(TFPBlock* block)
 {
-   if (fPathCache == "")
-      return false;
+   TMD5 md;
 
-   Bool_t found = false;
-   TString fullPath(fPathCache); // path of the cached files.
+   TString concatStr(fFile ? fFile->GetName() : "");
+   md.Update((UChar_t*)concatStr.Data(), concatStr.Length());
+   for (Int_t i=0; i < block->GetNoElem(); i++){
+      concatStr.Form(":%lld+%d", block->GetPos(i), block->GetLen(i));
+      md.Update((UChar_t*)concatStr.Data(), concatStr.Length());
+   }
+   md.Final();
 
-   Int_t value = 0;
+   TString fileName( md.AsString() );
+   TString fullPath( fPathCache );
+   fullPath += TString::Format("/%i/", SumHex(fileName) % 16);
+   fullPath += fileName;
+   return fullPath;
+}
 
-   if (!gSystem->OpenDirectory(fullPath))
-      gSystem->mkdir(fullPath);
+////////////////////////////////////////////////////////////////////////////////
+/// Test if the block is in cache.
+///
+/// A block found in cache is marked as recently used, so that it is evicted
+/// last from a cache with a size limit.
 
-   //dir is SHA1 value modulo 16; filename is the value of the SHA1(offset+len)
-   TMD5* md = new TMD5();
+Bool_t TFilePrefetch::CheckBlockInCache(char*& path, TFPBlock* block)
+{
+   if (fPathCache == "")
+      return false;
 
-   TString concatStr;
-   for (Int_t i=0; i < block->GetNoElem(); i++){
-      concatStr.Form("%lld", block->GetPos(i));
-      md->Update((UChar_t*)concatStr.Data(), concatStr.Length());
-   }
+   TString fullPath = GetBlockCachePath(block);
 
-   md->Final();
-   TString fileName( md->AsString() );
-   value = SumHex(fileName);
-   value = value % 16;
-   TString dirName;
-   dirName.Form("%i", value);
+   FileStat_t stat;
+   if (gSystem->GetPathInfo(fullPath, stat) != 0 || stat.fSize != block->GetDataSize())
+      return false;
 
-   fullPath += "/" + dirName + "/" + fileName;
+   Long_t now = (Long_t) time(nullptr);
+   gSystem->Utime(fullPath, now, now);
 
-   FileStat_t stat;
-   if (gSystem->GetPathInfo(fullPath, stat) == 0) {
-      path = new char[fullPath.Length() + 1];
-      strlcpy(path, fullPath,fullPath.Length() + 1);
-      found = true;
-   } else
-      found = false;
-
-   delete md;
-   return found;
+   path = new char[fullPath.Length() + 1];
+   strlcpy(path, fullPath,fullPath.Length() + 1);
+   return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Return a buffer from cache.
+/// Return a buffer from cache, or 0 if it cannot be read.
 
 char* TFilePrefetch::GetBlockFromCache(const char* path, Int_t length)
 {
@@ -447,12 +467,21 @@ char* TFilePrefetch::GetBlockFromCache(const char* path, Int_t length)
 
    strPath += "?filetype=raw";
    TFile* file = new TFile(strPath);
+   if (file->IsZombie()) {
+      delete file;
+      return 0;
+   }
 
    Double_t start = 0;
    if (gPerfStats != 0) start = TTimeStamp();
 
    buffer = (char*) calloc(length, sizeof(char));
-   file->ReadBuffer(buffer, 0, length);
+   if (file->ReadBuffer(buffer, 0, length)) {
+      free(buffer);
+      file->Close();
+      delete file;
+      return 0;
+   }
 
    fFile->fBytesRead  += length;
    fFile->fgBytesRead += length;
@@ -472,68 +501,119 @@ char* TFilePrefetch::GetBlockFromCache(const char* path, Int_t length)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Save the block content in cache.
+///
+/// The block is written to a file private to this process, which is then
+/// renamed to its final name: processes sharing the cache directory either
+/// see the complete block or no block at all.
 
 void TFilePrefetch::SaveBlockInCache(TFPBlock* block)
 {
    if (fPathCache == "")
       return;
 
-   //dir is SHA1 value modulo 16; filename is the value of the SHA1
-   TMD5* md = new TMD5();
+   TString fullPath = GetBlockCachePath(block);
+   TString dirName = gSystem->GetDirName(fullPath);
+   if (gSystem->AccessPathName(dirName))
+      gSystem->mkdir(dirName);
 
-   TString concatStr;
-   for(Int_t i=0; i< block->GetNoElem(); i++){
-      concatStr.Form("%lld", block->GetPos(i));
-      md->Update((UChar_t*)concatStr.Data(), concatStr.Length());
-   }
-   md->Final();
+   TString tmpPath = fullPath + TString::Format(".%d.%lx.tmp", gSystem->GetPid(), (ULong_t)this);
+   TFile* file = TFile::Open(tmpPath + "?filetype=raw", "recreate");
+   if (!file)
+      return;
 
-   TString fileName( md->AsString() );
-   Int_t value = SumHex(fileName);
-   value = value % 16;
+   Bool_t failed = file->WriteBuffer(block->GetBuffer(), block->GetDataSize());
+   file->Close();
+   delete file;
 
-   TString fullPath( fPathCache );
-   TString dirName;
-   dirName.Form("%i", value);
-   fullPath += ("/" + dirName);
+   if (failed || gSystem->Rename(tmpPath, fullPath)) {
+      gSystem->Unlink(tmpPath);
+      return;
+   }
 
-   if (!gSystem->OpenDirectory(fullPath))
-      gSystem->mkdir(fullPath);
+   fCacheSize += block->GetDataSize();
+   if (fCacheMaxSize > 0 && fCacheSize > fCacheMaxSize)
+      EvictFromCache();
+}
 
-   TFile* file = 0;
-   fullPath += ("/" + fileName);
-   FileStat_t stat;
-   if (gSystem->GetPathInfo(fullPath, stat) == 0) {
-      fullPath += "?filetype=raw";
-      file = TFile::Open(fullPath, "update");
-   } else{
-      fullPath += "?filetype=raw";
-      file = TFile::Open(fullPath, "new");
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the least recently used blocks from the cache directory until it
+/// uses less than 90% of the maximum cache size.
+///
+/// The whole directory is scanned, as it may be shared with other processes;
+/// the size found is the new estimate of the cache size.
+
+void TFilePrefetch::EvictFromCache()
+{
+   struct CachedBlock {
+      TString fPath;
+      Long64_t fSize;
+      Long_t fMtime;
+   };
+   std::vector<CachedBlock> blocks;
+   Long64_t total = 0;
+
+   for (Int_t i = 0; i < 16; i++) {
+      TString dirName = fPathCache + TString::Format("/%i", i);
+      void *dirp = gSystem->OpenDirectory(dirName);
+      if (!dirp)
+         continue;
+      while (const char *name = gSystem->GetDirEntry(dirp)) {
+         // Skip the blocks still being written by other processes
+         if (name[0] == '.' || TString(name).EndsWith(".tmp"))
+            continue;
+         TString path = dirName + "/" + name;
+         FileStat_t stat;
+         if (gSystem->GetPathInfo(path, stat) == 0 && !R_ISDIR(stat.fMode)) {
+            blocks.push_back({path, stat.fSize, stat.fMtime});
+            total += stat.fSize;
+         }
+      }
+      gSystem->FreeDirectory(dirp);
    }
 
-   if (file) {
-      // coverity[unchecked_value] We do not print error message, have not error
-      // return code and close the file anyway, not need to check the return value.
-      file->WriteBuffer(block->GetBuffer(), block->GetDataSize());
-      file->Close();
-      delete file;
+   if (total > fCacheMaxSize) {
+      std::sort(blocks.begin(), blocks.end(),
+                [](const CachedBlock &a, const CachedBlock &b) { return a.fMtime < b.fMtime; });
+      const Long64_t target = fCacheMaxSize / 10 * 9;
+      for (auto &b : blocks) {
+         if (total <= target)
+            break;
+         // Another process may have removed the block already
+         if (gSystem->Unlink(b.fPath) == 0)
+            total -= b.fSize;
+      }
    }
-   delete md;
+   fCacheSize = total;
 }
 
-
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the path of the cache directory.
 
 Bool_t TFilePrefetch::SetCache(const char* path)
 {
   fPathCache = path;
+  fCacheSize = 0;
 
-  if (!gSystem->OpenDirectory(path)){
+  if (gSystem->AccessPathName(path)){
     return (!gSystem->mkdir(path) ? true : false);
   }
 
   // Directory already exists
+  if (fCacheMaxSize > 0)
+    EvictFromCache();
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the maximum size in bytes of the cache directory, 0 meaning no limit.
+///
+/// Once the cache grows beyond this size, the blocks that were least recently
+/// used are removed. The limit is enforced by every process that uses the
+/// cache directory with a size limit.
+
+void TFilePrefetch::SetCacheMaxSize(Long64_t size)
+{
+   fCacheMaxSize = size;
+   if (fCacheMaxSize > 0 && fPathCache != "")
+      EvictFromCache();
+}
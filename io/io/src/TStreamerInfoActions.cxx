@@ -17,6 +17,7 @@
 #include "TInterpreter.h"
 #include "TError.h"
 #include "TVirtualArray.h"
+#include "TVirtualObject.h"
 #include "TBufferFile.h"
 #include "TBufferText.h"
 #include "TMemberStreamer.h"
@@ -210,6 +211,16 @@ namespace TStreamerInfoActions
       return 0;
    }
 
+   /// Read a fixed size array or a run of consecutive data members of the same basic type,
+   /// as regrouped by TStreamerInfo::Compile, with a single byte-swapping copy.
+   template <typename T>
+   INLINE_TEMPLATE_ARGS Int_t ReadBasicArray(TBuffer &buf, void *addr, const TConfiguration *config)
+   {
+      T *x = (T*)( ((char*)addr) + config->fOffset );
+      buf.ReadFastArray(x, config->fCompInfo->fLength);
+      return 0;
+   }
+
    void HandleReferencedTObject(TBuffer &buf, void *addr, const TConfiguration *config) {
       TBitsConfiguration *conf = (TBitsConfiguration*)config;
       UShort_t pidf;
@@ -253,6 +264,16 @@ namespace TStreamerInfoActions
       return 0;
    }
 
+   /// Write a fixed size array or a run of consecutive data members of the same basic type,
+   /// as regrouped by TStreamerInfo::Compile, with a single byte-swapping copy.
+   template <typename T>
+   INLINE_TEMPLATE_ARGS Int_t WriteBasicArray(TBuffer &buf, void *addr, const TConfiguration *config)
+   {
+      T *x = (T *)(((char *)addr) + config->fOffset);
+      buf.WriteFastArray(x, config->fCompInfo->fLength);
+      return 0;
+   }
+
    INLINE_TEMPLATE_ARGS Int_t WriteTextTNamed(TBuffer &buf, void *addr, const TConfiguration *config)
    {
       void *x = (void *)(((char *)addr) + config->fOffset);
@@ -1526,6 +1547,52 @@ namespace TStreamerInfoActions
       return 0;
    }
 
+   Int_t PushNewDataCache(TBuffer &b, void *, const TConfiguration *conf)
+   {
+      b.PushDataCache( new TVirtualArray( conf->fCompInfo->fElem->GetClassPointer(), 1 ) );
+      return 0;
+   }
+
+   Int_t DeleteDataCache(TBuffer &b, void *, const TConfiguration *)
+   {
+      delete b.PopDataCache();
+      return 0;
+   }
+
+   class TConfReadRule : public TConfiguration {
+      // Configuration object for the kArtificial case, i.e. the execution of a read rule.
+   public:
+      ROOT::TSchemaRule::ReadFuncPtr_t    fReadFunc;
+      ROOT::TSchemaRule::ReadRawFuncPtr_t fReadRawFunc;
+
+      TConfReadRule(TVirtualStreamerInfo *info, UInt_t id, TCompInfo_t *compinfo, Int_t offset,
+                    ROOT::TSchemaRule::ReadFuncPtr_t readfunc, ROOT::TSchemaRule::ReadRawFuncPtr_t readrawfunc) :
+         TConfiguration(info,id,compinfo,offset),fReadFunc(readfunc),fReadRawFunc(readrawfunc) {};
+      virtual TConfiguration *Copy() { return new TConfReadRule(*this); }
+   };
+
+   Int_t ReadRawRule(TBuffer &b, void *addr, const TConfiguration *conf)
+   {
+      // Intentionally pass the object, so that the member can be set from other members.
+      ((TConfReadRule*)conf)->fReadRawFunc( (char*)addr, b );
+      return 0;
+   }
+
+   Int_t ReadRule(TBuffer &b, void *addr, const TConfiguration *conf)
+   {
+      const TConfReadRule *config = (const TConfReadRule*)conf;
+
+      TVirtualObject obj(0);
+      TVirtualArray *objarr = b.PeekDataCache();
+      if (objarr) {
+         obj.fClass = objarr->fClass;
+         obj.fObject = objarr->GetObjectAt(0);
+      }
+      config->fReadFunc( ((char*)addr) + config->fOffset, &obj );
+      obj.fObject = 0; // Prevent auto deletion
+      return 0;
+   }
+
    class TConfigurationUseCache : public TConfiguration {
       // Configuration object for the UseCache case.
    public:
@@ -1805,6 +1872,16 @@ namespace TStreamerInfoActions
          return 0;
       }
 
+      template <Int_t (*iter_action)(TBuffer&,void *,const TConfiguration*)>
+      static INLINE_TEMPLATE_ARGS Int_t WriteAction(TBuffer &buf, void *start, const void *end, const TLoopConfiguration *loopconfig, const TConfiguration *config)
+      {
+         const Int_t incr = ((TVectorLoopConfig*)loopconfig)->fIncrement;
+         for(void *iter = start; iter != end; iter = (char*)iter + incr ) {
+            iter_action(buf, iter, config);
+         }
+         return 0;
+      }
+
       static INLINE_TEMPLATE_ARGS Int_t ReadBase(TBuffer &buf, void *start, const void *end, const TLoopConfiguration * loopconfig, const TConfiguration *config)
       {
          // Well the implementation is non trivial since we do not have a proxy for the container of _only_ the base class.  For now
@@ -2172,6 +2249,15 @@ namespace TStreamerInfoActions
          return 0;
       }
 
+      template <Int_t (*action)(TBuffer&,void *,const TConfiguration*)>
+      static INLINE_TEMPLATE_ARGS Int_t WriteAction(TBuffer &buf, void *start, const void *end, const TConfiguration *config)
+      {
+         for(void *iter = start; iter != end; iter = (char*)iter + sizeof(void*) ) {
+            action(buf, *(void**)iter, config);
+         }
+         return 0;
+      }
+
       static INLINE_TEMPLATE_ARGS Int_t ReadBase(TBuffer &buf, void *start, const void *end, const TConfiguration *config)
       {
          // Well the implementation is non trivial since we do not have a proxy for the container of _only_ the base class.  For now
@@ -2831,6 +2917,19 @@ static TConfiguredAction GetCollectionReadAction(TVirtualStreamerInfo *info, TSt
       case TStreamerInfo::kUInt:    return TConfiguredAction( Looper::template ReadBasicType<UInt_t>,   new TConfiguration(info,i,compinfo,offset) );    break;
       case TStreamerInfo::kULong:   return TConfiguredAction( Looper::template ReadBasicType<ULong_t>,  new TConfiguration(info,i,compinfo,offset) );   break;
       case TStreamerInfo::kULong64: return TConfiguredAction( Looper::template ReadBasicType<ULong64_t>, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kBool: return TConfiguredAction( Looper::template ReadAction<ReadBasicArray<Bool_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kChar: return TConfiguredAction( Looper::template ReadAction<ReadBasicArray<Char_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kShort: return TConfiguredAction( Looper::template ReadAction<ReadBasicArray<Short_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kInt: return TConfiguredAction( Looper::template ReadAction<ReadBasicArray<Int_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kLong: return TConfiguredAction( Looper::template ReadAction<ReadBasicArray<Long_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kLong64: return TConfiguredAction( Looper::template ReadAction<ReadBasicArray<Long64_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kFloat: return TConfiguredAction( Looper::template ReadAction<ReadBasicArray<Float_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kDouble: return TConfiguredAction( Looper::template ReadAction<ReadBasicArray<Double_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUChar: return TConfiguredAction( Looper::template ReadAction<ReadBasicArray<UChar_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUShort: return TConfiguredAction( Looper::template ReadAction<ReadBasicArray<UShort_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUInt: return TConfiguredAction( Looper::template ReadAction<ReadBasicArray<UInt_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kULong: return TConfiguredAction( Looper::template ReadAction<ReadBasicArray<ULong_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kULong64: return TConfiguredAction( Looper::template ReadAction<ReadBasicArray<ULong64_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
       case TStreamerInfo::kBits: return TConfiguredAction( Looper::template ReadAction<TStreamerInfoActions::ReadBasicType<BitsMarker> > , new TBitsConfiguration(info,i,compinfo,offset) ); break;
       case TStreamerInfo::kFloat16: {
          if (element->GetFactor() != 0) {
@@ -2957,6 +3056,19 @@ static TConfiguredAction GetCollectionWriteAction(TVirtualStreamerInfo *info, TS
       case TStreamerInfo::kUInt:    return TConfiguredAction( Looper::template WriteBasicType<UInt_t>,   new TConfiguration(info,i,compinfo,offset) ); break;
       case TStreamerInfo::kULong:   return TConfiguredAction( Looper::template WriteBasicType<ULong_t>,  new TConfiguration(info,i,compinfo,offset) ); break;
       case TStreamerInfo::kULong64: return TConfiguredAction( Looper::template WriteBasicType<ULong64_t>,new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kBool: return TConfiguredAction( Looper::template WriteAction<WriteBasicArray<Bool_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kChar: return TConfiguredAction( Looper::template WriteAction<WriteBasicArray<Char_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kShort: return TConfiguredAction( Looper::template WriteAction<WriteBasicArray<Short_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kInt: return TConfiguredAction( Looper::template WriteAction<WriteBasicArray<Int_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kLong: return TConfiguredAction( Looper::template WriteAction<WriteBasicArray<Long_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kLong64: return TConfiguredAction( Looper::template WriteAction<WriteBasicArray<Long64_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kFloat: return TConfiguredAction( Looper::template WriteAction<WriteBasicArray<Float_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kDouble: return TConfiguredAction( Looper::template WriteAction<WriteBasicArray<Double_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUChar: return TConfiguredAction( Looper::template WriteAction<WriteBasicArray<UChar_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUShort: return TConfiguredAction( Looper::template WriteAction<WriteBasicArray<UShort_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUInt: return TConfiguredAction( Looper::template WriteAction<WriteBasicArray<UInt_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kULong: return TConfiguredAction( Looper::template WriteAction<WriteBasicArray<ULong_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kULong64: return TConfiguredAction( Looper::template WriteAction<WriteBasicArray<ULong64_t> >, new TConfiguration(info,i,compinfo,offset) ); break;
       // the simple type missing are kBits and kCounter.
       default:
          return TConfiguredAction( Looper::GenericWrite, new TConfiguration(info,i,compinfo,0 /* 0 because we call the legacy code */) );
@@ -3260,6 +3372,20 @@ void TStreamerInfo::AddReadAction(TStreamerInfoActions::TActionSequence *readSeq
       case TStreamerInfo::kUInt:    readSequence->AddAction( ReadBasicType<UInt_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
       case TStreamerInfo::kULong:   readSequence->AddAction( ReadBasicType<ULong_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
       case TStreamerInfo::kULong64: readSequence->AddAction( ReadBasicType<ULong64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      // Fixed size arrays and regrouped consecutive members of the same basic type.
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kBool: readSequence->AddAction( ReadBasicArray<Bool_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kChar: readSequence->AddAction( ReadBasicArray<Char_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kShort: readSequence->AddAction( ReadBasicArray<Short_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kInt: readSequence->AddAction( ReadBasicArray<Int_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kLong: readSequence->AddAction( ReadBasicArray<Long_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kLong64: readSequence->AddAction( ReadBasicArray<Long64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kFloat: readSequence->AddAction( ReadBasicArray<Float_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kDouble: readSequence->AddAction( ReadBasicArray<Double_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUChar: readSequence->AddAction( ReadBasicArray<UChar_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUShort: readSequence->AddAction( ReadBasicArray<UShort_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUInt: readSequence->AddAction( ReadBasicArray<UInt_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kULong: readSequence->AddAction( ReadBasicArray<ULong_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kULong64: readSequence->AddAction( ReadBasicArray<ULong64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
       case TStreamerInfo::kBits:    readSequence->AddAction( ReadBasicType<BitsMarker>, new TBitsConfiguration(this,i,compinfo,compinfo->fOffset) );     break;
       case TStreamerInfo::kFloat16: {
          if (element->GetFactor() != 0) {
@@ -3457,6 +3583,27 @@ void TStreamerInfo::AddReadAction(TStreamerInfoActions::TActionSequence *readSeq
          }
          break;
       }
+      case TStreamerInfo::kCacheNew:
+         readSequence->AddAction( PushNewDataCache, new TConfiguration(this,i,compinfo,compinfo->fOffset) );
+         break;
+      case TStreamerInfo::kCacheDelete:
+         readSequence->AddAction( DeleteDataCache, new TConfiguration(this,i,compinfo,compinfo->fOffset) );
+         break;
+      case TStreamerInfo::kArtificial: {
+         // Call the function of the read rule directly rather than through the generic ReadBuffer
+         TStreamerArtificial *artElement = (TStreamerArtificial*)element;
+         ROOT::TSchemaRule::ReadRawFuncPtr_t rawfunc = artElement->GetReadRawFunc();
+         ROOT::TSchemaRule::ReadFuncPtr_t readfunc = artElement->GetReadFunc();
+         if (rawfunc) {
+            readSequence->AddAction( ReadRawRule, new TConfReadRule(this,i,compinfo,0,readfunc,rawfunc) );
+         } else if (readfunc) {
+            readSequence->AddAction( ReadRule, new TConfReadRule(this,i,compinfo,0,readfunc,rawfunc) );
+         } else {
+            // Nothing to execute, e.g. additional targets of a rule which are set by its first target.
+            return;
+         }
+         break;
+      }
       default:
          readSequence->AddAction( GenericReadAction, new TGenericConfiguration(this,i,compinfo) );
          break;
@@ -3580,6 +3727,20 @@ void TStreamerInfo::AddWriteAction(TStreamerInfoActions::TActionSequence *writeS
       case TStreamerInfo::kUInt:    writeSequence->AddAction( WriteBasicType<UInt_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
       case TStreamerInfo::kULong:   writeSequence->AddAction( WriteBasicType<ULong_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );   break;
       case TStreamerInfo::kULong64: writeSequence->AddAction( WriteBasicType<ULong64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      // Fixed size arrays and regrouped consecutive members of the same basic type.
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kBool: writeSequence->AddAction( WriteBasicArray<Bool_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kChar: writeSequence->AddAction( WriteBasicArray<Char_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kShort: writeSequence->AddAction( WriteBasicArray<Short_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kInt: writeSequence->AddAction( WriteBasicArray<Int_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kLong: writeSequence->AddAction( WriteBasicArray<Long_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kLong64: writeSequence->AddAction( WriteBasicArray<Long64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kFloat: writeSequence->AddAction( WriteBasicArray<Float_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kDouble: writeSequence->AddAction( WriteBasicArray<Double_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUChar: writeSequence->AddAction( WriteBasicArray<UChar_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUShort: writeSequence->AddAction( WriteBasicArray<UShort_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kUInt: writeSequence->AddAction( WriteBasicArray<UInt_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kULong: writeSequence->AddAction( WriteBasicArray<ULong_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
+      case TStreamerInfo::kOffsetL + TStreamerInfo::kULong64: writeSequence->AddAction( WriteBasicArray<ULong64_t>, new TConfiguration(this,i,compinfo,compinfo->fOffset) ); break;
        // case TStreamerInfo::kBits:    writeSequence->AddAction( WriteBasicType<BitsMarker>, new TConfiguration(this,i,compinfo,compinfo->fOffset) );    break;
      /*case TStreamerInfo::kFloat16: {
          if (element->GetFactor() != 0) {
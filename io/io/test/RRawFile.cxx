@@ -10,6 +10,7 @@
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -168,6 +169,36 @@ TEST(RRawFile, ReadV)
 }
 
 
+
+TEST(RRawFile, ReadVMany)
+{
+   // More requests than the depth of an io_uring queue, in random order, some of them reaching past the end of file
+   std::string content;
+   for (int i = 0; i < 100000; ++i)
+      content.push_back(static_cast<char>(i * 7 + 3));
+   FileRaii readvGuard("test_rawfile_readv_many", content);
+   auto f = RRawFile::Create("test_rawfile_readv_many");
+
+   const unsigned int nReq = 1000;
+   const std::size_t size = 300;
+   std::vector<char> buffer(nReq * size);
+   std::vector<RRawFile::RIOVec> iovec(nReq);
+   for (unsigned int i = 0; i < nReq; ++i) {
+      iovec[i].fBuffer = &buffer[i * size];
+      iovec[i].fOffset = (i * 7919) % (content.size() + 100);
+      iovec[i].fSize = size;
+   }
+   f->ReadV(iovec.data(), nReq);
+
+   for (unsigned int i = 0; i < nReq; ++i) {
+      const auto offset = iovec[i].fOffset;
+      const auto expected = (offset >= content.size()) ? 0 : std::min(size, content.size() - offset);
+      ASSERT_EQ(expected, iovec[i].fOutBytes) << "request " << i;
+      EXPECT_EQ(0, memcmp(&buffer[i * size], content.data() + std::min<std::size_t>(offset, content.size()), expected))
+         << "request " << i;
+   }
+}
+
 TEST(RRawFile, SplitUrl)
 {
    EXPECT_STREQ("C:\\Data\\events.root", RRawFile::GetLocation("C:\\Data\\events.root").c_str());
@@ -0,0 +1,112 @@
+#include "TBufferFile.h"
+#include "TClass.h"
+#include "TNamed.h"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <vector>
+
+// Streaming of basic type arrays, which includes the conversion to big endian
+template <typename T>
+static void BM_TBufferFile_WriteFastArray(benchmark::State &state)
+{
+   const Int_t n = state.range(0);
+   std::vector<T> values(n);
+   for (Int_t i = 0; i < n; ++i)
+      values[i] = static_cast<T>(i * 3 + 1);
+
+   TBufferFile buf(TBuffer::kWrite, n * sizeof(T) + 1024);
+   for (auto _ : state) {
+      buf.SetBufferOffset(0);
+      buf.WriteFastArray(values.data(), n);
+      benchmark::ClobberMemory();
+   }
+   state.SetItemsProcessed(state.iterations() * n);
+   state.SetBytesProcessed(state.iterations() * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_TBufferFile_WriteFastArray, Short_t)->Range(16, 1 << 16);
+BENCHMARK_TEMPLATE(BM_TBufferFile_WriteFastArray, Int_t)->Range(16, 1 << 16);
+BENCHMARK_TEMPLATE(BM_TBufferFile_WriteFastArray, Float_t)->Range(16, 1 << 16);
+BENCHMARK_TEMPLATE(BM_TBufferFile_WriteFastArray, Double_t)->Range(16, 1 << 16);
+
+template <typename T>
+static void BM_TBufferFile_ReadFastArray(benchmark::State &state)
+{
+   const Int_t n = state.range(0);
+   std::vector<T> values(n);
+   for (Int_t i = 0; i < n; ++i)
+      values[i] = static_cast<T>(i * 3 + 1);
+   TBufferFile wbuf(TBuffer::kWrite, n * sizeof(T) + 1024);
+   wbuf.WriteFastArray(values.data(), n);
+
+   TBufferFile rbuf(TBuffer::kRead, wbuf.Length(), wbuf.Buffer(), kFALSE);
+   for (auto _ : state) {
+      rbuf.SetBufferOffset(0);
+      rbuf.ReadFastArray(values.data(), n);
+      benchmark::DoNotOptimize(values.data());
+   }
+   state.SetItemsProcessed(state.iterations() * n);
+   state.SetBytesProcessed(state.iterations() * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_TBufferFile_ReadFastArray, Short_t)->Range(16, 1 << 16);
+BENCHMARK_TEMPLATE(BM_TBufferFile_ReadFastArray, Int_t)->Range(16, 1 << 16);
+BENCHMARK_TEMPLATE(BM_TBufferFile_ReadFastArray, Float_t)->Range(16, 1 << 16);
+BENCHMARK_TEMPLATE(BM_TBufferFile_ReadFastArray, Double_t)->Range(16, 1 << 16);
+
+// Streaming of objects through their TStreamerInfo, for a collection and a TObject
+static void BM_TBufferFile_WriteObjectAny_Vector(benchmark::State &state)
+{
+   const Int_t n = state.range(0);
+   std::vector<float> values(n, 1.5f);
+   TClass *cl = TClass::GetClass("vector<float>");
+
+   TBufferFile buf(TBuffer::kWrite, n * sizeof(float) + 1024);
+   for (auto _ : state) {
+      buf.SetBufferOffset(0);
+      buf.ResetMap();
+      buf.WriteObjectAny(&values, cl);
+      benchmark::ClobberMemory();
+   }
+   state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_TBufferFile_WriteObjectAny_Vector)->Range(16, 1 << 16);
+
+static void BM_TBufferFile_ReadObjectAny_Vector(benchmark::State &state)
+{
+   const Int_t n = state.range(0);
+   std::vector<float> values(n, 1.5f);
+   TClass *cl = TClass::GetClass("vector<float>");
+   TBufferFile wbuf(TBuffer::kWrite, n * sizeof(float) + 1024);
+   wbuf.WriteObjectAny(&values, cl);
+
+   TBufferFile rbuf(TBuffer::kRead, wbuf.Length(), wbuf.Buffer(), kFALSE);
+   for (auto _ : state) {
+      rbuf.SetBufferOffset(0);
+      rbuf.ResetMap();
+      auto obj = static_cast<std::vector<float> *>(rbuf.ReadObjectAny(cl));
+      benchmark::DoNotOptimize(obj);
+      delete obj;
+   }
+   state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_TBufferFile_ReadObjectAny_Vector)->Range(16, 1 << 16);
+
+static void BM_TBufferFile_RoundTrip_TNamed(benchmark::State &state)
+{
+   TNamed named("benchmark", "Object streamed through its TStreamerInfo");
+   TBufferFile buf(TBuffer::kWrite);
+   for (auto _ : state) {
+      buf.SetWriteMode();
+      buf.SetBufferOffset(0);
+      buf.ResetMap();
+      buf.WriteObject(&named);
+      buf.SetReadMode();
+      buf.SetBufferOffset(0);
+      buf.ResetMap();
+      auto obj = buf.ReadObject(TNamed::Class());
+      benchmark::DoNotOptimize(obj);
+      delete obj;
+   }
+}
+BENCHMARK(BM_TBufferFile_RoundTrip_TNamed);
@@ -0,0 +1,164 @@
+#include "TBufferFile.h"
+#include "TClass.h"
+#include "TInterpreter.h"
+#include "TStreamerElement.h"
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <vector>
+
+// Consecutive members of the same type are regrouped by TStreamerInfo::Compile and streamed, as the
+// fixed size arrays, with a single fast array action
+#define FUSED_MEMBERS_DECL                                                                  \
+   struct FusedMembers {                                                                    \
+      Int_t fA;                                                                             \
+      Int_t fB;                                                                             \
+      Int_t fC;                                                                             \
+      Float_t fArr[5];                                                                      \
+      Double_t fD;                                                                          \
+      Double_t fE;                                                                          \
+      Short_t fS[3];                                                                        \
+      Char_t fName[8];                                                                      \
+      Bool_t fFlag;                                                                         \
+   };
+#define FUSED_MEMBERS_STR_IMPL(x) #x
+#define FUSED_MEMBERS_STR(x) FUSED_MEMBERS_STR_IMPL(x)
+FUSED_MEMBERS_DECL
+
+// Element counts covering empty vector bodies, partial and full vector blocks and scalar tails
+static const Int_t gSizes[] = {1, 3, 4, 7, 8, 15, 16, 17, 33, 100, 1001};
+
+template <typename T>
+void CheckRoundTrip(T value0, T step)
+{
+   for (Int_t n : gSizes) {
+      std::vector<T> in(n);
+      for (Int_t i = 0; i < n; ++i)
+         in[i] = value0 + step * i;
+
+      TBufferFile wbuf(TBuffer::kWrite);
+      wbuf.WriteFastArray(in.data(), n);
+      wbuf.WriteArray(in.data(), n);
+      ASSERT_EQ(Int_t(2 * n * sizeof(T) + sizeof(Int_t)), wbuf.Length());
+
+      // The serialized form is big endian
+      const char *raw = wbuf.Buffer();
+      for (Int_t i = 0; i < n; ++i) {
+         char *elem = const_cast<char *>(raw) + i * sizeof(T);
+         T x;
+         frombuf(elem, &x);
+         ASSERT_EQ(in[i], x) << "n=" << n << " i=" << i;
+      }
+
+      TBufferFile rbuf(TBuffer::kRead, wbuf.Length(), wbuf.Buffer(), kFALSE);
+      std::vector<T> out(n);
+      rbuf.ReadFastArray(out.data(), n);
+      EXPECT_EQ(in, out) << "n=" << n;
+      T *outArray = nullptr;
+      EXPECT_EQ(n, rbuf.ReadArray(outArray));
+      EXPECT_EQ(0, std::memcmp(in.data(), outArray, n * sizeof(T))) << "n=" << n;
+      delete[] outArray;
+      EXPECT_EQ(wbuf.Length(), rbuf.Length());
+   }
+}
+
+TEST(TBufferFile, FastArrayRoundTrip)
+{
+   CheckRoundTrip<Short_t>(-300, 7);
+   CheckRoundTrip<Int_t>(-100000, 70001);
+   CheckRoundTrip<Long64_t>(-(1ll << 40), 123456789012ll);
+   CheckRoundTrip<Float_t>(-3.5f, 0.37f);
+   CheckRoundTrip<Double_t>(-1e10, 12345.678);
+}
+
+TEST(TBufferFile, FastArrayFloat16Double32)
+{
+   TStreamerElement floatNbits("f", "[0,0,14]", 0, 0, "Float16_t");
+   TStreamerElement floatRange("f", "[-20,80,16]", 0, 0, "Float16_t");
+   TStreamerElement doubleNbits("d", "[0,0,14]", 0, 0, "Double32_t");
+   TStreamerElement doubleRange("d", "[-20,80,16]", 0, 0, "Double32_t");
+   ASSERT_EQ(0., floatNbits.GetFactor());
+   ASSERT_NE(0., floatRange.GetFactor());
+
+   for (Int_t n : gSizes) {
+      std::vector<Float_t> f(n), fInRange(n);
+      std::vector<Double_t> d(n), dInRange(n);
+      for (Int_t i = 0; i < n; ++i) {
+         // Exactly representable with 14 mantissa bits
+         f[i] = -17.25f + 0.5f * i;
+         d[i] = 1.5 * i - 20;
+         fInRange[i] = -20.f + 0.09f * i;
+         dInRange[i] = 79.5 - 0.09 * i;
+      }
+
+      TBufferFile wbuf(TBuffer::kWrite);
+      wbuf.WriteFastArrayFloat16(f.data(), n, &floatNbits);
+      wbuf.WriteFastArrayDouble32(d.data(), n, &doubleNbits);
+      wbuf.WriteFastArrayDouble32(d.data(), n);
+      wbuf.WriteFastArrayFloat16(fInRange.data(), n, &floatRange);
+      wbuf.WriteFastArrayDouble32(dInRange.data(), n, &doubleRange);
+
+      TBufferFile rbuf(TBuffer::kRead, wbuf.Length(), wbuf.Buffer(), kFALSE);
+      std::vector<Float_t> fout(n);
+      std::vector<Double_t> dout(n);
+      rbuf.ReadFastArrayFloat16(fout.data(), n, &floatNbits);
+      EXPECT_EQ(f, fout) << "n=" << n;
+      rbuf.ReadFastArrayDouble32(dout.data(), n, &doubleNbits);
+      EXPECT_EQ(d, dout) << "n=" << n;
+      rbuf.ReadFastArrayDouble32(dout.data(), n);
+      EXPECT_EQ(d, dout) << "n=" << n;
+      rbuf.ReadFastArrayFloat16(fout.data(), n, &floatRange);
+      for (Int_t i = 0; i < n; ++i)
+         EXPECT_NEAR(fInRange[i], fout[i], 0.01) << "n=" << n << " i=" << i;
+      rbuf.ReadFastArrayDouble32(dout.data(), n, &doubleRange);
+      for (Int_t i = 0; i < n; ++i)
+         EXPECT_NEAR(dInRange[i], dout[i], 0.01) << "n=" << n << " i=" << i;
+      EXPECT_EQ(wbuf.Length(), rbuf.Length());
+   }
+}
+
+TEST(TBufferFile, FusedMembersRoundTrip)
+{
+   ASSERT_TRUE(gInterpreter->Declare(FUSED_MEMBERS_STR(FUSED_MEMBERS_DECL)));
+   TClass *cl = TClass::GetClass("FusedMembers");
+   ASSERT_NE(nullptr, cl);
+
+   std::vector<FusedMembers> in(3);
+   for (int k = 0; k < 3; ++k) {
+      auto &o = in[k];
+      std::memset(&o, 0, sizeof(o));
+      o.fA = -7 + k;
+      o.fB = 1 << 20;
+      o.fC = 42 * k;
+      for (int i = 0; i < 5; ++i)
+         o.fArr[i] = 0.25f * i - k;
+      o.fD = -1e100;
+      o.fE = 3.5 * k;
+      for (int i = 0; i < 3; ++i)
+         o.fS[i] = -300 + i + k;
+      std::strcpy(o.fName, "fused");
+      o.fFlag = (k % 2);
+   }
+
+   TBufferFile wbuf(TBuffer::kWrite);
+   for (auto &o : in)
+      wbuf.WriteObjectAny(&o, cl);
+
+   TBufferFile rbuf(TBuffer::kRead, wbuf.Length(), wbuf.Buffer(), kFALSE);
+   for (auto &o : in) {
+      auto out = static_cast<FusedMembers *>(rbuf.ReadObjectAny(cl));
+      ASSERT_NE(nullptr, out);
+      EXPECT_EQ(o.fA, out->fA);
+      EXPECT_EQ(o.fB, out->fB);
+      EXPECT_EQ(o.fC, out->fC);
+      EXPECT_EQ(0, std::memcmp(o.fArr, out->fArr, sizeof(o.fArr)));
+      EXPECT_EQ(o.fD, out->fD);
+      EXPECT_EQ(o.fE, out->fE);
+      EXPECT_EQ(0, std::memcmp(o.fS, out->fS, sizeof(o.fS)));
+      EXPECT_STREQ(o.fName, out->fName);
+      EXPECT_EQ(o.fFlag, out->fFlag);
+      cl->Destructor(out);
+   }
+   EXPECT_EQ(wbuf.Length(), rbuf.Length());
+}
@@ -0,0 +1,63 @@
+#include "TBufferJSON.h"
+#include "TList.h"
+#include "TNamed.h"
+#include "TSystem.h"
+
+#include "gtest/gtest.h"
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+// Large enough that the JSON output is flushed several times while the object is converted
+static TList *MakeList()
+{
+   auto list = new TList;
+   list->SetOwner(kTRUE);
+   for (Int_t i = 0; i < 20000; ++i)
+      list->Add(new TNamed(TString::Format("name%d", i), TString::Format("title of item %d", i)));
+   return list;
+}
+
+TEST(TBufferJSON, StreamOutput)
+{
+   std::unique_ptr<TList> list(MakeList());
+
+   for (Int_t compact : {0, TBufferJSON::kNoSpaces + TBufferJSON::kSameSuppression}) {
+      const TString expected = TBufferJSON::ConvertToJSON(list.get(), compact);
+      ASSERT_GT(expected.Length(), 64 * 1024);
+
+      std::ostringstream os;
+      EXPECT_TRUE(TBufferJSON::ExportToStream(os, list.get(), TList::Class(), compact));
+      EXPECT_EQ(std::string(expected.Data()), os.str());
+
+      std::string str;
+      TBufferJSON buf;
+      buf.SetCompact(compact);
+      EXPECT_TRUE(buf.StoreObject(str, list.get(), TList::Class()));
+      EXPECT_EQ(std::string(expected.Data()), str);
+   }
+
+   // Small objects do not reach the flush threshold
+   TNamed named("name", "title");
+   std::ostringstream os;
+   EXPECT_TRUE(TBufferJSON::ExportToStream(os, &named, TNamed::Class()));
+   EXPECT_EQ(std::string(TBufferJSON::ToJSON(&named).Data()), os.str());
+}
+
+TEST(TBufferJSON, ExportToFile)
+{
+   const char *fileName = "TBufferJSONExportToFile.json";
+   std::unique_ptr<TList> list(MakeList());
+
+   const TString expected = TBufferJSON::ConvertToJSON(list.get());
+   EXPECT_EQ(expected.Length(), TBufferJSON::ExportToFile(fileName, list.get()));
+
+   std::ifstream ifs(fileName);
+   std::stringstream content;
+   content << ifs.rdbuf();
+   EXPECT_EQ(std::string(expected.Data()), content.str());
+
+   gSystem->Unlink(fileName);
+}
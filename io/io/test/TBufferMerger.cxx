@@ -178,6 +178,63 @@ TEST(TBufferMerger, AutoSave)
    RemoveFile("tbuffermerger_autosave.root");
 }
 
+TEST(TBufferMerger, QueueLimit)
+{
+   int nthreads = 8;
+   int nwrites = 16;
+   int events_per_write = 512;
+
+   ROOT::EnableThreadSafety();
+
+   {
+      TBufferMerger merger("tbuffermerger_queuelimit.root");
+
+      merger.SetAutoSave(1024 * 1024 * 1024);
+      merger.SetQueueLimit(1);
+      EXPECT_EQ(1u, merger.GetQueueLimit());
+
+      std::vector<std::thread> threads;
+      for (int i = 0; i < nthreads; ++i) {
+         threads.emplace_back([=, &merger]() {
+            auto myfile = merger.GetFile();
+            auto mytree = new TTree("mytree", "mytree");
+            mytree->ResetBit(kMustCleanup);
+
+            int n = 0;
+            mytree->Branch("n", &n, "n/I");
+            for (int w = 0; w < nwrites; ++w) {
+               for (int j = 0; j < events_per_write; ++j) {
+                  n = 1;
+                  mytree->Fill();
+               }
+               myfile->Write();
+            }
+            mytree->ResetBranchAddresses();
+         });
+      }
+
+      for (auto &&t : threads)
+         t.join();
+
+      // Every write exceeds the limit, so it either merges the queue or waits for the merge in progress
+      EXPECT_EQ(0u, merger.GetQueueSize());
+      EXPECT_LE(merger.GetPeakQueueSize(), size_t(nthreads));
+      EXPECT_GT(merger.GetNMerges(), 0u);
+      EXPECT_GT(merger.GetMergeTime(), 0.);
+      EXPECT_GE(merger.GetMergeTime(), merger.GetMaxMergeTime());
+      EXPECT_GE(merger.GetWaitTime(), 0.);
+   }
+
+   {
+      TFile f("tbuffermerger_queuelimit.root");
+      auto t = f.Get<TTree>("mytree");
+      ASSERT_TRUE(t != nullptr);
+      EXPECT_EQ(nthreads * nwrites * events_per_write, t->GetEntries());
+   }
+
+   RemoveFile("tbuffermerger_queuelimit.root");
+}
+
 TEST(TBufferMerger, CheckTreeFillResults)
 {
    int sum_s, sum_p;
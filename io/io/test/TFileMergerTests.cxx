@@ -2,9 +2,14 @@
 
 #include "TFileMerger.h"
 
+#include "TH1F.h"
 #include "TMemFile.h"
 #include "TTree.h"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 static void CreateATuple(TMemFile &file, const char *name, double value)
 {
    auto mytree = new TTree(name, "A tree");
@@ -68,3 +73,34 @@ TEST(TFileMerger, CreateWithUnwritableTFilePointer)
    ROOT_EXPECT_ERROR(merger.OutputFile(std::move(output)), "TFileMerger::OutputFile",
                      "output file output.root is not writable");
 }
+
+TEST(TFileMerger, MergeBatchSize)
+{
+   std::vector<std::unique_ptr<TMemFile>> inputs;
+   for (int i = 0; i < 5; ++i) {
+      inputs.emplace_back(new TMemFile(("batch" + std::to_string(i) + ".root").c_str(), "RECREATE"));
+      auto dir = inputs.back()->mkdir("dir");
+      TH1F h("h", "h", 10, 0, 10);
+      for (int j = 0; j <= i; ++j)
+         h.Fill(j);
+      dir->WriteTObject(&h);
+      inputs.back()->WriteTObject(&h);
+   }
+
+   TFileMerger merger(kFALSE, kTRUE);
+   merger.SetMergeBatchSize(2);
+   EXPECT_EQ(2, merger.GetMergeBatchSize());
+   ASSERT_TRUE(merger.OutputFile(std::unique_ptr<TMemFile>(new TMemFile("batchout.root", "CREATE"))));
+   for (auto &input : inputs)
+      merger.AddFile(input.get(), false);
+   ASSERT_TRUE(merger.PartialMerge());
+
+   auto output = merger.GetOutputFile();
+   for (auto name : {"h", "dir/h"}) {
+      auto h = output->Get<TH1F>(name);
+      ASSERT_TRUE(h != nullptr) << name;
+      EXPECT_EQ(15, h->GetEntries());
+      EXPECT_EQ(5, h->GetBinContent(1));
+      EXPECT_EQ(1, h->GetBinContent(5));
+   }
+}
@@ -1,4 +1,8 @@
 #include "TFile.h"
+#include "TFileCacheWrite.h"
+#include "TKey.h"
+#include "TNamed.h"
+#include "TSystem.h"
 
 #include "gtest/gtest.h"
 
@@ -21,4 +25,105 @@ TEST(TFile, ReadFromSameFile)
    auto o2 = f2.Get(objpath);
 
    EXPECT_TRUE(o1 != o2) << "Same objects read from two different files have the same pointer!";
-}
\ No newline at end of file
+}
+
+TEST(TFile, GetKeyCycles)
+{
+   const auto filename = "GetKeyCycles.root";
+   const int nobjs = 5000;
+   {
+      TFile f(filename, "RECREATE");
+      for (int i = 0; i < nobjs; ++i) {
+         TNamed obj(TString::Format("obj%d", i).Data(), "1");
+         f.WriteTObject(&obj);
+         if (i % 100 == 0) {
+            obj.SetTitle("2");
+            f.WriteTObject(&obj);
+         }
+      }
+   }
+
+   TFile f(filename);
+   EXPECT_EQ(nobjs + nobjs / 100, f.GetNkeys());
+   for (int i = 0; i < nobjs; i += 7) {
+      const TString name = TString::Format("obj%d", i);
+      auto obj = f.Get<TNamed>(name);
+      ASSERT_TRUE(obj != nullptr) << name;
+      EXPECT_STREQ(i % 100 == 0 ? "2" : "1", obj->GetTitle()) << name;
+   }
+   auto first = f.Get<TNamed>("obj100;1");
+   ASSERT_TRUE(first != nullptr);
+   EXPECT_STREQ("1", first->GetTitle());
+   auto second = static_cast<TNamed *>(f.Get("obj100;2"));
+   ASSERT_TRUE(second != nullptr);
+   EXPECT_STREQ("2", second->GetTitle());
+   EXPECT_EQ(nullptr, f.Get("obj101;2"));
+   EXPECT_EQ(nullptr, f.Get("missing"));
+   ASSERT_TRUE(f.FindKeyAny("obj4999") != nullptr);
+   EXPECT_EQ(1, f.FindKeyAny("obj4999")->GetCycle());
+
+   gSystem->Unlink(filename);
+}
+
+TEST(TFile, ReadStreamerInfoLazy)
+{
+   const auto filename = "ReadStreamerInfoLazy.root";
+   {
+      TFile f(filename, "RECREATE");
+      TNamed named("named", "title");
+      f.WriteTObject(&named);
+   }
+
+   TFile::SetReadStreamerInfoLazy(kTRUE);
+   {
+      TFile f(filename);
+      auto named = f.Get<TNamed>("named");
+      ASSERT_NE(nullptr, named);
+      EXPECT_STREQ("title", named->GetTitle());
+   }
+   {
+      // Switching to update mode processes the StreamerInfos that were not needed yet
+      TFile f(filename);
+      EXPECT_EQ(0, f.ReOpen("UPDATE"));
+      TNamed other("other", "other title");
+      f.WriteTObject(&other);
+   }
+   {
+      TFile f(filename);
+      auto other = f.Get<TNamed>("other");
+      ASSERT_NE(nullptr, other);
+      EXPECT_STREQ("other title", other->GetTitle());
+   }
+   TFile::SetReadStreamerInfoLazy(kFALSE);
+
+   gSystem->Unlink(filename);
+}
+
+TEST(TFile, AsyncWriteCache)
+{
+   const auto filename = "AsyncWriteCache.root";
+   const int nobjects = 200;
+   {
+      TFile f(filename, "RECREATE");
+      auto cache = new TFileCacheWrite(&f, 64000);
+      ASSERT_TRUE(cache->SetAsync(kTRUE, TFileCacheWrite::kSyncEachBuffer));
+      EXPECT_TRUE(cache->IsAsync());
+      for (int i = 0; i < nobjects; ++i) {
+         TNamed named(TString::Format("named%d", i), TString(char('a' + i % 26), 1000 + i));
+         f.WriteTObject(&named);
+      }
+      // Read back while some of the data is still being written
+      auto named = f.Get<TNamed>("named7");
+      ASSERT_NE(nullptr, named);
+      EXPECT_EQ(TString('h', 1007), named->GetTitle());
+   }
+   {
+      TFile f(filename);
+      for (int i = 0; i < nobjects; ++i) {
+         auto named = f.Get<TNamed>(TString::Format("named%d", i));
+         ASSERT_NE(nullptr, named);
+         EXPECT_EQ(TString(char('a' + i % 26), 1000 + i), named->GetTitle());
+      }
+   }
+   gSystem->Unlink(filename);
+}
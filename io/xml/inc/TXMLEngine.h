@@ -18,6 +18,8 @@ typedef void *XMLNodePointer_t;
 typedef void *XMLNsPointer_t;
 typedef void *XMLAttrPointer_t;
 typedef void *XMLDocPointer_t;
+typedef void *XMLReaderPointer_t;
+typedef void *XMLWriterPointer_t;
 
 class TXMLInputStream;
 class TXMLOutputStream;
@@ -34,14 +36,31 @@ protected:
    void TruncateNsExtension(XMLNodePointer_t xmlnode);
    void UnpackSpecialCharacters(char *target, const char *source, int srclen);
    void OutputValue(char *value, TXMLOutputStream *out);
+   void SaveNodeStart(XMLNodePointer_t xmlnode, TXMLOutputStream *out);
+   void SaveNodeEnd(XMLNodePointer_t xmlnode, TXMLOutputStream *out);
    void SaveNode(XMLNodePointer_t xmlnode, TXMLOutputStream *out, Int_t layout, Int_t level);
-   XMLNodePointer_t ReadNode(XMLNodePointer_t xmlparent, TXMLInputStream *inp, Int_t &resvalue);
+   XMLNodePointer_t ReadNode(XMLNodePointer_t xmlparent, TXMLInputStream *inp, Int_t &resvalue, Bool_t readchilds = kTRUE);
    void DisplayError(Int_t error, Int_t linenumber);
    XMLDocPointer_t ParseStream(TXMLInputStream *input);
+   XMLReaderPointer_t NewStreamReader(TXMLInputStream *input);
+   Int_t FillReaderEvents(XMLReaderPointer_t xmlreader);
+   void AddReaderEvents(XMLReaderPointer_t xmlreader, XMLNodePointer_t xmlnode, Int_t depth, Bool_t owner);
+   void WriterBeginChild(XMLWriterPointer_t xmlwriter);
 
    Bool_t fSkipComments; //! if true, do not create comments nodes in document during parsing
 
 public:
+   /// Events returned by ReadNext() while reading a document with a reader
+   enum EXMLReaderEvent {
+      kXMLReadError = -1,   ///< syntax error, the reader cannot continue
+      kXMLEndDocument = 0,  ///< end of the document is reached
+      kXMLStartElement = 1, ///< start of an element with its attributes, followed by the events of its children
+      kXMLEndElement = 2,   ///< end of an element
+      kXMLContent = 3,      ///< content of an element
+      kXMLComment = 4,      ///< comment
+      kXMLInstruction = 5   ///< processing instruction like <?xml version="1.0"?>
+   };
+
    TXMLEngine();
    virtual ~TXMLEngine();
 
@@ -105,6 +124,21 @@ public:
    void SaveSingleNode(XMLNodePointer_t xmlnode, TString *res, Int_t layout = 1);
    XMLNodePointer_t ReadSingleNode(const char *src);
 
+   XMLReaderPointer_t NewReader(const char *filename, Int_t maxbuf = 100000);
+   XMLReaderPointer_t NewStringReader(const char *xmlstring);
+   Int_t ReadNext(XMLReaderPointer_t xmlreader);
+   XMLNodePointer_t GetReaderNode(XMLReaderPointer_t xmlreader);
+   Int_t GetReaderDepth(XMLReaderPointer_t xmlreader);
+   XMLNodePointer_t ReadSubtree(XMLReaderPointer_t xmlreader);
+   void FreeReader(XMLReaderPointer_t xmlreader);
+
+   XMLWriterPointer_t NewWriter(const char *filename, Int_t layout = 1, const char *version = "1.0");
+   void WriteStartNode(XMLWriterPointer_t xmlwriter, XMLNodePointer_t xmlnode);
+   void WriteNode(XMLWriterPointer_t xmlwriter, XMLNodePointer_t xmlnode);
+   void WriteContent(XMLWriterPointer_t xmlwriter, const char *content);
+   void WriteEndNode(XMLWriterPointer_t xmlwriter);
+   void FreeWriter(XMLWriterPointer_t xmlwriter);
+
    ClassDef(TXMLEngine, 1); // ROOT XML I/O parser, user by TXMLFile to read/write xml files
 };
 
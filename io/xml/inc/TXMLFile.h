@@ -121,7 +121,7 @@ protected:
    Int_t ReadKeysList(TDirectory *dir, XMLNodePointer_t topnode);
    TKeyXML *FindDirKey(TDirectory *dir);
    TDirectory *FindKeyDir(TDirectory *mother, Long64_t keyid);
-   void CombineNodesTree(TDirectory *dir, XMLNodePointer_t topnode, Bool_t dolink);
+   void WriteKeysNodes(TDirectory *dir, XMLWriterPointer_t writer);
 
    void SaveToFile();
 
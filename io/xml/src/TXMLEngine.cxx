@@ -16,6 +16,10 @@
 //  as parser for arbitrary XML files. For such cases TXMLParser should
 //  be used. This class was introduced to exclude dependency from
 //  external libraries (like libxml2) and improve speed / memory consumption.
+//  Large documents can be read node after node with a reader (NewReader(),
+//  ReadNext(), ReadSubtree()) and written with a writer (NewWriter(),
+//  WriteStartNode(), WriteNode(), WriteEndNode()) without keeping the
+//  complete document in memory.
 //
 //________________________________________________________________________
 
@@ -30,6 +34,9 @@
 #include <fstream>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
 
 ClassImp(TXMLEngine);
 
@@ -67,6 +74,35 @@ struct SXmlDoc_t {
    char *fDtdRoot;
 };
 
+struct SXmlReaderEvent_t {
+   Int_t fEvent;       // kind of event, see TXMLEngine::EXMLReaderEvent
+   SXmlNode_t *fNode;  // node of the event
+   Int_t fDepth;       // depth of the node, 1 for the root element
+   Bool_t fOwner;      // node has to be released after this event
+};
+
+struct SXmlReader_t {
+   TXMLInputStream *fInp;                 // input stream
+   XMLDocPointer_t fDoc;                  // document, which top node is the parent of the nodes on the first level
+   std::vector<SXmlNode_t *> fOpen;       // elements which start tag was read, while the end tag is still in the stream
+   std::deque<SXmlReaderEvent_t> fEvents; // events of the nodes which were read but not yet delivered
+   std::vector<SXmlNode_t *> fRelease;    // nodes to be released with the next event
+   SXmlNode_t *fNode;                     // node of the current event
+   Int_t fEvent;                          // kind of the current event
+   Int_t fDepth;                          // depth of the current node
+   Bool_t fFinished;                      // end of the stream or error is reached
+};
+
+struct SXmlWriter_t {
+   TXMLOutputStream *fOut;         // output stream
+   Int_t fLayout;                  // layout, see SaveDoc
+   std::vector<std::string> fOpen; // end tags of the open elements
+   TString fTag;                   // start tag of the innermost open element, not yet written
+   Bool_t fTagPending;             // start tag is not yet written
+   TString fContent;               // first content of the innermost open element, not yet written
+   Bool_t fContentPending;         // content is not yet written
+};
+
 class TXMLOutputStream {
 protected:
    std::ostream *fOut;
@@ -131,7 +167,10 @@ public:
       int len = strlen(str);
       if (fCurrent + len >= fMaxAddr) {
          OutputCurrent();
-         fOut->write(str, len);
+         if (fOut != 0)
+            fOut->write(str, len);
+         else if (fOutStr != 0)
+            fOutStr->Append(str, len);
       } else {
          while (*str)
             *fCurrent++ = *str++;
@@ -1477,6 +1516,491 @@ XMLNodePointer_t TXMLEngine::ReadSingleNode(const char *src)
    return xmlnode;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Creates reader of the xml file, which delivers the nodes of the document
+/// one after another with ReadNext() instead of building the complete
+/// document in memory. This allows to process large files with little memory.
+/// The maxbuf argument specifies the initial size of the input buffer.
+/// Reader should be released with FreeReader()
+
+XMLReaderPointer_t TXMLEngine::NewReader(const char *filename, Int_t maxbuf)
+{
+   if ((filename == 0) || (strlen(filename) == 0))
+      return 0;
+   if (maxbuf < 100000)
+      maxbuf = 100000;
+   return NewStreamReader(new TXMLInputStream(true, filename, maxbuf));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Creates reader of the xml document provided as string, see NewReader()
+/// The string should exist as long as the reader is used.
+
+XMLReaderPointer_t TXMLEngine::NewStringReader(const char *xmlstring)
+{
+   if ((xmlstring == 0) || (strlen(xmlstring) == 0))
+      return 0;
+   return NewStreamReader(new TXMLInputStream(false, xmlstring, 100000));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// creates reader for the input stream, which is owned by the reader
+
+XMLReaderPointer_t TXMLEngine::NewStreamReader(TXMLInputStream *inp)
+{
+   SXmlReader_t *reader = new SXmlReader_t;
+   reader->fInp = inp;
+   reader->fDoc = NewDoc(0);
+   reader->fNode = 0;
+   reader->fEvent = kXMLEndDocument;
+   reader->fDepth = 0;
+   reader->fFinished = kFALSE;
+   return (XMLReaderPointer_t)reader;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reads next node of the document and returns its kind, see EXMLReaderEvent.
+/// The node itself is accessible with GetReaderNode() until the next call of
+/// ReadNext(). For a kXMLStartElement event the node provides its name and
+/// attributes, while its children follow as separate events up to the
+/// kXMLEndElement event of the node. For content, comment and processing
+/// instruction the text is returned by GetNodeName().
+/// Namespace extensions are removed from the names of the elements.
+/// Returns kXMLEndDocument at the end of the document and kXMLReadError if
+/// the document is not valid.
+
+Int_t TXMLEngine::ReadNext(XMLReaderPointer_t xmlreader)
+{
+   if (xmlreader == 0)
+      return kXMLReadError;
+
+   SXmlReader_t *reader = (SXmlReader_t *)xmlreader;
+
+   // release nodes delivered with the previous event
+   for (auto node : reader->fRelease)
+      FreeNode((XMLNodePointer_t)node);
+   reader->fRelease.clear();
+   reader->fNode = 0;
+   reader->fDepth = 0;
+   reader->fEvent = kXMLReadError;
+
+   while (reader->fEvents.empty() && !reader->fFinished) {
+      Int_t res = FillReaderEvents(xmlreader);
+      if (res < 0) {
+         reader->fFinished = kTRUE;
+         return kXMLReadError;
+      }
+   }
+
+   if (reader->fEvents.empty()) {
+      if (reader->fOpen.empty())
+         reader->fEvent = kXMLEndDocument;
+      return reader->fEvent;
+   }
+
+   SXmlReaderEvent_t event = reader->fEvents.front();
+   reader->fEvents.pop_front();
+
+   reader->fNode = event.fNode;
+   reader->fEvent = event.fEvent;
+   reader->fDepth = event.fDepth;
+   if (event.fOwner)
+      reader->fRelease.push_back(event.fNode);
+
+   return event.fEvent;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// returns node of the last event of the reader
+
+XMLNodePointer_t TXMLEngine::GetReaderNode(XMLReaderPointer_t xmlreader)
+{
+   return xmlreader == 0 ? 0 : (XMLNodePointer_t)((SXmlReader_t *)xmlreader)->fNode;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// returns depth of the node of the last event, 1 for the root element
+
+Int_t TXMLEngine::GetReaderDepth(XMLReaderPointer_t xmlreader)
+{
+   return xmlreader == 0 ? 0 : ((SXmlReader_t *)xmlreader)->fDepth;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reads the node of the last event together with all its children,
+/// which are not delivered as events anymore. For a kXMLStartElement event
+/// this includes the end of the element, so that the next event is the one
+/// following the element. The node is unlinked from its parent and
+/// has to be released by the user with FreeNode().
+/// This allows to process the parts of a large document separately with the
+/// usual node-based methods, keeping in memory one part at a time.
+
+XMLNodePointer_t TXMLEngine::ReadSubtree(XMLReaderPointer_t xmlreader)
+{
+   if (xmlreader == 0)
+      return 0;
+
+   SXmlReader_t *reader = (SXmlReader_t *)xmlreader;
+   SXmlNode_t *node = reader->fNode;
+   if ((node == 0) || (reader->fEvent == kXMLEndElement))
+      return 0;
+
+   reader->fNode = 0;
+
+   if (!reader->fOpen.empty() && (reader->fOpen.back() == node)) {
+      // start tag of the element was read, read now its children from the stream
+      reader->fOpen.pop_back();
+      Int_t resvalue = 0;
+      do {
+         ReadNode((XMLNodePointer_t)node, reader->fInp, resvalue);
+      } while (resvalue == 2);
+      node->fParent = 0;
+      if (resvalue != 1) {
+         DisplayError(resvalue, reader->fInp->CurrentLine());
+         reader->fFinished = kTRUE;
+         FreeNode((XMLNodePointer_t)node);
+         return 0;
+      }
+      return (XMLNodePointer_t)node;
+   }
+
+   // the node was read completely before, drop the events of its children
+   if (node->fType == kXML_NODE) {
+      while (!reader->fEvents.empty()) {
+         SXmlReaderEvent_t event = reader->fEvents.front();
+         reader->fEvents.pop_front();
+         if ((event.fNode == node) && (event.fEvent == kXMLEndElement))
+            break;
+      }
+   }
+
+   // parent of the node is either still open or the top node of the document, when
+   // the node was read as a whole, otherwise it is part of the children of the parent
+   SXmlNode_t *parent = node->fParent;
+   Bool_t isfirst = (parent == ((SXmlDoc_t *)reader->fDoc)->fRootNode);
+   for (auto open : reader->fOpen)
+      if (open == parent)
+         isfirst = kTRUE;
+
+   if (isfirst) {
+      node->fParent = 0;
+      node->fNext = 0;
+      for (auto iter = reader->fRelease.begin(); iter != reader->fRelease.end(); ++iter)
+         if (*iter == node) {
+            reader->fRelease.erase(iter);
+            break;
+         }
+   } else {
+      UnlinkNode((XMLNodePointer_t)node);
+   }
+
+   return (XMLNodePointer_t)node;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// release reader and all nodes which are not yet delivered
+
+void TXMLEngine::FreeReader(XMLReaderPointer_t xmlreader)
+{
+   if (xmlreader == 0)
+      return;
+
+   SXmlReader_t *reader = (SXmlReader_t *)xmlreader;
+
+   for (auto node : reader->fRelease)
+      FreeNode((XMLNodePointer_t)node);
+
+   for (auto &event : reader->fEvents)
+      if (event.fOwner)
+         FreeNode((XMLNodePointer_t)event.fNode);
+
+   for (auto node : reader->fOpen)
+      FreeNode((XMLNodePointer_t)node);
+
+   FreeDoc(reader->fDoc);
+   delete reader->fInp;
+   delete reader;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reads next portion of the stream into the events of the reader.
+/// Elements are read up to the end of their start tag, while other nodes
+/// (and elements included from external entities) are read completely.
+/// Returns negative value in case of error
+
+Int_t TXMLEngine::FillReaderEvents(XMLReaderPointer_t xmlreader)
+{
+   SXmlReader_t *reader = (SXmlReader_t *)xmlreader;
+   TXMLInputStream *inp = reader->fInp;
+
+   SXmlNode_t *parent = reader->fOpen.empty() ? ((SXmlDoc_t *)reader->fDoc)->fRootNode : reader->fOpen.back();
+
+   if (reader->fOpen.empty()) {
+      // same as in ParseStream, nodes on the first level may be followed by end of the stream
+      if (!inp->EndOfStream())
+         inp->SkipSpaces();
+      if (inp->EndOfStream()) {
+         reader->fFinished = kTRUE;
+         return 0;
+      }
+   }
+
+   Int_t resvalue = 0;
+   XMLNodePointer_t xmlnode = ReadNode((XMLNodePointer_t)parent, inp, resvalue, kFALSE);
+
+   if (resvalue == 1) {
+      // end of the open element, which is released after its event
+      reader->fOpen.pop_back();
+      reader->fEvents.push_back({kXMLEndElement, parent, (Int_t)reader->fOpen.size() + 1, kTRUE});
+      return 1;
+   }
+
+   if ((resvalue != 2) && (resvalue != 3)) {
+      // nodes created so far are children of the parent and released with it
+      DisplayError(resvalue, inp->CurrentLine());
+      return resvalue < 0 ? resvalue : -1;
+   }
+
+   // take over all nodes created as children of the parent, which can be more
+   // than one when content with entities was read
+   SXmlNode_t *child = parent->fChild;
+   parent->fChild = 0;
+   parent->fLastChild = 0;
+
+   Int_t depth = reader->fOpen.size() + 1;
+
+   while (child != 0) {
+      SXmlNode_t *next = child->fNext;
+      child->fNext = 0;
+      if ((resvalue == 3) && (child == (SXmlNode_t *)xmlnode)) {
+         // children of the element are read later, names of the children are compared
+         // with the name of the element without namespace extension, see ReadNode
+         if (child->fNs != 0)
+            TruncateNsExtension((XMLNodePointer_t)child);
+         reader->fOpen.push_back(child);
+         reader->fEvents.push_back({kXMLStartElement, child, depth, kFALSE});
+      } else {
+         AddReaderEvents(xmlreader, (XMLNodePointer_t)child, depth, kTRUE);
+      }
+      child = next;
+   }
+
+   return resvalue;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// add events of the node, which was read completely, and of all its children
+
+void TXMLEngine::AddReaderEvents(XMLReaderPointer_t xmlreader, XMLNodePointer_t xmlnode, Int_t depth, Bool_t owner)
+{
+   SXmlReader_t *reader = (SXmlReader_t *)xmlreader;
+   SXmlNode_t *node = (SXmlNode_t *)xmlnode;
+
+   switch (node->fType) {
+   case kXML_NODE:
+      reader->fEvents.push_back({kXMLStartElement, node, depth, kFALSE});
+      for (SXmlNode_t *child = node->fChild; child != 0; child = child->fNext)
+         AddReaderEvents(xmlreader, (XMLNodePointer_t)child, depth + 1, kFALSE);
+      reader->fEvents.push_back({kXMLEndElement, node, depth, owner});
+      break;
+   case kXML_CONTENT: reader->fEvents.push_back({kXMLContent, node, depth, owner}); break;
+   case kXML_COMMENT: reader->fEvents.push_back({kXMLComment, node, depth, owner}); break;
+   case kXML_PI_NODE: reader->fEvents.push_back({kXMLInstruction, node, depth, owner}); break;
+   default:
+      if (owner)
+         FreeNode(xmlnode);
+      break;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Creates writer of the xml file, which writes the nodes as they are
+/// provided instead of building the complete document in memory first.
+/// Elements are opened with WriteStartNode(), filled with WriteNode() or
+/// WriteContent() and closed with WriteEndNode(). The file has the same
+/// layout as written by SaveDoc(), see its description for the meaning of
+/// the layout argument. If version is specified, the file starts with
+/// the <?xml version="..."?> processing instruction.
+/// Writer should be released with FreeWriter()
+
+XMLWriterPointer_t TXMLEngine::NewWriter(const char *filename, Int_t layout, const char *version)
+{
+   if ((filename == 0) || (strlen(filename) == 0))
+      return 0;
+
+   SXmlWriter_t *writer = new SXmlWriter_t;
+   writer->fOut = new TXMLOutputStream(filename, 100000);
+   writer->fLayout = layout;
+   writer->fTagPending = kFALSE;
+   writer->fContentPending = kFALSE;
+
+   if (version != 0) {
+      XMLNodePointer_t vernode = NewChild(0, 0, "xml");
+      ((SXmlNode_t *)vernode)->fType = kXML_PI_NODE;
+      NewAttr(vernode, 0, "version", version);
+      WriteNode((XMLWriterPointer_t)writer, vernode);
+      FreeNode(vernode);
+   }
+
+   return (XMLWriterPointer_t)writer;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Opens element with the name, namespace and attributes of the xmlnode.
+/// Children of the xmlnode are not written, the node can be released
+/// immediately after the call.
+
+void TXMLEngine::WriteStartNode(XMLWriterPointer_t xmlwriter, XMLNodePointer_t xmlnode)
+{
+   if ((xmlwriter == 0) || (xmlnode == 0))
+      return;
+
+   if (((SXmlNode_t *)xmlnode)->fType != kXML_NODE) {
+      WriteNode(xmlwriter, xmlnode);
+      return;
+   }
+
+   SXmlWriter_t *writer = (SXmlWriter_t *)xmlwriter;
+
+   WriterBeginChild(xmlwriter);
+
+   writer->fTag.Clear();
+   TString endtag;
+   {
+      TXMLOutputStream out(&writer->fTag, 1000);
+      if (writer->fLayout > 0)
+         out.Put(' ', 2 * writer->fOpen.size());
+      SaveNodeStart(xmlnode, &out);
+      TXMLOutputStream endout(&endtag, 1000);
+      SaveNodeEnd(xmlnode, &endout);
+   }
+   writer->fOpen.emplace_back(endtag.Data());
+   writer->fTagPending = kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Writes xmlnode with all its children in the currently open element
+
+void TXMLEngine::WriteNode(XMLWriterPointer_t xmlwriter, XMLNodePointer_t xmlnode)
+{
+   if ((xmlwriter == 0) || (xmlnode == 0))
+      return;
+
+   if (((SXmlNode_t *)xmlnode)->fType == kXML_CONTENT) {
+      WriteContent(xmlwriter, SXmlNode_t::Name(xmlnode));
+      return;
+   }
+
+   SXmlWriter_t *writer = (SXmlWriter_t *)xmlwriter;
+
+   WriterBeginChild(xmlwriter);
+   SaveNode(xmlnode, writer->fOut, writer->fLayout, 2 * writer->fOpen.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Writes content in the currently open element
+
+void TXMLEngine::WriteContent(XMLWriterPointer_t xmlwriter, const char *content)
+{
+   if ((xmlwriter == 0) || (content == 0))
+      return;
+
+   SXmlWriter_t *writer = (SXmlWriter_t *)xmlwriter;
+
+   // single content is written in the same line as the element, see SaveNode
+   if (writer->fTagPending && !writer->fContentPending) {
+      writer->fContent = content;
+      writer->fContentPending = kTRUE;
+      return;
+   }
+
+   WriterBeginChild(xmlwriter);
+
+   if (writer->fLayout > 0)
+      writer->fOut->Put(' ', 2 * writer->fOpen.size());
+   writer->fOut->Write(content);
+   if (writer->fLayout > 0)
+      writer->fOut->Put('\n');
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Closes the element opened last with WriteStartNode()
+
+void TXMLEngine::WriteEndNode(XMLWriterPointer_t xmlwriter)
+{
+   SXmlWriter_t *writer = (SXmlWriter_t *)xmlwriter;
+   if ((writer == 0) || writer->fOpen.empty())
+      return;
+
+   TXMLOutputStream *out = writer->fOut;
+
+   if (writer->fTagPending) {
+      out->Write(writer->fTag.Data());
+      if (writer->fContentPending) {
+         out->Put('>');
+         out->Write(writer->fContent.Data());
+         out->Write(writer->fOpen.back().c_str());
+      } else {
+         out->Write("/>");
+      }
+      writer->fTagPending = kFALSE;
+      writer->fContentPending = kFALSE;
+   } else {
+      if (writer->fLayout > 0)
+         out->Put(' ', 2 * (writer->fOpen.size() - 1));
+      out->Write(writer->fOpen.back().c_str());
+   }
+   if (writer->fLayout > 0)
+      out->Put('\n');
+
+   writer->fOpen.pop_back();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Closes all open elements, flushes the output and releases the writer
+
+void TXMLEngine::FreeWriter(XMLWriterPointer_t xmlwriter)
+{
+   if (xmlwriter == 0)
+      return;
+
+   SXmlWriter_t *writer = (SXmlWriter_t *)xmlwriter;
+
+   while (!writer->fOpen.empty())
+      WriteEndNode(xmlwriter);
+
+   delete writer->fOut;
+   delete writer;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// writes pending start tag and content of the innermost open element
+/// before a new child is written
+
+void TXMLEngine::WriterBeginChild(XMLWriterPointer_t xmlwriter)
+{
+   SXmlWriter_t *writer = (SXmlWriter_t *)xmlwriter;
+   if (!writer->fTagPending)
+      return;
+
+   TXMLOutputStream *out = writer->fOut;
+
+   out->Write(writer->fTag.Data());
+   out->Put('>');
+   if (writer->fLayout > 0)
+      out->Put('\n');
+   writer->fTagPending = kFALSE;
+
+   if (writer->fContentPending) {
+      if (writer->fLayout > 0)
+         out->Put(' ', 2 * writer->fOpen.size());
+      out->Write(writer->fContent.Data());
+      if (writer->fLayout > 0)
+         out->Put('\n');
+      writer->fContentPending = kFALSE;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// creates char* variable with copy of provided string
 
@@ -1664,6 +2188,54 @@ void TXMLEngine::OutputValue(char *value, TXMLOutputStream *out)
       out->Write(last);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// stream start tag of xmlnode with its attributes to output, without closing '>'
+
+void TXMLEngine::SaveNodeStart(XMLNodePointer_t xmlnode, TXMLOutputStream *out)
+{
+   SXmlNode_t *node = (SXmlNode_t *)xmlnode;
+
+   out->Put('<');
+   if (node->fType == kXML_PI_NODE)
+      out->Put('?');
+
+   // we suppose that ns is always first attribute
+   if ((node->fNs != 0) && (node->fNs != node->fAttr)) {
+      out->Write(SXmlAttr_t::Name(node->fNs) + 6);
+      out->Put(':');
+   }
+   out->Write(SXmlNode_t::Name(node));
+
+   SXmlAttr_t *attr = node->fAttr;
+   while (attr != 0) {
+      out->Put(' ');
+      char *attrname = SXmlAttr_t::Name(attr);
+      out->Write(attrname);
+      out->Write("=\"");
+      attrname += strlen(attrname) + 1;
+      OutputValue(attrname, out);
+      out->Put('\"');
+      attr = attr->fNext;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// stream end tag of xmlnode to output
+
+void TXMLEngine::SaveNodeEnd(XMLNodePointer_t xmlnode, TXMLOutputStream *out)
+{
+   SXmlNode_t *node = (SXmlNode_t *)xmlnode;
+
+   out->Write("</");
+   // we suppose that ns is always first attribute
+   if ((node->fNs != 0) && (node->fNs != node->fAttr)) {
+      out->Write(SXmlAttr_t::Name(node->fNs) + 6);
+      out->Put(':');
+   }
+   out->Write(SXmlNode_t::Name(node));
+   out->Put('>');
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// stream data of xmlnode to output
 
@@ -1697,28 +2269,7 @@ void TXMLEngine::SaveNode(XMLNodePointer_t xmlnode, TXMLOutputStream *out, Int_t
       return;
    }
 
-   out->Put('<');
-   if (node->fType == kXML_PI_NODE)
-      out->Put('?');
-
-   // we suppose that ns is always first attribute
-   if ((node->fNs != 0) && (node->fNs != node->fAttr)) {
-      out->Write(SXmlAttr_t::Name(node->fNs) + 6);
-      out->Put(':');
-   }
-   out->Write(SXmlNode_t::Name(node));
-
-   SXmlAttr_t *attr = node->fAttr;
-   while (attr != 0) {
-      out->Put(' ');
-      char *attrname = SXmlAttr_t::Name(attr);
-      out->Write(attrname);
-      out->Write("=\"");
-      attrname += strlen(attrname) + 1;
-      OutputValue(attrname, out);
-      out->Put('\"');
-      attr = attr->fNext;
-   }
+   SaveNodeStart(xmlnode, out);
 
    // if single line, close node with "/>" and return
    if (issingleline) {
@@ -1750,14 +2301,7 @@ void TXMLEngine::SaveNode(XMLNodePointer_t xmlnode, TXMLOutputStream *out, Int_t
          out->Put(' ', level);
    }
 
-   out->Write("</");
-   // we suppose that ns is always first attribute
-   if ((node->fNs != 0) && (node->fNs != node->fAttr)) {
-      out->Write(SXmlAttr_t::Name(node->fNs) + 6);
-      out->Put(':');
-   }
-   out->Write(SXmlNode_t::Name(node));
-   out->Put('>');
+   SaveNodeEnd(xmlnode, out);
    if (layout > 0)
       out->Put('\n');
 }
@@ -1768,8 +2312,10 @@ void TXMLEngine::SaveNode(XMLNodePointer_t xmlnode, TXMLOutputStream *out, Int_t
 /// resvalue <= 0 if error
 /// resvalue == 1 if this is endnode of parent
 /// resvalue == 2 if this is child
+/// resvalue == 3 if this is child, which start tag was read while its
+///               children are not read (only when readchilds is false)
 
-XMLNodePointer_t TXMLEngine::ReadNode(XMLNodePointer_t xmlparent, TXMLInputStream *inp, Int_t &resvalue)
+XMLNodePointer_t TXMLEngine::ReadNode(XMLNodePointer_t xmlparent, TXMLInputStream *inp, Int_t &resvalue, Bool_t readchilds)
 {
    resvalue = 0;
 
@@ -1875,6 +2421,8 @@ XMLNodePointer_t TXMLEngine::ReadNode(XMLNodePointer_t xmlparent, TXMLInputStrea
                   UnlinkNode(currnode);
                   AddChild(xmlparent, currnode);
                }
+
+               FreeDoc(entitydoc);
             } else {
                AddNodeContent(xmlparent, entity->GetTitle());
             }
@@ -1920,7 +2468,18 @@ XMLNodePointer_t TXMLEngine::ReadNode(XMLNodePointer_t xmlparent, TXMLInputStrea
          return 0;
       }
 
-      if (strncmp(SXmlNode_t::Name(parent), inp->fCurrent, len) != 0) {
+      // name of the parent can be already without namespace extension, see NewStreamReader
+      Bool_t truncated = kFALSE;
+      if (parent->fNs != 0) {
+         const char *nsname = SXmlAttr_t::Name(parent->fNs) + 6;
+         Int_t nslen = strlen(nsname);
+         truncated = (len > nslen + 1) && (strncmp(inp->fCurrent, nsname, nslen) == 0) &&
+                     (inp->fCurrent[nslen] == ':') &&
+                     ((Int_t)strlen(SXmlNode_t::Name(parent)) == len - nslen - 1) &&
+                     (strncmp(SXmlNode_t::Name(parent), inp->fCurrent + nslen + 1, len - nslen - 1) == 0);
+      }
+
+      if (!truncated && (strncmp(SXmlNode_t::Name(parent), inp->fCurrent, len) != 0)) {
          resvalue = -5;
          return 0;
       }
@@ -1935,7 +2494,7 @@ XMLNodePointer_t TXMLEngine::ReadNode(XMLNodePointer_t xmlparent, TXMLInputStrea
       if (!inp->ShiftCurrent())
          return 0;
 
-      if (parent->fNs != 0)
+      if ((parent->fNs != 0) && !truncated)
          TruncateNsExtension((XMLNodePointer_t)parent);
 
       inp->SkipSpaces(kTRUE); // locate start of next string
@@ -2160,6 +2719,11 @@ XMLNodePointer_t TXMLEngine::ReadNode(XMLNodePointer_t xmlparent, TXMLInputStrea
          if (!inp->ShiftCurrent())
             return 0;
 
+         if (!readchilds) {
+            resvalue = 3;
+            return node;
+         }
+
          do {
             ReadNode(node, inp, resvalue);
          } while (resvalue == 2);
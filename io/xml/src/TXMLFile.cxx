@@ -87,6 +87,8 @@
 #include "TVirtualMutex.h"
 #include <ROOT/RMakeUnique.hxx>
 
+#include <vector>
+
 ClassImp(TXMLFile);
 
 
@@ -445,10 +447,9 @@ void TXMLFile::ProduceFileNames(const char *filename, TString &fname, TString &d
 ////////////////////////////////////////////////////////////////////////////////
 /// Saves xml structures to the file
 /// xml elements are kept in list of TKeyXML objects
-/// When saving, all this elements are linked to root xml node
+/// When saving, all this elements are written as children of root xml node
 /// At the end StreamerInfo structures are added
-/// After xml document is saved, all nodes will be unlinked from root node
-/// and kept in memory.
+/// The elements are streamed to the file one after another and kept in memory.
 /// Only Close() or destructor release memory, used by xml structures
 
 void TXMLFile::SaveToFile()
@@ -501,38 +502,42 @@ void TXMLFile::SaveToFile()
    TString fname, dtdname;
    ProduceFileNames(fRealName, fname, dtdname);
 
-   /*
-      TIter iter(GetListOfKeys());
-      TKeyXML* key = nullptr;
-      while ((key=(TKeyXML*)iter()) != nullptr)
-         fXML->AddChild(fRootNode, key->KeyNode());
-   */
-
-   CombineNodesTree(this, fRootNode, kTRUE);
-
    WriteStreamerInfo();
 
-   if (fStreamerInfoNode)
-      fXML->AddChild(fRootNode, fStreamerInfoNode);
-
    Int_t layout = GetCompressionLevel() > 5 ? 0 : 1;
 
-   fXML->SaveDoc(fDoc, fname, layout);
+   // nodes of the document, of the keys and of the streamer infos are written
+   // one after another, without combining them in a single tree
+   XMLWriterPointer_t writer = fXML->NewWriter(fname, layout, nullptr);
+   if (!writer)
+      return;
 
-   /*   iter.Reset();
-      while ((key=(TKeyXML*)iter()) != nullptr)
-         fXML->UnlinkNode(key->KeyNode());
-   */
-   CombineNodesTree(this, fRootNode, kFALSE);
+   XMLNodePointer_t node = fXML->GetChild(fXML->GetParent(fRootNode), kFALSE);
+   while (node) {
+      if (node == fRootNode) {
+         fXML->WriteStartNode(writer, fRootNode);
+         XMLNodePointer_t child = fXML->GetChild(fRootNode, kFALSE);
+         while (child) {
+            fXML->WriteNode(writer, child);
+            fXML->ShiftToNext(child, kFALSE);
+         }
+         WriteKeysNodes(this, writer);
+         if (fStreamerInfoNode)
+            fXML->WriteNode(writer, fStreamerInfoNode);
+         fXML->WriteEndNode(writer);
+      } else {
+         fXML->WriteNode(writer, node);
+      }
+      fXML->ShiftToNext(node, kFALSE);
+   }
 
-   if (fStreamerInfoNode)
-      fXML->UnlinkNode(fStreamerInfoNode);
+   fXML->FreeWriter(writer);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Connect/disconnect all file nodes to single tree before/after saving
+/// Write nodes of all keys of the directory, including the keys of its subdirectories
 
-void TXMLFile::CombineNodesTree(TDirectory *dir, XMLNodePointer_t topnode, Bool_t dolink)
+void TXMLFile::WriteKeysNodes(TDirectory *dir, XMLWriterPointer_t writer)
 {
    if (!dir)
       return;
@@ -541,32 +546,90 @@ void TXMLFile::CombineNodesTree(TDirectory *dir, XMLNodePointer_t topnode, Bool_
    TKeyXML *key = nullptr;
 
    while ((key = (TKeyXML *)iter()) != nullptr) {
-      if (dolink)
-         fXML->AddChild(topnode, key->KeyNode());
-      else
-         fXML->UnlinkNode(key->KeyNode());
-      if (key->IsSubdir())
-         CombineNodesTree(FindKeyDir(dir, key->GetKeyId()), key->KeyNode(), dolink);
+      if (!key->IsSubdir()) {
+         fXML->WriteNode(writer, key->KeyNode());
+         continue;
+      }
+
+      // keys of not yet read subdirectory are still children of its key node
+      fXML->WriteStartNode(writer, key->KeyNode());
+      XMLNodePointer_t child = fXML->GetChild(key->KeyNode(), kFALSE);
+      while (child) {
+         fXML->WriteNode(writer, child);
+         fXML->ShiftToNext(child, kFALSE);
+      }
+      WriteKeysNodes(FindKeyDir(dir, key->GetKeyId()), writer);
+      fXML->WriteEndNode(writer);
    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// read document from file
-/// Now full content of document reads into the memory
-/// Then document decomposed to separate keys and streamer info structures
-/// All irrelevant data will be cleaned
+/// Document is read node after node, the full content is never kept in memory
+/// Nodes of the keys and streamer infos are read one after another as separate structures
+/// All irrelevant data are skipped
 
 Bool_t TXMLFile::ReadFromFile()
 {
-   fDoc = fXML->ParseFile(fRealName);
-   if (!fDoc)
+   XMLReaderPointer_t reader = fXML->NewReader(fRealName);
+   if (!reader)
       return kFALSE;
 
-   XMLNodePointer_t fRootNode = fXML->DocGetRootElement(fDoc);
+   fDoc = fXML->NewDoc(nullptr);
+
+   XMLNodePointer_t fRootNode = nullptr;
+   std::vector<XMLNodePointer_t> prolog; // nodes in front of root node
+
+   Int_t event = 0;
+   while ((event = fXML->ReadNext(reader)) > 0) {
+      Int_t depth = fXML->GetReaderDepth(reader);
+
+      if ((depth == 1) && !fRootNode && (event == TXMLEngine::kXMLStartElement)) {
+         // only name and attributes of root node are copied, its children are read separately
+         XMLNodePointer_t readernode = fXML->GetReaderNode(reader);
+         fRootNode = fXML->NewChild(nullptr, nullptr, fXML->GetNodeName(readernode));
+         XMLAttrPointer_t attr = fXML->GetFirstAttr(readernode);
+         while (attr) {
+            fXML->NewAttr(fRootNode, nullptr, fXML->GetAttrName(attr), fXML->GetAttrValue(attr));
+            attr = fXML->GetNextAttr(attr);
+         }
+         fXML->DocSetRootElement(fDoc, fRootNode);
+         for (auto iter = prolog.rbegin(); iter != prolog.rend(); ++iter)
+            fXML->AddChildFirst(fXML->GetParent(fRootNode), *iter);
+         prolog.clear();
+      } else if ((depth == 1) && (event != TXMLEngine::kXMLEndElement)) {
+         XMLNodePointer_t node = fXML->ReadSubtree(reader);
+         if (!node)
+            continue;
+         if (fRootNode)
+            fXML->AddChild(fXML->GetParent(fRootNode), node);
+         else
+            prolog.push_back(node);
+      } else if ((depth == 2) && (event == TXMLEngine::kXMLStartElement)) {
+         XMLNodePointer_t node = fXML->ReadSubtree(reader);
+         if (!node)
+            continue;
+         if (!fStreamerInfoNode && (strcmp(xmlio::SInfos, fXML->GetNodeName(node)) == 0))
+            fStreamerInfoNode = node;
+         else if (strcmp(xmlio::Xmlkey, fXML->GetNodeName(node)) == 0)
+            fXML->AddChild(fRootNode, node);
+         else
+            fXML->FreeNode(node);
+      }
+   }
+
+   fXML->FreeReader(reader);
+
+   for (auto node : prolog)
+      fXML->FreeNode(node);
 
-   if (!fRootNode || !fXML->ValidateVersion(fDoc)) {
+   if ((event < 0) || !fRootNode || !fXML->ValidateVersion(fDoc)) {
       fXML->FreeDoc(fDoc);
       fDoc = nullptr;
+      if (fStreamerInfoNode) {
+         fXML->FreeNode(fStreamerInfoNode);
+         fStreamerInfoNode = nullptr;
+      }
       return kFALSE;
    }
 
@@ -598,15 +661,6 @@ Bool_t TXMLFile::ReadFromFile()
    if (fXML->HasAttr(fRootNode, "file_version"))
       fVersion = fXML->GetIntAttr(fRootNode, "file_version");
 
-   fStreamerInfoNode = fXML->GetChild(fRootNode);
-   fXML->SkipEmpty(fStreamerInfoNode);
-   while (fStreamerInfoNode) {
-      if (strcmp(xmlio::SInfos, fXML->GetNodeName(fStreamerInfoNode)) == 0)
-         break;
-      fXML->ShiftToNext(fStreamerInfoNode);
-   }
-   fXML->UnlinkNode(fStreamerInfoNode);
-
    if (fStreamerInfoNode)
       ReadStreamerInfo();
 
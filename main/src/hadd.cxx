@@ -48,6 +48,12 @@
   (i.e. direct copy of the raw byte on disk). The "fast" mode is typically
   5 times faster than the mode unzipping and unstreaming the baskets.
 
+  If the option -mt is used, hadd merges all the inputs in one process with
+  ROOT's implicit multi-threading enabled: when the baskets are recompressed
+  (e.g. -O or a change of compression with -f), the input branches are read and
+  the output baskets are compressed by several threads. The basket copy of the
+  "fast" mode remains serial. -mt cannot be combined with -j.
+
   If the option -cachesize is used, hadd will resize (or disable if 0) the
   prefetching cache use to speed up I/O operations.
 
@@ -74,6 +80,7 @@
 #include "ROOT/TIOFeatures.hxx"
 #include "TFile.h"
 #include "THashList.h"
+#include "TROOT.h"
 #include "TKey.h"
 #include "TClass.h"
 #include "TSystem.h"
@@ -112,6 +119,8 @@ int main( int argc, char **argv )
    Bool_t keepCompressionAsIs = kFALSE;
    Bool_t useFirstInputCompression = kFALSE;
    Bool_t multiproc = kFALSE;
+   Bool_t multithread = kFALSE;
+   UInt_t nThreads = 0;
    Bool_t debug = kFALSE;
    Int_t maxopenedfiles = 0;
    Int_t verbosity = 99;
@@ -186,6 +195,22 @@ int main( int argc, char **argv )
          }
          multiproc = kTRUE;
          ++ffirst;
+      } else if (strcmp(argv[a], "-mt") == 0) {
+         // If the number of threads is not specified, let ROOT use all the cores.
+         if (a + 1 != argc && isdigit(argv[a + 1][0])) {
+            char *end = nullptr;
+            Long_t request = strtol(argv[a + 1], &end, 10);
+            if (*end == '\0' && request < kMaxLong && request >= 0) {
+               nThreads = (UInt_t)request;
+               ++a;
+               ++ffirst;
+            } else {
+               std::cerr << "Error: could not parse the number of threads passed after -mt: " << argv[a + 1]
+                         << ". We will use the default value (number of logical cores).\n";
+            }
+         }
+         multithread = kTRUE;
+         ++ffirst;
       } else if ( strcmp(argv[a],"-cachesize=") == 0 ) {
          int size;
          static const size_t arglen = strlen("-cachesize=");
@@ -336,6 +361,20 @@ int main( int argc, char **argv )
 
    gSystem->Load("libTreePlayer");
 
+   if (multithread) {
+#ifdef R__USE_IMT
+      if (multiproc) {
+         std::cerr << "Error: -mt cannot be combined with -j; -mt is ignored.\n";
+      } else {
+         ROOT::EnableImplicitMT(nThreads);
+         if (verbosity > 1)
+            std::cout << "hadd merging with " << ROOT::GetThreadPoolSize() << " threads\n";
+      }
+#else
+      std::cerr << "Error: -mt requires ROOT to be built with imt support; -mt is ignored.\n";
+#endif
+   }
+
    const char *targetname = 0;
    if (outputPlace) {
       targetname = argv[outputPlace];
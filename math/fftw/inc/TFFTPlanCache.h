@@ -0,0 +1,45 @@
+// @(#)root/fft:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TFFTPlanCache
+#define ROOT_TFFTPlanCache
+
+#include "Rtypes.h"
+
+#include <functional>
+
+class TFFTComplex;
+class TFFTComplexReal;
+class TFFTRealComplex;
+class TFFTReal;
+
+class TFFTPlanCache {
+public:
+   enum EPlanType { kC2C, kC2R, kR2C, kR2R };
+
+   static void   SetNThreads(Int_t nthreads = 0);
+   static Int_t  GetNThreads();
+   static Bool_t ImportWisdom(const char *filename);
+   static Bool_t ExportWisdom(const char *filename);
+   static Int_t  GetNPlans();
+
+private:
+   friend class TFFTComplex;
+   friend class TFFTComplexReal;
+   friend class TFFTRealComplex;
+   friend class TFFTReal;
+
+   static void *GetPlan(EPlanType type, Int_t ndim, const Int_t *n, const Int_t *kind, Int_t nkind, UInt_t flags,
+                        void *in, void *out, const std::function<void *()> &makePlan);
+
+   ClassDef(TFFTPlanCache, 0); // Process-wide cache of the FFTW plans
+};
+
+#endif
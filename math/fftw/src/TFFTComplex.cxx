@@ -40,6 +40,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "TFFTComplex.h"
+#include "TFFTPlanCache.h"
 #include "fftw3.h"
 #include "TComplex.h"
 
@@ -102,13 +103,11 @@ TFFTComplex::TFFTComplex(Int_t ndim, Int_t *n, Bool_t inPlace)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-///Destroys the data arrays and the plan. However, some plan information stays around
-///until the root session is over, and is reused if other plans of the same size are
-///created
+///Destroys the data arrays. The plan stays in TFFTPlanCache until the root session is
+///over, and is reused by the other transforms of the same size and type
 
 TFFTComplex::~TFFTComplex()
 {
-   fftw_destroy_plan((fftw_plan)fPlan);
    fPlan = 0;
    fftw_free((fftw_complex*)fIn);
    if (fOut)
@@ -135,21 +134,19 @@ TFFTComplex::~TFFTComplex()
 /// - "EX" (from "exhaustive") - the most optimal way is found
 ///This option should be chosen depending on how many transforms of the same size and
 ///type are going to be done. Planning is only done once, for the first transform of this
-///size and type.
+///size and type: the plan is kept in TFFTPlanCache and shared by all the transforms of
+///this size and type.
 
 void TFFTComplex::Init( Option_t *flags, Int_t sign,const Int_t* /*kind*/)
 {
    fSign = sign;
    fFlags = flags;
 
-   if (fPlan)
-      fftw_destroy_plan((fftw_plan)fPlan);
-   fPlan = 0;
-
-   if (fOut)
-      fPlan = (void*)fftw_plan_dft(fNdim, fN, (fftw_complex*)fIn, (fftw_complex*)fOut, sign,MapFlag(flags));
-   else
-      fPlan = (void*)fftw_plan_dft(fNdim, fN, (fftw_complex*)fIn, (fftw_complex*)fIn, sign, MapFlag(flags));
+   const UInt_t fftwFlags = MapFlag(flags);
+   fPlan = TFFTPlanCache::GetPlan(TFFTPlanCache::kC2C, fNdim, fN, &sign, 1, fftwFlags, fIn, fOut, [&]() {
+      fftw_complex *out = (fftw_complex *)(fOut ? fOut : fIn);
+      return (void *)fftw_plan_dft(fNdim, fN, (fftw_complex *)fIn, out, sign, fftwFlags);
+   });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -158,7 +155,7 @@ void TFFTComplex::Init( Option_t *flags, Int_t sign,const Int_t* /*kind*/)
 void TFFTComplex::Transform()
 {
    if (fPlan)
-      fftw_execute((fftw_plan)fPlan);
+      fftw_execute_dft((fftw_plan)fPlan, (fftw_complex*)fIn, (fftw_complex*)(fOut ? fOut : fIn));
    else {
       Error("Transform", "transform not initialised");
       return;
@@ -42,6 +42,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "TFFTComplexReal.h"
+#include "TFFTPlanCache.h"
 #include "fftw3.h"
 #include "TComplex.h"
 
@@ -108,13 +109,11 @@ TFFTComplexReal::TFFTComplexReal(Int_t ndim, Int_t *n, Bool_t inPlace)
 
 
 ////////////////////////////////////////////////////////////////////////////////
-///Destroys the data arrays and the plan. However, some plan information stays around
-///until the root session is over, and is reused if other plans of the same size are
-///created
+///Destroys the data arrays. The plan stays in TFFTPlanCache until the root session is
+///over, and is reused by the other transforms of the same size and type
 
 TFFTComplexReal::~TFFTComplexReal()
 {
-   fftw_destroy_plan((fftw_plan)fPlan);
    fPlan = 0;
    fftw_free((fftw_complex*)fIn);
    if (fOut)
@@ -143,20 +142,18 @@ TFFTComplexReal::~TFFTComplexReal()
 ///
 ///This option should be chosen depending on how many transforms of the same size and
 ///type are going to be done. Planning is only done once, for the first transform of this
-///size and type.
+///size and type: the plan is kept in TFFTPlanCache and shared by all the transforms of
+///this size and type.
 
 void TFFTComplexReal::Init( Option_t *flags, Int_t /*sign*/,const Int_t* /*kind*/)
 {
    fFlags = flags;
 
-   if (fPlan)
-      fftw_destroy_plan((fftw_plan)fPlan);
-   fPlan = 0;
-
-   if (fOut)
-      fPlan = (void*)fftw_plan_dft_c2r(fNdim, fN,(fftw_complex*)fIn,(Double_t*)fOut, MapFlag(flags));
-   else
-      fPlan = (void*)fftw_plan_dft_c2r(fNdim, fN, (fftw_complex*)fIn, (Double_t*)fIn, MapFlag(flags));
+   const UInt_t fftwFlags = MapFlag(flags);
+   fPlan = TFFTPlanCache::GetPlan(TFFTPlanCache::kC2R, fNdim, fN, nullptr, 0, fftwFlags, fIn, fOut, [&]() {
+      Double_t *out = (Double_t *)(fOut ? fOut : fIn);
+      return (void *)fftw_plan_dft_c2r(fNdim, fN, (fftw_complex *)fIn, out, fftwFlags);
+   });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -165,7 +162,7 @@ void TFFTComplexReal::Init( Option_t *flags, Int_t /*sign*/,const Int_t* /*kind*
 void TFFTComplexReal::Transform()
 {
    if (fPlan)
-      fftw_execute((fftw_plan)fPlan);
+      fftw_execute_dft_c2r((fftw_plan)fPlan, (fftw_complex*)fIn, (Double_t*)(fOut ? fOut : fIn));
    else {
       Error("Transform", "transform was not initialized");
       return;
@@ -0,0 +1,196 @@
+// @(#)root/fft:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+/// \class TFFTPlanCache
+///
+/// Process-wide cache of the plans of the FFTW interface classes (TFFTComplex,
+/// TFFTComplexReal, TFFTRealComplex and TFFTReal).
+///
+/// The plans are identified by the type, the sizes, the sign or kinds and the
+/// flags of the transform, and by whether it is in place. A plan is created
+/// once, by the first Init() of a transform, and is shared by all the transforms
+/// of the same size and type, which execute it on their own arrays: creating
+/// many transform objects of the same size (e.g. one per histogram or per thread)
+/// no longer repeats the planning, which for the "M", "P" and "EX" flags costs
+/// much more than the transform itself. The plans are kept until the end of the
+/// session.
+///
+/// The plans can be saved in a wisdom file and imported in a later session, to
+/// skip the planning of the transforms already measured:
+///
+/// ~~~{.cpp}
+/// TFFTPlanCache::ImportWisdom("fftw.wisdom");
+/// auto fft = TVirtualFFT::FFT(1, &n, "R2C M");
+/// ...
+/// TFFTPlanCache::ExportWisdom("fftw.wisdom");
+/// ~~~
+///
+/// If FFTW was built with its threads library, the plans created after
+/// SetNThreads() compute each transform with several threads. This only pays
+/// off for large transforms (of order 10^5 points and more).
+////////////////////////////////////////////////////////////////////////////////
+
+#include "TFFTPlanCache.h"
+#include "TError.h"
+#include "fftw3.h"
+
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#endif
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+ClassImp(TFFTPlanCache);
+
+namespace {
+
+struct PlanCache {
+   std::mutex fMutex;                                  ///< the FFTW planner is not thread safe
+   std::map<std::vector<Long64_t>, fftw_plan> fPlans; ///< plans by key
+   Int_t fNThreads = 1;                                ///< threads of the plans to be created
+#ifdef R__FFTW_THREADS
+   bool fThreadsInit = false;                          ///< whether fftw_init_threads was called
+#endif
+
+   ~PlanCache()
+   {
+      for (auto &plan : fPlans)
+         fftw_destroy_plan(plan.second);
+   }
+};
+
+PlanCache &GetCache()
+{
+   static PlanCache cache;
+   return cache;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of threads used by the transforms planned from now on.
+/// With nthreads <= 0, use the size of the pool of the implicit multithreading
+/// (one thread if it is not enabled). The plans already in the cache are not
+/// changed. Needs FFTW built with its threads library.
+
+void TFFTPlanCache::SetNThreads(Int_t nthreads)
+{
+   if (nthreads <= 0) {
+      nthreads = 1;
+#ifdef R__USE_IMT
+      if (ROOT::IsImplicitMTEnabled())
+         nthreads = ROOT::GetThreadPoolSize();
+#endif
+   }
+#ifdef R__FFTW_THREADS
+   auto &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+   if (!cache.fThreadsInit) {
+      if (!fftw_init_threads()) {
+         ::Error("TFFTPlanCache::SetNThreads", "the threads of FFTW could not be initialized");
+         return;
+      }
+      cache.fThreadsInit = true;
+   }
+   cache.fNThreads = nthreads;
+#else
+   if (nthreads > 1)
+      ::Warning("TFFTPlanCache::SetNThreads", "FFTW was built without its threads library, using one thread");
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of threads used by the transforms planned from now on
+
+Int_t TFFTPlanCache::GetNThreads()
+{
+   auto &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+   return cache.fNThreads;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the wisdom of the file to the wisdom of FFTW. Return kFALSE if the file
+/// could not be read.
+
+Bool_t TFFTPlanCache::ImportWisdom(const char *filename)
+{
+   auto &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+   if (!fftw_import_wisdom_from_filename(filename)) {
+      ::Error("TFFTPlanCache::ImportWisdom", "cannot import the FFTW wisdom from %s", filename);
+      return kFALSE;
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the wisdom of FFTW, i.e. of all the plans created in this session and of
+/// the imported wisdom, into the file. Return kFALSE if the file could not be written.
+
+Bool_t TFFTPlanCache::ExportWisdom(const char *filename)
+{
+   auto &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+   if (!fftw_export_wisdom_to_filename(filename)) {
+      ::Error("TFFTPlanCache::ExportWisdom", "cannot export the FFTW wisdom to %s", filename);
+      return kFALSE;
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of plans in the cache
+
+Int_t TFFTPlanCache::GetNPlans()
+{
+   auto &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+   return cache.fPlans.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the plan of a transform of type type and sizes n[ndim] with kinds
+/// kind[nkind] (the sign of a complex transform, the kinds of a real one) and the
+/// FFTW flags flags, between the arrays in and out (out = 0 for an in-place
+/// transform). If it is not in the cache, the plan is created by makePlan.
+///
+/// The plan is owned by the cache. It can be executed on any pair of arrays
+/// allocated by fftw_malloc, with the new-array execute functions of FFTW.
+
+void *TFFTPlanCache::GetPlan(EPlanType type, Int_t ndim, const Int_t *n, const Int_t *kind, Int_t nkind,
+                             UInt_t flags, void *in, void *out, const std::function<void *()> &makePlan)
+{
+   auto &cache = GetCache();
+   std::lock_guard<std::mutex> lock(cache.fMutex);
+
+   // the alignments are the same for all the arrays allocated by fftw_malloc; they are part of the key as a
+   // plan may only be executed on arrays with the alignment of the ones it was created for
+   std::vector<Long64_t> key = {type, ndim, flags, out == nullptr, fftw_alignment_of((double *)in),
+                                out ? fftw_alignment_of((double *)out) : 0, cache.fNThreads};
+   key.insert(key.end(), n, n + ndim);
+   key.insert(key.end(), kind, kind + nkind);
+
+   auto it = cache.fPlans.find(key);
+   if (it != cache.fPlans.end())
+      return it->second;
+
+#ifdef R__FFTW_THREADS
+   if (cache.fThreadsInit)
+      fftw_plan_with_nthreads(cache.fNThreads);
+#endif
+   auto plan = (fftw_plan)makePlan();
+   if (plan)
+      cache.fPlans.emplace(std::move(key), plan);
+   return plan;
+}
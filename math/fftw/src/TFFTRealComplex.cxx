@@ -43,6 +43,7 @@
 /////////////////////////////////////////////////////////////////////////////////
 
 #include "TFFTRealComplex.h"
+#include "TFFTPlanCache.h"
 #include "fftw3.h"
 #include "TComplex.h"
 
@@ -112,13 +113,11 @@ TFFTRealComplex::TFFTRealComplex(Int_t ndim, Int_t *n, Bool_t inPlace)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-///Destroys the data arrays and the plan. However, some plan information stays around
-///until the root session is over, and is reused if other plans of the same size are
-///created
+///Destroys the data arrays. The plan stays in TFFTPlanCache until the root session is
+///over, and is reused by the other transforms of the same size and type
 
 TFFTRealComplex::~TFFTRealComplex()
 {
-   fftw_destroy_plan((fftw_plan)fPlan);
    fPlan = 0;
    fftw_free(fIn);
    fIn = 0;
@@ -147,20 +146,18 @@ TFFTRealComplex::~TFFTRealComplex()
 ///
 ///This option should be chosen depending on how many transforms of the same size and
 ///type are going to be done. Planning is only done once, for the first transform of this
-///size and type.
+///size and type: the plan is kept in TFFTPlanCache and shared by all the transforms of
+///this size and type.
 
 void TFFTRealComplex::Init(Option_t *flags,Int_t /*sign*/, const Int_t* /*kind*/)
 {
    fFlags = flags;
 
-   if (fPlan)
-      fftw_destroy_plan((fftw_plan)fPlan);
-   fPlan = 0;
-
-   if (fOut)
-      fPlan = (void*)fftw_plan_dft_r2c(fNdim, fN, (Double_t*)fIn, (fftw_complex*)fOut,MapFlag(flags));
-   else
-      fPlan = (void*)fftw_plan_dft_r2c(fNdim, fN, (Double_t*)fIn, (fftw_complex*)fIn, MapFlag(flags));
+   const UInt_t fftwFlags = MapFlag(flags);
+   fPlan = TFFTPlanCache::GetPlan(TFFTPlanCache::kR2C, fNdim, fN, nullptr, 0, fftwFlags, fIn, fOut, [&]() {
+      fftw_complex *out = (fftw_complex *)(fOut ? fOut : fIn);
+      return (void *)fftw_plan_dft_r2c(fNdim, fN, (Double_t *)fIn, out, fftwFlags);
+   });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -170,7 +167,7 @@ void TFFTRealComplex::Transform()
 {
 
    if (fPlan){
-      fftw_execute((fftw_plan)fPlan);
+      fftw_execute_dft_r2c((fftw_plan)fPlan, (Double_t*)fIn, (fftw_complex*)(fOut ? fOut : fIn));
    }
    else {
       Error("Transform", "transform hasn't been initialised");
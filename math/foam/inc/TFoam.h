@@ -7,6 +7,7 @@
 
 #include "TObject.h"
 #include "TString.h"
+#include "Fit/FitExecutionPolicy.h"
 
 #include <vector>
 
@@ -73,6 +74,9 @@ protected:
 
    Double_t *fAlpha;          ///< [fDim] Internal parameters of the hyper-rectangle
 
+   Int_t   fNBatch;           ///<! No. of MC points of the cell exploration evaluated at once
+   ROOT::Fit::ExecutionPolicy fExecutionPolicy; ///<! Execution policy of the cell exploration
+
 public:
    TFoam();                          // Default constructor (used only by ROOT streamer)
    TFoam(const Char_t*);             // Principal user-defined constructor
@@ -92,6 +96,7 @@ public:
    virtual Int_t  Divide(TFoamCell *);       // Divide iCell into two daughters; iCell retained, taged as inactive
    virtual void MakeActiveList();            // Creates table of active cells
    virtual void GenerCel2(TFoamCell *&);     // Chose an active cell the with probability ~ Primary integral
+   virtual void EvalBatch(Int_t, Double_t *, Double_t *); // Evaluates the distribution at several points
    // Generation
    virtual Double_t Eval(Double_t *);        // Evaluates value of the distribution function
    virtual void     MakeEvent();             // Makes (generates) single MC event
@@ -99,6 +104,7 @@ public:
    virtual void     GetMCwt(Double_t &);     // Provides generated MC weight
    virtual Double_t GetMCwt();               // Provides generates MC weight
    virtual Double_t MCgenerate(Double_t *MCvect);// All three above function in one
+   Double_t GenerateEvent(TRandom &rnd, Double_t *MCvect) const; // Thread-safe generation with the generator rnd
    // Finalization
    virtual void GetIntegMC(Double_t&, Double_t&);// Provides Integrand and abs. error from MC run
    virtual void GetIntNorm(Double_t&, Double_t&);// Provides normalization Inegrand
@@ -121,6 +127,8 @@ public:
    virtual void SetOptDrive(Int_t OptDrive){fOptDrive =OptDrive;}  // Sets optimization switch
    virtual void SetEvPerBin(Int_t EvPerBin){fEvPerBin =EvPerBin;}  // Sets max. no. of effective events per bin
    virtual void SetMaxWtRej(Double_t MaxWtRej){fMaxWtRej=MaxWtRej;}  // Sets max. weight for rejection
+   virtual void SetnBatch(Int_t nBatch){fNBatch = nBatch;}  // Sets no of MC points evaluated at once in cell exploration
+   virtual void SetExecutionPolicy(ROOT::Fit::ExecutionPolicy policy){fExecutionPolicy = policy;} // Sets serial or multithreaded exploration
    virtual void SetInhiDiv(Int_t, Int_t );            // Set inhibition of cell division along certain edge
    virtual void SetXdivPRD(Int_t, Int_t, Double_t[]); // Set predefined division points
    // Getters and Setters
@@ -130,6 +138,8 @@ public:
    virtual void GetPrimary(Double_t &prime) {prime = fPrime;}      // Get value of primary integral R'
    virtual Long_t GetnCalls() const {return fNCalls;}            // Get total no. of the function calls
    virtual Long_t GetnEffev() const {return fNEffev;}            // Get total no. of effective wt=1 events
+   virtual Int_t  GetnBatch() const {return fNBatch;}            // Get no of MC points evaluated at once
+   ROOT::Fit::ExecutionPolicy GetExecutionPolicy() const {return fExecutionPolicy;} // Get execution policy
    // Debug
    virtual void CheckAll(Int_t);     // Checks correctness of the entire data structure in the FOAM object
    virtual void PrintCells();        // Prints content of all cells
@@ -138,6 +148,7 @@ public:
    // Inline
 private:
    Double_t Sqr(Double_t x) const { return x*x;}      // Square function
+   TFoamCell *ChooseCell(Double_t random) const;       // Active cell for the uniform random number random
 
    ClassDef(TFoam,2);   // General purpose self-adapting Monte Carlo event generator
 };
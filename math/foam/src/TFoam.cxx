@@ -68,6 +68,17 @@ Only `kDim` HAS TO BE redefined, the other parameters may be left at their defau
 Increasing `nSampl` sometimes helps, but it may cost CPU time.
 `MaxWtRej` may need to be increased for wild a distribution, while using `OptRej=0`.
 
+### Batched and multithreaded evaluation
+
+In the cell exploration, the `nSampl` MC points of a cell are evaluated by batches of
+`nBatch` points (1 by default, see SetnBatch()) with TFoamIntegrand::DensityBatch,
+which can be overridden to evaluate several points at once.
+With `FoamObject->SetExecutionPolicy(ROOT::Fit::ExecutionPolicy::kMultithread)` and
+the implicit multithreading enabled (ROOT::EnableImplicitMT()), all the points of a cell
+are evaluated in parallel, which requires a thread-safe distribution.
+After Initialize(), GenerateEvent() generates events from several threads, each with
+its own random number generator.
+
 Past versions of FOAM: August 2003, v.1.00; September 2003 v.1.01
 Adopted starting from FOAM-2.06 by P. Sawicki
 
@@ -92,6 +103,14 @@ S. Jadach, Computer Physics Communications 152 (2003) 55.
 #include "TMath.h"
 #include "TInterpreter.h"
 
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <vector>
+
 ClassImp(TFoam);
 
 //FFFFFF  BoX-FORMATs for nice and flexible outputs
@@ -158,7 +177,7 @@ TFoam::TFoam() :
    fSumOve(0), fNevGen(0),
    fWtMax(0), fWtMin(0),
    fPrime(0), fMCresult(0), fMCerror(0),
-   fAlpha(0)
+   fAlpha(0), fNBatch(1), fExecutionPolicy(ROOT::Fit::ExecutionPolicy::kSerial)
 {
 }
 ////////////////////////////////////////////////////////////////////////////////
@@ -179,7 +198,7 @@ TFoam::TFoam(const Char_t* Name) :
    fSumOve(0), fNevGen(0),
    fWtMax(0), fWtMin(0),
    fPrime(0), fMCresult(0), fMCerror(0),
-   fAlpha(0)
+   fAlpha(0), fNBatch(1), fExecutionPolicy(ROOT::Fit::ExecutionPolicy::kSerial)
 {
    if(strlen(Name)  >129) {
       Error("TFoam","Name too long %s \n",Name);
@@ -537,8 +556,6 @@ void TFoam::Explore(TFoamCell *cell)
 
    TFoamCell  *parent;
 
-   Double_t *xRand = new Double_t[fDim];
-
    Double_t *volPart=0;
 
    cell->CalcVolume();
@@ -560,35 +577,49 @@ void TFoam::Explore(TFoamCell *cell)
    fHistWt->Reset();
    //
    // ||||||||||||||||||||||||||BEGIN MC LOOP|||||||||||||||||||||||||||||
+   // The points are generated and evaluated by batches of nBatch points, then accumulated one by one.
+   // The points of the last batch after the exit condition are not used.
+   const Long_t nBatch = (fExecutionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread)
+                            ? fNSampl : std::max(1, std::min<Int_t>(fNBatch, fNSampl));
+   std::vector<Double_t> alphaBatch(nBatch*fDim), xBatch(nBatch*fDim), rhoBatch(nBatch);
    Double_t nevEff=0.;
-   for(iev=0;iev<fNSampl;iev++){
-      MakeAlpha();               // generate uniformly vector inside hypercube
-
-      if(fDim>0){
-      for(j=0; j<fDim; j++)
-         xRand[j]= cellPosi[j] +fAlpha[j]*(cellSize[j]);
+   Bool_t exitMC = kFALSE;
+   for(iev=0; iev<fNSampl && !exitMC; iev+=nBatch){
+      const Long_t nPoints = std::min(nBatch, fNSampl-iev);
+      for(Long_t ip=0; ip<nPoints; ip++){
+         MakeAlpha();               // generate uniformly vector inside hypercube
+         for(j=0; j<fDim; j++){
+            alphaBatch[ip*fDim+j] = fAlpha[j];
+            xBatch[ip*fDim+j] = cellPosi[j] +fAlpha[j]*(cellSize[j]);
+         }
       }
-
-      wt=dx*Eval(xRand);
-
-      nProj = 0;
-      if(fDim>0) {
-         for(k=0; k<fDim; k++) {
-            xproj =fAlpha[k];
-            ((TH1D *)(*fHistEdg)[nProj])->Fill(xproj,wt);
-            nProj++;
+      EvalBatch(nPoints, xBatch.data(), rhoBatch.data());
+      fNCalls += nPoints;
+
+      for(Long_t ip=0; ip<nPoints; ip++){
+         wt=dx*rhoBatch[ip];
+
+         nProj = 0;
+         if(fDim>0) {
+            for(k=0; k<fDim; k++) {
+               xproj =alphaBatch[ip*fDim+k];
+               ((TH1D *)(*fHistEdg)[nProj])->Fill(xproj,wt);
+               nProj++;
+            }
+         }
+         //
+         ceSum[0] += wt;    // sum of weights
+         ceSum[1] += wt*wt; // sum of weights squared
+         ceSum[2]++;        // sum of 1
+         if (ceSum[3]>wt) ceSum[3]=wt;  // minimum weight;
+         if (ceSum[4]<wt) ceSum[4]=wt;  // maximum weight
+         // test MC loop exit condition
+         nevEff = ceSum[1] == 0. ? 0. : ceSum[0]*ceSum[0]/ceSum[1];
+         if( nevEff >= fNBin*fEvPerBin) {
+            exitMC = kTRUE;
+            break;
          }
       }
-      //
-      fNCalls++;
-      ceSum[0] += wt;    // sum of weights
-      ceSum[1] += wt*wt; // sum of weights squared
-      ceSum[2]++;        // sum of 1
-      if (ceSum[3]>wt) ceSum[3]=wt;  // minimum weight;
-      if (ceSum[4]<wt) ceSum[4]=wt;  // maximum weight
-      // test MC loop exit condition
-      nevEff = ceSum[1] == 0. ? 0. : ceSum[0]*ceSum[0]/ceSum[1];
-      if( nevEff >= fNBin*fEvPerBin) break;
    }   // ||||||||||||||||||||||||||END MC LOOP|||||||||||||||||||||||||||||
    //------------------------------------------------------------------
    //---  predefine logics of searching for the best division edge ---
@@ -660,7 +691,6 @@ void TFoam::Explore(TFoamCell *cell)
       parent->SetDriv( parDriv   +intDriv -driOld );
    }
    delete [] volPart;
-   delete [] xRand;
    //cell->Print();
 } // TFoam::Explore
 
@@ -1080,18 +1110,60 @@ Double_t TFoam::Eval(Double_t *xRand)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Internal method.
+/// Evaluates the distribution function at the npoints points x, x[i*fDim+j] being
+/// the coordinate j of the point i, with TFoamIntegrand::DensityBatch.
+///
+/// With the multithreaded execution policy and the implicit multithreading of ROOT
+/// enabled, the points are split in chunks evaluated in parallel: the distribution
+/// must then be thread safe. Without a TFoamIntegrand (interactive mode), the points
+/// are evaluated sequentially with Eval().
+
+void TFoam::EvalBatch(Int_t npoints, Double_t *x, Double_t *rho)
+{
+   if(!fRho) {   //interactive mode
+      for(Int_t i=0; i<npoints; i++) rho[i] = Eval(x + i*fDim);
+      return;
+   }
+#ifdef R__USE_IMT
+   if (fExecutionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread && ROOT::IsImplicitMTEnabled() && npoints > 1) {
+      const Int_t nChunks = std::min<Int_t>(npoints, ROOT::GetThreadPoolSize());
+      const Int_t chunkSize = (npoints + nChunks - 1) / nChunks;
+      auto evalChunk = [&](Int_t ichunk) {
+         const Int_t first = ichunk * chunkSize;
+         const Int_t n = std::min(chunkSize, npoints - first);
+         if (n > 0)
+            fRho->DensityBatch(fDim, n, x + first * fDim, rho + first);
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(evalChunk, ROOT::TSeqI(nChunks));
+      return;
+   }
+#endif
+   fRho->DensityBatch(fDim, npoints, x, rho);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Internal method.
 /// Return randomly chosen active cell with probability equal to its
 /// contribution into total driver integral using interpolation search.
 
 void TFoam::GenerCel2(TFoamCell *&pCell)
+{
+   pCell = ChooseCell(fPseRan->Rndm());
+}       // TFoam::GenerCel2
+
+////////////////////////////////////////////////////////////////////////////////
+/// Internal method.
+/// Return the active cell corresponding to the uniform random number random,
+/// using interpolation search in the cumulative primary integrals.
+
+TFoamCell *TFoam::ChooseCell(Double_t random) const
 {
    Long_t  lo, hi, hit;
    Double_t fhit, flo, fhi;
-   Double_t random;
 
-   random=fPseRan->Rndm();
    lo  = 0;              hi =fNoAct-1;
    flo = fPrimAcu[lo];  fhi=fPrimAcu[hi];
    while(lo+1<hi) {
@@ -1110,10 +1182,10 @@ void TFoam::GenerCel2(TFoamCell *&pCell)
       }
    }
    if (fPrimAcu[lo]>random)
-      pCell = fCells[fCellsAct[lo]];
+      return fCells[fCellsAct[lo]];
    else
-      pCell = fCells[fCellsAct[hi]];
-}       // TFoam::GenerCel2
+      return fCells[fCellsAct[hi]];
+}
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1170,6 +1242,53 @@ ee0:
    //********************** MC LOOP ENDS HERE **********************
 } // MakeEvent
 
+////////////////////////////////////////////////////////////////////////////////
+/// Thread-safe generation of a MC event, with the random number generator rnd.
+/// The MC vector is put in MCvect and its MC weight is returned.
+///
+/// The event is generated as in MakeEvent(), including the rejection for
+/// OptRej=1, but the state of the foam is not modified: the MC statistics
+/// (GetIntegMC(), GetWtParams(), ...) do not include these events.
+/// After Initialize(), several threads can thus generate events from the same
+/// foam, each with its own generator, provided that the distribution is thread
+/// safe:
+///
+/// ~~~{.cpp}
+/// ROOT::TThreadExecutor pool;
+/// pool.Foreach([&](UInt_t ibatch) {
+///    TRandom3 rnd(ibatch + 1);
+///    std::vector<Double_t> x(foam->GetTotDim());
+///    for (Int_t i = 0; i < 100000; i++) {
+///       Double_t wt = foam->GenerateEvent(rnd, x.data());
+///       ...
+///    }
+/// }, ROOT::TSeqU(nbatches));
+/// ~~~
+///
+/// The distribution must be set with SetRho() or SetRhoInt().
+
+Double_t TFoam::GenerateEvent(TRandom &rnd, Double_t *MCvect) const
+{
+   if(!fRho) {
+      Error("GenerateEvent", "Only compiled distributions are supported\n");
+      return 0;
+   }
+   std::vector<Double_t> alpha(fDim);
+   TFoamVect  cellPosi(fDim); TFoamVect  cellSize(fDim);
+   while(true) {
+      TFoamCell *rCell = ChooseCell(rnd.Rndm());   // choose randomly one cell
+      if(fDim>0) rnd.RndmArray(fDim,alpha.data());
+      rCell->GetHcub(cellPosi,cellSize);
+      for(Int_t j=0; j<fDim; j++)
+         MCvect[j]= cellPosi[j] +alpha[j]*cellSize[j];
+      Double_t mcwt = rCell->GetVolume()*fRho->Density(fDim,MCvect) / rCell->GetPrim();
+      if(fOptRej != 1) return mcwt;
+      //*******  Optional rejection ******
+      if( fMaxWtRej*rnd.Rndm() > mcwt) continue;  // Wt=1 events, internal rejection
+      return (mcwt<fMaxWtRej) ? 1.0 : mcwt/fMaxWtRej;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// User may get generated MC point/vector with help of this method
 
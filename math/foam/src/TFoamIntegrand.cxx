@@ -7,4 +7,20 @@
 Abstract class representing n-dimensional real positive integrand function
 */
 
-ClassImp(TFoamIntegrand);
\ No newline at end of file
+ClassImp(TFoamIntegrand);
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the density at the npoints points x, stored one after the other:
+/// x[i*ndim + j] is the coordinate j of the point i, and its density is put
+/// in rho[i].
+///
+/// The default implementation calls Density() for each point. It can be
+/// overridden to evaluate the points together, e.g. with vectorized code.
+/// TFoam uses it in the exploration of the cells; with the multithreaded execution
+/// policy of TFoam it is called concurrently on distinct points, and must then be
+/// thread safe.
+
+void TFoamIntegrand::DensityBatch(Int_t ndim, Int_t npoints, Double_t *x, Double_t *rho)
+{
+   for (Int_t i = 0; i < npoints; i++)
+      rho[i] = Density(ndim, x + i * ndim);
+}
@@ -2,11 +2,15 @@
 // Author: Stephan Hageboeck, CERN  04/2020
 
 #include "TFoam.h"
+#include "TFoamIntegrand.h"
 #include "TFile.h"
 #include "TMath.h"
+#include "TRandom3.h"
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+
 Double_t sqr(Double_t x){
    return x*x;
 }
@@ -50,3 +54,49 @@ TEST(TFoam, Readv1) {
     EXPECT_NEAR(x[1], results[i][1], 1.E-9);
   }
 }
+
+class Camel2Integrand : public TFoamIntegrand {
+public:
+   Int_t fMaxBatch = 0;
+   Double_t Density(Int_t nDim, Double_t *x) override { return Camel2(nDim, x); }
+   void DensityBatch(Int_t nDim, Int_t npoints, Double_t *x, Double_t *rho) override
+   {
+      fMaxBatch = std::max(fMaxBatch, npoints);
+      TFoamIntegrand::DensityBatch(nDim, npoints, x, rho);
+   }
+};
+
+// Explore the cells by batches of points, and generate events with GenerateEvent
+TEST(TFoam, BatchAndGenerateEvent) {
+  TRandom3 rnd(4357);
+  Camel2Integrand rho;
+  TFoam foam("FoamBatch");
+  foam.SetkDim(2);
+  foam.SetnCells(500);
+  foam.SetnBatch(50);
+  foam.SetChat(0);
+  foam.SetRho(&rho);
+  foam.SetPseRan(&rnd);
+  foam.Initialize();
+  EXPECT_EQ(rho.fMaxBatch, 50);
+
+  // the distribution is normalized to one
+  double x[2];
+  for (int i = 0; i < 100000; ++i)
+    foam.MakeEvent();
+  double integral, error;
+  foam.GetIntegMC(integral, error);
+  EXPECT_NEAR(integral, 1., 5 * error + 1.E-4);
+
+  // GenerateEvent uses the random numbers as MakeEvent, without changing the foam
+  TRandom3 rnd2(rnd);
+  for (int i = 0; i < 5; ++i) {
+    double y[2];
+    double wt = foam.GenerateEvent(rnd2, y);
+    foam.MakeEvent();
+    foam.GetMCvect(x);
+    EXPECT_EQ(y[0], x[0]);
+    EXPECT_EQ(y[1], x[1]);
+    EXPECT_EQ(wt, foam.GetMCwt());
+  }
+}
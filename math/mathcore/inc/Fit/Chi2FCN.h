@@ -68,7 +68,9 @@ public:
       fNEffPoints(0),
       fGrad ( std::vector<double> ( func->NPar() ) ),
       fExecutionPolicy(executionPolicy)
-   { }
+   {
+      InitDeviceData();
+   }
 
    /**
       Same Constructor from data set (binned ) and model function but now managed by the user
@@ -79,7 +81,9 @@ public:
       fNEffPoints(0),
       fGrad ( std::vector<double> ( func.NPar() ) ),
       fExecutionPolicy(executionPolicy)
-   { }
+   {
+      InitDeviceData();
+   }
 
    /**
       Destructor (no operations)
@@ -92,7 +96,8 @@ public:
       BaseFCN(f.DataPtr(), f.ModelFunctionPtr() ),
       fNEffPoints( f.fNEffPoints ),
       fGrad( f.fGrad),
-      fExecutionPolicy(f.fExecutionPolicy)
+      fExecutionPolicy(f.fExecutionPolicy),
+      fDeviceData(f.fDeviceData)
    {  }
 
    /**
@@ -103,6 +108,8 @@ public:
       SetModelFunction(rhs.ModelFunctionPtr() );
       fNEffPoints = rhs.fNEffPoints;
       fGrad = rhs.fGrad;
+      fExecutionPolicy = rhs.fExecutionPolicy;
+      fDeviceData = rhs.fDeviceData;
    }
 
    /*
@@ -126,8 +133,11 @@ public:
    // need to be virtual to be instantiated
    virtual void Gradient(const double *x, double *g) const {
       // evaluate the chi2 gradient
+      if (fDeviceData &&
+          FitUtil::Evaluate<T>::EvalChi2GradientOnDevice(BaseFCN::ModelFunction(), BaseFCN::Data(), x, g, *fDeviceData))
+         return;
       FitUtil::Evaluate<T>::EvalChi2Gradient(BaseFCN::ModelFunction(), BaseFCN::Data(), x, g, fNEffPoints,
-                                             fExecutionPolicy);
+                                             CPUExecutionPolicy());
    }
 
    /// get type of fit method function
@@ -139,6 +149,18 @@ protected:
    /// set number of fit points (need to be called in const methods, make it const)
    virtual void SetNFitPoints(unsigned int n) const { fNEffPoints = n; }
 
+   /// create the data kept on the device with the GPU execution policy
+   void InitDeviceData() {
+      fDeviceData = FitUtil::CreateDeviceData(
+         dynamic_cast<const IDeviceModelFunction *>(&BaseFCN::ModelFunction()) != nullptr, fExecutionPolicy);
+   }
+
+   /// execution policy of the evaluations on the CPU: with the GPU policy, the ones which cannot be done on the device
+   ::ROOT::Fit::ExecutionPolicy CPUExecutionPolicy() const {
+      return (fExecutionPolicy == ::ROOT::Fit::ExecutionPolicy::kGPU) ? ::ROOT::Fit::ExecutionPolicy::kSerial
+                                                                      : fExecutionPolicy;
+   }
+
 private:
 
    /**
@@ -148,8 +170,12 @@ private:
       this->UpdateNCalls();
       if (BaseFCN::Data().HaveCoordErrors() || BaseFCN::Data().HaveAsymErrors())
          return FitUtil::Evaluate<T>::EvalChi2Effective(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fNEffPoints);
-      else
-         return FitUtil::Evaluate<T>::EvalChi2(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fNEffPoints, fExecutionPolicy);
+      double chi2 = 0;
+      if (fDeviceData && FitUtil::Evaluate<T>::EvalChi2OnDevice(BaseFCN::ModelFunction(), BaseFCN::Data(), x,
+                                                                *fDeviceData, chi2))
+         return chi2;
+      return FitUtil::Evaluate<T>::EvalChi2(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fNEffPoints,
+                                            CPUExecutionPolicy());
    }
 
    // for derivatives
@@ -163,6 +189,7 @@ private:
 
    mutable std::vector<double> fGrad; // for derivatives
    ::ROOT::Fit::ExecutionPolicy fExecutionPolicy;
+   std::shared_ptr<FitDeviceData> fDeviceData; // data resident on the device, with the GPU execution policy
 
 };
 
@@ -0,0 +1,65 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2020  LCG ROOT Math Team, CERN/PH-SFT                *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Header file for class IDeviceModelFunction
+
+#ifndef ROOT_Fit_DeviceModelFunction
+#define ROOT_Fit_DeviceModelFunction
+
+namespace ROOT {
+
+   namespace Fit {
+
+//___________________________________________________________________________________
+/**
+   Interface for model functions which can be evaluated on a CUDA device, used by the fits
+   with the ROOT::Fit::ExecutionPolicy::kGPU execution policy.
+
+   A model function implementing it derives from both ROOT::Math::IParamMultiFunction (the
+   evaluation on the host, used for instance for the integral of an extended likelihood) and
+   from this class, whose methods launch CUDA kernels (they are typically implemented in a
+   .cu file compiled by the user).
+
+   All pointers passed to the methods are in device memory. The coordinates are stored by
+   component: coordinate j of point i is x[j * stride + i]. The kernels are expected to be
+   launched on the default stream; the results are read back after a synchronization.
+
+   @ingroup  FitMain
+*/
+class IDeviceModelFunction {
+
+public:
+
+   virtual ~IDeviceModelFunction() {}
+
+   /**
+      Evaluate the model at the n points of x for the parameters p and store the values in f[0..n-1]
+   */
+   virtual void DeviceEval(const double *x, unsigned int n, unsigned int stride, const double *p,
+                           double *f) const = 0;
+
+   /**
+      Return true if DeviceParameterGradient is implemented
+   */
+   virtual bool HasDeviceParameterGradient() const { return false; }
+
+   /**
+      Evaluate the derivatives of the model with respect to the parameters at the n points of x and
+      store them in g: the derivative with respect to parameter k at point i is g[k * n + i]
+   */
+   virtual void DeviceParameterGradient(const double * /* x */, unsigned int /* n */, unsigned int /* stride */,
+                                        const double * /* p */, double * /* g */) const {}
+
+};
+
+   } // end namespace Fit
+
+} // end namespace ROOT
+
+#endif /* ROOT_Fit_DeviceModelFunction */
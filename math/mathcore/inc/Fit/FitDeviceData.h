@@ -0,0 +1,103 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2020  LCG ROOT Math Team, CERN/PH-SFT                *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Header file for class FitDeviceData
+
+#ifndef ROOT_Fit_FitDeviceData
+#define ROOT_Fit_FitDeviceData
+
+#include <memory>
+
+namespace ROOT {
+
+   namespace Fit {
+
+class FitData;
+class BinData;
+class UnBinData;
+class IDeviceModelFunction;
+
+//___________________________________________________________________________________
+/**
+   Copy of a fit data set in the memory of a CUDA device, used by the fit method functions
+   with the ROOT::Fit::ExecutionPolicy::kGPU execution policy.
+
+   The data are uploaded once and stay resident on the device across the evaluations of the
+   fit method function (i.e. across the minimizer iterations). At each evaluation only the
+   parameters are copied to the device; the model is evaluated by the kernels of an
+   IDeviceModelFunction and the chi2 or log-likelihood terms are summed with parallel reductions
+   on the device. Only the partial sums of the thread blocks are copied back, and they are added
+   in a fixed order, so that the result does not change from one evaluation to the next.
+
+   The points are processed in chunks, so that the memory needed on the device besides the data
+   is bounded, also when computing the gradient.
+
+   It is available only if ROOT has been built with CUDA support (cuda=ON) and a device is
+   present, see IsAvailable(). Otherwise the fit method functions evaluate on the CPU.
+
+   @ingroup  FitMain
+*/
+class FitDeviceData {
+
+public:
+
+   FitDeviceData();
+
+   ~FitDeviceData();
+
+   FitDeviceData(const FitDeviceData &) = delete;
+   FitDeviceData &operator=(const FitDeviceData &) = delete;
+
+   /// return true if ROOT has been built with CUDA support and a CUDA device is present
+   static bool IsAvailable();
+
+   /// copy the binned data set to the device, if it is not already resident.
+   /// Return false if this is not possible or if the data options are not supported on the device
+   /// (integral of the model in the bins, errors on the coordinates)
+   bool Upload(const BinData &data);
+
+   /// copy the unbinned data set to the device, if it is not already resident
+   bool Upload(const UnBinData &data);
+
+   /// return true if the given data set is the one resident on the device
+   bool IsResident(const FitData &data) const;
+
+   /// free the device memory
+   void Clear();
+
+   /// sum of the chi2 residuals of the resident binned data for the model at the parameters p
+   bool Chi2(const IDeviceModelFunction &func, const double *p, unsigned int npar, bool useExpErrors,
+             double invWeight, double maxResValue, double &chi2);
+
+   /// gradient of the chi2 of the resident binned data
+   bool Chi2Gradient(const IDeviceModelFunction &func, const double *p, unsigned int npar, double *grad);
+
+   /// sum of the logarithms of the model at the resident unbinned data points, and the sums of
+   /// the weights and of their squares (iWeight = 2 and not extended, as in FitUtil::EvaluateLogL)
+   bool LogL(const IDeviceModelFunction &func, const double *p, unsigned int npar, int iWeight, bool extended,
+             double &logl, double &sumW, double &sumW2);
+
+   /// gradient of minus the log-likelihood of the resident unbinned data
+   bool LogLGradient(const IDeviceModelFunction &func, const double *p, unsigned int npar, double *grad);
+
+private:
+
+   struct Impl;
+
+   std::unique_ptr<Impl> fImpl;      // device buffers
+   const FitData *fData = nullptr;   // data set resident on the device
+   unsigned int fSize = 0;           // number of points of the resident data set
+
+};
+
+   } // end namespace Fit
+
+} // end namespace ROOT
+
+#endif /* ROOT_Fit_FitDeviceData */
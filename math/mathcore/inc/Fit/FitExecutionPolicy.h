@@ -2,7 +2,9 @@
 #define ROOT_Fit_FitExecutionPolicy
 namespace ROOT{
    namespace Fit{
-      enum class ExecutionPolicy { kSerial, kMultithread, kMultiprocess };
+      /// kGPU evaluates the chi2 and the unbinned likelihood on a CUDA device, for model functions
+      /// implementing ROOT::Fit::IDeviceModelFunction (see ROOT::Fit::FitDeviceData)
+      enum class ExecutionPolicy { kSerial, kMultithread, kMultiprocess, kGPU };
     }
 }
 
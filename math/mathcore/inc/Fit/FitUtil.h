@@ -24,11 +24,14 @@
 #include "Fit/BinData.h"
 #include "Fit/UnBinData.h"
 #include "Fit/FitExecutionPolicy.h"
+#include "Fit/FitDeviceData.h"
+#include "Fit/DeviceModelFunction.h"
 
 #include "Math/Integrator.h"
 #include "Math/IntegratorMultiDim.h"
 
 #include "TError.h"
+#include <memory>
 #include <vector>
 
 // using parameter cache is not thread safe but needed for normalizing the functions
@@ -302,6 +305,42 @@ namespace FitUtil {
                             ROOT::Fit::ExecutionPolicy executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial,
                             unsigned nChunks = 0);
 
+  /**
+      return the data to be kept on the device by a fit method function with the kGPU execution policy, or
+      nullptr, after changing the policy to kSerial with a warning, if ROOT is built without CUDA support, if no
+      device is present or if the model function does not implement IDeviceModelFunction (isDeviceModel false)
+  */
+  std::shared_ptr<FitDeviceData> CreateDeviceData(bool isDeviceModel, ROOT::Fit::ExecutionPolicy &executionPolicy);
+
+  /**
+      evaluate the Chi2 on a CUDA device (ROOT::Fit::ExecutionPolicy::kGPU), with the data kept resident in devData.
+      Return false, without evaluating it, if the model function does not implement IDeviceModelFunction or if
+      the device or the data options are not supported: the Chi2 must then be evaluated on the CPU
+  */
+  bool EvaluateChi2OnDevice(const IModelFunction &func, const BinData &data, const double *p,
+                            FitDeviceData &devData, double &chi2);
+
+  /**
+      evaluate the Chi2 gradient on a CUDA device. Return false if it is not possible, as EvaluateChi2OnDevice,
+      or if the model function does not provide its parameter derivatives on the device
+  */
+  bool EvaluateChi2GradientOnDevice(const IModelFunction &func, const BinData &data, const double *p, double *grad,
+                                    FitDeviceData &devData);
+
+  /**
+      evaluate the LogL on a CUDA device, with the data kept resident in devData.
+      Return false if it is not possible, as EvaluateChi2OnDevice
+  */
+  bool EvaluateLogLOnDevice(const IModelFunction &func, const UnBinData &data, const double *p, int iWeight,
+                            bool extended, unsigned int &nPoints, FitDeviceData &devData, double &logl);
+
+  /**
+      evaluate the LogL gradient on a CUDA device. Return false if it is not possible, as
+      EvaluateChi2GradientOnDevice
+  */
+  bool EvaluateLogLGradientOnDevice(const IModelFunction &func, const UnBinData &data, const double *p, double *grad,
+                                    FitDeviceData &devData);
+
   // #ifdef R__HAS_VECCORE
   //    template <class NotCompileIfScalarBackend = std::enable_if<!(std::is_same<double, ROOT::Double_v>::value)>>
   //    void EvaluateLogLGradient(const IModelFunctionTempl<ROOT::Double_v> &, const UnBinData &, const double *, double
@@ -869,6 +908,28 @@ namespace FitUtil {
          return -1.;
       }
 
+      // the vectorized model functions are not evaluated on a device: the evaluation is done on the CPU
+      static bool EvalChi2OnDevice(const IModelFunctionTempl<T> &, const BinData &, const double *, FitDeviceData &,
+                                   double &)
+      {
+         return false;
+      }
+      static bool EvalChi2GradientOnDevice(const IModelFunctionTempl<T> &, const BinData &, const double *, double *,
+                                           FitDeviceData &)
+      {
+         return false;
+      }
+      static bool EvalLogLOnDevice(const IModelFunctionTempl<T> &, const UnBinData &, const double *, int, bool,
+                                   unsigned int &, FitDeviceData &, double &)
+      {
+         return false;
+      }
+      static bool EvalLogLGradientOnDevice(const IModelFunctionTempl<T> &, const UnBinData &, const double *,
+                                           double *, FitDeviceData &)
+      {
+         return false;
+      }
+
       // Compute a mask to filter out infinite numbers and NaN values.
       // The argument rval is updated so infinite numbers and NaN values are replaced by
       // maximum finite values (preserving the original sign).
@@ -1456,6 +1517,28 @@ namespace FitUtil {
       {
          FitUtil::EvaluateLogLGradient(func, data, p, g, nPoints, executionPolicy, nChunks);
       }
+
+      static bool EvalChi2OnDevice(const IModelFunctionTempl<double> &func, const BinData &data, const double *p,
+                                   FitDeviceData &devData, double &chi2)
+      {
+         return FitUtil::EvaluateChi2OnDevice(func, data, p, devData, chi2);
+      }
+      static bool EvalChi2GradientOnDevice(const IModelFunctionTempl<double> &func, const BinData &data,
+                                           const double *p, double *g, FitDeviceData &devData)
+      {
+         return FitUtil::EvaluateChi2GradientOnDevice(func, data, p, g, devData);
+      }
+      static bool EvalLogLOnDevice(const IModelFunctionTempl<double> &func, const UnBinData &data, const double *p,
+                                   int iWeight, bool extended, unsigned int &nPoints, FitDeviceData &devData,
+                                   double &logl)
+      {
+         return FitUtil::EvaluateLogLOnDevice(func, data, p, iWeight, extended, nPoints, devData, logl);
+      }
+      static bool EvalLogLGradientOnDevice(const IModelFunctionTempl<double> &func, const UnBinData &data,
+                                           const double *p, double *g, FitDeviceData &devData)
+      {
+         return FitUtil::EvaluateLogLGradientOnDevice(func, data, p, g, devData);
+      }
    };
 
 } // end namespace FitUtil
@@ -63,7 +63,9 @@ public:
       fNEffPoints(0),
       fGrad ( std::vector<double> ( func->NPar() ) ),
       fExecutionPolicy(executionPolicy)
-   {}
+   {
+      InitDeviceData();
+   }
 
       /**
       Constructor from unbin data set and model function (pdf) for object managed by users
@@ -75,7 +77,9 @@ public:
       fNEffPoints(0),
       fGrad ( std::vector<double> ( func.NPar() ) ),
       fExecutionPolicy(executionPolicy)
-   {}
+   {
+      InitDeviceData();
+   }
 
    /**
       Destructor (no operations)
@@ -91,7 +95,8 @@ public:
       fWeight( f.fWeight ),
       fNEffPoints( f.fNEffPoints ),
       fGrad( f.fGrad),
-      fExecutionPolicy(f.fExecutionPolicy)
+      fExecutionPolicy(f.fExecutionPolicy),
+      fDeviceData(f.fDeviceData)
    {  }
 
 
@@ -106,6 +111,7 @@ public:
       fIsExtended = rhs.fIsExtended;
       fWeight = rhs.fWeight;
       fExecutionPolicy = rhs.fExecutionPolicy;
+      fDeviceData = rhs.fDeviceData;
       return *this;
    }
 
@@ -128,8 +134,11 @@ public:
    // need to be virtual to be instantited
    virtual void Gradient(const double *x, double *g) const {
       // evaluate the chi2 gradient
+      if (fDeviceData && FitUtil::Evaluate<typename BaseFCN::T>::EvalLogLGradientOnDevice(
+                            BaseFCN::ModelFunction(), BaseFCN::Data(), x, g, *fDeviceData))
+         return;
       FitUtil::Evaluate<typename BaseFCN::T>::EvalLogLGradient(BaseFCN::ModelFunction(), BaseFCN::Data(), x, g,
-                                                               fNEffPoints, fExecutionPolicy);
+                                                               fNEffPoints, CPUExecutionPolicy());
    }
 
    /// get type of fit method function
@@ -148,6 +157,17 @@ public:
 
 protected:
 
+   /// create the data kept on the device with the GPU execution policy
+   void InitDeviceData() {
+      fDeviceData = FitUtil::CreateDeviceData(
+         dynamic_cast<const IDeviceModelFunction *>(&BaseFCN::ModelFunction()) != nullptr, fExecutionPolicy);
+   }
+
+   /// execution policy of the evaluations on the CPU: with the GPU policy, the ones which cannot be done on the device
+   ::ROOT::Fit::ExecutionPolicy CPUExecutionPolicy() const {
+      return (fExecutionPolicy == ::ROOT::Fit::ExecutionPolicy::kGPU) ? ::ROOT::Fit::ExecutionPolicy::kSerial
+                                                                      : fExecutionPolicy;
+   }
 
 private:
 
@@ -156,7 +176,11 @@ private:
     */
    virtual double DoEval (const double * x) const {
       this->UpdateNCalls();
-      return FitUtil::Evaluate<T>::EvalLogL(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fWeight, fIsExtended, fNEffPoints, fExecutionPolicy);
+      double logl = 0;
+      if (fDeviceData && FitUtil::Evaluate<T>::EvalLogLOnDevice(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fWeight,
+                                                                fIsExtended, fNEffPoints, *fDeviceData, logl))
+         return logl;
+      return FitUtil::Evaluate<T>::EvalLogL(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fWeight, fIsExtended, fNEffPoints, CPUExecutionPolicy());
    }
 
    // for derivatives
@@ -176,6 +200,7 @@ private:
    mutable std::vector<double> fGrad; // for derivatives
 
    ::ROOT::Fit::ExecutionPolicy fExecutionPolicy; // Execution policy
+   std::shared_ptr<FitDeviceData> fDeviceData; // data resident on the device, with the GPU execution policy
 };
       // define useful typedef's
       // using LogLikelihoodFunction_v = LogLikelihoodFCN<ROOT::Math::IMultiGenFunction, ROOT::Math::IParametricFunctionMultiDimTempl<T>>;
@@ -67,7 +67,14 @@ public:
       fNEffPoints(0),
       fGrad ( std::vector<double> ( func->NPar() ) ),
       fExecutionPolicy(executionPolicy)
-   { }
+   {
+      if (fExecutionPolicy == ::ROOT::Fit::ExecutionPolicy::kGPU) {
+         // the binned likelihood is not evaluated on a device
+         Warning("PoissonLikelihoodFCN", "GPU execution policy is not supported for binned likelihood fits. "
+                                         "Changing to ROOT::Fit::ExecutionPolicy::kSerial.");
+         fExecutionPolicy = ::ROOT::Fit::ExecutionPolicy::kSerial;
+      }
+   }
 
    /**
       Constructor from unbin data set and model function (pdf) managed by the users
@@ -79,7 +86,14 @@ public:
       fNEffPoints(0),
       fGrad ( std::vector<double> ( func.NPar() ) ),
       fExecutionPolicy(executionPolicy)
-   { }
+   {
+      if (fExecutionPolicy == ::ROOT::Fit::ExecutionPolicy::kGPU) {
+         // the binned likelihood is not evaluated on a device
+         Warning("PoissonLikelihoodFCN", "GPU execution policy is not supported for binned likelihood fits. "
+                                         "Changing to ROOT::Fit::ExecutionPolicy::kSerial.");
+         fExecutionPolicy = ::ROOT::Fit::ExecutionPolicy::kSerial;
+      }
+   }
 
 
    /**
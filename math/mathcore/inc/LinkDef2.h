@@ -72,6 +72,7 @@
 #pragma link C++ class ROOT::Math::Random<ROOT::Math::MixMaxEngine<17,0>>+;
 #pragma link C++ class ROOT::Math::Random<ROOT::Math::MixMaxEngine<17,1>>+;
 #pragma link C++ class ROOT::Math::Random<ROOT::Math::MixMaxEngine<17,2>>+;
+#pragma link C++ class ROOT::Math::RandomStreams<ROOT::Math::MixMaxEngine<240,0>>+;
 
 // #pragma link C++ typedef ROOT::Math::RandomMT19937;
 // #pragma link C++ typedef ROOT::Math::RandomMT64;
@@ -18,6 +18,8 @@
 
 #include "Math/VirtualIntegrator.h"
 
+#include "Fit/FitExecutionPolicy.h"
+
 namespace ROOT {
 namespace Math {
 
@@ -61,6 +63,15 @@ An integration rule of degree seven is used together with a certain
 strategy of subdivision.
 For a more detailed description of the method see References.
 
+### Evaluation of the integrand:
+
+The 2^n + 2n(n+1) + 1 points of the integration rule of a region are evaluated together with
+IMultiGenFunction::EvalBatch, which the integrand can re-implement to evaluate many points at once.
+When a region is divided, the points of its two halves are evaluated in the same batch.
+With the execution policy ROOT::Fit::ExecutionPolicy::kMultithread (see SetExecutionPolicy) and the
+implicit multithreading enabled, the batches are split among the threads of the IMT pool: the integrand
+must then be thread safe.
+
 ### Notes:
 
   1..Multi-dimensional integration is time-consuming. For each rectangular
@@ -169,6 +180,13 @@ public:
    /// set the options
    void SetOptions(const ROOT::Math::IntegratorMultiDimOptions & opt);
 
+   /// set the execution policy of the integrand evaluations: ROOT::Fit::ExecutionPolicy::kSerial (default)
+   /// or ROOT::Fit::ExecutionPolicy::kMultithread, which requires a thread-safe integrand and IMT
+   void SetExecutionPolicy(ROOT::Fit::ExecutionPolicy policy);
+
+   /// return the execution policy of the integrand evaluations
+   ROOT::Fit::ExecutionPolicy GetExecutionPolicy() const { return fExecutionPolicy; }
+
    ///  get the option used for the integration
    ROOT::Math::IntegratorMultiDimOptions Options() const;
 
@@ -177,6 +195,9 @@ protected:
    // internal function to compute the integral (if absVal is true compute abs value of function integral
    double DoIntegral(const double* xmin, const double * xmax, bool absVal = false);
 
+   // evaluate the integrand at the npoints points x, according to the execution policy
+   void EvalRulePoints(unsigned int npoints, const double *x, double *f) const;
+
  private:
 
    unsigned int fDim;     // dimensionality of integrand
@@ -193,6 +214,7 @@ protected:
    int fStatus;           // status of algorithm (error if not zero)
 
    const IMultiGenFunction* fFun;   // pointer to integrand function
+   ROOT::Fit::ExecutionPolicy fExecutionPolicy; // execution policy of the integrand evaluations
 
 };
 
@@ -95,6 +95,9 @@ public:
    /// Return the Interpolated z value corresponding to the (x,y) point
    double  Interpolate(double x, double y);
 
+   /// Interpolate the z values of n (x,y) points
+   void    Interpolate(int n, const double *x, const double *y, double *z);
+
    /// Find all triangles 
    void      FindAllTriangles();
 
@@ -122,7 +125,7 @@ private:
    // internal methods
 
    
-   inline double Linear_transform(double x, double offset, double factor){
+   inline double Linear_transform(double x, double offset, double factor) const {
 	   return (x+offset)*factor;
    }
 
@@ -133,8 +136,12 @@ private:
    /// use Triangle or CGAL if flag is set 
    void DoFindTriangles();
 
+   /// internal method to interpolate a point after the triangles have been found,
+   /// starting the search of its triangle from the triangle hint (or -1)
+   double  DoInterpolate(double x, double y, int &hint) const;
+
    /// internal method to compute the interpolation
-   double  DoInterpolateNormalized(double x, double y);
+   double  DoInterpolateNormalized(double x, double y, int &hint) const;
 
 
    
@@ -271,6 +278,16 @@ protected:
    double fYCellStep; //! inverse denominator to calculate X cell = fNCells / (fYNmax - fYNmin)
    std::set<UInt_t> fCells[(fNCells+1)*(fNCells+1)]; //! grid cells with containing triangles
 
+   /* The neighbors of the triangles are used to walk from the triangle of the previous point
+    * to the one of the next point, which is faster than the search in the grid cells for the
+    * close points interpolated in batch
+    *
+    * fNeighbors[3*t + i] is the triangle opposite to the vertex i of triangle t, or -1 on the hull
+    */
+
+   static const int fMaxWalk = 64; //! maximum number of steps of a walk before searching the grid cells
+   std::vector<int> fNeighbors; //! neighbors of the triangles
+
    inline unsigned int Cell(UInt_t x, UInt_t y) const {
 	   return x*(fNCells+1) + y;
    }
@@ -94,6 +94,16 @@ namespace ROOT {
             return DoEval(x);
          }
 
+         /**
+            Evaluate the function at the n points x[i * NDim()], with i < n, and write the values in f[i].
+            Use the private virtual method DoEvalBatch, which evaluates the points one by one and can be
+            re-implemented by the sub-classes to evaluate them together (e.g. with vectorized code)
+         */
+         void EvalBatch(unsigned int n, const T *x, T *f) const
+         {
+            DoEvalBatch(n, x, f);
+         }
+
 #ifdef LATER
          /**
             Template method to eveluate the function using the begin of an iterator
@@ -115,6 +125,16 @@ namespace ROOT {
          */
          virtual T DoEval(const T *x) const = 0;
 
+         /**
+            Implementation of the evaluation of a batch of points. By default call DoEval for each point
+         */
+         virtual void DoEvalBatch(unsigned int n, const T *x, T *f) const
+         {
+            const unsigned int ndim = NDim();
+            for (unsigned int i = 0; i < n; ++i)
+               f[i] = DoEval(x + i * ndim);
+         }
+
 
       };
 
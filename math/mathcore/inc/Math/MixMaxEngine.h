@@ -131,13 +131,17 @@ http://dx.doi.org/10.1016/j.chaos.2016.05.003
          /// set the generator seed
          void  SetSeed(Result_t seed);
 
+         /// set the generator seed and the stream number. The streams of a seed are guaranteed not to overlap,
+         /// and the stream 0 is the sequence of SetSeed(seed). See ROOT::Math::RandomStreams.
+         void  SetSeed(Result_t seed, Result_t stream);
+
          // generate a random number (virtual interface)
          virtual double Rndm() { return Rndm_impl(); }
 
          /// generate a double random number (faster interface)
          inline double operator() () { return Rndm_impl(); }
 
-         /// generate an array of random numbers
+         /// generate an array of random numbers, the same as n calls to Rndm() but faster
          void RndmArray (int n, double * array);
 
          /// generate a 64  bit integer number
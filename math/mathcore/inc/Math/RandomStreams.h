@@ -0,0 +1,86 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2020 , ROOT MathLib Team                             *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Header file for class RandomStreams
+
+#ifndef ROOT_Math_RandomStreams
+#define ROOT_Math_RandomStreams
+
+#include "Math/MixMaxEngine.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace ROOT {
+namespace Math {
+
+/**
+   Source of independent and reproducible streams of random numbers, for the parallel generation of
+   toy Monte Carlo samples.
+
+   Every stream, identified by a 64 bit number, is a MIXMAX generator seeded with the seed of the
+   RandomStreams object and the stream number, using the skip-ahead of the MIXMAX generators: the
+   sequences of the different streams are guaranteed not to overlap, and a stream is the same sequence
+   whatever the thread which uses it. The stream 0 is the sequence of a generator seeded with
+   `SetSeed(seed)`.
+
+   To keep the results reproducible, the streams must be chosen by the index of the task (e.g. the toy
+   number, or the slot number of a RDataFrame) and not by the thread which runs it:
+
+   ~~~{.cpp}
+   ROOT::Math::RandomStreams<> streams(4357);
+   ROOT::TThreadExecutor pool;
+   pool.Foreach([&](unsigned int itoy) {
+      auto engine = streams.GetStream(itoy);
+      std::vector<double> x(1000);
+      engine->RndmArray(x.size(), x.data());
+      ...
+   }, ROOT::TSeqU(ntoys));
+   ~~~
+
+   The stream can also seed the engine of a ROOT::Math::Random object, to generate the other distributions:
+
+   ~~~{.cpp}
+   ROOT::Math::Random<ROOT::Math::MixMaxEngine240> rnd;
+   streams.SeedStream(rnd.Rng(), itoy);
+   double x = rnd.Gaus(0, 1);
+   ~~~
+
+   @ingroup Random
+*/
+
+template <class Engine = MixMaxEngine<240, 0>>
+class RandomStreams {
+
+public:
+   explicit RandomStreams(uint64_t seed = 1) : fSeed(seed) {}
+
+   /// seed of the streams
+   uint64_t GetSeed() const { return fSeed; }
+
+   /// seed the engine to generate the stream number stream
+   void SeedStream(Engine &engine, uint64_t stream) const { engine.SetSeed(fSeed, stream); }
+
+   /// return a new engine generating the stream number stream
+   std::unique_ptr<Engine> GetStream(uint64_t stream) const
+   {
+      std::unique_ptr<Engine> engine(new Engine(fSeed));
+      if (stream != 0)
+         SeedStream(*engine, stream);
+      return engine;
+   }
+
+private:
+   uint64_t fSeed; ///< seed of all the streams
+};
+
+} // namespace Math
+} // namespace ROOT
+
+#endif
@@ -91,6 +91,12 @@ namespace ROOT {
             return Rndm();
          }
 
+         /// generate an array of random numbers
+         void RndmArray(int n, double * array) {
+            for (int i = 0; i < n; ++i)
+               array[i] = Rndm();
+         }
+
          Result_t IntRndm() {
             return fGen();
          }
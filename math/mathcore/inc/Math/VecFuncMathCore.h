@@ -0,0 +1,326 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_Math_VecFuncMathCore
+#define ROOT_Math_VecFuncMathCore
+
+#include "Math/Types.h"
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+/**
+\file Math/VecFuncMathCore.h
+\ingroup SpecFunc
+Vectorizable versions of the special functions and of the statistical functions of MathCore
+that are used in the inner loops of the likelihood evaluations.
+
+The functions of the namespace ROOT::Math::Vec are templates which can be instantiated with
+`double` or with ROOT::Double_v, in which case all the lanes are evaluated without branches and
+the different ranges of the approximations are combined with masks. They use the same Cephes
+rational approximations as the scalar functions of ROOT::Math, so that for the same argument
+they agree with them to a few units in the last place:
+
+| Function                 | Accuracy with respect to the scalar ROOT::Math function                |
+|--------------------------|------------------------------------------------------------------------|
+| erf, erfc                | relative 1e-15                                                         |
+| lgamma                   | relative 1e-15, absolute 1e-15 near the zeros at 1 and 2               |
+|                          | absolute 1e-13 for x < 0, which always uses the reflection formula     |
+| normal_pdf               | relative 1e-15                                                         |
+| normal_cdf, normal_cdf_c | relative 1e-15                                                         |
+| poisson_pdf              | relative 1e-15                                                         |
+
+The array overloads evaluate a function for n values, using ROOT::Double_v for the bulk of
+the array and the scalar instantiation for the remainder, so that the result of an element does
+not depend on its position in the array. Without VecCore, ROOT::Double_v is `double` and the
+functions are evaluated one value at a time.
+*/
+
+namespace ROOT {
+namespace Math {
+namespace Vec {
+
+namespace Internal {
+
+#ifdef R__HAS_VECCORE
+template <class T>
+inline T Select(const vecCore::Mask<T> &mask, const T &a, const T &b)
+{
+   return vecCore::Blend<T>(mask, a, b);
+}
+template <class T>
+inline T Abs(const T &x)
+{
+   return vecCore::math::Abs(x);
+}
+template <class T>
+inline T Exp(const T &x)
+{
+   return vecCore::math::Exp(x);
+}
+template <class T>
+inline T Log(const T &x)
+{
+   return vecCore::math::Log(x);
+}
+template <class T>
+inline T Floor(const T &x)
+{
+   return vecCore::math::Floor(x);
+}
+template <class T>
+inline T Sin(const T &x)
+{
+   return vecCore::math::Sin(x);
+}
+#else
+template <class T>
+inline T Select(bool mask, const T &a, const T &b)
+{
+   return mask ? a : b;
+}
+template <class T>
+inline T Abs(const T &x)
+{
+   return std::abs(x);
+}
+template <class T>
+inline T Exp(const T &x)
+{
+   return std::exp(x);
+}
+template <class T>
+inline T Log(const T &x)
+{
+   return std::log(x);
+}
+template <class T>
+inline T Floor(const T &x)
+{
+   return std::floor(x);
+}
+template <class T>
+inline T Sin(const T &x)
+{
+   return std::sin(x);
+}
+#endif
+
+/// Polynomial c[0] x^(N-1) + ... + c[N-1]
+template <class T, std::size_t N>
+inline T Polynomial(const T &x, const double (&c)[N])
+{
+   T res(c[0]);
+   for (std::size_t i = 1; i < N; ++i)
+      res = res * x + T(c[i]);
+   return res;
+}
+
+/// Polynomial x^N + c[0] x^(N-1) + ... + c[N-1], with implicit leading coefficient 1
+template <class T, std::size_t N>
+inline T Polynomial1(const T &x, const double (&c)[N])
+{
+   T res = x + T(c[0]);
+   for (std::size_t i = 1; i < N; ++i)
+      res = res * x + T(c[i]);
+   return res;
+}
+
+/// Error function for |x| <= 1, as in ROOT::Math::Cephes::erf
+template <class T>
+T ErfSmall(const T &x)
+{
+   static const double kT[] = {9.60497373987051638749E0, 9.00260197203842689217E1, 2.23200534594684319226E3,
+                               7.00332514112805075473E3, 5.55923013010394962768E4};
+   static const double kU[] = {3.35617141647503099647E1, 5.21357949780152679795E2, 4.59432382970980127987E3,
+                               2.26290000613890934246E4, 4.92673942608635921086E4};
+   const T z = x * x;
+   return x * Polynomial(z, kT) / Polynomial1(z, kU);
+}
+
+/// Complementary error function for |a| >= 1, as in ROOT::Math::Cephes::erfc
+template <class T>
+T ErfcLarge(const T &a)
+{
+   static const double kP[] = {2.46196981473530512524E-10, 5.64189564831068821977E-1, 7.46321056442269912687E0,
+                               4.86371970985681366614E1,   1.96520832956077098242E2,  5.26445194995477358631E2,
+                               9.34528527171957607540E2,   1.02755188689515710272E3,  5.57535335369399327526E2};
+   static const double kQ[] = {1.32281951154744992508E1, 8.67072140885989742329E1, 3.54937778887819891062E2,
+                               9.75708501743205489753E2, 1.82390916687909736289E3, 2.24633760818710981792E3,
+                               1.65666309194161350182E3, 5.57535340817727675546E2};
+   static const double kR[] = {5.64189583547755073984E-1, 1.27536670759978104416E0, 5.01905042251180477414E0,
+                               6.16021097993053585195E0,  7.40974269950448939160E0, 2.97886665372100240670E0};
+   static const double kS[] = {2.26052863220117276590E0, 9.39603524938001434673E0, 1.20489539808096656605E1,
+                               1.70814450747565897222E1, 9.60896809063285878198E0, 3.36907645100081516050E0};
+   const double kMaxLog = 709.782712893383973096206318587;
+
+   const T x = Abs(a);
+   const T z = a * a;
+   const auto lower = x < T(8.);
+   const T p = Select(lower, Polynomial(x, kP), Polynomial(x, kR));
+   const T q = Select(lower, Polynomial1(x, kQ), Polynomial1(x, kS));
+   const T y = Select(z > T(kMaxLog), T(0.), (Exp(-z) * p) / q);
+   return Select(a < T(0.), T(2.) - y, y);
+}
+
+/// Logarithm of the gamma function for x > 0, as in ROOT::Math::Cephes::lgam
+template <class T>
+T LogGammaPositive(const T &x)
+{
+   static const double kA[] = {8.11614167470508450300E-4, -5.95061904284301438324E-4, 7.93650340457716943945E-4,
+                               -2.77777777730099687205E-3, 8.33333333333331927722E-2};
+   static const double kB[] = {-1.37825152569120859100E3, -3.88016315134637840924E4, -3.31612992738871184744E5,
+                               -1.16237097492762307383E6, -1.72173700820839662146E6, -8.53555664245765465627E5};
+   static const double kC[] = {-3.51815701436523470549E2, -1.70642106651881159223E4, -2.20528590553854454839E5,
+                               -1.13933444367982507207E6, -2.53252307177582951285E6, -2.01889141433532773231E6};
+   const double kLS2PI = 0.91893853320467274178;
+   const double kMaxLgm = 2.556348e305;
+
+   // below 13: reduce the argument to [2, 3) with the recurrence of the gamma function,
+   // with a fixed number of masked steps so that all the lanes follow the same path
+   const auto small = x < T(13.);
+   T u = Select(small, x, T(2.5));
+   T z(1.);
+   for (int i = 0; i < 2; ++i) {
+      const auto up = u < T(2.);
+      z = Select(up, z / u, z);
+      u = Select(up, u + T(1.), u);
+   }
+   for (int i = 0; i < 10; ++i) {
+      const auto down = u >= T(3.);
+      u = Select(down, u - T(1.), u);
+      z = Select(down, z * u, z);
+   }
+   const T w = u - T(2.);
+   const T resSmall = Log(z) + w * Polynomial(w, kB) / Polynomial1(w, kC);
+
+   // Stirling's formula above 13
+   const T y = Select(small, T(13.), x);
+   const T p = T(1.) / (y * y);
+   const T resLarge = (y - T(0.5)) * Log(y) - y + T(kLS2PI) + Polynomial(p, kA) / y;
+
+   T res = Select(small, resSmall, resLarge);
+   return Select(x > T(kMaxLgm), T(std::numeric_limits<double>::infinity()), res);
+}
+
+} // namespace Internal
+
+////////////////////////////////////////////////////////////////////////////////
+/// Error function, see ROOT::Math::erf.
+
+template <class T>
+T erf(const T &x)
+{
+   const T ax = Internal::Abs(x);
+   const auto large = ax > T(1.);
+   // the arguments of the lanes evaluated with the other approximation are moved into its range
+   return Internal::Select(large, T(1.) - Internal::ErfcLarge(Internal::Select(large, x, T(2.))),
+                           Internal::ErfSmall(Internal::Select(large, T(0.), x)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Complementary error function, see ROOT::Math::erfc.
+
+template <class T>
+T erfc(const T &x)
+{
+   const T ax = Internal::Abs(x);
+   const auto small = ax < T(1.);
+   return Internal::Select(small, T(1.) - Internal::ErfSmall(Internal::Select(small, x, T(0.))),
+                           Internal::ErfcLarge(Internal::Select(small, T(2.), x)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Logarithm of the absolute value of the gamma function, see ROOT::Math::lgamma.
+/// Returns +inf at the non-positive integers.
+
+template <class T>
+T lgamma(const T &x)
+{
+   const double kPi = 3.14159265358979323846;
+   const T q = Internal::Abs(x);
+   const T lq = Internal::LogGammaPositive(Internal::Select(q > T(0.), q, T(1.)));
+
+   // reflection formula for negative x, with the sine evaluated at the distance to the nearest integer
+   const T fl = Internal::Floor(q);
+   T d = q - fl;
+   d = Internal::Select(d > T(0.5), T(1.) - d, d);
+   const T s = q * Internal::Sin(T(kPi) * d);
+   const T lneg = T(std::log(kPi)) - Internal::Log(Internal::Select(s > T(0.), s, T(1.))) - lq;
+
+   const T inf(std::numeric_limits<double>::infinity());
+   const T res = Internal::Select(x < T(0.), lneg, lq);
+   return Internal::Select(x <= T(0.) && fl == q, inf, res);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Probability density function of the normal distribution, see ROOT::Math::normal_pdf.
+
+template <class T>
+T normal_pdf(const T &x, double sigma = 1, double x0 = 0)
+{
+   const T tmp = (x - T(x0)) / T(sigma);
+   return T(1. / (std::sqrt(2 * 3.14159265358979323846) * std::abs(sigma))) * Internal::Exp(T(-0.5) * tmp * tmp);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Cumulative distribution function of the normal distribution (lower tail), see ROOT::Math::normal_cdf.
+
+template <class T>
+T normal_cdf(const T &x, double sigma = 1, double x0 = 0)
+{
+   const T z = (x - T(x0)) / T(sigma * 1.41421356237309504880);
+   return Internal::Select(z < T(-1.), T(0.5) * erfc(-z), T(0.5) * (T(1.) + erf(z)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Complement of the cumulative distribution function of the normal distribution (upper tail),
+/// see ROOT::Math::normal_cdf_c.
+
+template <class T>
+T normal_cdf_c(const T &x, double sigma = 1, double x0 = 0)
+{
+   const T z = (x - T(x0)) / T(sigma * 1.41421356237309504880);
+   return Internal::Select(z > T(1.), T(0.5) * erfc(z), T(0.5) * (T(1.) - erf(z)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Probability density function of the Poisson distribution for n events with mean mu,
+/// see ROOT::Math::poisson_pdf. The number of events n is taken as a floating point value,
+/// which is expected to be a non-negative integer. Returns NaN for mu < 0.
+
+template <class T>
+T poisson_pdf(const T &n, const T &mu)
+{
+   const auto positive = n > T(0.);
+   const T safeMu = Internal::Select(mu > T(0.), mu, T(1.));
+   const T res = Internal::Select(positive, Internal::Exp(n * Internal::Log(safeMu) - lgamma(n + T(1.)) - mu),
+                                  Internal::Exp(-mu));
+   // for n > 0 and mu = 0 the probability is 0
+   const T zero(0.);
+   const T nan(std::numeric_limits<double>::quiet_NaN());
+   return Internal::Select(mu < zero, nan, Internal::Select(positive && mu == zero, zero, res));
+}
+
+/// \name Evaluation for arrays of n values
+///@{
+void erf(std::size_t n, const double *x, double *result);
+void erfc(std::size_t n, const double *x, double *result);
+void lgamma(std::size_t n, const double *x, double *result);
+void normal_pdf(std::size_t n, const double *x, double *result, double sigma = 1, double x0 = 0);
+void normal_cdf(std::size_t n, const double *x, double *result, double sigma = 1, double x0 = 0);
+void normal_cdf_c(std::size_t n, const double *x, double *result, double sigma = 1, double x0 = 0);
+void poisson_pdf(std::size_t n, const double *k, const double *mu, double *result);
+///@}
+
+} // namespace Vec
+} // namespace Math
+} // namespace ROOT
+
+#endif
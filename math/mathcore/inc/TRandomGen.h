@@ -61,10 +61,17 @@ public:
    using TRandom::Rndm; 
    virtual  Double_t Rndm( ) { return fEngine(); }
    virtual  void     RndmArray(Int_t n, Float_t *array) {
-      for (int i = 0; i < n; ++i) array[i] = fEngine(); 
+      // generate the numbers in batches with the array interface of the engine
+      const Int_t kBufferSize = 256;
+      Double_t buffer[kBufferSize];
+      for (Int_t i = 0; i < n; i += kBufferSize) {
+         const Int_t m = (n - i < kBufferSize) ? n - i : kBufferSize;
+         fEngine.RndmArray(m, buffer);
+         for (Int_t j = 0; j < m; ++j) array[i + j] = buffer[j];
+      }
    }
    virtual  void     RndmArray(Int_t n, Double_t *array) {
-            for (int i = 0; i < n; ++i) array[i] = fEngine(); 
+      fEngine.RndmArray(n, array);
    }
    virtual  void     SetSeed(ULong_t seed=0) {
       fEngine.SetSeed(seed);
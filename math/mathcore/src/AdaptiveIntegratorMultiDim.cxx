@@ -8,10 +8,85 @@
 
 #include <cmath>
 #include <algorithm>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 namespace ROOT {
 namespace Math {
 
+namespace {
+
+const double xl2 = 0.358568582800318073;//lambda_2
+const double xl4 = 0.948683298050513796;//lambda_4
+const double xl5 = 0.688247201611685289;//lambda_5
+
+// Write in x the 2^n + 2n(n+1) + 1 points of the integration rule of the region of center ctr and half
+// widths wth, in the order in which DoIntegral combines their values: the center, the 4 points along each
+// axis, the 2n(n-1) points on the planes of two axes and the 2^n corners of the inner hypercube
+void FillRulePoints(unsigned int n, const double *ctr, const double *wth, double *x)
+{
+   double z[15], wthl[15];
+   unsigned int j, j1, k, l, m;
+   auto addPoint = [&]() {
+      std::copy(z, z + n, x);
+      x += n;
+   };
+
+   for (j=0; j<n; j++) z[j] = ctr[j];
+   addPoint();
+
+   for (j=0; j<n; j++) {
+      z[j]    = ctr[j] - xl2*wth[j];
+      addPoint();
+      z[j]    = ctr[j] + xl2*wth[j];
+      addPoint();
+      wthl[j] = xl4*wth[j];
+      z[j]    = ctr[j] - wthl[j];
+      addPoint();
+      z[j]    = ctr[j] + wthl[j];
+      addPoint();
+      z[j]    = ctr[j];
+   }
+
+   for (j=1;j<n;j++) {
+      j1 = j-1;
+      for (k=j;k<n;k++) {
+         for (l=0;l<2;l++) {
+            wthl[j1] = -wthl[j1];
+            z[j1]    = ctr[j1] + wthl[j1];
+            for (m=0;m<2;m++) {
+               wthl[k] = -wthl[k];
+               z[k]    = ctr[k] + wthl[k];
+               addPoint();
+            }
+         }
+         z[k] = ctr[k];
+      }
+      z[j1] = ctr[j1];
+   }
+
+   // end nodes ~gray codes; the signs are kept apart, to have all the 2^n points also for null widths
+   bool neg[15];
+   for (j=0;j<n;j++) {
+      neg[j] = true;
+      z[j] = ctr[j] - xl5*wth[j];
+   }
+   do {
+      addPoint();
+      for (j=0;j<n;j++) {
+         neg[j] = !neg[j];
+         z[j] = neg[j] ? ctr[j] - xl5*wth[j] : ctr[j] + xl5*wth[j];
+         if (!neg[j]) break;
+      }
+   } while (j < n);
+}
+
+} // anonymous namespace
+
 
 
 AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim(double absTol, double relTol, unsigned int maxpts, unsigned int size):
@@ -25,7 +100,8 @@ AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim(double absTol, double rel
    fError(0), fRelError(0),
    fNEval(0),
    fStatus(-1),
-   fFun(0)
+   fFun(0),
+   fExecutionPolicy(ROOT::Fit::ExecutionPolicy::kSerial)
 {
    // constructor - without passing a function
    if (fAbsTol < 0) fAbsTol = ROOT::Math::IntegratorMultiDimOptions::DefaultAbsTolerance();
@@ -45,7 +121,8 @@ AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim( const IMultiGenFunction
    fError(0), fRelError(0),
    fNEval(0),
    fStatus(-1),
-   fFun(&f)
+   fFun(&f),
+   fExecutionPolicy(ROOT::Fit::ExecutionPolicy::kSerial)
 {
    // constructur passing a multi-dimensional function interface
    // constructor - without passing a function
@@ -72,6 +149,43 @@ void AdaptiveIntegratorMultiDim::SetRelTolerance(double relTol){ this->fRelTol =
 
 void AdaptiveIntegratorMultiDim::SetAbsTolerance(double absTol){ this->fAbsTol = absTol; }
 
+void AdaptiveIntegratorMultiDim::SetExecutionPolicy(ROOT::Fit::ExecutionPolicy policy)
+{
+   // set the execution policy of the integrand evaluations
+   if (policy != ROOT::Fit::ExecutionPolicy::kSerial && policy != ROOT::Fit::ExecutionPolicy::kMultithread) {
+      MATH_ERROR_MSG("AdaptiveIntegratorMultiDim::SetExecutionPolicy","Only the serial and multithread policies are supported");
+      return;
+   }
+#ifndef R__USE_IMT
+   if (policy == ROOT::Fit::ExecutionPolicy::kMultithread) {
+      MATH_WARN_MSG("AdaptiveIntegratorMultiDim::SetExecutionPolicy","Multithread execution policy requires IMT, which is disabled. Using the serial policy");
+      policy = ROOT::Fit::ExecutionPolicy::kSerial;
+   }
+#endif
+   fExecutionPolicy = policy;
+}
+
+void AdaptiveIntegratorMultiDim::EvalRulePoints(unsigned int npoints, const double *x, double *f) const
+{
+   // evaluate the integrand at the npoints points x, in parallel chunks if the policy is multithread
+#ifdef R__USE_IMT
+   if (fExecutionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread && ROOT::IsImplicitMTEnabled()) {
+      const unsigned int nChunks = std::min(npoints, ROOT::GetThreadPoolSize());
+      const unsigned int ndim = fDim;
+      const IMultiGenFunction *func = fFun;
+      auto evalChunk = [=](unsigned int ichunk) {
+         const unsigned int begin = ichunk*npoints/nChunks;
+         const unsigned int end = (ichunk+1)*npoints/nChunks;
+         func->EvalBatch(end - begin, x + begin*ndim, f + begin);
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(evalChunk, ROOT::TSeq<unsigned int>(0, nChunks));
+      return;
+   }
+#endif
+   fFun->EvalBatch(npoints, x, f);
+}
+
 
 double AdaptiveIntegratorMultiDim::DoIntegral(const double* xmin, const double * xmax, bool absValue)
 {
@@ -96,11 +210,8 @@ double AdaptiveIntegratorMultiDim::DoIntegral(const double* xmin, const double *
    double relerr; //an estimation of the relative accuracy of the result
 
 
-   double ctr[15], wth[15], wthl[15], z[15];
+   double ctr[15], wth[15], ctr2[15];
 
-   static const double xl2 = 0.358568582800318073;//lambda_2
-   static const double xl4 = 0.948683298050513796;//lambda_4
-   static const double xl5 = 0.688247201611685289;//lambda_5
    static const double w2  = 980./6561; //weights/2^n
    static const double w4  = 200./19683;
    static const double wp2 = 245./486;//error weights/2^n
@@ -180,37 +291,50 @@ double AdaptiveIntegratorMultiDim::DoIntegral(const double* xmin, const double *
    double rgnvol, sum1, sum2, sum3, sum4, sum5, difmax, f2, f3, dif, aresult;
    double rgncmp=0, rgnval, rgnerr;
 
-   unsigned int j1, k, l, m, idvaxn=0, idvax0=0, isbtmp, isbtpp;
+   unsigned int k, idvaxn=0, idvax0=0, isbtmp, isbtpp;
 
    //InitArgs(z,fParams);
 
+   // rule points and integrand values of a region, and of the second half of a divided region
+   std::vector<double> points(2*irlcls*n);
+   std::vector<double> fvalues(2*irlcls);
+   bool secondHalf = kFALSE;
+   const double *fval;
+   auto val = [&](unsigned int i) { return absValue ? std::abs(fval[i]) : fval[i]; };
+
 L20:
    rgnvol = twondm;//=2^n
    for (j=0; j<n; j++) {
       rgnvol *= wth[j]; //region volume
-      z[j]    = ctr[j]; //temporary node
    }
-   sum1 = (*fFun)((const double*)z);//EvalPar(z,fParams); //evaluate function
+   if (ldv) {
+      // first half of a divided region: evaluate in the same batch the points of the second half
+      for (j=0; j<n; j++) ctr2[j] = ctr[j];
+      ctr2[idvax0-1] += 2*wth[idvax0-1];
+      FillRulePoints(n, ctr, wth, points.data());
+      FillRulePoints(n, ctr2, wth, points.data() + irlcls*n);
+      EvalRulePoints(2*irlcls, points.data(), fvalues.data());
+      fval = fvalues.data();
+      secondHalf = kTRUE;
+   } else if (secondHalf) {
+      fval = fvalues.data() + irlcls;
+      secondHalf = kFALSE;
+   } else {
+      FillRulePoints(n, ctr, wth, points.data());
+      EvalRulePoints(irlcls, points.data(), fvalues.data());
+      fval = fvalues.data();
+   }
 
+   // combine the values in the order of the points of FillRulePoints
+   sum1 = fval[0]; //center of the region
    difmax = 0;
    sum2   = 0;
    sum3   = 0;
 
    //loop over coordinates
    for (j=0; j<n; j++) {
-      z[j]    = ctr[j] - xl2*wth[j];
-      if (absValue) f2 = std::abs((*fFun)(z));
-      else          f2 = (*fFun)(z);
-      z[j]    = ctr[j] + xl2*wth[j];
-      if (absValue) f2 += std::abs((*fFun)(z));
-      else          f2 += (*fFun)(z);
-      wthl[j] = xl4*wth[j];
-      z[j]    = ctr[j] - wthl[j];
-      if (absValue) f3 = std::abs((*fFun)(z));
-      else          f3 = (*fFun)(z);
-      z[j]    = ctr[j] + wthl[j];
-      if (absValue) f3 += std::abs((*fFun)(z));
-      else          f3 += (*fFun)(z);
+      f2 = val(1+4*j) + val(2+4*j);
+      f3 = val(3+4*j) + val(4+4*j);
       sum2   += f2;//sum func eval with different weights separately
       sum3   += f3;//for a given region
       dif     = std::abs(7*f2-f3-12*sum1);
@@ -219,42 +343,14 @@ L20:
          difmax=dif;
          idvaxn=j+1;
       }
-      z[j]    = ctr[j];
    }
 
    sum4 = 0;
-   for (j=1;j<n;j++) {
-      j1 = j-1;
-      for (k=j;k<n;k++) {
-         for (l=0;l<2;l++) {
-            wthl[j1] = -wthl[j1];
-            z[j1]    = ctr[j1] + wthl[j1];
-            for (m=0;m<2;m++) {
-               wthl[k] = -wthl[k];
-               z[k]    = ctr[k] + wthl[k];
-               if (absValue) sum4 += std::abs((*fFun)(z));
-               else            sum4 += (*fFun)(z);
-            }
-         }
-         z[k] = ctr[k];
-      }
-      z[j1] = ctr[j1];
-   }
+   k = 1+4*n;
+   for (j=0; j<2*n*(n-1); j++) sum4 += val(k+j);
 
    sum5 = 0;
-
-   for (j=0;j<n;j++) {
-      wthl[j] = -xl5*wth[j];
-      z[j] = ctr[j] + wthl[j];
-   }
-L90: //sum over end nodes ~gray codes
-   if (absValue) sum5 += std::abs((*fFun)(z));
-   else          sum5 += (*fFun)(z);
-   for (j=0;j<n;j++) {
-      wthl[j] = -wthl[j];
-      z[j] = ctr[j] + wthl[j];
-      if (wthl[j] > 0) goto L90;
-   }
+   for (k+=2*n*(n-1); k<irlcls; k++) sum5 += val(k);
 
    rgncmp  = rgnvol*(wpn1[n-2]*sum1+wp2*sum2+wpn3[n-2]*sum3+wp4*sum4);
    rgnval  = wn1[n-2]*sum1+w2*sum2+wn3[n-2]*sum3+w4*sum4+wn5[n-2]*sum5;
@@ -25,6 +25,11 @@
 #include <algorithm>
 #include <stdlib.h>
 
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
 namespace ROOT {
    
    namespace Math {
@@ -111,15 +116,55 @@ double Delaunay2D::Interpolate(double x, double y)
    // needed in this function.
    FindAllTriangles();
 
+   int hint = -1;
+   return DoInterpolate(x, y, hint);
+}
+
+//______________________________________________________________________________
+void Delaunay2D::Interpolate(int n, const double *x, const double *y, double *z)
+{
+   // Return in z the z values corresponding to the n points (x[i],y[i]).
+   // The search of the triangle of a point starts from the triangle of the
+   // previous point, which is fast when the consecutive points are close, as
+   // the bin centres of a histogram. With IMT enabled, chunks of points are
+   // interpolated in parallel.
+
+   FindAllTriangles();
+
+   auto interpolateRange = [=](int begin, int end) {
+      int hint = -1;
+      for (int i = begin; i < end; ++i)
+         z[i] = DoInterpolate(x[i], y[i], hint);
+   };
+
+#ifdef R__USE_IMT
+   // below this number of points per chunk the tasks are not worth it
+   const int minChunkSize = 1024;
+   if (ROOT::IsImplicitMTEnabled() && n >= 2 * minChunkSize) {
+      const int nChunks = std::min<int>(n / minChunkSize, 4 * ROOT::GetThreadPoolSize());
+      auto interpolateChunk = [=](int ichunk) {
+         interpolateRange(Long64_t(ichunk) * n / nChunks, Long64_t(ichunk + 1) * n / nChunks);
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(interpolateChunk, ROOT::TSeq<int>(0, nChunks));
+      return;
+   }
+#endif
+   interpolateRange(0, n);
+}
+
+//______________________________________________________________________________
+double Delaunay2D::DoInterpolate(double x, double y, int &hint) const
+{
    // Find the z value corresponding to the point (x,y).
    double xx, yy;
    xx = Linear_transform(x, fOffsetX, fScaleFactorX); //xx = xTransformer(x);
    yy = Linear_transform(y, fOffsetY, fScaleFactorY); //yy = yTransformer(y);
-   double zz = DoInterpolateNormalized(xx, yy);
+   double zz = DoInterpolateNormalized(xx, yy, hint);
 
    // Wrong zeros may appear when points sit on a regular grid.
    // The following line try to avoid this problem.
-   if (zz==0) zz = DoInterpolateNormalized(xx+0.0001, yy);
+   if (zz==0) zz = DoInterpolateNormalized(xx+0.0001, yy, hint);
 
    return zz;
 }
@@ -207,15 +252,12 @@ void Delaunay2D::DoFindTriangles() {
 }
 
 /// CGAL implementation for interpolation
-double Delaunay2D::DoInterpolateNormalized(double xx, double yy)
+double Delaunay2D::DoInterpolateNormalized(double xx, double yy, int &) const
 {
    // Finds the Delaunay triangle that the point (xi,yi) sits in (if any) and
    // calculate a z-value for it by linearly interpolating the z-values that
    // make up that triangle.
 
-   // initialise the Delaunay algorithm if needed
-    FindAllTriangles();
-
    //coordinate computation
    Point p(xx, yy);
 
@@ -321,9 +363,10 @@ void Delaunay2D::DoFindTriangles() {
       in.pointlist[2 * i + 1] = fYN[i];
    }
 
-   triangulate((char *) "zQN", &in, &out, nullptr);
+   triangulate((char *) "zQNn", &in, &out, nullptr);
 
    fTriangles.resize(out.numberoftriangles);
+   fNeighbors.assign(out.neighborlist, out.neighborlist + 3 * out.numberoftriangles);
    for(int t = 0; t < out.numberoftriangles; ++t){
       Triangle tri;
 
@@ -376,7 +419,9 @@ void Delaunay2D::DoFindTriangles() {
 /// Finds the Delaunay triangle that the point (xi,yi) sits in (if any) and
 /// calculate a z-value for it by linearly interpolating the z-values that
 /// make up that triangle.
-double Delaunay2D::DoInterpolateNormalized(double xx, double yy)
+/// The search walks from the triangle hint towards the point, and falls back
+/// to the triangles of its grid cell. hint is set to the triangle found.
+double Delaunay2D::DoInterpolateNormalized(double xx, double yy, int &hint) const
 {
 
    // relay that ll the triangles have been found
@@ -396,24 +441,51 @@ double Delaunay2D::DoInterpolateNormalized(double xx, double yy)
        return std::get<0>(coords) >= 0 && std::get<1>(coords) >= 0 && std::get<2>(coords) >= 0;
     };
     
+    auto interpolate = [&] (const unsigned int t, const std::tuple<double, double, double> & coords) -> double {
+       //we found the triangle -> interpolate using the barycentric interpolation
+       return std::get<0>(coords) * fZ[fTriangles[t].idx[0]]
+              + std::get<1>(coords) * fZ[fTriangles[t].idx[1]]
+              + std::get<2>(coords) * fZ[fTriangles[t].idx[2]];
+    };
+
    int cX = CellX(xx);
    int cY = CellY(yy);
 
    if(cX < 0 || cX > fNCells || cY < 0 || cY > fNCells)
       return fZout; //TODO some more fancy interpolation here
 
+   // walk towards the point, across the edge opposite to the vertex with the most negative coordinate
+   for (int t = hint, step = 0; t >= 0 && step < fMaxWalk; ++step) {
+      auto coords = bayCoords(t);
+      if (inTriangle(coords)) {
+         hint = t;
+         return interpolate(t, coords);
+      }
+      int v = std::get<0>(coords) < std::get<1>(coords) ? 0 : 1;
+      if (std::get<2>(coords) < (v == 0 ? std::get<0>(coords) : std::get<1>(coords)))
+         v = 2;
+      const int next = fNeighbors[3 * t + v];
+      // the point is beyond an edge of the hull, which is convex
+      if (next < 0) {
+         hint = t;
+         return fZout;
+      }
+      t = next;
+   }
+
     for(unsigned int t : fCells[Cell(cX, cY)]){
        auto coords = bayCoords(t);
 
        if(inTriangle(coords)){
-          //we found the triangle -> interpolate using the barycentric interpolation
-          return std::get<0>(coords) * fZ[fTriangles[t].idx[0]]
-                 + std::get<1>(coords) * fZ[fTriangles[t].idx[1]]
-               + std::get<2>(coords) * fZ[fTriangles[t].idx[2]];
-
+          hint = t;
+          return interpolate(t, coords);
        }
     }
 
+    // the point is outside of the hull, start the next walk from a close triangle
+    if (!fCells[Cell(cX, cY)].empty())
+       hint = *fCells[Cell(cX, cY)].begin();
+
     //debugging
 
     /*
@@ -0,0 +1,367 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2020  LCG ROOT Math Team, CERN/PH-SFT                *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Implementation file for class FitDeviceData
+
+#include "Fit/FitDeviceData.h"
+
+#include "Fit/BinData.h"
+#include "Fit/UnBinData.h"
+#include "Fit/DeviceModelFunction.h"
+
+#ifdef MATHCORE_USE_CUDA
+#include "FitDeviceKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#endif
+
+namespace ROOT {
+
+   namespace Fit {
+
+#ifdef MATHCORE_USE_CUDA
+
+namespace {
+
+/// number of points for which the model is evaluated at once
+constexpr unsigned int kChunkSize = 1 << 22;
+
+/// maximum number of model derivatives stored at once on the device
+constexpr unsigned int kGradientBufferSize = 1 << 23;
+
+} // anonymous namespace
+
+struct FitDeviceData::Impl {
+   double *fCoords = nullptr;     // coordinates, stored by component
+   double *fValues = nullptr;     // bin contents (binned data)
+   double *fInvErrors = nullptr;  // inverse errors of the bin contents (binned data)
+   double *fBinVolumes = nullptr; // normalized bin volumes, if the model is multiplied by them (binned data)
+   double *fWeights = nullptr;    // weights of the points (weighted unbinned data)
+   double *fModel = nullptr;      // model values for a chunk of points
+   double *fModelGrad = nullptr;  // model derivatives for a chunk of points
+   double *fParams = nullptr;     // parameter values
+   double *fPartials = nullptr;   // partial sums of the reductions
+   unsigned int fNParams = 0;     // size of fParams
+   unsigned int fNPartials = 0;   // size of fPartials
+   unsigned int fGradChunk = 0;   // number of points of fModelGrad
+   unsigned int fGradNPar = 0;    // number of parameters of fModelGrad
+   std::vector<double> fHostPartials;
+
+   ~Impl()
+   {
+      for (double *ptr : {fCoords, fValues, fInvErrors, fBinVolumes, fWeights, fModel, fModelGrad, fParams, fPartials})
+         DeviceKernels::Free(ptr);
+   }
+
+   /// allocate n doubles and copy them from the host
+   static double *Upload(const double *src, std::size_t n)
+   {
+      double *ptr = DeviceKernels::Allocate(n);
+      if (ptr && !DeviceKernels::CopyToDevice(ptr, src, n)) {
+         DeviceKernels::Free(ptr);
+         return nullptr;
+      }
+      return ptr;
+   }
+
+   bool SetParameters(const double *p, unsigned int npar)
+   {
+      if (npar > fNParams) {
+         DeviceKernels::Free(fParams);
+         fParams = DeviceKernels::Allocate(npar);
+         fNParams = fParams ? npar : 0;
+         if (!fParams)
+            return false;
+      }
+      return DeviceKernels::CopyToDevice(fParams, p, npar);
+   }
+
+   /// make room for nout partial sums per block
+   bool ReservePartials(unsigned int nout)
+   {
+      const unsigned int n = nout * DeviceKernels::kNBlocks;
+      if (n > fNPartials) {
+         DeviceKernels::Free(fPartials);
+         fPartials = DeviceKernels::Allocate(n);
+         fNPartials = fPartials ? n : 0;
+         if (!fPartials)
+            return false;
+      }
+      fHostPartials.resize(n);
+      return true;
+   }
+
+   /// make room for the model derivatives of npar parameters, return the number of points per chunk
+   unsigned int ReserveModelGradient(unsigned int npar, unsigned int size)
+   {
+      const unsigned int chunk = std::max(1u, std::min({kChunkSize, kGradientBufferSize / npar, size}));
+      if (npar != fGradNPar || chunk != fGradChunk) {
+         DeviceKernels::Free(fModelGrad);
+         fModelGrad = DeviceKernels::Allocate(std::size_t(npar) * chunk);
+         fGradNPar = fModelGrad ? npar : 0;
+         fGradChunk = fModelGrad ? chunk : 0;
+      }
+      return fGradChunk;
+   }
+
+   /// copy the partial sums of nout outputs to the host and add them, in order, to sums[0, nout)
+   bool AddPartials(unsigned int nout, double *sums)
+   {
+      const unsigned int nblocks = DeviceKernels::kNBlocks;
+      if (!DeviceKernels::CopyToHost(fHostPartials.data(), fPartials, nout * nblocks))
+         return false;
+      for (unsigned int k = 0; k < nout; ++k) {
+         for (unsigned int b = 0; b < nblocks; ++b)
+            sums[k] += fHostPartials[k * nblocks + b];
+      }
+      return true;
+   }
+};
+
+FitDeviceData::FitDeviceData() {}
+
+FitDeviceData::~FitDeviceData() {}
+
+bool FitDeviceData::IsAvailable()
+{
+   static const bool available = DeviceKernels::DeviceCount() > 0;
+   return available;
+}
+
+bool FitDeviceData::IsResident(const FitData &data) const
+{
+   return fImpl && fData == &data && fSize == data.Size();
+}
+
+void FitDeviceData::Clear()
+{
+   fImpl.reset();
+   fData = nullptr;
+   fSize = 0;
+}
+
+bool FitDeviceData::Upload(const BinData &data)
+{
+   if (IsResident(data))
+      return true;
+   Clear();
+   const DataOptions &fitOpt = data.Opt();
+   if (!IsAvailable() || data.Size() == 0 || (fitOpt.fIntegral && data.HasBinEdges()) || data.HaveCoordErrors() ||
+       data.HaveAsymErrors())
+      return false;
+
+   const unsigned int n = data.Size();
+   const unsigned int ndim = data.NDim();
+   const bool useBinVolume = fitOpt.fBinVolume && data.HasBinEdges();
+   std::unique_ptr<Impl> impl(new Impl);
+
+   // when the model is multiplied by the bin volume it is evaluated at the bin centers
+   std::vector<double> coords(std::size_t(ndim) * n);
+   std::vector<double> volumes;
+   if (useBinVolume) {
+      const double wrefVolume = fitOpt.fNormBinVolume ? 1.0 / data.RefVolume() : 1.0;
+      volumes.assign(n, wrefVolume);
+      for (unsigned int j = 0; j < ndim; ++j) {
+         for (unsigned int i = 0; i < n; ++i) {
+            const double x1 = *data.GetCoordComponent(i, j);
+            const double x2 = data.GetBinUpEdgeComponent(i, j);
+            volumes[i] *= std::abs(x2 - x1);
+            coords[std::size_t(j) * n + i] = 0.5 * (x2 + x1);
+         }
+      }
+   } else {
+      for (unsigned int j = 0; j < ndim; ++j)
+         std::copy_n(data.GetCoordComponent(0, j), n, coords.begin() + std::size_t(j) * n);
+   }
+   std::vector<double> values(n);
+   std::vector<double> invErrors(n);
+   for (unsigned int i = 0; i < n; ++i) {
+      values[i] = data.Value(i);
+      invErrors[i] = data.InvError(i);
+   }
+
+   impl->fCoords = Impl::Upload(coords.data(), coords.size());
+   impl->fValues = Impl::Upload(values.data(), n);
+   impl->fInvErrors = Impl::Upload(invErrors.data(), n);
+   if (useBinVolume)
+      impl->fBinVolumes = Impl::Upload(volumes.data(), n);
+   impl->fModel = DeviceKernels::Allocate(std::min(n, kChunkSize));
+   if (!impl->fCoords || !impl->fValues || !impl->fInvErrors || (useBinVolume && !impl->fBinVolumes) ||
+       !impl->fModel)
+      return false;
+
+   fImpl = std::move(impl);
+   fData = &data;
+   fSize = n;
+   return true;
+}
+
+bool FitDeviceData::Upload(const UnBinData &data)
+{
+   if (IsResident(data))
+      return true;
+   Clear();
+   if (!IsAvailable() || data.Size() == 0)
+      return false;
+
+   const unsigned int n = data.Size();
+   const unsigned int ndim = data.NDim();
+   std::unique_ptr<Impl> impl(new Impl);
+
+   std::vector<double> coords(std::size_t(ndim) * n);
+   for (unsigned int j = 0; j < ndim; ++j)
+      std::copy_n(data.GetCoordComponent(0, j), n, coords.begin() + std::size_t(j) * n);
+   impl->fCoords = Impl::Upload(coords.data(), coords.size());
+   if (data.IsWeighted())
+      impl->fWeights = Impl::Upload(data.WeightsPtr(0), n);
+   impl->fModel = DeviceKernels::Allocate(std::min(n, kChunkSize));
+   if (!impl->fCoords || (data.IsWeighted() && !impl->fWeights) || !impl->fModel)
+      return false;
+
+   fImpl = std::move(impl);
+   fData = &data;
+   fSize = n;
+   return true;
+}
+
+bool FitDeviceData::Chi2(const IDeviceModelFunction &func, const double *p, unsigned int npar, bool useExpErrors,
+                         double invWeight, double maxResValue, double &chi2)
+{
+   if (!fImpl)
+      return false;
+   Impl &d = *fImpl;
+   if (!d.SetParameters(p, npar) || !d.ReservePartials(1))
+      return false;
+   double sum = 0;
+   for (unsigned int begin = 0; begin < fSize; begin += kChunkSize) {
+      const unsigned int m = std::min(kChunkSize, fSize - begin);
+      func.DeviceEval(d.fCoords + begin, m, fSize, d.fParams, d.fModel);
+      if (!DeviceKernels::Chi2Partials(d.fModel, d.fValues + begin, d.fInvErrors + begin,
+                                       d.fBinVolumes ? d.fBinVolumes + begin : nullptr, m, useExpErrors, invWeight,
+                                       maxResValue, d.fPartials) ||
+          !d.AddPartials(1, &sum))
+         return false;
+   }
+   chi2 = sum;
+   return true;
+}
+
+bool FitDeviceData::Chi2Gradient(const IDeviceModelFunction &func, const double *p, unsigned int npar, double *grad)
+{
+   if (!fImpl || !func.HasDeviceParameterGradient())
+      return false;
+   Impl &d = *fImpl;
+   const unsigned int chunk = d.ReserveModelGradient(npar, fSize);
+   if (chunk == 0 || !d.SetParameters(p, npar) || !d.ReservePartials(npar))
+      return false;
+   std::vector<double> g(npar);
+   for (unsigned int begin = 0; begin < fSize; begin += chunk) {
+      const unsigned int m = std::min(chunk, fSize - begin);
+      func.DeviceEval(d.fCoords + begin, m, fSize, d.fParams, d.fModel);
+      func.DeviceParameterGradient(d.fCoords + begin, m, fSize, d.fParams, d.fModelGrad);
+      if (!DeviceKernels::Chi2GradientPartials(d.fModel, d.fModelGrad, d.fValues + begin, d.fInvErrors + begin,
+                                               d.fBinVolumes ? d.fBinVolumes + begin : nullptr, m, npar,
+                                               d.fPartials) ||
+          !d.AddPartials(npar, g.data()))
+         return false;
+   }
+   std::copy(g.begin(), g.end(), grad);
+   return true;
+}
+
+bool FitDeviceData::LogL(const IDeviceModelFunction &func, const double *p, unsigned int npar, int iWeight,
+                         bool extended, double &logl, double &sumW, double &sumW2)
+{
+   if (!fImpl)
+      return false;
+   Impl &d = *fImpl;
+   if (!d.SetParameters(p, npar) || !d.ReservePartials(3))
+      return false;
+   double sums[3] = {0, 0, 0};
+   for (unsigned int begin = 0; begin < fSize; begin += kChunkSize) {
+      const unsigned int m = std::min(kChunkSize, fSize - begin);
+      func.DeviceEval(d.fCoords + begin, m, fSize, d.fParams, d.fModel);
+      if (!DeviceKernels::LogLPartials(d.fModel, d.fWeights ? d.fWeights + begin : nullptr, m, iWeight, extended,
+                                       d.fPartials) ||
+          !d.AddPartials(3, sums))
+         return false;
+   }
+   logl = sums[0];
+   sumW = sums[1];
+   sumW2 = sums[2];
+   return true;
+}
+
+bool FitDeviceData::LogLGradient(const IDeviceModelFunction &func, const double *p, unsigned int npar, double *grad)
+{
+   if (!fImpl || !func.HasDeviceParameterGradient())
+      return false;
+   Impl &d = *fImpl;
+   const unsigned int chunk = d.ReserveModelGradient(npar, fSize);
+   if (chunk == 0 || !d.SetParameters(p, npar) || !d.ReservePartials(npar))
+      return false;
+   // same bounds as in FitUtil::EvaluateLogLGradient
+   const double kdmax1 = std::sqrt(std::numeric_limits<double>::max());
+   const double kdmax2 = std::numeric_limits<double>::max() / (4 * fSize);
+   std::vector<double> g(npar);
+   for (unsigned int begin = 0; begin < fSize; begin += chunk) {
+      const unsigned int m = std::min(chunk, fSize - begin);
+      func.DeviceEval(d.fCoords + begin, m, fSize, d.fParams, d.fModel);
+      func.DeviceParameterGradient(d.fCoords + begin, m, fSize, d.fParams, d.fModelGrad);
+      if (!DeviceKernels::LogLGradientPartials(d.fModel, d.fModelGrad, m, npar, kdmax1, kdmax2, d.fPartials) ||
+          !d.AddPartials(npar, g.data()))
+         return false;
+   }
+   std::copy(g.begin(), g.end(), grad);
+   return true;
+}
+
+#else
+
+// ROOT built without CUDA support: the data cannot be uploaded and the fit method functions evaluate on the CPU
+
+struct FitDeviceData::Impl {};
+
+FitDeviceData::FitDeviceData() {}
+
+FitDeviceData::~FitDeviceData() {}
+
+bool FitDeviceData::IsAvailable() { return false; }
+
+bool FitDeviceData::IsResident(const FitData &) const { return false; }
+
+void FitDeviceData::Clear() {}
+
+bool FitDeviceData::Upload(const BinData &) { return false; }
+
+bool FitDeviceData::Upload(const UnBinData &) { return false; }
+
+bool FitDeviceData::Chi2(const IDeviceModelFunction &, const double *, unsigned int, bool, double, double, double &)
+{
+   return false;
+}
+
+bool FitDeviceData::Chi2Gradient(const IDeviceModelFunction &, const double *, unsigned int, double *) { return false; }
+
+bool FitDeviceData::LogL(const IDeviceModelFunction &, const double *, unsigned int, int, bool, double &, double &,
+                         double &)
+{
+   return false;
+}
+
+bool FitDeviceData::LogLGradient(const IDeviceModelFunction &, const double *, unsigned int, double *) { return false; }
+
+#endif
+
+   } // end namespace Fit
+
+} // end namespace ROOT
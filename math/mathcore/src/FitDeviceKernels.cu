@@ -0,0 +1,227 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2020  LCG ROOT Math Team, CERN/PH-SFT                *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// CUDA memory management and reduction kernels used by FitDeviceData.
+// The per-point terms are the same as the ones of FitUtil::EvaluateChi2, EvaluateChi2Gradient,
+// EvaluateLogL and EvaluateLogLGradient.
+
+#include "FitDeviceKernels.h"
+
+#include "TError.h"
+
+#include <cfloat>
+#include <cuda_runtime.h>
+
+namespace ROOT {
+
+   namespace Fit {
+
+namespace DeviceKernels {
+
+namespace {
+
+bool CheckCuda(cudaError_t code, const char *where)
+{
+   if (code == cudaSuccess)
+      return true;
+   Error(where, "CUDA error: %s", cudaGetErrorString(code));
+   return false;
+}
+
+/// check for errors in the launch of the last kernel
+bool CheckLaunch(const char *where)
+{
+   return CheckCuda(cudaGetLastError(), where);
+}
+
+/// sum the values of the threads of the block and store the result in *partial
+__device__ void StorePartialSum(double value, double *partial)
+{
+   __shared__ double cache[kNThreads];
+   cache[threadIdx.x] = value;
+   __syncthreads();
+   for (unsigned int s = blockDim.x / 2; s > 0; s >>= 1) {
+      if (threadIdx.x < s)
+         cache[threadIdx.x] += cache[threadIdx.x + s];
+      __syncthreads();
+   }
+   if (threadIdx.x == 0)
+      *partial = cache[0];
+}
+
+/// as CheckInfNaNValue in FitUtil.cxx, without correcting the value
+__device__ bool IsFiniteValue(double x)
+{
+   return x > -DBL_MAX && x < DBL_MAX;
+}
+
+/// as ROOT::Math::Util::EvalLog
+__device__ double EvalLog(double x)
+{
+   const double epsilon = 2.0 * DBL_MIN;
+   return x <= epsilon ? x / epsilon + log(epsilon) - 1.0 : log(x);
+}
+
+__global__ void Chi2Kernel(const double *f, const double *y, const double *invErr, const double *binVol,
+                           unsigned int n, bool useExpErrors, double invWeight, double maxResValue, double *partials)
+{
+   double sum = 0;
+   for (unsigned int i = blockIdx.x * blockDim.x + threadIdx.x; i < n; i += blockDim.x * gridDim.x) {
+      double fval = f[i];
+      if (binVol)
+         fval *= binVol[i];
+      double invError = invErr[i];
+      if (useExpErrors)
+         invError = (fval > 0) ? sqrt(invWeight / fval) : 0.0;
+      if (invError > 0) {
+         double tmp = (y[i] - fval) * invError;
+         double resval = tmp * tmp;
+         // avoid infinities or nan in the chi2 due to wrong function values
+         sum += (resval < maxResValue) ? resval : maxResValue;
+      }
+   }
+   StorePartialSum(sum, partials + blockIdx.x);
+}
+
+// blockIdx.y is the index of the parameter
+__global__ void Chi2GradientKernel(const double *f, const double *g, const double *y, const double *invErr,
+                                   const double *binVol, unsigned int n, double *partials)
+{
+   const unsigned int k = blockIdx.y;
+   double sum = 0;
+   for (unsigned int i = blockIdx.x * blockDim.x + threadIdx.x; i < n; i += blockDim.x * gridDim.x) {
+      const double volume = binVol ? binVol[i] : 1.0;
+      const double fval = f[i] * volume;
+      if (!IsFiniteValue(fval))
+         continue;
+      // as on the CPU, a point contributes to the derivatives with respect to the parameters before the first
+      // infinite derivative
+      bool isFinite = true;
+      for (unsigned int j = 0; j < k && isFinite; ++j)
+         isFinite = IsFiniteValue(g[j * n + i] * volume);
+      const double dfval = g[k * n + i] * volume;
+      if (!isFinite || !IsFiniteValue(dfval))
+         continue;
+      const double invError = (invErr[i] != 0.0) ? invErr[i] : 1.0;
+      sum += -2.0 * (y[i] - fval) * invError * invError * dfval;
+   }
+   StorePartialSum(sum, partials + k * gridDim.x + blockIdx.x);
+}
+
+__global__ void LogLKernel(const double *f, const double *w, unsigned int n, int iWeight, bool extended,
+                           double *partials)
+{
+   double logl = 0;
+   double sumW = 0;
+   double sumW2 = 0;
+   for (unsigned int i = blockIdx.x * blockDim.x + threadIdx.x; i < n; i += blockDim.x * gridDim.x) {
+      double logval = EvalLog(f[i]);
+      if (iWeight > 0) {
+         const double weight = w ? w[i] : 1.0;
+         logval *= weight;
+         if (iWeight == 2) {
+            logval *= weight;
+            if (!extended) {
+               sumW += weight;
+               sumW2 += weight * weight;
+            }
+         }
+      }
+      logl += logval;
+   }
+   StorePartialSum(logl, partials + blockIdx.x);
+   StorePartialSum(sumW, partials + gridDim.x + blockIdx.x);
+   StorePartialSum(sumW2, partials + 2 * gridDim.x + blockIdx.x);
+}
+
+// blockIdx.y is the index of the parameter
+__global__ void LogLGradientKernel(const double *f, const double *g, unsigned int n, double kdmax1, double kdmax2,
+                                   double *partials)
+{
+   const unsigned int k = blockIdx.y;
+   double sum = 0;
+   for (unsigned int i = blockIdx.x * blockDim.x + threadIdx.x; i < n; i += blockDim.x * gridDim.x) {
+      const double fval = f[i];
+      const double gval = g[k * n + i];
+      if (fval > 0) {
+         sum += -1. / fval * gval;
+      } else if (gval != 0) {
+         const double gg = kdmax1 * gval;
+         sum -= (gg > 0) ? fmin(gg, kdmax2) : fmax(gg, -kdmax2);
+      }
+   }
+   StorePartialSum(sum, partials + k * gridDim.x + blockIdx.x);
+}
+
+} // anonymous namespace
+
+int DeviceCount()
+{
+   int count = 0;
+   if (cudaGetDeviceCount(&count) != cudaSuccess)
+      return 0;
+   return count;
+}
+
+double *Allocate(std::size_t n)
+{
+   void *ptr = nullptr;
+   if (!CheckCuda(cudaMalloc(&ptr, n * sizeof(double)), "FitDeviceData::Allocate"))
+      return nullptr;
+   return static_cast<double *>(ptr);
+}
+
+void Free(double *ptr)
+{
+   if (ptr)
+      cudaFree(ptr);
+}
+
+bool CopyToDevice(double *dst, const double *src, std::size_t n)
+{
+   return CheckCuda(cudaMemcpy(dst, src, n * sizeof(double), cudaMemcpyHostToDevice), "FitDeviceData::CopyToDevice");
+}
+
+bool CopyToHost(double *dst, const double *src, std::size_t n)
+{
+   return CheckCuda(cudaMemcpy(dst, src, n * sizeof(double), cudaMemcpyDeviceToHost), "FitDeviceData::CopyToHost");
+}
+
+bool Chi2Partials(const double *f, const double *y, const double *invErr, const double *binVol, unsigned int n,
+                  bool useExpErrors, double invWeight, double maxResValue, double *partials)
+{
+   Chi2Kernel<<<kNBlocks, kNThreads>>>(f, y, invErr, binVol, n, useExpErrors, invWeight, maxResValue, partials);
+   return CheckLaunch("FitDeviceData::Chi2");
+}
+
+bool Chi2GradientPartials(const double *f, const double *g, const double *y, const double *invErr,
+                          const double *binVol, unsigned int n, unsigned int npar, double *partials)
+{
+   Chi2GradientKernel<<<dim3(kNBlocks, npar), kNThreads>>>(f, g, y, invErr, binVol, n, partials);
+   return CheckLaunch("FitDeviceData::Chi2Gradient");
+}
+
+bool LogLPartials(const double *f, const double *w, unsigned int n, int iWeight, bool extended, double *partials)
+{
+   LogLKernel<<<kNBlocks, kNThreads>>>(f, w, n, iWeight, extended, partials);
+   return CheckLaunch("FitDeviceData::LogL");
+}
+
+bool LogLGradientPartials(const double *f, const double *g, unsigned int n, unsigned int npar, double kdmax1,
+                          double kdmax2, double *partials)
+{
+   LogLGradientKernel<<<dim3(kNBlocks, npar), kNThreads>>>(f, g, n, kdmax1, kdmax2, partials);
+   return CheckLaunch("FitDeviceData::LogLGradient");
+}
+
+} // end namespace DeviceKernels
+
+   } // end namespace Fit
+
+} // end namespace ROOT
@@ -0,0 +1,70 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2020  LCG ROOT Math Team, CERN/PH-SFT                *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Internal header: CUDA memory management and reduction kernels used by FitDeviceData.
+// Implemented in FitDeviceKernels.cu, compiled only when ROOT is built with CUDA support.
+// All pointers to double are in device memory, except the ones passed to CopyToDevice as source
+// and to CopyToHost as destination.
+
+#ifndef ROOT_Fit_FitDeviceKernels
+#define ROOT_Fit_FitDeviceKernels
+
+#include <cstddef>
+
+namespace ROOT {
+
+   namespace Fit {
+
+namespace DeviceKernels {
+
+/// number of thread blocks of the reductions: each block writes one partial sum per output, and
+/// the partial sums are added on the host in a fixed order
+constexpr unsigned int kNBlocks = 256;
+
+/// number of threads per block of the reductions
+constexpr unsigned int kNThreads = 256;
+
+int DeviceCount();
+
+/// allocate n doubles on the device, return nullptr on failure
+double *Allocate(std::size_t n);
+
+void Free(double *ptr);
+
+bool CopyToDevice(double *dst, const double *src, std::size_t n);
+
+/// copy n doubles to the host, after waiting for the kernels launched before to complete
+bool CopyToHost(double *dst, const double *src, std::size_t n);
+
+/// partial sums of the chi2 residuals of the n points, in partials[0, kNBlocks)
+/// (binVol may be null; if useExpErrors the errors are computed from the model values)
+bool Chi2Partials(const double *f, const double *y, const double *invErr, const double *binVol, unsigned int n,
+                  bool useExpErrors, double invWeight, double maxResValue, double *partials);
+
+/// partial sums of the derivatives of the chi2 with respect to the npar parameters, given the model values f
+/// and their derivatives g (g[k * n + i]); the sums for parameter k are in partials[k * kNBlocks, (k + 1) * kNBlocks)
+bool Chi2GradientPartials(const double *f, const double *g, const double *y, const double *invErr,
+                          const double *binVol, unsigned int n, unsigned int npar, double *partials);
+
+/// partial sums of the log-likelihood, of the weights and of their squares, in partials[c * kNBlocks, (c + 1) * kNBlocks)
+/// for c = 0, 1, 2 (w may be null for unweighted data)
+bool LogLPartials(const double *f, const double *w, unsigned int n, int iWeight, bool extended, double *partials);
+
+/// partial sums of the derivatives of minus the log-likelihood, laid out as in Chi2GradientPartials;
+/// kdmax1 and kdmax2 bound the contributions of the points where the model is not positive
+bool LogLGradientPartials(const double *f, const double *g, unsigned int n, unsigned int npar, double kdmax1,
+                          double kdmax2, double *partials);
+
+} // end namespace DeviceKernels
+
+   } // end namespace Fit
+
+} // end namespace ROOT
+
+#endif /* ROOT_Fit_FitDeviceKernels */
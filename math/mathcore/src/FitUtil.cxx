@@ -14,6 +14,8 @@
 
 #include "Fit/BinData.h"
 #include "Fit/UnBinData.h"
+#include "Fit/FitDeviceData.h"
+#include "Fit/DeviceModelFunction.h"
 
 #include "Math/IFunctionfwd.h"
 #include "Math/IParamFunction.h"
@@ -195,6 +197,46 @@ namespace ROOT {
          }
 
 
+         // Compute the extended term of the unbinned log-likelihood, from the integral nuTot of the function in
+         // the range of the data. Return false if no range is set and the function is not zero at +/- inf.
+         bool EvaluateLogLExtendedTerm(const IModelFunction &func, const UnBinData &data, const double *p, int iWeight,
+                                       double sumW, double sumW2, double &extendedTerm)
+         {
+            double nuTot = 0;
+            IntegralEvaluator<> igEval( func, p, true);
+            std::vector<double> xmin(data.NDim());
+            std::vector<double> xmax(data.NDim());
+
+            // compute integral in the ranges where is defined
+            if (data.Range().Size() > 0 ) {
+               nuTot = 0;
+               for (unsigned int ir = 0; ir < data.Range().Size(); ++ir) {
+                  data.Range().GetRange(&xmin[0],&xmax[0],ir);
+                  nuTot += igEval.Integral(xmin.data(),xmax.data());
+               }
+            } else {
+               // use (-inf +inf)
+               data.Range().GetRange(&xmin[0],&xmax[0]);
+               // check if funcition is zero at +- inf
+               if (func(xmin.data(), p) != 0 || func(xmax.data(), p) != 0) {
+                  MATH_ERROR_MSG("FitUtil::EvaluateLogLikelihood","A range has not been set and the function is not zero at +/- inf");
+                  return false;
+               }
+               nuTot = igEval.Integral(&xmin[0],&xmax[0]);
+            }
+
+            // force to be last parameter value
+            //nutot = p[func.NDim()-1];
+            if (iWeight != 2)
+               extendedTerm = - nuTot;  // no need to add in this case n log(nu) since is already computed before
+            else {
+               // case use weight square in likelihood : compute total effective weight = sw2/sw
+               // ignore for the moment case when sumW is zero
+               extendedTerm = - (sumW2 / sumW) * nuTot;
+            }
+            return true;
+         }
+
          // calculation of the integral of the gradient functions
          // for a function providing derivative w.r.t parameters
          // x1 and x2 defines the integration interval , p the parameters
@@ -1076,38 +1118,8 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double> &func, const UnBi
       // nuTot is integral of function in the range
       // if function has been normalized integral has been already computed
       if (!normalizeFunc) {
-         IntegralEvaluator<> igEval( func, p, true);
-         std::vector<double> xmin(data.NDim());
-         std::vector<double> xmax(data.NDim());
-
-         // compute integral in the ranges where is defined
-         if (data.Range().Size() > 0 ) {
-            nuTot = 0;
-            for (unsigned int ir = 0; ir < data.Range().Size(); ++ir) {
-               data.Range().GetRange(&xmin[0],&xmax[0],ir);
-               nuTot += igEval.Integral(xmin.data(),xmax.data());
-            }
-         } else {
-            // use (-inf +inf)
-            data.Range().GetRange(&xmin[0],&xmax[0]);
-            // check if funcition is zero at +- inf
-            if (func(xmin.data(), p) != 0 || func(xmax.data(), p) != 0) {
-               MATH_ERROR_MSG("FitUtil::EvaluateLogLikelihood","A range has not been set and the function is not zero at +/- inf");
-               return 0;
-            }
-            nuTot = igEval.Integral(&xmin[0],&xmax[0]);
-         }
-
-         // force to be last parameter value
-         //nutot = p[func.NDim()-1];
-         if (iWeight != 2)
-            extendedTerm = - nuTot;  // no need to add in this case n log(nu) since is already computed before
-         else {
-            // case use weight square in likelihood : compute total effective weight = sw2/sw
-            // ignore for the moment case when sumW is zero
-            extendedTerm = - (sumW2 / sumW) * nuTot;
-         }
-
+         if (!EvaluateLogLExtendedTerm(func, data, p, iWeight, sumW, sumW2, extendedTerm))
+            return 0;
       }
       else {
          nuTot = norm;
@@ -1780,6 +1792,100 @@ void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction &f, const BinData
 
 }
 
+//_________________________________________________________________________________________________
+// for evaluations on a CUDA device (ROOT::Fit::ExecutionPolicy::kGPU)
+//_________________________________________________________________________________________________
+
+std::shared_ptr<FitDeviceData> FitUtil::CreateDeviceData(bool isDeviceModel, ROOT::Fit::ExecutionPolicy &executionPolicy)
+{
+   if (executionPolicy != ROOT::Fit::ExecutionPolicy::kGPU)
+      return nullptr;
+   if (!FitDeviceData::IsAvailable()) {
+      Warning("FitUtil::CreateDeviceData", "GPU execution policy requires ROOT built with CUDA support and a CUDA "
+                                           "device. Changing to ROOT::Fit::ExecutionPolicy::kSerial.");
+   } else if (!isDeviceModel) {
+      Warning("FitUtil::CreateDeviceData", "GPU execution policy requires a model function implementing "
+                                           "ROOT::Fit::IDeviceModelFunction. Changing to ROOT::Fit::ExecutionPolicy::kSerial.");
+   } else {
+      return std::make_shared<FitDeviceData>();
+   }
+   executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial;
+   return nullptr;
+}
+
+bool FitUtil::EvaluateChi2OnDevice(const IModelFunction &func, const BinData &data, const double *p,
+                                   FitDeviceData &devData, double &chi2)
+{
+   // evaluate the chi2 on the device, as EvaluateChi2 does on the CPU
+   const IDeviceModelFunction *dfunc = dynamic_cast<const IDeviceModelFunction *>(&func);
+   if (!dfunc || !devData.Upload(data))
+      return false;
+
+   const DataOptions &fitOpt = data.Opt();
+   bool useExpErrors = fitOpt.fExpErrors;
+   double invWeight = 1.0;
+   // with expected errors use the global weight for weighted data (see EvaluateChi2)
+   if (useExpErrors && data.IsWeighted())
+      invWeight = data.SumOfContent() / data.SumOfError2();
+   double maxResValue = std::numeric_limits<double>::max() / data.Size();
+
+   (const_cast<IModelFunction &>(func)).SetParameters(p);
+   return devData.Chi2(*dfunc, p, func.NPar(), useExpErrors, invWeight, maxResValue, chi2);
+}
+
+bool FitUtil::EvaluateChi2GradientOnDevice(const IModelFunction &func, const BinData &data, const double *p,
+                                           double *grad, FitDeviceData &devData)
+{
+   // evaluate the chi2 gradient on the device, as EvaluateChi2Gradient does on the CPU
+   const IDeviceModelFunction *dfunc = dynamic_cast<const IDeviceModelFunction *>(&func);
+   if (!dfunc || data.HaveCoordErrors() || !devData.Upload(data))
+      return false;
+
+   (const_cast<IModelFunction &>(func)).SetParameters(p);
+   return devData.Chi2Gradient(*dfunc, p, func.NPar(), grad);
+}
+
+bool FitUtil::EvaluateLogLOnDevice(const IModelFunction &func, const UnBinData &data, const double *p, int iWeight,
+                                   bool extended, unsigned int &nPoints, FitDeviceData &devData, double &result)
+{
+   // evaluate minus the log-likelihood on the device, as EvaluateLogL does on the CPU.
+   // The extended term is computed on the host, from the integral of the function
+   const IDeviceModelFunction *dfunc = dynamic_cast<const IDeviceModelFunction *>(&func);
+   if (!dfunc || !devData.Upload(data))
+      return false;
+
+   (const_cast<IModelFunction &>(func)).SetParameters(p);
+   double logl = 0;
+   double sumW = 0;
+   double sumW2 = 0;
+   if (!devData.LogL(*dfunc, p, func.NPar(), iWeight, extended, logl, sumW, sumW2))
+      return false;
+   nPoints = data.Size();
+
+   if (extended) {
+      double extendedTerm = 0;
+      if (!EvaluateLogLExtendedTerm(func, data, p, iWeight, sumW, sumW2, extendedTerm)) {
+         result = 0;
+         return true;
+      }
+      logl += extendedTerm;
+   }
+   result = -logl;
+   return true;
+}
+
+bool FitUtil::EvaluateLogLGradientOnDevice(const IModelFunction &func, const UnBinData &data, const double *p,
+                                           double *grad, FitDeviceData &devData)
+{
+   // evaluate the gradient of minus the log-likelihood on the device, as EvaluateLogLGradient does on the CPU
+   const IDeviceModelFunction *dfunc = dynamic_cast<const IDeviceModelFunction *>(&func);
+   if (!dfunc || !devData.Upload(data))
+      return false;
+
+   (const_cast<IModelFunction &>(func)).SetParameters(p);
+   return devData.LogLGradient(*dfunc, p, func.NPar(), grad);
+}
+
 
 unsigned FitUtil::setAutomaticChunking(unsigned nEvents){
       auto ncpu  = ROOT::GetThreadPoolSize();
@@ -30,6 +30,7 @@ namespace {
 
 #include "Math/MixMaxEngine.h"
 
+#include <algorithm>
 #include <iostream>
 
 #if (ROOT_MM_N==17)
@@ -55,6 +56,7 @@ namespace ROOT {
       }
       ~MixMaxEngineImpl() {}
       void SetSeed(uint64_t) { }
+      void SetSeed(uint64_t, uint64_t) { }
       double Rndm() { return -1; }
       double IntRndm() { return 0; }
       void SetState(const std::vector<uint64_t> &) { }
@@ -62,6 +64,7 @@ namespace ROOT {
       int Counter() { return -1; }
       void SetCounter(int) {}
       void Iterate() {} 
+      void FillArray(int, double *, int) {}
    };
 
 
@@ -87,6 +90,11 @@ public:
       //seed_spbox(fRngState, seed);
       seed_uniquestream(fRngState, 0, 0, (uint32_t)(seed>>32), (uint32_t)seed );
    }
+   // seed the stream number stream of the seed: the first two IDs of the unique streams, which are left to 0
+   // by SetSeed(seed), are the stream number
+   void SetSeed(Result_t seed, Result_t stream) {
+      seed_uniquestream(fRngState, (uint32_t)(stream>>32), (uint32_t)stream, (uint32_t)(seed>>32), (uint32_t)seed );
+   }
    double Rndm() {
        return get_next_float(fRngState);
    }
@@ -121,6 +129,26 @@ public:
    void RndmArray(int n, double * array) {
       fill_array(fRngState, n, array); 
    }
+   // fill the array with the next n numbers of the sequence, the same ones as n calls to Rndm(), applying skip
+   // extra iterations every time the state vector is exhausted. The numbers of the state vector are converted
+   // in a loop without the check of the counter, which the compiler can vectorize.
+   void FillArray(int n, double * array, int skip) {
+      int i = 0;
+      while (i < n) {
+         if (fRngState->counter > ROOT_MM_N - 1) {
+            for (int iskip = 0; iskip <= skip; ++iskip)
+               iterate(fRngState);
+            fRngState->counter = 1;
+         }
+         const int m = std::min(n - i, ROOT_MM_N - fRngState->counter);
+         const myuint * v = fRngState->V + fRngState->counter;
+         double * out = array + i;
+         for (int j = 0; j < m; ++j)
+            out[j] = (int64_t)v[j] * (double)(INV_MERSBASE);
+         fRngState->counter += m;
+         i += m;
+      }
+   }
    void ReadState(const char filename[] ) {
       read_state(fRngState, filename);
    }
@@ -14,8 +14,21 @@
 
 #include "TString.h"
 #include <string.h>
+#include <array>
 #include <limits>
 
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+namespace {
+// minimum number of points of a tree built in parallel, and of a batch of queries processed in parallel,
+// when the implicit multithreading is enabled
+const Int_t kMinPointsParallelBuild = 100000;
+const Int_t kMinPointsParallelQuery = 1000;
+}
+
 templateClassImp(TKDTree);
 
 
@@ -403,6 +416,9 @@ TKDTree<Index, Value>::~TKDTree()
 /// 3. initialize index array
 /// 4. non recursive building of the binary tree
 ///
+/// When the implicit multithreading is enabled (ROOT::EnableImplicitMT()), the first rows of large trees
+/// are divided serially and the resulting subtrees, which use disjoint parts of the index and node arrays,
+/// are then built in parallel. The tree is the same as the one built serially.
 ///
 /// The tree is divided recursively. See class description, section 4b for the details
 /// of the division alogrithm
@@ -449,94 +465,125 @@ void TKDTree<Index, Value>::Build()
    //
    //
    //4.
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && fNPoints >= kMinPointsParallelBuild) {
+      // split the first rows serially, until there are enough subtrees to keep the threads busy; the
+      // subtrees use disjoint ranges of fIndPoints and of the node arrays, and are then built in parallel
+      const UInt_t nTasks = 4 * ROOT::GetThreadPoolSize();
+      std::vector<std::array<Int_t, 4>> subtrees(1, {{0, 0, fNPoints, 0}}); // row, node, npoints, pos
+      Bool_t split = kTRUE;
+      while (split && subtrees.size() < nTasks) {
+         split = kFALSE;
+         std::vector<std::array<Int_t, 4>> next;
+         for (auto &t : subtrees) {
+            if (t[2] <= fBucketSize) {
+               next.push_back(t);
+               continue;
+            }
+            Int_t nleft = SplitNode(t[0], t[1], t[2], t[3]);
+            next.push_back({{t[0] + 1, 2 * t[1] + 1, nleft, t[3]}});
+            next.push_back({{t[0] + 1, 2 * t[1] + 2, t[2] - nleft, t[3] + nleft}});
+            split = kTRUE;
+         }
+         subtrees.swap(next);
+      }
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([this](const std::array<Int_t, 4> &t) { BuildSubtree(t[0], t[1], t[2], t[3]); }, subtrees);
+      return;
+   }
+#endif
+   BuildSubtree(0, 0, fNPoints, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the subtree of the node `node` of the row `row`, whose npoints points start at the position pos
+/// of fIndPoints
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::BuildSubtree(Int_t row, Int_t node, Int_t npoints, Int_t pos)
+{
    //    stack for non recursive build - size 128 bytes enough
    Int_t rowStack[128];
    Int_t nodeStack[128];
    Int_t npointStack[128];
    Int_t posStack[128];
    Int_t currentIndex = 0;
-   Int_t iter =0;
-   rowStack[0]    = 0;
-   nodeStack[0]   = 0;
-   npointStack[0] = fNPoints;
-   posStack[0]   = 0;
+   rowStack[0]    = row;
+   nodeStack[0]   = node;
+   npointStack[0] = npoints;
+   posStack[0]   = pos;
    //
-   Int_t nbucketsall =0;
    while (currentIndex>=0){
-      iter++;
-      //
-      Int_t npoints  = npointStack[currentIndex];
-      if (npoints<=fBucketSize) {
-         //printf("terminal node : index %d iter %d\n", currentIndex, iter);
+      Int_t cpoints  = npointStack[currentIndex];
+      if (cpoints<=fBucketSize) {
          currentIndex--;
-         nbucketsall++;
          continue; // terminal node
       }
       Int_t crow     = rowStack[currentIndex];
       Int_t cpos     = posStack[currentIndex];
       Int_t cnode    = nodeStack[currentIndex];
-      //printf("currentIndex %d npoints %d node %d\n", currentIndex, npoints, cnode);
-      //
-      // divide points
-      Int_t nbuckets0 = npoints/fBucketSize;           //current number of  buckets
-      if (npoints%fBucketSize) nbuckets0++;            //
-      Int_t restRows = fRowT0-rowStack[currentIndex];  // rest of fully occupied node row
-      if (restRows<0) restRows =0;
-      for (;nbuckets0>(2<<restRows); restRows++) {}
-      Int_t nfull = 1<<restRows;
-      Int_t nrest = nbuckets0-nfull;
-      Int_t nleft =0, nright =0;
-      //
-      if (nrest>(nfull/2)){
-         nleft  = nfull*fBucketSize;
-         nright = npoints-nleft;
-      }else{
-         nright = nfull*fBucketSize/2;
-         nleft  = npoints-nright;
-      }
-
-      //
-      //find the axis with biggest spread
-      Value maxspread=0;
-      Value tempspread, min, max;
-      Index axspread=0;
-      Value *array;
-      for (Int_t idim=0; idim<fNDim; idim++){
-         array = fData[idim];
-         Spread(npoints, array, fIndPoints+cpos, min, max);
-         tempspread = max - min;
-         if (maxspread < tempspread) {
-            maxspread=tempspread;
-            axspread = idim;
-         }
-         if(cnode) continue;
-         //printf("set %d %6.3f %6.3f\n", idim, min, max);
-         fRange[2*idim] = min; fRange[2*idim+1] = max;
-      }
-      array = fData[axspread];
-      KOrdStat(npoints, array, nleft, fIndPoints+cpos);
-      fAxis[cnode]  = axspread;
-      fValue[cnode] = array[fIndPoints[cpos+nleft]];
-      //printf("Set node %d : ax %d val %f\n", cnode, node->fAxis, node->fValue);
-      //
+      Int_t nleft    = SplitNode(crow, cnode, cpoints, cpos);
       //
       npointStack[currentIndex] = nleft;
       rowStack[currentIndex]    = crow+1;
       posStack[currentIndex]    = cpos;
       nodeStack[currentIndex]   = cnode*2+1;
       currentIndex++;
-      npointStack[currentIndex] = nright;
+      npointStack[currentIndex] = cpoints-nleft;
       rowStack[currentIndex]    = crow+1;
       posStack[currentIndex]    = cpos+nleft;
       nodeStack[currentIndex]   = (cnode*2)+2;
-      //
-      if (0){
-         // consistency check
-         Info("Build()", "%s", Form("points %d left %d right %d", npoints, nleft, nright));
-         if (nleft<nright) Warning("Build", "Problem Left-Right");
-         if (nleft<0 || nright<0) Warning("Build()", "Problem Negative number");
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Divide the npoints points of the non-terminal node cnode of the row crow, starting at the position cpos
+/// of fIndPoints, along the axis with the biggest spread. Set the axis and the value of the node and
+/// return the number of points of the left daughter node, which are moved before the ones of the right one.
+
+template <typename  Index, typename Value>
+Int_t TKDTree<Index, Value>::SplitNode(Int_t crow, Int_t cnode, Int_t npoints, Int_t cpos)
+{
+   // divide points
+   Int_t nbuckets0 = npoints/fBucketSize;           //current number of  buckets
+   if (npoints%fBucketSize) nbuckets0++;            //
+   Int_t restRows = fRowT0-crow;                    // rest of fully occupied node row
+   if (restRows<0) restRows =0;
+   for (;nbuckets0>(2<<restRows); restRows++) {}
+   Int_t nfull = 1<<restRows;
+   Int_t nrest = nbuckets0-nfull;
+   Int_t nleft =0, nright =0;
+   //
+   if (nrest>(nfull/2)){
+      nleft  = nfull*fBucketSize;
+      nright = npoints-nleft;
+   }else{
+      nright = nfull*fBucketSize/2;
+      nleft  = npoints-nright;
+   }
+
+   //
+   //find the axis with biggest spread
+   Value maxspread=0;
+   Value tempspread, min, max;
+   Index axspread=0;
+   Value *array;
+   for (Int_t idim=0; idim<fNDim; idim++){
+      array = fData[idim];
+      Spread(npoints, array, fIndPoints+cpos, min, max);
+      tempspread = max - min;
+      if (maxspread < tempspread) {
+         maxspread=tempspread;
+         axspread = idim;
       }
+      if(cnode) continue;
+      fRange[2*idim] = min; fRange[2*idim+1] = max;
    }
+   array = fData[axspread];
+   KOrdStat(npoints, array, nleft, fIndPoints+cpos);
+   fAxis[cnode]  = axspread;
+   fValue[cnode] = array[fIndPoints[cpos+nleft]];
+   return nleft;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -561,6 +608,42 @@ void TKDTree<Index, Value>::FindNearestNeighbors(const Value *point, const Int_t
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///Find the kNN nearest neighbors of each of the npoints points of the array points, where the
+///coordinates of the point i start at points[i*fNDim]. The neighbors of the point i are written at
+///ind[i*kNN] and dist[i*kNN]; the arrays are provided by the user.
+///The queries are processed in parallel when the implicit multithreading is enabled.
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::FindNearestNeighbors(Index npoints, const Value *points, Int_t kNN, Index *ind,
+                                                 Value *dist)
+{
+   if (!ind || !dist) {
+      Error("FindNearestNeighbors", "Working arrays must be allocated by the user!");
+      return;
+   }
+   // the boundaries are built before the queries, which then only read the tree
+   MakeBoundariesExact();
+   auto query = [&](Index ipoint) {
+      Index *indi = ind + ipoint * kNN;
+      Value *disti = dist + ipoint * kNN;
+      for (Int_t i = 0; i < kNN; i++) {
+         disti[i] = std::numeric_limits<Value>::max();
+         indi[i] = -1;
+      }
+      UpdateNearestNeighbors(0, points + ipoint * fNDim, kNN, indi, disti);
+   };
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && npoints >= kMinPointsParallelQuery) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(query, ROOT::TSeq<Index>(0, npoints), 4 * ROOT::GetThreadPoolSize());
+      return;
+   }
+#endif
+   for (Index ipoint = 0; ipoint < npoints; ipoint++)
+      query(ipoint);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///Update the nearest neighbors values by examining the node inode
 
@@ -757,11 +840,38 @@ void TKDTree<Index, Value>::FindInRange(Value * point, Value range, std::vector<
    UpdateRange(0, point, range, res);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///Find the points within the distance range from each of the npoints points of the array points,
+///where the coordinates of the point i start at points[i*fNDim]. The indexes of the points found for
+///the point i are written in res[i].
+///The queries are processed in parallel when the implicit multithreading is enabled.
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::FindInRange(Index npoints, const Value *points, Value range,
+                                        std::vector<std::vector<Index>> &res)
+{
+   MakeBoundariesExact();
+   res.resize(npoints);
+   auto query = [&](Index ipoint) {
+      res[ipoint].clear();
+      UpdateRange(0, points + ipoint * fNDim, range, res[ipoint]);
+   };
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && npoints >= kMinPointsParallelQuery) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(query, ROOT::TSeq<Index>(0, npoints), 4 * ROOT::GetThreadPoolSize());
+      return;
+   }
+#endif
+   for (Index ipoint = 0; ipoint < npoints; ipoint++)
+      query(ipoint);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///Internal recursive function with the implementation of range searches
 
 template <typename  Index, typename Value>
-void TKDTree<Index, Value>::UpdateRange(Index inode, Value* point, Value range, std::vector<Index> &res)
+void TKDTree<Index, Value>::UpdateRange(Index inode, const Value* point, Value range, std::vector<Index> &res)
 {
    Value min, max;
    DistanceToNode(point, inode, min, max);
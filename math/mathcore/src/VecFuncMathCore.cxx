@@ -0,0 +1,171 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "Math/VecFuncMathCore.h"
+
+namespace {
+
+/// Apply func to the n values of x, one ROOT::Double_v at a time and the remainder as doubles
+template <class Func>
+void Apply(std::size_t n, const double *x, double *result, const Func &func)
+{
+   std::size_t i = 0;
+#ifdef R__HAS_VECCORE
+   const std::size_t vecSize = vecCore::VectorSize<ROOT::Double_v>();
+   for (; i + vecSize <= n; i += vecSize) {
+      ROOT::Double_v v;
+      vecCore::Load<ROOT::Double_v>(v, x + i);
+      vecCore::Store<ROOT::Double_v>(func(v), result + i);
+   }
+#endif
+   for (; i < n; ++i)
+      result[i] = func(x[i]);
+}
+
+/// Same as Apply for the functions of two arguments
+template <class Func>
+void Apply(std::size_t n, const double *x, const double *y, double *result, const Func &func)
+{
+   std::size_t i = 0;
+#ifdef R__HAS_VECCORE
+   const std::size_t vecSize = vecCore::VectorSize<ROOT::Double_v>();
+   for (; i + vecSize <= n; i += vecSize) {
+      ROOT::Double_v v, w;
+      vecCore::Load<ROOT::Double_v>(v, x + i);
+      vecCore::Load<ROOT::Double_v>(w, y + i);
+      vecCore::Store<ROOT::Double_v>(func(v, w), result + i);
+   }
+#endif
+   for (; i < n; ++i)
+      result[i] = func(x[i], y[i]);
+}
+
+struct Erf {
+   template <class T>
+   T operator()(const T &x) const
+   {
+      return ROOT::Math::Vec::erf(x);
+   }
+};
+
+struct Erfc {
+   template <class T>
+   T operator()(const T &x) const
+   {
+      return ROOT::Math::Vec::erfc(x);
+   }
+};
+
+struct LogGamma {
+   template <class T>
+   T operator()(const T &x) const
+   {
+      return ROOT::Math::Vec::lgamma(x);
+   }
+};
+
+struct NormalPdf {
+   double fSigma, fX0;
+   template <class T>
+   T operator()(const T &x) const
+   {
+      return ROOT::Math::Vec::normal_pdf(x, fSigma, fX0);
+   }
+};
+
+struct NormalCdf {
+   double fSigma, fX0;
+   template <class T>
+   T operator()(const T &x) const
+   {
+      return ROOT::Math::Vec::normal_cdf(x, fSigma, fX0);
+   }
+};
+
+struct NormalCdfC {
+   double fSigma, fX0;
+   template <class T>
+   T operator()(const T &x) const
+   {
+      return ROOT::Math::Vec::normal_cdf_c(x, fSigma, fX0);
+   }
+};
+
+struct PoissonPdf {
+   template <class T>
+   T operator()(const T &k, const T &mu) const
+   {
+      return ROOT::Math::Vec::poisson_pdf(k, mu);
+   }
+};
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace Math {
+namespace Vec {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate erf for the n values of x.
+
+void erf(std::size_t n, const double *x, double *result)
+{
+   Apply(n, x, result, Erf());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate erfc for the n values of x.
+
+void erfc(std::size_t n, const double *x, double *result)
+{
+   Apply(n, x, result, Erfc());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate lgamma for the n values of x.
+
+void lgamma(std::size_t n, const double *x, double *result)
+{
+   Apply(n, x, result, LogGamma());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the normal density with the given sigma and mean x0 for the n values of x.
+
+void normal_pdf(std::size_t n, const double *x, double *result, double sigma, double x0)
+{
+   Apply(n, x, result, NormalPdf{sigma, x0});
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the lower tail of the normal distribution for the n values of x.
+
+void normal_cdf(std::size_t n, const double *x, double *result, double sigma, double x0)
+{
+   Apply(n, x, result, NormalCdf{sigma, x0});
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the upper tail of the normal distribution for the n values of x.
+
+void normal_cdf_c(std::size_t n, const double *x, double *result, double sigma, double x0)
+{
+   Apply(n, x, result, NormalCdfC{sigma, x0});
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the Poisson probability of k[i] events for the mean mu[i], for i < n.
+
+void poisson_pdf(std::size_t n, const double *k, const double *mu, double *result)
+{
+   Apply(n, k, mu, result, PoissonPdf());
+}
+
+} // namespace Vec
+} // namespace Math
+} // namespace ROOT
@@ -241,6 +241,8 @@ protected:
             std::cout << "   RUN MULTI-THREAD \n";
          else if (fExecutionPolicy == ROOT::Fit::ExecutionPolicy::kMultiprocess)
             std::cout << "   RUN MULTI-PROCESS \n";
+         else if (fExecutionPolicy == ROOT::Fit::ExecutionPolicy::kGPU)
+            std::cout << "   RUN GPU \n";
 
          std::cout << "**************************************\n";
       }
@@ -283,7 +285,14 @@ TYPED_TEST_P(GradientFittingTest, Multithread)
    EXPECT_TRUE(TestFixture::RunFit(ROOT::Fit::ExecutionPolicy::kMultithread));
 }
 
-REGISTER_TYPED_TEST_SUITE_P(GradientFittingTest,Sequential,Multithread);
+// The model functions do not implement ROOT::Fit::IDeviceModelFunction: the fit method functions must fall back
+// to the evaluation on the CPU
+TYPED_TEST_P(GradientFittingTest, GPUFallback)
+{
+   EXPECT_TRUE(TestFixture::RunFit(ROOT::Fit::ExecutionPolicy::kGPU));
+}
+
+REGISTER_TYPED_TEST_SUITE_P(GradientFittingTest,Sequential,Multithread,GPUFallback);
 
 INSTANTIATE_TYPED_TEST_SUITE_P(GradientFitting, GradientFittingTest, TestTypes);
 
@@ -2,6 +2,7 @@
 #include "Math/TRandomEngine.h"
 #include "Math/MersenneTwisterEngine.h"
 #include "Math/MixMaxEngine.h"
+#include "Math/RandomStreams.h"
 //#include "Math/MyMixMaxEngine.h"
 //#include "Math/GSLRndmEngines.h"
 #include "Math/GoFTest.h"
@@ -192,6 +193,63 @@ bool test4() {
    return ret; 
 }
 
+template <class Engine>
+bool testArray(const char *name) {
+
+   // the array generation must give the same sequence as the single numbers, also when mixed with them
+   Engine e1(1111);
+   Engine e2(1111);
+   std::vector<double> x(2000);
+   std::vector<double> y(x.size());
+   for (auto &xi : x) xi = e1();
+   y[0] = e2();
+   e2.RndmArray(3, &y[1]);
+   e2.RndmArray(y.size() - 4, &y[4]);
+
+   bool ok = (x == y);
+   std::cout << "Test RndmArray of " << name << (ok ? "  :  OK" : "  :  FAILED") << std::endl;
+   return ok;
+}
+
+bool test5() {
+
+   bool ret = true;
+
+   std::cout << "\nTesting array generation of MIXMAX" << std::endl;
+
+   ret &= testArray<MixMaxEngine240>("MIXMAX240");
+   ret &= testArray<MixMaxEngine<256,2>>("MIXMAX256");
+   ret &= testArray<MixMaxEngine<17,0>>("MIXMAX17");
+   return ret;
+}
+
+bool test6() {
+
+   bool ret = true;
+
+   std::cout << "\nTesting MIXMAX240 streams" << std::endl;
+
+   RandomStreams<> streams(1111);
+
+   // stream 0 is the sequence of the seed
+   MixMaxEngine240 e0(1111);
+   auto s0 = streams.GetStream(0);
+   bool ok = true;
+   for (int i = 0; i < 1000; ++i)
+      ok &= ((*s0)() == e0());
+   std::cout << "Test stream 0 " << (ok ? "  :  OK" : "  :  FAILED") << std::endl;
+   ret &= ok;
+
+   // different streams are independent
+   Random<MixMaxEngine240> rmx1;
+   Random<MixMaxEngine240> rmx2;
+   streams.SeedStream(rmx1.Rng(), 1);
+   streams.SeedStream(rmx2.Rng(), 2);
+   ret &= testUniform(rmx1, rmx2);
+   ret &= testGauss(rmx1, rmx2);
+   return ret;
+}
+
 
 bool testMathRandom() {
 
@@ -203,6 +261,8 @@ bool testMathRandom() {
    ret &= test2(); 
    ret &= test3(); 
    ret &= test4(); 
+   ret &= test5();
+   ret &= test6();
 
    if (!ret) Error("testMathRandom","Test Failed");
    else
@@ -0,0 +1,117 @@
+#include "Math/VecFuncMathCore.h"
+#include "Math/PdfFuncMathCore.h"
+#include "Math/ProbFuncMathCore.h"
+#include "Math/SpecFuncMathCore.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Odd size, so that the arrays end with a partial vector
+constexpr std::size_t kN = 10001;
+
+static std::vector<double> Uniform(double a, double b, unsigned int seed)
+{
+   std::mt19937 gen(seed);
+   std::uniform_real_distribution<double> dist(a, b);
+   std::vector<double> x(kN);
+   for (auto &v : x)
+      v = dist(gen);
+   return x;
+}
+
+static void ExpectClose(double expected, double value, double tolerance)
+{
+   if (expected == value)
+      return;
+   EXPECT_LE(std::abs(value - expected), tolerance * std::abs(expected)) << "expected " << expected << ", got " << value;
+}
+
+TEST(VecFuncMathCore, Erf)
+{
+   const auto x = Uniform(-10, 10, 1);
+   std::vector<double> res(kN), resc(kN);
+   ROOT::Math::Vec::erf(kN, x.data(), res.data());
+   ROOT::Math::Vec::erfc(kN, x.data(), resc.data());
+   for (std::size_t i = 0; i < kN; ++i) {
+      ExpectClose(ROOT::Math::erf(x[i]), res[i], 1e-15);
+      ExpectClose(ROOT::Math::erfc(x[i]), resc[i], 1e-15);
+   }
+   for (double v : {0., 1., -1., 8., -8., 30., -30.}) {
+      EXPECT_EQ(ROOT::Math::erf(v), ROOT::Math::Vec::erf(v));
+      EXPECT_EQ(ROOT::Math::erfc(v), ROOT::Math::Vec::erfc(v));
+   }
+}
+
+TEST(VecFuncMathCore, LogGamma)
+{
+   const auto x = Uniform(-50, 200, 2);
+   std::vector<double> res(kN);
+   ROOT::Math::Vec::lgamma(kN, x.data(), res.data());
+   for (std::size_t i = 0; i < kN; ++i) {
+      const double expected = ROOT::Math::lgamma(x[i]);
+      if (x[i] < 0)
+         EXPECT_NEAR(expected, res[i], 1e-13);
+      else if (std::abs(expected) < 1)
+         EXPECT_NEAR(expected, res[i], 1e-15);
+      else
+         ExpectClose(expected, res[i], 1e-15);
+   }
+   const double inf = std::numeric_limits<double>::infinity();
+   for (double v : {0., -1., -3., inf})
+      EXPECT_EQ(inf, ROOT::Math::Vec::lgamma(v));
+   EXPECT_EQ(0., ROOT::Math::Vec::lgamma(1.));
+   EXPECT_EQ(0., ROOT::Math::Vec::lgamma(2.));
+}
+
+TEST(VecFuncMathCore, Normal)
+{
+   const auto x = Uniform(-30, 30, 3);
+   std::vector<double> pdf(kN), cdf(kN), cdfc(kN);
+   ROOT::Math::Vec::normal_pdf(kN, x.data(), pdf.data(), 2., 1.);
+   ROOT::Math::Vec::normal_cdf(kN, x.data(), cdf.data(), 2., 1.);
+   ROOT::Math::Vec::normal_cdf_c(kN, x.data(), cdfc.data(), 2., 1.);
+   for (std::size_t i = 0; i < kN; ++i) {
+      ExpectClose(ROOT::Math::normal_pdf(x[i], 2., 1.), pdf[i], 1e-15);
+      ExpectClose(ROOT::Math::normal_cdf(x[i], 2., 1.), cdf[i], 1e-15);
+      ExpectClose(ROOT::Math::normal_cdf_c(x[i], 2., 1.), cdfc[i], 1e-15);
+   }
+}
+
+TEST(VecFuncMathCore, Poisson)
+{
+   auto k = Uniform(0, 1000, 4);
+   for (auto &v : k)
+      v = std::floor(v);
+   const auto mu = Uniform(0, 1000, 5);
+   std::vector<double> res(kN);
+   ROOT::Math::Vec::poisson_pdf(kN, k.data(), mu.data(), res.data());
+   for (std::size_t i = 0; i < kN; ++i)
+      ExpectClose(ROOT::Math::poisson_pdf(static_cast<unsigned int>(k[i]), mu[i]), res[i], 1e-15);
+
+   EXPECT_EQ(1., ROOT::Math::Vec::poisson_pdf(0., 0.));
+   EXPECT_EQ(0., ROOT::Math::Vec::poisson_pdf(3., 0.));
+   EXPECT_TRUE(std::isnan(ROOT::Math::Vec::poisson_pdf(2., -1.)));
+}
+
+#ifdef R__HAS_VECCORE
+// The lanes of a vector give the same results as the scalar instantiation
+TEST(VecFuncMathCore, VectorLanes)
+{
+   const auto x = Uniform(-20, 20, 6);
+   const std::size_t vecSize = vecCore::VectorSize<ROOT::Double_v>();
+   for (std::size_t i = 0; i + vecSize <= kN; i += vecSize) {
+      ROOT::Double_v v;
+      vecCore::Load<ROOT::Double_v>(v, &x[i]);
+      const ROOT::Double_v resErf = ROOT::Math::Vec::erf(v);
+      const ROOT::Double_v resGamma = ROOT::Math::Vec::lgamma(v);
+      for (std::size_t j = 0; j < vecSize; ++j) {
+         EXPECT_EQ(ROOT::Math::Vec::erf(x[i + j]), vecCore::Get(resErf, j));
+         EXPECT_EQ(ROOT::Math::Vec::lgamma(x[i + j]), vecCore::Get(resGamma, j));
+      }
+   }
+}
+#endif
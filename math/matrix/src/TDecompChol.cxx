@@ -26,6 +26,7 @@
 
 #include "TDecompChol.h"
 #include "TMath.h"
+#include "TMatrixTLapack.h"
 
 ClassImp(TDecompChol);
 
@@ -115,6 +116,14 @@ Bool_t TDecompChol::Decompose()
    Int_t i,j,icol,irow;
    const Int_t     n  = fU.GetNrows();
          Double_t *pU = fU.GetMatrixArray();
+#ifdef R__MATRIX_USE_LAPACK
+   if (n >= TMatrixTLapack::kMinSize) {
+      if (!TMatrixTLapack::DecomposeChol(n,pU)) {
+         Error("Decompose()","matrix not positive definite");
+         return kFALSE;
+      }
+   } else
+#endif
    for (icol = 0; icol < n; icol++) {
       const Int_t rowOff = icol*n;
 
@@ -11,6 +11,9 @@
 
 #include "TDecompLU.h"
 #include "TMath.h"
+#include "TMatrixTLapack.h"
+
+#include <vector>
 
 ClassImp(TDecompLU);
 
@@ -136,6 +139,14 @@ Bool_t TDecompLU::Decompose()
    Bool_t ok;
    if (fImplicitPivot)
       ok = DecomposeLUCrout(fLU,fIndex,fSign,fTol,nrZeros);
+#ifdef R__MATRIX_USE_LAPACK
+   // the external library does the same elimination with partial pivoting as DecomposeLUGauss
+   else if (fLU.GetNrows() >= TMatrixTLapack::kMinSize) {
+      ok = TMatrixTLapack::DecomposeLU(fLU.GetNrows(),fLU.GetMatrixArray(),fIndex,fSign);
+      if (!ok)
+         Error("Decompose()","matrix is singular");
+   }
+#endif
    else
       ok = DecomposeLUGauss(fLU,fIndex,fSign,fTol,nrZeros);
 
@@ -785,6 +796,34 @@ Bool_t TDecompLU::InvertLU(TMatrixD &lu,Double_t tol,Double_t *det)
    const Int_t     n   = lu.GetNcols();
    Double_t *pLU = lu.GetMatrixArray();
 
+#ifdef R__MATRIX_USE_LAPACK
+   if (n >= TMatrixTLapack::kMinSize) {
+      std::vector<Int_t> ipiv(n);
+      Double_t sign = 1.0;
+      const Bool_t ok = TMatrixTLapack::FactorizeLU(n,pLU,ipiv.data(),sign);
+      Int_t nrZeros = 0;
+      for (Int_t i = 0; i < n; i++) {
+         if (TMath::Abs(pLU[i*n+i]) < tol)
+            nrZeros++;
+      }
+      if (!ok || nrZeros > 0) {
+         ::Error("TDecompLU::InvertLU","matrix is singular, %d diag elements < tolerance of %.4e",nrZeros,tol);
+         return kFALSE;
+      }
+
+      if (det) {
+         Double_t d1;
+         Double_t d2;
+         const TVectorD diagv = TMatrixDDiag_const(lu);
+         DiagProd(diagv,tol,d1,d2);
+         d1 *= sign;
+         *det = d1*TMath::Power(2.0,d2);
+      }
+
+      return TMatrixTLapack::InvertFactorizedLU(n,pLU,ipiv.data());
+   }
+#endif
+
    Int_t worki[kWorkMax];
    Bool_t isAllocatedI = kFALSE;
    Int_t *index = worki;
@@ -43,6 +43,7 @@
 #include "TDecompSVD.h"
 #include "TMath.h"
 #include "TArrayD.h"
+#include "TMatrixTLapack.h"
 
 ClassImp(TDecompSVD);
 
@@ -133,6 +134,23 @@ Bool_t TDecompSVD::Decompose()
    const Int_t rowLwb = this->GetRowLwb();
    const Int_t colLwb = this->GetColLwb();
 
+#ifdef R__MATRIX_USE_LAPACK
+   if (nCol >= TMatrixTLapack::kMinSize) {
+      TMatrixD v(nCol,nCol);
+      if (!TMatrixTLapack::DecomposeSVD(fV.GetNrows(),nCol,fV.GetMatrixArray(),fU.GetMatrixArray(),
+                                        fSig.GetMatrixArray(),v.GetMatrixArray())) {
+         Error("Decompose()","singular value decomposition did not converge");
+         return kFALSE;
+      }
+      fV.ResizeTo(nCol,nCol); fV = v; fV.Shift(colLwb,colLwb);
+      fSig.Shift(colLwb);
+      fU.Shift(rowLwb,colLwb);
+      SetBit(kDecomposed);
+
+      return kTRUE;
+   }
+#endif
+
    TVectorD offDiag;
    Double_t work[kWorkMax];
    if (nCol > kWorkMax) offDiag.ResizeTo(nCol);
@@ -25,6 +25,7 @@
 
 #include "TMatrixDSymEigen.h"
 #include "TMath.h"
+#include "TMatrixTLapack.h"
 
 ClassImp(TMatrixDSymEigen);
 
@@ -43,6 +44,16 @@ TMatrixDSymEigen::TMatrixDSymEigen(const TMatrixDSym &a)
 
    fEigenVectors = a;
 
+#ifdef R__MATRIX_USE_LAPACK
+   if (nRows >= TMatrixTLapack::kMinSize) {
+      TMatrixDSym tmp(a);
+      if (!TMatrixTLapack::SymEigen(nRows,tmp.GetMatrixArray(),fEigenValues.GetMatrixArray(),
+                                    fEigenVectors.GetMatrixArray()))
+         Error("TMatrixDSymEigen","eigenvalue decomposition did not converge");
+      return;
+   }
+#endif
+
    TVectorD offDiag;
    Double_t work[kWorkMax];
    if (nRows > kWorkMax) offDiag.ResizeTo(nRows);
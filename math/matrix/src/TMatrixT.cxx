@@ -20,8 +20,6 @@
 
 */
 
-#include <typeinfo>
-
 #include "TMatrixT.h"
 #include "TBuffer.h"
 #include "TMatrixTSym.h"
@@ -30,6 +28,7 @@
 #include "TDecompLU.h"
 #include "TMatrixDEigen.h"
 #include "TMath.h"
+#include "TMatrixTLapack.h"
 
 templateClassImp(TMatrixT);
 
@@ -665,19 +664,14 @@ void TMatrixT<Element>::Mult(const TMatrixT<Element> &a,const TMatrixT<Element>
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasNoTrans,CblasNoTrans,fNrows,fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasNoTrans,CblasNoTrans,fNrows,fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else
-      Error("Mult","type %s not implemented in BLAS library",typeid(Element));
-#else
+#ifdef R__MATRIX_USE_LAPACK
+   if (TMatrixTLapack::UseLapack(this->fNrows,this->fNcols,a.GetNcols())) {
+      TMatrixTLapack::Gemm(kFALSE,kFALSE,this->fNrows,this->fNcols,a.GetNcols(),a.GetMatrixArray(),b.GetMatrixArray(),
+                           this->GetMatrixArray());
+      return;
+   }
+#endif
+
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -687,7 +681,6 @@ void TMatrixT<Element>::Mult(const TMatrixT<Element> &a,const TMatrixT<Element>
          Element *       cp = this->GetMatrixArray();
 
    AMultB(ap,na,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -716,19 +709,14 @@ void TMatrixT<Element>::Mult(const TMatrixTSym<Element> &a,const TMatrixT<Elemen
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dsymm (CblasRowMajor,CblasLeft,CblasUpper,fNrows,fNcols,1.0,
-                   ap,a.GetNcols(),bp,b.GetNcols(),0.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_ssymm (CblasRowMajor,CblasLeft,CblasUpper,fNrows,fNcols,1.0,
-                   ap,a.GetNcols(),bp,b.GetNcols(),0.0,cp,fNcols);
-   else
-      Error("Mult","type %s not implemented in BLAS library",typeid(Element));
-#else
+#ifdef R__MATRIX_USE_LAPACK
+   if (TMatrixTLapack::UseLapack(this->fNrows,this->fNcols,a.GetNcols())) {
+      TMatrixTLapack::Gemm(kFALSE,kFALSE,this->fNrows,this->fNcols,a.GetNcols(),a.GetMatrixArray(),b.GetMatrixArray(),
+                           this->GetMatrixArray());
+      return;
+   }
+#endif
+
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -738,8 +726,6 @@ void TMatrixT<Element>::Mult(const TMatrixTSym<Element> &a,const TMatrixT<Elemen
          Element *       cp = this->GetMatrixArray();
 
    AMultB(ap,na,ncolsa,bp,nb,ncolsb,cp);
-
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -768,19 +754,14 @@ void TMatrixT<Element>::Mult(const TMatrixT<Element> &a,const TMatrixTSym<Elemen
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dsymm (CblasRowMajor,CblasRight,CblasUpper,fNrows,fNcols,1.0,
-                   bp,b.GetNcols(),ap,a.GetNcols(),0.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_ssymm (CblasRowMajor,CblasRight,CblasUpper,fNrows,fNcols,1.0,
-                   bp,b.GetNcols(),ap,a.GetNcols(),0.0,cp,fNcols);
-   else
-      Error("Mult","type %s not implemented in BLAS library",typeid(Element));
-#else
+#ifdef R__MATRIX_USE_LAPACK
+   if (TMatrixTLapack::UseLapack(this->fNrows,this->fNcols,a.GetNcols())) {
+      TMatrixTLapack::Gemm(kFALSE,kFALSE,this->fNrows,this->fNcols,a.GetNcols(),a.GetMatrixArray(),b.GetMatrixArray(),
+                           this->GetMatrixArray());
+      return;
+   }
+#endif
+
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -790,7 +771,6 @@ void TMatrixT<Element>::Mult(const TMatrixT<Element> &a,const TMatrixTSym<Elemen
          Element *       cp = this->GetMatrixArray();
 
    AMultB(ap,na,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -820,19 +800,14 @@ void TMatrixT<Element>::Mult(const TMatrixTSym<Element> &a,const TMatrixTSym<Ele
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dsymm (CblasRowMajor,CblasLeft,CblasUpper,fNrows,fNcols,1.0,
-                   ap,a.GetNcols(),bp,b.GetNcols(),0.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_ssymm (CblasRowMajor,CblasLeft,CblasUpper,fNrows,fNcols,1.0,
-                   ap,a.GetNcols(),bp,b.GetNcols(),0.0,cp,fNcols);
-   else
-      Error("Mult","type %s not implemented in BLAS library",typeid(Element));
-#else
+#ifdef R__MATRIX_USE_LAPACK
+   if (TMatrixTLapack::UseLapack(this->fNrows,this->fNcols,a.GetNcols())) {
+      TMatrixTLapack::Gemm(kFALSE,kFALSE,this->fNrows,this->fNcols,a.GetNcols(),a.GetMatrixArray(),b.GetMatrixArray(),
+                           this->GetMatrixArray());
+      return;
+   }
+#endif
+
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -842,7 +817,6 @@ void TMatrixT<Element>::Mult(const TMatrixTSym<Element> &a,const TMatrixTSym<Ele
          Element *       cp = this->GetMatrixArray();
 
    AMultB(ap,na,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -871,19 +845,14 @@ void TMatrixT<Element>::TMult(const TMatrixT<Element> &a,const TMatrixT<Element>
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasTrans,CblasNoTrans,this->fNrows,this->fNcols,a.GetNrows(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,this->fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasTrans,CblasNoTrans,fNrows,fNcols,a.GetNrows(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else
-      Error("TMult","type %s not implemented in BLAS library",typeid(Element));
-#else
+#ifdef R__MATRIX_USE_LAPACK
+   if (TMatrixTLapack::UseLapack(this->fNrows,this->fNcols,a.GetNrows())) {
+      TMatrixTLapack::Gemm(kTRUE,kFALSE,this->fNrows,this->fNcols,a.GetNrows(),a.GetMatrixArray(),b.GetMatrixArray(),
+                           this->GetMatrixArray());
+      return;
+   }
+#endif
+
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
    const Int_t ncolsb = b.GetNcols();
@@ -892,7 +861,6 @@ void TMatrixT<Element>::TMult(const TMatrixT<Element> &a,const TMatrixT<Element>
          Element *       cp = this->GetMatrixArray();
 
    AtMultB(ap,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -921,19 +889,14 @@ void TMatrixT<Element>::TMult(const TMatrixT<Element> &a,const TMatrixTSym<Eleme
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasTrans,CblasNoTrans,fNrows,fNcols,a.GetNrows(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasTrans,CblasNoTrans,fNrows,fNcols,a.GetNrows(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else
-      Error("TMult","type %s not implemented in BLAS library",typeid(Element));
-#else
+#ifdef R__MATRIX_USE_LAPACK
+   if (TMatrixTLapack::UseLapack(this->fNrows,this->fNcols,a.GetNrows())) {
+      TMatrixTLapack::Gemm(kTRUE,kFALSE,this->fNrows,this->fNcols,a.GetNrows(),a.GetMatrixArray(),b.GetMatrixArray(),
+                           this->GetMatrixArray());
+      return;
+   }
+#endif
+
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
    const Int_t ncolsb = b.GetNcols();
@@ -942,7 +905,6 @@ void TMatrixT<Element>::TMult(const TMatrixT<Element> &a,const TMatrixTSym<Eleme
          Element *       cp = this->GetMatrixArray();
 
    AtMultB(ap,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -971,19 +933,14 @@ void TMatrixT<Element>::MultT(const TMatrixT<Element> &a,const TMatrixT<Element>
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasNoTrans,CblasTrans,fNrows,fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasNoTrans,CblasTrans,fNrows,fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else
-      Error("MultT","type %s not implemented in BLAS library",typeid(Element));
-#else
+#ifdef R__MATRIX_USE_LAPACK
+   if (TMatrixTLapack::UseLapack(this->fNrows,this->fNcols,a.GetNcols())) {
+      TMatrixTLapack::Gemm(kFALSE,kTRUE,this->fNrows,this->fNcols,a.GetNcols(),a.GetMatrixArray(),b.GetMatrixArray(),
+                           this->GetMatrixArray());
+      return;
+   }
+#endif
+
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -993,7 +950,6 @@ void TMatrixT<Element>::MultT(const TMatrixT<Element> &a,const TMatrixT<Element>
          Element *       cp = this->GetMatrixArray();
 
    AMultBt(ap,na,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1022,19 +978,14 @@ void TMatrixT<Element>::MultT(const TMatrixTSym<Element> &a,const TMatrixT<Eleme
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasNoTrans,CblasTrans,this->fNrows,this->fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,this->fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasNoTrans,CblasTrans,fNrows,fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else
-      Error("MultT","type %s not implemented in BLAS library",typeid(Element));
-#else
+#ifdef R__MATRIX_USE_LAPACK
+   if (TMatrixTLapack::UseLapack(this->fNrows,this->fNcols,a.GetNcols())) {
+      TMatrixTLapack::Gemm(kFALSE,kTRUE,this->fNrows,this->fNcols,a.GetNcols(),a.GetMatrixArray(),b.GetMatrixArray(),
+                           this->GetMatrixArray());
+      return;
+   }
+#endif
+
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -1044,7 +995,6 @@ void TMatrixT<Element>::MultT(const TMatrixTSym<Element> &a,const TMatrixT<Eleme
          Element *       cp = this->GetMatrixArray();
 
    AMultBt(ap,na,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
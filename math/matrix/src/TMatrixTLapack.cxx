@@ -0,0 +1,177 @@
+// @(#)root/matrix:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// Implementation of TMatrixTLapack, see TMatrixTLapack.h
+
+#include "TMatrixTLapack.h"
+
+#ifdef R__MATRIX_USE_LAPACK
+
+#include <vector>
+
+extern "C" {
+void sgemm_(const char *transa, const char *transb, const int *m, const int *n, const int *k, const float *alpha,
+            const float *a, const int *lda, const float *b, const int *ldb, const float *beta, float *c,
+            const int *ldc);
+void dgemm_(const char *transa, const char *transb, const int *m, const int *n, const int *k, const double *alpha,
+            const double *a, const int *lda, const double *b, const int *ldb, const double *beta, double *c,
+            const int *ldc);
+void dgetrf_(const int *m, const int *n, double *a, const int *lda, int *ipiv, int *info);
+void dgetri_(const int *n, double *a, const int *lda, const int *ipiv, double *work, const int *lwork, int *info);
+void dpotrf_(const char *uplo, const int *n, double *a, const int *lda, int *info);
+void dgesvd_(const char *jobu, const char *jobvt, const int *m, const int *n, double *a, const int *lda, double *s,
+             double *u, const int *ldu, double *vt, const int *ldvt, double *work, const int *lwork, int *info);
+void dsyevd_(const char *jobz, const char *uplo, const int *n, double *a, const int *lda, double *w, double *work,
+             const int *lwork, int *iwork, const int *liwork, int *info);
+}
+
+namespace {
+
+// The BLAS routines compute C = op(A) op(B) in column-major order. A row-major matrix is the transpose of the same
+// array in column-major order, so the row-major product C = op(A) op(B) is the column-major C^T = op(B)^T op(A)^T.
+
+void CallGemm(const char *transB, const char *transA, const int *n, const int *m, const int *k, const float *b,
+              const int *ldb, const float *a, const int *lda, float *c)
+{
+   const float one = 1;
+   const float zero = 0;
+   sgemm_(transB, transA, n, m, k, &one, b, ldb, a, lda, &zero, c, n);
+}
+
+void CallGemm(const char *transB, const char *transA, const int *n, const int *m, const int *k, const double *b,
+              const int *ldb, const double *a, const int *lda, double *c)
+{
+   const double one = 1;
+   const double zero = 0;
+   dgemm_(transB, transA, n, m, k, &one, b, ldb, a, lda, &zero, c, n);
+}
+
+/// transpose in place the (n x n) matrix a
+void Transpose(Int_t n, Double_t *a)
+{
+   for (Int_t i = 0; i < n; i++)
+      for (Int_t j = 0; j < i; j++) {
+         const Double_t tmp = a[i * n + j];
+         a[i * n + j] = a[j * n + i];
+         a[j * n + i] = tmp;
+      }
+}
+
+} // namespace
+
+template <class Element>
+void TMatrixTLapack::Gemm(Bool_t transA, Bool_t transB, Int_t m, Int_t n, Int_t k, const Element *a,
+                          const Element *b, Element *c)
+{
+   const int lda = transA ? m : k;
+   const int ldb = transB ? k : n;
+   CallGemm(transB ? "T" : "N", transA ? "T" : "N", &n, &m, &k, b, &ldb, a, &lda, c);
+}
+
+template void TMatrixTLapack::Gemm<Float_t>(Bool_t, Bool_t, Int_t, Int_t, Int_t, const Float_t *, const Float_t *,
+                                            Float_t *);
+template void TMatrixTLapack::Gemm<Double_t>(Bool_t, Bool_t, Int_t, Int_t, Int_t, const Double_t *,
+                                             const Double_t *, Double_t *);
+
+Bool_t TMatrixTLapack::DecomposeLU(Int_t n, Double_t *lu, Int_t *index, Double_t &sign)
+{
+   // the row interchanges and the factors L and U of the column-major matrix are the ones of the row-major matrix
+   // after transposition
+   std::vector<int> ipiv(n);
+   Transpose(n, lu);
+   int info = 0;
+   dgetrf_(&n, &n, lu, &n, ipiv.data(), &info);
+   Transpose(n, lu);
+
+   sign = 1.0;
+   for (Int_t i = 0; i < n; i++) {
+      index[i] = ipiv[i] - 1;
+      if (index[i] != i)
+         sign = -sign;
+   }
+   return info == 0;
+}
+
+Bool_t TMatrixTLapack::FactorizeLU(Int_t n, Double_t *a, Int_t *ipiv, Double_t &sign)
+{
+   // the inverse of the transpose is the transpose of the inverse: no transposition is needed
+   int info = 0;
+   dgetrf_(&n, &n, a, &n, ipiv, &info);
+   sign = 1.0;
+   for (Int_t i = 0; i < n; i++)
+      if (ipiv[i] != i + 1)
+         sign = -sign;
+   return info == 0;
+}
+
+Bool_t TMatrixTLapack::InvertFactorizedLU(Int_t n, Double_t *a, const Int_t *ipiv)
+{
+   int info = 0;
+   int lwork = -1;
+   double workSize = 0;
+   dgetri_(&n, a, &n, ipiv, &workSize, &lwork, &info);
+   lwork = static_cast<int>(workSize);
+   std::vector<double> work(lwork);
+   dgetri_(&n, a, &n, ipiv, work.data(), &lwork, &info);
+   return info == 0;
+}
+
+Bool_t TMatrixTLapack::DecomposeChol(Int_t n, Double_t *a)
+{
+   // the lower triangle L of the column-major matrix, with A = L L^T, is the upper triangle U = L^T of the
+   // row-major matrix
+   int info = 0;
+   dpotrf_("L", &n, a, &n, &info);
+   return info == 0;
+}
+
+Bool_t TMatrixTLapack::DecomposeSVD(Int_t m, Int_t n, Double_t *a, Double_t *u, Double_t *sig, Double_t *v)
+{
+   // the column-major matrix is A^T = V S U^T: its left singular vectors are the columns of V, and its V^T is U^T
+   // in column-major order, i.e. U in row-major order
+   std::vector<double> vcm(n * n);
+   int info = 0;
+   int lwork = -1;
+   double workSize = 0;
+   dgesvd_("A", "A", &n, &m, a, &n, sig, vcm.data(), &n, u, &m, &workSize, &lwork, &info);
+   lwork = static_cast<int>(workSize);
+   std::vector<double> work(lwork);
+   dgesvd_("A", "A", &n, &m, a, &n, sig, vcm.data(), &n, u, &m, work.data(), &lwork, &info);
+   for (Int_t i = 0; i < n; i++)
+      for (Int_t j = 0; j < n; j++)
+         v[i * n + j] = vcm[j * n + i];
+   return info == 0;
+}
+
+Bool_t TMatrixTLapack::SymEigen(Int_t n, Double_t *a, Double_t *eigenValues, Double_t *v)
+{
+   std::vector<double> w(n);
+   int info = 0;
+   int lwork = -1;
+   int liwork = -1;
+   double workSize = 0;
+   int iworkSize = 0;
+   dsyevd_("V", "L", &n, a, &n, w.data(), &workSize, &lwork, &iworkSize, &liwork, &info);
+   lwork = static_cast<int>(workSize);
+   liwork = iworkSize;
+   std::vector<double> work(lwork);
+   std::vector<int> iwork(liwork);
+   dsyevd_("V", "L", &n, a, &n, w.data(), work.data(), &lwork, iwork.data(), &liwork, &info);
+   // the eigenvalues are in increasing order and the eigenvectors are the columns of the column-major matrix
+   for (Int_t j = 0; j < n; j++) {
+      const Int_t col = n - 1 - j;
+      eigenValues[col] = w[j];
+      for (Int_t i = 0; i < n; i++)
+         v[i * n + col] = a[j * n + i];
+   }
+   return info == 0;
+}
+
+#endif
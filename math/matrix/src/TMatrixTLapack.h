@@ -0,0 +1,77 @@
+// @(#)root/matrix:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TMatrixTLapack
+#define ROOT_TMatrixTLapack
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TMatrixTLapack                                                       //
+//                                                                      //
+// Internal interface to an external, possibly multithreaded, BLAS and  //
+// LAPACK library (e.g. OpenBLAS or MKL), used instead of the in-house  //
+// code for the products and decompositions of large matrices when ROOT //
+// is built with matrix_lapack=ON (R__MATRIX_USE_LAPACK).               //
+//                                                                      //
+// The matrices of the linear algebra package are stored in row-major   //
+// order, while the library uses column-major order: the functions take //
+// and return row-major arrays and do the needed transpositions.        //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifdef R__MATRIX_USE_LAPACK
+
+#include "Rtypes.h"
+
+namespace TMatrixTLapack {
+
+/// below this dimension the in-house code is used: the calls to the external library cost more than what its
+/// optimized and multithreaded kernels save
+const Int_t kMinSize = 64;
+
+/// whether the product of an (m x k) and a (k x n) matrix is large enough for the external library
+inline Bool_t UseLapack(Int_t m, Int_t n, Int_t k)
+{
+   return Double_t(m) * n * k >= Double_t(kMinSize) * kMinSize * kMinSize;
+}
+
+/// c = op(a) * op(b), with op(a) an (m x k) matrix, op(b) a (k x n) matrix and op(x) = x^T if transX
+template <class Element>
+void Gemm(Bool_t transA, Bool_t transB, Int_t m, Int_t n, Int_t k, const Element *a, const Element *b,
+          Element *c);
+
+/// LU decomposition with partial pivoting of the (n x n) matrix lu, in place, in the format of
+/// TDecompLU::DecomposeLUGauss. Return kFALSE if the matrix is singular.
+Bool_t DecomposeLU(Int_t n, Double_t *lu, Int_t *index, Double_t &sign);
+
+/// LU decomposition with partial pivoting of the transpose of the (n x n) matrix a, in place, for
+/// InvertFactorizedLU. The diagonal of U and sign give the determinant of a. ipiv must have n elements.
+Bool_t FactorizeLU(Int_t n, Double_t *a, Int_t *ipiv, Double_t &sign);
+
+/// inverse of the (n x n) matrix a, in place, from the output of FactorizeLU
+Bool_t InvertFactorizedLU(Int_t n, Double_t *a, const Int_t *ipiv);
+
+/// Cholesky decomposition A = U^T U of the (n x n) symmetric matrix a; U is written in the upper triangle.
+/// Return kFALSE if the matrix is not positive definite.
+Bool_t DecomposeChol(Int_t n, Double_t *a);
+
+/// singular value decomposition A = U S V^T of the (m x n) matrix a, m >= n, with the (m x m) matrix u, the n
+/// singular values sig, in decreasing order, and the (n x n) matrix v. a is destroyed.
+Bool_t DecomposeSVD(Int_t m, Int_t n, Double_t *a, Double_t *u, Double_t *sig, Double_t *v);
+
+/// eigenvalues, in decreasing order, and eigenvectors, in the columns of v, of the (n x n) symmetric matrix a.
+/// a is destroyed.
+Bool_t SymEigen(Int_t n, Double_t *a, Double_t *eigenValues, Double_t *v);
+
+} // namespace TMatrixTLapack
+
+#endif
+
+#endif
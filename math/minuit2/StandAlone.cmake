@@ -157,6 +157,7 @@ endif()
 # Setup package info
 add_feature_info(minuit2_openmp minuit2_openmp "OpenMP (Thread safe FCNs only)")
 add_feature_info(minuit2_mpi minuit2_mpi "MPI (Thread safe FCNs only)")
+add_feature_info(minuit2_lapack minuit2_lapack "External BLAS/LAPACK for large matrices")
 set_package_properties(OpenMP PROPERTIES
     URL "http://www.openmp.org"
     DESCRIPTION "Parallel compiler directives"
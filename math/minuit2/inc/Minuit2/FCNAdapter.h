@@ -36,7 +36,8 @@ public:
 
    FCNAdapter(const Function & f, double up = 1.) :
       fFunc(f) ,
-      fUp (up)
+      fUp (up),
+      fThreadSafe(false)
    {}
 
    ~FCNAdapter() {}
@@ -52,6 +53,10 @@ public:
 
    void SetErrorDef(double up) { fUp = up; }
 
+   /// declare that the wrapped function can be evaluated concurrently (see FCNBase::IsThreadSafe)
+   void SetThreadSafe(bool on = true) { fThreadSafe = on; }
+   bool IsThreadSafe() const { return fThreadSafe; }
+
    //virtual std::vector<double> Gradient(const std::vector<double>&) const;
 
    // forward interface
@@ -60,6 +65,7 @@ public:
 private:
    const Function & fFunc;
    double fUp;
+   bool fThreadSafe;
 };
 
    } // end namespace Minuit2
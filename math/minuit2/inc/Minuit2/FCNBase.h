@@ -113,6 +113,16 @@ public:
    */
    virtual void SetErrorDef(double ) {};
 
+   /**
+      Return true if operator() can be called concurrently from several threads,
+      i.e. if it does not modify any state shared between calls.
+      Minuit then computes the numerical derivatives of the different parameters
+      in parallel when ROOT's implicit multi-threading is enabled.
+      The result does not depend on the number of threads.
+      Re-implement this function if needed.
+   */
+   virtual bool IsThreadSafe() const { return false; }
+
 };
 
   }  // namespace Minuit2
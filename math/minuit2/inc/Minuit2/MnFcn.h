@@ -13,6 +13,8 @@
 #include "Minuit2/MnConfig.h"
 #include "Minuit2/MnMatrix.h"
 
+#include <atomic>
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -35,6 +37,8 @@ public:
    /// constructor of
    explicit MnFcn(const FCNBase& fcn, int ncall = 0) : fFCN(fcn), fNumCall(ncall) {}
 
+   MnFcn(const MnFcn& other) : fFCN(other.fFCN), fNumCall(other.NumOfCalls()) {}
+
   virtual ~MnFcn();
 
   virtual double operator()(const MnAlgebraicVector&) const;
@@ -54,7 +58,7 @@ private:
 
 protected:
 
-  mutable int fNumCall;
+  mutable std::atomic<int> fNumCall; // atomic since the FCN may be called by several threads
 };
 
   }  // namespace Minuit2
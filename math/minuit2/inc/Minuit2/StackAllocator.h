@@ -44,8 +44,9 @@ class StackError {};
 
 /** StackAllocator controls the memory allocation/deallocation of Minuit. If
     _MN_NO_THREAD_SAVE_ is defined, memory is taken from a pre-allocated piece
-    of heap memory which is then used like a stack, otherwise via standard
-    malloc/free. Note that defining _MN_NO_THREAD_SAVE_ makes the code thread-
+    of heap memory which is then used like a stack, otherwise from a cache of
+    free blocks owned by the calling thread (see ThreadCacheAllocate).
+    Note that defining _MN_NO_THREAD_SAVE_ makes the code thread-
     unsave. The gain in performance is mainly for cost-cheap FCN functions.
  */
 
@@ -94,8 +95,7 @@ public:
 #endif
 
 #else
-      void* result = malloc(nBytes);
-      if (!result) throw std::bad_alloc();
+      void* result = ThreadCacheAllocate(nBytes);
 #endif
 
       return result;
@@ -124,7 +124,7 @@ public:
       CheckConsistency();
 #endif
 #else
-      free(p);
+      ThreadCacheDeallocate(p);
 #endif
       // std::cout << "Block at " << delBlock
       //   << " deallocated, fStackOffset = " << fStackOffset << std::endl;
@@ -202,6 +202,15 @@ public:
      return true;
   }
 
+  /// Allocate nBytes from the free blocks cached by the calling thread, or from the heap if there is none of the
+  /// right size. Threads running independent minimizations therefore neither share state nor, after the first
+  /// iterations, call malloc for the temporary vectors and matrices.
+  static void* ThreadCacheAllocate(size_t nBytes);
+
+  /// Give back a block obtained with ThreadCacheAllocate, possibly by another thread: it is kept in the cache of the
+  /// calling thread, unless the cache is full.
+  static void ThreadCacheDeallocate(void* p);
+
 private:
 
   unsigned char* fStack;
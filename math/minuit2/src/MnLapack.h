@@ -0,0 +1,40 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2020 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+// Internal header: routines of an external BLAS/LAPACK library (e.g. OpenBLAS or MKL), used instead of the
+// f2c translations for the matrices of size at least kMinSizeForLapack when Minuit2 is built with
+// minuit2_lapack=ON (MINUIT2_USE_LAPACK).
+// The symmetric matrices of Minuit2 (LASymMatrix) are stored in the packed format of the upper triangle used by
+// these routines (uplo = 'U'), so that no conversion is needed.
+
+#ifndef ROOT_Minuit2_MnLapack
+#define ROOT_Minuit2_MnLapack
+
+#ifdef MINUIT2_USE_LAPACK
+
+extern "C" void dspmv_(const char *uplo, const int *n, const double *alpha, const double *ap, const double *x,
+                       const int *incx, const double *beta, double *y, const int *incy);
+extern "C" void dspr_(const char *uplo, const int *n, const double *alpha, const double *x, const int *incx,
+                      double *ap);
+extern "C" void dpptrf_(const char *uplo, const int *n, double *ap, int *info);
+extern "C" void dpptri_(const char *uplo, const int *n, double *ap, int *info);
+
+namespace ROOT {
+
+   namespace Minuit2 {
+
+/// below this size the calls to the external library cost more than what its optimized kernels save
+const unsigned int kMinSizeForLapack = 64;
+
+   }  // namespace Minuit2
+
+}  // namespace ROOT
+
+#endif
+
+#endif  // ROOT_Minuit2_MnLapack
@@ -0,0 +1,117 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2020 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#include "Minuit2/StackAllocator.h"
+
+namespace ROOT {
+
+   namespace Minuit2 {
+
+namespace {
+
+// The blocks are cached in size classes of 2^(kMinClassLog + i) bytes, i < kNClasses (16 bytes to 1 MB).
+// Larger blocks, e.g. the matrices of fits with several hundreds of parameters, are not cached.
+const unsigned int kMinClassLog = 4;
+const unsigned int kNClasses = 17;
+
+// maximum number of free blocks cached per size class and thread
+const unsigned int kMaxCachedBlocks = 32;
+
+// every block starts with a header holding its size class (kNClasses for the blocks which are not cached);
+// its size keeps the memory returned to the caller aligned as the one returned by malloc
+const size_t kHeaderSize = 16;
+
+struct FreeBlock {
+   FreeBlock *fNext;
+};
+
+struct ThreadCache {
+   FreeBlock *fFree[kNClasses];
+   unsigned int fCount[kNClasses];
+};
+
+enum ECacheState { kCacheUnused, kCacheAlive, kCacheDestroyed };
+
+// these are trivially destructible, so that they can be used also while the thread exits, after the cache
+// has been emptied by ~ThreadCacheCleaner
+thread_local ThreadCache gThreadCache;
+thread_local ECacheState gThreadCacheState = kCacheUnused;
+
+struct ThreadCacheCleaner {
+   ThreadCacheCleaner() { gThreadCacheState = kCacheAlive; }
+   ~ThreadCacheCleaner()
+   {
+      for (unsigned int i = 0; i < kNClasses; ++i) {
+         while (gThreadCache.fFree[i]) {
+            FreeBlock *block = gThreadCache.fFree[i];
+            gThreadCache.fFree[i] = block->fNext;
+            free(reinterpret_cast<unsigned char *>(block) - kHeaderSize);
+         }
+         gThreadCache.fCount[i] = 0;
+      }
+      gThreadCacheState = kCacheDestroyed;
+   }
+};
+
+thread_local ThreadCacheCleaner gThreadCacheCleaner;
+
+unsigned int SizeClass(size_t nBytes)
+{
+   unsigned int i = 0;
+   while (i < kNClasses && (size_t(1) << (kMinClassLog + i)) < nBytes)
+      ++i;
+   return i;
+}
+
+bool UseThreadCache()
+{
+   // the first use of the cleaner in the thread constructs it and registers its destruction at the exit of the thread
+   if (gThreadCacheState == kCacheUnused)
+      (void)&gThreadCacheCleaner;
+   return gThreadCacheState == kCacheAlive;
+}
+
+} // anonymous namespace
+
+void *StackAllocator::ThreadCacheAllocate(size_t nBytes)
+{
+   const unsigned int cls = SizeClass(nBytes);
+   if (cls < kNClasses && UseThreadCache() && gThreadCache.fFree[cls]) {
+      FreeBlock *block = gThreadCache.fFree[cls];
+      gThreadCache.fFree[cls] = block->fNext;
+      --gThreadCache.fCount[cls];
+      return block;
+   }
+
+   const size_t size = (cls < kNClasses) ? (size_t(1) << (kMinClassLog + cls)) : nBytes;
+   unsigned char *base = static_cast<unsigned char *>(malloc(kHeaderSize + size));
+   if (!base)
+      throw std::bad_alloc();
+   *reinterpret_cast<unsigned int *>(base) = cls;
+   return base + kHeaderSize;
+}
+
+void StackAllocator::ThreadCacheDeallocate(void *p)
+{
+   if (!p)
+      return;
+   unsigned char *base = static_cast<unsigned char *>(p) - kHeaderSize;
+   const unsigned int cls = *reinterpret_cast<unsigned int *>(base);
+   if (cls < kNClasses && UseThreadCache() && gThreadCache.fCount[cls] < kMaxCachedBlocks) {
+      FreeBlock *block = static_cast<FreeBlock *>(p);
+      block->fNext = gThreadCache.fFree[cls];
+      gThreadCache.fFree[cls] = block;
+      ++gThreadCache.fCount[cls];
+      return;
+   }
+   free(base);
+}
+
+   }  // namespace Minuit2
+
+}  // namespace ROOT
@@ -12,6 +12,8 @@
    -lf2c -lm   (in that order)
 */
 
+#include "MnLapack.h"
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -129,6 +131,14 @@ int Mndspmv(const char* uplo, unsigned int n, double alpha,
    /*     .. */
    /*     .. Executable Statements .. */
 
+#ifdef MINUIT2_USE_LAPACK
+   if (n >= kMinSizeForLapack) {
+      const int nn = n;
+      dspmv_(uplo, &nn, &alpha, ap, x, &incx, &beta, y, &incy);
+      return 0;
+   }
+#endif
+
    /*     Test the input parameters. */
 
    /* Parameter adjustments */
@@ -12,6 +12,8 @@
    -lf2c -lm   (in that order)
 */
 
+#include "MnLapack.h"
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -115,6 +117,14 @@ int mndspr(const char* uplo, unsigned int n, double alpha,
    /*     .. */
    /*     .. Executable Statements .. */
 
+#ifdef MINUIT2_USE_LAPACK
+   if (n >= kMinSizeForLapack) {
+      const int nn = n;
+      dspr_(uplo, &nn, &alpha, x, &incx, ap);
+      return 0;
+   }
+#endif
+
    /*     Test the input parameters. */
 
    /* Parameter adjustments */
@@ -8,8 +8,13 @@
  **********************************************************************/
 
 #include "Minuit2/MnMatrix.h"
+#include "MnLapack.h"
 
 #include <cmath>
+#ifdef MINUIT2_USE_LAPACK
+#include <algorithm>
+#include <vector>
+#endif
 
 namespace ROOT {
 
@@ -19,6 +24,9 @@ namespace ROOT {
 /** Inverts a symmetric matrix. Matrix is first scaled to have all ones on
     the diagonal (equivalent to change of units) but no pivoting is done
     since matrix is positive-definite.
+    When built with minuit2_lapack=ON, large matrices are inverted with the
+    Cholesky decomposition of LAPACK (dpptrf/dpptri), falling back to the
+    Gauss-Jordan elimination below if the decomposition fails.
  */
 
 int mnvert(MnAlgebraicSymMatrix& a) {
@@ -38,6 +46,24 @@ int mnvert(MnAlgebraicSymMatrix& a) {
       for(unsigned int j = i; j < nrow; j++)
          a(i,j) *= (s(i)*s(j));
 
+#ifdef MINUIT2_USE_LAPACK
+   if (nrow >= kMinSizeForLapack) {
+      std::vector<double> scaled(a.Data(), a.Data() + a.size());
+      const int n = nrow;
+      int info = 0;
+      dpptrf_("U", &n, a.Data(), &info);
+      if (info == 0)
+         dpptri_("U", &n, a.Data(), &info);
+      if (info == 0) {
+         for(unsigned int j = 0; j < nrow; j++)
+            for(unsigned int k = j; k < nrow; k++)
+               a(j,k) *= (s(j)*s(k));
+         return 0;
+      }
+      std::copy(scaled.begin(), scaled.end(), a.Data());
+   }
+#endif
+
    for(unsigned i = 0; i < nrow; i++) {
       unsigned int k = i;
       if(a(k,k) == 0.) return 1;
@@ -24,6 +24,8 @@
 // to speed up the result
 // define the environment variable OMP_NUM_THREADS to the number of desired threads
 // By default it will have thenumber of core of the machine
+// In a ROOT build with implicit multi-threading, the gradient is instead computed on the
+// IMT pool when ROOT::EnableImplicitMT() has been called, since the FCN declares itself thread safe
 // The default number of dimension is 20 (fit in 40 parameters) on 1000 data events.
 // One can change the dimension and the number of events by doing:
 // ./test_Minuit2_Parallel    ndim  nevents
@@ -67,6 +69,8 @@ struct LogLikeFCN  : public FCNBase {
       return logl;
    }
    double Up() const { return 0.5; }
+   // operator() only reads fData, so it can be called concurrently
+   bool IsThreadSafe() const { return true; }
    const Data & fData;
 };
 
@@ -0,0 +1,66 @@
+#include "Math/Functor.h"
+#include "Minuit2/Minuit2Minimizer.h"
+
+#include "benchmark/benchmark.h"
+
+#include <string>
+
+// Generalized Rosenbrock function in n dimensions, with the minimum 0 at (1, ..., 1)
+static double Rosenbrock(const double *x, unsigned int n)
+{
+   double f = 0;
+   for (unsigned int i = 0; i + 1 < n; ++i) {
+      const double a = x[i + 1] - x[i] * x[i];
+      const double b = 1. - x[i];
+      f += 100. * a * a + b * b;
+   }
+   return f;
+}
+
+// Sum of (x_i - i)^2 / (i + 1), a quadratic function with different scales along each dimension
+static double Quadratic(const double *x, unsigned int n)
+{
+   double f = 0;
+   for (unsigned int i = 0; i < n; ++i)
+      f += (x[i] - i) * (x[i] - i) / (i + 1);
+   return f;
+}
+
+static void RunMinimization(benchmark::State &state, double (*func)(const double *, unsigned int),
+                            const char *algorithm)
+{
+   const unsigned int n = state.range(0);
+   ROOT::Math::Functor functor([&](const double *x) { return func(x, n); }, n);
+   unsigned int ncalls = 0;
+   for (auto _ : state) {
+      ROOT::Minuit2::Minuit2Minimizer minimizer(algorithm);
+      minimizer.SetPrintLevel(0);
+      minimizer.SetMaxFunctionCalls(1000000);
+      minimizer.SetTolerance(0.001);
+      minimizer.SetFunction(functor);
+      for (unsigned int i = 0; i < n; ++i)
+         minimizer.SetVariable(i, "x" + std::to_string(i), -1.2, 0.1);
+      minimizer.Minimize();
+      ncalls = minimizer.NCalls();
+      benchmark::DoNotOptimize(minimizer.MinValue());
+   }
+   state.counters["calls"] = ncalls;
+}
+
+static void BM_Minuit2_Migrad_Rosenbrock(benchmark::State &state)
+{
+   RunMinimization(state, Rosenbrock, "Migrad");
+}
+BENCHMARK(BM_Minuit2_Migrad_Rosenbrock)->Arg(2)->Arg(10)->Arg(50)->Unit(benchmark::kMillisecond);
+
+static void BM_Minuit2_Migrad_Quadratic(benchmark::State &state)
+{
+   RunMinimization(state, Quadratic, "Migrad");
+}
+BENCHMARK(BM_Minuit2_Migrad_Quadratic)->Arg(2)->Arg(10)->Arg(50)->Arg(200)->Unit(benchmark::kMillisecond);
+
+static void BM_Minuit2_Simplex_Rosenbrock(benchmark::State &state)
+{
+   RunMinimization(state, Rosenbrock, "Simplex");
+}
+BENCHMARK(BM_Minuit2_Simplex_Rosenbrock)->Arg(2)->Arg(10)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,432 @@
+// @(#)root/smatrix:$Id$
+
+#ifndef ROOT_Math_SMatrixBatch
+#define ROOT_Math_SMatrixBatch
+
+/**
+   @defgroup SMatrixBatchGroup Batches of matrices
+   @ingroup SMatrixGroup
+
+   Classes and functions for the operations on many small matrices of the same size, e.g. the 5x5 covariance
+   matrices of the Kalman filter of a track fit. The matrices are stored as a structure of arrays, as in the
+   Matriplex of mkFit, so that the operations are vectorized across the matrices instead of within one matrix.
+*/
+
+#include "Math/SMatrix.h"
+
+#include <cmath>
+#include <type_traits>
+
+namespace ROOT {
+
+namespace Math {
+
+/// offsets of the elements of the matrices of a SMatrixBatch in the storage of a single matrix
+namespace SMatrixBatchHelpers {
+
+template <class R>
+struct Offsets;
+
+template <class T, unsigned int D1, unsigned int D2>
+struct Offsets<MatRepStd<T, D1, D2>> {
+   static constexpr unsigned int Get(unsigned int i, unsigned int j) { return i * D2 + j; }
+};
+
+template <class T, unsigned int D>
+struct Offsets<MatRepSym<T, D>> {
+   static constexpr unsigned int Get(unsigned int i, unsigned int j) { return MatRepSym<T, D>::off2(i, j); }
+};
+
+} // namespace SMatrixBatchHelpers
+
+//__________________________________________________________________________
+/**
+    SMatrixBatch: a batch of N matrices D1 x D2, stored as a structure of arrays.
+
+    The class is templated as SMatrix on the scalar type, on the matrix sizes and on the representation of a
+    matrix, MatRepStd<T,D1,D2> for general matrices or MatRepSym<T,D> for symmetric matrices, and in addition
+    on the number N of matrices. The N values of an element (i,j) are contiguous in memory, so that the loops
+    of the operations on the batch (products, similarity transforms and inversions) are vectorized over the
+    matrices, like an operation on SMatrix<Double_v, D1, D2> with vectors of N doubles. N is typically a
+    multiple of the SIMD width, e.g. 8 or 16.
+
+    Usage example, for the propagation of the covariance matrices of a Kalman filter:
+    @code
+    // fill the batches from the matrices of 16 tracks
+    SMatrixBatch<double, 5, 5, 16> jacobians;
+    SMatrixBatch<double, 5, 5, 16, MatRepSym<double, 5>> covs, propagated;
+    for (unsigned int n = 0; n < 16; ++n) {
+       jacobians.SetMatrix(n, jacobian[n]);
+       covs.SetMatrix(n, cov[n]);
+    }
+    // J C J^T and its inverse for the 16 tracks at once
+    Similarity(jacobians, covs, propagated);
+    propagated.InvertFast();
+    @endcode
+
+    @ingroup SMatrixBatchGroup
+*/
+template <class T, unsigned int D1, unsigned int D2, unsigned int N, class R = MatRepStd<T, D1, D2>>
+class SMatrixBatch {
+public:
+   /** contained scalar type */
+   typedef T value_type;
+
+   /** storage representation type of a matrix */
+   typedef R rep_type;
+
+   /** type of a single matrix of the batch */
+   typedef SMatrix<T, D1, D2, R> matrix_type;
+
+   enum {
+      /// number of matrix rows
+      kRows = D1,
+      /// number of matrix columns
+      kCols = D2,
+      /// number of stored elements of a matrix
+      kSize = R::kSize,
+      /// number of matrices
+      kN = N
+   };
+
+   /// default constructor: the elements are not initialized
+   SMatrixBatch() {}
+
+   /// pointer to the N values of the element (i,j), one for each matrix
+   T *Elements(unsigned int i, unsigned int j) { return fArray + SMatrixBatchHelpers::Offsets<R>::Get(i, j) * N; }
+   const T *Elements(unsigned int i, unsigned int j) const
+   {
+      return fArray + SMatrixBatchHelpers::Offsets<R>::Get(i, j) * N;
+   }
+
+   /// element (i,j) of the matrix n
+   T &At(unsigned int n, unsigned int i, unsigned int j) { return Elements(i, j)[n]; }
+   const T &At(unsigned int n, unsigned int i, unsigned int j) const { return Elements(i, j)[n]; }
+
+   /// copy the matrix m into the matrix n of the batch
+   template <class R2>
+   void SetMatrix(unsigned int n, const SMatrix<T, D1, D2, R2> &m)
+   {
+      for (unsigned int i = 0; i < D1; ++i)
+         for (unsigned int j = 0; j < D2; ++j)
+            At(n, i, j) = m(i, j);
+   }
+
+   /// return the matrix n of the batch
+   matrix_type GetMatrix(unsigned int n) const
+   {
+      matrix_type m;
+      for (unsigned int i = 0; i < D1; ++i)
+         for (unsigned int j = 0; j < D2; ++j)
+            m(i, j) = At(n, i, j);
+      return m;
+   }
+
+   /// set all the elements of all the matrices to x
+   void SetAll(T x)
+   {
+      for (unsigned int k = 0; k < kSize * N; ++k)
+         fArray[k] = x;
+   }
+
+   SMatrixBatch &operator+=(const SMatrixBatch &rhs)
+   {
+      for (unsigned int k = 0; k < kSize * N; ++k)
+         fArray[k] += rhs.fArray[k];
+      return *this;
+   }
+
+   SMatrixBatch &operator-=(const SMatrixBatch &rhs)
+   {
+      for (unsigned int k = 0; k < kSize * N; ++k)
+         fArray[k] -= rhs.fArray[k];
+      return *this;
+   }
+
+   /**
+      Invert the square matrices with the algorithm of SMatrix::Invert, one matrix at a time.
+      Return false if the inversion of one of the matrices failed; the matrices which could not be inverted are
+      left unchanged and, if ifail is given, ifail[n] is set to 1 for them and to 0 for the others.
+   */
+   bool Invert(int *ifail = nullptr)
+   {
+      STATIC_CHECK(D1 == D2, SMatrixBatch_not_square);
+      bool ok = true;
+      for (unsigned int n = 0; n < N; ++n) {
+         matrix_type m = GetMatrix(n);
+         const bool okn = m.Invert();
+         if (okn)
+            SetMatrix(n, m);
+         if (ifail)
+            ifail[n] = okn ? 0 : 1;
+         ok = ok && okn;
+      }
+      return ok;
+   }
+
+   /**
+      Invert the square matrices, vectorized over the batch: with the Cramer rule for matrices up to 3x3 and
+      with the Cholesky decomposition for larger symmetric matrices, which must then be positive definite as
+      covariance matrices. Larger general matrices are inverted one at a time as in SMatrix::InvertFast.
+      The return value and ifail are as in Invert().
+   */
+   bool InvertFast(int *ifail = nullptr)
+   {
+      STATIC_CHECK(D1 == D2, SMatrixBatch_not_square);
+      if (D1 <= 3)
+         return InvertCramer(ifail);
+      if (std::is_same<R, MatRepSym<T, D1>>::value)
+         return InvertCholesky(ifail);
+      bool ok = true;
+      for (unsigned int n = 0; n < N; ++n) {
+         matrix_type m = GetMatrix(n);
+         const bool okn = m.InvertFast();
+         if (okn)
+            SetMatrix(n, m);
+         if (ifail)
+            ifail[n] = okn ? 0 : 1;
+         ok = ok && okn;
+      }
+      return ok;
+   }
+
+   /**
+      Invert the symmetric positive definite matrices with the Cholesky decomposition, vectorized over the
+      batch. The return value and ifail are as in Invert().
+   */
+   bool InvertChol(int *ifail = nullptr)
+   {
+      STATIC_CHECK((std::is_same<R, MatRepSym<T, D1>>::value), SMatrixBatch_not_symmetric);
+      return InvertCholesky(ifail);
+   }
+
+   /// pointer to the storage: the N values of each element of the representation R, in its order
+   T *Array() { return fArray; }
+   const T *Array() const { return fArray; }
+
+private:
+   /// keep the original matrices which could not be inverted, and fill ifail
+   bool Restore(const SMatrixBatch &orig, const bool *ok, int *ifail)
+   {
+      bool allOk = true;
+      for (unsigned int n = 0; n < N; ++n) {
+         if (!ok[n]) {
+            for (unsigned int k = 0; k < kSize; ++k)
+               fArray[k * N + n] = orig.fArray[k * N + n];
+            allOk = false;
+         }
+         if (ifail)
+            ifail[n] = ok[n] ? 0 : 1;
+      }
+      return allOk;
+   }
+
+   bool InvertCramer(int *ifail)
+   {
+      const SMatrixBatch a(*this);
+      bool ok[N];
+      if (D1 == 1) {
+         const T *a00 = a.Elements(0, 0);
+         T *r00 = Elements(0, 0);
+         for (unsigned int n = 0; n < N; ++n) {
+            ok[n] = a00[n] != T(0);
+            r00[n] = T(1) / (ok[n] ? a00[n] : T(1));
+         }
+      } else if (D1 == 2) {
+         const T *a00 = a.Elements(0, 0), *a01 = a.Elements(0, 1);
+         const T *a10 = a.Elements(1, 0), *a11 = a.Elements(1, 1);
+         T *r00 = Elements(0, 0), *r01 = Elements(0, 1), *r10 = Elements(1, 0), *r11 = Elements(1, 1);
+         for (unsigned int n = 0; n < N; ++n) {
+            const T det = a00[n] * a11[n] - a01[n] * a10[n];
+            ok[n] = det != T(0);
+            const T s = T(1) / (ok[n] ? det : T(1));
+            const T b00 = a11[n] * s, b01 = -a01[n] * s, b10 = -a10[n] * s, b11 = a00[n] * s;
+            // for symmetric matrices r01 and r10 are the same element, with the same value
+            r00[n] = b00;
+            r01[n] = b01;
+            r10[n] = b10;
+            r11[n] = b11;
+         }
+      } else if (D1 == 3) {
+         const T *a00 = a.Elements(0, 0), *a01 = a.Elements(0, 1), *a02 = a.Elements(0, 2);
+         const T *a10 = a.Elements(1, 0), *a11 = a.Elements(1, 1), *a12 = a.Elements(1, 2);
+         const T *a20 = a.Elements(2, 0), *a21 = a.Elements(2, 1), *a22 = a.Elements(2, 2);
+         T *r[3][3];
+         for (unsigned int i = 0; i < 3; ++i)
+            for (unsigned int j = 0; j < 3; ++j)
+               r[i][j] = Elements(i, j);
+         for (unsigned int n = 0; n < N; ++n) {
+            // cofactors
+            const T c00 = a11[n] * a22[n] - a12[n] * a21[n];
+            const T c01 = a12[n] * a20[n] - a10[n] * a22[n];
+            const T c02 = a10[n] * a21[n] - a11[n] * a20[n];
+            const T c10 = a02[n] * a21[n] - a01[n] * a22[n];
+            const T c11 = a00[n] * a22[n] - a02[n] * a20[n];
+            const T c12 = a01[n] * a20[n] - a00[n] * a21[n];
+            const T c20 = a01[n] * a12[n] - a02[n] * a11[n];
+            const T c21 = a02[n] * a10[n] - a00[n] * a12[n];
+            const T c22 = a00[n] * a11[n] - a01[n] * a10[n];
+            const T det = a00[n] * c00 + a01[n] * c01 + a02[n] * c02;
+            ok[n] = det != T(0);
+            const T s = T(1) / (ok[n] ? det : T(1));
+            r[0][0][n] = c00 * s;
+            r[0][1][n] = c10 * s;
+            r[0][2][n] = c20 * s;
+            r[1][0][n] = c01 * s;
+            r[1][1][n] = c11 * s;
+            r[1][2][n] = c21 * s;
+            r[2][0][n] = c02 * s;
+            r[2][1][n] = c12 * s;
+            r[2][2][n] = c22 * s;
+         }
+      }
+      return Restore(a, ok, ifail);
+   }
+
+   bool InvertCholesky(int *ifail)
+   {
+      const SMatrixBatch a(*this);
+      // lower triangular matrix L, with a = L L^T, and then its inverse, in packed storage; the diagonal holds
+      // the inverse of the diagonal elements
+      T l[D1 * (D1 + 1) / 2][N];
+      bool ok[N];
+      for (unsigned int n = 0; n < N; ++n)
+         ok[n] = true;
+      // the sums are accumulated in local arrays, which the compiler knows not to alias the inputs
+      T sum[N];
+      for (unsigned int j = 0; j < D1; ++j) {
+         const T *ajj = a.Elements(j, j);
+         for (unsigned int n = 0; n < N; ++n)
+            sum[n] = ajj[n];
+         for (unsigned int k = 0; k < j; ++k) {
+            const T *ljk = l[j * (j + 1) / 2 + k];
+            for (unsigned int n = 0; n < N; ++n)
+               sum[n] -= ljk[n] * ljk[n];
+         }
+         T *ljj = l[j * (j + 1) / 2 + j];
+         for (unsigned int n = 0; n < N; ++n)
+            ok[n] = ok[n] && sum[n] > T(0);
+         // the square root of a positive argument also for the matrices which are not positive definite, and
+         // which are restored at the end, so that the loop is vectorized also with math errno
+         for (unsigned int n = 0; n < N; ++n)
+            ljj[n] = T(1) / std::sqrt(sum[n] > T(0) ? sum[n] : T(1));
+         for (unsigned int i = j + 1; i < D1; ++i) {
+            const T *aij = a.Elements(i, j);
+            for (unsigned int n = 0; n < N; ++n)
+               sum[n] = aij[n];
+            for (unsigned int k = 0; k < j; ++k) {
+               const T *lik = l[i * (i + 1) / 2 + k];
+               const T *ljk = l[j * (j + 1) / 2 + k];
+               for (unsigned int n = 0; n < N; ++n)
+                  sum[n] -= lik[n] * ljk[n];
+            }
+            T *lij = l[i * (i + 1) / 2 + j];
+            for (unsigned int n = 0; n < N; ++n)
+               lij[n] = sum[n] * ljj[n];
+         }
+      }
+      // inverse of L, in place, row by row
+      for (unsigned int i = 1; i < D1; ++i) {
+         const T *lii = l[i * (i + 1) / 2 + i];
+         for (unsigned int j = 0; j < i; ++j) {
+            for (unsigned int n = 0; n < N; ++n)
+               sum[n] = T(0);
+            for (unsigned int k = j; k < i; ++k) {
+               const T *lik = l[i * (i + 1) / 2 + k];
+               const T *mkj = l[k * (k + 1) / 2 + j];
+               for (unsigned int n = 0; n < N; ++n)
+                  sum[n] += lik[n] * mkj[n];
+            }
+            T *lij = l[i * (i + 1) / 2 + j];
+            for (unsigned int n = 0; n < N; ++n)
+               lij[n] = -lii[n] * sum[n];
+         }
+      }
+      // a^-1 = (L^-1)^T L^-1
+      for (unsigned int i = 0; i < D1; ++i) {
+         for (unsigned int j = 0; j <= i; ++j) {
+            for (unsigned int n = 0; n < N; ++n)
+               sum[n] = T(0);
+            for (unsigned int k = i; k < D1; ++k) {
+               const T *mki = l[k * (k + 1) / 2 + i];
+               const T *mkj = l[k * (k + 1) / 2 + j];
+               for (unsigned int n = 0; n < N; ++n)
+                  sum[n] += mki[n] * mkj[n];
+            }
+            T *rij = Elements(i, j);
+            T *rji = Elements(j, i);
+            for (unsigned int n = 0; n < N; ++n)
+               rij[n] = rji[n] = sum[n];
+         }
+      }
+      return Restore(a, ok, ifail);
+   }
+
+   T fArray[kSize * N];
+};
+
+/**
+   Product of the matrices of two batches, c = a * b for each matrix of the batches.
+   c must not be a or b.
+
+   @ingroup SMatrixBatchGroup
+*/
+template <class T, unsigned int D1, unsigned int D, unsigned int D2, unsigned int N, class R1, class R2>
+void Multiply(const SMatrixBatch<T, D1, D, N, R1> &a, const SMatrixBatch<T, D, D2, N, R2> &b,
+              SMatrixBatch<T, D1, D2, N> &c)
+{
+   for (unsigned int i = 0; i < D1; ++i) {
+      for (unsigned int j = 0; j < D2; ++j) {
+         // accumulate in a local array, which the compiler knows not to alias a and b
+         T sum[N];
+         for (unsigned int n = 0; n < N; ++n)
+            sum[n] = T(0);
+         for (unsigned int k = 0; k < D; ++k) {
+            const T *aik = a.Elements(i, k);
+            const T *bkj = b.Elements(k, j);
+            for (unsigned int n = 0; n < N; ++n)
+               sum[n] += aik[n] * bkj[n];
+         }
+         T *cij = c.Elements(i, j);
+         for (unsigned int n = 0; n < N; ++n)
+            cij[n] = sum[n];
+      }
+   }
+}
+
+/**
+   Similarity transform of the symmetric matrices of a batch, b = u * a * u^T for each matrix of the batches,
+   as ROOT::Math::Similarity(u, a) for SMatrix.
+
+   @ingroup SMatrixBatchGroup
+*/
+template <class T, unsigned int D1, unsigned int D2, unsigned int N, class R>
+void Similarity(const SMatrixBatch<T, D1, D2, N, R> &u, const SMatrixBatch<T, D2, D2, N, MatRepSym<T, D2>> &a,
+                SMatrixBatch<T, D1, D1, N, MatRepSym<T, D1>> &b)
+{
+   SMatrixBatch<T, D1, D2, N> ua;
+   Multiply(u, a, ua);
+   // only the lower triangle of the symmetric result is computed
+   for (unsigned int i = 0; i < D1; ++i) {
+      for (unsigned int j = 0; j <= i; ++j) {
+         T sum[N];
+         for (unsigned int n = 0; n < N; ++n)
+            sum[n] = T(0);
+         for (unsigned int k = 0; k < D2; ++k) {
+            const T *uaik = ua.Elements(i, k);
+            const T *ujk = u.Elements(j, k);
+            for (unsigned int n = 0; n < N; ++n)
+               sum[n] += uaik[n] * ujk[n];
+         }
+         T *bij = b.Elements(i, j);
+         for (unsigned int n = 0; n < N; ++n)
+            bij[n] = sum[n];
+      }
+   }
+}
+
+} // namespace Math
+
+} // namespace ROOT
+
+#endif // ROOT_Math_SMatrixBatch
@@ -1,6 +1,7 @@
 #include <cmath>
 #include "Math/SVector.h"
 #include "Math/SMatrix.h"
+#include "Math/SMatrixBatch.h"
 
 #include <iomanip>
 #include <iostream>
@@ -1431,6 +1432,121 @@ int test25()
    return iret;
 }
 
+int test26()
+{
+   // products and similarity transforms of batches of matrices
+   const unsigned int N = 8;
+   SMatrix<double, 5, 5> u[N];
+   SMatrix<double, 5, 3> w[N];
+   SMatrix<double, 5, 5, MatRepSym<double, 5>> a[N];
+   SMatrixBatch<double, 5, 5, N> ub;
+   SMatrixBatch<double, 5, 3, N> wb;
+   SMatrixBatch<double, 5, 5, N, MatRepSym<double, 5>> ab, sb;
+   SMatrixBatch<double, 5, 3, N> pb;
+   for (unsigned int n = 0; n < N; ++n) {
+      for (unsigned int i = 0; i < 5; ++i) {
+         for (unsigned int j = 0; j < 5; ++j) {
+            u[n](i, j) = std::sin(1. + n + 5 * i + j);
+            if (j <= i)
+               a[n](i, j) = std::cos(2. * n + i * j) + (i == j ? 5. : 0.);
+            if (j < 3)
+               w[n](i, j) = std::cos(0.5 * n + i - j);
+         }
+      }
+      ub.SetMatrix(n, u[n]);
+      wb.SetMatrix(n, w[n]);
+      ab.SetMatrix(n, a[n]);
+   }
+   Multiply(ub, wb, pb);
+   Similarity(ub, ab, sb);
+
+   int iret = 0;
+   for (unsigned int n = 0; n < N; ++n) {
+      iret |= compare(ub.GetMatrix(n) == u[n], true, "SetMatrix/GetMatrix");
+      const SMatrix<double, 5, 3> p = u[n] * w[n];
+      const SMatrix<double, 5, 5, MatRepSym<double, 5>> s = Similarity(u[n], a[n]);
+      for (unsigned int i = 0; i < 5; ++i) {
+         for (unsigned int j = 0; j < 5; ++j) {
+            if (j < 3)
+               iret |= compare(pb.At(n, i, j), p(i, j), "batch product", 100);
+            iret |= compare(sb.At(n, i, j), s(i, j), "batch similarity", 1000);
+         }
+      }
+   }
+   return iret;
+}
+
+int test27()
+{
+   // inversion of batches of matrices
+   const unsigned int N = 8;
+   SMatrixBatch<double, 5, 5, N, MatRepSym<double, 5>> symb;
+   SMatrixBatch<double, 5, 5, N> genb;
+   SMatrixBatch<double, 3, 3, N> gen3b;
+   SMatrixBatch<double, 2, 2, N, MatRepSym<double, 2>> sym2b;
+   SMatrix<double, 5, 5, MatRepSym<double, 5>> sym[N];
+   SMatrix<double, 5, 5> gen[N];
+   SMatrix<double, 3, 3> gen3[N];
+   SMatrix<double, 2, 2, MatRepSym<double, 2>> sym2[N];
+   for (unsigned int n = 0; n < N; ++n) {
+      for (unsigned int i = 0; i < 5; ++i) {
+         for (unsigned int j = 0; j < 5; ++j) {
+            gen[n](i, j) = std::sin(1. + n + 5 * i + j) + (i == j ? 3. : 0.);
+            if (j <= i)
+               sym[n](i, j) = std::cos(2. * n + i * j) + (i == j ? 5. : 0.);
+            if (i < 3 && j < 3)
+               gen3[n](i, j) = gen[n](i, j);
+            if (i < 2 && j <= i)
+               sym2[n](i, j) = sym[n](i, j);
+         }
+      }
+   }
+   // a singular matrix, which must be left unchanged
+   const double singular[9] = {1, 2, 3, 4, 5, 6, 2, 4, 6};
+   gen3[3] = SMatrix<double, 3, 3>(singular, singular + 9);
+   for (unsigned int n = 0; n < N; ++n) {
+      symb.SetMatrix(n, sym[n]);
+      genb.SetMatrix(n, gen[n]);
+      gen3b.SetMatrix(n, gen3[n]);
+      sym2b.SetMatrix(n, sym2[n]);
+   }
+
+   int iret = 0;
+   int ifail[N];
+   iret |= compare(symb.InvertFast(), true, "InvertFast symmetric");
+   iret |= compare(genb.Invert(), true, "Invert general");
+   iret |= compare(sym2b.InvertFast(), true, "InvertFast symmetric 2x2");
+   iret |= compare(gen3b.InvertFast(ifail), false, "InvertFast singular");
+   for (unsigned int n = 0; n < N; ++n)
+      iret |= compare(ifail[n], n == 3 ? 1 : 0, "ifail");
+
+   // a matrix which is not positive definite is left unchanged by the Cholesky inversion
+   SMatrixBatch<double, 5, 5, N, MatRepSym<double, 5>> notPosDefb = symb;
+   notPosDefb.At(5, 2, 2) = -1;
+   const SMatrix<double, 5, 5, MatRepSym<double, 5>> notPosDef = notPosDefb.GetMatrix(5);
+   iret |= compare(notPosDefb.InvertChol(ifail), false, "InvertChol not positive definite");
+   iret |= compare(ifail[5], 1, "ifail InvertChol");
+   iret |= compare(notPosDefb.GetMatrix(5) == notPosDef, true, "InvertChol not positive definite unchanged");
+
+   for (unsigned int n = 0; n < N; ++n) {
+      const SMatrix<double, 5, 5, MatRepSym<double, 5>> symInv = sym[n].Inverse(ifail[n]);
+      const SMatrix<double, 5, 5> genInv = gen[n].Inverse(ifail[n]);
+      const SMatrix<double, 3, 3> gen3Inv = (n == 3) ? gen3[n] : gen3[n].Inverse(ifail[n]);
+      const SMatrix<double, 2, 2, MatRepSym<double, 2>> sym2Inv = sym2[n].Inverse(ifail[n]);
+      for (unsigned int i = 0; i < 5; ++i) {
+         for (unsigned int j = 0; j < 5; ++j) {
+            iret |= compare(symb.At(n, i, j), symInv(i, j), "batch InvertFast symmetric", 10000);
+            iret |= compare(genb.At(n, i, j), genInv(i, j), "batch Invert general", 10000);
+            if (i < 3 && j < 3)
+               iret |= compare(gen3b.At(n, i, j), gen3Inv(i, j), "batch InvertFast general", 10000);
+            if (i < 2 && j < 2)
+               iret |= compare(sym2b.At(n, i, j), sym2Inv(i, j), "batch InvertFast symmetric 2x2", 10000);
+         }
+      }
+   }
+   return iret;
+}
+
 #define TEST(N)                                                   \
    itest = N;                                                     \
    if (test##N() == 0)                                            \
@@ -1470,6 +1586,8 @@ int testSMatrix()
    TEST(23);
    TEST(24);
    TEST(25);
+   TEST(26);
+   TEST(27);
 
    return iret;
 }
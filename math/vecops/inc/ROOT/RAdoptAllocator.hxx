@@ -45,6 +45,11 @@ Upon a second allocation, the vector *v* ceases to be a proxy
 v.emplace_back(0.);
 ~~~
 now the vector *v* owns its memory as a regular vector.
+
+The RAdoptAllocator can also be given a buffer, typically the inline storage of the object that owns the container,
+which it returns for the allocations that fit in it while the buffer is not in use. Copies of the allocator know the
+buffer, so that they do not deallocate it, but only the allocator the buffer was given to and its copy-constructed
+copies allocate from it: the allocators that the containers move or swap around never do.
 **/
 
 template <typename T>
@@ -73,17 +78,46 @@ private:
    pointer fInitialAddress = nullptr;
    EAllocType fAllocType = EAllocType::kOwning;
    StdAlloc_t fStdAllocator;
+   pointer fBuffer = nullptr;  ///< Storage for the allocations of up to fBufferSize elements, not owned
+   size_type fBufferSize = 0;
+   bool fCanUseBuffer = false; ///< False for the allocators moved or assigned from the one that was given the buffer
+   bool fBufferInUse = false;  ///< Whether the buffer holds the elements of the container
 
 public:
    /// This is the constructor which allows the allocator to adopt a certain memory region.
    RAdoptAllocator(pointer p) : fInitialAddress(p), fAllocType(EAllocType::kAdoptingNoAllocYet){};
+   /// This constructor gives the allocator a buffer for the allocations of up to bufferSize elements.
+   /// The buffer must outlive the container that uses the allocator.
+   RAdoptAllocator(pointer buffer, size_type bufferSize)
+      : fBuffer(buffer), fBufferSize(bufferSize), fCanUseBuffer(true){};
    RAdoptAllocator() = default;
    RAdoptAllocator(const RAdoptAllocator &) = default;
-   RAdoptAllocator(RAdoptAllocator &&) = default;
-   RAdoptAllocator &operator=(const RAdoptAllocator &) = default;
-   RAdoptAllocator &operator=(RAdoptAllocator &&) = default;
+   RAdoptAllocator(RAdoptAllocator &&other) : RAdoptAllocator(other) { fCanUseBuffer = false; }
+   RAdoptAllocator &operator=(const RAdoptAllocator &other)
+   {
+      fInitialAddress = other.fInitialAddress;
+      fAllocType = other.fAllocType;
+      fStdAllocator = other.fStdAllocator;
+      fBuffer = other.fBuffer;
+      fBufferSize = other.fBufferSize;
+      fCanUseBuffer = false;
+      fBufferInUse = other.fBufferInUse;
+      return *this;
+   }
+   RAdoptAllocator &operator=(RAdoptAllocator &&other) { return *this = other; }
    RAdoptAllocator(const RAdoptAllocator<bool> &);
 
+   /// The copies of a container do not share the buffer of the original.
+   RAdoptAllocator select_on_container_copy_construction() const
+   {
+      RAdoptAllocator copy(*this);
+      copy.fBuffer = nullptr;
+      copy.fBufferSize = 0;
+      copy.fCanUseBuffer = false;
+      copy.fBufferInUse = false;
+      return copy;
+   }
+
    /// Construct an object at a certain memory address
    /// \tparam U The type of the memory address at which the object needs to be constructed
    /// \tparam Args The arguments' types necessary for the construction of the object
@@ -101,7 +135,8 @@ public:
 
    /// \brief Allocate some memory
    /// If an address has been adopted, at the first call, that address is returned.
-   /// Subsequent calls will make "decay" the allocator to a regular stl allocator.
+   /// Subsequent calls will make "decay" the allocator to a regular stl allocator, which returns the buffer, if any,
+   /// when the n elements fit in it and it is not in use.
    pointer allocate(std::size_t n)
    {
       if (n > std::size_t(-1) / sizeof(T))
@@ -111,12 +146,20 @@ public:
          return fInitialAddress;
       }
       fAllocType = EAllocType::kOwning;
+      if (fCanUseBuffer && !fBufferInUse && n <= fBufferSize) {
+         fBufferInUse = true;
+         return fBuffer;
+      }
       return StdAllocTraits_t::allocate(fStdAllocator, n);
    }
 
-   /// \brief Dellocate some memory if that had not been adopted.
+   /// \brief Dellocate some memory if that had not been adopted and is not the buffer.
    void deallocate(pointer p, std::size_t n)
    {
+      if (fBufferInUse && p == fBuffer) {
+         fBufferInUse = false;
+         return;
+      }
       if (p != fInitialAddress)
          StdAllocTraits_t::deallocate(fStdAllocator, p, n);
    }
@@ -132,12 +175,15 @@ public:
    bool operator==(const RAdoptAllocator<T> &other)
    {
       return fInitialAddress == other.fInitialAddress && fAllocType == other.fAllocType &&
-             fStdAllocator == other.fStdAllocator;
+             fStdAllocator == other.fStdAllocator && fBuffer == other.fBuffer;
    }
 
    bool operator!=(const RAdoptAllocator<T> &other) { return !(*this == other); }
 
    size_type max_size() const { return fStdAllocator.max_size(); };
+
+   /// Whether the memory of the container is adopted, i.e. not owned by the allocator
+   bool IsAdopting() const { return EAllocType::kOwning != fAllocType; }
 };
 
 // The different semantics of std::vector<bool> make  memory adoption through a
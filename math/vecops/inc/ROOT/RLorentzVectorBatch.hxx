@@ -0,0 +1,178 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RLORENTZVECTORBATCH
+#define ROOT_RLORENTZVECTORBATCH
+
+#include <ROOT/RVec.hxx>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace ROOT {
+namespace Internal {
+namespace VecOps {
+
+/// \name SIMD kernels of RLorentzVectorBatch
+/// Defined in libROOTVecOps together with the SIMD kernels of RVec. The output arrays can be input arrays.
+///@{
+#define RVEC_DECLARE_LORENTZ_KERNELS(T)                                                                            \
+   /* (pt, eta, phi, m) to (px, py, pz, e) */                                                                      \
+   void PxPyPzE(const T *pt, const T *eta, const T *phi, const T *m, T *px, T *py, T *pz, T *e, std::size_t n);   \
+   /* sum of the vectors 1 and 2, in (pt, eta, phi, m) */                                                         \
+   void AddPtEtaPhiM(const T *pt1, const T *eta1, const T *phi1, const T *m1, const T *pt2, const T *eta2,        \
+                     const T *phi2, const T *m2, T *pt, T *eta, T *phi, T *m, std::size_t n);                     \
+   /* boost of the vectors by (bx, by, bz): the mass does not change */                                            \
+   void BoostPtEtaPhiM(const T *pt, const T *eta, const T *phi, const T *m, const T *bx, const T *by, const T *bz, \
+                       T *ptOut, T *etaOut, T *phiOut, std::size_t n);                                            \
+   void DeltaR(const T *eta1, const T *phi1, const T *eta2, const T *phi2, T *out, std::size_t n);
+
+RVEC_DECLARE_LORENTZ_KERNELS(float)
+RVEC_DECLARE_LORENTZ_KERNELS(double)
+#undef RVEC_DECLARE_LORENTZ_KERNELS
+///@}
+
+} // namespace VecOps
+} // namespace Internal
+
+namespace VecOps {
+
+/**
+\class ROOT::VecOps::RLorentzVectorBatch
+\ingroup vecops
+\brief A batch of Lorentz vectors in (pt, eta, phi, m) coordinates, stored as a structure of arrays
+\tparam T The type of the coordinates, float or double
+
+Each coordinate is stored in its own RVec, so that the coordinates can be taken from and given to the columns of a
+dataset (e.g. the `Muon_pt`, `Muon_eta`, ... columns of a RDataFrame) without copies. The operations on the
+batch (conversion to cartesian coordinates, sum, boost and \f$\Delta R\f$) are computed on all vectors at once by
+the SIMD kernels of libROOTVecOps, instead of one ROOT::Math::PtEtaPhiMVector at a time. They follow the
+conventions of GenVector: \f$\phi\f$ is in \f$(-\pi, \pi]\f$ and a negative squared mass gives a negative mass.
+A vector with a null transverse momentum has an infinite \f$\eta\f$.
+
+~~~{.cpp}
+using namespace ROOT::VecOps;
+RLorentzVectorBatch<float> mu1(Muon1_pt, Muon1_eta, Muon1_phi, Muon1_mass);
+RLorentzVectorBatch<float> mu2(Muon2_pt, Muon2_eta, Muon2_phi, Muon2_mass);
+auto dimuon = mu1 + mu2;
+RVec<float> masses = dimuon.M();
+RVec<float> dr = DeltaR(mu1, mu2);
+// conversion from and to RVec<ROOT::Math::PtEtaPhiMVector>
+auto vectors = dimuon.ToVectors<ROOT::Math::PtEtaPhiMVector>();
+auto batch = RLorentzVectorBatch<double>::FromVectors(vectors);
+~~~
+*/
+template <typename T>
+class RLorentzVectorBatch {
+   static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value,
+                 "RLorentzVectorBatch supports only float and double coordinates");
+
+   RVec<T> fPt;
+   RVec<T> fEta;
+   RVec<T> fPhi;
+   RVec<T> fM;
+
+public:
+   RLorentzVectorBatch() = default;
+
+   /// Build the batch from the RVecs of its coordinates, which must have the same size. The RVecs are moved into the
+   /// batch, they can adopt the memory of the columns of a dataset.
+   RLorentzVectorBatch(RVec<T> pt, RVec<T> eta, RVec<T> phi, RVec<T> m)
+      : fPt(std::move(pt)), fEta(std::move(eta)), fPhi(std::move(phi)), fM(std::move(m))
+   {
+      ROOT::Detail::VecOps::GetVectorsSize("RLorentzVectorBatch", fPt, fEta, fPhi, fM);
+   }
+
+   /// Build the batch from a RVec of Lorentz vectors, e.g. ROOT::Math::PtEtaPhiMVector, with methods Pt(), Eta(),
+   /// Phi() and M().
+   template <typename V>
+   static RLorentzVectorBatch FromVectors(const RVec<V> &vectors)
+   {
+      const auto size = vectors.size();
+      RVec<T> pt(size), eta(size), phi(size), m(size);
+      for (std::size_t i = 0; i < size; ++i) {
+         pt[i] = vectors[i].Pt();
+         eta[i] = vectors[i].Eta();
+         phi[i] = vectors[i].Phi();
+         m[i] = vectors[i].M();
+      }
+      return RLorentzVectorBatch(std::move(pt), std::move(eta), std::move(phi), std::move(m));
+   }
+
+   /// Return the RVec of the Lorentz vectors of the batch, e.g. RVec<ROOT::Math::PtEtaPhiMVector>, built from
+   /// (pt, eta, phi, m).
+   template <typename V>
+   RVec<V> ToVectors() const
+   {
+      return Construct<V>(fPt, fEta, fPhi, fM);
+   }
+
+   std::size_t size() const { return fPt.size(); }
+
+   const RVec<T> &Pt() const { return fPt; }
+   const RVec<T> &Eta() const { return fEta; }
+   const RVec<T> &Phi() const { return fPhi; }
+   const RVec<T> &M() const { return fM; }
+
+   /// Compute the cartesian coordinates of the vectors.
+   void GetPxPyPzE(RVec<T> &px, RVec<T> &py, RVec<T> &pz, RVec<T> &e) const
+   {
+      const auto n = size();
+      px.resize(n);
+      py.resize(n);
+      pz.resize(n);
+      e.resize(n);
+      ROOT::Internal::VecOps::PxPyPzE(fPt.data(), fEta.data(), fPhi.data(), fM.data(), px.data(), py.data(),
+                                      pz.data(), e.data(), n);
+   }
+
+   /// Return the vectors boosted by the velocities (bx, by, bz), in units of c, as ROOT::Math::LorentzVector::Boost.
+   RLorentzVectorBatch Boost(const RVec<T> &bx, const RVec<T> &by, const RVec<T> &bz) const
+   {
+      const auto n = ROOT::Detail::VecOps::GetVectorsSize("Boost", fPt, bx, by, bz);
+      RVec<T> pt(n), eta(n), phi(n);
+      ROOT::Internal::VecOps::BoostPtEtaPhiM(fPt.data(), fEta.data(), fPhi.data(), fM.data(), bx.data(), by.data(),
+                                             bz.data(), pt.data(), eta.data(), phi.data(), n);
+      return RLorentzVectorBatch(std::move(pt), std::move(eta), std::move(phi), fM);
+   }
+
+   /// Return the vectors boosted by the same velocity (bx, by, bz), in units of c.
+   RLorentzVectorBatch Boost(T bx, T by, T bz) const
+   {
+      const auto n = size();
+      return Boost(RVec<T>(n, bx), RVec<T>(n, by), RVec<T>(n, bz));
+   }
+};
+
+/// Return the element-wise sums of the vectors of the batches a and b.
+template <typename T>
+RLorentzVectorBatch<T> operator+(const RLorentzVectorBatch<T> &a, const RLorentzVectorBatch<T> &b)
+{
+   const auto n = ROOT::Detail::VecOps::GetVectorsSize("operator+", a.Pt(), b.Pt());
+   RVec<T> pt(n), eta(n), phi(n), m(n);
+   ROOT::Internal::VecOps::AddPtEtaPhiM(a.Pt().data(), a.Eta().data(), a.Phi().data(), a.M().data(), b.Pt().data(),
+                                        b.Eta().data(), b.Phi().data(), b.M().data(), pt.data(), eta.data(),
+                                        phi.data(), m.data(), n);
+   return RLorentzVectorBatch<T>(std::move(pt), std::move(eta), std::move(phi), std::move(m));
+}
+
+/// Return the element-wise distances on the \f$\eta\f$-\f$\phi\f$ plane of the vectors of the batches a and b.
+template <typename T>
+RVec<T> DeltaR(const RLorentzVectorBatch<T> &a, const RLorentzVectorBatch<T> &b)
+{
+   const auto n = ROOT::Detail::VecOps::GetVectorsSize("DeltaR", a.Pt(), b.Pt());
+   RVec<T> dr(n);
+   ROOT::Internal::VecOps::DeltaR(a.Eta().data(), a.Phi().data(), b.Eta().data(), b.Phi().data(), dr.data(), n);
+   return dr;
+}
+
+} // namespace VecOps
+} // namespace ROOT
+
+#endif
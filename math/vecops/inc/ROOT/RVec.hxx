@@ -29,6 +29,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <new> // placement new
 #include <numeric> // for inner_product
 #include <sstream>
 #include <stdexcept>
@@ -119,6 +120,48 @@ void EmplaceBack(std::vector<bool> &v, Args &&... args)
    v.push_back(std::forward<Args>(args)...);
 }
 
+/// Whether the memory of v is adopted. The operators compute their result in the memory of the temporary RVecs
+/// they are given, unless it is adopted.
+template <typename T>
+bool IsAdopting(const ROOT::VecOps::RVec<T> &v)
+{
+   return v.AsVector().get_allocator().IsAdopting();
+}
+
+inline bool IsAdopting(const ROOT::VecOps::RVec<bool> &)
+{
+   return false;
+}
+
+/// The number of elements that a RVec<T> stores inline, i.e. without allocating memory on the heap: as many as fit in
+/// 64 bytes. RVec<bool>, stored in a std::vector<bool>, has no inline storage.
+template <typename T>
+struct RVecInlineSize {
+   static constexpr std::size_t value = std::is_same<T, bool>::value || sizeof(T) > 64 ? 0 : 64 / sizeof(T);
+};
+
+/// \name SIMD kernels
+/// Loops over contiguous arrays of floats and doubles, defined in libROOTVecOps. They use explicit SIMD instructions
+/// when ROOT is built with VecCore and Vc, and are otherwise compiled for several instruction sets, one of which is
+/// selected at runtime, where the compiler supports it. The output array can be one of the input arrays.
+///@{
+#define RVEC_DECLARE_SIMD_KERNELS(T)                                                                               \
+   void Exp(const T *in, T *out, std::size_t n);                                                                  \
+   void Log(const T *in, T *out, std::size_t n);                                                                  \
+   void Sqrt(const T *in, T *out, std::size_t n);                                                                 \
+   void Atan2(const T *y, const T *x, T *out, std::size_t n);                                                     \
+   T Sum(const T *in, std::size_t n);                                                                             \
+   T Dot(const T *in0, const T *in1, std::size_t n);                                                              \
+   /* n must be positive */                                                                                       \
+   T Max(const T *in, std::size_t n);                                                                             \
+   void InvariantMasses(const T *pt1, const T *eta1, const T *phi1, const T *mass1, const T *pt2, const T *eta2,  \
+                        const T *phi2, const T *mass2, T *out, std::size_t n);
+
+RVEC_DECLARE_SIMD_KERNELS(float)
+RVEC_DECLARE_SIMD_KERNELS(double)
+#undef RVEC_DECLARE_SIMD_KERNELS
+///@}
+
 } // End of VecOps NS
 } // End of Internal NS
 
@@ -178,6 +221,15 @@ auto goodMuons_pt = mu_pt[ (mu_pt > 10.f && abs(mu_eta) <= 2.f && mu_charge == -
 Now the clean collection of transverse momenta can be used within the rest of the data analysis, for
 example to fill a histogram.
 
+The operators and the mathematical functions compute their result in the memory of the temporary RVecs they
+receive, when the result has the type of their elements. In `sqrt(px * px + py * py)`, for example, the two
+products allocate new RVecs, while the sum and the square root overwrite the elements of the first product.
+Memory adopted by a RVec is never overwritten.
+
+`exp`, `log`, `sqrt`, `atan2`, Sum, Dot, Max and InvariantMasses of RVecs of floats and doubles (and DeltaR, which
+uses `sqrt`) are computed by SIMD kernels compiled in libROOTVecOps. ROOT::VecOps::EnableFastMath() makes `exp`,
+`log` and `atan2` use the faster, less accurate approximations of vdt.
+
 ## <a name="owningandadoptingmemory"></a>Owning and adopting memory
 RVec has contiguous memory associated to it. It can own it or simply adopt it. In the latter case,
 it can be constructed with the address of the memory associated to it and its length. For example:
@@ -190,6 +242,12 @@ If any method which implies a re-allocation is called, e.g. *emplace_back* or *r
 memory is released and new one is allocated. The previous content is copied in the new memory and
 preserved.
 
+An owning RVec stores its first elements inline, in the RVec object itself, and only allocates memory
+on the heap when they do not fit anymore: as many elements as fit in 64 bytes, e.g. 16 floats or 8
+doubles. Short RVecs, such as the collections of jets of an event or the temporary results of `v[v > 0]`,
+therefore do not allocate memory. RVec<bool> has no inline storage.
+Moving a RVec whose elements are stored inline moves the elements one by one.
+
 ## <a name="#sorting"></a>Sorting and manipulation of indices
 
 ### Sorting
@@ -296,28 +354,93 @@ public:
    using const_reverse_iterator = typename Impl_t::const_reverse_iterator;
 
 private:
+   static constexpr std::size_t InlineSize = ::ROOT::Internal::VecOps::RVecInlineSize<T>::value;
+   using HasInlineStorage_t = std::integral_constant<bool, (InlineSize > 0)>;
+
    Impl_t fData;
+   /// The storage of the elements while they fit in it, see RAdoptAllocator
+   alignas(T) char fInlineBuffer[InlineSize > 0 ? InlineSize * sizeof(T) : 1]; //!
+
+   // the overloads are templates so that they are not instantiated with RVec<bool>, which has no inline storage
+   template <typename U = T>
+   typename Impl_t::allocator_type MakeAllocator(std::true_type)
+   {
+      return {reinterpret_cast<U *>(fInlineBuffer), InlineSize};
+   }
+   template <typename U = T>
+   typename Impl_t::allocator_type MakeAllocator(std::false_type)
+   {
+      return {};
+   }
+   /// The allocator of the owning containers, which allocates from the inline buffer first
+   typename Impl_t::allocator_type MakeAllocator() { return MakeAllocator(HasInlineStorage_t()); }
+
+   template <typename U = T>
+   bool IsInline(std::true_type) const
+   {
+      return static_cast<const void *>(fData.data()) == fInlineBuffer;
+   }
+   template <typename U = T>
+   bool IsInline(std::false_type) const
+   {
+      return false;
+   }
+   /// Whether the elements are stored in the inline buffer
+   bool IsInline() const { return IsInline(HasInlineStorage_t()); }
+
+   /// Replace the container with an empty one that stores its elements inline
+   void ResetStorage()
+   {
+      fData.~Impl_t();
+      new (&fData) Impl_t(MakeAllocator());
+      fData.reserve(InlineSize);
+   }
+
+   /// Take the elements of v, moving them one by one if they are stored inline, or its memory otherwise. Memory
+   /// is never exchanged between a container and another RVec, as the allocator of a container would use the inline
+   /// buffer of the other RVec.
+   void MoveFrom(RVec<T> &v)
+   {
+      if (v.IsInline()) {
+         if (IsInline())
+            fData.clear();
+         else
+            ResetStorage();
+         for (auto &&x : v.fData)
+            ::ROOT::Internal::VecOps::EmplaceBack(fData, std::move(x));
+         v.fData.clear();
+      } else {
+         fData.~Impl_t();
+         new (&fData) Impl_t(std::move(v.fData));
+         v.ResetStorage();
+      }
+   }
 
 public:
    // constructors
-   RVec() {}
+   RVec() : fData(MakeAllocator()) { fData.reserve(InlineSize); }
 
-   explicit RVec(size_type count) : fData(count) {}
+   explicit RVec(size_type count) : RVec() { fData.resize(count); }
 
-   RVec(size_type count, const T &value) : fData(count, value) {}
+   RVec(size_type count, const T &value) : RVec() { fData.assign(count, value); }
 
-   RVec(const RVec<T> &v) : fData(v.fData) {}
+   RVec(const RVec<T> &v) : RVec() { fData.assign(v.fData.begin(), v.fData.end()); }
 
-   RVec(RVec<T> &&v) : fData(std::move(v.fData)) {}
+   RVec(RVec<T> &&v) : RVec() { MoveFrom(v); }
 
-   RVec(const std::vector<T> &v) : fData(v.cbegin(), v.cend()) {}
+   RVec(const std::vector<T> &v) : RVec() { fData.assign(v.cbegin(), v.cend()); }
 
    RVec(pointer p, size_type n) : fData(n, T(), ROOT::Detail::VecOps::RAdoptAllocator<T>(p)) {}
 
    template <class InputIt>
-   RVec(InputIt first, InputIt last) : fData(first, last) {}
+   RVec(InputIt first, InputIt last) : RVec()
+   {
+      fData.assign(first, last);
+   }
+
+   RVec(std::initializer_list<T> init) : RVec() { fData.assign(init); }
 
-   RVec(std::initializer_list<T> init) : fData(init) {}
+   ~RVec() = default;
 
    // assignment
    RVec<T> &operator=(const RVec<T> &v)
@@ -328,7 +451,12 @@ public:
 
    RVec<T> &operator=(RVec<T> &&v)
    {
-      std::swap(fData, v.fData);
+      if (this == &v)
+         return *this;
+      if (!IsInline() && !v.IsInline())
+         std::swap(fData, v.fData);
+      else
+         MoveFrom(v);
       return *this;
    }
 
@@ -347,6 +475,8 @@ public:
       return ret;
    }
 
+   /// The container of the elements. It must not be moved or swapped with another container, which might take the
+   /// inline storage of this RVec.
    const Impl_t &AsVector() const { return fData; }
    Impl_t &AsVector() { return fData; }
 
@@ -401,7 +531,12 @@ public:
    size_type max_size() const noexcept { return fData.size(); }
    void reserve(size_type new_cap) { fData.reserve(new_cap); }
    size_type capacity() const noexcept { return fData.capacity(); }
-   void shrink_to_fit() { fData.shrink_to_fit(); };
+   void shrink_to_fit()
+   {
+      // the inline storage cannot shrink
+      if (!IsInline())
+         fData.shrink_to_fit();
+   };
    // modifiers
    void clear() noexcept { fData.clear(); }
    iterator erase(iterator pos) { return fData.erase(pos); }
@@ -424,7 +559,16 @@ public:
    void pop_back() { fData.pop_back(); }
    void resize(size_type count) { fData.resize(count); }
    void resize(size_type count, const value_type &value) { fData.resize(count, value); }
-   void swap(RVec<T> &other) { std::swap(fData, other.fData); }
+   void swap(RVec<T> &other)
+   {
+      if (!IsInline() && !other.IsInline()) {
+         std::swap(fData, other.fData);
+         return;
+      }
+      RVec<T> tmp(std::move(other));
+      other = std::move(*this);
+      *this = std::move(tmp);
+   }
 };
 
 ///@name RVec Unary Arithmetic Operators
@@ -438,6 +582,17 @@ RVec<T> operator OP(const RVec<T> &v)                                          \
    for (auto &x : ret)                                                         \
       x = OP x;                                                                \
 return ret;                                                                    \
+}                                                                              \
+                                                                               \
+/* temporaries are transformed in place */                                     \
+template <typename T>                                                          \
+RVec<T> operator OP(RVec<T> &&v)                                               \
+{                                                                              \
+   if (ROOT::Internal::VecOps::IsAdopting(v))                                  \
+      return OP static_cast<const RVec<T> &>(v);                               \
+   for (auto &&x : v)                                                          \
+      x = OP x;                                                                \
+   return std::move(v);                                                        \
 }                                                                              \
 
 RVEC_UNARY_OPERATOR(+)
@@ -486,6 +641,70 @@ auto operator OP(const RVec<T0> &v0, const RVec<T1> &v1)                       \
    std::transform(v0.begin(), v0.end(), v1.begin(), ret.begin(), op);          \
    return ret;                                                                 \
 }                                                                              \
+                                                                               \
+/* the result is computed in the memory of a temporary operand of its type */  \
+template <typename T0, typename T1,                                            \
+          typename R = decltype(std::declval<const T0 &>() OP std::declval<const T1 &>()), \
+          typename std::enable_if<std::is_same<R, T0>::value, int>::type = 0>  \
+RVec<T0> operator OP(RVec<T0> &&v, const T1 &y)                                \
+{                                                                              \
+   if (ROOT::Internal::VecOps::IsAdopting(v))                                  \
+      return static_cast<const RVec<T0> &>(v) OP y;                            \
+   for (auto &&x : v)                                                          \
+      x = x OP y;                                                              \
+   return std::move(v);                                                        \
+}                                                                              \
+                                                                               \
+template <typename T0, typename T1,                                            \
+          typename R = decltype(std::declval<const T0 &>() OP std::declval<const T1 &>()), \
+          typename std::enable_if<std::is_same<R, T1>::value, int>::type = 0>  \
+RVec<T1> operator OP(const T0 &x, RVec<T1> &&v)                                \
+{                                                                              \
+   if (ROOT::Internal::VecOps::IsAdopting(v))                                  \
+      return x OP static_cast<const RVec<T1> &>(v);                            \
+   for (auto &&y : v)                                                          \
+      y = x OP y;                                                              \
+   return std::move(v);                                                        \
+}                                                                              \
+                                                                               \
+template <typename T0, typename T1,                                            \
+          typename R = decltype(std::declval<const T0 &>() OP std::declval<const T1 &>()), \
+          typename std::enable_if<std::is_same<R, T0>::value, int>::type = 0>  \
+RVec<T0> operator OP(RVec<T0> &&v0, const RVec<T1> &v1)                        \
+{                                                                              \
+   if (v0.size() != v1.size())                                                 \
+      throw std::runtime_error(ERROR_MESSAGE(OP));                             \
+   if (ROOT::Internal::VecOps::IsAdopting(v0))                                 \
+      return static_cast<const RVec<T0> &>(v0) OP v1;                          \
+   auto op = [](const T0 &x, const T1 &y) { return x OP y; };                  \
+   std::transform(v0.begin(), v0.end(), v1.begin(), v0.begin(), op);           \
+   return std::move(v0);                                                       \
+}                                                                              \
+                                                                               \
+template <typename T0, typename T1,                                            \
+          typename R = decltype(std::declval<const T0 &>() OP std::declval<const T1 &>()), \
+          typename std::enable_if<std::is_same<R, T1>::value, int>::type = 0>  \
+RVec<T1> operator OP(const RVec<T0> &v0, RVec<T1> &&v1)                        \
+{                                                                              \
+   if (v0.size() != v1.size())                                                 \
+      throw std::runtime_error(ERROR_MESSAGE(OP));                             \
+   if (ROOT::Internal::VecOps::IsAdopting(v1))                                 \
+      return v0 OP static_cast<const RVec<T1> &>(v1);                          \
+   auto op = [](const T0 &x, const T1 &y) { return x OP y; };                  \
+   std::transform(v0.begin(), v0.end(), v1.begin(), v1.begin(), op);           \
+   return std::move(v1);                                                       \
+}                                                                              \
+                                                                               \
+/* with two temporaries, the memory of the first one is used if possible */    \
+template <typename T0, typename T1,                                            \
+          typename R = decltype(std::declval<const T0 &>() OP std::declval<const T1 &>()), \
+          typename std::enable_if<std::is_same<R, T0>::value || std::is_same<R, T1>::value, int>::type = 0> \
+RVec<R> operator OP(RVec<T0> &&v0, RVec<T1> &&v1)                              \
+{                                                                              \
+   using Left_t = typename std::conditional<std::is_same<R, T0>::value, RVec<T0> &&, const RVec<T0> &>::type; \
+   using Right_t = typename std::conditional<std::is_same<R, T0>::value, const RVec<T1> &, RVec<T1> &&>::type; \
+   return static_cast<Left_t>(v0) OP static_cast<Right_t>(v1);                 \
+}                                                                              \
 
 RVEC_BINARY_OPERATOR(+)
 RVEC_BINARY_OPERATOR(-)
@@ -610,6 +829,17 @@ using PromoteTypes = decltype(PromoteType<U>() + PromoteType<V>());
       auto f = [](const T &x) { return FUNC(x); };                             \
       std::transform(v.begin(), v.end(), ret.begin(), f);                      \
       return ret;                                                              \
+   }                                                                           \
+                                                                               \
+   /* temporaries of the type of the result are transformed in place */        \
+   template <typename T, typename std::enable_if<std::is_same<PromoteType<T>, T>::value, int>::type = 0> \
+   RVec<T> NAME(RVec<T> &&v)                                                   \
+   {                                                                           \
+      if (ROOT::Internal::VecOps::IsAdopting(v))                               \
+         return NAME(static_cast<const RVec<T> &>(v));                         \
+      auto f = [](const T &x) { return FUNC(x); };                             \
+      std::transform(v.begin(), v.end(), v.begin(), f);                        \
+      return std::move(v);                                                     \
    }
 
 #define RVEC_BINARY_FUNCTION(NAME, FUNC)                                       \
@@ -721,6 +951,56 @@ RVEC_VDT_UNARY_FUNCTION(fast_atan)
 
 #endif // R__HAS_VDT
 
+///@}
+///@name RVec Mathematical Functions with SIMD kernels
+///@{
+
+/// Use the fast approximations of vdt in the SIMD kernels that compute exp, log and atan2 of float and double RVecs.
+/// This has no effect if ROOT is built without vdt.
+void EnableFastMath();
+/// Compute exp, log and atan2 of float and double RVecs with the accuracy of the functions of the standard library.
+/// This is the default.
+void DisableFastMath();
+/// Whether the fast approximations of vdt are used, see EnableFastMath
+bool IsFastMathEnabled();
+
+// These functions of float and double RVecs are computed by the SIMD kernels of libROOTVecOps. The overloads are
+// preferred to the templates above, also for the temporaries, whose memory is reused.
+#define RVEC_SIMD_UNARY_FUNCTION(T, NAME, KERNEL)                                     \
+   inline RVec<T> NAME(const RVec<T> &v)                                              \
+   {                                                                                  \
+      RVec<T> ret(v.size());                                                          \
+      ROOT::Internal::VecOps::KERNEL(v.data(), ret.data(), v.size());                 \
+      return ret;                                                                     \
+   }                                                                                  \
+                                                                                      \
+   inline RVec<T> NAME(RVec<T> &&v)                                                   \
+   {                                                                                  \
+      if (ROOT::Internal::VecOps::IsAdopting(v))                                      \
+         return NAME(static_cast<const RVec<T> &>(v));                                \
+      ROOT::Internal::VecOps::KERNEL(v.data(), v.data(), v.size());                   \
+      return std::move(v);                                                            \
+   }
+
+#define RVEC_SIMD_FUNCTIONS(T)                                                        \
+   RVEC_SIMD_UNARY_FUNCTION(T, exp, Exp)                                              \
+   RVEC_SIMD_UNARY_FUNCTION(T, log, Log)                                              \
+   RVEC_SIMD_UNARY_FUNCTION(T, sqrt, Sqrt)                                            \
+                                                                                      \
+   inline RVec<T> atan2(const RVec<T> &y, const RVec<T> &x)                           \
+   {                                                                                  \
+      if (y.size() != x.size())                                                       \
+         throw std::runtime_error("Cannot call atan2 on vectors of different sizes.");\
+      RVec<T> ret(y.size());                                                          \
+      ROOT::Internal::VecOps::Atan2(y.data(), x.data(), ret.data(), y.size());        \
+      return ret;                                                                     \
+   }
+
+RVEC_SIMD_FUNCTIONS(float)
+RVEC_SIMD_FUNCTIONS(double)
+#undef RVEC_SIMD_FUNCTIONS
+#undef RVEC_SIMD_UNARY_FUNCTION
+
 #undef RVEC_UNARY_FUNCTION
 
 ///@}
@@ -744,6 +1024,20 @@ auto Dot(const RVec<T> &v0, const RVec<V> &v1) -> decltype(v0[0] * v1[0])
    return std::inner_product(v0.begin(), v0.end(), v1.begin(), decltype(v0[0] * v1[0])(0));
 }
 
+inline float Dot(const RVec<float> &v0, const RVec<float> &v1)
+{
+   if (v0.size() != v1.size())
+      throw std::runtime_error("Cannot compute inner product of vectors of different sizes");
+   return ROOT::Internal::VecOps::Dot(v0.data(), v1.data(), v0.size());
+}
+
+inline double Dot(const RVec<double> &v0, const RVec<double> &v1)
+{
+   if (v0.size() != v1.size())
+      throw std::runtime_error("Cannot compute inner product of vectors of different sizes");
+   return ROOT::Internal::VecOps::Dot(v0.data(), v1.data(), v0.size());
+}
+
 /// Sum elements of an RVec
 ///
 /// Example code, at the ROOT prompt:
@@ -760,6 +1054,16 @@ T Sum(const RVec<T> &v)
    return std::accumulate(v.begin(), v.end(), T(0));
 }
 
+inline float Sum(const RVec<float> &v)
+{
+   return ROOT::Internal::VecOps::Sum(v.data(), v.size());
+}
+
+inline double Sum(const RVec<double> &v)
+{
+   return ROOT::Internal::VecOps::Sum(v.data(), v.size());
+}
+
 /// Get the mean of the elements of an RVec
 ///
 /// The return type is a double precision floating point number.
@@ -794,6 +1098,16 @@ T Max(const RVec<T> &v)
    return *std::max_element(v.begin(), v.end());
 }
 
+inline float Max(const RVec<float> &v)
+{
+   return v.empty() ? Max<float>(v) : ROOT::Internal::VecOps::Max(v.data(), v.size());
+}
+
+inline double Max(const RVec<double> &v)
+{
+   return v.empty() ? Max<double>(v) : ROOT::Internal::VecOps::Max(v.data(), v.size());
+}
+
 /// Get the smallest element of an RVec
 ///
 /// Example code, at the ROOT prompt:
@@ -1589,6 +1903,26 @@ RVec<T> InvariantMasses(
    return inv_masses;
 }
 
+#define RVEC_SIMD_INVARIANT_MASSES(T)                                                                                \
+   inline RVec<T> InvariantMasses(const RVec<T> &pt1, const RVec<T> &eta1, const RVec<T> &phi1,                   \
+                                  const RVec<T> &mass1, const RVec<T> &pt2, const RVec<T> &eta2,                  \
+                                  const RVec<T> &phi2, const RVec<T> &mass2)                                      \
+   {                                                                                                              \
+      std::size_t size = pt1.size();                                                                              \
+                                                                                                                  \
+      R__ASSERT(eta1.size() == size && phi1.size() == size && mass1.size() == size);                              \
+      R__ASSERT(pt2.size() == size && phi2.size() == size && mass2.size() == size);                               \
+                                                                                                                  \
+      RVec<T> inv_masses(size);                                                                                   \
+      ROOT::Internal::VecOps::InvariantMasses(pt1.data(), eta1.data(), phi1.data(), mass1.data(), pt2.data(),     \
+                                              eta2.data(), phi2.data(), mass2.data(), inv_masses.data(), size);   \
+      return inv_masses;                                                                                          \
+   }
+
+RVEC_SIMD_INVARIANT_MASSES(float)
+RVEC_SIMD_INVARIANT_MASSES(double)
+#undef RVEC_SIMD_INVARIANT_MASSES
+
 /// Return the invariant mass of multiple particles given the collections of the
 /// quantities transverse momentum (pt), rapidity (eta), azimuth (phi) and mass.
 ///
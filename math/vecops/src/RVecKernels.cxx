@@ -0,0 +1,500 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// The SIMD kernels of the mathematical functions and reductions of float and double RVecs.
+// With VecCore, the bulk of the arrays is processed with the vector types of its backend (Vc), see Math/Types.h, and
+// the remainder with scalars. Without it, the loops are left to the auto-vectorizer: this file is compiled with
+// -O3 -ffast-math, and with GCC on x86-64 Linux each kernel is compiled for several instruction sets, the best of
+// which is selected when the library is loaded.
+
+#include "ROOT/RVec.hxx"
+#include "ROOT/RLorentzVectorBatch.hxx"
+#include "RConfigure.h"
+
+#ifdef R__HAS_VECCORE
+#include "Math/Types.h"
+#endif
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+
+#if !defined(R__HAS_VECCORE) && defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && \
+   defined(__linux__)
+#define R__VECOPS_TARGETS __attribute__((target_clones("avx512f", "avx2", "default")))
+// the loops must be inlined in the clones to be compiled for their instruction sets
+#define R__VECOPS_INLINE inline __attribute__((always_inline))
+#else
+#define R__VECOPS_TARGETS
+#define R__VECOPS_INLINE inline
+#endif
+
+namespace {
+
+std::atomic<bool> gFastMath{false};
+
+bool UseVdt()
+{
+#ifdef R__HAS_VDT
+   return gFastMath.load(std::memory_order_relaxed);
+#else
+   return false;
+#endif
+}
+
+#ifdef R__HAS_VECCORE
+namespace VecMath = vecCore::math;
+
+template <typename T>
+struct RSimd;
+
+template <>
+struct RSimd<float> {
+   using Vector_t = ROOT::Float_v;
+};
+
+template <>
+struct RSimd<double> {
+   using Vector_t = ROOT::Double_v;
+};
+
+using vecCore::Blend;
+#else
+// The functions of vecCore::math used below, for scalars
+namespace VecMath {
+template <typename T>
+T Exp(T x)
+{
+   return std::exp(x);
+}
+template <typename T>
+T Log(T x)
+{
+   return std::log(x);
+}
+template <typename T>
+T Sqrt(T x)
+{
+   return std::sqrt(x);
+}
+template <typename T>
+T ATan2(T y, T x)
+{
+   return std::atan2(y, x);
+}
+template <typename T>
+T Sin(T x)
+{
+   return std::sin(x);
+}
+template <typename T>
+T Cos(T x)
+{
+   return std::cos(x);
+}
+template <typename T>
+T Sinh(T x)
+{
+   return std::sinh(x);
+}
+template <typename T>
+T Max(T x, T y)
+{
+   return x < y ? y : x;
+}
+template <typename T>
+T Abs(T x)
+{
+   return std::abs(x);
+}
+template <typename T>
+T Floor(T x)
+{
+   return std::floor(x);
+}
+} // namespace VecMath
+
+template <typename T>
+T Blend(bool mask, T tval, T fval)
+{
+   return mask ? tval : fval;
+}
+#endif
+
+/// x, which is not negative, with the sign of y
+template <typename V>
+V WithSignOf(const V &x, const V &y)
+{
+   return Blend(y < V(0), -x, x);
+}
+
+struct RExp {
+   template <typename V>
+   V operator()(const V &x) const
+   {
+      return VecMath::Exp(x);
+   }
+};
+
+struct RLog {
+   template <typename V>
+   V operator()(const V &x) const
+   {
+      return VecMath::Log(x);
+   }
+};
+
+struct RSqrt {
+   template <typename V>
+   V operator()(const V &x) const
+   {
+      return VecMath::Sqrt(x);
+   }
+};
+
+struct RAtan2 {
+   template <typename V>
+   V operator()(const V &y, const V &x) const
+   {
+      return VecMath::ATan2(y, x);
+   }
+};
+
+struct RInvariantMass {
+   template <typename V>
+   V operator()(const V &pt1, const V &eta1, const V &phi1, const V &mass1, const V &pt2, const V &eta2,
+                const V &phi2, const V &mass2) const
+   {
+      // Conversion from (pt, eta, phi, mass) to (x, y, z, e) coordinate system
+      const V x1 = pt1 * VecMath::Cos(phi1);
+      const V y1 = pt1 * VecMath::Sin(phi1);
+      const V z1 = pt1 * VecMath::Sinh(eta1);
+      const V e1 = VecMath::Sqrt(x1 * x1 + y1 * y1 + z1 * z1 + mass1 * mass1);
+
+      const V x2 = pt2 * VecMath::Cos(phi2);
+      const V y2 = pt2 * VecMath::Sin(phi2);
+      const V z2 = pt2 * VecMath::Sinh(eta2);
+      const V e2 = VecMath::Sqrt(x2 * x2 + y2 * y2 + z2 * z2 + mass2 * mass2);
+
+      // Addition of particle four-vector elements, invariant mass with (+, -, -, -) metric
+      const V e = e1 + e2;
+      const V x = x1 + x2;
+      const V y = y1 + y2;
+      const V z = z1 + z2;
+      return VecMath::Sqrt(e * e - x * x - y * y - z * z);
+   }
+};
+
+/// Lorentz vectors in cartesian coordinates, for the kernels of RLorentzVectorBatch
+template <typename V>
+struct RPxPyPzE {
+   V fX, fY, fZ, fE;
+};
+
+template <typename V>
+RPxPyPzE<V> FromPtEtaPhiM(const V &pt, const V &eta, const V &phi, const V &m)
+{
+   const V x = pt * VecMath::Cos(phi);
+   const V y = pt * VecMath::Sin(phi);
+   const V z = pt * VecMath::Sinh(eta);
+   return {x, y, z, VecMath::Sqrt(x * x + y * y + z * z + m * m)};
+}
+
+/// (pt, eta, phi) of the vector (x, y, z)
+template <typename V>
+std::array<V, 3> PtEtaPhi(const V &x, const V &y, const V &z)
+{
+   const V pt = VecMath::Sqrt(x * x + y * y);
+   const V p = VecMath::Sqrt(x * x + y * y + z * z);
+   // asinh(z / pt), computed for |z| to avoid the cancellation for z < 0
+   const V absEta = VecMath::Log((p + VecMath::Abs(z)) / pt);
+   return {pt, WithSignOf(absEta, z), VecMath::ATan2(y, x)};
+}
+
+struct RLorentzPxPyPzE {
+   template <typename V>
+   std::array<V, 4> operator()(const V &pt, const V &eta, const V &phi, const V &m) const
+   {
+      const auto v = FromPtEtaPhiM(pt, eta, phi, m);
+      return {v.fX, v.fY, v.fZ, v.fE};
+   }
+};
+
+struct RLorentzAdd {
+   template <typename V>
+   std::array<V, 4> operator()(const V &pt1, const V &eta1, const V &phi1, const V &m1, const V &pt2, const V &eta2,
+                               const V &phi2, const V &m2) const
+   {
+      const auto v1 = FromPtEtaPhiM(pt1, eta1, phi1, m1);
+      const auto v2 = FromPtEtaPhiM(pt2, eta2, phi2, m2);
+      const V x = v1.fX + v2.fX;
+      const V y = v1.fY + v2.fY;
+      const V z = v1.fZ + v2.fZ;
+      const V e = v1.fE + v2.fE;
+      const auto ptEtaPhi = PtEtaPhi(x, y, z);
+      // as GenVector, a negative squared mass gives a negative mass
+      const V m2sum = e * e - x * x - y * y - z * z;
+      return {ptEtaPhi[0], ptEtaPhi[1], ptEtaPhi[2], WithSignOf(VecMath::Sqrt(VecMath::Abs(m2sum)), m2sum)};
+   }
+};
+
+struct RLorentzBoost {
+   template <typename V>
+   std::array<V, 3> operator()(const V &pt, const V &eta, const V &phi, const V &m, const V &bx, const V &by,
+                               const V &bz) const
+   {
+      // as ROOT::Math::LorentzVector::Boost, with (gamma - 1) / b2 = gamma^2 / (gamma + 1) which is also defined
+      // for a null velocity
+      const auto v = FromPtEtaPhiM(pt, eta, phi, m);
+      const V b2 = bx * bx + by * by + bz * bz;
+      const V gamma = V(1) / VecMath::Sqrt(V(1) - b2);
+      const V bp = bx * v.fX + by * v.fY + bz * v.fZ;
+      const V gamma2 = gamma * gamma / (gamma + V(1));
+      const V c = gamma2 * bp + gamma * v.fE;
+      return PtEtaPhi(v.fX + c * bx, v.fY + c * by, v.fZ + c * bz);
+   }
+};
+
+struct RDeltaR {
+   template <typename V>
+   V operator()(const V &eta1, const V &phi1, const V &eta2, const V &phi2) const
+   {
+      // the difference of the angles, in [-pi, pi)
+      const V twoPi(2 * M_PI);
+      V dphi = phi2 - phi1;
+      dphi = dphi - twoPi * VecMath::Floor(dphi / twoPi + V(0.5));
+      const V deta = eta1 - eta2;
+      return VecMath::Sqrt(deta * deta + dphi * dphi);
+   }
+};
+
+/// out[i] = f(in0[i], in1[i], ...)
+template <typename T, typename F, typename... Ins>
+R__VECOPS_INLINE void Map(F f, T *out, std::size_t n, const Ins *... ins)
+{
+   std::size_t i = 0;
+#ifdef R__HAS_VECCORE
+   using V = typename RSimd<T>::Vector_t;
+   constexpr std::size_t N = vecCore::VectorSize<V>();
+   for (; i + N <= n; i += N)
+      vecCore::Store<V>(f(vecCore::Load<V>(ins + i)...), out + i);
+#endif
+   for (; i < n; ++i)
+      out[i] = f(ins[i]...);
+}
+
+/// outs[k][i] = f(in0[i], in1[i], ...)[k], where f returns a std::array of K values
+template <typename T, std::size_t K, typename F, typename... Ins>
+R__VECOPS_INLINE void MapN(F f, T *const (&outs)[K], std::size_t n, const Ins *... ins)
+{
+   std::size_t i = 0;
+#ifdef R__HAS_VECCORE
+   using V = typename RSimd<T>::Vector_t;
+   constexpr std::size_t N = vecCore::VectorSize<V>();
+   for (; i + N <= n; i += N) {
+      const auto res = f(vecCore::Load<V>(ins + i)...);
+      for (std::size_t k = 0; k < K; ++k)
+         vecCore::Store<V>(res[k], outs[k] + i);
+   }
+#endif
+   for (; i < n; ++i) {
+      const auto res = f(ins[i]...);
+      for (std::size_t k = 0; k < K; ++k)
+         outs[k][i] = res[k];
+   }
+}
+
+/// Combine the values f(in0[i], in1[i], ...) with op, starting from init
+template <typename T, typename Op, typename F, typename... Ins>
+R__VECOPS_INLINE T Reduce(Op op, T init, F f, std::size_t n, const Ins *... ins)
+{
+   T res = init;
+   std::size_t i = 0;
+#ifdef R__HAS_VECCORE
+   using V = typename RSimd<T>::Vector_t;
+   constexpr std::size_t N = vecCore::VectorSize<V>();
+   if (n >= N) {
+      V acc(init);
+      for (; i + N <= n; i += N)
+         acc = op(acc, f(vecCore::Load<V>(ins + i)...));
+      for (std::size_t lane = 0; lane < N; ++lane)
+         res = op(res, vecCore::Get(acc, lane));
+   }
+#endif
+   for (; i < n; ++i)
+      res = op(res, f(ins[i]...));
+   return res;
+}
+
+struct RPlus {
+   template <typename V>
+   V operator()(const V &x, const V &y) const
+   {
+      return x + y;
+   }
+};
+
+struct RMax {
+   template <typename V>
+   V operator()(const V &x, const V &y) const
+   {
+      return VecMath::Max(x, y);
+   }
+};
+
+struct RIdentity {
+   template <typename V>
+   V operator()(const V &x) const
+   {
+      return x;
+   }
+};
+
+struct RProduct {
+   template <typename V>
+   V operator()(const V &x, const V &y) const
+   {
+      return x * y;
+   }
+};
+
+#ifdef R__HAS_VDT
+inline float VdtExp(float x)
+{
+   return vdt::fast_expf(x);
+}
+inline double VdtExp(double x)
+{
+   return vdt::fast_exp(x);
+}
+inline float VdtLog(float x)
+{
+   return vdt::fast_logf(x);
+}
+inline double VdtLog(double x)
+{
+   return vdt::fast_log(x);
+}
+inline float VdtAtan2(float y, float x)
+{
+   return vdt::fast_atan2f(y, x);
+}
+inline double VdtAtan2(double y, double x)
+{
+   return vdt::fast_atan2(y, x);
+}
+#define RVEC_VDT_KERNEL(STMT) \
+   if (UseVdt()) {            \
+      STMT;                   \
+      return;                 \
+   }
+#else
+#define RVEC_VDT_KERNEL(STMT)
+#endif
+
+} // anonymous namespace
+
+void ROOT::VecOps::EnableFastMath()
+{
+   gFastMath = true;
+}
+
+void ROOT::VecOps::DisableFastMath()
+{
+   gFastMath = false;
+}
+
+bool ROOT::VecOps::IsFastMathEnabled()
+{
+   return UseVdt();
+}
+
+#define RVEC_DEFINE_SIMD_KERNELS(T)                                                                                  \
+   R__VECOPS_TARGETS void ROOT::Internal::VecOps::Exp(const T *in, T *out, std::size_t n)                            \
+   {                                                                                                                 \
+      RVEC_VDT_KERNEL(for (std::size_t i = 0; i < n; ++i) out[i] = VdtExp(in[i]))                                    \
+      Map(RExp(), out, n, in);                                                                                       \
+   }                                                                                                                 \
+                                                                                                                     \
+   R__VECOPS_TARGETS void ROOT::Internal::VecOps::Log(const T *in, T *out, std::size_t n)                            \
+   {                                                                                                                 \
+      RVEC_VDT_KERNEL(for (std::size_t i = 0; i < n; ++i) out[i] = VdtLog(in[i]))                                    \
+      Map(RLog(), out, n, in);                                                                                       \
+   }                                                                                                                 \
+                                                                                                                     \
+   R__VECOPS_TARGETS void ROOT::Internal::VecOps::Sqrt(const T *in, T *out, std::size_t n)                           \
+   {                                                                                                                 \
+      Map(RSqrt(), out, n, in);                                                                                      \
+   }                                                                                                                 \
+                                                                                                                     \
+   R__VECOPS_TARGETS void ROOT::Internal::VecOps::Atan2(const T *y, const T *x, T *out, std::size_t n)               \
+   {                                                                                                                 \
+      RVEC_VDT_KERNEL(for (std::size_t i = 0; i < n; ++i) out[i] = VdtAtan2(y[i], x[i]))                             \
+      Map(RAtan2(), out, n, y, x);                                                                                   \
+   }                                                                                                                 \
+                                                                                                                     \
+   R__VECOPS_TARGETS T ROOT::Internal::VecOps::Sum(const T *in, std::size_t n)                                       \
+   {                                                                                                                 \
+      return Reduce(RPlus(), T(0), RIdentity(), n, in);                                                                \
+   }                                                                                                                 \
+                                                                                                                     \
+   R__VECOPS_TARGETS T ROOT::Internal::VecOps::Dot(const T *in0, const T *in1, std::size_t n)                        \
+   {                                                                                                                 \
+      return Reduce(RPlus(), T(0), RProduct(), n, in0, in1);                                                           \
+   }                                                                                                                 \
+                                                                                                                     \
+   R__VECOPS_TARGETS T ROOT::Internal::VecOps::Max(const T *in, std::size_t n)                                       \
+   {                                                                                                                 \
+      return Reduce(RMax(), in[0], RIdentity(), n - 1, in + 1);                                                        \
+   }                                                                                                                 \
+                                                                                                                     \
+   R__VECOPS_TARGETS void ROOT::Internal::VecOps::InvariantMasses(const T *pt1, const T *eta1, const T *phi1,        \
+                                                                  const T *mass1, const T *pt2, const T *eta2,       \
+                                                                  const T *phi2, const T *mass2, T *out,             \
+                                                                  std::size_t n)                                     \
+   {                                                                                                                 \
+      Map(RInvariantMass(), out, n, pt1, eta1, phi1, mass1, pt2, eta2, phi2, mass2);                                 \
+   }
+
+RVEC_DEFINE_SIMD_KERNELS(float)
+RVEC_DEFINE_SIMD_KERNELS(double)
+
+#define RVEC_DEFINE_LORENTZ_KERNELS(T)                                                                               \
+   R__VECOPS_TARGETS void ROOT::Internal::VecOps::PxPyPzE(const T *pt, const T *eta, const T *phi, const T *m,      \
+                                                          T *px, T *py, T *pz, T *e, std::size_t n)                  \
+   {                                                                                                                 \
+      T *const outs[] = {px, py, pz, e};                                                                             \
+      MapN(RLorentzPxPyPzE(), outs, n, pt, eta, phi, m);                                                             \
+   }                                                                                                                 \
+                                                                                                                     \
+   R__VECOPS_TARGETS void ROOT::Internal::VecOps::AddPtEtaPhiM(const T *pt1, const T *eta1, const T *phi1,          \
+                                                               const T *m1, const T *pt2, const T *eta2,            \
+                                                               const T *phi2, const T *m2, T *pt, T *eta, T *phi,   \
+                                                               T *m, std::size_t n)                                  \
+   {                                                                                                                 \
+      T *const outs[] = {pt, eta, phi, m};                                                                           \
+      MapN(RLorentzAdd(), outs, n, pt1, eta1, phi1, m1, pt2, eta2, phi2, m2);                                        \
+   }                                                                                                                 \
+                                                                                                                     \
+   R__VECOPS_TARGETS void ROOT::Internal::VecOps::BoostPtEtaPhiM(const T *pt, const T *eta, const T *phi,           \
+                                                                 const T *m, const T *bx, const T *by, const T *bz, \
+                                                                 T *ptOut, T *etaOut, T *phiOut, std::size_t n)     \
+   {                                                                                                                 \
+      T *const outs[] = {ptOut, etaOut, phiOut};                                                                     \
+      MapN(RLorentzBoost(), outs, n, pt, eta, phi, m, bx, by, bz);                                                   \
+   }                                                                                                                 \
+                                                                                                                     \
+   R__VECOPS_TARGETS void ROOT::Internal::VecOps::DeltaR(const T *eta1, const T *phi1, const T *eta2, const T *phi2, \
+                                                         T *out, std::size_t n)                                      \
+   {                                                                                                                 \
+      Map(RDeltaR(), out, n, eta1, phi1, eta2, phi2);                                                                \
+   }
+
+RVEC_DEFINE_LORENTZ_KERNELS(float)
+RVEC_DEFINE_LORENTZ_KERNELS(double)
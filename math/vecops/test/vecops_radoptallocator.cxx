@@ -98,3 +98,38 @@ TEST(RAdoptAllocator, Traits)
 
 }
 
+
+TEST(RAdoptAllocator, Buffer)
+{
+   double buffer[4];
+   RAdoptAllocator<double> alloc(buffer, 4);
+   std::vector<double, RAdoptAllocator<double>> v(alloc);
+   v.reserve(4);
+   EXPECT_EQ(buffer, v.data());
+   v.assign({1., 2., 3., 4.});
+   EXPECT_EQ(buffer, v.data());
+   v.emplace_back(5.);
+   EXPECT_NE(buffer, v.data());
+
+   // the buffer is used again once it is released
+   v.resize(2);
+   v.shrink_to_fit();
+   EXPECT_EQ(buffer, v.data());
+   EXPECT_EQ(2., v[1]);
+
+   // containers that are moved from the original one do not use the buffer
+   std::vector<double, RAdoptAllocator<double>> moved(std::move(v));
+   EXPECT_EQ(buffer, moved.data());
+   moved.emplace_back(3.);
+   moved.clear();
+   moved.shrink_to_fit();
+   moved.reserve(1);
+   EXPECT_NE(buffer, moved.data());
+
+   // copies of the container do not use the buffer either
+   std::vector<double, RAdoptAllocator<double>> w(alloc);
+   w.reserve(2);
+   auto copy = w;
+   copy.reserve(2);
+   EXPECT_NE(buffer, copy.data());
+}
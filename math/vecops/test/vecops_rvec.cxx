@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 #include <Math/LorentzVector.h>
 #include <Math/PtEtaPhiM4D.h>
+#include <Math/Vector3D.h>
 #include <Math/Vector4Dfwd.h>
+#include <Math/VectorUtil.h>
+#include <ROOT/RLorentzVectorBatch.hxx>
 #include <ROOT/RVec.hxx>
 #include <ROOT/TSeq.hxx>
 #include <TFile.h>
@@ -1068,3 +1071,242 @@ TEST(VecOps, Construct)
    EXPECT_TRUE(fourVects[2] == ref2);
 }
 
+
+TEST(VecOps, InlineStorage)
+{
+   // 8 doubles fit in the inline storage
+   RVec<double> v{1., 2., 3.};
+   const auto inlineData = v.data();
+   const auto inlineCapacity = v.capacity();
+   EXPECT_EQ(8u, inlineCapacity);
+   for (auto i = 3u; i < inlineCapacity; ++i)
+      v.emplace_back(i);
+   EXPECT_EQ(inlineData, v.data());
+   v.emplace_back(42.);
+   EXPECT_NE(inlineData, v.data());
+
+   // moving a RVec stored inline moves the elements, moving a RVec stored on the heap moves the memory
+   RVec<double> small{1., 2.};
+   RVec<double> movedSmall(std::move(small));
+   CheckEqual(movedSmall, RVec<double>{1., 2.});
+   EXPECT_TRUE(small.empty());
+   small.emplace_back(3.);
+   CheckEqual(small, RVec<double>{3.});
+   const auto heapData = v.data();
+   RVec<double> movedLarge(std::move(v));
+   EXPECT_EQ(heapData, movedLarge.data());
+   EXPECT_EQ(9u, movedLarge.size());
+   EXPECT_TRUE(v.empty());
+
+   std::swap(movedSmall, movedLarge);
+   EXPECT_EQ(heapData, movedSmall.data());
+   CheckEqual(movedLarge, RVec<double>{1., 2.});
+   movedLarge = std::move(movedSmall);
+   EXPECT_EQ(heapData, movedLarge.data());
+
+   // adopted memory is moved too
+   std::vector<double> model{1., 2., 3.};
+   RVec<double> adopting(model.data(), model.size());
+   RVec<double> owning{4.};
+   std::swap(adopting, owning);
+   EXPECT_EQ(model.data(), owning.data());
+   CheckEqual(adopting, RVec<double>{4.});
+   CheckEqual(model, std::vector<double>{1., 2., 3.});
+
+   // collections of RVecs and of non-trivial types
+   RVec<std::string> strings{"a", "b"};
+   RVec<RVec<std::string>> nested(2, strings);
+   nested.emplace_back(std::move(strings));
+   nested.emplace_back(RVec<std::string>(100, "c"));
+   EXPECT_EQ(4u, nested.size());
+   EXPECT_EQ("b", nested[2][1]);
+   EXPECT_EQ(100u, nested[3].size());
+   nested[3].resize(1);
+   nested[3].shrink_to_fit();
+   EXPECT_EQ(1u, nested[3].size());
+}
+
+TEST(VecOps, TemporariesReuse)
+{
+   // RVecs larger than the inline storage, so that reusing their memory is visible
+   RVec<double> x(100, 2.);
+   RVec<double> y(100, 3.);
+
+   RVec<double> tmp = x * y;
+   const auto tmpData = tmp.data();
+   auto res = std::move(tmp) + x;
+   EXPECT_EQ(tmpData, res.data());
+   CheckEqual(res, RVec<double>(100, 8.));
+
+   auto chain = sqrt(x * x + y * y + 3.) - 1.;
+   CheckEqual(chain, RVec<double>(100, 3.));
+   auto right = 1. - (x / y) * 3.;
+   CheckEqual(right, RVec<double>(100, -1.));
+   auto both = (x + 1.) * (y - 1.);
+   CheckEqual(both, RVec<double>(100, 6.));
+   auto neg = -(x + y);
+   CheckEqual(neg, RVec<double>(100, -5.));
+
+   // the result type differs from the type of the temporaries: new memory is allocated
+   RVec<float> f(100, 2.f);
+   RVec<double> promoted = (f * 2.f) * 1.5;
+   CheckEqual(promoted, RVec<double>(100, 6.));
+   RVec<double> promoted2 = (f + 1.f) + (f + 2.f) * 1.;
+   CheckEqual(promoted2, RVec<double>(100, 7.));
+   RVec<int> i(100, 2);
+   RVec<double> sqrti = sqrt(i * 2);
+   CheckEqual(sqrti, RVec<double>(100, 2.));
+
+   // adopted memory is never overwritten
+   std::vector<double> model(100, 4.);
+   RVec<double> adopting(model.data(), model.size());
+   auto fromAdopting = std::move(adopting) * 2.;
+   EXPECT_NE(model.data(), fromAdopting.data());
+   CheckEqual(fromAdopting, RVec<double>(100, 8.));
+   CheckEqual(model, std::vector<double>(100, 4.));
+
+   // sizes are still checked
+   EXPECT_THROW(RVec<double>(3, 1.) + RVec<double>(2, 1.), std::runtime_error);
+}
+
+template <typename T>
+void CheckSIMDKernels(T tolerance)
+{
+   // sizes around the widths of the vector registers, to exercise the remainders of the loops
+   for (std::size_t size = 0u; size < 40u; ++size) {
+      RVec<T> x(size), y(size);
+      for (std::size_t i = 0u; i < size; ++i) {
+         x[i] = T(0.25) + T(0.5) * i;
+         y[i] = T(1.5) - T(0.2) * i;
+      }
+      const auto expX = exp(x);
+      const auto logX = log(x);
+      const auto sqrtX = sqrt(x);
+      const auto atan2YX = atan2(y, x);
+      T sum = 0, dot = 0;
+      for (std::size_t i = 0u; i < size; ++i) {
+         EXPECT_NEAR(std::exp(x[i]), expX[i], tolerance * std::exp(x[i]));
+         EXPECT_NEAR(std::log(x[i]), logX[i], tolerance);
+         EXPECT_NEAR(std::sqrt(x[i]), sqrtX[i], tolerance * std::sqrt(x[i]));
+         EXPECT_NEAR(std::atan2(y[i], x[i]), atan2YX[i], tolerance);
+         sum += x[i];
+         dot += x[i] * y[i];
+      }
+      EXPECT_NEAR(sum, Sum(x), tolerance * std::abs(sum));
+      EXPECT_NEAR(dot, Dot(x, y), tolerance * (1 + std::abs(dot)));
+      if (size > 0) {
+         EXPECT_EQ(x.back(), Max(x));
+         EXPECT_EQ(y.front(), Max(y));
+      }
+
+      // the temporaries are transformed in place (their memory is reused if it is not the inline storage)
+      auto tmp = x * T(2);
+      const auto tmpData = tmp.data();
+      const auto sqrtTmp = sqrt(std::move(tmp));
+      if (size * sizeof(T) > 64)
+         EXPECT_EQ(tmpData, sqrtTmp.data());
+      for (std::size_t i = 0u; i < size; ++i)
+         EXPECT_NEAR(std::sqrt(2 * x[i]), sqrtTmp[i], tolerance * std::sqrt(2 * x[i]));
+
+      RVec<T> pt(size), eta(size), phi(size);
+      for (std::size_t i = 0u; i < size; ++i) {
+         pt[i] = T(10) + i;
+         eta[i] = T(2) * std::sin(T(i));
+         phi[i] = T(3) * std::cos(T(i));
+      }
+      const RVec<T> mass(size, T(0.105));
+      const auto invMass = InvariantMasses(pt, eta, phi, mass, pt * T(2), -eta, phi + T(1), mass);
+      const auto invMassRef = InvariantMasses<T>(pt, eta, phi, mass, pt * T(2), -eta, phi + T(1), mass);
+      for (std::size_t i = 0u; i < size; ++i)
+         EXPECT_NEAR(invMassRef[i], invMass[i], tolerance * (1 + invMassRef[i]));
+   }
+   EXPECT_THROW(atan2(RVec<T>(3), RVec<T>(2)), std::runtime_error);
+}
+
+TEST(VecOps, SIMDKernels)
+{
+   CheckSIMDKernels<float>(1e-5f);
+   CheckSIMDKernels<double>(1e-12);
+
+   ROOT::VecOps::EnableFastMath();
+#ifdef R__HAS_VDT
+   EXPECT_TRUE(ROOT::VecOps::IsFastMathEnabled());
+#else
+   EXPECT_FALSE(ROOT::VecOps::IsFastMathEnabled());
+#endif
+   CheckSIMDKernels<float>(1e-5f);
+   CheckSIMDKernels<double>(1e-12);
+   ROOT::VecOps::DisableFastMath();
+   EXPECT_FALSE(ROOT::VecOps::IsFastMathEnabled());
+}
+
+template <typename T>
+void CheckLorentzVectorBatch(T tol)
+{
+   // more elements than the SIMD width, to check also the remainder loops
+   const std::size_t n = 19;
+   RVec<T> pt1(n), eta1(n), phi1(n), m1(n), pt2(n), eta2(n), phi2(n), m2(n), bx(n), by(n), bz(n);
+   for (std::size_t i = 0; i < n; ++i) {
+      pt1[i] = 5 + 3 * i;
+      eta1[i] = -2.4 + 0.25 * i;
+      phi1[i] = -3.1 + 0.33 * i;
+      m1[i] = (i % 3) * 0.5;
+      pt2[i] = 60 - 2 * i;
+      eta2[i] = 2.1 - 0.2 * i;
+      phi2[i] = 3.0 - 0.35 * i;
+      m2[i] = 0.105;
+      bx[i] = 0.02 * i - 0.2;
+      by[i] = 0.3 - 0.01 * i;
+      bz[i] = (i % 2) ? 0.5 : -0.4;
+   }
+
+   RLorentzVectorBatch<T> a(pt1, eta1, phi1, m1);
+   RLorentzVectorBatch<T> b(pt2, eta2, phi2, m2);
+   EXPECT_EQ(a.size(), n);
+   const auto sum = a + b;
+   const auto dr = DeltaR(a, b);
+   const auto boosted = a.Boost(bx, by, bz);
+   RVec<T> px, py, pz, e;
+   a.GetPxPyPzE(px, py, pz, e);
+
+   for (std::size_t i = 0; i < n; ++i) {
+      const ROOT::Math::PtEtaPhiMVector v1(pt1[i], eta1[i], phi1[i], m1[i]);
+      const ROOT::Math::PtEtaPhiMVector v2(pt2[i], eta2[i], phi2[i], m2[i]);
+      EXPECT_NEAR(px[i], v1.Px(), tol * v1.E());
+      EXPECT_NEAR(py[i], v1.Py(), tol * v1.E());
+      EXPECT_NEAR(pz[i], v1.Pz(), tol * v1.E());
+      EXPECT_NEAR(e[i], v1.E(), tol * v1.E());
+
+      const auto v = v1 + v2;
+      EXPECT_NEAR(sum.Pt()[i], v.Pt(), tol * v.E());
+      EXPECT_NEAR(sum.Eta()[i], v.Eta(), tol * std::abs(v.Eta()) + tol);
+      EXPECT_NEAR(sum.Phi()[i], v.Phi(), tol);
+      EXPECT_NEAR(sum.M()[i], v.M(), tol * v.E());
+
+      EXPECT_NEAR(dr[i], ROOT::Math::VectorUtil::DeltaR(v1, v2), tol * 10);
+
+      const auto vb = ROOT::Math::VectorUtil::boost(v1, ROOT::Math::XYZVector(bx[i], by[i], bz[i]));
+      EXPECT_NEAR(boosted.Pt()[i], vb.Pt(), tol * vb.E());
+      EXPECT_NEAR(boosted.Eta()[i], vb.Eta(), tol * std::abs(vb.Eta()) + tol);
+      EXPECT_NEAR(boosted.Phi()[i], vb.Phi(), tol);
+      EXPECT_EQ(boosted.M()[i], m1[i]);
+   }
+
+   // conversion from and to RVec<PtEtaPhiMVector>
+   const auto vectors = a.template ToVectors<ROOT::Math::PtEtaPhiMVector>();
+   const auto fromVectors = RLorentzVectorBatch<T>::FromVectors(vectors);
+   for (std::size_t i = 0; i < n; ++i) {
+      EXPECT_NEAR(fromVectors.Pt()[i], pt1[i], tol * pt1[i]);
+      EXPECT_NEAR(fromVectors.Eta()[i], eta1[i], tol);
+      EXPECT_NEAR(fromVectors.Phi()[i], phi1[i], tol);
+   }
+
+   EXPECT_THROW((RLorentzVectorBatch<T>(pt1, eta1, phi1, RVec<T>(n - 1))), std::runtime_error);
+   EXPECT_THROW(a.Boost(bx, by, RVec<T>(n + 1)), std::runtime_error);
+}
+
+TEST(VecOps, LorentzVectorBatch)
+{
+   CheckLorentzVectorBatch<float>(1e-4f);
+   CheckLorentzVectorBatch<double>(1e-10);
+}
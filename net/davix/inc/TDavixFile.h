@@ -50,6 +50,9 @@
 //Davix.S3.Region
 //Davix.S3.Token
 //
+//Davix.ReadV.Parallel
+//Davix.ReadV.MinSize
+//
 // Environment variables:
 // X509_USER_CERT, X509_USER_KEY, X509_USER_PROXY ... usual meaning for the X509 Grid things. gEnv vars have higher priority.
 // S3_ACCESS_KEY, S3_SECRET_KEY, S3_REGION, S3_TOKEN. gEnv vars have higher priority.
@@ -112,6 +115,10 @@ public:
     /// and grid related extension for a grid analysis usage
     void enableGridMode();
 
+    /// Set the maximal number of concurrent requests used to read the buffers of
+    /// large vectored reads, 1 keeps a single multi-range request
+    void setReadVParallel(Int_t nreq);
+
     ClassDef(TDavixFile, 0)
 };
 
@@ -50,6 +50,9 @@
 #include <sstream>
 #include <string>
 #include <cstring>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 
 static const std::string VERSION = "0.2.0";
@@ -440,6 +443,13 @@ void TDavixFileInternal::parseConfig()
    env_var = gEnv->GetValue("Davix.GSI.GridMode", (const char *)"y");
    if (!isno(env_var))
       enableGridMode();
+
+   // vectored reads
+   readvParallel = gEnv->GetValue("Davix.ReadV.Parallel", readvParallel);
+   readvMinSize = gEnv->GetValue("Davix.ReadV.MinSize", (Int_t)readvMinSize);
+   if (gDebug > 0)
+      Info("parseConfig", "Split vectored reads of at least %lld bytes in up to %d concurrent requests",
+           readvMinSize, readvParallel);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -713,6 +723,13 @@ void TDavixFile::enableGridMode()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void TDavixFile::setReadVParallel(Int_t nreq)
+{
+   d_ptr->readvParallel = (nreq < 1) ? 1 : nreq;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 bool TDavixFileInternal::isMyDird(void *fd)
 {
    TLockGuard l(&(openLock));
@@ -738,6 +755,70 @@ void TDavixFileInternal::removeDird(void *fd)
       dirdVec.erase(f);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the nbuf ranges of a vectored read with nreq concurrent requests.
+/// The ranges are split in groups of consecutive ranges with about the same
+/// number of bytes, each group being read with single range requests by its
+/// own thread. The requests go through the davix context shared by all the
+/// files, so that the connections are taken from and returned to its pool.
+/// Returns the number of bytes read or -1 in case of error.
+
+Long64_t TDavixFileInternal::readBuffersParallel(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf, Int_t nreq)
+{
+   std::vector<Long64_t> bufOffset(nbuf + 1, 0);
+   for (Int_t i = 0; i < nbuf; ++i)
+      bufOffset[i + 1] = bufOffset[i] + len[i];
+   const Long64_t total = bufOffset[nbuf];
+
+   // first range of each group
+   std::vector<Int_t> first(nreq + 1, nbuf);
+   first[0] = 0;
+   Int_t igroup = 1;
+   for (Int_t i = 1; (i < nbuf) && (igroup < nreq); ++i) {
+      if (bufOffset[i] * nreq >= total * igroup)
+         first[igroup++] = i;
+   }
+
+   std::atomic<bool> failed(false);
+   std::string errMsg;
+   std::mutex errMutex;
+
+   auto readGroup = [&](Int_t ireq) {
+      DavFile file(*davixContext, Davix::Uri(fUrl.GetUrl()));
+      for (Int_t i = first[ireq]; (i < first[ireq + 1]) && !failed; ++i) {
+         DavixError *davixErr = NULL;
+         dav_ssize_t ret = file.readPartial(davixParam, buf + bufOffset[i], len[i], pos[i], &davixErr);
+         if (ret != len[i]) {
+            if (!failed.exchange(true)) {
+               std::lock_guard<std::mutex> lock(errMutex);
+               errMsg = davixErr ? davixErr->getErrMsg() : std::string("short read");
+            }
+            DavixError::clearError(&davixErr);
+         }
+      }
+   };
+
+   std::vector<std::thread> threads;
+   for (Int_t ireq = 1; ireq < nreq; ++ireq) {
+      if (first[ireq] < first[ireq + 1])
+         threads.emplace_back(readGroup, ireq);
+   }
+   readGroup(0);
+   for (auto &t : threads)
+      t.join();
+
+   if (failed) {
+      Error("DavixReadBuffers", "can not read data with davix: %s", errMsg.c_str());
+      return -1;
+   }
+
+   if (gDebug > 1)
+      Info("DavixReadBuffers", "%lld bytes read from %d buffers with %d concurrent requests",
+           total, nbuf, nreq);
+
+   return total;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Long64_t TDavixFile::GetSize() const
@@ -847,6 +928,20 @@ Long64_t TDavixFile::DavixReadBuffers(Davix_fd *fd, char *buf, Long64_t *pos, In
 {
    DavixError *davixErr = NULL;
    Double_t start_time = eventStart();
+
+   // large vectored reads are split in concurrent single range requests, as many servers
+   // answer multi-range requests serially or not at all
+   Long64_t total = 0;
+   for (Int_t i = 0; i < nbuf; ++i)
+      total += len[i];
+   Int_t nreq = std::min(d_ptr->readvParallel, nbuf);
+   if ((nreq > 1) && (total >= d_ptr->readvMinSize)) {
+      Long64_t ret = d_ptr->readBuffersParallel(buf, pos, len, nbuf, nreq);
+      if (ret >= 0)
+         eventStop(start_time, ret);
+      return ret;
+   }
+
    DavIOVecInput in[nbuf];
    DavIOVecOuput out[nbuf];
 
@@ -65,7 +65,9 @@ private:
       fUrl(mUrl),
       opt(mopt),
       oflags(0),
-      dirdVec() { }
+      dirdVec(),
+      readvParallel(4),
+      readvMinSize(1024 * 1024) { }
 
    TDavixFileInternal(const char* url, Option_t* mopt) :
       positionLock(),
@@ -77,7 +79,9 @@ private:
       fUrl(url),
       opt(mopt),
       oflags(0),
-      dirdVec() { }
+      dirdVec(),
+      readvParallel(4),
+      readvMinSize(1024 * 1024) { }
 
    ~TDavixFileInternal();
 
@@ -118,6 +122,8 @@ private:
 
    void removeDird(void* fd);
 
+   Long64_t readBuffersParallel(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf, Int_t nreq);
+
    std::vector<std::string> getReplicas()
    {
      return replicas;
@@ -137,6 +143,8 @@ private:
    Option_t* opt;
    int oflags;
    std::vector<void*> dirdVec;
+   Int_t readvParallel;   // maximal number of concurrent requests used for a vectored read
+   Long64_t readvMinSize; // minimal size of a vectored read which is split in concurrent requests
 
 public:
    Int_t DavixStat(const char *url, struct stat *st);
@@ -17,6 +17,7 @@
 #include "TString.h"
 
 #include <condition_variable>
+#include <mutex>
 #include <string>
 #include <memory>
 
@@ -48,6 +49,7 @@ protected:
 
    UInt_t fWSId{0};               ///<! websocket identifier, used in web-socket related operations
 
+   std::mutex fMutex;             ///<! mutex protecting notification flag
    std::condition_variable fCond; ///<! condition used to wait for processing
 
    TString fContentType;          ///<! type of content
@@ -69,10 +71,13 @@ private:
 
    std::string  fContent;  ///<! content - text or binary
    std::string  fPostData; ///<! data received with post request - text - or binary
+   std::shared_ptr<const std::string> fZipContent; ///<! content already compressed with gzip, used by CompressWithGzip()
 
    void AssignWSId();
    std::shared_ptr<THttpWSEngine> TakeWSEngine();
 
+   void WaitCondition();
+
 public:
    explicit THttpCallArg() {} // NOLINT: not allowed to use = default because of TObject::kIsOnHeap detection, see ROOT-10300
    virtual ~THttpCallArg();
@@ -201,8 +206,13 @@ public:
    void SetContent(std::string &&cont);
    void ReplaceAllinContent(const std::string &from, const std::string &to, bool once = false);
 
+   /** Set content already compressed with gzip, which will be used when reply has to be compressed */
+   void SetZipContent(std::shared_ptr<const std::string> zipped) { fZipContent = zipped; }
+
    Bool_t CompressWithGzip();
 
+   static Bool_t CompressWithGzip(const std::string &content, std::string &res);
+
    void SetZipping(Int_t mode = kZipLarge) { fZipping = mode; }
    Int_t GetZipping() const { return fZipping; }
 
@@ -39,6 +39,7 @@ protected:
    Bool_t fOwnThread{kFALSE};           ///<! true when specialized thread allocated for processing requests
    std::thread fThrd;                   ///<! own thread
    Bool_t fOldProcessSignature{kFALSE}; ///<! flag used to detect usage of old signature of Process() method
+   Bool_t fMultiThreaded{kFALSE};       ///<! process thread-safe requests directly in threads of engines
 
    TString fJSROOTSYS;       ///<! location of local JSROOT files
    TString fTopName{"ROOT"}; ///<! name of top folder, default - "ROOT"
@@ -66,6 +67,10 @@ protected:
 
    virtual void ProcessRequest(THttpCallArg *arg);
 
+   void ProcessSnifferRequest(std::shared_ptr<THttpCallArg> &arg, Bool_t in_thread);
+
+   Bool_t ProcessInThread(std::shared_ptr<THttpCallArg> &arg);
+
    void StopServerThread();
 
    static Bool_t VerifyFilePath(const char *fname);
@@ -121,6 +126,11 @@ public:
 
    void CreateServerThread();
 
+   void SetMultiThreaded(Bool_t on = kTRUE);
+
+   /** returns kTRUE if thread-safe requests are processed in threads of engines */
+   Bool_t IsMultiThreaded() const { return fMultiThreaded; }
+
    /** Check if file is requested, thread safe */
    Bool_t IsFileRequested(const char *uri, TString &res) const;
 
@@ -14,7 +14,9 @@
 
 #include "TNamed.h"
 #include "TList.h"
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 class TFolder;
@@ -122,12 +124,34 @@ protected:
    Bool_t fReadOnly{kTRUE}; ///<! indicate if sniffer allowed to change ROOT structures - like read objects from file
    Bool_t fScanGlobalDir{kTRUE};       ///<! when enabled (default), scan gROOT for histograms, canvases, open files
    std::unique_ptr<TFolder> fTopFolder; ///<! own top TFolder object, used for registering objects
-   THttpCallArg *fCurrentArg{nullptr}; ///<! current http arguments (if any)
-   Int_t fCurrentRestrict{0};          ///<! current restriction for last-found object
-   TString fCurrentAllowedMethods;     ///<! list of allowed methods, extracted when analyzed object restrictions
+   Bool_t fThreadSafe{kFALSE};         ///<! registered objects can be accessed from several threads at once
    TList fRestrictions;                ///<! list of restrictions for different locations
    TString fAutoLoad;                  ///<! scripts names, which are add as _autoload parameter to h.json request
 
+   /** state of the http request processed by the current thread */
+   struct CallState_t {
+      THttpCallArg *fArg{nullptr}; ///< current http arguments (if any)
+      Int_t fRestrict{0};          ///< current restriction for last-found object
+      TString fAllowedMethods;     ///< list of allowed methods, extracted when analyzed object restrictions
+   };
+
+   static CallState_t &CurrentCall();
+
+   /** response, reused for identical requests */
+   struct CacheEntry_t {
+      TObject *fObj{nullptr};                     ///< object used to produce response (if any)
+      Long64_t fTime{0};                          ///< time when response was produced, ms
+      std::shared_ptr<const std::string> fContent; ///< produced response
+      std::shared_ptr<const std::string> fZipped;  ///< response compressed with gzip, only for large responses
+   };
+
+   Long_t fCacheTTL{0};                          ///<! time in ms while produced responses are reused, 0 - disabled
+   Long_t fCacheMinZip{10000};                   ///<! minimal size of response which is stored compressed
+   std::mutex fCacheMutex;                       ///<! protects cache of responses
+   std::map<std::string, CacheEntry_t> fCache;   ///<! cached responses
+
+   static Long64_t CacheTime();
+
    void ScanObjectMembers(TRootSnifferScanRec &rec, TClass *cl, char *ptr);
 
    virtual void ScanObjectProperties(TRootSnifferScanRec &rec, TObject *obj);
@@ -208,6 +232,15 @@ public:
    /** Returns true when sniffer allowed to scan global directories */
    Bool_t IsScanGlobalDir() const { return fScanGlobalDir; }
 
+   /** When enabled, the registered objects may be accessed from several threads at once,
+     * see THttpServer::SetMultiThreaded() */
+   void SetThreadSafe(Bool_t on = kTRUE) { fThreadSafe = on; }
+
+   /** Returns true when registered objects can be accessed from several threads */
+   Bool_t IsThreadSafe() const { return fThreadSafe; }
+
+   virtual Bool_t IsThreadSafeRequest(const std::string &file) const;
+
    Bool_t RegisterObject(const char *subfolder, TObject *obj);
 
    Bool_t UnregisterObject(TObject *obj);
@@ -242,6 +275,29 @@ public:
 
    Bool_t Produce(const std::string &path, const std::string &file, const std::string &options, std::string &res);
 
+   Bool_t Produce(const std::string &path, const std::string &file, const std::string &options, std::string &res,
+                  std::shared_ptr<const std::string> &zipped);
+
+   void SetCacheTTL(Long_t ms);
+
+   /** Returns time in ms while produced responses are reused, 0 when caching is disabled */
+   Long_t GetCacheTTL() const { return fCacheTTL; }
+
+   /** Set minimal size of response, which is kept in cache also compressed with gzip */
+   void SetCacheMinZip(Long_t sz) { fCacheMinZip = sz; }
+
+   virtual Bool_t IsCachedRequest(const std::string &file) const;
+
+   std::string MakeCacheKey(const std::string &path, const std::string &file, const std::string &options) const;
+
+   Bool_t FindCached(const std::string &key, std::string &res, std::shared_ptr<const std::string> &zipped);
+
+   std::shared_ptr<const std::string> StoreCached(const std::string &key, TObject *obj, const std::string &res);
+
+   void InvalidateCache(TObject *obj = nullptr);
+
+   virtual void RecursiveRemove(TObject *obj);
+
    ClassDef(TRootSniffer, 0) // Sniffer of ROOT objects (basic version)
 };
 
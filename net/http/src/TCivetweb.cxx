@@ -24,6 +24,7 @@
 #include "THttpServer.h"
 #include "THttpWSEngine.h"
 #include "TUrl.h"
+#include "TEnv.h"
 
 
 
@@ -446,7 +447,7 @@ Int_t TCivetweb::ProcessLog(const char *message)
 /// As main argument, http port should be specified like "8090".
 /// Or one can provide combination of ipaddress and portnumber like 127.0.0.1:8090
 /// Extra parameters like in URL string could be specified after '?' mark:
-///    thrds=N   - there N is number of threads used by the civetweb (default is 10)
+///    thrds=N   - there N is number of threads used by the civetweb (default is 10 or HttpServ.Threads from .rootrc)
 ///    top=name  - configure top name, visible in the web browser
 ///    ssl_certificate=filename - SSL certificate, see docs/OpenSSL.md from civetweb
 ///    auth_file=filename  - authentication file name, created with htdigets utility
@@ -469,10 +470,12 @@ Bool_t TCivetweb::Create(const char *args)
    memset(fCallbacks, 0, sizeof(struct mg_callbacks));
    //((struct mg_callbacks *) fCallbacks)->begin_request = begin_request_handler;
    ((struct mg_callbacks *)fCallbacks)->log_message = log_message_handler;
-   TString sport = IsSecured() ? "8480s" : "8080", num_threads = "10", websocket_timeout = "300000";
+   TString sport = IsSecured() ? "8480s" : "8080", num_threads, websocket_timeout = "300000";
    TString auth_file, auth_domain, log_file, ssl_cert, max_age;
    Bool_t use_ws = kTRUE;
 
+   num_threads.Form("%d", gEnv->GetValue("HttpServ.Threads", 10));
+
    // extract arguments
    if (args && (strlen(args) > 0)) {
 
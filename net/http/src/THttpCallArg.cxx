@@ -122,6 +122,7 @@ TString THttpCallArg::CountHeader(const TString &buf, Int_t number) const
 /// Content will be copied by THttpCallArg
 void THttpCallArg::SetContent(const char *cont)
 {
+   fZipContent.reset();
    if (cont)
       fContent = cont;
    else
@@ -134,6 +135,7 @@ void THttpCallArg::SetContent(const char *cont)
 
 void THttpCallArg::SetContent(std::string &&cont)
 {
+   fZipContent.reset();
    fContent = cont;
 }
 
@@ -259,6 +261,7 @@ std::shared_ptr<THttpWSEngine> THttpCallArg::TakeWSEngine()
 
 void THttpCallArg::ReplaceAllinContent(const std::string &from, const std::string &to, bool once)
 {
+   fZipContent.reset();
    std::size_t start_pos = 0;
    while((start_pos = fContent.find(from, start_pos)) != std::string::npos) {
       fContent.replace(start_pos, from.length(), to);
@@ -359,11 +362,31 @@ std::string THttpCallArg::FillHttpHeader(const char *name)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// compress reply data with gzip compression
+/// If content compressed before was provided with SetZipContent(), it is used directly
 
 Bool_t THttpCallArg::CompressWithGzip()
 {
-   char *objbuf = (char *)GetContent();
-   Long_t objlen = GetContentLength();
+   std::string buffer;
+
+   if (fZipContent)
+      buffer = *fZipContent;
+   else
+      CompressWithGzip(fContent, buffer);
+
+   SetContent(std::move(buffer));
+
+   SetEncoding("gzip");
+
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// compress data with gzip compression, result stored in res
+
+Bool_t THttpCallArg::CompressWithGzip(const std::string &content, std::string &res)
+{
+   const char *objbuf = content.data();
+   Long_t objlen = content.length();
 
    unsigned long objcrc = R__crc32(0, NULL, 0);
    objcrc = R__crc32(objcrc, (const unsigned char *)objbuf, objlen);
@@ -395,7 +418,7 @@ Bool_t THttpCallArg::CompressWithGzip()
    memcpy(dummy, bufcur - 6, 6);
 
    // R__memcompress fills first 6 bytes with own header, therefore just overwrite them
-   unsigned long ziplen = R__memcompress(bufcur - 6, objlen + 6, objbuf, objlen);
+   unsigned long ziplen = R__memcompress(bufcur - 6, objlen + 6, (char *)objbuf, objlen);
 
    memcpy(bufcur - 6, dummy, 6);
 
@@ -415,9 +438,7 @@ Bool_t THttpCallArg::CompressWithGzip()
 
    buffer.resize(bufcur - (char *)buffer.data());
 
-   SetContent(std::move(buffer));
-
-   SetEncoding("gzip");
+   res = std::move(buffer);
 
    return kTRUE;
 }
@@ -428,12 +449,24 @@ Bool_t THttpCallArg::CompressWithGzip()
 
 void THttpCallArg::NotifyCondition()
 {
+   std::lock_guard<std::mutex> lk(fMutex);
    if (!fNotifyFlag && !IsPostponed()) {
       fNotifyFlag = kTRUE;
       HttpReplied();
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// wait until NotifyCondition() is called for the request
+/// Returns immediately if it was already called, which may happen from any thread
+/// when the reply was postponed
+
+void THttpCallArg::WaitCondition()
+{
+   std::unique_lock<std::mutex> lk(fMutex);
+   fCond.wait(lk, [this] { return fNotifyFlag; });
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// virtual method to inform object that http request is processed
 /// Normally condition is notified and waiting thread will be awaked
@@ -22,6 +22,7 @@
 #include "RConfigure.h"
 #include "TRegexp.h"
 #include "TObjArray.h"
+#include "ROOT/RMemoryAccounting.hxx"
 
 #include "THttpEngine.h"
 #include "THttpLongPollEngine.h"
@@ -128,6 +129,9 @@ ClassImp(THttpServer);
 ///     cors           - enable CORS header with origin="*"
 ///     cors=domain    - enable CORS header with origin="domain"
 ///     basic_sniffer  - use basic sniffer without support of hist, gpad, graph classes
+///     mt             - process requests for registered objects directly in the threads of http engine,
+///                      objects must not be modified concurrently, see SetMultiThreaded()
+///     cache=ms       - reuse responses for identical requests during specified time, see TRootSniffer::SetCacheTTL()
 ///
 /// For example, create http server, which allows cors headers and disable scan of global lists,
 /// one should provide "http:8080;cors;noglobal" as parameter
@@ -200,6 +204,11 @@ THttpServer::THttpServer(const char *engine) : TNamed("http", "ROOT http server"
             SetCors(opt + 5);
          } else if (strcmp(opt, "cors") == 0) {
             SetCors("*");
+         } else if (strncmp(opt, "cache=", 6) == 0) {
+            GetSniffer()->SetCacheTTL(TString(opt + 6).Atoi());
+         } else if (strcmp(opt, "mt") == 0) {
+            GetSniffer()->SetThreadSafe(kTRUE);
+            SetMultiThreaded(kTRUE);
          } else
             CreateEngine(opt);
       }
@@ -389,6 +398,28 @@ Bool_t THttpServer::CreateEngine(const char *engine)
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable multi-threaded processing of requests
+///
+/// By default all requests are processed in the main ROOT thread by ProcessRequests().
+/// In multi-threaded mode requests, which objects sniffer declares thread-safe
+/// (see TRootSniffer::IsThreadSafeRequest()), are processed directly in the threads of http engine.
+/// Thus heavy requests do not block each other and are not delayed by the timer.
+/// Sniffer should be configured with TRootSniffer::SetThreadSafe() and without scan of global directories,
+/// number of threads of the civetweb engine can be set with "thrds=N" option like "http:8080?thrds=50".
+/// When enabled, also ROOT thread safety is enabled.
+///
+/// All other requests and user methods like MissedRequest() are still processed in main thread.
+/// Reply on long operations can be postponed there with THttpCallArg::SetPostponed() and
+/// completed later from any thread by setting content and calling THttpCallArg::NotifyCondition().
+
+void THttpServer::SetMultiThreaded(Bool_t on)
+{
+   if (on)
+      ROOT::EnableThreadSafety();
+   fMultiThreaded = on;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// create timer which will invoke ProcessRequests() function periodically
 /// Timer is required to perform all actions in main ROOT thread
@@ -567,11 +598,16 @@ Bool_t THttpServer::ExecuteHttp(std::shared_ptr<THttpCallArg> arg)
       return kTRUE;
    }
 
+   if (ProcessInThread(arg))
+      return kTRUE;
+
    // add call arg to the list
-   std::unique_lock<std::mutex> lk(fMutex);
-   fArgs.push(arg);
-   // and now wait until request is processed
-   arg->fCond.wait(lk);
+   {
+      std::lock_guard<std::mutex> lk(fMutex);
+      fArgs.push(arg);
+   }
+   // and now wait until request is processed, reply can be also postponed and done from other thread
+   arg->WaitCondition();
 
    return kTRUE;
 }
@@ -598,12 +634,57 @@ Bool_t THttpServer::SubmitHttp(std::shared_ptr<THttpCallArg> arg, Bool_t can_run
       return kTRUE;
    }
 
+   if (ProcessInThread(arg))
+      return kTRUE;
+
    // add call arg to the list
    std::unique_lock<std::mutex> lk(fMutex);
    fArgs.push(arg);
    return kFALSE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Process request directly in the calling thread, which is normally thread of http engine
+/// Only done in multi-threaded mode for requests which sniffer declares thread-safe,
+/// see SetMultiThreaded(). Returns kTRUE when request was processed
+
+Bool_t THttpServer::ProcessInThread(std::shared_ptr<THttpCallArg> &arg)
+{
+   if (!fMultiThreaded || !fSniffer)
+      return kFALSE;
+
+   TString filename = arg->fFileName;
+   if (filename.EndsWith(".gz"))
+      filename.Resize(filename.Length() - 3);
+
+   if (!fSniffer->IsThreadSafeRequest(filename.Data()))
+      return kFALSE;
+
+   // web socket handler may serve files from its directory
+   if (!arg->fPathName.IsNull()) {
+      TString wsname = arg->fPathName;
+      auto pos = wsname.First('/');
+      if (pos != kNPOS)
+         wsname.Resize(pos);
+      if (FindWS(wsname.Data()))
+         return kFALSE;
+   }
+
+   fSniffer->SetCurrentCallArg(arg.get());
+
+   try {
+      ProcessSnifferRequest(arg, kTRUE);
+   } catch (...) {
+      arg->Set404();
+   }
+
+   fSniffer->SetCurrentCallArg(nullptr);
+
+   arg->NotifyCondition();
+
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Process requests, submitted for execution
 /// Returns number of processed requests
@@ -890,7 +971,17 @@ void THttpServer::ProcessRequest(std::shared_ptr<THttpCallArg> arg)
       }
    }
 
-   filename = arg->fFileName;
+   ProcessSnifferRequest(arg, kFALSE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Process request, which is served by the objects sniffer
+/// Produces objects hierarchy or content of single objects
+/// When called outside of the main thread, MissedRequest() is not invoked
+
+void THttpServer::ProcessSnifferRequest(std::shared_ptr<THttpCallArg> &arg, Bool_t in_thread)
+{
+   TString filename = arg->fFileName;
 
    Bool_t iszip = kFALSE;
    if (filename.EndsWith(".gz")) {
@@ -898,7 +989,27 @@ void THttpServer::ProcessRequest(std::shared_ptr<THttpCallArg> arg)
       iszip = kTRUE;
    }
 
-   if ((filename == "h.xml") || (filename == "get.xml")) {
+   const char *topname = fTopName.Data();
+   if (arg->fTopName.Length() > 0)
+      topname = arg->fTopName.Data();
+
+   std::shared_ptr<const std::string> zipped;
+
+   // objects hierarchy is produced here, therefore cache is used directly
+   std::string cachekey;
+   Bool_t incache = kFALSE;
+   if (((filename == "h.xml") || (filename == "h.json")) && fSniffer->IsCachedRequest(filename.Data())) {
+      cachekey = fSniffer->MakeCacheKey(std::string(topname) + ":" + arg->fPathName.Data(), filename.Data(),
+                                        arg->fQuery.Data());
+      incache = fSniffer->FindCached(cachekey, arg->fContent, zipped);
+   }
+
+   if (incache) {
+      if (filename == "h.xml")
+         arg->SetXml();
+      else
+         arg->SetJson();
+   } else if ((filename == "h.xml") || (filename == "get.xml")) {
 
       Bool_t compact = arg->fQuery.Index("compact") != kNPOS;
 
@@ -913,9 +1024,6 @@ void THttpServer::ProcessRequest(std::shared_ptr<THttpCallArg> arg)
       {
          TRootSnifferStoreXml store(res, compact);
 
-         const char *topname = fTopName.Data();
-         if (arg->fTopName.Length() > 0)
-            topname = arg->fTopName.Data();
          fSniffer->ScanHierarchy(topname, arg->fPathName.Data(), &store, filename == "get.xml");
       }
 
@@ -929,20 +1037,31 @@ void THttpServer::ProcessRequest(std::shared_ptr<THttpCallArg> arg)
    } else if (filename == "h.json") {
       TString res;
       TRootSnifferStoreJson store(res, arg->fQuery.Index("compact") != kNPOS);
-      const char *topname = fTopName.Data();
-      if (arg->fTopName.Length() > 0)
-         topname = arg->fTopName.Data();
       fSniffer->ScanHierarchy(topname, arg->fPathName.Data(), &store);
       arg->SetContent(std::string(res.Data()));
       arg->SetJson();
-   } else if (fSniffer->Produce(arg->fPathName.Data(), filename.Data(), arg->fQuery.Data(), arg->fContent)) {
+   } else if (filename == "memory.json") {
+      // memory usage of the whole process, independent from the path
+      arg->SetContent(ROOT::Experimental::RMemoryAccounting::GetJSON());
+      arg->SetJson();
+   } else if (fSniffer->Produce(arg->fPathName.Data(), filename.Data(), arg->fQuery.Data(), arg->fContent, zipped)) {
       // define content type base on extension
       arg->SetContentType(GetMimeType(filename.Data()));
+   } else if (in_thread) {
+      // user methods are not called outside of the main thread
+      arg->Set404();
    } else {
       // miss request, user may process
       MissedRequest(arg.get());
    }
 
+   if (!cachekey.empty() && !incache)
+      zipped = fSniffer->StoreCached(cachekey, nullptr, arg->fContent);
+
+   // reuse compressed copy of cached response, if reply has to be compressed
+   if (zipped)
+      arg->SetZipContent(zipped);
+
    if (arg->Is404())
       return;
 
@@ -1048,11 +1167,13 @@ Bool_t THttpServer::ExecuteWS(std::shared_ptr<THttpCallArg> &arg, Bool_t externa
       handler = dynamic_cast<THttpWSHandler *>(fSniffer->FindTObjectInHierarchy(arg->fPathName.Data()));
 
    if (external_thrd && (!handler || !handler->AllowMTProcess())) {
-      std::unique_lock<std::mutex> lk(fMutex);
-      fArgs.push(arg);
+      {
+         std::lock_guard<std::mutex> lk(fMutex);
+         fArgs.push(arg);
+      }
       // and now wait until request is processed
       if (wait_process)
-         arg->fCond.wait(lk);
+         arg->WaitCondition();
 
       return kTRUE;
    }
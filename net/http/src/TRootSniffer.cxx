@@ -31,6 +31,7 @@
 #include "ROOT/RMakeUnique.hxx"
 
 #include <stdlib.h>
+#include <chrono>
 #include <vector>
 #include <string.h>
 
@@ -427,6 +428,10 @@ TRootSniffer::TRootSniffer(const char *name, const char *objpath)
 
 TRootSniffer::~TRootSniffer()
 {
+   if (fCacheTTL > 0) {
+      R__LOCKGUARD(gROOTMutex);
+      gROOT->GetListOfCleanups()->Remove(this);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -437,9 +442,37 @@ TRootSniffer::~TRootSniffer()
 
 void TRootSniffer::SetCurrentCallArg(THttpCallArg *arg)
 {
-   fCurrentArg = arg;
-   fCurrentRestrict = 0;
-   fCurrentAllowedMethods = "";
+   auto &call = CurrentCall();
+   call.fArg = arg;
+   call.fRestrict = 0;
+   call.fAllowedMethods = "";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// returns state of the http request processed by the calling thread
+/// Kept per thread, while THttpServer may process several requests in parallel
+
+TRootSniffer::CallState_t &TRootSniffer::CurrentCall()
+{
+   thread_local CallState_t state;
+   return state;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// returns kTRUE if request for specified file can be processed in any thread,
+/// in parallel with other requests and with the main thread of the application
+/// Only requests which stream registered objects or scan objects hierarchy are allowed,
+/// and only when sniffer configured with SetThreadSafe() and without scan of global directories,
+/// which can be modified by the application at any time. Binary requests are excluded,
+/// while they share the streamer infos of the sniffer
+
+Bool_t TRootSniffer::IsThreadSafeRequest(const std::string &file) const
+{
+   if (!fThreadSafe || fScanGlobalDir)
+      return kFALSE;
+
+   return (file == "root.json") || (file == "root.xml") || (file == "item.json") || (file == "item.xml") ||
+          (file == "h.json") || (file == "h.xml") || (file == "get.xml");
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -494,7 +527,7 @@ const char *TRootSniffer::GetAutoLoad() const
 
 Bool_t TRootSniffer::HasRestriction(const char *item_name)
 {
-   if (!item_name || (*item_name == 0) || !fCurrentArg)
+   if (!item_name || (*item_name == 0) || !CurrentCall().fArg)
       return kFALSE;
 
    return fRestrictions.FindObject(item_name) != nullptr;
@@ -507,7 +540,8 @@ Bool_t TRootSniffer::HasRestriction(const char *item_name)
 
 Int_t TRootSniffer::WithCurrentUserName(const char *option)
 {
-   const char *username = fCurrentArg ? fCurrentArg->GetUserName() : nullptr;
+   auto arg = CurrentCall().fArg;
+   const char *username = arg ? arg->GetUserName() : nullptr;
 
    if (!username || !option || (*option == 0))
       return 0;
@@ -590,7 +624,7 @@ Int_t TRootSniffer::CheckRestriction(const char *full_item_name)
 
    const char *methods = url.GetValueFromOptions("allow_method");
    if (methods)
-      fCurrentAllowedMethods = methods;
+      CurrentCall().fAllowedMethods = methods;
 
    if (can_access < 0)
       return 1; // read-only access
@@ -963,8 +997,9 @@ TFolder *TRootSniffer::GetTopFolder(Bool_t force)
 void TRootSniffer::ScanRoot(TRootSnifferScanRec &rec)
 {
    rec.SetField(item_prop_kind, "ROOT.Session");
-   if (fCurrentArg && fCurrentArg->GetUserName())
-      rec.SetField(item_prop_user, fCurrentArg->GetUserName());
+   auto arg = CurrentCall().fArg;
+   if (arg && arg->GetUserName())
+      rec.SetField(item_prop_user, arg->GetUserName());
 
    // should be on the top while //root/http folder could have properties for itself
    TFolder *topf = GetTopFolder();
@@ -1072,7 +1107,7 @@ void *TRootSniffer::FindInHierarchy(const char *path, TClass **cl, TDataMember *
       *chld = store.GetResNumChilds();
 
    // remember current restriction
-   fCurrentRestrict = store.GetResRestrict();
+   CurrentCall().fRestrict = store.GetResRestrict();
 
    return res;
 }
@@ -1148,9 +1183,16 @@ Bool_t TRootSniffer::ProduceJson(const std::string &path, const std::string &opt
    if (!obj_ptr || (!obj_cl && !member))
       return kFALSE;
 
-   // TODO: implement direct storage into std::string
-   TString buf = TBufferJSON::ConvertToJSON(obj_ptr, obj_cl, compact >= 0 ? compact : 0, member ? member->GetName() : nullptr);
-   res = buf.Data();
+   if (member) {
+      TString buf = TBufferJSON::ConvertToJSON(obj_ptr, obj_cl, compact >= 0 ? compact : 0, member->GetName());
+      res = buf.Data();
+   } else {
+      // store JSON directly into the result, avoiding an extra copy of the complete string
+      TBufferJSON json;
+      json.SetCompact(compact >= 0 ? compact : 0);
+      res.clear();
+      json.StoreObject(res, obj_ptr, obj_cl);
+   }
 
    return !res.empty();
 }
@@ -1182,7 +1224,7 @@ Bool_t TRootSniffer::ExecuteCmd(const std::string &path, const std::string &opti
    // if read-only specified for the command, it is not allowed for execution
    if (fRestrictions.GetLast() >= 0) {
       FindInHierarchy(path.c_str()); // one need to call method to check access rights
-      if (fCurrentRestrict == 1) {
+      if (CurrentCall().fRestrict == 1) {
          if (gDebug > 0)
             Info("ExecuteCmd", "Entry %s not allowed for specified user", path.c_str());
          res = "false";
@@ -1331,11 +1373,12 @@ Bool_t TRootSniffer::ProduceExe(const std::string & /*path*/, const std::string
 
 Bool_t TRootSniffer::ProduceMulti(const std::string &path, const std::string &options, std::string &str, Bool_t asjson)
 {
-   if (!fCurrentArg || (fCurrentArg->GetPostDataLength() <= 0) || !fCurrentArg->GetPostData())
+   auto arg = CurrentCall().fArg;
+   if (!arg || (arg->GetPostDataLength() <= 0) || !arg->GetPostData())
       return kFALSE;
 
-   const char *args = (const char *)fCurrentArg->GetPostData();
-   const char *ends = args + fCurrentArg->GetPostDataLength();
+   const char *args = (const char *)arg->GetPostData();
+   const char *ends = args + arg->GetPostDataLength();
 
    TUrl url;
    url.SetOptions(options.c_str());
@@ -1479,9 +1522,48 @@ Bool_t TRootSniffer::ProduceImage(Int_t /*kind*/, const std::string & /*path*/,
 
 Bool_t TRootSniffer::Produce(const std::string &path, const std::string &file, const std::string &options, std::string &res)
 {
+   std::shared_ptr<const std::string> zipped;
+   return Produce(path, file, options, res, zipped);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Produce binary data for specified item
+///
+/// When caching of responses is enabled with SetCacheTTL(), response produced before
+/// for the same request is reused. In such case zipped may be set to the copy of response,
+/// compressed with gzip, which can be delivered to the client without compressing it again.
+
+Bool_t TRootSniffer::Produce(const std::string &path, const std::string &file, const std::string &options,
+                             std::string &res, std::shared_ptr<const std::string> &zipped)
+{
+   zipped.reset();
+
    if (file.empty())
       return kFALSE;
 
+   std::string cachekey;
+   if (IsCachedRequest(file)) {
+      cachekey = MakeCacheKey(path, file, options);
+      if (FindCached(cachekey, res, zipped))
+         return kTRUE;
+   } else if ((fCacheTTL > 0) && ((file.compare(0, 4, "exe.") == 0) || (file == "cmd.json"))) {
+      // executed methods or commands may modify any object
+      InvalidateCache();
+   }
+
+   if (!cachekey.empty()) {
+      Bool_t res_ok = kFALSE;
+      if (file == "root.bin")
+         res_ok = ProduceBinary(path, options, res);
+      else if (file == "root.xml")
+         res_ok = ProduceXml(path, options, res);
+      else if (file == "root.json")
+         res_ok = ProduceJson(path, options, res);
+      if (res_ok)
+         zipped = StoreCached(cachekey, FindTObjectInHierarchy(path.c_str()), res);
+      return res_ok;
+   }
+
    if (file == "root.bin")
       return ProduceBinary(path, options, res);
 
@@ -1528,6 +1610,171 @@ Bool_t TRootSniffer::Produce(const std::string &path, const std::string &file, c
    return kFALSE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable caching of produced responses
+///
+/// Responses for root.json, root.xml, root.bin, h.json and h.xml requests are kept
+/// for specified time (in milliseconds) and reused for identical requests,
+/// so that many clients polling same objects cost about the same as one client.
+/// Large responses are also stored compressed with gzip, see SetCacheMinZip().
+/// Since ROOT objects do not provide modification counters, cached response for the
+/// object can be discarded before expiration with InvalidateCache(obj).
+/// Responses for deleted or unregistered objects are discarded automatically,
+/// execution of object methods or commands discards all responses.
+/// 0 disables caching (default)
+
+void TRootSniffer::SetCacheTTL(Long_t ms)
+{
+   if (ms < 0)
+      ms = 0;
+
+   if ((ms > 0) != (fCacheTTL > 0)) {
+      R__LOCKGUARD(gROOTMutex);
+      if (ms > 0)
+         gROOT->GetListOfCleanups()->Add(this);
+      else
+         gROOT->GetListOfCleanups()->Remove(this);
+   }
+
+   fCacheTTL = ms;
+
+   if (ms == 0)
+      InvalidateCache();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns current time in ms, used to check expiration of cached responses
+
+Long64_t TRootSniffer::CacheTime()
+{
+   return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns kTRUE if response for specified file can be taken from the cache
+
+Bool_t TRootSniffer::IsCachedRequest(const std::string &file) const
+{
+   if (fCacheTTL <= 0)
+      return kFALSE;
+
+   return (file == "root.json") || (file == "root.xml") || (file == "root.bin") || (file == "h.json") ||
+          (file == "h.xml");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Produce key of the cache entry for specified request
+/// Includes name of the current user, while restrictions may change produced response
+
+std::string TRootSniffer::MakeCacheKey(const std::string &path, const std::string &file, const std::string &options) const
+{
+   std::string key;
+   auto arg = CurrentCall().fArg;
+   if (arg && arg->GetUserName())
+      key = arg->GetUserName();
+   key.append("\n");
+   key.append(path);
+   key.append("/");
+   key.append(file);
+   key.append("?");
+   key.append(options);
+   return key;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Search response in the cache
+/// Returns kTRUE if not expired response is found, zipped set to its compressed copy (if any)
+
+Bool_t TRootSniffer::FindCached(const std::string &key, std::string &res, std::shared_ptr<const std::string> &zipped)
+{
+   std::lock_guard<std::mutex> grd(fCacheMutex);
+
+   auto iter = fCache.find(key);
+   if (iter == fCache.end())
+      return kFALSE;
+
+   if (CacheTime() - iter->second.fTime > fCacheTTL) {
+      fCache.erase(iter);
+      return kFALSE;
+   }
+
+   res = *iter->second.fContent;
+   zipped = iter->second.fZipped;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store response in the cache, obj is the object used to produce the response (if any)
+/// Large responses are compressed with gzip, compressed copy is returned
+
+std::shared_ptr<const std::string> TRootSniffer::StoreCached(const std::string &key, TObject *obj, const std::string &res)
+{
+   std::shared_ptr<const std::string> zipped;
+
+   if (fCacheTTL <= 0)
+      return zipped;
+
+   if ((fCacheMinZip > 0) && ((Long_t)res.length() >= fCacheMinZip)) {
+      std::string buf;
+      if (THttpCallArg::CompressWithGzip(res, buf))
+         zipped = std::make_shared<const std::string>(std::move(buf));
+   }
+
+   auto now = CacheTime();
+
+   std::lock_guard<std::mutex> grd(fCacheMutex);
+
+   // remove expired entries, while keys with different options can accumulate
+   if (fCache.size() >= 100) {
+      for (auto iter = fCache.begin(); iter != fCache.end();) {
+         if (now - iter->second.fTime > fCacheTTL)
+            iter = fCache.erase(iter);
+         else
+            iter++;
+      }
+   }
+
+   auto &entry = fCache[key];
+   entry.fObj = obj;
+   entry.fTime = now;
+   entry.fContent = std::make_shared<const std::string>(res);
+   entry.fZipped = zipped;
+
+   return zipped;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Discard cached responses produced for specified object
+/// Should be called when object is modified and clients should get new content before
+/// expiration of cached response. Without argument all cached responses are discarded.
+/// Responses for objects hierarchy (h.json, h.xml) are discarded with any object
+
+void TRootSniffer::InvalidateCache(TObject *obj)
+{
+   std::lock_guard<std::mutex> grd(fCacheMutex);
+
+   if (!obj) {
+      fCache.clear();
+      return;
+   }
+
+   for (auto iter = fCache.begin(); iter != fCache.end();) {
+      if (!iter->second.fObj || (iter->second.fObj == obj))
+         iter = fCache.erase(iter);
+      else
+         iter++;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Discard cached responses for deleted object
+
+void TRootSniffer::RecursiveRemove(TObject *obj)
+{
+   if (fCacheTTL > 0)
+      InvalidateCache(obj);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// return item from the subfolders structure
 
@@ -1643,6 +1890,9 @@ Bool_t TRootSniffer::UnregisterObject(TObject *obj)
    // TODO - probably we should remove all set properties as well
    topf->RecursiveRemove(obj);
 
+   if (fCacheTTL > 0)
+      InvalidateCache(obj);
+
    return kTRUE;
 }
 
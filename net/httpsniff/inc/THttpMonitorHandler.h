@@ -0,0 +1,91 @@
+// $Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_THttpMonitorHandler
+#define ROOT_THttpMonitorHandler
+
+#include "THttpWSHandler.h"
+#include "Compression.h"
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+class TH1;
+class TTimer;
+class TRootSniffer;
+
+class THttpMonitorHandler : public THttpWSHandler {
+public:
+   enum EFlags {
+      kSumw2 = BIT(0),  ///< record contains sum of squares of weights of the changed bins
+      kReset = BIT(1),  ///< record contains all bins, sent after subscription or change of binning
+      kMissing = BIT(2) ///< subscribed item not found or not a histogram
+   };
+
+protected:
+   struct Subscription_t {
+      UInt_t fId{0};                  ///< identifier, assigned by the client
+      std::string fPath;              ///< item name in the objects hierarchy
+      TH1 *fHist{nullptr};            ///< monitored histogram
+      Bool_t fReset{kTRUE};           ///< all bins must be sent with next update
+      Bool_t fMissingSent{kFALSE};    ///< client was informed that item is missing
+      std::vector<Double_t> fAxes;    ///< number of bins and ranges of the axes, sent last time
+      std::vector<Double_t> fStats;   ///< entries and statistics, sent last time
+      std::vector<Double_t> fContent; ///< bins content, sent last time
+      std::vector<Double_t> fSumw2;   ///< sum of squares of weights, sent last time
+   };
+
+   TRootSniffer *fSniffer{nullptr}; ///<! sniffer used to find subscribed items
+   TTimer *fTimer{nullptr};         ///<! timer used to send updates
+   Int_t fCompression{ROOT::RCompressionSetting::EDefaults::kUseGeneralPurpose}; ///<! compression of updates
+   Int_t fMinZipSize{512};          ///<! minimal size of the update which is compressed
+   std::map<UInt_t, std::vector<Subscription_t>> fClients; ///<! subscriptions of each websocket connection
+   std::mutex fPendingMutex;        ///<! protects list of connections with pending send operations
+   std::set<UInt_t> fPending;       ///<! connections, which did not complete sending of previous update
+
+   virtual void CompleteWSSend(UInt_t wsid);
+
+   void ProcessCommand(UInt_t wsid, const std::string &cmd);
+
+   Bool_t FillUpdate(Subscription_t &sub, std::string &buf);
+
+public:
+   THttpMonitorHandler(const char *name, const char *title, TRootSniffer *sniffer, Long_t period = 1000);
+   virtual ~THttpMonitorHandler();
+
+   /// Send operations are performed in separate threads, not blocking the application
+   virtual Bool_t AllowMTSend() const { return kTRUE; }
+
+   virtual Bool_t ProcessWS(THttpCallArg *arg);
+
+   virtual Bool_t HandleTimer(TTimer *timer);
+
+   virtual void RecursiveRemove(TObject *obj);
+
+   void SetUpdatePeriod(Long_t period);
+
+   /// Set compression of updates in the same format as TFile::SetCompressionSettings(), 0 disables compression
+   void SetCompression(Int_t settings) { fCompression = settings; }
+
+   /// Returns compression of updates
+   Int_t GetCompression() const { return fCompression; }
+
+   /// Set minimal size of the update which is compressed
+   void SetMinZipSize(Int_t sz) { fMinZipSize = sz; }
+
+   Int_t Update();
+
+   ClassDef(THttpMonitorHandler, 0) // websocket handler sending changes of monitored histograms
+};
+
+#endif
@@ -0,0 +1,395 @@
+// $Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "THttpMonitorHandler.h"
+
+#include "TH1.h"
+#include "TTimer.h"
+#include "TROOT.h"
+#include "TString.h"
+#include "TVirtualMutex.h"
+#include "TRootSniffer.h"
+#include "THttpCallArg.h"
+#include "RZip.h"
+
+#include <cstring>
+#include <cstdlib>
+
+/////////////////////////////////////////////////////////////////////////
+///
+/// THttpMonitorHandler
+///
+/// Websocket handler, which sends to subscribed clients only changes of
+/// monitored histograms instead of complete objects. Changes are tracked
+/// for each connection separately, comparing histograms with the content
+/// which was sent last time. Updates are sent periodically in binary form
+/// and compressed with ROOT compression algorithms (zstd by default).
+///
+///        auto serv = new THttpServer("http:8080");
+///        auto monitor = new THttpMonitorHandler("monitor", "histograms monitoring", serv->GetSniffer());
+///        serv->Register("/", monitor);
+///
+/// Client connects to "ws://host:8080/monitor/root.websocket" and sends text commands:
+///
+///     SUBSCRIBE:id:itemname   - monitor histogram with item name like "Objects/hpx",
+///                               id is arbitrary number used to identify updates
+///     UNSUBSCRIBE:id          - stop monitoring
+///     RESET:id                - request all bins with next update
+///
+/// Full object (with axes, title and so on) should be requested as usual with "itemname/root.json".
+/// Each update is sent as text header "DELTA:nrecords:length" followed by binary data of
+/// specified length, which contains one record per changed histogram. When header is
+/// "DELTAZ:nrecords:length", data is compressed in ROOT format and must be unzipped first.
+/// Record consists of (all numbers in little-endian order, records aligned to 8 bytes,
+/// so that data can be accessed with typed arrays):
+///
+///     uint32 id, uint32 flags, uint32 nstats, uint32 nbins
+///     float64 stats[nstats]  - entries and statistics as returned by TH1::GetStats()
+///     float64 content[nbins] - new content of changed bins
+///     float64 sumw2[nbins]   - new sum of squares of weights, only with kSumw2 flag
+///     uint32 bins[nbins]     - global indexes of changed bins, not sent with kReset flag
+///     uint32 padding         - only when nbins is odd and indexes are sent
+///
+/// kReset flag indicates that all bins are sent, which is the case for the first update after
+/// subscription or when the binning of the histogram was changed - then client should request the
+/// full object again. kMissing flag indicates that item does not exist or is not a histogram.
+/// No update is sent to a connection until previous one is completely sent, thus slow clients
+/// get larger updates less often.
+///
+///////////////////////////////////////////////////////////////////////////
+
+ClassImp(THttpMonitorHandler);
+
+////////////////////////////////////////////////////////////////////////////////
+/// constructor
+/// Sniffer is used to find subscribed items, updates are sent every period milliseconds.
+/// If period is 0, Update() should be called by application
+
+THttpMonitorHandler::THttpMonitorHandler(const char *name, const char *title, TRootSniffer *sniffer, Long_t period)
+   : THttpWSHandler(name, title, kFALSE), fSniffer(sniffer)
+{
+   {
+      R__LOCKGUARD(gROOTMutex);
+      gROOT->GetListOfCleanups()->Add(this);
+   }
+
+   SetUpdatePeriod(period);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// destructor
+
+THttpMonitorHandler::~THttpMonitorHandler()
+{
+   delete fTimer;
+
+   R__LOCKGUARD(gROOTMutex);
+   gROOT->GetListOfCleanups()->Remove(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Configure period of updates in milliseconds
+/// Updates are sent from main thread during gSystem->ProcessEvents() calls.
+/// If period is 0, Update() should be called by application
+
+void THttpMonitorHandler::SetUpdatePeriod(Long_t period)
+{
+   delete fTimer;
+   fTimer = nullptr;
+
+   if (period > 0) {
+      fTimer = new TTimer(this, period, kTRUE);
+      fTimer->TurnOn();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// timeout handler, sends updates
+
+Bool_t THttpMonitorHandler::HandleTimer(TTimer *)
+{
+   Update();
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove deleted histogram from all subscriptions
+
+void THttpMonitorHandler::RecursiveRemove(TObject *obj)
+{
+   for (auto &client : fClients)
+      for (auto &sub : client.second)
+         if (sub.fHist == obj) {
+            sub.fHist = nullptr;
+            sub.fMissingSent = kFALSE;
+         }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Method called when send operation to the connection is completed, can be called from any thread
+
+void THttpMonitorHandler::CompleteWSSend(UInt_t wsid)
+{
+   std::lock_guard<std::mutex> grd(fPendingMutex);
+   fPending.erase(wsid);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Process websocket requests, always called from main thread
+
+Bool_t THttpMonitorHandler::ProcessWS(THttpCallArg *arg)
+{
+   if (!arg || IsDisabled())
+      return kFALSE;
+
+   UInt_t wsid = arg->GetWSId();
+
+   if (arg->IsMethod("WS_CONNECT"))
+      return kTRUE;
+
+   if (arg->IsMethod("WS_READY")) {
+      fClients[wsid].clear();
+      return kTRUE;
+   }
+
+   if (arg->IsMethod("WS_CLOSE")) {
+      fClients.erase(wsid);
+      std::lock_guard<std::mutex> grd(fPendingMutex);
+      fPending.erase(wsid);
+      return kTRUE;
+   }
+
+   if (arg->IsMethod("WS_DATA")) {
+      std::string cmd((const char *)arg->GetPostData(), arg->GetPostDataLength());
+      ProcessCommand(wsid, cmd);
+      return kTRUE;
+   }
+
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Process command, received from the client
+
+void THttpMonitorHandler::ProcessCommand(UInt_t wsid, const std::string &cmd)
+{
+   auto iter = fClients.find(wsid);
+   if (iter == fClients.end())
+      return;
+
+   auto &subs = iter->second;
+
+   auto separ = cmd.find(':');
+   if (separ == std::string::npos)
+      return;
+
+   std::string kind = cmd.substr(0, separ), args = cmd.substr(separ + 1);
+
+   char *endp = nullptr;
+   UInt_t id = (UInt_t)std::strtoul(args.c_str(), &endp, 10);
+   if (endp == args.c_str())
+      return;
+
+   auto find = [&subs, id]() {
+      for (auto it = subs.begin(); it != subs.end(); ++it)
+         if (it->fId == id)
+            return it;
+      return subs.end();
+   };
+
+   auto sub = find();
+
+   if (kind == "SUBSCRIBE") {
+      if (*endp != ':')
+         return;
+      if (sub == subs.end()) {
+         subs.emplace_back();
+         sub = subs.end() - 1;
+         sub->fId = id;
+      }
+      sub->fPath = endp + 1;
+      sub->fHist = fSniffer ? dynamic_cast<TH1 *>(fSniffer->FindTObjectInHierarchy(sub->fPath.c_str())) : nullptr;
+      // bins content of profiles has different meaning, not supported
+      if (sub->fHist && TString(sub->fHist->ClassName()).BeginsWith("TProfile"))
+         sub->fHist = nullptr;
+      if (sub->fHist)
+         sub->fHist->SetBit(kMustCleanup);
+      sub->fReset = kTRUE;
+      sub->fMissingSent = kFALSE;
+   } else if (kind == "UNSUBSCRIBE") {
+      if (sub != subs.end())
+         subs.erase(sub);
+   } else if (kind == "RESET") {
+      if (sub != subs.end())
+         sub->fReset = kTRUE;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append record with changes of the subscribed histogram to the buffer
+/// Returns kTRUE if record was added
+
+Bool_t THttpMonitorHandler::FillUpdate(Subscription_t &sub, std::string &buf)
+{
+   auto append = [&buf](const void *data, std::size_t len) { buf.append((const char *)data, len); };
+
+   UInt_t header[4] = {sub.fId, 0, 0, 0};
+
+   TH1 *h = sub.fHist;
+   if (!h) {
+      if (sub.fMissingSent)
+         return kFALSE;
+      sub.fMissingSent = kTRUE;
+      sub.fReset = kTRUE;
+      header[1] = kMissing;
+      append(header, sizeof(header));
+      return kTRUE;
+   }
+
+   std::vector<Double_t> axes;
+   for (const TAxis *axis : {h->GetXaxis(), h->GetYaxis(), h->GetZaxis()}) {
+      axes.push_back(axis->GetNbins());
+      axes.push_back(axis->GetXmin());
+      axes.push_back(axis->GetXmax());
+   }
+
+   std::vector<Double_t> stats(1 + TH1::kNstat, 0.);
+   stats[0] = h->GetEntries();
+   h->GetStats(stats.data() + 1);
+
+   Int_t ncells = h->GetNcells();
+   const Double_t *sumw2 = (h->GetSumw2N() == ncells) ? h->GetSumw2()->GetArray() : nullptr;
+
+   Bool_t reset = sub.fReset || (axes != sub.fAxes) || ((Int_t)sub.fContent.size() != ncells) ||
+                  ((sumw2 != nullptr) != !sub.fSumw2.empty());
+
+   std::vector<UInt_t> bins;
+   std::vector<Double_t> content, errors;
+
+   if (reset) {
+      sub.fAxes = axes;
+      sub.fContent.resize(ncells);
+      sub.fSumw2.resize(sumw2 ? ncells : 0);
+      for (Int_t n = 0; n < ncells; ++n)
+         sub.fContent[n] = h->GetBinContent(n);
+      if (sumw2)
+         std::copy(sumw2, sumw2 + ncells, sub.fSumw2.begin());
+   } else {
+      for (Int_t n = 0; n < ncells; ++n) {
+         Double_t value = h->GetBinContent(n);
+         if ((value != sub.fContent[n]) || (sumw2 && (sumw2[n] != sub.fSumw2[n]))) {
+            sub.fContent[n] = value;
+            bins.push_back(n);
+            content.push_back(value);
+            if (sumw2) {
+               sub.fSumw2[n] = sumw2[n];
+               errors.push_back(sumw2[n]);
+            }
+         }
+      }
+      if (bins.empty() && (stats == sub.fStats))
+         return kFALSE;
+   }
+
+   sub.fStats = stats;
+   sub.fReset = kFALSE;
+
+   header[1] = (reset ? kReset : 0) | (sumw2 ? kSumw2 : 0);
+   header[2] = stats.size();
+   header[3] = reset ? ncells : bins.size();
+
+   append(header, sizeof(header));
+   append(stats.data(), stats.size() * sizeof(Double_t));
+   if (reset) {
+      append(sub.fContent.data(), sub.fContent.size() * sizeof(Double_t));
+      append(sub.fSumw2.data(), sub.fSumw2.size() * sizeof(Double_t));
+   } else {
+      append(content.data(), content.size() * sizeof(Double_t));
+      append(errors.data(), errors.size() * sizeof(Double_t));
+      append(bins.data(), bins.size() * sizeof(UInt_t));
+      if (bins.size() % 2) {
+         UInt_t padding = 0;
+         append(&padding, sizeof(padding));
+      }
+   }
+
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Send changes of subscribed histograms to all connections
+/// Connections, which still send previous update, are skipped
+/// Must be called from main thread, returns number of sent updates
+
+Int_t THttpMonitorHandler::Update()
+{
+   if (IsDisabled())
+      return 0;
+
+   Int_t nsend = 0;
+
+   std::string buf, zipbuf;
+
+   for (auto &client : fClients) {
+      UInt_t wsid = client.first;
+
+      {
+         std::lock_guard<std::mutex> grd(fPendingMutex);
+         if (fPending.count(wsid))
+            continue;
+      }
+
+      buf.clear();
+      Int_t nrecords = 0;
+      for (auto &sub : client.second)
+         if (FillUpdate(sub, buf))
+            nrecords++;
+
+      if (nrecords == 0)
+         continue;
+
+      const char *kind = "DELTA";
+      const char *data = buf.data();
+      Int_t len = buf.length();
+
+      Int_t cxlevel = fCompression % 100;
+      if ((cxlevel > 0) && (len >= fMinZipSize)) {
+         auto algorithm = static_cast<ROOT::RCompressionSetting::EAlgorithm::EValues>(fCompression / 100);
+         Int_t nblocks = 1 + (len - 1) / kMAXZIPBUF;
+         zipbuf.resize(len + 9 * nblocks);
+         Int_t ziplen = R__zipMultipleAlgorithmBlocks(cxlevel, len, (char *)buf.data(), zipbuf.length(),
+                                                      (char *)zipbuf.data(), algorithm);
+         // when data cannot be compressed, it is sent as is
+         if (ziplen > 0) {
+            kind = "DELTAZ";
+            data = zipbuf.data();
+            len = ziplen;
+         }
+      }
+
+      {
+         std::lock_guard<std::mutex> grd(fPendingMutex);
+         fPending.insert(wsid);
+      }
+
+      // 0 - sent immediately, 1 - will be sent in other thread, -1 - error
+      Int_t res = SendHeaderWS(wsid, TString::Format("%s:%d:%d", kind, nrecords, (int)buf.length()).Data(), data, len);
+
+      if (res <= 0) {
+         std::lock_guard<std::mutex> grd(fPendingMutex);
+         fPending.erase(wsid);
+      }
+
+      if (res >= 0)
+         nsend++;
+   }
+
+   return nsend;
+}
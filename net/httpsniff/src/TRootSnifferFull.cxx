@@ -294,8 +294,8 @@ Bool_t TRootSnifferFull::ProduceBinary(const std::string &path, const std::strin
    sbuf->SetParent(fMemFile);
    sbuf->MapObject(obj);
    obj->Streamer(*sbuf);
-   if (fCurrentArg)
-      fCurrentArg->SetExtraHeader("RootClassName", obj_cl->GetName());
+   if (CurrentCall().fArg)
+      CurrentCall().fArg->SetExtraHeader("RootClassName", obj_cl->GetName());
 
    // produce actual version of streamer info
    delete fSinfo;
@@ -522,12 +522,12 @@ Bool_t TRootSnifferFull::ProduceExe(const std::string &path, const std::string &
       return debug != nullptr;
    }
 
-   if ((fReadOnly && (fCurrentRestrict == 0)) || (fCurrentRestrict == 1)) {
-      if ((method != nullptr) && (fCurrentAllowedMethods.Index(method_name) == kNPOS)) {
+   if ((fReadOnly && (CurrentCall().fRestrict == 0)) || (CurrentCall().fRestrict == 1)) {
+      if ((method != nullptr) && (CurrentCall().fAllowedMethods.Index(method_name) == kNPOS)) {
          if (debug)
             debug->append("Server runs in read-only mode, method cannot be executed\n");
          return debug != nullptr;
-      } else if ((func != nullptr) && (fCurrentAllowedMethods.Index(funcname) == kNPOS)) {
+      } else if ((func != nullptr) && (CurrentCall().fAllowedMethods.Index(funcname) == kNPOS)) {
          if (debug)
             debug->append("Server runs in read-only mode, function cannot be executed\n");
          return debug != nullptr;
@@ -570,11 +570,11 @@ Bool_t TRootSnifferFull::ProduceExe(const std::string &path, const std::string &
          // special case - object itself is used as argument
          sval.Form("(%s*)0x%lx", obj_cl->GetName(), (long unsigned)obj_ptr);
          val = sval.Data();
-      } else if ((val != nullptr) && (fCurrentArg != nullptr) && (fCurrentArg->GetPostData() != nullptr)) {
+      } else if ((val != nullptr) && (CurrentCall().fArg != nullptr) && (CurrentCall().fArg->GetPostData() != nullptr)) {
          // process several arguments which are specific for post requests
          if (strcmp(val, "_post_object_xml_") == 0) {
             // post data has extra 0 at the end and can be used as null-terminated string
-            post_obj = TBufferXML::ConvertFromXML((const char *)fCurrentArg->GetPostData());
+            post_obj = TBufferXML::ConvertFromXML((const char *)CurrentCall().fArg->GetPostData());
             if (!post_obj) {
                sval = "0";
             } else {
@@ -585,7 +585,7 @@ Bool_t TRootSnifferFull::ProduceExe(const std::string &path, const std::string &
             val = sval.Data();
          } else if (strcmp(val, "_post_object_json_") == 0) {
             // post data has extra 0 at the end and can be used as null-terminated string
-            post_obj = TBufferJSON::ConvertFromJSON((const char *)fCurrentArg->GetPostData());
+            post_obj = TBufferJSON::ConvertFromJSON((const char *)CurrentCall().fArg->GetPostData());
             if (!post_obj) {
                sval = "0";
             } else {
@@ -605,7 +605,7 @@ Bool_t TRootSnifferFull::ProduceExe(const std::string &path, const std::string &
                } else {
                   if (debug)
                      debug->append(TString::Format("Reconstruct object of class %s from POST data\n", clname.Data()).Data());
-                  TBufferFile buf(TBuffer::kRead, fCurrentArg->GetPostDataLength(), (void *)fCurrentArg->GetPostData(), kFALSE);
+                  TBufferFile buf(TBuffer::kRead, CurrentCall().fArg->GetPostDataLength(), (void *)CurrentCall().fArg->GetPostData(), kFALSE);
                   buf.MapObject(post_obj, arg_cl);
                   post_obj->Streamer(buf);
                   if (url.HasOption("_destroy_post_"))
@@ -615,10 +615,10 @@ Bool_t TRootSnifferFull::ProduceExe(const std::string &path, const std::string &
             sval.Form("(%s*)0x%lx", clname.Data(), (long unsigned)post_obj);
             val = sval.Data();
          } else if (strcmp(val, "_post_data_") == 0) {
-            sval.Form("(void*)0x%lx", (long unsigned)fCurrentArg->GetPostData());
+            sval.Form("(void*)0x%lx", (long unsigned)CurrentCall().fArg->GetPostData());
             val = sval.Data();
          } else if (strcmp(val, "_post_length_") == 0) {
-            sval.Form("%ld", (long)fCurrentArg->GetPostDataLength());
+            sval.Form("%ld", (long)CurrentCall().fArg->GetPostDataLength());
             val = sval.Data();
          }
       }
@@ -772,8 +772,8 @@ Bool_t TRootSnifferFull::ProduceExe(const std::string &path, const std::string &
          TObject *obj = (TObject *)ret_obj;
          resbuf->MapObject(obj);
          obj->Streamer(*resbuf);
-         if (fCurrentArg)
-            fCurrentArg->SetExtraHeader("RootClassName", ret_cl->GetName());
+         if (CurrentCall().fArg)
+            CurrentCall().fArg->SetExtraHeader("RootClassName", ret_cl->GetName());
       } else {
          res = TBufferJSON::ConvertToJSON(ret_obj, ret_cl, compact);
       }
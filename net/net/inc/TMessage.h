@@ -47,6 +47,8 @@ private:
    char    *fBufComp{nullptr};    // Compressed buffer
    char    *fBufCompCur{nullptr}; // Current position in compressed buffer
    char    *fCompPos{nullptr};    // Position of fBufCur when message was compressed
+   Int_t    fBufCompSize{0};      // Allocated size of the compressed buffer
+   Int_t    fBufCapacity{0};      // Allocated size of fBuffer while reading, kept when the message is reused
    Bool_t   fEvolution{kFALSE};   // True if support for schema evolution required
 
    static Bool_t fgEvolution;  //True if global support for schema evolution required
@@ -58,9 +60,14 @@ private:
    // used by friend TSocket
    Bool_t TestBitNumber(UInt_t bitnumber) const { return fBitsPIDs.TestBitNumber(bitnumber); }
 
+   void   DeleteCompBuffer();
+   void   ReadMessageHeader();
+
 protected:
    TMessage(void *buf, Int_t bufsize);   // only called by T(P)Socket::Recv()
    void SetLength() const;               // only called by T(P)Socket::Send()
+   char *PrepareRecv(Int_t bufsize, Bool_t compressed); // only called by TSocket::Recv(TMessage &)
+   void  InitRecv(Int_t bufsize, Bool_t compressed);    // only called by TSocket::Recv(TMessage &)
 
 public:
    TMessage(UInt_t what = kMESS_ANY, Int_t bufsiz = TBuffer::kInitialSize);
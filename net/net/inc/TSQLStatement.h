@@ -76,6 +76,7 @@ public:
    virtual const char *GetFieldName(Int_t) = 0;
    virtual Bool_t      SetMaxFieldSize(Int_t, Long_t) { return kFALSE; }
    virtual Bool_t      NextResultRow() = 0;
+   virtual Int_t       NextResultRows(Int_t maxrows, const char *types, void **buffers, Bool_t **nulls = nullptr);
 
    virtual Bool_t      IsNull(Int_t) { return kTRUE; }
    virtual Int_t       GetInt(Int_t) { return 0; }
@@ -71,6 +71,7 @@ public:
    Int_t Send(Int_t kind)                                  { return TSocket::Send(kind); }
    Int_t Send(Int_t status, Int_t kind)                    { return TSocket::Send(status, kind); }
    Int_t Send(const char *mess, Int_t kind = kMESS_STRING) { return TSocket::Send(mess, kind); }
+   Int_t Recv(TMessage &mess)                              { return TSocket::Recv(mess); }
    Int_t Recv(Int_t &status, Int_t &kind)                  { return TSocket::Recv(status, kind); }
    Int_t Recv(char *mess, Int_t max)                       { return TSocket::Recv(mess, max); }
    Int_t Recv(char *mess, Int_t max, Int_t &kind)          { return TSocket::Recv(mess, max, kind); }
@@ -88,9 +88,9 @@ protected:
    Bool_t       Authenticate(const char *user);
    void         SetDescriptor(Int_t desc) { fSocket = desc; }
    void         SendStreamerInfos(const TMessage &mess);
-   Bool_t       RecvStreamerInfos(TMessage *mess);
+   Bool_t       RecvStreamerInfos(TMessage *mess, Bool_t del = kTRUE);
    void         SendProcessIDs(const TMessage &mess);
-   Bool_t       RecvProcessIDs(TMessage *mess);
+   Bool_t       RecvProcessIDs(TMessage *mess, Bool_t del = kTRUE);
    void         MarkBrokenConnection();
 
 private:
@@ -131,6 +131,7 @@ public:
    virtual Bool_t        IsAuthenticated() const { return fSecContext ? kTRUE : kFALSE; }
    virtual Bool_t        IsValid() const { return fSocket < 0 ? kFALSE : kTRUE; }
    virtual Int_t         Recv(TMessage *&mess);
+   Int_t                 Recv(TMessage &mess);
    virtual Int_t         Recv(Int_t &status, Int_t &kind);
    virtual Int_t         Recv(char *mess, Int_t max);
    virtual Int_t         Recv(char *mess, Int_t max, Int_t &kind);
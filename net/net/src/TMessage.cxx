@@ -84,12 +84,22 @@ TMessage::TMessage(void *buf, Int_t bufsize) : TBufferFile(TBuffer::kRead, bufsi
 
    if (fWhat & kMESS_ZIP) {
       // if buffer has kMESS_ZIP set, move it to fBufComp and uncompress
-      fBufComp    = fBuffer;
-      fBufCompCur = fBuffer + bufsize;
-      fBuffer     = nullptr;
+      fBufComp     = fBuffer;
+      fBufCompCur  = fBuffer + bufsize;
+      fBufCompSize = bufsize;
+      fBuffer      = nullptr;
       Uncompress();
    }
 
+   ReadMessageHeader();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the class of the object stored in a kMESS_OBJECT message,
+/// the message type must be already known.
+
+void TMessage::ReadMessageHeader()
+{
    if (fWhat == kMESS_OBJECT) {
       InitMap();
       fClass = ReadClass();     // get first the class stored in message
@@ -100,6 +110,88 @@ TMessage::TMessage(void *buf, Int_t bufsize) : TBufferFile(TBuffer::kRead, bufsi
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the compressed buffer, if any.
+
+void TMessage::DeleteCompBuffer()
+{
+   delete [] fBufComp;
+   fBufComp     = nullptr;
+   fBufCompCur  = nullptr;
+   fCompPos     = nullptr;
+   fBufCompSize = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the buffer where a message of bufsize bytes, including the length
+/// header, has to be received. A compressed message is received in the
+/// compressed buffer, any other one directly in the message buffer. The
+/// buffers of the message are reused and only reallocated when too small,
+/// so a message used for a sequence of TSocket::Recv(TMessage &) calls does
+/// not allocate memory once it has reached the size of the largest message.
+/// This method is only called by TSocket::Recv(TMessage &).
+
+char *TMessage::PrepareRecv(Int_t bufsize, Bool_t compressed)
+{
+   // the allocated size of the message buffer is only tracked while reading
+   if (IsWriting())
+      fBufCapacity = (fBuffer && TestBit(kIsOwner)) ? fBufSize : 0;
+
+   if (compressed) {
+      if (fBufCompSize < bufsize) {
+         DeleteCompBuffer();
+         fBufComp     = new char[bufsize];
+         fBufCompSize = bufsize;
+      }
+      return fBufComp;
+   }
+
+   if (!fBuffer || !TestBit(kIsOwner) || fBufCapacity < bufsize) {
+      if (TestBit(kIsOwner))
+         delete [] fBuffer;
+      fBuffer      = new char[bufsize];
+      fBufCapacity = bufsize;
+      SetBit(kIsOwner);
+   }
+   return fBuffer;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set up the message for reading once bufsize bytes were received in the
+/// buffer returned by PrepareRecv(). A compressed message is uncompressed
+/// in the reused message buffer.
+/// This method is only called by TSocket::Recv(TMessage &).
+
+void TMessage::InitRecv(Int_t bufsize, Bool_t compressed)
+{
+   SetReadMode();
+   ResetMap();
+   fBitsPIDs.ResetAllBits();
+   if (fInfos)
+      fInfos->Clear();
+
+   if (compressed) {
+      char *buf = fBufComp + sizeof(UInt_t);
+      frombuf(buf, &fWhat);
+      fBufCompCur = fBufComp + bufsize;
+      fCompPos    = nullptr;
+      if (!TestBit(kIsOwner)) {
+         fBuffer      = nullptr;
+         fBufCapacity = 0;
+         SetBit(kIsOwner);
+      }
+      Uncompress();
+   } else {
+      DeleteCompBuffer();
+      fBufSize = bufsize;
+      fBufMax  = fBuffer + bufsize;
+      fBufCur  = fBuffer + sizeof(UInt_t);
+      *this >> fWhat;
+   }
+
+   ReadMessageHeader();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Destructor
 
@@ -181,12 +273,8 @@ void TMessage::Reset()
    SetBufferOffset(sizeof(UInt_t) + sizeof(fWhat));
    ResetMap();
 
-   if (fBufComp) {
-      delete [] fBufComp;
-      fBufComp    = nullptr;
-      fBufCompCur = nullptr;
-      fCompPos    = nullptr;
-   }
+   if (fBufComp)
+      DeleteCompBuffer();
 
    if (fgEvolution || fEvolution) {
       if (fInfos)
@@ -249,12 +337,8 @@ void TMessage::SetCompressionAlgorithm(Int_t algorithm)
       int level = fCompress % 100;
       newCompress = 100 * algorithm + level;
    }
-   if (newCompress != fCompress && fBufComp) {
-      delete [] fBufComp;
-      fBufComp    = nullptr;
-      fBufCompCur = nullptr;
-      fCompPos    = nullptr;
-   }
+   if (newCompress != fCompress && fBufComp)
+      DeleteCompBuffer();
    fCompress = newCompress;
 }
 
@@ -273,12 +357,8 @@ void TMessage::SetCompressionLevel(Int_t level)
       if (algorithm >= ROOT::RCompressionSetting::EAlgorithm::kUndefined) algorithm = 0;
       newCompress = 100 * algorithm + level;
    }
-   if (newCompress != fCompress && fBufComp) {
-      delete [] fBufComp;
-      fBufComp    = nullptr;
-      fBufCompCur = nullptr;
-      fCompPos    = nullptr;
-   }
+   if (newCompress != fCompress && fBufComp)
+      DeleteCompBuffer();
    fCompress = newCompress;
 }
 
@@ -287,12 +367,8 @@ void TMessage::SetCompressionLevel(Int_t level)
 
 void TMessage::SetCompressionSettings(Int_t settings)
 {
-   if (settings != fCompress && fBufComp) {
-      delete [] fBufComp;
-      fBufComp    = nullptr;
-      fBufCompCur = nullptr;
-      fCompPos    = nullptr;
-   }
+   if (settings != fCompress && fBufComp)
+      DeleteCompBuffer();
    fCompress = settings;
 }
 
@@ -309,12 +385,8 @@ Int_t TMessage::Compress()
    Int_t compressionAlgorithm = GetCompressionAlgorithm();
    if (compressionLevel <= 0) {
       // no compression specified
-      if (fBufComp) {
-         delete [] fBufComp;
-         fBufComp    = nullptr;
-         fBufCompCur = nullptr;
-         fCompPos    = nullptr;
-      }
+      if (fBufComp)
+         DeleteCompBuffer();
       return 0;
    }
 
@@ -324,12 +396,8 @@ Int_t TMessage::Compress()
    }
 
    // remove any existing compressed buffer before compressing modified message
-   if (fBufComp) {
-      delete [] fBufComp;
-      fBufComp    = nullptr;
-      fBufCompCur = nullptr;
-      fCompPos    = nullptr;
-   }
+   if (fBufComp)
+      DeleteCompBuffer();
 
    if (Length() <= (Int_t)(256 + 2*sizeof(UInt_t))) {
       // this message is too small to be compressed
@@ -347,31 +415,17 @@ Int_t TMessage::Compress()
    Int_t chdrlen  = 3*sizeof(UInt_t);   // compressed buffer header length
    Int_t buflen   = std::max(512, chdrlen + messlen + 9*nbuffers);
    fBufComp       = new char[buflen];
-   char *messbuf  = Buffer() + hdrlen;
-   char *bufcur   = fBufComp + chdrlen;
-   Int_t noutot   = 0;
-   Int_t nzip     = 0;
-   Int_t nout, bufmax;
-   for (Int_t i = 0; i < nbuffers; ++i) {
-      if (i == nbuffers - 1)
-         bufmax = messlen - nzip;
-      else
-         bufmax = kMAXZIPBUF;
-      R__zipMultipleAlgorithm(compressionLevel, &bufmax, messbuf, &bufmax, bufcur, &nout,
-                              static_cast<ROOT::RCompressionSetting::EAlgorithm::EValues>(compressionAlgorithm));
-      if (nout == 0 || nout >= messlen) {
-         //this happens when the buffer cannot be compressed
-         delete [] fBufComp;
-         fBufComp    = nullptr;
-         fBufCompCur = nullptr;
-         fCompPos    = nullptr;
-         return -1;
-      }
-      bufcur  += nout;
-      noutot  += nout;
-      messbuf += kMAXZIPBUF;
-      nzip    += kMAXZIPBUF;
+   fBufCompSize   = buflen;
+   // the blocks are compressed in parallel when implicit multi-threading is enabled
+   Int_t noutot = R__zipMultipleAlgorithmBlocks(compressionLevel, messlen, Buffer() + hdrlen, buflen - chdrlen,
+                                                fBufComp + chdrlen,
+                                                static_cast<ROOT::RCompressionSetting::EAlgorithm::EValues>(compressionAlgorithm));
+   if (noutot == 0) {
+      //this happens when the buffer cannot be compressed
+      DeleteCompBuffer();
+      return -1;
    }
+   char *bufcur = fBufComp + chdrlen + noutot;
    fBufCompCur = bufcur;
    fCompPos    = fBufCur;
 
@@ -406,23 +460,24 @@ Int_t TMessage::Uncompress()
       return -1;
    }
 
-   fBuffer  = new char[buflen];
+   // reuse the message buffer when the message is received with TSocket::Recv(TMessage &)
+   if (!fBuffer || fBufCapacity < buflen) {
+      if (TestBit(kIsOwner))
+         delete [] fBuffer;
+      fBuffer      = new char[buflen];
+      fBufCapacity = buflen;
+      SetBit(kIsOwner);
+   }
    fBufSize = buflen;
    fBufCur  = fBuffer + sizeof(UInt_t) + sizeof(fWhat);
    fBufMax  = fBuffer + fBufSize;
    char *messbuf = fBuffer + hdrlen;
 
-   Int_t nout;
-   Int_t noutot = 0;
-   while (1) {
-      Int_t hc = R__unzip_header(&nin, bufcur, &nbuf);
-      if (hc!=0) break;
-      R__unzip(&nin, bufcur, &nbuf, (unsigned char*) messbuf, &nout);
-      if (!nout) break;
-      noutot += nout;
-      if (noutot >= buflen - hdrlen) break;
-      bufcur  += nin;
-      messbuf += nout;
+   // the blocks are uncompressed in parallel when implicit multi-threading is enabled
+   Int_t chdrlen = 3*sizeof(UInt_t);
+   if (!R__unzipBlocks(CompLength() - chdrlen, bufcur, buflen - hdrlen, (UChar_t *)messbuf)) {
+      Error("Uncompress", "Failed to uncompress message of %d bytes", buflen);
+      return -1;
    }
 
    fWhat &= ~kMESS_ZIP;
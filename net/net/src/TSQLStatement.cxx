@@ -99,15 +99,21 @@
 //
 // Oracle and some ODBC drivers support buffering of parameter values and,
 // as a result, bulk insert (update) operation. MySQL (native driver and
-// MyODBC 3) does not support such a mode of operation, therefore adding
-// new rows will result in communication loop to database.
+// MyODBC 3) does not support such a mode of operation. For statements like
+// "INSERT INTO ... VALUES (?, ?, ...)" the native MySQL driver therefore collects
+// the rows of one buffer and inserts them with a single multi-row INSERT statement.
+// Other statements still result in a communication loop to database for each row.
+// The PostgreSQL driver sends the rows of one buffer in pipeline mode (requires
+// libpq 14 or newer), so that it waits for the answer of the server only once
+// per buffer.
 //
 // Local databases (SQLite3) do not use any buffering at all in the TSQLStatement
 // implementation (but inside the library). They still profit from the
 // usage of prepared statements. When inserting many rows into a SQLite3 database,
 // consider using a transaction via the methods StartTransaction() and Commit()
 // of the TSQLServer, as autocommit is active by default and causes a sync to disk
-// after each single insert.
+// after each single insert. If a buffer length larger than 1 is specified, the
+// rows of each buffer are inserted within a savepoint, which has the same effect.
 //
 // One should also mention differences between Oracle and ODBC SQL syntax for
 // parameters. ODBC (and MySQL) use question marks to specify the position
@@ -174,6 +180,23 @@
 //       }
 //    }
 //
+// Instead of one row after another, blocks of rows can be fetched into column-wise
+// buffers with the NextResultRows() method. Each character of the types string
+// specifies the buffer of one field: 'I' for Int_t, 'L' for Long64_t, 'D' for Double_t
+// and 'S' for TString, while '-' (or the end of the string) skips the field:
+//
+//    const Int_t nrows = 1000;
+//    std::vector<Double_t> id1(nrows);
+//    std::vector<TString> name1(nrows);
+//    void *buffers[3] = { id1.data(), nullptr, name1.data() };
+//    Int_t n;
+//    while ((n = stmt->NextResultRows(nrows, "D-S", buffers)) > 0)
+//       for (Int_t i = 0; i < n; i++)
+//          std::cout << id1[i] << "  " << name1[i] << std::endl;
+//
+// Drivers holding the complete result set in memory (like PostgreSQL) fill the
+// buffers directly from it, the others use the access methods described above.
+//
 // 4. Working with date/time parameters
 // ====================================
 // The current implementation supports date, time, date&time and timestamp
@@ -224,6 +247,8 @@
 
 #include "TSQLStatement.h"
 
+#include <cstring>
+
 ClassImp(TSQLStatement);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -267,6 +292,61 @@ void TSQLStatement::SetError(Int_t code, const char* msg, const char* method)
       Error(method,"Code: %d  Msg: %s", code, (msg ? msg : "No message"));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fetch up to maxrows rows of the result set into column-wise buffers.
+/// Character n of types defines the type of buffers[n], which has to provide
+/// space for maxrows values of field n: 'I' - Int_t, 'L' - Long64_t,
+/// 'D' - Double_t, 'S' - TString. Fields with type '-', with a null buffer or
+/// beyond the length of types are not read. If nulls is specified, nulls[n]
+/// (if not null) is filled with the null flags of field n, null values are
+/// stored as 0 or empty string.
+/// Returns number of fetched rows, which is smaller than maxrows only at the
+/// end of the result set, or -1 in case of error.
+/// Default implementation reads the rows one by one with NextResultRow().
+
+Int_t TSQLStatement::NextResultRows(Int_t maxrows, const char *types, void **buffers, Bool_t **nulls)
+{
+   ClearError();
+
+   if ((maxrows <= 0) || !buffers) {
+      SetError(-1, "Invalid arguments", "NextResultRows");
+      return -1;
+   }
+
+   Int_t nfields = GetNumFields();
+   Int_t ntypes = types ? strlen(types) : 0;
+   if (ntypes > nfields) ntypes = nfields;
+
+   for (Int_t n = 0; n < ntypes; n++)
+      if (!strchr("ILDS-", types[n])) {
+         SetError(-1, Form("Unsupported buffer type %c of field %d", types[n], n), "NextResultRows");
+         return -1;
+      }
+
+   Int_t nrows = 0;
+   while ((nrows < maxrows) && NextResultRow()) {
+      for (Int_t n = 0; n < ntypes; n++) {
+         if (!buffers[n] || (types[n] == '-')) continue;
+         Bool_t isnull = IsNull(n);
+         if (nulls && nulls[n])
+            nulls[n][nrows] = isnull;
+         switch (types[n]) {
+            case 'I': ((Int_t *) buffers[n])[nrows] = isnull ? 0 : GetInt(n); break;
+            case 'L': ((Long64_t *) buffers[n])[nrows] = isnull ? 0 : GetLong64(n); break;
+            case 'D': ((Double_t *) buffers[n])[nrows] = isnull ? 0. : GetDouble(n); break;
+            case 'S': {
+               const char *str = isnull ? nullptr : GetString(n);
+               ((TString *) buffers[n])[nrows] = str ? str : "";
+               break;
+            }
+         }
+      }
+      nrows++;
+   }
+
+   return IsError() ? -1 : nrows;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// set only date value for specified parameter from TDatime object
 
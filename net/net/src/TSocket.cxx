@@ -886,6 +886,64 @@ oncemore:
    return n;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Receive a TMessage object in an existing message, reusing its buffers.
+/// Contrary to Recv(TMessage *&), no memory is allocated once the message
+/// has reached the size of the largest received message, which matters
+/// for high rate streams of messages. The message can be reused for any
+/// number of calls, its previous content is discarded. The message type
+/// and length are received together, so that a compressed message is
+/// directly received in the compressed buffer of the message and then
+/// uncompressed in its reused message buffer.
+/// Returns length of message in bytes (can be 0 if other side of connection
+/// is closed) or -1 in case of error or -4 in case a non-blocking socket would
+/// block (i.e. there is nothing to be read) or -5 if pipe broken or reset by
+/// peer (EPIPE || ECONNRESET).
+
+Int_t TSocket::Recv(TMessage &mess)
+{
+   TSystem::ResetErrno();
+
+   if (!IsValid())
+      return -1;
+
+   Int_t n;
+   UInt_t len, what;
+   char hdr[2*sizeof(UInt_t)];
+   do {
+      if ((n = RecvRaw(hdr, sizeof(hdr))) <= 0)
+         return n;
+      char *hbuf = hdr;
+      frombuf(hbuf, &len);
+      frombuf(hbuf, &what);
+      if (len < sizeof(UInt_t)) {
+         Error("Recv", "wrong message length %u", len);
+         return -1;
+      }
+
+      Bool_t compressed = (what & kMESS_ZIP) ? kTRUE : kFALSE;
+      char *buf = mess.PrepareRecv(len + sizeof(UInt_t), compressed);
+      memcpy(buf, hdr, sizeof(hdr));
+      n = len - sizeof(UInt_t);
+      if ((n > 0) && ((n = RecvRaw(buf + sizeof(hdr), n)) <= 0))
+         return n;
+
+      mess.InitRecv(len + sizeof(UInt_t), compressed);
+
+      // receive any streamer infos or process ids
+   } while (RecvStreamerInfos(&mess, kFALSE) || RecvProcessIDs(&mess, kFALSE));
+
+   if (mess.What() & kMESS_ACK) {
+      char ok[2] = { 'o', 'k' };
+      Int_t n2 = 0;
+      if ((n2 = SendRaw(ok, sizeof(ok))) < 0)
+         return n2;
+      mess.SetWhat(mess.What() & ~kMESS_ACK);
+   }
+
+   return len;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Receive a raw buffer of specified length bytes. Using option kPeek
 /// one can peek at incoming data. Returns number of received bytes.
@@ -921,10 +979,10 @@ Int_t TSocket::RecvRaw(void *buffer, Int_t length, ESendRecvOptions opt)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Receive a message containing streamer infos. In case the message contains
-/// streamer infos they are imported, the message will be deleted and the
-/// method returns kTRUE.
+/// streamer infos they are imported, the message will be deleted (if del is
+/// kTRUE) and the method returns kTRUE.
 
-Bool_t TSocket::RecvStreamerInfos(TMessage *mess)
+Bool_t TSocket::RecvStreamerInfos(TMessage *mess, Bool_t del)
 {
    if (mess->What() == kMESS_STREAMERINFO) {
       TList *list = (TList*)mess->ReadObject(TList::Class());
@@ -959,7 +1017,8 @@ Bool_t TSocket::RecvStreamerInfos(TMessage *mess)
          lnk = lnk->Next();
      }
       delete list;
-      delete mess;
+      if (del)
+         delete mess;
 
       return kTRUE;
    }
@@ -968,10 +1027,10 @@ Bool_t TSocket::RecvStreamerInfos(TMessage *mess)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Receive a message containing process ids. In case the message contains
-/// process ids they are imported, the message will be deleted and the
-/// method returns kTRUE.
+/// process ids they are imported, the message will be deleted (if del is
+/// kTRUE) and the method returns kTRUE.
 
-Bool_t TSocket::RecvProcessIDs(TMessage *mess)
+Bool_t TSocket::RecvProcessIDs(TMessage *mess, Bool_t del)
 {
    if (mess->What() == kMESS_PROCESSID) {
       TList *list = (TList*)mess->ReadObject(TList::Class());
@@ -999,7 +1058,8 @@ Bool_t TSocket::RecvProcessIDs(TMessage *mess)
          }
       }
       delete list;
-      delete mess;
+      if (del)
+         delete mess;
 
       return kTRUE;
    }
@@ -50,13 +50,14 @@ private:
    // if requested
    Int_t                   fReadvIorMax; // Max size of a single readv chunk
    Int_t                   fReadvIovMax; // Max number of readv chunks
+   Int_t                   fParallelReadv; // Number of requests a vector read is split into
    Int_t                   fQueryReadVParams;
    TString                 fNewUrl;
 
 public:
    TNetXNGFile() : TFile(),
       fFile(0), fUrl(0), fMode(XrdCl::OpenFlags::None), fInitCondVar(0),
-      fReadvIorMax(0), fReadvIovMax(0) {}
+      fReadvIorMax(0), fReadvIovMax(0), fParallelReadv(1) {}
    TNetXNGFile(const char *url, const char *lurl, Option_t *mode , const char *title ,
                Int_t compress , Int_t netopt , Bool_t parallelopen );
    TNetXNGFile(const char *url, Option_t *mode = "", const char *title = "",
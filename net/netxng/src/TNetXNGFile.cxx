@@ -30,6 +30,7 @@
 #include <XrdCl/XrdClXRootDResponses.hh>
 #include <XrdCl/XrdClDefaultEnv.hh>
 #include <XrdVersion.hh>
+#include <algorithm>
 #include <iostream>
 
 //------------------------------------------------------------------------------
@@ -162,6 +163,7 @@ TNetXNGFile::TNetXNGFile(const char *url,
    fQueryReadVParams = 1;
    fReadvIorMax = 2097136;
    fReadvIovMax = 1024;
+   fParallelReadv = 1;
 
    if (ParseOpenMode(mode, fOption, fMode, kTRUE)<0) {
       Error("Open", "could not parse open mode %s", mode);
@@ -480,6 +482,7 @@ Bool_t TNetXNGFile::ReadBuffers(char *buffer, Long64_t *position, Int_t *length,
    std::vector<XRootDStatus*> *statuses;
    TSemaphore                 *semaphore;
    Int_t                       totalBytes = 0;
+   Long64_t                    listBytes  = 0;
    Long64_t                    offset     = 0;
    char                       *cursor     = buffer;
 
@@ -490,40 +493,34 @@ Bool_t TNetXNGFile::ReadBuffers(char *buffer, Long64_t *position, Int_t *length,
       for (Int_t i = 0; i < nbuffs; i++)
          position[i] += fArchiveOffset;
 
-   // Build a list of chunks. Put the buffers in the ChunkInfo's
-   for (Int_t i = 0; i < nbuffs; ++i) {
+   for (Int_t i = 0; i < nbuffs; ++i)
       totalBytes += length[i];
 
+   // Large requests are split into several readv requests of about the same
+   // size, which are all in flight at the same time and can thus be served in
+   // parallel over the sub-streams of the connection. Requests are not made
+   // smaller than the largest readv chunk the server accepts.
+   Long64_t maxListBytes = totalBytes;
+   if (fParallelReadv > 1)
+      maxListBytes = std::max((Long64_t)fReadvIorMax, (totalBytes + fParallelReadv - 1) / fParallelReadv);
+
+   // Build a list of chunks. Put the buffers in the ChunkInfo's
+   for (Int_t i = 0; i < nbuffs; ++i) {
       // If the length is bigger than max readv size, split into smaller chunks
-      if (length[i] > fReadvIorMax) {
-         Int_t nsplit = length[i] / fReadvIorMax;
-         Int_t rem    = length[i] % fReadvIorMax;
-         Int_t j;
-
-         // Add as many max-size chunks as are divisible
-         for (j = 0; j < nsplit; ++j) {
-            offset = position[i] + (j * fReadvIorMax);
-            chunks.push_back(ChunkInfo(offset, fReadvIorMax, cursor));
-            cursor += fReadvIorMax;
+      for (Int_t done = 0; done < length[i]; ) {
+         Int_t len = std::min(length[i] - done, fReadvIorMax);
+         offset = position[i] + done;
+         chunks.push_back(ChunkInfo(offset, len, cursor));
+         cursor += len;
+         done += len;
+         listBytes += len;
+
+         // If there are max chunks or enough bytes, make another chunk list
+         if ((Int_t) chunks.size() == fReadvIovMax || listBytes >= maxListBytes) {
+            chunkLists.push_back(chunks);
+            chunks = ChunkList();
+            listBytes = 0;
          }
-
-         // Add the remainder
-         offset = position[i] + (j * fReadvIorMax);
-         chunks.push_back(ChunkInfo(offset, rem, cursor));
-         cursor += rem;
-      } else {
-         chunks.push_back(ChunkInfo(position[i], length[i], cursor));
-         cursor += length[i];
-      }
-
-      // If there are more than or equal to max chunks, make another chunk list
-      if ((Int_t) chunks.size() == fReadvIovMax) {
-         chunkLists.push_back(chunks);
-         chunks = ChunkList();
-      } else if ((Int_t) chunks.size() > fReadvIovMax) {
-         chunkLists.push_back(ChunkList(chunks.begin(),
-                                        chunks.begin() + fReadvIovMax));
-         chunks = ChunkList(chunks.begin() + fReadvIovMax, chunks.end());
       }
    }
 
@@ -546,6 +543,14 @@ Bool_t TNetXNGFile::ReadBuffers(char *buffer, Long64_t *position, Int_t *length,
 
       if (!status.IsOK()) {
          Error("ReadBuffers", "%s", status.ToStr().c_str());
+         delete handler;
+         // Wait for the requests already sent before releasing their status
+         for (auto sent = chunkLists.begin(); sent != it; ++sent)
+            semaphore->Wait();
+         for (auto st : *statuses)
+            delete st;
+         delete statuses;
+         delete semaphore;
          return kTRUE;
       }
    }
@@ -877,6 +882,11 @@ void TNetXNGFile::SetEnv()
       env->PutString("ClientMonitorParam", val.Data());
 
    fQueryReadVParams = gEnv->GetValue("NetXNG.QueryReadVParams", 1);
+
+   // By default, split vector reads over as many requests as there are streams
+   int substreams = 1;
+   env->GetInt("SubStreamsPerChannel", substreams);
+   fParallelReadv = std::max(1, gEnv->GetValue("NetXNG.ParallelReadv", substreams));
    env->PutInt( "MultiProtocol", gEnv->GetValue("TFile.CrossProtocolRedirects", 1));
 
    // Old style netrc file
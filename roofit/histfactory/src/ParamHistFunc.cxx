@@ -35,6 +35,7 @@
  */
 
 
+#include <algorithm>
 #include <sstream>
 #include <math.h>
 #include <stdexcept>
@@ -662,6 +663,49 @@ Double_t ParamHistFunc::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the function for a batch of events: the bins of all events are looked
+/// up at once with RooDataHist::binIndices(), and each event takes the value of the
+/// parameter of its bin. If one of the observables is not a batch, or a dimension
+/// is a category, the values are computed event by event.
+
+RooSpan<double> ParamHistFunc::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  std::vector<RooSpan<const double>> coordinates;
+  for (const auto obs : *_dataSet.get()) {
+    auto var = dynamic_cast<const RooAbsReal*>(_dataVars.find(obs->GetName()));
+    if (!var) {
+      return RooAbsReal::evaluateBatch(begin, batchSize);
+    }
+
+    auto batch = var->getValBatch(begin, batchSize);
+    if (batch.empty()) {
+      return RooAbsReal::evaluateBatch(begin, batchSize);
+    }
+    batchSize = std::min(batchSize, batch.size());
+    coordinates.push_back(batch);
+  }
+
+  std::vector<Int_t> bins(batchSize);
+  if (!_dataSet.binIndices(bins.data(), coordinates, batchSize)) {
+    return RooAbsReal::evaluateBatch(begin, batchSize);
+  }
+
+  // Values of the parameters, in the order of the bins of the RooDataHist
+  std::vector<double> values(numBins());
+  for (Int_t i = 0; i < numBins(); ++i) {
+    values[i] = getParameter(i).getVal();
+  }
+
+  auto output = _batchData.makeWritableBatchUnInit(begin, batchSize);
+  for (std::size_t i = 0; i < batchSize; ++i) {
+    output[i] = values[bins[i]];
+  }
+
+  return output;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Advertise that all integrals can be handled internally.
 
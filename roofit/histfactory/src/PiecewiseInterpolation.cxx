@@ -24,8 +24,10 @@
 #include "RooMsgService.h"
 #include "RooNumIntConfig.h"
 #include "RooTrace.h"
+#include "BatchHelpers.h"
 
 #include <exception>
+#include <limits>
 #include <math.h>
 
 using namespace std;
@@ -297,6 +299,159 @@ Double_t PiecewiseInterpolation::evaluate() const
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the interpolation for a batch of events. The nominal value and the variations
+/// may depend on the observables, e.g. RooHistFunc, while the interpolation parameters are
+/// the same for all events. The interpolation code and the side of each parameter are therefore
+/// chosen once per batch, and the loops over the events only apply the selected formula of
+/// evaluate().
+
+RooSpan<double> PiecewiseInterpolation::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  const auto& nominalFunc = static_cast<const RooAbsReal&>(_nominal.arg());
+  auto nominalBatch = nominalFunc.getValBatch(begin, batchSize);
+
+  std::vector<RooSpan<const double>> batches{nominalBatch};
+  std::vector<BatchHelpers::BracketAdapterWithMask> lows;
+  std::vector<BatchHelpers::BracketAdapterWithMask> highs;
+  lows.reserve(_paramSet.size());
+  highs.reserve(_paramSet.size());
+  for (unsigned int i=0; i < _paramSet.size(); ++i) {
+    auto low  = static_cast<const RooAbsReal*>(_lowSet.at(i));
+    auto high = static_cast<const RooAbsReal*>(_highSet.at(i));
+    auto lowBatch  = low->getValBatch(begin, batchSize);
+    auto highBatch = high->getValBatch(begin, batchSize);
+    lows.emplace_back(lowBatch.empty() ? low->getVal() : 0., lowBatch);
+    highs.emplace_back(highBatch.empty() ? high->getVal() : 0., highBatch);
+    batches.push_back(lowBatch);
+    batches.push_back(highBatch);
+  }
+
+  batchSize = BatchHelpers::findSize(batches);
+  if (batchSize == std::numeric_limits<std::size_t>::max()) {
+    // Nothing depends on the observables
+    return {};
+  }
+
+  BatchHelpers::BracketAdapterWithMask nominal(nominalBatch.empty() ? nominalFunc.getVal() : 0., nominalBatch);
+  auto output = _batchData.makeWritableBatchUnInit(begin, batchSize);
+  for (std::size_t j = 0; j < batchSize; ++j) { //CHECK_VECTORISE
+    output[j] = nominal[j];
+  }
+
+  for (unsigned int i=0; i < _paramSet.size(); ++i) {
+    const double x = static_cast<const RooAbsReal*>(_paramSet.at(i))->getVal();
+    const auto& low = lows[i];
+    const auto& high = highs[i];
+
+    switch (_interpCode[i]) {
+    case 0: {
+      // piece-wise linear
+      if (x > 0) {
+        for (std::size_t j = 0; j < batchSize; ++j) { //CHECK_VECTORISE
+          output[j] += x * (high[j] - nominal[j]);
+        }
+      } else {
+        for (std::size_t j = 0; j < batchSize; ++j) { //CHECK_VECTORISE
+          output[j] += x * (nominal[j] - low[j]);
+        }
+      }
+      break;
+    }
+    case 1: {
+      // piece-wise log
+      if (x >= 0) {
+        for (std::size_t j = 0; j < batchSize; ++j) {
+          output[j] *= std::pow(high[j] / nominal[j], x);
+        }
+      } else {
+        for (std::size_t j = 0; j < batchSize; ++j) {
+          output[j] *= std::pow(low[j] / nominal[j], -x);
+        }
+      }
+      break;
+    }
+    case 2:
+    case 3: {
+      // parabolic with linear extrapolation
+      for (std::size_t j = 0; j < batchSize; ++j) { //CHECK_VECTORISE
+        const double a = 0.5 * (high[j] + low[j]) - nominal[j];
+        const double b = 0.5 * (high[j] - low[j]);
+        if (x > 1) {
+          output[j] += (2 * a + b) * (x - 1) + high[j] - nominal[j];
+        } else if (x < -1) {
+          output[j] += -1 * (2 * a - b) * (x + 1) + low[j] - nominal[j];
+        } else {
+          output[j] += a * x * x + b * x;
+        }
+      }
+      break;
+    }
+    case 4: {
+      if (x > 1) {
+        for (std::size_t j = 0; j < batchSize; ++j) { //CHECK_VECTORISE
+          output[j] += x * (high[j] - nominal[j]);
+        }
+      } else if (x < -1) {
+        for (std::size_t j = 0; j < batchSize; ++j) { //CHECK_VECTORISE
+          output[j] += x * (nominal[j] - low[j]);
+        }
+      } else {
+        // polynomial with equal function, first and second derivative at the boundaries
+        const double polyA = x * x * (15 + x * x * (-10 + x * x * 3));
+        for (std::size_t j = 0; j < batchSize; ++j) { //CHECK_VECTORISE
+          const double epsPlus = high[j] - nominal[j];
+          const double epsMinus = nominal[j] - low[j];
+          const double S = 0.5 * (epsPlus + epsMinus);
+          const double A = 0.0625 * (epsPlus - epsMinus);
+          const double val = nominal[j] + x * S + polyA * A;
+          output[j] += (val < 0 ? 0. : val) - nominal[j];
+        }
+      }
+      break;
+    }
+    case 5: {
+      if (x > 1 || x < -1) {
+        if (x > 0) {
+          for (std::size_t j = 0; j < batchSize; ++j) { //CHECK_VECTORISE
+            output[j] += x * (high[j] - nominal[j]);
+          }
+        } else {
+          for (std::size_t j = 0; j < batchSize; ++j) { //CHECK_VECTORISE
+            output[j] += x * (nominal[j] - low[j]);
+          }
+        }
+      } else {
+        // polynomial with equal function and first derivative at the boundaries
+        for (std::size_t j = 0; j < batchSize; ++j) {
+          if (nominal[j] == 0) continue;
+          const double epsPlus = high[j] - nominal[j];
+          const double epsMinus = nominal[j] - low[j];
+          const double S = 0.5 * (epsPlus + epsMinus);
+          const double A = 0.5 * (epsPlus - epsMinus);
+          const double val = nominal[j] + S * x + 1.5 * A * x * x - 0.5 * A * x * x * x * x;
+          output[j] += (val < 0 ? 0. : val) - nominal[j];
+        }
+      }
+      break;
+    }
+    default: {
+      coutE(InputArguments) << "PiecewiseInterpolation::evaluateBatch ERROR:  " << _paramSet.at(i)->GetName()
+			    << " with unknown interpolation code" << _interpCode[i] << endl ;
+      break;
+    }
+    }
+  }
+
+  if (_positiveDefinite) {
+    for (std::size_t j = 0; j < batchSize; ++j) { //CHECK_VECTORISE
+      output[j] = output[j] < 0 ? 0. : output[j];
+    }
+  }
+
+  return output;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Bool_t PiecewiseInterpolation::setBinIntegrator(RooArgSet& allVars) 
@@ -2,9 +2,15 @@
 // Authors: Stephan Hageboeck, CERN  01/2019
 
 #include "RooStats/HistFactory/Sample.h"
+#include "RooStats/HistFactory/PiecewiseInterpolation.h"
+#include "RooStats/HistFactory/ParamHistFunc.h"
 #include "RooStats/ModelConfig.h"
 #include "RooWorkspace.h"
 #include "RooArgSet.h"
+#include "RooDataHist.h"
+#include "RooDataSet.h"
+#include "RooHistFunc.h"
+#include "RooRealVar.h"
 
 #include "TROOT.h"
 #include "TFile.h"
@@ -81,3 +87,65 @@ TEST(HistFactory, Read_ROOT6_16_Combined_Model) {
   EXPECT_NEAR(pdf->getVal(), 0.17488817, 1.E-8);
   EXPECT_NEAR(pdf->getVal(*obs), 0.95652174, 1.E-8);
 }
+
+
+TEST(HistFactory, BatchEvaluation) {
+  RooRealVar x("x", "x", 0., 10.);
+  x.setBins(10);
+
+  RooDataHist nominalHist("nominalHist", "nominalHist", x);
+  RooDataHist lowHist("lowHist", "lowHist", x);
+  RooDataHist highHist("highHist", "highHist", x);
+  for (int i = 0; i < 10; ++i) {
+    nominalHist.get(i);
+    nominalHist.set(10. + i);
+    lowHist.get(i);
+    lowHist.set(8. + 0.5 * i);
+    highHist.get(i);
+    highHist.set(12. + 1.5 * i);
+  }
+
+  RooHistFunc nominal("nominal", "nominal", x, nominalHist);
+  RooHistFunc low("low", "low", x, lowHist);
+  RooHistFunc high("high", "high", x, highHist);
+  RooRealVar alpha("alpha", "alpha", 0., -5., 5.);
+  PiecewiseInterpolation interpolation("interpolation", "interpolation", nominal, low, high, alpha);
+
+  std::vector<std::unique_ptr<RooRealVar>> gammas;
+  RooArgList gammaList;
+  for (int i = 0; i < 10; ++i) {
+    std::string name = "gamma_" + std::to_string(i);
+    gammas.emplace_back(new RooRealVar(name.c_str(), name.c_str(), 1. + 0.05 * i, 0., 2.));
+    gammaList.add(*gammas.back());
+  }
+  ParamHistFunc paramHist("paramHist", "paramHist", x, gammaList);
+
+  RooDataSet data("data", "data", x);
+  for (int i = 0; i < 100; ++i) {
+    x.setVal(0.1 * i + 0.05);
+    data.add(x);
+  }
+  std::unique_ptr<RooArgSet> observables(interpolation.getObservables(data));
+  data.attachBuffers(*observables);
+
+  for (int code = 0; code < 6; ++code) {
+    interpolation.setAllInterpCodes(code);
+    for (double alphaVal : {-1.7, -0.4, 0., 0.3, 1.2}) {
+      alpha.setVal(alphaVal);
+      auto batch = interpolation.getValBatch(0, data.numEntries());
+      ASSERT_EQ(batch.size(), static_cast<std::size_t>(data.numEntries()));
+
+      for (int i = 0; i < data.numEntries(); ++i) {
+        x.setVal(data.get(i)->getRealValue("x"));
+        EXPECT_NEAR(batch[i], interpolation.getVal(), 1.E-12)
+            << "code " << code << ", alpha " << alphaVal << ", event " << i;
+      }
+    }
+  }
+
+  auto batch = paramHist.getValBatch(0, data.numEntries());
+  ASSERT_EQ(batch.size(), static_cast<std::size_t>(data.numEntries()));
+  for (int i = 0; i < data.numEntries(); ++i) {
+    EXPECT_DOUBLE_EQ(batch[i], 1. + 0.05 * (i / 10)) << "event " << i;
+  }
+}
@@ -41,6 +41,7 @@ protected:
   Double_t evaluate() const override;
 
   RooSpan<double> evaluateBatch(std::size_t begin, std::size_t batchSize) const override;
+  double* evaluateDeviceBatch(BatchHelpers::DeviceContext& context) const override;
 
 private:
   ClassDefOverride(RooExponential,1) // Exponential PDF
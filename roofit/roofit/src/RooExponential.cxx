@@ -29,6 +29,7 @@ range and values of the arguments.
 
 #include "RooRealVar.h"
 #include "BatchHelpers.h"
+#include "BatchDevice.h"
 #include "RooVDTHeaders.h"
 
 #include <cmath>
@@ -130,3 +131,20 @@ RooSpan<double> RooExponential::evaluateBatch(std::size_t begin, std::size_t bat
   }
   return output;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the exponential without normalising it on the device, for data in `x`
+/// and a constant `c`.
+/// \return The device array with the results, or nullptr if `c` depends on the data.
+
+double* RooExponential::evaluateDeviceBatch(BatchHelpers::DeviceContext& context) const {
+  if (context.dependsOnData(c.arg()))
+    return nullptr;
+
+  const double* xData = x.arg().getDeviceBatch(context);
+  double* output = context.output(*this);
+  if (!xData || !output || !context.exponential(output, xData, c))
+    return nullptr;
+
+  return output;
+}
@@ -24,6 +24,7 @@ Plain Gaussian p.d.f
 
 #include "RooFit.h"
 #include "BatchHelpers.h"
+#include "BatchDevice.h"
 #include "RooAbsReal.h"
 #include "RooRealVar.h"
 #include "RooRandom.h"
@@ -137,6 +138,24 @@ RooSpan<double> RooGaussian::evaluateBatch(std::size_t begin, std::size_t batchS
   return output;
 }
 
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the Gaussian without normalising it on the device, for data in `x` and
+/// constant mean and sigma.
+/// \return The device array with the results, or nullptr if mean or sigma depend on the data.
+
+double* RooGaussian::evaluateDeviceBatch(BatchHelpers::DeviceContext& context) const {
+  if (context.dependsOnData(mean.arg()) || context.dependsOnData(sigma.arg()))
+    return nullptr;
+
+  const double* xData = x.arg().getDeviceBatch(context);
+  double* output = context.output(*this);
+  if (!xData || !output || !context.gaussian(output, xData, mean, sigma))
+    return nullptr;
+
+  return output;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooGaussian::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const
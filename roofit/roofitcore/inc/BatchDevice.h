@@ -0,0 +1,101 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2020, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#ifndef ROOFIT_ROOFITCORE_INC_BATCHDEVICE_H_
+#define ROOFIT_ROOFITCORE_INC_BATCHDEVICE_H_
+
+#include <cstddef>
+#include <map>
+#include <memory>
+
+class RooAbsArg;
+class RooAbsReal;
+class RooArgSet;
+
+namespace BatchHelpers {
+
+/**
+ * Evaluation of the batches of a likelihood on a CUDA device.
+ *
+ * The context holds a range of events of a dataset: the columns of the observables are
+ * uploaded to the device the first time they are requested, and stay resident across the
+ * evaluations of the likelihood (i.e. across the iterations of the minimiser). The nodes
+ * of the computation graph that support it (see RooAbsReal::evaluateDeviceBatch()) compute
+ * their values for all events in arrays on the device, with their parameters passed from
+ * the host. The likelihood is reduced on the device, and only the partial sums of the
+ * thread blocks are copied back and added in a fixed order.
+ *
+ * It is available only if ROOT has been built with CUDA support (cuda=ON) and a device is
+ * present, see isAvailable().
+ */
+class DeviceContext {
+  public:
+    /// Create a context for the events [first, first + size) of the dataset with the given observables.
+    DeviceContext(const RooArgSet& observables, std::size_t first, std::size_t size);
+    ~DeviceContext();
+
+    DeviceContext(const DeviceContext&) = delete;
+    DeviceContext& operator=(const DeviceContext&) = delete;
+
+    /// Return true if ROOT has been built with CUDA support and a CUDA device is present.
+    static bool isAvailable();
+
+    std::size_t first() const { return _first; }
+    std::size_t size() const { return _size; }
+
+    /// Return true if the value of `arg` changes from event to event.
+    bool dependsOnData(const RooAbsArg& arg) const;
+
+    /// Return the device array with the values of the observable `var` for the events of the
+    /// context, uploaded at the first call. Return nullptr if `var` is not a column of the dataset.
+    const double* column(const RooAbsReal& var);
+
+    /// Return the device array with the weights of the events, uploaded at the first call.
+    const double* weights(const double* hostWeights);
+
+    /// Return the device array holding the values of `node`, allocated at the first call.
+    double* output(const RooAbsArg& node);
+
+    /// \name Kernels
+    /// Element-wise operations on device arrays of size(). All of them return false if
+    /// the launch failed.
+    ///@{
+    bool fill(double* out, double value);
+    bool scale(double* out, double factor);
+    /// out += a * in
+    bool axpy(double* out, const double* in, double a);
+    bool gaussian(double* out, const double* x, double mean, double sigma);
+    bool exponential(double* out, const double* x, double c);
+    ///@}
+
+    /// Compute the sum over the events of `-w * log(p)` and the sum of the weights `w`. The weights are
+    /// the device array `w`, or the constant `weight` if it is null, squared if `weightSquared`.
+    bool negativeLogSum(const double* p, const double* w, double weight, bool weightSquared,
+        double& nll, double& sumWeights);
+
+  private:
+    struct Impl;
+
+    std::unique_ptr<Impl> _impl;
+    std::unique_ptr<RooArgSet> _observables;
+    std::size_t _first;
+    std::size_t _size;
+    std::map<const RooAbsArg*, double*> _columns;
+    std::map<const RooAbsArg*, double*> _outputs;
+    double* _weights = nullptr;
+};
+
+}
+
+#endif /* ROOFIT_ROOFITCORE_INC_BATCHDEVICE_H_ */
@@ -563,6 +563,12 @@ protected:
    /// Notify that a shape-like property (*e.g.* binning) has changed.
    void setShapeDirty(const RooAbsArg* source);
 
+ private:
+   void propagateValueDirty(const RooAbsArg* source, unsigned long propagation);
+   void propagateShapeDirty(const RooAbsArg* source, unsigned long propagation);
+
+ protected:
+
    virtual void ioStreamerPass2() ;
    static void ioStreamerPass2Finalize() ;
 
@@ -659,6 +665,8 @@ private:
   mutable Bool_t _valueDirty ;  // Flag set if value needs recalculating because input values modified
   mutable Bool_t _shapeDirty ;  // Flag set if value needs recalculating because input shapes modified
   mutable bool _allBatchesDirty{true}; //! Mark batches as dirty (only meaningful for RooAbsReal).
+  mutable unsigned long _valueDirtyPropagation{0}; //! Last propagation of the value dirty flag through this node
+  mutable unsigned long _shapeDirtyPropagation{0}; //! Last propagation of the shape dirty flag through this node
 
   mutable OperMode _operMode ; // Dirty state propagation mode
   mutable Bool_t _fast ; // Allow fast access mode in getVal() and proxies
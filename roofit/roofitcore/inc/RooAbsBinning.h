@@ -19,6 +19,9 @@
 #include "Rtypes.h"
 #include "RooPrintable.h"
 #include "TNamed.h" 
+
+#include <cstddef>
+
 class TIterator ;
 class RooAbsRealLValue ;
 class RooAbsReal ;
@@ -41,6 +44,7 @@ public:
   virtual Int_t numBoundaries() const = 0 ;
   virtual Int_t binNumber(Double_t x) const = 0 ;
   virtual Int_t rawBinNumber(Double_t x) const { return binNumber(x) ; }
+  virtual void binNumbers(const double* x, Int_t* bins, std::size_t n, Int_t coef=1) const ;
   virtual Double_t binCenter(Int_t bin) const = 0 ;
   virtual Double_t binWidth(Int_t bin) const = 0 ;
   virtual Double_t binLow(Int_t bin) const = 0 ;
@@ -203,6 +203,8 @@ public:
       const RooArgSet* normSet = nullptr) const final;
   RooSpan<const double> getLogValBatch(std::size_t begin, std::size_t batchSize,
       const RooArgSet* normSet = nullptr) const;
+  const double* getDeviceBatch(BatchHelpers::DeviceContext& context,
+      const RooArgSet* normSet = nullptr) const final;
 
   /// \copydoc getNorm(const RooArgSet*) const
   Double_t getNorm(const RooArgSet& nset) const { 
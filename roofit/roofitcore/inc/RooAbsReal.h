@@ -46,6 +46,9 @@ class RooVectorDataStore ;
 namespace RooHelpers {
 class BatchInterfaceAccessor;
 }
+namespace BatchHelpers {
+class DeviceContext;
+}
 struct TreeReadBuffer; /// A space to attach TBranches
 
 class TH1;
@@ -108,6 +111,7 @@ public:
   virtual Double_t getValV(const RooArgSet* normalisationSet = nullptr) const ;
 
   virtual RooSpan<const double> getValBatch(std::size_t begin, std::size_t maxSize, const RooArgSet* normSet = nullptr) const;
+  virtual const double* getDeviceBatch(BatchHelpers::DeviceContext& context, const RooArgSet* normSet = nullptr) const;
 
   Double_t getPropagatedError(const RooFitResult &fr, const RooArgSet &nset = RooArgSet()) const;
 
@@ -406,6 +410,7 @@ protected:
   /// Evaluate this PDF / function / constant. Needs to be overridden by all derived classes.
   virtual Double_t evaluate() const = 0;
   virtual RooSpan<double> evaluateBatch(std::size_t begin, std::size_t maxSize) const;
+  virtual double* evaluateDeviceBatch(BatchHelpers::DeviceContext& context) const;
 
   //---------- Interface to access batch data ---------------------------
   //
@@ -64,6 +64,14 @@ public:
   virtual Double_t offset() const { return _offset ; }
   virtual Double_t offsetCarry() const { return _offsetCarry; }
 
+  std::vector<RooAbsTestStatistic*> simComponents() const ;
+
+  void setNumThreads(Int_t nThreads) ;
+  Int_t numThreads() const {
+    // Return number of threads requested for the calculation (0 = all threads of the ROOT thread pool)
+    return _nThreads ;
+  }
+
 protected:
 
   virtual void printCompactTreeHook(std::ostream& os, const char* indent="") ;
@@ -78,6 +86,7 @@ protected:
   void setSimCount(Int_t simCount) { 
     // Store total number of components p.d.f. of a RooSimultaneous in this component test statistic
     _simCount = simCount ; 
+    for (auto gof : _mtArray) gof->setSimCount(simCount) ;
   }
   
   void setEventCount(Int_t nEvents) { 
@@ -122,6 +131,10 @@ protected:
   Bool_t initialize() ;
   void initSimMode(RooSimultaneous* pdf, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;    
   void initMPMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;
+  void initMTMode() ;
+  void deleteMTMode() ;
+  Int_t effectiveNumThreads() const ;
+  Int_t componentThreads(Int_t nEvents, Int_t nTotal) const ;
 
   mutable Bool_t _init ;          //! Is object initialized  
   GOFOpMode   _gofOpMode ;        // Operation mode of test statistic instance 
@@ -140,13 +153,17 @@ protected:
   Int_t          _nCPU ;      //  Number of processors to use in parallel calculation mode
   pRooRealMPFE*  _mpfeArray ; //! Array of parallel execution frond ends
 
+  // Multi-threaded mode data
+  Int_t          _nThreads ;  //  Number of threads to use in multi-threaded calculation mode (0 = all threads of the pool)
+  std::vector<pRooAbsTestStatistic> _mtArray ; //! Partitions evaluated in the threads of the ROOT thread pool
+
   RooFit::MPSplit        _mpinterl ; // Use interleaving strategy rather than N-wise split for partioning of dataset for multiprocessor-split
   Bool_t         _doOffset ; // Apply interval value offset to control numeric precision?
   mutable Double_t _offset ; //! Offset
   mutable Double_t _offsetCarry; //! avoids loss of precision
   mutable Double_t _evalCarry; //! carry of Kahan sum in evaluatePartition
 
-  ClassDef(RooAbsTestStatistic,2) // Abstract base class for real-valued test statistics
+  ClassDef(RooAbsTestStatistic,3) // Abstract base class for real-valued test statistics
 
 };
 
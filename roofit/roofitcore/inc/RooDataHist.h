@@ -22,6 +22,7 @@
 #include "RooNameSet.h"
 #include "RooCacheManager.h"
 
+#include <algorithm>
 #include <map>
 #include <vector>
 #include <string>
@@ -90,12 +91,10 @@ public:
   }
   virtual Bool_t isNonPoissonWeighted() const ;
 
-  virtual RooSpan<const double> getWeightBatch(std::size_t, std::size_t) const {
-    //TODO
-    std::cerr << "Retrieving weights in batches not yet implemented for RooDataHist." << std::endl;
-    assert(false);
-
-    return {};
+  virtual RooSpan<const double> getWeightBatch(std::size_t first, std::size_t len) const {
+    // Return the weights of the bins [first, first+len), in the order of get(Int_t)
+    const std::size_t last = std::min(first + len, static_cast<std::size_t>(_arrSize));
+    return first < last ? RooSpan<const double>(_wgt + first, _wgt + last) : RooSpan<const double>();
   }
 
   Double_t sum(Bool_t correctForBinSize, Bool_t inverseCorr=kFALSE) const ;
@@ -108,6 +107,8 @@ public:
   }
   Double_t weightSquared() const ;
   Double_t weight(const RooArgSet& bin, Int_t intOrder=1, Bool_t correctForBinSize=kFALSE, Bool_t cdfBoundaries=kFALSE, Bool_t oneSafe=kFALSE) ;   
+  bool binIndices(Int_t* indices, const std::vector<RooSpan<const double>>& coordinates, std::size_t n) const ;
+  bool weights(double* output, const std::vector<RooSpan<const double>>& coordinates, std::size_t n, bool correctForBinSize) const ;
   Double_t binVolume() const { return _curVolume ; }
   Double_t binVolume(const RooArgSet& bin) ; 
   virtual Bool_t valid() const ;
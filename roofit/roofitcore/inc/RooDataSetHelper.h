@@ -0,0 +1,135 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2020, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#ifndef ROOFIT_ROOFITCORE_INC_ROODATASETHELPER_H_
+#define ROOFIT_ROOFITCORE_INC_ROODATASETHELPER_H_
+
+#include "RooArgList.h"
+#include "RooDataSet.h"
+#include "RooRealVar.h"
+#include "RooVectorDataStore.h"
+
+#include "ROOT/RDF/ActionHelpers.hxx"
+#include "ROOT/RDF/Utils.hxx"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * RDataFrame action filling a RooDataSet column by column.
+ *
+ * Each thread of the event loop appends the values of the columns to its own vectors, one
+ * per variable, without loading them into the variables of the dataset event by event. At the
+ * end of the event loop, the vectors are moved into the RooVectorDataStore of the dataset (see
+ * RooVectorDataStore::adoptColumns()): in a single-threaded event loop, the dataset adopts their
+ * memory without copies, otherwise the vectors of the threads are concatenated.
+ *
+ * The columns are booked in the order of the variables. Events with a value outside of the range of
+ * its variable are skipped, as in the import of a TTree. Any data source of RDataFrame can be used,
+ * e.g. a TTree or an RNTuple (with ROOT::Experimental::MakeNTupleDataFrame()):
+ * ~~~{.cpp}
+ * RooRealVar x("x", "x", -10., 10.);
+ * RooRealVar y("y", "y", 0., 100.);
+ * ROOT::EnableImplicitMT();
+ * ROOT::RDataFrame rdf("tree", "file.root");
+ * auto data = rdf.Book<double, float>(RooDataSetHelper("data", "data", RooArgList(x, y)), {"x", "y"});
+ * data->Print();
+ * ~~~
+ * With multiple threads, the order of the events in the dataset depends on the scheduling of the
+ * event loop. A weighted dataset is created if `wgtVarName` names one of the variables.
+ */
+class RooDataSetHelper : public ROOT::Detail::RDF::RActionImpl<RooDataSetHelper> {
+public:
+  using Result_t = RooDataSet;
+
+  RooDataSetHelper(const char* name, const char* title, const RooArgList& vars, const char* wgtVarName = nullptr) :
+    _dataset(std::make_shared<RooDataSet>(name, title, RooArgSet(vars), wgtVarName)),
+    _vars(vars),
+    _columns(ROOT::Internal::RDF::GetNSlots(), std::vector<std::vector<double>>(vars.size()))
+  {
+    for (const auto var : _vars) {
+      auto realVar = dynamic_cast<const RooRealVar*>(var);
+      if (!realVar) {
+        throw std::invalid_argument(std::string("RooDataSetHelper: the columns must be RooRealVars, ")
+            + var->GetName() + " is not.");
+      }
+      _min.push_back(realVar->getMin());
+      _max.push_back(realVar->getMax());
+    }
+
+    _dataset->convertToVectorStore();
+  }
+
+  RooDataSetHelper(RooDataSetHelper&&) = default;
+  RooDataSetHelper(const RooDataSetHelper&) = delete;
+
+  std::shared_ptr<RooDataSet> GetResultPtr() const { return _dataset; }
+
+  void Initialize() {}
+  void InitTask(TTreeReader*, unsigned int) {}
+
+  /// Append the values of an event to the columns of the thread.
+  template <typename... ColumnTypes>
+  void Exec(unsigned int slot, ColumnTypes... values)
+  {
+    static_assert(sizeof...(ColumnTypes) > 0, "RooDataSetHelper needs at least one column.");
+    const double event[] = {static_cast<double>(values)...};
+    if (sizeof...(ColumnTypes) != _min.size()) {
+      throw std::invalid_argument("RooDataSetHelper: the number of columns differs from the number of variables.");
+    }
+
+    for (std::size_t i = 0; i < _min.size(); ++i) {
+      if (event[i] < _min[i] || event[i] > _max[i])
+        return;
+    }
+
+    auto& columns = _columns[slot];
+    for (std::size_t i = 0; i < _min.size(); ++i) {
+      columns[i].push_back(event[i]);
+    }
+  }
+
+  /// Move the columns into the dataset.
+  void Finalize()
+  {
+    std::vector<std::vector<double>> columns(std::move(_columns.front()));
+    for (std::size_t slot = 1; slot < _columns.size(); ++slot) {
+      for (std::size_t i = 0; i < columns.size(); ++i) {
+        auto& slotColumn = _columns[slot][i];
+        if (columns[i].empty())
+          columns[i].swap(slotColumn);
+        else
+          columns[i].insert(columns[i].end(), slotColumn.begin(), slotColumn.end());
+        std::vector<double>().swap(slotColumn);
+      }
+    }
+
+    auto store = static_cast<RooVectorDataStore*>(_dataset->store());
+    store->adoptColumns(_vars, std::move(columns));
+  }
+
+  std::string GetActionName() { return "RooDataSetHelper"; }
+
+private:
+  std::shared_ptr<RooDataSet> _dataset;
+  RooArgList _vars;
+  std::vector<double> _min;
+  std::vector<double> _max;
+  std::vector<std::vector<std::vector<double>>> _columns; // columns of each slot
+};
+
+#endif /* ROOFIT_ROOFITCORE_INC_ROODATASETHELPER_H_ */
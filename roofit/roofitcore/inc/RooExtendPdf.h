@@ -30,6 +30,7 @@ public:
   virtual ~RooExtendPdf() ;
 
   Double_t evaluate() const { return _pdf ; }
+  RooSpan<double> evaluateBatch(std::size_t begin, std::size_t batchSize) const ;
 
   Bool_t forceAnalyticalInt(const RooAbsArg& /*dep*/) const { return kTRUE ; }
   Int_t getAnalyticalIntegralWN(RooArgSet& allVars, RooArgSet& analVars, const RooArgSet* normSet, const char* rangeName=0) const {
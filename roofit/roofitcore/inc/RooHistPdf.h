@@ -91,6 +91,7 @@ protected:
   Bool_t importWorkspaceHook(RooWorkspace& ws) ;
   
   Double_t evaluate() const;
+  RooSpan<double> evaluateBatch(std::size_t begin, std::size_t batchSize) const;
   Double_t totalVolume() const ;
   friend class RooAbsCachedPdf ;
   Double_t totVolume() const ;
@@ -53,6 +53,7 @@ public:
   void setOffsetting(Bool_t flag) ;
   void setMaxIterations(Int_t n) ;
   void setMaxFunctionCalls(Int_t n) ; 
+  void setComponentGradient(Bool_t flag=kTRUE) ;
 
   RooFitResult* fit(const char* options) ;
 
@@ -102,8 +103,9 @@ protected:
   inline std::ofstream* logfile() { return fitterFcn()->GetLogFile(); }
   inline Double_t& maxFCN() { return fitterFcn()->GetMaxFCN() ; }
   
-  const RooMinimizerFcn* fitterFcn() const {  return ( fitter()->GetFCN() ? ((RooMinimizerFcn*) fitter()->GetFCN()) : _fcn ) ; }
-  RooMinimizerFcn* fitterFcn() { return ( fitter()->GetFCN() ? ((RooMinimizerFcn*) fitter()->GetFCN()) : _fcn ) ; }
+  const RooMinimizerFcn* fitterFcn() const ;
+  RooMinimizerFcn* fitterFcn() ;
+  bool fitFcn() const ;
 
 private:
 
@@ -111,6 +113,7 @@ private:
   Int_t       _status ;
   Bool_t      _optConst ;
   Bool_t      _profile ;
+  Bool_t      _componentGradient ;
   RooAbsReal* _func ;
 
   Bool_t      _verbose ;
@@ -27,12 +27,15 @@
 
 #include <iostream>
 #include <fstream>
+#include <utility>
 #include <vector>
 
 class RooMinimizer;
 
 class RooMinimizerFcn : public ROOT::Math::IBaseFunctionMultiDim {
 
+  friend class RooMinimizerGradFcn;
+
  public:
 
   RooMinimizerFcn(RooAbsReal *funct, RooMinimizer *context, 
@@ -104,5 +107,35 @@ private:
 
 };
 
+
+// Gradient of a RooMinimizerFcn from central finite differences, which only
+// recalculates the terms of the function that depend on the varied parameter
+class RooMinimizerGradFcn : public ROOT::Math::IMultiGradFunction {
+
+ public:
+
+  RooMinimizerGradFcn(RooMinimizerFcn& fcn) : _fcn(&fcn) {}
+
+  virtual ROOT::Math::IMultiGradFunction* Clone() const { return new RooMinimizerGradFcn(*_fcn) ; }
+  virtual unsigned int NDim() const { return _fcn->NDim() ; }
+  virtual void Gradient(const double* x, double* grad) const;
+
+  RooMinimizerFcn* fcn() const { return _fcn ; }
+
+ private:
+
+  virtual double DoEval(const double* x) const { return (*_fcn)(x) ; }
+  virtual double DoDerivative(const double* x, unsigned int icoord) const;
+
+  void findComponents() const;
+  double partialDerivative(unsigned int index, double value) const;
+
+  RooMinimizerFcn* _fcn; // Function whose gradient is calculated, not owned
+
+  mutable std::vector<std::pair<RooAbsReal*,double> > _components; // Terms of the function and their weights
+  mutable std::vector<std::vector<std::size_t> > _paramComponents; // Indices of the terms depending on each parameter
+
+};
+
 #endif
 #endif
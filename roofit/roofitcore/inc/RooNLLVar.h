@@ -21,14 +21,18 @@
 #include "RooAbsPdf.h"
 #include <vector>
 #include <utility>
+#include <memory>
 
 class RooRealSumPdf ;
+namespace BatchHelpers {
+class DeviceContext;
+}
 
 class RooNLLVar : public RooAbsOptTestStatistic {
 public:
 
   // Constructors, assignment etc
-  RooNLLVar() { _first = kTRUE ; }
+  RooNLLVar();
   RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbsData& data,
 	    const RooCmdArg& arg1=RooCmdArg::none(), const RooCmdArg& arg2=RooCmdArg::none(),const RooCmdArg& arg3=RooCmdArg::none(),
 	    const RooCmdArg& arg4=RooCmdArg::none(), const RooCmdArg& arg5=RooCmdArg::none(),const RooCmdArg& arg6=RooCmdArg::none(),
@@ -50,7 +54,11 @@ public:
   virtual RooAbsTestStatistic* create(const char *name, const char *title, RooAbsReal& pdf, RooAbsData& adata,
 				      const RooArgSet& projDeps, const char* rangeName, const char* addCoefRangeName=0, 
 				      Int_t nCPU=1, RooFit::MPSplit interleave=RooFit::BulkPartition, Bool_t verbose=kTRUE, Bool_t splitRange=kFALSE, Bool_t binnedL=kFALSE) {
-    return new RooNLLVar(name,title,(RooAbsPdf&)pdf,adata,projDeps,_extended,rangeName, addCoefRangeName, nCPU, interleave,verbose,splitRange,kFALSE,binnedL) ;
+    auto nll = new RooNLLVar(name,title,(RooAbsPdf&)pdf,adata,projDeps,_extended,rangeName, addCoefRangeName, nCPU, interleave,verbose,splitRange,kFALSE,binnedL) ;
+    nll->batchMode(_batchEvaluations) ;
+    nll->deviceMode(_deviceEvaluations) ;
+    nll->applyWeightSquared(_weightSq) ;
+    return nll ;
   }
   
   virtual ~RooNLLVar();
@@ -63,6 +71,12 @@ public:
     _batchEvaluations = on;
   }
 
+  /// Compute the batches on a CUDA device if one is available, see BatchHelpers::DeviceContext.
+  /// Only effective in batch mode.
+  void deviceMode(bool on = true) {
+    _deviceEvaluations = on;
+  }
+
 protected:
 
   virtual Bool_t processEmptyDataSets() const { return _extended ; }
@@ -77,8 +91,12 @@ private:
   std::tuple<double, double, double> computeScalar(
         std::size_t stepSize, std::size_t firstEvent, std::size_t lastEvent) const;
 
+  bool computeOnDevice(std::size_t firstEvent, std::size_t lastEvent,
+      std::tuple<double, double, double>& result) const;
+
   Bool_t _extended ;
   bool _batchEvaluations{false};
+  bool _deviceEvaluations{false};
   Bool_t _weightSq ; // Apply weights squared?
   mutable Bool_t _first ; //!
   Double_t _offsetSaveW2; //!
@@ -86,6 +104,9 @@ private:
 
   mutable std::vector<Double_t> _binw ; //!
   mutable RooRealSumPdf* _binnedPdf ; //!
+  mutable std::unique_ptr<BatchHelpers::DeviceContext> _deviceContext; //! Device arrays of the events of this partition
+  mutable const RooAbsData* _deviceData{nullptr}; //! Dataset of the device context
+  mutable bool _deviceFallback{false}; //! The computation has fallen back to the host
    
   ClassDef(RooNLLVar,3) // Function representing (extended) -log(L) of p.d.f and dataset
 };
@@ -87,6 +87,7 @@ protected:
   Bool_t _respectCompSelect;
 
   const RooArgSet& parameters() const ;
+  TString numIntCacheKey() const ;
 
   enum IntOperMode { Hybrid, Analytic, PassThrough } ;
   //friend class RooAbsPdf ;
@@ -33,6 +33,7 @@ public:
 
   virtual Int_t numBoundaries() const { return _nbins + 1 ; }
   virtual Int_t binNumber(Double_t x) const  ;
+  virtual void binNumbers(const double* x, Int_t* bins, std::size_t n, Int_t coef=1) const ;
   virtual Bool_t isUniform() const { return kTRUE ; }
 
   virtual Double_t lowBound() const { return _xlo ; }
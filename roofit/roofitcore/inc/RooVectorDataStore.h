@@ -92,6 +92,9 @@ public:
   // Add rows 
   virtual void append(RooAbsDataStore& other) override;
 
+  // Replace all rows by columns of values
+  void adoptColumns(const RooArgList& vars, std::vector<std::vector<double>>&& columns);
+
   // General & bookkeeping methods
   virtual Bool_t valid() const override;
   virtual Int_t numEntries() const override { return static_cast<int>(size()); }
@@ -162,6 +162,9 @@ public:
 
   const TUUID& uuid() const { return _uuid ; }
 
+  /// Cache of expensive objects of the workspace, e.g. the values of numeric integrals. It is written
+  /// with the workspace, and can be imported into the cache of another workspace with
+  /// RooExpensiveObjectCache::importCacheObjects().
   RooExpensiveObjectCache& expensiveObjectCache() { return _eocache ; }
 
   class CodeRepo : public TObject {
@@ -0,0 +1,191 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2020, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+#include "BatchDevice.h"
+
+#include "RooArgSet.h"
+#include "RooRealVar.h"
+
+#ifdef ROOFIT_USE_CUDA
+#include "BatchDeviceKernels.h"
+
+#include <vector>
+#endif
+
+namespace BatchHelpers {
+
+#ifdef ROOFIT_USE_CUDA
+
+struct DeviceContext::Impl {
+  std::vector<double*> _buffers;       // all the device arrays, freed with the context
+  double* _partials = nullptr;         // partial sums of the reductions
+  std::vector<double> _hostPartials;
+
+  ~Impl() {
+    for (auto buffer : _buffers)
+      DeviceKernels::free(buffer);
+  }
+
+  double* allocate(std::size_t n) {
+    double* buffer = DeviceKernels::allocate(n);
+    if (buffer)
+      _buffers.push_back(buffer);
+    return buffer;
+  }
+};
+
+#else
+
+struct DeviceContext::Impl {};
+
+#endif
+
+
+DeviceContext::DeviceContext(const RooArgSet& observables, std::size_t first, std::size_t size) :
+  _impl(new Impl),
+  _observables(new RooArgSet(observables)),
+  _first(first),
+  _size(size)
+{
+}
+
+
+DeviceContext::~DeviceContext() = default;
+
+
+bool DeviceContext::isAvailable()
+{
+#ifdef ROOFIT_USE_CUDA
+  static const bool available = DeviceKernels::deviceCount() > 0;
+  return available;
+#else
+  return false;
+#endif
+}
+
+
+bool DeviceContext::dependsOnData(const RooAbsArg& arg) const
+{
+  return arg.dependsOnValue(*_observables);
+}
+
+
+const double* DeviceContext::column(const RooAbsReal& var)
+{
+  auto item = _columns.find(&var);
+  if (item != _columns.end())
+    return item->second;
+
+  double* buffer = nullptr;
+#ifdef ROOFIT_USE_CUDA
+  auto realVar = dynamic_cast<const RooRealVar*>(&var);
+  if (realVar && _observables->find(*realVar)) {
+    auto hostData = realVar->getValBatch(_first, _size);
+    if (hostData.size() == _size) {
+      buffer = _impl->allocate(_size);
+      if (buffer && !DeviceKernels::copyToDevice(buffer, hostData.data(), _size))
+        buffer = nullptr;
+    }
+  }
+#endif
+
+  _columns[&var] = buffer;
+  return buffer;
+}
+
+
+const double* DeviceContext::weights(const double* hostWeights)
+{
+#ifdef ROOFIT_USE_CUDA
+  if (!_weights) {
+    _weights = _impl->allocate(_size);
+    if (_weights && !DeviceKernels::copyToDevice(_weights, hostWeights, _size))
+      _weights = nullptr;
+  }
+#else
+  (void)hostWeights;
+#endif
+  return _weights;
+}
+
+
+double* DeviceContext::output(const RooAbsArg& node)
+{
+  double*& buffer = _outputs[&node];
+#ifdef ROOFIT_USE_CUDA
+  if (!buffer)
+    buffer = _impl->allocate(_size);
+#endif
+  return buffer;
+}
+
+
+#ifdef ROOFIT_USE_CUDA
+
+bool DeviceContext::fill(double* out, double value) { return DeviceKernels::fill(out, _size, value); }
+
+bool DeviceContext::scale(double* out, double factor) { return DeviceKernels::scale(out, _size, factor); }
+
+bool DeviceContext::axpy(double* out, const double* in, double a) { return DeviceKernels::axpy(out, in, _size, a); }
+
+bool DeviceContext::gaussian(double* out, const double* x, double mean, double sigma)
+{
+  return DeviceKernels::gaussian(out, x, _size, mean, sigma);
+}
+
+bool DeviceContext::exponential(double* out, const double* x, double c)
+{
+  return DeviceKernels::exponential(out, x, _size, c);
+}
+
+bool DeviceContext::negativeLogSum(const double* p, const double* w, double weight, bool weightSquared,
+    double& nll, double& sumWeights)
+{
+  constexpr unsigned int nBlocks = DeviceKernels::nBlocks;
+  if (!_impl->_partials) {
+    _impl->_partials = _impl->allocate(2 * nBlocks);
+    _impl->_hostPartials.resize(2 * nBlocks);
+  }
+  if (!_impl->_partials
+      || !DeviceKernels::negativeLogPartials(p, w, _size, weight, weightSquared, _impl->_partials)
+      || !DeviceKernels::copyToHost(_impl->_hostPartials.data(), _impl->_partials, 2 * nBlocks))
+    return false;
+
+  // Add the partial sums in a fixed order, so that the result does not change between evaluations
+  nll = 0.;
+  sumWeights = 0.;
+  for (unsigned int i = 0; i < nBlocks; ++i) {
+    nll += _impl->_hostPartials[i];
+    sumWeights += _impl->_hostPartials[nBlocks + i];
+  }
+  return true;
+}
+
+#else
+
+bool DeviceContext::fill(double*, double) { return false; }
+
+bool DeviceContext::scale(double*, double) { return false; }
+
+bool DeviceContext::axpy(double*, const double*, double) { return false; }
+
+bool DeviceContext::gaussian(double*, const double*, double, double) { return false; }
+
+bool DeviceContext::exponential(double*, const double*, double) { return false; }
+
+bool DeviceContext::negativeLogSum(const double*, const double*, double, bool, double&, double&) { return false; }
+
+#endif
+
+}
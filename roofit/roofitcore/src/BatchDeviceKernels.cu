@@ -0,0 +1,190 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2020, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+// CUDA memory management and kernels used by BatchHelpers::DeviceContext.
+// The pdf kernels compute the same values as the evaluate() functions of the pdfs.
+
+#include "BatchDeviceKernels.h"
+
+#include "TError.h"
+
+#include <cuda_runtime.h>
+
+namespace BatchHelpers {
+namespace DeviceKernels {
+
+namespace {
+
+bool checkCuda(cudaError_t code, const char* where)
+{
+  if (code == cudaSuccess)
+    return true;
+  Error(where, "CUDA error: %s", cudaGetErrorString(code));
+  return false;
+}
+
+/// Check for errors in the launch of the last kernel.
+bool checkLaunch(const char* where)
+{
+  return checkCuda(cudaGetLastError(), where);
+}
+
+/// Number of blocks for an element-wise kernel on n elements.
+unsigned int elementBlocks(std::size_t n)
+{
+  const std::size_t blocks = (n + nThreads - 1) / nThreads;
+  return blocks < 65535 ? (blocks > 0 ? blocks : 1) : 65535;
+}
+
+/// Sum the values of the threads of the block and store the result in *partial.
+__device__ void storePartialSum(double value, double* partial)
+{
+  __shared__ double cache[nThreads];
+  cache[threadIdx.x] = value;
+  __syncthreads();
+  for (unsigned int s = blockDim.x / 2; s > 0; s >>= 1) {
+    if (threadIdx.x < s)
+      cache[threadIdx.x] += cache[threadIdx.x + s];
+    __syncthreads();
+  }
+  if (threadIdx.x == 0)
+    *partial = cache[0];
+}
+
+#define GRID_STRIDE_LOOP(i, n) \
+  for (std::size_t i = blockIdx.x * blockDim.x + threadIdx.x; i < n; i += blockDim.x * gridDim.x)
+
+__global__ void fillKernel(double* out, std::size_t n, double value)
+{
+  GRID_STRIDE_LOOP(i, n) out[i] = value;
+}
+
+__global__ void scaleKernel(double* out, std::size_t n, double factor)
+{
+  GRID_STRIDE_LOOP(i, n) out[i] *= factor;
+}
+
+__global__ void axpyKernel(double* out, const double* in, std::size_t n, double a)
+{
+  GRID_STRIDE_LOOP(i, n) out[i] += a * in[i];
+}
+
+__global__ void gaussianKernel(double* out, const double* x, std::size_t n, double mean, double sigma)
+{
+  const double invSig2 = 1. / (sigma * sigma);
+  GRID_STRIDE_LOOP(i, n) {
+    const double arg = x[i] - mean;
+    out[i] = exp(-0.5 * arg * arg * invSig2);
+  }
+}
+
+__global__ void exponentialKernel(double* out, const double* x, std::size_t n, double c)
+{
+  GRID_STRIDE_LOOP(i, n) out[i] = exp(c * x[i]);
+}
+
+__global__ void negativeLogKernel(const double* p, const double* w, std::size_t n, double weight,
+    bool weightSquared, double* partials)
+{
+  double sum = 0.;
+  double sumWeights = 0.;
+  GRID_STRIDE_LOOP(i, n) {
+    double eventWeight = w ? w[i] : weight;
+    if (eventWeight == 0.)
+      continue;
+    if (weightSquared)
+      eventWeight *= eventWeight;
+    // as RooAbsPdf::getLogVal(), a vanishing probability gives an infinite term
+    sum -= eventWeight * log(p[i]);
+    sumWeights += eventWeight;
+  }
+  storePartialSum(sum, partials + blockIdx.x);
+  storePartialSum(sumWeights, partials + gridDim.x + blockIdx.x);
+}
+
+#undef GRID_STRIDE_LOOP
+
+} // anonymous namespace
+
+int deviceCount()
+{
+  int count = 0;
+  if (cudaGetDeviceCount(&count) != cudaSuccess)
+    return 0;
+  return count;
+}
+
+double* allocate(std::size_t n)
+{
+  void* ptr = nullptr;
+  if (!checkCuda(cudaMalloc(&ptr, n * sizeof(double)), "DeviceContext::allocate"))
+    return nullptr;
+  return static_cast<double*>(ptr);
+}
+
+void free(double* ptr)
+{
+  if (ptr)
+    cudaFree(ptr);
+}
+
+bool copyToDevice(double* dst, const double* src, std::size_t n)
+{
+  return checkCuda(cudaMemcpy(dst, src, n * sizeof(double), cudaMemcpyHostToDevice), "DeviceContext::copyToDevice");
+}
+
+bool copyToHost(double* dst, const double* src, std::size_t n)
+{
+  return checkCuda(cudaMemcpy(dst, src, n * sizeof(double), cudaMemcpyDeviceToHost), "DeviceContext::copyToHost");
+}
+
+bool fill(double* out, std::size_t n, double value)
+{
+  fillKernel<<<elementBlocks(n), nThreads>>>(out, n, value);
+  return checkLaunch("DeviceContext::fill");
+}
+
+bool scale(double* out, std::size_t n, double factor)
+{
+  scaleKernel<<<elementBlocks(n), nThreads>>>(out, n, factor);
+  return checkLaunch("DeviceContext::scale");
+}
+
+bool axpy(double* out, const double* in, std::size_t n, double a)
+{
+  axpyKernel<<<elementBlocks(n), nThreads>>>(out, in, n, a);
+  return checkLaunch("DeviceContext::axpy");
+}
+
+bool gaussian(double* out, const double* x, std::size_t n, double mean, double sigma)
+{
+  gaussianKernel<<<elementBlocks(n), nThreads>>>(out, x, n, mean, sigma);
+  return checkLaunch("DeviceContext::gaussian");
+}
+
+bool exponential(double* out, const double* x, std::size_t n, double c)
+{
+  exponentialKernel<<<elementBlocks(n), nThreads>>>(out, x, n, c);
+  return checkLaunch("DeviceContext::exponential");
+}
+
+bool negativeLogPartials(const double* p, const double* w, std::size_t n, double weight, bool weightSquared,
+    double* partials)
+{
+  negativeLogKernel<<<nBlocks, nThreads>>>(p, w, n, weight, weightSquared, partials);
+  return checkLaunch("DeviceContext::negativeLogSum");
+}
+
+}
+}
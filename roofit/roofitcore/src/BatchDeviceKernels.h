@@ -0,0 +1,61 @@
+/*****************************************************************************
+ * RooFit
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2020, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+// Internal header: CUDA memory management and kernels used by BatchHelpers::DeviceContext.
+// Implemented in BatchDeviceKernels.cu, compiled only when ROOT is built with CUDA support.
+// All pointers to double are in device memory, except the ones passed to copyToDevice as source
+// and to copyToHost as destination.
+
+#ifndef ROOFIT_ROOFITCORE_SRC_BATCHDEVICEKERNELS_H_
+#define ROOFIT_ROOFITCORE_SRC_BATCHDEVICEKERNELS_H_
+
+#include <cstddef>
+
+namespace BatchHelpers {
+namespace DeviceKernels {
+
+/// Number of thread blocks of the reductions: each block writes one partial sum per output, and
+/// the partial sums are added on the host in a fixed order.
+constexpr unsigned int nBlocks = 256;
+
+/// Number of threads per block.
+constexpr unsigned int nThreads = 256;
+
+int deviceCount();
+
+/// Allocate n doubles on the device, return nullptr on failure.
+double* allocate(std::size_t n);
+
+void free(double* ptr);
+
+bool copyToDevice(double* dst, const double* src, std::size_t n);
+
+/// Copy n doubles to the host, after waiting for the kernels launched before to complete.
+bool copyToHost(double* dst, const double* src, std::size_t n);
+
+bool fill(double* out, std::size_t n, double value);
+bool scale(double* out, std::size_t n, double factor);
+bool axpy(double* out, const double* in, std::size_t n, double a);
+bool gaussian(double* out, const double* x, std::size_t n, double mean, double sigma);
+bool exponential(double* out, const double* x, std::size_t n, double c);
+
+/// Partial sums of `-w * log(p)` and of the weights, in partials[0, nBlocks) and partials[nBlocks, 2 * nBlocks).
+/// The weights are the array w, or the constant weight if w is null, squared if weightSquared.
+bool negativeLogPartials(const double* p, const double* w, std::size_t n, double weight, bool weightSquared,
+    double* partials);
+
+}
+}
+
+#endif /* ROOFIT_ROOFITCORE_SRC_BATCHDEVICEKERNELS_H_ */
@@ -68,6 +68,7 @@ setting/clearing/testing named attributes.
 #include <sstream>
 #include <cstring>
 #include <algorithm>
+#include <atomic>
 
 using namespace std;
 
@@ -818,6 +819,17 @@ Bool_t RooAbsArg::observableOverlaps(const RooArgSet* nset, const RooAbsArg& tes
 
 
 
+namespace {
+
+/// Return a new number identifying a propagation of dirty flags through the graph.
+unsigned long newDirtyPropagation()
+{
+  static std::atomic<unsigned long> counter{0};
+  return ++counter;
+}
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Mark this object as having changed its value, and propagate this status
 /// change to all of our clients. If the object is not in automatic dirty
@@ -835,6 +847,28 @@ void RooAbsArg::setValueDirty(const RooAbsArg* source)
     return ;
   }
 
+  propagateValueDirty(source, newDirtyPropagation()) ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Raise the value dirty flag of this object and its clients. Every node is visited
+/// once per propagation: in graphs where clients share servers, such as large
+/// HistFactory models, the flag otherwise reaches a node once for each path from
+/// the source.
+
+void RooAbsArg::propagateValueDirty(const RooAbsArg* source, unsigned long propagation)
+{
+  _allBatchesDirty = true;
+
+  if (_operMode!=Auto || _inhibitDirty) return ;
+
+  // Handle no-propagation scenarios first
+  if (_clientListValue.size() == 0) {
+    _valueDirty = kTRUE ;
+    return ;
+  }
+
   // Cyclical dependency interception
   if (source==0) {
     source=this ;
@@ -846,6 +880,10 @@ void RooAbsArg::setValueDirty(const RooAbsArg* source)
     return ;
   }
 
+  // This node and its clients have already been reached in this propagation
+  if (_valueDirtyPropagation == propagation) return ;
+  _valueDirtyPropagation = propagation ;
+
   // Propagate dirty flag to all clients if this is a down->up transition
   if (_verboseDirty) {
     cxcoutD(LinkStateMgmt) << "RooAbsArg::setValueDirty(" << (source?source->GetName():"self") << "->" << GetName() << "," << this
@@ -856,10 +894,8 @@ void RooAbsArg::setValueDirty(const RooAbsArg* source)
 
 
   for (auto client : _clientListValue) {
-    client->setValueDirty(source) ;
+    client->propagateValueDirty(source, propagation) ;
   }
-
-
 }
 
 
@@ -868,6 +904,16 @@ void RooAbsArg::setValueDirty(const RooAbsArg* source)
 /// change to all of our clients.
 
 void RooAbsArg::setShapeDirty(const RooAbsArg* source)
+{
+  propagateShapeDirty(source, newDirtyPropagation()) ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Raise the shape and value dirty flags of this object and its clients, visiting
+/// every node once per propagation.
+
+void RooAbsArg::propagateShapeDirty(const RooAbsArg* source, unsigned long propagation)
 {
   if (_verboseDirty) {
     cxcoutD(LinkStateMgmt) << "RooAbsArg::setShapeDirty(" << GetName()
@@ -889,12 +935,16 @@ void RooAbsArg::setShapeDirty(const RooAbsArg* source)
     return ;
   }
 
+  // This node and its clients have already been reached in this propagation
+  if (_shapeDirtyPropagation == propagation) return ;
+  _shapeDirtyPropagation = propagation ;
+
   // Propagate dirty flag to all clients if this is a down->up transition
   _shapeDirty=kTRUE ;
 
   for (auto client : _clientListShape) {
-    client->setShapeDirty(source) ;
-    client->setValueDirty(source) ;
+    client->propagateShapeDirty(source, propagation) ;
+    client->propagateValueDirty(source, propagation) ;
   }
 
 }
@@ -56,6 +56,21 @@ RooAbsBinning::~RooAbsBinning()
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the bin numbers of the `n` values in `x`, and add them multiplied by
+/// `coef` to the `n` elements of `bins`. This allows to compute the linear index of
+/// bins in several dimensions. Binnings with a fast bin lookup override this, the
+/// default calls binNumber() for each value.
+
+void RooAbsBinning::binNumbers(const double* x, Int_t* bins, std::size_t n, Int_t coef) const
+{
+  for (std::size_t i = 0; i < n; ++i) {
+    bins[i] += coef * binNumber(x[i]) ;
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Print binning name
 
@@ -172,6 +172,7 @@ called for each data event.
 #include "RooWorkspace.h"
 
 #include "RooHelpers.h"
+#include "BatchDevice.h"
 #include "RooVDTHeaders.h"
 
 #include "TClass.h"
@@ -398,6 +399,40 @@ RooSpan<const double> RooAbsPdf::getValBatch(std::size_t begin, std::size_t maxS
   return ret;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values of the p.d.f. for the events of a device context, normalised
+/// by integrating over the observables in `normSet` as in getValBatch(). The
+/// normalisation integral is computed on the host, and applied on the device.
+/// \return Device array with the results, or nullptr if the p.d.f. cannot be computed
+/// on the device.
+const double* RooAbsPdf::getDeviceBatch(BatchHelpers::DeviceContext& context, const RooArgSet* normSet) const
+{
+  getValV(normSet);
+
+  if (!normSet) {
+    RooArgSet* tmp = _normSet ;
+    _normSet = nullptr;
+    double* outputs = evaluateDeviceBatch(context);
+    _normSet = tmp;
+    return outputs;
+  }
+
+  double* outputs = evaluateDeviceBatch(context);
+  if (!outputs)
+    return nullptr;
+
+  const double normVal = _norm->getVal();
+  if (normVal < 0.) {
+    logEvalError(Form("p.d.f normalization integral is zero or negative."
+        "\n\tInt(%s) = %f", GetName(), normVal));
+  }
+
+  if (normVal != 1. && normVal > 0. && !context.scale(outputs, 1./normVal))
+    return nullptr;
+
+  return outputs;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Analytical integral with normalization (see RooAbsReal::analyticalIntegralWN() for further information)
 ///
@@ -868,7 +903,10 @@ Double_t RooAbsPdf::extendedTerm(Double_t observed, const RooArgSet* nset) const
 ///   <tr><td> 3 = RooFit::Hybrid <td> Follow strategy 0 for all RooSimultaneous components, except those with less than
 ///                     30 dataset entries, for which strategy 2 is followed.
 ///   </table>
+/// <tr><td> `NumThreads(int num)`             <td> Parallelize NLL calculation on `num` threads of the implicit multithreading pool of ROOT
+///                                               (all the threads of the pool if `num` is 0). See RooAbsTestStatistic::setNumThreads().
 /// <tr><td> `BatchMode(bool on)`              <td> Batch evaluation mode. See createNLL().
+/// <tr><td> `BatchMode(const char* mode)`     <td> Batch evaluation mode `"off"`, `"cpu"` or `"cuda"`. See createNLL().
 /// <tr><td> `Optimize(Bool_t flag)`           <td> Activate constant term optimization (on by default)
 /// <tr><td> `SplitRange(Bool_t flag)`         <td> Use separate fit ranges in a simultaneous fit. Actual range name for each subsample is assumed to
 ///                                               be `rangeName_indexState`, where `indexState` is the state of the master index category of the simultaneous fit.
@@ -929,6 +967,7 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   pc.defineInt("ext","Extended",0,2) ;
   pc.defineInt("numcpu","NumCPU",0,1) ;
   pc.defineInt("interleave","NumCPU",1,0) ;
+  pc.defineInt("numthreads","NumThreads",0,1) ;
   pc.defineInt("verbose","Verbose",0,0) ;
   pc.defineInt("optConst","Optimize",0,0) ;
   pc.defineInt("cloneData","CloneData", 0, 2);
@@ -964,6 +1003,7 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   }
   RooFit::MPSplit interl = (RooFit::MPSplit) numcpu_strategy;
 
+  Int_t numthreads = pc.getInt("numthreads") ;
   Int_t splitr   = pc.getInt("splitRange") ;
   Bool_t verbose = pc.getInt("verbose") ;
   Int_t optConst = pc.getInt("optConst") ;
@@ -1053,6 +1093,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
         *this,data,projDeps,ext,rangeName,addCoefRangeName,numcpu,interl,
         verbose,splitr,cloneData);
     theNLL->batchMode(pc.getInt("BatchMode"));
+    theNLL->deviceMode(pc.getInt("BatchMode") == 2);
+    theNLL->setNumThreads(numthreads);
     nll = theNLL;
   } else {
     // Composite case: multiple ranges
@@ -1063,6 +1105,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
           *this,data,projDeps,ext,token.c_str(),addCoefRangeName,numcpu,interl,
           verbose,splitr,cloneData);
       nllComp->batchMode(pc.getInt("BatchMode"));
+      nllComp->deviceMode(pc.getInt("BatchMode") == 2);
+      nllComp->setNumThreads(numthreads);
       nllList.add(*nllComp) ;
     }
     nll = new RooAddition(baseName.c_str(),"-log(likelihood)",nllList,kTRUE) ;
@@ -1173,6 +1217,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
 ///   <tr><td> 3 = RooFit::Hybrid <td> Follow strategy 0 for all RooSimultaneous components, except those with less than
 ///                     30 dataset entries, for which strategy 2 is followed.
 ///   </table>
+/// <tr><td> `NumThreads(int num)`             <td>  Parallelize NLL calculation on `num` threads of the implicit multithreading pool of ROOT,
+///                                                instead of processes. See createNLL().
 /// <tr><td> `SplitRange(Bool_t flag)`          <td>  Use separate fit ranges in a simultaneous fit. Actual range name for each subsample is assumed
 ///                                                 to by `rangeName_indexState` where indexState is the state of the master index category of the simultaneous fit.
 /// Using `Range("range"), SplitRange()` as switches, different ranges could be set like this:
@@ -1193,6 +1239,11 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
 ///                                                          implemented for the PDFs of the model, likelihood computations are 2x to 10x faster.
 ///                                                          The relative difference of the single log-likelihoods w.r.t. the legacy mode is usually better than 1.E-12,
 ///                                                          and fit parameters usually agree to better than 1.E-6.
+/// <tr><td> `BatchMode(const char* mode)`              <td> Batch evaluation mode `"off"`, `"cpu"` (same as `BatchMode(true)`) or `"cuda"`.
+///                                                          In `"cuda"` mode, the data are copied to a CUDA device once, and the p.d.f.s which support it
+///                                                          (see BatchHelpers::DeviceContext) and the sum of the log-likelihood are computed on the device.
+///                                                          If ROOT was built without CUDA support (`cuda=ON`), if no device is found or the model
+///                                                          contains p.d.f.s which cannot be computed on the device, the batches are computed on the host.
 ///
 /// <tr><th><th> Options to control flow of fit procedure
 /// <tr><td> `Minimizer(type,algo)`   <td>  Choose minimization package and algorithm to use. Default is MINUIT/MIGRAD through the RooMinimizer interface,
@@ -1288,7 +1339,7 @@ RooFitResult* RooAbsPdf::fitTo(RooAbsData& data, const RooLinkedList& cmdList)
   RooLinkedList fitCmdList(cmdList) ;
   RooLinkedList nllCmdList = pc.filterCmdList(fitCmdList,"ProjectedObservables,Extended,Range,"
       "RangeWithName,SumCoefRange,NumCPU,SplitRange,Constrained,Constrain,ExternalConstraints,"
-      "CloneData,GlobalObservables,GlobalObservablesTag,OffsetLikelihood,BatchMode");
+      "CloneData,GlobalObservables,GlobalObservablesTag,OffsetLikelihood,BatchMode,NumThreads");
 
   pc.defineDouble("prefit", "Prefit",0,0);
   pc.defineString("fitOpt","FitOptions",0,"") ;
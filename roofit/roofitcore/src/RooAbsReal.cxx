@@ -83,6 +83,7 @@
 #include "RooVectorDataStore.h"
 #include "RooCachedReal.h"
 #include "RooHelpers.h"
+#include "BatchDevice.h"
 
 #include "Compression.h"
 #include "Math/IFunction.h"
@@ -106,6 +107,7 @@
 #include <sstream>
 #include <iostream>
 #include <iomanip>
+#include <mutex>
 
 using namespace std ;
 
@@ -318,6 +320,23 @@ RooSpan<const double> RooAbsReal::getValBatch(std::size_t begin, std::size_t max
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the values of the object for the events of a device context, in an array
+/// in the memory of the device. The observables of the dataset are the columns of the
+/// context, all other objects are computed with evaluateDeviceBatch().
+/// \param[in] context Device context holding the events and the device arrays.
+/// \param[in] normSet Variables to normalise over.
+/// \return Device array of size `context.size()`, or nullptr if this object or one of its
+/// servers cannot be computed on the device.
+const double* RooAbsReal::getDeviceBatch(BatchHelpers::DeviceContext& context, const RooArgSet* normSet) const {
+  if (auto column = context.column(*this))
+    return column;
+
+  getValV(normSet);
+  return evaluateDeviceBatch(context);
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooAbsReal::numEvalErrorItems()
@@ -3667,6 +3686,18 @@ Double_t RooAbsReal::maxVal(Int_t /*code*/) const
 
 
 
+namespace {
+
+/// Mutex protecting the log of evaluation errors
+std::recursive_mutex& evalErrorMutex()
+{
+  static std::recursive_mutex mutex ;
+  return mutex ;
+}
+
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Interface to insert remote error logging messages received by RooRealMPFE into current error loggin stream
 
@@ -3676,6 +3707,9 @@ void RooAbsReal::logEvalError(const RooAbsReal* originator, const char* origName
     return ;
   }
 
+  // Errors can be logged concurrently by test statistics evaluated in multiple threads
+  std::lock_guard<std::recursive_mutex> lock(evalErrorMutex()) ;
+
   if (_evalErrorMode==CountErrors) {
     _evalErrorCount++ ;
     return ;
@@ -3731,6 +3765,9 @@ void RooAbsReal::logEvalError(const char* message, const char* serverValueString
     return ;
   }
 
+  // Errors can be logged concurrently by test statistics evaluated in multiple threads
+  std::lock_guard<std::recursive_mutex> lock(evalErrorMutex()) ;
+
   if (_evalErrorMode==CountErrors) {
     _evalErrorCount++ ;
     return ;
@@ -4922,6 +4959,17 @@ RooSpan<double> RooAbsReal::evaluateBatch(std::size_t begin, std::size_t maxSize
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values of the object for the events of a device context. Classes
+/// supporting the evaluation on a CUDA device override this to run their kernels
+/// on the device arrays of their servers, see BatchHelpers::DeviceContext.
+/// \return Device array of size `context.size()` with the results, or nullptr if the
+/// object cannot be computed on the device. This is what this default implementation returns.
+double* RooAbsReal::evaluateDeviceBatch(BatchHelpers::DeviceContext& /*context*/) const {
+  return nullptr;
+}
+
+
 
 
 #include "TSystem.h"
@@ -32,6 +32,11 @@ organizes multi-processor parallel calculation of test statistic
 values. For the latter, the test statistic value is calculated in
 partitions in parallel executing processes and a posteriori
 combined in the main thread.
+
+Alternatively, the partitions can be calculated in the threads of
+the ROOT thread pool, see setNumThreads(). Each partition holds its
+own clone of the function and its own slice of the data, so that
+no state is shared between the threads but the parameters.
 **/
 
 #include "RooAbsTestStatistic.h"
@@ -40,6 +45,7 @@ combined in the main thread.
 #include "RooAbsPdf.h"
 #include "RooSimultaneous.h"
 #include "RooAbsData.h"
+#include "RooDataSet.h"
 #include "RooArgSet.h"
 #include "RooRealVar.h"
 #include "RooNLLVar.h"
@@ -54,17 +60,40 @@ combined in the main thread.
 #include "TClass.h"
 #include <string>
 
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
 using namespace std;
 
 ClassImp(RooAbsTestStatistic);
 
+namespace {
+
+/// Evaluate the given test statistics, in parallel in the threads of the ROOT thread pool if available.
+/// The values are cached in the test statistics and retrieved afterwards with getValV() and getCarry().
+void evaluateInParallel(const std::vector<RooAbsTestStatistic*>& gofs)
+{
+#ifdef R__USE_IMT
+  if (gofs.size()>1) {
+    ROOT::TThreadExecutor pool ;
+    pool.Foreach([&gofs](unsigned int i) { gofs[i]->getVal() ; }, ROOT::TSeqU(gofs.size())) ;
+    return ;
+  }
+#endif
+  for (auto gof : gofs) gof->getVal() ;
+}
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor
 
 RooAbsTestStatistic::RooAbsTestStatistic() :
   _func(0), _data(0), _projDeps(0), _splitRange(0), _simCount(0),
   _verbose(kFALSE), _init(kFALSE), _gofOpMode(Slave), _nEvents(0), _setNum(0),
-  _numSets(0), _extSet(0), _nGof(0), _gofArray(0), _nCPU(1), _mpfeArray(0),
+  _numSets(0), _extSet(0), _nGof(0), _gofArray(0), _nCPU(1), _mpfeArray(0), _nThreads(1),
   _mpinterl(RooFit::BulkPartition), _doOffset(kFALSE), _offset(0),
   _offsetCarry(0), _evalCarry(0)
 {
@@ -114,6 +143,7 @@ RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, Ro
   _gofArray(0),
   _nCPU(nCPU),
   _mpfeArray(0),
+  _nThreads(1),
   _mpinterl(interleave),
   _doOffset(kFALSE),
   _offset(0),
@@ -173,6 +203,7 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
   _gofSplitMode(other._gofSplitMode),
   _nCPU(other._nCPU),
   _mpfeArray(0),
+  _nThreads(other._nThreads),
   _mpinterl(other._mpinterl),
   _doOffset(other._doOffset),
   _offset(other._offset),
@@ -228,12 +259,37 @@ RooAbsTestStatistic::~RooAbsTestStatistic()
     delete[] _gofArray ;
   }
 
+  deleteMTMode() ;
+
   delete _projDeps ;
 
 }
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the test statistics of the components of a RooSimultaneous, whose
+/// sum divided by globalNormalization() is the value of this test statistic.
+/// Each component is a client of the parameters of its own p.d.f. only, so
+/// that it is only recalculated when one of these parameters changes.
+/// Returns an empty vector if the test statistic is not calculated per component
+/// in this process.
+
+std::vector<RooAbsTestStatistic*> RooAbsTestStatistic::simComponents() const
+{
+  if (!_init) {
+    const_cast<RooAbsTestStatistic*>(this)->initialize() ;
+  }
+
+  std::vector<RooAbsTestStatistic*> components ;
+  if (SimMaster == _gofOpMode && numSets() == 1) {
+    components.assign(_gofArray, _gofArray + _nGof) ;
+  }
+  return components ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate and return value of test statistic. If the test statistic
 /// is calculated from a RooSimultaneous, the test statistic calculation
@@ -252,6 +308,15 @@ Double_t RooAbsTestStatistic::evaluate() const
     // Evaluate array of owned GOF objects
     Double_t ret = 0.;
 
+    // Evaluate the components concurrently in the thread pool first, combinedValue() picks up their cached values
+    if (effectiveNumThreads()>1 && numSets()==1) {
+      std::vector<RooAbsTestStatistic*> gofs ;
+      for (Int_t i = 0 ; i < _nGof; ++i) {
+	if (_gofArray[i]->operMode()!=MPMaster) gofs.push_back(_gofArray[i]) ;
+      }
+      evaluateInParallel(gofs) ;
+    }
+
     if (_mpinterl == RooFit::BulkPartition || _mpinterl == RooFit::Interleave ) {
       ret = combinedValue((RooAbsReal**)_gofArray,_nGof);
     } else {
@@ -299,6 +364,49 @@ Double_t RooAbsTestStatistic::evaluate() const
     _evalCarry = carry;
     return ret ;
 
+  } else if (!_mtArray.empty()) {
+
+    // This instance calculates the first slice of the data, including the extended term, and the
+    // partitions the other slices, all of them in the threads of the ROOT thread pool
+    const Int_t nPart = _mtArray.size() + 1 ;
+    const Int_t nEvents = _data->numEntries() ;
+    Double_t ret = 0., retCarry = 0. ;
+#ifdef R__USE_IMT
+    ROOT::TThreadExecutor pool ;
+    pool.Foreach([&](unsigned int i) {
+      if (i==0) {
+	ret = evaluatePartition(0,nEvents/nPart,1) ;
+	retCarry = _evalCarry ;
+      } else {
+	_mtArray[i-1]->getVal() ;
+      }
+    }, ROOT::TSeqU(nPart)) ;
+#else
+    ret = evaluatePartition(0,nEvents/nPart,1) ;
+    retCarry = _evalCarry ;
+    evaluateInParallel(_mtArray) ;
+#endif
+
+    Double_t sum(ret), carry(retCarry) ;
+    for (auto gof : _mtArray) {
+      Double_t y = gof->getValV();
+      carry += gof->getCarry();
+      y -= carry;
+      const Double_t t = sum + y;
+      carry = (t - sum) - y;
+      sum = t;
+    }
+    ret = sum ;
+    _evalCarry = carry;
+
+    if (numSets()==1) {
+      const Double_t norm = globalNormalization();
+      ret /= norm;
+      _evalCarry /= norm;
+    }
+
+    return ret ;
+
   } else {
 
     // Evaluate as straight FUNC
@@ -356,6 +464,8 @@ Bool_t RooAbsTestStatistic::initialize()
     initMPMode(_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
   } else if (SimMaster == _gofOpMode) {
     initSimMode((RooSimultaneous*)_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
+  } else if (_nThreads!=1 && _mtArray.empty()) {
+    initMTMode() ;
   }
   _init = kTRUE;
   return kFALSE;
@@ -383,6 +493,10 @@ Bool_t RooAbsTestStatistic::redirectServersHook(const RooAbsCollection& newServe
 // 	cout << "redirecting servers on " << _mpfeArray[i]->GetName() << endl;
       }
     }
+  } else if (Slave == _gofOpMode) {
+    for (auto gof : _mtArray) {
+      gof->recursiveRedirectServers(newServerList,mustReplaceAll,nameChange);
+    }
   }
   return kFALSE;
 }
@@ -433,6 +547,10 @@ void RooAbsTestStatistic::constOptimizeTestStatistic(ConstOpCode opcode, Bool_t
     for (Int_t i = 0; i < _nCPU; ++i) {
       _mpfeArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
     }
+  } else {
+    for (auto gof : _mtArray) {
+      gof->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
+    }
   }
 }
 
@@ -596,6 +714,13 @@ void RooAbsTestStatistic::initSimMode(RooSimultaneous* simpdf, RooAbsData* data,
 
       _gofArray[n]->recursiveRedirectServers(*selTargetParams);
 
+      // Share the threads between the components in proportion to their number of events. The partitions
+      // are created now, as the components are evaluated concurrently
+      if (effectiveNumThreads()>1) {
+	_gofArray[n]->setNumThreads(componentThreads(dset->numEntries(),data->numEntries())) ;
+	_gofArray[n]->initialize() ;
+      }
+
       delete selTargetParams;
       delete actualParams;
 
@@ -632,8 +757,10 @@ Bool_t RooAbsTestStatistic::setData(RooAbsData& indata, Bool_t cloneData)
 
   switch(operMode()) {
   case Slave:
-    // Delegate to implementation
-    return setDataSlave(indata, cloneData);
+    // Delegate to implementation, and slice the new dataset for the threads
+    if (!setDataSlave(indata, cloneData)) return kFALSE;
+    if (!_mtArray.empty()) initMTMode();
+    return kTRUE;
   case SimMaster:
     // Forward to slaves
     //     cout << "RATS::setData(" << GetName() << ") SimMaster, calling setDataSlave() on slave nodes" << endl;
@@ -695,6 +822,9 @@ void RooAbsTestStatistic::enableOffsetting(Bool_t flag)
       _offset = 0 ;
       _offsetCarry = 0;
     }
+    for (auto gof : _mtArray) {
+      gof->enableOffsetting(flag);
+    }
     setValueDirty() ;
     break ;
   case SimMaster:
@@ -713,5 +843,145 @@ void RooAbsTestStatistic::enableOffsetting(Bool_t flag)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the test statistic in `nThreads` partitions, evaluated concurrently in the threads of
+/// the ROOT thread pool, instead of a single pass over the data. If `nThreads` is 0, the number of
+/// threads of the pool is used (see ROOT::EnableImplicitMT()), and 1 switches the feature off.
+///
+/// Each partition owns a clone of the function and a contiguous slice of the data (or a copy of
+/// binned data, of which it evaluates a contiguous range of bins), so that the threads share only
+/// the parameters, which are not modified during the calculation. For a RooSimultaneous, the
+/// components are evaluated concurrently and each of them is split in a number of partitions
+/// proportional to its number of events, so that the load of the threads is balanced by the
+/// scheduler of the thread pool.
+///
+/// Unlike the multi-process calculation with NumCPU, the partitions do not need to be synchronized
+/// with the parameters through a pipe at each evaluation. Both modes cannot be combined: the
+/// request is ignored for a test statistic calculated in multiple processes.
+
+void RooAbsTestStatistic::setNumThreads(Int_t nThreads)
+{
+#ifndef R__USE_IMT
+  if (nThreads!=1) {
+    coutW(Eval) << "RooAbsTestStatistic::setNumThreads(" << GetName() << ") WARNING: ROOT was built without "
+		<< "multithreading support (imt=OFF), calculating test statistic in a single thread" << endl ;
+  }
+  return ;
+#else
+  if (nThreads<0) nThreads = 1 ;
+  if (nThreads==_nThreads) return ;
+
+  if (MPMaster == _gofOpMode || _nCPU>1) {
+    if (nThreads!=1) {
+      coutW(Eval) << "RooAbsTestStatistic::setNumThreads(" << GetName() << ") WARNING: test statistic is calculated "
+		  << "in " << _nCPU << " processes, ignoring request for " << nThreads << " threads" << endl ;
+    }
+    return ;
+  }
+
+  _nThreads = nThreads ;
+
+  if (SimMaster == _gofOpMode) {
+    if (_init) {
+      Int_t nTotal(0) ;
+      for (Int_t i = 0; i < _nGof; ++i) nTotal += _gofArray[i]->_nEvents ;
+      for (Int_t i = 0; i < _nGof; ++i) {
+	_gofArray[i]->setNumThreads(componentThreads(_gofArray[i]->_nEvents,nTotal)) ;
+	_gofArray[i]->initialize() ;
+      }
+    }
+  } else if (_init) {
+    deleteMTMode() ;
+    if (_nThreads!=1) initMTMode() ;
+  }
+  setValueDirty() ;
+#endif
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of threads of a component of a simultaneous test statistic with
+/// `nEvents` events out of `nTotal`: the threads are shared between the components in
+/// proportion to their number of events.
+
+Int_t RooAbsTestStatistic::componentThreads(Int_t nEvents, Int_t nTotal) const
+{
+  const Int_t nThreads = effectiveNumThreads() ;
+  if (nThreads<=1 || nTotal<=0) return 1 ;
+  const Int_t k = Int_t((Long64_t(nEvents)*nThreads + nTotal - 1) / nTotal) ;
+  return std::max(1,std::min(nThreads,k)) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of partitions to use for a requested number of threads of 0, i.e. the size
+/// of the ROOT thread pool, or the requested number of threads otherwise.
+
+Int_t RooAbsTestStatistic::effectiveNumThreads() const
+{
+#ifdef R__USE_IMT
+  if (_nThreads==0) {
+    return ROOT::IsImplicitMTEnabled() ? Int_t(ROOT::GetThreadPoolSize()) : 1 ;
+  }
+#endif
+  return _nThreads ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Initialize multi-threaded calculation mode. Create the test statistics of all partitions but
+/// the first one, which is calculated by this instance: they are created from the clones of the
+/// function and data of this instance, with a contiguous slice of the events for unbinned data.
+
+void RooAbsTestStatistic::initMTMode()
+{
+  deleteMTMode() ;
+
+  const Int_t nEvents = _data->numEntries() ;
+  const Int_t nPart = std::min(effectiveNumThreads(),nEvents) ;
+  if (nPart<=1) return ;
+
+  const Bool_t binnedL = _func->getAttribute("BinnedLikelihoodActive") ;
+  const Bool_t slice = dynamic_cast<RooDataSet*>(_data) && !binnedL ;
+
+  for (Int_t i = 1; i < nPart; ++i) {
+    RooAbsData* partData = slice ? _data->reduce(RooFit::EventRange(nEvents*i/nPart,nEvents*(i+1)/nPart)) : _data ;
+    RooAbsTestStatistic* gof = create(Form("%s_MT%d",GetName(),i),Form("%s_MT%d",GetTitle(),i),*_func,*partData,*_projDeps,
+				      0,0,1,RooFit::BulkPartition,kFALSE,kFALSE,binnedL) ;
+    if (slice) {
+      delete partData ;
+    } else {
+      gof->setMPSet(i,nPart) ;
+    }
+    // The extended term is calculated by this instance, which has all the events
+    gof->_extSet = -1 ;
+    gof->setSimCount(_simCount) ;
+    gof->recursiveRedirectServers(_paramSet) ;
+    if (_doOffset) gof->enableOffsetting(kTRUE) ;
+    gof->initialize() ;
+    _mtArray.push_back(gof) ;
+  }
+
+  ccoutD(Eval) << "RooAbsTestStatistic::initMTMode(" << GetName() << ") calculating test statistic in " << nPart
+	       << " partitions of " << (slice ? "the events" : "the bins") << endl ;
+  setValueDirty() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the partitions of the multi-threaded calculation mode
+
+void RooAbsTestStatistic::deleteMTMode()
+{
+  for (auto gof : _mtArray) delete gof ;
+  _mtArray.clear() ;
+}
+
+
+
 Double_t RooAbsTestStatistic::getCarry() const
 { return _evalCarry; }
@@ -81,6 +81,7 @@ An (enforced) condition for this assumption is that each \f$ \mathrm{PDF}_i \f$
 #include "RooGlobalFunc.h"
 #include "RooRealIntegral.h"
 #include "RooTrace.h"
+#include "BatchDevice.h"
 
 #include "Riostream.h"
 #include <algorithm>
@@ -879,6 +880,38 @@ RooSpan<double> RooAddPdf::evaluateBatch(std::size_t begin, std::size_t batchSiz
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the sum of the component p.d.f.s on the device. The coefficients are
+/// computed on the host, as in evaluateBatch().
+/// \return Device array with the results, or nullptr if one of the components cannot
+/// be computed on the device.
+double* RooAddPdf::evaluateDeviceBatch(BatchHelpers::DeviceContext& context) const {
+  auto normAndCache = getNormAndCache();
+  const RooArgSet* nset = normAndCache.first;
+  CacheElem* cache = normAndCache.second;
+
+  double* output = context.output(*this);
+  if (!output || !context.fill(output, 0.))
+    return nullptr;
+
+  for (unsigned int pdfNo = 0; pdfNo < _pdfList.size(); ++pdfNo) {
+    const auto& pdf = static_cast<RooAbsPdf&>(_pdfList[pdfNo]);
+    if (!pdf.isSelectedComp())
+      continue;
+
+    const double* pdfOutputs = pdf.getDeviceBatch(context, nset);
+    const double coef = _coefCache[pdfNo] / (cache->_needSupNorm ?
+        static_cast<RooAbsReal*>(cache->_suppNormList.at(pdfNo))->getVal() :
+        1.);
+
+    if (!pdfOutputs || !context.axpy(output, pdfOutputs, coef))
+      return nullptr;
+  }
+
+  return output;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Reset error counter to given value, limiting the number
 /// of future error messages for this pdf to 'resetValue'
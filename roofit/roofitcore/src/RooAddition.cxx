@@ -37,6 +37,7 @@ in the two sets.
 #include "RooNLLVar.h"
 #include "RooChi2Var.h"
 #include "RooMsgService.h"
+#include "BatchHelpers.h"
 
 #include <algorithm>
 #include <cmath>
@@ -179,6 +180,42 @@ Double_t RooAddition::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the sum on the given batch of events. The terms that do not depend
+/// on the batch are added as constants.
+
+RooSpan<double> RooAddition::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  const RooArgSet* nset = _set.nset() ;
+
+  std::vector<RooSpan<const double>> batches ;
+  double constant(0) ;
+  for (const auto arg : _set) {
+    const auto comp = static_cast<RooAbsReal*>(arg);
+    auto batch = comp->getValBatch(begin, batchSize, nset) ;
+    if (batch.empty()) {
+      constant += comp->getVal(nset) ;
+    } else {
+      batches.push_back(batch) ;
+    }
+  }
+  if (batches.empty()) {
+    return {} ;
+  }
+
+  batchSize = BatchHelpers::findSize(batches) ;
+  auto output = _batchData.makeWritableBatchInit(begin, batchSize, constant) ;
+  for (const auto& batch : batches) {
+    for (std::size_t i = 0; i < batchSize; ++i) { //CHECK_VECTORISE
+      output[i] += batch[i] ;
+    }
+  }
+
+  return output ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the default error level for MINUIT error analysis
 /// If the addition contains one or more RooNLLVars and 
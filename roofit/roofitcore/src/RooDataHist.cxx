@@ -991,6 +991,70 @@ Int_t RooDataHist::calcTreeIndex() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the indices of the bins enclosing `n` points, in the numbering of get(Int_t).
+/// The bin numbers are computed dimension by dimension for all points with
+/// RooAbsBinning::binNumbers().
+/// \param[out] indices Array of `n` bin indices.
+/// \param[in] coordinates Coordinates of the points for each dimension, in the order of
+/// the variables of get(). Each span must have at least `n` elements.
+/// \param[in] n Number of points.
+/// \return False if the histogram has category dimensions, which are not supported.
+
+bool RooDataHist::binIndices(Int_t* indices, const std::vector<RooSpan<const double>>& coordinates,
+    std::size_t n) const
+{
+  checkInit() ;
+
+  if (coordinates.size() != _lvvars.size()) return false ;
+  for (unsigned int i=0; i < _lvvars.size(); ++i) {
+    if (!dynamic_cast<const RooAbsRealLValue*>(_lvvars[i]) || !_lvbins[i] || coordinates[i].size() < n) {
+      return false ;
+    }
+  }
+
+  std::fill(indices, indices + n, 0) ;
+  for (unsigned int i=0; i < _lvvars.size(); ++i) {
+    _lvbins[i]->binNumbers(coordinates[i].data(), indices, n, _idxMult[i]) ;
+  }
+
+  return true ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the weights of the bins enclosing `n` points, without interpolation, as
+/// weight(const RooArgSet&, Int_t, Bool_t, Bool_t, Bool_t) with `intOrder=0`. The bins
+/// are looked up with binIndices().
+/// \param[out] output Array of `n` weights.
+/// \param[in] coordinates Coordinates of the points for each dimension, in the order of
+/// the variables of get(). Each span must have at least `n` elements.
+/// \param[in] n Number of points.
+/// \param[in] correctForBinSize Divide the weights by the bin volumes.
+/// \return False if the histogram has category dimensions, which are not supported.
+
+bool RooDataHist::weights(double* output, const std::vector<RooSpan<const double>>& coordinates,
+    std::size_t n, bool correctForBinSize) const
+{
+  std::vector<Int_t> indices(n) ;
+  if (!binIndices(indices.data(), coordinates, n)) return false ;
+
+  if (correctForBinSize) {
+    for (std::size_t i=0; i < n; ++i) {
+      output[i] = _wgt[indices[i]] / _binv[indices[i]] ;
+    }
+  } else {
+    for (std::size_t i=0; i < n; ++i) {
+      output[i] = _wgt[indices[i]] ;
+    }
+  }
+
+  return true ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Debug stuff, should go...
 
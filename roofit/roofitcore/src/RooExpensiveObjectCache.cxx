@@ -343,13 +343,29 @@ void RooExpensiveObjectCache::ExpensiveObject::print() const
 
 
 ////////////////////////////////////////////////////////////////////////////////
+/// Import copies of the objects of `other` that are associated with the object `ownerName`,
+/// or all of them if `ownerName` is null. Objects stored under the same name are replaced.
+/// This can be used to reuse expensive objects, e.g. the values of numeric integrals, of
+/// an earlier session:
+/// ~~~{.cpp}
+/// // after the fit
+/// TFile file("cache.root", "RECREATE");
+/// file.WriteObject(&workspace.expensiveObjectCache(), "cache");
+///
+/// // in another session
+/// std::unique_ptr<TFile> file(TFile::Open("cache.root"));
+/// std::unique_ptr<RooExpensiveObjectCache> cache(file->Get<RooExpensiveObjectCache>("cache"));
+/// workspace.expensiveObjectCache().importCacheObjects(*cache, nullptr);
+/// ~~~
 
 void RooExpensiveObjectCache::importCacheObjects(RooExpensiveObjectCache& other, const char* ownerName, Bool_t verbose) 
 {
   map<TString,ExpensiveObject*>::const_iterator iter = other._map.begin() ;
   while(iter!=other._map.end()) {
-    if (string(ownerName)==iter->second->ownerName()) {      
-      _map[iter->first.Data()] = new ExpensiveObject(_nextUID++, *iter->second) ;
+    if (!ownerName || string(ownerName)==iter->second->ownerName()) {      
+      ExpensiveObject*& eo = _map[iter->first.Data()] ;
+      delete eo ;
+      eo = new ExpensiveObject(_nextUID++, *iter->second) ;
       if (verbose) {
 	oocoutI(iter->second->payload(),Caching) << "RooExpensiveObjectCache::importCache() importing cache object " 
 						 << iter->first << " associated with object " << iter->second->ownerName() << endl ;
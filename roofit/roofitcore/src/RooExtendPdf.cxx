@@ -45,6 +45,8 @@ the nominal integration range \f$ \mathrm{normRegion}[x] \f$.
 #include "RooNameReg.h"
 #include "RooMsgService.h"
 
+#include <algorithm>
+
 
 
 using namespace std;
@@ -101,6 +103,23 @@ RooExtendPdf::~RooExtendPdf()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Forward the batch evaluation to the input p.d.f, normalized as in evaluate().
+
+RooSpan<double> RooExtendPdf::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  auto pdfData = _pdf.getValBatch(begin, batchSize) ;
+  if (pdfData.empty()) {
+    return {} ;
+  }
+
+  auto output = _batchData.makeWritableBatchUnInit(begin, pdfData.size()) ;
+  std::copy(pdfData.begin(), pdfData.end(), output.begin()) ;
+  return output ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
 /// Return the number of expected events over the full range of all variables.
 /// `norm`, the variable set as normalisation constant in the constructor,
 /// will yield the number of events in the range set in the constructor. That is, the function returns
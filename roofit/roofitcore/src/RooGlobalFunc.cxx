@@ -28,8 +28,11 @@
 #include "RooFitResult.h"
 #include "RooAbsPdf.h"
 #include "RooFormulaVar.h"
+#include "RooMsgService.h"
 #include "TH1.h"
 
+#include <cstring>
+
 using namespace std;
 
 namespace RooFit {
@@ -155,7 +158,17 @@ namespace RooFit {
   RooCmdArg Extended(Bool_t flag) { return RooCmdArg("Extended",flag,0,0,0,0,0,0,0) ; }
   RooCmdArg DataError(Int_t etype) { return RooCmdArg("DataError",(Int_t)etype,0,0,0,0,0,0,0) ; }
   RooCmdArg NumCPU(Int_t nCPU, Int_t interleave)   { return RooCmdArg("NumCPU",nCPU,interleave,0,0,0,0,0,0) ; }
+  RooCmdArg NumThreads(Int_t nThreads)   { return RooCmdArg("NumThreads",nThreads,0,0,0,0,0,0,0) ; }
   RooCmdArg BatchMode(bool flag) { return RooCmdArg("BatchMode", flag); }
+  RooCmdArg BatchMode(const char* mode) {
+    // "off" = 0, "cpu" = 1 as BatchMode(true), "cuda" = 2
+    const int imode = strcmp(mode, "cuda") == 0 ? 2 : (strcmp(mode, "cpu") == 0 ? 1 : 0);
+    if (imode == 0 && strcmp(mode, "off") != 0) {
+      oocoutE((TObject*)0, InputArguments) << "RooFit::BatchMode(" << mode << ") unknown mode, "
+          << "use \"off\", \"cpu\" or \"cuda\". The batch mode is switched off." << std::endl;
+    }
+    return RooCmdArg("BatchMode", imode);
+  }
   
   // RooAbsCollection::printLatex arguments
   RooCmdArg Columns(Int_t ncol)                           { return RooCmdArg("Columns",ncol,0,0,0,0,0,0,0) ; }
@@ -199,6 +199,60 @@ Double_t RooHistFunc::evaluate() const
   return ret ;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values of the histogram for a batch of events. Without interpolation,
+/// the bins of all events are looked up at once with RooDataHist::weights(), as in
+/// RooHistPdf::evaluateBatch(). Otherwise, the values are computed event by event.
+
+RooSpan<double> RooHistFunc::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  if (_intOrder != 0 || _depList.empty()) {
+    return RooAbsReal::evaluateBatch(begin, batchSize);
+  }
+
+  // Batches of the observables, in the order of the dimensions of the histogram
+  std::vector<RooSpan<const double>> coordinates;
+  std::vector<std::size_t> rangeChecked;
+  for (const auto histVar : *_dataHist->get()) {
+    const Int_t i = _histObsList.index(histVar->GetName());
+    const auto funcObs = i < 0 ? nullptr : dynamic_cast<const RooAbsReal*>(_depList[i]);
+    if (!funcObs) {
+      return RooAbsReal::evaluateBatch(begin, batchSize);
+    }
+
+    auto batch = funcObs->getValBatch(begin, batchSize);
+    if (batch.empty()) {
+      return RooAbsReal::evaluateBatch(begin, batchSize);
+    }
+    batchSize = std::min(batchSize, batch.size());
+    coordinates.push_back(batch);
+    if (_histObsList[i] != _depList[i]) {
+      rangeChecked.push_back(coordinates.size() - 1);
+    }
+  }
+
+  auto output = _batchData.makeWritableBatchUnInit(begin, batchSize);
+  if (!_dataHist->weights(output.data(), coordinates, batchSize, false)) {
+    return RooAbsReal::evaluateBatch(begin, batchSize);
+  }
+
+  // As in evaluate(), the function vanishes outside of the range of the histogram
+  for (auto dim : rangeChecked) {
+    const auto histVar = static_cast<const RooAbsRealLValue*>((*_dataHist->get())[dim]);
+    const double xmin = histVar->getMin();
+    const double xmax = histVar->getMax();
+    for (std::size_t i = 0; i < output.size(); ++i) {
+      const double x = coordinates[dim][i];
+      const double epsilon = 1e-8 * std::abs(x);
+      if (x < xmin - epsilon || x > xmax + epsilon) {
+        output[i] = 0.;
+      }
+    }
+  }
+
+  return output;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Only handle case of maximum in all variables
 
@@ -230,6 +230,66 @@ Double_t RooHistPdf::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the values of the histogram for a batch of events. Without interpolation,
+/// the bins of all events are looked up at once with RooDataHist::weights(). With
+/// interpolation, or if the histogram has category dimensions, the values are computed
+/// event by event.
+
+RooSpan<double> RooHistPdf::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  if (_intOrder != 0) {
+    return RooAbsPdf::evaluateBatch(begin, batchSize);
+  }
+
+  // Batches of the observables, in the order of the dimensions of the histogram
+  std::vector<RooSpan<const double>> coordinates;
+  std::vector<std::size_t> rangeChecked;
+  for (const auto histVar : *_dataHist->get()) {
+    const Int_t i = _histObsList.index(histVar->GetName());
+    const auto pdfObs = i < 0 ? nullptr : dynamic_cast<const RooAbsReal*>(_pdfObsList[i]);
+    if (!pdfObs) {
+      return RooAbsPdf::evaluateBatch(begin, batchSize);
+    }
+
+    auto batch = pdfObs->getValBatch(begin, batchSize);
+    if (batch.empty()) {
+      return RooAbsPdf::evaluateBatch(begin, batchSize);
+    }
+    batchSize = std::min(batchSize, batch.size());
+    coordinates.push_back(batch);
+    if (_histObsList[i] != _pdfObsList[i]) {
+      rangeChecked.push_back(coordinates.size() - 1);
+    }
+  }
+
+  auto output = _batchData.makeWritableBatchUnInit(begin, batchSize);
+  if (!_dataHist->weights(output.data(), coordinates, batchSize, !_unitNorm)) {
+    return RooAbsPdf::evaluateBatch(begin, batchSize);
+  }
+
+  // As in evaluate(), points outside of the range of the histogram have zero probability
+  for (auto dim : rangeChecked) {
+    const auto histVar = static_cast<const RooAbsRealLValue*>((*_dataHist->get())[dim]);
+    const double xmin = histVar->getMin();
+    const double xmax = histVar->getMax();
+    for (std::size_t i = 0; i < output.size(); ++i) {
+      const double x = coordinates[dim][i];
+      const double epsilon = 1e-8 * std::abs(x);
+      if (x < xmin - epsilon || x > xmax + epsilon) {
+        output[i] = 0.;
+      }
+    }
+  }
+
+  for (double& val : output) { //CHECK_VECTORISE
+    val = val < 0. ? 0. : val;
+  }
+
+  return output;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the total volume spanned by the observables of the RooHistPdf
 
@@ -119,6 +119,7 @@ RooMinimizer::RooMinimizer(RooAbsReal& function)
   _profile = kFALSE ;
   _profileStart = kFALSE ;
   _printLevel = 1 ;
+  _componentGradient = kFALSE ;
   _minimizerType = "Minuit"; // default minimizer
 
   if (_theFitter) delete _theFitter ;
@@ -240,6 +241,55 @@ void RooMinimizer::setOffsetting(Bool_t flag)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Provide the minimizer with the gradient of the function, calculated with
+/// finite differences that only recalculate the terms of the function that
+/// depend on the varied parameter. The terms are the components of a
+/// RooAddition, e.g. the likelihood and the constraints, and the likelihoods
+/// of the channels of a RooSimultaneous. The other terms keep their cached
+/// values, which is much faster than the numerical gradient of the minimizer
+/// for combined fits of many channels.
+
+void RooMinimizer::setComponentGradient(Bool_t flag)
+{
+  _componentGradient = flag ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Run the fit of the function, with the gradient calculated from the terms
+/// of the function if requested
+
+bool RooMinimizer::fitFcn() const
+{
+  if (_componentGradient) {
+    // The fitter owns a clone of the gradient function, which uses _fcn
+    return _theFitter->FitFCN(RooMinimizerGradFcn(*_fcn)) ;
+  }
+  return _theFitter->FitFCN(*_fcn) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the function used by the fitter, or our own if there is none yet
+
+const RooMinimizerFcn* RooMinimizer::fitterFcn() const
+{
+  const ROOT::Math::IMultiGenFunction* fcn = fitter()->GetFCN() ;
+  if (!fcn) return _fcn ;
+  if (auto gradFcn = dynamic_cast<const RooMinimizerGradFcn*>(fcn)) return gradFcn->fcn() ;
+  return static_cast<const RooMinimizerFcn*>(fcn) ;
+}
+
+RooMinimizerFcn* RooMinimizer::fitterFcn()
+{
+  return const_cast<RooMinimizerFcn*>(static_cast<const RooMinimizer*>(this)->fitterFcn()) ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Choose the minimiser algorithm.
 void RooMinimizer::setMinimizerType(const char* type)
@@ -321,7 +371,7 @@ Int_t RooMinimizer::minimize(const char* type, const char* alg)
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::CollectErrors) ;
   RooAbsReal::clearEvalErrorLog() ;
 
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -350,7 +400,7 @@ Int_t RooMinimizer::migrad()
   RooAbsReal::clearEvalErrorLog() ;
 
   _theFitter->Config().SetMinimizer(_minimizerType.c_str(),"migrad");
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -513,7 +563,7 @@ Int_t RooMinimizer::seek()
   RooAbsReal::clearEvalErrorLog() ;
 
   _theFitter->Config().SetMinimizer(_minimizerType.c_str(),"seek");
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -542,7 +592,7 @@ Int_t RooMinimizer::simplex()
   RooAbsReal::clearEvalErrorLog() ;
 
   _theFitter->Config().SetMinimizer(_minimizerType.c_str(),"simplex");
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -571,7 +621,7 @@ Int_t RooMinimizer::improve()
   RooAbsReal::clearEvalErrorLog() ;
 
   _theFitter->Config().SetMinimizer(_minimizerType.c_str(),"migradimproved");
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
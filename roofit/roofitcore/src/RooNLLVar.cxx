@@ -44,6 +44,7 @@ In extended mode, a
 #include "RooRealVar.h"
 #include "RooProdPdf.h"
 #include "RooHelpers.h"
+#include "BatchDevice.h"
 
 #include "Math/Util.h"
 
@@ -54,6 +55,15 @@ ClassImp(RooNLLVar)
 RooArgSet RooNLLVar::_emptySet ;
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Default constructor
+
+RooNLLVar::RooNLLVar()
+{
+  _first = kTRUE ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Construct likelihood from given p.d.f and (binned or unbinned dataset)
 ///
@@ -67,7 +77,7 @@ RooArgSet RooNLLVar::_emptySet ;
 ///  ConditionalObservables() | Define conditional observables
 ///  Verbose()                | Verbose output of GOF framework classes
 ///  CloneData()              | Clone input dataset for internal use (default is kTRUE)
-///  BatchMode()              | Evaluate batches of data events (faster if PDFs support it)
+///  BatchMode()              | Evaluate batches of data events (faster if PDFs support it). With `BatchMode("cuda")`, on a CUDA device.
 
 RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbsData& indata,
 		     const RooCmdArg& arg1, const RooCmdArg& arg2,const RooCmdArg& arg3,
@@ -95,6 +105,7 @@ RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbs
 
   _extended = pc.getInt("extended") ;
   _batchEvaluations = pc.getInt("BatchMode");
+  _deviceEvaluations = pc.getInt("BatchMode") == 2;
   _weightSq = kFALSE ;
   _first = kTRUE ;
   _offset = 0.;
@@ -201,6 +212,7 @@ RooNLLVar::RooNLLVar(const RooNLLVar& other, const char* name) :
   RooAbsOptTestStatistic(other,name),
   _extended(other._extended),
   _batchEvaluations(other._batchEvaluations),
+  _deviceEvaluations(other._deviceEvaluations),
   _weightSq(other._weightSq),
   _first(kTRUE), _offsetSaveW2(other._offsetSaveW2),
   _offsetCarrySaveW2(other._offsetCarrySaveW2),
@@ -231,6 +243,8 @@ void RooNLLVar::applyWeightSquared(Bool_t flag)
       std::swap(_offset, _offsetSaveW2);
       std::swap(_offsetCarry, _offsetCarrySaveW2);
     }
+    for (auto gof : _mtArray)
+      static_cast<RooNLLVar*>(gof)->applyWeightSquared(flag);
     setValueDirty();
   } else if ( _gofOpMode==MPMaster) {
     for (Int_t i=0 ; i<_nCPU ; i++)
@@ -317,7 +331,11 @@ Double_t RooNLLVar::evaluatePartition(std::size_t firstEvent, std::size_t lastEv
 
   } else { //unbinned PDF
 
-    if (_batchEvaluations) {
+    std::tuple<double, double, double> deviceResult;
+    if (_batchEvaluations && _deviceEvaluations && stepSize == 1
+        && computeOnDevice(firstEvent, lastEvent, deviceResult)) {
+      std::tie(result, carry, sumWeight) = deviceResult;
+    } else if (_batchEvaluations) {
       std::tie(result, carry, sumWeight) = computeBatched(stepSize, firstEvent, lastEvent);
 #ifdef ROOFIT_CHECK_CACHED_VALUES
 
@@ -507,6 +525,61 @@ std::tuple<double, double, double> RooNLLVar::computeBatched(std::size_t stepSiz
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the likelihood of the events [firstEvent, lastEvent) on a CUDA device.
+/// The data columns and the weights are uploaded once for the range and stay on the
+/// device, only the partial sums of the likelihood are copied back.
+/// \return False if no device is available or the p.d.f. cannot be computed on the
+/// device. The caller then falls back to computeBatched().
+bool RooNLLVar::computeOnDevice(std::size_t firstEvent, std::size_t lastEvent,
+    std::tuple<double, double, double>& result) const
+{
+  if (_deviceFallback)
+    return false;
+
+  auto fallBack = [this](const char* reason) {
+    coutW(Minimization) << "RooNLLVar::computeOnDevice(" << GetName() << ") " << reason
+        << ", the batches are computed on the host." << std::endl;
+    _deviceFallback = true;
+    _deviceContext.reset();
+    return false;
+  };
+
+  if (!BatchHelpers::DeviceContext::isAvailable())
+    return fallBack("no CUDA device is available");
+
+  const std::size_t nEvents = lastEvent - firstEvent;
+  if (!_deviceContext || _deviceData != _dataClone
+      || _deviceContext->first() != firstEvent || _deviceContext->size() != nEvents) {
+    _deviceContext.reset(new BatchHelpers::DeviceContext(*_dataClone->get(), firstEvent, nEvents));
+    _deviceData = _dataClone;
+  }
+
+  auto pdfClone = static_cast<const RooAbsPdf*>(_funcClone);
+  const double* probabilities = pdfClone->getDeviceBatch(*_deviceContext, _normSet);
+  if (!probabilities)
+    return fallBack(Form("cannot compute the p.d.f. %s on the device", pdfClone->GetName()));
+
+  const RooSpan<const double> eventWeights = _dataClone->getWeightBatch(firstEvent, nEvents);
+  const double* weights = nullptr;
+  if (!eventWeights.empty()) {
+    weights = _deviceContext->weights(eventWeights.data());
+    if (!weights)
+      return fallBack("cannot upload the event weights");
+  }
+
+  // As in computeBatched(), a constant weight is not squared
+  double nll = 0.;
+  double sumWeights = 0.;
+  if (!_deviceContext->negativeLogSum(probabilities, weights, _dataClone->weight(), weights && _weightSq,
+      nll, sumWeights))
+    return fallBack("the reduction of the likelihood failed");
+
+  result = std::tuple<double, double, double>{nll, 0., sumWeights};
+  return true;
+}
+
+
 std::tuple<double, double, double> RooNLLVar::computeScalar(std::size_t stepSize, std::size_t firstEvent, std::size_t lastEvent) const {
   auto pdfClone = static_cast<const RooAbsPdf*>(_funcClone);
 
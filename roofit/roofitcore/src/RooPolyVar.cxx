@@ -31,6 +31,7 @@ it can define.
 #include "RooPolyVar.h"
 #include "RooArgList.h"
 #include "RooMsgService.h"
+#include "BatchHelpers.h"
 //#include "Riostream.h"
 
 #include "TError.h"
@@ -140,6 +141,51 @@ Double_t RooPolyVar::evaluate() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the polynomial on the given batch of x values, with the Horner scheme
+/// applied to all the events at once.
+
+RooSpan<double> RooPolyVar::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  auto xData = _x.getValBatch(begin, batchSize);
+  if (xData.empty()) {
+    return {};
+  }
+  batchSize = xData.size();
+
+  const unsigned sz = _coefList.getSize();
+  const int lowestOrder = _lowestOrder;
+  if (!sz) {
+    return _batchData.makeWritableBatchInit(begin, batchSize, lowestOrder ? 1. : 0.);
+  }
+
+  const RooArgSet* nset = _coefList.nset();
+  std::vector<BatchHelpers::BracketAdapterWithMask> coefs;
+  for (const auto arg : _coefList) {
+    const auto c = static_cast<RooAbsReal*>(arg);
+    coefs.emplace_back(c->getVal(nset), c->getValBatch(begin, batchSize, nset));
+  }
+
+  auto output = _batchData.makeWritableBatchUnInit(begin, batchSize);
+  for (std::size_t i = 0; i < batchSize; ++i) {
+    output[i] = coefs[sz - 1][i];
+  }
+  for (unsigned k = sz - 1; k--; ) {
+    for (std::size_t i = 0; i < batchSize; ++i) {
+      output[i] = coefs[k][i] + xData[i] * output[i];
+    }
+  }
+  for (int k = 0; k < lowestOrder; ++k) {
+    for (std::size_t i = 0; i < batchSize; ++i) { //CHECK_VECTORISE
+      output[i] *= xData[i];
+    }
+  }
+
+  return output;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Advertise that we can internally integrate over x
 
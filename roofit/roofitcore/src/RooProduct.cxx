@@ -34,6 +34,7 @@ A RooProduct represents the product of a given set of RooAbsReal objects.
 #include "RooErrorHandler.h"
 #include "RooMsgService.h"
 #include "RooTrace.h"
+#include "BatchHelpers.h"
 
 using namespace std ;
 
@@ -379,6 +380,46 @@ Double_t RooProduct::evaluate() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the product on the given batch of events. The terms that do not depend
+/// on the batch, and the categories, multiply the batch as constants.
+
+RooSpan<double> RooProduct::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  const RooArgSet* nset = _compRSet.nset() ;
+
+  std::vector<RooSpan<const double>> batches ;
+  double constant(1) ;
+  for (const auto item : _compRSet) {
+    auto rcomp = static_cast<const RooAbsReal*>(item);
+    auto batch = rcomp->getValBatch(begin, batchSize, nset) ;
+    if (batch.empty()) {
+      constant *= rcomp->getVal(nset) ;
+    } else {
+      batches.push_back(batch) ;
+    }
+  }
+  if (batches.empty()) {
+    return {} ;
+  }
+
+  for (const auto item : _compCSet) {
+    constant *= static_cast<const RooAbsCategory*>(item)->getCurrentIndex() ;
+  }
+
+  batchSize = BatchHelpers::findSize(batches) ;
+  auto output = _batchData.makeWritableBatchInit(begin, batchSize, constant) ;
+  for (const auto& batch : batches) {
+    for (std::size_t i = 0; i < batchSize; ++i) { //CHECK_VECTORISE
+      output[i] *= batch[i] ;
+    }
+  }
+
+  return output ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Forward the plot sampling hint from the p.d.f. that defines the observable obs  
 
@@ -51,6 +51,7 @@ integration is performed in the various implementations of the RooAbsIntegrator
 #include "TClass.h"
 
 #include <iostream>
+#include <sstream>
 
 using namespace std;
 
@@ -820,8 +821,10 @@ Double_t RooRealIntegral::evaluate() const
     {      
       // Cache numeric integrals in >1d expensive object cache
       RooDouble* cacheVal(0) ;
-      if ((_cacheNum && _intList.getSize()>0) || _intList.getSize()>=_cacheAllNDim) {
-        cacheVal = (RooDouble*) expensiveObjectCache().retrieveObject(GetName(),RooDouble::Class(),parameters())  ;
+      const Bool_t cacheNumInt = (_cacheNum && _intList.getSize()>0) || _intList.getSize()>=_cacheAllNDim ;
+      const TString cacheKey = cacheNumInt ? numIntCacheKey() : TString() ;
+      if (cacheNumInt) {
+        cacheVal = (RooDouble*) expensiveObjectCache().retrieveObject(cacheKey,RooDouble::Class(),parameters())  ;
       }
 
       if (cacheVal) {
@@ -858,9 +861,9 @@ Double_t RooRealIntegral::evaluate() const
         _sumList=_saveSum ;
         
         // Cache numeric integrals in >1d expensive object cache
-        if ((_cacheNum && _intList.getSize()>0) || _intList.getSize()>=_cacheAllNDim) {
+        if (cacheNumInt) {
           RooDouble* val = new RooDouble(retVal) ;
-          expensiveObjectCache().registerObject(_function.arg().GetName(),GetName(),*val,parameters())  ;
+          expensiveObjectCache().registerObject(_function.arg().GetName(),cacheKey,*val,parameters())  ;
           //  	  cout << "### caching value of integral" << GetName() << " in " << &expensiveObjectCache() << endl ;
         }
         
@@ -921,6 +924,43 @@ Double_t RooRealIntegral::evaluate() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the name under which the value of a numeric integral is stored in the
+/// expensive object cache. Besides the name of the integral, it contains a hash of
+/// the structure of the integrand (class, name and meta arguments of each node of
+/// its expression tree) and of the limits of the numeric integration. A cached value
+/// is therefore not used for a different integrand with the same name, e.g. in a
+/// workspace read back in another session, or after the integration range has changed.
+
+TString RooRealIntegral::numIntCacheKey() const
+{
+  std::ostringstream structure ;
+  structure.precision(17) ;
+
+  RooArgSet nodes ;
+  _function.arg().treeNodeServerList(&nodes) ;
+  for (const auto node : nodes) {
+    structure << node->IsA()->GetName() << "::" << node->GetName() << "(" ;
+    node->printMetaArgs(structure) ;
+    structure << ")" ;
+    for (const auto server : node->servers()) {
+      structure << server->GetName() << "," ;
+    }
+    structure << ";" ;
+  }
+
+  const char* rangeName = RooNameReg::str(_rangeName) ;
+  for (const auto arg : _intList) {
+    auto var = static_cast<const RooAbsRealLValue*>(arg) ;
+    structure << var->GetName() << "[" << var->getMin(rangeName) << "," << var->getMax(rangeName) << "]" ;
+  }
+
+  const std::string str = structure.str() ;
+  return TString::Format("%s_%08x", GetName(), TString::Hash(str.c_str(), str.size())) ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return product of jacobian terms originating from analytical integration
 
@@ -60,9 +60,11 @@ to the fractions of the various functions. **This requires setting the last argu
 #include "RooRealIntegral.h"
 #include "RooMsgService.h"
 #include "RooNameReg.h"
+#include "BatchHelpers.h"
 
 #include <algorithm>
 #include <memory>
+#include <limits>
 
 using namespace std;
 
@@ -287,6 +289,66 @@ Double_t RooRealSumPdf::evaluate() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the sum of the functions weighted by their coefficients on the given batch of events.
+/// The functions that do not depend on the batch are added as constants.
+
+RooSpan<double> RooRealSumPdf::evaluateBatch(std::size_t begin, std::size_t batchSize) const
+{
+  // Collect the selected functions with their coefficients, as in evaluate()
+  std::vector<std::pair<const RooAbsReal*, double>> terms ;
+  Double_t lastCoef(1) ;
+  auto funcIt = _funcList.begin();
+  for (const auto coefArg : _coefList) {
+    auto func = static_cast<const RooAbsReal*>(*funcIt++);
+    const Double_t coefVal = static_cast<const RooAbsReal*>(coefArg)->getVal() ;
+    if (coefVal) {
+      if (func->isSelectedComp()) terms.emplace_back(func, coefVal) ;
+      lastCoef -= coefVal ;
+    }
+  }
+  if (!haveLastCoef()) {
+    auto func = static_cast<const RooAbsReal*>(*funcIt);
+    if (func->isSelectedComp()) terms.emplace_back(func, lastCoef) ;
+  }
+
+  std::vector<RooSpan<const double>> funcBatches ;
+  for (const auto& term : terms) {
+    funcBatches.push_back(term.first->getValBatch(begin, batchSize)) ;
+  }
+  batchSize = BatchHelpers::findSize(funcBatches) ;
+  if (batchSize == std::numeric_limits<std::size_t>::max()) {
+    return {} ;
+  }
+
+  auto output = _batchData.makeWritableBatchInit(begin, batchSize, 0.) ;
+  for (std::size_t k = 0; k < terms.size(); ++k) {
+    const double coef = terms[k].second ;
+    const auto& funcBatch = funcBatches[k] ;
+    if (funcBatch.empty()) {
+      const double value = terms[k].first->getVal() * coef ;
+      for (std::size_t i = 0; i < batchSize; ++i) { //CHECK_VECTORISE
+        output[i] += value ;
+      }
+    } else {
+      for (std::size_t i = 0; i < batchSize; ++i) { //CHECK_VECTORISE
+        output[i] += funcBatch[i] * coef ;
+      }
+    }
+  }
+
+  // Introduce floor if so requested
+  if (_doFloor || _doFloorGlobal) {
+    for (std::size_t i = 0; i < batchSize; ++i) { //CHECK_VECTORISE
+      output[i] = output[i] < 0. ? 0. : output[i] ;
+    }
+  }
+
+  return output ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Check if FUNC is valid for given normalization set.
 /// Coefficient and FUNC must be non-overlapping, but func-coefficient
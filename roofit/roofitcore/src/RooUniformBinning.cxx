@@ -126,6 +126,24 @@ Int_t RooUniformBinning::binNumber(Double_t x) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the bin numbers of the `n` values in `x` as binNumber(), and add them
+/// multiplied by `coef` to `bins`. The loop has no virtual calls and can be vectorised.
+
+void RooUniformBinning::binNumbers(const double* x, Int_t* bins, std::size_t n, Int_t coef) const
+{
+  const double xlo = _xlo ;
+  const double binw = _binw ;
+  const Int_t lastBin = _nbins - 1 ;
+  for (std::size_t i = 0; i < n; ++i) { //CHECK_VECTORISE
+    Int_t bin = Int_t((x[i] - xlo)/binw) ;
+    bin = bin < 0 ? 0 : (bin > lastBin ? lastBin : bin) ;
+    bins[i] += coef * bin ;
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the central value of the 'i'-th fit bin
 
@@ -42,6 +42,7 @@ use a TTree as internal storage mechanism
 #include "TList.h"
 
 #include <iomanip>
+#include <stdexcept>
 using namespace std;
 
 ClassImp(RooVectorDataStore);
@@ -966,6 +967,83 @@ void RooVectorDataStore::reserve(Int_t nEvts)
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Replace the contents of the store by columns of values, without the event-by-event
+/// propagation of fill(). The vectors are moved into the store, which adopts their
+/// memory without copying it.
+/// \param[in] vars Variables of the columns. All the real-valued variables of the store
+/// (including the weight variable) must be present, and the store must not have category
+/// columns.
+/// \param[in] columns Values of the variables, in the order of `vars`. All columns must have
+/// the same size. The errors of the variables with errors are set to zero.
+/// \throws std::invalid_argument if the columns do not match the variables of the store.
+
+void RooVectorDataStore::adoptColumns(const RooArgList& vars, std::vector<std::vector<double>>&& columns)
+{
+  auto error = [this](const std::string& what) {
+    return std::invalid_argument(std::string("RooVectorDataStore::adoptColumns(") + GetName() + "): " + what);
+  };
+
+  if (vars.size() != columns.size())
+    throw error("the number of columns does not match the number of variables.");
+  if (!_catStoreList.empty())
+    throw error("the store has category columns, which cannot be adopted.");
+  if (vars.size() != _realStoreList.size() + _realfStoreList.size())
+    throw error("a column is required for each real-valued variable of the store.");
+
+  const std::size_t nEvents = columns.empty() ? 0 : columns.front().size();
+  std::vector<RealVector*> targets;
+  for (unsigned int i = 0; i < vars.size(); ++i) {
+    RealVector* target = nullptr;
+    for (auto realVec : _realStoreList) {
+      if (realVec->bufArg()->namePtr() == vars[i].namePtr())
+        target = realVec;
+    }
+    for (auto fullVec : _realfStoreList) {
+      if (fullVec->bufArg()->namePtr() == vars[i].namePtr())
+        target = fullVec;
+    }
+
+    if (!target || std::find(targets.begin(), targets.end(), target) != targets.end())
+      throw error(std::string("no column or more than one column for ") + vars[i].GetName() + ".");
+    if (columns[i].size() != nEvents)
+      throw error(std::string("the size of the column of ") + vars[i].GetName() + " differs from the others.");
+    targets.push_back(target);
+  }
+
+  for (unsigned int i = 0; i < targets.size(); ++i) {
+    targets[i]->_vec = std::move(columns[i]);
+  }
+
+  for (auto fullVec : _realfStoreList) {
+    for (auto errors : {fullVec->_vecE, fullVec->_vecEL, fullVec->_vecEH}) {
+      if (errors)
+        errors->assign(nEvents, 0.);
+    }
+  }
+
+  // use Kahan's algorithm to sum up weights to avoid loss of precision
+  _sumWeight = _sumWeightCarry = 0.;
+  const RealVector* weights = nullptr;
+  for (unsigned int i = 0; i < targets.size(); ++i) {
+    if (_wgtVar && vars[i].namePtr() == _wgtVar->namePtr())
+      weights = targets[i];
+  }
+  if (!weights) {
+    _sumWeight = nEvents;
+  } else {
+    for (double wgt : weights->_vec) {
+      Double_t y = wgt - _sumWeightCarry;
+      Double_t t = _sumWeight + y;
+      _sumWeightCarry = (t - _sumWeight) - y;
+      _sumWeight = t;
+    }
+  }
+
+  resetCache();
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void RooVectorDataStore::append(RooAbsDataStore& other) 
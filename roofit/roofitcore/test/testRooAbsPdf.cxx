@@ -6,9 +6,17 @@
 #include "RooFormulaVar.h"
 #include "RooDataSet.h"
 #include "RooFitResult.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooAddPdf.h"
+#include "RooAbsReal.h"
+#include "RooPolyVar.h"
+#include "RooProduct.h"
+#include "RooRealSumPdf.h"
 
 #include "gtest/gtest.h"
 
+#include <cmath>
 #include <memory>
 
 // ROOT-10668: Asympt. correct errors don't work when title and name differ
@@ -40,3 +48,76 @@ TEST(RooAbsPdf, AsymptoticallyCorrectErrors)
   EXPECT_GT(aError, a.getError()*2.) << "Asymptotically correct errors should be significantly larger.";
 }
 
+
+// The likelihood calculated in the threads of the ROOT thread pool is the one calculated in a single thread
+TEST(RooAbsPdf, NLLInThreads)
+{
+  RooRealVar x("x", "x", 0., 10.);
+  RooRealVar mean("mean", "mean", 5., 0., 10.);
+  RooRealVar sigma("sigma", "sigma", 1., 0.1, 5.);
+  RooRealVar lambda("lambda", "lambda", -0.3, -2., 0.);
+  RooGaussian gauss("gauss", "gauss", x, mean, sigma);
+  RooExponential expo("expo", "expo", x, lambda);
+  RooRealVar nsig("nsig", "nsig", 500., 0., 10000.);
+  RooRealVar nbkg("nbkg", "nbkg", 1500., 0., 10000.);
+  RooAddPdf model("model", "model", RooArgList(gauss, expo), RooArgList(nsig, nbkg));
+
+  std::unique_ptr<RooDataSet> data(model.generate(x, 2000));
+
+  std::unique_ptr<RooAbsReal> nll(model.createNLL(*data, RooFit::Extended()));
+  std::unique_ptr<RooAbsReal> nllMT(model.createNLL(*data, RooFit::Extended(), RooFit::NumThreads(4)));
+
+  EXPECT_NEAR(nll->getVal(), nllMT->getVal(), 1.E-8 * std::abs(nll->getVal()));
+
+  mean = 4.5;
+  nsig = 700;
+  EXPECT_NEAR(nll->getVal(), nllMT->getVal(), 1.E-8 * std::abs(nll->getVal()));
+}
+
+// The batch evaluation of the composite functions and pdfs gives the likelihood of the scalar evaluation
+TEST(RooAbsPdf, BatchModeRealSumPdf)
+{
+  RooRealVar x("x", "x", 0., 10.);
+  RooRealVar c1("c1", "c1", 0.3, -1., 1.);
+  RooRealVar c2("c2", "c2", 0.05, -1., 1.);
+  RooRealVar scale("scale", "scale", 2., 0.1, 10.);
+  RooPolyVar poly("poly", "poly", x, RooArgList(scale, c1, c2));
+  RooProduct prod("prod", "prod", RooArgList(x, scale));
+  RooRealVar frac("frac", "frac", 0.3, 0., 1.);
+  RooRealSumPdf model("model", "model", RooArgList(poly, prod), RooArgList(frac));
+
+  std::unique_ptr<RooDataSet> data(model.generate(x, 2000));
+
+  std::unique_ptr<RooAbsReal> nll(model.createNLL(*data));
+  std::unique_ptr<RooAbsReal> nllBatch(model.createNLL(*data, RooFit::BatchMode(true)));
+
+  EXPECT_NEAR(nll->getVal(), nllBatch->getVal(), 1.E-8 * std::abs(nll->getVal()));
+
+  c1 = 0.1;
+  frac = 0.6;
+  EXPECT_NEAR(nll->getVal(), nllBatch->getVal(), 1.E-8 * std::abs(nll->getVal()));
+}
+
+TEST(RooAbsPdf, BatchModeCuda)
+{
+  RooRealVar x("x", "x", 0., 10.);
+  RooRealVar mean("mean", "mean", 4., 0., 10.);
+  RooRealVar sigma("sigma", "sigma", 1., 0.1, 5.);
+  RooGaussian gauss("gauss", "gauss", x, mean, sigma);
+  RooRealVar c("c", "c", -0.2, -1., 0.);
+  RooExponential expo("expo", "expo", x, c);
+  RooRealVar frac("frac", "frac", 0.4, 0., 1.);
+  RooAddPdf model("model", "model", RooArgList(gauss, expo), RooArgList(frac));
+
+  std::unique_ptr<RooDataSet> data(model.generate(x, 5000));
+
+  // Without a CUDA device, the batches are computed on the host
+  std::unique_ptr<RooAbsReal> nllCpu(model.createNLL(*data, RooFit::BatchMode("cpu")));
+  std::unique_ptr<RooAbsReal> nllCuda(model.createNLL(*data, RooFit::BatchMode("cuda")));
+
+  EXPECT_NEAR(nllCpu->getVal(), nllCuda->getVal(), 1.E-10 * std::abs(nllCpu->getVal()));
+
+  mean = 5.;
+  frac = 0.6;
+  EXPECT_NEAR(nllCpu->getVal(), nllCuda->getVal(), 1.E-10 * std::abs(nllCpu->getVal()));
+}
@@ -22,3 +22,35 @@ TEST(RooDataHist, BinningRangeCheck_8163)
   RooDataHist dataHist("dataHist", "", RooArgList(x), &hist);
   EXPECT_TRUE(hijack.str().empty()) << "Messages issued were: " << hijack.str();
 }
+
+/// The batch lookup of the weights must agree with the lookup of single bins.
+TEST(RooDataHist, BatchWeights)
+{
+  RooRealVar x("x", "x", 0., 10.);
+  RooRealVar y("y", "y", -5., 5.);
+  x.setBins(20);
+  y.setBins(7);
+  RooDataHist dataHist("dataHist", "dataHist", RooArgSet(x, y));
+
+  for (int i = 0; i < 140; ++i) {
+    dataHist.get(i);
+    dataHist.set(1. + i % 13);
+  }
+
+  std::vector<double> xVals;
+  std::vector<double> yVals;
+  for (int i = 0; i < 100; ++i) {
+    xVals.push_back(0.0999 * i);
+    yVals.push_back(-5. + 0.0997 * i);
+  }
+
+  std::vector<double> weights(xVals.size());
+  ASSERT_TRUE(dataHist.weights(weights.data(), {RooSpan<const double>(xVals), RooSpan<const double>(yVals)},
+      weights.size(), true));
+
+  for (std::size_t i = 0; i < xVals.size(); ++i) {
+    x.setVal(xVals[i]);
+    y.setVal(yVals[i]);
+    EXPECT_DOUBLE_EQ(weights[i], dataHist.weight(RooArgSet(x, y), 0, true)) << "at point " << i;
+  }
+}
@@ -0,0 +1,43 @@
+// Tests for the filling of RooDataSets from RDataFrame
+
+#include "RooDataSetHelper.h"
+
+#include "ROOT/RDataFrame.hxx"
+
+#include "gtest/gtest.h"
+
+TEST(RooDataSetHelper, FillColumns)
+{
+  RooRealVar x("x", "x", 0., 10.);
+  RooRealVar y("y", "y", -1., 1.);
+
+  ROOT::RDataFrame rdf(1000);
+  auto data = rdf.Define("x", [](ULong64_t entry) { return 0.01 * entry; }, {"rdfentry_"})
+                 .Define("y", [](ULong64_t entry) { return entry % 2 ? 0.5f : -0.5f; }, {"rdfentry_"})
+                 .Book<double, float>(RooDataSetHelper("data", "data", RooArgList(x, y)), {"x", "y"});
+
+  ASSERT_EQ(data->numEntries(), 1000);
+  EXPECT_DOUBLE_EQ(data->sumEntries(), 1000.);
+  EXPECT_DOUBLE_EQ(data->mean(x), 0.01 * 999. / 2.);
+  EXPECT_DOUBLE_EQ(data->mean(*static_cast<RooRealVar*>(data->get()->find("y"))), 0.);
+
+  auto row = data->get(10);
+  EXPECT_DOUBLE_EQ(static_cast<RooRealVar*>(row->find("x"))->getVal(), 0.1);
+  EXPECT_DOUBLE_EQ(static_cast<RooRealVar*>(row->find("y"))->getVal(), -0.5);
+}
+
+TEST(RooDataSetHelper, RangeAndWeights)
+{
+  RooRealVar x("x", "x", 0., 5.);
+  RooRealVar w("w", "w", 0., 10.);
+
+  ROOT::RDataFrame rdf(1000);
+  auto data = rdf.Define("x", [](ULong64_t entry) { return 0.01 * entry; }, {"rdfentry_"})
+                 .Define("w", []() { return 2.; })
+                 .Book<double, double>(RooDataSetHelper("data", "data", RooArgList(x, w), "w"), {"x", "w"});
+
+  // Events with x > 5 are outside of the range
+  EXPECT_EQ(data->numEntries(), 501);
+  EXPECT_TRUE(data->isWeighted());
+  EXPECT_DOUBLE_EQ(data->sumEntries(), 1002.);
+}
@@ -0,0 +1,62 @@
+// Tests for RooMinimizer
+
+#include "RooRealVar.h"
+#include "RooCategory.h"
+#include "RooGaussian.h"
+#include "RooSimultaneous.h"
+#include "RooDataSet.h"
+#include "RooAbsReal.h"
+#include "RooMinimizer.h"
+#include "RooGlobalFunc.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// The fit of a RooSimultaneous with the gradient calculated from the channels finds the same minimum
+TEST(RooMinimizer, ComponentGradient)
+{
+  RooRealVar x("x", "x", -10., 10.);
+  RooRealVar sigma("sigma", "sigma", 1.5, 0.1, 5.);
+  RooCategory channel("channel", "channel");
+  RooSimultaneous simPdf("simPdf", "simPdf", channel);
+
+  const int nChannels = 4;
+  std::vector<std::unique_ptr<RooRealVar>> means;
+  std::vector<std::unique_ptr<RooGaussian>> gausses;
+  for (int i = 0; i < nChannels; ++i) {
+    const std::string name = "ch" + std::to_string(i);
+    channel.defineType(name.c_str(), i);
+    means.emplace_back(new RooRealVar(("mean_" + name).c_str(), "mean", 0., -5., 5.));
+    gausses.emplace_back(new RooGaussian(("gauss_" + name).c_str(), "gauss", x, *means.back(), sigma));
+    simPdf.addPdf(*gausses.back(), name.c_str());
+  }
+
+  // Generate each channel with a different mean
+  for (int i = 0; i < nChannels; ++i)
+    means[i]->setVal(-3. + 2. * i);
+  std::unique_ptr<RooDataSet> data(simPdf.generate(RooArgSet(x, channel), 4000));
+
+  auto fit = [&](bool componentGradient) {
+    for (auto &mean : means)
+      mean->setVal(0.);
+    sigma.setVal(1.5);
+    std::unique_ptr<RooAbsReal> nll(simPdf.createNLL(*data));
+    RooMinimizer minimizer(*nll);
+    minimizer.setPrintLevel(-1);
+    minimizer.setComponentGradient(componentGradient);
+    EXPECT_EQ(minimizer.migrad(), 0);
+    std::vector<double> values;
+    for (auto &mean : means)
+      values.push_back(mean->getVal());
+    values.push_back(sigma.getVal());
+    return values;
+  };
+
+  const auto reference = fit(false);
+  const auto values = fit(true);
+  for (std::size_t i = 0; i < reference.size(); ++i)
+    EXPECT_NEAR(values[i], reference[i], 5.E-3) << "parameter " << i;
+}
@@ -12,6 +12,8 @@
 #include "TFile.h"
 #include "TSystem.h"
 
+#include <memory>
+
 #include "gtest/gtest.h"
 
 using namespace RooStats;
@@ -231,3 +233,42 @@ TEST_F(TestRooWorkspaceWithGaussian, HashLookupInWorkspace) {
   EXPECT_FALSE(model_constrained_orig->dependsOn(*ws->var("mu2")));
   EXPECT_NE(ws->pdf("Gauss_editPdf_orig"), nullptr);
 }
+
+
+/// Numeric integrals are cached in the workspace. The cached values must only be reused
+/// for the same integrand and the same integration limits.
+TEST(RooWorkspace, NumericIntegralCache)
+{
+  auto makeWorkspace = [](const char* formula) {
+    auto ws = std::make_unique<RooWorkspace>("ws");
+    ws->factory(Form("EXPR::pdf('%s', x[0.1, 1], y[0.1, 1], a[1, 0, 5])", formula));
+    ws->var("x")->setVal(0.5);
+    ws->var("y")->setVal(0.5);
+    return ws;
+  };
+  auto normVal = [](RooWorkspace& ws) {
+    return ws.pdf("pdf")->getVal(RooArgSet(*ws.var("x"), *ws.var("y")));
+  };
+
+  auto ws1 = makeWorkspace("exp(-a*x*x*y)");
+  const double val1 = normVal(*ws1);
+  ASSERT_GT(ws1->expensiveObjectCache().size(), 0);
+
+  // A different range of the observables gives a different integral
+  ws1->var("x")->setMax(2.);
+  EXPECT_LT(normVal(*ws1), val1);
+  ws1->var("x")->setMax(1.);
+  EXPECT_DOUBLE_EQ(normVal(*ws1), val1);
+
+  // A pdf with the same name but a different formula does not use the integrals of ws1
+  auto ws2 = makeWorkspace("exp(-a*x*y*y)");
+  ws2->expensiveObjectCache().importCacheObjects(ws1->expensiveObjectCache(), nullptr);
+  auto ws3 = makeWorkspace("exp(-a*x*y*y)");
+  EXPECT_DOUBLE_EQ(normVal(*ws2), normVal(*ws3));
+
+  // The same pdf can use the integrals of ws1
+  auto ws4 = makeWorkspace("exp(-a*x*x*y)");
+  ws4->expensiveObjectCache().importCacheObjects(ws1->expensiveObjectCache(), nullptr);
+  EXPECT_EQ(ws4->expensiveObjectCache().size(), ws1->expensiveObjectCache().size());
+  EXPECT_DOUBLE_EQ(normVal(*ws4), val1);
+}
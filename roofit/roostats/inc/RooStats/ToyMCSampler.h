@@ -234,6 +234,11 @@ class ToyMCSampler: public TestStatSampler {
       // calling with argument or NULL deactivates proof
       void SetProofConfig(ProofConfig *pc = NULL) { fProofConfig = pc; }
 
+      // run the toys in nWorkers processes forked with ROOT::TProcessExecutor (not available
+      // on Windows); 0 or 1 runs them in the current process. A ProofConfig takes precedence.
+      void SetNWorkers(unsigned int nWorkers) { fNWorkers = nWorkers; }
+      unsigned int GetNWorkers() const { return fNWorkers; }
+
       void SetProtoData(const RooDataSet* d) { fProtoData = d; }
 
    protected:
@@ -246,6 +251,9 @@ class ToyMCSampler: public TestStatSampler {
       // helper method for clearing  the cache
       virtual void ClearCache();
 
+      // run the toys in worker processes, see SetNWorkers()
+      RooDataSet* GetSamplingDistributionsMultiProcess(RooArgSet& paramPoint);
+
 
       // densities, snapshots, and test statistics to reweight to
       RooAbsPdf *fPdf; // model (can be alt or null)
@@ -279,6 +287,7 @@ class ToyMCSampler: public TestStatSampler {
       const RooDataSet *fProtoData; // in dev
 
       ProofConfig *fProofConfig;   //!
+      unsigned int fNWorkers;      //! number of worker processes for the toys
 
       mutable NuisanceParametersSampler *fNuisanceParametersSampler; //!
 
@@ -27,6 +27,13 @@ TestStatistic.
 For parallel runs, ToyMCSampler can be given an instance of ProofConfig
 and then run in parallel using proof or proof-lite. Internally, it uses
 ToyMCStudy with the RooStudyManager.
+
+Without PROOF, the toys can be run in local worker processes with SetNWorkers().
+The processes are forked with ROOT::TProcessExecutor, so that each of them works
+on its own copy of the model. Each worker generates its share of the toys with a
+seed drawn from RooRandom in the parent process, and the sampling distributions of
+the workers are merged in the parent. Adaptive sampling is not supported in this
+mode either.
 */
 
 #include "RooStats/ToyMCSampler.h"
@@ -50,6 +57,14 @@ ToyMCStudy with the RooStudyManager.
 
 #include "TMath.h"
 
+#ifndef R__WIN32
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
+#include <algorithm>
+#include <vector>
+
 
 using namespace RooFit;
 using namespace std;
@@ -175,6 +190,7 @@ ToyMCSampler::ToyMCSampler() : fSamplingDistName("SD"), fNToys(1)
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNWorkers = 0;
    fNuisanceParametersSampler = NULL;
 
    _allVars = NULL ;
@@ -215,6 +231,7 @@ ToyMCSampler::ToyMCSampler(TestStatistic &ts, Int_t ntoys) : fSamplingDistName(t
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNWorkers = 0;
    fNuisanceParametersSampler = NULL;
 
    _allVars = NULL ;
@@ -326,9 +343,13 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
 {
 
    // ======= S I N G L E   R U N ? =======
-   if(!fProofConfig)
+   if(!fProofConfig && fNWorkers <= 1)
       return GetSamplingDistributionsSingleWorker(paramPointIn);
 
+   // ======= L O C A L   W O R K E R S =======
+   if(!fProofConfig)
+      return GetSamplingDistributionsMultiProcess(paramPointIn);
+
    // ======= P A R A L L E L   R U N =======
    if (!CheckConfig()){
       oocoutE((TObject*)NULL, InputArguments)
@@ -369,6 +390,74 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
    return output;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Run the toys in fNWorkers processes forked with ROOT::TProcessExecutor. Each
+/// worker runs GetSamplingDistributionsSingleWorker() on its share of the toys,
+/// after reseeding RooRandom with a seed drawn in this process, and sends back its
+/// sampling distributions, which are appended in the order of the workers.
+
+RooDataSet* ToyMCSampler::GetSamplingDistributionsMultiProcess(RooArgSet& paramPointIn)
+{
+#ifdef R__WIN32
+   oocoutW((TObject*)NULL, InputArguments)
+      << "ToyMCSampler: worker processes are not supported on Windows, running the toys in this process."
+      << endl;
+   return GetSamplingDistributionsSingleWorker(paramPointIn);
+#else
+   if (!CheckConfig()){
+      oocoutE((TObject*)NULL, InputArguments)
+         << "Bad COnfiguration in ToyMCSampler "
+         << endl;
+      return nullptr;
+   }
+
+   // turn adaptive sampling off if given
+   if(fToysInTails) {
+      fToysInTails = 0;
+      oocoutW((TObject*)NULL, InputArguments)
+         << "Adaptive sampling in ToyMCSampler is not supported for parallel runs."
+         << endl;
+   }
+
+   const Int_t totToys = fNToys;
+   const unsigned int nWorkers = std::max(1u, std::min(fNWorkers, static_cast<unsigned int>(std::max(totToys, 0))));
+
+   // the seeds are drawn here, so that the workers generate independent toys, and
+   // the results are reproducible for a given seed of RooRandom
+   std::vector<UInt_t> seeds(nWorkers);
+   for (auto& seed : seeds)
+      seed = RooRandom::randomGenerator()->Integer(TMath::Limits<unsigned int>::Max());
+
+   // the workers are forks of this process: changing the sampler and the model in
+   // a worker does not affect the others
+   auto work = [&](unsigned int i) {
+      RooRandom::randomGenerator()->SetSeed(seeds[i]);
+      fNToys = totToys / nWorkers + (static_cast<Int_t>(i) < totToys % static_cast<Int_t>(nWorkers) ? 1 : 0);
+      return GetSamplingDistributionsSingleWorker(paramPointIn);
+   };
+
+   ROOT::TProcessExecutor pool(nWorkers);
+   std::vector<RooDataSet*> results = pool.Map(work, ROOT::TSeqU(nWorkers));
+
+   RooDataSet* output = nullptr;
+   for (auto result : results) {
+      if (!result) continue;
+      if (!output) {
+         output = result;
+      } else {
+         output->append(*result);
+         delete result;
+      }
+   }
+
+   if (!output) {
+      oocoutE((TObject*)NULL, Generation) << "ToyMCSampler: the worker processes did not return any toys." << endl;
+   }
+
+   return output;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// This is the main function for serial runs. It is called automatically
 /// from inside GetSamplingDistribution when no ProofConfig is given.
@@ -0,0 +1,56 @@
+// Tests for the ToyMCSampler
+
+#include "RooRealVar.h"
+#include "RooGaussian.h"
+#include "RooExtendPdf.h"
+#include "RooRandom.h"
+#include "RooStats/NumEventsTestStat.h"
+#include "RooStats/SamplingDistribution.h"
+#include "RooStats/ToyMCSampler.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <memory>
+
+using namespace RooStats;
+
+TEST(ToyMCSampler, WorkerProcesses) {
+  RooRealVar x("x", "x", -5., 5.);
+  RooRealVar mean("mean", "mean", 0., -1., 1.);
+  RooRealVar sigma("sigma", "sigma", 1., 0.1, 10.);
+  RooGaussian gauss("gauss", "gauss", x, mean, sigma);
+  RooRealVar nEvents("nEvents", "nEvents", 50., 0., 1000.);
+  RooExtendPdf pdf("pdf", "pdf", gauss, nEvents);
+
+  NumEventsTestStat testStat(pdf);
+  ToyMCSampler sampler(testStat, 101);
+  sampler.SetPdf(pdf);
+  RooArgSet observables(x);
+  sampler.SetObservables(observables);
+  RooArgSet poi(nEvents);
+  sampler.SetParametersForTestStat(poi);
+
+  RooRandom::randomGenerator()->SetSeed(4357);
+  sampler.SetNWorkers(3);
+  EXPECT_EQ(sampler.GetNWorkers(), 3u);
+  std::unique_ptr<SamplingDistribution> parallel(sampler.GetSamplingDistribution(poi));
+  ASSERT_NE(parallel, nullptr);
+  ASSERT_EQ(parallel->GetSamplingDistribution().size(), 101u);
+
+  // The toys are Poisson-distributed numbers of events around 50
+  double sum = 0.;
+  for (double value : parallel->GetSamplingDistribution())
+    sum += value;
+  EXPECT_NEAR(sum / 101., 50., 3.);
+
+  // The workers draw different toys
+  const auto& values = parallel->GetSamplingDistribution();
+  EXPECT_FALSE(std::equal(values.begin(), values.begin() + 34, values.begin() + 34));
+
+  // With the same seed, the results are reproducible
+  RooRandom::randomGenerator()->SetSeed(4357);
+  std::unique_ptr<SamplingDistribution> again(sampler.GetSamplingDistribution(poi));
+  ASSERT_NE(again, nullptr);
+  EXPECT_EQ(again->GetSamplingDistribution(), parallel->GetSamplingDistribution());
+}
@@ -52,6 +52,11 @@ protected:
    Int_t            fWorkingMode{0};      //! 1 - setting parameters, 2 - retrieving results
    Int_t            fIterationCount{-1};  //! number of iteration
    Bool_t           fNeedParBind{kFALSE}; //! indicates when parameters bind should be called
+   MYSQL_STMT      *fBatchStmt{nullptr};  //! statement inserting fBatchSize rows at once
+   Int_t            fBatchSize{0};        //! number of rows inserted by fBatchStmt
+   Int_t            fBatchCount{0};       //! number of rows stored in batch buffers
+   MYSQL_BIND      *fBatchBind{nullptr};  //! bind data of all rows of the batch
+   TParamData      *fBatchBuffer{nullptr};//! copies of parameter values of all rows of the batch
 
    Bool_t      IsSetParsMode() const { return fWorkingMode==1; }
    Bool_t      IsResultSetMode() const { return fWorkingMode==2; }
@@ -64,6 +69,10 @@ protected:
    void        FreeBuffers();
    void        SetBuffersNumber(Int_t n);
 
+   Bool_t      StoreBatchRow(const char *method);
+   Bool_t      ExecuteBatch(const char *method);
+   void        FreeBatchBuffers();
+
    void       *BeforeSet(const char* method, Int_t npar, Int_t sqltype, Bool_t sig = kTRUE, ULong_t size = 0);
 
    static ULong64_t fgAllocSizeLimit;
@@ -73,7 +82,7 @@ private:
    TMySQLStatement &operator=(const TMySQLStatement&) = delete;
 
 public:
-   TMySQLStatement(MYSQL_STMT* stmt, Bool_t errout = kTRUE);
+   TMySQLStatement(MYSQL_STMT* stmt, Bool_t errout = kTRUE, MYSQL_STMT* batchstmt = nullptr, Int_t batchsize = 0);
    virtual ~TMySQLStatement();
 
    static ULong_t GetAllocSizeLimit() { return fgAllocSizeLimit; }
@@ -81,7 +90,7 @@ public:
 
    void        Close(Option_t * = "") final;
 
-   Int_t       GetBufferLength() const final { return 1; }
+   Int_t       GetBufferLength() const final { return fBatchStmt ? fBatchSize : 1; }
    Int_t       GetNumParameters() final;
 
    Bool_t      SetNull(Int_t npar) final;
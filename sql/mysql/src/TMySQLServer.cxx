@@ -52,6 +52,8 @@
 #include "TObjString.h"
 #include "TObjArray.h"
 
+#include <cctype>
+
 ClassImp(TMySQLServer);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -699,10 +701,85 @@ Bool_t TMySQLServer::HasStatement() const
 }
 
 
+#if MYSQL_VERSION_ID >= 40100
+
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare statement inserting the values of up to nrows iterations of the
+/// statement sql at once. Only statements like "INSERT INTO ... VALUES (?, ?, ...)"
+/// can be converted, for other statements nullptr is returned. The number of rows
+/// is reduced if required by the limit of 65535 parameters per statement.
+
+static MYSQL_STMT *PrepareBatchInsert(MYSQL *mysql, const char *sql, Int_t numpars, Int_t &nrows)
+{
+   if ((nrows < 2) || (numpars <= 0)) return nullptr;
+
+   TString query = sql;
+   query = query.Strip(TString::kBoth);
+   query = query.Strip(TString::kTrailing, ';');
+   query = query.Strip(TString::kTrailing);
+   if (!query.BeginsWith("INSERT", TString::kIgnoreCase) && !query.BeginsWith("REPLACE", TString::kIgnoreCase))
+      return nullptr;
+
+   // find VALUES keyword, which is followed by the tuple of parameters till the end of the query
+   Ssiz_t pos = 0;
+   while ((pos = query.Index("VALUES", pos, TString::kIgnoreCase)) != kNPOS) {
+      if ((pos > 0) && (isspace(query[pos-1]) || (query[pos-1] == ')')) &&
+          ((pos + 6 < query.Length()) && (isspace(query[pos+6]) || (query[pos+6] == '('))))
+         break;
+      pos += 6;
+   }
+   if (pos == kNPOS) return nullptr;
+
+   TString tuple = query(pos + 6, query.Length() - pos - 6);
+   tuple = tuple.Strip(TString::kBoth);
+   if ((tuple.Length() < 2) || (tuple[0] != '(')) return nullptr;
+
+   // the tuple must end with the parenthesis matching the first one
+   Int_t depth = 0;
+   char quote = 0;
+   for (Ssiz_t n = 0; n < tuple.Length(); n++) {
+      if (quote) {
+         if (tuple[n] == quote) quote = 0;
+         continue;
+      }
+      if ((tuple[n] == '\'') || (tuple[n] == '"')) quote = tuple[n];
+      if (tuple[n] == '(') depth++;
+      if ((tuple[n] == ')') && (--depth == 0) && (n != tuple.Length() - 1)) return nullptr;
+   }
+   if (depth != 0) return nullptr;
+
+   if (nrows > 65535 / numpars) nrows = 65535 / numpars;
+   if (nrows < 2) return nullptr;
+
+   TString batch = query(0, pos);
+   batch += "VALUES ";
+   batch += tuple;
+   for (Int_t n = 1; n < nrows; n++) {
+      batch += ",";
+      batch += tuple;
+   }
+
+   MYSQL_STMT *stmt = mysql_stmt_init(mysql);
+   if (!stmt) return nullptr;
+
+   if (mysql_stmt_prepare(stmt, batch.Data(), batch.Length()) ||
+       (mysql_stmt_param_count(stmt) != (ULong_t) (nrows * numpars))) {
+      mysql_stmt_close(stmt);
+      return nullptr;
+   }
+
+   return stmt;
+}
+
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Produce TMySQLStatement.
+/// With bufsize > 1, statements like "INSERT INTO ... VALUES (?, ?, ...)"
+/// insert the parameters of bufsize iterations with a single multi-row
+/// INSERT statement, see TSQLStatement.
 
-TSQLStatement *TMySQLServer::Statement(const char *sql, Int_t)
+TSQLStatement *TMySQLServer::Statement(const char *sql, Int_t bufsize)
 {
 #if MYSQL_VERSION_ID < 40100
    ClearError();
@@ -727,7 +804,10 @@ TSQLStatement *TMySQLServer::Statement(const char *sql, Int_t)
       return nullptr;
    }
 
-   return new TMySQLStatement(stmt, fErrorOut);
+   Int_t batchsize = bufsize;
+   MYSQL_STMT *batchstmt = PrepareBatchInsert(fMySQL, sql, mysql_stmt_param_count(stmt), batchsize);
+
+   return new TMySQLStatement(stmt, fErrorOut, batchstmt, batchsize);
 
 #endif
 }
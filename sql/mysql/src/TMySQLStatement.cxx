@@ -33,8 +33,11 @@ ULong64_t TMySQLStatement::fgAllocSizeLimit = 0x8000000; // 128 Mb
 ////////////////////////////////////////////////////////////////////////////////
 /// Normal constructor.
 /// Checks if statement contains parameters tags.
+/// If batchstmt is specified, it must insert the same values as stmt for
+/// batchsize rows at once. The statement takes ownership of batchstmt and
+/// uses it to insert the parameters of batchsize iterations together.
 
-TMySQLStatement::TMySQLStatement(MYSQL_STMT* stmt, Bool_t errout) :
+TMySQLStatement::TMySQLStatement(MYSQL_STMT* stmt, Bool_t errout, MYSQL_STMT* batchstmt, Int_t batchsize) :
    TSQLStatement(errout),
    fStmt(stmt)
 {
@@ -45,7 +48,18 @@ TMySQLStatement::TMySQLStatement(MYSQL_STMT* stmt, Bool_t errout) :
       SetBuffersNumber(paramcount);
       fNeedParBind = kTRUE;
       fIterationCount = -1;
+
+      if (batchstmt && (batchsize > 1)) {
+         fBatchStmt = batchstmt;
+         fBatchSize = batchsize;
+         fBatchBind = new MYSQL_BIND[fBatchSize*fNumBuffers];
+         memset(fBatchBind, 0, sizeof(MYSQL_BIND)*fBatchSize*fNumBuffers);
+         fBatchBuffer = new TParamData[fBatchSize*fNumBuffers];
+      }
    }
+
+   if (batchstmt && !fBatchStmt)
+      mysql_stmt_close(batchstmt);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -64,8 +78,13 @@ void TMySQLStatement::Close(Option_t *)
    if (fStmt)
       mysql_stmt_close(fStmt);
 
+   if (fBatchStmt)
+      mysql_stmt_close(fBatchStmt);
+
    fStmt = nullptr;
+   fBatchStmt = nullptr;
 
+   FreeBatchBuffers();
    FreeBuffers();
 }
 
@@ -118,8 +137,10 @@ Bool_t TMySQLStatement::Process()
    if (IsSetParsMode()) {
       if (fIterationCount>=0)
          if (!NextIteration()) return kFALSE;
+      if ((fBatchCount > 0) && !ExecuteBatch("Process")) return kFALSE;
       fWorkingMode = 0;
       fIterationCount = -1;
+      FreeBatchBuffers();
       FreeBuffers();
       return kTRUE;
    }
@@ -256,6 +277,9 @@ Bool_t TMySQLStatement::NextIteration()
 
    if (fIterationCount==0) return kTRUE;
 
+   if (fBatchBuffer)
+      return StoreBatchRow("NextIteration");
+
    if (fNeedParBind) {
       fNeedParBind = kFALSE;
       if (mysql_stmt_bind_param(fStmt, fBind))
@@ -268,6 +292,110 @@ Bool_t TMySQLStatement::NextIteration()
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Copy parameter values of the current iteration into the batch buffers.
+/// When the buffers of all rows of the batch are filled, the batch is inserted.
+
+Bool_t TMySQLStatement::StoreBatchRow(const char *method)
+{
+   TParamData *data = fBatchBuffer + fBatchCount*fNumBuffers;
+   MYSQL_BIND *bind = fBatchBind + fBatchCount*fNumBuffers;
+
+   for (Int_t n = 0; n < fNumBuffers; n++) {
+      if (fBuffer[n].fSqlType == 0) {
+         SetError(-1, Form("Value of parameter %d not specified", n), method);
+         return kFALSE;
+      }
+
+      // values of strings and binary data have variable length
+      ULong_t len = fBuffer[n].fSize;
+      switch (fBuffer[n].fSqlType) {
+#if MYSQL_VERSION_ID >= 50022
+         case MYSQL_TYPE_NEWDECIMAL:
+#endif
+         case MYSQL_TYPE_STRING:
+         case MYSQL_TYPE_VAR_STRING:
+         case MYSQL_TYPE_TINY_BLOB:
+         case MYSQL_TYPE_BLOB:
+         case MYSQL_TYPE_MEDIUM_BLOB:
+         case MYSQL_TYPE_LONG_BLOB:
+            len = fBuffer[n].fResLength;
+            break;
+      }
+
+      if (!data[n].fMem || ((ULong_t) data[n].fSize < len)) {
+         free(data[n].fMem);
+         data[n].fSize = len > 0 ? len : 1;
+         data[n].fMem = malloc(data[n].fSize);
+      }
+      if (len > 0)
+         memcpy(data[n].fMem, fBuffer[n].fMem, len);
+      data[n].fResLength = fBuffer[n].fResLength;
+      data[n].fResNull = fBuffer[n].fResNull;
+
+      bind[n].buffer_type = fBind[n].buffer_type;
+      bind[n].is_unsigned = fBind[n].is_unsigned;
+      bind[n].buffer = data[n].fMem;
+      bind[n].buffer_length = len;
+      bind[n].length = &(data[n].fResLength);
+      bind[n].is_null = &(data[n].fResNull);
+   }
+
+   if (++fBatchCount < fBatchSize) return kTRUE;
+
+   return ExecuteBatch(method);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Insert rows stored in the batch buffers. A complete batch is inserted with
+/// the multi-row statement, the rows of an incomplete one with the normal statement.
+
+Bool_t TMySQLStatement::ExecuteBatch(const char *method)
+{
+   Int_t nrows = fBatchCount;
+   fBatchCount = 0;
+
+   if (nrows == fBatchSize) {
+      if (mysql_stmt_bind_param(fBatchStmt, fBatchBind) || mysql_stmt_execute(fBatchStmt)) {
+         unsigned int stmterrno = mysql_stmt_errno(fBatchStmt);
+         SetError(stmterrno ? stmterrno : 11111, stmterrno ? mysql_stmt_error(fBatchStmt) : "MySQL statement error", method);
+         return kFALSE;
+      }
+      return kTRUE;
+   }
+
+   // the parameters of the normal statement are bound to the batch buffers now
+   fNeedParBind = kTRUE;
+
+   for (Int_t row = 0; row < nrows; row++) {
+      if (mysql_stmt_bind_param(fStmt, fBatchBind + row*fNumBuffers))
+         CheckErrNo(method, kTRUE, kFALSE);
+
+      if (mysql_stmt_execute(fStmt))
+         CheckErrNo(method, kTRUE, kFALSE);
+   }
+
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release buffers used for the batch of rows.
+
+void TMySQLStatement::FreeBatchBuffers()
+{
+   if (fBatchBuffer) {
+      for (Int_t n = 0; n < fBatchSize*fNumBuffers; n++)
+         free(fBatchBuffer[n].fMem);
+      delete[] fBatchBuffer;
+   }
+
+   delete[] fBatchBind;
+
+   fBatchBuffer = nullptr;
+   fBatchBind = nullptr;
+   fBatchCount = 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Release all buffers, used by statement.
 
@@ -1056,7 +1184,7 @@ Bool_t TMySQLStatement::SetTimestamp(Int_t npar, Int_t year, Int_t month, Int_t
 /// Normal constructor.
 /// For MySQL version < 4.1 no statement is supported
 
-TMySQLStatement::TMySQLStatement(MYSQL_STMT*, Bool_t)
+TMySQLStatement::TMySQLStatement(MYSQL_STMT*, Bool_t, MYSQL_STMT*, Int_t)
 {
 }
 
@@ -1156,6 +1284,29 @@ void TMySQLStatement::SetBuffersNumber(Int_t)
 {
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Copy parameter values of the current iteration into the batch buffers.
+
+Bool_t TMySQLStatement::StoreBatchRow(const char *)
+{
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Insert rows stored in the batch buffers.
+
+Bool_t TMySQLStatement::ExecuteBatch(const char *)
+{
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release buffers used for the batch of rows.
+
+void TMySQLStatement::FreeBatchBuffers()
+{
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Convert field value to string.
 
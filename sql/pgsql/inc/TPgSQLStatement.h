@@ -37,6 +37,8 @@ private:
    int                  *fParamFormats{nullptr};  //! data type (OID)
    Int_t                 fNumResultRows{0};
    Int_t                 fNumResultCols{0};
+   Int_t                 fBufferLength{1};        //! number of iterations sent at once in pipeline mode
+   Int_t                 fNumPipelined{0};        //! number of iterations sent, but not yet synchronized
 
    Bool_t      IsSetParsMode() const { return fWorkingMode==1; }
    Bool_t      IsResultSetMode() const { return fWorkingMode==2; }
@@ -51,13 +53,16 @@ private:
 
    void        ConvertTimeToUTC(const TString &PQvalue, Int_t& year, Int_t& month, Int_t& day, Int_t& hour, Int_t& min, Int_t& sec);
 
+   Bool_t      SendIteration(const char *method);
+   Bool_t      SyncPipeline(const char *method);
+
 public:
-   TPgSQLStatement(PgSQL_Stmt_t* stmt, Bool_t errout = kTRUE);
+   TPgSQLStatement(PgSQL_Stmt_t* stmt, Bool_t errout = kTRUE, Int_t bufsize = 1);
    virtual ~TPgSQLStatement();
 
    void        Close(Option_t * = "") final;
 
-   Int_t       GetBufferLength() const final { return 1; }
+   Int_t       GetBufferLength() const final { return fBufferLength; }
    Int_t       GetNumParameters() final;
 
    Bool_t      SetNull(Int_t npar) final;
@@ -85,6 +90,7 @@ public:
    Int_t       GetNumFields() final;
    const char *GetFieldName(Int_t nfield) final;
    Bool_t      NextResultRow() final;
+   Int_t       NextResultRows(Int_t maxrows, const char *types, void **buffers, Bool_t **nulls = nullptr) final;
 
    Bool_t      IsNull(Int_t npar) final;
    Int_t       GetInt(Int_t npar) final;
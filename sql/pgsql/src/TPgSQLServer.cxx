@@ -351,9 +351,11 @@ Bool_t TPgSQLServer::HasStatement() const
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Produce TPgSQLStatement.
+/// With bufsize > 1, the iterations of a statement with parameters are sent
+/// to the server in pipeline mode, bufsize iterations at once (libpq 14 or newer).
 
 #ifdef PG_VERSION_NUM
-TSQLStatement* TPgSQLServer::Statement(const char *sql, Int_t)
+TSQLStatement* TPgSQLServer::Statement(const char *sql, Int_t bufsize)
 #else
 TSQLStatement* TPgSQLServer::Statement(const char *, Int_t)
 #endif
@@ -375,7 +377,7 @@ TSQLStatement* TPgSQLServer::Statement(const char *, Int_t)
    ExecStatusType stat = PQresultStatus(stmt->fRes);
    if (pgsql_success(stat)) {
       fErrorOut = stat;
-      return new TPgSQLStatement(stmt, fErrorOut);
+      return new TPgSQLStatement(stmt, fErrorOut, bufsize);
    } else {
       SetError(stat, PQresultErrorMessage(stmt->fRes), "Statement");
       stmt->fConn = 0;
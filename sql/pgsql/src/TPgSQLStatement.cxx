@@ -43,8 +43,10 @@ static const Int_t kBindStringSize = 30;    // big enough to handle text rep. of
 ////////////////////////////////////////////////////////////////////////////////
 /// Normal constructor.
 /// Checks if statement contains parameters tags.
+/// With bufsize > 1, the iterations of the statement are sent to the
+/// server in pipeline mode and synchronized each bufsize iterations.
 
-TPgSQLStatement::TPgSQLStatement(PgSQL_Stmt_t* stmt, Bool_t errout):
+TPgSQLStatement::TPgSQLStatement(PgSQL_Stmt_t* stmt, Bool_t errout, Int_t bufsize):
    TSQLStatement(errout),
    fStmt(stmt),
    fNumBuffers(0),
@@ -55,7 +57,8 @@ TPgSQLStatement::TPgSQLStatement(PgSQL_Stmt_t* stmt, Bool_t errout):
    fParamLengths(0),
    fParamFormats(0),
    fNumResultRows(0),
-   fNumResultCols(0)
+   fNumResultCols(0),
+   fBufferLength(bufsize > 1 ? bufsize : 1)
 {
    // Given fRes not used, we retrieve the statement using the connection.
    if (fStmt->fRes != NULL) {
@@ -89,6 +92,9 @@ TPgSQLStatement::~TPgSQLStatement()
 
 void TPgSQLStatement::Close(Option_t *)
 {
+   if (fNumPipelined > 0)
+      SyncPipeline("Close");
+
    if (fStmt->fRes)
       PQclear(fStmt->fRes);
 
@@ -171,6 +177,12 @@ Bool_t TPgSQLStatement::Process()
    }
 
    if (IsSetParsMode()) {
+#ifdef LIBPQ_HAS_PIPELINING
+      if (fBufferLength > 1) {
+         fStmt->fRes = nullptr;
+         return SendIteration("Process") && SyncPipeline("Process");
+      }
+#endif
       fStmt->fRes= PQexecPrepared(fStmt->fConn,"preparedstmt",fNumBuffers,
                                  (const char* const*)fBind,
                                  0,0,0);
@@ -285,6 +297,17 @@ Bool_t TPgSQLStatement::NextIteration()
 
    if (fIterationCount==0) return kTRUE;
 
+#ifdef LIBPQ_HAS_PIPELINING
+   if (fBufferLength > 1) {
+      if (!SendIteration("NextIteration"))
+         return kFALSE;
+      return (fNumPipelined < fBufferLength) || SyncPipeline("NextIteration");
+   }
+#endif
+
+   if (fStmt->fRes)
+      PQclear(fStmt->fRes);
+
    fStmt->fRes= PQexecPrepared(fStmt->fConn,"preparedstmt",fNumBuffers,
                                (const char* const*)fBind,
                                0,//fParamLengths,
@@ -298,6 +321,133 @@ Bool_t TPgSQLStatement::NextIteration()
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Send current parameters of the statement to the server in pipeline mode,
+/// entering this mode if required. Results are collected by SyncPipeline().
+
+Bool_t TPgSQLStatement::SendIteration(const char *method)
+{
+#ifdef LIBPQ_HAS_PIPELINING
+   if ((PQpipelineStatus(fStmt->fConn) == PQ_PIPELINE_OFF) && !PQenterPipelineMode(fStmt->fConn)) {
+      SetError(-1, PQerrorMessage(fStmt->fConn), method);
+      return kFALSE;
+   }
+
+   if (!PQsendQueryPrepared(fStmt->fConn, "preparedstmt", fNumBuffers, (const char* const*)fBind, 0, 0, 0)) {
+      TString errmsg = PQerrorMessage(fStmt->fConn);
+      SyncPipeline(method);
+      SetError(-1, errmsg.Data(), method);
+      return kFALSE;
+   }
+
+   fNumPipelined++;
+   return kTRUE;
+#else
+   SetError(-1, "Pipeline mode requires libpq 14 or newer", method);
+   return kFALSE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Synchronize the pipeline with the server and check the results of all
+/// iterations sent since the last synchronization. The first failed iteration
+/// defines the error of the statement, the following ones are aborted by the server.
+/// The result of the last iteration is kept to provide GetNumAffectedRows().
+
+Bool_t TPgSQLStatement::SyncPipeline(const char *method)
+{
+   fNumPipelined = 0;
+
+#ifdef LIBPQ_HAS_PIPELINING
+   Bool_t ok = kTRUE;
+
+   if (!PQpipelineSync(fStmt->fConn)) {
+      SetError(-1, PQerrorMessage(fStmt->fConn), method);
+      ok = kFALSE;
+   } else {
+      // each iteration delivers its result followed by a null pointer,
+      // two null pointers in sequence mean that the connection is broken
+      Int_t nempty = 0;
+      while (nempty < 2) {
+         PGresult *res = PQgetResult(fStmt->fConn);
+         if (!res) {
+            nempty++;
+            continue;
+         }
+         nempty = 0;
+         ExecStatusType stat = PQresultStatus(res);
+         if (stat == PGRES_PIPELINE_SYNC) {
+            PQclear(res);
+            break;
+         }
+         if (ok && !pgsql_success(stat)) {
+            SetError(stat, PQresultErrorMessage(res), method);
+            ok = kFALSE;
+         }
+         if (fStmt->fRes)
+            PQclear(fStmt->fRes);
+         fStmt->fRes = res;
+      }
+   }
+
+   PQexitPipelineMode(fStmt->fConn);
+
+   return ok;
+#else
+   SetError(-1, "Pipeline mode requires libpq 14 or newer", method);
+   return kFALSE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fetch up to maxrows rows into column-wise buffers, see
+/// TSQLStatement::NextResultRows(). The values are converted directly from
+/// the result set, which is completely stored on the client side.
+
+Int_t TPgSQLStatement::NextResultRows(Int_t maxrows, const char *types, void **buffers, Bool_t **nulls)
+{
+   ClearError();
+
+   if (!fStmt || !IsResultSetMode() || (maxrows <= 0) || !buffers) {
+      SetError(-1, "Cannot fetch rows for that statement", "NextResultRows");
+      return -1;
+   }
+
+   Int_t ntypes = types ? strlen(types) : 0;
+   if (ntypes > fNumResultCols) ntypes = fNumResultCols;
+
+   Int_t first = fIterationCount + 1;
+   Int_t nrows = TMath::Max(0, TMath::Min(maxrows, fNumResultRows - first));
+
+   for (Int_t n = 0; n < ntypes; n++) {
+      if (!buffers[n] || (types[n] == '-')) continue;
+      if (!strchr("ILDS", types[n])) {
+         SetError(-1, Form("Unsupported buffer type %c of field %d", types[n], n), "NextResultRows");
+         return -1;
+      }
+      for (Int_t i = 0; i < nrows; i++) {
+         Bool_t isnull = PQgetisnull(fStmt->fRes, first + i, n);
+         if (nulls && nulls[n])
+            nulls[n][i] = isnull;
+         const char *value = isnull ? "" : PQgetvalue(fStmt->fRes, first + i, n);
+         switch (types[n]) {
+            case 'I': ((Int_t *) buffers[n])[i] = atoi(value); break;
+#ifndef R__WIN32
+            case 'L': ((Long64_t *) buffers[n])[i] = atoll(value); break;
+#else
+            case 'L': ((Long64_t *) buffers[n])[i] = _atoi64(value); break;
+#endif
+            case 'D': ((Double_t *) buffers[n])[i] = atof(value); break;
+            case 'S': ((TString *) buffers[n])[i] = value; break;
+         }
+      }
+   }
+
+   fIterationCount += nrows;
+
+   return nrows;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Release all buffers, used by statement.
 
@@ -914,7 +1064,7 @@ Bool_t TPgSQLStatement::SetTimestamp(Int_t npar, const TTimeStamp& tm)
 /// Normal constructor.
 /// For PgSQL version < 8.2 no statement is supported.
 
-TPgSQLStatement::TPgSQLStatement(PgSQL_Stmt_t*, Bool_t)
+TPgSQLStatement::TPgSQLStatement(PgSQL_Stmt_t*, Bool_t, Int_t)
 {
 }
 
@@ -989,6 +1139,14 @@ Bool_t TPgSQLStatement::NextResultRow()
    return kFALSE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fetch up to maxrows rows into column-wise buffers.
+
+Int_t TPgSQLStatement::NextResultRows(Int_t, const char *, void **, Bool_t **)
+{
+   return -1;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment iteration counter for statement, where parameter can be set.
@@ -1007,6 +1165,22 @@ void TPgSQLStatement::FreeBuffers()
 {
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Send current parameters of the statement in pipeline mode.
+
+Bool_t TPgSQLStatement::SendIteration(const char *)
+{
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Synchronize the pipeline with the server.
+
+Bool_t TPgSQLStatement::SyncPipeline(const char *)
+{
+   return kFALSE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Allocate buffers for statement parameters/ result fields.
 
@@ -29,6 +29,9 @@ private:
    Int_t                 fWorkingMode{0};    //! 1 - setting parameters, 2 - retrieving results
    Int_t                 fNumPars{0};        //! Number of bindable / gettable parameters
    Int_t                 fIterationCount{0}; //! Iteration count
+   Int_t                 fBufferLength{1};   //! Number of iterations executed within one savepoint
+   Int_t                 fNumBatched{0};     //! Number of iterations executed within the open savepoint
+   Bool_t                fBatchOpen{kFALSE}; //! Indicates if savepoint for iterations is open
 
    Bool_t      IsSetParsMode() const { return fWorkingMode==1; }
    Bool_t      IsResultSetMode() const { return fWorkingMode==2; }
@@ -40,8 +43,12 @@ private:
 
    Bool_t CheckBindError(const char *method, int res);
 
+   Bool_t      Step(const char *method);
+   Bool_t      BeginBatch(const char *method);
+   Bool_t      EndBatch(const char *method);
+
 public:
-   TSQLiteStatement(SQLite3_Stmt_t* stmt, Bool_t errout = kTRUE);
+   TSQLiteStatement(SQLite3_Stmt_t* stmt, Bool_t errout = kTRUE, Int_t bufsize = 1);
    virtual ~TSQLiteStatement();
 
    void        Close(Option_t * = "") final;
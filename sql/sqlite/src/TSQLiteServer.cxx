@@ -337,8 +337,10 @@ Bool_t TSQLiteServer::HasStatement() const
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Produce TSQLiteStatement.
+/// With bufsize > 1, each bufsize iterations of a statement with parameters
+/// are executed within one savepoint instead of one transaction per row.
 
-TSQLStatement* TSQLiteServer::Statement(const char *sql, Int_t)
+TSQLStatement* TSQLiteServer::Statement(const char *sql, Int_t bufsize)
 {
    if (!sql || !*sql) {
       SetError(-1, "no query string specified", "Statement");
@@ -368,7 +370,7 @@ TSQLStatement* TSQLiteServer::Statement(const char *sql, Int_t)
    stmt->fConn = fSQLite;
    stmt->fRes  = preparedStmt;
 
-   return new TSQLiteStatement(stmt);
+   return new TSQLiteStatement(stmt, kTRUE, bufsize);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
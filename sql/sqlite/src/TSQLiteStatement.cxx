@@ -32,13 +32,16 @@ ClassImp(TSQLiteStatement);
 ////////////////////////////////////////////////////////////////////////////////
 /// Normal constructor.
 /// Checks if statement contains parameters tags.
+/// With bufsize > 1, each bufsize iterations of a statement with parameters
+/// are executed within one savepoint, i.e. committed at once.
 
-TSQLiteStatement::TSQLiteStatement(SQLite3_Stmt_t* stmt, Bool_t errout):
+TSQLiteStatement::TSQLiteStatement(SQLite3_Stmt_t* stmt, Bool_t errout, Int_t bufsize):
       TSQLStatement(errout),
       fStmt(stmt),
       fWorkingMode(0),
       fNumPars(0),
-      fIterationCount(0)
+      fIterationCount(0),
+      fBufferLength(bufsize > 1 ? bufsize : 1)
 {
    unsigned long bindParamcount = sqlite3_bind_parameter_count(fStmt->fRes);
 
@@ -64,6 +67,8 @@ TSQLiteStatement::~TSQLiteStatement()
 
 void TSQLiteStatement::Close(Option_t *)
 {
+   EndBatch("Close");
+
    if (fStmt->fRes) {
       sqlite3_finalize(fStmt->fRes);
    }
@@ -124,14 +129,75 @@ Bool_t TSQLiteStatement::CheckBindError(const char *method, int res)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Process statement.
+/// For statements with parameters and a buffer length > 1, the savepoint
+/// of the iterations is released after the last iteration is executed.
 
 Bool_t TSQLiteStatement::Process()
 {
    CheckStmt("Process", kFALSE);
 
+   if (!IsSetParsMode() || (fBufferLength < 2))
+      return Step("Process");
+
+   Bool_t res = BeginBatch("Process") && Step("Process");
+
+   return EndBatch("Process") && res;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Open savepoint for the next iterations, if not yet done.
+
+Bool_t TSQLiteStatement::BeginBatch(const char *method)
+{
+   if (fBatchOpen)
+      return kTRUE;
+
+   char *errmsg = nullptr;
+   if (sqlite3_exec(fStmt->fConn, "SAVEPOINT ROOT_STATEMENT_BATCH", nullptr, nullptr, &errmsg) != SQLITE_OK) {
+      SetError(-1, Form("SQLite error when opening savepoint: %s", errmsg ? errmsg : ""), method);
+      sqlite3_free(errmsg);
+      return kFALSE;
+   }
+
+   fBatchOpen = kTRUE;
+   fNumBatched = 0;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release savepoint of the iterations, if open. Outside of a transaction
+/// this commits the iterations executed since BeginBatch().
+
+Bool_t TSQLiteStatement::EndBatch(const char *method)
+{
+   if (!fBatchOpen)
+      return kTRUE;
+
+   fBatchOpen = kFALSE;
+   fNumBatched = 0;
+
+   char *errmsg = nullptr;
+   if (sqlite3_exec(fStmt->fConn, "RELEASE SAVEPOINT ROOT_STATEMENT_BATCH", nullptr, nullptr, &errmsg) != SQLITE_OK) {
+      SetError(-1, Form("SQLite error when releasing savepoint: %s", errmsg ? errmsg : ""), method);
+      sqlite3_free(errmsg);
+      return kFALSE;
+   }
+
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Execute one step of the statement.
+
+Bool_t TSQLiteStatement::Step(const char *method)
+{
+   CheckStmt(method, kFALSE);
+
    int res = sqlite3_step(fStmt->fRes);
    if ((res != SQLITE_DONE) && (res != SQLITE_ROW)) {
-      SetError(-1, Form("SQLite error code during statement-stepping: %d %s", res, sqlite3_errmsg(fStmt->fConn)), "Process");
+      SetError(-1, Form("SQLite error code during statement-stepping: %d %s", res, sqlite3_errmsg(fStmt->fConn)), method);
+      // the failed step has to be reset before the savepoint can be released
+      sqlite3_reset(fStmt->fRes);
       return kFALSE;
    }
 
@@ -264,7 +330,21 @@ Bool_t TSQLiteStatement::NextIteration()
 
    fIterationCount++;
 
-   return Process();
+   if (fBufferLength < 2)
+      return Process();
+
+   if (!BeginBatch("NextIteration"))
+      return kFALSE;
+
+   if (!Step("NextIteration")) {
+      EndBatch("NextIteration");
+      return kFALSE;
+   }
+
+   if (++fNumBatched >= fBufferLength)
+      return EndBatch("NextIteration");
+
+   return kTRUE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
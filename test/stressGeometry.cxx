@@ -32,6 +32,11 @@
 // root > stressGeometry(exp_name); // where exp_name is the geometry file name without .root
 // OR simply: stressGeometry(); to run tests for a set of geometries
 //
+//  The option mt[=N] (e.g. stressGeometry alice mt=64) runs in addition a benchmark of the
+//  multi-threaded navigation: the same tracks are transported with 1, 2, 4, ... up to N
+//  threads (64 by default), each thread using its own navigator, and the throughput and
+//  speedup are reported. The results have to be identical to the single-threaded ones.
+//
 // Authors: Rene Brun, Andrei Gheata, 22 march 2005
 
 #include "TStopwatch.h"
@@ -53,18 +58,23 @@
 #include "TSystem.h"
 #include "TVirtualGeoConverter.h"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 // Total and reference times
 Double_t tpstot = 0;
 Double_t tpsref = 112.1; //time including the generation of the ref files
 Bool_t testfailed = kFALSE;
 #ifndef __CINT__
-void stressGeometry(const char*, Bool_t, Bool_t);
+void stressGeometry(const char*, Bool_t, Bool_t, Int_t);
 
 int main(int argc, char **argv)
 {
    gROOT->SetBatch();
    TApplication theApp("App", &argc, argv);
    Bool_t vecgeom = kFALSE;
+   Int_t nthreads = 0;
    TString geom = "*";
    if (argc > 1) geom = argv[1];
    geom.ToLower();
@@ -74,9 +84,11 @@ int main(int argc, char **argv)
    if (argc > 1) {
        for (Int_t iarg=1; iarg<argc; ++iarg) {
           if (!strcmp(argv[iarg], "vecgeom")) vecgeom = kTRUE;
+          if (!strcmp(argv[iarg], "mt")) nthreads = 64;
+          if (!strncmp(argv[iarg], "mt=", 3)) nthreads = atoi(argv[iarg] + 3);
        }
    }
-   stressGeometry(geom,kFALSE,vecgeom);
+   stressGeometry(geom,kFALSE,vecgeom,nthreads);
    return 0;
 }
 
@@ -235,9 +247,10 @@ Bool_t gen_ref=kFALSE;
 void FindRad(Double_t x, Double_t y, Double_t z,Double_t theta, Double_t phi, Int_t &nbound, Float_t &length, Float_t &safe, Float_t &rad, Bool_t verbose=kFALSE);
 void ReadRef(Int_t kexp);
 void WriteRef(Int_t kexp);
+void BenchmarkThreads(Int_t kexp, Int_t maxthreads);
 void InspectRef(const char *exp="alice", Int_t vers=3);
 
-void stressGeometry(const char *exp="*", Bool_t generate_ref=kFALSE, Bool_t vecgeom=kFALSE) {
+void stressGeometry(const char *exp="*", Bool_t generate_ref=kFALSE, Bool_t vecgeom=kFALSE, Int_t nthreads=0) {
    TGeoManager::SetVerboseLevel(0);
    gen_ref = generate_ref;
    gErrorIgnoreLevel = 10;
@@ -287,6 +300,7 @@ void stressGeometry(const char *exp="*", Bool_t generate_ref=kFALSE, Bool_t vecg
       }
 
       ReadRef(i);
+      if (nthreads > 0) BenchmarkThreads(i, nthreads);
    }
    if (all && tpstot>0) {
       Float_t rootmarks = 800*tpsref/tpstot;
@@ -454,6 +468,63 @@ void WriteRef(Int_t kexp) {
    delete T;
 }
 
+void BenchmarkThreads(Int_t kexp, Int_t maxthreads) {
+   // Transport the same tracks with an increasing number of threads and compare
+   // the throughput and the results with the ones of a single thread
+   const Int_t ntracks = 20000;
+   TRandom3 r;
+   Double_t point[3];
+   TGeoShape *top = gGeoManager->GetMasterVolume()->GetShape();
+   std::vector<p_t> tracks;
+   tracks.reserve(ntracks);
+   while ((Int_t)tracks.size() < ntracks) {
+      p_t t;
+      t.x = r.Uniform(-boxes[kexp][0], boxes[kexp][0]);
+      t.y = r.Uniform(-boxes[kexp][1], boxes[kexp][1]);
+      t.z = r.Uniform(-boxes[kexp][2], boxes[kexp][2]);
+      point[0] = t.x;
+      point[1] = t.y;
+      point[2] = t.z;
+      if (!top->Contains(point)) continue;
+      t.phi   = 2*TMath::Pi()*r.Rndm();
+      t.theta = TMath::ACos(1.-2.*r.Rndm());
+      FindRad(t.x, t.y, t.z, t.theta, t.phi, t.nbound, t.length, t.safe, t.rad);
+      tracks.push_back(t);
+   }
+   std::vector<Int_t> nthreadsList;
+   for (Int_t nthreads = 1; nthreads < maxthreads; nthreads *= 2) nthreadsList.push_back(nthreads);
+   nthreadsList.push_back(maxthreads);
+   gGeoManager->SetMaxThreads(maxthreads);
+   Double_t time1 = 0;
+   for (Int_t nthreads : nthreadsList) {
+      // Reuse the thread data slots of the previous round
+      TGeoManager::ClearThreadsMap();
+      std::atomic<Int_t> next(0);
+      std::atomic<Int_t> nbad(0);
+      TStopwatch sw;
+      std::vector<std::thread> workers;
+      for (Int_t ith = 0; ith < nthreads; ith++) {
+         workers.emplace_back([&]() {
+            TGeoNavigator *nav = gGeoManager->AddNavigator();
+            p_t t;
+            Int_t itrack;
+            while ((itrack = next++) < ntracks) {
+               const p_t &ref = tracks[itrack];
+               FindRad(ref.x, ref.y, ref.z, ref.theta, ref.phi, t.nbound, t.length, t.safe, t.rad);
+               if (t.nbound != ref.nbound || t.length != ref.length || t.rad != ref.rad) nbad++;
+            }
+            gGeoManager->RemoveNavigator(nav);
+         });
+      }
+      for (auto &worker : workers) worker.join();
+      Double_t time = sw.RealTime();
+      if (nthreads == 1) time1 = time;
+      fprintf(stderr,"*     mt %-15s %3d threads: %10.0f tracks/s  speedup %6.2f%s\n", exps[kexp], nthreads,
+              ntracks/time, time1/time, nbad ? "  ...... FAILED" : "");
+      if (nbad) testfailed = kTRUE;
+   }
+}
+
 void FindRad(Double_t x, Double_t y, Double_t z,Double_t theta, Double_t phi, Int_t &nbound, Float_t &length, Float_t &safe, Float_t &rad, Bool_t verbose) {
    Double_t xp  = TMath::Sin(theta)*TMath::Cos(phi);
    Double_t yp  = TMath::Sin(theta)*TMath::Sin(phi);
@@ -68,6 +68,8 @@
 #include <iomanip>
 #include <limits>
 #include <cmath>
+#include <algorithm>
+#include <vector>
 #include "TBenchmark.h"
 #include "TROOT.h"
 #include "TRandom3.h"
@@ -76,6 +78,7 @@
 #include "TFile.h"
 #include "TF1.h"
 #include "TMath.h"
+#include "TKDTree.h"
 
 #include "Math/Vector2D.h"
 #include "Math/Vector3D.h"
@@ -1439,6 +1442,74 @@ int testTrack(int ngen) {
 
 
 
+int testKDTree(int ngen) {
+
+   std::cout <<"******************************************************************************\n";
+   std::cout << "\tTest of TKDTree\n";
+   std::cout <<"******************************************************************************\n";
+
+   int iret = 0;
+   const Int_t ndim = 3;
+   const Int_t npoints = 100*ngen;
+   const Int_t bsize = 10;
+   TRandom3 r(4357);
+   std::vector<double> data0(ndim*npoints);
+   for (auto & x : data0) x = r.Rndm();
+   double * data[ndim];
+   for (int idim = 0; idim < ndim; ++idim) data[idim] = &data0[idim*npoints];
+
+   PrintTest("TKDTree build");
+   TKDTreeID tree(npoints, ndim, bsize, data);
+   {
+      Timer timer;
+      tree.Build();
+   }
+#ifdef R__USE_IMT
+   // the parallel build must give the same tree
+   ROOT::EnableImplicitMT();
+   TKDTreeID treeMT(npoints, ndim, bsize, data);
+   {
+      Timer timer;
+      treeMT.Build();
+   }
+   ROOT::DisableImplicitMT();
+   for (int i = 0; i < tree.GetNNodes(); ++i)
+      if (tree.GetNodeAxis(i) != treeMT.GetNodeAxis(i) || tree.GetNodeValue(i) != treeMT.GetNodeValue(i)) iret = 1;
+   for (int i = 0; i < npoints; ++i)
+      if (tree.GetIndPoints()[i] != treeMT.GetIndPoints()[i]) iret = 1;
+#endif
+   PrintStatus(iret);
+
+   // batched queries, checked against a brute force search for some of the points
+   PrintTest("TKDTree nearest neighbors");
+   int iret2 = 0;
+   const Int_t nquery = ngen;
+   const Int_t knn = 5;
+   std::vector<double> points(ndim*nquery);
+   for (auto & x : points) x = r.Rndm();
+   std::vector<Int_t> ind(knn*nquery);
+   std::vector<double> dist(knn*nquery);
+   {
+      Timer timer;
+      tree.FindNearestNeighbors(nquery, points.data(), knn, ind.data(), dist.data());
+   }
+   for (int iq = 0; iq < nquery; iq += 100) {
+      std::vector<std::pair<double,Int_t>> d2(npoints);
+      for (int ip = 0; ip < npoints; ++ip) {
+         double d = 0;
+         for (int idim = 0; idim < ndim; ++idim)
+            d += (points[iq*ndim+idim] - data[idim][ip])*(points[iq*ndim+idim] - data[idim][ip]);
+         d2[ip] = std::make_pair(d, ip);
+      }
+      std::partial_sort(d2.begin(), d2.begin() + knn, d2.end());
+      for (int k = 0; k < knn; ++k)
+         if (ind[iq*knn+k] != d2[k].second) iret2 = 1;
+   }
+   PrintStatus(iret2);
+
+   return iret | iret2;
+}
+
 int testGenVectors(int ngen,bool io) {
 
    int iret = 0;
@@ -1554,6 +1625,8 @@ int stressMathCore(double nscale = 1) {
 
    iret |= testStatFunctions(n/10);
 
+   iret |= testKDTree(n);
+
    bool io = true;
 
    iret |= ( gSystem->Load("libSmatrix") < 0 );   // iret = 0 or = 1 is fine
@@ -6,7 +6,7 @@
 //    TSPectrum test suite
 //    ====================
 //
-// This stress program tests many elements of the TSpectrum, TSpectrum2 classes.
+// This stress program tests many elements of the TSpectrum, TSpectrum2, TSpectrum3 classes.
 //
 // To run in batch, do
 //   stressSpectrum        : run 100 experiments with graphics (default)
@@ -37,6 +37,8 @@
 //****************************************************************************
 //Peak1 : found = 70.21/ 73.75, good = 65.03/ 68.60, ghost = 8.54/ 8.39,--- OK
 //Peak2 : found =163/300, good =163, ghost =8,----------------------------  OK
+//Back2 : double  0.51s, float  0.24s, MT  0.09s, diff =3.1e-07,--------- OK
+//Back3 : double  1.35s, float  0.66s, MT  0.22s, diff =2.4e-07,--------- OK
 //****************************************************************************
 //stressSpectrum: Real Time =  19.86 seconds Cpu Time =  19.04 seconds
 //****************************************************************************
@@ -45,6 +47,7 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <vector>
 #include "snprintf.h"
 #include "TApplication.h"
 #include "TBenchmark.h"
@@ -54,6 +57,7 @@
 #include "TRandom.h"
 #include "TSpectrum.h"
 #include "TSpectrum2.h"
+#include "TSpectrum3.h"
 #include "TStyle.h"
 #include "TROOT.h"
 #include "TMath.h"
@@ -249,6 +253,84 @@ void stress2(Int_t np2) {
           nfound,npeaks,ngood,nghost,sok);
 }
 
+// Return the largest difference between the double and the float background
+// relative to the largest channel.
+Double_t compareBackground(const Double_t *d, const Float_t *f, Int_t n) {
+   Double_t dmax = 0, maxch = 0;
+   for (Int_t i=0;i<n;i++) {
+      dmax  = TMath::Max(dmax,TMath::Abs(d[i]-f[i]));
+      maxch = TMath::Max(maxch,TMath::Abs(d[i]));
+   }
+   return maxch > 0 ? dmax/maxch : dmax;
+}
+void stress3() {
+   //benchmark of the background estimation of 2-D and 3-D spectra, in double and
+   //single precision and with the implicit multithreading if available. The
+   //multithreaded result must be identical to the sequential one.
+   TRandom r;
+   const Int_t n2 = 1024, n3 = 96, niter2 = 20, niter3 = 6;
+   std::vector<Double_t> d2(n2*n2), m2(n2*n2);
+   std::vector<Float_t>  f2(n2*n2);
+   std::vector<Double_t*> rows2(n2), mrows2(n2);
+   std::vector<Float_t*>  frows2(n2);
+   for (Int_t i=0;i<n2*n2;i++) d2[i] = m2[i] = f2[i] = r.Poisson(10) + (i%n2 == (i/n2+7)%n2 ? 50 : 0);
+   for (Int_t i=0;i<n2;i++) {
+      rows2[i] = &d2[i*n2]; mrows2[i] = &m2[i*n2]; frows2[i] = &f2[i*n2];
+   }
+   std::vector<Double_t> d3(n3*n3*n3), m3(n3*n3*n3);
+   std::vector<Float_t>  f3(n3*n3*n3);
+   std::vector<Double_t*> rows3(n3*n3), mrows3(n3*n3);
+   std::vector<Float_t*>  frows3(n3*n3);
+   std::vector<Double_t**> cube3(n3), mcube3(n3);
+   std::vector<Float_t**>  fcube3(n3);
+   for (Int_t i=0;i<n3*n3*n3;i++) d3[i] = m3[i] = f3[i] = r.Poisson(10);
+   for (Int_t i=0;i<n3*n3;i++) {
+      rows3[i] = &d3[i*n3]; mrows3[i] = &m3[i*n3]; frows3[i] = &f3[i*n3];
+   }
+   for (Int_t i=0;i<n3;i++) {
+      cube3[i] = &rows3[i*n3]; mcube3[i] = &mrows3[i*n3]; fcube3[i] = &frows3[i*n3];
+   }
+   TSpectrum2 s2;
+   TSpectrum3 s3;
+
+   gBenchmark->Start("back2d");
+   s2.Background(rows2.data(),n2,n2,niter2,niter2,TSpectrum2::kBackDecreasingWindow,TSpectrum2::kBackSuccessiveFiltering);
+   gBenchmark->Stop("back2d");
+   gBenchmark->Start("back2f");
+   s2.Background(frows2.data(),n2,n2,niter2,niter2,TSpectrum2::kBackDecreasingWindow,TSpectrum2::kBackSuccessiveFiltering);
+   gBenchmark->Stop("back2f");
+   gBenchmark->Start("back3d");
+   s3.Background(cube3.data(),n3,n3,n3,niter3,niter3,niter3,TSpectrum3::kBackDecreasingWindow,TSpectrum3::kBackSuccessiveFiltering);
+   gBenchmark->Stop("back3d");
+   gBenchmark->Start("back3f");
+   s3.Background(fcube3.data(),n3,n3,n3,niter3,niter3,niter3,TSpectrum3::kBackDecreasingWindow,TSpectrum3::kBackSuccessiveFiltering);
+   gBenchmark->Stop("back3f");
+
+   Bool_t sameMT = kTRUE;
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT();
+#endif
+   gBenchmark->Start("back2mt");
+   s2.Background(mrows2.data(),n2,n2,niter2,niter2,TSpectrum2::kBackDecreasingWindow,TSpectrum2::kBackSuccessiveFiltering);
+   gBenchmark->Stop("back2mt");
+   gBenchmark->Start("back3mt");
+   s3.Background(mcube3.data(),n3,n3,n3,niter3,niter3,niter3,TSpectrum3::kBackDecreasingWindow,TSpectrum3::kBackSuccessiveFiltering);
+   gBenchmark->Stop("back3mt");
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+   if (d2 != m2 || d3 != m3) sameMT = kFALSE;
+
+   Double_t diff2 = compareBackground(d2.data(),f2.data(),n2*n2);
+   Double_t diff3 = compareBackground(d3.data(),f3.data(),n3*n3*n3);
+   printf("Back2 : double %5.2fs, float %5.2fs, MT %5.2fs, diff =%7.1e,--------- %s\n",
+          gBenchmark->GetRealTime("back2d"),gBenchmark->GetRealTime("back2f"),gBenchmark->GetRealTime("back2mt"),
+          diff2,(sameMT && diff2 < 1e-4) ? "OK" : "failed");
+   printf("Back3 : double %5.2fs, float %5.2fs, MT %5.2fs, diff =%7.1e,--------- %s\n",
+          gBenchmark->GetRealTime("back3d"),gBenchmark->GetRealTime("back3f"),gBenchmark->GetRealTime("back3mt"),
+          diff3,(sameMT && diff3 < 1e-4) ? "OK" : "failed");
+}
+
 void stressSpectrum(Int_t ntimes=100) {
    std::cout << "****************************************************************************" <<std::endl;
    std::cout << "*  Starting  stress S P E C T R U M                                        *" <<std::endl;
@@ -257,6 +339,7 @@ void stressSpectrum(Int_t ntimes=100) {
    stress1(ntimes);
    stress2(300);
    gBenchmark->Stop ("stressSpectrum");
+   stress3();
    Double_t reftime100 = 19.04; //pcbrun compiled
    Double_t ct = gBenchmark->GetCpuTime("stressSpectrum");
    const Double_t rootmarks = 800*reftime100*ntimes/(100*ct);
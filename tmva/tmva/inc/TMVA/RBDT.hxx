@@ -19,10 +19,13 @@
 #ifndef TMVA_RBDT
 #define TMVA_RBDT
 
+#include "TMVA/Config.h"
 #include "TMVA/RTensor.hxx"
 #include "TMVA/TreeInference/Forest.hxx"
 #include "TFile.h"
+#include "ROOT/TSeq.hxx"
 
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <sstream> // std::stringstream
@@ -92,23 +95,47 @@ public:
    std::vector<Value_t> Compute(const std::vector<Value_t> &x) { return this->Compute<std::vector<Value_t>>(x); }
 
    /// Compute model prediction on input RTensor
+   ///
+   /// If multi-threading is enabled in TMVA (see TMVA::Config::EnableMT), the events of
+   /// an input with row major layout are split in chunks, which are processed in parallel.
    RTensor<Value_t> Compute(const RTensor<Value_t> &x)
    {
       const auto rows = x.GetShape()[0];
+      const auto cols = x.GetShape()[1];
       RTensor<Value_t> y({rows, static_cast<std::size_t>(fNumOutputs)}, MemoryLayout::ColumnMajor);
       const bool layout = x.GetMemoryLayout() == MemoryLayout::ColumnMajor ? false : true;
-      for (int i = 0; i < fNumOutputs; i++)
-         fBackends[i].Inference(x.GetData(), rows, layout, &y(0, i));
-      if (fNormalizeOutputs) {
-         Value_t s;
-         for (int i = 0; i < static_cast<int>(rows); i++) {
-            s = 0.0;
-            for (int j = 0; j < fNumOutputs; j++)
-               s += y(i, j);
-            for (int j = 0; j < fNumOutputs; j++)
-               y(i, j) /= s;
+
+      // The stride between the input variables of an event is the number of rows of the tensor,
+      // therefore events in column major layout are processed in a single chunk.
+      const std::size_t minChunkSize = 256;
+      auto &executor = TMVA::Config::Instance().GetThreadExecutor();
+      std::size_t numChunks = 1;
+      if (layout && rows >= 2 * minChunkSize)
+         numChunks = std::min<std::size_t>(executor.GetPoolSize(), rows / minChunkSize);
+
+      // The outputs of the chunk are contiguous in the column major output tensor
+      auto computeChunk = [&](unsigned int chunk) {
+         const std::size_t begin = rows * chunk / numChunks;
+         const std::size_t end = rows * (chunk + 1) / numChunks;
+         const auto inputs = x.GetData() + begin * cols;
+         for (int i = 0; i < fNumOutputs; i++)
+            fBackends[i].Inference(inputs, static_cast<int>(end - begin), layout, &y(begin, i));
+         if (fNormalizeOutputs) {
+            Value_t s;
+            for (std::size_t i = begin; i < end; i++) {
+               s = 0.0;
+               for (int j = 0; j < fNumOutputs; j++)
+                  s += y(i, j);
+               for (int j = 0; j < fNumOutputs; j++)
+                  y(i, j) /= s;
+            }
          }
-      }
+      };
+
+      if (numChunks > 1)
+         executor.Foreach(computeChunk, ROOT::TSeqU(numChunks));
+      else
+         computeChunk(0);
       return y;
    }
 };
@@ -0,0 +1,182 @@
+/**********************************************************************************
+ * Project: ROOT - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Streaming of the events of an RDataFrame in shuffled batches              *
+ *                                                                                *
+ * Copyright (c) 2020:                                                            *
+ *      CERN, Switzerland                                                         *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+#ifndef TMVA_RBATCHGENERATOR
+#define TMVA_RBATCHGENERATOR
+
+#include "TMVA/RTensor.hxx"
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RVec.hxx"
+
+#include <algorithm> // std::copy, std::shuffle, std::min
+#include <cstdint>   // std::uint32_t
+#include <mutex>     // std::mutex, std::lock_guard
+#include <numeric>   // std::iota
+#include <random>    // std::mt19937
+#include <sstream>   // std::stringstream
+#include <stdexcept> // std::runtime_error
+#include <string>
+#include <vector>
+
+namespace TMVA {
+namespace Experimental {
+
+/// \brief Stream the events of an RDataFrame in shuffled batches
+///
+/// Instead of copying the full dataset into memory before the training, the events are read in a
+/// single pass over the dataframe and collected in a shuffling buffer of `bufferSize` events per
+/// processing slot. Whenever a buffer is full, its events are shuffled and handed out as batches
+/// of shape {batchSize, columns} to a callback, so that the memory needed is bounded by the number
+/// of slots times the size of the buffer, independently of the size of the dataset.
+///
+/// With implicit multithreading enabled, the reading of the data and the Defines of the dataframe
+/// run in parallel on all slots, while the calls of the callback are serialized, e.g. to run the
+/// training steps of a neural network. The columns can be of any arithmetic type and are converted
+/// to float. Each call of ForEachBatch() is one epoch with a different shuffling.
+///
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df("tree", "file.root");
+/// TMVA::Experimental::RBatchGenerator generator(df, {"x", "y", "label"}, 128, 100000);
+/// for (auto epoch = 0; epoch < 10; epoch++) {
+///    generator.ForEachBatch([&](const TMVA::Experimental::RTensor<float> &batch) { Train(batch); });
+/// }
+/// ~~~
+class RBatchGenerator {
+private:
+   ROOT::RDF::RNode fDataFrame;    ///< Dataframe with the column of the values of an event
+   std::vector<std::string> fColumns;
+   std::size_t fBatchSize;         ///< Number of events in a batch
+   std::size_t fBufferSize;        ///< Number of events in the shuffling buffer of a slot
+   std::uint32_t fSeed;            ///< Seed of the shuffling
+   unsigned int fEpoch = 0;        ///< Number of passes over the data done so far
+   bool fDropRemainder = false;    ///< Whether to drop the incomplete batches at the end of a pass
+
+   /// Name of the column which collects the values of an event
+   static const char *GetValuesColumnName() { return "TMVA_RBatchGenerator_values"; }
+
+   /// Shuffling buffer of a slot, with the values of the events in row major layout
+   struct Buffer {
+      std::vector<float> fValues;
+      std::size_t fNumEvents = 0;
+      std::mt19937 fGenerator;
+   };
+
+   static ROOT::RDF::RNode DefineValues(ROOT::RDF::RNode df, const std::vector<std::string> &columns)
+   {
+      if (columns.empty())
+         throw std::runtime_error("RBatchGenerator needs at least one column.");
+      std::stringstream ss;
+      ss << "ROOT::VecOps::RVec<float>({";
+      for (std::size_t i = 0; i < columns.size(); i++) {
+         ss << (i == 0 ? "" : ", ") << "static_cast<float>(" << columns[i] << ")";
+      }
+      ss << "})";
+      return df.Define(GetValuesColumnName(), ss.str());
+   }
+
+public:
+   /// \brief Create a generator of batches
+   /// \param[in] df RDataFrame node
+   /// \param[in] columns Names of the columns of a batch, including e.g. targets and weights
+   /// \param[in] batchSize Number of events in a batch
+   /// \param[in] bufferSize Number of events in the shuffling buffer of each slot, at least batchSize
+   /// \param[in] seed Seed of the shuffling
+   RBatchGenerator(ROOT::RDF::RNode df, const std::vector<std::string> &columns, std::size_t batchSize,
+                   std::size_t bufferSize, std::uint32_t seed = 0)
+      : fDataFrame(DefineValues(df, columns)), fColumns(columns), fBatchSize(batchSize),
+        fBufferSize(std::max(bufferSize, batchSize)), fSeed(seed)
+   {
+      if (batchSize == 0)
+         throw std::runtime_error("Batch size of RBatchGenerator has to be larger than zero.");
+   }
+
+   /// Drop the incomplete batches at the end of a pass over the data instead of handing them out
+   void SetDropRemainder(bool dropRemainder) { fDropRemainder = dropRemainder; }
+
+   const std::vector<std::string> &GetColumnNames() const { return fColumns; }
+   std::size_t GetBatchSize() const { return fBatchSize; }
+   std::size_t GetBufferSize() const { return fBufferSize; }
+
+   /// \brief Run one pass over the data and call f(const RTensor<float> &batch) for each batch
+   /// \return Number of batches
+   ///
+   /// The batches have the shape {batchSize, columns} in row major layout. Only the last batch of
+   /// each slot can have less events, unless SetDropRemainder(true) was called. The tensor given to
+   /// the callback is only valid during the call.
+   template <typename F>
+   std::size_t ForEachBatch(F &&f)
+   {
+      const auto numColumns = fColumns.size();
+      const auto numSlots = fDataFrame.GetNSlots();
+      std::vector<Buffer> buffers(numSlots);
+      for (unsigned int slot = 0; slot < numSlots; slot++) {
+         buffers[slot].fValues.resize(fBufferSize * numColumns);
+         buffers[slot].fGenerator.seed(fSeed + fEpoch * numSlots + slot);
+      }
+      fEpoch++;
+
+      std::mutex callbackMutex;
+      std::size_t numBatches = 0;
+
+      // Shuffle the buffer and hand out its events in batches, keeping an incomplete batch in the
+      // buffer unless the pass over the data is done
+      auto flush = [&](Buffer &b, bool done) {
+         std::vector<std::size_t> order(b.fNumEvents);
+         std::iota(order.begin(), order.end(), 0);
+         std::shuffle(order.begin(), order.end(), b.fGenerator);
+         std::vector<float> kept;
+         for (std::size_t first = 0; first < b.fNumEvents; first += fBatchSize) {
+            const auto size = std::min(fBatchSize, b.fNumEvents - first);
+            RTensor<float> batch({size, numColumns});
+            auto data = batch.GetData();
+            for (std::size_t i = 0; i < size; i++) {
+               const auto begin = b.fValues.begin() + order[first + i] * numColumns;
+               std::copy(begin, begin + numColumns, data + i * numColumns);
+            }
+            if (size < fBatchSize && !done) {
+               kept.assign(data, data + size * numColumns);
+               break;
+            }
+            if (size < fBatchSize && fDropRemainder)
+               break;
+            std::lock_guard<std::mutex> lock(callbackMutex);
+            f(static_cast<const RTensor<float> &>(batch));
+            numBatches++;
+         }
+         std::copy(kept.begin(), kept.end(), b.fValues.begin());
+         b.fNumEvents = kept.size() / numColumns;
+      };
+
+      fDataFrame.ForeachSlot(
+         [&](unsigned int slot, const ROOT::VecOps::RVec<float> &values) {
+            auto &b = buffers[slot];
+            std::copy(values.begin(), values.end(), b.fValues.begin() + b.fNumEvents * numColumns);
+            if (++b.fNumEvents == fBufferSize)
+               flush(b, false);
+         },
+         {GetValuesColumnName()});
+
+      for (auto &b : buffers)
+         flush(b, true);
+
+      return numBatches;
+   }
+};
+
+} // namespace Experimental
+} // namespace TMVA
+
+#endif // TMVA_RBATCHGENERATOR
@@ -0,0 +1,116 @@
+/**********************************************************************************
+ * Project: ROOT - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Graph of a neural network and generation of C++ inference code           *
+ *                                                                                *
+ * Copyright (c) 2020:                                                            *
+ *      CERN, Switzerland                                                         *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+#ifndef TMVA_RMODEL
+#define TMVA_RMODEL
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int64_t
+#include <map>
+#include <string>
+#include <vector>
+
+namespace TMVA {
+namespace Experimental {
+
+/// Tensor of a model, with the values of the initialized tensors (weights)
+struct RModelTensor {
+   std::vector<std::size_t> fShape;    ///< Shape of the tensor
+   std::vector<float> fData;           ///< Values of a tensor of floating point type
+   std::vector<std::int64_t> fIntData; ///< Values of a tensor of integer type, e.g. the shape of a Reshape
+};
+
+/// Attribute of an operator
+struct RModelAttribute {
+   std::int64_t fInt = 0;
+   float fFloat = 0.;
+   std::string fString;
+   std::vector<std::int64_t> fInts;
+   std::vector<float> fFloats;
+   std::vector<std::string> fStrings;
+};
+
+/// Operator of a model, with the names of its input and output tensors as in ONNX
+///
+/// Optional inputs and outputs which are not used have an empty name.
+struct RModelOperator {
+   std::string fType;                                  ///< Type of the operator, e.g. "Gemm"
+   std::vector<std::string> fInputs;                   ///< Names of the input tensors
+   std::vector<std::string> fOutputs;                  ///< Names of the output tensors
+   std::map<std::string, RModelAttribute> fAttributes; ///< Attributes by name
+
+   bool HasAttribute(const std::string &name) const { return fAttributes.count(name) > 0; }
+   std::int64_t GetInt(const std::string &name, std::int64_t defaultValue) const;
+   float GetFloat(const std::string &name, float defaultValue) const;
+   std::string GetString(const std::string &name, const std::string &defaultValue) const;
+   std::vector<std::int64_t> GetInts(const std::string &name, const std::vector<std::int64_t> &defaultValue) const;
+};
+
+/// Neural network in inference mode, which generates C++ code for its evaluation
+///
+/// The model is a sequence of operators in topological order, with the semantics of the ONNX
+/// operators of the same name. It is usually read from an ONNX file by RModelParser_ONNX, but
+/// it can also be built by hand. The supported operators are Gemm, MatMul, Add, Relu, Sigmoid,
+/// Tanh, Softmax, BatchNormalization, Conv (1D and 2D), Flatten, Reshape, Identity, and the
+/// forward LSTM and GRU with the default activation functions.
+///
+/// Generate() returns the code of a header-only inference function for a fixed batch size:
+/// ~~~{.cpp}
+/// auto model = TMVA::Experimental::RModelParser_ONNX::Parse("model.onnx", 64);
+/// model.OutputGenerated("MyModel", "MyModel.hxx");
+/// ~~~
+/// The header declares a struct `MyModel::Session`, which holds the weights and all intermediate
+/// tensors. Its method `infer(const float *input, ..., float *output, ...)` takes one pointer per
+/// input and per output of the model, with the tensors in row major layout, and does not allocate
+/// memory. The matrix multiplications call `sgemm_` of BLAS, so the application has to be linked
+/// against a BLAS library. Generate() throws a std::runtime_error if the model contains an operator,
+/// or options of an operator, which are not supported.
+class RModel {
+private:
+   std::vector<std::string> fInputNames;  ///< Names of the input tensors of the model
+   std::vector<std::string> fOutputNames; ///< Names of the output tensors of the model
+   std::map<std::string, std::vector<std::size_t>> fInputShapes; ///< Shapes of the inputs
+   std::map<std::string, RModelTensor> fInitializedTensors; ///< Weights of the model
+   std::vector<RModelOperator> fOperators; ///< Operators in topological order
+   int fOpsetVersion = 13;                 ///< Version of the ONNX operator set
+
+public:
+   void AddInput(const std::string &name, const std::vector<std::size_t> &shape);
+   void AddOutput(const std::string &name);
+   void AddInitializedTensor(const std::string &name, const std::vector<std::size_t> &shape,
+                             const std::vector<float> &data);
+   void AddInitializedTensor(const std::string &name, const std::vector<std::size_t> &shape,
+                             const std::vector<std::int64_t> &data);
+   void AddOperator(const RModelOperator &op) { fOperators.push_back(op); }
+   /// Set the version of the ONNX operator set, which defines e.g. the default axis of Softmax
+   void SetOpsetVersion(int version) { fOpsetVersion = version; }
+
+   const std::vector<std::string> &GetInputNames() const { return fInputNames; }
+   const std::vector<std::string> &GetOutputNames() const { return fOutputNames; }
+   const std::vector<RModelOperator> &GetOperators() const { return fOperators; }
+   int GetOpsetVersion() const { return fOpsetVersion; }
+   bool IsInitializedTensor(const std::string &name) const { return fInitializedTensors.count(name) > 0; }
+   const RModelTensor &GetInitializedTensor(const std::string &name) const;
+   const std::vector<std::size_t> &GetInputShape(const std::string &name) const;
+
+   std::string Generate(const std::string &nameSpace) const;
+   void OutputGenerated(const std::string &nameSpace, const std::string &filename) const;
+};
+
+} // namespace Experimental
+} // namespace TMVA
+
+#endif // TMVA_RMODEL
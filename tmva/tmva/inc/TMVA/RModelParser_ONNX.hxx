@@ -0,0 +1,46 @@
+/**********************************************************************************
+ * Project: ROOT - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Reader of ONNX files into a TMVA::Experimental::RModel                    *
+ *                                                                                *
+ * Copyright (c) 2020:                                                            *
+ *      CERN, Switzerland                                                         *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+#ifndef TMVA_RMODELPARSER_ONNX
+#define TMVA_RMODELPARSER_ONNX
+
+#include "TMVA/RModel.hxx"
+
+#include <cstddef> // std::size_t
+#include <string>
+
+namespace TMVA {
+namespace Experimental {
+
+/// Reader of models in the ONNX format
+///
+/// The protobuf messages of the file are decoded directly, without dependency on the protobuf
+/// library. The weights have to be stored in the file itself (no external data) as floating
+/// point or integer tensors. Dimensions of the inputs which are not fixed in the file, usually
+/// the batch size, are set to `batchSize`.
+///
+/// A std::runtime_error is thrown if the file cannot be read or decoded. The operators are checked
+/// when the code of the model is generated, see RModel::Generate().
+class RModelParser_ONNX {
+public:
+   static RModel Parse(const std::string &filename, std::size_t batchSize = 1);
+   static RModel ParseBuffer(const std::string &buffer, std::size_t batchSize = 1);
+};
+
+} // namespace Experimental
+} // namespace TMVA
+
+#endif // TMVA_RMODELPARSER_ONNX
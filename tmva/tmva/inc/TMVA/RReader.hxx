@@ -5,10 +5,14 @@
 #include "TXMLEngine.h"
 #include "ROOT/RMakeUnique.hxx"
 
+#include "ROOT/TSeq.hxx"
+#include "TMVA/Config.h"
 #include "TMVA/RTensor.hxx"
 #include "TMVA/Reader.h"
 
+#include <algorithm> // std::copy, std::min, std::max
 #include <memory> // std::unique_ptr
+#include <mutex> // std::mutex, std::lock_guard
 #include <sstream> // std::stringstream
 
 namespace TMVA {
@@ -111,73 +115,143 @@ inline XMLConfig ParseXMLConfig(const std::string &filename)
 } // namespace Internal
 
 /// TMVA::Reader legacy interface
+///
+/// The model can be evaluated concurrently by several threads, e.g. in a Define of a multithreaded
+/// RDataFrame. Since the methods of TMVA keep the state of the current event, each thread evaluates
+/// its own instance of TMVA::Reader, which is booked from the weight file on first use and kept for
+/// later calls. EvaluateBatch() splits the events of a tensor in chunks which are processed in
+/// parallel if the implicit multithreading of TMVA is enabled.
 class RReader {
 private:
-   std::unique_ptr<Reader> fReader;
-   std::vector<float> fValues;
+   /// TMVA::Reader with the memory of its input variables, used by one thread at a time
+   struct Worker {
+      std::unique_ptr<Reader> fReader;
+      std::vector<float> fValues;
+   };
+
+   std::string fPath;
    std::vector<std::string> fVariables;
    std::vector<std::string> fExpressions;
    unsigned int fNumClasses;
    const char *name = "RReader";
    Internal::AnalysisType fAnalysisType;
+   mutable std::mutex fWorkersMutex;                         ///< Protects fIdleWorkers
+   mutable std::vector<std::unique_ptr<Worker>> fIdleWorkers; ///< Readers which are not in use by a thread
 
-public:
-   /// Create TMVA model from XML file
-   RReader(const std::string &path)
-   {
-      // Load config
-      auto c = Internal::ParseXMLConfig(path);
-      fVariables = c.variables;
-      fExpressions = c.expressions;
-      fAnalysisType = c.analysisType;
-      fNumClasses = c.numClasses;
+   /// Minimum number of events evaluated by a task of EvaluateBatch()
+   static constexpr std::size_t kMinChunkSize = 256;
 
-      // Setup reader
-      fReader = std::make_unique<Reader>("Silent");
+   /// Book a new reader of the model
+   std::unique_ptr<Worker> MakeWorker() const
+   {
+      auto w = std::make_unique<Worker>();
+      // Booking reads the weight file and registers objects globally
+      R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
+      w->fReader = std::make_unique<Reader>("Silent");
       const auto numVars = fVariables.size();
-      fValues = std::vector<float>(numVars);
+      w->fValues = std::vector<float>(numVars);
       for (std::size_t i = 0; i < numVars; i++) {
-         fReader->AddVariable(TString(fExpressions[i]), &fValues[i]);
+         w->fReader->AddVariable(TString(fExpressions[i]), &w->fValues[i]);
       }
-      fReader->BookMVA(name, path.c_str());
+      w->fReader->BookMVA(name, fPath.c_str());
+      return w;
    }
 
-   /// Compute model prediction on vector
-   std::vector<float> Compute(const std::vector<float> &x)
+   /// Take an idle reader or book a new one if all are in use
+   std::unique_ptr<Worker> AcquireWorker() const
    {
-      if (x.size() != fVariables.size())
-         throw std::runtime_error("Size of input vector is not equal to number of variables.");
-
-      // Copy over inputs to memory used by TMVA reader
-      for (std::size_t i = 0; i < x.size(); i++) {
-         fValues[i] = x[i];
+      {
+         std::lock_guard<std::mutex> lock(fWorkersMutex);
+         if (!fIdleWorkers.empty()) {
+            auto w = std::move(fIdleWorkers.back());
+            fIdleWorkers.pop_back();
+            return w;
+         }
       }
+      return MakeWorker();
+   }
 
-      // Take lock to protect model evaluation
-      R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
+   /// Give back a reader for later use by any thread
+   void ReleaseWorker(std::unique_ptr<Worker> w) const
+   {
+      std::lock_guard<std::mutex> lock(fWorkersMutex);
+      fIdleWorkers.push_back(std::move(w));
+   }
 
-      // Evaluate TMVA model
+   /// Number of outputs of the model for a single event
+   std::size_t GetNumOutputs() const
+   {
+      return fAnalysisType == Internal::AnalysisType::Multiclass ? fNumClasses : 1;
+   }
+
+   /// Evaluate the model on the values set in the worker and write the outputs to y
+   void Evaluate(Worker &w, float *y) const
+   {
       // Classification
       if (fAnalysisType == Internal::AnalysisType::Classification) {
-         return std::vector<float>({static_cast<float>(fReader->EvaluateMVA(name))});
+         y[0] = w.fReader->EvaluateMVA(name);
       }
       // Regression
       else if (fAnalysisType == Internal::AnalysisType::Regression) {
-         return fReader->EvaluateRegression(name);
+         y[0] = w.fReader->EvaluateRegression(name)[0];
       }
       // Multiclass
       else if (fAnalysisType == Internal::AnalysisType::Multiclass) {
-         return fReader->EvaluateMulticlass(name);
+         const auto &p = w.fReader->EvaluateMulticlass(name);
+         std::copy(p.begin(), p.begin() + fNumClasses, y);
       }
       // Throw error
       else {
          throw std::runtime_error("RReader has undefined analysis type.");
-         return std::vector<float>();
       }
    }
 
+public:
+   /// Create TMVA model from XML file
+   RReader(const std::string &path) : fPath(path)
+   {
+      // Load config
+      auto c = Internal::ParseXMLConfig(path);
+      fVariables = c.variables;
+      fExpressions = c.expressions;
+      fAnalysisType = c.analysisType;
+      fNumClasses = c.numClasses;
+
+      // Setup a first reader, which also checks the weight file
+      fIdleWorkers.push_back(MakeWorker());
+   }
+
+   /// Compute model prediction on vector
+   std::vector<float> Compute(const std::vector<float> &x) const
+   {
+      if (x.size() != fVariables.size())
+         throw std::runtime_error("Size of input vector is not equal to number of variables.");
+
+      auto w = AcquireWorker();
+
+      // Copy over inputs to memory used by TMVA reader
+      std::copy(x.begin(), x.end(), w->fValues.begin());
+
+      // Evaluate TMVA model, regression returns all targets
+      std::vector<float> y;
+      if (fAnalysisType == Internal::AnalysisType::Regression) {
+         y = w->fReader->EvaluateRegression(name);
+      } else {
+         y.resize(GetNumOutputs());
+         Evaluate(*w, y.data());
+      }
+
+      ReleaseWorker(std::move(w));
+      return y;
+   }
+
    /// Compute model prediction on input RTensor
-   RTensor<float> Compute(RTensor<float> &x)
+   ///
+   /// The events are the rows of the rank 2 tensor x. The output has one entry per event for
+   /// classification and regression, and the shape {events, classes} for multiclass models.
+   /// The method is thread-safe. If the implicit multithreading of TMVA is enabled, the events
+   /// are split in chunks which are evaluated in parallel.
+   RTensor<float> EvaluateBatch(const RTensor<float> &x) const
    {
       // Error-handling for input tensor
       const auto shape = x.GetShape();
@@ -190,39 +264,41 @@ public:
          throw std::runtime_error("Second dimension of input tensor is not equal to number of variables.");
 
       // Define shape of output tensor based on analysis type
-      unsigned int numClasses = 1;
+      const auto numOutputs = GetNumOutputs();
+      RTensor<float> y({numEntries * numOutputs});
       if (fAnalysisType == Internal::AnalysisType::Multiclass)
-         numClasses = fNumClasses;
-      RTensor<float> y({numEntries * numClasses});
-      if (fAnalysisType == Internal::AnalysisType::Multiclass)
-         y = y.Reshape({numEntries, numClasses});
+         y = y.Reshape({numEntries, numOutputs});
 
-      // Fill output tensor
-      for (std::size_t i = 0; i < numEntries; i++) {
-         for (std::size_t j = 0; j < numVars; j++) {
-            fValues[j] = x(i, j);
-         }
-         R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
-         // Classification
-         if (fAnalysisType == Internal::AnalysisType::Classification) {
-            y(i) = fReader->EvaluateMVA(name);
-         }
-         // Regression
-         else if (fAnalysisType == Internal::AnalysisType::Regression) {
-            y(i) = fReader->EvaluateRegression(name)[0];
-         }
-         // Multiclass
-         else if (fAnalysisType == Internal::AnalysisType::Multiclass) {
-            const auto p = fReader->EvaluateMulticlass(name);
-            for (std::size_t k = 0; k < numClasses; k++)
-               y(i, k) = p[k];
+      // Fill output tensor, one reader per chunk of events
+      auto &executor = Config::Instance().GetThreadExecutor();
+      const auto numChunks = std::max<std::size_t>(
+         1, std::min<std::size_t>(executor.GetPoolSize(), numEntries / kMinChunkSize));
+      const auto chunkSize = (numEntries + numChunks - 1) / numChunks;
+      float *yData = y.GetData();
+      auto computeChunk = [&](unsigned int chunk) {
+         const auto first = chunk * chunkSize;
+         const auto last = std::min(numEntries, first + chunkSize);
+         auto w = AcquireWorker();
+         for (std::size_t i = first; i < last; i++) {
+            for (std::size_t j = 0; j < numVars; j++) {
+               w->fValues[j] = x(i, j);
+            }
+            Evaluate(*w, yData + i * numOutputs);
          }
-      }
+         ReleaseWorker(std::move(w));
+      };
+      if (numChunks > 1)
+         executor.Foreach(computeChunk, ROOT::TSeqU(numChunks));
+      else
+         computeChunk(0);
 
       return y;
    }
 
-   std::vector<std::string> GetVariableNames() { return fVariables; }
+   /// Compute model prediction on input RTensor, see EvaluateBatch()
+   RTensor<float> Compute(RTensor<float> &x) const { return EvaluateBatch(x); }
+
+   std::vector<std::string> GetVariableNames() const { return fVariables; }
 };
 
 } // namespace Experimental
@@ -247,6 +247,7 @@ public:
    const std::shared_ptr<Container_t> GetContainer() const { return fContainer; }
    MemoryLayout GetMemoryLayout() const { return fLayout; }
    bool IsView() const { return fContainer == NULL; }
+   bool IsContiguous() const;
    bool IsOwner() const { return !IsView(); }
 
    // Copy
@@ -324,6 +325,9 @@ inline void RTensor<Value_t, Container_t>::ReshapeInplace(const Shape_t &shape)
       }
       throw std::runtime_error(ss.str());
    }
+   if (!IsContiguous()) {
+      throw std::runtime_error("Cannot reshape tensor which is not contiguous in memory, use Copy() first.");
+   }
 
    // Compute new strides from shape
    auto strides = Internal::ComputeStridesFromShape(shape, fLayout);
@@ -376,6 +380,22 @@ const Value_t &RTensor<Value_t, Container_t>::operator() (Idx... idx) const
    return operator()({static_cast<std::size_t>(idx)...});
 }
 
+/// \brief Check whether the elements are contiguous in memory
+/// \returns True if the strides are the ones of a dense tensor with the same shape and layout
+/// Tensors created from a shape or by reshaping are contiguous, slices and tensors adopting
+/// strided memory in general are not. Only the memory of a contiguous tensor can be passed on
+/// as flat array of GetSize() elements.
+template <typename Value_t, typename Container_t>
+inline bool RTensor<Value_t, Container_t>::IsContiguous() const
+{
+   const auto strides = Internal::ComputeStridesFromShape(fShape, fLayout);
+   for (std::size_t i = 0; i < fShape.size(); i++) {
+      if (fShape[i] != 1 && strides[i] != fStrides[i])
+         return false;
+   }
+   return true;
+}
+
 /// \brief Transpose
 /// \returns New RTensor
 /// The tensor is transposed by inverting the associated memory layout from row-
@@ -384,18 +404,18 @@ const Value_t &RTensor<Value_t, Container_t>::operator() (Idx... idx) const
 template <typename Value_t, typename Container_t>
 inline RTensor<Value_t, Container_t> RTensor<Value_t, Container_t>::Transpose()
 {
+   // Create copy of container
+   RTensor<Value_t, Container_t> x(*this);
+
    // Transpose by inverting memory layout
    if (fLayout == MemoryLayout::RowMajor) {
-      fLayout = MemoryLayout::ColumnMajor;
+      x.fLayout = MemoryLayout::ColumnMajor;
    } else if (fLayout == MemoryLayout::ColumnMajor) {
-      fLayout = MemoryLayout::RowMajor;
+      x.fLayout = MemoryLayout::RowMajor;
    } else {
       throw std::runtime_error("Memory layout is not known.");
    }
 
-   // Create copy of container
-   RTensor<Value_t, Container_t> x(*this);
-
    // Reverse shape
    std::reverse(x.fShape.begin(), x.fShape.end());
 
@@ -484,7 +504,10 @@ inline RTensor<Value_t, Container_t> RTensor<Value_t, Container_t>::Reshape(cons
 /// \brief Create a slice of the tensor
 /// \param[in] slice Slice vector
 /// \returns New RTensor
-/// A slice is a subset of the tensor defined by a vector of pairs of indices.
+/// A slice is a subset of the tensor defined by a vector of pairs of indices {start, stop}
+/// or of triples {start, stop, step} for every dimension. The slice is a view on the same
+/// memory with adjusted shape and strides, no element is copied. Dimensions of size one
+/// are removed from the slice.
 template <typename Value_t, typename Container_t>
 inline RTensor<Value_t, Container_t> RTensor<Value_t, Container_t>::Slice(const Slice_t &slice)
 {
@@ -497,35 +520,37 @@ inline RTensor<Value_t, Container_t> RTensor<Value_t, Container_t>::Slice(const
       throw std::runtime_error(ss.str());
    }
 
-   // Sanitize slice indices
-   // TODO: Sanitize slice indices
-   /*
-   for (std::size_t i = 0; i < sliceSize; i++) {
-   }
-   */
-
-   // Convert -1 in slice to proper pair of indices
-   // TODO
-
-   // Recompute shape and size
+   // Sanitize slice indices and recompute shape, strides and size
    Shape_t shape(sliceSize);
+   Shape_t strides(sliceSize);
+   Shape_t idx(sliceSize);
    for (std::size_t i = 0; i < sliceSize; i++) {
-      shape[i] = slice[i][1] - slice[i][0];
+      const auto &s = slice[i];
+      if (s.size() != 2 && s.size() != 3) {
+         std::stringstream ss;
+         ss << "Slice of dimension " << i << " has " << s.size() << " indices instead of {start, stop} or {start, stop, step}.";
+         throw std::runtime_error(ss.str());
+      }
+      const std::size_t step = s.size() == 3 ? s[2] : 1;
+      if (s[0] > s[1] || s[1] > fShape[i] || step == 0) {
+         std::stringstream ss;
+         ss << "Slice of dimension " << i << " is invalid for size " << fShape[i] << ".";
+         throw std::runtime_error(ss.str());
+      }
+      idx[i] = s[0];
+      shape[i] = (s[1] - s[0] + step - 1) / step;
+      strides[i] = fStrides[i] * step;
    }
    auto size = Internal::GetSizeFromShape(shape);
 
    // Determine first element contributing to the slice and get the data pointer
-   Value_t *data;
-   Shape_t idx(sliceSize);
-   for (std::size_t i = 0; i < sliceSize; i++) {
-      idx[i] = slice[i][0];
-   }
-   data = &operator()(idx);
+   Value_t *data = &operator()(idx);
 
    // Create copy and modify properties
    RTensor<Value_t, Container_t> x(*this);
    x.fData = data;
    x.fShape = shape;
+   x.fStrides = strides;
    x.fSize = size;
 
    // Squeeze tensor and return
@@ -1,6 +1,8 @@
 #ifndef TMVA_RTENSOR_UTILS
 #define TMVA_RTENSOR_UTILS
 
+#include <algorithm> // std::copy
+#include <memory> // std::make_shared
 #include <vector>
 #include <string>
 
@@ -32,25 +34,30 @@ AsTensor(U &dataframe, std::vector<std::string> columns = {}, MemoryLayout layou
       resultPtrs.emplace_back(dataframe.template Take<T>(col));
    }
 
-   // Copy data to tensor based on requested memory layout
+   // A single column is adopted by the tensor without copying it
    const auto numCols = resultPtrs.size();
    const auto numEntries = resultPtrs[0]->size();
+   if (numCols == 1) {
+      auto container = std::make_shared<std::vector<T>>(std::move(*resultPtrs[0]));
+      return RTensor<T>(container, {numEntries, numCols}, layout);
+   }
+
+   // Copy data to tensor based on requested memory layout, column by column so that the
+   // memory of a column is released as soon as it is copied
    RTensor<T> x({numEntries, numCols}, layout);
    const auto data = x.GetData();
-   if (layout == MemoryLayout::RowMajor) {
-      for (std::size_t i = 0; i < numEntries; i++) {
-         const auto entry = data + numCols * i;
-         for (std::size_t j = 0; j < numCols; j++) {
-            entry[j] = resultPtrs[j]->at(i);
+   for (std::size_t j = 0; j < numCols; j++) {
+      auto &column = *resultPtrs[j];
+      if (layout == MemoryLayout::RowMajor) {
+         for (std::size_t i = 0; i < numEntries; i++) {
+            data[numCols * i + j] = column[i];
          }
+      } else if (layout == MemoryLayout::ColumnMajor) {
+         std::copy(column.begin(), column.end(), data + numEntries * j);
+      } else {
+         throw std::runtime_error("Memory layout is not known.");
       }
-   } else if (layout == MemoryLayout::ColumnMajor) {
-      for (std::size_t i = 0; i < numCols; i++) {
-         // TODO: Replace by RVec<T>::insert as soon as available.
-         std::memcpy(data + numEntries * i, &resultPtrs[i]->at(0), numEntries * sizeof(T));
-      }
-   } else {
-      throw std::runtime_error("Memory layout is not known.");
+      std::vector<T>().swap(column);
    }
 
    // Remove dimensions of 1
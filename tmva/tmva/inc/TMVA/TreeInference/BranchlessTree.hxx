@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <string>
 #include <sstream>
+#include <limits>
 
 namespace TMVA {
 namespace Experimental {
@@ -110,6 +111,8 @@ template <typename T>
 inline std::string BranchlessTree<T>::GetInferenceCode(const std::string& funcName, const std::string& typeName)
 {
    std::stringstream ss;
+   // Write the thresholds with all digits, so that the compiled code makes the same cuts
+   ss.precision(std::numeric_limits<T>::max_digits10);
 
    // Build signature
    ss << "inline " << typeName << " " << funcName << "(const " << typeName << "* input, const int stride)";
@@ -26,6 +26,7 @@
 #include <stdexcept>
 #include <cmath>
 #include <algorithm>
+#include <sstream>
 
 #include "TFile.h"
 #include "TDirectory.h"
@@ -57,6 +58,49 @@ bool CompareTree(const BranchlessTree<T> &a, const BranchlessTree<T> &b)
    else
       return a.fInputs[0] < b.fInputs[0];
 }
+
+/// Number of events processed together by the inference of the forests
+constexpr int kInferenceBlockSize = 16;
+
+/// Get code for compiling the inference function of a forest
+///
+/// The trees are declared in the given order as functions `tree0`, `tree1`, ... by the codes
+/// returned from BranchlessTree::GetInferenceCode. The function `Inference` of the namespace
+/// fills the predictions with the sum of the scores of the trees, without objective function.
+///
+/// \param[in] codes Codes of the inference functions of the trees
+/// \param[in] typeName Name of the type used for the computation
+/// \param[in] numInputs Number of input variables
+/// \param[in] nameSpace Name of the namespace enclosing the code
+/// \param[out] Code of the forest as string
+inline std::string GetForestInferenceCode(const std::vector<std::string> &codes, const std::string &typeName,
+                                          const int numInputs, const std::string &nameSpace)
+{
+   std::stringstream ss;
+   ss << "namespace " << nameSpace << " {\n";
+   for (const auto &code : codes) {
+      ss << code << "\n\n";
+   }
+   ss << "void Inference(const "
+      << typeName << "* inputs, const int rows, bool layout, "
+      << typeName << "* predictions)"
+      << "\n{\n"
+      << "   const auto strideTree = layout ? 1 : rows;\n"
+      << "   const auto strideBatch = layout ? " << numInputs << " : 1;\n"
+      << "   for (int begin = 0; begin < rows; begin += " << kInferenceBlockSize << ") {\n"
+      << "      const int end = begin + " << kInferenceBlockSize << " < rows ? begin + " << kInferenceBlockSize
+      << " : rows;\n"
+      << "      for (int i = begin; i < end; i++)\n"
+      << "         predictions[i] = 0.0;\n";
+   for (std::size_t i = 0; i < codes.size(); i++) {
+      ss << "      for (int i = begin; i < end; i++)\n"
+         << "         predictions[i] += tree" << i << "(inputs + i * strideBatch, strideTree);\n";
+   }
+   ss << "   }\n"
+      << "}\n"
+      << "} // end namespace " << nameSpace;
+   return ss.str();
+}
 } // namespace Internal
 
 /// Forest base class
@@ -84,12 +128,19 @@ inline void ForestBase<T, ForestType>::Inference(const T *inputs, const int rows
 {
    const auto strideTree = layout ? 1 : rows;
    const auto strideBatch = layout ? fNumInputs : 1;
-   for (int i = 0; i < rows; i++) {
-      predictions[i] = 0.0;
+   // Loop over the trees for blocks of events, so that the nodes of a tree stay in the cache
+   // while they are used for all events of the block. The trees are added in the same order
+   // for each event as in an event-by-event loop.
+   for (int begin = 0; begin < rows; begin += Internal::kInferenceBlockSize) {
+      const int end = std::min(begin + Internal::kInferenceBlockSize, rows);
+      for (int i = begin; i < end; i++)
+         predictions[i] = 0.0;
       for (auto &tree : fTrees) {
-         predictions[i] += tree.Inference(inputs + i * strideBatch, strideTree);
+         for (int i = begin; i < end; i++)
+            predictions[i] += tree.Inference(inputs + i * strideBatch, strideTree);
       }
-      predictions[i] = fObjectiveFunc(predictions[i]);
+      for (int i = begin; i < end; i++)
+         predictions[i] = fObjectiveFunc(predictions[i]);
    }
 }
 
@@ -99,6 +150,7 @@ inline void ForestBase<T, ForestType>::Inference(const T *inputs, const int rows
 template <typename T>
 struct BranchlessForest : public ForestBase<T, std::vector<BranchlessTree<T>>> {
    void Load(const std::string &key, const std::string &filename, const int output = 0, const bool sortTrees = true);
+   std::string GetInferenceCode(const std::string &nameSpace);
 };
 
 /// Load parameters from a ROOT file to the branchless trees
@@ -180,6 +232,35 @@ BranchlessForest<T>::Load(const std::string &key, const std::string &filename, c
    file->Close();
 }
 
+/// Get standalone C++ code for the inference of the forest
+///
+/// The code can be written to a file and compiled ahead of time with the application, which
+/// avoids the just-in-time compilation of BranchlessJittedForest at runtime. It declares in the
+/// given namespace the function
+/// ~~~{.cpp}
+/// void Inference(const T* inputs, const int rows, bool layout, T* predictions);
+/// ~~~
+/// with the same arguments as BranchlessForest::Inference, which fills the predictions with the
+/// sum of the scores of the trees. The objective function of the forest is not part of the code
+/// and has to be applied by the caller, e.g. with Objectives::GetFunction.
+///
+/// \param[in] nameSpace Name of the namespace enclosing the code
+/// \param[out] Code of the forest as string
+template <typename T>
+inline std::string BranchlessForest<T>::GetInferenceCode(const std::string &nameSpace)
+{
+   std::string typeName = ROOT::Internal::GetDemangledTypeName(typeid(T));
+   if (typeName.compare("") == 0) {
+      throw std::runtime_error("Failed to generate inference code for branchless forest (typename as string)");
+   }
+
+   std::vector<std::string> codes(this->fTrees.size());
+   for (std::size_t i = 0; i < codes.size(); i++) {
+      codes[i] = this->fTrees[i].GetInferenceCode("tree" + std::to_string(i), typeName);
+   }
+   return Internal::GetForestInferenceCode(codes, typeName, this->fNumInputs, nameSpace);
+}
+
 /// Forest using branchless jitted trees
 ///
 /// \tparam T Value type for the computation (usually floating point type)
@@ -297,30 +378,12 @@ BranchlessJittedForest<T>::Load(const std::string &key, const std::string &filen
    nameSpace = "ns_" + nameSpace;
 
    // JIT the forest
-   std::stringstream jitForest;
-   jitForest << "#pragma cling optimize(3)\n"
-             << "namespace " << nameSpace << " {\n";
+   std::vector<std::string> sortedCodes(codes.size());
    for (int i = 0; i < static_cast<int>(codes.size()); i++) {
-      jitForest << codes[treeIndices[i]] << "\n\n";
-   }
-   jitForest << "void Inference(const "
-             << typeName << "* inputs, const int rows, bool layout, "
-             << typeName << "* predictions)"
-             << "\n{\n"
-             << "   const auto strideTree = layout ? 1 : rows;\n"
-             << "   const auto strideBatch = layout ? " << this->fNumInputs << " : 1;\n"
-             << "   for (int i = 0; i < rows; i++) {\n"
-             << "      predictions[i] = 0.0;\n";
-   for (int i = 0; i < static_cast<int>(codes.size()); i++) {
-      std::stringstream ss;
-      ss << "tree" << i;
-      const std::string funcName = ss.str();
-      jitForest << "      predictions[i] += " << funcName << "(inputs + i * strideBatch, strideTree);\n";
+      sortedCodes[i] = codes[treeIndices[i]];
    }
-   jitForest << "   }\n"
-             << "}\n"
-             << "} // end namespace " << nameSpace;
-   const std::string jitForestStr = jitForest.str();
+   const std::string jitForestStr = "#pragma cling optimize(3)\n" +
+      Internal::GetForestInferenceCode(sortedCodes, typeName, this->fNumInputs, nameSpace);
    const auto err = gInterpreter->Declare(jitForestStr.c_str());
    if (err == 0) {
       throw std::runtime_error("Failed to just-in-time compile inference code for branchless forest (declare function)");
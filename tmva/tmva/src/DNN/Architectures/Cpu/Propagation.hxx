@@ -342,30 +342,53 @@ void TCpu<AFloat>::ConvLayerForward(TCpuTensor<AFloat> & output,
    Im2colIndices(forwardIndices, input.At(0).GetMatrix(), nLocalViews, params.inputHeight, params.inputWidth, params.filterHeight,
                  params.filterWidth, params.strideRows, params.strideCols, params.paddingHeight, params.paddingWidth);
 
-   //this should fix multi-thread inizializations of arrays
-   TCpuMatrix<AFloat>::InitializeOneVector(nLocalViews);
-   TCpuMatrix<AFloat>::InitializeOneVector(output.GetWSize());   // since it is used in AddCOnvBiases
+   // The samples are processed in blocks, with a single matrix multiplication per block: the outputs of
+   // consecutive samples are contiguous in the (column major) output tensor, so the output of a block is
+   // a depth x (blockSize * nLocalViews) matrix. This avoids many small multiplications for small images,
+   // while keeping at least one block per thread.
+   constexpr size_t minBlockColumns = 1024;
+   const size_t batchSize = input.GetFirstSize();
+   const size_t nThreads = std::max<size_t>(1, TCpuMatrix<AFloat>::GetThreadExecutor().GetPoolSize());
+   const size_t blockSize = std::max<size_t>(1, std::min((minBlockColumns + nLocalViews - 1) / nLocalViews,
+                                                         (batchSize + nThreads - 1) / nThreads));
+   const size_t nBlocks = (batchSize + blockSize - 1) / blockSize;
+   const size_t outputSampleSize = output.GetStrides().back();
 
+   //this should fix multi-thread inizializations of arrays
+   TCpuMatrix<AFloat>::InitializeOneVector(blockSize * nLocalViews); // since it is used in AddConvBiases
 
-   auto f = [&] (UInt_t i)
+   auto f = [&] (UInt_t iBlock)
    {
        // dropout not yet implemented for CNN
        // if (applyDropout && (dropoutProbability != 1.0)) {
        //    Dropout(input[i], dropoutProbability);
        // }
 
-       TCpuMatrix<AFloat> inputTr(nLocalViews, nLocalViewPixels);
-       //inputTr.Zero();   // this is not thread safe
-
-       Im2colFast(inputTr, input.At(i).GetMatrix(), forwardIndices);
-
-       Matrix_t output_m = output.At(i).GetMatrix();
+       const size_t first = iBlock * blockSize;
+       const size_t nSamples = std::min(blockSize, batchSize - first);
+       const size_t nRows = nSamples * nLocalViews;
+
+       // im2col matrix of the block, the rows of sample k start at k * nLocalViews
+       TCpuMatrix<AFloat> inputTr(nRows, nLocalViewPixels);
+       AFloat *a = inputTr.GetRawDataPointer();
+       for (size_t k = 0; k < nSamples; ++k) {
+          const AFloat *b = input.At(first + k).GetMatrix().GetRawDataPointer();
+          for (size_t j = 0; j < nLocalViewPixels; ++j) {
+             AFloat *aCol = a + j * nRows + k * nLocalViews;
+             const int *idx = forwardIndices.data() + j * nLocalViews;
+             for (size_t v = 0; v < nLocalViews; ++v)
+                aCol[v] = (idx[v] >= 0) ? b[idx[v]] : AFloat(0);
+          }
+       }
+
+       TCpuMatrix<AFloat> output_m(output.GetDeviceBuffer().GetSubBuffer(first * outputSampleSize, nSamples * outputSampleSize),
+                                   weights.GetNrows(), nRows);
        MultiplyTranspose(output_m, weights, inputTr);
        AddConvBiases(output_m, biases);
 
    };
 
-   TCpuMatrix<AFloat>::GetThreadExecutor().Foreach(f, ROOT::TSeqI(input.GetFirstSize()));
+   TCpuMatrix<AFloat>::GetThreadExecutor().Foreach(f, ROOT::TSeqI(nBlocks));
 
    //evaluateDerivative<TCpu<AFloat>>(derivatives, activFunc, output);
    // need to save output of convolution (input to activation function)
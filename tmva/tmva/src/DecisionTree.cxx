@@ -1356,6 +1356,29 @@ struct TrainNodeInfo{
 
        return ret;
    };
+
+   // In-place addition, used to merge the results of the threads without allocating
+   // a new set of histograms for every partial sum
+   TrainNodeInfo& operator+=(const TrainNodeInfo& other)
+   {
+       for (Int_t ivar=0; ivar<cNvars; ivar++) {
+          for (UInt_t ibin=0; ibin<nBins[ivar]; ibin++) {
+             nSelS[ivar][ibin] += other.nSelS[ivar][ibin];
+             nSelB[ivar][ibin] += other.nSelB[ivar][ibin];
+             nSelS_unWeighted[ivar][ibin] += other.nSelS_unWeighted[ivar][ibin];
+             nSelB_unWeighted[ivar][ibin] += other.nSelB_unWeighted[ivar][ibin];
+             target[ivar][ibin] += other.target[ivar][ibin];
+             target2[ivar][ibin] += other.target2[ivar][ibin];
+          }
+       }
+
+       nTotS += other.nTotS;
+       nTotS_unWeighted += other.nTotS_unWeighted;
+       nTotB += other.nTotB;
+       nTotB_unWeighted += other.nTotB_unWeighted;
+
+       return *this;
+   };
  
 };
 //===========================================================================
@@ -1474,6 +1497,9 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
    UInt_t cNvars = fNvars;
    if (fUseFisherCuts && fisherOK) cNvars++;  // use the Fisher output simple as additional variable
 
+   // the Fisher discriminant of each event, computed once for the range and the histograms
+   std::vector<Double_t> fisherValues;
+
    // #### set up the binning info arrays
    // #### each var has its own binning since some may be integers 
    UInt_t*   nBins = new UInt_t [cNvars];
@@ -1515,11 +1541,13 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
          xmax[ivar]=-999;
          // too bad, for the moment I don't know how to do this without looping
          // once to get the "min max" and then AGAIN to fill the histogram
+         fisherValues.resize(nevents);
          for (UInt_t iev=0; iev<nevents; iev++) {
             // returns the Fisher value (no fixed range)
             Double_t result = fisherCoeff[fNvars]; // the fisher constant offset
             for (UInt_t jvar=0; jvar<fNvars; jvar++)
                result += fisherCoeff[jvar]*(eventSample[iev])->GetValueFast(jvar);
+            fisherValues[iev] = result;
             if (result > xmax[ivar]) xmax[ivar]=result;
             if (result < xmin[ivar]) xmin[ivar]=result;
          }
@@ -1589,18 +1617,27 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
       auto seeds = ROOT::TSeqU(nPartitions);
 
       // need a lambda function to pass to TThreadExecutor::MapReduce
-      auto f = [this, &eventSample, &fisherCoeff, &useVariable, &invBinWidth,
+      auto f = [this, &eventSample, &fisherValues, &useVariable, &invBinWidth,
                 &nBins, &xmin, &cNvars, &nPartitions](UInt_t partition = 0){
 
          UInt_t start = 1.0*partition/nPartitions*eventSample.size();
          UInt_t end   = (partition+1.0)/nPartitions*eventSample.size();
 
          TrainNodeInfo nodeInfof(cNvars, nBins);
+         const Bool_t doRegression = DoRegression();
 
          for(UInt_t iev=start; iev<end; iev++) {
 
-            Double_t eventWeight =  eventSample[iev]->GetWeight();
-            if (eventSample[iev]->GetClass() == fSigClass) {
+            // #### class, weight and target are the same for all the variables
+            const TMVA::Event *ev = eventSample[iev];
+            const Double_t eventWeight = ev->GetWeight();
+            const Bool_t isSignal = ev->GetClass() == fSigClass;
+            Double_t weightedTarget = 0, weightedTarget2 = 0;
+            if (doRegression) {
+               weightedTarget = eventWeight*ev->GetTarget(0);
+               weightedTarget2 = weightedTarget*ev->GetTarget(0);
+            }
+            if (isSignal) {
                nodeInfof.nTotS+=eventWeight;
                nodeInfof.nTotS_unWeighted++;    }
             else {
@@ -1609,23 +1646,15 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
             }
 
             // #### Count the number in each bin
-            Int_t iBin=-1;
             for (UInt_t ivar=0; ivar < cNvars; ivar++) {
                // now scan trough the cuts for each varable and find which one gives
                // the best separationGain at the current stage.
                if ( useVariable[ivar] ) {
-                  Double_t eventData;
-                  if (ivar < fNvars) eventData = eventSample[iev]->GetValueFast(ivar);
-                  else { // the fisher variable
-                     eventData = fisherCoeff[fNvars];
-                     for (UInt_t jvar=0; jvar<fNvars; jvar++)
-                        eventData += fisherCoeff[jvar]*(eventSample[iev])->GetValueFast(jvar);
-
-                  }
+                  const Double_t eventData = (ivar < fNvars) ? ev->GetValueFast(ivar) : fisherValues[iev];
                   // #### figure out which bin it belongs in ...
                   // "maximum" is nbins-1 (the "-1" because we start counting from 0 !!
-                  iBin = TMath::Min(Int_t(nBins[ivar]-1),TMath::Max(0,int (invBinWidth[ivar]*(eventData-xmin[ivar]) ) ));
-                  if (eventSample[iev]->GetClass() == fSigClass) {
+                  const Int_t iBin = TMath::Min(Int_t(nBins[ivar]-1),TMath::Max(0,int (invBinWidth[ivar]*(eventData-xmin[ivar]) ) ));
+                  if (isSignal) {
                      nodeInfof.nSelS[ivar][iBin]+=eventWeight;
                      nodeInfof.nSelS_unWeighted[ivar][iBin]++;
                   }
@@ -1633,9 +1662,9 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
                      nodeInfof.nSelB[ivar][iBin]+=eventWeight;
                      nodeInfof.nSelB_unWeighted[ivar][iBin]++;
                   }
-                  if (DoRegression()) {
-                     nodeInfof.target[ivar][iBin] +=eventWeight*eventSample[iev]->GetTarget(0);
-                     nodeInfof.target2[ivar][iBin]+=eventWeight*eventSample[iev]->GetTarget(0)*eventSample[iev]->GetTarget(0);
+                  if (doRegression) {
+                     nodeInfof.target[ivar][iBin] +=weightedTarget;
+                     nodeInfof.target2[ivar][iBin]+=weightedTarget2;
                   }
                }
             }
@@ -1643,11 +1672,12 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
          return nodeInfof;
       };
 
-      // #### Need an intial struct to pass to std::accumulate
-      TrainNodeInfo nodeInfoInit(cNvars, nBins);
-
-      // #### Run the threads in parallel then merge the results
-      auto redfunc = [nodeInfoInit](std::vector<TrainNodeInfo> v) -> TrainNodeInfo { return std::accumulate(v.begin(), v.end(), nodeInfoInit); };
+      // #### Run the threads in parallel then merge the results in place into the first partition
+      auto redfunc = [](const std::vector<TrainNodeInfo> &v) -> TrainNodeInfo {
+         TrainNodeInfo sum = v.front();
+         for (std::size_t i = 1; i < v.size(); i++) sum += v[i];
+         return sum;
+      };
       nodeInfo = TMVA::Config::Instance().GetThreadExecutor().MapReduce(f, seeds, redfunc);
    }
  
@@ -1656,16 +1686,18 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
    // #### Parallelize by vectorizing the variable loop
    else {
 
-      auto fvarFillNodeInfo = [this, &nodeInfo, &eventSample, &fisherCoeff, &useVariable, &invBinWidth, &nBins, &xmin](UInt_t ivar = 0){
+      auto fvarFillNodeInfo = [this, &nodeInfo, &eventSample, &fisherValues, &useVariable, &invBinWidth, &nBins, &xmin](UInt_t ivar = 0){
 
+         const Bool_t doRegression = DoRegression();
          for(UInt_t iev=0; iev<eventSample.size(); iev++) {
 
-            Int_t iBin=-1;
-            Double_t eventWeight =  eventSample[iev]->GetWeight(); 
+            const TMVA::Event *ev = eventSample[iev];
+            const Double_t eventWeight = ev->GetWeight();
+            const Bool_t isSignal = ev->GetClass() == fSigClass;
 
             // Only count the net signal and background once
             if(ivar==0){
-                if (eventSample[iev]->GetClass() == fSigClass) {
+                if (isSignal) {
                    nodeInfo.nTotS+=eventWeight;
                    nodeInfo.nTotS_unWeighted++;    }
                 else {
@@ -1676,18 +1708,11 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
          
             // Figure out which bin the event belongs in and increment the bin in each histogram vector appropriately
             if ( useVariable[ivar] ) {
-               Double_t eventData;
-               if (ivar < fNvars) eventData = eventSample[iev]->GetValueFast(ivar); 
-               else { // the fisher variable
-                  eventData = fisherCoeff[fNvars];
-                  for (UInt_t jvar=0; jvar<fNvars; jvar++)
-                     eventData += fisherCoeff[jvar]*(eventSample[iev])->GetValueFast(jvar);
-                  
-               }
+               const Double_t eventData = (ivar < fNvars) ? ev->GetValueFast(ivar) : fisherValues[iev];
                // #### figure out which bin it belongs in ...
                // "maximum" is nbins-1 (the "-1" because we start counting from 0 !!
-               iBin = TMath::Min(Int_t(nBins[ivar]-1),TMath::Max(0,int (invBinWidth[ivar]*(eventData-xmin[ivar]) ) ));
-               if (eventSample[iev]->GetClass() == fSigClass) {
+               const Int_t iBin = TMath::Min(Int_t(nBins[ivar]-1),TMath::Max(0,int (invBinWidth[ivar]*(eventData-xmin[ivar]) ) ));
+               if (isSignal) {
                   nodeInfo.nSelS[ivar][iBin]+=eventWeight;
                   nodeInfo.nSelS_unWeighted[ivar][iBin]++;
                } 
@@ -1695,9 +1720,10 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
                   nodeInfo.nSelB[ivar][iBin]+=eventWeight;
                   nodeInfo.nSelB_unWeighted[ivar][iBin]++;
                }
-               if (DoRegression()) {
-                  nodeInfo.target[ivar][iBin] +=eventWeight*eventSample[iev]->GetTarget(0);
-                  nodeInfo.target2[ivar][iBin]+=eventWeight*eventSample[iev]->GetTarget(0)*eventSample[iev]->GetTarget(0);
+               if (doRegression) {
+                  const Double_t weightedTarget = eventWeight*ev->GetTarget(0);
+                  nodeInfo.target[ivar][iBin] +=weightedTarget;
+                  nodeInfo.target2[ivar][iBin]+=weightedTarget*ev->GetTarget(0);
                }
             }
          }
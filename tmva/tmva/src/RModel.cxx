@@ -0,0 +1,994 @@
+// @(#)root/tmva $Id$
+
+/*************************************************************************
+ * Copyright (C) 2020, Rene Brun and Fons Rademakers.                    *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TMVA/RModel.hxx"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace TMVA {
+namespace Experimental {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the integer attribute `name`, or `defaultValue` if the operator does not have it.
+
+std::int64_t RModelOperator::GetInt(const std::string &name, std::int64_t defaultValue) const
+{
+   auto item = fAttributes.find(name);
+   return item == fAttributes.end() ? defaultValue : item->second.fInt;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the floating point attribute `name`, or `defaultValue` if the operator does not have it.
+
+float RModelOperator::GetFloat(const std::string &name, float defaultValue) const
+{
+   auto item = fAttributes.find(name);
+   return item == fAttributes.end() ? defaultValue : item->second.fFloat;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the string attribute `name`, or `defaultValue` if the operator does not have it.
+
+std::string RModelOperator::GetString(const std::string &name, const std::string &defaultValue) const
+{
+   auto item = fAttributes.find(name);
+   return item == fAttributes.end() ? defaultValue : item->second.fString;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the list of integers of the attribute `name`, or `defaultValue` if the operator does not have it.
+
+std::vector<std::int64_t>
+RModelOperator::GetInts(const std::string &name, const std::vector<std::int64_t> &defaultValue) const
+{
+   auto item = fAttributes.find(name);
+   return item == fAttributes.end() ? defaultValue : item->second.fInts;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add an input of the model, with a fixed shape.
+
+void RModel::AddInput(const std::string &name, const std::vector<std::size_t> &shape)
+{
+   if (fInputShapes.count(name) == 0)
+      fInputNames.push_back(name);
+   fInputShapes[name] = shape;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add an output of the model, which is the output of one of the operators.
+
+void RModel::AddOutput(const std::string &name)
+{
+   fOutputNames.push_back(name);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a tensor of floating point weights, with the values in row major layout.
+
+void RModel::AddInitializedTensor(const std::string &name, const std::vector<std::size_t> &shape,
+                                  const std::vector<float> &data)
+{
+   auto &tensor = fInitializedTensors[name];
+   tensor.fShape = shape;
+   tensor.fData = data;
+   tensor.fIntData.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a tensor of integers, e.g. the shape of a Reshape operator.
+
+void RModel::AddInitializedTensor(const std::string &name, const std::vector<std::size_t> &shape,
+                                  const std::vector<std::int64_t> &data)
+{
+   auto &tensor = fInitializedTensors[name];
+   tensor.fShape = shape;
+   tensor.fData.clear();
+   tensor.fIntData = data;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the initialized tensor `name`, throw if the model does not have it.
+
+const RModelTensor &RModel::GetInitializedTensor(const std::string &name) const
+{
+   auto item = fInitializedTensors.find(name);
+   if (item == fInitializedTensors.end())
+      throw std::runtime_error("TMVA::RModel: tensor " + name + " is not an initialized tensor of the model");
+   return item->second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the shape of the input `name`, throw if the model does not have it.
+
+const std::vector<std::size_t> &RModel::GetInputShape(const std::string &name) const
+{
+   auto item = fInputShapes.find(name);
+   if (item == fInputShapes.end())
+      throw std::runtime_error("TMVA::RModel: tensor " + name + " is not an input of the model");
+   return item->second;
+}
+
+namespace {
+
+using Shape_t = std::vector<std::size_t>;
+
+std::size_t GetSize(const Shape_t &shape)
+{
+   return std::accumulate(shape.begin(), shape.end(), std::size_t(1), std::multiplies<std::size_t>());
+}
+
+std::string ShapeToString(const Shape_t &shape)
+{
+   std::stringstream ss;
+   ss << "[";
+   for (std::size_t i = 0; i < shape.size(); i++)
+      ss << (i > 0 ? ", " : "") << shape[i];
+   ss << "]";
+   return ss.str();
+}
+
+/// Replace the characters of a tensor name which are not allowed in a C++ identifier
+std::string Sanitize(const std::string &name)
+{
+   std::string result = name;
+   for (auto &c : result) {
+      if (!std::isalnum(static_cast<unsigned char>(c)))
+         c = '_';
+   }
+   return result;
+}
+
+/// Normalize a possibly negative axis of a tensor of the given rank
+std::size_t GetAxis(std::int64_t axis, std::size_t rank, const std::string &opType)
+{
+   const auto r = static_cast<std::int64_t>(rank);
+   if (axis < -r || axis >= r)
+      throw std::runtime_error("TMVA::RModel: axis " + std::to_string(axis) + " of " + opType +
+                               " is out of range");
+   return static_cast<std::size_t>(axis < 0 ? axis + r : axis);
+}
+
+/// Writer of the code of the inference session of a model
+///
+/// Every tensor is accessed in the body of the inference function through a pointer `tensor_<name>`:
+/// the inputs and outputs of the model are the arguments of the function, the weights and the
+/// intermediate tensors are members of the session, allocated once when the session is created.
+class RModelGenerator {
+   const RModel &fModel;
+   std::map<std::string, Shape_t> fShapes;   ///< Shapes of the tensors defined so far
+   std::set<std::string> fDeclared;          ///< Tensors with a pointer in the inference function
+   std::set<std::string> fModelOutputs;      ///< Outputs of the model
+   std::stringstream fMembers;               ///< Declaration of the members of the session
+   std::stringstream fPointers;              ///< Declaration of the pointers in the inference function
+   std::stringstream fBody;                  ///< Body of the inference function
+   std::size_t fOpIndex = 0;                 ///< Index of the operator being generated
+
+   const RModelOperator &CurrentOp() const { return fModel.GetOperators()[fOpIndex]; }
+
+   [[noreturn]] void Fail(const std::string &what) const
+   {
+      throw std::runtime_error("TMVA::RModel: operator " + fModel.GetOperators()[fOpIndex].fType + " (" +
+                               std::to_string(fOpIndex) + ") " + what);
+   }
+
+   /// Write the values of a tensor as initializer list of a std::vector<float>
+   static void WriteValues(std::ostream &os, const std::vector<float> &values)
+   {
+      os << std::scientific << std::setprecision(std::numeric_limits<float>::max_digits10 - 1);
+      os << "{";
+      for (std::size_t i = 0; i < values.size(); i++) {
+         if (!std::isfinite(values[i]))
+            throw std::runtime_error("TMVA::RModel: weights with infinite or NaN values are not supported");
+         if (i > 0)
+            os << (i % 8 == 0 ? ",\n      " : ", ");
+         os << values[i] << "f";
+      }
+      os << "}";
+      os << std::defaultfloat;
+   }
+
+   /// Declare the weights `name` of the session
+   std::string AddWeights(const std::string &name, const std::vector<float> &values)
+   {
+      const auto var = Sanitize(name);
+      fMembers << "   std::vector<float> fTensor_" << var << " = ";
+      WriteValues(fMembers, values);
+      fMembers << ";\n";
+      fPointers << "      const float *tensor_" << var << " = fTensor_" << var << ".data();\n";
+      fDeclared.insert(name);
+      return "tensor_" + var;
+   }
+
+   /// Declare a buffer of the session, for temporary values of an operator
+   std::string AddBuffer(const std::string &suffix, std::size_t size)
+   {
+      const auto var = "op" + std::to_string(fOpIndex) + "_" + suffix;
+      fMembers << "   std::vector<float> fBuffer_" << var << " = std::vector<float>(" << size << ");\n";
+      fPointers << "      float *buffer_" << var << " = fBuffer_" << var << ".data();\n";
+      return "buffer_" + var;
+   }
+
+   /// Return the variable of the input tensor `name` of an operator
+   std::string Input(const std::string &name)
+   {
+      if (fDeclared.count(name) > 0)
+         return "tensor_" + Sanitize(name);
+      if (!fModel.IsInitializedTensor(name))
+         Fail("uses tensor " + name + ", which is not defined before");
+      const auto &tensor = fModel.GetInitializedTensor(name);
+      if (tensor.fData.size() != GetSize(tensor.fShape))
+         Fail("uses tensor " + name + ", which is not a tensor of floating point values");
+      return AddWeights(name, tensor.fData);
+   }
+
+   /// Return the shape of the input `i` of the operator, which must exist
+   const Shape_t &InputShape(std::size_t i) const
+   {
+      if (i >= CurrentOp().fInputs.size() || CurrentOp().fInputs[i].empty())
+         Fail("needs input " + std::to_string(i));
+      const auto &name = CurrentOp().fInputs[i];
+      auto item = fShapes.find(name);
+      if (item != fShapes.end())
+         return item->second;
+      if (!fModel.IsInitializedTensor(name))
+         Fail("uses tensor " + name + ", which is not defined before");
+      return fModel.GetInitializedTensor(name).fShape;
+   }
+
+   /// Return true if the optional input `i` of the operator is given
+   bool HasInput(std::size_t i) const { return i < CurrentOp().fInputs.size() && !CurrentOp().fInputs[i].empty(); }
+
+   /// Return true if the optional output `i` of the operator is used
+   bool HasOutput(std::size_t i) const { return i < CurrentOp().fOutputs.size() && !CurrentOp().fOutputs[i].empty(); }
+
+   /// Return the values of the initialized input `i` of the operator
+   const RModelTensor &InitializedInput(std::size_t i)
+   {
+      InputShape(i);
+      if (!fModel.IsInitializedTensor(CurrentOp().fInputs[i]))
+         Fail("needs an initialized tensor as input " + std::to_string(i));
+      return fModel.GetInitializedTensor(CurrentOp().fInputs[i]);
+   }
+
+   /// Define the output `i` of the operator and return its variable
+   std::string Output(std::size_t i, const Shape_t &shape)
+   {
+      if (!HasOutput(i))
+         Fail("needs output " + std::to_string(i));
+      const auto &name = CurrentOp().fOutputs[i];
+      if (fShapes.count(name) > 0)
+         Fail("redefines tensor " + name);
+      fShapes[name] = shape;
+      const auto var = Sanitize(name);
+      if (fModelOutputs.count(name) == 0) {
+         fMembers << "   std::vector<float> fTensor_" << var << " = std::vector<float>(" << GetSize(shape) << ");\n";
+         fPointers << "      float *tensor_" << var << " = fTensor_" << var << ".data();\n";
+      }
+      fDeclared.insert(name);
+      return "tensor_" + var;
+   }
+
+   void GenerateGemm();
+   void GenerateMatMul();
+   void GenerateAdd();
+   void GenerateElementwise(const std::string &expression);
+   void GenerateSoftmax();
+   void GenerateBatchNormalization();
+   void GenerateConv();
+   void GenerateReshape();
+   void GenerateLSTM();
+   void GenerateGRU();
+   void CheckRecurrent(std::size_t maxInputs);
+
+public:
+   RModelGenerator(const RModel &model) : fModel(model)
+   {
+      fBody.precision(std::numeric_limits<float>::max_digits10);
+   }
+
+   std::string Generate(const std::string &nameSpace);
+};
+
+void RModelGenerator::GenerateGemm()
+{
+   const auto &op = CurrentOp();
+   const auto shapeA = InputShape(0);
+   const auto shapeB = InputShape(1);
+   if (shapeA.size() != 2 || shapeB.size() != 2)
+      Fail("needs matrices as inputs");
+   const bool transA = op.GetInt("transA", 0) != 0;
+   const bool transB = op.GetInt("transB", 0) != 0;
+   const auto m = transA ? shapeA[1] : shapeA[0];
+   const auto k = transA ? shapeA[0] : shapeA[1];
+   const auto n = transB ? shapeB[0] : shapeB[1];
+   if ((transB ? shapeB[1] : shapeB[0]) != k)
+      Fail("has inputs with incompatible shapes " + ShapeToString(shapeA) + " and " + ShapeToString(shapeB));
+   const auto a = Input(op.fInputs[0]);
+   const auto b = Input(op.fInputs[1]);
+   const auto alpha = op.GetFloat("alpha", 1.);
+   auto beta = op.GetFloat("beta", 1.);
+
+   const auto y = Output(0, {m, n});
+   if (HasInput(2) && beta != 0.) {
+      // Broadcast C to the shape of the output, which is then accumulated by the multiplication
+      auto shapeC = InputShape(2);
+      const auto c = Input(op.fInputs[2]);
+      while (shapeC.size() < 2)
+         shapeC.insert(shapeC.begin(), 1);
+      if (shapeC.size() != 2 || (shapeC[0] != 1 && shapeC[0] != m) || (shapeC[1] != 1 && shapeC[1] != n))
+         Fail("cannot broadcast input C of shape " + ShapeToString(shapeC));
+      std::string index = shapeC[1] == 1 ? "0" : "j";
+      if (shapeC[0] != 1)
+         index = "i * " + std::to_string(shapeC[1]) + " + " + index;
+      fBody << "      for (int i = 0; i < " << m << "; i++)\n"
+            << "         for (int j = 0; j < " << n << "; j++)\n"
+            << "            " << y << "[i * " << n << " + j] = " << c << "[" << index << "];\n";
+   } else {
+      beta = 0.;
+   }
+   fBody << "      Gemm(" << transA << ", " << transB << ", " << m << ", " << n << ", " << k << ", " << alpha << ", "
+         << a << ", " << b << ", " << beta << ", " << y << ");\n";
+}
+
+void RModelGenerator::GenerateMatMul()
+{
+   const auto &op = CurrentOp();
+   const auto shapeA = InputShape(0);
+   const auto shapeB = InputShape(1);
+   if (shapeA.size() < 2 || shapeB.size() != 2 || shapeA.back() != shapeB[0])
+      Fail("supports only the product of a tensor with a matrix, not of shapes " + ShapeToString(shapeA) + " and " +
+           ShapeToString(shapeB));
+   const auto k = shapeB[0];
+   const auto n = shapeB[1];
+   const auto m = GetSize(shapeA) / k;
+   const auto a = Input(op.fInputs[0]);
+   const auto b = Input(op.fInputs[1]);
+   auto shapeY = shapeA;
+   shapeY.back() = n;
+   const auto y = Output(0, shapeY);
+   fBody << "      Gemm(0, 0, " << m << ", " << n << ", " << k << ", 1., " << a << ", " << b << ", 0., " << y << ");\n";
+}
+
+void RModelGenerator::GenerateAdd()
+{
+   const auto &op = CurrentOp();
+   auto shapeA = InputShape(0);
+   auto shapeB = InputShape(1);
+   auto a = Input(op.fInputs[0]);
+   auto b = Input(op.fInputs[1]);
+   if (GetSize(shapeA) < GetSize(shapeB)) {
+      std::swap(shapeA, shapeB);
+      std::swap(a, b);
+   }
+   // The smaller tensor is broadcast if its shape matches the last dimensions of the larger one
+   while (!shapeB.empty() && shapeB.front() == 1)
+      shapeB.erase(shapeB.begin());
+   if (shapeB.size() > shapeA.size() || !std::equal(shapeB.begin(), shapeB.end(), shapeA.end() - shapeB.size()))
+      Fail("supports only the broadcast of the last dimensions, not of shapes " + ShapeToString(shapeA) + " and " +
+           ShapeToString(shapeB));
+   const auto size = GetSize(shapeA);
+   const auto sizeB = GetSize(shapeB);
+   const auto y = Output(0, shapeA);
+   fBody << "      for (int i = 0; i < " << size << "; i++)\n"
+         << "         " << y << "[i] = " << a << "[i] + " << b << "[" << (sizeB == size ? "i" : "i % " + std::to_string(sizeB))
+         << "];\n";
+}
+
+/// Generate an operator applying `expression` of the value `x` to all elements of the input
+void RModelGenerator::GenerateElementwise(const std::string &expression)
+{
+   const auto shape = InputShape(0);
+   const auto x = Input(CurrentOp().fInputs[0]);
+   const auto y = Output(0, shape);
+   fBody << "      for (int i = 0; i < " << GetSize(shape) << "; i++) {\n"
+         << "         const float x = " << x << "[i];\n"
+         << "         " << y << "[i] = " << expression << ";\n"
+         << "      }\n";
+}
+
+void RModelGenerator::GenerateSoftmax()
+{
+   const auto shape = InputShape(0);
+   const auto x = Input(CurrentOp().fInputs[0]);
+   const auto y = Output(0, shape);
+   // Before version 13 of the operator set, the input is coerced to a matrix at the axis
+   const bool coerce = fModel.GetOpsetVersion() < 13;
+   const auto axis = GetAxis(CurrentOp().GetInt("axis", coerce ? 1 : -1), shape.size(), CurrentOp().fType);
+   const auto outer = GetSize(Shape_t(shape.begin(), shape.begin() + axis));
+   const auto inner = coerce ? 1 : GetSize(Shape_t(shape.begin() + axis + 1, shape.end()));
+   const auto size = GetSize(shape) / outer / inner;
+   fBody << "      for (int o = 0; o < " << outer << "; o++) {\n"
+         << "         for (int i = 0; i < " << inner << "; i++) {\n"
+         << "            const float *x = " << x << " + o * " << size * inner << " + i;\n"
+         << "            float *y = " << y << " + o * " << size * inner << " + i;\n"
+         << "            float max = x[0];\n"
+         << "            for (int j = 1; j < " << size << "; j++)\n"
+         << "               max = std::max(max, x[j * " << inner << "]);\n"
+         << "            float sum = 0.;\n"
+         << "            for (int j = 0; j < " << size << "; j++) {\n"
+         << "               y[j * " << inner << "] = std::exp(x[j * " << inner << "] - max);\n"
+         << "               sum += y[j * " << inner << "];\n"
+         << "            }\n"
+         << "            for (int j = 0; j < " << size << "; j++)\n"
+         << "               y[j * " << inner << "] /= sum;\n"
+         << "         }\n"
+         << "      }\n";
+}
+
+void RModelGenerator::GenerateBatchNormalization()
+{
+   const auto shape = InputShape(0);
+   if (shape.size() < 2)
+      Fail("needs an input with a dimension for the channels");
+   const auto channels = shape[1];
+   const auto &scale = InitializedInput(1).fData;
+   const auto &bias = InitializedInput(2).fData;
+   const auto &mean = InitializedInput(3).fData;
+   const auto &var = InitializedInput(4).fData;
+   if (scale.size() != channels || bias.size() != channels || mean.size() != channels || var.size() != channels)
+      Fail("has parameters which do not match the " + std::to_string(channels) + " channels");
+
+   // Fold the normalization in a linear function of the input
+   const auto epsilon = CurrentOp().GetFloat("epsilon", 1e-5);
+   std::vector<float> a(channels);
+   std::vector<float> b(channels);
+   for (std::size_t c = 0; c < channels; c++) {
+      a[c] = scale[c] / std::sqrt(var[c] + epsilon);
+      b[c] = bias[c] - mean[c] * a[c];
+   }
+   const auto prefix = "op" + std::to_string(fOpIndex) + "_";
+   const auto va = AddWeights(prefix + "scale", a);
+   const auto vb = AddWeights(prefix + "bias", b);
+
+   const auto x = Input(CurrentOp().fInputs[0]);
+   const auto y = Output(0, shape);
+   const auto size = GetSize(shape) / shape[0] / channels;
+   fBody << "      for (int n = 0; n < " << shape[0] << "; n++) {\n"
+         << "         for (int c = 0; c < " << channels << "; c++) {\n"
+         << "            const int offset = (n * " << channels << " + c) * " << size << ";\n"
+         << "            for (int i = 0; i < " << size << "; i++)\n"
+         << "               " << y << "[offset + i] = " << va << "[c] * " << x << "[offset + i] + " << vb << "[c];\n"
+         << "         }\n"
+         << "      }\n";
+}
+
+void RModelGenerator::GenerateConv()
+{
+   const auto &op = CurrentOp();
+   const auto shapeX = InputShape(0);
+   const auto shapeW = InputShape(1);
+   if ((shapeX.size() != 3 && shapeX.size() != 4) || shapeW.size() != shapeX.size())
+      Fail("supports only 1D and 2D convolutions");
+   const auto spatial = shapeX.size() - 2;
+
+   // The 1D convolution is a 2D convolution of inputs with a height of one
+   const std::size_t batch = shapeX[0];
+   const std::size_t channels = shapeX[1];
+   const std::size_t height = spatial == 2 ? shapeX[2] : 1;
+   const std::size_t width = shapeX.back();
+   const std::size_t filters = shapeW[0];
+   const std::size_t groupChannels = shapeW[1];
+   const std::size_t kernelH = spatial == 2 ? shapeW[2] : 1;
+   const std::size_t kernelW = shapeW.back();
+   const auto group = static_cast<std::size_t>(op.GetInt("group", 1));
+   if (group == 0 || channels != groupChannels * group || filters % group != 0)
+      Fail("has a number of channels and groups which do not match");
+   const auto kernelShape = op.GetInts("kernel_shape", {});
+   if (!kernelShape.empty() && (kernelShape.size() != spatial || static_cast<std::size_t>(kernelShape.back()) != kernelW))
+      Fail("has a kernel shape which does not match the weights");
+
+   auto strides = op.GetInts("strides", std::vector<std::int64_t>(spatial, 1));
+   auto dilations = op.GetInts("dilations", std::vector<std::int64_t>(spatial, 1));
+   auto pads = op.GetInts("pads", std::vector<std::int64_t>(2 * spatial, 0));
+   if (strides.size() != spatial || dilations.size() != spatial || pads.size() != 2 * spatial)
+      Fail("has strides, dilations or pads which do not match the dimension");
+   if (spatial == 1) {
+      strides.insert(strides.begin(), 1);
+      dilations.insert(dilations.begin(), 1);
+      pads = {0, pads[0], 0, pads[1]};
+   }
+   const std::int64_t inputSize[2] = {static_cast<std::int64_t>(height), static_cast<std::int64_t>(width)};
+   const std::int64_t kernel[2] = {static_cast<std::int64_t>(kernelH), static_cast<std::int64_t>(kernelW)};
+   const auto autoPad = op.GetString("auto_pad", "NOTSET");
+   if (autoPad == "VALID") {
+      pads = {0, 0, 0, 0};
+   } else if (autoPad == "SAME_UPPER" || autoPad == "SAME_LOWER") {
+      for (int d = 0; d < 2; d++) {
+         const auto outputSize = (inputSize[d] + strides[d] - 1) / strides[d];
+         const auto total =
+            std::max<std::int64_t>(0, (outputSize - 1) * strides[d] + dilations[d] * (kernel[d] - 1) + 1 - inputSize[d]);
+         pads[d] = autoPad == "SAME_UPPER" ? total / 2 : total - total / 2;
+         pads[d + 2] = total - pads[d];
+      }
+   } else if (autoPad != "NOTSET") {
+      Fail("has an unknown auto_pad " + autoPad);
+   }
+   std::int64_t outputSize[2];
+   for (int d = 0; d < 2; d++) {
+      if (strides[d] < 1 || dilations[d] < 1)
+         Fail("has invalid strides or dilations");
+      outputSize[d] = (inputSize[d] + pads[d] + pads[d + 2] - dilations[d] * (kernel[d] - 1) - 1) / strides[d] + 1;
+      if (outputSize[d] < 1)
+         Fail("has a kernel larger than the padded input");
+   }
+
+   const auto x = Input(op.fInputs[0]);
+   const auto w = Input(op.fInputs[1]);
+   std::string b;
+   if (HasInput(2)) {
+      if (GetSize(InputShape(2)) != filters)
+         Fail("has a bias which does not match the number of filters");
+      b = Input(op.fInputs[2]);
+   }
+   Shape_t shapeY = {batch, filters};
+   if (spatial == 2)
+      shapeY.push_back(outputSize[0]);
+   shapeY.push_back(outputSize[1]);
+   const auto y = Output(0, shapeY);
+
+   // Unfold the patches of the input in the columns of a matrix, which is multiplied with the filters
+   const std::size_t outputPixels = outputSize[0] * outputSize[1];
+   const std::size_t patchSize = groupChannels * kernelH * kernelW;
+   const std::size_t groupFilters = filters / group;
+   const auto col = AddBuffer("col", patchSize * outputPixels);
+   fBody << "      for (int n = 0; n < " << batch << "; n++) {\n"
+         << "         for (int g = 0; g < " << group << "; g++) {\n"
+         << "            const float *x = " << x << " + (n * " << channels << " + g * " << groupChannels << ") * "
+         << height * width << ";\n"
+         << "            for (int c = 0; c < " << groupChannels << "; c++) {\n"
+         << "               for (int kh = 0; kh < " << kernelH << "; kh++) {\n"
+         << "                  for (int kw = 0; kw < " << kernelW << "; kw++) {\n"
+         << "                     float *col = " << col << " + ((c * " << kernelH << " + kh) * " << kernelW
+         << " + kw) * " << outputPixels << ";\n"
+         << "                     for (int oh = 0; oh < " << outputSize[0] << "; oh++) {\n"
+         << "                        const int h = oh * " << strides[0] << " - " << pads[0] << " + kh * "
+         << dilations[0] << ";\n"
+         << "                        for (int ow = 0; ow < " << outputSize[1] << "; ow++) {\n"
+         << "                           const int w = ow * " << strides[1] << " - " << pads[1] << " + kw * "
+         << dilations[1] << ";\n"
+         << "                           col[oh * " << outputSize[1] << " + ow] = (h >= 0 && h < " << height
+         << " && w >= 0 && w < " << width << ") ? x[(c * " << height << " + h) * " << width << " + w] : 0.f;\n"
+         << "                        }\n"
+         << "                     }\n"
+         << "                  }\n"
+         << "               }\n"
+         << "            }\n"
+         << "            Gemm(0, 0, " << groupFilters << ", " << outputPixels << ", " << patchSize << ", 1., " << w
+         << " + g * " << groupFilters * patchSize << ", " << col << ", 0., " << y << " + (n * " << filters
+         << " + g * " << groupFilters << ") * " << outputPixels << ");\n"
+         << "         }\n"
+         << "      }\n";
+   if (!b.empty()) {
+      fBody << "      for (int n = 0; n < " << batch << "; n++)\n"
+            << "         for (int m = 0; m < " << filters << "; m++)\n"
+            << "            for (int i = 0; i < " << outputPixels << "; i++)\n"
+            << "               " << y << "[(n * " << filters << " + m) * " << outputPixels << " + i] += " << b
+            << "[m];\n";
+   }
+}
+
+/// Generate Flatten and Reshape, which copy the values of the input
+void RModelGenerator::GenerateReshape()
+{
+   const auto &op = CurrentOp();
+   const auto shapeX = InputShape(0);
+   const auto size = GetSize(shapeX);
+   Shape_t shapeY;
+   if (op.fType == "Flatten") {
+      // The axis of Flatten can be equal to the rank of the input
+      auto axis = op.GetInt("axis", 1);
+      if (axis < 0)
+         axis += shapeX.size();
+      if (axis < 0 || axis > static_cast<std::int64_t>(shapeX.size()))
+         Fail("has an axis out of range");
+      shapeY = {GetSize(Shape_t(shapeX.begin(), shapeX.begin() + axis)),
+                GetSize(Shape_t(shapeX.begin() + axis, shapeX.end()))};
+   } else if (op.fType == "Reshape") {
+      if (!HasInput(1) || !fModel.IsInitializedTensor(op.fInputs[1]))
+         Fail("needs the shape as initialized tensor");
+      const auto &shape = fModel.GetInitializedTensor(op.fInputs[1]).fIntData;
+      int inferred = -1;
+      for (std::size_t i = 0; i < shape.size(); i++) {
+         if (shape[i] == 0 && i < shapeX.size() && op.GetInt("allowzero", 0) == 0) {
+            shapeY.push_back(shapeX[i]);
+         } else if (shape[i] == -1 && inferred < 0) {
+            inferred = i;
+            shapeY.push_back(1);
+         } else if (shape[i] > 0) {
+            shapeY.push_back(shape[i]);
+         } else {
+            Fail("has an invalid shape");
+         }
+      }
+      if (inferred >= 0)
+         shapeY[inferred] = size / GetSize(shapeY);
+   } else {
+      shapeY = shapeX;
+   }
+   if (GetSize(shapeY) != size)
+      Fail("changes the size of the tensor from " + ShapeToString(shapeX) + " to " + ShapeToString(shapeY));
+   const auto x = Input(op.fInputs[0]);
+   const auto y = Output(0, shapeY);
+   fBody << "      std::copy(" << x << ", " << x << " + " << size << ", " << y << ");\n";
+}
+
+/// Check the options of LSTM and GRU which are not supported
+void RModelGenerator::CheckRecurrent(std::size_t maxInputs)
+{
+   const auto &op = CurrentOp();
+   if (op.GetString("direction", "forward") != "forward")
+      Fail("supports only the forward direction");
+   if (op.GetInt("layout", 0) != 0)
+      Fail("supports only the layout with the sequence as first dimension");
+   if (op.HasAttribute("clip"))
+      Fail("does not support the clip of the cell");
+   if (op.HasAttribute("activations")) {
+      const auto &activations = op.fAttributes.at("activations").fStrings;
+      const std::vector<std::string> lstm = {"Sigmoid", "Tanh", "Tanh"};
+      const std::vector<std::string> gru = {"Sigmoid", "Tanh"};
+      if (activations != (op.fType == "LSTM" ? lstm : gru))
+         Fail("supports only the default activation functions");
+   }
+   if (HasInput(4))
+      Fail("does not support sequences of different length");
+   for (std::size_t i = maxInputs; i < op.fInputs.size(); i++) {
+      if (!op.fInputs[i].empty())
+         Fail("has an unsupported input " + op.fInputs[i]);
+   }
+}
+
+void RModelGenerator::GenerateLSTM()
+{
+   const auto &op = CurrentOp();
+   CheckRecurrent(7);
+   if (op.GetInt("input_forget", 0) != 0)
+      Fail("does not support the coupling of the input and forget gates");
+
+   const auto shapeX = InputShape(0);
+   const auto shapeW = InputShape(1);
+   const auto shapeR = InputShape(2);
+   const auto hidden = static_cast<std::size_t>(op.GetInt("hidden_size", shapeR.back()));
+   if (shapeX.size() != 3 || shapeW != Shape_t{1, 4 * hidden, shapeX[2]} || shapeR != Shape_t{1, 4 * hidden, hidden})
+      Fail("has weights which do not match the input and hidden size");
+   const auto seqLength = shapeX[0];
+   const auto batch = shapeX[1];
+   const auto inputSize = shapeX[2];
+   const auto gates = 4 * hidden;
+
+   // The biases of the input and recurrent weights are added in the gates before the sequence
+   std::vector<float> bias(gates, 0.);
+   if (HasInput(3)) {
+      const auto &b = InitializedInput(3).fData;
+      if (b.size() != 2 * gates)
+         Fail("has a bias which does not match the hidden size");
+      for (std::size_t i = 0; i < gates; i++)
+         bias[i] = b[i] + b[gates + i];
+   }
+   const auto vb = AddWeights("op" + std::to_string(fOpIndex) + "_bias", bias);
+   const auto x = Input(op.fInputs[0]);
+   const auto w = Input(op.fInputs[1]);
+   const auto r = Input(op.fInputs[2]);
+   const auto state = batch * hidden;
+   std::string initialH, initialC;
+   if (HasInput(5)) {
+      if (GetSize(InputShape(5)) != state)
+         Fail("has an initial hidden state which does not match the hidden size");
+      initialH = Input(op.fInputs[5]);
+   }
+   if (HasInput(6)) {
+      if (GetSize(InputShape(6)) != state)
+         Fail("has an initial cell state which does not match the hidden size");
+      initialC = Input(op.fInputs[6]);
+   }
+   const auto g = AddBuffer("gates", seqLength * batch * gates);
+   const auto h = AddBuffer("h", state);
+   const auto c = AddBuffer("c", state);
+   std::string y, yh, yc;
+   if (HasOutput(0))
+      y = Output(0, {seqLength, 1, batch, hidden});
+   if (HasOutput(1))
+      yh = Output(1, {1, batch, hidden});
+   if (HasOutput(2))
+      yc = Output(2, {1, batch, hidden});
+
+   // Gates in the order input, output, forget, cell
+   fBody << "      for (int i = 0; i < " << seqLength * batch << "; i++)\n"
+         << "         std::copy(" << vb << ", " << vb << " + " << gates << ", " << g << " + i * " << gates << ");\n"
+         << "      Gemm(0, 1, " << seqLength * batch << ", " << gates << ", " << inputSize << ", 1., " << x << ", " << w
+         << ", 1., " << g << ");\n";
+   if (initialH.empty())
+      fBody << "      std::fill(" << h << ", " << h << " + " << state << ", 0.f);\n";
+   else
+      fBody << "      std::copy(" << initialH << ", " << initialH << " + " << state << ", " << h << ");\n";
+   if (initialC.empty())
+      fBody << "      std::fill(" << c << ", " << c << " + " << state << ", 0.f);\n";
+   else
+      fBody << "      std::copy(" << initialC << ", " << initialC << " + " << state << ", " << c << ");\n";
+   fBody << "      for (int t = 0; t < " << seqLength << "; t++) {\n"
+         << "         float *gt = " << g << " + t * " << batch * gates << ";\n"
+         << "         Gemm(0, 1, " << batch << ", " << gates << ", " << hidden << ", 1., " << h << ", " << r
+         << ", 1., gt);\n"
+         << "         for (int b = 0; b < " << batch << "; b++) {\n"
+         << "            const float *gb = gt + b * " << gates << ";\n"
+         << "            for (int j = 0; j < " << hidden << "; j++) {\n"
+         << "               const float i = 1.f / (1.f + std::exp(-gb[j]));\n"
+         << "               const float o = 1.f / (1.f + std::exp(-gb[" << hidden << " + j]));\n"
+         << "               const float f = 1.f / (1.f + std::exp(-gb[" << 2 * hidden << " + j]));\n"
+         << "               const float z = std::tanh(gb[" << 3 * hidden << " + j]);\n"
+         << "               const int k = b * " << hidden << " + j;\n"
+         << "               " << c << "[k] = f * " << c << "[k] + i * z;\n"
+         << "               " << h << "[k] = o * std::tanh(" << c << "[k]);\n"
+         << "            }\n"
+         << "         }\n";
+   if (!y.empty())
+      fBody << "         std::copy(" << h << ", " << h << " + " << state << ", " << y << " + t * " << state << ");\n";
+   fBody << "      }\n";
+   if (!yh.empty())
+      fBody << "      std::copy(" << h << ", " << h << " + " << state << ", " << yh << ");\n";
+   if (!yc.empty())
+      fBody << "      std::copy(" << c << ", " << c << " + " << state << ", " << yc << ");\n";
+}
+
+void RModelGenerator::GenerateGRU()
+{
+   const auto &op = CurrentOp();
+   CheckRecurrent(6);
+   const bool linearBeforeReset = op.GetInt("linear_before_reset", 0) != 0;
+
+   const auto shapeX = InputShape(0);
+   const auto shapeW = InputShape(1);
+   const auto shapeR = InputShape(2);
+   const auto hidden = static_cast<std::size_t>(op.GetInt("hidden_size", shapeR.back()));
+   if (shapeX.size() != 3 || shapeW != Shape_t{1, 3 * hidden, shapeX[2]} || shapeR != Shape_t{1, 3 * hidden, hidden})
+      Fail("has weights which do not match the input and hidden size");
+   const auto seqLength = shapeX[0];
+   const auto batch = shapeX[1];
+   const auto inputSize = shapeX[2];
+   const auto gates = 3 * hidden;
+
+   std::vector<float> biasW(gates, 0.);
+   std::vector<float> biasR(gates, 0.);
+   if (HasInput(3)) {
+      const auto &b = InitializedInput(3).fData;
+      if (b.size() != 2 * gates)
+         Fail("has a bias which does not match the hidden size");
+      std::copy(b.begin(), b.begin() + gates, biasW.begin());
+      std::copy(b.begin() + gates, b.end(), biasR.begin());
+   }
+   const auto prefix = "op" + std::to_string(fOpIndex) + "_";
+   const auto vbw = AddWeights(prefix + "biasW", biasW);
+   const auto vbr = AddWeights(prefix + "biasR", biasR);
+   const auto x = Input(op.fInputs[0]);
+   const auto w = Input(op.fInputs[1]);
+   const auto r = Input(op.fInputs[2]);
+   const auto state = batch * hidden;
+   std::string initialH;
+   if (HasInput(5)) {
+      if (GetSize(InputShape(5)) != state)
+         Fail("has an initial hidden state which does not match the hidden size");
+      initialH = Input(op.fInputs[5]);
+   }
+   const auto gx = AddBuffer("gates", seqLength * batch * gates);
+   const auto gh = AddBuffer("recurrent", batch * gates);
+   const auto h = AddBuffer("h", state);
+   std::string rh, ghh;
+   if (!linearBeforeReset) {
+      rh = AddBuffer("resetH", state);
+      ghh = AddBuffer("recurrentH", state);
+   }
+   std::string y, yh;
+   if (HasOutput(0))
+      y = Output(0, {seqLength, 1, batch, hidden});
+   if (HasOutput(1))
+      yh = Output(1, {1, batch, hidden});
+
+   // Gates in the order update, reset, hidden
+   fBody << "      for (int i = 0; i < " << seqLength * batch << "; i++)\n"
+         << "         std::copy(" << vbw << ", " << vbw << " + " << gates << ", " << gx << " + i * " << gates << ");\n"
+         << "      Gemm(0, 1, " << seqLength * batch << ", " << gates << ", " << inputSize << ", 1., " << x << ", " << w
+         << ", 1., " << gx << ");\n";
+   if (initialH.empty())
+      fBody << "      std::fill(" << h << ", " << h << " + " << state << ", 0.f);\n";
+   else
+      fBody << "      std::copy(" << initialH << ", " << initialH << " + " << state << ", " << h << ");\n";
+   fBody << "      for (int t = 0; t < " << seqLength << "; t++) {\n"
+         << "         const float *gt = " << gx << " + t * " << batch * gates << ";\n"
+         << "         for (int b = 0; b < " << batch << "; b++)\n"
+         << "            std::copy(" << vbr << ", " << vbr << " + " << gates << ", " << gh << " + b * " << gates << ");\n"
+         << "         Gemm(0, 1, " << batch << ", " << gates << ", " << hidden << ", 1., " << h << ", " << r << ", 1., "
+         << gh << ");\n";
+   if (!linearBeforeReset) {
+      // The recurrent part of the hidden gate is computed from the hidden state multiplied by the reset gate
+      fBody << "         for (int b = 0; b < " << batch << "; b++) {\n"
+            << "            for (int j = 0; j < " << hidden << "; j++) {\n"
+            << "               const int k = b * " << gates << " + " << hidden << " + j;\n"
+            << "               const float r = 1.f / (1.f + std::exp(-gt[k] - " << gh << "[k]));\n"
+            << "               " << rh << "[b * " << hidden << " + j] = r * " << h << "[b * " << hidden << " + j];\n"
+            << "               " << ghh << "[b * " << hidden << " + j] = " << vbr << "[" << 2 * hidden << " + j];\n"
+            << "            }\n"
+            << "         }\n"
+            << "         Gemm(0, 1, " << batch << ", " << hidden << ", " << hidden << ", 1., " << rh << ", " << r
+            << " + " << 2 * hidden * hidden << ", 1., " << ghh << ");\n";
+   }
+   fBody << "         for (int b = 0; b < " << batch << "; b++) {\n"
+         << "            const float *gxb = gt + b * " << gates << ";\n"
+         << "            const float *ghb = " << gh << " + b * " << gates << ";\n"
+         << "            for (int j = 0; j < " << hidden << "; j++) {\n"
+         << "               const float z = 1.f / (1.f + std::exp(-gxb[j] - ghb[j]));\n";
+   if (linearBeforeReset) {
+      fBody << "               const float r = 1.f / (1.f + std::exp(-gxb[" << hidden << " + j] - ghb[" << hidden
+            << " + j]));\n"
+            << "               const float n = std::tanh(gxb[" << 2 * hidden << " + j] + r * ghb[" << 2 * hidden
+            << " + j]);\n";
+   } else {
+      fBody << "               const float n = std::tanh(gxb[" << 2 * hidden << " + j] + " << ghh << "[b * " << hidden
+            << " + j]);\n";
+   }
+   fBody << "               const int k = b * " << hidden << " + j;\n"
+         << "               " << h << "[k] = (1.f - z) * n + z * " << h << "[k];\n"
+         << "            }\n"
+         << "         }\n";
+   if (!y.empty())
+      fBody << "         std::copy(" << h << ", " << h << " + " << state << ", " << y << " + t * " << state << ");\n";
+   fBody << "      }\n";
+   if (!yh.empty())
+      fBody << "      std::copy(" << h << ", " << h << " + " << state << ", " << yh << ");\n";
+}
+
+std::string RModelGenerator::Generate(const std::string &nameSpace)
+{
+   // The inputs and outputs of the model are the arguments of the inference function
+   std::stringstream args;
+   std::stringstream doc;
+   for (const auto &name : fModel.GetInputNames()) {
+      fShapes[name] = fModel.GetInputShape(name);
+      fDeclared.insert(name);
+      args << (args.tellp() > 0 ? ", " : "") << "const float *tensor_" << Sanitize(name);
+      doc << "/// - input " << name << " of shape " << ShapeToString(fShapes[name]) << "\n";
+   }
+   for (const auto &name : fModel.GetOutputNames()) {
+      fModelOutputs.insert(name);
+      args << (args.tellp() > 0 ? ", " : "") << "float *tensor_" << Sanitize(name);
+   }
+
+   const auto &operators = fModel.GetOperators();
+   for (fOpIndex = 0; fOpIndex < operators.size(); fOpIndex++) {
+      const auto &type = operators[fOpIndex].fType;
+      fBody << "      // " << type << "\n";
+      if (type == "Gemm")
+         GenerateGemm();
+      else if (type == "MatMul")
+         GenerateMatMul();
+      else if (type == "Add")
+         GenerateAdd();
+      else if (type == "Relu")
+         GenerateElementwise("x > 0.f ? x : 0.f");
+      else if (type == "Sigmoid")
+         GenerateElementwise("1.f / (1.f + std::exp(-x))");
+      else if (type == "Tanh")
+         GenerateElementwise("std::tanh(x)");
+      else if (type == "Softmax")
+         GenerateSoftmax();
+      else if (type == "BatchNormalization")
+         GenerateBatchNormalization();
+      else if (type == "Conv")
+         GenerateConv();
+      else if (type == "Flatten" || type == "Reshape" || type == "Identity")
+         GenerateReshape();
+      else if (type == "LSTM")
+         GenerateLSTM();
+      else if (type == "GRU")
+         GenerateGRU();
+      else
+         Fail("is not supported");
+   }
+
+   for (const auto &name : fModel.GetOutputNames()) {
+      if (fShapes.count(name) == 0 || fModel.IsInitializedTensor(name) ||
+          std::find(fModel.GetInputNames().begin(), fModel.GetInputNames().end(), name) !=
+             fModel.GetInputNames().end())
+         throw std::runtime_error("TMVA::RModel: output " + name + " is not computed by an operator of the model");
+      doc << "/// - output " << name << " of shape " << ShapeToString(fShapes[name]) << "\n";
+   }
+
+   std::string guard = "TMVA_RMODEL_" + Sanitize(nameSpace);
+   std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+   std::stringstream code;
+   code << "// Inference code generated by TMVA::Experimental::RModel\n"
+        << "\n"
+        << "#ifndef " << guard << "\n"
+        << "#define " << guard << "\n"
+        << "\n"
+        << "#include <algorithm>\n"
+        << "#include <cmath>\n"
+        << "#include <vector>\n"
+        << "\n"
+        << "namespace " << nameSpace << " {\n"
+        << "\n"
+        << "namespace BLAS {\n"
+        << "extern \"C\" void sgemm_(const char *transa, const char *transb, const int *m, const int *n, const int *k,\n"
+        << "                       const float *alpha, const float *A, const int *lda, const float *B, const int *ldb,\n"
+        << "                       const float *beta, float *C, const int *ldc);\n"
+        << "}\n"
+        << "\n"
+        << "/// Inference of the model, with the tensors in row major layout:\n"
+        << doc.str()
+        << "struct Session {\n"
+        << fMembers.str()
+        << "\n"
+        << "   void infer(" << args.str() << ")\n"
+        << "   {\n"
+        << fPointers.str()
+        << "\n"
+        << fBody.str()
+        << "   }\n"
+        << "\n"
+        << "private:\n"
+        << "   /// Row major C[m, n] = alpha * op(A)[m, k] * op(B)[k, n] + beta * C, computed as the column major\n"
+        << "   /// product of the transposed matrices\n"
+        << "   static void Gemm(bool transA, bool transB, int m, int n, int k, float alpha, const float *A,\n"
+        << "                    const float *B, float beta, float *C)\n"
+        << "   {\n"
+        << "      const char ta = transA ? 'T' : 'N';\n"
+        << "      const char tb = transB ? 'T' : 'N';\n"
+        << "      const int lda = transA ? m : k;\n"
+        << "      const int ldb = transB ? k : n;\n"
+        << "      BLAS::sgemm_(&tb, &ta, &n, &m, &k, &alpha, B, &ldb, A, &lda, &beta, C, &n);\n"
+        << "   }\n"
+        << "};\n"
+        << "\n"
+        << "} // namespace " << nameSpace << "\n"
+        << "\n"
+        << "#endif // " << guard << "\n";
+   return code.str();
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the code of the inference of the model.
+///
+/// \param[in] nameSpace Namespace of the generated code, which contains the struct `Session`
+/// \return Code of a header-only implementation of the inference
+
+std::string RModel::Generate(const std::string &nameSpace) const
+{
+   RModelGenerator generator(*this);
+   return generator.Generate(nameSpace);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the code of the inference of the model to a header file.
+///
+/// \param[in] nameSpace Namespace of the generated code, which contains the struct `Session`
+/// \param[in] filename Name of the header file
+
+void RModel::OutputGenerated(const std::string &nameSpace, const std::string &filename) const
+{
+   const auto code = Generate(nameSpace);
+   std::ofstream file(filename);
+   if (!file)
+      throw std::runtime_error("TMVA::RModel: cannot open file " + filename);
+   file << code;
+}
+
+} // namespace Experimental
+} // namespace TMVA
@@ -0,0 +1,478 @@
+// @(#)root/tmva $Id$
+
+/*************************************************************************
+ * Copyright (C) 2020, Rene Brun and Fons Rademakers.                    *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TMVA/RModelParser_ONNX.hxx"
+
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace TMVA {
+namespace Experimental {
+
+namespace {
+
+/// Decoder of the wire format of protobuf messages
+///
+/// The fields of a message are read in sequence with ReadKey(), followed by the read of the value
+/// with the method matching the type of the field, or Skip() for unknown fields.
+class ProtoReader {
+   const char *fPos;
+   const char *fEnd;
+
+   [[noreturn]] static void Fail() { throw std::runtime_error("TMVA::RModelParser_ONNX: invalid ONNX data"); }
+
+   const char *Advance(std::uint64_t n)
+   {
+      if (n > static_cast<std::uint64_t>(fEnd - fPos))
+         Fail();
+      const char *pos = fPos;
+      fPos += n;
+      return pos;
+   }
+
+public:
+   ProtoReader(const char *begin, const char *end) : fPos(begin), fEnd(end) {}
+
+   bool AtEnd() const { return fPos >= fEnd; }
+
+   std::uint64_t ReadVarint()
+   {
+      std::uint64_t value = 0;
+      for (int shift = 0; shift < 64; shift += 7) {
+         const auto byte = static_cast<unsigned char>(*Advance(1));
+         value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+         if (!(byte & 0x80))
+            return value;
+      }
+      Fail();
+   }
+
+   /// Read the number and the wire type of the next field
+   void ReadKey(int &field, int &wireType)
+   {
+      const auto key = ReadVarint();
+      field = static_cast<int>(key >> 3);
+      wireType = static_cast<int>(key & 7);
+   }
+
+   /// Read a length-delimited field, e.g. an embedded message
+   ProtoReader ReadBytes()
+   {
+      const auto length = ReadVarint();
+      const char *begin = Advance(length);
+      return ProtoReader(begin, fPos);
+   }
+
+   std::string ReadString()
+   {
+      auto bytes = ReadBytes();
+      return std::string(bytes.fPos, bytes.fEnd);
+   }
+
+   float ReadFloat()
+   {
+      float value;
+      std::memcpy(&value, Advance(sizeof(value)), sizeof(value));
+      return value;
+   }
+
+   double ReadDouble()
+   {
+      double value;
+      std::memcpy(&value, Advance(sizeof(value)), sizeof(value));
+      return value;
+   }
+
+   void Skip(int wireType)
+   {
+      switch (wireType) {
+      case 0: ReadVarint(); break;
+      case 1: Advance(8); break;
+      case 2: ReadBytes(); break;
+      case 5: Advance(4); break;
+      default: Fail();
+      }
+   }
+};
+
+/// Read an element of a repeated integer field, or all of them if the field is packed
+void ReadInts(ProtoReader &reader, int wireType, std::vector<std::int64_t> &values)
+{
+   if (wireType == 2) {
+      auto packed = reader.ReadBytes();
+      while (!packed.AtEnd())
+         values.push_back(static_cast<std::int64_t>(packed.ReadVarint()));
+   } else {
+      values.push_back(static_cast<std::int64_t>(reader.ReadVarint()));
+   }
+}
+
+/// Read an element of a repeated float field, or all of them if the field is packed
+void ReadFloats(ProtoReader &reader, int wireType, std::vector<float> &values)
+{
+   if (wireType == 2) {
+      auto packed = reader.ReadBytes();
+      while (!packed.AtEnd())
+         values.push_back(packed.ReadFloat());
+   } else {
+      values.push_back(reader.ReadFloat());
+   }
+}
+
+/// Read an element of a repeated double field, or all of them if the field is packed
+void ReadDoubles(ProtoReader &reader, int wireType, std::vector<double> &values)
+{
+   if (wireType == 2) {
+      auto packed = reader.ReadBytes();
+      while (!packed.AtEnd())
+         values.push_back(packed.ReadDouble());
+   } else {
+      values.push_back(reader.ReadDouble());
+   }
+}
+
+/// Content of the message TensorProto
+struct Tensor {
+   enum EDataType { kFloat = 1, kInt32 = 6, kInt64 = 7, kDouble = 11 };
+
+   std::string fName;
+   std::vector<std::int64_t> fDims;
+   int fDataType = 0;
+   std::vector<float> fFloats;
+   std::vector<std::int64_t> fInts;
+   std::vector<double> fDoubles;
+   std::string fRawData;
+   bool fExternal = false;
+};
+
+Tensor ReadTensor(ProtoReader reader)
+{
+   Tensor tensor;
+   int field, wireType;
+   while (!reader.AtEnd()) {
+      reader.ReadKey(field, wireType);
+      switch (field) {
+      case 1: ReadInts(reader, wireType, tensor.fDims); break;
+      case 2: tensor.fDataType = static_cast<int>(reader.ReadVarint()); break;
+      case 4: ReadFloats(reader, wireType, tensor.fFloats); break;
+      case 5: ReadInts(reader, wireType, tensor.fInts); break; // int32_data
+      case 7: ReadInts(reader, wireType, tensor.fInts); break; // int64_data
+      case 8: tensor.fName = reader.ReadString(); break;
+      case 9: tensor.fRawData = reader.ReadString(); break;
+      case 10: ReadDoubles(reader, wireType, tensor.fDoubles); break;
+      case 14: tensor.fExternal = reader.ReadVarint() == 1; break; // data_location
+      default: reader.Skip(wireType);
+      }
+   }
+   return tensor;
+}
+
+/// Copy the little endian values of the raw data of a tensor
+template <typename From, typename To>
+void ConvertRawData(const Tensor &tensor, std::vector<To> &values)
+{
+   const auto n = tensor.fRawData.size() / sizeof(From);
+   if (n * sizeof(From) != tensor.fRawData.size())
+      throw std::runtime_error("TMVA::RModelParser_ONNX: tensor " + tensor.fName + " has invalid raw data");
+   values.resize(n);
+   for (std::size_t i = 0; i < n; i++) {
+      From value;
+      std::memcpy(&value, tensor.fRawData.data() + i * sizeof(From), sizeof(From));
+      values[i] = static_cast<To>(value);
+   }
+}
+
+void AddTensor(RModel &model, const Tensor &tensor, const std::string &name)
+{
+   if (tensor.fExternal)
+      throw std::runtime_error("TMVA::RModelParser_ONNX: tensor " + name + " with external data is not supported");
+   std::vector<std::size_t> shape;
+   std::size_t size = 1;
+   for (auto d : tensor.fDims) {
+      if (d < 0)
+         throw std::runtime_error("TMVA::RModelParser_ONNX: tensor " + name + " has a negative dimension");
+      shape.push_back(static_cast<std::size_t>(d));
+      size *= shape.back();
+   }
+
+   std::vector<float> data;
+   std::vector<std::int64_t> intData;
+   bool isInteger = false;
+   const bool raw = !tensor.fRawData.empty();
+   switch (tensor.fDataType) {
+   case Tensor::kFloat:
+      if (raw)
+         ConvertRawData<float>(tensor, data);
+      else
+         data = tensor.fFloats;
+      break;
+   case Tensor::kDouble:
+      if (raw)
+         ConvertRawData<double>(tensor, data);
+      else
+         data.assign(tensor.fDoubles.begin(), tensor.fDoubles.end());
+      break;
+   case Tensor::kInt64:
+      isInteger = true;
+      if (raw)
+         ConvertRawData<std::int64_t>(tensor, intData);
+      else
+         intData = tensor.fInts;
+      break;
+   case Tensor::kInt32:
+      isInteger = true;
+      if (raw)
+         ConvertRawData<std::int32_t>(tensor, intData);
+      else
+         intData = tensor.fInts;
+      break;
+   default:
+      throw std::runtime_error("TMVA::RModelParser_ONNX: tensor " + name + " has an unsupported data type " +
+                               std::to_string(tensor.fDataType));
+   }
+
+   if ((isInteger ? intData.size() : data.size()) != size)
+      throw std::runtime_error("TMVA::RModelParser_ONNX: tensor " + name + " has a size which does not match its shape");
+   if (isInteger)
+      model.AddInitializedTensor(name, shape, intData);
+   else
+      model.AddInitializedTensor(name, shape, data);
+}
+
+/// Read an AttributeProto, and its tensor if it has one (attribute of the operator Constant)
+std::string ReadAttribute(ProtoReader reader, RModelAttribute &attribute, Tensor &tensor, bool &hasTensor)
+{
+   std::string name;
+   int field, wireType;
+   while (!reader.AtEnd()) {
+      reader.ReadKey(field, wireType);
+      switch (field) {
+      case 1: name = reader.ReadString(); break;
+      case 2: attribute.fFloat = reader.ReadFloat(); break;
+      case 3: attribute.fInt = static_cast<std::int64_t>(reader.ReadVarint()); break;
+      case 4: attribute.fString = reader.ReadString(); break;
+      case 5:
+         tensor = ReadTensor(reader.ReadBytes());
+         hasTensor = true;
+         break;
+      case 7: ReadFloats(reader, wireType, attribute.fFloats); break;
+      case 8: ReadInts(reader, wireType, attribute.fInts); break;
+      case 9: attribute.fStrings.push_back(reader.ReadString()); break;
+      default: reader.Skip(wireType);
+      }
+   }
+   return name;
+}
+
+/// Read a NodeProto, converting the operator Constant in an initialized tensor
+void ReadNode(ProtoReader reader, RModel &model)
+{
+   RModelOperator op;
+   std::string domain;
+   Tensor value;
+   bool hasValue = false;
+   int field, wireType;
+   while (!reader.AtEnd()) {
+      reader.ReadKey(field, wireType);
+      switch (field) {
+      case 1: op.fInputs.push_back(reader.ReadString()); break;
+      case 2: op.fOutputs.push_back(reader.ReadString()); break;
+      case 4: op.fType = reader.ReadString(); break;
+      case 5: {
+         RModelAttribute attribute;
+         const auto name = ReadAttribute(reader.ReadBytes(), attribute, value, hasValue);
+         op.fAttributes[name] = attribute;
+         break;
+      }
+      case 7: domain = reader.ReadString(); break;
+      default: reader.Skip(wireType);
+      }
+   }
+
+   if (!domain.empty() && domain != "ai.onnx")
+      throw std::runtime_error("TMVA::RModelParser_ONNX: operator " + op.fType + " of domain " + domain +
+                               " is not supported");
+   if (op.fType == "Constant") {
+      if (!hasValue || op.fOutputs.size() != 1)
+         throw std::runtime_error("TMVA::RModelParser_ONNX: only Constant operators with a tensor are supported");
+      AddTensor(model, value, op.fOutputs[0]);
+   } else {
+      model.AddOperator(op);
+   }
+}
+
+/// Read the name and the dimensions of a ValueInfoProto, with -1 for dimensions which are not fixed
+std::string ReadValueInfo(ProtoReader reader, std::vector<std::int64_t> &dims)
+{
+   std::string name;
+   int field, wireType;
+   while (!reader.AtEnd()) {
+      reader.ReadKey(field, wireType);
+      if (field == 1) {
+         name = reader.ReadString();
+      } else if (field == 2) {
+         // TypeProto, with the tensor type in field 1 and its shape in field 2
+         auto type = reader.ReadBytes();
+         while (!type.AtEnd()) {
+            type.ReadKey(field, wireType);
+            if (field != 1) {
+               type.Skip(wireType);
+               continue;
+            }
+            auto tensorType = type.ReadBytes();
+            while (!tensorType.AtEnd()) {
+               tensorType.ReadKey(field, wireType);
+               if (field != 2) {
+                  tensorType.Skip(wireType);
+                  continue;
+               }
+               auto shape = tensorType.ReadBytes();
+               while (!shape.AtEnd()) {
+                  shape.ReadKey(field, wireType);
+                  if (field != 1) {
+                     shape.Skip(wireType);
+                     continue;
+                  }
+                  // Dimension, with a fixed value in field 1 or a symbolic name in field 2
+                  auto dim = shape.ReadBytes();
+                  std::int64_t value = -1;
+                  while (!dim.AtEnd()) {
+                     dim.ReadKey(field, wireType);
+                     if (field == 1)
+                        value = static_cast<std::int64_t>(dim.ReadVarint());
+                     else
+                        dim.Skip(wireType);
+                  }
+                  dims.push_back(value > 0 ? value : -1);
+               }
+            }
+         }
+      } else {
+         reader.Skip(wireType);
+      }
+   }
+   return name;
+}
+
+RModel ReadGraph(ProtoReader reader, std::size_t batchSize, int opsetVersion)
+{
+   RModel model;
+   model.SetOpsetVersion(opsetVersion);
+   std::vector<ProtoReader> nodes, inputs, outputs;
+   std::set<std::string> initialized;
+   int field, wireType;
+   while (!reader.AtEnd()) {
+      reader.ReadKey(field, wireType);
+      switch (field) {
+      case 1: nodes.push_back(reader.ReadBytes()); break;
+      case 5: {
+         const auto tensor = ReadTensor(reader.ReadBytes());
+         AddTensor(model, tensor, tensor.fName);
+         initialized.insert(tensor.fName);
+         break;
+      }
+      case 11: inputs.push_back(reader.ReadBytes()); break;
+      case 12: outputs.push_back(reader.ReadBytes()); break;
+      default: reader.Skip(wireType);
+      }
+   }
+
+   // The initializers can also be listed as inputs of the graph
+   for (auto &input : inputs) {
+      std::vector<std::int64_t> dims;
+      const auto name = ReadValueInfo(input, dims);
+      if (initialized.count(name) > 0)
+         continue;
+      std::vector<std::size_t> shape;
+      for (std::size_t i = 0; i < dims.size(); i++) {
+         if (dims[i] < 0 && i > 0)
+            throw std::runtime_error("TMVA::RModelParser_ONNX: dimension " + std::to_string(i) + " of input " + name +
+                                     " is not fixed");
+         shape.push_back(dims[i] < 0 ? batchSize : static_cast<std::size_t>(dims[i]));
+      }
+      model.AddInput(name, shape);
+   }
+   for (auto &node : nodes)
+      ReadNode(node, model);
+   for (auto &output : outputs) {
+      std::vector<std::int64_t> dims;
+      model.AddOutput(ReadValueInfo(output, dims));
+   }
+   return model;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read a model from an ONNX file.
+///
+/// \param[in] filename Name of the ONNX file
+/// \param[in] batchSize Size of the dimensions of the inputs which are not fixed in the file
+
+RModel RModelParser_ONNX::Parse(const std::string &filename, std::size_t batchSize)
+{
+   std::ifstream file(filename, std::ios::binary);
+   if (!file)
+      throw std::runtime_error("TMVA::RModelParser_ONNX: cannot open file " + filename);
+   std::stringstream buffer;
+   buffer << file.rdbuf();
+   return ParseBuffer(buffer.str(), batchSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read a model from the content of an ONNX file.
+///
+/// \param[in] buffer Serialized ModelProto message
+/// \param[in] batchSize Size of the dimensions of the inputs which are not fixed in the model
+
+RModel RModelParser_ONNX::ParseBuffer(const std::string &buffer, std::size_t batchSize)
+{
+   ProtoReader reader(buffer.data(), buffer.data() + buffer.size());
+   bool hasGraph = false;
+   ProtoReader graph(nullptr, nullptr);
+   int opsetVersion = 1;
+   int field, wireType;
+   while (!reader.AtEnd()) {
+      reader.ReadKey(field, wireType);
+      if (field == 7) {
+         graph = reader.ReadBytes();
+         hasGraph = true;
+      } else if (field == 8) {
+         // OperatorSetIdProto, the version of the default domain defines the operators
+         auto opset = reader.ReadBytes();
+         std::string domain;
+         int version = 0;
+         while (!opset.AtEnd()) {
+            opset.ReadKey(field, wireType);
+            if (field == 1)
+               domain = opset.ReadString();
+            else if (field == 2)
+               version = static_cast<int>(opset.ReadVarint());
+            else
+               opset.Skip(wireType);
+         }
+         if (domain.empty() || domain == "ai.onnx")
+            opsetVersion = version;
+      } else {
+         reader.Skip(wireType);
+      }
+   }
+   if (!hasGraph)
+      throw std::runtime_error("TMVA::RModelParser_ONNX: the model does not contain a graph");
+   return ReadGraph(graph, batchSize, opsetVersion);
+}
+
+} // namespace Experimental
+} // namespace TMVA
@@ -6,6 +6,7 @@
 #include "TMVA/TreeInference/BranchlessTree.hxx"
 #include "TMVA/TreeInference/Objectives.hxx"
 
+#include <cmath>
 #include <vector>
 
 using namespace TMVA::Experimental;
@@ -277,3 +278,38 @@ TEST(BranchlessJittedForest, SortTrees)
    for (int i = 0; i < rows; i++)
       EXPECT_FLOAT_EQ(predictions1[i], predictions2[i]);
 }
+
+TEST(BranchlessForest, InferenceCode)
+{
+   const auto maxDepth = 1;
+   const auto numInputs = 2;
+   const auto numTrees = 3;
+   const float cut = 0.123456789;
+   WriteModel("myModel", "TestBranchlessForest4.root", "identity", {0, 1, 0}, {0, 0, 0},
+              {cut, 1.0, -1.0, 0.0, 2.0, -2.0, -cut, 4.0, -4.0}, {maxDepth}, {numTrees}, {numInputs}, {1});
+
+   BranchlessForest<float> forest;
+   forest.Load("myModel", "TestBranchlessForest4.root", 0);
+
+   // Compile the generated code and get the inference function
+   const auto code = forest.GetInferenceCode("BranchlessForestCode4");
+   ASSERT_NE(gInterpreter->Declare(code.c_str()), 0);
+   auto ptr = gInterpreter->Calc("BranchlessForestCode4::Inference");
+   ASSERT_NE(ptr, 0);
+   auto func = reinterpret_cast<void (*)(const float *, int, bool, float *)>(ptr);
+
+   // Use more events than processed in one block, with inputs next to the cut values
+   const auto rows = 50;
+   std::vector<float> inputs(numInputs * rows);
+   for (int i = 0; i < rows; i++) {
+      inputs[i * numInputs] = std::nextafter(i % 2 == 0 ? cut : -cut, i % 3 == 0 ? 1.0f : -1.0f);
+      inputs[i * numInputs + 1] = i % 5 == 0 ? 1.0 : -1.0;
+   }
+   std::vector<float> predictions1(rows);
+   forest.Inference(inputs.data(), rows, true, predictions1.data());
+   std::vector<float> predictions2(rows);
+   func(inputs.data(), rows, true, predictions2.data());
+
+   for (int i = 0; i < rows; i++)
+      EXPECT_EQ(predictions1[i], predictions2[i]);
+}
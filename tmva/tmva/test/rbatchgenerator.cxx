@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "TMVA/RBatchGenerator.hxx"
+#include "ROOT/RDataFrame.hxx"
+
+#include <vector>
+
+using namespace ROOT;
+using namespace TMVA::Experimental;
+
+TEST(RBatchGenerator, AllEventsOnce)
+{
+   RDataFrame df(1000);
+   auto df2 = df.Define("a", "rdfentry_").Define("b", "-1.f * rdfentry_");
+   RBatchGenerator generator(df2, {"a", "b"}, 64, 200);
+
+   for (unsigned int epoch = 0; epoch < 2; epoch++) {
+      std::vector<int> seen(1000, 0);
+      std::size_t numEvents = 0;
+      const auto numBatches = generator.ForEachBatch([&](const RTensor<float> &x) {
+         const auto shape = x.GetShape();
+         EXPECT_EQ(shape.size(), 2u);
+         EXPECT_LE(shape[0], 64u);
+         EXPECT_EQ(shape[1], 2u);
+         for (std::size_t i = 0; i < shape[0]; i++) {
+            EXPECT_EQ(x(i, 1), -x(i, 0));
+            seen[static_cast<std::size_t>(x(i, 0))]++;
+         }
+         numEvents += shape[0];
+      });
+      EXPECT_EQ(numBatches, 16u);
+      EXPECT_EQ(numEvents, 1000u);
+      for (auto n : seen)
+         EXPECT_EQ(n, 1);
+   }
+}
+
+TEST(RBatchGenerator, Shuffle)
+{
+   RDataFrame df(100);
+   auto df2 = df.Define("a", "rdfentry_");
+   RBatchGenerator generator(df2, {"a"}, 100, 100);
+
+   std::vector<float> first, second;
+   generator.ForEachBatch([&](const RTensor<float> &x) { first.assign(x.GetData(), x.GetData() + x.GetSize()); });
+   generator.ForEachBatch([&](const RTensor<float> &x) { second.assign(x.GetData(), x.GetData() + x.GetSize()); });
+   EXPECT_EQ(first.size(), 100u);
+   EXPECT_EQ(second.size(), 100u);
+   EXPECT_NE(first, second);
+}
+
+TEST(RBatchGenerator, DropRemainder)
+{
+   RDataFrame df(1000);
+   auto df2 = df.Define("a", "rdfentry_");
+   RBatchGenerator generator(df2, {"a"}, 64, 200);
+   generator.SetDropRemainder(true);
+
+   std::size_t numEvents = 0;
+   const auto numBatches = generator.ForEachBatch([&](const RTensor<float> &x) {
+      EXPECT_EQ(x.GetShape()[0], 64u);
+      numEvents += x.GetShape()[0];
+   });
+   EXPECT_EQ(numBatches, 15u);
+   EXPECT_EQ(numEvents, 960u);
+}
@@ -2,6 +2,7 @@
 
 #include "BDTHelpers.hxx"
 #include "TMVA/RBDT.hxx"
+#include "RConfigure.h" // R__USE_IMT
 
 #include "ROOT/RVec.hxx"
 
@@ -125,3 +126,34 @@ TEST(RBDT, ColumnMajorInput)
    EXPECT_FLOAT_EQ(y(0, 0), 1.0);
    EXPECT_FLOAT_EQ(y(1, 0), 1.0);
 }
+
+#ifdef R__USE_IMT
+TEST(RBDT, MulticlassBatchMultiThreaded)
+{
+   const auto maxDepth = 1;
+   const auto numInputs = 1;
+   const auto numOutputs = 3;
+   const auto numTrees = 3;
+   WriteModel("myModel", "TestRBDT6.root", "softmax", {0, 0, 0}, {0, 1, 2},
+              {0.0, 1.0, -1.0, 0.0, -1.0, 1.0, 0.0, 2.0, -2.0}, {maxDepth}, {numTrees}, {numInputs}, {numOutputs});
+
+   RBDT<> bdt("myModel", "TestRBDT6.root");
+   const std::size_t rows = 2000;
+   RTensor<float> x({rows, 1});
+   for (std::size_t i = 0; i < rows; i++)
+      x(i, 0) = i % 3 == 0 ? 999.0 : -999.0;
+
+   TMVA::Config::Instance().EnableMT(4);
+   auto y = bdt.Compute(x);
+   TMVA::Config::Instance().DisableMT();
+
+   const auto shape = y.GetShape();
+   EXPECT_EQ(shape[0], rows);
+   EXPECT_EQ(shape[1], 3u);
+   for (std::size_t i = 0; i < rows; i++) {
+      const auto ref = bdt.Compute({x(i, 0)});
+      for (std::size_t j = 0; j < 3; j++)
+         EXPECT_FLOAT_EQ(y(i, j), ref[j]);
+   }
+}
+#endif
@@ -0,0 +1,419 @@
+#include <gtest/gtest.h>
+
+#include "TMVA/RModel.hxx"
+#include "TMVA/RModelParser_ONNX.hxx"
+
+#include "TInterpreter.h"
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace TMVA::Experimental;
+
+using InferFunc_t = void (*)(const float *, float *);
+
+/// Compile the generated code with a function `Infer` running a session of the model
+InferFunc_t CompileModel(const RModel &model, const std::string &nameSpace)
+{
+   const auto code = model.Generate(nameSpace) + "\nnamespace " + nameSpace +
+                     " {\nvoid Infer(const float *x, float *y)\n{\n   static Session s;\n   s.infer(x, y);\n}\n}\n";
+   if (gInterpreter->Declare(code.c_str()) == 0)
+      throw std::runtime_error("Failed to compile the code of the model " + nameSpace);
+   auto ptr = gInterpreter->Calc((nameSpace + "::Infer").c_str());
+   return reinterpret_cast<InferFunc_t>(ptr);
+}
+
+RModelOperator MakeOperator(const std::string &type, const std::vector<std::string> &inputs,
+                            const std::vector<std::string> &outputs)
+{
+   RModelOperator op;
+   op.fType = type;
+   op.fInputs = inputs;
+   op.fOutputs = outputs;
+   return op;
+}
+
+float Sigmoid(float x)
+{
+   return 1.f / (1.f + std::exp(-x));
+}
+
+TEST(RModel, Dense)
+{
+   const std::vector<float> w1 = {0.1, -0.2, 0.3, 0.4, 0.5, -0.6, -0.7, 0.8, 0.9, 1.0, -1.1, 1.2};
+   const std::vector<float> b1 = {0.1, 0.2, -0.3, 0.4};
+   const std::vector<float> w2 = {1.0, -1.0, 0.5, 0.25, -0.5, 2.0, 0.75, -0.25};
+   const std::vector<float> b2 = {0.5, -0.5};
+
+   RModel model;
+   model.AddInput("x", {2, 3});
+   model.AddInitializedTensor("w1", {4, 3}, w1);
+   model.AddInitializedTensor("b1", {4}, b1);
+   model.AddInitializedTensor("w2", {4, 2}, w2);
+   model.AddInitializedTensor("b2", {2}, b2);
+   auto gemm = MakeOperator("Gemm", {"x", "w1", "b1"}, {"h"});
+   gemm.fAttributes["transB"].fInt = 1;
+   model.AddOperator(gemm);
+   model.AddOperator(MakeOperator("Relu", {"h"}, {"r"}));
+   model.AddOperator(MakeOperator("MatMul", {"r", "w2"}, {"m"}));
+   model.AddOperator(MakeOperator("Add", {"m", "b2"}, {"z"}));
+   model.AddOperator(MakeOperator("Softmax", {"z"}, {"y"}));
+   model.AddOutput("y");
+
+   auto infer = CompileModel(model, "RModelDense");
+   const float x[6] = {1.0, 2.0, 3.0, -1.0, 0.5, 2.0};
+   float y[4];
+   infer(x, y);
+
+   for (int n = 0; n < 2; n++) {
+      float r[4];
+      for (int i = 0; i < 4; i++) {
+         r[i] = b1[i];
+         for (int j = 0; j < 3; j++)
+            r[i] += x[n * 3 + j] * w1[i * 3 + j];
+         r[i] = std::max(r[i], 0.f);
+      }
+      float z[2];
+      for (int i = 0; i < 2; i++) {
+         z[i] = b2[i];
+         for (int j = 0; j < 4; j++)
+            z[i] += r[j] * w2[j * 2 + i];
+      }
+      const float s = std::exp(z[0]) + std::exp(z[1]);
+      EXPECT_FLOAT_EQ(y[n * 2], std::exp(z[0]) / s);
+      EXPECT_FLOAT_EQ(y[n * 2 + 1], std::exp(z[1]) / s);
+   }
+}
+
+TEST(RModel, Convolution)
+{
+   // Two groups of two filters, on an input with two channels of 5x5 pixels
+   const int channels = 2, size = 5, filters = 4, kernel = 3, stride = 2, pad = 1;
+   const int outSize = (size + 2 * pad - kernel) / stride + 1;
+   std::vector<float> w(filters * kernel * kernel);
+   for (std::size_t i = 0; i < w.size(); i++)
+      w[i] = 0.1 * (static_cast<int>(i % 7) - 3);
+   const std::vector<float> b = {0.1, -0.1, 0.2, -0.2};
+   const std::vector<float> scale = {1.0, 2.0, 0.5, 1.5};
+   const std::vector<float> bias = {0.0, 0.1, -0.1, 0.2};
+   const std::vector<float> mean = {0.1, 0.0, -0.2, 0.3};
+   const std::vector<float> var = {1.0, 0.5, 2.0, 0.25};
+
+   RModel model;
+   model.AddInput("x", {1, channels, size, size});
+   model.AddInitializedTensor("w", {filters, 1, kernel, kernel}, w);
+   model.AddInitializedTensor("b", {filters}, b);
+   model.AddInitializedTensor("scale", {filters}, scale);
+   model.AddInitializedTensor("bias", {filters}, bias);
+   model.AddInitializedTensor("mean", {filters}, mean);
+   model.AddInitializedTensor("var", {filters}, var);
+   auto conv = MakeOperator("Conv", {"x", "w", "b"}, {"c"});
+   conv.fAttributes["group"].fInt = 2;
+   conv.fAttributes["strides"].fInts = {stride, stride};
+   conv.fAttributes["pads"].fInts = {pad, pad, pad, pad};
+   model.AddOperator(conv);
+   model.AddOperator(MakeOperator("BatchNormalization", {"c", "scale", "bias", "mean", "var"}, {"n"}));
+   model.AddOperator(MakeOperator("Flatten", {"n"}, {"y"}));
+   model.AddOutput("y");
+
+   auto infer = CompileModel(model, "RModelConvolution");
+   std::vector<float> x(channels * size * size);
+   for (std::size_t i = 0; i < x.size(); i++)
+      x[i] = std::sin(0.3 * i);
+   std::vector<float> y(filters * outSize * outSize);
+   infer(x.data(), y.data());
+
+   for (int m = 0; m < filters; m++) {
+      const int c = m / 2; // channel of the group of the filter
+      for (int oh = 0; oh < outSize; oh++) {
+         for (int ow = 0; ow < outSize; ow++) {
+            float sum = b[m];
+            for (int kh = 0; kh < kernel; kh++) {
+               for (int kw = 0; kw < kernel; kw++) {
+                  const int h = oh * stride - pad + kh;
+                  const int v = ow * stride - pad + kw;
+                  if (h >= 0 && h < size && v >= 0 && v < size)
+                     sum += w[(m * kernel + kh) * kernel + kw] * x[(c * size + h) * size + v];
+               }
+            }
+            const float ref = scale[m] * (sum - mean[m]) / std::sqrt(var[m] + 1e-5f) + bias[m];
+            EXPECT_NEAR(y[(m * outSize + oh) * outSize + ow], ref, 1e-5);
+         }
+      }
+   }
+}
+
+TEST(RModel, LSTM)
+{
+   const int seqLength = 3, batch = 2, inputSize = 2, hidden = 3;
+   std::vector<float> w(4 * hidden * inputSize), r(4 * hidden * hidden), b(8 * hidden);
+   for (std::size_t i = 0; i < w.size(); i++)
+      w[i] = 0.1 * std::cos(1. * i);
+   for (std::size_t i = 0; i < r.size(); i++)
+      r[i] = 0.2 * std::sin(1. * i);
+   for (std::size_t i = 0; i < b.size(); i++)
+      b[i] = 0.05 * (static_cast<int>(i % 5) - 2);
+
+   RModel model;
+   model.AddInput("x", {seqLength, batch, inputSize});
+   model.AddInitializedTensor("w", {1, 4 * hidden, inputSize}, w);
+   model.AddInitializedTensor("r", {1, 4 * hidden, hidden}, r);
+   model.AddInitializedTensor("b", {1, 8 * hidden}, b);
+   auto lstm = MakeOperator("LSTM", {"x", "w", "r", "b"}, {"", "y"});
+   lstm.fAttributes["hidden_size"].fInt = hidden;
+   model.AddOperator(lstm);
+   model.AddOutput("y");
+
+   auto infer = CompileModel(model, "RModelLSTM");
+   std::vector<float> x(seqLength * batch * inputSize);
+   for (std::size_t i = 0; i < x.size(); i++)
+      x[i] = std::sin(0.7 * i);
+   std::vector<float> y(batch * hidden);
+   infer(x.data(), y.data());
+
+   // Gates in the order input, output, forget, cell
+   std::vector<float> h(batch * hidden, 0.), c(batch * hidden, 0.);
+   for (int t = 0; t < seqLength; t++) {
+      std::vector<float> hNew(h.size());
+      for (int n = 0; n < batch; n++) {
+         float g[4 * hidden];
+         for (int k = 0; k < 4 * hidden; k++) {
+            g[k] = b[k] + b[4 * hidden + k];
+            for (int j = 0; j < inputSize; j++)
+               g[k] += w[k * inputSize + j] * x[(t * batch + n) * inputSize + j];
+            for (int j = 0; j < hidden; j++)
+               g[k] += r[k * hidden + j] * h[n * hidden + j];
+         }
+         for (int j = 0; j < hidden; j++) {
+            auto &cell = c[n * hidden + j];
+            cell = Sigmoid(g[2 * hidden + j]) * cell + Sigmoid(g[j]) * std::tanh(g[3 * hidden + j]);
+            hNew[n * hidden + j] = Sigmoid(g[hidden + j]) * std::tanh(cell);
+         }
+      }
+      h = hNew;
+   }
+   for (std::size_t i = 0; i < h.size(); i++)
+      EXPECT_NEAR(y[i], h[i], 1e-6);
+}
+
+void TestGRU(bool linearBeforeReset, const std::string &nameSpace)
+{
+   const int seqLength = 3, batch = 2, inputSize = 2, hidden = 3;
+   std::vector<float> w(3 * hidden * inputSize), r(3 * hidden * hidden), b(6 * hidden);
+   for (std::size_t i = 0; i < w.size(); i++)
+      w[i] = 0.3 * std::cos(1. * i);
+   for (std::size_t i = 0; i < r.size(); i++)
+      r[i] = 0.2 * std::sin(1. * i);
+   for (std::size_t i = 0; i < b.size(); i++)
+      b[i] = 0.05 * (static_cast<int>(i % 5) - 2);
+
+   RModel model;
+   model.AddInput("x", {seqLength, batch, inputSize});
+   model.AddInitializedTensor("w", {1, 3 * hidden, inputSize}, w);
+   model.AddInitializedTensor("r", {1, 3 * hidden, hidden}, r);
+   model.AddInitializedTensor("b", {1, 6 * hidden}, b);
+   auto gru = MakeOperator("GRU", {"x", "w", "r", "b"}, {"y"});
+   gru.fAttributes["hidden_size"].fInt = hidden;
+   gru.fAttributes["linear_before_reset"].fInt = linearBeforeReset;
+   model.AddOperator(gru);
+   model.AddOutput("y");
+
+   auto infer = CompileModel(model, nameSpace);
+   std::vector<float> x(seqLength * batch * inputSize);
+   for (std::size_t i = 0; i < x.size(); i++)
+      x[i] = std::sin(0.7 * i);
+   std::vector<float> y(seqLength * batch * hidden);
+   infer(x.data(), y.data());
+
+   // Gates in the order update, reset, hidden
+   std::vector<float> h(batch * hidden, 0.);
+   for (int t = 0; t < seqLength; t++) {
+      std::vector<float> hNew(h.size());
+      for (int n = 0; n < batch; n++) {
+         const float *xt = &x[(t * batch + n) * inputSize];
+         const float *ht = &h[n * hidden];
+         float gx[3 * hidden], gh[3 * hidden];
+         for (int k = 0; k < 3 * hidden; k++) {
+            gx[k] = b[k];
+            gh[k] = b[3 * hidden + k];
+            for (int j = 0; j < inputSize; j++)
+               gx[k] += w[k * inputSize + j] * xt[j];
+            for (int j = 0; j < hidden; j++)
+               gh[k] += r[k * hidden + j] * ht[j];
+         }
+         float reset[hidden];
+         for (int j = 0; j < hidden; j++)
+            reset[j] = Sigmoid(gx[hidden + j] + gh[hidden + j]);
+         for (int j = 0; j < hidden; j++) {
+            const float z = Sigmoid(gx[j] + gh[j]);
+            float candidate;
+            if (linearBeforeReset) {
+               candidate = std::tanh(gx[2 * hidden + j] + reset[j] * gh[2 * hidden + j]);
+            } else {
+               float sum = b[5 * hidden + j];
+               for (int k = 0; k < hidden; k++)
+                  sum += r[(2 * hidden + j) * hidden + k] * reset[k] * ht[k];
+               candidate = std::tanh(gx[2 * hidden + j] + sum);
+            }
+            hNew[n * hidden + j] = (1 - z) * candidate + z * ht[j];
+         }
+      }
+      h = hNew;
+      for (std::size_t i = 0; i < h.size(); i++)
+         EXPECT_NEAR(y[t * batch * hidden + i], h[i], 1e-6);
+   }
+}
+
+TEST(RModel, GRU)
+{
+   TestGRU(false, "RModelGRU");
+}
+
+TEST(RModel, GRULinearBeforeReset)
+{
+   TestGRU(true, "RModelGRULinearBeforeReset");
+}
+
+TEST(RModel, UnsupportedOperator)
+{
+   RModel model;
+   model.AddInput("x", {1, 4});
+   model.AddOperator(MakeOperator("Foo", {"x"}, {"y"}));
+   model.AddOutput("y");
+   EXPECT_THROW(model.Generate("RModelUnsupported"), std::runtime_error);
+}
+
+/// Writer of the protobuf messages of an ONNX model
+class ProtoWriter {
+   std::string fData;
+
+   void Varint(std::uint64_t value)
+   {
+      while (value >= 0x80) {
+         fData += static_cast<char>((value & 0x7f) | 0x80);
+         value >>= 7;
+      }
+      fData += static_cast<char>(value);
+   }
+
+   void Key(int field, int wireType) { Varint(static_cast<std::uint64_t>(field) << 3 | wireType); }
+
+public:
+   const std::string &Data() const { return fData; }
+
+   ProtoWriter &Int(int field, std::int64_t value)
+   {
+      Key(field, 0);
+      Varint(static_cast<std::uint64_t>(value));
+      return *this;
+   }
+
+   ProtoWriter &Bytes(int field, const std::string &value)
+   {
+      Key(field, 2);
+      Varint(value.size());
+      fData += value;
+      return *this;
+   }
+
+   ProtoWriter &Message(int field, const ProtoWriter &message) { return Bytes(field, message.Data()); }
+
+   ProtoWriter &PackedFloats(int field, const std::vector<float> &values)
+   {
+      return Bytes(field, std::string(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(float)));
+   }
+};
+
+ProtoWriter FloatTensor(const std::string &name, const std::vector<std::int64_t> &dims, const std::vector<float> &values,
+                        bool raw)
+{
+   ProtoWriter tensor;
+   for (auto d : dims)
+      tensor.Int(1, d);
+   tensor.Int(2, 1).Bytes(8, name);
+   if (raw)
+      tensor.PackedFloats(9, values);
+   else
+      tensor.PackedFloats(4, values);
+   return tensor;
+}
+
+ProtoWriter ValueInfo(const std::string &name, const std::vector<std::int64_t> &dims)
+{
+   ProtoWriter shape;
+   for (auto d : dims) {
+      ProtoWriter dim;
+      if (d < 0)
+         dim.Bytes(2, "batch");
+      else
+         dim.Int(1, d);
+      shape.Message(1, dim);
+   }
+   ProtoWriter tensorType;
+   tensorType.Int(1, 1).Message(2, shape);
+   ProtoWriter type;
+   type.Message(1, tensorType);
+   ProtoWriter info;
+   info.Bytes(1, name).Message(2, type);
+   return info;
+}
+
+TEST(RModelParser_ONNX, Dense)
+{
+   const std::vector<float> w = {0.5, -1.0, 1.5, 2.0, -0.5, 0.25};
+   const std::vector<float> b = {0.1, -0.2};
+
+   ProtoWriter gemm;
+   ProtoWriter transB;
+   transB.Bytes(1, "transB").Int(3, 1).Int(20, 2);
+   gemm.Bytes(1, "input").Bytes(1, "w").Bytes(1, "b").Bytes(2, "hidden").Bytes(4, "Gemm").Message(5, transB);
+   ProtoWriter relu;
+   relu.Bytes(1, "hidden").Bytes(2, "output").Bytes(4, "Relu");
+
+   ProtoWriter graph;
+   graph.Message(1, gemm)
+      .Message(1, relu)
+      .Bytes(2, "dense")
+      .Message(5, FloatTensor("w", {2, 3}, w, true))
+      .Message(5, FloatTensor("b", {2}, b, false))
+      .Message(11, ValueInfo("input", {-1, 3}))
+      .Message(11, ValueInfo("w", {2, 3}))
+      .Message(12, ValueInfo("output", {-1, 2}));
+   ProtoWriter opset;
+   opset.Bytes(1, "").Int(2, 11);
+   ProtoWriter onnxModel;
+   onnxModel.Int(1, 6).Message(7, graph).Message(8, opset);
+
+   const auto model = RModelParser_ONNX::ParseBuffer(onnxModel.Data(), 2);
+   EXPECT_EQ(model.GetOpsetVersion(), 11);
+   ASSERT_EQ(model.GetInputNames(), std::vector<std::string>({"input"}));
+   EXPECT_EQ(model.GetInputShape("input"), std::vector<std::size_t>({2, 3}));
+   EXPECT_EQ(model.GetOutputNames(), std::vector<std::string>({"output"}));
+   ASSERT_EQ(model.GetOperators().size(), 2u);
+   EXPECT_EQ(model.GetOperators()[0].fType, "Gemm");
+   EXPECT_EQ(model.GetOperators()[0].GetInt("transB", 0), 1);
+   EXPECT_EQ(model.GetInitializedTensor("w").fData, w);
+   EXPECT_EQ(model.GetInitializedTensor("b").fData, b);
+
+   auto infer = CompileModel(model, "RModelParserDense");
+   const float x[6] = {1.0, 2.0, 3.0, -3.0, 0.5, 1.0};
+   float y[4];
+   infer(x, y);
+   for (int n = 0; n < 2; n++) {
+      for (int i = 0; i < 2; i++) {
+         float sum = b[i];
+         for (int j = 0; j < 3; j++)
+            sum += w[i * 3 + j] * x[n * 3 + j];
+         EXPECT_FLOAT_EQ(y[n * 2 + i], std::max(sum, 0.f));
+      }
+   }
+}
+
+TEST(RModelParser_ONNX, InvalidData)
+{
+   EXPECT_THROW(RModelParser_ONNX::ParseBuffer(std::string("\x3a\x10\x00", 3)), std::runtime_error);
+   EXPECT_THROW(RModelParser_ONNX::Parse("RModelParserMissingFile.onnx"), std::runtime_error);
+}
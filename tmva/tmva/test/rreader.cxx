@@ -3,6 +3,7 @@
 #include <TFile.h>
 #include <TTree.h>
 #include <TSystem.h>
+#include <RConfigure.h>
 #include <TMVA/Factory.h>
 #include <TMVA/DataLoader.h>
 
@@ -281,3 +282,25 @@ TEST(RReader, MulticlassComputeDataFrame)
    auto y = df2.Take<std::vector<float>>("y");
    EXPECT_EQ(y->size(), *c);
 }
+
+#ifdef R__USE_IMT
+TEST(RReader, MulticlassEvaluateBatchMultiThreaded)
+{
+   TrainMulticlassModel();
+   ROOT::RDataFrame df("TreeS", filenameMulticlass);
+   auto x = AsTensor<float>(df, variablesMulticlass);
+   const auto numEntries = x.GetShape()[0];
+
+   const RReader model(modelMulticlass);
+   TMVA::Config::Instance().EnableMT(4);
+   auto y = model.EvaluateBatch(x);
+   TMVA::Config::Instance().DisableMT();
+
+   EXPECT_EQ(y.GetShape()[0], numEntries);
+   for (std::size_t i = 0; i < numEntries; i++) {
+      const auto p = model.Compute({x(i, 0), x(i, 1), x(i, 2), x(i, 3)});
+      for (std::size_t k = 0; k < 4; k++)
+         EXPECT_FLOAT_EQ(y(i, k), p[k]);
+   }
+}
+#endif
@@ -351,3 +351,57 @@ TEST(RTensor, SliceColumnMajor)
       }
    }
 }
+
+TEST(RTensor, TransposeKeepsOriginal)
+{
+   RTensor<float> x({2, 3});
+   auto x2 = x.Transpose();
+   EXPECT_EQ(x.GetMemoryLayout(), MemoryLayout::RowMajor);
+   EXPECT_EQ(x2.GetMemoryLayout(), MemoryLayout::ColumnMajor);
+   EXPECT_EQ(x2.GetData(), x.GetData());
+   x(1, 2) = 42.f;
+   EXPECT_EQ(x2(2, 1), 42.f);
+   EXPECT_TRUE(x.IsContiguous());
+   EXPECT_TRUE(x2.IsContiguous());
+}
+
+TEST(RTensor, SliceWithStep)
+{
+   // Data layout:
+   // [ [ 0, 1, 2, 3 ], [ 4, 5, 6, 7 ], [ 8, 9, 10, 11 ] ]
+   RTensor<float> x({3, 4});
+   float c = 0.f;
+   for (auto i = 0; i < 3; i++) {
+      for (auto j = 0; j < 4; j++) {
+         x(i, j) = c;
+         c++;
+      }
+   }
+
+   // Slice:
+   // [ [ 1, 3 ], [ 9, 11 ] ]
+   auto s1 = x.Slice({{0, 3, 2}, {1, 4, 2}});
+   EXPECT_EQ(s1.GetSize(), 4u);
+   EXPECT_EQ(s1.GetShape()[0], 2u);
+   EXPECT_EQ(s1.GetShape()[1], 2u);
+   EXPECT_EQ(s1(0, 0), 1.f);
+   EXPECT_EQ(s1(0, 1), 3.f);
+   EXPECT_EQ(s1(1, 0), 9.f);
+   EXPECT_EQ(s1(1, 1), 11.f);
+   EXPECT_FALSE(s1.IsContiguous());
+
+   // The slice is a view on the same memory
+   s1(1, 1) = -1.f;
+   EXPECT_EQ(x(2, 3), -1.f);
+
+   // Copy makes a contiguous tensor, which can be reshaped
+   EXPECT_THROW(s1.Reshape({4}), std::runtime_error);
+   auto s2 = s1.Copy().Reshape({4});
+   EXPECT_TRUE(s2.IsContiguous());
+   EXPECT_EQ(s2(3), -1.f);
+
+   // Invalid slices
+   EXPECT_THROW(x.Slice({{0, 4}, {0, 4}}), std::runtime_error);
+   EXPECT_THROW(x.Slice({{0, 3, 0}, {0, 4}}), std::runtime_error);
+   EXPECT_THROW(x.Slice({{0}, {0, 4}}), std::runtime_error);
+}
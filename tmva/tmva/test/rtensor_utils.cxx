@@ -47,3 +47,17 @@ TEST(RTensor, AsTensorColumnMajor)
       EXPECT_EQ(x(i, 1), -1.f * i);
    }
 }
+
+TEST(RTensor, AsTensorSingleColumn)
+{
+   RDataFrame df(10);
+   auto df2 = df.Define("a", "1.f * rdfentry_");
+   auto x = AsTensor<float>(df2, {"a"});
+   EXPECT_TRUE(x.IsOwner());
+   EXPECT_EQ(x.GetShape().size(), 2u);
+   EXPECT_EQ(x.GetShape()[0], 10u);
+   EXPECT_EQ(x.GetShape()[1], 1u);
+   for (size_t i = 0; i < 10; i++) {
+      EXPECT_EQ(x(i, 0), 1.f * i);
+   }
+}
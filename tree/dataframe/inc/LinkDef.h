@@ -37,6 +37,8 @@
 #pragma link C++ class ROOT::RDF::RTrivialDS-;
 #pragma link C++ class ROOT::Internal::RDF::RRootDS-;
 #pragma link C++ class ROOT::RDF::RCsvDS-;
+#pragma link C++ class ROOT::RDF::RSqlDS-;
+#pragma link C++ class ROOT::RDF::RArrowBatches-;
 #pragma link C++ class ROOT::Internal::RDF::MeanHelper-;
 #pragma link C++ class ROOT::Internal::RDF::RColumnValue<int>-;
 #pragma link C++ class ROOT::Internal::RDF::RColumnValue<unsigned int>-;
@@ -15,8 +15,8 @@
 #include "ROOT/RDataSource.hxx"
 
 #include <deque>
-#include <list>
 #include <map>
+#include <utility>
 #include <vector>
 #include <fstream>
 
@@ -39,13 +39,16 @@ private:
    std::ifstream fStream;
    const char fDelimiter;
    const Long64_t fLinesChunkSize;
-   ULong64_t fEntryRangesRequested = 0ULL;
    ULong64_t fProcessedLines = 0ULL; // marks the progress of the consumption of the csv lines
+   ULong64_t fChunkFirstEntry = 0ULL; // entry number of the first line of the current chunk
    std::vector<std::string> fHeaders;
    std::map<std::string, ColType_t> fColTypes;
-   std::list<ColType_t> fColTypesList;
+   std::vector<ColType_t> fColTypesList;
    std::vector<std::vector<void *>> fColAddresses;         // fColAddresses[column][slot]
-   std::vector<Record_t> fRecords;                         // fRecords[entry][column]
+   std::string fChunk;     // raw content of the lines of the current chunk, parsed in SetEntry
+   std::string fLeftover;  // bytes read from the file after the end of the current chunk
+   std::vector<std::pair<std::size_t, std::size_t>> fLines; // offset and length in fChunk of each line of the chunk
+   std::vector<std::vector<std::string>> fSlotColumns;      // fields of the entry being parsed, one per slot
    std::vector<std::vector<double>> fDoubleEvtValues;      // one per column per slot
    std::vector<std::vector<Long64_t>> fLong64EvtValues;    // one per column per slot
    std::vector<std::vector<std::string>> fStringEvtValues; // one per column per slot
@@ -56,13 +59,14 @@ private:
    static TRegexp intRegex, doubleRegex1, doubleRegex2, doubleRegex3, trueRegex, falseRegex;
 
    void FillHeaders(const std::string &);
-   void FillRecord(const std::string &, Record_t &);
    void GenerateHeaders(size_t);
    std::vector<void *> GetColumnReadersImpl(std::string_view, const std::type_info &);
    void InferColTypes(std::vector<std::string> &);
-   void InferType(const std::string &, unsigned int);
-   std::vector<std::string> ParseColumns(const std::string &);
-   size_t ParseValue(const std::string &, std::vector<std::string> &, size_t);
+   ColType_t InferType(const std::string &) const;
+   std::vector<std::string> ParseColumns(std::string_view);
+   void ParseColumns(std::string_view, std::vector<std::string> &);
+   size_t ParseValue(std::string_view, std::string &, size_t);
+   void ReadChunk();
    ColType_t GetType(std::string_view colName) const;
 
 protected:
@@ -88,6 +92,7 @@ public:
 /// \param[in] readHeaders `true` if the CSV file contains headers as first row, `false` otherwise
 ///                        (default `true`).
 /// \param[in] delimiter Delimiter character (default ',').
+/// \param[in] linesChunkSize Maximum number of lines read from the file at a time, -1 for no limit (default -1).
 RDataFrame MakeCsvDataFrame(std::string_view fileName, bool readHeaders = true, char delimiter = ',',
                             Long64_t linesChunkSize = -1LL);
 
@@ -24,6 +24,7 @@
 #include "ROOT/RStringView.hxx"
 #include "ROOT/RVec.hxx"
 #include "ROOT/TBufferMerger.hxx" // for SnapshotHelper
+#include "ROOT/RDF/RArrowBatches.hxx"
 #include "ROOT/RDF/RCutFlowReport.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RMakeUnique.hxx"
@@ -45,6 +46,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <map>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -52,6 +54,7 @@
 #include <vector>
 #include <iomanip>
 #include <numeric> // std::accumulate in MeanHelper
+#include <tuple>
 
 /// \cond HIDDEN_SYMBOLS
 
@@ -125,6 +128,57 @@ public:
    std::string GetActionName() { return "ForeachSlot"; }
 };
 
+/// Calls the callable on the entries in their order. In multi-thread event loops, the values of the entries of a task
+/// are copied and the callable is called on them at the end of the task, which ordered actions end in the order of
+/// their entries.
+template <typename F, typename ColumnTypes = typename CallableTraits<F>::arg_types>
+class ForeachOrderedHelper;
+
+template <typename F, typename... ColTypes>
+class ForeachOrderedHelper<F, TypeList<ColTypes...>>
+   : public RActionImpl<ForeachOrderedHelper<F, TypeList<ColTypes...>>> {
+   F fCallable;
+   std::vector<std::vector<std::tuple<ColTypes...>>> fEntries; ///< The entries of the current task of each slot
+
+   template <std::size_t... S>
+   void Call(std::tuple<ColTypes...> &entry, std::index_sequence<S...>)
+   {
+      fCallable(std::get<S>(entry)...);
+   }
+
+public:
+   using ColumnTypes_t = TypeList<ColTypes...>;
+   ForeachOrderedHelper(F &&f, unsigned int nSlots) : fCallable(f), fEntries(nSlots) {}
+   ForeachOrderedHelper(ForeachOrderedHelper &&) = default;
+   ForeachOrderedHelper(const ForeachOrderedHelper &) = delete;
+
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   template <typename... Args>
+   void Exec(unsigned int slot, Args &&... args)
+   {
+      static_assert(std::is_same<TypeList<typename std::decay<Args>::type...>, ColumnTypes_t>::value, "");
+      // sequential event loops process the entries in order
+      if (fEntries.size() == 1)
+         fCallable(std::forward<Args>(args)...);
+      else
+         fEntries[slot].emplace_back(args...);
+   }
+
+   void FinalizeTask(unsigned int slot)
+   {
+      for (auto &entry : fEntries[slot])
+         Call(entry, std::index_sequence_for<ColTypes...>());
+      fEntries[slot].clear();
+   }
+
+   void Initialize() { /* noop */}
+
+   void Finalize() { /* noop */}
+
+   std::string GetActionName() { return "ForeachOrdered"; }
+};
+
 class CountHelper : public RActionImpl<CountHelper> {
    const std::shared_ptr<ULong64_t> fResultCount;
    Results<ULong64_t> fCounts;
@@ -182,6 +236,8 @@ public:
 class FillHelper : public RActionImpl<FillHelper> {
    // this sets a total initial size of 16 MB for the buffers (can increase)
    static constexpr unsigned int fgTotalBufSize = 2097152;
+   /// Minimum total number of buffered values for which the buffers are emptied in parallel, see Finalize().
+   static constexpr std::size_t fgMinParallelFill = 1 << 18;
    using BufEl_t = double;
    using Buf_t = std::vector<BufEl_t>;
 
@@ -284,7 +340,61 @@ FillHelper::Exec(unsigned int, const std::vector<unsigned int> &, const std::vec
 
 template <typename HIST = Hist_t>
 class FillParHelper : public RActionImpl<FillParHelper<HIST>> {
+   /// Number of values of unweighted 1D fills collected per slot before they are passed to TH1::FillN.
+   static constexpr std::size_t fgBatchSize = 1024;
+
    std::vector<HIST *> fObjects;
+   /// Values of unweighted 1D fills not yet passed to the histogram of each slot, see fUseFillN.
+   std::vector<std::vector<double>> fBatches;
+   /// Whether unweighted fills of 1D histograms are done in batches with TH1::FillN.
+   bool fUseFillN = false;
+
+   template <typename H = HIST, typename std::enable_if<std::is_base_of<TH1, H>::value, int>::type = 0>
+   static bool CanUseFillN(const H &h)
+   {
+      // Profiles are 1D histograms but cannot be filled with x values only
+      return h.GetDimension() == 1 && !h.InheritsFrom("TProfile");
+   }
+
+   template <typename H = HIST, typename std::enable_if<!std::is_base_of<TH1, H>::value, int>::type = 0>
+   static bool CanUseFillN(const H &)
+   {
+      return false;
+   }
+
+   template <typename H = HIST, typename std::enable_if<std::is_base_of<TH1, H>::value, int>::type = 0>
+   void FlushBatch(unsigned int slot)
+   {
+      auto &batch = fBatches[slot];
+      if (batch.empty())
+         return;
+      static_cast<TH1 *>(fObjects[slot])->FillN(batch.size(), batch.data(), nullptr);
+      batch.clear();
+   }
+
+   template <typename H = HIST, typename std::enable_if<!std::is_base_of<TH1, H>::value, int>::type = 0>
+   void FlushBatch(unsigned int)
+   {
+   }
+
+   template <typename T, typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+   void Fill1D(unsigned int slot, const T &x0)
+   {
+      if (!fUseFillN) {
+         fObjects[slot]->Fill(x0);
+         return;
+      }
+      auto &batch = fBatches[slot];
+      batch.emplace_back(x0);
+      if (batch.size() == fgBatchSize)
+         FlushBatch(slot);
+   }
+
+   template <typename T, typename std::enable_if<!std::is_arithmetic<T>::value, int>::type = 0>
+   void Fill1D(unsigned int slot, const T &x0)
+   {
+      fObjects[slot]->Fill(x0);
+   }
 
 public:
    FillParHelper(FillParHelper &&) = default;
@@ -300,13 +410,19 @@ public:
             objAsHist->SetDirectory(nullptr);
          }
       }
+      fUseFillN = CanUseFillN(*fObjects[0]);
+      if (fUseFillN) {
+         fBatches.resize(nSlots);
+         for (auto &batch : fBatches)
+            batch.reserve(fgBatchSize);
+      }
    }
 
    void InitTask(TTreeReader *, unsigned int) {}
 
    void Exec(unsigned int slot, double x0) // 1D histos
    {
-      fObjects[slot]->Fill(x0);
+      Fill1D(slot, x0);
    }
 
    void Exec(unsigned int slot, double x0, double x1) // 1D weighted and 2D histos
@@ -327,9 +443,8 @@ public:
    template <typename X0, typename std::enable_if<IsDataContainer<X0>::value || std::is_same<X0, std::string>::value, int>::type = 0>
    void Exec(unsigned int slot, const X0 &x0s)
    {
-      auto thisSlotH = fObjects[slot];
       for (auto &x0 : x0s) {
-         thisSlotH->Fill(x0); // TODO: Can be optimised in case T == vector<double>
+         Fill1D(slot, x0);
       }
    }
 
@@ -444,6 +559,12 @@ public:
 
    void Initialize() { /* noop */}
 
+   void FinalizeTask(unsigned int slot)
+   {
+      if (fUseFillN)
+         FlushBatch(slot);
+   }
+
    void Finalize()
    {
       auto resObj = fObjects[0];
@@ -457,7 +578,12 @@ public:
       resObj->Merge(&l);
    }
 
-   HIST &PartialUpdate(unsigned int slot) { return *fObjects[slot]; }
+   HIST &PartialUpdate(unsigned int slot)
+   {
+      if (fUseFillN)
+         FlushBatch(slot);
+      return *fObjects[slot];
+   }
 
    // Helper functions for RMergeableValue
    std::unique_ptr<RMergeableValueBase> GetMergeableValue() const final
@@ -468,6 +594,43 @@ public:
    std::string GetActionName() { return "FillPar"; }
 };
 
+/// Fill one histogram per variation of a column varied with RInterface::Vary, plus the nominal one.
+class VariedHisto1DHelper : public RActionImpl<VariedHisto1DHelper> {
+public:
+   using Result_t = std::map<std::string, ::TH1D>;
+
+private:
+   std::shared_ptr<Result_t> fResult;
+   std::vector<std::string> fTags; ///< Variation tags, in the order of the elements of the varied values
+   /// Histograms of each slot: the nominal one first, then one per variation tag
+   std::vector<std::vector<std::unique_ptr<::TH1D>>> fHistos;
+
+   [[noreturn]] void ThrowSizeMismatch(std::size_t size) const;
+
+public:
+   VariedHisto1DHelper(const ::TH1D &model, const std::vector<std::string> &tags, const unsigned int nSlots);
+   VariedHisto1DHelper(VariedHisto1DHelper &&) = default;
+   VariedHisto1DHelper(const VariedHisto1DHelper &) = delete;
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   template <typename T>
+   void Exec(unsigned int slot, const T &nominal, const RVec<T> &varied)
+   {
+      if (varied.size() != fTags.size())
+         ThrowSizeMismatch(varied.size());
+      auto &histos = fHistos[slot];
+      histos[0]->Fill(nominal);
+      for (std::size_t i = 0; i < varied.size(); ++i)
+         histos[i + 1]->Fill(varied[i]);
+   }
+
+   void Initialize() { /* noop */}
+   void Finalize();
+   std::shared_ptr<Result_t> GetResultPtr() const { return fResult; }
+
+   std::string GetActionName() { return "VariedHisto1D"; }
+};
+
 class FillTGraphHelper : public ROOT::Detail::RDF::RActionImpl<FillTGraphHelper> {
 public:
    using Result_t = ::TGraph;
@@ -750,6 +913,67 @@ extern template class TakeHelper<float, float, std::vector<float>>;
 extern template class TakeHelper<double, double, std::vector<double>>;
 #endif
 
+/// Fill the columns of one Arrow record batch per slot, see RInterface::ToArrow
+template <typename... ColTypes>
+class ArrowBatchesHelper : public RActionImpl<ArrowBatchesHelper<ColTypes...>> {
+   using Columns_t = std::tuple<RArrowColumn<ColTypes>...>;
+   std::shared_ptr<RArrowBatches> fBatches;
+   std::vector<Columns_t> fColumns; ///< One set of columns per slot
+   std::vector<ULong64_t> fNEntries;
+
+   template <std::size_t... S>
+   void PushValues(Columns_t &columns, std::index_sequence<S...>, const ColTypes &... values)
+   {
+      int expander[] = {(std::get<S>(columns).Push(values), 0)..., 0};
+      (void)expander;
+   }
+
+   template <std::size_t... S>
+   RArrowBatches::Columns_t MoveColumns(Columns_t &columns, std::index_sequence<S...>)
+   {
+      RArrowBatches::Columns_t batchColumns;
+      int expander[] = {
+         (batchColumns.emplace_back(std::make_unique<RArrowColumn<ColTypes>>(std::move(std::get<S>(columns)))), 0)...,
+         0};
+      (void)expander;
+      return batchColumns;
+   }
+
+public:
+   using ColumnTypes_t = TypeList<ColTypes...>;
+   ArrowBatchesHelper(const std::shared_ptr<RArrowBatches> &batches, const ColumnNames_t &columnNames,
+                      const unsigned int nSlots)
+      : fBatches(batches), fColumns(nSlots), fNEntries(nSlots, 0ull)
+   {
+      fBatches->SetColumnNames(columnNames);
+   }
+   ArrowBatchesHelper(ArrowBatchesHelper &&) = default;
+   ArrowBatchesHelper(const ArrowBatchesHelper &) = delete;
+
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   void Exec(unsigned int slot, const ColTypes &... values)
+   {
+      PushValues(fColumns[slot], std::index_sequence_for<ColTypes...>(), values...);
+      ++fNEntries[slot];
+   }
+
+   void Initialize() { /* noop */}
+
+   // the buffers filled by each slot become a batch: they are moved, not copied
+   void Finalize()
+   {
+      for (auto slot = 0u; slot < fColumns.size(); ++slot) {
+         const auto isLastWithoutBatches = slot + 1 == fColumns.size() && fBatches->GetNBatches() == 0;
+         if (fNEntries[slot] == 0 && !isLastWithoutBatches)
+            continue;
+         fBatches->AddBatch(fNEntries[slot], MoveColumns(fColumns[slot], std::index_sequence_for<ColTypes...>()));
+      }
+   }
+
+   std::string GetActionName() { return "ToArrow"; }
+};
+
 
 template <typename ResultType>
 class MinHelper : public RActionImpl<MinHelper<ResultType>> {
@@ -1217,6 +1441,13 @@ inline void UpdateBoolArray(BoolArrayMap &boolArrays, RVec<bool> &v, const std::
 
 void ValidateSnapshotOutput(const RSnapshotOptions &opts, const std::string &treeName, const std::string &fileName);
 
+/// Return the name of the file holding the output of processing slot `slot` for RSnapshotOptions::fOutputFilePerSlot
+std::string SnapshotSlotFileName(const std::string &fileName, unsigned int slot);
+
+/// Merge the files written for RSnapshotOptions::fOutputFilePerSlot into the output file and delete them
+void MergeSnapshotSlotFiles(const std::vector<std::string> &slotFileNames, const std::string &fileName,
+                            const RSnapshotOptions &opts);
+
 /// Helper object for a single-thread Snapshot action
 template <typename... BranchTypes>
 class SnapshotHelper : public RActionImpl<SnapshotHelper<BranchTypes...>> {
@@ -1349,6 +1580,8 @@ template <typename... BranchTypes>
 class SnapshotHelperMT : public RActionImpl<SnapshotHelperMT<BranchTypes...>> {
    const unsigned int fNSlots;
    std::unique_ptr<ROOT::Experimental::TBufferMerger> fMerger; // must use a ptr because TBufferMerger is not movable
+   // Per-slot mergers writing to per-slot files, used instead of fMerger if fOptions.fOutputFilePerSlot
+   std::vector<std::unique_ptr<ROOT::Experimental::TBufferMerger>> fSlotMergers;
    std::vector<std::shared_ptr<ROOT::Experimental::TBufferMergerFile>> fOutputFiles;
    std::vector<std::unique_ptr<TTree>> fOutputTrees;
    std::vector<int> fIsFirstEvent;        // vector<bool> does not allow concurrent writing of different elements
@@ -1386,7 +1619,14 @@ public:
       ::TDirectory::TContext c; // do not let tasks change the thread-local gDirectory
       if (!fOutputFiles[slot]) {
          // first time this thread executes something, let's create a TBufferMerger output directory
-         fOutputFiles[slot] = fMerger->GetFile();
+         if (fOptions.fOutputFilePerSlot) {
+            const auto cs = ROOT::CompressionSettings(fOptions.fCompressionAlgorithm, fOptions.fCompressionLevel);
+            fSlotMergers[slot] = std::make_unique<ROOT::Experimental::TBufferMerger>(
+               SnapshotSlotFileName(fFileName, slot).c_str(), "RECREATE", cs);
+            fOutputFiles[slot] = fSlotMergers[slot]->GetFile();
+         } else {
+            fOutputFiles[slot] = fMerger->GetFile();
+         }
       }
       TDirectory *treeDirectory = fOutputFiles[slot].get();
       if (!fDirName.empty()) {
@@ -1435,6 +1675,9 @@ public:
       }
       UpdateBoolArrays(slot, values..., ind_t{});
       fOutputTrees[slot]->Fill();
+      // in ordered mode, the output of a task is written at once when the task ends, see FinalizeTask
+      if (fOptions.fOrdered)
+         return;
       auto entries = fOutputTrees[slot]->GetEntries();
       auto autoFlush = fOutputTrees[slot]->GetAutoFlush();
       if ((autoFlush > 0) && (entries % autoFlush == 0))
@@ -1482,6 +1725,11 @@ public:
 
    void Initialize()
    {
+      if (fOptions.fOutputFilePerSlot) {
+         // the per-slot files are created when the slots are first used
+         fSlotMergers.resize(fNSlots);
+         return;
+      }
       const auto cs = ROOT::CompressionSettings(fOptions.fCompressionAlgorithm, fOptions.fCompressionLevel);
       fMerger = std::make_unique<ROOT::Experimental::TBufferMerger>(fFileName.c_str(), fOptions.fMode.c_str(), cs);
    }
@@ -1504,6 +1752,19 @@ public:
       // flush all buffers to disk by destroying the TBufferMerger
       fOutputFiles.clear();
       fMerger.reset();
+
+      if (fOptions.fOutputFilePerSlot) {
+         std::vector<std::string> slotFileNames;
+         for (unsigned int slot = 0; slot < fSlotMergers.size(); ++slot) {
+            if (fSlotMergers[slot]) {
+               fSlotMergers[slot].reset();
+               slotFileNames.emplace_back(SnapshotSlotFileName(fFileName, slot));
+            }
+         }
+         fSlotMergers.clear();
+         if (fileWritten)
+            MergeSnapshotSlotFiles(slotFileNames, fFileName, fOptions);
+      }
    }
 
    std::string GetActionName() { return "Snapshot"; }
@@ -75,6 +75,12 @@ HeadNode_t CreateSnapshotRDF(const ColumnNames_t &validCols,
                             RLoopManager &loopManager,
                             std::unique_ptr<RDFInternal::RActionBase> actionPtr);
 
+/// Create an empty temporary file for the columns cached on disk by RInterface::Cache and return its name
+std::string CreateCacheFile();
+
+/// Return an upper bound of the number of entries processed by the event loop of `lm`, 0 if unknown
+ULong64_t GetMaxNEntries(RLoopManager &lm);
+
 std::string DemangleTypeIdName(const std::type_info &typeInfo);
 
 ColumnNames_t ConvertRegexToColumns(const RDFInternal::RBookedCustomColumns &customColumns, TTree *tree,
@@ -552,6 +558,9 @@ ColumnNames_t FindUnknownColumns(const ColumnNames_t &requiredCols, const Column
 
 bool IsInternalColumn(std::string_view colName);
 
+/// Return the name of the internal column holding the varied values of a column varied with RInterface::Vary
+std::string VariationsColumnName(std::string_view colName);
+
 /// Returns the list of Filters defined in the whole graph
 std::vector<std::string> GetFilterNames(const std::shared_ptr<RLoopManager> &loopManager);
 
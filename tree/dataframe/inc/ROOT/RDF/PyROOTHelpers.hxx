@@ -69,6 +69,15 @@ ROOT::RDF::RResultPtr<std::vector<T>> RDataFrameTake(ROOT::RDF::RNode df, std::s
    return df.Take<T>(column);
 }
 
+// RDataFrame.AsArrow helpers
+
+// NOTE: The Arrow C data interface structs are allocated by pyarrow, which passes their addresses as integers
+inline void ExportArrowBatch(ROOT::RDF::RArrowBatches &batches, std::size_t batch, ULong64_t arrayAddress,
+                             ULong64_t schemaAddress)
+{
+   batches.Export(batch, reinterpret_cast<ArrowArray *>(arrayAddress), reinterpret_cast<ArrowSchema *>(schemaAddress));
+}
+
 } // namespace RDF
 } // namespace Internal
 } // namespace ROOT
@@ -105,6 +105,7 @@ class RActionCRTP<RAction<Helper, PrevDataFrame, ColumnTypes_t>> : public RActio
    Helper fHelper;
    const std::shared_ptr<PrevDataFrame> fPrevDataPtr;
    PrevDataFrame &fPrevData;
+   ROOT::RDF::RNodeProfile *fProfile = nullptr; ///< Where evaluations are recorded if profiling is enabled, or null
 
 protected:
    /// The nth flag signals whether the nth input column is a custom column or not.
@@ -153,13 +154,30 @@ public:
 
    void Run(unsigned int slot, Long64_t entry) final
    {
+      if (fProfile) {
+         // the time recorded includes the evaluation of the upstream filters
+         const auto start = ROOT::RDF::RNodeProfile::Clock_t::now();
+         const bool passed = fPrevData.CheckFilters(slot, entry);
+         if (passed)
+            static_cast<Action_t *>(this)->Exec(slot, entry, TypeInd_t());
+         fProfile->Add(slot, start, passed);
+         return;
+      }
       // check if entry passes all filters
       if (fPrevData.CheckFilters(slot, entry))
          static_cast<Action_t *>(this)->Exec(slot, entry, TypeInd_t());
    }
 
+   void InitProfile(ROOT::RDF::RProfiler &profiler) final
+   {
+      fProfile = profiler.IsEnabled() ? &profiler.GetNodeProfile(this, fHelper.GetActionName()) : nullptr;
+      GetCustomColumns().InitProfiles(profiler);
+   }
+
    void TriggerChildrenCount() final { fPrevData.IncrChildrenCount(); }
 
+   RNodeBase *GetPrevNode() const final { return fPrevDataPtr.get(); }
+
    void FinalizeSlot(unsigned int slot) final
    {
       ClearValueReaders(slot);
@@ -184,7 +202,8 @@ public:
 
       // Action nodes do not need to ask an helper to create the graph nodes. They are never common nodes between
       // multiple branches
-      auto thisNode = std::make_shared<RDFGraphDrawing::GraphNode>(fHelper.GetActionName());
+      auto thisNode = std::make_shared<RDFGraphDrawing::GraphNode>(
+         fProfile ? fHelper.GetActionName() + "\n" + fProfile->GetSummary() : fHelper.GetActionName());
       auto evaluatedNode = thisNode;
       for (auto &column : GetCustomColumns().GetColumns()) {
          /* Each column that this node has but the previous hadn't has been defined in between,
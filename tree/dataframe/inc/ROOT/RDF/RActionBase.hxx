@@ -16,13 +16,19 @@
 #include "RtypesCore.h"
 
 #include <memory>
+#include <set>
 #include <string>
 
 namespace ROOT {
 
+namespace RDF {
+class RProfiler;
+} // namespace RDF
+
 namespace Detail {
 namespace RDF {
 class RLoopManager;
+class RNodeBase;
 class RCustomColumnBase;
 class RMergeableValueBase;
 } // namespace RDF
@@ -51,6 +57,7 @@ protected:
 private:
    const unsigned int fNSlots; ///< Number of thread slots used by this node.
    bool fHasRun = false;
+   bool fIsOrdered = false; ///< Whether the tasks of multi-thread event loops must end in the order of their entries
    const ColumnNames_t fColumnNames;
 
    RBookedCustomColumns fCustomColumns;
@@ -72,6 +79,8 @@ public:
    virtual void ClearValueReaders(unsigned int slot) = 0;
    virtual void FinalizeSlot(unsigned int) = 0;
    virtual void Finalize() = 0;
+   /// Set the profile the action records its evaluations in, or reset it if profiling is disabled
+   virtual void InitProfile(ROOT::RDF::RProfiler &profiler) = 0;
    /// This method is invoked to update a partial result during the event loop, right before passing the result to a
    /// user-defined callback registered via RResultPtr::RegisterCallback
    virtual void *PartialUpdate(unsigned int slot) = 0;
@@ -80,8 +89,18 @@ public:
    virtual bool HasRun() const { return fHasRun; }
    virtual void SetHasRun() { fHasRun = true; }
 
+   /// Whether FinalizeSlot must be called at the end of the tasks in the order of their entries
+   bool IsOrdered() const { return fIsOrdered; }
+   void SetOrdered() { fIsOrdered = true; }
+
    virtual std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> GetGraph() = 0;
 
+   /// Return the node upstream of this action
+   virtual RNodeBase *GetPrevNode() const = 0;
+   /// Add to branchNames the input columns of this action that are not Defines, and those of the Defines it reads.
+   /// Overridden by RJittedAction.
+   virtual void AddInputBranchNames(std::set<std::string> &branchNames) const;
+
    /**
       Retrieve a wrapper to the result of the action that knows how to merge
       with others of the same type.
@@ -0,0 +1,253 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RARROWBATCHES
+#define ROOT_RDF_RARROWBATCHES
+
+#include "ROOT/RVec.hxx"
+#include "RtypesCore.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// The structs of the Arrow C data interface, see https://arrow.apache.org/docs/format/CDataInterface.html
+// Their ABI is stable: they are meant to be copied in the projects that exchange Arrow data, so that no dependency
+// on the Arrow libraries is needed.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+struct ArrowSchema {
+   const char *format;
+   const char *name;
+   const char *metadata;
+   int64_t flags;
+   int64_t n_children;
+   struct ArrowSchema **children;
+   struct ArrowSchema *dictionary;
+   void (*release)(struct ArrowSchema *);
+   void *private_data;
+};
+
+struct ArrowArray {
+   int64_t length;
+   int64_t null_count;
+   int64_t offset;
+   int64_t n_buffers;
+   int64_t n_children;
+   const void **buffers;
+   struct ArrowArray **children;
+   struct ArrowArray *dictionary;
+   void (*release)(struct ArrowArray *);
+   void *private_data;
+};
+}
+
+#endif // ARROW_C_DATA_INTERFACE
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// The description of an array in the Arrow columnar format, whose buffers are owned by a RArrowColumn
+struct RArrowLayout {
+   std::string fFormat;                ///< Format string of the Arrow C data interface
+   std::string fName;                  ///< Name of the field, empty for the values of a list
+   std::int64_t fLength;               ///< Number of values
+   std::vector<const void *> fBuffers; ///< The validity bitmap, always null as no value is missing, then the data
+   std::vector<RArrowLayout> fChildren;
+};
+
+/// The values of a column in one of the batches filled by ToArrow
+class RArrowColumnBase {
+public:
+   virtual ~RArrowColumnBase() = default;
+   virtual RArrowLayout GetLayout() const = 0;
+};
+
+/// Format string of the Arrow C data interface for an arithmetic type
+template <typename T>
+const char *GetArrowFormat()
+{
+   static_assert(sizeof(T) <= 8, "ToArrow: arithmetic types larger than 64 bits are not supported.");
+   if (std::is_floating_point<T>::value)
+      return sizeof(T) == 4 ? "f" : "g";
+   static const char *formats[] = {"c", "C", "s", "S", "i", "I", "l", "L"};
+   const auto sizeIdx = sizeof(T) == 1 ? 0 : sizeof(T) == 2 ? 1 : sizeof(T) == 4 ? 2 : 3;
+   return formats[2 * sizeIdx + (std::is_signed<T>::value ? 0 : 1)];
+}
+
+/// The offsets of list and string arrays are 32 bits wide
+inline std::int32_t CheckArrowOffset(std::size_t offset)
+{
+   if (offset > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+      throw std::runtime_error("ToArrow: the values of a column in a batch exceed the 2^31 elements of an Arrow list.");
+   return static_cast<std::int32_t>(offset);
+}
+
+template <typename T, typename = void>
+class RArrowColumn final : public RArrowColumnBase {
+   static_assert(sizeof(T) == 0, "ToArrow: only arithmetic types, std::string and collections of these, such as "
+                                 "RVec<float>, are supported.");
+};
+
+/// Arithmetic types: primitive arrays
+template <typename T>
+class RArrowColumn<T, typename std::enable_if<std::is_arithmetic<T>::value>::type> final : public RArrowColumnBase {
+   std::vector<T> fValues;
+
+public:
+   void Push(const T &value) { fValues.emplace_back(value); }
+   std::size_t GetSize() const { return fValues.size(); }
+   RArrowLayout GetLayout() const final
+   {
+      return {GetArrowFormat<T>(), "", static_cast<std::int64_t>(fValues.size()), {nullptr, fValues.data()}, {}};
+   }
+};
+
+/// Booleans: bit-packed primitive arrays
+template <>
+class RArrowColumn<bool, void> final : public RArrowColumnBase {
+   std::vector<std::uint8_t> fBits;
+   std::size_t fSize = 0;
+
+public:
+   void Push(bool value)
+   {
+      if (fSize % 8 == 0)
+         fBits.emplace_back(0);
+      if (value)
+         fBits.back() |= static_cast<std::uint8_t>(1u << (fSize % 8));
+      ++fSize;
+   }
+   std::size_t GetSize() const { return fSize; }
+   RArrowLayout GetLayout() const final
+   {
+      return {"b", "", static_cast<std::int64_t>(fSize), {nullptr, fBits.data()}, {}};
+   }
+};
+
+/// Strings: utf8 arrays
+template <>
+class RArrowColumn<std::string, void> final : public RArrowColumnBase {
+   std::vector<std::int32_t> fOffsets{0};
+   std::vector<char> fChars;
+
+public:
+   void Push(const std::string &value)
+   {
+      fChars.insert(fChars.end(), value.begin(), value.end());
+      fOffsets.emplace_back(CheckArrowOffset(fChars.size()));
+   }
+   std::size_t GetSize() const { return fOffsets.size() - 1; }
+   RArrowLayout GetLayout() const final
+   {
+      return {"u", "", static_cast<std::int64_t>(GetSize()), {nullptr, fOffsets.data(), fChars.data()}, {}};
+   }
+};
+
+/// Collections: list arrays, whose values are stored in a child column
+template <typename Coll_t>
+class RArrowListColumn : public RArrowColumnBase {
+   using Value_t = typename Coll_t::value_type;
+   std::vector<std::int32_t> fOffsets{0};
+   RArrowColumn<Value_t> fValues;
+
+public:
+   void Push(const Coll_t &coll)
+   {
+      for (const auto &v : coll)
+         fValues.Push(v);
+      fOffsets.emplace_back(CheckArrowOffset(fValues.GetSize()));
+   }
+   std::size_t GetSize() const { return fOffsets.size() - 1; }
+   RArrowLayout GetLayout() const final
+   {
+      return {"+l", "", static_cast<std::int64_t>(GetSize()), {nullptr, fOffsets.data()}, {fValues.GetLayout()}};
+   }
+};
+
+template <typename T>
+class RArrowColumn<ROOT::VecOps::RVec<T>, void> final : public RArrowListColumn<ROOT::VecOps::RVec<T>> {
+};
+
+template <typename T>
+class RArrowColumn<std::vector<T>, void> final : public RArrowListColumn<std::vector<T>> {
+};
+
+} // namespace RDF
+} // namespace Internal
+
+namespace RDF {
+
+// clang-format off
+/**
+\class ROOT::RDF::RArrowBatches
+\ingroup dataframe
+\brief The result of the ToArrow action: the values of some columns, in Arrow record batches.
+
+Each processing slot of the event loop fills its own batch, so there are as many batches as slots that processed
+entries (and always at least one, possibly empty, so that the schema is known). In multi-thread event loops the
+order of the batches, and of the entries among batches, is not the order of the entries in the dataset.
+
+The batches are handed to Arrow consumers (pyarrow, Arrow C++, Arrow Flight...) through the
+[Arrow C data interface](https://arrow.apache.org/docs/format/CDataInterface.html): Export moves the buffers of a batch
+into the exported structs, without copying the values, and the consumer frees them when it does not need them anymore.
+~~~{.py}
+import pyarrow
+from pyarrow.cffi import ffi
+batches = df.ToArrow(["pt", "eta"]).GetValue()
+array, schema = ffi.new("struct ArrowArray*"), ffi.new("struct ArrowSchema*")
+ROOT.Internal.RDF.ExportArrowBatch(batches, 0, int(ffi.cast("uintptr_t", array)), int(ffi.cast("uintptr_t", schema)))
+batch = pyarrow.RecordBatch._import_from_c(int(ffi.cast("uintptr_t", array)), int(ffi.cast("uintptr_t", schema)))
+~~~
+RDataFrame.AsArrow does this for all batches in Python.
+*/
+// clang-format on
+class RArrowBatches {
+public:
+   using Columns_t = std::vector<std::unique_ptr<ROOT::Internal::RDF::RArrowColumnBase>>;
+
+private:
+   struct RBatch {
+      ULong64_t fNEntries;
+      Columns_t fColumns;
+      bool fExported;
+   };
+
+   std::vector<std::string> fColumnNames;
+   std::vector<RBatch> fBatches;
+
+public:
+   /// Set the names of the fields of the batches, in the order of their columns
+   void SetColumnNames(const std::vector<std::string> &columnNames) { fColumnNames = columnNames; }
+   /// Add a batch with nEntries values in each of its columns
+   void AddBatch(ULong64_t nEntries, Columns_t &&columns)
+   {
+      fBatches.push_back(RBatch{nEntries, std::move(columns), false});
+   }
+   const std::vector<std::string> &GetColumnNames() const { return fColumnNames; }
+   std::size_t GetNBatches() const { return fBatches.size(); }
+   /// Return the number of entries in a batch
+   ULong64_t GetNEntries(std::size_t batch) const { return fBatches.at(batch).fNEntries; }
+   void Export(std::size_t batch, ArrowArray *array, ArrowSchema *schema);
+};
+
+} // namespace RDF
+} // namespace ROOT
+
+#endif
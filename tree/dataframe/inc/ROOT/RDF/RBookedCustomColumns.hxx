@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <map>
+#include <set>
 #include <vector>
 #include <string>
 #include <algorithm>
@@ -25,6 +26,10 @@ class RCustomColumnBase;
 }
 }
 
+namespace RDF {
+class RProfiler;
+}
+
 namespace Internal {
 namespace RDF {
 
@@ -95,6 +100,14 @@ public:
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Internally it recreates the map with the new column name, and swaps with the old one.
    void AddName(std::string_view name);
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Sets the profile of each user-defined column, or resets it if profiling is disabled.
+   void InitProfiles(ROOT::RDF::RProfiler &profiler) const;
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Adds to branchNames the columns that are not defined here, and recursively the inputs of those that are.
+   void AddInputBranchNames(const ColumnNames_t &columns, std::set<std::string> &branchNames) const;
 };
 
 } // Namespace RDF
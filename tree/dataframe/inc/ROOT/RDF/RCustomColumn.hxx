@@ -123,7 +123,13 @@ public:
    {
       if (entry != fLastCheckedEntry[slot]) {
          // evaluate this filter, cache the result
-         UpdateHelper(slot, entry, TypeInd_t(), ExtraArgsTag{});
+         if (fProfile) {
+            const auto start = ROOT::RDF::RNodeProfile::Clock_t::now();
+            UpdateHelper(slot, entry, TypeInd_t(), ExtraArgsTag{});
+            fProfile->Add(slot, start, true);
+         } else {
+            UpdateHelper(slot, entry, TypeInd_t(), ExtraArgsTag{});
+         }
          fLastCheckedEntry[slot] = entry;
       }
    }
@@ -133,6 +139,8 @@ public:
       return fIsDataSourceColumn ? typeid(typename std::remove_pointer<ret_type>::type) : typeid(ret_type);
    }
 
+   const ColumnNames_t &GetColumnNames() const final { return fColumnNames; }
+
    void ClearValueReaders(unsigned int slot) final
    {
       if (fIsInitialized[slot]) {
@@ -13,6 +13,7 @@
 
 #include "ROOT/RDF/GraphNode.hxx"
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 
 #include <memory>
 #include <string>
@@ -41,6 +42,7 @@ protected:
    const unsigned int fID = GetNextID();
    RDFInternal::RBookedCustomColumns fCustomColumns;
    std::deque<bool> fIsInitialized; // because vector<bool> is not thread-safe
+   ROOT::RDF::RNodeProfile *fProfile = nullptr; ///< Where evaluations are recorded if profiling is enabled, or null
 
    static unsigned int GetNextID();
 
@@ -58,9 +60,15 @@ public:
    std::string GetTypeName() const;
    virtual void Update(unsigned int slot, Long64_t entry) = 0;
    virtual void ClearValueReaders(unsigned int slot) = 0;
+   /// Return the names of the input columns of this custom column
+   virtual const std::vector<std::string> &GetColumnNames() const = 0;
    bool IsDataSourceColumn() const { return fIsDataSourceColumn; }
    /// Return the unique identifier of this RCustomColumnBase.
    unsigned int GetID() const { return fID; }
+   /// Set the profile the evaluations of this column are recorded in, or reset it if null. Overridden by
+   /// RJittedCustomColumn.
+   virtual void SetProfile(ROOT::RDF::RNodeProfile *profile) { fProfile = profile; }
+   const ROOT::RDF::RNodeProfile *GetProfile() const { return fProfile; }
 };
 
 } // ns RDF
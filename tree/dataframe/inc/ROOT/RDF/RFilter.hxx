@@ -84,12 +84,22 @@ public:
    bool CheckFilters(unsigned int slot, Long64_t entry) final
    {
       if (entry != fLastCheckedEntry[slot]) {
-         if (!fPrevData.CheckFilters(slot, entry)) {
+         if (!fChain.empty()) {
+            // this filter ends a chain of reorderable filters: evaluate all of them in the best order found so far
+            fLastResult[slot] = fChainPrev->CheckFilters(slot, entry) && CheckChain(slot, entry);
+         } else if (!fPrevData.CheckFilters(slot, entry)) {
             // a filter upstream returned false, cache the result
             fLastResult[slot] = false;
          } else {
             // evaluate this filter, cache the result
-            auto passed = CheckFilterHelper(slot, entry, TypeInd_t());
+            bool passed;
+            if (fProfile) {
+               const auto start = ROOT::RDF::RNodeProfile::Clock_t::now();
+               passed = CheckFilterHelper(slot, entry, TypeInd_t());
+               fProfile->Add(slot, start, passed);
+            } else {
+               passed = CheckFilterHelper(slot, entry, TypeInd_t());
+            }
             passed ? ++fAccepted[slot] : ++fRejected[slot];
             fLastResult[slot] = passed;
          }
@@ -107,6 +117,15 @@ public:
       return fFilter(std::get<S>(fValues[slot]).Get(entry)...);
    }
 
+   bool CheckPredicate(unsigned int slot, Long64_t entry) final { return CheckFilterHelper(slot, entry, TypeInd_t()); }
+
+   RNodeBase *GetPrevNode() const final { return fPrevDataPtr.get(); }
+
+   void AddInputBranchNames(std::set<std::string> &branchNames) const final
+   {
+      fCustomColumns.AddInputBranchNames(fColumnNames, branchNames);
+   }
+
    void InitSlot(TTreeReader *r, unsigned int slot) final
    {
       for (auto &bookedBranch : fCustomColumns.GetColumns())
@@ -13,9 +13,12 @@
 
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
 #include "ROOT/RDF/RNodeBase.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 #include "RtypesCore.h"
 #include "TError.h" // R_ASSERT
 
+#include <limits>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -33,6 +36,22 @@ namespace RDFInternal = ROOT::Internal::RDF;
 
 class RLoopManager;
 
+/// The interval of values of a dataset column accepted by a filter, derived from a comparison of the column with a
+/// number in the filter expression
+struct RColumnBounds {
+   std::string fColumnName;
+   double fMin = -std::numeric_limits<double>::infinity();
+   double fMax = std::numeric_limits<double>::infinity();
+   bool fMinIsStrict = false; ///< Whether the filter rejects the value fMin
+   bool fMaxIsStrict = false; ///< Whether the filter rejects the value fMax
+
+   /// Whether some values in [min, max] can pass the filter
+   bool MayMatch(double min, double max) const
+   {
+      return (fMinIsStrict ? max > fMin : max >= fMin) && (fMaxIsStrict ? min < fMax : min <= fMax);
+   }
+};
+
 class RFilterBase : public RNodeBase {
 protected:
    std::vector<Long64_t> fLastCheckedEntry;
@@ -44,6 +63,30 @@ protected:
 
    RDFInternal::RBookedCustomColumns fCustomColumns;
 
+   /// Whether this filter can be evaluated in any order with respect to the reorderable filters around it
+   bool fCanReorder = false;
+
+   /// Measurements used to choose the evaluation order of a chain of reorderable filters, per slot
+   struct RPredicateStats {
+      ULong64_t fNEvaluated = 0; ///< Number of times the predicate was evaluated
+      ULong64_t fNPassed = 0;    ///< Number of times the predicate returned true
+      ULong64_t fNTimed = 0;     ///< Number of timed evaluations
+      double fTime = 0.;         ///< Total duration of the timed evaluations, in seconds
+   };
+   /// Reorderable filters of the chain ending with this filter, in booking order; empty if there is no such chain
+   std::vector<RFilterBase *> fChain;
+   RNodeBase *fChainPrev = nullptr;                    ///< Node upstream of fChain
+   std::vector<std::vector<unsigned int>> fChainOrder; ///< Per slot, order of evaluation of the filters of fChain
+   std::vector<std::vector<RPredicateStats>> fChainStats; ///< Per slot, measurements for each filter of fChain
+   std::vector<ULong64_t> fNChainChecks;                  ///< Per slot, number of entries checked by CheckChain
+   ROOT::RDF::RNodeProfile *fProfile = nullptr; ///< Where evaluations are recorded if profiling is enabled, or null
+   /// Bounds that the predicate sets on dataset columns; entries with values outside of any of them are rejected
+   std::vector<RColumnBounds> fColumnBounds;
+
+   void InitReordering();
+   bool CheckChain(unsigned int slot, Long64_t entry);
+   void ReorderChain(unsigned int slot);
+
 public:
    RFilterBase(RLoopManager *df, std::string_view name, const unsigned int nSlots,
                const RDFInternal::RBookedCustomColumns &customColumns);
@@ -67,6 +110,20 @@ public:
    virtual void ClearTask(unsigned int slot) = 0;
    virtual void InitNode();
    virtual void AddFilterName(std::vector<std::string> &filters) = 0;
+   /// Evaluate the predicate of this filter only, without checking the upstream filters
+   virtual bool CheckPredicate(unsigned int slot, Long64_t entry) = 0;
+   /// Return the node upstream of this filter
+   virtual RNodeBase *GetPrevNode() const = 0;
+   /// Add to branchNames the input columns of this filter that are not Defines, and those of the Defines it reads
+   virtual void AddInputBranchNames(std::set<std::string> &branchNames) const = 0;
+   virtual void InitProfile(ROOT::RDF::RProfiler &profiler);
+   ROOT::RDF::RNodeProfile *GetProfile() const { return fProfile; }
+   bool CanReorder() const { return fCanReorder; }
+   void SetCanReorder(bool canReorder) { fCanReorder = canReorder; }
+   const std::vector<RColumnBounds> &GetColumnBounds() const { return fColumnBounds; }
+   void SetColumnBounds(std::vector<RColumnBounds> &&bounds) { fColumnBounds = std::move(bounds); }
+   /// Count entries that were not read because the column bounds reject them all
+   virtual void AddRejected(unsigned int slot, ULong64_t nEntries) { fRejected[slot] += nEntries; }
 };
 
 } // ns RDF
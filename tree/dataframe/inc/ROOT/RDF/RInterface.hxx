@@ -36,7 +36,9 @@
 #include <cstddef>
 #include <initializer_list>
 #include <limits>
+#include <map>
 #include <memory>
+#include <numeric> // std::accumulate
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -424,6 +426,45 @@ public:
       return newInterface;
    }
 
+   // clang-format off
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Register systematic variations of a column.
+   /// \param[in] colName The name of the column that is varied.
+   /// \param[in] expression Function, lambda expression, functor class or any other callable object returning the varied values of the column as a `RVec`, one element per variation tag.
+   /// \param[in] columns Names of the columns/branches in input to the expression.
+   /// \param[in] variationTags Names of the variations, in the order of the elements returned by the expression.
+   /// \return the first node of the computation graph for which the variations are defined.
+   ///
+   /// The varied values are computed once per entry, together with the nominal value of the column, and all the
+   /// variations of a result are then filled in the same event loop by the actions that support varied columns,
+   /// see VariedHisto1D. The nodes upstream of this one are evaluated only once per entry, for all variations.
+   /// A column can only be varied once per computation graph, and "nominal" cannot be used as a variation tag.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// auto df_varied = df.Vary("pt", [](float pt) { return RVec<float>{0.9f * pt, 1.1f * pt}; }, {"pt"}, {"down", "up"});
+   /// auto histos = df_varied.VariedHisto1D<float>({"pt", "pt", 64u, 0., 128.}, "pt");
+   /// (*histos)["up"].Draw();
+   /// ~~~
+   // clang-format on
+   template <typename F>
+   RInterface<Proxied, DS_t> Vary(std::string_view colName, F expression, const ColumnNames_t &columns,
+                                  const std::vector<std::string> &variationTags)
+   {
+      using Ret_t = typename TTraits::CallableTraits<F>::ret_type;
+      static_assert(RDFInternal::IsRVec_t<Ret_t>::value, "Error in `Vary`: the expression must return a RVec");
+
+      if (variationTags.empty())
+         throw std::runtime_error("Vary: at least one variation tag is required.");
+      if (std::find(variationTags.begin(), variationTags.end(), "nominal") != variationTags.end())
+         throw std::runtime_error("Vary: \"nominal\" cannot be used as a variation tag.");
+
+      const auto variationsColName = RDFInternal::VariationsColumnName(colName);
+      auto newInterface = Define(variationsColName, std::move(expression), columns);
+      fLoopManager->AddVariation(std::string(colName), variationTags);
+      return newInterface;
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Save selected columns to disk, in a new TTree `treename` in file `filename`.
    /// \tparam ColumnTypes variadic list of branch/column types.
@@ -601,6 +642,39 @@ public:
       return CacheImpl<ColumnTypes...>(columnList, staticSeq);
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Save selected columns in memory, or on disk if they might not fit in a memory budget
+   /// \tparam ColumnTypes variadic list of branch/column types.
+   /// \param[in] columns to be cached.
+   /// \param[in] memoryBudget maximum number of bytes the cached columns can take in memory.
+   /// \return a `RDataFrame` that wraps the cached dataset.
+   ///
+   /// The size of the cached dataset is estimated from the number of entries of the input dataset and the size of
+   /// the column types, e.g. without the elements of collections: if it exceeds the memory budget, the columns are
+   /// written to a temporary ROOT file instead, which is read back by the returned `RDataFrame` and deleted with it.
+   /// The event loop caching the columns on disk runs immediately. Datasets read from a data source are always
+   /// cached in memory.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// // cache at most 2 GB in memory
+   /// auto cached_df = df.Cache<double, int>({"col0", "col1"}, 2000000000ull);
+   /// ~~~
+   template <typename... ColumnTypes>
+   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList, ULong64_t memoryBudget)
+   {
+      const std::size_t columnSizes[] = {0u, sizeof(ColumnTypes)...};
+      const ULong64_t bytesPerEntry = std::accumulate(std::begin(columnSizes), std::end(columnSizes), 0ull);
+      const auto maxNEntries = RDFInternal::GetMaxNEntries(*fLoopManager);
+      if (bytesPerEntry == 0ull || maxNEntries == 0ull || maxNEntries <= memoryBudget / bytesPerEntry)
+         return Cache<ColumnTypes...>(columnList);
+
+      const auto fileName = RDFInternal::CreateCacheFile();
+      RInterface<RLoopManager> cachedRDF = *Snapshot<ColumnTypes...>("rdfcache", fileName, columnList);
+      cachedRDF.fLoopManager->AddTemporaryFile(fileName);
+      return cachedRDF;
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Save selected columns in memory
    /// \param[in] columns to be cached in memory
@@ -679,7 +753,10 @@ public:
    /// \return the first node of the computation graph for which the event loop is limited to a certain range of entries.
    ///
    /// Note that in case of previous Ranges and Filters the selected range refers to the transformed dataset.
-   /// Ranges are only available if EnableImplicitMT has _not_ been called. Multi-thread ranges are not supported.
+   /// In multi-thread event loops, a Range can only be applied directly to the dataset (possibly after Defines), where
+   /// it selects entries by their number in the dataset. The event loop then stops at the end of the range if all
+   /// actions are downstream of such ranges. Ranges downstream of filters require a sequential event loop: their
+   /// selection depends on the order in which the entries that pass the filters are processed.
    ///
    /// ### Example usage:
    /// ~~~{.cpp}
@@ -693,7 +770,9 @@ public:
       // check invariants
       if (stride == 0 || (end != 0 && end < begin))
          throw std::runtime_error("Range: stride must be strictly greater than 0 and end must be greater than begin.");
-      CheckIMTDisabled("Range");
+      if (fLoopManager->GetNSlots() > 1 && static_cast<RDFDetail::RNodeBase *>(fProxiedPtr.get()) != fLoopManager)
+         throw std::runtime_error("Range: in multi-thread event loops, a Range can only be applied to the dataset "
+                                  "directly, not downstream of filters or other ranges.");
 
       using Range_t = RDFDetail::RRange<Proxied>;
       auto rangePtr = std::make_shared<Range_t>(begin, end, stride, fProxiedPtr);
@@ -779,6 +858,44 @@ public:
       fLoopManager->Run();
    }
 
+   // clang-format off
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Execute a user-defined function on each entry, in the order of the entries (*instant action*)
+   /// \param[in] f Function, lambda expression, functor class or any other callable object performing user defined calculations.
+   /// \param[in] columns Names of the columns/branches in input to the user function.
+   ///
+   /// Same as `Foreach`, but also in multi-thread event loops the callable is invoked in the order of the entries of
+   /// the dataset, and never concurrently. The values of the entries of each task are copied, and the callable is
+   /// invoked on them when the task ends, after all previous tasks. The tasks are started in the order of their
+   /// entries, so the entries buffered at any time are those of about one task per thread.
+   /// The column types must be copy-constructible.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// myDf.ForeachOrdered([&out](ULong64_t e, int i){ out << e << ' ' << i << '\n'; }, {"rdfentry_", "myIntColumn"});
+   /// ~~~
+   // clang-format on
+   template <typename F>
+   void ForeachOrdered(F f, const ColumnNames_t &columns = {})
+   {
+      using ColTypes_t = typename TTraits::CallableTraits<F>::arg_types;
+      constexpr auto nColumns = ColTypes_t::list_size;
+
+      const auto validColumnNames = GetValidatedColumnNames(nColumns, columns);
+
+      auto newColumns = CheckAndFillDSColumns(validColumnNames, std::make_index_sequence<nColumns>(), ColTypes_t());
+
+      using Helper_t = RDFInternal::ForeachOrderedHelper<F>;
+      using Action_t = RDFInternal::RAction<Helper_t, Proxied>;
+
+      auto action = std::make_unique<Action_t>(Helper_t(std::move(f), fLoopManager->GetNSlots()), validColumnNames,
+                                               fProxiedPtr, std::move(newColumns));
+      action->SetOrdered();
+      fLoopManager->Book(action.get());
+
+      fLoopManager->Run();
+   }
+
    // clang-format off
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Execute a user-defined reduce operation on the values of a column.
@@ -903,6 +1020,84 @@ public:
       return MakeResultPtr(valuesPtr, *fLoopManager, std::move(action));
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Collect the values of columns in Arrow record batches (*lazy action*)
+   /// \tparam ColumnTypes variadic list of branch/column types.
+   /// \param[in] columnList Names of the columns to collect.
+   /// \return the batches wrapped in a `RResultPtr`.
+   ///
+   /// Each processing slot fills its own batch in the Arrow columnar format, so that the values are collected in
+   /// parallel in multi-thread event loops. Columns of arithmetic types and of `std::string` become primitive and
+   /// utf8 arrays; collections of these, e.g. `RVec<float>`, become list arrays. The batches can be handed to Arrow
+   /// consumers without copying the values, see RArrowBatches.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// auto batches = df.ToArrow<float, RVec<int>>({"pt", "charges"});
+   /// ArrowArray array;
+   /// ArrowSchema schema;
+   /// batches->Export(0, &array, &schema); // e.g. for arrow::ImportRecordBatch(&array, &schema)
+   /// ~~~
+   ///
+   /// This action is *lazy*: upon invocation of this method the calculation is
+   /// booked but not executed. See RResultPtr documentation.
+   template <typename... ColumnTypes>
+   RResultPtr<RArrowBatches> ToArrow(const ColumnNames_t &columnList)
+   {
+      RDFInternal::CheckTypesAndPars(sizeof...(ColumnTypes), columnList.size());
+
+      const auto validColumnNames = GetValidatedColumnNames(columnList.size(), columnList);
+
+      auto newColumns = CheckAndFillDSColumns(validColumnNames, std::index_sequence_for<ColumnTypes...>(),
+                                              TTraits::TypeList<ColumnTypes...>());
+
+      using Helper_t = RDFInternal::ArrowBatchesHelper<ColumnTypes...>;
+      using Action_t = RDFInternal::RAction<Helper_t, Proxied>;
+      auto batchesPtr = std::make_shared<RArrowBatches>();
+      const auto nSlots = fLoopManager->GetNSlots();
+
+      auto action = std::make_unique<Action_t>(Helper_t(batchesPtr, columnList, nSlots), validColumnNames,
+                                               fProxiedPtr, std::move(newColumns));
+      fLoopManager->Book(action.get());
+      return MakeResultPtr(batchesPtr, *fLoopManager, std::move(action));
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Collect the values of columns in Arrow record batches (*lazy action*)
+   /// \param[in] columnList Names of the columns to collect.
+   /// \return the batches wrapped in a `RResultPtr`.
+   ///
+   /// The types of the columns are automatically inferred and do not need to be specified: `std::vector` columns
+   /// are read as `RVec`. See above for a more complete description.
+   RResultPtr<RArrowBatches> ToArrow(const ColumnNames_t &columnList)
+   {
+      std::stringstream toArrowCall;
+      auto upcastNode = RDFInternal::UpcastNode(fProxiedPtr);
+      RInterface<TTraits::TakeFirstParameter_t<decltype(upcastNode)>> upcastInterface(fProxiedPtr, *fLoopManager,
+                                                                                      fCustomColumns, fDataSource);
+
+      // build a string equivalent to
+      // "resPtr = (RInterface<nodetype*>*)(this)->ToArrow<Ts...>(args...)"
+      RResultPtr<RArrowBatches> resPtr;
+      toArrowCall << "*reinterpret_cast<ROOT::RDF::RResultPtr<ROOT::RDF::RArrowBatches>*>("
+                  << RDFInternal::PrettyPrintAddr(&resPtr)
+                  << ") = reinterpret_cast<ROOT::RDF::RInterface<ROOT::Detail::RDF::RNodeBase>*>("
+                  << RDFInternal::PrettyPrintAddr(&upcastInterface) << ")->ToArrow<";
+
+      const auto validColumnNames = GetValidatedColumnNames(columnList.size(), columnList);
+      const auto colTypes = GetValidatedArgTypes(validColumnNames, fCustomColumns, fLoopManager->GetTree(), fDataSource,
+                                                 "ToArrow", /*vector2rvec=*/true);
+
+      for (auto &colType : colTypes)
+         toArrowCall << colType << ", ";
+      if (!colTypes.empty())
+         toArrowCall.seekp(-2, toArrowCall.cur); // remove the last ",
+      toArrowCall << ">(*reinterpret_cast<std::vector<std::string>*>(" // vector<string> should be ColumnNames_t
+                  << RDFInternal::PrettyPrintAddr(&columnList) << "));";
+      RDFInternal::InterpreterCalc(toArrowCall.str(), "ToArrow");
+      return resPtr;
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Fill and return a one-dimensional histogram with the values of a column (*lazy action*)
    /// \tparam V The type of the column used to fill the histogram.
@@ -970,6 +1165,43 @@ public:
       return Histo1D<V>({h_name.c_str(), h_title.c_str(), 128u, 0., 0.}, vName);
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Fill one-dimensional histograms with the nominal and the varied values of a column (*lazy action*)
+   /// \tparam V The type of the column used to fill the histograms.
+   /// \param[in] model The returned histograms will be constructed using this as a model.
+   /// \param[in] vName The name of the column that will fill the histograms, varied with Vary.
+   /// \return the histograms, by variation tag, wrapped in a `RResultPtr`.
+   ///
+   /// The histogram filled with the nominal values of the column is stored with the key "nominal"; all the
+   /// histograms are filled in the same event loop. The axis range of the model must be fixed.
+   /// This action is *lazy*: upon invocation of this method the calculation is
+   /// booked but not executed. See RResultPtr documentation.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// auto df_varied = df.Vary("x", [](double x) { return RVec<double>{x - 1, x + 1}; }, {"x"}, {"down", "up"});
+   /// auto histos = df_varied.VariedHisto1D<double>({"x", "x", 64u, 0., 128.}, "x");
+   /// auto shift = (*histos)["up"].GetMean() - (*histos)["nominal"].GetMean();
+   /// ~~~
+   template <typename V>
+   RResultPtr<std::map<std::string, ::TH1D>> VariedHisto1D(const TH1DModel &model, std::string_view vName)
+   {
+      const std::string colName(vName);
+      const auto &tags = fLoopManager->GetVariationTags(colName);
+
+      std::shared_ptr<::TH1D> h(nullptr);
+      {
+         ROOT::Internal::RDF::RIgnoreErrorLevelRAII iel(kError);
+         h = model.GetHistogram();
+         h->SetDirectory(nullptr);
+      }
+      if (h->GetXaxis()->GetXmax() == h->GetXaxis()->GetXmin())
+         throw std::runtime_error("VariedHisto1D: the model histogram must have a fixed axis range.");
+
+      return Book<V, RVec<V>>(RDFInternal::VariedHisto1DHelper(*h, tags, fLoopManager->GetNSlots()),
+                              {colName, RDFInternal::VariationsColumnName(colName)});
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Fill and return a one-dimensional histogram with the weighted values of a column (*lazy action*)
    /// \tparam V The type of the column used to fill the histogram.
@@ -1976,6 +2208,68 @@ public:
    /// ~~~
    unsigned int GetNRuns() const { return fLoopManager->GetNRuns(); }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Allow the event loop to evaluate chains of unnamed filters in the order it measures to be the fastest
+   /// \param[in] enable Whether the unnamed filters booked from now on in this computation graph can be reordered.
+   ///
+   /// Consecutive unnamed filters booked while reordering is enabled form a chain whose predicates are evaluated in
+   /// the order of increasing ratio between their measured cost and rejection rate, updated during the event loop.
+   /// Since a predicate is only evaluated if all the predicates before it accepted the entry, the columns it reads
+   /// are only read for such entries. The predicates of a chain must therefore be free of side effects and must not
+   /// depend on each other. Named filters, which are reported by Report, are never reordered, and neither are
+   /// filters separated by a Range.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// df.EnableFilterReordering();
+   /// auto selected = df.Filter(expensiveCut, {"tracks"}).Filter("nMuons > 2"); // "nMuons > 2" might run first
+   /// ~~~
+   void EnableFilterReordering(bool enable = true) { fLoopManager->SetFilterReordering(enable); }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Record timings and counters of the next event loops of this computation graph
+   /// \param[in] enable Whether the event loops started from now on are profiled.
+   ///
+   /// For each slot, the event loop records the number of evaluations of each Filter, Define and action and the time
+   /// spent in them, the number of entries processed and the time spent loading them. The time spent jitting the
+   /// computation graph and the duration of each task are recorded too. The times of a node include the evaluation of
+   /// the Defines it reads and, for actions, of the upstream filters. Profiling adds the cost of reading a clock to
+   /// each evaluation, so it is disabled by default. The results are available from GetProfiler() and are added to
+   /// the nodes drawn by ROOT::RDF::SaveGraph.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// df.EnableProfiling();
+   /// auto h = df.Filter("x > 0").Define("y", "x * x").Histo1D("y");
+   /// h->Draw(); // run the event loop
+   /// df.GetProfiler().Print();
+   /// std::ofstream("trace.json") << df.GetProfiler().ToChromeTrace(); // can be opened e.g. with chrome://tracing
+   /// ROOT::RDF::SaveGraph(df, "graph.dot"); // the nodes are annotated with their number of calls and time
+   /// ~~~
+   void EnableProfiling(bool enable = true) { fLoopManager->GetProfiler().SetEnabled(enable); }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Return the timings and counters recorded while profiling was enabled, see EnableProfiling.
+   ROOT::RDF::RProfiler &GetProfiler() { return fLoopManager->GetProfiler(); }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Return the monitor that publishes the progress and the throughput of the event loops while they run.
+   ///
+   /// Event loops are monitored once an output is set: the number of entries processed, the entries and bytes per
+   /// second overall and per slot, and the estimated time left are then printed or passed to callbacks at regular
+   /// intervals, see ROOT::RDF::RProgressMonitor.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// df.GetProgressMonitor().SetInterval(10.); // seconds
+   /// df.GetProgressMonitor().PrintTo(std::cout);
+   /// df.GetProgressMonitor().AddCallback([](const ROOT::RDF::RProgressInfo &info) {
+   ///    if (info.fEntriesPerSecond == 0.)
+   ///       std::cerr << "the event loop is stalled\n";
+   /// });
+   /// ~~~
+   ROOT::RDF::RProgressMonitor &GetProgressMonitor() { return fLoopManager->GetProgressMonitor(); }
+
    // clang-format off
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Execute a user-defined accumulation operation on the processed column values in each processing slot
@@ -2409,11 +2703,15 @@ private:
                                       fProxiedPtr, std::move(newColumns)));
       } else {
          // multi-thread snapshot
+         if (options.fOrdered && options.fOutputFilePerSlot)
+            throw std::runtime_error("Snapshot: the fOrdered and fOutputFilePerSlot options cannot be combined.");
          using Helper_t = RDFInternal::SnapshotHelperMT<ColumnTypes...>;
          using Action_t = RDFInternal::RAction<Helper_t, Proxied>;
          actionPtr.reset(new Action_t(
             Helper_t(fLoopManager->GetNSlots(), filename, dirname, treename, validCols, columnList, options), validCols,
             fProxiedPtr, std::move(newColumns)));
+         if (options.fOrdered)
+            actionPtr->SetOrdered();
       }
 
       fLoopManager->Book(actionPtr.get());
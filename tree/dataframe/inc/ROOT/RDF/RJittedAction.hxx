@@ -52,12 +52,15 @@ public:
    void TriggerChildrenCount() final;
    void FinalizeSlot(unsigned int) final;
    void Finalize() final;
+   void InitProfile(ROOT::RDF::RProfiler &profiler) final;
    void *PartialUpdate(unsigned int slot) final;
    bool HasRun() const final;
    void SetHasRun() final;
    void ClearValueReaders(unsigned int slot) final;
 
    std::shared_ptr<GraphDrawing::GraphNode> GetGraph();
+   RNodeBase *GetPrevNode() const final;
+   void AddInputBranchNames(std::set<std::string> &branchNames) const final;
 
    // Helper for RMergeableValue
    std::unique_ptr<ROOT::Detail::RDF::RMergeableValueBase> GetMergeableValue() const final;
@@ -44,6 +44,8 @@ public:
    const std::type_info &GetTypeId() const final;
    void Update(unsigned int slot, Long64_t entry) final;
    void ClearValueReaders(unsigned int slot) final;
+   const std::vector<std::string> &GetColumnNames() const final;
+   void SetProfile(ROOT::RDF::RNodeProfile *profile) final;
 };
 
 } // ns RDF
@@ -57,8 +57,13 @@ public:
    void ResetReportCount() final;
    void ClearValueReaders(unsigned int slot) final;
    void InitNode() final;
+   void InitProfile(ROOT::RDF::RProfiler &profiler) final;
    void AddFilterName(std::vector<std::string> &filters) final;
    void ClearTask(unsigned int slot) final;
+   bool CheckPredicate(unsigned int slot, Long64_t entry) final;
+   RNodeBase *GetPrevNode() const final;
+   void AddInputBranchNames(std::set<std::string> &branchNames) const final;
+   void AddRejected(unsigned int slot, ULong64_t nEntries) final;
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph();
 };
 
@@ -13,10 +13,17 @@
 
 #include "ROOT/RDF/RNodeBase.hxx"
 #include "ROOT/RDF/NodesUtils.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
+#include "ROOT/RDF/RProgressMonitor.hxx"
 
+#include <condition_variable>
+#include <cstddef> // std::size_t
 #include <functional>
+#include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -56,6 +63,8 @@ using ROOT::RDF::RDataSource;
 class RLoopManager : public RNodeBase {
    enum class ELoopType { kROOTFiles, kROOTFilesMT, kNoFiles, kNoFilesMT, kDataSource, kDataSourceMT };
    using Callback_t = std::function<void(unsigned int)>;
+   /// Gets the minimum and maximum of a column in the zone of entries that contains an entry, and the end of the zone
+   using ColumnStatistics_t = std::function<bool(const std::string &, ULong64_t, double &, double &, ULong64_t &)>;
    class TCallback {
       const Callback_t fFun;
       const ULong64_t fEveryN;
@@ -113,11 +122,33 @@ class RLoopManager : public RNodeBase {
    std::vector<TCallback> fCallbacks;                      ///< Registered callbacks
    std::vector<TOneTimeCallback> fCallbacksOnce; ///< Registered callbacks to invoke just once before running the loop
    unsigned int fNRuns{0}; ///< Number of event loops run
+   /// Variation tags of the columns varied with RInterface::Vary, by column name
+   std::map<std::string, std::vector<std::string>> fVariationTags;
+   bool fFilterReordering{false}; ///< Whether unnamed filters booked now can be evaluated in any order
+   /// Temporary files read by this RLoopManager, deleted when it is destroyed
+   std::vector<std::string> fTemporaryFiles;
+   ROOT::RDF::RProfiler fProfiler{fNSlots}; ///< Timings and counters of the event loops, if profiling is enabled
+   ROOT::RDF::RProgressMonitor fProgressMonitor{fNSlots}; ///< Publishes the progress of the event loops, if enabled
+   /// Entries [begin, end) processed by the current event loop, if started by RunOnEntryRange
+   std::pair<ULong64_t, ULong64_t> fEntryRange{0ull, 0ull};
+   bool fHasEntryRange{false};
+   /// Branches that only nodes downstream of a filter read. The TTreeCache does not unzip their baskets ahead.
+   std::set<std::string> fLateBranches;
+   /// Filters that every processed entry has to pass first. The event loop skips the zones of entries they reject.
+   std::vector<RFilterBase *> fSkippingFilters;
+   /// Entry at which multi-thread event loops stop, if every action is downstream of a Range with an end
+   ULong64_t fEndEntryMT{std::numeric_limits<ULong64_t>::max()};
+   /// Whether the tasks of the multi-thread event loop start and end in the order of their entries, see CleanUpTask
+   bool fOrderedTasks{false};
+   std::vector<std::size_t> fSlotTasks; ///< Index of the task each slot is processing, in ordered event loops
+   std::size_t fNextTaskToEnd{0};       ///< Index of the next task that can end, in ordered event loops
+   std::mutex fTaskOrderMutex;
+   std::mutex fRunMutex; ///< Serializes the event loops triggered concurrently by the results, see RunForAction
+   std::condition_variable fTaskOrderCondition;
 
    /// Cache of the tree/chain branch names. Never access directy, always use GetBranchNames().
    ColumnNames_t fValidBranchNames;
 
-   void CheckIndexedFriends();
    void RunEmptySourceMT();
    void RunEmptySource();
    void RunTreeProcessorMT();
@@ -125,10 +156,25 @@ class RLoopManager : public RNodeBase {
    void RunDataSourceMT();
    void RunDataSource();
    void RunAndCheckFilters(unsigned int slot, Long64_t entry);
+   bool LoadEntry(TTreeReader &r, unsigned int slot);
+   bool LoadEntry(unsigned int slot, ULong64_t entry);
    void InitNodeSlots(TTreeReader *r, unsigned int slot);
    void InitNodes();
+   void FindLateBranches();
+   RNodeBase *FindLeadingNode(RNodeBase *node);
+   void FindSkippingFilters();
+   void FindEndEntryMT();
+   std::pair<ULong64_t, ULong64_t>
+   SkipRejectedEntries(unsigned int slot, ULong64_t begin, ULong64_t end, const ColumnStatistics_t &getStatistics);
+   void InitProfiles();
    void CleanUpNodes();
    void CleanUpTask(unsigned int slot);
+   Long64_t GetNEntriesToProcess() const;
+   void SetSlotTask(unsigned int slot, std::size_t taskIndex)
+   {
+      if (fOrderedTasks)
+         fSlotTasks[slot] = taskIndex;
+   }
    void EvalChildrenCounts();
 
 public:
@@ -137,11 +183,14 @@ public:
    RLoopManager(std::unique_ptr<RDataSource> ds, const ColumnNames_t &defaultBranches);
    RLoopManager(const RLoopManager &) = delete;
    RLoopManager &operator=(const RLoopManager &) = delete;
+   ~RLoopManager();
 
    void JitDeclarations();
    void Jit();
    RLoopManager *GetLoopManagerUnchecked() final { return this; }
    void Run();
+   void RunForAction(const RDFInternal::RActionBase &action);
+   void RunOnEntryRange(ULong64_t begin, ULong64_t end);
    const ColumnNames_t &GetDefaultColumnNames() const;
    TTree *GetTree() const;
    ::TDirectory *GetDirectory() const;
@@ -166,6 +215,14 @@ public:
    const std::map<std::string, std::string> &GetAliasMap() const { return fAliasColumnNameMap; }
    void RegisterCallback(ULong64_t everyNEvents, std::function<void(unsigned int)> &&f);
    unsigned int GetNRuns() const { return fNRuns; }
+   void AddVariation(const std::string &colName, const std::vector<std::string> &tags);
+   const std::vector<std::string> &GetVariationTags(const std::string &colName) const;
+   void SetFilterReordering(bool enable) { fFilterReordering = enable; }
+   bool IsFilterReorderingEnabled() const { return fFilterReordering; }
+   /// Delete the file `fileName` when this RLoopManager is destroyed
+   void AddTemporaryFile(const std::string &fileName) { fTemporaryFiles.emplace_back(fileName); }
+   ROOT::RDF::RProfiler &GetProfiler() { return fProfiler; }
+   ROOT::RDF::RProgressMonitor &GetProgressMonitor() { return fProgressMonitor; }
 
    /// End of recursive chain of calls, does nothing
    void AddFilterName(std::vector<std::string> &) {}
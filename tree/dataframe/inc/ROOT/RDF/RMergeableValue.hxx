@@ -22,6 +22,8 @@
 #include <algorithm> // std::min, std::max
 
 #include "RtypesCore.h"
+#include "TBuffer.h"
+#include "TClass.h"
 #include "TList.h" // RMergeableFill::Merge
 
 namespace ROOT {
@@ -57,8 +59,50 @@ public:
       (classTBufferFile.html#a209078a4cb58373b627390790bf0c9c1)
    */
    RMergeableValueBase() = default;
+   /////////////////////////////////////////////////////////////////////////////
+   /// \brief Write the content of this object to a buffer, or read it from the
+   ///        buffer if the buffer is in reading mode.
+   ///
+   /// Used to send mergeables to other processes, see ROOT::RDF::RunMultiProcess.
+   /// \throws std::runtime_error If the type of the result cannot be streamed.
+   virtual void Serialize(TBuffer &buf) = 0;
 };
 
+/// \cond HIDDEN_SYMBOLS
+// Stream a value of a fundamental type, in the direction given by the mode of the buffer.
+template <typename T>
+void SerializeBasic(TBuffer &buf, T &value)
+{
+   if (buf.IsReading())
+      buf >> value;
+   else
+      buf << value;
+}
+inline void SerializeValue(TBuffer &buf, Bool_t &value) { SerializeBasic(buf, value); }
+inline void SerializeValue(TBuffer &buf, Char_t &value) { SerializeBasic(buf, value); }
+inline void SerializeValue(TBuffer &buf, UChar_t &value) { SerializeBasic(buf, value); }
+inline void SerializeValue(TBuffer &buf, Short_t &value) { SerializeBasic(buf, value); }
+inline void SerializeValue(TBuffer &buf, UShort_t &value) { SerializeBasic(buf, value); }
+inline void SerializeValue(TBuffer &buf, Int_t &value) { SerializeBasic(buf, value); }
+inline void SerializeValue(TBuffer &buf, UInt_t &value) { SerializeBasic(buf, value); }
+inline void SerializeValue(TBuffer &buf, Long_t &value) { SerializeBasic(buf, value); }
+inline void SerializeValue(TBuffer &buf, ULong_t &value) { SerializeBasic(buf, value); }
+inline void SerializeValue(TBuffer &buf, Long64_t &value) { SerializeBasic(buf, value); }
+inline void SerializeValue(TBuffer &buf, ULong64_t &value) { SerializeBasic(buf, value); }
+inline void SerializeValue(TBuffer &buf, Float_t &value) { SerializeBasic(buf, value); }
+inline void SerializeValue(TBuffer &buf, Double_t &value) { SerializeBasic(buf, value); }
+
+// Stream any other value through its dictionary.
+template <typename T>
+void SerializeValue(TBuffer &buf, T &value)
+{
+   auto cl = TClass::GetClass(typeid(T));
+   if (!cl)
+      throw std::runtime_error("RMergeableValue: cannot serialize a result of a type without dictionary.");
+   cl->Streamer(&value, buf);
+}
+/// \endcond
+
 /**
 \class ROOT::Detail::RDF::RMergeableValue
 \ingroup dataframe
@@ -164,6 +208,7 @@ public:
    /////////////////////////////////////////////////////////////////////////////
    /// \brief Retrieve the result wrapped by this mergeable.
    const T &GetValue() const { return fValue; }
+   void Serialize(TBuffer &buf) override { SerializeValue(buf, fValue); }
 };
 
 /**
@@ -362,6 +407,11 @@ public:
    */
    RMergeableMean() = default;
    RMergeableMean(RMergeableMean &&) = default;
+   void Serialize(TBuffer &buf) final
+   {
+      RMergeableValue<Double_t>::Serialize(buf);
+      SerializeValue(buf, fCounts);
+   }
    RMergeableMean(const RMergeableMean &) = delete;
 };
 
@@ -473,6 +523,12 @@ public:
    */
    RMergeableStdDev() = default;
    RMergeableStdDev(RMergeableStdDev &&) = default;
+   void Serialize(TBuffer &buf) final
+   {
+      RMergeableValue<Double_t>::Serialize(buf);
+      SerializeValue(buf, fCounts);
+      SerializeValue(buf, fMean);
+   }
    RMergeableStdDev(const RMergeableStdDev &) = delete;
 };
 
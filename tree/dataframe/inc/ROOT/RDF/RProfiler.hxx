@@ -0,0 +1,144 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RPROFILER
+#define ROOT_RDF_RPROFILER
+
+#include "RtypesCore.h"
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+namespace RDF {
+
+/// Per-slot statistics of one node of a computation graph, collected while profiling is enabled (see RProfiler).
+/// Times are inclusive: they contain the evaluation of the Defines and the reading of the columns the node triggers.
+class RNodeProfile {
+public:
+   using Clock_t = std::chrono::steady_clock;
+
+private:
+   std::string fName;
+   std::vector<ULong64_t> fCalls;   ///< Number of evaluations of the node, per slot
+   std::vector<ULong64_t> fEntries; ///< Number of entries accepted (filters) or processed (actions), per slot
+   std::vector<double> fTimes;      ///< Time spent in the evaluations of the node, per slot, in seconds
+
+public:
+   RNodeProfile(const std::string &name, unsigned int nSlots)
+      : fName(name), fCalls(nSlots, 0ull), fEntries(nSlots, 0ull), fTimes(nSlots, 0.)
+   {
+   }
+
+   /// Record an evaluation of the node in the given slot that started at `start` and ends now.
+   void Add(unsigned int slot, Clock_t::time_point start, bool accepted)
+   {
+      fTimes[slot] += std::chrono::duration<double>(Clock_t::now() - start).count();
+      ++fCalls[slot];
+      if (accepted)
+         ++fEntries[slot];
+   }
+
+   const std::string &GetName() const { return fName; }
+   void SetName(const std::string &name) { fName = name; }
+   const std::vector<ULong64_t> &GetSlotCalls() const { return fCalls; }
+   const std::vector<ULong64_t> &GetSlotEntries() const { return fEntries; }
+   const std::vector<double> &GetSlotTimes() const { return fTimes; }
+   ULong64_t GetCalls() const;
+   ULong64_t GetEntries() const;
+   double GetTime() const;
+   std::string GetSummary() const;
+   void Reset();
+};
+
+// clang-format off
+/**
+\class ROOT::RDF::RProfiler
+\ingroup dataframe
+\brief Timings and counters of the event loops of a computation graph, see RInterface::EnableProfiling.
+
+While profiling is enabled, the event loop records
+- the time spent evaluating each Filter, Define and action, together with the number of evaluations, for each slot;
+- the number of entries processed and the time spent loading them from the TTree or the data source, for each slot;
+- the time spent jitting the code of the computation graph;
+- the start and end of the event loop and of each of its tasks.
+
+The results can be printed with Print(), exported as Chrome trace JSON with ToChromeTrace(), and are added to the
+nodes of the graph produced by ROOT::RDF::SaveGraph.
+*/
+// clang-format on
+class RProfiler {
+public:
+   using Clock_t = std::chrono::steady_clock;
+
+   /// A time interval of the event loop, e.g. the jitting or a task. Times are in seconds since the profiler creation.
+   struct RInterval {
+      std::string fName;
+      int fSlot;          ///< The processing slot, or -1 for intervals that do not belong to a task
+      double fStart;
+      double fEnd;
+      ULong64_t fEntries; ///< Number of entries processed during the interval
+   };
+
+private:
+   const unsigned int fNSlots;
+   bool fEnabled = false;
+   const Clock_t::time_point fCreationTime = Clock_t::now();
+   std::map<const void *, RNodeProfile> fNodes; ///< Profiles of the nodes, indexed by node address
+   std::vector<const void *> fNodesOrder;       ///< Node addresses in order of registration, for printing
+   std::vector<ULong64_t> fEntries;             ///< Number of entries processed, per slot
+   std::vector<double> fReadTimes;              ///< Time spent loading entries, per slot, in seconds
+   std::vector<double> fTaskStarts;             ///< Start of the current task of each slot
+   std::vector<ULong64_t> fTaskEntries;         ///< Entries processed by the slot before its current task started
+   std::vector<RInterval> fIntervals;
+   std::mutex fIntervalsMutex;
+
+public:
+   explicit RProfiler(unsigned int nSlots);
+   RProfiler(const RProfiler &) = delete;
+   RProfiler &operator=(const RProfiler &) = delete;
+
+   void SetEnabled(bool enable) { fEnabled = enable; }
+   bool IsEnabled() const { return fEnabled; }
+
+   /// Return the number of seconds elapsed since the creation of the profiler.
+   double Now() const { return std::chrono::duration<double>(Clock_t::now() - fCreationTime).count(); }
+
+   RNodeProfile &GetNodeProfile(const void *node, const std::string &name);
+   void ForgetNode(const void *node);
+   void AddInterval(const std::string &name, int slot, double start, double end, ULong64_t entries = 0ull);
+   void StartTask(unsigned int slot);
+   void EndTask(unsigned int slot);
+   void AddEntry(unsigned int slot) { ++fEntries[slot]; }
+   /// Record the loading of an entry in the given slot that started at `start` and ends now.
+   void AddReadTime(unsigned int slot, Clock_t::time_point start)
+   {
+      fReadTimes[slot] += std::chrono::duration<double>(Clock_t::now() - start).count();
+   }
+
+   std::vector<const RNodeProfile *> GetNodeProfiles() const;
+   const std::vector<ULong64_t> &GetSlotEntries() const { return fEntries; }
+   const std::vector<double> &GetSlotReadTimes() const { return fReadTimes; }
+   const std::vector<RInterval> &GetIntervals() const { return fIntervals; }
+   ULong64_t GetEntries() const;
+   double GetReadTime() const;
+   double GetJitTime() const;
+
+   void Print(std::ostream &os = std::cout) const;
+   std::string ToChromeTrace() const;
+   void Reset();
+};
+
+} // namespace RDF
+} // namespace ROOT
+
+#endif // ROOT_RDF_RPROFILER
@@ -0,0 +1,133 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RPROGRESSMONITOR
+#define ROOT_RDF_RPROGRESSMONITOR
+
+#include "RtypesCore.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ROOT {
+namespace RDF {
+
+/// The progress of an event loop at some point in time, as published by RProgressMonitor.
+struct RProgressInfo {
+   double fElapsed = 0.;          ///< Seconds since the start of the event loop
+   ULong64_t fEntries = 0ull;     ///< Number of entries processed so far
+   Long64_t fTotalEntries = -1;   ///< Number of entries the event loop processes, or -1 if not known in advance
+   double fEntriesPerSecond = 0.; ///< Processing rate since the previous snapshot
+   Long64_t fBytesRead = 0;       ///< Bytes read from ROOT files since the start of the event loop
+   double fBytesPerSecond = 0.;   ///< Reading rate since the previous snapshot
+   double fTimeLeft = -1.;        ///< Estimated number of seconds to the end of the event loop, or -1 if unknown
+   bool fIsFinal = false;         ///< Whether the snapshot was taken at the end of the event loop
+   std::vector<ULong64_t> fSlotEntries;       ///< Number of entries processed so far, per slot
+   std::vector<double> fSlotEntriesPerSecond; ///< Processing rate since the previous snapshot, per slot
+
+   std::string AsString() const;
+};
+
+// clang-format off
+/**
+\class ROOT::RDF::RProgressMonitor
+\ingroup dataframe
+\brief Publishes the progress and the throughput of the event loops of a computation graph while they run.
+
+Once an output is set with PrintTo() or AddCallback(), a thread started with each event loop takes a snapshot of its
+progress (an RProgressInfo) every SetInterval() seconds, and once more at its end. It is printed to the stream and
+passed to the callbacks, which are never invoked concurrently.
+
+Each processing slot counts the entries it processes in its own cache line, with a plain store: the event loop does
+not synchronize on them. The bytes read are taken from TFile::GetFileBytesRead(), hence they include the reading of
+all ROOT files of the process. The time left is only estimated if the number of entries is known in advance, i.e.
+for empty sources, trees (but not chains whose files have not been opened yet) and entry ranges.
+
+The callbacks can e.g. update an object published by a THttpServer, so that stalled or I/O-bound jobs can be spotted
+from a monitoring service:
+~~~{.cpp}
+THttpServer serv("http:8080");
+TNamed progress("progress", "");
+serv.Register("/rdf", &progress);
+df.GetProgressMonitor().AddCallback([&progress](const ROOT::RDF::RProgressInfo &info) {
+   progress.SetTitle(info.AsString().c_str());
+});
+~~~
+*/
+// clang-format on
+class RProgressMonitor {
+public:
+   using Clock_t = std::chrono::steady_clock;
+   using Callback_t = std::function<void(const RProgressInfo &)>;
+
+private:
+   /// The entries processed by a slot. It is only written by the thread that processes the slot, and padded so that
+   /// the counters of different slots never share a cache line.
+   struct RSlotCounter {
+      std::atomic<ULong64_t> fEntries{0ull};
+      char fPadding[64 - sizeof(std::atomic<ULong64_t>)];
+   };
+
+   const unsigned int fNSlots;
+   const std::unique_ptr<RSlotCounter[]> fSlotCounters;
+   bool fEnabled = false;
+   double fInterval = 1.;          ///< Seconds between two snapshots
+   std::ostream *fStream = nullptr; ///< The stream to print the snapshots to, if any
+   std::vector<Callback_t> fCallbacks;
+
+   // the state of the current event loop
+   std::thread fThread;
+   std::mutex fMutex;
+   std::condition_variable fCondition;
+   bool fStopRequested = false;
+   Clock_t::time_point fStart;
+   Long64_t fTotalEntries = -1;
+   Long64_t fBytesReadAtStart = 0;
+   RProgressInfo fLastInfo;
+
+   RProgressInfo TakeSnapshot(bool isFinal) const;
+   void Publish(bool isFinal);
+
+public:
+   explicit RProgressMonitor(unsigned int nSlots);
+   RProgressMonitor(const RProgressMonitor &) = delete;
+   RProgressMonitor &operator=(const RProgressMonitor &) = delete;
+   ~RProgressMonitor();
+
+   void SetInterval(double seconds);
+   void PrintTo(std::ostream &os = std::cout);
+   void AddCallback(Callback_t callback);
+   void Clear();
+   bool IsEnabled() const { return fEnabled; }
+
+   /// Count an entry processed by the given slot. Called by the event loop only, from the thread processing the slot.
+   void AddEntry(unsigned int slot)
+   {
+      auto &entries = fSlotCounters[slot].fEntries;
+      entries.store(entries.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+   }
+
+   void Start(Long64_t totalEntries);
+   void Stop();
+
+   /// Return the last snapshot published, i.e. the one taken at the end of the last event loop once it is done.
+   const RProgressInfo &GetLastInfo() const { return fLastInfo; }
+};
+
+} // namespace RDF
+} // namespace ROOT
+
+#endif // ROOT_RDF_RPROGRESSMONITOR
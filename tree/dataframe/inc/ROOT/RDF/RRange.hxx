@@ -51,6 +51,10 @@ public:
    /// Ranges act as filters when it comes to selecting entries that downstream nodes should process
    bool CheckFilters(unsigned int slot, Long64_t entry) final
    {
+      // the tasks of multi-thread event loops process the entries out of order, see RRangeBase::IsSelected
+      if (fNSlots > 1)
+         return fPrevData.CheckFilters(slot, entry) && IsSelected(entry);
+
       if (entry != fLastCheckedEntry) {
          if (fHasStopped)
             return false;
@@ -98,6 +102,8 @@ public:
 
    /// This function must be defined by all nodes, but only the filters will add their name
    void AddFilterName(std::vector<std::string> &filters) { fPrevData.AddFilterName(filters); }
+   RNodeBase *GetPrevNode() const final { return fPrevDataPtr.get(); }
+
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph()
    {
       // TODO: Ranges node have no information about custom columns, hence it is not possible now
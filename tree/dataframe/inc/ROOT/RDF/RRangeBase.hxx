@@ -50,7 +50,11 @@ public:
    virtual ~RRangeBase();
 
    void InitNode() { ResetCounters(); }
+   unsigned int GetStop() const { return fStop; }
+   bool IsSelected(ULong64_t entry) const;
    virtual std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph() = 0;
+   /// Return the node upstream of this range
+   virtual RNodeBase *GetPrevNode() const = 0;
 };
 
 } // ns RDF
@@ -176,6 +176,12 @@ void InterpreterDeclare(const std::string &code);
 /// The pointer returned by the call to TInterpreter::Calc is returned in case of success.
 Long64_t InterpreterCalc(const std::string &code, const std::string &context = "");
 
+/// Record the declaration of a jitted lambda, which the libraries of the jit cache have to contain
+void RegisterJittedLambda(const std::string &name, const std::string &declaration);
+
+/// Run code to jit from the jit cache enabled with ROOT::RDF::EnableJitCache, return false if it must be interpreted
+bool RunWithJitCache(const std::string &code);
+
 } // end NS RDF
 } // end NS Internal
 } // end NS ROOT
@@ -15,6 +15,7 @@
 
 #include <ROOT/RDataFrame.hxx>
 #include <ROOT/RDF/GraphUtils.hxx>
+#include <ROOT/RResultHandle.hxx>
 #include <ROOT/RIntegerSequence.hxx>
 #include <ROOT/TypeTraits.hxx>
 
@@ -146,6 +147,80 @@ RNode AsRNode(NodeType node)
    return node;
 }
 
+// clang-format off
+/// Trigger the event loop of multiple RDataFrames concurrently
+/// \param[in] handles A vector of RResultHandles, see RResultHandle
+/// \return The number of distinct computation graphs that have been processed
+///
+/// This function triggers the event loop of all computation graphs which relate to the
+/// given RResultHandles. The advantage compared to running the event loop implicitly by accessing the
+/// RResultPtr is that the event loops will run concurrently. Therefore, the overall
+/// computation of all results is generally more efficient.
+/// It should be noted that user-defined operations (e.g., Filters and Defines) of the different RDataFrame graphs are assumed to be safe to call concurrently.
+/// The just-in-time compilation of all graphs is done in one go before any of the event loops starts.
+///
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df1("tree1", "file1.root");
+/// auto r1 = df1.Histo1D("var1");
+///
+/// ROOT::RDataFrame df2("tree2", "file2.root");
+/// auto r2 = df2.Sum("var2");
+///
+/// // RResultPtr -> RResultHandle conversion is automatic
+/// ROOT::RDF::RunGraphs({r1, r2});
+/// ~~~
+// clang-format on
+unsigned int RunGraphs(std::vector<RResultHandle> handles);
+
+#ifndef R__WIN32
+// clang-format off
+/// Run the event loop of a computation graph in several worker processes and merge their results
+/// \param[in] handles The RResultHandles of the results to compute, see RResultHandle. They must all belong to the same computation graph.
+/// \param[in] nWorkers The maximum number of worker processes
+/// \return The number of entry ranges that have been processed by the worker processes
+///
+/// The entries of the dataset are split in at most nWorkers ranges: clusters are not split for a TTree, entries
+/// are split evenly for a TChain or an empty source. Each range is processed, sequentially, by a process forked
+/// with ROOT::TProcessExecutor after the computation graph has been jitted. The partial results are sent back to
+/// this process and merged with ROOT::Detail::RDF::MergeValues: only actions that support
+/// RActionBase::GetMergeableValue (e.g. Count, Sum, Mean, Min, Max, Histo*D, StdDev) can be computed this way.
+/// Data sources and trees with entry lists are not supported.
+///
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df("tree", "file.root");
+/// auto h = df.Filter("pt > 20").Histo1D("pt");
+/// auto n = df.Count();
+/// ROOT::RDF::RunMultiProcess({h, n}, 8);
+/// h->Draw(); // filled by the 8 worker processes
+/// ~~~
+// clang-format on
+unsigned int RunMultiProcess(std::vector<RResultHandle> handles, unsigned int nWorkers);
+#endif
+
+// clang-format off
+/// Store the code that RDataFrame jits before the event loops in shared libraries, reused by later jobs
+/// \param[in] directory The directory where the libraries are stored. It is created if needed.
+///
+/// The code that creates the nodes booked with string expressions (e.g. `Filter("x > 0")`) is compiled with ACLiC
+/// in a library whose name depends on the jitted code, the types of its columns and the ROOT version. Later event
+/// loops, in this or in other processes, that jit the same code load the library instead of compiling the code with
+/// the interpreter. The first event loop that needs a library is slower than with the interpreter, as it performs a
+/// full, optimized compilation.
+/// Code that uses types or functions that are only known to the interpreter cannot be compiled in a library: it is
+/// jitted by the interpreter, and the cache records the failure so that later jobs do not attempt the compilation
+/// again. The return types of the expressions are still inferred by the interpreter when the nodes are booked.
+///
+/// ~~~{.cpp}
+/// ROOT::RDF::EnableJitCache("/scratch/rdfjitcache");
+/// ROOT::RDataFrame df("tree", "file.root");
+/// auto h = df.Filter("pt > 20").Define("pt2", "pt * pt").Histo1D("pt2"); // jitted code is loaded from the cache
+/// ~~~
+// clang-format on
+void EnableJitCache(std::string_view directory);
+
+/// Jit the code of the event loops with the interpreter again, see EnableJitCache
+void DisableJitCache();
+
 } // namespace RDF
 } // namespace ROOT
 #endif
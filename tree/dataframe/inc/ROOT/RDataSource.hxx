@@ -204,6 +204,23 @@ public:
    // clang-format on
    virtual void Finalise() {}
 
+   // clang-format off
+   /// \brief Retrieve the smallest and largest value of a column in the cluster of entries that contains a given entry.
+   /// \param[in] columnName The name of the column
+   /// \param[in] entry The entry whose cluster is considered
+   /// \param[out] min The smallest value of the column in the cluster
+   /// \param[out] max The largest value of the column in the cluster
+   /// \param[out] end The end (exclusive) of the cluster of entries
+   /// RDataFrame uses these statistics to skip the clusters of entries that its leading filters reject, e.g. a
+   /// `Filter("run > 100")`. Returns *false* if the statistics are not available, which is the default.
+   /// This method can be called concurrently from multiple threads during an event-loop.
+   // clang-format on
+   virtual bool GetColumnStatistics(std::string_view /*columnName*/, ULong64_t /*entry*/, double & /*min*/,
+                                    double & /*max*/, ULong64_t & /*end*/)
+   {
+      return false;
+   }
+
    /// \brief Return a string representation of the datasource type.
    /// The returned string will be used by ROOT::RDF::SaveGraph() to represent
    /// the datasource in the visualization of the computation graph.
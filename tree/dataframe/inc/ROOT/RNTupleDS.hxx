@@ -33,6 +33,9 @@ class REntry;
 
 
 class RNTupleDS final : public ROOT::RDF::RDataSource {
+   /// In multi-threaded runs, the entry ranges are made of whole clusters; aim for these many ranges per slot
+   static constexpr unsigned int kTasksPerSlotHint = 10;
+
    /// Clones of the first reader, one for each slot
    std::vector<std::unique_ptr<ROOT::Experimental::RNTupleReader>> fReaders;
    std::vector<std::unique_ptr<ROOT::Experimental::REntry>> fEntries;
@@ -53,6 +56,8 @@ public:
    std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() final;
 
    bool SetEntry(unsigned int slot, ULong64_t entry) final;
+   bool GetColumnStatistics(std::string_view colName, ULong64_t entry, double &min, double &max,
+                            ULong64_t &end) final;
 
    void Initialise() final;
 
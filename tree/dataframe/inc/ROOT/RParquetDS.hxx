@@ -0,0 +1,88 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RPARQUETDS
+#define ROOT_RPARQUETDS
+
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDataSource.hxx"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ROOT {
+
+namespace RDF {
+
+class RParquetDS final : public RDataSource {
+private:
+   /// A selection of the form `column op value`, see the constructor
+   struct RCut {
+      enum class EOp { kLess, kLessEqual, kGreater, kGreaterEqual, kEqual, kNotEqual };
+      std::size_t fColumn; ///< Index of the column in fColumnNames
+      EOp fOp;
+      double fValue;
+   };
+
+   /// A row group of one of the files, with the number of its first entry in the whole dataset
+   struct RRowGroup {
+      std::size_t fFile;
+      int fIndex;
+      ULong64_t fFirstEntry;
+      ULong64_t fNEntries;
+   };
+   struct RSlotData; // defined in RParquetDS.cxx, to avoid exposing arrow and parquet headers
+
+   std::vector<std::string> fFileNames;
+   std::vector<std::string> fColumnNames;
+   std::vector<std::string> fColumnTypes;
+   std::vector<std::vector<int>> fLeafIndices; ///< Parquet leaf columns of each column
+   std::vector<RCut> fCuts;
+   std::vector<RRowGroup> fRowGroups;  ///< Row groups not rejected by the cuts, in entry order
+   ULong64_t fNRejectedRowGroups = 0ULL;
+   std::vector<std::size_t> fReadColumns; ///< Columns read from the files: the ones requested and the ones cut on
+   std::vector<std::vector<void *>> fColAddresses; ///< fColAddresses[column][slot]
+   std::vector<std::unique_ptr<RSlotData>> fSlots;
+   std::size_t fNextRowGroup = 0;
+   unsigned int fNSlots = 0U;
+
+   std::vector<void *> GetColumnReadersImpl(std::string_view name, const std::type_info &) final;
+   std::size_t GetColumnIndex(std::string_view colName) const;
+   void LoadRowGroup(unsigned int slot, ULong64_t entry);
+
+public:
+   RParquetDS(const std::vector<std::string> &fileNames, const std::vector<std::string> &selection = {});
+   ~RParquetDS();
+   const std::vector<std::string> &GetColumnNames() const final;
+   std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() final;
+   std::string GetTypeName(std::string_view colName) const final;
+   bool HasColumn(std::string_view colName) const final;
+   bool SetEntry(unsigned int slot, ULong64_t entry) final;
+   void SetNSlots(unsigned int nSlots) final;
+   void Initialise() final;
+   void Finalise() final;
+   std::string GetLabel() final;
+   /// Return the number of row groups that are never read because the statistics show that the selection rejects
+   /// all of their entries.
+   ULong64_t GetNRejectedRowGroups() const { return fNRejectedRowGroups; }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Factory method to create a RDataFrame that reads Apache Parquet files.
+/// \param[in] fileNames Paths or URIs of the Parquet files, which must have the same schema.
+/// \param[in] selection Cuts of the form `column op value` that the entries must pass, see RParquetDS.
+RDataFrame
+MakeParquetDataFrame(const std::vector<std::string> &fileNames, const std::vector<std::string> &selection = {});
+
+} // namespace RDF
+
+} // namespace ROOT
+
+#endif
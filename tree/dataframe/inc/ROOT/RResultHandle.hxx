@@ -0,0 +1,154 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RRESULTHANDLE
+#define ROOT_RRESULTHANDLE
+
+#include "ROOT/RResultPtr.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RDF/RActionBase.hxx"
+#include "ROOT/RDF/RMergeableValue.hxx"
+#include "ROOT/RDF/Utils.hxx" // TypeID2TypeName
+
+#include <memory>
+#include <sstream>
+#include <typeinfo>
+#include <stdexcept> // std::runtime_error
+#include <type_traits>
+#include <vector>
+
+namespace ROOT {
+namespace RDF {
+
+/// A type-erased version of RResultPtr, e.g. to collect the results of different actions (and different
+/// computation graphs) in one container, see RunGraphs().
+/**
+\class ROOT::RDF::RResultHandle
+\ingroup dataframe
+\brief A type-erased wrapper around the result of a RDataFrame action.
+
+~~~{.cpp}
+std::vector<ROOT::RDF::RResultHandle> handles{df1.Count(), df2.Histo1D("x")};
+ROOT::RDF::RunGraphs(handles);
+auto n = handles[0].GetValue<ULong64_t>();
+~~~
+*/
+class RResultHandle {
+   ROOT::Detail::RDF::RLoopManager *fLoopManager = nullptr; ///< Pointer to the loop manager
+   /// Owning pointer to the action that will produce this result.
+   /// Ownership is shared with RResultPtrs and RResultHandles that refer to the same result.
+   std::shared_ptr<ROOT::Internal::RDF::RActionBase> fActionPtr;
+   std::shared_ptr<void> fObjPtr; ///< Type erased shared pointer encapsulating the wrapped result
+   const std::type_info *fType = nullptr; ///< Type of the wrapped result
+   using Mergeables_t = std::vector<std::unique_ptr<ROOT::Detail::RDF::RMergeableValueBase>>;
+   /// Merge partial results of the action and store the merged value in the wrapped result, see MergeResults.
+   /// Null if the type of the result cannot be assigned to.
+   void (*fMergeResults)(void *, Mergeables_t &) = nullptr;
+
+   // The ROOT::RDF::RunGraphs helper has to access the loop manager to check whether two RResultHandles belong to
+   // the same computation graph
+   friend unsigned int RunGraphs(std::vector<RResultHandle>);
+   // ROOT::RDF::RunMultiProcess has to access the actions to merge the results of the worker processes
+   friend unsigned int RunMultiProcess(std::vector<RResultHandle>, unsigned int);
+
+   /// Merge the partial results, which must wrap values of type T, and assign the merged value to `*result`.
+   template <class T>
+   static void MergeResults(void *result, Mergeables_t &partials)
+   {
+      using ROOT::Detail::RDF::RMergeableValue;
+      auto merged = dynamic_cast<RMergeableValue<T> *>(partials.at(0).get());
+      if (!merged)
+         throw std::runtime_error("The partial results of the action do not hold values of type " +
+                                  ROOT::Internal::RDF::TypeID2TypeName(typeid(T)) + ".");
+      for (auto i = 1u; i < partials.size(); ++i)
+         ROOT::Detail::RDF::MergeValues(*merged, static_cast<const RMergeableValue<T> &>(*partials[i]));
+      *static_cast<T *>(result) = merged->GetValue();
+   }
+
+   template <class T>
+   static constexpr auto GetMergeResults(std::true_type /*isAssignable*/) -> void (*)(void *, Mergeables_t &)
+   {
+      return &MergeResults<T>;
+   }
+
+   template <class T>
+   static constexpr auto GetMergeResults(std::false_type /*isAssignable*/) -> void (*)(void *, Mergeables_t &)
+   {
+      return nullptr;
+   }
+
+   /// Get the pointer to the encapsulated result.
+   /// Ownership is not transferred to the caller.
+   /// Triggers event loop and execution of all actions booked in the associated RLoopManager.
+   void *Get()
+   {
+      if (!fActionPtr->HasRun())
+         fLoopManager->RunForAction(*fActionPtr);
+      return fObjPtr.get();
+   }
+
+   /// Compare given type to the type of the wrapped result and throw if the types don't match.
+   void CheckType(const std::type_info &type)
+   {
+      if (*fType != type) {
+         std::stringstream ss;
+         ss << "Got the type " << ROOT::Internal::RDF::TypeID2TypeName(type)
+            << " but the RResultHandle refers to a result of type " << ROOT::Internal::RDF::TypeID2TypeName(*fType)
+            << ".";
+         throw std::runtime_error(ss.str());
+      }
+   }
+
+public:
+   template <class T>
+   RResultHandle(const RResultPtr<T> &resultPtr)
+      : fLoopManager(resultPtr.fLoopManager), fActionPtr(resultPtr.fActionPtr), fObjPtr(resultPtr.fObjPtr),
+        fType(&typeid(T)), fMergeResults(GetMergeResults<T>(std::is_copy_assignable<T>{}))
+   {
+   }
+
+   RResultHandle(const RResultHandle &) = default;
+   RResultHandle(RResultHandle &&) = default;
+   RResultHandle &operator=(const RResultHandle &) = default;
+   RResultHandle &operator=(RResultHandle &&) = default;
+
+   /// Get the pointer to the encapsulated result, triggering the event loop if needed.
+   /// Ownership is not transferred to the caller.
+   /// Throws if the given type is not the type of the wrapped result.
+   template <class T>
+   T *GetPtr()
+   {
+      CheckType(typeid(T));
+      return static_cast<T *>(Get());
+   }
+
+   /// Get a reference to the encapsulated result, triggering the event loop if needed.
+   /// Throws if the given type is not the type of the wrapped result.
+   template <class T>
+   const T &GetValue()
+   {
+      CheckType(typeid(T));
+      return *static_cast<T *>(Get());
+   }
+
+   /// Check whether the result has already been computed
+   bool IsReady() const
+   {
+      if (fActionPtr == nullptr)
+         return false;
+      return fActionPtr->HasRun();
+   }
+
+   bool operator==(const RResultHandle &rhs) const { return fObjPtr == rhs.fObjPtr; }
+   bool operator!=(const RResultHandle &rhs) const { return !(fObjPtr == rhs.fObjPtr); }
+};
+
+} // namespace RDF
+} // namespace ROOT
+
+#endif // ROOT_RRESULTHANDLE
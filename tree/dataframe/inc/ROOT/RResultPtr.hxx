@@ -33,6 +33,7 @@ namespace RDF {
 // Fwd decl for MakeResultPtr
 template <typename T>
 class RResultPtr;
+class RResultHandle;
 } // namespace RDF
 
 namespace Detail {
@@ -103,6 +104,8 @@ class RResultPtr {
 
    friend class ROOT::Internal::RDF::GraphDrawing::GraphCreatorHelper;
 
+   friend class RResultHandle;
+
    /// \cond HIDDEN_SYMBOLS
    template <typename V, bool hasBeginEnd = TTraits::HasBeginAndEnd<V>::value>
    struct RIterationHelper {
@@ -304,7 +307,7 @@ public:
 template <typename T>
 void RResultPtr<T>::TriggerRun()
 {
-   fLoopManager->Run();
+   fLoopManager->RunForAction(*fActionPtr);
 }
 
 template <class T1, class T2>
@@ -37,6 +37,13 @@ struct RSnapshotOptions {
    int fSplitLevel = 99;                       ///< Split level of output tree
    bool fLazy = false;                         ///< Do not start the event loop when Snapshot is called
    bool fOverwriteIfExists = false; ///< If fMode is "UPDATE", overwrite object in output file if it already exists
+   /// In multi-thread runs, write the output of each processing slot to its own file, without synchronization
+   /// between the slots, and merge these files into the output file with a fast basket copy at the end of the
+   /// event loop
+   bool fOutputFilePerSlot = false;
+   /// In multi-thread runs, write the entries in the order of the input dataset. The output of each task is kept in
+   /// memory until all previous tasks have written theirs.
+   bool fOrdered = false;
 };
 } // ns RDF
 } // ns ROOT
@@ -0,0 +1,86 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RSQLDS
+#define ROOT_RSQLDS
+
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDataSource.hxx"
+#include "ROOT/RStringView.hxx"
+
+#include "TString.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class TSQLServer;
+class TSQLStatement;
+
+namespace ROOT {
+
+namespace RDF {
+
+class RSqlDS final : public ROOT::RDF::RDataSource {
+
+private:
+   // Possible values are L, D and S, the type codes of TSQLStatement::NextResultRows for Long64_t, double and string
+   using ColType_t = char;
+
+   std::unique_ptr<TSQLServer> fServer;
+   std::unique_ptr<TSQLStatement> fStmt; ///< Statement of the running event loop, deleted before the server
+   const std::string fQuery;
+   const Int_t fRowsChunkSize;
+   unsigned int fNSlots = 0U;
+   ULong64_t fProcessedRows = 0ULL;  // marks the progress of the consumption of the result set
+   ULong64_t fChunkFirstEntry = 0ULL; // entry number of the first row of the current chunk
+   std::vector<std::string> fColumnNames;
+   std::vector<ColType_t> fColTypes;
+   std::vector<bool> fColIsActive;                     // only the columns read by the RDataFrame are fetched
+   std::vector<std::vector<void *>> fColAddresses;     // fColAddresses[column][slot]
+   std::vector<std::vector<Long64_t>> fLong64Values;   // values of the current chunk, one vector per column
+   std::vector<std::vector<double>> fDoubleValues;     // values of the current chunk, one vector per column
+   std::vector<std::vector<TString>> fStringValues;    // values of the current chunk, one vector per column
+   std::vector<std::vector<std::string>> fStringEvtValues; // one per column per slot
+
+   TSQLStatement *ExecuteQuery();
+   void InferColTypes();
+   ColType_t GetType(std::string_view colName) const;
+
+protected:
+   Record_t GetColumnReadersImpl(std::string_view name, const std::type_info &) final;
+
+public:
+   RSqlDS(std::string_view url, std::string_view query, std::string_view user = "", std::string_view password = "",
+          Int_t rowsChunkSize = 10000);
+   ~RSqlDS();
+   void SetNSlots(unsigned int nSlots) final;
+   const std::vector<std::string> &GetColumnNames() const final;
+   bool HasColumn(std::string_view colName) const final;
+   std::string GetTypeName(std::string_view colName) const final;
+   std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() final;
+   bool SetEntry(unsigned int slot, ULong64_t entry) final;
+   void Initialise() final;
+   void Finalise() final;
+   std::string GetLabel() final;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Factory method to create a RDataFrame reading the result set of a SQL query.
+/// \param[in] url URL of the database, as accepted by TSQLServer::Connect, e.g. "mysql://host/db".
+/// \param[in] query SELECT query.
+/// \param[in] user User name for the connection.
+/// \param[in] password Password for the connection.
+RDataFrame MakeSqlDataFrame(std::string_view url, std::string_view query, std::string_view user = "",
+                            std::string_view password = "");
+
+} // ns RDF
+
+} // ns ROOT
+
+#endif
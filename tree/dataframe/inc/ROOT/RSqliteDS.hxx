@@ -48,6 +48,11 @@ is used:
   - For expressions ("SELECT 1+1 FROM table"), the type of the first row of the result set determines the column type.
     That can result in a column to be of thought of type NULL where subsequent rows actually have meaningful values.
     The provided SELECT query can be used to avoid such ambiguities.
+
+With more than one slot, e.g. with implicit multi-threading enabled, the result set is split into one window of
+consecutive rows per slot. Each slot reads its window through its own database connection with the query
+"SELECT * FROM (query) LIMIT n OFFSET m". The rows of a window are thus only well defined if the order of the result
+set is, e.g. if the query has an ORDER BY clause or reads a single table.
 */
 class RSqliteDS final : public ROOT::RDF::RDataSource {
 private:
@@ -83,8 +88,8 @@ private:
    ULong64_t fNRow;
    std::vector<std::string> fColumnNames;
    std::vector<ETypes> fColumnTypes;
-   /// The data source is inherently single-threaded and returns only one row at a time. This vector holds the results.
-   std::vector<Value_t> fValues;
+   /// The values of the current row of each slot, by slot and column
+   std::vector<std::vector<Value_t>> fValues;
 
    // clang-format off
    /// Corresponds to the types defined in ETypes.
@@ -106,6 +111,7 @@ public:
    std::string GetTypeName(std::string_view colName) const final;
    std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() final;
    bool SetEntry(unsigned int slot, ULong64_t entry) final;
+   void InitSlot(unsigned int slot, ULong64_t firstEntry) final;
    void Initialise() final;
    std::string GetLabel() final;
 
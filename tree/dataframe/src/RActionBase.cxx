@@ -18,3 +18,8 @@ RActionBase::RActionBase(RLoopManager *lm, const ColumnNames_t &colNames, RBooke
 
 // outlined to pin virtual table
 RActionBase::~RActionBase() {}
+
+void RActionBase::AddInputBranchNames(std::set<std::string> &branchNames) const
+{
+   fCustomColumns.AddInputBranchNames(fColumnNames, branchNames);
+}
@@ -0,0 +1,118 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RArrowBatches.hxx"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using ROOT::Internal::RDF::RArrowLayout;
+
+namespace {
+/// What an exported array owns. Every array, children included, shares the ownership of the buffers, so that
+/// consumers can also move the children out of their parent.
+struct RArrayData {
+   std::shared_ptr<void> fOwner;
+   std::vector<const void *> fBuffers;
+   std::vector<ArrowArray> fChildren;
+   std::vector<ArrowArray *> fChildPtrs;
+};
+
+/// What an exported schema owns
+struct RSchemaData {
+   std::string fFormat;
+   std::string fName;
+   std::vector<ArrowSchema> fChildren;
+   std::vector<ArrowSchema *> fChildPtrs;
+};
+
+void ReleaseArray(ArrowArray *array)
+{
+   auto data = static_cast<RArrayData *>(array->private_data);
+   for (auto child : data->fChildPtrs)
+      if (child->release)
+         child->release(child);
+   delete data;
+   array->release = nullptr;
+}
+
+void ReleaseSchema(ArrowSchema *schema)
+{
+   auto data = static_cast<RSchemaData *>(schema->private_data);
+   for (auto child : data->fChildPtrs)
+      if (child->release)
+         child->release(child);
+   delete data;
+   schema->release = nullptr;
+}
+
+void ExportArray(const RArrowLayout &layout, const std::shared_ptr<void> &owner, ArrowArray &array)
+{
+   auto data = new RArrayData{owner, layout.fBuffers, std::vector<ArrowArray>(layout.fChildren.size()), {}};
+   for (std::size_t i = 0; i < layout.fChildren.size(); ++i) {
+      ExportArray(layout.fChildren[i], owner, data->fChildren[i]);
+      data->fChildPtrs.emplace_back(&data->fChildren[i]);
+   }
+   array.length = layout.fLength;
+   array.null_count = 0;
+   array.offset = 0;
+   array.n_buffers = static_cast<int64_t>(data->fBuffers.size());
+   array.n_children = static_cast<int64_t>(data->fChildPtrs.size());
+   array.buffers = data->fBuffers.data();
+   array.children = data->fChildPtrs.empty() ? nullptr : data->fChildPtrs.data();
+   array.dictionary = nullptr;
+   array.release = &ReleaseArray;
+   array.private_data = data;
+}
+
+void ExportSchema(const RArrowLayout &layout, ArrowSchema &schema)
+{
+   auto data = new RSchemaData{layout.fFormat, layout.fName, std::vector<ArrowSchema>(layout.fChildren.size()), {}};
+   for (std::size_t i = 0; i < layout.fChildren.size(); ++i) {
+      ExportSchema(layout.fChildren[i], data->fChildren[i]);
+      data->fChildPtrs.emplace_back(&data->fChildren[i]);
+   }
+   schema.format = data->fFormat.c_str();
+   schema.name = data->fName.c_str();
+   schema.metadata = nullptr;
+   schema.flags = 0; // values are never missing
+   schema.n_children = static_cast<int64_t>(data->fChildPtrs.size());
+   schema.children = data->fChildPtrs.empty() ? nullptr : data->fChildPtrs.data();
+   schema.dictionary = nullptr;
+   schema.release = &ReleaseSchema;
+   schema.private_data = data;
+}
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////
+/// \brief Move a batch into structs of the Arrow C data interface, without copying its values.
+/// \param[in] batch The index of the batch, smaller than GetNBatches().
+/// \param[out] array The struct that receives the values of the batch, as a struct array with one child per column.
+/// \param[out] schema The struct that receives the description of the fields of the batch.
+///
+/// The batch is not owned by this object anymore: the release callbacks of the structs free its memory. Each batch
+/// can therefore be exported only once.
+void ROOT::RDF::RArrowBatches::Export(std::size_t batch, ArrowArray *array, ArrowSchema *schema)
+{
+   auto &theBatch = fBatches.at(batch);
+   if (theBatch.fExported)
+      throw std::runtime_error("RArrowBatches: batch " + std::to_string(batch) + " has already been exported.");
+
+   RArrowLayout layout{"+s", "", static_cast<std::int64_t>(theBatch.fNEntries), {nullptr}, {}};
+   for (std::size_t i = 0; i < theBatch.fColumns.size(); ++i) {
+      layout.fChildren.emplace_back(theBatch.fColumns[i]->GetLayout());
+      layout.fChildren.back().fName = fColumnNames[i];
+   }
+
+   auto owner = std::make_shared<Columns_t>(std::move(theBatch.fColumns));
+   theBatch.fExported = true;
+   ExportArray(layout, owner, *array);
+   ExportSchema(layout, *schema);
+}
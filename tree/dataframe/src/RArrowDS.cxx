@@ -36,170 +36,12 @@ arrow::Schema.
 #include <sstream>
 #include <string>
 
-#if defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wshadow"
-#pragma GCC diagnostic ignored "-Wunused-parameter"
-#endif
-#include <arrow/table.h>
-#include <arrow/stl.h>
-#if defined(__GNUC__)
-#pragma GCC diagnostic pop
-#endif
+#include "RArrowUtils.hxx"
 
 namespace ROOT {
 namespace Internal {
 namespace RDF {
 
-// This is needed by Arrow 0.12.0 which dropped 
-//
-//      using ArrowType = ArrowType_;
-//
-// from ARROW_STL_CONVERSION
-template <typename T>
-struct RootConversionTraits {};
-
-#define ROOT_ARROW_STL_CONVERSION(c_type, ArrowType_)  \
-   template <>                                         \
-   struct RootConversionTraits<c_type> {               \
-   using ArrowType = ::arrow::ArrowType_;              \
-   };
-
-ROOT_ARROW_STL_CONVERSION(bool, BooleanType)
-ROOT_ARROW_STL_CONVERSION(int8_t, Int8Type)
-ROOT_ARROW_STL_CONVERSION(int16_t, Int16Type)
-ROOT_ARROW_STL_CONVERSION(int32_t, Int32Type)
-ROOT_ARROW_STL_CONVERSION(Long64_t, Int64Type)
-ROOT_ARROW_STL_CONVERSION(uint8_t, UInt8Type)
-ROOT_ARROW_STL_CONVERSION(uint16_t, UInt16Type)
-ROOT_ARROW_STL_CONVERSION(uint32_t, UInt32Type)
-ROOT_ARROW_STL_CONVERSION(ULong64_t, UInt64Type)
-ROOT_ARROW_STL_CONVERSION(float, FloatType)
-ROOT_ARROW_STL_CONVERSION(double, DoubleType)
-ROOT_ARROW_STL_CONVERSION(std::string, StringType)
-
-// Per slot visitor of an Array.
-class ArrayPtrVisitor : public ::arrow::ArrayVisitor {
-private:
-   /// The pointer to update.
-   void **fResult;
-   bool fCachedBool{false}; // Booleans need to be unpacked, so we use a cached entry.
-   // FIXME: I should really use a variant here
-   RVec<float> fCachedRVecFloat;
-   RVec<double> fCachedRVecDouble;
-   RVec<ULong64_t> fCachedRVecULong64;
-   RVec<UInt_t> fCachedRVecUInt;
-   RVec<Long64_t> fCachedRVecLong64;
-   RVec<Int_t> fCachedRVecInt;
-   std::string fCachedString;
-   /// The entry in the array which should be looked up.
-   ULong64_t fCurrentEntry;
-
-   template <typename T>
-   void *getTypeErasedPtrFrom(arrow::ListArray const &array, int32_t entry, RVec<T> &cache)
-   {
-      using ArrowType = typename RootConversionTraits<T>::ArrowType;
-      using ArrayType = typename arrow::TypeTraits<ArrowType>::ArrayType;
-      auto values = reinterpret_cast<ArrayType *>(array.values().get());
-      auto offset = array.value_offset(entry);
-      // Here the cast to void* is a worksround while we figure out the
-      // issues we have with long long types, signed and unsigned.
-      RVec<T> tmp(reinterpret_cast<T *>((void *)values->raw_values()) + offset, array.value_length(entry));
-      std::swap(cache, tmp);
-      return (void *)(&cache);
-   }
-
-public:
-   ArrayPtrVisitor(void **result) : fResult{result}, fCurrentEntry{0} {}
-
-   void SetEntry(ULong64_t entry) { fCurrentEntry = entry; }
-
-   /// Check if we are asking the same entry as before.
-   virtual arrow::Status Visit(arrow::Int32Array const &array) final
-   {
-      *fResult = (void *)(array.raw_values() + fCurrentEntry);
-      return arrow::Status::OK();
-   }
-
-   virtual arrow::Status Visit(arrow::Int64Array const &array) final
-   {
-      *fResult = (void *)(array.raw_values() + fCurrentEntry);
-      return arrow::Status::OK();
-   }
-
-   /// Check if we are asking the same entry as before.
-   virtual arrow::Status Visit(arrow::UInt32Array const &array) final
-   {
-      *fResult = (void *)(array.raw_values() + fCurrentEntry);
-      return arrow::Status::OK();
-   }
-
-   virtual arrow::Status Visit(arrow::UInt64Array const &array) final
-   {
-      *fResult = (void *)(array.raw_values() + fCurrentEntry);
-      return arrow::Status::OK();
-   }
-
-   virtual arrow::Status Visit(arrow::FloatArray const &array) final
-   {
-      *fResult = (void *)(array.raw_values() + fCurrentEntry);
-      return arrow::Status::OK();
-   }
-
-   virtual arrow::Status Visit(arrow::DoubleArray const &array) final
-   {
-      *fResult = (void *)(array.raw_values() + fCurrentEntry);
-      return arrow::Status::OK();
-   }
-
-   virtual arrow::Status Visit(arrow::BooleanArray const &array) final
-   {
-      fCachedBool = array.Value(fCurrentEntry);
-      *fResult = reinterpret_cast<void *>(&fCachedBool);
-      return arrow::Status::OK();
-   }
-
-   virtual arrow::Status Visit(arrow::StringArray const &array) final
-   {
-      fCachedString = array.GetString(fCurrentEntry);
-      *fResult = reinterpret_cast<void *>(&fCachedString);
-      return arrow::Status::OK();
-   }
-
-   virtual arrow::Status Visit(arrow::ListArray const &array) final
-   {
-      switch (array.value_type()->id()) {
-      case arrow::Type::FLOAT: {
-         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecFloat);
-         return arrow::Status::OK();
-      }
-      case arrow::Type::DOUBLE: {
-         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecDouble);
-         return arrow::Status::OK();
-      }
-      case arrow::Type::UINT32: {
-         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecUInt);
-         return arrow::Status::OK();
-      }
-      case arrow::Type::UINT64: {
-         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecULong64);
-         return arrow::Status::OK();
-      }
-      case arrow::Type::INT32: {
-         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecInt);
-         return arrow::Status::OK();
-      }
-      case arrow::Type::INT64: {
-         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecLong64);
-         return arrow::Status::OK();
-      }
-      default: return arrow::Status::TypeError("Type not supported");
-      }
-   }
-
-   using ::arrow::ArrayVisitor::Visit;
-};
-
 /// Helper class which keeps track for each slot where to get the entry.
 class TValueGetter {
 private:
@@ -291,95 +133,6 @@ public:
 
 namespace RDF {
 
-/// Helper to get the contents of a given column
-
-/// Helper to get the human readable name of type
-class RDFTypeNameGetter : public ::arrow::TypeVisitor {
-private:
-   std::vector<std::string> fTypeName;
-
-public:
-   arrow::Status Visit(const arrow::Int64Type &) override
-   {
-      fTypeName.push_back("Long64_t");
-      return arrow::Status::OK();
-   }
-   arrow::Status Visit(const arrow::Int32Type &) override
-   {
-      fTypeName.push_back("Int_t");
-      return arrow::Status::OK();
-   }
-   arrow::Status Visit(const arrow::UInt64Type &) override
-   {
-      fTypeName.push_back("ULong64_t");
-      return arrow::Status::OK();
-   }
-   arrow::Status Visit(const arrow::UInt32Type &) override
-   {
-      fTypeName.push_back("UInt_t");
-      return arrow::Status::OK();
-   }
-   arrow::Status Visit(const arrow::FloatType &) override
-   {
-      fTypeName.push_back("float");
-      return arrow::Status::OK();
-   }
-   arrow::Status Visit(const arrow::DoubleType &) override
-   {
-      fTypeName.push_back("double");
-      return arrow::Status::OK();
-   }
-   arrow::Status Visit(const arrow::StringType &) override
-   {
-      fTypeName.push_back("string");
-      return arrow::Status::OK();
-   }
-   arrow::Status Visit(const arrow::BooleanType &) override
-   {
-      fTypeName.push_back("bool");
-      return arrow::Status::OK();
-   }
-   arrow::Status Visit(const arrow::ListType &l) override
-   {
-      /// Recursively visit List types and map them to
-      /// an RVec. We accumulate the result of the recursion on
-      /// fTypeName so that we can create the actual type
-      /// when the recursion is done.
-      fTypeName.push_back("ROOT::VecOps::RVec<%s>");
-      return l.value_type()->Accept(this);
-   }
-   std::string result()
-   {
-      // This recursively builds a nested type.
-      std::string result = "%s";
-      char buffer[8192];
-      for (size_t i = 0; i < fTypeName.size(); ++i) {
-         snprintf(buffer, 8192, result.c_str(), fTypeName[i].c_str());
-         result = buffer;
-      }
-      return result;
-   }
-
-   using ::arrow::TypeVisitor::Visit;
-};
-
-/// Helper to determine if a given Column is a supported type.
-class VerifyValidColumnType : public ::arrow::TypeVisitor {
-private:
-public:
-   virtual arrow::Status Visit(const arrow::Int64Type &) override { return arrow::Status::OK(); }
-   virtual arrow::Status Visit(const arrow::UInt64Type &) override { return arrow::Status::OK(); }
-   virtual arrow::Status Visit(const arrow::Int32Type &) override { return arrow::Status::OK(); }
-   virtual arrow::Status Visit(const arrow::UInt32Type &) override { return arrow::Status::OK(); }
-   virtual arrow::Status Visit(const arrow::FloatType &) override { return arrow::Status::OK(); }
-   virtual arrow::Status Visit(const arrow::DoubleType &) override { return arrow::Status::OK(); }
-   virtual arrow::Status Visit(const arrow::StringType &) override { return arrow::Status::OK(); }
-   virtual arrow::Status Visit(const arrow::BooleanType &) override { return arrow::Status::OK(); }
-   virtual arrow::Status Visit(const arrow::ListType &) override { return arrow::Status::OK(); }
-
-   using ::arrow::TypeVisitor::Visit;
-};
-
 ////////////////////////////////////////////////////////////////////////
 /// Constructor to create an Arrow RDataSource for RDataFrame.
 /// \param[in] table the arrow Table to observe.
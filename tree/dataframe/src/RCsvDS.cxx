@@ -22,14 +22,17 @@ ROOT::RDF::MakeCsvDataFrame, which accepts three parameters:
 not (optional, default `true`). If `false`, header names will be automatically generated as Col0, Col1, ..., ColN.
 3. Delimiter (optional, default ',').
 
-The types of the columns in the CSV file are automatically inferred. The supported
-types are:
+The types of the columns in the CSV file are automatically inferred from the first records of the file.
+The supported types are:
 - Integer: stored as a 64-bit long long int.
 - Floating point number: stored with double precision.
 - Boolean: matches the literals `true` and `false`.
 - String: stored as an std::string, matches anything that does not fall into any of the
 previous types.
 
+If the records disagree, the widest type is chosen: a column with both integer and floating point values is
+a column of doubles, any other mix is a column of strings.
+
 These are some formatting rules expected by the RCsvDS implementation:
 - All records must have the same number of fields, in the same order.
 - Any field may be quoted.
@@ -65,9 +68,10 @@ double-quote characters must be represented by a pair of double-quote characters
     2000,Mercury,Cougar
 ~~~
 
-The current implementation of RCsvDS reads the entire CSV file content into memory before
-RDataFrame starts processing it. Therefore, before creating a CSV RDataFrame, it is
-important to check both how much memory is available and the size of the CSV file.
+The CSV file is read in chunks of lines: at most `linesChunkSize` lines if this parameter of
+ROOT::RDF::MakeCsvDataFrame is positive, and at most about 64 MB of text in any case. Only the text of
+the current chunk is kept in memory. The lines are parsed when they are processed, concurrently by the
+processing slots if implicit multi-threading is enabled.
 */
 // clang-format on
 
@@ -82,6 +86,26 @@ important to check both how much memory is available and the size of the CSV fil
 #include <sstream>
 #include <string>
 
+namespace {
+/// Maximum size of the text of a chunk of lines, see RCsvDS::ReadChunk
+constexpr std::size_t kMaxChunkBytes = 64u * 1024u * 1024u;
+/// Size of each read from the CSV file
+constexpr std::size_t kReadBytes = 1024u * 1024u;
+/// Number of records used to infer the types of the columns
+constexpr unsigned int kNTypeInferenceLines = 10u;
+
+/// Return the type of a column whose values are of type `a` and `b`: numbers are widened to double, any other
+/// mix of types to string.
+char WidenType(char a, char b)
+{
+   if (a == b)
+      return a;
+   if ((a == 'l' && b == 'd') || (a == 'd' && b == 'l'))
+      return 'd';
+   return 's';
+}
+} // anonymous namespace
+
 namespace ROOT {
 
 namespace RDF {
@@ -110,41 +134,6 @@ void RCsvDS::FillHeaders(const std::string &line)
    }
 }
 
-void RCsvDS::FillRecord(const std::string &line, Record_t &record)
-{
-   std::istringstream lineStream(line);
-   auto i = 0U;
-
-   auto columns = ParseColumns(line);
-
-   for (auto &col : columns) {
-      auto colType = fColTypes[fHeaders[i]];
-
-      switch (colType) {
-      case 'd': {
-         record.emplace_back(new double(std::stod(col)));
-         break;
-      }
-      case 'l': {
-         record.emplace_back(new Long64_t(std::stoll(col)));
-         break;
-      }
-      case 'b': {
-         auto b = new bool();
-         record.emplace_back(b);
-         std::istringstream is(col);
-         is >> std::boolalpha >> *b;
-         break;
-      }
-      case 's': {
-         record.emplace_back(new std::string(col));
-         break;
-      }
-      }
-      ++i;
-   }
-}
-
 void RCsvDS::GenerateHeaders(size_t size)
 {
    for (size_t i = 0; i < size; ++i) {
@@ -184,16 +173,20 @@ std::vector<void *> RCsvDS::GetColumnReadersImpl(std::string_view colName, const
    return ret;
 }
 
+/// Update the types of the columns with the values of one record.
 void RCsvDS::InferColTypes(std::vector<std::string> &columns)
 {
-   auto i = 0U;
-   for (auto &col : columns) {
-      InferType(col, i);
-      ++i;
+   const bool firstRecord = fColTypesList.empty();
+   for (auto i = 0U; i < columns.size(); ++i) {
+      const auto type = InferType(columns[i]);
+      if (firstRecord)
+         fColTypesList.push_back(type);
+      else if (i < fColTypesList.size())
+         fColTypesList[i] = WidenType(fColTypesList[i], type);
    }
 }
 
-void RCsvDS::InferType(const std::string &col, unsigned int idxCol)
+RCsvDS::ColType_t RCsvDS::InferType(const std::string &col) const
 {
    ColType_t type;
    int dummy;
@@ -211,24 +204,32 @@ void RCsvDS::InferType(const std::string &col, unsigned int idxCol)
    }
    // TODO: Date
 
-   fColTypes[fHeaders[idxCol]] = type;
-   fColTypesList.push_back(type);
+   return type;
 }
 
-std::vector<std::string> RCsvDS::ParseColumns(const std::string &line)
+std::vector<std::string> RCsvDS::ParseColumns(std::string_view line)
 {
    std::vector<std::string> columns;
+   ParseColumns(line, columns);
+   return columns;
+}
 
+/// Fill `columns` with the fields of the line, reusing the memory of the strings it already contains.
+void RCsvDS::ParseColumns(std::string_view line, std::vector<std::string> &columns)
+{
+   size_t nColumns = 0;
    for (size_t i = 0; i < line.size(); ++i) {
-      i = ParseValue(line, columns, i);
+      if (nColumns == columns.size())
+         columns.emplace_back();
+      auto &val = columns[nColumns++];
+      val.clear();
+      i = ParseValue(line, val, i);
    }
-
-   return columns;
+   columns.resize(nColumns);
 }
 
-size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &columns, size_t i)
+size_t RCsvDS::ParseValue(std::string_view line, std::string &val, size_t i)
 {
-   std::stringstream val;
    bool quoted = false;
 
    for (; i < line.size(); ++i) {
@@ -236,18 +237,16 @@ size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &col
          break;
       } else if (line[i] == '"') {
          // Keep just one quote for escaped quotes, none for the normal quotes
-         if (line[i + 1] != '"') {
+         if (i + 1 >= line.size() || line[i + 1] != '"') {
             quoted = !quoted;
          } else {
-            val << line[++i];
+            val += line[++i];
          }
       } else {
-         val << line[i];
+         val += line[i];
       }
    }
 
-   columns.emplace_back(val.str());
-
    return i;
 }
 
@@ -257,6 +256,7 @@ size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &col
 /// \param[in] readHeaders `true` if the CSV file contains headers as first row, `false` otherwise
 ///                        (default `true`).
 /// \param[in] delimiter Delimiter character (default ',').
+/// \param[in] linesChunkSize Maximum number of lines read from the file at a time, -1 for no limit (default -1).
 RCsvDS::RCsvDS(std::string_view fileName, bool readHeaders, char delimiter, Long64_t linesChunkSize) // TODO: Let users specify types?
    : fReadHeaders(readHeaders),
      fStream(std::string(fileName)),
@@ -277,57 +277,79 @@ RCsvDS::RCsvDS(std::string_view fileName, bool readHeaders, char delimiter, Long
    }
 
    fDataPos = fStream.tellg();
-   bool eof = false;
-   do {
-      eof = !std::getline(fStream, line);
-   } while (line.empty());
-   if (!eof) {
+   // Infer types of columns with the first records
+   auto nRecords = 0U;
+   while (nRecords < kNTypeInferenceLines && std::getline(fStream, line)) {
+      if (line.empty())
+         continue; // skip empty lines
       auto columns = ParseColumns(line);
 
       // Generate headers if not present
-      if (!fReadHeaders) {
+      if (0U == nRecords && !fReadHeaders) {
          GenerateHeaders(columns.size());
       }
 
-      // Infer types of columns with first record
       InferColTypes(columns);
-
-      // rewind
-      fStream.seekg(fDataPos);
-   } else {
+      ++nRecords;
+   }
+   if (0U == nRecords) {
       std::string msg = "Could not infer column types of CSV file ";
       msg += fileName;
       throw std::runtime_error(msg);
    }
+   for (auto i = 0U; i < std::min(fHeaders.size(), fColTypesList.size()); ++i)
+      fColTypes[fHeaders[i]] = fColTypesList[i];
+
+   // rewind
+   fStream.clear();
+   fStream.seekg(fDataPos);
 }
 
+/// Release the text of the current chunk of lines.
 void RCsvDS::FreeRecords()
 {
-   for (auto &record : fRecords) {
-      for (size_t i = 0; i < record.size(); ++i) {
-         void *p = record[i];
-         const auto colType = fColTypes[fHeaders[i]];
-         switch (colType) {
-         case 'd': {
-            delete static_cast<double *>(p);
-            break;
-         }
-         case 'l': {
-            delete static_cast<Long64_t *>(p);
-            break;
-         }
-         case 'b': {
-            delete static_cast<bool *>(p);
-            break;
+   fChunk.clear();
+   fChunk.shrink_to_fit();
+   fLines.clear();
+   fLines.shrink_to_fit();
+}
+
+/// Read the next chunk of lines from the file into fChunk, splitting it at newline boundaries.
+/// The chunk ends after fLinesChunkSize non-empty lines, if positive, or after the first line that brings its size
+/// above kMaxChunkBytes. The bytes read after the end of the chunk are kept for the next one.
+void RCsvDS::ReadChunk()
+{
+   fChunk.swap(fLeftover);
+   fLeftover.clear();
+   fLines.clear();
+
+   size_t lineStart = 0;
+   size_t searchFrom = 0;
+   while ((-1LL == fLinesChunkSize || static_cast<Long64_t>(fLines.size()) < fLinesChunkSize) &&
+          lineStart < kMaxChunkBytes) {
+      auto lineEnd = fChunk.find('\n', searchFrom);
+      if (lineEnd == std::string::npos) {
+         if (fStream) {
+            // the line continues after the bytes read so far
+            searchFrom = fChunk.size();
+            fChunk.resize(fChunk.size() + kReadBytes);
+            fStream.read(&fChunk[searchFrom], kReadBytes);
+            fChunk.resize(searchFrom + fStream.gcount());
+            continue;
          }
-         case 's': {
-            delete static_cast<std::string *>(p);
+         // last line of the file, without newline
+         if (lineStart == fChunk.size())
             break;
-         }
-         }
+         lineEnd = fChunk.size();
       }
+      if (lineEnd > lineStart) // skip empty lines
+         fLines.emplace_back(lineStart, lineEnd - lineStart);
+      lineStart = std::min(lineEnd + 1, fChunk.size());
+      searchFrom = lineStart;
    }
-   fRecords.clear();
+
+   fLeftover.assign(fChunk, lineStart, std::string::npos);
+   fChunk.resize(lineStart);
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -342,7 +364,8 @@ void RCsvDS::Finalise()
    fStream.clear();
    fStream.seekg(fDataPos);
    fProcessedLines = 0ULL;
-   fEntryRangesRequested = 0ULL;
+   fChunkFirstEntry = 0ULL;
+   fLeftover.clear();
    FreeRecords();
 }
 
@@ -353,35 +376,28 @@ const std::vector<std::string> &RCsvDS::GetColumnNames() const
 
 std::vector<std::pair<ULong64_t, ULong64_t>> RCsvDS::GetEntryRanges()
 {
-
-   // Read records and store them in memory
-   auto linesToRead = fLinesChunkSize;
-   FreeRecords();
-
-   std::string line;
-   while ((-1LL == fLinesChunkSize || 0 != linesToRead) && std::getline(fStream, line)) {
-      if (line.empty()) continue; // skip empty lines
-      fRecords.emplace_back();
-      FillRecord(line, fRecords.back());
-      --linesToRead;
-   }
+   // Read the text of the next lines, they are parsed by SetEntry
+   ReadChunk();
 
    if (gDebug > 0) {
       if (fLinesChunkSize == -1LL) {
-         Info("GetEntryRanges", "Attempted to read entire CSV file into memory, %zu lines read", fRecords.size());
+         Info("GetEntryRanges", "Read chunk of %zu bytes of CSV file into memory, %zu lines read", fChunk.size(),
+              fLines.size());
       } else {
-         Info("GetEntryRanges", "Attempted to read chunk of %lld lines of CSV file into memory, %zu lines read", fLinesChunkSize, fRecords.size());
+         Info("GetEntryRanges", "Attempted to read chunk of %lld lines of CSV file into memory, %zu lines read",
+              fLinesChunkSize, fLines.size());
       }
    }
 
    std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
-   const auto nRecords = fRecords.size();
+   const auto nRecords = fLines.size();
    if (0 == nRecords)
       return entryRanges;
 
    const auto chunkSize = nRecords / fNSlots;
    const auto remainder = 1U == fNSlots ? 0 : nRecords % fNSlots;
-   auto start = 0ULL == fEntryRangesRequested ? 0ULL : fProcessedLines;
+   fChunkFirstEntry = fProcessedLines;
+   auto start = fChunkFirstEntry;
    auto end = start;
 
    for (auto i : ROOT::TSeqU(fNSlots)) {
@@ -393,7 +409,6 @@ std::vector<std::pair<ULong64_t, ULong64_t>> RCsvDS::GetEntryRanges()
    entryRanges.back().second += remainder;
 
    fProcessedLines += nRecords;
-   fEntryRangesRequested++;
 
    return entryRanges;
 }
@@ -422,30 +437,34 @@ bool RCsvDS::HasColumn(std::string_view colName) const
 bool RCsvDS::SetEntry(unsigned int slot, ULong64_t entry)
 {
    // Here we need to normalise the entry to the number of lines we already processed.
-   const auto offset = (fEntryRangesRequested - 1) * fLinesChunkSize;
-   const auto recordPos = entry - offset;
-   int colIndex = 0;
-   for (auto &colType : fColTypesList) {
-      auto dataPtr = fRecords[recordPos][colIndex];
-      switch (colType) {
+   const auto &line = fLines[entry - fChunkFirstEntry];
+   // Parsing happens here, so that each slot parses its own lines
+   auto &columns = fSlotColumns[slot];
+   ParseColumns(std::string_view(fChunk).substr(line.first, line.second), columns);
+   const auto nColumns = std::min(columns.size(), fColTypesList.size());
+   for (auto colIndex = 0U; colIndex < nColumns; ++colIndex) {
+      auto &col = columns[colIndex];
+      switch (fColTypesList[colIndex]) {
       case 'd': {
-         fDoubleEvtValues[colIndex][slot] = *static_cast<double *>(dataPtr);
+         fDoubleEvtValues[colIndex][slot] = std::stod(col);
          break;
       }
       case 'l': {
-         fLong64EvtValues[colIndex][slot] = *static_cast<Long64_t *>(dataPtr);
+         fLong64EvtValues[colIndex][slot] = std::stoll(col);
          break;
       }
       case 'b': {
-         fBoolEvtValues[colIndex][slot] = *static_cast<bool *>(dataPtr);
+         bool b = false;
+         std::istringstream is(col);
+         is >> std::boolalpha >> b;
+         fBoolEvtValues[colIndex][slot] = b;
          break;
       }
       case 's': {
-         fStringEvtValues[colIndex][slot] = *static_cast<std::string *>(dataPtr);
+         fStringEvtValues[colIndex][slot].swap(col);
          break;
       }
       }
-      colIndex++;
    }
    return true;
 }
@@ -465,6 +484,7 @@ void RCsvDS::SetNSlots(unsigned int nSlots)
    fLong64EvtValues.resize(nColumns, std::vector<Long64_t>(fNSlots));
    fStringEvtValues.resize(nColumns, std::vector<std::string>(fNSlots));
    fBoolEvtValues.resize(nColumns, std::deque<bool>(fNSlots));
+   fSlotColumns.resize(fNSlots);
 }
 
 std::string RCsvDS::GetLabel()
@@ -8,7 +8,15 @@
  * For the list of contributors see $ROOTSYS/README/CREDITS.             *
  *************************************************************************/
 
+#include "RConfigure.h" // R__USE_IMT
 #include "ROOT/RDF/ActionHelpers.hxx"
+#include "TFileMerger.h"
+#include "TSystem.h"
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
 
 namespace ROOT {
 namespace Internal {
@@ -97,7 +105,50 @@ void FillHelper::Finalize()
    if (fResultHist->CanExtendAllAxes() && globalMin != std::numeric_limits<BufEl_t>::max() &&
        globalMax != std::numeric_limits<BufEl_t>::lowest()) {
       fResultHist->SetBins(fResultHist->GetNbinsX(), globalMin, globalMax);
+      // globalMax falls in the overflow bin: extend the axis now, as the first fill of globalMax would do, so that
+      // the axis stays the same while the buffers are emptied
+      fResultHist->ExtendAxis(globalMax, fResultHist->GetXaxis());
+   }
+
+#ifdef R__USE_IMT
+   std::size_t nValues = 0;
+   unsigned int nFilledSlots = 0;
+   for (auto &buf : fBuffers) {
+      nValues += buf.size();
+      nFilledSlots += !buf.empty();
+   }
+   // All values are now inside the axis (or in the under/overflow bins if it cannot be extended), so the buffers of the
+   // slots can be emptied in parallel in copies of the result, which are then added to it in slot order. The copies
+   // are made here, as the construction of histograms is not thread-safe.
+   auto axis = fResultHist->GetXaxis();
+   if (ROOT::IsImplicitMTEnabled() && nFilledSlots > 1 && nValues >= fgMinParallelFill &&
+       axis->GetXmax() > axis->GetXmin()) {
+      std::vector<std::unique_ptr<Hist_t>> hists(fNSlots);
+      for (unsigned int i = 0; i < fNSlots; ++i) {
+         if (!fBuffers[i].empty()) {
+            hists[i] = std::make_unique<Hist_t>(*fResultHist);
+            hists[i]->SetDirectory(nullptr);
+         }
+      }
+      auto fillSlot = [&](unsigned int i) {
+         if (!hists[i])
+            return;
+         auto weights = fWBuffers[i].empty() ? nullptr : fWBuffers[i].data();
+         hists[i]->FillN(fBuffers[i].size(), fBuffers[i].data(), weights);
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(fillSlot, ROOT::TSeqU(fNSlots));
+      for (auto &h : hists) {
+         if (!h)
+            continue;
+         fResultHist->Add(h.get());
+         // a NaN value disables the extension of the axis, see TH1::ExtendAxis
+         if (!h->CanExtendAllAxes())
+            fResultHist->SetCanExtend(TH1::kNoAxis);
+      }
+      return;
    }
+#endif
 
    for (unsigned int i = 0; i < fNSlots; ++i) {
       auto weights = fWBuffers[i].empty() ? nullptr : fWBuffers[i].data();
@@ -116,6 +167,38 @@ template void FillHelper::Exec(unsigned int, const std::vector<char> &, const st
 template void FillHelper::Exec(unsigned int, const std::vector<int> &, const std::vector<int> &);
 template void FillHelper::Exec(unsigned int, const std::vector<unsigned int> &, const std::vector<unsigned int> &);
 
+VariedHisto1DHelper::VariedHisto1DHelper(const ::TH1D &model, const std::vector<std::string> &tags,
+                                         const unsigned int nSlots)
+   : fResult(std::make_shared<Result_t>()), fTags(tags), fHistos(nSlots)
+{
+   for (auto &histos : fHistos) {
+      for (std::size_t i = 0; i < tags.size() + 1; ++i) {
+         histos.emplace_back(static_cast<::TH1D *>(model.Clone()));
+         histos.back()->SetDirectory(nullptr);
+      }
+   }
+}
+
+void VariedHisto1DHelper::ThrowSizeMismatch(std::size_t size) const
+{
+   throw std::runtime_error("VariedHisto1D: the varied values have " + std::to_string(size) + " elements but " +
+                            std::to_string(fTags.size()) + " variation tags were given to Vary.");
+}
+
+void VariedHisto1DHelper::Finalize()
+{
+   auto &result = fHistos[0];
+   for (std::size_t slot = 1; slot < fHistos.size(); ++slot) {
+      for (std::size_t i = 0; i < result.size(); ++i)
+         result[i]->Add(fHistos[slot][i].get());
+   }
+   for (std::size_t i = 0; i < result.size(); ++i) {
+      auto &h = (*fResult)[i == 0 ? "nominal" : fTags[i - 1]];
+      result[i]->Copy(h);
+      h.SetDirectory(nullptr);
+   }
+}
+
 // TODO
 // template void MinHelper::Exec(unsigned int, const std::vector<float> &);
 // template void MinHelper::Exec(unsigned int, const std::vector<double> &);
@@ -264,6 +347,35 @@ void ValidateSnapshotOutput(const RSnapshotOptions &opts, const std::string &tre
    }
 }
 
+std::string SnapshotSlotFileName(const std::string &fileName, unsigned int slot)
+{
+   const std::string ext = ".root";
+   const auto slotSuffix = "_slot" + std::to_string(slot);
+   if (fileName.size() > ext.size() && fileName.compare(fileName.size() - ext.size(), ext.size(), ext) == 0)
+      return fileName.substr(0, fileName.size() - ext.size()) + slotSuffix + ext;
+   return fileName + slotSuffix;
+}
+
+void MergeSnapshotSlotFiles(const std::vector<std::string> &slotFileNames, const std::string &fileName,
+                            const RSnapshotOptions &opts)
+{
+   ::TDirectory::TContext c; // do not let the merge change gDirectory
+   const auto cs = ROOT::CompressionSettings(opts.fCompressionAlgorithm, opts.fCompressionLevel);
+   {
+      // The slot files are written with the same compression settings as the output file: the merge copies the
+      // compressed baskets without unzipping them
+      TFileMerger merger(/*isLocal=*/kFALSE);
+      if (!merger.OutputFile(fileName.c_str(), opts.fMode.c_str(), cs))
+         throw std::runtime_error("Snapshot: cannot open output file \"" + fileName + "\"");
+      for (const auto &slotFileName : slotFileNames)
+         merger.AddFile(slotFileName.c_str(), /*cpProgress=*/kFALSE);
+      if (!merger.Merge())
+         throw std::runtime_error("Snapshot: merging the per-slot files into \"" + fileName + "\" failed");
+   }
+   for (const auto &slotFileName : slotFileNames)
+      gSystem->Unlink(slotFileName.c_str());
+}
+
 } // end NS RDF
 } // end NS Internal
 } // end NS ROOT
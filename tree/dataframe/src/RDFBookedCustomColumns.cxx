@@ -1,4 +1,6 @@
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
+#include "ROOT/RDF/RCustomColumnBase.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 
 namespace ROOT {
 namespace Internal {
@@ -25,6 +27,29 @@ void RBookedCustomColumns::AddName(std::string_view name)
    fCustomColumnsNames = newColsNames;
 }
 
+void RBookedCustomColumns::InitProfiles(ROOT::RDF::RProfiler &profiler) const
+{
+   const bool enabled = profiler.IsEnabled();
+   for (auto &column : GetColumns()) {
+      auto &columnPtr = column.second;
+      if (columnPtr->IsDataSourceColumn())
+         continue;
+      columnPtr->SetProfile(enabled ? &profiler.GetNodeProfile(columnPtr.get(), "Define\n" + column.first) : nullptr);
+   }
+}
+
+void RBookedCustomColumns::AddInputBranchNames(const ColumnNames_t &columns, std::set<std::string> &branchNames) const
+{
+   const auto &customColumns = GetColumns();
+   for (const auto &column : columns) {
+      const auto it = customColumns.find(column);
+      if (it == customColumns.end())
+         branchNames.insert(column);
+      else if (!it->second->IsDataSourceColumn())
+         AddInputBranchNames(it->second->GetColumnNames(), branchNames);
+   }
+}
+
 } // namespace RDF
 } // namespace Internal
 } // namespace ROOT
@@ -88,7 +88,8 @@ CreateDefineNode(const std::string &columnName, const ROOT::Detail::RDF::RCustom
       return duplicateDefine;
    }
 
-   auto node = std::make_shared<GraphNode>("Define\n" + columnName);
+   auto profile = columnPtr->GetProfile();
+   auto node = std::make_shared<GraphNode>("Define\n" + columnName + (profile ? "\n" + profile->GetSummary() : ""));
    node->SetDefine();
 
    sColumnsMap[columnPtr] = node;
@@ -106,6 +107,8 @@ std::shared_ptr<GraphNode> CreateFilterNode(const ROOT::Detail::RDF::RFilterBase
       return duplicateFilter;
    }
    auto filterName = (filterPtr->HasName() ? filterPtr->GetName() : "Filter");
+   if (auto profile = filterPtr->GetProfile())
+      filterName += "\n" + profile->GetSummary();
    auto node = std::make_shared<GraphNode>(filterName);
 
    sFiltersMap[filterPtr] = node;
@@ -0,0 +1,62 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDFHelpers.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RResultHandle.hxx"
+#include "RConfigure.h" // R__USE_IMT
+#include "TError.h"     // Warning
+#include "TROOT.h"      // IsImplicitMTEnabled
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <set>
+#include <vector>
+
+unsigned int ROOT::RDF::RunGraphs(std::vector<RResultHandle> handles)
+{
+   if (handles.empty()) {
+      Warning("RunGraphs", "Got an empty list of handles");
+      return 0u;
+   }
+
+   // Only the graphs of results that are not ready yet have to be run
+   std::vector<ROOT::Detail::RDF::RLoopManager *> loopManagers;
+   std::set<ROOT::Detail::RDF::RLoopManager *> seen;
+   unsigned int nReady = 0u;
+   for (const auto &h : handles) {
+      if (h.IsReady()) {
+         ++nReady;
+         continue;
+      }
+      if (h.fLoopManager && seen.insert(h.fLoopManager).second)
+         loopManagers.emplace_back(h.fLoopManager);
+   }
+   if (nReady > 0u)
+      Warning("RunGraphs", "Got %zu handles from which %u link to results which are already ready.", handles.size(),
+              nReady);
+   if (loopManagers.empty())
+      return 0u;
+
+   // The code to jit is shared by all RLoopManagers: jit all graphs in one go, before starting the event loops
+   loopManagers.front()->Jit();
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && loopManagers.size() > 1u) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([](ROOT::Detail::RDF::RLoopManager *lm) { lm->Run(); }, loopManagers);
+      return loopManagers.size();
+   }
+#endif
+
+   for (auto lm : loopManagers)
+      lm->Run();
+   return loopManagers.size();
+}
@@ -23,6 +23,7 @@
 #include <TObject.h>
 #include <TPRegexp.h>
 #include <TString.h>
+#include <TSystem.h>
 #include <TTree.h>
 
 // pragma to disable warnings on Rcpp which have
@@ -38,6 +39,9 @@
 #endif
 
 #include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
 #include <set>
 #include <stdexcept>
 #include <string>
@@ -241,6 +245,7 @@ static std::string DeclareLambda(const std::string &expr, const ColumnNames_t &v
 
    // InterpreterDeclare could throw. If it doesn't, mark the lambda as already jitted
    exprMap.insert({lambdaExpr, lambdaFullName});
+   ROOT::Internal::RDF::RegisterJittedLambda(lambdaFullName, toDeclare);
 
    return lambdaFullName;
 }
@@ -317,6 +322,106 @@ static bool IsValidCppVarName(const std::string &var)
    return true;
 }
 
+/// Find the bounds that a filter expression sets on the values of dataset columns. The expression must be a
+/// conjunction of terms at its top level: the terms comparing a column with a number with <, <=, >, >= or == give
+/// the bounds, the others are ignored. Defined columns are ignored, as well as negative numbers compared with
+/// columns of unsigned type, which the comparison converts to large positive numbers.
+static std::vector<ROOT::Detail::RDF::RColumnBounds>
+FindColumnBounds(const std::string &expr, const ColumnNames_t &usedCols, const ColumnNames_t &usedColTypes,
+                 const ColumnNames_t &customColNames, const std::map<std::string, std::string> &aliasMap)
+{
+   std::vector<ROOT::Detail::RDF::RColumnBounds> bounds;
+
+   // Splitting at && only gives the terms of the conjunction if the expression contains neither grouping nor
+   // operators with a lower precedence than &&
+   const auto npos = std::string::npos;
+   if (expr.find_first_of("|?,;(){}[]") != npos || expr.find("<<") != npos || expr.find(">>") != npos ||
+       TPRegexp(R"(\breturn\b)").Match(expr) == 1)
+      return bounds;
+   for (std::size_t i = 0; i < expr.size(); ++i) {
+      const bool isAssignment = expr[i] == '=' && (i == 0 || std::string("=!<>").find(expr[i - 1]) == npos) &&
+                                (i + 1 == expr.size() || expr[i + 1] != '=');
+      if (isAssignment)
+         return bounds;
+   }
+
+   auto trim = [](const std::string &str) {
+      const auto first = str.find_first_not_of(" \t\n");
+      return first == npos ? std::string() : str.substr(first, str.find_last_not_of(" \t\n") - first + 1);
+   };
+   auto parseNumber = [](const std::string &str, double &value) {
+      if (str.empty() || !(std::isdigit(str[0]) || str[0] == '.' || str[0] == '+' || str[0] == '-'))
+         return false;
+      char *end = nullptr;
+      value = std::strtod(str.c_str(), &end);
+      return end == str.c_str() + str.size() && !std::isnan(value);
+   };
+   // returns the index of the column in usedCols, or -1 if str is not a dataset column
+   auto findColumn = [&](const std::string &str) {
+      const auto &col = ResolveAlias(str, aliasMap);
+      const auto it = std::find(usedCols.begin(), usedCols.end(), col);
+      if (it == usedCols.end() || IsStrInVec(col, customColNames))
+         return -1;
+      return int(it - usedCols.begin());
+   };
+   auto isUnsigned = [](const std::string &type) {
+      const bool isRootTypedef = type.size() > 2 && type[0] == 'U' && type.compare(type.size() - 2, 2, "_t") == 0;
+      return isRootTypedef || type.find("unsigned") != npos || type.find("uint") != npos ||
+             type.find("size_t") != npos;
+   };
+
+   std::size_t termBegin = 0;
+   while (termBegin <= expr.size()) {
+      auto termEnd = expr.find("&&", termBegin);
+      if (termEnd == npos)
+         termEnd = expr.size();
+      const auto term = expr.substr(termBegin, termEnd - termBegin);
+      termBegin = termEnd + 2;
+
+      const auto opPos = term.find_first_of("<>=");
+      if (opPos == npos)
+         continue;
+      std::string op = term.substr(opPos, 1);
+      if (opPos + 1 < term.size() && term[opPos + 1] == '=')
+         op += '=';
+      if (op == "=") // part of !=
+         continue;
+      const auto lhs = trim(term.substr(0, opPos));
+      const auto rhs = trim(term.substr(opPos + op.size()));
+      if (rhs.find_first_of("<>=") != npos)
+         continue;
+
+      double value;
+      int colIdx;
+      if (parseNumber(rhs, value) && (colIdx = findColumn(lhs)) >= 0) {
+         // column op value
+      } else if (parseNumber(lhs, value) && (colIdx = findColumn(rhs)) >= 0) {
+         // value op column, i.e. column (mirrored op) value
+         if (op[0] == '<')
+            op[0] = '>';
+         else if (op[0] == '>')
+            op[0] = '<';
+      } else {
+         continue;
+      }
+      if (value < 0 && isUnsigned(usedColTypes[colIdx]))
+         continue;
+
+      ROOT::Detail::RDF::RColumnBounds columnBounds;
+      columnBounds.fColumnName = usedCols[colIdx];
+      if (op[0] == '<' || op == "==") {
+         columnBounds.fMax = value;
+         columnBounds.fMaxIsStrict = op == "<";
+      }
+      if (op[0] == '>' || op == "==") {
+         columnBounds.fMin = value;
+         columnBounds.fMinIsStrict = op == ">";
+      }
+      bounds.emplace_back(std::move(columnBounds));
+   }
+   return bounds;
+}
+
 } // anonymous namespace
 
 namespace ROOT {
@@ -345,6 +450,23 @@ HeadNode_t CreateSnapshotRDF(const ColumnNames_t &validCols,
    return snapshotRDFResPtr;
 }
 
+std::string CreateCacheFile()
+{
+   TString fileName("rdfcache");
+   FILE *f = gSystem->TempFileName(fileName);
+   if (!f)
+      throw std::runtime_error("Cache: cannot create a temporary file in " + std::string(gSystem->TempDirectory()));
+   fclose(f);
+   return fileName.Data();
+}
+
+ULong64_t GetMaxNEntries(RLoopManager &lm)
+{
+   if (auto tree = lm.GetTree())
+      return tree->GetEntries();
+   return lm.GetNEmptyEntries();
+}
+
 std::string DemangleTypeIdName(const std::type_info &typeInfo)
 {
    int dummy(0);
@@ -523,6 +645,11 @@ bool IsInternalColumn(std::string_view colName)
    return goodPrefix && '_' == colName.back();                 // also ends with '_'
 }
 
+std::string VariationsColumnName(std::string_view colName)
+{
+   return "rdfvariations_" + std::string(colName) + "_";
+}
+
 std::vector<std::string> GetFilterNames(const std::shared_ptr<RLoopManager> &loopManager)
 {
    return loopManager->GetFiltersNames();
@@ -553,6 +680,13 @@ void BookFilterJit(const std::shared_ptr<RJittedFilter> &jittedFilter,
    if (type != "bool")
       std::runtime_error("Filter: the following expression does not evaluate to bool:\n" + std::string(expression));
 
+   // A filter that processes all entries can skip the clusters of entries it rejects according to column statistics
+   auto lm = jittedFilter->GetLoopManagerUnchecked();
+   if (prevNodeOnHeap->get() == lm) {
+      jittedFilter->SetColumnBounds(FindColumnBounds(std::string(expression), parsedExpr.fUsedCols, exprVarTypes,
+                                                     customCols.GetNames(), aliasMap));
+   }
+
    // columnsOnHeap is deleted by the jitted call to JitFilterHelper
    ROOT::Internal::RDF::RBookedCustomColumns *columnsOnHeap = new ROOT::Internal::RDF::RBookedCustomColumns(customCols);
    const auto columnsOnHeapAddr = PrettyPrintAddr(columnsOnHeap);
@@ -577,7 +711,6 @@ void BookFilterJit(const std::shared_ptr<RJittedFilter> &jittedFilter,
                     << "reinterpret_cast<ROOT::Internal::RDF::RBookedCustomColumns*>(" << columnsOnHeapAddr << ")"
                     << ");\n";
 
-   auto lm = jittedFilter->GetLoopManagerUnchecked();
    lm->ToJitExec(filterInvocation.str());
 }
 
@@ -0,0 +1,170 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDFHelpers.hxx"
+#include "ROOT/RDF/Utils.hxx"
+#include "RVersion.h" // ROOT_RELEASE
+#include "TError.h"   // Warning
+#include "TMD5.h"
+#include "TSystem.h"
+
+#include <fstream>
+#include <regex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+/// The directory where the libraries of the jit cache are stored, empty if the cache is disabled
+std::string &GetJitCacheDirectory()
+{
+   static std::string directory;
+   return directory;
+}
+
+/// Declarations of the jitted lambdas, by lambda name (e.g. "__rdf::lambda0")
+std::unordered_map<std::string, std::string> &GetLambdaDeclarations()
+{
+   static std::unordered_map<std::string, std::string> declarations;
+   return declarations;
+}
+
+/// Replace the addresses that the code to jit embeds, e.g. `reinterpret_cast<T*>(0x1234)`, with the elements of an
+/// array `args`, so that the same computation graph produces the same code in every process.
+/// Return the addresses, in order of appearance.
+std::vector<void *> ReplaceAddresses(std::string &code)
+{
+   static const std::regex addressRegex(R"(reinterpret_cast<([^()]+)\*>\((0x[0-9a-fA-F]+|0)\))");
+   std::vector<void *> addresses;
+   std::string replaced;
+   std::size_t last = 0u;
+   const auto end = std::sregex_iterator();
+   for (auto it = std::sregex_iterator(code.begin(), code.end(), addressRegex); it != end; ++it) {
+      const auto &match = *it;
+      replaced.append(code, last, match.position() - last);
+      replaced += "reinterpret_cast<" + match[1].str() + "*>(args[" + std::to_string(addresses.size()) + "])";
+      addresses.emplace_back(reinterpret_cast<void *>(std::stoull(match[2].str(), nullptr, 16)));
+      last = match.position() + match.length();
+   }
+   replaced.append(code, last, std::string::npos);
+   code = std::move(replaced);
+   return addresses;
+}
+
+/// Build the source of a library that runs `code` in an `extern "C"` function called `<id>_run`.
+/// The jitted lambdas are declared in namespace `<id>` instead of __rdf, so that they clash neither with the lambdas
+/// declared to the interpreter nor with the ones of other libraries. `<id>` is a placeholder, see RunWithJitCache.
+/// Return an empty string if the code uses jitted lambdas whose declaration is not known.
+std::string MakeLibrarySource(const std::string &code, const std::string &id)
+{
+   std::string source = "// Generated by RDataFrame for ROOT " ROOT_RELEASE "\n#include \"ROOT/RDataFrame.hxx\"\n\n";
+   static const std::regex lambdaRegex(R"(__rdf::lambda[0-9]+)");
+   std::set<std::string> declared;
+   const auto end = std::sregex_iterator();
+   for (auto it = std::sregex_iterator(code.begin(), code.end(), lambdaRegex); it != end; ++it) {
+      const auto name = it->str();
+      if (!declared.insert(name).second)
+         continue;
+      const auto &declarations = GetLambdaDeclarations();
+      const auto declIt = declarations.find(name);
+      if (declIt == declarations.end())
+         return "";
+      source += declIt->second + "\n";
+   }
+   source += "\nextern \"C\" void " + id + "_run(void **args)\n{\n" + code + "\n}\n";
+   static const std::regex namespaceRegex(R"(\b__rdf\b)");
+   return std::regex_replace(source, namespaceRegex, id);
+}
+
+bool FileExists(const std::string &fileName)
+{
+   // AccessPathName returns false if the file exists
+   return !gSystem->AccessPathName(fileName.c_str());
+}
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+void RegisterJittedLambda(const std::string &name, const std::string &declaration)
+{
+   GetLambdaDeclarations()[name] = declaration;
+}
+
+/// Run the code to jit with a function loaded from the libraries of the jit cache, compiling the library first if
+/// it is not in the cache yet. Return false if the cache is disabled or if the code cannot be compiled in a library,
+/// e.g. because it uses types or functions only known to the interpreter: the interpreter must run the code then.
+bool RunWithJitCache(const std::string &code)
+{
+   const auto &directory = GetJitCacheDirectory();
+   if (directory.empty())
+      return false;
+
+   std::string cacheableCode = code;
+   auto addresses = ReplaceAddresses(cacheableCode);
+
+   // the name of the library depends on the code and on the ROOT version, which is also part of the source
+   const std::string placeholder = "RDF_JIT_ID";
+   auto source = MakeLibrarySource(cacheableCode, placeholder);
+   if (source.empty())
+      return false;
+   TMD5 md5;
+   md5.Update(reinterpret_cast<const UChar_t *>(source.data()), source.size());
+   md5.Final();
+   const std::string baseName = std::string("rdfjit_") + md5.AsString();
+   source = std::regex_replace(source, std::regex(placeholder), baseName);
+
+   const auto basePath = directory + "/" + baseName;
+   const auto sourceFile = basePath + ".C";
+   const auto libFile = basePath + "_C." + gSystem->GetSoExt();
+   const auto failedFile = basePath + ".failed";
+   if (FileExists(failedFile))
+      return false;
+
+   if (FileExists(libFile)) {
+      if (gSystem->Load(libFile.c_str()) < 0)
+         return false;
+   } else {
+      std::ofstream(sourceFile) << source;
+      if (!gSystem->CompileMacro(sourceFile.c_str(), "kOs")) {
+         // do not retry in later runs
+         std::ofstream(failedFile) << "Compilation of " << sourceFile << " failed\n";
+         gSystem->Unlink(sourceFile.c_str());
+         Warning("RDataFrame::Jit", "The code to jit could not be compiled in the jit cache, using the interpreter.");
+         return false;
+      }
+   }
+
+   const auto funcName = baseName + "_run";
+   auto func = reinterpret_cast<void (*)(void **)>(gSystem->DynFindSymbol(libFile.c_str(), funcName.c_str()));
+   if (!func)
+      return false;
+   func(addresses.data());
+   return true;
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+void ROOT::RDF::EnableJitCache(std::string_view directory)
+{
+   std::string dir(directory);
+   if (dir.empty())
+      throw std::runtime_error("EnableJitCache: the directory of the jit cache cannot be empty.");
+   gSystem->mkdir(dir.c_str(), /*recursive=*/true);
+   GetJitCacheDirectory() = dir;
+}
+
+void ROOT::RDF::DisableJitCache()
+{
+   GetJitCacheDirectory().clear();
+}
@@ -0,0 +1,156 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDFHelpers.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RDF/RMergeableValue.hxx"
+#include "ROOT/RResultHandle.hxx"
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#include "TBufferFile.h"
+#include "TChain.h"
+#include "TError.h" // Warning
+#include "TTree.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using EntryRange_t = std::pair<ULong64_t, ULong64_t>;
+
+namespace {
+/// Split the entries [0, nEntries) in at most nRanges ranges of similar size.
+std::vector<EntryRange_t> SplitEvenly(ULong64_t nEntries, unsigned int nRanges)
+{
+   std::vector<EntryRange_t> ranges;
+   const auto nPerRange = nEntries / nRanges;
+   auto remainder = nEntries % nRanges;
+   ULong64_t start = 0ull;
+   while (start < nEntries) {
+      auto end = start + nPerRange;
+      if (remainder > 0) {
+         ++end;
+         --remainder;
+      }
+      ranges.emplace_back(start, end);
+      start = end;
+   }
+   return ranges;
+}
+
+/// Split the entries of a TTree in at most nRanges ranges, without splitting clusters.
+std::vector<EntryRange_t> SplitClusters(TTree &tree, unsigned int nRanges)
+{
+   const auto nEntries = static_cast<ULong64_t>(tree.GetEntries());
+   std::vector<ULong64_t> clusterStarts;
+   auto clusterIter = tree.GetClusterIterator(0);
+   Long64_t start = 0;
+   while ((start = clusterIter()) < static_cast<Long64_t>(nEntries))
+      clusterStarts.emplace_back(start);
+   if (clusterStarts.empty())
+      return {};
+
+   // each range starts at the first cluster that begins after its share of entries
+   std::vector<EntryRange_t> ranges;
+   ULong64_t rangeStart = 0ull;
+   auto clusterIt = clusterStarts.begin();
+   for (auto i = 1u; i <= nRanges && rangeStart < nEntries; ++i) {
+      const auto target = nEntries * i / nRanges;
+      clusterIt = std::lower_bound(clusterIt, clusterStarts.end(), target);
+      const auto rangeEnd = clusterIt == clusterStarts.end() ? nEntries : *clusterIt;
+      if (rangeEnd > rangeStart) {
+         ranges.emplace_back(rangeStart, rangeEnd);
+         rangeStart = rangeEnd;
+      }
+   }
+   return ranges;
+}
+
+/// Return the entry ranges that the worker processes run on.
+std::vector<EntryRange_t> MakeEntryRanges(ROOT::Detail::RDF::RLoopManager &lm, unsigned int nRanges)
+{
+   if (lm.GetDataSource())
+      throw std::runtime_error("RunMultiProcess: computation graphs that read from data sources are not supported.");
+   auto tree = lm.GetTree();
+   if (!tree)
+      return SplitEvenly(lm.GetNEmptyEntries(), nRanges);
+   if (tree->GetEntryList())
+      throw std::runtime_error("RunMultiProcess: trees with entry lists are not supported.");
+   // the clusters of the trees of a chain are not known before the files are opened
+   if (dynamic_cast<TChain *>(tree))
+      return SplitEvenly(static_cast<ULong64_t>(tree->GetEntries()), nRanges);
+   return SplitClusters(*tree, nRanges);
+}
+} // anonymous namespace
+
+unsigned int ROOT::RDF::RunMultiProcess(std::vector<RResultHandle> handles, unsigned int nWorkers)
+{
+   if (handles.empty()) {
+      Warning("RunMultiProcess", "Got an empty list of handles");
+      return 0u;
+   }
+   if (nWorkers == 0u)
+      throw std::runtime_error("RunMultiProcess: the number of worker processes must be positive.");
+
+   auto lm = handles.front().fLoopManager;
+   for (const auto &h : handles) {
+      if (h.fLoopManager != lm)
+         throw std::runtime_error("RunMultiProcess: all handles must belong to the same computation graph.");
+      if (h.IsReady())
+         throw std::runtime_error("RunMultiProcess: all handles must refer to results that are not ready yet.");
+   }
+
+   // the workers are forked after jitting, so that they do not jit the same code again
+   lm->Jit();
+
+   // check that all results can be merged before starting the workers: GetMergeableValue throws if not
+   for (const auto &h : handles) {
+      h.fActionPtr->GetMergeableValue();
+      if (!h.fMergeResults)
+         throw std::runtime_error("RunMultiProcess: the results of type " +
+                                  ROOT::Internal::RDF::TypeID2TypeName(*h.fType) + " cannot be merged.");
+   }
+
+   const auto ranges = MakeEntryRanges(*lm, nWorkers);
+
+   std::vector<std::string> blobs;
+   if (!ranges.empty()) {
+      // each worker runs the event loop on its entry range and sends back the partial results, serialized in order
+      auto work = [&](unsigned int i) {
+         lm->RunOnEntryRange(ranges[i].first, ranges[i].second);
+         TBufferFile buf(TBuffer::kWrite);
+         for (const auto &h : handles)
+            h.fActionPtr->GetMergeableValue()->Serialize(buf);
+         return std::string(buf.Buffer(), buf.Length());
+      };
+      ROOT::TProcessExecutor pool(std::min(nWorkers, static_cast<unsigned int>(ranges.size())));
+      blobs = pool.Map(work, ROOT::TSeqU(static_cast<unsigned int>(ranges.size())));
+   }
+
+   // an event loop on no entries finalizes the results in this process and marks the actions as run
+   lm->RunOnEntryRange(0ull, 0ull);
+   if (blobs.empty())
+      return 0u;
+
+   std::vector<std::vector<std::unique_ptr<ROOT::Detail::RDF::RMergeableValueBase>>> partials(handles.size());
+   for (auto &blob : blobs) {
+      TBufferFile buf(TBuffer::kRead, static_cast<Int_t>(blob.size()), &blob[0], /*adopt=*/false);
+      for (auto i = 0u; i < handles.size(); ++i) {
+         auto partial = handles[i].fActionPtr->GetMergeableValue();
+         partial->Serialize(buf);
+         partials[i].emplace_back(std::move(partial));
+      }
+   }
+   for (auto i = 0u; i < handles.size(); ++i)
+      handles[i].fMergeResults(handles[i].fObjPtr.get(), partials[i]);
+
+   return blobs.size();
+}
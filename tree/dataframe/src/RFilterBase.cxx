@@ -10,6 +10,10 @@
 
 #include "ROOT/RDF/RCutFlowReport.hxx"
 #include "ROOT/RDF/RFilterBase.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
+
+#include <algorithm>
+#include <chrono>
 #include <numeric> // std::accumulate
 
 using namespace ROOT::Detail::RDF;
@@ -17,7 +21,9 @@ using namespace ROOT::Detail::RDF;
 RFilterBase::RFilterBase(RLoopManager *implPtr, std::string_view name, const unsigned int nSlots,
                          const RDFInternal::RBookedCustomColumns &customColumns)
    : RNodeBase(implPtr), fLastResult(nSlots), fAccepted(nSlots), fRejected(nSlots), fName(name), fNSlots(nSlots),
-     fCustomColumns(customColumns) {}
+     fCustomColumns(customColumns), fCanReorder(name.empty() && implPtr->IsFilterReorderingEnabled())
+{
+}
 
 // outlined to pin virtual table
 RFilterBase::~RFilterBase() {}
@@ -44,6 +50,100 @@ void RFilterBase::FillReport(ROOT::RDF::RCutFlowReport &rep) const
 void RFilterBase::InitNode()
 {
    fLastCheckedEntry = std::vector<Long64_t>(fNSlots, -1);
+   InitReordering();
    if (!fName.empty()) // if this is a named filter we care about its report count
       ResetReportCount();
 }
+
+/// Set the profile this filter records its evaluations in, or reset it if profiling is disabled.
+/// The same is done for the Defines this filter has access to.
+void RFilterBase::InitProfile(ROOT::RDF::RProfiler &profiler)
+{
+   fProfile = profiler.IsEnabled() ? &profiler.GetNodeProfile(this, HasName() ? GetName() : "Filter") : nullptr;
+   fCustomColumns.InitProfiles(profiler);
+}
+
+/// Collect the chain of reorderable filters that ends with this filter, if this filter is reorderable and its
+/// upstream node is a reorderable filter too. CheckChain then evaluates the predicates of the chain in the order that
+/// is expected to reject entries the fastest.
+void RFilterBase::InitReordering()
+{
+   fChain.clear();
+   fChainPrev = nullptr;
+   if (!fCanReorder)
+      return;
+
+   fChain.emplace_back(this);
+   RNodeBase *prev = GetPrevNode();
+   while (auto prevFilter = dynamic_cast<RFilterBase *>(prev)) {
+      if (!prevFilter->CanReorder())
+         break;
+      fChain.emplace_back(prevFilter);
+      prev = prevFilter->GetPrevNode();
+   }
+   if (fChain.size() < 2) {
+      fChain.clear();
+      return;
+   }
+   std::reverse(fChain.begin(), fChain.end());
+   fChainPrev = prev;
+
+   std::vector<unsigned int> bookingOrder(fChain.size());
+   std::iota(bookingOrder.begin(), bookingOrder.end(), 0u);
+   fChainOrder.assign(fNSlots, bookingOrder);
+   fChainStats.assign(fNSlots, std::vector<RPredicateStats>(fChain.size()));
+   fNChainChecks.assign(fNSlots, 0ull);
+}
+
+/// Evaluate the predicates of fChain in the current order of the slot, stopping at the first that rejects the entry.
+/// The predicates are timed once every 64 entries, and the order is updated every 4096 entries.
+bool RFilterBase::CheckChain(unsigned int slot, Long64_t entry)
+{
+   const auto nChecks = ++fNChainChecks[slot];
+   const bool mustTime = (nChecks % 64) == 1;
+   auto &stats = fChainStats[slot];
+
+   bool passed = true;
+   for (auto idx : fChainOrder[slot]) {
+      auto &predicateStats = stats[idx];
+      auto profile = fChain[idx]->GetProfile();
+      if (mustTime || profile) {
+         const auto start = std::chrono::steady_clock::now();
+         passed = fChain[idx]->CheckPredicate(slot, entry);
+         if (mustTime) {
+            predicateStats.fTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            ++predicateStats.fNTimed;
+         }
+         if (profile)
+            profile->Add(slot, start, passed);
+      } else {
+         passed = fChain[idx]->CheckPredicate(slot, entry);
+      }
+      ++predicateStats.fNEvaluated;
+      if (!passed)
+         break;
+      ++predicateStats.fNPassed;
+   }
+
+   if ((nChecks % 4096) == 0)
+      ReorderChain(slot);
+   return passed;
+}
+
+/// Sort the predicates of fChain by increasing ratio of cost and rejection rate, which minimizes the expected
+/// evaluation time of the chain for independent predicates. Predicates not measured yet are moved to the front.
+void RFilterBase::ReorderChain(unsigned int slot)
+{
+   const auto &stats = fChainStats[slot];
+   std::vector<double> ranks(stats.size(), 0.);
+   for (std::size_t i = 0; i < stats.size(); ++i) {
+      const auto &s = stats[i];
+      if (s.fNEvaluated == 0 || s.fNTimed == 0)
+         continue;
+      const double cost = s.fTime / s.fNTimed;
+      const double rejectionRate = 1. - double(s.fNPassed) / s.fNEvaluated;
+      ranks[i] = cost / std::max(rejectionRate, 1e-6);
+   }
+   auto &order = fChainOrder[slot];
+   std::stable_sort(order.begin(), order.end(), [&ranks](unsigned int a, unsigned int b) { return ranks[a] < ranks[b]; });
+}
@@ -56,6 +56,12 @@ void RJittedAction::Finalize()
    fConcreteAction->Finalize();
 }
 
+void RJittedAction::InitProfile(ROOT::RDF::RProfiler &profiler)
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   fConcreteAction->InitProfile(profiler);
+}
+
 void *RJittedAction::PartialUpdate(unsigned int slot)
 {
    R__ASSERT(fConcreteAction != nullptr);
@@ -84,6 +90,18 @@ void RJittedAction::ClearValueReaders(unsigned int slot)
    return fConcreteAction->ClearValueReaders(slot);
 }
 
+ROOT::Detail::RDF::RNodeBase *RJittedAction::GetPrevNode() const
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   return fConcreteAction->GetPrevNode();
+}
+
+void RJittedAction::AddInputBranchNames(std::set<std::string> &branchNames) const
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   fConcreteAction->AddInputBranchNames(branchNames);
+}
+
 std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> RJittedAction::GetGraph()
 {
    R__ASSERT(fConcreteAction != nullptr);
@@ -31,12 +31,26 @@ const std::type_info &RJittedCustomColumn::GetTypeId() const
    return fConcreteCustomColumn->GetTypeId();
 }
 
+const std::vector<std::string> &RJittedCustomColumn::GetColumnNames() const
+{
+   R__ASSERT(fConcreteCustomColumn != nullptr);
+   return fConcreteCustomColumn->GetColumnNames();
+}
+
 void RJittedCustomColumn::Update(unsigned int slot, Long64_t entry)
 {
    R__ASSERT(fConcreteCustomColumn != nullptr);
    fConcreteCustomColumn->Update(slot, entry);
 }
 
+/// The concrete column records the evaluations, this column keeps the profile for SaveGraph.
+void RJittedCustomColumn::SetProfile(ROOT::RDF::RNodeProfile *profile)
+{
+   R__ASSERT(fConcreteCustomColumn != nullptr);
+   fProfile = profile;
+   fConcreteCustomColumn->SetProfile(profile);
+}
+
 void RJittedCustomColumn::ClearValueReaders(unsigned int slot)
 {
    R__ASSERT(fConcreteCustomColumn != nullptr);
@@ -21,6 +21,8 @@ RJittedFilter::RJittedFilter(RLoopManager *lm, std::string_view name)
 void RJittedFilter::SetFilter(std::unique_ptr<RFilterBase> f)
 {
    fConcreteFilter = std::move(f);
+   // the concrete filter is created at jitting time: it must be reorderable if this filter was when it was booked
+   fConcreteFilter->SetCanReorder(fCanReorder);
 }
 
 void RJittedFilter::InitSlot(TTreeReader *r, unsigned int slot)
@@ -95,12 +97,45 @@ void RJittedFilter::ClearTask(unsigned int slot)
    fConcreteFilter->ClearTask(slot);
 }
 
+bool RJittedFilter::CheckPredicate(unsigned int slot, Long64_t entry)
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   return fConcreteFilter->CheckPredicate(slot, entry);
+}
+
+RNodeBase *RJittedFilter::GetPrevNode() const
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   return fConcreteFilter->GetPrevNode();
+}
+
+void RJittedFilter::AddInputBranchNames(std::set<std::string> &branchNames) const
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   fConcreteFilter->AddInputBranchNames(branchNames);
+}
+
+void RJittedFilter::AddRejected(unsigned int slot, ULong64_t nEntries)
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   fConcreteFilter->AddRejected(slot, nEntries);
+}
+
 void RJittedFilter::InitNode()
 {
    R__ASSERT(fConcreteFilter != nullptr);
    fConcreteFilter->InitNode();
 }
 
+/// The profile is shared with the concrete filter, which records the evaluations. The wrapper needs it too for the
+/// evaluations of chains of reorderable filters, which go through the RJittedFilter.
+void RJittedFilter::InitProfile(ROOT::RDF::RProfiler &profiler)
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   fConcreteFilter->InitProfile(profiler);
+   fProfile = fConcreteFilter->GetProfile();
+}
+
 void RJittedFilter::AddFilterName(std::vector<std::string> &filters)
 {
    if (fConcreteFilter == nullptr) {
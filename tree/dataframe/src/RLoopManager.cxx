@@ -5,6 +5,7 @@
 #include "ROOT/RDF/RLoopManager.hxx"
 #include "ROOT/RDF/RRangeBase.hxx"
 #include "ROOT/RDF/RSlotStack.hxx"
+#include "ROOT/RTrace.hxx"
 #include "RtypesCore.h" // Long64_t
 #include "TBranchElement.h"
 #include "TBranchObject.h"
@@ -12,6 +13,8 @@
 #include "TFriendElement.h"
 #include "TInterpreter.h"
 #include "TROOT.h" // IsImplicitMTEnabled
+#include "TSystem.h"
+#include "TTree.h"
 #include "TTreeReader.h"
 
 #ifdef R__USE_IMT
@@ -19,11 +22,14 @@
 #include "ROOT/TTreeProcessorMT.hxx"
 #endif
 
+#include <algorithm>
 #include <atomic>
 #include <exception>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <numeric> // std::iota
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
@@ -205,6 +211,28 @@ static void ThrowIfPoolSizeChanged(unsigned int nSlots)
    }
 }
 
+#ifdef R__USE_IMT
+/// Run `task(i)` for every i in [0, nTasks) in the thread pool. In order, each of the `nWorkers` workers takes the
+/// next task when it is done with the previous one, so that tasks start in the order of their index.
+template <typename F>
+void ForeachTask(ROOT::TThreadExecutor &pool, std::size_t nTasks, bool inOrder, unsigned int nWorkers, F &task)
+{
+   if (inOrder) {
+      std::atomic<std::size_t> nextTask(0u);
+      pool.Foreach(
+         [&] {
+            for (auto taskIdx = nextTask++; taskIdx < nTasks; taskIdx = nextTask++)
+               task(taskIdx);
+         },
+         nWorkers);
+   } else {
+      std::vector<std::size_t> taskIdxs(nTasks);
+      std::iota(taskIdxs.begin(), taskIdxs.end(), 0u);
+      pool.Foreach(task, taskIdxs);
+   }
+}
+#endif
+
 } // anonymous namespace
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -240,23 +268,14 @@ RLoopManager::RLoopManager(std::unique_ptr<RDataSource> ds, const ColumnNames_t
    fDataSource->SetNSlots(fNSlots);
 }
 
-// ROOT-9559: we cannot handle indexed friends
-void RLoopManager::CheckIndexedFriends()
+RLoopManager::~RLoopManager()
 {
-   auto friends = fTree->GetListOfFriends();
-   if (!friends)
+   if (fTemporaryFiles.empty())
       return;
-   for (auto friendElObj : *friends) {
-      auto friendEl = static_cast<TFriendElement *>(friendElObj);
-      auto friendTree = friendEl->GetTree();
-      if (friendTree && friendTree->GetTreeIndex()) {
-         std::string err = fTree->GetName();
-         err += " has a friend, \"";
-         err += friendTree->GetName();
-         err += "\", which has an index. This is not supported.";
-         throw std::runtime_error(err);
-      }
-   }
+   // close the input files before deleting them
+   fTree.reset();
+   for (const auto &fileName : fTemporaryFiles)
+      gSystem->Unlink(fileName.c_str());
 }
 
 /// Run event loop with no source files, in parallel.
@@ -266,11 +285,12 @@ void RLoopManager::RunEmptySourceMT()
    RSlotStack slotStack(fNSlots);
    // Working with an empty tree.
    // Evenly partition the entries according to fNSlots. Produce around 2 tasks per slot.
-   const auto nEntriesPerSlot = fNEmptyEntries / (fNSlots * 2);
-   auto remainder = fNEmptyEntries % (fNSlots * 2);
+   const auto nEntries = std::min(fNEmptyEntries, fEndEntryMT);
+   const auto nEntriesPerSlot = nEntries / (fNSlots * 2);
+   auto remainder = nEntries % (fNSlots * 2);
    std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
    ULong64_t start = 0;
-   while (start < fNEmptyEntries) {
+   while (start < nEntries) {
       ULong64_t end = start + nEntriesPerSlot;
       if (remainder > 0) {
          ++end;
@@ -281,9 +301,12 @@ void RLoopManager::RunEmptySourceMT()
    }
 
    // Each task will generate a subrange of entries
-   auto genFunction = [this, &slotStack](const std::pair<ULong64_t, ULong64_t> &range) {
+   auto genFunction = [this, &slotStack, &entryRanges](std::size_t taskIdx) {
+      R__TRACE_SCOPE("rdf", "RLoopManager::RunTask");
+      const auto &range = entryRanges[taskIdx];
       auto slot = slotStack.GetSlot();
       InitNodeSlots(nullptr, slot);
+      SetSlotTask(slot, taskIdx);
       try {
          for (auto currEntry = range.first; currEntry < range.second; ++currEntry) {
             RunAndCheckFilters(slot, currEntry);
@@ -299,7 +322,7 @@ void RLoopManager::RunEmptySourceMT()
    };
 
    ROOT::TThreadExecutor pool;
-   pool.Foreach(genFunction, entryRanges);
+   ForeachTask(pool, entryRanges.size(), fOrderedTasks, fNSlots, genFunction);
 
 #endif // not implemented otherwise
 }
@@ -308,8 +331,10 @@ void RLoopManager::RunEmptySourceMT()
 void RLoopManager::RunEmptySource()
 {
    InitNodeSlots(nullptr, 0);
+   const auto begin = fHasEntryRange ? fEntryRange.first : 0ull;
+   const auto end = fHasEntryRange ? std::min(fEntryRange.second, fNEmptyEntries) : fNEmptyEntries;
    try {
-      for (ULong64_t currEntry = 0; currEntry < fNEmptyEntries && fNStopsReceived < fNChildren; ++currEntry) {
+      for (ULong64_t currEntry = begin; currEntry < end && fNStopsReceived < fNChildren; ++currEntry) {
          RunAndCheckFilters(0, currEntry);
       }
    } catch (...) {
@@ -324,23 +349,43 @@ void RLoopManager::RunEmptySource()
 void RLoopManager::RunTreeProcessorMT()
 {
 #ifdef R__USE_IMT
-   CheckIndexedFriends();
    RSlotStack slotStack(fNSlots);
    const auto &entryList = fTree->GetEntryList() ? *fTree->GetEntryList() : TEntryList();
    auto tp = std::make_unique<ROOT::TTreeProcessorMT>(*fTree, entryList, fNSlots);
 
-   std::atomic<ULong64_t> entryCount(0ull);
+   // the zones of entries that the skipping filters reject are not processed, unless an entry list selects entries
+   const bool canSkip = !fSkippingFilters.empty() && !fTree->GetEntryList();
 
-   tp->Process([this, &slotStack, &entryCount](TTreeReader &r) -> void {
+   auto processTask = [this, &slotStack, canSkip](TTreeReader &r, const ROOT::TTreeProcessorMT::TTaskRange &task) {
+      R__TRACE_SCOPE("rdf", "RLoopManager::RunTask");
       auto slot = slotStack.GetSlot();
       InitNodeSlots(&r, slot);
+      SetSlotTask(slot, task.fIndex);
       const auto entryRange = r.GetEntriesRange(); // we trust TTreeProcessorMT to call SetEntriesRange
-      const auto nEntries = entryRange.second - entryRange.first;
-      auto count = entryCount.fetch_add(nEntries);
+      // the entries of the reader can be numbered within one of the files, rdfentry_ is the number in the dataset
+      const auto firstEntry = ULong64_t(task.fFirstEntry) - ULong64_t(entryRange.first);
+      const ColumnStatistics_t getStatistics = [&r](const std::string &column, ULong64_t entry, double &min,
+                                                    double &max, ULong64_t &zoneEnd) {
+         const auto statsEnd = r.GetTree()->GetClusterStatistics(column.c_str(), entry, min, max);
+         zoneEnd = statsEnd;
+         return statsEnd >= 0;
+      };
+      ULong64_t keptEnd = 0ull;
       try {
          // recursive call to check filters and conditionally execute actions
-         while (r.Next()) {
-            RunAndCheckFilters(slot, count++);
+         while (LoadEntry(r, slot)) {
+            const ULong64_t current = r.GetCurrentEntry();
+            if (canSkip && current >= keptEnd) {
+               const auto kept = SkipRejectedEntries(slot, current, ULong64_t(entryRange.second), getStatistics);
+               if (kept.first >= ULong64_t(entryRange.second) ||
+                   (kept.first != current && r.SetEntry(kept.first) != TTreeReader::kEntryValid))
+                  break;
+               keptEnd = kept.second;
+            }
+            const auto entry = firstEntry + r.GetCurrentEntry();
+            if (entry >= fEndEntryMT)
+               break;
+            RunAndCheckFilters(slot, entry);
          }
       } catch (...) {
          CleanUpTask(slot);
@@ -349,23 +394,53 @@ void RLoopManager::RunTreeProcessorMT()
       }
       CleanUpTask(slot);
       slotStack.ReturnSlot(slot);
-   });
+   };
+   const auto endEntry = fEndEntryMT == std::numeric_limits<ULong64_t>::max() ? -1ll : Long64_t(fEndEntryMT);
+   tp->ProcessTasks(processTask, endEntry, fOrderedTasks);
 #endif // no-op otherwise (will not be called)
 }
 
 /// Run event loop over one or multiple ROOT files, in sequence.
 void RLoopManager::RunTreeReader()
 {
-   CheckIndexedFriends();
    TTreeReader r(fTree.get(), fTree->GetEntryList());
    if (0 == fTree->GetEntriesFast())
       return;
+   if (fHasEntryRange) {
+      if (fEntryRange.first >= fEntryRange.second)
+         return;
+      r.SetEntriesRange(fEntryRange.first, fEntryRange.second);
+   }
    InitNodeSlots(&r, 0);
 
+   // the zones of entries that the skipping filters reject are not processed, unless an entry list selects entries
+   const bool canSkip = !fSkippingFilters.empty() && !fTree->GetEntryList();
+   const auto end = fHasEntryRange ? fEntryRange.second : std::numeric_limits<ULong64_t>::max();
+   const ColumnStatistics_t getStatistics = [&r](const std::string &column, ULong64_t entry, double &min, double &max,
+                                                 ULong64_t &zoneEnd) {
+      const auto statsEnd = r.GetTree()->GetClusterStatistics(column.c_str(), entry, min, max);
+      zoneEnd = statsEnd;
+      return statsEnd >= 0;
+   };
+   ULong64_t keptEnd = 0ull;
+   bool skippedToEnd = false;
+
    // recursive call to check filters and conditionally execute actions
    // in the non-MT case processing can be stopped early by ranges, hence the check on fNStopsReceived
    try {
-      while (r.Next() && fNStopsReceived < fNChildren) {
+      while (LoadEntry(r, 0u) && fNStopsReceived < fNChildren) {
+         const ULong64_t current = r.GetCurrentEntry();
+         if (canSkip && current >= keptEnd) {
+            const auto kept = SkipRejectedEntries(0u, current, end, getStatistics);
+            if (kept.first >= end) {
+               skippedToEnd = true;
+               break;
+            }
+            // past the last entry, the reader status reports that the end was reached
+            if (kept.first != current && r.SetEntry(kept.first) != TTreeReader::kEntryValid)
+               break;
+            keptEnd = kept.second;
+         }
          RunAndCheckFilters(0, r.GetCurrentEntry());
       }
    } catch (...) {
@@ -373,7 +448,11 @@ void RLoopManager::RunTreeReader()
       std::cerr << "RDataFrame::Run: event loop was interrupted\n";
       throw;
    }
-   if (r.GetEntryStatus() != TTreeReader::kEntryNotFound && fNStopsReceived < fNChildren) {
+   // at the end of an entry range that is not the end of the tree, TTreeReader reports kEntryBeyondEnd
+   const auto status = r.GetEntryStatus();
+   const bool reachedEnd = skippedToEnd || status == TTreeReader::kEntryNotFound ||
+                           (fHasEntryRange && status == TTreeReader::kEntryBeyondEnd);
+   if (!reachedEnd && fNStopsReceived < fNChildren) {
       // something went wrong in the TTreeReader event loop
       throw std::runtime_error("An error was encountered while processing the data. TTreeReader status code is: " +
                                std::to_string(r.GetEntryStatus()));
@@ -386,6 +465,11 @@ void RLoopManager::RunDataSource()
 {
    R__ASSERT(fDataSource != nullptr);
    fDataSource->Initialise();
+   const bool canSkip = !fSkippingFilters.empty();
+   const ColumnStatistics_t getStatistics = [this](const std::string &column, ULong64_t entry, double &min,
+                                                   double &max, ULong64_t &end) {
+      return fDataSource->GetColumnStatistics(column, entry, min, max, end);
+   };
    auto ranges = fDataSource->GetEntryRanges();
    while (!ranges.empty()) {
       InitNodeSlots(nullptr, 0u);
@@ -393,8 +477,16 @@ void RLoopManager::RunDataSource()
       try {
          for (const auto &range : ranges) {
             auto end = range.second;
+            ULong64_t keptEnd = 0ull;
             for (auto entry = range.first; entry < end; ++entry) {
-               if (fDataSource->SetEntry(0u, entry)) {
+               if (canSkip && entry >= keptEnd) {
+                  const auto kept = SkipRejectedEntries(0u, entry, end, getStatistics);
+                  entry = kept.first;
+                  keptEnd = kept.second;
+                  if (entry >= end)
+                     break;
+               }
+               if (LoadEntry(0u, entry)) {
                   RunAndCheckFilters(0u, entry);
                }
             }
@@ -419,15 +511,35 @@ void RLoopManager::RunDataSourceMT()
    RSlotStack slotStack(fNSlots);
    ROOT::TThreadExecutor pool;
 
+   const bool canSkip = !fSkippingFilters.empty();
+   const ColumnStatistics_t getStatistics = [this](const std::string &column, ULong64_t entry, double &min,
+                                                   double &max, ULong64_t &end) {
+      return fDataSource->GetColumnStatistics(column, entry, min, max, end);
+   };
+
+   std::vector<std::pair<ULong64_t, ULong64_t>> ranges;
+   std::size_t firstTask = 0; // tasks are numbered across the batches of entry ranges
+
    // Each task works on a subrange of entries
-   auto runOnRange = [this, &slotStack](const std::pair<ULong64_t, ULong64_t> &range) {
+   auto runOnRange = [this, &slotStack, canSkip, &getStatistics, &ranges, &firstTask](std::size_t rangeIdx) {
+      R__TRACE_SCOPE("rdf", "RLoopManager::RunTask");
+      const auto &range = ranges[rangeIdx];
       const auto slot = slotStack.GetSlot();
       InitNodeSlots(nullptr, slot);
+      SetSlotTask(slot, firstTask + rangeIdx);
       fDataSource->InitSlot(slot, range.first);
-      const auto end = range.second;
+      const auto end = std::min(range.second, fEndEntryMT);
+      ULong64_t keptEnd = 0ull;
       try {
          for (auto entry = range.first; entry < end; ++entry) {
-            if (fDataSource->SetEntry(slot, entry)) {
+            if (canSkip && entry >= keptEnd) {
+               const auto kept = SkipRejectedEntries(slot, entry, end, getStatistics);
+               entry = kept.first;
+               keptEnd = kept.second;
+               if (entry >= end)
+                  break;
+            }
+            if (LoadEntry(slot, entry)) {
                RunAndCheckFilters(slot, entry);
             }
          }
@@ -442,9 +554,10 @@ void RLoopManager::RunDataSourceMT()
    };
 
    fDataSource->Initialise();
-   auto ranges = fDataSource->GetEntryRanges();
+   ranges = fDataSource->GetEntryRanges();
    while (!ranges.empty()) {
-      pool.Foreach(runOnRange, ranges);
+      ForeachTask(pool, ranges.size(), fOrderedTasks, fNSlots, runOnRange);
+      firstTask += ranges.size();
       ranges = fDataSource->GetEntryRanges();
    }
    fDataSource->Finalise();
@@ -455,6 +568,10 @@ void RLoopManager::RunDataSourceMT()
 /// Named filters must be called even if the analysis logic would not require it, lest they report confusing results.
 void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
 {
+   if (fProfiler.IsEnabled())
+      fProfiler.AddEntry(slot);
+   if (fProgressMonitor.IsEnabled())
+      fProgressMonitor.AddEntry(slot);
    for (auto &actionPtr : fBookedActions)
       actionPtr->Run(slot, entry);
    for (auto &namedFilterPtr : fBookedNamedFilters)
@@ -463,6 +580,28 @@ void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
       callback(slot);
 }
 
+/// Load the next entry of the TTreeReader, measuring the time it takes if profiling is enabled.
+bool RLoopManager::LoadEntry(TTreeReader &r, unsigned int slot)
+{
+   if (!fProfiler.IsEnabled())
+      return r.Next();
+   const auto start = ROOT::RDF::RProfiler::Clock_t::now();
+   const bool loaded = r.Next();
+   fProfiler.AddReadTime(slot, start);
+   return loaded;
+}
+
+/// Load an entry of the data source, measuring the time it takes if profiling is enabled.
+bool RLoopManager::LoadEntry(unsigned int slot, ULong64_t entry)
+{
+   if (!fProfiler.IsEnabled())
+      return fDataSource->SetEntry(slot, entry);
+   const auto start = ROOT::RDF::RProfiler::Clock_t::now();
+   const bool loaded = fDataSource->SetEntry(slot, entry);
+   fProfiler.AddReadTime(slot, start);
+   return loaded;
+}
+
 /// Build TTreeReaderValues for all nodes
 /// This method loops over all filters, actions and other booked objects and
 /// calls their `InitRDFValues` methods. It is called once per node per slot, before
@@ -470,6 +609,10 @@ void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
 /// a particular slot will be using.
 void RLoopManager::InitNodeSlots(TTreeReader *r, unsigned int slot)
 {
+   if (r)
+      r->SetLateBranches(fLateBranches);
+   if (fProfiler.IsEnabled())
+      fProfiler.StartTask(slot);
    for (auto &ptr : fBookedActions)
       ptr->InitSlot(r, slot);
    for (auto &ptr : fBookedFilters)
@@ -485,12 +628,179 @@ void RLoopManager::InitNodeSlots(TTreeReader *r, unsigned int slot)
 void RLoopManager::InitNodes()
 {
    EvalChildrenCounts();
+   if (fLoopType == ELoopType::kROOTFiles || fLoopType == ELoopType::kROOTFilesMT)
+      FindLateBranches();
+   FindSkippingFilters();
+   FindEndEntryMT();
+   fOrderedTasks = fNSlots > 1 && std::any_of(fBookedActions.begin(), fBookedActions.end(),
+                                              [](RDFInternal::RActionBase *action) { return action->IsOrdered(); });
+   fSlotTasks.assign(fNSlots, 0u);
+   fNextTaskToEnd = 0u;
    for (auto &filter : fBookedFilters)
       filter->InitNode();
    for (auto &range : fBookedRanges)
       range->InitNode();
    for (auto &ptr : fBookedActions)
       ptr->Initialize();
+   InitProfiles();
+}
+
+/// Collect the branches that are read only downstream of a filter, which the TTreeCache does not need to unzip ahead
+/// of the reader: most of their baskets might not be needed at all if the filters are selective. Branches that are
+/// also read by a node that processes every entry are not included. The filters of a chain of reorderable filters are
+/// evaluated in any order, so they all count as the first filter of the chain.
+void RLoopManager::FindLateBranches()
+{
+   auto hasFiltersUpstream = [](RNodeBase *prev) {
+      while (auto range = dynamic_cast<RRangeBase *>(prev))
+         prev = range->GetPrevNode();
+      return dynamic_cast<RFilterBase *>(prev) != nullptr;
+   };
+
+   std::set<std::string> earlyBranches;
+   std::set<std::string> lateBranches;
+   for (auto filter : fBookedFilters) {
+      RNodeBase *prev = filter->GetPrevNode();
+      if (filter->CanReorder()) {
+         while (auto prevFilter = dynamic_cast<RFilterBase *>(prev)) {
+            if (!prevFilter->CanReorder())
+               break;
+            prev = prevFilter->GetPrevNode();
+         }
+      }
+      filter->AddInputBranchNames(hasFiltersUpstream(prev) ? lateBranches : earlyBranches);
+   }
+   for (auto action : fBookedActions)
+      action->AddInputBranchNames(hasFiltersUpstream(action->GetPrevNode()) ? lateBranches : earlyBranches);
+
+   auto resolveAlias = [this](const std::string &name) -> const std::string & {
+      const auto it = fAliasColumnNameMap.find(name);
+      return it == fAliasColumnNameMap.end() ? name : it->second;
+   };
+   std::set<std::string> resolvedEarlyBranches;
+   for (const auto &name : earlyBranches)
+      resolvedEarlyBranches.insert(resolveAlias(name));
+
+   fLateBranches.clear();
+   for (const auto &name : lateBranches) {
+      const auto &branchName = resolveAlias(name);
+      if (resolvedEarlyBranches.count(branchName) == 0)
+         fLateBranches.insert(branchName);
+   }
+}
+
+/// Return the node attached to this RLoopManager of the chain of filters and ranges that ends with `node`, or nullptr
+/// if the chain contains other nodes.
+RNodeBase *RLoopManager::FindLeadingNode(RNodeBase *node)
+{
+   while (node != this) {
+      RNodeBase *prev = nullptr;
+      if (auto filter = dynamic_cast<RFilterBase *>(node))
+         prev = filter->GetPrevNode();
+      else if (auto range = dynamic_cast<RRangeBase *>(node))
+         prev = range->GetPrevNode();
+      else
+         return nullptr;
+      if (prev == this)
+         return node;
+      node = prev;
+   }
+   return nullptr;
+}
+
+/// Collect the filters that every processed entry has to pass first, if all of them bound the values of dataset
+/// columns: the event loop skips the zones of entries in which, according to the column statistics, each of them
+/// rejects all entries. The skipped entries still count as rejected in the reports. Callbacks have to be called for
+/// every entry and the filters of a chain of reorderable filters are evaluated in any order, so neither can be
+/// combined with skipping.
+void RLoopManager::FindSkippingFilters()
+{
+   fSkippingFilters.clear();
+   if (!fCallbacks.empty())
+      return;
+
+   std::vector<RFilterBase *> skippingFilters;
+   auto addSkippingFilter = [&](RNodeBase *node) {
+      auto filter = dynamic_cast<RFilterBase *>(FindLeadingNode(node));
+      if (!filter || filter->GetColumnBounds().empty() || filter->CanReorder())
+         return false;
+      if (std::find(skippingFilters.begin(), skippingFilters.end(), filter) == skippingFilters.end())
+         skippingFilters.emplace_back(filter);
+      return true;
+   };
+   for (auto action : fBookedActions)
+      if (!addSkippingFilter(action->GetPrevNode()))
+         return;
+   for (auto filter : fBookedNamedFilters)
+      if (!addSkippingFilter(filter))
+         return;
+   fSkippingFilters = std::move(skippingFilters);
+}
+
+/// In multi-thread event loops, ranges are attached to this RLoopManager and select entries by their number in the
+/// dataset. If every action and named filter is downstream of a range with an end, no entry after the last of these
+/// ends is needed: the event loop does not create tasks for them.
+void RLoopManager::FindEndEntryMT()
+{
+   fEndEntryMT = std::numeric_limits<ULong64_t>::max();
+   if (fNSlots == 1 || fBookedActions.empty())
+      return;
+
+   ULong64_t endEntry = 0ull;
+   auto addRange = [&](RNodeBase *node) {
+      auto range = dynamic_cast<RRangeBase *>(FindLeadingNode(node));
+      if (!range || range->GetStop() == 0)
+         return false;
+      endEntry = std::max<ULong64_t>(endEntry, range->GetStop());
+      return true;
+   };
+   for (auto action : fBookedActions)
+      if (!addRange(action->GetPrevNode()))
+         return;
+   for (auto filter : fBookedNamedFilters)
+      if (!addRange(filter))
+         return;
+   fEndEntryMT = endEntry;
+}
+
+/// Skip the zones of entries from `begin` on that all skipping filters reject according to the column statistics,
+/// adding the skipped entries to the rejected entries of the filters. Returns the first entry that is not skipped and
+/// the end of the zone of entries that need not be checked again, at most `end`.
+std::pair<ULong64_t, ULong64_t> RLoopManager::SkipRejectedEntries(unsigned int slot, ULong64_t begin, ULong64_t end,
+                                                                  const ColumnStatistics_t &getStatistics)
+{
+   auto entry = begin;
+   while (entry < end) {
+      auto zoneEnd = end;
+      for (auto filter : fSkippingFilters) {
+         bool rejects = false;
+         for (const auto &bounds : filter->GetColumnBounds()) {
+            double min, max;
+            ULong64_t columnZoneEnd;
+            if (!getStatistics(bounds.fColumnName, entry, min, max, columnZoneEnd) || columnZoneEnd <= entry)
+               continue;
+            zoneEnd = std::min(zoneEnd, columnZoneEnd);
+            if (!bounds.MayMatch(min, max))
+               rejects = true;
+         }
+         if (!rejects)
+            return {entry, zoneEnd};
+      }
+      for (auto filter : fSkippingFilters)
+         filter->AddRejected(slot, zoneEnd - entry);
+      entry = zoneEnd;
+   }
+   return {end, end};
+}
+
+/// Give each filter, define and action the profile it has to fill during the event loop, or none if profiling is
+/// disabled.
+void RLoopManager::InitProfiles()
+{
+   for (auto &filter : fBookedFilters)
+      filter->InitProfile(fProfiler);
+   for (auto &ptr : fBookedActions)
+      ptr->InitProfile(fProfiler);
 }
 
 /// Perform clean-up operations. To be called at the end of each event loop.
@@ -520,21 +830,56 @@ void RLoopManager::CleanUpNodes()
 /// Perform clean-up operations. To be called at the end of each task execution.
 void RLoopManager::CleanUpTask(unsigned int slot)
 {
-   for (auto &ptr : fBookedActions)
-      ptr->FinalizeSlot(slot);
+   if (fProfiler.IsEnabled())
+      fProfiler.EndTask(slot);
+   if (!fOrderedTasks) {
+      for (auto &ptr : fBookedActions)
+         ptr->FinalizeSlot(slot);
+      for (auto &ptr : fBookedFilters)
+         ptr->ClearTask(slot);
+      return;
+   }
+
+   // Ordered actions see the tasks end in the order of their entries. Tasks start in this order too, hence the tasks
+   // this one waits for are all running already.
+   {
+      std::unique_lock<std::mutex> lock(fTaskOrderMutex);
+      fTaskOrderCondition.wait(lock, [this, slot] { return fNextTaskToEnd == fSlotTasks[slot]; });
+   }
+   auto letNextTaskEnd = [this] {
+      {
+         std::lock_guard<std::mutex> lock(fTaskOrderMutex);
+         ++fNextTaskToEnd;
+      }
+      fTaskOrderCondition.notify_all();
+   };
+   try {
+      for (auto &ptr : fBookedActions)
+         ptr->FinalizeSlot(slot);
+   } catch (...) {
+      letNextTaskEnd();
+      throw;
+   }
    for (auto &ptr : fBookedFilters)
       ptr->ClearTask(slot);
+   letNextTaskEnd();
 }
 
 /// Add RDF nodes that require just-in-time compilation to the computation graph.
 /// This method also clears the contents of GetCodeToJit().
+/// Nothing is modified if there is no code to jit, so that the event loops started by RunGraphs()
+/// can call this concurrently after the code of all graphs has been jitted.
 void RLoopManager::Jit()
 {
-   const std::string code = std::move(GetCodeToJit());
-   if (code.empty())
+   auto &codeToJit = GetCodeToJit();
+   if (codeToJit.empty())
       return;
+   const std::string code = std::move(codeToJit);
+   codeToJit.clear();
+   R__TRACE_SCOPE("jit", "RLoopManager::Jit");
 
-   RDFInternal::InterpreterCalc(code, "RLoopManager::Run");
+   if (!RDFInternal::RunWithJitCache(code))
+      RDFInternal::InterpreterCalc(code, "RLoopManager::Run");
 }
 
 /// Trigger counting of number of children nodes for each node of the functional graph.
@@ -551,30 +896,99 @@ void RLoopManager::EvalChildrenCounts()
       namedFilterPtr->TriggerChildrenCount();
 }
 
+/// Return the number of entries the next event loop processes, to estimate its time left, or -1 if it is not known
+/// in advance: the number of entries of a chain is only known once all its files have been opened, and data sources
+/// do not provide it.
+Long64_t RLoopManager::GetNEntriesToProcess() const
+{
+   Long64_t nEntries = -1;
+   if (fHasEntryRange) {
+      nEntries = fEntryRange.second - fEntryRange.first;
+   } else if (fTree) {
+      if (auto entryList = fTree->GetEntryList())
+         nEntries = entryList->GetN();
+      else if (fTree->GetEntriesFast() < TTree::kMaxEntries)
+         nEntries = fTree->GetEntriesFast();
+   } else if (!fDataSource) {
+      nEntries = fNEmptyEntries;
+   }
+   if (nEntries >= 0 && ULong64_t(nEntries) > fEndEntryMT)
+      nEntries = fEndEntryMT;
+   return nEntries;
+}
+
 /// Start the event loop with a different mechanism depending on IMT/no IMT, data source/no data source.
 /// Also perform a few setup and clean-up operations (jit actions if necessary, clear booked actions after the loop...).
 void RLoopManager::Run()
 {
+   R__TRACE_SCOPE("rdf", "RLoopManager::Run");
    ThrowIfPoolSizeChanged(GetNSlots());
 
+   const bool profiling = fProfiler.IsEnabled();
+   const auto jitStart = fProfiler.Now();
    Jit();
+   if (profiling)
+      fProfiler.AddInterval("Jit", -1, jitStart, fProfiler.Now());
 
    InitNodes();
 
-   switch (fLoopType) {
-   case ELoopType::kNoFilesMT: RunEmptySourceMT(); break;
-   case ELoopType::kROOTFilesMT: RunTreeProcessorMT(); break;
-   case ELoopType::kDataSourceMT: RunDataSourceMT(); break;
-   case ELoopType::kNoFiles: RunEmptySource(); break;
-   case ELoopType::kROOTFiles: RunTreeReader(); break;
-   case ELoopType::kDataSource: RunDataSource(); break;
+   const auto loopStart = fProfiler.Now();
+   const auto entriesBefore = fProfiler.GetEntries();
+   // event loops on a range of entries are always sequential, see RunOnEntryRange
+   auto loopType = fLoopType;
+   if (fHasEntryRange)
+      loopType = fTree ? ELoopType::kROOTFiles : ELoopType::kNoFiles;
+   fProgressMonitor.Start(fProgressMonitor.IsEnabled() ? GetNEntriesToProcess() : -1);
+   try {
+      switch (loopType) {
+      case ELoopType::kNoFilesMT: RunEmptySourceMT(); break;
+      case ELoopType::kROOTFilesMT: RunTreeProcessorMT(); break;
+      case ELoopType::kDataSourceMT: RunDataSourceMT(); break;
+      case ELoopType::kNoFiles: RunEmptySource(); break;
+      case ELoopType::kROOTFiles: RunTreeReader(); break;
+      case ELoopType::kDataSource: RunDataSource(); break;
+      }
+   } catch (...) {
+      fProgressMonitor.Stop();
+      throw;
    }
+   fProgressMonitor.Stop();
+   if (profiling)
+      fProfiler.AddInterval("EventLoop", -1, loopStart, fProfiler.Now(), fProfiler.GetEntries() - entriesBefore);
 
    CleanUpNodes();
 
    fNRuns++;
 }
 
+/// Run the event loop unless the given action has already been run. Results of the same computation graph can be
+/// requested concurrently, e.g. from several Python threads, in which case the event loop is run by the first one
+/// while the others wait for it to complete.
+void RLoopManager::RunForAction(const RDFInternal::RActionBase &action)
+{
+   std::lock_guard<std::mutex> lock(fRunMutex);
+   if (!action.HasRun())
+      Run();
+}
+
+/// Run the event loop on the entries [begin, end) only, in sequence, e.g. in one of the processes started by
+/// ROOT::RDF::RunMultiProcess. The results of the actions only contain the contributions of these entries.
+/// Not supported for data sources.
+void RLoopManager::RunOnEntryRange(ULong64_t begin, ULong64_t end)
+{
+   if (fDataSource)
+      throw std::runtime_error("RDataFrame: event loops on a range of entries are not supported for data sources.");
+   fEntryRange = {begin, end};
+   fHasEntryRange = true;
+   try {
+      Run();
+   } catch (...) {
+      fHasEntryRange = false;
+      throw;
+   }
+   fHasEntryRange = false;
+}
+
 /// Return the list of default columns -- empty if none was provided when constructing the RDataFrame
 const ColumnNames_t &RLoopManager::GetDefaultColumnNames() const
 {
@@ -593,6 +1007,7 @@ void RLoopManager::Book(RDFInternal::RActionBase *actionPtr)
 
 void RLoopManager::Deregister(RDFInternal::RActionBase *actionPtr)
 {
+   fProfiler.ForgetNode(actionPtr);
    RDFInternal::Erase(actionPtr, fRunActions);
    RDFInternal::Erase(actionPtr, fBookedActions);
 }
@@ -608,6 +1023,7 @@ void RLoopManager::Book(RFilterBase *filterPtr)
 
 void RLoopManager::Deregister(RFilterBase *filterPtr)
 {
+   fProfiler.ForgetNode(filterPtr);
    RDFInternal::Erase(filterPtr, fBookedFilters);
    RDFInternal::Erase(filterPtr, fBookedNamedFilters);
 }
@@ -640,6 +1056,24 @@ void RLoopManager::ToJitExec(const std::string &code) const
    GetCodeToJit().append(code);
 }
 
+/// Record the variation tags of a column varied with RInterface::Vary.
+/// Throws if the column has already been varied.
+void RLoopManager::AddVariation(const std::string &colName, const std::vector<std::string> &tags)
+{
+   if (!fVariationTags.emplace(colName, tags).second)
+      throw std::runtime_error("Column \"" + colName + "\" has already been varied.");
+}
+
+/// Return the variation tags of a column varied with RInterface::Vary.
+/// Throws if the column has not been varied.
+const std::vector<std::string> &RLoopManager::GetVariationTags(const std::string &colName) const
+{
+   auto it = fVariationTags.find(colName);
+   if (it == fVariationTags.end())
+      throw std::runtime_error("Column \"" + colName + "\" has not been varied: call Vary first.");
+   return it->second;
+}
+
 void RLoopManager::RegisterCallback(ULong64_t everyNEvents, std::function<void(unsigned int)> &&f)
 {
    if (everyNEvents == 0ull)
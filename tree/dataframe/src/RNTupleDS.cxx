@@ -19,6 +19,8 @@
 
 #include <TError.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <typeinfo>
@@ -62,25 +64,69 @@ bool RNTupleDS::SetEntry(unsigned int slot, ULong64_t entryIndex)
    return true;
 }
 
+/// The statistics are taken from the cluster meta-data, if the ntuple was written with cluster statistics (see
+/// RNTupleWriteOptions::SetClusterStatistics()).
+bool RNTupleDS::GetColumnStatistics(std::string_view colName, ULong64_t entry, double &min, double &max,
+                                    ULong64_t &end)
+{
+   if (!HasColumn(colName))
+      return false;
+   const auto &descriptor = fReaders[0]->GetDescriptor();
+   const auto fieldId = descriptor.FindFieldId(colName);
+   if (fieldId == kInvalidDescriptorId)
+      return false;
+   // The statistics describe the elements of the principal column, which correspond to the entries only for
+   // top-level fields with a single value per entry
+   const auto &fieldDesc = descriptor.GetFieldDescriptor(fieldId);
+   if (fieldDesc.GetStructure() != ENTupleStructure::kLeaf || fieldDesc.GetNRepetitions() != 0)
+      return false;
+   const auto columnId = descriptor.FindColumnId(fieldId, 0);
+   if (columnId == kInvalidDescriptorId)
+      return false;
+   const auto clusterId = descriptor.FindClusterId(columnId, entry);
+   if (clusterId == kInvalidDescriptorId)
+      return false;
+   const auto &clusterDesc = descriptor.GetClusterDescriptor(clusterId);
+   const auto &columnRange = clusterDesc.GetColumnRange(columnId);
+   if (!columnRange.fHasStatistics)
+      return false;
+   min = columnRange.fMin;
+   max = columnRange.fMax;
+   end = clusterDesc.GetFirstEntryIndex() + clusterDesc.GetNEntries();
+   return true;
+}
+
 std::vector<std::pair<ULong64_t, ULong64_t>> RNTupleDS::GetEntryRanges()
 {
-   // TODO(jblomer): use cluster boundaries for the entry ranges
    std::vector<std::pair<ULong64_t, ULong64_t>> ranges;
    if (fHasSeenAllRanges) return ranges;
+   fHasSeenAllRanges = true;
 
-   auto nEntries = fReaders[0]->GetNEntries();
-   const auto chunkSize = nEntries / fNSlots;
-   const auto reminder = 1U == fNSlots ? 0 : nEntries % fNSlots;
-   auto start = 0UL;
-   auto end = 0UL;
-   for (auto i : ROOT::TSeqU(fNSlots)) {
-      start = end;
-      end += chunkSize;
-      ranges.emplace_back(start, end);
-      (void)i;
+   // Entry ranges never cross cluster boundaries so that no cluster is read and decompressed by more than one slot
+   const auto &descriptor = fReaders[0]->GetDescriptor();
+   std::vector<std::pair<ULong64_t, ULong64_t>> clusterRanges;
+   clusterRanges.reserve(descriptor.GetNClusters());
+   for (unsigned int i = 0; i < descriptor.GetNClusters(); ++i) {
+      const auto &clusterDesc = descriptor.GetClusterDescriptor(i);
+      const auto nEntries = clusterDesc.GetNEntries();
+      if (nEntries == 0)
+         continue;
+      const auto first = clusterDesc.GetFirstEntryIndex();
+      clusterRanges.emplace_back(first, first + nEntries);
+   }
+   std::sort(clusterRanges.begin(), clusterRanges.end());
+   if (clusterRanges.empty())
+      return ranges;
+
+   // Hand out more ranges than slots, like TTreeProcessorMT does for TTree clusters: the thread executor then
+   // balances the load dynamically among the slots. Only if there are many more clusters than that, neighbouring
+   // clusters are merged into a single range.
+   const std::size_t nMaxRanges = fNSlots == 1 ? 1 : std::size_t(fNSlots) * kTasksPerSlotHint;
+   const std::size_t nClustersPerRange = (clusterRanges.size() + nMaxRanges - 1) / nMaxRanges;
+   for (std::size_t i = 0; i < clusterRanges.size(); i += nClustersPerRange) {
+      const auto last = std::min(i + nClustersPerRange, clusterRanges.size()) - 1;
+      ranges.emplace_back(clusterRanges[i].first, clusterRanges[last].second);
    }
-   ranges.back().second += reminder;
-   fHasSeenAllRanges = true;
    return ranges;
 }
 
@@ -0,0 +1,469 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// clang-format off
+/** \class ROOT::RDF::RParquetDS
+    \ingroup dataframe
+    \brief RDataFrame data source class to read Apache Parquet files.
+
+A RDataFrame that reads one or more Parquet files can be constructed using the factory method
+ROOT::RDF::MakeParquetDataFrame, which accepts two parameters:
+1. The paths of the files. URIs such as `s3://bucket/file.parquet` are supported if the Arrow installation
+supports the corresponding filesystem.
+2. A selection, i.e. a list of cuts of the form `column op value`, where `op` is one of `<`, `<=`, `>`, `>=`,
+`==`, `!=` and `value` is a number (optional).
+
+The files are never loaded in memory as a whole: each processing slot reads one row group at a time, and only the
+columns that are used by the computation graph and by the selection are read. Row groups are distributed to the
+slots by GetEntryRanges().
+
+The cuts of the selection are evaluated on the entries as if they were leading Filters: entries that do not pass
+them are not processed. In addition, the min/max statistics stored in the files are used to skip the row groups
+in which no entry can pass the cuts without reading them. The cuts are evaluated on the values converted to
+`double`, and can only be applied to columns of numbers or booleans.
+
+~~~{.cpp}
+auto df = ROOT::RDF::MakeParquetDataFrame({"data0.parquet", "data1.parquet"}, {"pt > 20", "nJets >= 2"});
+auto h = df.Histo1D("pt"); // only the row groups with entries with pt > 20 and nJets >= 2 are read
+~~~
+
+The types of the columns are derived from the types in the Arrow schema of the files, as in RArrowDS. Columns of
+types that are not supported are not exposed.
+*/
+// clang-format on
+
+#include <ROOT/RDF/Utils.hxx>
+#include <ROOT/RParquetDS.hxx>
+#include <ROOT/RMakeUnique.hxx>
+#include <TError.h> // R__ASSERT
+
+#include <algorithm>
+#include <regex>
+#include <stdexcept>
+#include <string>
+
+#include "RArrowUtils.hxx"
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#endif
+#include <arrow/filesystem/api.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/file_reader.h>
+#include <parquet/metadata.h>
+#include <parquet/schema.h>
+#include <parquet/statistics.h>
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace {
+void ThrowIfError(const arrow::Status &status, const std::string &what)
+{
+   if (!status.ok())
+      throw std::runtime_error("RParquetDS: " + what + ": " + status.ToString());
+}
+
+/// Open a Parquet file, on the local filesystem or on any filesystem that Arrow can access.
+std::unique_ptr<parquet::arrow::FileReader> OpenParquetFile(const std::string &fileName)
+{
+   std::string path;
+   auto fs = arrow::fs::FileSystemFromUriOrPath(fileName, &path);
+   ThrowIfError(fs.status(), "cannot access " + fileName);
+   auto input = (*fs)->OpenInputFile(path);
+   ThrowIfError(input.status(), "cannot open " + fileName);
+   std::unique_ptr<parquet::arrow::FileReader> reader;
+   ThrowIfError(parquet::arrow::OpenFile(*input, arrow::default_memory_pool(), &reader),
+                "cannot read " + fileName + " as a Parquet file");
+   return reader;
+}
+
+bool IsCuttableType(const std::string &typeName)
+{
+   for (auto name : {"bool", "Int_t", "UInt_t", "Long64_t", "ULong64_t", "float", "double"})
+      if (typeName == name)
+         return true;
+   return false;
+}
+
+/// Read the minimum and maximum of the statistics of a column chunk. Return false if they are not available.
+bool GetMinMax(const parquet::Statistics &stats, bool isUnsigned, double &min, double &max)
+{
+   if (!stats.HasMinMax())
+      return false;
+   switch (stats.physical_type()) {
+   case parquet::Type::BOOLEAN: {
+      const auto &s = static_cast<const parquet::BoolStatistics &>(stats);
+      min = s.min();
+      max = s.max();
+      return true;
+   }
+   case parquet::Type::INT32: {
+      // unsigned values are stored as signed integers of the same size
+      const auto &s = static_cast<const parquet::Int32Statistics &>(stats);
+      min = isUnsigned ? static_cast<uint32_t>(s.min()) : s.min();
+      max = isUnsigned ? static_cast<uint32_t>(s.max()) : s.max();
+      return true;
+   }
+   case parquet::Type::INT64: {
+      const auto &s = static_cast<const parquet::Int64Statistics &>(stats);
+      min = isUnsigned ? static_cast<uint64_t>(s.min()) : s.min();
+      max = isUnsigned ? static_cast<uint64_t>(s.max()) : s.max();
+      return true;
+   }
+   case parquet::Type::FLOAT: {
+      const auto &s = static_cast<const parquet::FloatStatistics &>(stats);
+      min = s.min();
+      max = s.max();
+      return true;
+   }
+   case parquet::Type::DOUBLE: {
+      const auto &s = static_cast<const parquet::DoubleStatistics &>(stats);
+      min = s.min();
+      max = s.max();
+      return true;
+   }
+   default: return false;
+   }
+}
+
+/// Return the value that a pointer returned by ArrayPtrVisitor points to, converted to double.
+double ValueAsDouble(const void *ptr, arrow::Type::type typeId)
+{
+   switch (typeId) {
+   case arrow::Type::BOOL: return *static_cast<const bool *>(ptr);
+   case arrow::Type::INT32: return *static_cast<const int32_t *>(ptr);
+   case arrow::Type::UINT32: return *static_cast<const uint32_t *>(ptr);
+   case arrow::Type::INT64: return *static_cast<const int64_t *>(ptr);
+   case arrow::Type::UINT64: return *static_cast<const uint64_t *>(ptr);
+   case arrow::Type::FLOAT: return *static_cast<const float *>(ptr);
+   case arrow::Type::DOUBLE: return *static_cast<const double *>(ptr);
+   default: throw std::runtime_error("RParquetDS: cannot apply a cut to a column of this type.");
+   }
+}
+} // anonymous namespace
+
+namespace ROOT {
+
+namespace RDF {
+
+/// The current row group of a processing slot and the readers it uses.
+struct RParquetDS::RSlotData {
+   struct RColumn {
+      std::shared_ptr<arrow::ChunkedArray> fData;
+      std::vector<int64_t> fChunkEnds; ///< Number of entries of the row group up to the end of each chunk
+      std::size_t fChunk = 0;
+      arrow::Type::type fTypeId = arrow::Type::NA;
+      ROOT::Internal::RDF::ArrayPtrVisitor fVisitor;
+      explicit RColumn(void **result) : fVisitor(result) {}
+   };
+
+   std::vector<std::unique_ptr<parquet::arrow::FileReader>> fReaders; ///< One per file, opened on first use
+   std::vector<RColumn> fColumns;                                     ///< One per column of the dataset
+   ULong64_t fFirstEntry = 0ULL;
+   ULong64_t fNEntries = 0ULL; ///< Zero if no row group is loaded
+};
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor to create a Parquet RDataSource for RDataFrame.
+/// \param[in] fileNames Paths or URIs of the Parquet files, which must have the same schema.
+/// \param[in] selection Cuts of the form `column op value` that the entries must pass.
+///
+/// The metadata of all files are read, to compute the number of entries of the row groups and to check their
+/// statistics against the selection.
+RParquetDS::RParquetDS(const std::vector<std::string> &fileNames, const std::vector<std::string> &selection)
+   : fFileNames(fileNames)
+{
+   if (fFileNames.empty())
+      throw std::runtime_error("RParquetDS: at least one file is required.");
+
+   std::shared_ptr<arrow::Schema> schema;
+   ULong64_t nEntries = 0ULL;
+   for (std::size_t fileIdx = 0; fileIdx < fFileNames.size(); ++fileIdx) {
+      auto reader = OpenParquetFile(fFileNames[fileIdx]);
+      std::shared_ptr<arrow::Schema> fileSchema;
+      ThrowIfError(reader->GetSchema(&fileSchema), "cannot read the schema of " + fFileNames[fileIdx]);
+      auto metadata = reader->parquet_reader()->metadata();
+
+      if (fileIdx == 0) {
+         schema = fileSchema;
+         const auto &descr = *metadata->schema();
+         for (const auto &field : schema->fields()) {
+            ROOT::RDF::VerifyValidColumnType verifyType;
+            ROOT::RDF::RDFTypeNameGetter typeGetter;
+            if (!field->type()->Accept(&verifyType).ok() || !field->type()->Accept(&typeGetter).ok())
+               continue;
+            std::vector<int> leaves;
+            for (int leaf = 0; leaf < descr.num_columns(); ++leaf)
+               if (descr.Column(leaf)->path()->ToDotVector().front() == field->name())
+                  leaves.push_back(leaf);
+            fColumnNames.push_back(field->name());
+            fColumnTypes.push_back(typeGetter.result());
+            fLeafIndices.push_back(leaves);
+         }
+
+         static const std::regex cutRegex(R"(^\s*([A-Za-z_][A-Za-z0-9_.]*)\s*(<=|>=|==|!=|<|>)\s*(\S+)\s*$)");
+         for (const auto &cutExpr : selection) {
+            std::smatch match;
+            if (!std::regex_match(cutExpr, match, cutRegex))
+               throw std::runtime_error("RParquetDS: cannot parse the cut \"" + cutExpr +
+                                        "\", expected the form `column op value`.");
+            const auto column = GetColumnIndex(match[1].str());
+            if (!IsCuttableType(fColumnTypes[column]))
+               throw std::runtime_error("RParquetDS: the cut \"" + cutExpr + "\" is on column " + match[1].str() +
+                                        " of type " + fColumnTypes[column] + ", only numbers can be cut on.");
+            std::size_t parsed = 0;
+            double value = 0.;
+            try {
+               value = std::stod(match[3].str(), &parsed);
+            } catch (const std::logic_error &) {
+            }
+            if (parsed == 0 || parsed != static_cast<std::size_t>(match[3].length()))
+               throw std::runtime_error("RParquetDS: the value of the cut \"" + cutExpr + "\" is not a number.");
+            const auto &op = match[2];
+            const auto eop = op == "<"    ? RCut::EOp::kLess
+                             : op == "<=" ? RCut::EOp::kLessEqual
+                             : op == ">"  ? RCut::EOp::kGreater
+                             : op == ">=" ? RCut::EOp::kGreaterEqual
+                             : op == "==" ? RCut::EOp::kEqual
+                                          : RCut::EOp::kNotEqual;
+            fCuts.push_back({column, eop, value});
+            if (std::find(fReadColumns.begin(), fReadColumns.end(), column) == fReadColumns.end())
+               fReadColumns.push_back(column);
+         }
+      } else if (!fileSchema->Equals(*schema)) {
+         throw std::runtime_error("RParquetDS: the schema of " + fFileNames[fileIdx] + " differs from the schema of " +
+                                  fFileNames[0] + ".");
+      }
+
+      for (int rg = 0; rg < metadata->num_row_groups(); ++rg) {
+         auto rgMetadata = metadata->RowGroup(rg);
+         const auto nRows = static_cast<ULong64_t>(rgMetadata->num_rows());
+         if (nRows == 0ULL)
+            continue;
+
+         // a row group is rejected if the range of values of a column cannot pass a cut on that column
+         bool mayPass = true;
+         for (const auto &cut : fCuts) {
+            const auto &leaves = fLeafIndices[cut.fColumn];
+            auto chunkMetadata = rgMetadata->ColumnChunk(leaves.front());
+            if (!chunkMetadata->is_stats_set())
+               continue;
+            const auto &type = fColumnTypes[cut.fColumn];
+            double min = 0., max = 0.;
+            if (!GetMinMax(*chunkMetadata->statistics(), type == "UInt_t" || type == "ULong64_t", min, max))
+               continue;
+            switch (cut.fOp) {
+            case RCut::EOp::kLess: mayPass = min < cut.fValue; break;
+            case RCut::EOp::kLessEqual: mayPass = min <= cut.fValue; break;
+            case RCut::EOp::kGreater: mayPass = max > cut.fValue; break;
+            case RCut::EOp::kGreaterEqual: mayPass = max >= cut.fValue; break;
+            case RCut::EOp::kEqual: mayPass = min <= cut.fValue && cut.fValue <= max; break;
+            case RCut::EOp::kNotEqual: mayPass = !(min == cut.fValue && max == cut.fValue); break;
+            }
+            if (!mayPass)
+               break;
+         }
+
+         if (mayPass)
+            fRowGroups.push_back({fileIdx, rg, nEntries, nRows});
+         else
+            ++fNRejectedRowGroups;
+         nEntries += nRows;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Destructor.
+RParquetDS::~RParquetDS()
+{
+}
+
+const std::vector<std::string> &RParquetDS::GetColumnNames() const
+{
+   return fColumnNames;
+}
+
+std::size_t RParquetDS::GetColumnIndex(std::string_view colName) const
+{
+   const auto it = std::find(fColumnNames.begin(), fColumnNames.end(), colName);
+   if (it == fColumnNames.end()) {
+      std::string msg = "The dataset does not have column ";
+      msg += colName;
+      throw std::runtime_error(msg);
+   }
+   return std::distance(fColumnNames.begin(), it);
+}
+
+/// Return one range per row group, for at most one row group per slot.
+std::vector<std::pair<ULong64_t, ULong64_t>> RParquetDS::GetEntryRanges()
+{
+   std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
+   for (; fNextRowGroup < fRowGroups.size() && entryRanges.size() < fNSlots; ++fNextRowGroup) {
+      const auto &rg = fRowGroups[fNextRowGroup];
+      entryRanges.emplace_back(rg.fFirstEntry, rg.fFirstEntry + rg.fNEntries);
+   }
+   return entryRanges;
+}
+
+std::string RParquetDS::GetTypeName(std::string_view colName) const
+{
+   return fColumnTypes[GetColumnIndex(colName)];
+}
+
+bool RParquetDS::HasColumn(std::string_view colName) const
+{
+   return fColumnNames.end() != std::find(fColumnNames.begin(), fColumnNames.end(), colName);
+}
+
+/// Read the columns that are used from the row group that contains the entry.
+/// Called by SetEntry, so that the row groups of different slots are read and decompressed concurrently.
+void RParquetDS::LoadRowGroup(unsigned int slot, ULong64_t entry)
+{
+   auto it = std::upper_bound(fRowGroups.begin(), fRowGroups.end(), entry,
+                              [](ULong64_t e, const RRowGroup &rg) { return e < rg.fFirstEntry; });
+   R__ASSERT(it != fRowGroups.begin() && "Entry does not belong to a row group.");
+   const auto &rg = *(it - 1);
+
+   auto &slotData = *fSlots[slot];
+   slotData.fFirstEntry = rg.fFirstEntry;
+   slotData.fNEntries = rg.fNEntries;
+   if (fReadColumns.empty())
+      return; // e.g. only entries are counted
+
+   auto &reader = slotData.fReaders[rg.fFile];
+   if (!reader)
+      reader = OpenParquetFile(fFileNames[rg.fFile]);
+
+   std::vector<int> leaves;
+   for (auto col : fReadColumns)
+      leaves.insert(leaves.end(), fLeafIndices[col].begin(), fLeafIndices[col].end());
+   std::shared_ptr<arrow::Table> table;
+   ThrowIfError(reader->ReadRowGroup(rg.fIndex, leaves, &table),
+                "cannot read row group " + std::to_string(rg.fIndex) + " of " + fFileNames[rg.fFile]);
+
+   for (auto col : fReadColumns) {
+      auto &column = slotData.fColumns[col];
+      column.fData = table->GetColumnByName(fColumnNames[col]);
+      column.fTypeId = column.fData->type()->id();
+      column.fChunkEnds.clear();
+      int64_t end = 0;
+      for (const auto &chunk : column.fData->chunks()) {
+         end += chunk->length();
+         column.fChunkEnds.push_back(end);
+      }
+      column.fChunk = 0;
+   }
+}
+
+bool RParquetDS::SetEntry(unsigned int slot, ULong64_t entry)
+{
+   auto &slotData = *fSlots[slot];
+   if (entry < slotData.fFirstEntry || entry >= slotData.fFirstEntry + slotData.fNEntries)
+      LoadRowGroup(slot, entry);
+
+   const auto localEntry = static_cast<int64_t>(entry - slotData.fFirstEntry);
+   for (auto col : fReadColumns) {
+      auto &column = slotData.fColumns[col];
+      // entries are read in order: the chunk is the current one or one of the following ones
+      if (column.fChunk > 0 && localEntry < column.fChunkEnds[column.fChunk - 1])
+         column.fChunk = 0;
+      while (localEntry >= column.fChunkEnds[column.fChunk])
+         ++column.fChunk;
+      const auto chunkStart = column.fChunk == 0 ? 0 : column.fChunkEnds[column.fChunk - 1];
+      column.fVisitor.SetEntry(localEntry - chunkStart);
+      auto status = column.fData->chunk(column.fChunk)->Accept(&column.fVisitor);
+      if (!status.ok()) {
+         std::string msg = "Could not get pointer for slot ";
+         msg += std::to_string(slot) + " looking at entry " + std::to_string(entry);
+         throw std::runtime_error(msg);
+      }
+   }
+
+   for (const auto &cut : fCuts) {
+      const auto value = ValueAsDouble(fColAddresses[cut.fColumn][slot], slotData.fColumns[cut.fColumn].fTypeId);
+      bool pass = true;
+      switch (cut.fOp) {
+      case RCut::EOp::kLess: pass = value < cut.fValue; break;
+      case RCut::EOp::kLessEqual: pass = value <= cut.fValue; break;
+      case RCut::EOp::kGreater: pass = value > cut.fValue; break;
+      case RCut::EOp::kGreaterEqual: pass = value >= cut.fValue; break;
+      case RCut::EOp::kEqual: pass = value == cut.fValue; break;
+      case RCut::EOp::kNotEqual: pass = value != cut.fValue; break;
+      }
+      if (!pass)
+         return false;
+   }
+   return true;
+}
+
+void RParquetDS::SetNSlots(unsigned int nSlots)
+{
+   R__ASSERT(0U == fNSlots && "Setting the number of slots even if the number of slots is different from zero.");
+   fNSlots = nSlots;
+
+   // the addresses of the values must not change after this, the visitors of the slots point to them
+   const auto nColumns = fColumnNames.size();
+   fColAddresses.resize(nColumns, std::vector<void *>(fNSlots, nullptr));
+   for (auto slot = 0U; slot < fNSlots; ++slot) {
+      auto slotData = std::make_unique<RSlotData>();
+      slotData->fReaders.resize(fFileNames.size());
+      slotData->fColumns.reserve(nColumns);
+      for (std::size_t col = 0; col < nColumns; ++col)
+         slotData->fColumns.emplace_back(&fColAddresses[col][slot]);
+      fSlots.emplace_back(std::move(slotData));
+   }
+}
+
+/// Only the columns requested here are read from the files, in addition to the ones of the selection.
+std::vector<void *> RParquetDS::GetColumnReadersImpl(std::string_view colName, const std::type_info &)
+{
+   const auto col = GetColumnIndex(colName);
+   if (std::find(fReadColumns.begin(), fReadColumns.end(), col) == fReadColumns.end())
+      fReadColumns.push_back(col);
+
+   std::vector<void *> ret(fNSlots);
+   for (auto slot = 0U; slot < fNSlots; ++slot)
+      ret[slot] = &fColAddresses[col][slot];
+   return ret;
+}
+
+void RParquetDS::Initialise()
+{
+   fNextRowGroup = 0;
+   // columns might have been requested since the last event loop: row groups are read again
+   for (auto &slotData : fSlots)
+      slotData->fNEntries = 0ULL;
+}
+
+void RParquetDS::Finalise()
+{
+   for (auto &slotData : fSlots) {
+      slotData->fNEntries = 0ULL;
+      for (auto &column : slotData->fColumns)
+         column.fData.reset();
+   }
+}
+
+std::string RParquetDS::GetLabel()
+{
+   return "ParquetDS";
+}
+
+RDataFrame MakeParquetDataFrame(const std::vector<std::string> &fileNames, const std::vector<std::string> &selection)
+{
+   ROOT::RDataFrame tdf(std::make_unique<RParquetDS>(fileNames, selection));
+   return tdf;
+}
+
+} // namespace RDF
+
+} // namespace ROOT
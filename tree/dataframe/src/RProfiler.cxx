@@ -0,0 +1,224 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RProfiler.hxx"
+
+#include <algorithm>
+#include <cstdio> // snprintf
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+
+using ROOT::RDF::RNodeProfile;
+using ROOT::RDF::RProfiler;
+
+namespace {
+/// Escape a string so that it can be written as a JSON string literal.
+std::string EscapeJSON(const std::string &str)
+{
+   std::string escaped;
+   escaped.reserve(str.size());
+   for (const char c : str) {
+      switch (c) {
+      case '"': escaped += "\\\""; break;
+      case '\\': escaped += "\\\\"; break;
+      case '\n': escaped += "\\n"; break;
+      case '\t': escaped += "\\t"; break;
+      default:
+         if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", c);
+            escaped += buf;
+         } else {
+            escaped += c;
+         }
+      }
+   }
+   return escaped;
+}
+
+/// Return the name of a node on a single line.
+std::string SingleLine(std::string name)
+{
+   std::replace(name.begin(), name.end(), '\n', ' ');
+   return name;
+}
+} // anonymous namespace
+
+ULong64_t RNodeProfile::GetCalls() const
+{
+   return std::accumulate(fCalls.begin(), fCalls.end(), 0ull);
+}
+
+ULong64_t RNodeProfile::GetEntries() const
+{
+   return std::accumulate(fEntries.begin(), fEntries.end(), 0ull);
+}
+
+double RNodeProfile::GetTime() const
+{
+   return std::accumulate(fTimes.begin(), fTimes.end(), 0.);
+}
+
+/// Return a short description of the profile, e.g. "1000 calls, 12.3 ms".
+std::string RNodeProfile::GetSummary() const
+{
+   char buf[64];
+   snprintf(buf, sizeof(buf), "%llu calls, %.3g ms", GetCalls(), GetTime() * 1e3);
+   return buf;
+}
+
+void RNodeProfile::Reset()
+{
+   std::fill(fCalls.begin(), fCalls.end(), 0ull);
+   std::fill(fEntries.begin(), fEntries.end(), 0ull);
+   std::fill(fTimes.begin(), fTimes.end(), 0.);
+}
+
+RProfiler::RProfiler(unsigned int nSlots)
+   : fNSlots(nSlots), fEntries(nSlots, 0ull), fReadTimes(nSlots, 0.), fTaskStarts(nSlots, 0.),
+     fTaskEntries(nSlots, 0ull)
+{
+}
+
+/// Return the profile of the given node, creating it if needed.
+/// Profiles are never erased while the nodes are alive, so the nodes can keep a reference to them.
+RNodeProfile &RProfiler::GetNodeProfile(const void *node, const std::string &name)
+{
+   auto it = fNodes.find(node);
+   if (it == fNodes.end()) {
+      it = fNodes.emplace(node, RNodeProfile(name, fNSlots)).first;
+      fNodesOrder.emplace_back(node);
+   } else {
+      it->second.SetName(name);
+   }
+   return it->second;
+}
+
+/// Erase the profile of a node that is being destroyed.
+void RProfiler::ForgetNode(const void *node)
+{
+   if (fNodes.erase(node) > 0)
+      fNodesOrder.erase(std::find(fNodesOrder.begin(), fNodesOrder.end(), node));
+}
+
+void RProfiler::AddInterval(const std::string &name, int slot, double start, double end, ULong64_t entries)
+{
+   std::lock_guard<std::mutex> lock(fIntervalsMutex);
+   fIntervals.push_back({name, slot, start, end, entries});
+}
+
+void RProfiler::StartTask(unsigned int slot)
+{
+   fTaskStarts[slot] = Now();
+   fTaskEntries[slot] = fEntries[slot];
+}
+
+void RProfiler::EndTask(unsigned int slot)
+{
+   AddInterval("Task", slot, fTaskStarts[slot], Now(), fEntries[slot] - fTaskEntries[slot]);
+}
+
+/// Return the profiles of the nodes, in the order in which they were registered.
+std::vector<const RNodeProfile *> RProfiler::GetNodeProfiles() const
+{
+   std::vector<const RNodeProfile *> profiles;
+   for (auto node : fNodesOrder)
+      profiles.emplace_back(&fNodes.at(node));
+   return profiles;
+}
+
+ULong64_t RProfiler::GetEntries() const
+{
+   return std::accumulate(fEntries.begin(), fEntries.end(), 0ull);
+}
+
+double RProfiler::GetReadTime() const
+{
+   return std::accumulate(fReadTimes.begin(), fReadTimes.end(), 0.);
+}
+
+double RProfiler::GetJitTime() const
+{
+   double jitTime = 0.;
+   for (const auto &interval : fIntervals)
+      if (interval.fName == "Jit")
+         jitTime += interval.fEnd - interval.fStart;
+   return jitTime;
+}
+
+/// Print a table with the statistics of each node and of each slot.
+void RProfiler::Print(std::ostream &os) const
+{
+   os << "Entries processed: " << GetEntries() << "\nTime spent jitting: " << GetJitTime()
+      << " s\nTime spent loading entries: " << GetReadTime() << " s\n";
+   os << std::left << std::setw(40) << "Node" << std::right << std::setw(14) << "Calls" << std::setw(14) << "Entries"
+      << std::setw(14) << "Time [s]" << '\n';
+   for (auto profile : GetNodeProfiles())
+      os << std::left << std::setw(40) << SingleLine(profile->GetName()) << std::right << std::setw(14)
+         << profile->GetCalls() << std::setw(14) << profile->GetEntries() << std::setw(14) << profile->GetTime()
+         << '\n';
+   for (auto slot = 0u; slot < fNSlots; ++slot) {
+      if (fEntries[slot] == 0ull)
+         continue;
+      os << "Slot " << slot << ": " << fEntries[slot] << " entries, " << fReadTimes[slot] << " s loading entries\n";
+   }
+}
+
+/// Return the recorded intervals in the Chrome trace event format, which can be visualized e.g. with chrome://tracing
+/// or Perfetto. The intervals of each slot are shown in their own row, the statistics of the nodes are stored in the
+/// `otherData` section.
+std::string RProfiler::ToChromeTrace() const
+{
+   std::ostringstream os;
+   os << std::setprecision(15);
+   os << "{\"traceEvents\": [";
+   bool first = true;
+   auto separator = [&first]() {
+      const char *sep = first ? "\n" : ",\n";
+      first = false;
+      return sep;
+   };
+   os << separator() << R"({"name": "thread_name", "ph": "M", "pid": 0, "tid": 0, "args": {"name": "RLoopManager"}})";
+   for (auto slot = 0u; slot < fNSlots; ++slot)
+      os << separator() << R"({"name": "thread_name", "ph": "M", "pid": 0, "tid": )" << slot + 1
+         << R"(, "args": {"name": "slot )" << slot << "\"}}";
+   for (const auto &interval : fIntervals) {
+      os << separator() << "{\"name\": \"" << EscapeJSON(interval.fName) << R"(", "cat": "RDataFrame", "ph": "X", )"
+         << "\"ts\": " << interval.fStart * 1e6 << ", \"dur\": " << (interval.fEnd - interval.fStart) * 1e6
+         << ", \"pid\": 0, \"tid\": " << interval.fSlot + 1 << ", \"args\": {\"entries\": " << interval.fEntries
+         << "}}";
+   }
+   os << "\n],\n\"displayTimeUnit\": \"ms\",\n\"otherData\": {";
+   first = true;
+   // several nodes can have the same name (e.g. "Filter"): keys are made unique with the index of the node
+   unsigned int index = 0u;
+   for (auto profile : GetNodeProfiles()) {
+      std::ostringstream stats;
+      stats << "calls: " << profile->GetCalls() << ", entries: " << profile->GetEntries()
+            << ", time [s]: " << profile->GetTime();
+      os << separator() << '"' << index++ << ": " << EscapeJSON(SingleLine(profile->GetName())) << "\": \""
+         << stats.str() << '"';
+   }
+   os << separator() << "\"entries\": \"" << GetEntries() << '"';
+   os << separator() << "\"read time [s]\": \"" << GetReadTime() << '"';
+   os << separator() << "\"jit time [s]\": \"" << GetJitTime() << '"';
+   os << "\n}}\n";
+   return os.str();
+}
+
+/// Clear all statistics collected so far. Node profiles are kept, with their counters set to zero.
+void RProfiler::Reset()
+{
+   for (auto &node : fNodes)
+      node.second.Reset();
+   std::fill(fEntries.begin(), fEntries.end(), 0ull);
+   std::fill(fReadTimes.begin(), fReadTimes.end(), 0.);
+   std::lock_guard<std::mutex> lock(fIntervalsMutex);
+   fIntervals.clear();
+}
@@ -0,0 +1,150 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RProgressMonitor.hxx"
+#include "TFile.h" // GetFileBytesRead
+
+#include <algorithm>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+using ROOT::RDF::RProgressInfo;
+using ROOT::RDF::RProgressMonitor;
+
+/// Return the snapshot on a single line, e.g. `[12.0 s] 1200000/4000000 entries (30.0%), 100000 entries/s,
+/// 25.2 MB/s, 28.0 s left`.
+std::string RProgressInfo::AsString() const
+{
+   std::ostringstream os;
+   os << std::fixed << std::setprecision(1) << '[' << fElapsed << " s] " << fEntries;
+   if (fTotalEntries >= 0) {
+      os << '/' << fTotalEntries << " entries";
+      if (fTotalEntries > 0)
+         os << " (" << 100. * fEntries / fTotalEntries << "%)";
+   } else {
+      os << " entries";
+   }
+   os << ", " << std::setprecision(0) << fEntriesPerSecond << " entries/s, " << std::setprecision(1)
+      << fBytesPerSecond / 1e6 << " MB/s";
+   if (fTimeLeft >= 0.)
+      os << ", " << fTimeLeft << " s left";
+   return os.str();
+}
+
+RProgressMonitor::RProgressMonitor(unsigned int nSlots) : fNSlots(nSlots), fSlotCounters(new RSlotCounter[nSlots]) {}
+
+RProgressMonitor::~RProgressMonitor()
+{
+   if (fThread.joinable())
+      Stop();
+}
+
+/// Set the number of seconds between two snapshots taken while an event loop runs.
+void RProgressMonitor::SetInterval(double seconds)
+{
+   if (seconds <= 0.)
+      throw std::runtime_error("RProgressMonitor::SetInterval: the interval must be positive.");
+   fInterval = seconds;
+}
+
+/// Print the snapshots to the given stream, one per line.
+void RProgressMonitor::PrintTo(std::ostream &os)
+{
+   fStream = &os;
+   fEnabled = true;
+}
+
+/// Pass the snapshots to the given callback.
+void RProgressMonitor::AddCallback(Callback_t callback)
+{
+   fCallbacks.emplace_back(std::move(callback));
+   fEnabled = true;
+}
+
+/// Remove the stream and the callbacks: the next event loops are not monitored.
+void RProgressMonitor::Clear()
+{
+   fStream = nullptr;
+   fCallbacks.clear();
+   fEnabled = false;
+}
+
+RProgressInfo RProgressMonitor::TakeSnapshot(bool isFinal) const
+{
+   RProgressInfo info;
+   info.fElapsed = std::chrono::duration<double>(Clock_t::now() - fStart).count();
+   info.fTotalEntries = fTotalEntries;
+   info.fBytesRead = TFile::GetFileBytesRead() - fBytesReadAtStart;
+   info.fIsFinal = isFinal;
+   info.fSlotEntries.resize(fNSlots);
+   for (auto slot = 0u; slot < fNSlots; ++slot)
+      info.fSlotEntries[slot] = fSlotCounters[slot].fEntries.load(std::memory_order_relaxed);
+   info.fEntries = std::accumulate(info.fSlotEntries.begin(), info.fSlotEntries.end(), 0ull);
+
+   // rates are computed since the previous snapshot, so that a stall shows up right away
+   const auto dt = info.fElapsed - fLastInfo.fElapsed;
+   info.fSlotEntriesPerSecond.assign(fNSlots, 0.);
+   if (dt > 0.) {
+      info.fEntriesPerSecond = (info.fEntries - fLastInfo.fEntries) / dt;
+      info.fBytesPerSecond = (info.fBytesRead - fLastInfo.fBytesRead) / dt;
+      for (auto slot = 0u; slot < fNSlots; ++slot)
+         info.fSlotEntriesPerSecond[slot] = (info.fSlotEntries[slot] - fLastInfo.fSlotEntries[slot]) / dt;
+   }
+   // the time left is estimated with the average rate, which fluctuates less
+   if (isFinal)
+      info.fTimeLeft = 0.;
+   else if (fTotalEntries >= 0 && info.fEntries > 0)
+      info.fTimeLeft = std::max(0., info.fElapsed * (fTotalEntries - double(info.fEntries)) / info.fEntries);
+   return info;
+}
+
+void RProgressMonitor::Publish(bool isFinal)
+{
+   fLastInfo = TakeSnapshot(isFinal);
+   if (fStream)
+      *fStream << fLastInfo.AsString() << std::endl;
+   for (auto &callback : fCallbacks)
+      callback(fLastInfo);
+}
+
+/// Start monitoring an event loop that processes `totalEntries` entries (-1 if not known), if an output is set.
+void RProgressMonitor::Start(Long64_t totalEntries)
+{
+   if (!fEnabled)
+      return;
+   for (auto slot = 0u; slot < fNSlots; ++slot)
+      fSlotCounters[slot].fEntries.store(0ull, std::memory_order_relaxed);
+   fStart = Clock_t::now();
+   fTotalEntries = totalEntries;
+   fBytesReadAtStart = TFile::GetFileBytesRead();
+   fLastInfo = RProgressInfo();
+   fLastInfo.fSlotEntries.assign(fNSlots, 0ull);
+   fStopRequested = false;
+   fThread = std::thread([this] {
+      std::unique_lock<std::mutex> lock(fMutex);
+      const std::chrono::duration<double> interval(fInterval);
+      while (!fCondition.wait_for(lock, interval, [this] { return fStopRequested; }))
+         Publish(/*isFinal=*/false);
+   });
+}
+
+/// Stop monitoring the current event loop and publish its final snapshot.
+void RProgressMonitor::Stop()
+{
+   if (!fThread.joinable())
+      return;
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fStopRequested = true;
+   }
+   fCondition.notify_one();
+   fThread.join();
+   Publish(/*isFinal=*/true);
+}
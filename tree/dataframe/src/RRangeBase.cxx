@@ -24,5 +24,13 @@ void RRangeBase::ResetCounters()
    fHasStopped = false;
 }
 
+/// Whether the range selects an entry by its number in the dataset. In multi-thread event loops, ranges are attached
+/// to the head node, so the n-th entry of the dataset is the n-th entry the range processes in sequential event loops.
+bool RRangeBase::IsSelected(ULong64_t entry) const
+{
+   const auto n = entry + 1;
+   return n > fStart && (fStop == 0 || n <= fStop) && (fStride == 1 || n % fStride == 0);
+}
+
 // outlined to pin virtual table
 RRangeBase::~RRangeBase() { }
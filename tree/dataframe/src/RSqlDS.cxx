@@ -0,0 +1,310 @@
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// clang-format off
+/** \class ROOT::RDF::RSqlDS
+    \ingroup dataframe
+    \brief RDataFrame data source class for reading the result set of a query to any SQL server supported by TSQLServer.
+
+A RDataFrame reading the result set of a SELECT query can be constructed with the factory method
+ROOT::RDF::MakeSqlDataFrame:
+~~~{.cpp}
+auto rdf = ROOT::RDF::MakeSqlDataFrame("mysql://host/conditions", "SELECT run, lumi FROM runs", "user", "password");
+~~~
+
+The rows are fetched from the server in chunks with TSQLStatement::NextResultRows, which fills column-wise
+buffers of many rows at a time. Only the columns used by the RDataFrame are read. The rows of each chunk are
+split among the slots.
+
+The types of the columns are inferred from the values of the first chunk of rows, read when the data source is
+constructed. The supported types are:
+- Integer: stored as a 64-bit long long int, if all the values are integer numbers.
+- Floating point number: stored with double precision, if all the values are numbers.
+- String: stored as an std::string otherwise, e.g. for dates or for columns with only null values.
+
+Null values are read as 0 or as empty string. Each event loop executes the query again.
+*/
+// clang-format on
+
+#include <ROOT/RSqlDS.hxx>
+#include <ROOT/RDF/Utils.hxx>
+#include <ROOT/TSeq.hxx>
+
+#include "TError.h"
+#include "TSQLServer.h"
+#include "TSQLStatement.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace ROOT {
+
+namespace RDF {
+
+RSqlDS::RSqlDS(std::string_view url, std::string_view query, std::string_view user, std::string_view password,
+               Int_t rowsChunkSize)
+   : fQuery(query), fRowsChunkSize(rowsChunkSize > 0 ? rowsChunkSize : 1)
+{
+   fServer.reset(TSQLServer::Connect(std::string(url).c_str(), std::string(user).c_str(),
+                                     std::string(password).c_str()));
+   if (!fServer || !fServer->IsConnected()) {
+      std::string msg = "Cannot connect to the SQL server ";
+      msg += url;
+      throw std::runtime_error(msg);
+   }
+
+   InferColTypes();
+}
+
+RSqlDS::~RSqlDS()
+{
+   fStmt.reset();
+}
+
+/// Execute the query and return the statement holding the result set. The caller owns the statement.
+TSQLStatement *RSqlDS::ExecuteQuery()
+{
+   std::unique_ptr<TSQLStatement> stmt(fServer->Statement(fQuery.c_str()));
+   if (!stmt || !stmt->Process() || !stmt->StoreResult()) {
+      std::string msg = "Cannot execute the query \"" + fQuery + "\"";
+      if (stmt && stmt->IsError()) {
+         msg += ": ";
+         msg += stmt->GetErrorMsg();
+      }
+      throw std::runtime_error(msg);
+   }
+   return stmt.release();
+}
+
+/// Read the column names and the first chunk of rows as strings to find the types of the columns.
+void RSqlDS::InferColTypes()
+{
+   std::unique_ptr<TSQLStatement> stmt(ExecuteQuery());
+
+   const auto nColumns = stmt->GetNumFields();
+   for (auto i : ROOT::TSeqI(nColumns))
+      fColumnNames.emplace_back(stmt->GetFieldName(i));
+
+   std::vector<std::vector<TString>> values(nColumns, std::vector<TString>(fRowsChunkSize));
+   std::vector<void *> buffers(nColumns);
+   std::vector<Bool_t *> nullBuffers(nColumns);
+   std::unique_ptr<Bool_t[]> nullFlags(new Bool_t[nColumns * fRowsChunkSize]);
+   for (auto i : ROOT::TSeqI(nColumns)) {
+      buffers[i] = values[i].data();
+      nullBuffers[i] = nullFlags.get() + i * fRowsChunkSize;
+   }
+   const auto nRows = stmt->NextResultRows(fRowsChunkSize, std::string(nColumns, 'S').c_str(), buffers.data(),
+                                           nullBuffers.data());
+   if (nRows < 0) {
+      std::string msg = "Cannot read the result set of the query \"" + fQuery + "\": ";
+      msg += stmt->GetErrorMsg();
+      throw std::runtime_error(msg);
+   }
+
+   for (auto i : ROOT::TSeqI(nColumns)) {
+      ColType_t type = 0;
+      for (auto row : ROOT::TSeqI(nRows)) {
+         if (nullBuffers[i][row])
+            continue;
+         const char *str = values[i][row].Data();
+         char *end = nullptr;
+         std::strtoll(str, &end, 10);
+         if (*str && !*end) {
+            if (!type)
+               type = 'L';
+            continue;
+         }
+         std::strtod(str, &end);
+         if (*str && !*end) {
+            type = 'D';
+            continue;
+         }
+         type = 'S';
+         break;
+      }
+      fColTypes.push_back(type ? type : 'S');
+   }
+   fColIsActive.resize(nColumns, false);
+}
+
+RSqlDS::ColType_t RSqlDS::GetType(std::string_view colName) const
+{
+   const auto it = std::find(fColumnNames.begin(), fColumnNames.end(), colName);
+   if (it == fColumnNames.end()) {
+      std::string msg = "The dataset does not have column ";
+      msg += colName;
+      throw std::runtime_error(msg);
+   }
+   return fColTypes[std::distance(fColumnNames.begin(), it)];
+}
+
+RDataSource::Record_t RSqlDS::GetColumnReadersImpl(std::string_view name, const std::type_info &ti)
+{
+   const auto colType = GetType(name);
+   if ((colType == 'D' && typeid(double) != ti) || (colType == 'L' && typeid(Long64_t) != ti) ||
+       (colType == 'S' && typeid(std::string) != ti)) {
+      std::string err = "The type selected for column \"";
+      err += name;
+      err += "\" does not correspond to column type, which is ";
+      err += GetTypeName(name);
+      throw std::runtime_error(err);
+   }
+
+   const auto index = std::distance(fColumnNames.begin(), std::find(fColumnNames.begin(), fColumnNames.end(), name));
+   fColIsActive[index] = true;
+   Record_t ret(fNSlots);
+   for (auto slot : ROOT::TSeqU(fNSlots)) {
+      if (colType == 'S')
+         fColAddresses[index][slot] = &fStringEvtValues[index][slot];
+      ret[slot] = &fColAddresses[index][slot];
+   }
+   return ret;
+}
+
+void RSqlDS::SetNSlots(unsigned int nSlots)
+{
+   R__ASSERT(0U == fNSlots && "Setting the number of slots even if the number of slots is different from zero.");
+
+   fNSlots = nSlots;
+
+   const auto nColumns = fColumnNames.size();
+   fColAddresses.resize(nColumns, std::vector<void *>(fNSlots, nullptr));
+   fStringEvtValues.resize(nColumns, std::vector<std::string>(fNSlots));
+   fLong64Values.resize(nColumns);
+   fDoubleValues.resize(nColumns);
+   fStringValues.resize(nColumns);
+}
+
+const std::vector<std::string> &RSqlDS::GetColumnNames() const
+{
+   return fColumnNames;
+}
+
+bool RSqlDS::HasColumn(std::string_view colName) const
+{
+   return fColumnNames.end() != std::find(fColumnNames.begin(), fColumnNames.end(), colName);
+}
+
+std::string RSqlDS::GetTypeName(std::string_view colName) const
+{
+   switch (GetType(colName)) {
+   case 'L': return "Long64_t";
+   case 'D': return "double";
+   default: return "std::string";
+   }
+}
+
+void RSqlDS::Initialise()
+{
+   fStmt.reset(ExecuteQuery());
+   fProcessedRows = 0ULL;
+   fChunkFirstEntry = 0ULL;
+}
+
+std::vector<std::pair<ULong64_t, ULong64_t>> RSqlDS::GetEntryRanges()
+{
+   std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
+   if (!fStmt)
+      return entryRanges;
+
+   // Fetch the next rows of the columns in use into the buffers of their type
+   const auto nColumns = fColumnNames.size();
+   std::string types(nColumns, '-');
+   std::vector<void *> buffers(nColumns, nullptr);
+   for (auto i : ROOT::TSeqU(nColumns)) {
+      if (!fColIsActive[i])
+         continue;
+      types[i] = fColTypes[i];
+      switch (fColTypes[i]) {
+      case 'L':
+         fLong64Values[i].resize(fRowsChunkSize);
+         buffers[i] = fLong64Values[i].data();
+         break;
+      case 'D':
+         fDoubleValues[i].resize(fRowsChunkSize);
+         buffers[i] = fDoubleValues[i].data();
+         break;
+      default:
+         fStringValues[i].resize(fRowsChunkSize);
+         buffers[i] = fStringValues[i].data();
+      }
+   }
+
+   const auto nRows = fStmt->NextResultRows(fRowsChunkSize, types.c_str(), buffers.data());
+   if (nRows < 0) {
+      std::string msg = "Cannot read the result set of the query \"" + fQuery + "\": ";
+      msg += fStmt->GetErrorMsg();
+      throw std::runtime_error(msg);
+   }
+
+   if (gDebug > 0)
+      Info("GetEntryRanges", "Fetched chunk of %d rows from the SQL server", nRows);
+
+   if (0 == nRows)
+      return entryRanges;
+
+   const auto chunkSize = nRows / fNSlots;
+   const auto remainder = 1U == fNSlots ? 0 : nRows % fNSlots;
+   fChunkFirstEntry = fProcessedRows;
+   auto start = fChunkFirstEntry;
+   auto end = start;
+
+   for (auto i : ROOT::TSeqU(fNSlots)) {
+      start = end;
+      end += chunkSize;
+      entryRanges.emplace_back(start, end);
+      (void)i;
+   }
+   entryRanges.back().second += remainder;
+
+   fProcessedRows += nRows;
+
+   return entryRanges;
+}
+
+bool RSqlDS::SetEntry(unsigned int slot, ULong64_t entry)
+{
+   // Here we need to normalise the entry to the number of rows we already processed.
+   const auto row = entry - fChunkFirstEntry;
+   for (auto i : ROOT::TSeqU(fColumnNames.size())) {
+      if (!fColIsActive[i])
+         continue;
+      switch (fColTypes[i]) {
+      case 'L': fColAddresses[i][slot] = &fLong64Values[i][row]; break;
+      case 'D': fColAddresses[i][slot] = &fDoubleValues[i][row]; break;
+      default: fStringEvtValues[i][slot] = fStringValues[i][row].Data();
+      }
+   }
+   return true;
+}
+
+void RSqlDS::Finalise()
+{
+   fStmt.reset();
+   for (auto &values : fStringValues) {
+      values.clear();
+      values.shrink_to_fit();
+   }
+}
+
+std::string RSqlDS::GetLabel()
+{
+   return "RSql";
+}
+
+RDataFrame MakeSqlDataFrame(std::string_view url, std::string_view query, std::string_view user,
+                            std::string_view password)
+{
+   ROOT::RDataFrame rdf(std::make_unique<RSqlDS>(url, query, user, password));
+   return rdf;
+}
+
+} // ns RDF
+
+} // ns ROOT
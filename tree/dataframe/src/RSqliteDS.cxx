@@ -33,7 +33,9 @@
 #include <ctime>
 #include <memory> // for placement new
 #include <stdexcept>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include <sqlite3.h>
 
@@ -341,6 +343,23 @@ namespace Internal {
 struct RSqliteDSDataSet {
    sqlite3 *fDb = nullptr;
    sqlite3_stmt *fQuery = nullptr;
+   std::string fFileName;
+   std::string fQueryText;
+   /// With more than one slot, the connection of each slot and its query restricted to a window of rows
+   std::vector<sqlite3 *> fSlotDbs;
+   std::vector<sqlite3_stmt *> fSlotQueries;
+   /// The windows of rows of the current event loop, one per slot
+   std::vector<std::pair<ULong64_t, ULong64_t>> fEntryRanges;
+
+   void CloseSlots()
+   {
+      for (auto query : fSlotQueries)
+         sqlite3_finalize(query);
+      for (auto db : fSlotDbs)
+         sqlite3_close(db);
+      fSlotQueries.clear();
+      fSlotDbs.clear();
+   }
 };
 }
 
@@ -383,12 +402,17 @@ RSqliteDS::RSqliteDS(const std::string &fileName, const std::string &query)
    if (retval != SQLITE_OK)
       SqliteError(retval);
 
+   // Kept for the connections of the slots, which embed the query in a windowed one
+   fDataSet->fFileName = fileName;
+   fDataSet->fQueryText = query;
+   const auto queryEnd = fDataSet->fQueryText.find_last_not_of(" \t\n;");
+   fDataSet->fQueryText.erase(queryEnd == std::string::npos ? 0 : queryEnd + 1);
+
    int colCount = sqlite3_column_count(fDataSet->fQuery);
    retval = sqlite3_step(fDataSet->fQuery);
    if ((retval != SQLITE_ROW) && (retval != SQLITE_DONE))
       SqliteError(retval);
 
-   fValues.reserve(colCount);
    for (int i = 0; i < colCount; ++i) {
       fColumnNames.emplace_back(sqlite3_column_name(fDataSet->fQuery, i));
       int type = SQLITE_NULL;
@@ -416,24 +440,19 @@ RSqliteDS::RSqliteDS(const std::string &fileName, const std::string &query)
       switch (type) {
       case SQLITE_INTEGER:
          fColumnTypes.push_back(ETypes::kInteger);
-         fValues.emplace_back(ETypes::kInteger);
          break;
       case SQLITE_FLOAT:
          fColumnTypes.push_back(ETypes::kReal);
-         fValues.emplace_back(ETypes::kReal);
          break;
       case SQLITE_TEXT:
          fColumnTypes.push_back(ETypes::kText);
-         fValues.emplace_back(ETypes::kText);
          break;
       case SQLITE_BLOB:
          fColumnTypes.push_back(ETypes::kBlob);
-         fValues.emplace_back(ETypes::kBlob);
          break;
       case SQLITE_NULL:
          // TODO: Null values in first rows are not well handled
          fColumnTypes.push_back(ETypes::kNull);
-         fValues.emplace_back(ETypes::kNull);
          break;
       default: throw std::runtime_error("Unhandled data type");
       }
@@ -444,6 +463,7 @@ RSqliteDS::RSqliteDS(const std::string &fileName, const std::string &query)
 /// Frees the sqlite resources and closes the file.
 RSqliteDS::~RSqliteDS()
 {
+   fDataSet->CloseSlots();
    // sqlite3_finalize returns the error code of the most recent operation on fQuery.
    sqlite3_finalize(fDataSet->fQuery);
    // Closing can possibly fail with SQLITE_BUSY, in which case resources are leaked. This should not happen
@@ -478,16 +498,28 @@ RDataSource::Record_t RSqliteDS::GetColumnReadersImpl(std::string_view name, con
       throw std::runtime_error(errmsg);
    }
 
-   fValues[index].fIsActive = true;
-   return std::vector<void *>{fNSlots, &fValues[index].fPtr};
+   std::vector<void *> ptrs;
+   for (auto &values : fValues) {
+      values[index].fIsActive = true;
+      ptrs.emplace_back(&values[index].fPtr);
+   }
+   return ptrs;
 }
 
 ////////////////////////////////////////////////////////////////////////////
-/// Returns a range of size 1 as long as more rows are available in the SQL result set.
-/// This inherently serialized the RDF independent of the number of slots.
+/// With a single slot, returns a range of size 1 as long as more rows are available in the SQL result set.
+/// With more slots, returns the windows of rows of all slots at once.
 std::vector<std::pair<ULong64_t, ULong64_t>> RSqliteDS::GetEntryRanges()
 {
    std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
+   if (fNSlots > 1) {
+      if (fNRow == 0 && !fDataSet->fEntryRanges.empty()) {
+         entryRanges = fDataSet->fEntryRanges;
+         fNRow = entryRanges.back().second;
+      }
+      return entryRanges;
+   }
+
    int retval = sqlite3_step(fDataSet->fQuery);
    switch (retval) {
    case SQLITE_DONE: return entryRanges;
@@ -524,13 +556,61 @@ bool RSqliteDS::HasColumn(std::string_view colName) const
 }
 
 ////////////////////////////////////////////////////////////////////////////
-/// Resets the SQlite query engine at the beginning of the event loop.
+/// Resets the SQlite query engine at the beginning of the event loop. With more than one slot, counts the rows of the
+/// result set and splits them into one window of consecutive rows per slot.
 void RSqliteDS::Initialise()
 {
    fNRow = 0;
    int retval = sqlite3_reset(fDataSet->fQuery);
    if (retval != SQLITE_OK)
       throw std::runtime_error("SQlite error, reset");
+   if (fNSlots < 2)
+      return;
+
+   const auto countQueryText = "SELECT count(*) FROM (" + fDataSet->fQueryText + ")";
+   sqlite3_stmt *countQuery = nullptr;
+   retval = sqlite3_prepare_v2(fDataSet->fDb, countQueryText.c_str(), -1, &countQuery, nullptr);
+   if (retval != SQLITE_OK)
+      SqliteError(retval);
+   retval = sqlite3_step(countQuery);
+   const ULong64_t nRows = (retval == SQLITE_ROW) ? sqlite3_column_int64(countQuery, 0) : 0;
+   sqlite3_finalize(countQuery);
+   if (retval != SQLITE_ROW)
+      SqliteError(retval);
+
+   fDataSet->fEntryRanges.clear();
+   const ULong64_t nWindows = std::min<ULong64_t>(fNSlots, nRows);
+   ULong64_t begin = 0;
+   for (ULong64_t i = 0; i < nWindows; ++i) {
+      const auto end = begin + nRows / nWindows + (i < nRows % nWindows ? 1 : 0);
+      fDataSet->fEntryRanges.emplace_back(begin, end);
+      begin = end;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// With more than one slot, runs the query of the slot on the window of rows that starts at firstEntry.
+void RSqliteDS::InitSlot(unsigned int slot, ULong64_t firstEntry)
+{
+   if (fNSlots < 2)
+      return;
+
+   const auto &ranges = fDataSet->fEntryRanges;
+   const auto range = std::find_if(ranges.begin(), ranges.end(), [firstEntry](const std::pair<ULong64_t, ULong64_t> &r) {
+      return r.first == firstEntry;
+   });
+   R__ASSERT(range != ranges.end());
+
+   auto query = fDataSet->fSlotQueries[slot];
+   int retval = sqlite3_reset(query);
+   if (retval != SQLITE_OK)
+      SqliteError(retval);
+   retval = sqlite3_bind_int64(query, 1, range->second - range->first);
+   if (retval != SQLITE_OK)
+      SqliteError(retval);
+   retval = sqlite3_bind_int64(query, 2, range->first);
+   if (retval != SQLITE_OK)
+      SqliteError(retval);
 }
 
 std::string RSqliteDS::GetLabel()
@@ -549,32 +629,43 @@ RDataFrame MakeSqliteDataFrame(std::string_view fileName, std::string_view query
 }
 
 ////////////////////////////////////////////////////////////////////////////
-/// Stores the result of the current active sqlite query row as a C++ value.
-bool RSqliteDS::SetEntry(unsigned int /* slot */, ULong64_t entry)
+/// Stores the result of the current active sqlite query row as a C++ value. With more than one slot, the slot's query
+/// steps to the next row of its window first.
+bool RSqliteDS::SetEntry(unsigned int slot, ULong64_t entry)
 {
-   R__ASSERT(entry + 1 == fNRow);
-   unsigned N = fValues.size();
+   sqlite3_stmt *query = fDataSet->fQuery;
+   if (fNSlots > 1) {
+      query = fDataSet->fSlotQueries[slot];
+      int retval = sqlite3_step(query);
+      if (retval != SQLITE_ROW)
+         SqliteError(retval);
+   } else {
+      R__ASSERT(entry + 1 == fNRow);
+   }
+
+   auto &values = fValues[slot];
+   unsigned N = values.size();
    for (unsigned i = 0; i < N; ++i) {
-      if (!fValues[i].fIsActive)
+      if (!values[i].fIsActive)
          continue;
 
       int nbytes;
-      switch (fValues[i].fType) {
-      case ETypes::kInteger: fValues[i].fInteger = sqlite3_column_int64(fDataSet->fQuery, i); break;
-      case ETypes::kReal: fValues[i].fReal = sqlite3_column_double(fDataSet->fQuery, i); break;
+      switch (values[i].fType) {
+      case ETypes::kInteger: values[i].fInteger = sqlite3_column_int64(query, i); break;
+      case ETypes::kReal: values[i].fReal = sqlite3_column_double(query, i); break;
       case ETypes::kText:
-         nbytes = sqlite3_column_bytes(fDataSet->fQuery, i);
+         nbytes = sqlite3_column_bytes(query, i);
          if (nbytes == 0) {
-            fValues[i].fText = "";
+            values[i].fText = "";
          } else {
-            fValues[i].fText = reinterpret_cast<const char *>(sqlite3_column_text(fDataSet->fQuery, i));
+            values[i].fText = reinterpret_cast<const char *>(sqlite3_column_text(query, i));
          }
          break;
       case ETypes::kBlob:
-         nbytes = sqlite3_column_bytes(fDataSet->fQuery, i);
-         fValues[i].fBlob.resize(nbytes);
+         nbytes = sqlite3_column_bytes(query, i);
+         values[i].fBlob.resize(nbytes);
          if (nbytes > 0) {
-            std::memcpy(fValues[i].fBlob.data(), sqlite3_column_blob(fDataSet->fQuery, i), nbytes);
+            std::memcpy(values[i].fBlob.data(), sqlite3_column_blob(query, i), nbytes);
          }
          break;
       case ETypes::kNull: break;
@@ -585,14 +676,38 @@ bool RSqliteDS::SetEntry(unsigned int /* slot */, ULong64_t entry)
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
-/// Almost a no-op, many slots can in fact reduce the performance due to thread synchronization.
+/// Prepares the values of each slot. With more than one slot, opens a database connection per slot, on which the
+/// query is run for the window of rows of the slot.
 void RSqliteDS::SetNSlots(unsigned int nSlots)
 {
-   if (nSlots > 1) {
-      ::Warning("SetNSlots", "Currently the SQlite data source faces performance degradation in multi-threaded mode. "
-                             "Consider turning off IMT.");
-   }
    fNSlots = nSlots;
+   fValues.clear();
+   fValues.resize(nSlots);
+   for (auto &values : fValues) {
+      // The values point to their own members, so they must not be moved once created
+      values.reserve(fColumnTypes.size());
+      for (auto type : fColumnTypes)
+         values.emplace_back(type);
+   }
+
+   fDataSet->CloseSlots();
+   if (nSlots < 2)
+      return;
+   const auto windowQueryText = "SELECT * FROM (" + fDataSet->fQueryText + ") LIMIT ?1 OFFSET ?2";
+   for (unsigned int i = 0; i < nSlots; ++i) {
+      sqlite3 *db = nullptr;
+      int retval = sqlite3_open_v2(fDataSet->fFileName.c_str(), &db, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX,
+                                   gSQliteVfsName);
+      // Also a connection that failed to open has to be closed
+      fDataSet->fSlotDbs.emplace_back(db);
+      if (retval != SQLITE_OK)
+         SqliteError(retval);
+      sqlite3_stmt *query = nullptr;
+      retval = sqlite3_prepare_v2(db, windowQueryText.c_str(), -1, &query, nullptr);
+      if (retval != SQLITE_OK)
+         SqliteError(retval);
+      fDataSet->fSlotQueries.emplace_back(query);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,64 @@
+#include <ROOT/RDataFrame.hxx>
+
+#include "TH1D.h"
+
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+// The event loops run over an empty data source with a fixed number of entries, so that the
+// benchmarks measure the per-entry overhead of the computation graph rather than the reading.
+
+static void BM_RDataFrame_Count(benchmark::State &state)
+{
+   const ULong64_t nEntries = state.range(0);
+   for (auto _ : state) {
+      ROOT::RDataFrame df(nEntries);
+      benchmark::DoNotOptimize(*df.Count());
+   }
+   state.SetItemsProcessed(state.iterations() * nEntries);
+}
+BENCHMARK(BM_RDataFrame_Count)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+static void BM_RDataFrame_DefineFilterSum(benchmark::State &state)
+{
+   const ULong64_t nEntries = state.range(0);
+   for (auto _ : state) {
+      ROOT::RDataFrame df(nEntries);
+      auto sum = df.Define("x", [](ULong64_t e) { return double(e % 100); }, {"rdfentry_"})
+                    .Filter([](double x) { return x > 10.; }, {"x"})
+                    .Sum<double>("x");
+      benchmark::DoNotOptimize(*sum);
+   }
+   state.SetItemsProcessed(state.iterations() * nEntries);
+}
+BENCHMARK(BM_RDataFrame_DefineFilterSum)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+static void BM_RDataFrame_DefineFilterSum_Jitted(benchmark::State &state)
+{
+   const ULong64_t nEntries = state.range(0);
+   for (auto _ : state) {
+      ROOT::RDataFrame df(nEntries);
+      auto sum = df.Define("x", "double(rdfentry_ % 100)").Filter("x > 10.").Sum("x");
+      benchmark::DoNotOptimize(*sum);
+   }
+   state.SetItemsProcessed(state.iterations() * nEntries);
+}
+BENCHMARK(BM_RDataFrame_DefineFilterSum_Jitted)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+// Many actions booked on the same event loop, as in a typical analysis with many histograms
+static void BM_RDataFrame_Histos(benchmark::State &state)
+{
+   const ULong64_t nEntries = 1 << 18;
+   const auto nHistos = state.range(0);
+   for (auto _ : state) {
+      ROOT::RDataFrame df(nEntries);
+      auto d = df.Define("x", [](ULong64_t e) { return double(e % 1000) / 100.; }, {"rdfentry_"});
+      std::vector<ROOT::RDF::RResultPtr<TH1D>> histos;
+      for (auto i = 0; i < nHistos; ++i)
+         histos.emplace_back(d.Histo1D<double>({"h", "h", 100, 0., 10.}, "x"));
+      benchmark::DoNotOptimize(histos.front()->GetEntries());
+   }
+   state.SetItemsProcessed(state.iterations() * nEntries * nHistos);
+}
+BENCHMARK(BM_RDataFrame_Histos)->Arg(1)->Arg(10)->Arg(100)->Unit(benchmark::kMillisecond);
@@ -30,6 +30,28 @@ TEST(Cache, FundType)
    }
 }
 
+TEST(Cache, MemoryBudget)
+{
+   ROOT::RDataFrame tdf(100);
+   auto df = tdf.Define("c0", [](ULong64_t e) { return int(e); }, {"rdfentry_"}).Define("c1", []() { return 1.; });
+
+   // fits in the budget: cached in memory, lazily
+   auto inMemory = df.Cache<int, double>({"c0", "c1"}, 100 * (sizeof(int) + sizeof(double)));
+   EXPECT_EQ(0u, tdf.GetNRuns());
+   EXPECT_EQ(100UL, *inMemory.Count());
+   EXPECT_EQ(1u, tdf.GetNRuns());
+
+   // exceeds the budget: cached on disk, immediately
+   auto onDisk = df.Cache<int, double>({"c0", "c1"}, 100);
+   EXPECT_EQ(2u, tdf.GetNRuns());
+   auto v = *onDisk.Take<int>("c0");
+   ASSERT_EQ(100UL, v.size());
+   for (auto j : ROOT::TSeqI(100))
+      EXPECT_EQ(j, v[j]);
+   EXPECT_DOUBLE_EQ(100., *onDisk.Sum<double>("c1"));
+   EXPECT_EQ(2u, tdf.GetNRuns());
+}
+
 TEST(Cache, Ambiguity)
 {
 // This test verifies that the correct method is called and there is no ambiguity between the JIT call to Cache using
@@ -270,11 +270,18 @@ TEST(RDFAndFriendsNoFixture, IndexedFriend)
    auxChain.BuildIndex("idx");
    mainChain.AddFriend(&auxChain);
 
-   auto op = [&](){
-      auto df = ROOT::RDataFrame(mainChain);
-      *df.Min<int>("x");
+   // the entries of the main tree are matched with the friend entries with the same idx
+   auto check = [&]() {
+      ROOT::RDataFrame df(mainChain);
+      auto sumY = df.Sum<float>("y");
+      auto maxX = df.Max<float>("x");
+      EXPECT_FLOAT_EQ(*sumY, 3 * 5.f + 2 * 7.f);
+      EXPECT_FLOAT_EQ(*maxX, 8.f);
    };
-   EXPECT_ANY_THROW(op());
+   check();
+   ROOT::EnableImplicitMT(2);
+   check();
+   ROOT::DisableImplicitMT();
 
    gSystem->Unlink(mainFile);
    gSystem->Unlink(auxFile);
@@ -275,3 +275,84 @@ TEST(RDFHelpers, SaveGraphToFile)
 
    gSystem->Unlink(outFileName);
 }
+
+TEST(RDFHelpers, RunGraphs)
+{
+   ROOT::RDataFrame df1(3);
+   auto r1 = df1.Define("x", [] { return 1; }).Sum<int>("x");
+   auto r2 = df1.Count();
+   ROOT::RDataFrame df2(4);
+   auto r3 = df2.Define("x", "2").Sum<int>("x");
+
+   std::vector<RResultHandle> handles{r1, r2, r3};
+   for (const auto &h : handles)
+      EXPECT_FALSE(h.IsReady());
+   EXPECT_EQ(2u, RunGraphs(handles));
+   for (const auto &h : handles)
+      EXPECT_TRUE(h.IsReady());
+   EXPECT_EQ(1u, df1.GetNRuns());
+   EXPECT_EQ(1u, df2.GetNRuns());
+
+   EXPECT_EQ(3, handles[0].GetValue<int>());
+   EXPECT_EQ(3ull, handles[1].GetValue<ULong64_t>());
+   EXPECT_EQ(8, *handles[2].GetPtr<int>());
+   EXPECT_EQ(8, *r3);
+   EXPECT_THROW(handles[0].GetValue<float>(), std::runtime_error);
+
+   // Nothing left to run
+   EXPECT_EQ(0u, RunGraphs(handles));
+   EXPECT_EQ(1u, df1.GetNRuns());
+}
+
+TEST(RDFHelpers, JitCache)
+{
+   const std::string cacheDir = "RDFHelpersJitCache";
+   ROOT::RDF::EnableJitCache(cacheDir);
+   auto countSelected = [] {
+      ROOT::RDataFrame df(10);
+      return *df.Define("x", "rdfentry_ * 2").Filter("x > 5").Count();
+   };
+   // the first event loop compiles the library, the second one loads it
+   EXPECT_EQ(7ull, countSelected());
+   EXPECT_EQ(7ull, countSelected());
+   ROOT::RDF::DisableJitCache();
+   EXPECT_EQ(7ull, countSelected());
+
+   std::vector<std::string> files;
+   auto dir = gSystem->OpenDirectory(cacheDir.c_str());
+   ASSERT_NE(nullptr, dir);
+   while (const char *entry = gSystem->GetDirEntry(dir)) {
+      const std::string fileName = entry;
+      if (fileName != "." && fileName != "..")
+         files.emplace_back(cacheDir + "/" + fileName);
+   }
+   gSystem->FreeDirectory(dir);
+   const auto libSuffix = std::string("_C.") + gSystem->GetSoExt();
+   const auto isLibrary = [&libSuffix](const std::string &f) { return f.find(libSuffix) != std::string::npos; };
+   EXPECT_TRUE(std::any_of(files.begin(), files.end(), isLibrary));
+   for (const auto &f : files)
+      gSystem->Unlink(f.c_str());
+   gSystem->Unlink(cacheDir.c_str());
+}
+
+TEST(RDFHelpers, RunMultiProcess)
+{
+   ROOT::RDataFrame df(100);
+   auto dfx = df.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"});
+   auto count = dfx.Filter([](double x) { return x > 9; }, {"x"}).Count();
+   auto sum = dfx.Sum<double>("x");
+   auto mean = dfx.Mean<double>("x");
+   auto h = dfx.Histo1D<double>({"h", "h", 10, 0, 100}, "x");
+
+   EXPECT_EQ(4u, RunMultiProcess({count, sum, mean, h}, 4));
+   EXPECT_EQ(1u, df.GetNRuns());
+   EXPECT_EQ(90ull, *count);
+   EXPECT_DOUBLE_EQ(4950., *sum);
+   EXPECT_DOUBLE_EQ(49.5, *mean);
+   EXPECT_EQ(100, h->GetEntries());
+   EXPECT_EQ(10, h->GetBinContent(1));
+
+   // results that cannot be merged are rejected before any worker is started
+   auto take = df.Take<ULong64_t>("rdfentry_");
+   EXPECT_THROW(RunMultiProcess({take}, 2), std::logic_error);
+}
@@ -1,11 +1,19 @@
 #include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDFHelpers.hxx"
 #include "ROOT/RTrivialDS.hxx"
 #include "TMemFile.h"
+#include "TFile.h"
 #include "TSystem.h"
 #include "TTree.h"
+#include "TTreeCacheUnzip.h"
 
 #include "gtest/gtest.h"
 
+#include <chrono>
+#include <numeric>
+#include <sstream>
+#include <thread>
+
 using namespace ROOT;
 using namespace ROOT::RDF;
 
@@ -423,3 +431,175 @@ TEST(RDataFrameInterface, TypeUnknownToInterpreter)
       df.Filter("res; return true;"),
       ss.str().c_str());
 }
+
+TEST(RDataFrameInterface, FilterReordering)
+{
+   const ULong64_t nEntries = 100000ull;
+   ROOT::RDataFrame df(nEntries);
+   auto d = df.Define("e", [](ULong64_t e) { return e; }, {"rdfentry_"});
+
+   ULong64_t nExpensive = 0ull;
+   auto expensive = [&nExpensive](ULong64_t e) {
+      ++nExpensive;
+      volatile double x = e;
+      for (int i = 0; i < 200; ++i)
+         x = x * 1.0000001 + 1.;
+      return x > 0.;
+   };
+   auto cheap = [](ULong64_t e) { return e % 10 == 0; };
+
+   auto nominal = d.Filter(expensive, {"e"}).Filter(cheap, {"e"}).Count();
+   EXPECT_EQ(nEntries / 10, *nominal);
+   EXPECT_EQ(nEntries, nExpensive);
+
+   nExpensive = 0ull;
+   df.EnableFilterReordering();
+   auto reordered = d.Filter(expensive, {"e"}).Filter(cheap, {"e"}).Count();
+   df.EnableFilterReordering(false);
+   EXPECT_EQ(nEntries / 10, *reordered);
+   // after the first reordering, the expensive filter only sees the entries accepted by the cheap one
+   EXPECT_LT(nExpensive, nEntries / 2);
+}
+
+TEST(RDataFrameInterface, Profiling)
+{
+   ROOT::RDataFrame df(100);
+   df.EnableProfiling();
+   auto d = df.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"});
+   auto count = d.Filter([](double x) { return x < 50; }, {"x"}, "half").Count();
+   auto sum = d.Sum<double>("x");
+   EXPECT_EQ(50ull, *count);
+   EXPECT_DOUBLE_EQ(4950., *sum);
+
+   auto &profiler = df.GetProfiler();
+   EXPECT_EQ(100ull, profiler.GetEntries());
+   std::map<std::string, const ROOT::RDF::RNodeProfile *> profiles;
+   for (auto profile : profiler.GetNodeProfiles())
+      profiles[profile->GetName()] = profile;
+   ASSERT_EQ(1u, profiles.count("half"));
+   EXPECT_EQ(100ull, profiles["half"]->GetCalls());
+   EXPECT_EQ(50ull, profiles["half"]->GetEntries());
+   ASSERT_EQ(1u, profiles.count("Define\nx"));
+   EXPECT_EQ(100ull, profiles["Define\nx"]->GetCalls());
+   ASSERT_EQ(1u, profiles.count("Count"));
+   EXPECT_EQ(100ull, profiles["Count"]->GetCalls());
+   EXPECT_EQ(50ull, profiles["Count"]->GetEntries());
+   ASSERT_EQ(1u, profiles.count("Sum"));
+   EXPECT_EQ(100ull, profiles["Sum"]->GetEntries());
+
+   const auto trace = profiler.ToChromeTrace();
+   EXPECT_NE(std::string::npos, trace.find("\"traceEvents\"")) << trace;
+   EXPECT_NE(std::string::npos, trace.find("\"name\": \"EventLoop\"")) << trace;
+   EXPECT_NE(std::string::npos, trace.find("\"name\": \"Task\"")) << trace;
+   EXPECT_NE(std::string::npos, trace.find("Define x")) << trace;
+
+   const auto graph = ROOT::RDF::SaveGraph(count);
+   EXPECT_NE(std::string::npos, graph.find("half\n100 calls")) << graph;
+
+   // nothing is recorded once profiling is disabled
+   profiler.Reset();
+   df.EnableProfiling(false);
+   EXPECT_EQ(100ull, *d.Count());
+   EXPECT_EQ(0ull, profiler.GetEntries());
+   EXPECT_EQ(0ull, profiles["half"]->GetCalls());
+}
+
+TEST(RDataFrameInterface, ProgressMonitor)
+{
+   ROOT::RDataFrame df(1000);
+   auto &monitor = df.GetProgressMonitor();
+   EXPECT_FALSE(monitor.IsEnabled());
+   std::vector<ROOT::RDF::RProgressInfo> infos;
+   std::ostringstream os;
+   monitor.SetInterval(0.001);
+   monitor.PrintTo(os);
+   monitor.AddCallback([&infos](const ROOT::RDF::RProgressInfo &info) { infos.emplace_back(info); });
+   EXPECT_TRUE(monitor.IsEnabled());
+   df.Foreach([] { std::this_thread::sleep_for(std::chrono::microseconds(10)); });
+
+   ASSERT_FALSE(infos.empty());
+   const auto &last = infos.back();
+   EXPECT_TRUE(last.fIsFinal);
+   EXPECT_EQ(1000ull, last.fEntries);
+   EXPECT_EQ(1000ll, last.fTotalEntries);
+   EXPECT_EQ(0., last.fTimeLeft);
+   EXPECT_EQ(1000ull, std::accumulate(last.fSlotEntries.begin(), last.fSlotEntries.end(), 0ull));
+   for (auto i = 1u; i < infos.size(); ++i) {
+      EXPECT_FALSE(infos[i - 1].fIsFinal);
+      EXPECT_LE(infos[i - 1].fEntries, infos[i].fEntries);
+   }
+   EXPECT_NE(std::string::npos, os.str().find("1000/1000 entries (100.0%)")) << os.str();
+
+   // nothing is published once the outputs are removed
+   monitor.Clear();
+   infos.clear();
+   EXPECT_EQ(1000ull, *df.Count());
+   EXPECT_TRUE(infos.empty());
+}
+
+TEST(RDataFrameInterface, LateBranchesUnzippedOnDemand)
+{
+   const auto fileName = "dataframe_interface_latebranches.root";
+   {
+      TFile f(fileName, "RECREATE");
+      TTree t("t", "t");
+      int x = 0;
+      int y = 0;
+      t.Branch("x", &x, "x/I", 1000);
+      t.Branch("y", &y, "y/I", 1000);
+      for (x = 0; x < 10000; ++x) {
+         y = 2 * x;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   const auto parallelUnzip = TTreeCacheUnzip::GetParallelUnzip();
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+   {
+      TFile f(fileName);
+      auto t = f.Get<TTree>("t");
+      ROOT::RDataFrame df(*t);
+      // y is only read for the entries that pass the filter on x
+      auto sum = df.Filter([](int x) { return x < 100; }, {"x"}).Sum<int>("y");
+      EXPECT_EQ(9900, *sum);
+
+      auto cache = dynamic_cast<TTreeCacheUnzip *>(f.GetCacheRead(t));
+      ASSERT_NE(nullptr, cache);
+      EXPECT_GT(cache->GetNUnzipOnDemand(), 0);
+      EXPECT_LT(cache->GetNUnzipOnDemand(), t->GetBranch("y")->GetWriteBasket() / 2);
+   }
+   TTreeCacheUnzip::SetParallelUnzip(parallelUnzip);
+   gSystem->Unlink(fileName);
+}
+
+TEST(RDataFrameInterface, SkipClustersRejectedByLeadingFilter)
+{
+   TMemFile f("dataframe_interface_skipclusters.root", "RECREATE");
+   TTree t("t", "t");
+   t.SetAutoFlush(100);
+   int x = 0;
+   t.Branch("x", &x);
+   t.AddClusterStatistics("x");
+   for (x = 0; x < 1000; ++x)
+      t.Fill();
+   t.Write();
+
+   ROOT::RDataFrame df(t);
+   df.EnableProfiling();
+   auto filtered = df.Filter("x >= 950", "high");
+   auto count = filtered.Count();
+   auto sum = filtered.Sum<int>("x");
+   auto report = df.Report();
+   EXPECT_EQ(50ull, *count);
+   EXPECT_EQ(48725, *sum);
+   // only the last cluster of entries is read, but the report still accounts for all entries
+   EXPECT_EQ(100ull, df.GetProfiler().GetEntries());
+   EXPECT_EQ(50ull, report->At("high").GetPass());
+   EXPECT_EQ(1000ull, report->At("high").GetAll());
+
+   // an action that sees every entry disables skipping
+   auto all = df.Count();
+   EXPECT_EQ(50ull, *df.Filter("950 <= x && x < 1000").Count());
+   EXPECT_EQ(1000ull, *all);
+}
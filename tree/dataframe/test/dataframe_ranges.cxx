@@ -91,18 +91,50 @@ TEST_F(RDFRanges, NoEarlyStopping)
 }
 
 #ifdef R__USE_IMT
-TEST(RDFRangesMT, ThrowIfIMT)
+TEST(RDFRangesMT, ThrowIfDownstreamOfFilter)
 {
    bool hasThrown = false;
    ROOT::EnableImplicitMT();
-   RDataFrame d(0);
+   RDataFrame d(10);
    try {
-      d.Range(0);
+      d.Filter([] { return true; }).Range(0);
    } catch (const std::exception &e) {
       hasThrown = true;
-      EXPECT_STREQ(e.what(), "Range was called with ImplicitMT enabled, but multi-thread is not supported.");
+      EXPECT_STREQ(e.what(), "Range: in multi-thread event loops, a Range can only be applied to the dataset "
+                             "directly, not downstream of filters or other ranges.");
    }
    EXPECT_TRUE(hasThrown);
+   ROOT::DisableImplicitMT();
+}
+
+TEST(RDFRangesMT, SelectByEntryNumber)
+{
+   ROOT::EnableImplicitMT();
+   RDataFrame d(1000);
+   auto r = d.Range(10, 50, 2);
+   auto count = r.Count();
+   auto min = r.Min<ULong64_t>("rdfentry_");
+   auto max = r.Max<ULong64_t>("rdfentry_");
+   auto sum = r.Sum<ULong64_t>("rdfentry_");
+   auto filtered = r.Filter([](ULong64_t e) { return e % 3 == 0; }, {"rdfentry_"}).Count();
+   EXPECT_EQ(*count, 20u);
+   EXPECT_EQ(*min, 11u);
+   EXPECT_EQ(*max, 49u);
+   EXPECT_EQ(*sum, 600u);
+   EXPECT_EQ(*filtered, 6u);
+   ROOT::DisableImplicitMT();
+}
+
+TEST(RDFRangesMT, ForeachOrdered)
+{
+   ROOT::EnableImplicitMT();
+   RDataFrame d(1000);
+   std::vector<ULong64_t> entries;
+   d.Range(100, 0).ForeachOrdered([&entries](ULong64_t e) { entries.emplace_back(e); }, {"rdfentry_"});
+   ASSERT_EQ(entries.size(), 900u);
+   for (auto i = 0u; i < entries.size(); ++i)
+      EXPECT_EQ(entries[i], i + 100u);
+   ROOT::DisableImplicitMT();
 }
 #endif
 
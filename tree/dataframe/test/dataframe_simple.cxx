@@ -930,6 +930,40 @@ TEST(RDFSimpleTests, ScalarValuesCollectionWeights)
    EXPECT_ANY_THROW(*h);
 }
 
+TEST_P(RDFSimpleTests, Histo1DWithModelInBatches)
+{
+   // More entries than fit in one batch of FillParHelper, plus collections
+   const ULong64_t nEntries = 5000;
+   RDataFrame d(nEntries);
+   auto df = d.Define("x", [](ULong64_t e) { return (e % 113) * 0.1; }, {"rdfentry_"})
+                .Define("v", [](ULong64_t e) { return RVec<float>(e % 3, e * 0.01f); }, {"rdfentry_"});
+   auto hx = df.Histo1D<double>({"hx", "", 20, 0., 10.}, "x");
+   auto hv = df.Histo1D<RVec<float>>({"hv", "", 20, 0., 60.}, "v");
+   unsigned int nPartial = 0;
+   hx.OnPartialResult(1000, [&nPartial](TH1D &h) {
+      if (h.GetEntries() > 0)
+         ++nPartial;
+   });
+
+   TH1D refx("refx", "", 20, 0., 10.);
+   TH1D refv("refv", "", 20, 0., 60.);
+   for (ULong64_t e = 0; e < nEntries; ++e) {
+      refx.Fill((e % 113) * 0.1);
+      for (ULong64_t i = 0; i < e % 3; ++i)
+         refv.Fill(e * 0.01f);
+   }
+
+   EXPECT_EQ(refx.GetEntries(), hx->GetEntries());
+   EXPECT_EQ(refv.GetEntries(), hv->GetEntries());
+   EXPECT_NEAR(refx.GetMean(), hx->GetMean(), 1e-9);
+   EXPECT_NEAR(refv.GetMean(), hv->GetMean(), 1e-9);
+   for (int b = 0; b <= 21; ++b) {
+      EXPECT_EQ(refx.GetBinContent(b), hx->GetBinContent(b));
+      EXPECT_EQ(refv.GetBinContent(b), hv->GetBinContent(b));
+   }
+   EXPECT_GT(nPartial, 0u);
+}
+
 TEST_P(RDFSimpleTests, ChainWithDifferentTreeNames)
 {
 	const auto fname1 = "test_chainwithdifferenttreenames_1.root";
@@ -952,6 +986,106 @@ TEST_P(RDFSimpleTests, ChainWithDifferentTreeNames)
    gSystem->Unlink(fname2);
 }
 
+TEST_P(RDFSimpleTests, VariedHisto1D)
+{
+   RDataFrame d(100);
+   auto df = d.Define("x", [](ULong64_t e) { return double(e % 10); }, {"rdfentry_"})
+                .Vary("x", [](double x) { return ROOT::RVec<double>{x - 1., x + 1.}; }, {"x"}, {"down", "up"});
+   auto histos = df.VariedHisto1D<double>({"h", "h", 20u, -5., 15.}, "x");
+   auto nominal = df.Histo1D<double>({"h2", "h2", 20u, -5., 15.}, "x");
+
+   ASSERT_EQ(3u, histos->size());
+   const auto &hNominal = histos->at("nominal");
+   const auto &hDown = histos->at("down");
+   const auto &hUp = histos->at("up");
+   EXPECT_EQ(1u, d.GetNRuns());
+   EXPECT_DOUBLE_EQ(nominal->GetMean(), hNominal.GetMean());
+   EXPECT_DOUBLE_EQ(nominal->GetMean() - 1., hDown.GetMean());
+   EXPECT_DOUBLE_EQ(nominal->GetMean() + 1., hUp.GetMean());
+   EXPECT_EQ(100., hUp.GetEntries());
+   EXPECT_EQ(nullptr, hUp.GetDirectory());
+
+   EXPECT_THROW(df.Vary("x", [](double x) { return ROOT::RVec<double>{x}; }, {"x"}, {"other"}), std::runtime_error);
+   EXPECT_THROW(df.VariedHisto1D<double>({"h3", "h3", 20u, -5., 15.}, "rdfentry_"), std::runtime_error);
+}
+
+TEST_P(RDFSimpleTests, ToArrow)
+{
+   ROOT::RDataFrame d(10);
+   auto df = d.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+                .Define("v", [](int x) { return RVec<float>(x % 3, x); }, {"x"})
+                .Define("b", [](int x) { return x % 2 == 0; }, {"x"});
+   auto batches = df.ToArrow<int, RVec<float>, bool>({"x", "v", "b"});
+   auto jittedBatches = df.ToArrow({"x", "v"});
+   EXPECT_EQ(batches->GetColumnNames(), std::vector<std::string>({"x", "v", "b"}));
+
+   ULong64_t nEntries = 0ull;
+   int xSum = 0;
+   std::size_t nValues = 0u;
+   std::size_t nTrue = 0u;
+   for (std::size_t i = 0u; i < batches->GetNBatches(); ++i) {
+      ArrowArray array;
+      ArrowSchema schema;
+      batches->Export(i, &array, &schema);
+      EXPECT_STREQ("+s", schema.format);
+      ASSERT_EQ(3, schema.n_children);
+      EXPECT_STREQ("x", schema.children[0]->name);
+      EXPECT_STREQ("i", schema.children[0]->format);
+      EXPECT_STREQ("+l", schema.children[1]->format);
+      EXPECT_STREQ("f", schema.children[1]->children[0]->format);
+      EXPECT_STREQ("b", schema.children[2]->format);
+      nEntries += array.length;
+
+      auto xs = static_cast<const int *>(array.children[0]->buffers[1]);
+      auto offsets = static_cast<const std::int32_t *>(array.children[1]->buffers[1]);
+      auto bits = static_cast<const std::uint8_t *>(array.children[2]->buffers[1]);
+      for (auto j = 0; j < array.length; ++j) {
+         xSum += xs[j];
+         EXPECT_EQ(xs[j] % 3, offsets[j + 1] - offsets[j]);
+         EXPECT_EQ(xs[j] % 2 == 0, bool(bits[j / 8] & (1u << (j % 8))));
+         nTrue += bits[j / 8] & (1u << (j % 8)) ? 1u : 0u;
+      }
+      nValues += array.children[1]->children[0]->length;
+
+      EXPECT_THROW(batches->Export(i, &array, &schema), std::runtime_error);
+      array.release(&array);
+      schema.release(&schema);
+      EXPECT_EQ(nullptr, array.release);
+   }
+   EXPECT_EQ(10ull, nEntries);
+   EXPECT_EQ(45, xSum);
+   EXPECT_EQ(9u, nValues);
+   EXPECT_EQ(5u, nTrue);
+   EXPECT_EQ(1u, d.GetNRuns());
+
+   ULong64_t nJittedEntries = 0ull;
+   for (std::size_t i = 0u; i < jittedBatches->GetNBatches(); ++i)
+      nJittedEntries += jittedBatches->GetNEntries(i);
+   EXPECT_EQ(10ull, nJittedEntries);
+}
+
+// Histo1D without axis limits, with enough values for the buffers of the slots to be emptied in parallel
+TEST_P(RDFSimpleTests, Histo1DAutoBinningLarge)
+{
+   const ULong64_t n = 1 << 19;
+   auto xOf = [](ULong64_t e) { return double(e % 1000) - 200.; };
+   auto h = RDataFrame(n).Define("x", xOf, {"rdfentry_"}).Histo1D<double>("x");
+
+   EXPECT_EQ(double(n), h->GetEntries());
+   EXPECT_DOUBLE_EQ(-200., h->GetXaxis()->GetXmin());
+   EXPECT_GT(h->GetXaxis()->GetXmax(), 799.);
+   EXPECT_EQ(0., h->GetBinContent(0));
+   EXPECT_EQ(0., h->GetBinContent(h->GetNbinsX() + 1));
+
+   TH1D ref("ref", "ref", h->GetNbinsX(), h->GetXaxis()->GetXmin(), h->GetXaxis()->GetXmax());
+   ref.SetDirectory(nullptr);
+   for (ULong64_t e = 0; e < n; ++e)
+      ref.Fill(xOf(e));
+   for (int bin = 0; bin <= h->GetNbinsX() + 1; ++bin)
+      EXPECT_EQ(ref.GetBinContent(bin), h->GetBinContent(bin));
+   EXPECT_NEAR(ref.GetMean(), h->GetMean(), 1e-9);
+}
+
 // run single-thread tests
 INSTANTIATE_TEST_SUITE_P(Seq, RDFSimpleTests, ::testing::Values(false));
 
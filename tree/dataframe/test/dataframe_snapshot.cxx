@@ -989,5 +989,46 @@ TEST(RDFSnapshotMore, TClonesArrayMT)
    ReadWriteTClonesArray();
 }
 
+TEST_F(RDFSnapshotMT, OutputFilePerSlot)
+{
+   const auto fname = "snapshot_outputfileperslot.root";
+   RSnapshotOptions opts;
+   opts.fOutputFilePerSlot = true;
+   auto sumIn = tdf.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"}).Sum<int>("x");
+   auto out = tdf.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+                 .Snapshot<int, int>("t", fname, {"ans", "x"}, opts);
+
+   EXPECT_EQ(kNEvents, *out->Count());
+   EXPECT_EQ(*sumIn, *out->Sum<int>("x"));
+   EXPECT_EQ(42., *out->Mean<int>("ans"));
+   // the per-slot files have been merged and deleted
+   for (auto slot = 0u; slot < kNSlots; ++slot)
+      EXPECT_TRUE(gSystem->AccessPathName(ROOT::Internal::RDF::SnapshotSlotFileName(fname, slot).c_str()));
+
+   gSystem->Unlink(fname);
+}
+
+TEST(RDFSnapshotMore, OrderedMT)
+{
+   TIMTEnabler _(4);
+   const auto fname = "snapshot_ordered.root";
+   const auto nEntries = 10000u;
+   RSnapshotOptions opts;
+   opts.fOrdered = true;
+   ROOT::RDataFrame d(nEntries);
+   d.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"}).Snapshot<int>("t", fname, {"x"}, opts);
+
+   opts.fOutputFilePerSlot = true;
+   EXPECT_THROW(d.Define("x", [] { return 0; }).Snapshot<int>("t", fname, {"x"}, opts), std::runtime_error);
+
+   ROOT::DisableImplicitMT();
+   auto xs = ROOT::RDataFrame("t", fname).Take<int>("x");
+   ASSERT_EQ(xs->size(), nEntries);
+   for (auto i = 0u; i < nEntries; ++i)
+      EXPECT_EQ((*xs)[i], int(i));
+
+   gSystem->Unlink(fname);
+}
+
 #endif // R__USE_IMT
 
@@ -2,9 +2,11 @@
 #include <ROOT/RCsvDS.hxx>
 #include <ROOT/TSeq.hxx>
 #include <TROOT.h>
+#include <TSystem.h>
 
 #include <gtest/gtest.h>
 
+#include <fstream>
 #include <iostream>
 
 using namespace ROOT::RDF;
@@ -182,6 +184,28 @@ TEST(RCsvDS, ProgressiveReadingRDF)
    EXPECT_EQ(6U, *c2);
 }
 
+TEST(RCsvDS, TypeInferenceWidening)
+{
+   const auto fileName = "RCsvDS_test_widening.csv";
+   {
+      std::ofstream f(fileName);
+      f << "x,y,z\n1,1,true\n2,2.5,3\n\n3,4,false";
+   }
+   {
+      RCsvDS tds(fileName);
+      EXPECT_EQ("Long64_t", tds.GetTypeName("x"));
+      EXPECT_EQ("double", tds.GetTypeName("y"));
+      EXPECT_EQ("std::string", tds.GetTypeName("z"));
+   }
+   auto tdf = ROOT::RDF::MakeCsvDataFrame(fileName);
+   EXPECT_DOUBLE_EQ(7.5, *tdf.Sum<double>("y"));
+   // the last line has no trailing newline
+   EXPECT_EQ(3U, *tdf.Count());
+   const std::vector<std::string> zRef{"true", "3", "false"};
+   EXPECT_EQ(zRef, *tdf.Take<std::string>("z"));
+   gSystem->Unlink(fileName);
+}
+
 #ifndef NDEBUG
 
 TEST(RCsvDS, SetNSlotsTwice)
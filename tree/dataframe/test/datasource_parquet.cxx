@@ -0,0 +1,143 @@
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RParquetDS.hxx>
+#include <ROOT/TSeq.hxx>
+#include <TROOT.h>
+#include <TSystem.h>
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#endif
+#include <arrow/builder.h>
+#include <arrow/io/file.h>
+#include <arrow/memory_pool.h>
+#include <arrow/table.h>
+#include <parquet/arrow/writer.h>
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace ROOT::RDF;
+
+const auto fileName0 = "RParquetDS_test.parquet";
+
+// Write a file with 3 row groups of 2 entries each
+void WriteTestFile()
+{
+   arrow::StringBuilder nameBuilder;
+   arrow::Int64Builder ageBuilder;
+   arrow::DoubleBuilder heightBuilder;
+   const std::vector<std::string> names = {"Harry", "Bob,Bob", "\"Joe\"", "Tom", " John  ", " Mary Ann "};
+   const std::vector<int64_t> ages = {64, 50, 40, 30, 2, 0};
+   const std::vector<double> heights = {180.0, 200.5, 1.7, 1.9, 1.0, 0.8};
+   for (auto i : ROOT::TSeqU(names.size())) {
+      ASSERT_TRUE(nameBuilder.Append(names[i]).ok());
+      ASSERT_TRUE(ageBuilder.Append(ages[i]).ok());
+      ASSERT_TRUE(heightBuilder.Append(heights[i]).ok());
+   }
+   std::shared_ptr<arrow::Array> nameArray, ageArray, heightArray;
+   ASSERT_TRUE(nameBuilder.Finish(&nameArray).ok());
+   ASSERT_TRUE(ageBuilder.Finish(&ageArray).ok());
+   ASSERT_TRUE(heightBuilder.Finish(&heightArray).ok());
+   auto schema = arrow::schema({arrow::field("Name", arrow::utf8()), arrow::field("Age", arrow::int64()),
+                                arrow::field("Height", arrow::float64())});
+   auto table = arrow::Table::Make(schema, {nameArray, ageArray, heightArray});
+
+   auto output = arrow::io::FileOutputStream::Open(fileName0);
+   ASSERT_TRUE(output.ok());
+   ASSERT_TRUE(parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), *output, /*chunk_size=*/2).ok());
+   ASSERT_TRUE((*output)->Close().ok());
+}
+
+class RParquetDSTest : public ::testing::Test {
+protected:
+   static void SetUpTestCase() { WriteTestFile(); }
+   static void TearDownTestCase() { gSystem->Unlink(fileName0); }
+};
+
+TEST_F(RParquetDSTest, ColTypeNames)
+{
+   RParquetDS tds({fileName0});
+   tds.SetNSlots(1);
+
+   auto colNames = tds.GetColumnNames();
+   ASSERT_EQ(3U, colNames.size());
+   EXPECT_EQ("Age", colNames[1]);
+   EXPECT_TRUE(tds.HasColumn("Height"));
+   EXPECT_FALSE(tds.HasColumn("Address"));
+
+   EXPECT_EQ("string", tds.GetTypeName("Name"));
+   EXPECT_EQ("Long64_t", tds.GetTypeName("Age"));
+   EXPECT_EQ("double", tds.GetTypeName("Height"));
+}
+
+TEST_F(RParquetDSTest, EntryRangesAreRowGroups)
+{
+   RParquetDS tds({fileName0, fileName0});
+   tds.SetNSlots(4U);
+   auto vals = tds.GetColumnReaders<Long64_t>("Age");
+   tds.Initialise();
+
+   // at most one row group per slot
+   auto ranges = tds.GetEntryRanges();
+   ASSERT_EQ(4U, ranges.size());
+   EXPECT_EQ(0U, ranges[0].first);
+   EXPECT_EQ(2U, ranges[0].second);
+   EXPECT_EQ(6U, ranges[3].first);
+   EXPECT_EQ(8U, ranges[3].second);
+
+   const std::vector<Long64_t> ages = {64, 50, 40, 30, 2, 0};
+   for (auto slot : ROOT::TSeqU(ranges.size())) {
+      tds.InitSlot(slot, ranges[slot].first);
+      for (auto i : ROOT::TSeq<ULong64_t>(ranges[slot].first, ranges[slot].second)) {
+         EXPECT_TRUE(tds.SetEntry(slot, i));
+         EXPECT_EQ(ages[i % 6], **vals[slot]);
+      }
+   }
+   EXPECT_EQ(2U, tds.GetEntryRanges().size());
+   EXPECT_TRUE(tds.GetEntryRanges().empty());
+   tds.Finalise();
+}
+
+TEST_F(RParquetDSTest, FromARDF)
+{
+   auto df = MakeParquetDataFrame({fileName0});
+   EXPECT_EQ(6U, *df.Count());
+   EXPECT_DOUBLE_EQ(200.5, *df.Max<double>("Height"));
+   EXPECT_EQ(186, *df.Sum<Long64_t>("Age"));
+   EXPECT_EQ(2, *df.Filter("Age < 40 && Age > 1").Min("Age"));
+}
+
+TEST_F(RParquetDSTest, Selection)
+{
+   // the last row group is rejected by its statistics, the Age == 30 entry by the cut itself
+   auto tds = std::make_unique<RParquetDS>(std::vector<std::string>{fileName0}, std::vector<std::string>{"Age >= 40"});
+   EXPECT_EQ(1U, tds->GetNRejectedRowGroups());
+   ROOT::RDataFrame df(std::move(tds));
+   EXPECT_EQ(3U, *df.Count());
+   EXPECT_EQ(154, *df.Sum<Long64_t>("Age"));
+
+   auto df2 = MakeParquetDataFrame({fileName0}, {"Age > 45", "Height>190"});
+   EXPECT_EQ(1U, *df2.Count());
+
+   EXPECT_THROW((RParquetDS({fileName0}, {"Age >> 3"})), std::runtime_error);
+   EXPECT_THROW((RParquetDS({fileName0}, {"Name == 3"})), std::runtime_error);
+   EXPECT_THROW((RParquetDS({fileName0}, {"Age == three"})), std::runtime_error);
+}
+
+#ifdef R__USE_IMT
+TEST_F(RParquetDSTest, SelectionMT)
+{
+   ROOT::EnableImplicitMT(2);
+   auto df = MakeParquetDataFrame({fileName0, fileName0}, {"Age >= 40"});
+   EXPECT_EQ(6U, *df.Count());
+   EXPECT_EQ(308, *df.Sum<Long64_t>("Age"));
+   ROOT::DisableImplicitMT();
+}
+#endif
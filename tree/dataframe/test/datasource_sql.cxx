@@ -0,0 +1,56 @@
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RMakeUnique.hxx>
+#include <ROOT/RSqlDS.hxx>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+using namespace ROOT::RDF;
+
+constexpr auto url0 = "sqlite://RSqliteDS_test.sqlite";
+constexpr auto query0 = "SELECT fint, freal, ftext FROM test";
+constexpr auto query1 = "SELECT fint, 'X' AS fconst FROM test ORDER BY fint";
+constexpr auto epsilon = 0.001;
+
+TEST(RSqlDS, Basics)
+{
+   auto rdf = MakeSqlDataFrame(url0, query0);
+   EXPECT_EQ(2U, *rdf.Count());
+   EXPECT_EQ(1, *rdf.Min<Long64_t>("fint"));
+   EXPECT_EQ(2, *rdf.Max<Long64_t>("fint"));
+   EXPECT_NEAR(3.0, *rdf.Sum<double>("freal"), epsilon);
+
+   EXPECT_THROW(MakeSqlDataFrame(url0, "SELECT * FROM nonexisting"), std::runtime_error);
+}
+
+TEST(RSqlDS, ColTypes)
+{
+   RSqlDS ds(url0, query1);
+   EXPECT_EQ(2U, ds.GetColumnNames().size());
+   EXPECT_TRUE(ds.HasColumn("fconst"));
+   EXPECT_FALSE(ds.HasColumn("fnull"));
+   EXPECT_EQ("Long64_t", ds.GetTypeName("fint"));
+   EXPECT_EQ("std::string", ds.GetTypeName("fconst"));
+   EXPECT_THROW(ds.GetTypeName("fnull"), std::runtime_error);
+
+   ds.SetNSlots(1);
+   EXPECT_THROW(ds.GetColumnReaders<double>("fint"), std::runtime_error);
+}
+
+TEST(RSqlDS, Chunks)
+{
+   // One row per chunk
+   ROOT::RDataFrame rdf(std::make_unique<RSqlDS>(url0, query1, "", "", 1));
+   auto fint = rdf.Take<Long64_t>("fint");
+   auto fconst = rdf.Take<std::string>("fconst");
+   ASSERT_EQ(2U, fint->size());
+   EXPECT_EQ(1, (*fint)[0]);
+   EXPECT_EQ(2, (*fint)[1]);
+   EXPECT_EQ("X", (*fconst)[0]);
+   EXPECT_EQ("X", (*fconst)[1]);
+
+   // The query is executed again for the next event loop
+   EXPECT_EQ(2U, *rdf.Count());
+}
@@ -1,4 +1,3 @@
-#include <ROOTUnitTestSupport.h>
 #include <ROOT/RConfig.hxx>
 #include <ROOT/RDataFrame.hxx>
 #include <ROOT/RMakeUnique.hxx>
@@ -126,17 +125,21 @@ TEST(RSqliteDS, ColumnReaders)
 {
    RSqliteDS rds(fileName0, query0);
    const auto nSlots = 2U;
-   ROOT_EXPECT_WARNING(rds.SetNSlots(nSlots), "SetNSlots",
-                       "Currently the SQlite data source faces performance degradation in multi-threaded mode. "
-                       "Consider turning off IMT.");
+   rds.SetNSlots(nSlots);
    auto vals = rds.GetColumnReaders<Long64_t>("fint");
    rds.Initialise();
+   // one window of rows per slot, all given out at once
    auto ranges = rds.GetEntryRanges();
-   EXPECT_EQ(1U, ranges.size());
+   ASSERT_EQ(2U, ranges.size());
+   EXPECT_EQ(0U, rds.GetEntryRanges().size());
    for (auto i : ROOT::TSeq<unsigned>(0, nSlots)) {
-      EXPECT_TRUE(rds.SetEntry(i, ranges[0].first));
-      auto val = **vals[i];
-      EXPECT_EQ(1, val);
+      EXPECT_EQ(i, ranges[i].first);
+      EXPECT_EQ(i + 1, ranges[i].second);
+      // the slots read different windows of the result set
+      rds.InitSlot(1 - i, ranges[i].first);
+      EXPECT_TRUE(rds.SetEntry(1 - i, ranges[i].first));
+      auto val = **vals[1 - i];
+      EXPECT_EQ(Long64_t(i + 1), val);
    }
 
    EXPECT_THROW(rds.GetColumnReaders<double>("fint"), std::runtime_error);
@@ -21,6 +21,7 @@
 #include <ROOT/RPageStorage.hxx> // for ColumnSet_t
 
 #include <condition_variable>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <future>
@@ -41,7 +42,10 @@ class RPageSource;
 \ingroup NTuple
 \brief Managed a set of clusters containing compressed and packed pages
 
-The cluster pool steers the preloading of (partial) clusters.
+The cluster pool steers the preloading of (partial) clusters. The I/O thread reads the clusters from storage and hands
+them over to the unzip thread, which gives the page source the chance to decompress the pages (RPageSource::UnzipCluster)
+before the cluster becomes available in the pool. Thus reading the next cluster overlaps with the decompression
+of the previous one.
 */
 // clang-format on
 class RClusterPool {
@@ -57,6 +61,13 @@ private:
       RPageSource::ColumnSet_t fColumns;
    };
 
+   /// A cluster that has been loaded by the I/O thread and that is waiting for the unzip thread
+   struct RUnzipItem {
+      std::promise<std::unique_ptr<RCluster>> fPromise;
+      /// A nullptr cluster signals the unzip thread to terminate
+      std::unique_ptr<RCluster> fCluster;
+   };
+
    /// Clusters that are currently being processed by the I/O thread.  Every in-flight cluster has a corresponding
    /// work item.
    struct RInFlightCluster {
@@ -81,6 +92,9 @@ private:
    unsigned int fWindowPre;
    /// The number of desired clusters in the pool, including the currently active cluster
    unsigned int fWindowPost;
+   /// If non-zero, limits the read-ahead such that the clusters in the look-ahead window following the active
+   /// cluster do not exceed this number of bytes on storage
+   std::uint64_t fMaxReadAheadBytes;
    /// The cache of clusters around the currently active cluster
    std::vector<std::unique_ptr<RCluster>> fPool;
 
@@ -94,11 +108,22 @@ private:
    /// The communication channel to the I/O thread
    std::queue<RWorkItem> fWorkQueue;
 
+   /// Protects the queue of loaded clusters between the I/O thread and the unzip thread
+   std::mutex fLockUnzipQueue;
+   /// Signals a non-empty unzip queue
+   std::condition_variable fCvHasUnzipWork;
+   /// The communication channel from the I/O thread to the unzip thread
+   std::queue<RUnzipItem> fUnzipQueue;
+
    /// The I/O thread calls RPageSource::LoadCluster() asynchronously.  The thread is mostly waiting for the
    /// data to arrive (blocked by the kernel) and therefore can safely run in addition to the application
    /// main threads.
    std::thread fThreadIo;
 
+   /// The unzip thread calls RPageSource::UnzipCluster() for every loaded cluster and then fulfills the promise
+   /// of the corresponding work item.  Page sources typically distribute the decompression to the IMT task arena.
+   std::thread fThreadUnzip;
+
    /// Every cluster id has at most one corresponding RCluster pointer in the pool
    RCluster *FindInPool(DescriptorId_t clusterId) const;
    /// Returns an index of an unused element in fPool; callers of this function (GetCluster() and WaitFor())
@@ -106,6 +131,8 @@ private:
    size_t FindFreeSlot() const;
    /// The I/O thread routine, there is exactly one I/O thread in-flight for every cluster pool
    void ExecLoadClusters();
+   /// The unzip thread routine, there is exactly one unzip thread in-flight for every cluster pool
+   void ExecUnzipClusters();
    /// Returns the given cluster from the pool, which needs to contain at least the columns `columns`.
    /// Executed at the end of GetCluster when all missing data pieces have been sent to the load queue.
    /// Ideally, the function returns without blocking if the cluster is already in the pool.
@@ -113,7 +140,7 @@ private:
 
 public:
    static constexpr unsigned int kDefaultPoolSize = 4;
-   RClusterPool(RPageSource &pageSource, unsigned int size);
+   RClusterPool(RPageSource &pageSource, unsigned int size, std::uint64_t maxReadAheadBytes = 0);
    explicit RClusterPool(RPageSource &pageSource) : RClusterPool(pageSource, kDefaultPoolSize) {}
    RClusterPool(const RClusterPool &other) = delete;
    RClusterPool &operator =(const RClusterPool &other) = delete;
@@ -121,10 +148,11 @@ public:
 
    unsigned int GetWindowPre() const { return fWindowPre; }
    unsigned int GetWindowPost() const { return fWindowPost; }
+   std::uint64_t GetMaxReadAheadBytes() const { return fMaxReadAheadBytes; }
 
    /// Returns the requested cluster either from the pool or, in case of a cache miss, lets the I/O thread load
    /// the cluster in the pool, blocks until done, and then returns it.  Triggers along the way the background loading
-   /// of the following fWindowPost number of clusters.  The returned cluster has at least all the pages of `columns`
+   /// of the following fWindowPost number of clusters, or less if fMaxReadAheadBytes is reached.  The returned cluster has at least all the pages of `columns`
    /// and possibly pages of other columns, too.  The returned cluster remains valid until the next call to
    /// GetCluster().
    RCluster *GetCluster(DescriptorId_t clusterId, const RPageSource::ColumnSet_t &columns);
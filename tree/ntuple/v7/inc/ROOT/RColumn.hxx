@@ -64,6 +64,9 @@ private:
    std::unique_ptr<RColumnElementBase> fElement;
 
    RColumn(const RColumnModel &model, std::uint32_t index);
+   /// Changes the on-disk type of the column to an encoded variant of its in-memory type, e.g. from kReal32
+   /// to kSplitReal32, and replaces the element that packs and unpacks the pages accordingly
+   void SetEncoding(EColumnType type);
 
 public:
    template <typename CppT, EColumnType ColumnT>
@@ -177,6 +180,30 @@ public:
          (clusterIndex.GetIndex() - fCurrentPage.GetClusterRangeFirst()) * RColumnElement<CppT, ColumnT>::kSize);
    }
 
+   /// Like Map() but additionally returns in nItems the number of elements that are contiguous in memory
+   /// starting from globalIndex, i.e. the elements up to the end of the page.
+   template <typename CppT, EColumnType ColumnT>
+   CppT *MapV(const NTupleSize_t globalIndex, NTupleSize_t &nItems) {
+      if (!fCurrentPage.Contains(globalIndex)) {
+         MapPage(globalIndex);
+      }
+      nItems = fCurrentPage.GetGlobalRangeLast() - globalIndex + 1;
+      return reinterpret_cast<CppT*>(
+         static_cast<unsigned char *>(fCurrentPage.GetBuffer()) +
+         (globalIndex - fCurrentPage.GetGlobalRangeFirst()) * RColumnElement<CppT, ColumnT>::kSize);
+   }
+
+   template <typename CppT, EColumnType ColumnT>
+   CppT *MapV(const RClusterIndex &clusterIndex, NTupleSize_t &nItems) {
+      if (!fCurrentPage.Contains(clusterIndex)) {
+         MapPage(clusterIndex);
+      }
+      nItems = fCurrentPage.GetClusterRangeLast() - clusterIndex.GetIndex() + 1;
+      return reinterpret_cast<CppT*>(
+         static_cast<unsigned char *>(fCurrentPage.GetBuffer()) +
+         (clusterIndex.GetIndex() - fCurrentPage.GetClusterRangeFirst()) * RColumnElement<CppT, ColumnT>::kSize);
+   }
+
    NTupleSize_t GetGlobalIndex(const RClusterIndex &clusterIndex) {
       if (!fCurrentPage.Contains(clusterIndex)) {
          MapPage(clusterIndex);
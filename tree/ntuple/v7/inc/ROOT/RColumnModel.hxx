@@ -48,6 +48,12 @@ enum class EColumnType {
    kInt64,
    kInt32,
    kInt16,
+   // Encoded variants of the column types above; they are unpacked to their native in-memory type when read.
+   // kSplitIndex stores the zigzag-encoded differences of consecutive values, the split types store the
+   // values byte by byte, i.e. first the first byte of all the elements of a page, then the second byte etc.
+   kSplitIndex,
+   kSplitReal64,
+   kSplitReal32,
 };
 
 // clang-format off
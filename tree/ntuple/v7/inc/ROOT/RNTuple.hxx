@@ -25,8 +25,10 @@
 #include <ROOT/RPageStorage.hxx>
 #include <ROOT/RStringView.hxx>
 
+#include <functional>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <utility>
 
@@ -74,6 +76,9 @@ Individual fields can be read as well by instantiating a tree view.
 // clang-format on
 class RNTupleReader {
 private:
+   /// Number of entry ranges per worker thread handed out by ProcessMT(), as for TTreeProcessorMT
+   static constexpr unsigned int kTasksPerWorkerHint = 10;
+
    std::unique_ptr<Detail::RPageSource> fSource;
    /// Needs to be destructed before fSource
    std::unique_ptr<RNTupleModel> fModel;
@@ -158,6 +163,13 @@ public:
 
    RNTupleGlobalRange GetEntryRange() { return RNTupleGlobalRange(0, GetNEntries()); }
 
+   /// Calls func for ranges of entries that do not cross cluster boundaries. With IMT enabled, the ranges are
+   /// processed concurrently by the tasks of the IMT pool, in the style of TTreeProcessorMT::Process(). Every
+   /// concurrent call receives a reader of its own: the clones of this reader, with a clone of its model, are reused
+   /// from one range to the next so that each worker opens the storage only once. Without IMT, func is called once
+   /// with this reader and the full entry range.
+   void ProcessMT(const std::function<void(RNTupleReader &reader, RNTupleGlobalRange range)> &func);
+
    /// Provides access to an individual field that can contain either a scalar value or a collection, e.g.
    /// GetView<double>("particles.pt") or GetView<std::vector<double>>("particle").  It can as well be the index
    /// field of a collection itself, like GetView<NTupleSize_t>("particle")
@@ -178,6 +190,54 @@ public:
    const Detail::RNTupleMetrics &GetMetrics() const { return fMetrics; }
 };
 
+// clang-format off
+/**
+\class ROOT::Experimental::RNTupleFillContext
+\ingroup NTuple
+\brief A context for filling entries into an RNTupleWriter from a separate thread
+
+Fill contexts are created by RNTupleWriter::CreateFillContext(). Every fill context has its own clone of the model,
+its own entries and its own page buffers. It collects and compresses the data of a full cluster and then writes
+the cluster to the writer's page sink. Using multiple fill contexts from multiple threads requires no additional
+synchronization. The entries of the clusters of different fill contexts interleave in the resulting ntuple.
+The fill contexts must be destructed before their writer.
+*/
+// clang-format on
+class RNTupleFillContext {
+   friend class RNTupleWriter;
+
+private:
+   std::unique_ptr<Detail::RPageSink> fSink;
+   /// Needs to be destructed before fSink
+   std::unique_ptr<RNTupleModel> fModel;
+   NTupleSize_t fClusterSizeEntries;
+   NTupleSize_t fLastCommitted = 0;
+   NTupleSize_t fNEntries = 0;
+
+   RNTupleFillContext(std::unique_ptr<RNTupleModel> model, std::unique_ptr<Detail::RPageSink> sink,
+                      NTupleSize_t clusterSizeEntries);
+
+public:
+   RNTupleFillContext(const RNTupleFillContext&) = delete;
+   RNTupleFillContext& operator=(const RNTupleFillContext&) = delete;
+   ~RNTupleFillContext();
+
+   /// The cloned model of the context; its default entry is used by Fill()
+   RNTupleModel *GetModel() { return fModel.get(); }
+   void Fill() { Fill(*fModel->GetDefaultEntry()); }
+   /// The entry must have been created from the model of this fill context
+   void Fill(REntry &entry) {
+      for (auto& value : entry) {
+         value.GetField()->Append(value);
+      }
+      fNEntries++;
+      if ((fNEntries % fClusterSizeEntries) == 0)
+         CommitCluster();
+   }
+   /// Seals the pages of the current cluster and writes them in one go to the writer's page sink
+   void CommitCluster();
+};
+
 // clang-format off
 /**
 \class ROOT::Experimental::RNTupleWriter
@@ -199,6 +259,8 @@ private:
    NTupleSize_t fClusterSizeEntries;
    NTupleSize_t fLastCommitted;
    NTupleSize_t fNEntries;
+   /// Serializes the cluster commits of the fill contexts
+   std::mutex fSinkLock;
 
 public:
    static std::unique_ptr<RNTupleWriter> Recreate(std::unique_ptr<RNTupleModel> model,
@@ -224,6 +286,10 @@ public:
    }
    /// Ensure that the data from the so far seen Fill calls has been written to storage
    void CommitCluster();
+
+   /// Creates a fill context for filling the ntuple in parallel, e.g. one per thread.  Fill(), i.e. filling through
+   /// the writer's own model, must not be used together with fill contexts.
+   std::unique_ptr<RNTupleFillContext> CreateFillContext();
 };
 
 // clang-format off
@@ -172,13 +172,19 @@ public:
       /// The usual format for ROOT compression settings (see Compression.h).
       /// The pages of a particular column in a particular cluster are all compressed with the same settings.
       std::int64_t fCompressionSettings = 0;
-
-      // TODO(jblomer): we perhaps want to store summary information, such as average, min/max, etc.
-      // Should this be done on the field level?
+      /// Whether fMin and fMax are set. Statistics are optionally recorded for the columns of numeric fields
+      /// (see RNTupleWriteOptions::SetClusterStatistics()), readers use them to skip clusters that cannot match a
+      /// selection.
+      bool fHasStatistics = false;
+      /// The smallest and the largest value of the elements of the column in the cluster
+      double fMin = 0.;
+      double fMax = 0.;
 
       bool operator==(const RColumnRange &other) const {
          return fColumnId == other.fColumnId && fFirstElementIndex == other.fFirstElementIndex &&
-                fNElements == other.fNElements && fCompressionSettings == other.fCompressionSettings;
+                fNElements == other.fNElements && fCompressionSettings == other.fCompressionSettings &&
+                fHasStatistics == other.fHasStatistics &&
+                (!fHasStatistics || (fMin == other.fMin && fMax == other.fMax));
       }
 
       bool Contains(NTupleSize_t index) const {
@@ -229,8 +235,9 @@ private:
    std::unordered_map<DescriptorId_t, RPageRange> fPageRanges;
 
 public:
-   /// In order to handle changes to the serialization routine in future ntuple versions
-   static constexpr std::uint16_t kFrameVersionCurrent = 0;
+   /// In order to handle changes to the serialization routine in future ntuple versions.
+   /// Version 1 adds the column statistics at the end of the cluster summary.
+   static constexpr std::uint16_t kFrameVersionCurrent = 1;
    static constexpr std::uint16_t kFrameVersionMin = 0;
 
    RClusterDescriptor() = default;
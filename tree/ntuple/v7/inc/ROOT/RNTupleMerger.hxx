@@ -0,0 +1,59 @@
+/// \file ROOT/RNTupleMerger.hxx
+/// \ingroup NTuple ROOT7
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT7_RNTupleMerger
+#define ROOT7_RNTupleMerger
+
+#include <ROOT/RNTupleUtil.hxx>
+#include <ROOT/RSpan.hxx>
+
+#include <vector>
+
+namespace ROOT {
+namespace Experimental {
+
+class RNTupleDescriptor;
+
+namespace Detail {
+class RPageSink;
+class RPageSource;
+} // namespace Detail
+
+// clang-format off
+/**
+\class ROOT::Experimental::RNTupleMerger
+\ingroup NTuple
+\brief Concatenates ntuples with identical schema without decompressing their pages
+
+The merger copies the sealed (packed and compressed) pages of every cluster of the sources byte by byte into the
+destination sink. Only the meta-data, i.e. the cluster and page locators, is rewritten. For this to work, the
+sources need to have the same fields and columns as well as the compression settings of the destination.
+*/
+// clang-format on
+class RNTupleMerger {
+private:
+   /// Returns, indexed by the column ids of the destination, the corresponding column ids of the source.
+   /// Throws an RException if the field and column structure of the two descriptors differ.
+   static std::vector<DescriptorId_t> MapColumns(const RNTupleDescriptor &destination,
+                                                 const RNTupleDescriptor &source);
+
+public:
+   /// Merges the attached page sources into the destination. The destination is created from the schema of the
+   /// first source; it must not have been created before. Throws an RException if the sources are incompatible.
+   void Merge(std::span<Detail::RPageSource *> sources, Detail::RPageSink &destination);
+};
+
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
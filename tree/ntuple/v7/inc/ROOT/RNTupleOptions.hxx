@@ -18,6 +18,10 @@
 
 #include <Compression.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
 namespace ROOT {
 namespace Experimental {
 
@@ -33,6 +37,18 @@ enum class ENTupleContainerFormat {
   kBare, // A thin envelope supporting a single RNTuple only
 };
 
+// clang-format off
+/**
+\class ROOT::Experimental::EImplicitMT
+\ingroup NTuple
+\brief Controls the use of the implicit multi-threading task arena by page sinks and sources
+*/
+// clang-format on
+enum class EImplicitMT {
+  kOff,     // Never use the IMT task arena
+  kDefault, // Use the IMT task arena if ROOT::EnableImplicitMT() has been called
+};
+
 
 // clang-format off
 /**
@@ -46,6 +62,20 @@ All page sink classes need to support the common options.
 class RNTupleWriteOptions {
   int fCompression{RCompressionSetting::EDefaults::kUseAnalysis};
   ENTupleContainerFormat fContainerFormat{ENTupleContainerFormat::kTFile};
+  /// If IMT is enabled, pages are compressed by tasks in the IMT arena and written in order on cluster commit
+  EImplicitMT fUseImplicitMT{EImplicitMT::kDefault};
+  /// If set, floating point columns are written byte-split and offset columns delta and zigzag encoded.
+  /// Readers detect the encoding from the meta-data.
+  bool fUseSplitEncoding{false};
+  /// If set, the minimum and maximum value of the columns of numeric fields are stored for every cluster
+  bool fClusterStatistics{false};
+  /// If non-zero, the number of elements per page is chosen for every column such that its compressed pages
+  /// approximately have this size, based on the compression of the pages of the column written so far
+  std::size_t fApproxZippedPageSize{0};
+  /// Lower bound of the number of elements per page chosen for fApproxZippedPageSize
+  std::size_t fMinElementsPerPage{64};
+  /// Upper bound of the number of elements per page chosen for fApproxZippedPageSize
+  std::size_t fMaxElementsPerPage{100000};
 
 public:
   int GetCompression() const { return fCompression; }
@@ -56,6 +86,24 @@ public:
 
   ENTupleContainerFormat GetContainerFormat() const { return fContainerFormat; }
   void SetContainerFormat(ENTupleContainerFormat val) { fContainerFormat = val; }
+
+  EImplicitMT GetUseImplicitMT() const { return fUseImplicitMT; }
+  void SetUseImplicitMT(EImplicitMT val) { fUseImplicitMT = val; }
+
+  bool GetUseSplitEncoding() const { return fUseSplitEncoding; }
+  void SetUseSplitEncoding(bool val) { fUseSplitEncoding = val; }
+
+  bool GetClusterStatistics() const { return fClusterStatistics; }
+  void SetClusterStatistics(bool val) { fClusterStatistics = val; }
+
+  std::size_t GetApproxZippedPageSize() const { return fApproxZippedPageSize; }
+  void SetApproxZippedPageSize(std::size_t val) { fApproxZippedPageSize = val; }
+  std::size_t GetMinElementsPerPage() const { return fMinElementsPerPage; }
+  std::size_t GetMaxElementsPerPage() const { return fMaxElementsPerPage; }
+  void SetElementsPerPageRange(std::size_t min, std::size_t max) {
+    fMinElementsPerPage = std::max<std::size_t>(min, 1);
+    fMaxElementsPerPage = std::max(max, fMinElementsPerPage);
+  }
 };
 
 
@@ -78,10 +126,30 @@ public:
 
 private:
    EClusterCache fClusterCache = EClusterCache::kDefault;
+   /// The number of clusters kept in the cluster pool, including the look-back and the read-ahead window
+   unsigned int fClusterPoolSize = 4;
+   /// If non-zero, the read-ahead stops once the clusters scheduled for loading exceed this number of bytes
+   std::uint64_t fMaxReadAheadBytes = 0;
+   /// If IMT is enabled, the pages of preloaded clusters are decompressed by tasks in the IMT arena
+   EImplicitMT fUseImplicitMT = EImplicitMT::kDefault;
+   /// If non-zero, unused pages stay in the page pool until the pool exceeds this number of bytes
+   std::uint64_t fPagePoolMaxBytes = 0;
+   /// If set and the file supports it, the file is memory mapped and uncompressed pages are served from the mapping
+   bool fUseMmap = false;
 
 public:
    EClusterCache GetClusterCache() const { return fClusterCache; }
    void SetClusterCache(EClusterCache val) { fClusterCache = val; }
+   unsigned int GetClusterPoolSize() const { return fClusterPoolSize; }
+   void SetClusterPoolSize(unsigned int val) { fClusterPoolSize = val; }
+   std::uint64_t GetMaxReadAheadBytes() const { return fMaxReadAheadBytes; }
+   void SetMaxReadAheadBytes(std::uint64_t val) { fMaxReadAheadBytes = val; }
+   EImplicitMT GetUseImplicitMT() const { return fUseImplicitMT; }
+   void SetUseImplicitMT(EImplicitMT val) { fUseImplicitMT = val; }
+   std::uint64_t GetPagePoolMaxBytes() const { return fPagePoolMaxBytes; }
+   void SetPagePoolMaxBytes(std::uint64_t val) { fPagePoolMaxBytes = val; }
+   bool GetUseMmap() const { return fUseMmap; }
+   void SetUseMmap(bool val) { fUseMmap = val; }
 };
 
 } // namespace Experimental
@@ -18,8 +18,11 @@
 
 #include <ROOT/RField.hxx>
 #include <ROOT/RNTupleUtil.hxx>
+#include <ROOT/RSpan.hxx>
 #include <ROOT/RStringView.hxx>
+#include <ROOT/RVec.hxx>
 
+#include <algorithm>
 #include <iterator>
 #include <memory>
 #include <type_traits>
@@ -145,7 +148,9 @@ The view owns a field and its underlying columns in order to fill an ntuple valu
 accessed by index. For top-level fields, the index refers to the entry number. Fields that are part of
 nested collections have global index numbers that are derived from their parent indexes.
 
-Fields of simple types with a Map() method will use that and thus expose zero-copy access.
+Fields of simple types with a Map() method will use that and thus expose zero-copy access.  For such fields,
+MapV() provides zero-copy access to all the elements from a given index up to the end of its page, which allows
+for vectorized processing of whole pages.  ReadV() returns an arbitrary range of elements as an RVec.
 */
 // clang-format on
 template <typename T>
@@ -204,6 +209,50 @@ public:
       fField.Read(clusterIndex, &fValue);
       return *fValue.Get<T>();
    }
+
+   /// Returns the contiguous elements from globalIndex up to the end of the page containing globalIndex.
+   /// No data is copied; the span is valid until the view maps another page, i.e. until the next read access.
+   template <typename C = T>
+   typename std::enable_if_t<Internal::IsMappable<FieldT>::value, std::span<const C>>
+   MapV(NTupleSize_t globalIndex) {
+      NTupleSize_t nItems;
+      const C *items = fField.MapV(globalIndex, nItems);
+      return std::span<const C>(items, nItems);
+   }
+
+   template <typename C = T>
+   typename std::enable_if_t<Internal::IsMappable<FieldT>::value, std::span<const C>>
+   MapV(const RClusterIndex &clusterIndex) {
+      NTupleSize_t nItems;
+      const C *items = fField.MapV(clusterIndex, nItems);
+      return std::span<const C>(items, nItems);
+   }
+
+   /// Copies count elements starting from globalIndex into an RVec; possibly spans several pages.
+   /// Mappable fields are copied page by page.
+   template <typename C = T>
+   typename std::enable_if_t<Internal::IsMappable<FieldT>::value, ROOT::VecOps::RVec<C>>
+   ReadV(NTupleSize_t globalIndex, NTupleSize_t count) {
+      ROOT::VecOps::RVec<C> result(count);
+      NTupleSize_t nRead = 0;
+      while (nRead < count) {
+         auto items = MapV(globalIndex + nRead);
+         const auto nBatch = std::min(NTupleSize_t(items.size()), count - nRead);
+         std::copy(items.begin(), items.begin() + nBatch, result.begin() + nRead);
+         nRead += nBatch;
+      }
+      return result;
+   }
+
+   template <typename C = T>
+   typename std::enable_if_t<!Internal::IsMappable<FieldT>::value, ROOT::VecOps::RVec<C>>
+   ReadV(NTupleSize_t globalIndex, NTupleSize_t count) {
+      ROOT::VecOps::RVec<C> result;
+      result.reserve(count);
+      for (NTupleSize_t i = 0; i < count; ++i)
+         result.emplace_back((*this)(globalIndex + i));
+      return result;
+   }
 };
 
 
@@ -16,16 +16,18 @@
 #ifndef ROOT7_RPagePool
 #define ROOT7_RPagePool
 
+#include <ROOT/RNTupleMetrics.hxx>
 #include <ROOT/RPage.hxx>
 #include <ROOT/RPageAllocator.hxx>
 #include <ROOT/RNTupleUtil.hxx>
 
 #include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <vector>
 
 namespace ROOT {
 namespace Experimental {
-
 namespace Detail {
 
 // clang-format off
@@ -39,12 +41,22 @@ pages is thread-safe. The page pool does not allocate the memory -- allocation a
 page storage, which might do it in a way optimized to the backing store (e.g., mmap()).
 Multiple page caches can coexist.
 
-TODO(jblomer): it should be possible to register pages and to find them by column and index; this would
-facilitate pre-filling a cache, e.g. by read-ahead.
+By default, pages are freed as soon as their reference counter drops to zero.  If the pool is given a memory budget,
+unreferenced pages are kept in the pool and can be handed out again by GetPage().  Once the pages in the pool exceed
+the budget, the least recently used unreferenced pages are evicted.  Pages in use are never evicted, so the budget
+is a soft limit.
 */
 // clang-format on
 class RPagePool {
 private:
+   /// I/O performance counters that get registered in fMetrics
+   struct RCounters {
+      RNTupleAtomicCounter &fNPageHit;
+      RNTupleAtomicCounter &fNPageMiss;
+      RNTupleAtomicCounter &fNPageEvicted;
+      RNTupleAtomicCounter &fSzPool;
+   };
+
    /// TODO(jblomer): should be an efficient index structure that allows
    ///   - random insert
    ///   - random delete
@@ -53,12 +65,33 @@ private:
    std::vector<RPage> fPages;
    std::vector<std::uint32_t> fReferences;
    std::vector<RPageDeleter> fDeleters;
+   /// For unreferenced pages, the value of fUseCounter when the page was returned the last time
+   std::vector<std::uint64_t> fLastUse;
+   /// Monotonically increasing clock used to find the least recently used page
+   std::uint64_t fUseCounter = 0;
+   /// The sum of the sizes of all the pages in the pool, in bytes
+   std::size_t fSzPages = 0;
+   /// If zero, unreferenced pages are released immediately
+   std::size_t fMaxBytes = 0;
+   /// Protects the page vectors
+   std::mutex fLock;
+
+   RNTupleMetrics fMetrics;
+   std::unique_ptr<RCounters> fCounters;
+
+   /// Removes the page at the given index and calls its deleter
+   void ErasePage(std::size_t idx);
+   /// Evicts least recently used, unreferenced pages until the pool fits into fMaxBytes or until there are
+   /// no more unreferenced pages
+   void Evict();
+   template <typename IndexT>
+   RPage GetPageImpl(ColumnId_t columnId, const IndexT &index);
 
 public:
-   RPagePool() = default;
+   explicit RPagePool(std::size_t maxBytes = 0);
    RPagePool(const RPagePool&) = delete;
    RPagePool& operator =(const RPagePool&) = delete;
-   ~RPagePool() = default;
+   ~RPagePool();
 
    /// Adds a new page to the pool together with the function to free its space. Upon registration,
    /// the page pool takes ownership of the page's memory. The new page has its reference counter set to 1.
@@ -71,6 +104,11 @@ public:
    /// this page. If the reference counter drops to zero, the page pool might decide to call the deleter given in
    /// during registration.
    void ReturnPage(const RPage &page);
+
+   std::size_t GetMaxBytes() const { return fMaxBytes; }
+   /// The sum of the sizes of the referenced and the cached pages
+   std::size_t GetSizeInBytes();
+   RNTupleMetrics &GetMetrics() { return fMetrics; }
 };
 
 } // namespace Detail
@@ -0,0 +1,80 @@
+/// \file ROOT/RPageSinkBuf.hxx
+/// \ingroup NTuple ROOT7
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT7_RPageSinkBuf
+#define ROOT7_RPageSinkBuf
+
+#include <ROOT/RPageStorage.hxx>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ROOT {
+namespace Experimental {
+namespace Detail {
+
+class RPageAllocatorHeap;
+
+// clang-format off
+/**
+\class ROOT::Experimental::Detail::RPageSinkBuf
+\ingroup NTuple
+\brief Page sink that seals the pages of a cluster in memory and writes them on cluster commit to another sink
+
+Committed pages are packed and compressed right away, i.e. in the thread that fills the columns. On cluster
+commit, the sealed pages are handed over to the inner sink in one go, followed by the cluster commit of the inner
+sink. Only this hand-over takes the lock that serializes the access to the inner sink. Therefore, several buffered
+sinks can feed the same inner sink from different threads. The columns of all the buffered sinks and of the
+inner sink must stem from the same model, so that the column ids match.
+*/
+// clang-format on
+class RPageSinkBuf : public RPageSink {
+private:
+   /// A sealed page whose buffer is owned by the sink until the cluster is committed
+   struct RBufferedPage {
+      DescriptorId_t fColumnId = kInvalidDescriptorId;
+      std::uint32_t fNElements = 0;
+      std::uint32_t fSize = 0;
+      std::unique_ptr<unsigned char[]> fBuffer;
+   };
+
+   RPageSink &fInnerSink;
+   /// Serializes the access to fInnerSink among all the buffered sinks that write into it
+   std::mutex &fInnerLock;
+   std::unique_ptr<RPageAllocatorHeap> fPageAllocator;
+   /// The sealed pages of the currently open cluster, in the order in which they have been committed
+   std::vector<RBufferedPage> fBufferedPages;
+
+protected:
+   void CreateImpl(const RNTupleModel &model) final;
+   RClusterDescriptor::RLocator CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page) final;
+   RClusterDescriptor::RLocator CommitClusterImpl(NTupleSize_t nEntries) final;
+   void CommitDatasetImpl() final;
+
+public:
+   /// The write options, most importantly the compression settings, are taken from the inner sink
+   RPageSinkBuf(RPageSink &innerSink, std::mutex &innerLock);
+   RPageSinkBuf(const RPageSinkBuf&) = delete;
+   RPageSinkBuf& operator=(const RPageSinkBuf&) = delete;
+   virtual ~RPageSinkBuf();
+
+   RPage ReservePage(ColumnHandle_t columnHandle, std::size_t nElements = 0) final;
+   void ReleasePage(RPage &page) final;
+};
+
+} // namespace Detail
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
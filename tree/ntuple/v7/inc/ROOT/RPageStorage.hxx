@@ -27,6 +27,7 @@
 #include <cstddef>
 #include <memory>
 #include <unordered_set>
+#include <vector>
 
 namespace ROOT {
 namespace Experimental {
@@ -81,6 +82,18 @@ public:
    /// The column handle identifies a column with the current open page storage
    using ColumnHandle_t = RColumnHandle;
 
+   /// A sealed page contains the bytes of a page as written to storage (packed & compressed).  It is used
+   /// as an input to CommitSealedPage() and as an output of LoadSealedPage(), e.g. to copy pages without
+   /// decompressing them.
+   struct RSealedPage {
+      const void *fBuffer = nullptr;
+      std::uint32_t fSize = 0;
+      std::uint32_t fNElements = 0;
+
+      RSealedPage() = default;
+      RSealedPage(const void *b, std::uint32_t s, std::uint32_t n) : fBuffer(b), fSize(s), fNElements(n) {}
+   };
+
    /// Register a new column.  When reading, the column must exist in the ntuple on disk corresponding to the meta-data.
    /// When writing, every column can only be attached once.
    virtual ColumnHandle_t AddColumn(DescriptorId_t fieldId, const RColumn &column) = 0;
@@ -108,6 +121,10 @@ up to the given entry number are committed.
 */
 // clang-format on
 class RPageSink : public RPageStorage {
+public:
+   /// Updates the minimum and maximum of the column range with the elements of a page
+   using StatisticsUpdater_t = void (*)(const RPage &page, RClusterDescriptor::RColumnRange &columnRange);
+
 protected:
    RNTupleWriteOptions fOptions;
 
@@ -121,10 +138,33 @@ protected:
    std::vector<RClusterDescriptor::RColumnRange> fOpenColumnRanges;
    /// Keeps track of the written pages in the currently open cluster. Indexed by column id.
    std::vector<RClusterDescriptor::RPageRange> fOpenPageRanges;
+   /// Indexed by column id; null for the columns without statistics (see RNTupleWriteOptions::SetClusterStatistics())
+   std::vector<StatisticsUpdater_t> fStatisticsUpdaters;
+   /// Indexed by column id, whether sealed pages were committed to the open cluster. The statistics do not see the
+   /// elements of sealed pages, they can only be given by SetColumnStatistics().
+   std::vector<bool> fHasSealedPages;
+   /// Elements and compressed bytes of the pages written so far for a column, used to size its next pages
+   struct RPageSizeStats {
+      std::uint64_t fNElements = 0;
+      std::uint64_t fZippedBytes = 0;
+   };
+   /// Indexed by column id, only updated if RNTupleWriteOptions::GetApproxZippedPageSize() is set
+   std::vector<RPageSizeStats> fPageSizeStats;
    RNTupleDescriptorBuilder fDescriptorBuilder;
 
+   /// Called by the storage implementations for every page they compress
+   void UpdatePageSizeStats(DescriptorId_t columnId, std::size_t nElements, std::size_t zippedBytes)
+   {
+      if (fOptions.GetApproxZippedPageSize() == 0)
+         return;
+      fPageSizeStats[columnId].fNElements += nElements;
+      fPageSizeStats[columnId].fZippedBytes += zippedBytes;
+   }
+
    virtual void CreateImpl(const RNTupleModel &model) = 0;
    virtual RClusterDescriptor::RLocator CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page) = 0;
+   /// Writes the sealed page as is; storage implementations that cannot handle sealed pages throw an RException
+   virtual RClusterDescriptor::RLocator CommitSealedPageImpl(DescriptorId_t columnId, const RSealedPage &sealedPage);
    virtual RClusterDescriptor::RLocator CommitClusterImpl(NTupleSize_t nEntries) = 0;
    virtual void CommitDatasetImpl() = 0;
 
@@ -135,6 +175,11 @@ public:
    static std::unique_ptr<RPageSink> Create(std::string_view ntupleName, std::string_view location,
                                             const RNTupleWriteOptions &options = RNTupleWriteOptions());
    EPageStorageType GetType() final { return EPageStorageType::kSink; }
+   const RNTupleWriteOptions &GetWriteOptions() const { return fOptions; }
+   /// The descriptor of the ntuple being written; it contains the clusters committed so far
+   const RNTupleDescriptor &GetDescriptor() const { return fDescriptorBuilder.GetDescriptor(); }
+   /// The number of entries in the clusters committed so far
+   NTupleSize_t GetNEntries() const { return fPrevClusterNEntries; }
 
    ColumnHandle_t AddColumn(DescriptorId_t fieldId, const RColumn &column) final;
    void DropColumn(ColumnHandle_t /*columnHandle*/) final {}
@@ -145,11 +190,21 @@ public:
    void Create(RNTupleModel &model);
    /// Write a page to the storage. The column must have been added before.
    void CommitPage(ColumnHandle_t columnHandle, const RPage &page);
+   /// Write a preprocessed page to storage, e.g. a page from another ntuple with identical column and
+   /// compression settings. The column must have been added before.
+   void CommitSealedPage(DescriptorId_t columnId, const RSealedPage &sealedPage);
+   /// Set the statistics of a column in the open cluster, e.g. of sealed pages committed by a sink that has seen
+   /// their elements or that are copied from another ntuple
+   void SetColumnStatistics(DescriptorId_t columnId, const RClusterDescriptor::RColumnRange &statistics);
    /// Finalize the current cluster and create a new one for the following data.
    void CommitCluster(NTupleSize_t nEntries);
    /// Finalize the current cluster and the entrire data set.
    void CommitDataset() { CommitDatasetImpl(); }
 
+   /// The number of elements of the next page of the column. It is fixed unless an approximate compressed page size
+   /// is set in the write options, in which case it follows the compression of the pages of the column written so far.
+   std::size_t GetNElementsPerPage(ColumnHandle_t columnHandle) const;
+
    /// Get a new, empty page for the given column that can be filled with up to nElements.  If nElements is zero,
    /// the page sink picks an appropriate size.
    virtual RPage ReservePage(ColumnHandle_t columnHandle, std::size_t nElements = 0) = 0;
@@ -169,6 +224,11 @@ class RPageSource : public RPageStorage {
 public:
    /// Derived from the model (fields) that are actually being requested at a given point in time
    using ColumnSet_t = std::unordered_set<DescriptorId_t>;
+   /// Identifies a (partial) cluster to be loaded by LoadClusters()
+   struct RClusterKey {
+      DescriptorId_t fClusterId = kInvalidDescriptorId;
+      ColumnSet_t fColumns;
+   };
 
 protected:
    RNTupleReadOptions fOptions;
@@ -203,6 +263,12 @@ public:
    /// Another version of PopulatePage that allows to specify cluster-relative indexes
    virtual RPage PopulatePage(ColumnHandle_t columnHandle, const RClusterIndex &clusterIndex) = 0;
 
+   /// Reads the packed and compressed bytes of the page that contains clusterIndex into the memory provided by
+   /// sealedPage.fBuffer.  If sealedPage.fBuffer is nullptr, only fSize and fNElements are set.  The sealed page
+   /// can subsequently be written to a page sink with CommitSealedPage().  Storage implementations that cannot
+   /// provide sealed pages throw an RException.
+   virtual void LoadSealedPage(DescriptorId_t columnId, const RClusterIndex &clusterIndex, RSealedPage &sealedPage);
+
    /// Populates all the pages of the given cluster id and columns; it is possible that some columns do not
    /// contain any pages.  The pages source may load more columns than the minimal necessary set from `columns`.
    /// To indicate which columns have been loaded, LoadCluster() must mark them with SetColumnAvailable().
@@ -211,6 +277,15 @@ public:
    /// LoadCluster() is typically called from the I/O thread of a cluster pool, i.e. the method runs
    /// concurrently to other methods of the page source.
    virtual std::unique_ptr<RCluster> LoadCluster(DescriptorId_t clusterId, const ColumnSet_t &columns) = 0;
+   /// Loads several (partial) clusters at once; the returned clusters are in the order of clusterKeys.
+   /// Page sources can use it to batch the storage requests of several clusters, e.g. in a single vector read.
+   /// The default implementation calls LoadCluster() for every key.
+   virtual std::vector<std::unique_ptr<RCluster>> LoadClusters(const std::vector<RClusterKey> &clusterKeys);
+
+   /// Called by the cluster pool's unzip thread for every loaded cluster before it is handed over to the pool.
+   /// Page sources can use it to decompress the pages ahead of time, so that PopulatePage() only needs to copy
+   /// and unpack. The default implementation leaves the cluster unchanged.
+   virtual void UnzipCluster(RCluster * /* cluster */) {}
 };
 
 } // namespace Detail
@@ -20,22 +20,23 @@
 #include <ROOT/RMiniFile.hxx>
 #include <ROOT/RNTupleMetrics.hxx>
 #include <ROOT/RNTupleZip.hxx>
+#include <ROOT/RRawFile.hxx>
 #include <ROOT/RStringView.hxx>
 
 #include <array>
 #include <cstdio>
+#include <deque>
 #include <memory>
 #include <string>
+#include <vector>
 
 class TFile;
 
 namespace ROOT {
 
-namespace Internal {
-class RRawFile;
-}
-
 namespace Experimental {
+class TTaskGroup;
+
 namespace Detail {
 
 class RCluster;
@@ -69,9 +70,33 @@ private:
    /// Helper for zipping keys and header / footer; comprises a 16MB zip buffer
    RNTupleCompressor fCompressor;
 
+   /// A page of the currently open cluster whose compression has been handed to the IMT task arena.
+   /// The page is written to the file and its locator is set in CommitClusterImpl().
+   struct RPendingPage {
+      DescriptorId_t fColumnId = kInvalidDescriptorId;
+      /// Index of the page info in fOpenPageRanges[fColumnId]
+      std::size_t fPageIndex = 0;
+      std::size_t fPackedBytes = 0;
+      std::size_t fZippedBytes = 0;
+      /// The packed page; the buffer is kept for uncompressible pages
+      std::unique_ptr<unsigned char[]> fPackedBuffer;
+      std::unique_ptr<unsigned char[]> fZipBuffer;
+   };
+   /// Pages are only appended during the lifetime of the compression tasks; the deque keeps the elements in place
+   std::deque<RPendingPage> fPendingPages;
+   /// Set if the pages are compressed in the IMT arena; needs to be destructed before fPendingPages
+   std::unique_ptr<TTaskGroup> fTaskGroup;
+
+   void InitImplicitMT();
+   /// Packs the page into a fresh buffer and schedules its compression
+   void ScheduleCompression(ColumnHandle_t columnHandle, const RPage &page);
+   /// Waits for the compression tasks and writes the pending pages in the order in which they were committed
+   void WritePendingPages();
+
 protected:
    void CreateImpl(const RNTupleModel &model) final;
    RClusterDescriptor::RLocator CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page) final;
+   RClusterDescriptor::RLocator CommitSealedPageImpl(DescriptorId_t columnId, const RSealedPage &sealedPage) final;
    RClusterDescriptor::RLocator CommitClusterImpl(NTupleSize_t nEntries) final;
    void CommitDatasetImpl() final;
 
@@ -122,14 +147,15 @@ private:
       RNTupleAtomicCounter &fNRead;
       RNTupleAtomicCounter &fSzReadPayload ;
       RNTupleAtomicCounter &fSzReadOverhead;
-      RNTuplePlainCounter  &fSzUnzip;
+      RNTupleAtomicCounter &fSzUnzip;
       RNTupleAtomicCounter &fNClusterLoaded;
       RNTuplePlainCounter  &fNPageLoaded;
       RNTuplePlainCounter  &fNPagePopulated;
+      RNTuplePlainCounter  &fNPageMapped;
       RNTupleAtomicCounter &fTimeWallRead;
-      RNTuplePlainCounter  &fTimeWallUnzip;
+      RNTupleAtomicCounter &fTimeWallUnzip;
       RNTupleTickCounter<RNTupleAtomicCounter> &fTimeCpuRead;
-      RNTupleTickCounter<RNTuplePlainCounter>  &fTimeCpuUnzip;
+      RNTupleTickCounter<RNTupleAtomicCounter> &fTimeCpuUnzip;
    };
    std::unique_ptr<RCounters> fCounters;
    /// Wraps the I/O counters and is observed by the RNTupleReader metrics
@@ -147,12 +173,28 @@ private:
    std::unique_ptr<ROOT::Internal::RRawFile> fFile;
    /// Takes the fFile to read ntuple blobs from it
    Internal::RMiniFileReader fReader;
+   /// If memory mapping is requested and supported, the entire file is mapped read-only
+   void *fMmapRegion = nullptr;
+   /// The length of the mapping; the mapping starts at offset zero
+   std::uint64_t fMmapSize = 0;
+   /// Set if the pages of preloaded clusters are decompressed by tasks in the IMT arena
+   std::unique_ptr<TTaskGroup> fTaskGroup;
    /// The cluster pool asynchronously preloads the next few clusters
    std::unique_ptr<RClusterPool> fClusterPool;
 
    RPageSourceFile(std::string_view ntupleName, const RNTupleReadOptions &options);
+   /// Maps fFile if requested by the read options and if the raw file supports it
+   void InitMmap();
+   /// Returns an RPage pointing into the file mapping if the page is stored uncompressed and suitably aligned;
+   /// otherwise returns a null page
+   RPage MapPage(ColumnId_t columnId, const RClusterDescriptor::RPageRange::RPageInfo &pageInfo,
+                 std::size_t elementSize);
    RPage PopulatePageFromCluster(ColumnHandle_t columnHandle, const RClusterDescriptor &clusterDescriptor,
                                  ClusterSize_t::ValueType clusterIndex);
+   /// Allocates the memory for the requested pages of a cluster and appends the coalesced byte ranges of
+   /// these pages to readRequests. The cluster is complete once readRequests are processed.
+   std::unique_ptr<RCluster> PrepareSingleCluster(DescriptorId_t clusterId, const ColumnSet_t &columns,
+                                                  std::vector<ROOT::Internal::RRawFile::RIOVec> &readRequests);
 
 protected:
    RNTupleDescriptor AttachImpl() final;
@@ -166,9 +208,14 @@ public:
 
    RPage PopulatePage(ColumnHandle_t columnHandle, NTupleSize_t globalIndex) final;
    RPage PopulatePage(ColumnHandle_t columnHandle, const RClusterIndex &clusterIndex) final;
+   void LoadSealedPage(DescriptorId_t columnId, const RClusterIndex &clusterIndex, RSealedPage &sealedPage) final;
    void ReleasePage(RPage &page) final;
 
    std::unique_ptr<RCluster> LoadCluster(DescriptorId_t clusterId, const ColumnSet_t &columns) final;
+   /// Issues the read requests of all the given clusters in a single RRawFile::ReadV() call
+   std::vector<std::unique_ptr<RCluster>> LoadClusters(const std::vector<RClusterKey> &clusterKeys) final;
+   /// With IMT enabled, replaces the compressed pages of the cluster by their decompressed (but still packed) version
+   void UnzipCluster(RCluster *cluster) final;
 
    RNTupleMetrics &GetMetrics() final { return fMetrics; }
 };
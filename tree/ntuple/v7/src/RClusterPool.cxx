@@ -16,6 +16,7 @@
 #include <ROOT/RClusterPool.hxx>
 #include <ROOT/RNTupleDescriptor.hxx>
 #include <ROOT/RPageStorage.hxx>
+#include <ROOT/RTrace.hxx>
 
 #include <TError.h>
 
@@ -47,10 +48,13 @@ bool ROOT::Experimental::Detail::RClusterPool::RInFlightCluster::operator <(cons
    return fClusterId < other.fClusterId;
 }
 
-ROOT::Experimental::Detail::RClusterPool::RClusterPool(RPageSource &pageSource, unsigned int size)
+ROOT::Experimental::Detail::RClusterPool::RClusterPool(RPageSource &pageSource, unsigned int size,
+                                                       std::uint64_t maxReadAheadBytes)
    : fPageSource(pageSource)
+   , fMaxReadAheadBytes(maxReadAheadBytes)
    , fPool(size)
    , fThreadIo(&RClusterPool::ExecLoadClusters, this)
+   , fThreadUnzip(&RClusterPool::ExecUnzipClusters, this)
 {
    R__ASSERT(size > 0);
    fWindowPre = 0;
@@ -71,6 +75,14 @@ ROOT::Experimental::Detail::RClusterPool::~RClusterPool()
       fCvHasWork.notify_one();
    }
    fThreadIo.join();
+
+   {
+      // Controlled shutdown of the unzip thread; the I/O thread does not queue any more clusters
+      std::unique_lock<std::mutex> lock(fLockUnzipQueue);
+      fUnzipQueue.emplace(RUnzipItem());
+      fCvHasUnzipWork.notify_one();
+   }
+   fThreadUnzip.join();
 }
 
 void ROOT::Experimental::Detail::RClusterPool::ExecLoadClusters()
@@ -86,12 +98,27 @@ void ROOT::Experimental::Detail::RClusterPool::ExecLoadClusters()
          }
       }
 
+      // The page source loads all the clusters of the work queue in one go, e.g. in a single vector read.
+      // The termination request is always the last item of the queue.
+      bool terminate = false;
+      std::vector<RPageSource::RClusterKey> clusterKeys;
       for (auto &item : workItems) {
-         if (item.fClusterId == kInvalidDescriptorId)
-            return;
+         if (item.fClusterId == kInvalidDescriptorId) {
+            terminate = true;
+            break;
+         }
+         clusterKeys.emplace_back(RPageSource::RClusterKey{item.fClusterId, item.fColumns});
+      }
+      std::vector<std::unique_ptr<RCluster>> clusters;
+      if (!clusterKeys.empty()) {
+         R__TRACE_SCOPE("io", "RClusterPool::LoadClusters");
+         clusters = fPageSource.LoadClusters(clusterKeys);
+      }
+      R__ASSERT(clusters.size() == clusterKeys.size());
 
-         // TODO(jblomer): the page source needs to be capable of loading multiple clusters in one go
-         auto cluster = fPageSource.LoadCluster(item.fClusterId, item.fColumns);
+      for (std::size_t i = 0; i < clusters.size(); ++i) {
+         auto &item = workItems[i];
+         auto &cluster = clusters[i];
 
          // Meanwhile, the user might have requested clusters outside the look-ahead window, so that we don't
          // need the cluster anymore, in which case we simply discard it right away, before moving it to the pool
@@ -105,10 +132,44 @@ void ROOT::Experimental::Detail::RClusterPool::ExecLoadClusters()
                break;
             }
          }
-         if (discard)
-            cluster.reset();
+         if (discard || !cluster) {
+            item.fPromise.set_value(nullptr);
+            continue;
+         }
 
-         item.fPromise.set_value(std::move(cluster));
+         std::unique_lock<std::mutex> lock(fLockUnzipQueue);
+         RUnzipItem unzipItem;
+         unzipItem.fPromise = std::move(item.fPromise);
+         unzipItem.fCluster = std::move(cluster);
+         fUnzipQueue.emplace(std::move(unzipItem));
+         fCvHasUnzipWork.notify_one();
+      }
+
+      if (terminate)
+         return;
+   } // while (true)
+}
+
+void ROOT::Experimental::Detail::RClusterPool::ExecUnzipClusters()
+{
+   while (true) {
+      std::vector<RUnzipItem> unzipItems;
+      {
+         std::unique_lock<std::mutex> lock(fLockUnzipQueue);
+         fCvHasUnzipWork.wait(lock, [&]{ return !fUnzipQueue.empty(); });
+         while (!fUnzipQueue.empty()) {
+            unzipItems.emplace_back(std::move(fUnzipQueue.front()));
+            fUnzipQueue.pop();
+         }
+      }
+
+      for (auto &item : unzipItems) {
+         if (!item.fCluster)
+            return;
+
+         R__TRACE_SCOPE("unzip", "RClusterPool::UnzipCluster");
+         fPageSource.UnzipCluster(item.fCluster.get());
+         item.fPromise.set_value(std::move(item.fCluster));
       }
    } // while (true)
 }
@@ -197,13 +258,15 @@ ROOT::Experimental::Detail::RClusterPool::GetCluster(
    RProvides provide;
    provide.Insert(clusterId, columns);
    auto next = clusterId;
-   // TODO(jblomer): instead of a fixed-sized window, eventually we should determine the window size based on
-   // a user-defined memory limit.  The size of the preloaded data can be determined at the beginning of
-   // GetCluster from the descriptor and the current contents of fPool.
+   // The size of the whole cluster on storage is used as an upper bound for the size of the requested columns
+   std::uint64_t szReadAhead = 0;
    for (unsigned int i = 1; i < fWindowPost; ++i) {
       next = desc.FindNextClusterId(next);
       if (next == kInvalidDescriptorId)
          break;
+      szReadAhead += desc.GetClusterDescriptor(next).GetLocator().fBytesOnStorage;
+      if ((fMaxReadAheadBytes > 0) && (szReadAhead > fMaxReadAheadBytes))
+         break;
       provide.Insert(next, columns);
    }
 
@@ -14,6 +14,7 @@
  *************************************************************************/
 
 #include <ROOT/RColumn.hxx>
+#include <ROOT/RColumnElement.hxx>
 #include <ROOT/RColumnModel.hxx>
 #include <ROOT/RPageStorage.hxx>
 
@@ -21,6 +22,22 @@
 
 #include <iostream>
 
+namespace {
+
+/// Returns the encoded variant of the given column type or kUnknown if there is none
+ROOT::Experimental::EColumnType GetSplitType(ROOT::Experimental::EColumnType type)
+{
+   using ROOT::Experimental::EColumnType;
+   switch (type) {
+   case EColumnType::kIndex: return EColumnType::kSplitIndex;
+   case EColumnType::kReal64: return EColumnType::kSplitReal64;
+   case EColumnType::kReal32: return EColumnType::kSplitReal32;
+   default: return EColumnType::kUnknown;
+   }
+}
+
+} // anonymous namespace
+
 ROOT::Experimental::Detail::RColumn::RColumn(const RColumnModel& model, std::uint32_t index)
    : fModel(model), fIndex(index), fPageSink(nullptr), fPageSource(nullptr), fHeadPage(), fNElements(0),
      fCurrentPage(),
@@ -40,11 +57,35 @@ ROOT::Experimental::Detail::RColumn::~RColumn()
       fPageSource->DropColumn(fHandleSource);
 }
 
+void ROOT::Experimental::Detail::RColumn::SetEncoding(EColumnType type)
+{
+   R__ASSERT(GetSplitType(fModel.GetType()) == type);
+   switch (type) {
+   case EColumnType::kSplitIndex:
+      fElement = std::unique_ptr<RColumnElementBase>(new RColumnElement<ClusterSize_t, EColumnType::kSplitIndex>(nullptr));
+      break;
+   case EColumnType::kSplitReal64:
+      fElement = std::unique_ptr<RColumnElementBase>(new RColumnElement<double, EColumnType::kSplitReal64>(nullptr));
+      break;
+   case EColumnType::kSplitReal32:
+      fElement = std::unique_ptr<RColumnElementBase>(new RColumnElement<float, EColumnType::kSplitReal32>(nullptr));
+      break;
+   default:
+      R__ASSERT(false);
+   }
+   fModel = RColumnModel(type, fModel.GetIsSorted());
+}
+
 void ROOT::Experimental::Detail::RColumn::Connect(DescriptorId_t fieldId, RPageStorage *pageStorage)
 {
    switch (pageStorage->GetType()) {
    case EPageStorageType::kSink:
       fPageSink = static_cast<RPageSink*>(pageStorage); // the page sink initializes fHeadPage on AddColumn
+      if (fPageSink->GetWriteOptions().GetUseSplitEncoding() &&
+          (GetSplitType(fModel.GetType()) != EColumnType::kUnknown))
+      {
+         SetEncoding(GetSplitType(fModel.GetType()));
+      }
       fHandleSink = fPageSink->AddColumn(fieldId, *this);
       fHeadPage = fPageSink->ReservePage(fHandleSink);
       break;
@@ -53,6 +94,12 @@ void ROOT::Experimental::Detail::RColumn::Connect(DescriptorId_t fieldId, RPageS
       fHandleSource = fPageSource->AddColumn(fieldId, *this);
       fNElements = fPageSource->GetNElements(fHandleSource);
       fColumnIdSource = fPageSource->GetColumnId(fHandleSource);
+      {
+         // Encoded columns are transparently unpacked into their in-memory type
+         auto onDiskType = fPageSource->GetDescriptor().GetColumnDescriptor(fHandleSource.fId).GetModel().GetType();
+         if ((onDiskType != fModel.GetType()) && (GetSplitType(fModel.GetType()) == onDiskType))
+            SetEncoding(onDiskType);
+      }
       break;
    default:
       R__ASSERT(false);
@@ -64,6 +111,14 @@ void ROOT::Experimental::Detail::RColumn::Flush()
    if (fHeadPage.GetSize() == 0) return;
 
    fPageSink->CommitPage(fHandleSink, fHeadPage);
+   // With adaptive page sizes, the next page is reallocated if the number of elements requested by the sink
+   // differs by more than a quarter from the current capacity
+   const auto nElements = fPageSink->GetNElementsPerPage(fHandleSink);
+   const auto capacity = fHeadPage.GetCapacity() / fHeadPage.GetElementSize();
+   if (4 * nElements < 3 * capacity || 4 * nElements > 5 * capacity) {
+      fPageSink->ReleasePage(fHeadPage);
+      fHeadPage = fPageSink->ReservePage(fHandleSink, nElements);
+   }
    fHeadPage.Reset(fNElements);
 }
 
@@ -20,6 +20,37 @@
 #include <algorithm>
 #include <bitset>
 #include <cstdint>
+#include <memory>
+
+namespace {
+
+/// Stores the bytes of count elements of size N such that first come the first bytes of all elements, then
+/// the second bytes etc.  Floating point numbers of similar magnitude then yield long runs of similar bytes,
+/// which compress better.
+template <std::size_t N>
+void SplitBytes(void *dst, const void *src, std::size_t count)
+{
+   auto splitArray = reinterpret_cast<unsigned char *>(dst);
+   auto elementArray = reinterpret_cast<const unsigned char *>(src);
+   for (std::size_t i = 0; i < count; ++i) {
+      for (std::size_t b = 0; b < N; ++b)
+         splitArray[b * count + i] = elementArray[i * N + b];
+   }
+}
+
+/// Inverse of SplitBytes()
+template <std::size_t N>
+void UnsplitBytes(void *dst, const void *src, std::size_t count)
+{
+   auto elementArray = reinterpret_cast<unsigned char *>(dst);
+   auto splitArray = reinterpret_cast<const unsigned char *>(src);
+   for (std::size_t i = 0; i < count; ++i) {
+      for (std::size_t b = 0; b < N; ++b)
+         elementArray[i * N + b] = splitArray[b * count + i];
+   }
+}
+
+} // anonymous namespace
 
 ROOT::Experimental::Detail::RColumnElementBase
 ROOT::Experimental::Detail::RColumnElementBase::Generate(EColumnType type) {
@@ -40,6 +71,12 @@ ROOT::Experimental::Detail::RColumnElementBase::Generate(EColumnType type) {
       return RColumnElement<ClusterSize_t, EColumnType::kIndex>(nullptr);
    case EColumnType::kSwitch:
       return RColumnElement<RColumnSwitch, EColumnType::kSwitch>(nullptr);
+   case EColumnType::kSplitIndex:
+      return RColumnElement<ClusterSize_t, EColumnType::kSplitIndex>(nullptr);
+   case EColumnType::kSplitReal64:
+      return RColumnElement<double, EColumnType::kSplitReal64>(nullptr);
+   case EColumnType::kSplitReal32:
+      return RColumnElement<float, EColumnType::kSplitReal32>(nullptr);
    default:
       R__ASSERT(false);
    }
@@ -47,6 +84,37 @@ ROOT::Experimental::Detail::RColumnElementBase::Generate(EColumnType type) {
    return RColumnElementBase();
 }
 
+std::size_t ROOT::Experimental::Detail::RColumnElementBase::GetBitsOnStorage(EColumnType type) {
+   switch (type) {
+   case EColumnType::kReal32:
+      return RColumnElement<float, EColumnType::kReal32>::kBitsOnStorage;
+   case EColumnType::kReal64:
+      return RColumnElement<double, EColumnType::kReal64>::kBitsOnStorage;
+   case EColumnType::kByte:
+      return RColumnElement<std::uint8_t, EColumnType::kByte>::kBitsOnStorage;
+   case EColumnType::kInt32:
+      return RColumnElement<std::int32_t, EColumnType::kInt32>::kBitsOnStorage;
+   case EColumnType::kInt64:
+      return RColumnElement<std::int64_t, EColumnType::kInt64>::kBitsOnStorage;
+   case EColumnType::kBit:
+      return RColumnElement<bool, EColumnType::kBit>::kBitsOnStorage;
+   case EColumnType::kIndex:
+      return RColumnElement<ClusterSize_t, EColumnType::kIndex>::kBitsOnStorage;
+   case EColumnType::kSwitch:
+      return RColumnElement<RColumnSwitch, EColumnType::kSwitch>::kBitsOnStorage;
+   case EColumnType::kSplitIndex:
+      return RColumnElement<ClusterSize_t, EColumnType::kSplitIndex>::kBitsOnStorage;
+   case EColumnType::kSplitReal64:
+      return RColumnElement<double, EColumnType::kSplitReal64>::kBitsOnStorage;
+   case EColumnType::kSplitReal32:
+      return RColumnElement<float, EColumnType::kSplitReal32>::kBitsOnStorage;
+   default:
+      R__ASSERT(false);
+   }
+   // never here
+   return 0;
+}
+
 void ROOT::Experimental::Detail::RColumnElement<bool, ROOT::Experimental::EColumnType::kBit>::Pack(
   void *dst, void *src, std::size_t count) const
 {
@@ -80,3 +148,62 @@ void ROOT::Experimental::Detail::RColumnElement<bool, ROOT::Experimental::EColum
       }
    }
 }
+
+void ROOT::Experimental::Detail::RColumnElement<float, ROOT::Experimental::EColumnType::kSplitReal32>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitBytes<kSize>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<float, ROOT::Experimental::EColumnType::kSplitReal32>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   UnsplitBytes<kSize>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<double, ROOT::Experimental::EColumnType::kSplitReal64>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   SplitBytes<kSize>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<double, ROOT::Experimental::EColumnType::kSplitReal64>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   UnsplitBytes<kSize>(dst, src, count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<
+   ROOT::Experimental::ClusterSize_t, ROOT::Experimental::EColumnType::kSplitIndex>::Pack(
+  void *dst, void *src, std::size_t count) const
+{
+   using ValueType = ClusterSize_t::ValueType;
+   static_assert(sizeof(ValueType) == kSize, "unexpected offset column element size");
+   auto indexArray = reinterpret_cast<const ClusterSize_t *>(src);
+   auto deltaArray = std::unique_ptr<ValueType[]>(new ValueType[count]);
+   // The differences of consecutive offsets are small and usually positive; the zigzag encoding keeps
+   // the occasional negative difference small, too
+   ValueType prev = 0;
+   for (std::size_t i = 0; i < count; ++i) {
+      auto delta = static_cast<std::int32_t>(indexArray[i] - prev);
+      deltaArray[i] = (static_cast<ValueType>(delta) << 1) ^ static_cast<ValueType>(delta >> 31);
+      prev = indexArray[i];
+   }
+   SplitBytes<kSize>(dst, deltaArray.get(), count);
+}
+
+void ROOT::Experimental::Detail::RColumnElement<
+   ROOT::Experimental::ClusterSize_t, ROOT::Experimental::EColumnType::kSplitIndex>::Unpack(
+  void *dst, void *src, std::size_t count) const
+{
+   using ValueType = ClusterSize_t::ValueType;
+   auto indexArray = reinterpret_cast<ClusterSize_t *>(dst);
+   UnsplitBytes<kSize>(dst, src, count);
+   ValueType prev = 0;
+   for (std::size_t i = 0; i < count; ++i) {
+      ValueType zigzag = indexArray[i];
+      auto delta = static_cast<ValueType>((zigzag >> 1) ^ (0 - (zigzag & 1)));
+      prev += delta;
+      indexArray[i] = prev;
+   }
+}
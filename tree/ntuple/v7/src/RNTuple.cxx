@@ -17,18 +17,25 @@
 
 #include "ROOT/RFieldVisitor.hxx"
 #include "ROOT/RNTupleModel.hxx"
+#include "ROOT/RPageSinkBuf.hxx"
 #include "ROOT/RPageStorage.hxx"
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 #include <algorithm>
 #include <exception>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <TError.h>
+#include <TROOT.h> // for IsImplicitMTEnabled()
 
 
 void ROOT::Experimental::RNTupleReader::ConnectModel(const RNTupleModel &model) {
@@ -204,6 +211,71 @@ void ROOT::Experimental::RNTupleReader::Show(NTupleSize_t index, const ENTupleSh
 }
 
 
+void ROOT::Experimental::RNTupleReader::ProcessMT(
+   const std::function<void(RNTupleReader &reader, RNTupleGlobalRange range)> &func)
+{
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && GetDescriptor().GetNClusters() > 1) {
+      // Entry ranges never cross cluster boundaries so that no cluster is read and decompressed by more than one
+      // reader; neighbouring clusters are only merged if there are many more clusters than tasks.
+      const auto &descriptor = GetDescriptor();
+      std::vector<std::pair<NTupleSize_t, NTupleSize_t>> clusterRanges;
+      clusterRanges.reserve(descriptor.GetNClusters());
+      for (unsigned int i = 0; i < descriptor.GetNClusters(); ++i) {
+         const auto &clusterDesc = descriptor.GetClusterDescriptor(i);
+         const auto nEntries = clusterDesc.GetNEntries();
+         if (nEntries == 0)
+            continue;
+         const auto first = clusterDesc.GetFirstEntryIndex();
+         clusterRanges.emplace_back(first, first + nEntries);
+      }
+      std::sort(clusterRanges.begin(), clusterRanges.end());
+      if (clusterRanges.empty())
+         return;
+
+      ROOT::TThreadExecutor pool;
+      const std::size_t nMaxRanges = std::size_t(pool.GetPoolSize()) * kTasksPerWorkerHint;
+      const std::size_t nClustersPerRange = (clusterRanges.size() + nMaxRanges - 1) / nMaxRanges;
+      std::vector<std::pair<NTupleSize_t, NTupleSize_t>> ranges;
+      for (std::size_t i = 0; i < clusterRanges.size(); i += nClustersPerRange) {
+         const auto last = std::min(i + nClustersPerRange, clusterRanges.size()) - 1;
+         ranges.emplace_back(clusterRanges[i].first, clusterRanges[last].second);
+      }
+
+      // Readers not used by a task at the moment; a new clone is only created if all of them are busy
+      std::mutex mutex;
+      std::vector<std::unique_ptr<RNTupleReader>> clones;
+      std::vector<RNTupleReader *> idleReaders{this};
+      auto processRange = [&](const std::pair<NTupleSize_t, NTupleSize_t> &range) {
+         RNTupleReader *reader = nullptr;
+         {
+            std::lock_guard<std::mutex> guard(mutex);
+            if (idleReaders.empty()) {
+               if (fModel) {
+                  clones.emplace_back(std::make_unique<RNTupleReader>(std::unique_ptr<RNTupleModel>(fModel->Clone()),
+                                                                      fSource->Clone()));
+               } else {
+                  clones.emplace_back(Clone());
+               }
+               if (fMetrics.IsEnabled())
+                  clones.back()->EnableMetrics();
+               idleReaders.emplace_back(clones.back().get());
+            }
+            reader = idleReaders.back();
+            idleReaders.pop_back();
+         }
+         func(*reader, RNTupleGlobalRange(range.first, range.second));
+         std::lock_guard<std::mutex> guard(mutex);
+         idleReaders.emplace_back(reader);
+      };
+      pool.Foreach(processRange, ranges);
+      return;
+   }
+#endif
+   func(*this, GetEntryRange());
+}
+
+
 //------------------------------------------------------------------------------
 
 
@@ -247,6 +319,49 @@ void ROOT::Experimental::RNTupleWriter::CommitCluster()
 }
 
 
+std::unique_ptr<ROOT::Experimental::RNTupleFillContext> ROOT::Experimental::RNTupleWriter::CreateFillContext()
+{
+   auto model = std::unique_ptr<RNTupleModel>(fModel->Clone());
+   std::unique_ptr<Detail::RPageSink> sink;
+   {
+      // Other fill contexts might concurrently commit clusters to fSink
+      std::lock_guard<std::mutex> guard(fSinkLock);
+      sink = std::make_unique<Detail::RPageSinkBuf>(*fSink, fSinkLock);
+   }
+   return std::unique_ptr<RNTupleFillContext>(
+      new RNTupleFillContext(std::move(model), std::move(sink), fClusterSizeEntries));
+}
+
+
+//------------------------------------------------------------------------------
+
+
+ROOT::Experimental::RNTupleFillContext::RNTupleFillContext(std::unique_ptr<RNTupleModel> model,
+   std::unique_ptr<Detail::RPageSink> sink, NTupleSize_t clusterSizeEntries)
+   : fSink(std::move(sink))
+   , fModel(std::move(model))
+   , fClusterSizeEntries(clusterSizeEntries)
+{
+   fSink->Create(*fModel.get());
+}
+
+ROOT::Experimental::RNTupleFillContext::~RNTupleFillContext()
+{
+   CommitCluster();
+}
+
+void ROOT::Experimental::RNTupleFillContext::CommitCluster()
+{
+   if (fNEntries == fLastCommitted) return;
+   for (auto& field : *fModel->GetFieldZero()) {
+      field.Flush();
+      field.CommitCluster();
+   }
+   fSink->CommitCluster(fNEntries);
+   fLastCommitted = fNEntries;
+}
+
+
 //------------------------------------------------------------------------------
 
 
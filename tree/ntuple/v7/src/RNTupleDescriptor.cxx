@@ -25,7 +25,9 @@
 #include <cstdint>
 #include <cstring>
 #include <iostream>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace {
 
@@ -84,6 +86,22 @@ std::uint32_t DeserializeUInt64(const void *buffer, std::uint64_t *val)
    return DeserializeInt64(buffer, reinterpret_cast<std::int64_t *>(val));
 }
 
+/// Doubles are stored as their IEEE 754 bit pattern in a 64bit integer
+std::uint32_t SerializeDouble(double val, void *buffer)
+{
+   std::uint64_t bits;
+   std::memcpy(&bits, &val, sizeof(bits));
+   return SerializeUInt64(bits, buffer);
+}
+
+std::uint32_t DeserializeDouble(const void *buffer, double *val)
+{
+   std::uint64_t bits;
+   auto size = DeserializeUInt64(buffer, &bits);
+   std::memcpy(val, &bits, sizeof(bits));
+   return size;
+}
+
 std::uint32_t SerializeInt32(std::int32_t val, void *buffer)
 {
    if (buffer != nullptr) {
@@ -444,7 +462,8 @@ std::uint32_t SerializeColumn(const ROOT::Experimental::RColumnDescriptor &val,
    return size;
 }
 
-std::uint32_t SerializeClusterSummary(const ROOT::Experimental::RClusterDescriptor &val, void *buffer)
+std::uint32_t SerializeClusterSummary(const ROOT::Experimental::RClusterDescriptor &val,
+   const std::vector<ROOT::Experimental::DescriptorId_t> &columnIds, void *buffer)
 {
    auto base = reinterpret_cast<unsigned char *>((buffer != nullptr) ? buffer : 0);
    auto pos = base;
@@ -460,6 +479,23 @@ std::uint32_t SerializeClusterSummary(const ROOT::Experimental::RClusterDescript
    pos += SerializeUInt64(val.GetNEntries(), *where);
    pos += SerializeLocator(val.GetLocator(), *where);
 
+   // Since frame version 1: the number of columns with statistics, followed by the id, the minimum and the maximum
+   // of each of these columns. Older readers skip them.
+   std::uint32_t nStats = 0;
+   for (auto columnId : columnIds) {
+      if (val.GetColumnRange(columnId).fHasStatistics)
+         ++nStats;
+   }
+   pos += SerializeUInt32(nStats, *where);
+   for (auto columnId : columnIds) {
+      const auto &columnRange = val.GetColumnRange(columnId);
+      if (!columnRange.fHasStatistics)
+         continue;
+      pos += SerializeUInt64(columnId, *where);
+      pos += SerializeDouble(columnRange.fMin, *where);
+      pos += SerializeDouble(columnRange.fMax, *where);
+   }
+
    auto size = pos - base;
    SerializeUInt32(size, ptrSize);
    return size;
@@ -577,10 +613,14 @@ std::uint32_t ROOT::Experimental::RNTupleDescriptor::SerializeFooter(void* buffe
       RNTupleDescriptor::kFrameVersionCurrent, RNTupleDescriptor::kFrameVersionMin, *where, &ptrSize);
    pos += SerializeUInt64(0, *where); // reserved; can be at some point used, e.g., for compression flags
 
+   std::vector<DescriptorId_t> columnIds;
+   for (const auto &column : fColumnDescriptors)
+      columnIds.emplace_back(column.first);
+
    pos += SerializeUInt64(fClusterDescriptors.size(), *where);
    for (const auto& cluster : fClusterDescriptors) {
       pos += SerializeUuid(fOwnUuid, *where); // in order to verify that header and footer belong together
-      pos += SerializeClusterSummary(cluster.second, *where);
+      pos += SerializeClusterSummary(cluster.second, columnIds, *where);
 
       pos += SerializeUInt32(fColumnDescriptors.size(), *where);
       for (const auto& column : fColumnDescriptors) {
@@ -851,6 +891,21 @@ void ROOT::Experimental::RNTupleDescriptorBuilder::AddClustersFromFooter(void* f
       pos += DeserializeLocator(pos, &locator);
       SetClusterLocator(clusterId, locator);
 
+      // Column statistics, absent in clusters written with frame version 0
+      std::unordered_map<DescriptorId_t, std::pair<double, double>> columnStats;
+      if (pos < clusterBase + frameSize) {
+         std::uint32_t nStats;
+         pos += DeserializeUInt32(pos, &nStats);
+         for (std::uint32_t j = 0; j < nStats; ++j) {
+            std::uint64_t columnId;
+            double min, max;
+            pos += DeserializeUInt64(pos, &columnId);
+            pos += DeserializeDouble(pos, &min);
+            pos += DeserializeDouble(pos, &max);
+            columnStats[columnId] = {min, max};
+         }
+      }
+
       pos = clusterBase + frameSize;
 
       std::uint32_t nColumns;
@@ -862,6 +917,12 @@ void ROOT::Experimental::RNTupleDescriptorBuilder::AddClustersFromFooter(void* f
          RClusterDescriptor::RColumnRange columnRange;
          columnRange.fColumnId = columnId;
          pos += DeserializeColumnRange(pos, &columnRange);
+         const auto itStats = columnStats.find(columnId);
+         if (itStats != columnStats.end()) {
+            columnRange.fHasStatistics = true;
+            columnRange.fMin = itStats->second.first;
+            columnRange.fMax = itStats->second.second;
+         }
          AddClusterColumnRange(clusterId, columnRange);
 
          RClusterDescriptor::RPageRange pageRange;
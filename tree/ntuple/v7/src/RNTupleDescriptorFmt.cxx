@@ -88,6 +88,12 @@ static std::string GetColumnTypeName(ROOT::Experimental::EColumnType type)
       return "Index";
    case ROOT::Experimental::EColumnType::kSwitch:
       return "Switch";
+   case ROOT::Experimental::EColumnType::kSplitIndex:
+      return "SplitIndex";
+   case ROOT::Experimental::EColumnType::kSplitReal64:
+      return "SplitReal64";
+   case ROOT::Experimental::EColumnType::kSplitReal32:
+      return "SplitReal32";
    default:
       return "UNKNOWN";
    }
@@ -0,0 +1,132 @@
+/// \file RNTupleMerger.cxx
+/// \ingroup NTuple ROOT7
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <ROOT/RError.hxx>
+#include <ROOT/RNTupleDescriptor.hxx>
+#include <ROOT/RNTupleMerger.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RPageStorage.hxx>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+std::vector<ROOT::Experimental::DescriptorId_t>
+ROOT::Experimental::RNTupleMerger::MapColumns(const RNTupleDescriptor &destination, const RNTupleDescriptor &source)
+{
+   if ((destination.GetNFields() != source.GetNFields()) || (destination.GetNColumns() != source.GetNColumns()))
+      throw RException(R__FAIL("ntuple '" + source.GetName() + "' has a different schema"));
+
+   // Maps destination field ids to source field ids; filled top-down because the parents are looked up first
+   std::unordered_map<DescriptorId_t, DescriptorId_t> fieldMap;
+   fieldMap[destination.GetFieldZeroId()] = source.GetFieldZeroId();
+   std::vector<DescriptorId_t> fieldStack{destination.GetFieldZeroId()};
+   while (!fieldStack.empty()) {
+      const auto parentId = fieldStack.back();
+      fieldStack.pop_back();
+      for (const auto &f : destination.GetFieldRange(parentId)) {
+         auto sourceFieldId = source.FindFieldId(f.GetFieldName(), fieldMap[parentId]);
+         if (sourceFieldId == kInvalidDescriptorId)
+            throw RException(R__FAIL("field '" + f.GetFieldName() + "' missing in ntuple '" + source.GetName() + "'"));
+         const auto &sourceField = source.GetFieldDescriptor(sourceFieldId);
+         if ((sourceField.GetTypeName() != f.GetTypeName()) || (sourceField.GetStructure() != f.GetStructure()) ||
+             (sourceField.GetNRepetitions() != f.GetNRepetitions()))
+         {
+            throw RException(R__FAIL("field '" + f.GetFieldName() + "' has a different type in ntuple '" +
+                                     source.GetName() + "'"));
+         }
+         fieldMap[f.GetId()] = sourceFieldId;
+         fieldStack.emplace_back(f.GetId());
+      }
+   }
+
+   std::vector<DescriptorId_t> columnMap(destination.GetNColumns(), kInvalidDescriptorId);
+   for (DescriptorId_t i = 0; i < destination.GetNColumns(); ++i) {
+      const auto &column = destination.GetColumnDescriptor(i);
+      auto sourceColumnId = source.FindColumnId(fieldMap[column.GetFieldId()], column.GetIndex());
+      if ((sourceColumnId == kInvalidDescriptorId) ||
+          !(source.GetColumnDescriptor(sourceColumnId).GetModel() == column.GetModel()))
+      {
+         throw RException(R__FAIL("column layout of field '" +
+                                  destination.GetFieldDescriptor(column.GetFieldId()).GetFieldName() +
+                                  "' differs in ntuple '" + source.GetName() + "'"));
+      }
+      columnMap[i] = sourceColumnId;
+   }
+   return columnMap;
+}
+
+
+void ROOT::Experimental::RNTupleMerger::Merge(std::span<Detail::RPageSource *> sources, Detail::RPageSink &destination)
+{
+   if (sources.empty())
+      throw RException(R__FAIL("no ntuples to merge"));
+
+   auto model = sources[0]->GetDescriptor().GenerateModel();
+   destination.Create(*model);
+   const auto compression = destination.GetWriteOptions().GetCompression();
+
+   // Check all the sources before writing anything
+   std::vector<std::vector<DescriptorId_t>> columnMaps;
+   for (auto source : sources) {
+      const auto &descriptor = source->GetDescriptor();
+      columnMaps.emplace_back(MapColumns(destination.GetDescriptor(), descriptor));
+      for (DescriptorId_t i = 0; i < descriptor.GetNClusters(); ++i) {
+         for (auto columnId : columnMaps.back()) {
+            if (descriptor.GetClusterDescriptor(i).GetColumnRange(columnId).fCompressionSettings != compression) {
+               throw RException(R__FAIL("ntuple '" + descriptor.GetName() +
+                                        "' has different compression settings than the destination"));
+            }
+         }
+      }
+   }
+
+   std::vector<unsigned char> buffer;
+   NTupleSize_t nEntries = 0;
+   for (std::size_t s = 0; s < sources.size(); ++s) {
+      auto source = sources[s];
+      const auto &descriptor = source->GetDescriptor();
+      const auto &columnMap = columnMaps[s];
+
+      std::vector<const RClusterDescriptor *> clusters;
+      for (DescriptorId_t i = 0; i < descriptor.GetNClusters(); ++i)
+         clusters.emplace_back(&descriptor.GetClusterDescriptor(i));
+      std::sort(clusters.begin(), clusters.end(), [](const RClusterDescriptor *a, const RClusterDescriptor *b) {
+         return a->GetFirstEntryIndex() < b->GetFirstEntryIndex();
+      });
+
+      for (auto cluster : clusters) {
+         for (DescriptorId_t columnId = 0; columnId < columnMap.size(); ++columnId) {
+            const auto sourceColumnId = columnMap[columnId];
+            ClusterSize_t::ValueType firstInPage = 0;
+            for (const auto &pageInfo : cluster->GetPageRange(sourceColumnId).fPageInfos) {
+               // The first call only determines the size of the sealed page
+               Detail::RPageStorage::RSealedPage sealedPage;
+               RClusterIndex index(cluster->GetId(), firstInPage);
+               source->LoadSealedPage(sourceColumnId, index, sealedPage);
+               if (buffer.size() < sealedPage.fSize)
+                  buffer.resize(sealedPage.fSize);
+               sealedPage.fBuffer = buffer.data();
+               source->LoadSealedPage(sourceColumnId, index, sealedPage);
+               destination.CommitSealedPage(columnId, sealedPage);
+               firstInPage += pageInfo.fNElements;
+            }
+            destination.SetColumnStatistics(columnId, cluster->GetColumnRange(sourceColumnId));
+         }
+         nEntries += cluster->GetNEntries();
+         destination.CommitCluster(nEntries);
+      }
+   }
+   destination.CommitDataset();
+}
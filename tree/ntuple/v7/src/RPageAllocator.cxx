@@ -14,6 +14,7 @@
  *************************************************************************/
 
 
+#include <ROOT/RMemoryAccounting.hxx>
 #include <ROOT/RPageAllocator.hxx>
 
 #include <TError.h>
@@ -24,10 +25,14 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageAllocatorHeap
    R__ASSERT((elementSize > 0) && (nElements > 0));
    auto nbytes = elementSize * nElements;
    auto buffer = new unsigned char[nbytes];
+   RMemoryAccounting::Add(RMemoryAccounting::ESubsystem::kPagePools, nbytes);
    return RPage(columnId, buffer, nbytes, elementSize);
 }
 
 void ROOT::Experimental::Detail::RPageAllocatorHeap::DeletePage(const RPage& page)
 {
+   if (page.IsNull())
+      return;
+   RMemoryAccounting::Add(RMemoryAccounting::ESubsystem::kPagePools, -std::int64_t(page.GetCapacity()));
    delete[] reinterpret_cast<unsigned char *>(page.GetBuffer());
 }
@@ -19,60 +19,128 @@
 #include <TError.h>
 
 #include <cstdlib>
+#include <limits>
+
+ROOT::Experimental::Detail::RPagePool::RPagePool(std::size_t maxBytes)
+   : fMaxBytes(maxBytes), fMetrics("RPagePool")
+{
+   fCounters = std::unique_ptr<RCounters>(new RCounters{
+      *fMetrics.MakeCounter<RNTupleAtomicCounter*>("nPageHit", "", "number of pages found in the pool"),
+      *fMetrics.MakeCounter<RNTupleAtomicCounter*>("nPageMiss", "", "number of pages not found in the pool"),
+      *fMetrics.MakeCounter<RNTupleAtomicCounter*>("nPageEvicted", "", "number of unreferenced pages evicted"),
+      *fMetrics.MakeCounter<RNTupleAtomicCounter*>("szPool", "B", "current size of the pages in the pool")
+   });
+}
+
+ROOT::Experimental::Detail::RPagePool::~RPagePool()
+{
+   // Cached pages are owned by the pool
+   for (std::size_t i = 0; i < fPages.size(); ++i) {
+      if (fReferences[i] == 0)
+         fDeleters[i](fPages[i]);
+   }
+}
+
+void ROOT::Experimental::Detail::RPagePool::ErasePage(std::size_t idx)
+{
+   auto N = fPages.size();
+   fSzPages -= fPages[idx].GetSize();
+   fCounters->fSzPool.Add(-static_cast<std::int64_t>(fPages[idx].GetSize()));
+   fDeleters[idx](fPages[idx]);
+   fPages[idx] = fPages[N-1];
+   fReferences[idx] = fReferences[N-1];
+   fDeleters[idx] = fDeleters[N-1];
+   fLastUse[idx] = fLastUse[N-1];
+   fPages.resize(N-1);
+   fReferences.resize(N-1);
+   fDeleters.resize(N-1);
+   fLastUse.resize(N-1);
+}
+
+void ROOT::Experimental::Detail::RPagePool::Evict()
+{
+   while (fSzPages > fMaxBytes) {
+      auto idxVictim = fPages.size();
+      auto lastUse = std::numeric_limits<std::uint64_t>::max();
+      for (std::size_t i = 0; i < fPages.size(); ++i) {
+         if ((fReferences[i] == 0) && (fLastUse[i] < lastUse)) {
+            idxVictim = i;
+            lastUse = fLastUse[i];
+         }
+      }
+      if (idxVictim == fPages.size())
+         return;
+      ErasePage(idxVictim);
+      fCounters->fNPageEvicted.Inc();
+   }
+}
 
 void ROOT::Experimental::Detail::RPagePool::RegisterPage(const RPage &page, const RPageDeleter &deleter)
 {
+   std::lock_guard<std::mutex> lockGuard(fLock);
    fPages.emplace_back(page);
    fReferences.emplace_back(1);
    fDeleters.emplace_back(deleter);
+   fLastUse.emplace_back(0);
+   fSzPages += page.GetSize();
+   fCounters->fSzPool.Add(page.GetSize());
+   if (fMaxBytes > 0)
+      Evict();
 }
 
 void ROOT::Experimental::Detail::RPagePool::ReturnPage(const RPage& page)
 {
    if (page.IsNull()) return;
 
+   std::lock_guard<std::mutex> lockGuard(fLock);
    unsigned int N = fPages.size();
    for (unsigned i = 0; i < N; ++i) {
       if (fPages[i] != page) continue;
 
       if (--fReferences[i] == 0) {
-         fDeleters[i](fPages[i]);
-         fPages[i] = fPages[N-1];
-         fReferences[i] = fReferences[N-1];
-         fDeleters[i] = fDeleters[N-1];
-         fPages.resize(N-1);
-         fReferences.resize(N-1);
-         fDeleters.resize(N-1);
+         if (fMaxBytes == 0) {
+            ErasePage(i);
+         } else {
+            fLastUse[i] = ++fUseCounter;
+            Evict();
+         }
       }
       return;
    }
    R__ASSERT(false);
 }
 
-ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPagePool::GetPage(
-   ColumnId_t columnId, NTupleSize_t globalIndex)
+template <typename IndexT>
+ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPagePool::GetPageImpl(
+   ColumnId_t columnId, const IndexT &index)
 {
+   std::lock_guard<std::mutex> lockGuard(fLock);
    unsigned int N = fPages.size();
    for (unsigned int i = 0; i < N; ++i) {
-      if (fReferences[i] == 0) continue;
       if (fPages[i].GetColumnId() != columnId) continue;
-      if (!fPages[i].Contains(globalIndex)) continue;
+      if (!fPages[i].Contains(index)) continue;
       fReferences[i]++;
+      fCounters->fNPageHit.Inc();
       return fPages[i];
    }
+   fCounters->fNPageMiss.Inc();
    return RPage();
 }
 
+ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPagePool::GetPage(
+   ColumnId_t columnId, NTupleSize_t globalIndex)
+{
+   return GetPageImpl(columnId, globalIndex);
+}
+
 ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPagePool::GetPage(
    ColumnId_t columnId, const RClusterIndex &clusterIndex)
 {
-   unsigned int N = fPages.size();
-   for (unsigned int i = 0; i < N; ++i) {
-      if (fReferences[i] == 0) continue;
-      if (fPages[i].GetColumnId() != columnId) continue;
-      if (!fPages[i].Contains(clusterIndex)) continue;
-      fReferences[i]++;
-      return fPages[i];
-   }
-   return RPage();
+   return GetPageImpl(columnId, clusterIndex);
+}
+
+std::size_t ROOT::Experimental::Detail::RPagePool::GetSizeInBytes()
+{
+   std::lock_guard<std::mutex> lockGuard(fLock);
+   return fSzPages;
 }
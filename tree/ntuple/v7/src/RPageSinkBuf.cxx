@@ -0,0 +1,104 @@
+/// \file RPageSinkBuf.cxx
+/// \ingroup NTuple ROOT7
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include <ROOT/RColumn.hxx>
+#include <ROOT/RColumnElement.hxx>
+#include <ROOT/RNTupleDescriptor.hxx>
+#include <ROOT/RNTupleZip.hxx>
+#include <ROOT/RPage.hxx>
+#include <ROOT/RPageAllocator.hxx>
+#include <ROOT/RPageSinkBuf.hxx>
+#include <ROOT/RPageStorageFile.hxx>
+
+#include <utility>
+
+ROOT::Experimental::Detail::RPageSinkBuf::RPageSinkBuf(RPageSink &innerSink, std::mutex &innerLock)
+   : RPageSink(innerSink.GetDescriptor().GetName(), innerSink.GetWriteOptions())
+   , fInnerSink(innerSink)
+   , fInnerLock(innerLock)
+   , fPageAllocator(std::make_unique<RPageAllocatorHeap>())
+{
+}
+
+ROOT::Experimental::Detail::RPageSinkBuf::~RPageSinkBuf()
+{
+}
+
+void ROOT::Experimental::Detail::RPageSinkBuf::CreateImpl(const RNTupleModel & /* model */)
+{
+   // The inner sink has been created from the same model; nothing to write here
+}
+
+ROOT::Experimental::RClusterDescriptor::RLocator
+ROOT::Experimental::Detail::RPageSinkBuf::CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page)
+{
+   auto element = columnHandle.fColumn->GetElement();
+   std::size_t packedBytes = page.GetSize();
+   std::unique_ptr<unsigned char[]> packedBuffer;
+   const void *source = page.GetBuffer();
+   if (!element->IsMappable()) {
+      packedBytes = (page.GetNElements() * element->GetBitsOnStorage() + 7) / 8;
+      packedBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[packedBytes]);
+      element->Pack(packedBuffer.get(), page.GetBuffer(), page.GetNElements());
+      source = packedBuffer.get();
+   }
+
+   RBufferedPage bufferedPage;
+   bufferedPage.fColumnId = columnHandle.fId;
+   bufferedPage.fNElements = page.GetNElements();
+   bufferedPage.fBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[packedBytes]);
+   bufferedPage.fSize = RNTupleCompressor::Zip(source, packedBytes, fOptions.GetCompression(),
+                                               bufferedPage.fBuffer.get());
+   UpdatePageSizeStats(columnHandle.fId, bufferedPage.fNElements, bufferedPage.fSize);
+   fBufferedPages.emplace_back(std::move(bufferedPage));
+
+   // The pages only get a location once they are written by the inner sink
+   return RClusterDescriptor::RLocator();
+}
+
+ROOT::Experimental::RClusterDescriptor::RLocator
+ROOT::Experimental::Detail::RPageSinkBuf::CommitClusterImpl(NTupleSize_t nEntries)
+{
+   {
+      std::lock_guard<std::mutex> guard(fInnerLock);
+      for (const auto &bufferedPage : fBufferedPages) {
+         fInnerSink.CommitSealedPage(bufferedPage.fColumnId,
+            RSealedPage(bufferedPage.fBuffer.get(), bufferedPage.fSize, bufferedPage.fNElements));
+      }
+      // The statistics of the buffered pages are computed by this sink
+      for (const auto &columnRange : fOpenColumnRanges)
+         fInnerSink.SetColumnStatistics(columnRange.fColumnId, columnRange);
+      fInnerSink.CommitCluster(fInnerSink.GetNEntries() + (nEntries - fPrevClusterNEntries));
+   }
+   fBufferedPages.clear();
+   return RClusterDescriptor::RLocator();
+}
+
+void ROOT::Experimental::Detail::RPageSinkBuf::CommitDatasetImpl()
+{
+   // The owner of the inner sink commits the data set
+}
+
+ROOT::Experimental::Detail::RPage
+ROOT::Experimental::Detail::RPageSinkBuf::ReservePage(ColumnHandle_t columnHandle, std::size_t nElements)
+{
+   if (nElements == 0)
+      nElements = GetNElementsPerPage(columnHandle);
+   auto elementSize = columnHandle.fColumn->GetElement()->GetSize();
+   return fPageAllocator->NewPage(columnHandle.fId, elementSize, nElements);
+}
+
+void ROOT::Experimental::Detail::RPageSinkBuf::ReleasePage(RPage &page)
+{
+   fPageAllocator->DeletePage(page);
+}
@@ -15,17 +15,23 @@
 
 #include <ROOT/RPageStorage.hxx>
 #include <ROOT/RPageStorageFile.hxx>
+#include <ROOT/RCluster.hxx>
 #include <ROOT/RColumn.hxx>
 #include <ROOT/RField.hxx>
 #include <ROOT/RNTupleMetrics.hxx>
 #include <ROOT/RNTupleModel.hxx>
 #include <ROOT/RPagePool.hxx>
 #include <ROOT/RPageStorageFile.hxx>
+#include <ROOT/RError.hxx>
 #include <ROOT/RStringView.hxx>
 
 #include <Compression.h>
 #include <TError.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
 #include <unordered_map>
 #include <utility>
 
@@ -94,6 +100,21 @@ ROOT::Experimental::ColumnId_t ROOT::Experimental::Detail::RPageSource::GetColum
    return columnHandle.fId;
 }
 
+std::vector<std::unique_ptr<ROOT::Experimental::Detail::RCluster>>
+ROOT::Experimental::Detail::RPageSource::LoadClusters(const std::vector<RClusterKey> &clusterKeys)
+{
+   std::vector<std::unique_ptr<RCluster>> clusters;
+   for (const auto &key : clusterKeys)
+      clusters.emplace_back(LoadCluster(key.fClusterId, key.fColumns));
+   return clusters;
+}
+
+void ROOT::Experimental::Detail::RPageSource::LoadSealedPage(DescriptorId_t /* columnId */,
+   const RClusterIndex & /* clusterIndex */, RSealedPage & /* sealedPage */)
+{
+   throw RException(R__FAIL("this page source does not support loading sealed pages"));
+}
+
 
 //------------------------------------------------------------------------------
 
@@ -113,15 +134,88 @@ std::unique_ptr<ROOT::Experimental::Detail::RPageSink> ROOT::Experimental::Detai
    return std::make_unique<RPageSinkFile>(ntupleName, location, options);
 }
 
+namespace {
+
+/// Fold the elements of a page, of in-memory type T, into the minimum and maximum of the column range
+template <typename T>
+void UpdateStatistics(const ROOT::Experimental::Detail::RPage &page,
+                      ROOT::Experimental::RClusterDescriptor::RColumnRange &columnRange)
+{
+   const auto values = reinterpret_cast<const T *>(page.GetBuffer());
+   const auto nElements = page.GetNElements();
+   for (std::size_t i = 0; i < nElements; ++i) {
+      const double value = values[i];
+      // NaN never satisfies a comparison, hence it does not need to be accounted for
+      if (std::isnan(value))
+         continue;
+      if (!columnRange.fHasStatistics) {
+         columnRange.fHasStatistics = true;
+         columnRange.fMin = columnRange.fMax = value;
+      } else if (value < columnRange.fMin) {
+         columnRange.fMin = value;
+      } else if (value > columnRange.fMax) {
+         columnRange.fMax = value;
+      }
+   }
+}
+
+/// The statistics are recorded for the principal column of numeric fields, whose in-memory type is given by the field
+ROOT::Experimental::Detail::RPageSink::StatisticsUpdater_t GetStatisticsUpdater(const std::string &fieldTypeName)
+{
+   if (fieldTypeName == "float")
+      return &UpdateStatistics<float>;
+   if (fieldTypeName == "double")
+      return &UpdateStatistics<double>;
+   if (fieldTypeName == "bool")
+      return &UpdateStatistics<bool>;
+   if (fieldTypeName == "std::uint8_t")
+      return &UpdateStatistics<std::uint8_t>;
+   if (fieldTypeName == "std::int32_t")
+      return &UpdateStatistics<std::int32_t>;
+   if (fieldTypeName == "std::uint32_t")
+      return &UpdateStatistics<std::uint32_t>;
+   if (fieldTypeName == "std::uint64_t")
+      return &UpdateStatistics<std::uint64_t>;
+   return nullptr;
+}
+
+} // anonymous namespace
+
 ROOT::Experimental::Detail::RPageStorage::ColumnHandle_t
 ROOT::Experimental::Detail::RPageSink::AddColumn(DescriptorId_t fieldId, const RColumn &column)
 {
    auto columnId = fLastColumnId++;
    fDescriptorBuilder.AddColumn(columnId, fieldId, column.GetVersion(), column.GetModel(), column.GetIndex());
+   StatisticsUpdater_t updater = nullptr;
+   if (fOptions.GetClusterStatistics() && column.GetIndex() == 0)
+      updater = GetStatisticsUpdater(fDescriptorBuilder.GetDescriptor().GetFieldDescriptor(fieldId).GetTypeName());
+   fStatisticsUpdaters.emplace_back(updater);
+   fHasSealedPages.emplace_back(false);
+   fPageSizeStats.emplace_back();
    return ColumnHandle_t{columnId, &column};
 }
 
 
+std::size_t ROOT::Experimental::Detail::RPageSink::GetNElementsPerPage(ColumnHandle_t columnHandle) const
+{
+   const auto targetSize = fOptions.GetApproxZippedPageSize();
+   if (targetSize == 0)
+      return RPageSinkFile::kDefaultElementsPerPage;
+
+   // Until the first page of the column is written, assume that it does not compress
+   const auto &stats = fPageSizeStats[columnHandle.fId];
+   const double bytesPerElement = (stats.fNElements > 0 && stats.fZippedBytes > 0)
+                                     ? double(stats.fZippedBytes) / stats.fNElements
+                                     : columnHandle.fColumn->GetElement()->GetBitsOnStorage() / 8.;
+   const double nElements = targetSize / std::max(bytesPerElement, 1. / 8.);
+   if (nElements <= fOptions.GetMinElementsPerPage())
+      return fOptions.GetMinElementsPerPage();
+   if (nElements >= fOptions.GetMaxElementsPerPage())
+      return fOptions.GetMaxElementsPerPage();
+   return static_cast<std::size_t>(nElements);
+}
+
+
 void ROOT::Experimental::Detail::RPageSink::Create(RNTupleModel &model)
 {
    fDescriptorBuilder.SetNTuple(fNTupleName, model.GetDescription(), "undefined author",
@@ -164,6 +258,8 @@ void ROOT::Experimental::Detail::RPageSink::CommitPage(ColumnHandle_t columnHand
 
    auto columnId = columnHandle.fId;
    fOpenColumnRanges[columnId].fNElements += page.GetNElements();
+   if (fStatisticsUpdaters[columnId] && !fHasSealedPages[columnId])
+      fStatisticsUpdaters[columnId](page, fOpenColumnRanges[columnId]);
    RClusterDescriptor::RPageRange::RPageInfo pageInfo;
    pageInfo.fNElements = page.GetNElements();
    pageInfo.fLocator = locator;
@@ -171,6 +267,38 @@ void ROOT::Experimental::Detail::RPageSink::CommitPage(ColumnHandle_t columnHand
 }
 
 
+ROOT::Experimental::RClusterDescriptor::RLocator
+ROOT::Experimental::Detail::RPageSink::CommitSealedPageImpl(DescriptorId_t /* columnId */,
+                                                           const RSealedPage & /* sealedPage */)
+{
+   throw RException(R__FAIL("this page sink does not support committing sealed pages"));
+}
+
+
+void ROOT::Experimental::Detail::RPageSink::CommitSealedPage(DescriptorId_t columnId, const RSealedPage &sealedPage)
+{
+   auto locator = CommitSealedPageImpl(columnId, sealedPage);
+
+   fOpenColumnRanges[columnId].fNElements += sealedPage.fNElements;
+   fHasSealedPages[columnId] = true;
+   fOpenColumnRanges[columnId].fHasStatistics = false;
+   RClusterDescriptor::RPageRange::RPageInfo pageInfo;
+   pageInfo.fNElements = sealedPage.fNElements;
+   pageInfo.fLocator = locator;
+   fOpenPageRanges[columnId].fPageInfos.emplace_back(pageInfo);
+}
+
+
+void ROOT::Experimental::Detail::RPageSink::SetColumnStatistics(DescriptorId_t columnId,
+                                                               const RClusterDescriptor::RColumnRange &statistics)
+{
+   auto &columnRange = fOpenColumnRanges[columnId];
+   columnRange.fHasStatistics = statistics.fHasStatistics;
+   columnRange.fMin = statistics.fMin;
+   columnRange.fMax = statistics.fMax;
+}
+
+
 void ROOT::Experimental::Detail::RPageSink::CommitCluster(ROOT::Experimental::NTupleSize_t nEntries)
 {
    auto locator = CommitClusterImpl(nEntries);
@@ -183,7 +311,9 @@ void ROOT::Experimental::Detail::RPageSink::CommitCluster(ROOT::Experimental::NT
       fDescriptorBuilder.AddClusterColumnRange(fLastClusterId, range);
       range.fFirstElementIndex += range.fNElements;
       range.fNElements = 0;
+      range.fHasStatistics = false;
    }
+   std::fill(fHasSealedPages.begin(), fHasSealedPages.end(), false);
    for (auto &range : fOpenPageRanges) {
       RClusterDescriptor::RPageRange fullRange;
       std::swap(fullRange, range);
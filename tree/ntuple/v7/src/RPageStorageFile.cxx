@@ -15,8 +15,10 @@
 
 #include <ROOT/RCluster.hxx>
 #include <ROOT/RClusterPool.hxx>
+#include <ROOT/RColumnElement.hxx>
 #include <ROOT/RField.hxx>
 #include <ROOT/RLogger.hxx>
+#include <ROOT/RMemoryAccounting.hxx>
 #include <ROOT/RNTupleDescriptor.hxx>
 #include <ROOT/RNTupleModel.hxx>
 #include <ROOT/RNTupleZip.hxx>
@@ -25,11 +27,14 @@
 #include <ROOT/RPagePool.hxx>
 #include <ROOT/RPageStorageFile.hxx>
 #include <ROOT/RRawFile.hxx>
+#include <ROOT/TTaskGroup.hxx>
 
 #include <RVersion.h>
 #include <TError.h>
+#include <TROOT.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
@@ -47,6 +52,7 @@ ROOT::Experimental::Detail::RPageSinkFile::RPageSinkFile(std::string_view ntuple
 
    fWriter = std::unique_ptr<Internal::RNTupleFileWriter>(Internal::RNTupleFileWriter::Recreate(
       ntupleName, path, options.GetCompression(), options.GetContainerFormat()));
+   InitImplicitMT();
 }
 
 
@@ -60,6 +66,7 @@ ROOT::Experimental::Detail::RPageSinkFile::RPageSinkFile(std::string_view ntuple
       "Do not store real data with this version of RNTuple!";
 
    fWriter = std::unique_ptr<Internal::RNTupleFileWriter>(Internal::RNTupleFileWriter::Append(ntupleName, file));
+   InitImplicitMT();
 }
 
 
@@ -73,11 +80,90 @@ ROOT::Experimental::Detail::RPageSinkFile::RPageSinkFile(std::string_view ntuple
       "Do not store real data with this version of RNTuple!";
    fWriter = std::unique_ptr<Internal::RNTupleFileWriter>(
       Internal::RNTupleFileWriter::Recreate(ntupleName, path, file));
+   InitImplicitMT();
 }
 
 
 ROOT::Experimental::Detail::RPageSinkFile::~RPageSinkFile()
 {
+#ifdef R__USE_IMT
+   // Pages of an uncommitted cluster are dropped but the tasks must not outlive their buffers
+   if (fTaskGroup)
+      fTaskGroup->Wait();
+#endif
+}
+
+
+void ROOT::Experimental::Detail::RPageSinkFile::InitImplicitMT()
+{
+#ifdef R__USE_IMT
+   if (fOptions.GetUseImplicitMT() == EImplicitMT::kOff || !ROOT::IsImplicitMTEnabled())
+      return;
+   // Without compression, there is nothing the tasks could do that is more expensive than the memory copy
+   if ((fOptions.GetCompression() % 100) == 0)
+      return;
+   fTaskGroup = std::make_unique<TTaskGroup>();
+#endif
+}
+
+
+void ROOT::Experimental::Detail::RPageSinkFile::ScheduleCompression(ColumnHandle_t columnHandle, const RPage &page)
+{
+#ifdef R__USE_IMT
+   auto element = columnHandle.fColumn->GetElement();
+
+   fPendingPages.emplace_back();
+   auto &pendingPage = fPendingPages.back();
+   pendingPage.fColumnId = columnHandle.fId;
+   pendingPage.fPageIndex = fOpenPageRanges[columnHandle.fId].fPageInfos.size();
+   // The page buffer is reused by the column as soon as we return, so we always need a copy
+   if (element->IsMappable()) {
+      pendingPage.fPackedBytes = page.GetSize();
+      pendingPage.fPackedBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[pendingPage.fPackedBytes]);
+      memcpy(pendingPage.fPackedBuffer.get(), page.GetBuffer(), pendingPage.fPackedBytes);
+   } else {
+      pendingPage.fPackedBytes = (page.GetNElements() * element->GetBitsOnStorage() + 7) / 8;
+      pendingPage.fPackedBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[pendingPage.fPackedBytes]);
+      element->Pack(pendingPage.fPackedBuffer.get(), page.GetBuffer(), page.GetNElements());
+   }
+
+   auto compression = fOptions.GetCompression();
+   fTaskGroup->Run([&pendingPage, compression]() {
+      pendingPage.fZipBuffer = std::unique_ptr<unsigned char[]>(new unsigned char[pendingPage.fPackedBytes]);
+      pendingPage.fZippedBytes = RNTupleCompressor::Zip(pendingPage.fPackedBuffer.get(), pendingPage.fPackedBytes,
+                                                        compression, pendingPage.fZipBuffer.get());
+      if (pendingPage.fZippedBytes == pendingPage.fPackedBytes) {
+         // Uncompressible page, write the packed buffer as is
+         pendingPage.fZipBuffer.reset();
+      } else {
+         pendingPage.fPackedBuffer.reset();
+      }
+   });
+#else
+   (void)columnHandle;
+   (void)page;
+#endif
+}
+
+
+void ROOT::Experimental::Detail::RPageSinkFile::WritePendingPages()
+{
+#ifdef R__USE_IMT
+   fTaskGroup->Wait();
+   for (auto &pendingPage : fPendingPages) {
+      const unsigned char *buffer = pendingPage.fZipBuffer ? pendingPage.fZipBuffer.get()
+                                                           : pendingPage.fPackedBuffer.get();
+      auto offsetData = fWriter->WriteBlob(buffer, pendingPage.fZippedBytes, pendingPage.fPackedBytes);
+      fClusterMinOffset = std::min(offsetData, fClusterMinOffset);
+      fClusterMaxOffset = std::max(offsetData + pendingPage.fZippedBytes, fClusterMaxOffset);
+
+      auto &pageInfo = fOpenPageRanges[pendingPage.fColumnId].fPageInfos[pendingPage.fPageIndex];
+      pageInfo.fLocator.fPosition = offsetData;
+      pageInfo.fLocator.fBytesOnStorage = pendingPage.fZippedBytes;
+      UpdatePageSizeStats(pendingPage.fColumnId, pageInfo.fNElements, pendingPage.fZippedBytes);
+   }
+   fPendingPages.clear();
+#endif
 }
 
 
@@ -98,6 +184,12 @@ void ROOT::Experimental::Detail::RPageSinkFile::CreateImpl(const RNTupleModel &
 ROOT::Experimental::RClusterDescriptor::RLocator
 ROOT::Experimental::Detail::RPageSinkFile::CommitPageImpl(ColumnHandle_t columnHandle, const RPage &page)
 {
+   if (fTaskGroup) {
+      ScheduleCompression(columnHandle, page);
+      // The final locator is set when the cluster is committed
+      return RClusterDescriptor::RLocator();
+   }
+
    unsigned char *buffer = reinterpret_cast<unsigned char *>(page.GetBuffer());
    bool isAdoptedBuffer = true;
    auto packedBytes = page.GetSize();
@@ -123,6 +215,7 @@ ROOT::Experimental::Detail::RPageSinkFile::CommitPageImpl(ColumnHandle_t columnH
    auto offsetData = fWriter->WriteBlob(buffer, zippedBytes, packedBytes);
    fClusterMinOffset = std::min(offsetData, fClusterMinOffset);
    fClusterMaxOffset = std::max(offsetData + zippedBytes, fClusterMaxOffset);
+   UpdatePageSizeStats(columnHandle.fId, page.GetNElements(), zippedBytes);
 
    if (!isAdoptedBuffer)
       delete[] buffer;
@@ -134,9 +227,30 @@ ROOT::Experimental::Detail::RPageSinkFile::CommitPageImpl(ColumnHandle_t columnH
 }
 
 
+ROOT::Experimental::RClusterDescriptor::RLocator
+ROOT::Experimental::Detail::RPageSinkFile::CommitSealedPageImpl(DescriptorId_t columnId, const RSealedPage &sealedPage)
+{
+   const auto &columnDesc = fDescriptorBuilder.GetDescriptor().GetColumnDescriptor(columnId);
+   const auto bitsOnStorage = RColumnElementBase::GetBitsOnStorage(columnDesc.GetModel().GetType());
+   const auto packedBytes = (bitsOnStorage * sealedPage.fNElements + 7) / 8;
+
+   auto offsetData = fWriter->WriteBlob(sealedPage.fBuffer, sealedPage.fSize, packedBytes);
+   fClusterMinOffset = std::min(offsetData, fClusterMinOffset);
+   fClusterMaxOffset = std::max(offsetData + sealedPage.fSize, fClusterMaxOffset);
+
+   RClusterDescriptor::RLocator result;
+   result.fPosition = offsetData;
+   result.fBytesOnStorage = sealedPage.fSize;
+   return result;
+}
+
+
 ROOT::Experimental::RClusterDescriptor::RLocator
 ROOT::Experimental::Detail::RPageSinkFile::CommitClusterImpl(ROOT::Experimental::NTupleSize_t /* nEntries */)
 {
+   if (fTaskGroup)
+      WritePendingPages();
+
    RClusterDescriptor::RLocator result;
    result.fPosition = fClusterMinOffset;
    result.fBytesOnStorage = fClusterMaxOffset - fClusterMinOffset;
@@ -165,7 +279,7 @@ ROOT::Experimental::Detail::RPage
 ROOT::Experimental::Detail::RPageSinkFile::ReservePage(ColumnHandle_t columnHandle, std::size_t nElements)
 {
    if (nElements == 0)
-      nElements = kDefaultElementsPerPage;
+      nElements = GetNElementsPerPage(columnHandle);
    auto elementSize = columnHandle.fColumn->GetElement()->GetSize();
    return fPageAllocator->NewPage(columnHandle.fId, elementSize, nElements);
 }
@@ -191,6 +305,7 @@ void ROOT::Experimental::Detail::RPageAllocatorFile::DeletePage(const RPage& pag
 {
    if (page.IsNull())
       return;
+   RMemoryAccounting::Add(RMemoryAccounting::ESubsystem::kPagePools, -std::int64_t(page.GetCapacity()));
    delete[] reinterpret_cast<unsigned char *>(page.GetBuffer());
 }
 
@@ -203,25 +318,36 @@ ROOT::Experimental::Detail::RPageSourceFile::RPageSourceFile(std::string_view nt
    : RPageSource(ntupleName, options)
    , fMetrics("RPageSourceFile")
    , fPageAllocator(std::make_unique<RPageAllocatorFile>())
-   , fPagePool(std::make_shared<RPagePool>())
-   , fClusterPool(std::make_unique<RClusterPool>(*this))
+   , fPagePool(std::make_shared<RPagePool>(options.GetPagePoolMaxBytes()))
+   , fClusterPool(std::make_unique<RClusterPool>(*this, options.GetClusterPoolSize(), options.GetMaxReadAheadBytes()))
 {
    fCounters = std::unique_ptr<RCounters>(new RCounters{
       *fMetrics.MakeCounter<RNTupleAtomicCounter*>("nReadV", "", "number of vector read requests"),
       *fMetrics.MakeCounter<RNTupleAtomicCounter*>("nRead", "", "number of byte ranges read"),
       *fMetrics.MakeCounter<RNTupleAtomicCounter*>("szReadPayload", "B", "volume read from file (required)"),
       *fMetrics.MakeCounter<RNTupleAtomicCounter*>("szReadOverhead", "B", "volume read from file (overhead)"),
-      *fMetrics.MakeCounter<RNTuplePlainCounter*> ("szUnzip", "B", "volume after unzipping"),
+      *fMetrics.MakeCounter<RNTupleAtomicCounter*>("szUnzip", "B", "volume after unzipping"),
       *fMetrics.MakeCounter<RNTupleAtomicCounter*>("nClusterLoaded", "",
                                                    "number of partial clusters preloaded from storage"),
       *fMetrics.MakeCounter<RNTuplePlainCounter*> ("nPageLoaded", "", "number of pages loaded from storage"),
       *fMetrics.MakeCounter<RNTuplePlainCounter*> ("nPagePopulated", "", "number of populated pages"),
+      *fMetrics.MakeCounter<RNTuplePlainCounter*> ("nPageMapped", "", "number of pages served from the file mapping"),
       *fMetrics.MakeCounter<RNTupleAtomicCounter*>("timeWallRead", "ns", "wall clock time spent reading"),
-      *fMetrics.MakeCounter<RNTuplePlainCounter*> ("timeWallUnzip", "ns", "wall clock time spent decompressing"),
+      *fMetrics.MakeCounter<RNTupleAtomicCounter*>("timeWallUnzip", "ns", "wall clock time spent decompressing"),
       *fMetrics.MakeCounter<RNTupleTickCounter<RNTupleAtomicCounter>*>("timeCpuRead", "ns", "CPU time spent reading"),
-      *fMetrics.MakeCounter<RNTupleTickCounter<RNTuplePlainCounter>*> ("timeCpuUnzip", "ns",
+      *fMetrics.MakeCounter<RNTupleTickCounter<RNTupleAtomicCounter>*>("timeCpuUnzip", "ns",
                                                                        "CPU time spent decompressing")
    });
+
+   fMetrics.ObserveMetrics(fPagePool->GetMetrics());
+
+#ifdef R__USE_IMT
+   if ((options.GetUseImplicitMT() == EImplicitMT::kDefault) && ROOT::IsImplicitMTEnabled() &&
+       (options.GetClusterCache() != RNTupleReadOptions::EClusterCache::kOff))
+   {
+      fTaskGroup = std::make_unique<TTaskGroup>();
+   }
+#endif
 }
 
 
@@ -232,11 +358,44 @@ ROOT::Experimental::Detail::RPageSourceFile::RPageSourceFile(std::string_view nt
    fFile = ROOT::Internal::RRawFile::Create(path);
    R__ASSERT(fFile);
    fReader = Internal::RMiniFileReader(fFile.get());
+   InitMmap();
 }
 
 
 ROOT::Experimental::Detail::RPageSourceFile::~RPageSourceFile()
 {
+   if (fMmapRegion)
+      fFile->Unmap(fMmapRegion, fMmapSize);
+}
+
+
+void ROOT::Experimental::Detail::RPageSourceFile::InitMmap()
+{
+   if (!fOptions.GetUseMmap() || !(fFile->GetFeatures() & ROOT::Internal::RRawFile::kFeatureHasMmap))
+      return;
+   if (!(fFile->GetFeatures() & ROOT::Internal::RRawFile::kFeatureHasSize))
+      return;
+   fMmapSize = fFile->GetSize();
+   if (fMmapSize == 0)
+      return;
+   std::uint64_t mapdOffset;
+   fMmapRegion = fFile->Map(fMmapSize, 0, mapdOffset);
+   R__ASSERT(mapdOffset == 0);
+}
+
+
+ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::MapPage(
+   ColumnId_t columnId, const RClusterDescriptor::RPageRange::RPageInfo &pageInfo, std::size_t elementSize)
+{
+   const auto &locator = pageInfo.fLocator;
+   if (locator.fPosition + locator.fBytesOnStorage > fMmapSize)
+      return RPage();
+   auto address = static_cast<unsigned char *>(fMmapRegion) + locator.fPosition;
+   // Unaligned pages are copied as usual
+   if (reinterpret_cast<std::uintptr_t>(address) % elementSize != 0)
+      return RPage();
+   fCounters->fNPageMapped.Inc();
+   return fPageAllocator->NewPage(columnId, address, elementSize, pageInfo.fNElements);
 }
 
 
@@ -295,8 +454,21 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
    const auto bytesOnStorage = pageInfo.fLocator.fBytesOnStorage;
    const auto bytesPacked = (element->GetBitsOnStorage() * pageInfo.fNElements + 7) / 8;
    const auto pageSize = elementSize * pageInfo.fNElements;
+   const auto indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex;
+
+   // Uncompressed pages of mappable columns can be used in place
+   if (fMmapRegion && element->IsMappable() && (bytesOnStorage == pageSize)) {
+      auto mappedPage = MapPage(columnId, pageInfo, elementSize);
+      if (!mappedPage.IsNull()) {
+         mappedPage.SetWindow(indexOffset + firstInPage, RPage::RClusterInfo(clusterId, indexOffset));
+         // The memory belongs to the file mapping, which is released by the page source destructor
+         fPagePool->RegisterPage(mappedPage, RPageDeleter([](const RPage & /*page*/, void * /*userData*/) {}));
+         return mappedPage;
+      }
+   }
 
    auto pageBuffer = new unsigned char[bytesPacked];
+   bool isUnzipped = false;
    if (fOptions.GetClusterCache() == RNTupleReadOptions::EClusterCache::kOff) {
       fReader.ReadBuffer(pageBuffer, bytesOnStorage, pageInfo.fLocator.fPosition);
       fCounters->fNPageLoaded.Inc();
@@ -307,12 +479,15 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
       ROnDiskPage::Key key(columnId, pageNo);
       auto onDiskPage = fCurrentCluster->GetOnDiskPage(key);
       R__ASSERT(onDiskPage);
-      R__ASSERT(bytesOnStorage == onDiskPage->GetSize());
+      // The page might have been decompressed already by UnzipCluster()
+      R__ASSERT((bytesOnStorage == onDiskPage->GetSize()) || (bytesPacked == onDiskPage->GetSize()));
       memcpy(pageBuffer, onDiskPage->GetAddress(), onDiskPage->GetSize());
+      if (onDiskPage->GetSize() != bytesOnStorage)
+         isUnzipped = true;
    }
 
-   if (bytesOnStorage != bytesPacked) {
-      RNTuplePlainTimer timer(fCounters->fTimeWallUnzip, fCounters->fTimeCpuUnzip);
+   if (!isUnzipped && (bytesOnStorage != bytesPacked)) {
+      RNTupleAtomicTimer timer(fCounters->fTimeWallUnzip, fCounters->fTimeCpuUnzip);
       fDecompressor(pageBuffer, bytesOnStorage, bytesPacked);
       fCounters->fSzUnzip.Add(bytesPacked);
    }
@@ -324,8 +499,9 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
       pageBuffer = unpackedBuffer;
    }
 
-   const auto indexOffset = clusterDescriptor.GetColumnRange(columnId).fFirstElementIndex;
    auto newPage = fPageAllocator->NewPage(columnId, pageBuffer, elementSize, pageInfo.fNElements);
+   // The page buffer is owned by the page pool from now on and released by RPageAllocatorFile::DeletePage()
+   RMemoryAccounting::Add(RMemoryAccounting::ESubsystem::kPagePools, newPage.GetCapacity());
    newPage.SetWindow(indexOffset + firstInPage, RPage::RClusterInfo(clusterId, indexOffset));
    fPagePool->RegisterPage(newPage,
       RPageDeleter([](const RPage &page, void * /*userData*/)
@@ -368,6 +544,35 @@ ROOT::Experimental::Detail::RPage ROOT::Experimental::Detail::RPageSourceFile::P
    return PopulatePageFromCluster(columnHandle, clusterDescriptor, index);
 }
 
+void ROOT::Experimental::Detail::RPageSourceFile::LoadSealedPage(
+   DescriptorId_t columnId, const RClusterIndex &clusterIndex, RSealedPage &sealedPage)
+{
+   const auto clusterId = clusterIndex.GetClusterId();
+   const auto index = clusterIndex.GetIndex();
+   const auto &clusterDescriptor = fDescriptor.GetClusterDescriptor(clusterId);
+   const auto &pageRange = clusterDescriptor.GetPageRange(columnId);
+
+   // TODO(jblomer): binary search
+   RClusterDescriptor::RPageRange::RPageInfo pageInfo;
+   ClusterSize_t::ValueType firstInPage = 0;
+   for (const auto &pi : pageRange.fPageInfos) {
+      if (firstInPage + pi.fNElements > index) {
+         pageInfo = pi;
+         break;
+      }
+      firstInPage += pi.fNElements;
+   }
+   R__ASSERT(firstInPage <= index);
+   R__ASSERT((firstInPage + pageInfo.fNElements) > index);
+
+   sealedPage.fSize = pageInfo.fLocator.fBytesOnStorage;
+   sealedPage.fNElements = pageInfo.fNElements;
+   if (sealedPage.fBuffer) {
+      fReader.ReadBuffer(const_cast<void *>(sealedPage.fBuffer), sealedPage.fSize, pageInfo.fLocator.fPosition);
+      fCounters->fNPageLoaded.Inc();
+   }
+}
+
 void ROOT::Experimental::Detail::RPageSourceFile::ReleasePage(RPage &page)
 {
    fPagePool->ReturnPage(page);
@@ -378,11 +583,13 @@ std::unique_ptr<ROOT::Experimental::Detail::RPageSource> ROOT::Experimental::Det
    auto clone = new RPageSourceFile(fNTupleName, fOptions);
    clone->fFile = fFile->Clone();
    clone->fReader = Internal::RMiniFileReader(clone->fFile.get());
+   clone->InitMmap();
    return std::unique_ptr<RPageSourceFile>(clone);
 }
 
 std::unique_ptr<ROOT::Experimental::Detail::RCluster>
-ROOT::Experimental::Detail::RPageSourceFile::LoadCluster(DescriptorId_t clusterId, const ColumnSet_t &columns)
+ROOT::Experimental::Detail::RPageSourceFile::PrepareSingleCluster(
+   DescriptorId_t clusterId, const ColumnSet_t &columns, std::vector<ROOT::Internal::RRawFile::RIOVec> &readRequests)
 {
    fCounters->fNClusterLoaded.Inc();
 
@@ -451,7 +658,7 @@ ROOT::Experimental::Detail::RPageSourceFile::LoadCluster(DescriptorId_t clusterI
       std::uint64_t fOffset = 0;
       std::uint64_t fSize = 0;
    };
-   std::vector<ROOT::Internal::RRawFile::RIOVec> readRequests;
+   const auto nReqsBefore = readRequests.size();
 
    ROOT::Internal::RRawFile::RIOVec req;
    std::size_t szPayload = 0;
@@ -491,11 +698,40 @@ ROOT::Experimental::Detail::RPageSourceFile::LoadCluster(DescriptorId_t clusterI
       pageMap->Register(key, ROnDiskPage(buffer + s.fBufPos, s.fSize));
    }
    fCounters->fNPageLoaded.Add(onDiskPages.size());
-   for (auto &r : readRequests) {
-      r.fBuffer = buffer + reinterpret_cast<intptr_t>(r.fBuffer);
+   for (auto i = nReqsBefore; i < readRequests.size(); ++i) {
+      readRequests[i].fBuffer = buffer + reinterpret_cast<intptr_t>(readRequests[i].fBuffer);
    }
 
+   auto cluster = std::make_unique<RCluster>(clusterId);
+   cluster->Adopt(std::move(pageMap));
+   for (auto colId : columns)
+      cluster->SetColumnAvailable(colId);
+   return cluster;
+}
+
+
+
+std::unique_ptr<ROOT::Experimental::Detail::RCluster>
+ROOT::Experimental::Detail::RPageSourceFile::LoadCluster(DescriptorId_t clusterId, const ColumnSet_t &columns)
+{
+   std::vector<RClusterKey> clusterKeys{RClusterKey{clusterId, columns}};
+   return std::move(LoadClusters(clusterKeys)[0]);
+}
+
+
+std::vector<std::unique_ptr<ROOT::Experimental::Detail::RCluster>>
+ROOT::Experimental::Detail::RPageSourceFile::LoadClusters(const std::vector<RClusterKey> &clusterKeys)
+{
+   // The read requests of all the clusters are issued as a single vector read, which saves round trips
+   // for remote files
+   std::vector<std::unique_ptr<RCluster>> clusters;
+   std::vector<ROOT::Internal::RRawFile::RIOVec> readRequests;
+   for (const auto &key : clusterKeys)
+      clusters.emplace_back(PrepareSingleCluster(key.fClusterId, key.fColumns, readRequests));
+
    auto nReqs = readRequests.size();
+   if (nReqs == 0)
+      return clusters;
    {
       RNTupleAtomicTimer timer(fCounters->fTimeWallRead, fCounters->fTimeCpuRead);
       fFile->ReadV(&readRequests[0], nReqs);
@@ -503,9 +739,72 @@ ROOT::Experimental::Detail::RPageSourceFile::LoadCluster(DescriptorId_t clusterI
    fCounters->fNReadV.Inc();
    fCounters->fNRead.Add(nReqs);
 
-   auto cluster = std::make_unique<RCluster>(clusterId);
-   cluster->Adopt(std::move(pageMap));
-   for (auto colId : columns)
-      cluster->SetColumnAvailable(colId);
-   return cluster;
+   return clusters;
+}
+
+
+void ROOT::Experimental::Detail::RPageSourceFile::UnzipCluster(RCluster *cluster)
+{
+   if (!fTaskGroup)
+      return;
+
+   const auto clusterId = cluster->GetId();
+   const auto &clusterDescriptor = fDescriptor.GetClusterDescriptor(clusterId);
+
+   struct RUnzipLocator {
+      RUnzipLocator() = default;
+      RUnzipLocator(DescriptorId_t c, NTupleSize_t p, std::size_t b) : fColumnId(c), fPageNo(p), fBufPos(b) {}
+      DescriptorId_t fColumnId = 0;
+      NTupleSize_t fPageNo = 0;
+      std::size_t fBufPos = 0;
+   };
+
+   // Collect the compressed pages and reserve space for them in a single buffer
+   std::vector<RUnzipLocator> unzipPages;
+   std::size_t szUnzipBuffer = 0;
+   for (auto columnId : cluster->GetAvailColumns()) {
+      const auto &columnDesc = fDescriptor.GetColumnDescriptor(columnId);
+      const auto bitsOnStorage = RColumnElementBase::GetBitsOnStorage(columnDesc.GetModel().GetType());
+      const auto &pageRange = clusterDescriptor.GetPageRange(columnId);
+      NTupleSize_t pageNo = 0;
+      for (const auto &pageInfo : pageRange.fPageInfos) {
+         const auto bytesPacked = (bitsOnStorage * pageInfo.fNElements + 7) / 8;
+         if (pageInfo.fLocator.fBytesOnStorage != bytesPacked) {
+            unzipPages.emplace_back(RUnzipLocator(columnId, pageNo, szUnzipBuffer));
+            szUnzipBuffer += bytesPacked;
+         }
+         ++pageNo;
+      }
+   }
+   if (unzipPages.empty())
+      return;
+
+   auto buffer = new unsigned char[szUnzipBuffer];
+   auto pageMap = std::make_unique<ROnDiskPageMapHeap>(std::unique_ptr<unsigned char []>(buffer));
+   std::vector<ROnDiskPage> unzippedPages(unzipPages.size());
+   {
+      RNTupleAtomicTimer timer(fCounters->fTimeWallUnzip, fCounters->fTimeCpuUnzip);
+      for (std::size_t i = 0; i < unzipPages.size(); ++i) {
+         const auto &locator = unzipPages[i];
+         const auto onDiskPage = cluster->GetOnDiskPage(ROnDiskPage::Key(locator.fColumnId, locator.fPageNo));
+         R__ASSERT(onDiskPage);
+         const auto bytesPacked = ((i + 1 < unzipPages.size()) ? unzipPages[i + 1].fBufPos : szUnzipBuffer) -
+                                  locator.fBufPos;
+         unzippedPages[i] = ROnDiskPage(buffer + locator.fBufPos, bytesPacked);
+         fTaskGroup->Run([onDiskPage, bytesPacked, target = buffer + locator.fBufPos]() {
+            RNTupleDecompressor::Unzip(onDiskPage->GetAddress(), onDiskPage->GetSize(), bytesPacked, target);
+         });
+      }
+      fTaskGroup->Wait();
+   }
+   fCounters->fSzUnzip.Add(szUnzipBuffer);
+
+   // The unzipped pages take precedence over the compressed ones; the compressed pages need to stay in the cluster
+   // as long as the cluster contains uncompressed pages from the same memory region
+   for (std::size_t i = 0; i < unzipPages.size(); ++i)
+      pageMap->Register(ROnDiskPage::Key(unzipPages[i].fColumnId, unzipPages[i].fPageNo), unzippedPages[i]);
+   RCluster unzippedCluster(clusterId);
+   unzippedCluster.Adopt(std::move(pageMap));
+   unzippedCluster.Adopt(std::move(*cluster));
+   *cluster = std::move(unzippedCluster);
 }
@@ -0,0 +1,81 @@
+#include <ROOT/RNTuple.hxx>
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleOptions.hxx>
+
+#include "Compression.h"
+#include "TRandom3.h"
+
+#include "benchmark/benchmark.h"
+
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+using RNTupleModel = ROOT::Experimental::RNTupleModel;
+using RNTupleReader = ROOT::Experimental::RNTupleReader;
+using RNTupleWriteOptions = ROOT::Experimental::RNTupleWriteOptions;
+using RNTupleWriter = ROOT::Experimental::RNTupleWriter;
+
+// Fixed dataset: 100000 entries of a float and a vector of on average 10 floats, generated with a fixed seed
+static constexpr int kNEntries = 100000;
+
+static void WriteNTuple(const std::string &fileName, int compression)
+{
+   auto model = RNTupleModel::Create();
+   auto pt = model->MakeField<float>("pt");
+   auto hits = model->MakeField<std::vector<float>>("hits");
+   RNTupleWriteOptions options;
+   options.SetCompression(compression);
+   auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntpl", fileName, options);
+   TRandom3 rnd(42);
+   for (int i = 0; i < kNEntries; ++i) {
+      *pt = rnd.Exp(20);
+      hits->resize(rnd.Poisson(10));
+      for (auto &h : *hits)
+         h = rnd.Gaus(0, 1);
+      ntuple->Fill();
+   }
+}
+
+static void BM_RNTuple_Write(benchmark::State &state)
+{
+   const std::string fileName = "ntuple_benchmarks_write.root";
+   for (auto _ : state)
+      WriteNTuple(fileName, state.range(0));
+   state.SetItemsProcessed(state.iterations() * kNEntries);
+}
+BENCHMARK(BM_RNTuple_Write)
+   ->Arg(0)
+   ->Arg(ROOT::RCompressionSetting::EDefaults::kUseAnalysis)
+   ->Arg(ROOT::RCompressionSetting::EDefaults::kUseGeneralPurpose)
+   ->Unit(benchmark::kMillisecond);
+
+static void BM_RNTuple_Read(benchmark::State &state)
+{
+   // The benchmark function is called several times, the file of each compression setting is written once
+   static std::set<int> created;
+   const int compression = state.range(0);
+   const std::string fileName = "ntuple_benchmarks_read_" + std::to_string(compression) + ".root";
+   if (created.insert(compression).second)
+      WriteNTuple(fileName, compression);
+
+   for (auto _ : state) {
+      auto ntuple = RNTupleReader::Open("ntpl", fileName);
+      auto viewPt = ntuple->GetView<float>("pt");
+      auto viewHits = ntuple->GetView<std::vector<float>>("hits");
+      double sum = 0;
+      for (auto i : ntuple->GetEntryRange()) {
+         sum += viewPt(i);
+         for (auto h : viewHits(i))
+            sum += h;
+      }
+      benchmark::DoNotOptimize(sum);
+   }
+   state.SetItemsProcessed(state.iterations() * kNEntries);
+}
+BENCHMARK(BM_RNTuple_Read)
+   ->Arg(0)
+   ->Arg(ROOT::RCompressionSetting::EDefaults::kUseAnalysis)
+   ->Arg(ROOT::RCompressionSetting::EDefaults::kUseGeneralPurpose)
+   ->Unit(benchmark::kMillisecond);
@@ -63,6 +63,10 @@ public:
       descBuilder.AddCluster(2, RNTupleVersion(), 2, ClusterSize_t(1));
       descBuilder.AddCluster(3, RNTupleVersion(), 3, ClusterSize_t(1));
       descBuilder.AddCluster(4, RNTupleVersion(), 4, ClusterSize_t(1));
+      ROOT::Experimental::RClusterDescriptor::RLocator locator;
+      locator.fBytesOnStorage = 100;
+      for (unsigned int i = 0; i < 5; ++i)
+         descBuilder.SetClusterLocator(i, locator);
       fDescriptor = descBuilder.MoveDescriptor();
    }
    std::unique_ptr<RPageSource> Clone() const final { return nullptr; }
@@ -269,6 +273,20 @@ TEST(ClusterPool, GetClusterBasics)
 }
 
 
+TEST(ClusterPool, ReadAheadBytes)
+{
+   RPageSourceMock p1;
+   {
+      RClusterPool c1(p1, 4, 150);
+      EXPECT_EQ(150U, c1.GetMaxReadAheadBytes());
+      c1.GetCluster(0, {0});
+   }
+   ASSERT_EQ(2U, p1.fReqsClusterIds.size());
+   EXPECT_EQ(0U, p1.fReqsClusterIds[0]);
+   EXPECT_EQ(1U, p1.fReqsClusterIds[1]);
+}
+
+
 TEST(ClusterPool, GetClusterIncrementally)
 {
    RPageSourceMock p1;
@@ -328,3 +346,44 @@ TEST(PageStorageFile, LoadCluster)
    ROnDiskPage::Key key(colId, 0);
    EXPECT_NE(nullptr, cluster->GetOnDiskPage(key));
 }
+
+
+TEST(PageStorageFile, LoadClusters)
+{
+   FileRaii fileGuard("test_ntuple_load_clusters.root");
+
+   auto modelWrite = ROOT::Experimental::RNTupleModel::Create();
+   auto wrPt = modelWrite->MakeField<float>("pt", 42.0);
+
+   {
+      ROOT::Experimental::RNTupleWriter ntuple(
+         std::move(modelWrite), std::make_unique<ROOT::Experimental::Detail::RPageSinkFile>(
+            "myNTuple", fileGuard.GetPath(), ROOT::Experimental::RNTupleWriteOptions()));
+      ntuple.Fill();
+      ntuple.CommitCluster();
+      *wrPt = 24.0;
+      ntuple.Fill();
+   }
+
+   ROOT::Experimental::Detail::RPageSourceFile source(
+      "myNTuple", fileGuard.GetPath(), ROOT::Experimental::RNTupleReadOptions());
+   source.Attach();
+   source.GetMetrics().Enable();
+
+   auto ptId = source.GetDescriptor().FindFieldId("pt");
+   auto colId = source.GetDescriptor().FindColumnId(ptId, 0);
+   EXPECT_NE(ROOT::Experimental::kInvalidDescriptorId, colId);
+
+   std::vector<RPageSource::RClusterKey> clusterKeys{{0, {colId}}, {1, {colId}}};
+   auto clusters = source.LoadClusters(clusterKeys);
+   ASSERT_EQ(2U, clusters.size());
+   EXPECT_EQ(0U, clusters[0]->GetId());
+   EXPECT_EQ(1U, clusters[1]->GetId());
+   EXPECT_NE(nullptr, clusters[0]->GetOnDiskPage(ROnDiskPage::Key(colId, 0)));
+   EXPECT_NE(nullptr, clusters[1]->GetOnDiskPage(ROnDiskPage::Key(colId, 0)));
+
+   // Both clusters must have been loaded by a single vector read
+   auto nReadV = source.GetMetrics().GetCounter("RPageSourceFile.nReadV");
+   ASSERT_NE(nullptr, nReadV);
+   EXPECT_EQ(1, nReadV->GetValueAsInt());
+}
@@ -142,3 +142,105 @@ TEST(RNTuple, LargeFile)
    delete f;
 }
 #endif
+
+
+#ifdef R__USE_IMT
+TEST(RNTuple, ImplicitMTCompression)
+{
+   FileRaii fileGuard("test_ntuple_imt_compression.root");
+
+   auto modelWrite = RNTupleModel::Create();
+   auto wrEvent = modelWrite->MakeField<std::uint64_t>("event");
+   auto wrEnergy = modelWrite->MakeField<float>("energy");
+   auto wrTimes = modelWrite->MakeField<std::vector<double>>("times");
+
+   ROOT::EnableImplicitMT();
+   TRandom3 rnd(42);
+   double chksumWrite = 0.0;
+   {
+      auto ntuple = RNTupleWriter::Recreate(std::move(modelWrite), "myNTuple", fileGuard.GetPath());
+      constexpr unsigned int nEvents = 200000;
+      for (unsigned int i = 0; i < nEvents; ++i) {
+         *wrEvent = i;
+         *wrEnergy = rnd.Rndm();
+         wrTimes->resize(i % 10);
+         for (auto &t : *wrTimes) {
+            t = rnd.Rndm();
+            chksumWrite += t;
+         }
+         chksumWrite += double(*wrEvent) + *wrEnergy;
+         ntuple->Fill();
+      }
+   }
+   ROOT::DisableImplicitMT();
+
+   auto ntuple = RNTupleReader::Open("myNTuple", fileGuard.GetPath());
+   EXPECT_GT(ntuple->GetDescriptor().GetNClusters(), 1);
+   auto rdEvent = ntuple->GetView<std::uint64_t>("event");
+   auto rdEnergy = ntuple->GetView<float>("energy");
+   auto rdTimes = ntuple->GetView<std::vector<double>>("times");
+   double chksumRead = 0.0;
+   for (auto i : ntuple->GetEntryRange()) {
+      EXPECT_EQ(i, rdEvent(i));
+      chksumRead += double(rdEvent(i)) + rdEnergy(i);
+      for (auto t : rdTimes(i))
+         chksumRead += t;
+   }
+   EXPECT_EQ(chksumRead, chksumWrite);
+}
+
+TEST(RNTuple, ProcessMT)
+{
+   FileRaii fileGuard("test_ntuple_process_mt.root");
+
+   constexpr unsigned int nEvents = 100000;
+   {
+      auto model = RNTupleModel::Create();
+      auto wrEvent = model->MakeField<std::uint64_t>("event");
+      auto wrTimes = model->MakeField<std::vector<double>>("times");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "myNTuple", fileGuard.GetPath());
+      for (unsigned int i = 0; i < nEvents; ++i) {
+         *wrEvent = i;
+         wrTimes->assign(i % 5, double(i));
+         ntuple->Fill();
+         if (i % 1000 == 999)
+            ntuple->CommitCluster();
+      }
+   }
+
+   auto model = RNTupleModel::Create();
+   model->MakeField<std::uint64_t>("event");
+   auto ntuple = RNTupleReader::Open(std::move(model), "myNTuple", fileGuard.GetPath());
+   EXPECT_EQ(nEvents / 1000, ntuple->GetDescriptor().GetNClusters());
+
+   ROOT::EnableImplicitMT(4);
+   std::mutex mutex;
+   std::vector<bool> seen(nEvents, false);
+   double sumTimes = 0.0;
+   ntuple->ProcessMT([&](RNTupleReader &reader, ROOT::Experimental::RNTupleGlobalRange range) {
+      auto event = reader.GetModel()->GetDefaultEntry()->Get<std::uint64_t>("event");
+      auto viewTimes = reader.GetView<std::vector<double>>("times");
+      double sum = 0.0;
+      std::vector<std::uint64_t> events;
+      for (auto i : range) {
+         reader.LoadEntry(i);
+         events.emplace_back(*event);
+         for (auto t : viewTimes(i))
+            sum += t;
+      }
+      std::lock_guard<std::mutex> guard(mutex);
+      for (auto e : events) {
+         EXPECT_FALSE(seen[e]);
+         seen[e] = true;
+      }
+      sumTimes += sum;
+   });
+   ROOT::DisableImplicitMT();
+
+   EXPECT_EQ(std::vector<bool>(nEvents, true), seen);
+   double expected = 0.0;
+   for (unsigned int i = 0; i < nEvents; ++i)
+      expected += double(i % 5) * i;
+   EXPECT_DOUBLE_EQ(expected, sumTimes);
+}
+#endif
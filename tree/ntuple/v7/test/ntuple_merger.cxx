@@ -0,0 +1,75 @@
+#include "ntuple_test.hxx"
+
+TEST(RNTupleMerger, Merge)
+{
+   FileRaii fileGuard1("test_ntuple_merge_in_1.root");
+   FileRaii fileGuard2("test_ntuple_merge_in_2.root");
+   FileRaii fileGuardOut("test_ntuple_merge_out.root");
+
+   for (auto path : {fileGuard1.GetPath(), fileGuard2.GetPath()}) {
+      auto model = RNTupleModel::Create();
+      auto wrPt = model->MakeField<float>("pt");
+      auto wrTag = model->MakeField<std::string>("tag");
+      auto wrJets = model->MakeField<std::vector<float>>("jets");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntpl", path);
+      for (unsigned int i = 0; i < 100; ++i) {
+         *wrPt = (path == fileGuard1.GetPath()) ? i : 100 + i;
+         *wrTag = std::to_string(*wrPt);
+         wrJets->assign(i % 3, *wrPt);
+         ntuple->Fill();
+         if (i % 40 == 39)
+            ntuple->CommitCluster();
+      }
+   }
+
+   {
+      auto source1 = RPageSource::Create("ntpl", fileGuard1.GetPath());
+      auto source2 = RPageSource::Create("ntpl", fileGuard2.GetPath());
+      source1->Attach();
+      source2->Attach();
+      std::vector<RPageSource *> sources{source1.get(), source2.get()};
+      auto destination = RPageSink::Create("ntpl", fileGuardOut.GetPath());
+      RNTupleMerger merger;
+      merger.Merge(sources, *destination);
+   }
+
+   auto ntuple = RNTupleReader::Open("ntpl", fileGuardOut.GetPath());
+   EXPECT_EQ(200U, ntuple->GetNEntries());
+   EXPECT_EQ(6U, ntuple->GetDescriptor().GetNClusters());
+   auto viewPt = ntuple->GetView<float>("pt");
+   auto viewTag = ntuple->GetView<std::string>("tag");
+   auto viewJets = ntuple->GetView<std::vector<float>>("jets");
+   for (auto i : ntuple->GetEntryRange()) {
+      EXPECT_EQ(static_cast<float>(i), viewPt(i));
+      EXPECT_EQ(std::to_string(static_cast<float>(i)), viewTag(i));
+      EXPECT_EQ(std::vector<float>((i % 100) % 3, static_cast<float>(i)), viewJets(i));
+   }
+}
+
+TEST(RNTupleMerger, Mismatch)
+{
+   FileRaii fileGuard1("test_ntuple_merge_mismatch_1.root");
+   FileRaii fileGuard2("test_ntuple_merge_mismatch_2.root");
+   FileRaii fileGuardOut("test_ntuple_merge_mismatch_out.root");
+   {
+      auto model = RNTupleModel::Create();
+      model->MakeField<float>("pt");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntpl", fileGuard1.GetPath());
+      ntuple->Fill();
+   }
+   {
+      auto model = RNTupleModel::Create();
+      model->MakeField<double>("pt");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntpl", fileGuard2.GetPath());
+      ntuple->Fill();
+   }
+
+   auto source1 = RPageSource::Create("ntpl", fileGuard1.GetPath());
+   auto source2 = RPageSource::Create("ntpl", fileGuard2.GetPath());
+   source1->Attach();
+   source2->Attach();
+   std::vector<RPageSource *> sources{source1.get(), source2.get()};
+   auto destination = RPageSink::Create("ntpl", fileGuardOut.GetPath());
+   RNTupleMerger merger;
+   EXPECT_THROW(merger.Merge(sources, *destination), RException);
+}
@@ -32,3 +32,75 @@ TEST(Packing, Bitfield)
       EXPECT_EQ(b9[i], e9[i]);
    }
 }
+
+TEST(Packing, Split)
+{
+   ROOT::Experimental::Detail::RColumnElement<double, ROOT::Experimental::EColumnType::kSplitReal64> element(nullptr);
+   element.Pack(nullptr, nullptr, 0);
+   element.Unpack(nullptr, nullptr, 0);
+
+   double mem[] = {0.0, 1.0, 2.0, 3.0};
+   unsigned char disk[sizeof(mem)];
+   element.Pack(disk, mem, 4);
+   // The most significant bytes are stored last
+   unsigned char msb[4];
+   for (unsigned i = 0; i < 4; ++i)
+      memcpy(&msb[i], reinterpret_cast<unsigned char *>(&mem[i]) + 7, 1);
+   EXPECT_EQ(0, memcmp(disk + 28, msb, 4));
+
+   double unpacked[4];
+   element.Unpack(unpacked, disk, 4);
+   for (unsigned i = 0; i < 4; ++i)
+      EXPECT_EQ(mem[i], unpacked[i]);
+}
+
+TEST(Packing, SplitIndex)
+{
+   using ClusterSize_t = ROOT::Experimental::ClusterSize_t;
+   ROOT::Experimental::Detail::RColumnElement<ClusterSize_t, ROOT::Experimental::EColumnType::kSplitIndex> element(
+      nullptr);
+
+   ClusterSize_t mem[] = {ClusterSize_t(1), ClusterSize_t(3), ClusterSize_t(3), ClusterSize_t(700000)};
+   std::uint32_t disk[4];
+   element.Pack(disk, mem, 4);
+   // Small differences leave the upper bytes empty
+   EXPECT_EQ(0, reinterpret_cast<unsigned char *>(disk)[15]);
+
+   ClusterSize_t unpacked[4];
+   element.Unpack(unpacked, disk, 4);
+   for (unsigned i = 0; i < 4; ++i)
+      EXPECT_EQ(mem[i], unpacked[i]);
+}
+
+TEST(Packing, SplitEncoding)
+{
+   FileRaii fileGuard("test_ntuple_packing_split.root");
+
+   auto model = RNTupleModel::Create();
+   auto wrPt = model->MakeField<float>("pt");
+   auto wrJets = model->MakeField<std::vector<double>>("jets");
+   {
+      RNTupleWriteOptions options;
+      options.SetUseSplitEncoding(true);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "ntpl", fileGuard.GetPath(), options);
+      for (unsigned int i = 0; i < 1000; ++i) {
+         *wrPt = i * 0.5;
+         wrJets->assign(i % 4, i * 0.25);
+         ntuple->Fill();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("ntpl", fileGuard.GetPath());
+   const auto &desc = ntuple->GetDescriptor();
+   auto ptColumnId = desc.FindColumnId(desc.FindFieldId("pt"), 0);
+   EXPECT_EQ(EColumnType::kSplitReal32, desc.GetColumnDescriptor(ptColumnId).GetModel().GetType());
+   auto jetsColumnId = desc.FindColumnId(desc.FindFieldId("jets"), 0);
+   EXPECT_EQ(EColumnType::kSplitIndex, desc.GetColumnDescriptor(jetsColumnId).GetModel().GetType());
+
+   auto viewPt = ntuple->GetView<float>("pt");
+   auto viewJets = ntuple->GetView<std::vector<double>>("jets");
+   for (auto i : ntuple->GetEntryRange()) {
+      EXPECT_EQ(static_cast<float>(i * 0.5), viewPt(i));
+      EXPECT_EQ(std::vector<double>(i % 4, i * 0.25), viewJets(i));
+   }
+}
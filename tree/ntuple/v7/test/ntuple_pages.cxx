@@ -55,3 +55,59 @@ TEST(Pages, Pool)
    page = pool.GetPage(1, 55);
    EXPECT_TRUE(page.IsNull());
 }
+
+TEST(Pages, PoolBudget)
+{
+   unsigned char buffer[3][10];
+   unsigned int nCallDeleter = 0;
+   // Room for two pages of 10 bytes each
+   RPagePool pool(20);
+   EXPECT_EQ(20U, pool.GetMaxBytes());
+   pool.GetMetrics().Enable();
+
+   RPageDeleter deleter([&nCallDeleter](const RPage & /*page*/, void * /*userData*/) { nCallDeleter++; });
+   RPage pages[3];
+   for (unsigned int i = 0; i < 3; ++i) {
+      pages[i] = RPage(1, buffer[i], 10, 1);
+      EXPECT_NE(nullptr, pages[i].TryGrow(10));
+      pages[i].SetWindow(i * 10, RPage::RClusterInfo(0, 0));
+   }
+
+   pool.RegisterPage(pages[0], deleter);
+   pool.RegisterPage(pages[1], deleter);
+   EXPECT_EQ(20U, pool.GetSizeInBytes());
+   pool.ReturnPage(pages[0]);
+   pool.ReturnPage(pages[1]);
+   // Unreferenced pages within the budget are kept
+   EXPECT_EQ(0U, nCallDeleter);
+   EXPECT_EQ(20U, pool.GetSizeInBytes());
+
+   // Reuse page 0, which makes page 1 the least recently used one
+   auto page = pool.GetPage(1, 5);
+   EXPECT_FALSE(page.IsNull());
+   EXPECT_EQ(0U, page.GetGlobalRangeFirst());
+   pool.ReturnPage(page);
+
+   pool.RegisterPage(pages[2], deleter);
+   EXPECT_EQ(1U, nCallDeleter);
+   EXPECT_EQ(20U, pool.GetSizeInBytes());
+   EXPECT_TRUE(pool.GetPage(1, 15).IsNull());
+   page = pool.GetPage(1, 5);
+   EXPECT_FALSE(page.IsNull());
+   pool.ReturnPage(page);
+
+   auto &metrics = pool.GetMetrics();
+   EXPECT_EQ(2, metrics.GetCounter("RPagePool.nPageHit")->GetValueAsInt());
+   EXPECT_EQ(1, metrics.GetCounter("RPagePool.nPageMiss")->GetValueAsInt());
+   EXPECT_EQ(1, metrics.GetCounter("RPagePool.nPageEvicted")->GetValueAsInt());
+   EXPECT_EQ(20, metrics.GetCounter("RPagePool.szPool")->GetValueAsInt());
+
+   // Referenced pages are never evicted, even if the pool exceeds its budget
+   page = pool.GetPage(1, 25);
+   EXPECT_FALSE(page.IsNull());
+   pool.RegisterPage(pages[1], deleter);
+   EXPECT_EQ(2U, nCallDeleter);
+   EXPECT_EQ(20U, pool.GetSizeInBytes());
+   pool.ReturnPage(page);
+   pool.ReturnPage(pages[1]);
+}
@@ -27,3 +27,34 @@ TEST(RNTuple, RDF)
    auto rdf = ROOT::Experimental::MakeNTupleDataFrame("myNTuple", fileGuard.GetPath());
    EXPECT_EQ(42.0, *rdf.Min("pt"));
 }
+
+TEST(RNTuple, RDFClusterRanges)
+{
+   FileRaii fileGuard("test_ntuple_rdf_cluster_ranges.root");
+   {
+      auto model = RNTupleModel::Create();
+      auto wrValue = model->MakeField<std::uint32_t>("value");
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "myNTuple", fileGuard.GetPath());
+      for (unsigned int i = 0; i < 100; ++i) {
+         *wrValue = i;
+         ntuple->Fill();
+         if (i % 10 == 9)
+            ntuple->CommitCluster();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("myNTuple", fileGuard.GetPath());
+   ROOT::Experimental::RNTupleDS ds(std::move(ntuple));
+   ds.SetNSlots(3);
+   ds.Initialise();
+   auto ranges = ds.GetEntryRanges();
+   ASSERT_EQ(10U, ranges.size());
+   for (unsigned int i = 0; i < ranges.size(); ++i) {
+      EXPECT_EQ(i * 10, ranges[i].first);
+      EXPECT_EQ((i + 1) * 10, ranges[i].second);
+   }
+   EXPECT_TRUE(ds.GetEntryRanges().empty());
+
+   auto rdf = ROOT::Experimental::MakeNTupleDataFrame("myNTuple", fileGuard.GetPath());
+   EXPECT_EQ(4950U, *rdf.Sum<std::uint32_t>("value"));
+}
@@ -70,3 +70,136 @@ TEST(RNTuple, Extended)
    }
    EXPECT_EQ(chksumRead, chksumWrite);
 }
+
+TEST(RNTuple, Mmap)
+{
+   FileRaii fileGuard("test_ntuple_mmap.root");
+
+   auto model = RNTupleModel::Create();
+   auto wrPt = model->MakeField<float>("pt");
+   auto wrJets = model->MakeField<std::vector<double>>("jets");
+   {
+      RNTupleWriteOptions options;
+      options.SetCompression(0);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "f", fileGuard.GetPath(), options);
+      for (unsigned int i = 0; i < 1000; ++i) {
+         *wrPt = i;
+         wrJets->assign(i % 5, i);
+         ntuple->Fill();
+         if (i % 100 == 99)
+            ntuple->CommitCluster();
+      }
+   }
+
+   RNTupleReadOptions options;
+   options.SetUseMmap(true);
+   auto ntuple = RNTupleReader::Open("f", fileGuard.GetPath(), options);
+   ntuple->EnableMetrics();
+   auto viewPt = ntuple->GetView<float>("pt");
+   auto viewJets = ntuple->GetView<std::vector<double>>("jets");
+   for (auto i : ntuple->GetEntryRange()) {
+      EXPECT_EQ(static_cast<float>(i), viewPt(i));
+      auto jets = viewJets(i);
+      ASSERT_EQ(i % 5, jets.size());
+      for (auto j : jets)
+         EXPECT_EQ(static_cast<double>(i), j);
+   }
+   auto nPageMapped = ntuple->GetMetrics().GetCounter("RNTupleReader.RPageSourceFile.nPageMapped");
+   ASSERT_NE(nullptr, nPageMapped);
+   EXPECT_GT(nPageMapped->GetValueAsInt(), 0);
+}
+
+TEST(RNTuple, FillContexts)
+{
+   FileRaii fileGuard("test_ntuple_fill_contexts.root");
+
+   constexpr unsigned int nThreads = 4;
+   constexpr unsigned int nEntriesPerThread = 10000;
+   {
+      auto model = RNTupleModel::Create();
+      model->MakeField<std::uint32_t>("id");
+      model->MakeField<std::vector<float>>("values");
+      auto writer = RNTupleWriter::Recreate(std::move(model), "ntpl", fileGuard.GetPath());
+
+      std::vector<std::unique_ptr<ROOT::Experimental::RNTupleFillContext>> contexts;
+      for (unsigned int t = 0; t < nThreads; ++t)
+         contexts.emplace_back(writer->CreateFillContext());
+
+      std::vector<std::thread> threads;
+      for (unsigned int t = 0; t < nThreads; ++t) {
+         threads.emplace_back([t, &contexts]() {
+            auto &context = *contexts[t];
+            auto entry = context.GetModel()->GetDefaultEntry();
+            auto id = entry->Get<std::uint32_t>("id");
+            auto values = entry->Get<std::vector<float>>("values");
+            for (unsigned int i = 0; i < nEntriesPerThread; ++i) {
+               *id = t * nEntriesPerThread + i;
+               values->assign(i % 3, static_cast<float>(*id));
+               context.Fill();
+               if (i % 1000 == 999)
+                  context.CommitCluster();
+            }
+         });
+      }
+      for (auto &thread : threads)
+         thread.join();
+   }
+
+   auto ntuple = RNTupleReader::Open("ntpl", fileGuard.GetPath());
+   EXPECT_EQ(nThreads * nEntriesPerThread, ntuple->GetNEntries());
+   EXPECT_EQ(nThreads * nEntriesPerThread / 1000, ntuple->GetDescriptor().GetNClusters());
+   auto viewId = ntuple->GetView<std::uint32_t>("id");
+   auto viewValues = ntuple->GetView<std::vector<float>>("values");
+   std::vector<bool> seen(nThreads * nEntriesPerThread, false);
+   for (auto i : ntuple->GetEntryRange()) {
+      auto id = viewId(i);
+      ASSERT_LT(id, seen.size());
+      EXPECT_FALSE(seen[id]);
+      seen[id] = true;
+      EXPECT_EQ(std::vector<float>((id % nEntriesPerThread) % 3, static_cast<float>(id)), viewValues(i));
+   }
+}
+
+TEST(RNTuple, AdaptivePageSize)
+{
+   FileRaii fileGuard("test_ntuple_adaptive_page_size.root");
+
+   constexpr std::size_t kZippedPageSize = 4096;
+   {
+      auto model = RNTupleModel::Create();
+      auto wrConstant = model->MakeField<std::uint64_t>("constant");
+      auto wrRandom = model->MakeField<double>("random");
+      RNTupleWriteOptions options;
+      options.SetApproxZippedPageSize(kZippedPageSize);
+      options.SetElementsPerPageRange(100, 50000);
+      auto ntuple = RNTupleWriter::Recreate(std::move(model), "f", fileGuard.GetPath(), options);
+      TRandom3 rnd(42);
+      for (unsigned int i = 0; i < 200000; ++i) {
+         *wrConstant = 7;
+         *wrRandom = rnd.Rndm();
+         ntuple->Fill();
+      }
+   }
+
+   auto ntuple = RNTupleReader::Open("f", fileGuard.GetPath());
+   const auto &desc = ntuple->GetDescriptor();
+   ASSERT_EQ(1U, desc.GetNClusters());
+   const auto &clusterDesc = desc.GetClusterDescriptor(0);
+   const auto &constantPages =
+      clusterDesc.GetPageRange(desc.FindColumnId(desc.FindFieldId("constant"), 0)).fPageInfos;
+   const auto &randomPages = clusterDesc.GetPageRange(desc.FindColumnId(desc.FindFieldId("random"), 0)).fPageInfos;
+
+   // The compressible column gets the maximum number of elements per page once its compression is known
+   EXPECT_EQ(50000U, constantPages.back().fNElements);
+   // The pages of the random column, after the first one, approach the requested compressed size
+   ASSERT_GT(randomPages.size(), 2U);
+   for (std::size_t i = 1; i + 1 < randomPages.size(); ++i) {
+      EXPECT_GT(randomPages[i].fLocator.fBytesOnStorage, kZippedPageSize / 2);
+      EXPECT_LT(randomPages[i].fLocator.fBytesOnStorage, kZippedPageSize * 2);
+   }
+
+   auto viewRandom = ntuple->GetView<double>("random");
+   TRandom3 rnd(42);
+   for (auto i : ntuple->GetEntryRange())
+      EXPECT_EQ(rnd.Rndm(), viewRandom(i));
+}
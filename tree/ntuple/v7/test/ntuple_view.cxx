@@ -121,3 +121,52 @@ TEST(RNTuple, Composable)
    }
    EXPECT_EQ(8, nEv);
 }
+
+TEST(RNTuple, BulkView)
+{
+   FileRaii fileGuard("test_ntuple_bulk_view.root");
+
+   auto model = RNTupleModel::Create();
+   auto fieldPt = model->MakeField<float>("pt");
+   auto fieldTag = model->MakeField<std::string>("tag");
+   constexpr unsigned int nEntries = 3 * RPageSinkFile::kDefaultElementsPerPage + 7;
+
+   {
+      RNTupleWriter ntuple(std::move(model),
+         std::make_unique<RPageSinkFile>("myNTuple", fileGuard.GetPath(), RNTupleWriteOptions()));
+      for (unsigned int i = 0; i < nEntries; ++i) {
+         *fieldPt = i;
+         *fieldTag = std::to_string(i);
+         ntuple.Fill();
+      }
+   }
+
+   RNTupleReader ntuple(std::make_unique<RPageSourceFile>("myNTuple", fileGuard.GetPath(), RNTupleReadOptions()));
+   auto viewPt = ntuple.GetView<float>("pt");
+
+   // A span never crosses the page boundary
+   auto span = viewPt.MapV(1);
+   ASSERT_EQ(RPageSinkFile::kDefaultElementsPerPage - 1, span.size());
+   EXPECT_EQ(1.0, span[0]);
+   EXPECT_EQ(&viewPt(1), &span[0]);
+   EXPECT_EQ(float(RPageSinkFile::kDefaultElementsPerPage - 1), span[span.size() - 1]);
+
+   NTupleSize_t nMapped = 0;
+   for (NTupleSize_t i = 0; i < nEntries; i += span.size()) {
+      span = viewPt.MapV(i);
+      for (auto v : span)
+         EXPECT_EQ(float(nMapped++), v);
+   }
+   EXPECT_EQ(nEntries, nMapped);
+
+   auto values = viewPt.ReadV(5, 2 * RPageSinkFile::kDefaultElementsPerPage);
+   ASSERT_EQ(2 * RPageSinkFile::kDefaultElementsPerPage, values.size());
+   for (unsigned int i = 0; i < values.size(); ++i)
+      EXPECT_EQ(float(i + 5), values[i]);
+
+   auto viewTag = ntuple.GetView<std::string>("tag");
+   auto tags = viewTag.ReadV(nEntries - 2, 2);
+   ASSERT_EQ(2U, tags.size());
+   EXPECT_EQ(std::to_string(nEntries - 2), tags[0]);
+   EXPECT_EQ(std::to_string(nEntries - 1), tags[1]);
+}
@@ -75,6 +75,9 @@ protected:
    Int_t       fLastWriteBufferSize[3] = {0,0,0}; ///<! Size of the buffer last three buffers we wrote it to disk
    Bool_t      fResetAllocation{false};           ///<! True if last reset re-allocated the memory
    UChar_t     fNextBufferSizeRecord{0};          ///<! Index into fLastWriteBufferSize of the last buffer written to disk
+   Bool_t      fDetached{kFALSE};                 ///<! True while written asynchronously; the branch then already set fCycle
+   Int_t       fEntryOffsetCapacity{0};           ///<! Length of fEntryOffset if it can be reused by ReadBasketBuffers, 0 otherwise
+   Int_t       fDisplacementCapacity{0};          ///<! Length of fDisplacement if it can be reused by ReadBasketBuffers, 0 otherwise
 #ifdef R__TRACK_BASKET_ALLOC_TIME
    ULong64_t   fResetAllocationTime{0};           ///<! Time spent reallocating baskets in microseconds during last Reset operation.
 #endif
@@ -31,6 +31,8 @@
 #include "Compression.h"
 #include "ROOT/TIOFeatures.hxx"
 
+#include <vector>
+
 class TTree;
 class TBasket;
 class TBranchElement;
@@ -73,7 +75,9 @@ public:
    Int_t GetBulkEntries(Long64_t evt, TBuffer &user_buf);
    Int_t GetEntriesSerialized(Long64_t evt, TBuffer &user_buf);
    Int_t GetEntriesSerialized(Long64_t evt, TBuffer &user_buf, TBuffer *count_buf);
+   Int_t GetEntriesJagged(Long64_t evt, TBuffer &user_buf, std::vector<Int_t> &offsets);
    Bool_t SupportsBulkRead() const;
+   Bool_t SupportsJaggedBulkRead() const;
 
 private:
    TBulkBranchRead(TBranch &parent)
@@ -93,6 +97,7 @@ protected:
    friend class TTreeCache;
    friend class TTreeCloner;
    friend class TTree;
+   friend class TBasket;
    friend class TBranchElement;
    friend class ROOT::Experimental::Internal::TBulkBranchRead;
 
@@ -150,6 +155,12 @@ protected:
 
    Bool_t      fSkipZip;          ///<! After being read, the buffer will not be unzipped.
 
+   std::vector<char>   fCompressDict;          ///<  Dictionary the baskets are compressed with, see SetCompressionDictionary()
+   std::vector<char>   fDictSamples;           ///<! Basket contents collected to train fCompressDict
+   std::vector<size_t> fDictSampleSizes;       ///<! Size of each sample in fDictSamples
+   Int_t               fDictTrainBaskets{0};   ///<! Number of baskets to collect before training fCompressDict; 0 if not training
+   Int_t               fDictMaxSize{0};        ///<! Maximum size of the dictionary to train
+
    using CacheInfo_t = ROOT::Internal::TBranchCacheInfo;
    CacheInfo_t fCacheInfo;        ///<! Hold info about which basket are in the cache and if they have been retrieved from the cache.
 
@@ -174,14 +185,20 @@ protected:
 
    virtual void SetAddressImpl(void *addr, Bool_t /* implied */) { SetAddress(addr); }
 
+   virtual Int_t GetJaggedElementSize(Bool_t &hasCollectionHeader) const;
+
 private:
    Int_t    GetBasketAndFirst(TBasket*& basket, Long64_t& first, TBuffer* user_buffer);
    TBasket *GetBasketImpl(Int_t basket, TBuffer* user_buffer);
    Int_t    GetBulkEntries(Long64_t, TBuffer&);
    Int_t    GetEntriesSerialized(Long64_t N, TBuffer& user_buf) {return GetEntriesSerialized(N, user_buf, nullptr);}
    Int_t    GetEntriesSerialized(Long64_t, TBuffer&, TBuffer*);
+   Int_t    GetEntriesJagged(Long64_t, TBuffer&, std::vector<Int_t>&);
    Int_t    FillEntryBuffer(TBasket* basket,TBuffer* buf, Int_t& lnew);
    Int_t    WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBranchIMTHelper *);
+   TBasket *DetachWriteBasket(Int_t &where);
+   Int_t    AttachWrittenBasket(TBasket *basket, Int_t where, Int_t nout);
+   void     AddCompressionDictionarySample(const char *buffer, Int_t len);
    TBranch(const TBranch&) = delete;             // not implemented
    TBranch& operator=(const TBranch&) = delete;  // not implemented
 
@@ -217,6 +234,7 @@ public:
            Int_t     GetCompressionAlgorithm() const;
            Int_t     GetCompressionLevel() const;
            Int_t     GetCompressionSettings() const;
+   const std::vector<char> &GetCompressionDictionary() const { return fCompressDict; }
    TDirectory       *GetDirectory() const {return fDirectory;}
    virtual Int_t     GetEntry(Long64_t entry=0, Int_t getall = 0);
    virtual Int_t     GetEntryExport(Long64_t entry, Int_t getall, TClonesArray *list, Int_t n);
@@ -271,6 +289,7 @@ public:
    void              SetCompressionAlgorithm(Int_t algorithm = ROOT::RCompressionSetting::EAlgorithm::kUseGlobal);
    void              SetCompressionLevel(Int_t level = ROOT::RCompressionSetting::ELevel::kUseMin);
    void              SetCompressionSettings(Int_t settings = ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault);
+   void              SetCompressionDictionary(Int_t nTrainingBaskets = 10, Int_t maxDictSize = 16384);
    virtual void      SetEntries(Long64_t entries);
    virtual void      SetEntryOffsetLen(Int_t len, Bool_t updateSubBranches = kFALSE);
    virtual void      SetFirstEntry( Long64_t entry );
@@ -283,12 +302,13 @@ public:
    virtual void      SetTree(TTree *tree) { fTree = tree;}
    virtual void      SetupAddresses();
            Bool_t    SupportsBulkRead() const;
+           Bool_t    SupportsJaggedBulkRead() const;
    virtual void      UpdateAddress() {;}
    virtual void      UpdateFile();
 
    static  void      ResetCount();
 
-   ClassDef(TBranch, 13); // Branch descriptor
+   ClassDef(TBranch, 14); // Branch descriptor
 };
 
 //______________________________________________________________________________
@@ -316,7 +336,9 @@ namespace Internal {
 inline Int_t  TBulkBranchRead::GetBulkEntries(Long64_t evt, TBuffer& user_buf) { return fParent.GetBulkEntries(evt, user_buf); }
 inline Int_t  TBulkBranchRead::GetEntriesSerialized(Long64_t evt, TBuffer& user_buf) { return fParent.GetEntriesSerialized(evt, user_buf); }
 inline Int_t  TBulkBranchRead::GetEntriesSerialized(Long64_t evt, TBuffer& user_buf, TBuffer* count_buf) { return fParent.GetEntriesSerialized(evt, user_buf, count_buf); }
+inline Int_t  TBulkBranchRead::GetEntriesJagged(Long64_t evt, TBuffer& user_buf, std::vector<Int_t> &offsets) { return fParent.GetEntriesJagged(evt, user_buf, offsets); }
 inline Bool_t TBulkBranchRead::SupportsBulkRead() const { return fParent.SupportsBulkRead(); }
+inline Bool_t TBulkBranchRead::SupportsJaggedBulkRead() const { return fParent.SupportsJaggedBulkRead(); }
 
 }  // Internal
 }  // Experimental
@@ -36,11 +36,14 @@ class TVirtualArray;
 
 #include "TStreamerInfoActions.h"
 
+#include <vector>
+
 class TBranchElement : public TBranch {
 
 // Friends
    friend class TTreeCloner;
    friend class TLeafElement;
+   friend class TBranchSTL;
 
 // Types
 protected:
@@ -101,6 +104,9 @@ protected:
    TVirtualCollectionIterators           *fIterators;      ///<! holds the iterators when the branch is of fType==4.
    TVirtualCollectionIterators           *fWriteIterators; ///<! holds the read (non-staging) iterators when the branch is of fType==4 and associative containers.
    TVirtualCollectionPtrIterators        *fPtrIterators;   ///<! holds the iterators when the branch is of fType==4 and it is a split collection of pointers.
+   std::vector<void*>                     fRecycledObjects;        ///<! Elements of a split collection of pointers kept for the next entries, see SetRecycleObjects().
+   TClassRef                              fRecycledClass;          ///<! Class of the objects in fRecycledObjects.
+   Bool_t                                 fRecycleObjects{kFALSE}; ///<! True if the elements of a split collection of pointers are reused across entries.
 
 // Not implemented
 private:
@@ -115,9 +121,11 @@ protected:
    virtual void             InitializeOffsets();
    virtual void             InitInfo();
    Bool_t                   IsMissingCollection() const;
+   void                     ReleaseRecycledObjects();
    TStreamerInfo           *FindOnfileInfo(TClass *valueClass, const TObjArray &branches) const;
    TClass                  *GetParentClass(); // Class referenced by fParentName
    TStreamerInfo           *GetInfoImp() const;
+   virtual Int_t            GetJaggedElementSize(Bool_t &hasCollectionHeader) const;
    void                     ReleaseObject();
    void                     SetupInfo();
    void                     SetBranchCount(TBranchElement* bre);
@@ -207,6 +215,7 @@ public:
    template<typename T > T  GetTypedValue(Int_t i, Int_t len, Bool_t subarr = kFALSE) const;
    virtual void            *GetValuePointer() const;
            Int_t            GetClassVersion() { return fClassVersion; }
+           Bool_t           GetRecycleObjects() const { return fRecycleObjects; }
            Bool_t           IsBranchFolder() const { return TestBit(kBranchFolder); }
            Bool_t           IsFolder() const;
    virtual Bool_t           IsObjectOwner() const { return TestBit(kDeleteObject); }
@@ -225,6 +234,7 @@ public:
    virtual void             SetBranchFolder() { SetBit(kBranchFolder); }
    virtual void             SetClassName(const char* name) { fClassName = name; }
    virtual void             SetOffset(Int_t offset);
+           void             SetRecycleObjects(Bool_t recycle = kTRUE);
    virtual void             SetMissing();
    inline  void             SetParentClass(TClass* clparent);
    virtual void             SetParentName(const char* name) { fParentName = name; }
@@ -36,14 +36,17 @@ class TBranchSTL: public TBranch {
       virtual Int_t          GetExpectedType(TClass *&clptr,EDataType &type);
       virtual Int_t          GetEntry( Long64_t entry = 0, Int_t getall = 0 );
       virtual TStreamerInfo *GetInfo() const;
+      Bool_t                 GetRecycleObjects() const { return fRecycleObjects; }
       virtual void           Print(Option_t*) const;
       virtual void           SetAddress( void* addr );
+      void                   SetRecycleObjects( Bool_t recycle = kTRUE );
 
       ClassDef( TBranchSTL, 1 ) //Branch handling STL collection of pointers
 
    private:
 
       void ReadLeavesImpl( TBuffer& b );
+      void RecycleElements( TClass* elClass );
       void FillLeavesImpl( TBuffer& b );
       virtual Int_t          FillImpl(ROOT::Internal::TBranchIMTHelper *);
 
@@ -75,6 +78,7 @@ class TBranchSTL: public TBranch {
       mutable TStreamerInfo   *fInfo;         ///<! The streamer info
       char*                    fObject;       ///<! Pointer to object at address or the
       Int_t                    fID;           ///<  Element serial number in the streamer info
+      Bool_t                   fRecycleObjects{kFALSE}; ///<! Reuse the elements across entries, see SetRecycleObjects()
 };
 
 #endif // ROOT_TBranchSTL
@@ -48,6 +48,7 @@ private:
    TChain(const TChain&);            // not implemented
    TChain& operator=(const TChain&); // not implemented
    void ParseTreeFilename(const char *name, TString &filename, TString &treename, TString &query, TString &suffix, Bool_t wildcards) const;
+   Bool_t ScanEntriesMT();
 
 protected:
    void InvalidateCurrentTree();
@@ -92,6 +93,7 @@ public:
    virtual Long64_t  GetCacheSize() const { return fTree ? fTree->GetCacheSize() : fCacheSize; }
    virtual Long64_t  GetChainEntryNumber(Long64_t entry) const;
    virtual TClusterIterator GetClusterIterator(Long64_t firstentry);
+   virtual Long64_t  GetClusterStatistics(const char *bname, Long64_t entry, Double_t &min, Double_t &max);
            Int_t     GetNtrees() const { return fNtrees; }
    virtual Long64_t  GetEntries() const;
    virtual Long64_t  GetEntries(const char *sel) { return TTree::GetEntries(sel); }
@@ -50,6 +50,8 @@ class TList;
 
 #include <array>
 #include <atomic>
+#include <memory>
+#include <string>
 #include <vector>
 #include <utility>
 
@@ -76,6 +78,12 @@ class TTreeCloner;
 class TFileMergeInfo;
 class TVirtualPerfStats;
 
+namespace ROOT {
+namespace Internal {
+class TBranchIMTHelper;
+}
+}
+
 class TTree : public TNamed, public TAttLine, public TAttFill, public TAttMarker {
 
    using TIOFeatures = ROOT::TIOFeatures;
@@ -112,6 +120,10 @@ protected:
    Long64_t       fDebugMin;              ///<! First entry number to debug
    Long64_t       fDebugMax;              ///<! Last entry number to debug
    TIOFeatures    fIOFeatures{0};         ///<  IO features to define for newly-written baskets and branches.
+   std::vector<std::string> fClusterStatsBranches; ///<  Branches whose minimum and maximum are recorded per cluster of entries
+   std::vector<Long64_t> fClusterStatsEnd; ///<  End (exclusive) of each cluster of entries with statistics
+   std::vector<Double_t> fClusterStatsMin; ///<  Minimum of each branch in each cluster, at index cluster * number of branches + branch
+   std::vector<Double_t> fClusterStatsMax; ///<  Maximum of each branch in each cluster, at the same index as in fClusterStatsMin
    Int_t          fMakeClass;             ///<! not zero when processing code generated by MakeClass
    Int_t          fFileNumber;            ///<! current file number (if file extensions)
    TObject       *fNotify;                ///<! Object to be notified when loading a Tree
@@ -157,10 +169,33 @@ private:
    mutable std::atomic<Long64_t> fIMTTotBytes;    ///<! Total bytes for the IMT flush baskets
    mutable std::atomic<Long64_t> fIMTZipBytes;    ///<! Zip bytes for the IMT flush baskets.
 
+   /// A basket taken away from its branch by an asynchronous flush, written by a background task
+   struct TAsyncBasket {
+      TBranch *fBranch = nullptr;
+      TBasket *fBasket = nullptr;
+      Int_t    fWhere = 0;  ///< Index of the basket in the branch basket arrays
+      Int_t    fNbytes = 0; ///< Result of TBasket::WriteBuffer
+   };
+   Bool_t         fAsyncFlush{kFALSE};    ///<! true if the autoflush writes the cluster's baskets in the background (needs IMT)
+   mutable std::vector<TAsyncBasket> fAsyncBaskets; ///<! Baskets of the asynchronous flush in flight
+   mutable std::unique_ptr<ROOT::Internal::TBranchIMTHelper> fAsyncFlushHelper; ///<! Tasks of the asynchronous flush in flight
+   Long64_t       fAdaptiveClusterBytes{0}; ///<! Target uncompressed cluster size of the adaptive autoflush, 0 if disabled
+   Int_t          fAdaptiveMaxBaskets{1};   ///<! Number of baskets per branch and cluster targeted by the adaptive autoflush
+   Int_t          fAdaptiveClusters{0};     ///<! Number of clusters the adaptive autoflush still tunes the sizes at
+   std::vector<TLeaf*> fClusterStatsLeaves;   ///<! Leaves of the branches in fClusterStatsBranches
+   std::vector<Double_t> fClusterStatsOpenMin; ///<! Minimum of each branch in the cluster being filled
+   std::vector<Double_t> fClusterStatsOpenMax; ///<! Maximum of each branch in the cluster being filled
+   Long64_t       fClusterStatsNFills{0};   ///<! Number of entries of the cluster being filled seen by FillClusterStatistics, -1 if unknown
+
    void             InitializeBranchLists(bool checkLeafCount);
    void             SortBranchesByTime();
    Int_t            FlushBasketsImpl() const;
+   Int_t            FlushBasketsAsync();
+   Int_t            FinishAsyncFlush() const;
    void             MarkEventCluster();
+   void             AdaptClusterSize();
+   void             FillClusterStatistics();
+   void             CloseClusterStatistics();
 
 protected:
    virtual void     KeepCircular();
@@ -315,6 +350,7 @@ public:
    TTree& operator=(const TTree& tt) = delete;
 
    virtual Int_t           AddBranchToCache(const char *bname, Bool_t subbranches = kFALSE);
+   Int_t                   AddClusterStatistics(const char *bname);
    virtual Int_t           AddBranchToCache(TBranch *branch,   Bool_t subbranches = kFALSE);
    virtual Int_t           DropBranchFromCache(const char *bname, Bool_t subbranches = kFALSE);
    virtual Int_t           DropBranchFromCache(TBranch *branch,   Bool_t subbranches = kFALSE);
@@ -450,6 +486,7 @@ public:
    virtual Long64_t        GetChainEntryNumber(Long64_t entry) const { return entry; }
    virtual Long64_t        GetChainOffset() const { return fChainOffset; }
    virtual Bool_t          GetClusterPrefetch() const { return fCacheDoClusterPrefetch; }
+   virtual Long64_t        GetClusterStatistics(const char *bname, Long64_t entry, Double_t &min, Double_t &max);
    TFile                  *GetCurrentFile() const;
            Int_t           GetDefaultEntryOffsetLen() const {return fDefaultEntryOffsetLen;}
            Long64_t        GetDebugMax()  const { return fDebugMax; }
@@ -473,6 +510,8 @@ public:
    virtual const char     *GetFriendAlias(TTree*) const;
    TH1                    *GetHistogram() { return GetPlayer()->GetHistogram(); }
    virtual Bool_t          GetImplicitMT() { return fIMTEnabled; }
+   Bool_t                  GetAsyncFlush() const { return fAsyncFlush; }
+   Long64_t                GetAdaptiveAutoFlush() const { return fAdaptiveClusterBytes; }
    virtual Int_t          *GetIndex() { return &fIndex.fArray[0]; }
    virtual Double_t       *GetIndexValues() { return &fIndexValues.fArray[0]; }
            ROOT::TIOFeatures GetIOFeatures() const;
@@ -538,7 +577,7 @@ public:
    virtual Double_t       *GetW()    { return GetPlayer()->GetW(); }
    virtual Double_t        GetWeight() const   { return fWeight; }
    virtual Long64_t        GetZipBytes() const { return fZipBytes; }
-   virtual void            IncrementTotalBuffers(Int_t nbytes) { fTotalBuffers += nbytes; }
+   virtual void            IncrementTotalBuffers(Int_t nbytes);
    Bool_t                  IsFolder() const { return kTRUE; }
    virtual Int_t           LoadBaskets(Long64_t maxmemory = 2000000000);
    virtual Long64_t        LoadTree(Long64_t entry);
@@ -613,6 +652,8 @@ public:
    virtual void            SetEventList(TEventList* list);
    virtual void            SetEntryList(TEntryList* list, Option_t *opt="");
    virtual void            SetImplicitMT(Bool_t enabled) { fIMTEnabled = enabled; }
+   void                    SetAsyncFlush(Bool_t enabled);
+   void                    SetAdaptiveAutoFlush(Long64_t clusterBytes = 100000000, Int_t maxBasketsPerCluster = 1, Int_t nTuningClusters = 3);
    virtual void            SetMakeClass(Int_t make);
    virtual void            SetMaxEntryLoop(Long64_t maxev = kMaxEntries) { fMaxEntryLoop = maxev; } // *MENU*
    static  void            SetMaxTreeSize(Long64_t maxsize = 100000000000LL);
@@ -648,7 +689,7 @@ public:
    virtual Int_t           Write(const char *name=0, Int_t option=0, Int_t bufsize=0);
    virtual Int_t           Write(const char *name=0, Int_t option=0, Int_t bufsize=0) const;
 
-   ClassDef(TTree, 20) // Tree descriptor (the main ROOT I/O class)
+   ClassDef(TTree, 21) // Tree descriptor (the main ROOT I/O class)
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -27,6 +27,7 @@
 
 class TTree;
 class TBranch;
+class TDirectory;
 class TObjArray;
 
 class TTreeCache : public TFileCacheRead {
@@ -124,6 +125,10 @@ private:
    TBranch *CalculateMissEntries(Long64_t, int, bool);    ///< Given an file read, try to determine the corresponding branch.
    Bool_t   ProcessMiss(Long64_t pos, int len); ///<! Given a file read not in the miss cache, handle (possibly) loading the data.
 
+   TString  GetProfileName(const char *name) const;
+   Int_t    AddProfileBranches(TDirectory *dir, const char *name);
+   void     LoadConfiguredProfile();
+
 public:
 
    TTreeCache();
@@ -154,6 +159,7 @@ public:
    virtual Bool_t       FillBuffer();
    virtual Int_t        LearnBranch(TBranch *b, Bool_t subgbranches = kFALSE);
    virtual void         LearnPrefill();
+   Int_t                LoadProfile(TDirectory *dir = nullptr, const char *name = nullptr);
 
    virtual void         Print(Option_t *option="") const;
    virtual Int_t        ReadBuffer(char *buf, Long64_t pos, Int_t len);
@@ -161,6 +167,7 @@ public:
    virtual Int_t        ReadBufferPrefetch(char *buf, Long64_t pos, Int_t len);
    virtual void         ResetCache();
    void                 ResetMissCache(); // Reset the miss cache.
+   Int_t                SaveProfile(TDirectory *dir = nullptr, const char *name = nullptr) const;
    void                 SetAutoCreated(Bool_t val) {fAutoCreated = val;}
    virtual Int_t        SetBufferSize(Int_t buffersize);
    virtual void         SetEntryRange(Long64_t emin,   Long64_t emax);
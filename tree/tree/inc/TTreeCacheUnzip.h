@@ -17,6 +17,8 @@
 #include "TTreeCache.h"
 #include <atomic>
 #include <memory>
+#include <set>
+#include <string>
 #include <vector>
 
 class TBasket;
@@ -94,9 +96,23 @@ protected:
 
    // Unzipping related members
    Int_t       fNseekMax;         ///<!  fNseek can change so we need to know its max size
-   Int_t       fUnzipGroupSize;   ///<!  Min accumulated size of a group of baskets ready to be unzipped by a IMT task
+   Int_t       fUnzipGroupSize;   ///<!  Min accumulated size of the baskets to be unzipped per IMT task
    Long64_t    fUnzipBufferSize;  ///<!  Max Size for the ready unzipped blocks (default is 2*fBufferSize)
 
+   // Members used to schedule the IMT tasks
+   std::vector<Int_t>    fUnzipOrder;          ///<! Indices of the baskets in the order they are unzipped, largest first
+   std::atomic<Int_t>    fUnzipNext{0};        ///<! Position in fUnzipOrder of the next basket to be taken by a task
+   std::atomic<Int_t>    fNUnzipTasks{0};      ///<! Number of running unzipping tasks
+   Int_t                 fNUnzipTasksMax{0};   ///<! Number of unzipping tasks for the current cache content
+   std::atomic<Long64_t> fUnzipAhead{0};       ///<! Size of the unzipped blocks not yet picked up, kept below fUnzipBufferSize
+
+   // Members used to unzip the baskets of some branches only when they are requested
+   std::set<std::string> fUnzipOnDemandBranches; ///<! Names of the branches whose baskets are not unzipped ahead
+   std::vector<char>     fUnzipOnDemand;         ///<! [fNseek] 0 if the basket is not of an on-demand branch, 2 if it is unzipped only when requested
+   Int_t                 fNOnDemand{0};          ///<! Number of baskets of on-demand branches in the current cache content
+   Int_t                 fNOnDemandRequested{0}; ///<! Number of those that were requested by the reader
+   Bool_t                fOnDemandAhead{kFALSE}; ///<! Unzip the baskets of the on-demand branches ahead anyway
+
    static Double_t fgRelBuffSize; ///< This is the percentage of the TTreeCacheUnzip that will be used
 
    // Members use to keep statistics
@@ -104,6 +120,7 @@ protected:
    Int_t       fNMissed;          ///<! number of blocks that were not found in the cache and were unzipped
    Int_t       fNStalls;          ///<! number of hits which caused a stall
    Int_t       fNUnzip;           ///<! number of blocks that were unzipped
+   Int_t       fNUnzipOnDemand;   ///<! number of blocks of on-demand branches that were unzipped when requested
 
 private:
    TTreeCacheUnzip(const TTreeCacheUnzip &);            //this class cannot be copied
@@ -114,6 +131,13 @@ private:
 
    // Private methods
    void  Init();
+   Bool_t IsOnDemandBasket(Int_t index) const
+   {
+      return index < (Int_t)fUnzipOnDemand.size() && fUnzipOnDemand[index] == 2;
+   }
+#ifdef R__USE_IMT
+   void  LaunchUnzipTasks();
+#endif
 
 public:
    TTreeCacheUnzip();
@@ -144,6 +168,8 @@ public:
    virtual Int_t  SetBufferSize(Int_t buffersize);
    void           SetUnzipBufferSize(Long64_t bufferSize);
    void           SetUnzipGroupSize(Int_t groupSize) { fUnzipGroupSize = groupSize; }
+   void           SetUnzipOnDemand(const char *bname, Bool_t onDemand = kTRUE);
+   Bool_t         IsUnzipOnDemand(const TBranch *b) const;
    static void    SetUnzipRelBufferSize(Float_t relbufferSize);
    Int_t          UnzipBuffer(char **dest, char *src);
    Int_t          UnzipCache(Int_t index);
@@ -152,6 +178,7 @@ public:
    Int_t  GetNUnzip() { return fNUnzip; }
    Int_t  GetNMissed(){ return fNMissed; }
    Int_t  GetNFound() { return fNFound; }
+   Int_t  GetNUnzipOnDemand() { return fNUnzipOnDemand; }
 
    void Print(Option_t* option = "") const;
 
@@ -22,6 +22,9 @@
 
 #include "TObjArray.h"
 
+#include <utility>
+#include <vector>
+
 class TBranch;
 class TTree;
 class TFileCacheRead;
@@ -39,6 +42,7 @@ class TTreeCloner {
    TObjArray  fToBranches;
 
    UInt_t     fMaxBaskets;
+   UInt_t     fNBaskets;         ///< Number of baskets collected for the current copy
    UInt_t    *fBasketBranchNum;  ///<[fMaxBaskets] Index of the branch(es) of the basket.
    UInt_t    *fBasketNum;        ///<[fMaxBaskets] index of the basket within the branch.
 
@@ -49,7 +53,10 @@ class TTreeCloner {
    UShort_t   fPidOffset;        ///< Offset to be added to the copied key/basket.
 
    UInt_t     fCloneMethod;      ///< Indicates which cloning method was selected.
-   Long64_t   fToStartEntries;   ///< Number of entries in the target tree before any addition.
+   Long64_t   fToStartEntries;   ///< Entry number in the target tree of the first entry of the input tree.
+   Long64_t   fFastFirst;        ///< First entry of the input tree whose baskets are copied as-is.
+   Long64_t   fFastLast;         ///< Entry after the last one whose baskets are copied as-is.
+   std::vector<std::pair<Long64_t, Long64_t>> fEntryRanges; ///< Ranges of entries to copy, if not all.
 
    Int_t           fCacheSize;   ///< Requested size of the file cache
    TFileCacheRead *fFileCache;   ///< File Cache used to reduce the number of individual reads
@@ -80,6 +87,8 @@ class TTreeCloner {
    friend class CompareEntry;
 
    void ImportClusterRanges();
+   Bool_t IsBasketBoundary(Long64_t entry);
+   void FillEntries(Long64_t first, Long64_t last);
    void CreateCache();
    UInt_t FillCache(UInt_t from);
    void RestoreCache();
@@ -99,6 +108,7 @@ public:
    TTreeCloner(TTree *from, TTree *to, Option_t *method, UInt_t options = kNone);
    virtual ~TTreeCloner();
 
+   void   AddEntryRange(Long64_t first, Long64_t last);
    void   CloseOutWriteBaskets();
    UInt_t CollectBranches(TBranch *from, TBranch *to);
    UInt_t CollectBranches(TObjArray *from, TObjArray *to);
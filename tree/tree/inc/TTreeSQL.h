@@ -52,6 +52,9 @@ protected:
    TSQLServer            *fServer;
    Bool_t                 fBranchChecked;
    TSQLTableInfo         *fTableInfo;
+   Int_t                  fInsertBatchSize;  //! Maximum number of rows inserted by one query
+   Int_t                  fNumBatchedRows;   //! Number of filled rows not yet inserted
+   TString                fBatchQuery;       //! Multi-row INSERT query of these rows
 
    void                   CheckBasket(TBranch * tb);
    Bool_t                 CheckBranch(TBranch * tb);
@@ -81,14 +84,17 @@ public:
    virtual TBranch       *Branch(const char *name, void *address, const char *leaflist, Int_t bufsize);
 
    virtual Int_t          Fill();
+           Int_t          FlushInserts();
    virtual Int_t          GetEntry(Long64_t entry=0, Int_t getall=0);
    virtual Long64_t       GetEntries()    const;
    virtual Long64_t       GetEntries(const char *sel) { return TTree::GetEntries(sel); }
    virtual Long64_t       GetEntriesFast()const;
+           Int_t          GetInsertBatchSize() const { return fInsertBatchSize; }
            TString        GetTableName(){ return fTable; }
    virtual Long64_t       LoadTree(Long64_t entry);
    virtual Long64_t       PrepEntry(Long64_t entry);
            void           Refresh();
+           void           SetInsertBatchSize(Int_t n);
 
    virtual ~TTreeSQL();
    ClassDef(TTreeSQL,2);  // TTree Implementation read and write to a SQL database.
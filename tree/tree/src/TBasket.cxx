@@ -24,6 +24,7 @@
 #include "TVirtualPerfStats.h"
 #include "TTimeStamp.h"
 #include "ROOT/TIOFeatures.hxx"
+#include "ROOT/RTrace.hxx"
 #include "RZip.h"
 
 #include <bitset>
@@ -182,6 +183,7 @@ Int_t TBasket::DropBuffers()
    fCompressedBufferRef = 0;
    fBuffer      = 0;
    fDisplacement= 0;
+   fDisplacementCapacity = 0;
    fEntryOffset = 0;
    fBranch->GetTree()->IncrementTotalBuffers(-fBufferSize);
    return fBufferSize;
@@ -208,6 +210,7 @@ Int_t *TBasket::GetCalculatedEntryOffset()
    }
    TLeaf *leaf = static_cast<TLeaf *>((*fBranch->GetListOfLeaves())[0]);
    fEntryOffset = leaf->GenerateOffsetArray(fKeylen, fNevBuf);
+   fEntryOffsetCapacity = 0;
    return fEntryOffset;
 }
 
@@ -369,6 +372,7 @@ Int_t TBasket::ReadBasketBuffersUncompressedCase()
    // entry in this basket.
    ResetEntryOffset();
    delete [] fDisplacement; fDisplacement = 0;
+   fDisplacementCapacity = 0;
 
    fBranch->GetTree()->IncrementTotalBuffers(fBufferSize);
    return 0;
@@ -426,6 +430,27 @@ static inline TBuffer* R__InitializeReadBasketBuffer(TBuffer* bufferRef, Int_t l
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read an Int_t array written by TBuffer::WriteArray into `array`, reusing its
+/// memory if it is known to hold at least the `capacity` elements needed.
+/// Returns the number of elements read, or 0 (leaving `array` untouched) if the
+/// buffer does not hold a valid array.
+
+static inline Int_t R__ReadRecycledArray(TBuffer &buffer, Int_t *&array, Int_t &capacity)
+{
+   Int_t n = 0;
+   buffer >> n;
+   if (n <= 0 || Long64_t(n) * sizeof(Int_t) > Long64_t(buffer.BufferSize()))
+      return 0;
+   if (!array || n > capacity) {
+      delete [] array;
+      array = new Int_t[n];
+      capacity = n;
+   }
+   buffer.ReadFastArray(array, n);
+   return n;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize the compressed buffer; either from the TTree or create a local one.
 
@@ -444,6 +469,7 @@ void TBasket::ResetEntryOffset()
       delete[] fEntryOffset;
    }
    fEntryOffset = nullptr;
+   fEntryOffsetCapacity = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -463,6 +489,7 @@ void TBasket::ResetEntryOffset()
 
 Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
 {
+   R__TRACE_SCOPE("io", "TBasket::ReadBasketBuffers");
    if(!fBranch->GetDirectory()) {
       return -1;
    }
@@ -471,6 +498,13 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
    char *rawUncompressedBuffer, *rawCompressedBuffer;
    Int_t uncompressedBufferLen;
 
+   // Per-branch monitoring, only if the tree has perf stats.
+   TVirtualPerfStats *branchPerfStats = fBranch->GetTree()->GetPerfStats();
+   Double_t readStart = 0;
+   if (R__unlikely(branchPerfStats)) {
+      readStart = TTimeStamp();
+   }
+
    // See if the cache has already unzipped the buffer for us.
    TFileCacheRead *pf = nullptr;
    {
@@ -483,6 +517,9 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
       char *buffer = nullptr;
       res = pf->GetUnzipBuffer(&buffer, pos, len, &free);
       if (R__unlikely(res >= 0)) {
+         if (R__unlikely(branchPerfStats)) {
+            branchPerfStats->BasketReadEvent(fBranch, len, readStart, kTRUE);
+         }
          len = ReadBasketBuffersUnzip(buffer, res, free, file);
          // Note that in the kNotDecompressed case, the above function will return 0;
          // In such a case, we should stop processing
@@ -539,6 +576,9 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
          }
       }
       gPerfStats = temp;
+      if (R__unlikely(branchPerfStats)) {
+         branchPerfStats->BasketReadEvent(fBranch, len, readStart, st > 0);
+      }
    } else {
       // Read from the file and unstream the header information.
       TVirtualPerfStats* temp = gPerfStats;
@@ -549,6 +589,9 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
          return 1;
       }
       else gPerfStats = temp;
+      if (R__unlikely(branchPerfStats)) {
+         branchPerfStats->BasketReadEvent(fBranch, len, readStart, kFALSE);
+      }
    }
    Streamer(*readBufferRef);
    if (IsZombie()) {
@@ -595,9 +638,10 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
 
       // Optional monitor for zip time profiling.
       Double_t start = 0;
-      if (R__unlikely(gPerfStats)) {
+      if (R__unlikely(gPerfStats || branchPerfStats)) {
          start = TTimeStamp();
       }
+      R__TRACE_SCOPE("unzip", "TBasket::Unzip");
 
       memcpy(rawUncompressedBuffer, rawCompressedBuffer, fKeylen);
       char *rawUncompressedObjectBuffer = rawUncompressedBuffer+fKeylen;
@@ -605,6 +649,9 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
       Int_t nin, nbuf;
       Int_t nout = 0, noutot = 0, nintot = 0;
 
+      // Baskets written after training the branch's dictionary need it to be decompressed.
+      const std::vector<char> &dict = fBranch->GetCompressionDictionary();
+
       // Unzip all the compressed objects in the compressed object buffer.
       while (1) {
          // Check the header for errors.
@@ -618,7 +665,8 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
             goto AfterBuffer;
          }
 
-         R__unzip(&nin, rawCompressedObjectBuffer, &nbuf, (unsigned char*) rawUncompressedObjectBuffer, &nout);
+         R__unzipDict(&nin, rawCompressedObjectBuffer, &nbuf, (unsigned char *)rawUncompressedObjectBuffer, &nout,
+                      dict.empty() ? nullptr : dict.data(), dict.size());
          if (!nout) break;
          noutot += nout;
          nintot += nin;
@@ -640,6 +688,9 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
          gPerfStats->UnzipEvent(fBranch->GetTree(),pos,start,nintot,fObjlen);
       }
       gPerfStats = temp;
+      if (R__unlikely(branchPerfStats)) {
+         branchPerfStats->BasketUnzipEvent(fBranch, start, nintot, fObjlen);
+      }
    } else {
       // Nothing is compressed - copy over wholesale.
       memcpy(rawUncompressedBuffer, rawCompressedBuffer, len);
@@ -655,12 +706,12 @@ AfterBuffer:
    if (!fBranch->GetEntryOffsetLen() || (fEntryOffset == reinterpret_cast<Int_t *>(-1))) {
       return 0;
    }
-   // At this point, we're required to read out an offset array.
-   ResetEntryOffset(); // TODO: every basket, we reset the offset array.  Is this necessary?
-                       // Could we instead switch to std::vector?
+   // At this point, we're required to read out an offset array.  A basket is
+   // typically read over and over by the same branch: keep the arrays of the
+   // previous read if they are large enough instead of reallocating them.
    fBufferRef->SetBufferOffset(fLast);
-   fBufferRef->ReadArray(fEntryOffset);
-   if (R__unlikely(!fEntryOffset)) {
+   if (R__unlikely(!R__ReadRecycledArray(*fBufferRef, fEntryOffset, fEntryOffsetCapacity))) {
+      ResetEntryOffset();
       fEntryOffset = new Int_t[fNevBuf+1];
       fEntryOffset[0] = fKeylen;
       Warning("ReadBasketBuffers","basket:%s has fNevBuf=%d but fEntryOffset=0, pos=%lld, len=%d, fNbytes=%d, fObjlen=%d, trying to repair",GetName(),fNevBuf,pos,len,fNbytes,fObjlen);
@@ -676,14 +727,14 @@ AfterBuffer:
    }
    fReadEntryOffset = kTRUE;
    // Read the array of diplacement if any.
-   delete [] fDisplacement;
-   fDisplacement = 0;
-   if (fBufferRef->Length() != len) {
-      // There is more data in the buffer!  It is the displacement
-      // array.  If len is less than TBuffer::kMinimalSize the actual
-      // size of the buffer is too large, so we can not use the
-      // fBufferRef->BufferSize()
-      fBufferRef->ReadArray(fDisplacement);
+   // There is more data in the buffer if it holds the displacement
+   // array.  If len is less than TBuffer::kMinimalSize the actual
+   // size of the buffer is too large, so we can not use the
+   // fBufferRef->BufferSize()
+   if (fBufferRef->Length() == len || !R__ReadRecycledArray(*fBufferRef, fDisplacement, fDisplacementCapacity)) {
+      delete [] fDisplacement;
+      fDisplacement = 0;
+      fDisplacementCapacity = 0;
    }
 
    return 0;
@@ -933,6 +984,7 @@ void TBasket::Streamer(TBuffer &b)
          }
          if (flag>40) {
             fDisplacement = new Int_t[fNevBufSize];
+            fDisplacementCapacity = 0;
             b.ReadArray(fDisplacement);
          }
       } else if (mustGenerateOffsets) {
@@ -940,6 +992,7 @@ void TBasket::Streamer(TBuffer &b)
          // displacement array must be zero.
          assert(flag <= 40);
          fEntryOffset = reinterpret_cast<Int_t *>(-1);
+         fEntryOffsetCapacity = 0;
       }
       if (flag == 1 || flag > 10) {
          fBufferRef = new TBufferFile(TBuffer::kRead,fBufferSize);
@@ -1128,6 +1181,7 @@ Int_t TBasket::WriteBuffer()
          fBufferRef->WriteArray(fDisplacement, fNevBuf + 1);
          delete[] fDisplacement;
          fDisplacement = 0;
+         fDisplacementCapacity = 0;
       }
    }
 
@@ -1136,10 +1190,14 @@ Int_t TBasket::WriteBuffer()
    fObjlen    = lbuf - fKeylen;
 
    fHeaderOnly = kTRUE;
-   fCycle = fBranch->GetWriteBasket();
+   if (!fDetached)
+      fCycle = fBranch->GetWriteBasket();
    Int_t cxlevel = fBranch->GetCompressionLevel();
    ROOT::RCompressionSetting::EAlgorithm::EValues cxAlgorithm = static_cast<ROOT::RCompressionSetting::EAlgorithm::EValues>(fBranch->GetCompressionAlgorithm());
    if (cxlevel > 0) {
+      if (cxAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kZSTD)
+         fBranch->AddCompressionDictionarySample(fBufferRef->Buffer() + fKeylen, fObjlen);
+      const std::vector<char> &dict = fBranch->GetCompressionDictionary();
       Int_t nbuffers = 1 + (fObjlen - 1) / kMAXZIPBUF;
       Int_t buflen = fKeylen + fObjlen + 9 * nbuffers + 28; //add 28 bytes in case object is placed in a deleted gap
       InitializeCompressedBuffer(buflen, file);
@@ -1165,7 +1223,8 @@ Int_t TBasket::WriteBuffer()
          // NOTE this is declared with C linkage, so it shouldn't except.  Also, when
          // USE_IMT is defined, we are guaranteed that the compression buffer is unique per-branch.
          // (see fCompressedBufferRef in constructor).
-         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
+         R__zipMultipleAlgorithmDict(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm,
+                                     dict.empty() ? nullptr : dict.data(), dict.size());
 #ifdef R__USE_IMT
          sentry.lock();
 #endif  // R__USE_IMT
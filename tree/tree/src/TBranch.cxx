@@ -15,6 +15,7 @@
 
 #include "Bytes.h"
 #include "Compression.h"
+#include "RZip.h"
 #include "TBasket.h"
 #include "TBranchBrowsable.h"
 #include "TBrowser.h"
@@ -42,6 +43,7 @@
 #include "TTree.h"
 #include "TTreeCache.h"
 #include "TTreeCacheUnzip.h"
+#include "TTimeStamp.h"
 #include "TVirtualMutex.h"
 #include "TVirtualPad.h"
 #include "TVirtualPerfStats.h"
@@ -1560,6 +1562,143 @@ Int_t TBranch::GetEntriesSerialized(Long64_t entry, TBuffer &user_buf, TBuffer *
    return N;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the size in bytes of one element of a branch whose entries are
+/// variable-length arrays of a fundamental type, or 0 if the entries are not
+/// of that kind.  `hasCollectionHeader` is set if each serialized entry starts
+/// with a collection header (byte count, version and number of elements)
+/// rather than with the elements themselves.
+///
+/// The TBranch case is a single leaf with a count leaf, e.g. `px[n]/F`.
+
+Int_t TBranch::GetJaggedElementSize(Bool_t &hasCollectionHeader) const
+{
+   hasCollectionHeader = kFALSE;
+   if (fNleaves != 1)
+      return 0;
+   TLeaf *leaf = static_cast<TLeaf*>(fLeaves.UncheckedAt(0));
+   if (!leaf->GetLeafCount() || (leaf->GetDeserializeType() == TLeaf::DeserializeType::kDestructive))
+      return 0;
+   return leaf->GetLenType() * leaf->GetLenStatic();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns true if the entries of this branch can be read with GetEntriesJagged.
+Bool_t TBranch::SupportsJaggedBulkRead() const {
+   Bool_t hasCollectionHeader;
+   return GetJaggedElementSize(hasCollectionHeader) > 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read all the entries of the basket starting at `entry` of a branch holding
+/// variable-length arrays of a fundamental type: a leaf with a count leaf
+/// such as `px[n]/F` or a `std::vector` of a fundamental type (see
+/// SupportsJaggedBulkRead).
+///
+/// Returns -1 in case of a failure.  On success, returns the number N of
+/// entries read; the caller can then access the elements of all the entries
+/// as one contiguous array, in serialized (big-endian) form, starting at
+/// `user_buf.GetCurrent()`.  The elements of entry `entry + i` are the
+/// elements `offsets[i]` to `offsets[i + 1] - 1`; `offsets` has N + 1 values.
+///
+/// Like GetBulkEntries, this only supports reading from the start of a basket
+/// and is meant to be used by higher-level, type-safe wrappers.
+
+Int_t TBranch::GetEntriesJagged(Long64_t entry, TBuffer &user_buf, std::vector<Int_t> &offsets)
+{
+   Bool_t hasCollectionHeader;
+   const Int_t elemSize = GetJaggedElementSize(hasCollectionHeader);
+   if (R__unlikely(elemSize <= 0)) return -1;
+
+   // Remember which entry we are reading.
+   fReadEntry = entry;
+
+   Bool_t enabled = !TestBit(kDoNotProcess);
+   if (R__unlikely(!enabled)) return -1;
+   TBasket *basket = nullptr;
+   Long64_t first;
+   Int_t result = GetBasketAndFirst(basket, first, &user_buf);
+   if (R__unlikely(result <= 0)) return -1;
+   // Only support reading from full clusters.
+   if (R__unlikely(entry != first)) {
+      Error("GetEntriesJagged", "Failed to read from full cluster; first entry is %lld; requested entry is %lld.\n", first, entry);
+      return -1;
+   }
+
+   basket->PrepareBasket(entry);
+   TBuffer* buf = basket->GetBufferRef();
+
+   // Test for very old ROOT files.
+   if (R__unlikely(!buf)) {
+      Error("GetEntriesJagged", "Failed to get a new buffer.\n");
+      return -1;
+   }
+   // Test for displacements, which aren't supported in fast mode.
+   if (R__unlikely(basket->GetDisplacement())) {
+      Error("GetEntriesJagged", "Basket has displacement.\n");
+      return -1;
+   }
+   Int_t *entryOffset = basket->GetEntryOffset();
+   if (R__unlikely(!entryOffset)) {
+      Error("GetEntriesJagged", "Basket has no entry offsets.\n");
+      return -1;
+   }
+
+   Int_t N = ((fNextBasketEntry < 0) ? fEntryNumber : fNextBasketEntry) - first;
+   if (R__unlikely(N > basket->GetNevBuf())) return -1;
+
+   // Collection header of a std::vector: byte count | kByteCountMask, version, number of elements
+   constexpr UInt_t kByteCountMask = 0x40000000;
+   constexpr Int_t kCollectionHeaderSize = sizeof(UInt_t) + sizeof(Version_t) + sizeof(Int_t);
+
+   // Move the elements of all entries next to each other, in place, dropping the collection headers
+   char *buffer = buf->Buffer();
+   const Int_t bufbegin = basket->GetKeylen();
+   Int_t dest = bufbegin;
+   Int_t nElements = 0;
+   offsets.resize(N + 1);
+   for (Int_t i = 0; i < N; ++i) {
+      Int_t start = entryOffset[i];
+      const Int_t end = (i + 1 < basket->GetNevBuf()) ? entryOffset[i + 1] : basket->GetLast();
+      if (hasCollectionHeader) {
+         char *header = buffer + start;
+         UInt_t byteCount;
+         Version_t version;
+         Int_t n;
+         frombuf(header, &byteCount);
+         frombuf(header, &version);
+         frombuf(header, &n);
+         if (R__unlikely(!(byteCount & kByteCountMask) ||
+                         (start + kCollectionHeaderSize + Long64_t(n) * elemSize != end))) {
+            Error("GetEntriesJagged", "Unexpected serialization of entry %lld.\n", entry + i);
+            return -1;
+         }
+         start += kCollectionHeaderSize;
+      }
+      const Int_t len = end - start;
+      if (R__unlikely((len < 0) || (len % elemSize))) {
+         Error("GetEntriesJagged", "Unexpected size of entry %lld.\n", entry + i);
+         return -1;
+      }
+      offsets[i] = nElements;
+      if (dest != start)
+         memmove(buffer + dest, buffer + start, len);
+      dest += len;
+      nElements += len / elemSize;
+   }
+   offsets[N] = nElements;
+   user_buf.SetBufferOffset(bufbegin);
+
+   // The basket content was rearranged, it must not be used for regular reading anymore.
+   fCurrentBasket = nullptr;
+   fBaskets[fReadBasket] = nullptr;
+   R__ASSERT(fExtraBasket == nullptr && "fExtraBasket should have been set to nullptr by GetFreshBasket");
+   fExtraBasket = basket;
+   basket->DisownBuffer();
+
+   return N;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read all leaves of entry and return total number of bytes read.
 ///
@@ -1626,7 +1765,14 @@ Int_t TBranch::GetEntry(Long64_t entry, Int_t getall)
    }
 
    // Int_t bufbegin = buf->Length();
-   (this->*fReadLeaves)(*buf);
+   TVirtualPerfStats *perfStats = fTree->GetPerfStats();
+   if (R__unlikely(perfStats)) {
+      Double_t start = TTimeStamp();
+      (this->*fReadLeaves)(*buf);
+      perfStats->BranchStreamEvent(this, start);
+   } else {
+      (this->*fReadLeaves)(*buf);
+   }
    return buf->Length() - bufbegin;
 }
 
@@ -2645,6 +2791,69 @@ void TBranch::SetCompressionSettings(Int_t settings)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compress the baskets of this branch and of its sub-branches with a ZSTD
+/// dictionary trained from the content of the next `nTrainingBaskets` baskets
+/// written.
+///
+/// Branches with many small baskets of similar content compress much better
+/// with a dictionary. The dictionary, of at most `maxDictSize` bytes, is stored
+/// with the branch and is used for all the baskets written after the training;
+/// the training baskets themselves are compressed without it. The dictionary
+/// is only used if the compression algorithm of the branch is ZSTD.
+/// A branch that already has a dictionary keeps it, as its baskets might
+/// depend on it. `nTrainingBaskets <= 0` stops an ongoing training.
+
+void TBranch::SetCompressionDictionary(Int_t nTrainingBaskets, Int_t maxDictSize)
+{
+   std::vector<char>().swap(fDictSamples);
+   std::vector<size_t>().swap(fDictSampleSizes);
+   fDictTrainBaskets = 0;
+   if (nTrainingBaskets > 0 && maxDictSize > 0) {
+      if (fCompressDict.empty()) {
+         fDictTrainBaskets = nTrainingBaskets;
+         fDictMaxSize = maxDictSize;
+      } else {
+         Warning("SetCompressionDictionary", "Branch %s already has a compression dictionary", GetName());
+      }
+   }
+
+   Int_t nb = fBranches.GetEntriesFast();
+   for (Int_t i=0;i<nb;i++) {
+      TBranch *branch = (TBranch*)fBranches.UncheckedAt(i);
+      branch->SetCompressionDictionary(nTrainingBaskets, maxDictSize);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Collect the uncompressed content of a basket to train the compression
+/// dictionary; trains it once enough baskets are collected.
+
+void TBranch::AddCompressionDictionarySample(const char *buffer, Int_t len)
+{
+   if (fDictTrainBaskets <= 0 || len <= 0)
+      return;
+
+   fDictSamples.insert(fDictSamples.end(), buffer, buffer + len);
+   fDictSampleSizes.push_back(len);
+   if (fDictSampleSizes.size() < (size_t)fDictTrainBaskets)
+      return;
+
+   std::vector<char> dict(fDictMaxSize);
+   Int_t size = R__trainDictZSTD(dict.data(), fDictMaxSize, fDictSamples.data(), fDictSampleSizes.data(),
+                                 fDictSampleSizes.size());
+   if (size > 0) {
+      dict.resize(size);
+      fCompressDict.swap(dict);
+   } else {
+      Warning("AddCompressionDictionarySample",
+              "Could not train a compression dictionary for branch %s, its baskets are compressed without", GetName());
+   }
+   fDictTrainBaskets = 0;
+   std::vector<char>().swap(fDictSamples);
+   std::vector<size_t>().swap(fDictSampleSizes);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Update the default value for the branch's fEntryOffsetLen if and only if
 /// it was already non zero (and the new value is not zero)
@@ -3101,6 +3310,92 @@ Int_t TBranch::WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBr
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Take the current write basket away from the branch so that it can be
+/// written asynchronously, i.e. while the branch keeps filling a new basket.
+/// Used by TTree::FlushBasketsAsync.
+///
+/// Returns the basket and sets `where` to its index in the basket arrays, or
+/// returns nullptr if there is nothing to write.  The location of the basket
+/// on disk is set once the write is completed by AttachWrittenBasket.
+
+TBasket *TBranch::DetachWriteBasket(Int_t &where)
+{
+   TBasket *basket = (TBasket*)fBaskets.UncheckedAt(fWriteBasket);
+   if (!fDirectory || !basket || !basket->GetNevBuf() || fBasketSeek[fWriteBasket] != 0)
+      return nullptr;
+   if (basket->GetBufferRef()->IsReading()) {
+      basket->SetWriteMode();
+   }
+
+   Int_t nevbuf = basket->GetNevBuf();
+   if (fEntryOffsetLen > 10 &&  (4*nevbuf) < fEntryOffsetLen ) {
+      fEntryOffsetLen = nevbuf < 3 ? 10 : 4*nevbuf;
+   } else if (fEntryOffsetLen && nevbuf > fEntryOffsetLen) {
+      fEntryOffsetLen = 2*nevbuf;
+   }
+
+   // The compression buffer is by default shared by all the baskets of the branch; the
+   // detached basket is compressed concurrently with the next one and needs its own.
+   if (!basket->fOwnsCompressedBuffer) {
+      basket->fCompressedBufferRef = new TBufferFile(TBuffer::kRead, basket->GetBufferSize());
+      basket->fOwnsCompressedBuffer = kTRUE;
+   }
+   basket->fCycle = fWriteBasket;
+   basket->fDetached = kTRUE;
+
+   where = fWriteBasket;
+   fBaskets[where] = 0;
+   --fNBaskets;
+   if (basket == fCurrentBasket) {
+      fCurrentBasket    = 0;
+      fFirstBasketEntry = -1;
+      fNextBasketEntry  = -1;
+   }
+   ++fWriteBasket;
+   if (fWriteBasket >= fMaxBaskets) {
+      ExpandBasketArrays();
+   }
+   fBasketEntry[fWriteBasket] = fEntryNumber;
+   return basket;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Complete the asynchronous write of a basket returned by DetachWriteBasket:
+/// record its location on disk and update the byte counters.  `nout` is the
+/// result of the basket's WriteBuffer.  The basket is reused as the next write
+/// basket if the branch did not create one in the meantime, otherwise it is
+/// deleted.  Returns `nout`.
+
+Int_t TBranch::AttachWrittenBasket(TBasket *basket, Int_t where, Int_t nout)
+{
+   basket->fDetached = kFALSE;
+   if (nout < 0) Error("TBranch::AttachWrittenBasket", "basket's WriteBuffer failed.\n");
+   fBasketBytes[where]  = basket->GetNbytes();
+   fBasketSeek[where]   = basket->GetSeekKey();
+   if (nout > 0) {
+      Int_t addbytes = basket->GetObjlen() + basket->GetKeylen();
+      fZipBytes += nout;
+      fTotBytes += addbytes;
+      fTree->AddTotBytes(addbytes);
+      fTree->AddZipBytes(nout);
+
+      basket->Reset();
+#ifdef R__TRACK_BASKET_ALLOC_TIME
+      fTree->AddAllocationTime(basket->GetResetAllocationTime());
+#endif
+      fTree->AddAllocationCount(basket->GetResetAllocationCount());
+      if (!fBaskets.UncheckedAt(fWriteBasket)) {
+         ++fNBaskets;
+         fBaskets.AddAtAndExpand(basket, fWriteBasket);
+         return nout;
+      }
+   }
+   basket->DropBuffers();
+   delete basket;
+   return nout;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///set the first entry number (case of TBranchSTL)
 
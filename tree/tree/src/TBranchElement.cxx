@@ -962,6 +962,8 @@ void TBranchElement::Init(TTree *tree, TBranch *parent, const char* bname, TVirt
 
 TBranchElement::~TBranchElement()
 {
+   ReleaseRecycledObjects();
+
    // Release any allocated I/O buffers.
    if (fOnfileObject && TestBit(kOwnOnfileObj)) {
       delete fOnfileObject;
@@ -2760,6 +2762,35 @@ Bool_t TBranchElement::GetMakeClass() const
    return TestBit(kDecomposedObj); // Same as TestBit(kMakeClass)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the element size of a branch holding a `std::vector` of a
+/// fundamental type, either as a top-level branch or as a data member of a
+/// split object, or 0 otherwise. See TBranch::GetJaggedElementSize.
+
+Int_t TBranchElement::GetJaggedElementSize(Bool_t &hasCollectionHeader) const
+{
+   hasCollectionHeader = kTRUE;
+   if (fType != 0 || fBranches.GetEntriesFast() || TestBit(kDecomposedObj))
+      return 0;
+
+   TClass *cl = nullptr;
+   if (fID < 0) {
+      cl = fBranchClass.GetClass();
+   } else if (fStreamerType == TVirtualStreamerInfo::kSTL) {
+      TStreamerInfo *info = GetInfoImp();
+      TStreamerElement *element = info ? info->GetElement(fID) : nullptr;
+      cl = element ? element->GetClassPointer() : nullptr;
+   }
+   TVirtualCollectionProxy *proxy = cl ? cl->GetCollectionProxy() : nullptr;
+   if (!proxy || proxy->GetCollectionType() != ROOT::kSTLvector || proxy->GetValueClass() ||
+       proxy->HasPointers() || proxy->GetType() == kBool_t || proxy->GetType() == kDouble32_t ||
+       proxy->GetType() == kFloat16_t) {
+      return 0;
+   }
+   TDataType *dt = TDataType::GetDataType(proxy->GetType());
+   return dt ? dt->Size() : 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return maximum count value of the branchcount if any.
 
@@ -4191,6 +4222,24 @@ void TBranchElement::ReadLeavesCollection(TBuffer& b)
    // TODO: Exception safety a la TPushPop
    TVirtualCollectionProxy* proxy = GetCollectionProxy();
    TVirtualCollectionProxy::TPushPop helper(proxy, fObject);
+   const Bool_t recycle = fRecycleObjects && proxy->HasPointers() && fSplitLevel > TTree::kSplitCollectionOfPointers &&
+                          (fSTLtype == ROOT::kSTLvector || fSTLtype == ROOT::kSTLlist || fSTLtype == ROOT::kSTLdeque);
+   if (recycle) {
+      // Take the elements of the previous entry out of the collection, such
+      // that Allocate does not delete them. They are kept in reverse order
+      // to be put back at the same position.
+      if (proxy->GetValueClass() != fRecycledClass.GetClass()) {
+         ReleaseRecycledObjects();
+         fRecycledClass = proxy->GetValueClass();
+      }
+      for (Int_t i = proxy->Size() - 1; i >= 0; --i) {
+         void **el = (void**)proxy->At(i);
+         if (*el) {
+            fRecycledObjects.push_back(*el);
+            *el = nullptr;
+         }
+      }
+   }
    void* alternate = proxy->Allocate(fNdata, true);
    if(fSTLtype != ROOT::kSTLvector && proxy->HasPointers() && fSplitLevel > TTree::kSplitCollectionOfPointers ) {
       fPtrIterators->CreateIterators(alternate, proxy);
@@ -4242,6 +4291,11 @@ void TBranchElement::ReadLeavesCollection(TBuffer& b)
       for( ; i < fNdata; ++i )
       {
          void **el = (void**)proxy->At( i );
+         if (recycle && !fRecycledObjects.empty()) {
+            *el = fRecycledObjects.back();
+            fRecycledObjects.pop_back();
+            continue;
+         }
          // coverity[dereference] since this is a member streaming action by definition the collection contains objects and elClass is not null.
          *el = elClass->New();
       }
@@ -5472,6 +5526,38 @@ void TBranchElement::SetObject(void* obj)
    SetAddress( &fObject );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Reuse the elements of a split collection of pointers (e.g. a
+/// `std::vector<MyClass*>` with a split level above
+/// TTree::kSplitCollectionOfPointers) across entries.
+///
+/// By default, reading an entry deletes the objects of the previous entry
+/// and creates new ones with TClass::New. With recycling, the objects of
+/// the previous entry are kept and handed out again, in the same order,
+/// similar to what TClonesArray does: their data members are overwritten
+/// by the values read, data members that are not read keep their values.
+/// This only applies to sequence containers (vector, list and deque); the
+/// objects kept are deleted with the branch or by `SetRecycleObjects(kFALSE)`.
+
+void TBranchElement::SetRecycleObjects(Bool_t recycle /* = kTRUE */)
+{
+   fRecycleObjects = recycle;
+   if (!recycle)
+      ReleaseRecycledObjects();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete the objects kept for reuse by SetRecycleObjects().
+
+void TBranchElement::ReleaseRecycledObjects()
+{
+   if (TClass *cl = fRecycledClass.GetClass()) {
+      for (auto obj : fRecycledObjects)
+         cl->Destructor(obj);
+   }
+   fRecycledObjects.clear();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set offset of the object (to which the data member represented by this
 /// branch belongs) inside its containing object (if any).
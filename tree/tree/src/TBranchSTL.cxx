@@ -410,6 +410,8 @@ Int_t TBranchSTL::GetEntry( Long64_t entry, Int_t getall )
       fObject = *(char**)fAddress;
    }
    TVirtualCollectionProxy::TPushPop helper( fCollProxy, fObject );
+   if( fRecycleObjects && elClass )
+      RecycleElements( elClass );
    void* env = fCollProxy->Allocate( size, kTRUE );
 
    //---------------------------------------------------------------------------
@@ -510,6 +512,46 @@ Int_t TBranchSTL::GetEntry( Long64_t entry, Int_t getall )
    return totalBytes;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Hand the elements of the collection over to the element branches of their
+/// actual class, which reuse them for the next entry instead of creating new
+/// objects; the collection proxy must have been pushed to the collection.
+
+void TBranchSTL::RecycleElements( TClass* elClass )
+{
+   Int_t type = fCollProxy->GetCollectionType();
+   if( type != ROOT::kSTLvector && type != ROOT::kSTLlist && type != ROOT::kSTLdeque )
+      return;
+
+   UInt_t nBranches = fBranches.GetEntriesFast();
+
+   //---------------------------------------------------------------------------
+   // Walk backwards such that the element branches get the objects back in
+   // the order of the collection
+   //---------------------------------------------------------------------------
+   for( Int_t i = fCollProxy->Size() - 1; i >= 0; --i ) {
+      void** element = (void**)fCollProxy->At(i);
+      if( !*element )
+         continue;
+
+      TClass* actClass = elClass->GetActualClass( *element );
+      for( UInt_t j = 0; j < nBranches; ++j ) {
+         TBranchElement* elemBranch = (TBranchElement*)fBranches.UncheckedAt(j);
+         TVirtualCollectionProxy* proxy = elemBranch->GetCollectionProxy();
+         if( !proxy || proxy->GetValueClass() != actClass )
+            continue;
+
+         if( elemBranch->fRecycledClass.GetClass() != actClass ) {
+            elemBranch->ReleaseRecycledObjects();
+            elemBranch->fRecycledClass = actClass;
+         }
+         elemBranch->fRecycledObjects.push_back( ((char*)*element) + actClass->GetBaseClassOffset( elClass ) );
+         *element = 0;
+         break;
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Fill expectedClass and expectedType with information on the data type of the
 /// object/values contained in this branch (and thus the type of pointers
@@ -655,6 +697,19 @@ void TBranchSTL::FillLeavesImpl( TBuffer& b )
    b.WriteClassBuffer( fIndArrayCl, &fInd );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Reuse the objects pointed to by the collection across entries, see
+/// TBranchElement::SetRecycleObjects(): the objects of the previous entry
+/// are handed out again, per actual class, instead of being deleted and
+/// created anew. This only applies to vectors, lists and deques.
+
+void TBranchSTL::SetRecycleObjects( Bool_t recycle /* = kTRUE */ )
+{
+   fRecycleObjects = recycle;
+   for( Int_t i = 0; i < fBranches.GetEntriesFast(); ++i )
+      ((TBranchElement*)fBranches.UncheckedAt(i))->SetRecycleObjects( recycle );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set Address.
 
@@ -61,6 +61,11 @@ the trees in the chain.
 #include "strlcpy.h"
 #include "snprintf.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include <vector>
+#endif
+
 ClassImp(TChain);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -929,6 +934,23 @@ TTree::TClusterIterator TChain::GetClusterIterator(Long64_t /* firstentry */)
    return TTree::GetClusterIterator(-1);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Retrieve the minimum and maximum value of branch 'bname' in the cluster of
+/// entries containing the chain entry 'entry' (see TTree::AddClusterStatistics()).
+///
+/// The tree containing the entry is loaded. Returns the end (exclusive) of the
+/// cluster of entries as a chain entry number, or -1 if no statistics are
+/// available for this branch and entry.
+
+Long64_t TChain::GetClusterStatistics(const char *bname, Long64_t entry, Double_t &min, Double_t &max)
+{
+   const Long64_t localEntry = LoadTree(entry);
+   if (localEntry < 0 || !fTree)
+      return -1;
+   const Long64_t localEnd = fTree->GetClusterStatistics(bname, localEntry, min, max);
+   return localEnd < 0 ? -1 : entry + (localEnd - localEntry);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return absolute entry number in the chain.
 /// The input parameter entry is the entry number in
@@ -954,11 +976,65 @@ Long64_t TChain::GetEntries() const
       return fProofChain->GetEntries();
    }
    if (fEntries == TTree::kMaxEntries) {
-      const_cast<TChain*>(this)->LoadTree(TTree::kMaxEntries-1);
+      if (!const_cast<TChain*>(this)->ScanEntriesMT())
+         const_cast<TChain*>(this)->LoadTree(TTree::kMaxEntries-1);
    }
    return fEntries;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the number of entries of all the trees whose number of entries is
+/// not yet known, opening their files in parallel on the implicit
+/// multi-threading pool, and update the tree offsets and the number of
+/// entries of the chain.
+///
+/// Returns kFALSE if implicit multi-threading is disabled or if any of the
+/// files or trees cannot be opened; nothing is changed in this case and the
+/// caller should fall back to the sequential scan, which reports the error.
+
+Bool_t TChain::ScanEntriesMT()
+{
+#ifdef R__USE_IMT
+   if (!ROOT::IsImplicitMTEnabled() || fNtrees < 2)
+      return kFALSE;
+
+   std::vector<UInt_t> unknown;
+   for (Int_t i = 0; i < fNtrees; ++i) {
+      if (static_cast<TChainElement *>(fFiles->UncheckedAt(i))->GetEntries() == TTree::kMaxEntries)
+         unknown.push_back(i);
+   }
+   if (unknown.size() < 2)
+      return kFALSE;
+
+   std::vector<Long64_t> entries(fNtrees, -1);
+   auto readEntries = [&](UInt_t i) {
+      auto element = static_cast<TChainElement *>(fFiles->UncheckedAt(i));
+      TDirectory::TContext ctxt;
+      std::unique_ptr<TFile> file(TFile::Open(element->GetTitle()));
+      if (!file || file->IsZombie())
+         return;
+      auto tree = file->Get<TTree>(element->GetName());
+      if (tree)
+         entries[i] = tree->GetEntries();
+   };
+   ROOT::TThreadExecutor pool;
+   pool.Foreach(readEntries, unknown);
+
+   for (auto i : unknown) {
+      if (entries[i] < 0)
+         return kFALSE;
+   }
+   for (auto i : unknown)
+      static_cast<TChainElement *>(fFiles->UncheckedAt(i))->SetNumberEntries(entries[i]);
+   for (Int_t i = 0; i < fNtrees; ++i)
+      fTreeOffset[i + 1] = fTreeOffset[i] + static_cast<TChainElement *>(fFiles->UncheckedAt(i))->GetEntries();
+   fEntries = fTreeOffset[fNtrees];
+   return kTRUE;
+#else
+   return kFALSE;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Get entry from the file to memory.
 ///
@@ -544,6 +544,33 @@ Int_t TEntryList::Contains(Long64_t entry, TTree *tree)
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the list contains at least one entry from entrymin to
+/// entrymax included. If the list has sub-lists, the entries are local to the
+/// tree of the current sub-list.
+/// Used by TTreeCache to only read the baskets holding entries of the list.
+
+Bool_t TEntryList::ContainsRange(Long64_t entrymin, Long64_t entrymax)
+{
+   if (fLists) {
+      if (!fCurrent) fCurrent = (TEntryList*)fLists->First();
+      return fCurrent ? fCurrent->ContainsRange(entrymin, entrymax) : kFALSE;
+   }
+   if (!fBlocks || entrymax < entrymin) return kFALSE;
+   if (entrymin < 0) entrymin = 0;
+   Int_t nfirst = entrymin/kBlockSize;
+   Int_t nlast = TMath::Min(Long64_t(fNBlocks - 1), entrymax/kBlockSize);
+   for (Int_t nblock = nfirst; nblock <= nlast; nblock++) {
+      TEntryListBlock *block = (TEntryListBlock*)fBlocks->UncheckedAt(nblock);
+      if (!block) continue;
+      Long64_t blockstart = Long64_t(nblock)*kBlockSize;
+      Int_t bmin = TMath::Max(entrymin, blockstart) - blockstart;
+      Int_t bmax = TMath::Min(entrymax, blockstart + kBlockSize - 1) - blockstart;
+      if (block->ContainsRange(bmin, bmax)) return kTRUE;
+   }
+   return kFALSE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Called by TKey and others to automatically add us to a directory when we are read from a file.
 
@@ -1239,13 +1266,18 @@ void TEntryList::Subtract(const TEntryList *elist)
          //second list is also only for 1 tree
          if (!strcmp(elist->fTreeName.Data(),fTreeName.Data()) &&
              !strcmp(elist->fFileName.Data(),fFileName.Data())){
-            //same tree
-            Long64_t n2 = elist->GetN();
-            Long64_t entry;
-            for (Int_t i=0; i<n2; i++){
-               entry = (const_cast<TEntryList*>(elist))->GetEntry(i);
-               Remove(entry);
+            //same tree, subtract block by block
+            if (!elist->fBlocks) return;
+            Int_t nmin = TMath::Min(fNBlocks, elist->fNBlocks);
+            for (Int_t i=0; i<nmin; i++){
+               TEntryListBlock *block1 = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+               TEntryListBlock *block2 = (TEntryListBlock*)elist->fBlocks->UncheckedAt(i);
+               if (!block1 || !block2) continue;
+               Long64_t nold = block1->GetNPassed();
+               fN = fN - nold + block1->Subtract(block2);
             }
+            fLastIndexQueried = -1;
+            fLastIndexReturned = 0;
          } else {
             //different trees
             return;
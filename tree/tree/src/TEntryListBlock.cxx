@@ -45,9 +45,46 @@ End_Macro
 
 #include "TEntryListBlock.h"
 #include "TString.h"
+#include "TMath.h"
+
+#include <algorithm>
 
 ClassImp(TEntryListBlock);
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of bits set in a word of the bits representation
+
+inline Int_t CountBits(UShort_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   return __builtin_popcount(word);
+#else
+   Int_t n = 0;
+   for (; word; word &= word - 1)
+      n++;
+   return n;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Position of the lowest bit set in a non-zero word of the bits representation
+
+inline Int_t LowestBit(UShort_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   return __builtin_ctz(word);
+#else
+   Int_t j = 0;
+   while ((word & (1 << j)) == 0)
+      j++;
+   return j;
+#endif
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default c-tor
 
@@ -236,13 +273,48 @@ Int_t TEntryListBlock::Contains(Int_t entry)
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// True if the block contains at least one entry from entrymin to entrymax included
+
+Bool_t TEntryListBlock::ContainsRange(Int_t entrymin, Int_t entrymax)
+{
+   if (entrymin < 0)
+      entrymin = 0;
+   if (entrymax >= kBlockSize*16)
+      entrymax = kBlockSize*16 - 1;
+   if (entrymin > entrymax)
+      return kFALSE;
+   if (!fIndices)
+      return !fPassing;
+   if (fType==0){
+      //bits, skip whole words
+      for (Int_t entry = entrymin; entry <= entrymax; ) {
+         Int_t i = entry>>4;
+         Int_t j = entry & 15;
+         Int_t last = TMath::Min(entrymax, i*16 + 15) - i*16;
+         UShort_t mask = UShort_t((0xFFFF << j) & (0xFFFF >> (15 - last)));
+         if (fIndices[i] & mask)
+            return kTRUE;
+         entry = (i+1)*16;
+      }
+      return kFALSE;
+   }
+   //list, the indices are sorted
+   UShort_t *first = std::lower_bound(fIndices, fIndices + fNPassed, entrymin);
+   UShort_t *last = std::upper_bound(first, fIndices + fNPassed, entrymax);
+   if (fPassing)
+      return first != last;
+   //the indices are the entries that don't pass
+   return (last - first) < (entrymax - entrymin + 1);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Merge with the other block
 /// Returns the resulting number of entries in the block
 
 Int_t TEntryListBlock::Merge(TEntryListBlock *block)
 {
-   Int_t i, j;
+   Int_t i;
    if (block->GetNPassed() == 0) return GetNPassed();
    if (GetNPassed() == 0){
       //this block is empty
@@ -260,33 +332,25 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
    }
    if (fType==0){
       //stored as bits
-      if (block->fType == 0){
-         for (i=0; i<kBlockSize*16; i++){
-            if (block->Contains(i))
-               Enter(i);
+      if (block->fType == 0 || !block->fPassing){
+         //union of the words, the loop is vectorized by the compiler;
+         //a block storing the entries that don't pass is brought to bits in a copy
+         TEntryListBlock other;
+         const UShort_t *bits = block->fIndices;
+         if (block->fType != 0) {
+            other = *block;
+            other.Transform(1, new UShort_t[kBlockSize]);
+            bits = other.fIndices;
          }
+         for (i=0; i<kBlockSize; i++)
+            fIndices[i] |= bits[i];
+         fNPassed = 0;
+         for (i=0; i<kBlockSize; i++)
+            fNPassed += CountBits(fIndices[i]);
       } else {
-         if (block->fPassing){
-            //the other block stores entries that pass
-            for (i=0; i<block->fNPassed; i++){
-               Enter(block->fIndices[i]);
-            }
-         } else {
-            //the other block stores entries that don't pass
-            if (block->fNPassed==0){
-               for (i=0; i<kBlockSize*16; i++){
-                  Enter(i);
-               }
-            }
-            for (j=0; j<block->fIndices[0]; j++)
-               Enter(j);
-            for (i=0; i<block->fNPassed-1; i++){
-               for (j=block->fIndices[i]+1; j<block->fIndices[i+1]; j++){
-                  Enter(j);
-               }
-            }
-            for (j=block->fIndices[block->fNPassed-1]+1; j<kBlockSize*16; j++)
-               Enter(j);
+         //the other block stores entries that pass
+         for (i=0; i<block->fNPassed; i++){
+            Enter(block->fIndices[i]);
          }
       }
    } else {
@@ -313,7 +377,7 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
                   newpos++;
                   elpos++;
                }
-               if (fIndices[i] == elst[elpos]) elpos++;
+               if (elpos < en && fIndices[i] == elst[elpos]) elpos++;
                newlist[newpos] = fIndices[i];
                newpos++;
             }
@@ -341,7 +405,7 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
                   current++;
                   newpos++;
                }
-               if (fIndices[current]==i) current++;
+               if (current < fNPassed && fIndices[current]==i) current++;
                newlist[newpos] = i;
                newpos++;
             }
@@ -363,6 +427,38 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
    return GetNPassed();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Remove all the entries of the other block from this block
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Subtract(TEntryListBlock *block)
+{
+   Int_t i;
+   if (GetNPassed() == 0 || block->GetNPassed() == 0) return GetNPassed();
+   if (fType != 0) {
+      //change to bits
+      UShort_t *bits = new UShort_t[kBlockSize];
+      Transform(1, bits);
+   }
+   if (block->fType == 0) {
+      for (i=0; i<kBlockSize; i++)
+         fIndices[i] &= ~block->fIndices[i];
+   } else {
+      //bring the other block to bits in a copy, to leave it unchanged
+      TEntryListBlock other(*block);
+      other.Transform(1, new UShort_t[kBlockSize]);
+      for (i=0; i<kBlockSize; i++)
+         fIndices[i] &= ~other.fIndices[i];
+   }
+   fNPassed = 0;
+   for (i=0; i<kBlockSize; i++)
+      fNPassed += CountBits(fIndices[i]);
+   fLastIndexQueried = -1;
+   fLastIndexReturned = -1;
+   OptimizeStorage();
+   return GetNPassed();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the number of entries, passing the selection.
 /// In case, when the block stores entries that pass (fPassing=1) returns fNPassed
@@ -387,14 +483,19 @@ Int_t TEntryListBlock::GetEntry(Int_t entry)
    else {
       Int_t i=0; Int_t j=0; Int_t entries_found=0;
       if (fType==0){
-         if ((fIndices[i] & (1<<j))!=0)
+         //skip whole words until the one holding the requested entry
+         Int_t nbits;
+         while (i < kBlockSize && entries_found + (nbits = CountBits(fIndices[i])) < entry+1) {
+            entries_found += nbits;
+            i++;
+         }
+         if (i == kBlockSize) return -1;
+         UShort_t word = fIndices[i];
+         while (entries_found < entry) {
+            word &= word - 1;
             entries_found++;
-         while (entries_found<entry+1){
-            if (j==15){i++; j=0;}
-            else j++;
-            if ((fIndices[i] & (1<<j))!=0)
-               entries_found++;
          }
+         j = LowestBit(word);
          fLastIndexQueried = entry;
          fLastIndexReturned = i*16+j;
          return fLastIndexReturned;
@@ -454,18 +555,14 @@ Int_t TEntryListBlock::Next()
 
    if (fType==0) {
       //bits
-      Int_t i=0;
-      Int_t j=0;
       fLastIndexReturned++;
-      i = fLastIndexReturned>>4;
-      j = fLastIndexReturned & 15;
-      Bool_t result=(fIndices[i] & (1<<j))!=0;
-      while (result==0){
-         if (j==15) {j=0; i++;}
-         else j++;
-         result = (fIndices[i] & (1<<j))!=0;
-      }
-      fLastIndexReturned = i*16+j;
+      Int_t i = fLastIndexReturned>>4;
+      Int_t j = fLastIndexReturned & 15;
+      //mask the bits before the current position, then skip the empty words
+      UShort_t word = fIndices[i] & (0xFFFF << j);
+      while (word == 0)
+         word = fIndices[++i];
+      fLastIndexReturned = i*16+LowestBit(word);
       fLastIndexQueried++;
       return fLastIndexReturned;
 
@@ -567,19 +664,14 @@ void TEntryListBlock::Transform(Bool_t dir, UShort_t *indexnew)
    Int_t ilist = 0;
    Int_t ibite, ibit;
    if (!dir) {
-         for (i=0; i<kBlockSize*16; i++){
-            ibite = i >> 4;
-            ibit = i & 15;
-            Bool_t result = (fIndices[ibite] & (1<<ibit))!=0;
-            if (result && fPassing){
-               //fill with the entries that pass
-               indexnew[ilist] = i;
-               ilist++;
-            }
-            else if (!result && !fPassing){
-               //fill with the entries that don't pass
-               indexnew[ilist] = i;
+         for (ibite=0; ibite<kBlockSize; ibite++){
+            //fill with the entries that pass or with the entries that don't pass
+            UShort_t word = fPassing ? fIndices[ibite] : UShort_t(~fIndices[ibite]);
+            while (word) {
+               ibit = LowestBit(word);
+               indexnew[ilist] = ibite*16 + ibit;
                ilist++;
+               word &= word - 1;
             }
          }
       if (fIndices)
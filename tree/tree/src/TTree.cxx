@@ -355,6 +355,7 @@ End_Macro
 #include <ROOT/RConfig.hxx>
 #include "TTree.h"
 
+#include "ROOT/RMemoryAccounting.hxx"
 #include "ROOT/TIOFeatures.hxx"
 #include "TArrayC.h"
 #include "TBufferFile.h"
@@ -423,10 +424,12 @@ End_Macro
 #include <cstddef>
 #include <iostream>
 #include <fstream>
+#include <functional>
 #include <sstream>
 #include <string>
 #include <cstdio>
 #include <climits>
+#include <limits>
 #include <algorithm>
 #include <set>
 
@@ -447,6 +450,11 @@ ClassImp(TTree);
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+static void R__AccountBasketBuffers(Long64_t nbytes)
+{
+   ROOT::Experimental::RMemoryAccounting::Add(ROOT::Experimental::RMemoryAccounting::ESubsystem::kBaskets, nbytes);
+}
+
 static char DataTypeToChar(EDataType datatype)
 {
    // Return the leaflist 'char' for a given datatype.
@@ -917,6 +925,7 @@ TTree::~TTree()
 #endif
    }
 
+   FinishAsyncFlush();
    if (fDirectory) {
       // We are in a directory, which may possibly be a file.
       if (fDirectory->GetList()) {
@@ -1009,6 +1018,8 @@ TTree::~TTree()
       delete fTransientBuffer;
       fTransientBuffer = 0;
    }
+   // The baskets still counted are gone with the branches
+   R__AccountBasketBuffers(-fTotalBuffers);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1109,6 +1120,50 @@ Int_t TTree::AddBranchToCache(TBranch *b, Bool_t subbranches)
    return tc->AddBranch(b,subbranches);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Record the minimum and maximum value of branch 'bname' in each cluster of
+/// entries written by Fill().
+///
+/// Readers use these statistics to skip the clusters of entries that a
+/// selection on the branch cannot accept, e.g. RDataFrame skips the clusters
+/// that a leading `Filter("run > 100")` rejects as a whole. This is effective
+/// for branches whose values are sorted or grouped along the entries, like a
+/// run number or a timestamp. The statistics are stored with the tree header.
+///
+/// The branch must hold a single numeric value per entry, and the statistics
+/// must be requested before the first call to Fill().
+///
+/// Returns:
+/// - 0 statistics are recorded for the branch
+/// - -1 on error
+
+Int_t TTree::AddClusterStatistics(const char *bname)
+{
+   if (fEntries > 0) {
+      Error("AddClusterStatistics", "Statistics of branch %s cannot be added after the first entry is filled", bname);
+      return -1;
+   }
+   TBranch *branch = GetBranch(bname);
+   if (!branch) {
+      Error("AddClusterStatistics", "Unknown branch -> %s", bname);
+      return -1;
+   }
+   if (std::find(fClusterStatsBranches.begin(), fClusterStatsBranches.end(), branch->GetName()) !=
+       fClusterStatsBranches.end())
+      return 0;
+   TObjArray *leaves = branch->GetListOfLeaves();
+   TLeaf *leaf = leaves->GetEntriesFast() == 1 ? static_cast<TLeaf *>(leaves->UncheckedAt(0)) : nullptr;
+   if (!leaf || leaf->GetLeafCount() || leaf->GetLenStatic() != 1 || leaf->InheritsFrom(TLeafElement::Class()) ||
+       leaf->InheritsFrom(TLeafObject::Class()) || leaf->InheritsFrom(TLeafC::Class())) {
+      Error("AddClusterStatistics", "Branch %s does not hold a single numeric value per entry", bname);
+      return -1;
+   }
+   fClusterStatsBranches.emplace_back(branch->GetName());
+   // the transient state is set up again by the next Fill
+   fClusterStatsLeaves.clear();
+   return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Remove the branch with name 'bname' from the Tree cache.
 /// If bname="*" all branches are removed from the cache.
@@ -1488,6 +1543,8 @@ Long64_t TTree::AutoSave(Option_t* option)
    if (opt.Contains("flushbaskets")) {
       if (gDebug > 0) Info("AutoSave", "calling FlushBaskets \n");
       FlushBasketsImpl();
+   } else {
+      FinishAsyncFlush();
    }
 
    fSavedBytes = GetZipBytes();
@@ -3449,9 +3506,11 @@ namespace {
 ///
 /// Returns number of bytes copied to this tree.
 ///
-/// If 'option' contains the word 'fast' and nentries is -1, the cloning will be
-/// done without unzipping or unstreaming the baskets (i.e., a direct copy of the
-/// raw bytes on disk).
+/// If 'option' contains the word 'fast', the cloning will be done without
+/// unzipping or unstreaming the baskets (i.e., a direct copy of the raw bytes
+/// on disk). If nentries is smaller than the number of entries of the tree,
+/// only the entries sharing a basket with the first entry not copied are
+/// unzipped and filled again (see TTreeCloner::AddEntryRange).
 ///
 /// When 'fast' is specified, 'option' can also contains a sorting order for the
 /// baskets in the output file.
@@ -3522,13 +3581,15 @@ Long64_t TTree::CopyEntries(TTree* tree, Long64_t nentries /* = -1 */, Option_t*
       nentries = treeEntries;
    }
 
-   if (fastClone && (nentries < 0 || nentries == tree->GetEntriesFast())) {
+   if (fastClone) {
       // Quickly copy the basket without decompression and streaming.
       Long64_t totbytes = GetTotBytes();
       for (Long64_t i = 0; i < nentries; i += tree->GetTree()->GetEntries()) {
          if (tree->LoadTree(i) < 0) {
             break;
          }
+         // Number of entries to copy from the current tree
+         Long64_t tentries = TMath::Min(tree->GetTree()->GetEntries(), nentries - i);
          if ( withIndex ) {
             withIndex = R__HandleIndex( onIndexError, this, tree );
          }
@@ -3542,19 +3603,23 @@ Long64_t TTree::CopyEntries(TTree* tree, Long64_t nentries /* = -1 */, Option_t*
          }
          TTreeCloner cloner(tree->GetTree(), this, option, TTreeCloner::kNoWarnings);
          if (cloner.IsValid()) {
-            this->SetEntries(this->GetEntries() + tree->GetTree()->GetEntries());
+            if (tentries < tree->GetTree()->GetEntries()) {
+               cloner.AddEntryRange(0, tentries);
+            } else {
+               this->SetEntries(this->GetEntries() + tentries);
+            }
             if (cacheSize != -1) cloner.SetCacheSize(cacheSize);
             cloner.Exec();
          } else {
-            if (i == 0) {
+            if (i == 0 && nentries == treeEntries) {
                Warning("CopyEntries","%s",cloner.GetWarning());
                // If the first cloning does not work, something is really wrong
                // (since apriori the source and target are exactly the same structure!)
                return -1;
             } else {
-               if (cloner.NeedConversion()) {
+               // A partial copy is always possible entry by entry, as without 'fast'
+               if (cloner.NeedConversion() || nentries < treeEntries) {
                   TTree *localtree = tree->GetTree();
-                  Long64_t tentries = localtree->GetEntries();
                   for (Long64_t ii = 0; ii < tentries; ii++) {
                      if (localtree->GetEntry(ii) <= 0) {
                         break;
@@ -4272,6 +4337,17 @@ Long64_t TTree::Draw(const char* varexp, const TCut& selection, Option_t* option
 ///
 /// When option contains "norm" the output histogram is normalized to 1.
 ///
+/// ### Compiling the expressions
+///
+/// When option contains "jit", the selection and the variable expressions are
+/// compiled once by the interpreter instead of being interpreted for every
+/// entry (and array element), see TTreeFormula::EnableJit. Expressions that
+/// cannot be compiled, e.g. because they use aliases, strings or function calls,
+/// are interpreted as usual; the result is the same either way.
+/// ~~~ {.cpp}
+///     tree->Draw("sqrt(px*px+py*py)", "abs(eta) < 2.5 && pt > 20", "jit");
+/// ~~~
+///
 /// ### Saving the result of Draw to a TEventList, a TEntryList or a TEntryListArray
 ///
 /// TTree::Draw can be used to fill a TEventList object (list of entry numbers)
@@ -4597,6 +4673,9 @@ Int_t TTree::Fill()
    if (fBranchRef)
       fBranchRef->Fill();
 
+   if (!fClusterStatsBranches.empty())
+      FillClusterStatistics();
+
    ++fEntries;
 
    if (fEntries > fMaxEntries)
@@ -4619,7 +4698,9 @@ Int_t TTree::Fill()
          // or the number of entries written.
          Long64_t zipBytes = GetZipBytes();
 
-         if (fAutoFlush)
+         if (fAdaptiveClusterBytes)
+            autoFlush = GetTotBytes() > fAdaptiveClusterBytes;
+         else if (fAutoFlush)
             autoFlush = fAutoFlush < 0 ? (zipBytes > -fAutoFlush) : fEntries % fAutoFlush == 0;
 
          if (fAutoSave)
@@ -4628,19 +4709,23 @@ Int_t TTree::Fill()
          if (autoFlush || autoSave) {
             // First call FlushBasket to make sure that fTotBytes is up to date.
             FlushBasketsImpl();
+            CloseClusterStatistics();
             autoFlush = false; // avoid auto flushing again later
 
             // When we are in one-basket-per-cluster mode, there is no need to optimize basket:
             // they will automatically grow to the size needed for an event cluster (with the basket
             // shrinking preventing them from growing too much larger than the actually-used space).
             if (!TestBit(TTree::kOnlyFlushAtCluster)) {
-               OptimizeBaskets(GetTotBytes(), 1, "");
+               // In adaptive mode, size the baskets such that a cluster spans fAdaptiveMaxBaskets of them.
+               OptimizeBaskets(fAdaptiveClusterBytes ? GetTotBytes() / fAdaptiveMaxBaskets : GetTotBytes(), 1, "");
                if (gDebug > 0)
                   Info("TTree::Fill", "OptimizeBaskets called at entry %lld, fZipBytes=%lld, fFlushedBytes=%lld\n",
                        fEntries, GetZipBytes(), fFlushedBytes);
             }
             fFlushedBytes = GetZipBytes();
             fAutoFlush = fEntries; // Use test on entries rather than bytes
+            if (fAdaptiveClusters > 0)
+               --fAdaptiveClusters;
 
             // subsequently in run
             if (fAutoSave < 0) {
@@ -4683,7 +4768,14 @@ Int_t TTree::Fill()
    }
 
    if (autoFlush) {
-      FlushBasketsImpl();
+      if (fAdaptiveClusters > 0) {
+         // Flush synchronously while tuning, such that the byte counters include this cluster
+         FlushBasketsImpl();
+         AdaptClusterSize();
+      } else {
+         FlushBasketsAsync();
+      }
+      CloseClusterStatistics();
       if (gDebug > 0)
          Info("TTree::Fill", "FlushBaskets() called at entry %lld, fZipBytes=%lld, fFlushedBytes=%lld\n", fEntries,
               GetZipBytes(), fFlushedBytes);
@@ -5063,8 +5155,13 @@ Int_t TTree::FlushBaskets(Bool_t create_cluster) const
 Int_t TTree::FlushBasketsImpl() const
 {
    if (!fDirectory) return 0;
-   Int_t nbytes = 0;
+   // The baskets of a pending asynchronous flush precede the ones written now.
+   Int_t nbytes = FinishAsyncFlush();
    Int_t nerror = 0;
+   if (nbytes < 0) {
+      nbytes = 0;
+      ++nerror;
+   }
    TObjArray *lb = const_cast<TTree*>(this)->GetListOfBranches();
    Int_t nb = lb->GetEntriesFast();
 
@@ -5116,7 +5213,7 @@ Int_t TTree::FlushBasketsImpl() const
       const_cast<TTree*>(this)->AddTotBytes(fIMTTotBytes);
       const_cast<TTree*>(this)->AddZipBytes(fIMTZipBytes);
 
-      return nerrpar ? -1 : nbpar.load();
+      return (nerror || nerrpar) ? -1 : nbytes + nbpar.load();
    }
 #endif
    for (Int_t j = 0; j < nb; j++) {
@@ -5137,6 +5234,105 @@ Int_t TTree::FlushBasketsImpl() const
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Flush the baskets of the current cluster without waiting for them to be
+/// written, used by the autoflush of TTree::Fill if SetAsyncFlush() is enabled.
+///
+/// Every branch hands its write basket over to a background task, which
+/// compresses and writes it, and continues filling a fresh basket. The flush
+/// is completed, i.e. the basket locations and the byte counters of the tree
+/// are updated, by FinishAsyncFlush() at the next flush or before anything
+/// depending on the written baskets, such as AutoSave(), Write() or
+/// Reset(). Hence at most one flush is in flight and the additional memory
+/// is bounded by one cluster of baskets.
+///
+/// Falls back to the synchronous FlushBasketsImpl() if asynchronous flushing
+/// is disabled or implicit multi-threading is not active.
+///
+/// Return the number of bytes written by the completed previous flush or -1
+/// in case of write error.
+
+Int_t TTree::FlushBasketsAsync()
+{
+#ifdef R__USE_IMT
+   if (!fDirectory || !fAsyncFlush || !ROOT::IsImplicitMTEnabled() || !fIMTEnabled)
+      return FlushBasketsImpl();
+
+   Int_t nbytes = FinishAsyncFlush();
+   Int_t nerror = 0;
+   if (nbytes < 0) {
+      nbytes = 0;
+      ++nerror;
+   }
+
+   std::function<void(TObjArray *)> detach = [&](TObjArray *branches) {
+      Int_t nb = branches->GetEntriesFast();
+      for (Int_t j = 0; j < nb; ++j) {
+         TBranch *branch = (TBranch *)branches->UncheckedAt(j);
+         if (!branch)
+            continue;
+         // Baskets other than the write basket are rare, they are flushed synchronously
+         for (Int_t i = 0; i < branch->GetWriteBasket(); ++i) {
+            if (branch->fBaskets.UncheckedAt(i)) {
+               Int_t nwrite = branch->FlushOneBasket(i);
+               if (nwrite < 0)
+                  ++nerror;
+               else
+                  nbytes += nwrite;
+            }
+         }
+         TAsyncBasket async;
+         async.fBranch = branch;
+         async.fBasket = branch->DetachWriteBasket(async.fWhere);
+         if (async.fBasket)
+            fAsyncBaskets.emplace_back(async);
+         detach(branch->GetListOfBranches());
+      }
+   };
+   detach(GetListOfBranches());
+
+   // fAsyncBaskets does not change anymore until the flush is finished
+   fAsyncFlushHelper.reset(new ROOT::Internal::TBranchIMTHelper());
+   for (auto &async : fAsyncBaskets) {
+      TAsyncBasket *target = &async;
+      fAsyncFlushHelper->Run([target]() {
+         target->fNbytes = target->fBasket->WriteBuffer();
+         return target->fNbytes;
+      });
+   }
+
+   return nerror ? -1 : nbytes;
+#else
+   return FlushBasketsImpl();
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wait for the asynchronous flush in flight, if any, and give the written
+/// baskets back to their branches. See FlushBasketsAsync().
+///
+/// Return the number of bytes written by the flush or -1 in case of write error.
+
+Int_t TTree::FinishAsyncFlush() const
+{
+   if (!fAsyncFlushHelper)
+      return 0;
+   fAsyncFlushHelper->Wait();
+
+   Int_t nbytes = 0;
+   Int_t nerror = 0;
+   for (auto &async : fAsyncBaskets) {
+      Int_t nwrite = async.fBranch->AttachWrittenBasket(async.fBasket, async.fWhere, async.fNbytes);
+      if (nwrite < 0)
+         ++nerror;
+      else
+         nbytes += nwrite;
+   }
+   fAsyncBaskets.clear();
+   fAsyncFlushHelper.reset();
+   return nerror ? -1 : nbytes;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the expanded value of the alias.  Search in the friends if any.
 
@@ -5373,6 +5569,28 @@ TTree::TClusterIterator TTree::GetClusterIterator(Long64_t firstentry)
    return TClusterIterator(this,firstentry);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Retrieve the minimum and maximum value of branch 'bname' in the cluster of
+/// entries containing 'entry' (see AddClusterStatistics()).
+///
+/// Returns the end (exclusive) of the cluster of entries that min and max
+/// refer to, or -1 if no statistics are available for this branch and entry.
+
+Long64_t TTree::GetClusterStatistics(const char *bname, Long64_t entry, Double_t &min, Double_t &max)
+{
+   const auto branchIt = std::find(fClusterStatsBranches.begin(), fClusterStatsBranches.end(), bname);
+   if (branchIt == fClusterStatsBranches.end() || entry < 0)
+      return -1;
+   const auto clusterIt = std::upper_bound(fClusterStatsEnd.begin(), fClusterStatsEnd.end(), entry);
+   if (clusterIt == fClusterStatsEnd.end())
+      return -1;
+   const auto idx = (clusterIt - fClusterStatsEnd.begin()) * fClusterStatsBranches.size() +
+                    (branchIt - fClusterStatsBranches.begin());
+   min = fClusterStatsMin[idx];
+   max = fClusterStatsMax[idx];
+   return *clusterIt;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return pointer to the current file.
 
@@ -6327,9 +6545,24 @@ void TTree::KeepCircular()
       }
    }
    fEntries = maxEntries;
+   // the recorded cluster statistics do not match the remaining entries anymore
+   fClusterStatsEnd.clear();
+   fClusterStatsMin.clear();
+   fClusterStatsMax.clear();
+   fClusterStatsNFills = -1;
    fReadEntry = -1;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Increment the number of bytes in the basket buffers of this tree, which are
+/// also accounted as the baskets of ROOT::Experimental::RMemoryAccounting.
+
+void TTree::IncrementTotalBuffers(Int_t nbytes)
+{
+   fTotalBuffers += nbytes;
+   R__AccountBasketBuffers(nbytes);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read in memory all baskets from all branches up to the limit of maxmemory bytes.
 ///
@@ -7797,6 +8030,7 @@ void TTree::Refresh()
    fTotBytes = tree->GetTotBytes();
    fZipBytes = tree->GetZipBytes();
    fSavedBytes = tree->fSavedBytes;
+   R__AccountBasketBuffers(tree->fTotalBuffers - fTotalBuffers);
    fTotalBuffers = tree->fTotalBuffers.load();
 
    //loop on all branches and update them
@@ -7865,6 +8099,7 @@ void TTree::RemoveFriend(TTree* oldFriend)
 
 void TTree::Reset(Option_t* option)
 {
+   FinishAsyncFlush();
    fNotify        = 0;
    fEntries       = 0;
    fNClusterRange = 0;
@@ -7872,9 +8107,14 @@ void TTree::Reset(Option_t* option)
    fZipBytes      = 0;
    fFlushedBytes  = 0;
    fSavedBytes    = 0;
+   R__AccountBasketBuffers(-fTotalBuffers);
    fTotalBuffers  = 0;
    fChainOffset   = 0;
    fReadEntry     = -1;
+   fClusterStatsEnd.clear();
+   fClusterStatsMin.clear();
+   fClusterStatsMax.clear();
+   fClusterStatsLeaves.clear();
 
    delete fTreeIndex;
    fTreeIndex = 0;
@@ -7902,9 +8142,14 @@ void TTree::ResetAfterMerge(TFileMergeInfo *info)
    fZipBytes      = 0;
    fSavedBytes    = 0;
    fFlushedBytes  = 0;
+   R__AccountBasketBuffers(-fTotalBuffers);
    fTotalBuffers  = 0;
    fChainOffset   = 0;
    fReadEntry     = -1;
+   fClusterStatsEnd.clear();
+   fClusterStatsMin.clear();
+   fClusterStatsMax.clear();
+   fClusterStatsLeaves.clear();
 
    delete fTreeIndex;
    fTreeIndex     = 0;
@@ -8043,6 +8288,8 @@ Bool_t TTree::SetAlias(const char* aliasName, const char* aliasFormula)
 ///
 /// The AutoFlush mechanism is disabled.
 ///
+/// Calling this function disables the adaptive mode set by SetAdaptiveAutoFlush().
+///
 /// Flushing the buffers at regular intervals optimize the location of
 /// consecutive entries on the disk by creating clusters of baskets.
 ///
@@ -8098,6 +8345,9 @@ void TTree::SetAutoFlush(Long64_t autof /* = -30000000 */ )
    // rather than its start in order to avoid using the array if the cluster
    // size never varies (If there is only one value of AutoFlush for the whole TTree).
 
+   fAdaptiveClusterBytes = 0;
+   fAdaptiveClusters = 0;
+
    if( fAutoFlush != autof) {
       if ((fAutoFlush > 0 || autof > 0) && fFlushedBytes) {
          // The mechanism was already enabled, let's record the previous
@@ -8108,6 +8358,73 @@ void TTree::SetAutoFlush(Long64_t autof /* = -30000000 */ )
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable the adaptive mode of the autoflush: instead of a fixed number of
+/// entries or of compressed bytes (see SetAutoFlush()), the cluster size and
+/// the basket sizes are derived from the data measured while filling.
+///
+/// The first cluster is flushed once `clusterBytes` uncompressed bytes have
+/// been written; the baskets are then resized with OptimizeBaskets() such that
+/// each branch needs about `maxBasketsPerCluster` baskets per cluster. At the
+/// end of each of the following `nTuningClusters - 1` clusters, the number of
+/// entries per cluster is recomputed from the average uncompressed entry size
+/// of all the entries filled so far and, if it changed by more than 10%, a new
+/// cluster range is started and the baskets are resized again. Afterwards the
+/// sizes are kept constant.
+///
+/// Clusters of a well defined uncompressed size give predictable memory usage
+/// and TTreeCache efficiency when reading, independently of the compression
+/// ratio of the data. The flushes of the tuning clusters are synchronous even
+/// if SetAsyncFlush() is enabled.
+///
+/// Calling SetAutoFlush() or this function with `clusterBytes <= 0` disables
+/// the adaptive mode. It must be enabled before the first flush of the tree.
+
+void TTree::SetAdaptiveAutoFlush(Long64_t clusterBytes, Int_t maxBasketsPerCluster, Int_t nTuningClusters)
+{
+   if (clusterBytes <= 0) {
+      fAdaptiveClusterBytes = 0;
+      fAdaptiveClusters = 0;
+      return;
+   }
+   if (fFlushedBytes) {
+      Error("SetAdaptiveAutoFlush", "The tree %s has already been flushed; the adaptive autoflush must be enabled before.",
+            GetName());
+      return;
+   }
+   // The sign keeps the usual meaning of a byte-based autoflush, e.g. for TTree::SetCacheSize.
+   fAutoFlush = -clusterBytes;
+   fAdaptiveClusterBytes = clusterBytes;
+   fAdaptiveMaxBaskets = TMath::Max(1, maxBasketsPerCluster);
+   fAdaptiveClusters = TMath::Max(1, nTuningClusters);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Recompute the number of entries per cluster of the adaptive autoflush
+/// after the flush of a cluster; see SetAdaptiveAutoFlush().
+
+void TTree::AdaptClusterSize()
+{
+   --fAdaptiveClusters;
+   const Long64_t totBytes = GetTotBytes();
+   if (totBytes <= 0 || fEntries <= 0 || fAutoFlush <= 0)
+      return;
+
+   const Double_t bytesPerEntry = Double_t(totBytes) / fEntries;
+   const Long64_t clusterEntries = TMath::Max(1LL, Long64_t(fAdaptiveClusterBytes / bytesPerEntry));
+   if (TMath::Abs(clusterEntries - fAutoFlush) * 10 <= fAutoFlush)
+      return;
+
+   if (gDebug > 0)
+      Info("AdaptClusterSize", "Changing the cluster size from %lld to %lld entries at entry %lld", fAutoFlush,
+           clusterEntries, fEntries);
+   // Close the current cluster range, as SetAutoFlush does.
+   MarkEventCluster();
+   fAutoFlush = clusterEntries;
+   if (!TestBit(TTree::kOnlyFlushAtCluster))
+      OptimizeBaskets(ULong64_t(clusterEntries * bytesPerEntry / fAdaptiveMaxBaskets), 1, "");
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Mark the previous event as being at the end of the event cluster.
 ///
@@ -8146,6 +8463,71 @@ void TTree::MarkEventCluster()
         fClusterSize[fNClusterRange] = fClusterRangeEnd[fNClusterRange] - fClusterRangeEnd[fNClusterRange-1];
     }
     ++fNClusterRange;
+    CloseClusterStatistics();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Update the minimum and maximum of the branches with cluster statistics
+/// (see AddClusterStatistics()) with the values of the entry being filled.
+
+void TTree::FillClusterStatistics()
+{
+   const auto nBranches = fClusterStatsBranches.size();
+   if (fClusterStatsLeaves.size() != nBranches) {
+      // First entry filled since the statistics were requested or since the tree was read back
+      fClusterStatsLeaves.clear();
+      for (const auto &name : fClusterStatsBranches) {
+         TBranch *branch = GetBranch(name.c_str());
+         fClusterStatsLeaves.emplace_back(branch ? static_cast<TLeaf *>(branch->GetListOfLeaves()->UncheckedAt(0))
+                                                 : nullptr);
+      }
+      fClusterStatsOpenMin.assign(nBranches, std::numeric_limits<Double_t>::infinity());
+      fClusterStatsOpenMax.assign(nBranches, -std::numeric_limits<Double_t>::infinity());
+      const Long64_t begin = fClusterStatsEnd.empty() ? 0 : fClusterStatsEnd.back();
+      // entries filled before, e.g. before an update of the file, are not known
+      fClusterStatsNFills = fEntries == begin ? 0 : -1;
+   }
+   for (std::size_t i = 0; i < nBranches; ++i) {
+      if (!fClusterStatsLeaves[i])
+         continue;
+      // NaN never satisfies a comparison, hence it does not need to be accounted for
+      const Double_t value = fClusterStatsLeaves[i]->GetValue(0);
+      if (value < fClusterStatsOpenMin[i])
+         fClusterStatsOpenMin[i] = value;
+      if (value > fClusterStatsOpenMax[i])
+         fClusterStatsOpenMax[i] = value;
+   }
+   if (fClusterStatsNFills >= 0)
+      ++fClusterStatsNFills;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record the statistics of the entries filled since the end of the previous
+/// cluster with statistics. If some of these entries were not seen by
+/// FillClusterStatistics(), e.g. because they were copied without calling
+/// Fill(), or if a branch is missing, the recorded range of values is
+/// unbounded.
+
+void TTree::CloseClusterStatistics()
+{
+   const Long64_t begin = fClusterStatsEnd.empty() ? 0 : fClusterStatsEnd.back();
+   if (fClusterStatsBranches.empty() || fEntries <= begin)
+      return;
+   const auto nBranches = fClusterStatsBranches.size();
+   const bool isComplete = fClusterStatsNFills == fEntries - begin && fClusterStatsLeaves.size() == nBranches;
+   for (std::size_t i = 0; i < nBranches; ++i) {
+      if (isComplete && fClusterStatsLeaves[i]) {
+         fClusterStatsMin.emplace_back(fClusterStatsOpenMin[i]);
+         fClusterStatsMax.emplace_back(fClusterStatsOpenMax[i]);
+      } else {
+         fClusterStatsMin.emplace_back(-std::numeric_limits<Double_t>::infinity());
+         fClusterStatsMax.emplace_back(std::numeric_limits<Double_t>::infinity());
+      }
+   }
+   fClusterStatsEnd.emplace_back(fEntries);
+   fClusterStatsOpenMin.assign(fClusterStatsOpenMin.size(), std::numeric_limits<Double_t>::infinity());
+   fClusterStatsOpenMax.assign(fClusterStatsOpenMax.size(), -std::numeric_limits<Double_t>::infinity());
+   fClusterStatsNFills = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -8165,6 +8547,27 @@ void TTree::SetAutoSave(Long64_t autos)
    fAutoSave = autos;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the asynchronous flushing of the baskets at the end of
+/// each cluster of entries (see SetAutoFlush()).
+///
+/// If enabled and implicit multi-threading is active, TTree::Fill does not
+/// wait for the baskets of the completed cluster to be compressed and written:
+/// they are written by background tasks while the following entries are
+/// filled into fresh baskets. The next flush waits for the previous one to
+/// be finished. This doubles the memory held by the baskets.
+///
+/// While a flush is in flight, no other object must be written to the file
+/// of the tree and the baskets of the previous cluster must not be read
+/// back; FlushBaskets(), AutoSave() and Write() complete the flush.
+
+void TTree::SetAsyncFlush(Bool_t enabled)
+{
+   if (!enabled)
+      FinishAsyncFlush();
+   fAsyncFlush = enabled;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set a branch's basket size.
 ///
@@ -9439,9 +9842,13 @@ void TTree::Streamer(TBuffer& b)
       b.CheckByteCount(R__s, R__c, TTree::IsA());
       //====end of old versions
    } else {
+      // The basket locations of an asynchronous flush are only known once it completed
+      FinishAsyncFlush();
       if (fBranchRef) {
          fBranchRef->Clear();
       }
+      // Entries filled since the last cluster are covered by the statistics written now
+      CloseClusterStatistics();
       TRefTable *table  = TRefTable::GetRefTable();
       if (table) TRefTable::SetRefTable(0);
 
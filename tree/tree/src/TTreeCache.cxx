@@ -261,6 +261,23 @@ rely on the system to cache the right branches.
     }
 ~~~
 
+#### Reusing the branches learnt by a previous job
+
+Jobs reading the same branches of the same files can skip the learning phase,
+during which every used branch is read with its own small request: the set of
+branches learnt by one job is saved as a profile, which the next jobs load.
+~~~ {.cpp}
+    // At the end of a first job
+    TFile profileFile("profile.root", "UPDATE"); // or next to the tree, if its file is writable
+    T->GetReadCache(T->GetCurrentFile())->SaveProfile(&profileFile);
+    // In the next jobs, right after SetCacheSize()
+    T->GetReadCache(T->GetCurrentFile())->LoadProfile(&profileFile);
+~~~
+Alternatively the resource variable `TTreeCache.Profile` (or the environment
+variable `ROOT_TTREECACHE_PROFILE`) makes every new TTreeCache load the profile
+of its tree: a value of `1` takes the profile from the file of the tree, any other
+value is taken as the name of the file holding the profile.
+
 ##  <a name="checkPerf"></a>How can the usage and performance of TTreeCache be verified?
 
 Once the event loop terminated, the number of effective system reads for a
@@ -284,6 +301,7 @@ myTreeOrChain.GetTree()->PrintCacheStats();
 #include "TBranch.h"
 #include "TBranchElement.h"
 #include "TEventList.h"
+#include "TEntryList.h"
 #include "TObjArray.h"
 #include "TObjString.h"
 #include "TRegexp.h"
@@ -293,7 +311,9 @@ myTreeOrChain.GetTree()->PrintCacheStats();
 #include "TMath.h"
 #include "TBranchCacheInfo.h"
 #include "TVirtualPerfStats.h"
+#include "ROOT/RTrace.hxx"
 #include <limits.h>
+#include <memory>
 
 Int_t TTreeCache::fgLearnEntries = 100;
 
@@ -316,6 +336,7 @@ TTreeCache::TTreeCache(TTree *tree, Int_t buffersize)
    fEntryNext = fEntryMin + fgLearnEntries;
    Int_t nleaves = tree->GetListOfLeaves()->GetEntries();
    fBranches = new TObjArray(nleaves);
+   LoadConfiguredProfile();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1105,6 +1126,7 @@ struct BasketRanges {
 
 Bool_t TTreeCache::FillBuffer()
 {
+   R__TRACE_SCOPE("io", "TTreeCache::FillBuffer");
 
    if (fNbranches <= 0) return kFALSE;
    TTree *tree = ((TBranch*)fBranches->UncheckedAt(0))->GetTree();
@@ -1286,16 +1308,30 @@ Bool_t TTreeCache::FillBuffer()
       fNextClusterStart = firstClusterEnd;
    }
 
-   // Check if owner has a TEventList set. If yes we optimize for this
-   // Special case reading only the baskets containing entries in the
+   // Check if owner has a TEventList or a TEntryList set. If yes we optimize
+   // for this Special case reading only the baskets containing entries in the
    // list.
    TEventList *elist = fTree->GetEventList();
+   TEntryList *enlist = elist ? nullptr : fTree->GetEntryList();
+   if (enlist && enlist->GetN() == 0)
+      enlist = nullptr;
    Long64_t chainOffset = 0;
-   if (elist) {
+   if (elist || enlist) {
       if (fTree->IsA() ==TChain::Class()) {
          TChain *chain = (TChain*)fTree;
          Int_t t = chain->GetTreeNumber();
-         chainOffset = chain->GetTreeOffset()[t];
+         if (enlist && enlist->GetLists()) {
+            // The sub-lists hold the entries local to their tree
+            TEntryList *sublist = nullptr;
+            TIter next(enlist->GetLists());
+            while ((sublist = (TEntryList*)next()) && sublist->GetTreeNumber() != t) {}
+            enlist = sublist;
+         } else {
+            chainOffset = chain->GetTreeOffset()[t];
+         }
+      } else if (enlist && enlist->GetLists()) {
+         // We cannot tell which sub-list belongs to this tree, read all its baskets
+         enlist = nullptr;
       }
    }
 
@@ -1353,7 +1389,7 @@ Bool_t TTreeCache::FillBuffer()
          kRewind = 3
       };
 
-      auto CollectBaskets = [this, elist, chainOffset, entry, clusterIterations, resetBranchInfo, perfStats,
+      auto CollectBaskets = [this, elist, enlist, chainOffset, entry, clusterIterations, resetBranchInfo, perfStats,
        &cursor, &lowestMaxEntry, &maxReadEntry, &minEntry,
        &reachedEnd, &skippedFirst, &oncePerBranch, &nDistinctLoad, &progress,
        &ranges, &memRanges, &reqRanges,
@@ -1481,6 +1517,13 @@ Bool_t TTreeCache::FillBuffer()
                   if (!elist->ContainsRange(entries[j]+chainOffset,emax+chainOffset))
                      continue;
                }
+               if (enlist) {
+                  Long64_t emax = fEntryMax;
+                  if (j<nb-1)
+                     emax = entries[j + 1] - 1;
+                  if (!enlist->ContainsRange(entries[j]+chainOffset,emax+chainOffset))
+                     continue;
+               }
 
                if (b->fCacheInfo.HasBeenUsed(j) || b->fCacheInfo.IsInCache(j) || b->fCacheInfo.IsVetoed(j)) {
                   // We already cached and used this basket during this cluster range,
@@ -1794,6 +1837,132 @@ TTreeCache::EPrefillType TTreeCache::GetConfiguredPrefillType() const
    return static_cast<TTreeCache::EPrefillType>(s);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the name of the access profile of the tree: `name` if given,
+/// otherwise the tree name followed by `_cacheprofile`.
+
+TString TTreeCache::GetProfileName(const char *name) const
+{
+   if (name && *name)
+      return name;
+   return TString::Format("%s_cacheprofile", fTree->GetName());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the branches listed in the access profile `name` stored in `dir` to the
+/// cache. Branches of the profile that do not exist in the tree are ignored.
+/// Returns the number of branches added or -1 if the profile cannot be found.
+
+Int_t TTreeCache::AddProfileBranches(TDirectory *dir, const char *name)
+{
+   if (!dir)
+      return -1;
+   TList *profile = dir->Get<TList>(GetProfileName(name));
+   if (!profile)
+      return -1;
+
+   Int_t nbranches = 0;
+   TIter next(profile);
+   TObject *os;
+   while ((os = next())) {
+      TBranch *b = fTree->GetBranch(os->GetName());
+      if (b && AddBranch(b) == 0)
+         ++nbranches;
+   }
+   profile->Delete();
+   delete profile;
+   return nbranches;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Load the access profile given by the `ROOT_TTREECACHE_PROFILE` environment
+/// variable or the `TTreeCache.Profile` resource variable, if any:
+/// - 1 - Load the profile stored in the file of the tree
+/// - any other, non-zero value - Name of the file holding the profile
+///
+/// If the profile is found, the learning phase is skipped.
+
+void TTreeCache::LoadConfiguredProfile()
+{
+   TString source = gSystem->Getenv("ROOT_TTREECACHE_PROFILE");
+   if (source.IsNull())
+      source = gEnv->GetValue("TTreeCache.Profile", "");
+   if (source.IsNull() || source == "0" || !fTree->GetTree())
+      return;
+
+   Int_t nbranches;
+   if (source == "1") {
+      nbranches = AddProfileBranches(fTree->GetCurrentFile(), nullptr);
+   } else {
+      TDirectory::TContext ctxt;
+      std::unique_ptr<TFile> file(TFile::Open(source));
+      if (!file || file->IsZombie()) {
+         Warning("LoadConfiguredProfile", "cannot open the cache profile file %s", source.Data());
+         return;
+      }
+      nbranches = AddProfileBranches(file.get(), nullptr);
+   }
+   if (nbranches > 0) {
+      // As for a cache that learnt from a previous file: the first read fills the cache
+      fIsLearning = kFALSE;
+      fIsManual = kTRUE;
+      fEntryNext = -1;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Load the access profile (see SaveProfile) `name` from `dir` and stop the
+/// learning phase: the cache then prefetches the branches of the profile from
+/// the first cluster on. If `dir` is null, the file of the tree is used; the
+/// profile name defaults to the tree name followed by `_cacheprofile`.
+/// Returns the number of branches added to the cache or -1 if the profile
+/// cannot be found.
+
+Int_t TTreeCache::LoadProfile(TDirectory *dir, const char *name)
+{
+   if (!dir)
+      dir = fTree->GetCurrentFile();
+   Int_t nbranches = AddProfileBranches(dir, name);
+   if (nbranches < 0) {
+      Error("LoadProfile", "cannot find the cache profile %s", GetProfileName(name).Data());
+      return -1;
+   }
+   if (nbranches > 0)
+      StopLearningPhase();
+   return nbranches;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Save the branches currently in the cache, i.e. typically the ones found
+/// during the learning phase, as an access profile named `name` in `dir`.
+/// A later job can load the profile (see LoadProfile) and skip the learning
+/// phase. If `dir` is null, the file of the tree is used, which must then be
+/// writable; the profile name defaults to the tree name followed by
+/// `_cacheprofile`. A previous profile of the same name is replaced.
+/// Returns the number of branches saved or -1 in case of error.
+
+Int_t TTreeCache::SaveProfile(TDirectory *dir, const char *name) const
+{
+   if (!dir)
+      dir = fTree->GetCurrentFile();
+   if (!dir || !dir->IsWritable()) {
+      Error("SaveProfile", "no writable directory for the cache profile");
+      return -1;
+   }
+
+   TList profile;
+   profile.SetOwner();
+   TIter next(fBrNames);
+   TObject *os;
+   while ((os = next()))
+      profile.Add(new TObjString(os->GetName()));
+   if (dir->WriteTObject(&profile, GetProfileName(name), "WriteDelete") <= 0) {
+      Error("SaveProfile", "cannot write the cache profile %s", GetProfileName(name).Data());
+      return -1;
+   }
+   return profile.GetSize();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Give the total efficiency of the primary cache... defined as the ratio
 /// of blocks found in the cache vs. the number of blocks prefetched
@@ -2007,6 +2176,7 @@ Int_t TTreeCache::ReadBufferPrefetch(char *buf, Long64_t pos, Int_t len)
 
 Int_t TTreeCache::ReadBuffer(char *buf, Long64_t pos, Int_t len)
 {
+   R__TRACE_SCOPE("io", "TTreeCache::ReadBuffer");
    if (!fEnabled) return 0;
 
    if (fEnablePrefetching)
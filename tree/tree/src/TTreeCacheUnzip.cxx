@@ -28,14 +28,17 @@ A TTreeCache which exploits parallelized decompression of its own content.
 #include "TROOT.h"
 #include "TMutex.h"
 #include "ROOT/RMakeUnique.hxx"
+#include "ROOT/RTrace.hxx"
 
 #ifdef R__USE_IMT
-#include "ROOT/TThreadExecutor.hxx"
 #include "ROOT/TTaskGroup.hxx"
 #endif
 
+#include <algorithm>
+
 extern "C" void R__unzip(Int_t *nin, UChar_t *bufin, Int_t *lout, char *bufout, Int_t *nout);
 extern "C" int R__unzip_header(Int_t *nin, UChar_t *bufin, Int_t *lout);
+extern "C" int R__unzip_needs_dict(Int_t nin, UChar_t *bufin);
 
 TTreeCacheUnzip::EParUnzipMode TTreeCacheUnzip::fgParallel = TTreeCacheUnzip::kDisable;
 
@@ -165,7 +168,8 @@ TTreeCacheUnzip::TTreeCacheUnzip() : TTreeCache(),
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
-   fNUnzip(0)
+   fNUnzip(0),
+   fNUnzipOnDemand(0)
 {
    // Default Constructor.
    Init();
@@ -184,7 +188,8 @@ TTreeCacheUnzip::TTreeCacheUnzip(TTree *tree, Int_t buffersize) : TTreeCache(tre
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
-   fNUnzip(0)
+   fNUnzip(0),
+   fNUnzipOnDemand(0)
 {
    Init();
 }
@@ -307,9 +312,19 @@ Bool_t TTreeCacheUnzip::FillBuffer()
    //clear cache buffer
    TFileCacheRead::Prefetch(0,0);
 
+   // The baskets of the on-demand branches are unzipped ahead like the others
+   // if the reader requested most of them in the previous cluster.
+   if (fNOnDemand > 0)
+      fOnDemandAhead = 2 * fNOnDemandRequested > fNOnDemand;
+   fNOnDemand = 0;
+   fNOnDemandRequested = 0;
+   fUnzipOnDemand.clear();
+
    //store baskets
    for (Int_t i = 0; i < fNbranches; i++) {
       TBranch *b = (TBranch*)fBranches->UncheckedAt(i);
+      // 0: unzipped ahead, 1: on-demand branch unzipped ahead anyway, 2: unzipped when requested
+      const char onDemand = IsUnzipOnDemand(b) ? (fOnDemandAhead ? 1 : 2) : 0;
       if (b->GetDirectory() == 0) continue;
       if (b->GetDirectory()->GetFile() != fFile) continue;
       Int_t nb = b->GetMaxBaskets();
@@ -337,6 +352,8 @@ Bool_t TTreeCacheUnzip::FillBuffer()
          fNReadPref++;
 
          TFileCacheRead::Prefetch(pos, len);
+         fUnzipOnDemand.resize(fNseek, onDemand);
+         if (onDemand) fNOnDemand++;
       }
       if (gDebug > 0) printf("Entry: %lld, registering baskets branch %s, fEntryNext=%lld, fNseek=%d, fNtot=%d\n", entry, ((TBranch*)fBranches->UncheckedAt(i))->GetName(), fEntryNext, fNseek, fNtot);
    }
@@ -393,6 +410,37 @@ void TTreeCacheUnzip::UpdateBranches(TTree *tree)
    TTreeCache::UpdateBranches(tree);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Do not unzip the baskets of branch bname ahead of the reader, or unzip
+/// them ahead again if onDemand is false. Meant for branches that are read
+/// for a small fraction of the entries: their baskets are still prefetched,
+/// but they are only unzipped, in the reading thread, when requested. The
+/// sub-branches of bname are included. If the reader ends up requesting most
+/// of the on-demand baskets of a cluster, all the baskets of the next cluster
+/// are unzipped ahead.
+
+void TTreeCacheUnzip::SetUnzipOnDemand(const char *bname, Bool_t onDemand /*= kTRUE*/)
+{
+   if (onDemand)
+      fUnzipOnDemandBranches.insert(bname);
+   else
+      fUnzipOnDemandBranches.erase(bname);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if b or its top-level mother branch were passed to
+/// SetUnzipOnDemand.
+
+Bool_t TTreeCacheUnzip::IsUnzipOnDemand(const TBranch *b) const
+{
+   if (fUnzipOnDemandBranches.empty())
+      return kFALSE;
+   if (fUnzipOnDemandBranches.count(b->GetName()))
+      return kTRUE;
+   const TBranch *mother = b->GetMother();
+   return mother && mother != b && fUnzipOnDemandBranches.count(mother->GetName());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                                                            //
 // From now on we have the methods concerning the threading part of the cache //
@@ -502,6 +550,7 @@ void TTreeCacheUnzip::ResetCache()
    // Reset all the lists and wipe all the chunks
    fCycle++;
    fUnzipState.Clear(fNseekMax);
+   fUnzipAhead = 0;
 
    if(fNseekMax < fNseek){
       if (gDebug > 0)
@@ -524,6 +573,7 @@ void TTreeCacheUnzip::ResetCache()
 
 Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
 {
+   R__TRACE_SCOPE("unzip", "TTreeCacheUnzip::UnzipCache");
    Int_t myCycle;
    const Int_t hlen = 128;
    Int_t objlen = 0, keylen = 0;
@@ -591,6 +641,7 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
          if (locbuff) delete [] locbuff;
          return 1;
       }
+      fUnzipAhead += loclen;
       fUnzipState.SetUnzipped(index, ptr, loclen); // Set it as done
       fNUnzip++;
    } else {
@@ -603,53 +654,75 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
 
 #ifdef R__USE_IMT
 ////////////////////////////////////////////////////////////////////////////////
-/// We create a TTaskGroup and asynchronously maps each group of baskets(> 100 kB in total)
-/// to a task. In TTaskGroup, we use TThreadExecutor to do the actually work of unzipping 
-/// a group of basket. The purpose of creating TTaskGroup is to avoid competing with main thread.
+/// We create a TTaskGroup whose tasks unzip the baskets of the cache ahead of
+/// the reader. The baskets are not statically split among the tasks: every
+/// task takes the next basket from a common queue, largest baskets first, so
+/// that idle workers pick up the remaining work. The number of tasks grows
+/// with the amount of data in the cache (fUnzipGroupSize bytes per task) up
+/// to the size of the thread pool. The TTaskGroup avoids competing with the
+/// main thread.
 
 Int_t TTreeCacheUnzip::CreateTasks()
 {
-   auto mapFunction = [&]() {
-      auto unzipFunction = [&](const std::vector<Int_t> &indices) {
-         // If cache is invalidated and we should return immediately.
-         if (!fIsTransferred) return nullptr;
-
-         for (auto ii : indices) {
-            if(fUnzipState.TryUnzipping(ii)) {
-               Int_t res = UnzipCache(ii);
-               if(res)
-                  if (gDebug > 0)
-                     Info("UnzipCache", "Unzipping failed or cache is in learning state");
-            }
-         }
-         return nullptr;
-      };
-
-      Int_t accusz = 0;
-      std::vector<std::vector<Int_t>> basketIndices;
-      std::vector<Int_t> indices;
-      if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
-      for (Int_t i = 0; i < fNseek; i++) {
-         while (accusz < fUnzipGroupSize) {
-            accusz += fSeekLen[i];
-            indices.push_back(i);
-            i++;
-            if (i >= fNseek) break;
-         }
-         if (i < fNseek) i--;
-         basketIndices.push_back(indices);
-         indices.clear();
-         accusz = 0;
-      }
-      ROOT::TThreadExecutor pool;
-      pool.Foreach(unzipFunction, basketIndices);
-   };
+   // Make sure no task of the previous cache content is still looking at fUnzipOrder
+   fUnzipTaskGroup.reset();
+
+   fUnzipOrder.clear();
+   Long64_t totalSize = 0;
+   for (Int_t i = 0; i < fNseek; ++i) {
+      if (IsOnDemandBasket(i)) continue;
+      fUnzipOrder.push_back(i);
+      totalSize += fSeekLen[i];
+   }
+   std::stable_sort(fUnzipOrder.begin(), fUnzipOrder.end(),
+                    [this](Int_t a, Int_t b) { return fSeekLen[a] > fSeekLen[b]; });
+   fUnzipNext = 0;
+   fUnzipAhead = 0;
+
+   if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
+   Long64_t nTasks = 1 + totalSize / fUnzipGroupSize;
+   fNUnzipTasksMax = std::max(1, (Int_t)std::min<Long64_t>(nTasks, ROOT::GetThreadPoolSize()));
 
    fUnzipTaskGroup.reset(new ROOT::Experimental::TTaskGroup());
-   fUnzipTaskGroup->Run(mapFunction);
+   LaunchUnzipTasks();
 
    return 0;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start unzipping tasks until fNUnzipTasksMax of them are running, unless
+/// all the baskets have been handed out already or the unzipped blocks not
+/// yet picked up by the reader exceed fUnzipBufferSize. The tasks stop once
+/// they exceed the latter, GetUnzipBuffer resumes them when the reader caught up.
+/// To be called by the main thread only.
+
+void TTreeCacheUnzip::LaunchUnzipTasks()
+{
+   if (!fUnzipTaskGroup || (fUnzipNext >= (Int_t)fUnzipOrder.size()) || (fUnzipAhead >= fUnzipBufferSize))
+      return;
+
+   const Int_t myCycle = fCycle;
+   auto unzipFunction = [this, myCycle]() {
+      // If cache is invalidated we return immediately.
+      while (fIsTransferred && (myCycle == fCycle) && (fUnzipAhead < fUnzipBufferSize)) {
+         Int_t next = fUnzipNext.fetch_add(1);
+         if (next >= (Int_t)fUnzipOrder.size()) break;
+         Int_t ii = fUnzipOrder[next];
+         if (fUnzipState.TryUnzipping(ii)) {
+            Int_t res = UnzipCache(ii);
+            if (res)
+               if (gDebug > 0)
+                  Info("UnzipCache", "Unzipping failed or cache is in learning state");
+         }
+      }
+      --fNUnzipTasks;
+   };
+
+   while (fNUnzipTasks < fNUnzipTasksMax) {
+      ++fNUnzipTasks;
+      fUnzipTaskGroup->Run(unzipFunction);
+   }
+}
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -664,8 +737,10 @@ Int_t TTreeCacheUnzip::CreateTasks()
 
 Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_t *free)
 {
+   R__TRACE_SCOPE("unzip", "TTreeCacheUnzip::GetUnzipBuffer");
    Int_t res = 0;
    Int_t loc = -1;
+   Bool_t onDemand = kFALSE;
 
    // We go straight to TTreeCache/TfileCacheRead, in order to get the info we need
    //  pointer to the original zipped chunk
@@ -694,6 +769,9 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
          // The buffer is, at minimum, in the file cache. We must know its index in the requests list
          // In order to get its info
          Int_t seekidx = fSeekIndex[loc];
+         if (seekidx < (Int_t)fUnzipOnDemand.size() && fUnzipOnDemand[seekidx])
+            fNOnDemandRequested++;
+         onDemand = IsOnDemandBasket(seekidx);
 
          do {
 
@@ -710,6 +788,10 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
                   fUnzipState.fUnzipChunks[seekidx].reset();
                   *free = kFALSE;
                }
+               fUnzipAhead -= fUnzipState.fUnzipLen[seekidx];
+#ifdef R__USE_IMT
+               LaunchUnzipTasks();
+#endif
 
                fNFound++;
                return fUnzipState.fUnzipLen[seekidx];
@@ -722,7 +804,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
                if (fEmpty) {
                   for (Int_t ii = 0; ii < fNseek; ++ii) {
                      Int_t idx = (seekidx + 1 + ii) % fNseek;
-                     if (fUnzipState.IsUntouched(idx)) {
+                     if (fUnzipState.IsUntouched(idx) && !IsOnDemandBasket(idx)) {
                         if(fUnzipState.TryUnzipping(idx)) {
                            reqi = idx;
                            break;
@@ -759,6 +841,10 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
                fUnzipState.fUnzipChunks[seekidx].reset();
                *free = kFALSE;
             }
+            fUnzipAhead -= fUnzipState.fUnzipLen[seekidx];
+#ifdef R__USE_IMT
+            LaunchUnzipTasks();
+#endif
 
             fNStalls++;
             return fUnzipState.fUnzipLen[seekidx];
@@ -814,7 +900,9 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
       *free = kTRUE;
    }
 
-   if (!fIsLearning) {
+   if (onDemand) {
+      fNUnzipOnDemand++;
+   } else if (!fIsLearning) {
       fNMissed++;
    }
    
@@ -882,6 +970,15 @@ Int_t TTreeCacheUnzip::UnzipBuffer(char **dest, char *src)
 
    if (objlen > nbytes-keylen || oldCase) {
 
+      // Baskets compressed with the dictionary of their branch are left to TBasket::ReadBasketBuffers
+      if (R__unzip_needs_dict(nbytes - keylen, (UChar_t *)(src + keylen))) {
+         if (alloc) {
+            delete [] *dest;
+            *dest = 0;
+         }
+         return -1;
+      }
+
       // Copy the key
       memcpy(*dest, src, keylen);
       uzlen += keylen;
@@ -949,6 +1046,7 @@ void  TTreeCacheUnzip::Print(Option_t* option) const {
    printf("Number of hits: %d\n", fNFound);
    printf("Number of stalls: %d\n", fNStalls);
    printf("Number of misses: %d\n", fNMissed);
+   printf("Number of blocks unzipped on demand: %d\n", fNUnzipOnDemand);
 
    TTreeCache::Print(option);
 }
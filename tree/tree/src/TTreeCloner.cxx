@@ -100,6 +100,9 @@ Bool_t TTreeCloner::CompareEntry::operator()(UInt_t i1, UInt_t i2)
 /// This means that on the file the baskets will be in the order
 /// in which they will be needed when reading the whole tree
 /// sequentially.
+///
+/// By default all the entries of 'from' are copied, see AddEntryRange()
+/// to copy only some of them.
 
 TTreeCloner::TTreeCloner(TTree *from, TTree *to, Option_t *method, UInt_t options) :
    fWarningMsg(),
@@ -112,6 +115,7 @@ TTreeCloner::TTreeCloner(TTree *from, TTree *to, Option_t *method, UInt_t option
    fFromBranches( from ? from->GetListOfLeaves()->GetEntries()+1 : 0),
    fToBranches( to ? to->GetListOfLeaves()->GetEntries()+1 : 0),
    fMaxBaskets(CollectBranches()),
+   fNBaskets(0),
    fBasketBranchNum(new UInt_t[fMaxBaskets]),
    fBasketNum(new UInt_t[fMaxBaskets]),
    fBasketSeek(new Long64_t[fMaxBaskets]),
@@ -120,6 +124,8 @@ TTreeCloner::TTreeCloner(TTree *from, TTree *to, Option_t *method, UInt_t option
    fPidOffset(0),
    fCloneMethod(TTreeCloner::kDefault),
    fToStartEntries(0),
+   fFastFirst(0),
+   fFastLast(0),
    fCacheSize(0LL),
    fFileCache(nullptr),
    fPrevCache(nullptr)
@@ -189,6 +195,29 @@ TTreeCloner::TTreeCloner(TTree *from, TTree *to, Option_t *method, UInt_t option
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Only copy the entries from 'first' to 'last' (excluded) of the input tree,
+/// instead of all its entries. Can be called several times, with increasing
+/// and non overlapping ranges.
+///
+/// The baskets holding only entries of the range are copied without being
+/// decompressed, while the entries of the range that share a basket with
+/// entries outside of it (typically at both ends of the range) are read and
+/// filled again in the output tree. For the latter, the branches of the
+/// output tree must be connected to the input tree, as done by CloneTree(0).
+///
+/// Unlike when all the entries are copied, the caller must not update the
+/// number of entries of the output tree.
+
+void TTreeCloner::AddEntryRange(Long64_t first, Long64_t last)
+{
+   if (first < 0) first = 0;
+   if (fFromTree && last > fFromTree->GetEntries()) last = fFromTree->GetEntries();
+   if (first < last) {
+      fEntryRanges.emplace_back(first, last);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute the cloning.
 
@@ -197,16 +226,76 @@ Bool_t TTreeCloner::Exec()
    if (!IsValid()) {
       return kFALSE;
    }
-   CreateCache();
-   ImportClusterRanges();
-   CopyStreamerInfos();
-   CopyProcessIds();
-   CloseOutWriteBaskets();
-   CollectBaskets();
-   SortBaskets();
-   WriteBaskets();
-   CopyMemoryBaskets();
-   RestoreCache();
+   if (fEntryRanges.empty()) {
+      fFastFirst = 0;
+      fFastLast = fFromTree->GetEntries();
+      CreateCache();
+      ImportClusterRanges();
+      CopyStreamerInfos();
+      CopyProcessIds();
+      CloseOutWriteBaskets();
+      CollectBaskets();
+      SortBaskets();
+      WriteBaskets();
+      CopyMemoryBaskets();
+      RestoreCache();
+
+      return kTRUE;
+   }
+
+   // Find in each range the largest part that starts and ends at a basket
+   // boundary of all the branches; the candidates are the cluster boundaries.
+   std::vector<std::pair<Long64_t, Long64_t>> fastRanges;
+   Bool_t needsInfos = kTRUE;
+   for (auto &range : fEntryRanges) {
+      std::vector<Long64_t> boundaries{range.first};
+      TTree::TClusterIterator clusterIter = fFromTree->GetClusterIterator(range.first);
+      Long64_t start;
+      while ((start = clusterIter()) < range.second) {
+         if (start > range.first) boundaries.push_back(start);
+      }
+      boundaries.push_back(range.second);
+      auto fastFirst = std::find_if(boundaries.begin(), boundaries.end(),
+                                    [this](Long64_t entry) { return IsBasketBoundary(entry); });
+      auto fastLast = std::find_if(boundaries.rbegin(), boundaries.rend(),
+                                   [this](Long64_t entry) { return IsBasketBoundary(entry); });
+      if (fastFirst != boundaries.end() && *fastFirst < *fastLast) {
+         fastRanges.emplace_back(*fastFirst, *fastLast);
+         if (needsInfos) {
+            CopyStreamerInfos();
+            CopyProcessIds();
+            needsInfos = kFALSE;
+         }
+      } else {
+         fastRanges.emplace_back(range.second, range.second);
+      }
+   }
+
+   auto markCluster = [this]() {
+      const Int_t nranges = fToTree->fNClusterRange;
+      if (nranges == 0 || fToTree->fClusterRangeEnd[nranges - 1] != fToTree->GetEntries() - 1)
+         fToTree->MarkEventCluster();
+   };
+   for (size_t i = 0; i < fEntryRanges.size(); ++i) {
+      FillEntries(fEntryRanges[i].first, fastRanges[i].first);
+      fFastFirst = fastRanges[i].first;
+      fFastLast = fastRanges[i].second;
+      if (fFastFirst < fFastLast) {
+         CloseOutWriteBaskets();
+         // The copied baskets form their own clusters
+         markCluster();
+         fToStartEntries = fToTree->GetEntries() - fFastFirst;
+         CreateCache();
+         CollectBaskets();
+         SortBaskets();
+         WriteBaskets();
+         CopyMemoryBaskets();
+         RestoreCache();
+         fToTree->SetEntries(fToTree->GetEntries() + fFastLast - fFastFirst);
+         markCluster();
+      }
+      FillEntries(fFastLast, fEntryRanges[i].second);
+   }
 
    return kTRUE;
 }
@@ -232,12 +321,55 @@ TTreeCloner::~TTreeCloner()
 
 void TTreeCloner::CloseOutWriteBaskets()
 {
+   // The baskets being flushed asynchronously must be on file before the new ones
+   fToTree->FinishAsyncFlush();
    for(Int_t i=0; i<fToBranches.GetEntries(); ++i) {
       TBranch *to = (TBranch*)fToBranches.UncheckedAt(i);
       to->FlushOneBasket(to->GetWriteBasket());
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the entries from 'first' to 'last' (excluded) of the input tree and
+/// fill them in the output tree.
+
+void TTreeCloner::FillEntries(Long64_t first, Long64_t last)
+{
+   for (Long64_t entry = first; entry < last; ++entry) {
+      if (fFromTree->GetEntry(entry) <= 0) {
+         break;
+      }
+      fToTree->Fill();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if a basket of each of the input branches starts at 'entry',
+/// or if 'entry' is the end of the input tree.
+
+Bool_t TTreeCloner::IsBasketBoundary(Long64_t entry)
+{
+   if (entry == fFromTree->GetEntries()) {
+      return kTRUE;
+   }
+   for (Int_t i = 0; i < fFromBranches.GetEntries(); ++i) {
+      TBranch *from = (TBranch*)fFromBranches.UncheckedAt(i);
+      Int_t writeBasket = from->GetWriteBasket();
+      if (writeBasket == 0) {
+         // The branches without any entry (e.g. non-terminal 'object' branches) do not constrain the boundaries
+         TBasket *basket = from->GetListOfBaskets()->GetEntries() ? from->GetBasket(0) : nullptr;
+         if (!basket || basket->GetNevBuf() == 0) {
+            continue;
+         }
+      }
+      Long64_t *basketEntry = from->GetBasketEntry();
+      if (!std::binary_search(basketEntry, basketEntry + writeBasket + 1, entry)) {
+         return kFALSE;
+      }
+   }
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Fill the array of branches, adding the branch 'from' and 'to',
 /// and matching the sub-branches of the 'from' and 'to' branches.
@@ -313,6 +445,23 @@ UInt_t TTreeCloner::CollectBranches(TBranch *from, TBranch *to) {
 
    }
 
+   if (!from->fCompressDict.empty() && from->fCompressDict != to->fCompressDict) {
+      if (to->fCompressDict.empty() && to->GetWriteBasket() == 0 && to->GetEntries() == 0) {
+         // The baskets are copied as is: an empty output branch can use the dictionary of the input.
+         to->fCompressDict = from->fCompressDict;
+         to->fDictTrainBaskets = 0;
+      } else {
+         fWarningMsg.Form("The export branch and the import branch (%s) do not use the same compression dictionary",
+                          from->GetName());
+         if (!(fOptions & kNoWarnings)) {
+            Warning("TTreeCloner::CollectBranches", "%s", fWarningMsg.Data());
+         }
+         fIsValid = kFALSE;
+         fNeedConversion = kTRUE;
+         return 0;
+      }
+   }
+
    fFromBranches.AddLast(from);
    if (!from->TestBit(TBranch::kDoNotUseBufferMap)) {
       // Make sure that we reset the Buffer's map if needed.
@@ -420,17 +569,25 @@ void TTreeCloner::CollectBaskets()
 {
    UInt_t len = fFromBranches.GetEntries();
 
-   for(UInt_t i=0,bi=0; i<len; ++i) {
+   UInt_t bi = 0;
+   for(UInt_t i=0; i<len; ++i) {
       TBranch *from = (TBranch*)fFromBranches.UncheckedAt(i);
-      for(Int_t b=0; b<from->GetWriteBasket(); ++b,++bi) {
+      for(Int_t b=0; b<from->GetWriteBasket(); ++b) {
+         if (!fEntryRanges.empty()) {
+            // Only the baskets of [fFastFirst, fFastLast), which starts and ends at basket boundaries
+            Long64_t basketEntry = from->GetBasketEntry()[b];
+            if (basketEntry < fFastFirst || basketEntry >= fFastLast) continue;
+         }
          fBasketBranchNum[bi] = i;
          fBasketNum[bi] = b;
          fBasketSeek[bi] = from->GetBasketSeek(b);
          //fprintf(stderr,"For %s %d %lld\n",from->GetName(),bi,fBasketSeek[bi]);
          fBasketEntry[bi] = from->GetBasketEntry()[b];
          fBasketIndex[bi] = bi;
+         ++bi;
       }
    }
+   fNBaskets = bi;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -485,18 +642,24 @@ void TTreeCloner::CopyMemoryBaskets()
       TBranch *from = (TBranch*)fFromBranches.UncheckedAt( i );
       TBranch *to   = (TBranch*)fToBranches.UncheckedAt( i );
 
+      Long64_t writeEntry = from->GetBasketEntry()[from->GetWriteBasket()];
+      if (!fEntryRanges.empty() && fFastLast <= writeEntry) {
+         // The entries of the write basket are not part of the copy
+         to->AddLastBasket(fToStartEntries + fFastLast);
+         continue;
+      }
       basket = from->GetListOfBaskets()->GetEntries() ? from->GetBasket(from->GetWriteBasket()) : 0;
       if (basket) {
          basket = (TBasket*)basket->Clone();
          basket->SetBranch(to);
-         to->AddBasket(*basket, kFALSE, fToStartEntries+from->GetBasketEntry()[from->GetWriteBasket()]);
+         to->AddBasket(*basket, kFALSE, fToStartEntries+writeEntry);
       } else {
-         to->AddLastBasket(  fToStartEntries+from->GetBasketEntry()[from->GetWriteBasket()] );
+         to->AddLastBasket(  fToStartEntries+writeEntry );
       }
       // In older files, if the branch is a TBranchElement non-terminal 'object' branch, it's basket will contain 0
       // events, in newer file in the same case, the write basket will be missing.
       if (from->GetEntries()!=0 && from->GetWriteBasket()==0 && (basket==0 || basket->GetNevBuf()==0)) {
-         to->SetEntries(to->GetEntries()+from->GetEntries());
+         to->SetEntries(to->GetEntries() + (fEntryRanges.empty() ? from->GetEntries() : fFastLast - fFastFirst));
       }
    }
 }
@@ -569,8 +732,13 @@ void TTreeCloner::CreateCache()
       fPrevCache = prev;
       // Remove the previous cache if any.
       if (prev) f->SetCacheRead(nullptr, fFromTree);
-      // The constructor attach the new cache.
-      fFileCache = new TFileCacheRead(f, fCacheSize, fFromTree);
+      if (fFileCache) {
+         // Reuse the cache detached by RestoreCache
+         f->SetCacheRead(fFileCache, fFromTree);
+      } else {
+         // The constructor attach the new cache.
+         fFileCache = new TFileCacheRead(f, fCacheSize, fFromTree);
+      }
    }
 }
 
@@ -639,14 +807,14 @@ void TTreeCloner::SortBaskets()
          // nothing to do, it is already sorted.
          break;
       case kSortBasketsByEntry: {
-         for(UInt_t i = 0; i < fMaxBaskets; ++i) { fBasketIndex[i] = i; }
-         std::sort(fBasketIndex, fBasketIndex+fMaxBaskets, CompareEntry( this) );
+         for(UInt_t i = 0; i < fNBaskets; ++i) { fBasketIndex[i] = i; }
+         std::sort(fBasketIndex, fBasketIndex+fNBaskets, CompareEntry( this) );
          break;
       }
       case kSortBasketsByOffset:
       default: {
-         for(UInt_t i = 0; i < fMaxBaskets; ++i) { fBasketIndex[i] = i; }
-         std::sort(fBasketIndex, fBasketIndex+fMaxBaskets, CompareSeek( this) );
+         for(UInt_t i = 0; i < fNBaskets; ++i) { fBasketIndex[i] = i; }
+         std::sort(fBasketIndex, fBasketIndex+fNBaskets, CompareSeek( this) );
          break;
       }
    }
@@ -663,7 +831,7 @@ UInt_t TTreeCloner::FillCache(UInt_t from)
    // Reset the cache
    fFileCache->Prefetch(0, 0);
    Long64_t size = 0;
-   for (UInt_t j = from; j < fMaxBaskets; ++j) {
+   for (UInt_t j = from; j < fNBaskets; ++j) {
       TBranch *frombr = (TBranch *) fFromBranches.UncheckedAt(fBasketBranchNum[fBasketIndex[j]]);
 
 
@@ -678,7 +846,7 @@ UInt_t TTreeCloner::FillCache(UInt_t from)
          fFileCache->Prefetch(pos,len);
       }
    }
-   return fMaxBaskets;
+   return fNBaskets;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -687,7 +855,7 @@ UInt_t TTreeCloner::FillCache(UInt_t from)
 void TTreeCloner::WriteBaskets()
 {
    TBasket *basket = new TBasket();
-   for(UInt_t j = 0, notCached = 0; j<fMaxBaskets; ++j) {
+   for(UInt_t j = 0, notCached = 0; j<fNBaskets; ++j) {
       TBranch *from = (TBranch*)fFromBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
       TBranch *to   = (TBranch*)fToBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
 
@@ -45,7 +45,9 @@ TTreeSQL::TTreeSQL(TSQLServer *server, TString DB, const TString& table) :
    fResult(0), fRow(0),
    fServer(server),
    fBranchChecked(kFALSE),
-   fTableInfo(0)
+   fTableInfo(0),
+   fInsertBatchSize(100),
+   fNumBatchedRows(0)
 {
    fCurrentEntry = -1;
    fQuery = TString("Select * from " + fTable);
@@ -55,6 +57,9 @@ TTreeSQL::TTreeSQL(TSQLServer *server, TString DB, const TString& table) :
       Error("TTreeSQL","No TSQLServer specified");
       return;
    }
+   // Oracle does not support INSERT with several rows of values
+   if (TString(fServer->GetDBMS()).Contains("Oracle", TString::kIgnoreCase))
+      fInsertBatchSize = 1;
    if (CheckTable(fTable.Data())) {
       Init();
    }
@@ -372,7 +377,8 @@ void TTreeSQL::CreateBranch(const TString &branchName, const TString &typeName)
    alterSQL += typeName;
    alterSQL += " ";
 
-   fServer->Query(alterSQL);
+   FlushInserts();
+   delete fServer->Query(alterSQL);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -556,6 +562,14 @@ void TTreeSQL::Init()
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Copy the information from the user object to the TTree
+///
+/// The rows are not inserted one by one, but collected into a single
+/// INSERT query with several rows of values, which is executed when
+/// GetInsertBatchSize() rows are filled, the table is read or altered,
+/// FlushInserts() is called or the tree is deleted. This saves a round
+/// trip to the server per row.
+/// Returns the number of rows inserted into the database by this call,
+/// 0 if the row is kept for a later query, or -1 in case of error.
 
 Int_t TTreeSQL::Fill()
 {
@@ -594,15 +608,40 @@ Int_t TTreeSQL::Fill()
    if (fInsertQuery[fInsertQuery.Length()-1]!='(') {
       fInsertQuery.Remove(fInsertQuery.Length()-1);
       fInsertQuery += ")";
-      TSQLResult *res = fServer?fServer->Query(fInsertQuery):0;
 
-      if (res) {
-         return res->GetRowCount();
+      if (fNumBatchedRows == 0) {
+         fBatchQuery = fInsertQuery;
+      } else {
+         // Append the values of this row, which start at the first parenthesis.
+         fBatchQuery += ",";
+         fBatchQuery += fInsertQuery.Data() + fInsertQuery.First('(');
       }
+      if (++fNumBatchedRows < fInsertBatchSize) return 0;
+      return FlushInserts();
    }
    return -1;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Insert into the database the rows filled but not yet inserted.
+/// Returns the number of rows inserted, or -1 in case of error.
+
+Int_t TTreeSQL::FlushInserts()
+{
+   if (fNumBatchedRows == 0) return 0;
+
+   Int_t nrows = fNumBatchedRows;
+   fNumBatchedRows = 0;
+   TSQLResult *res = fServer ? fServer->Query(fBatchQuery) : 0;
+   fBatchQuery.Clear();
+   if (!res) {
+      Error("FlushInserts", "Failed to insert %d rows into table %s", nrows, fTable.Data());
+      return -1;
+   }
+   delete res;
+   return nrows;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return a vector of columns index corresponding to the
 /// current SQL table and the branch given as argument
@@ -681,6 +720,7 @@ Long64_t  TTreeSQL::GetEntries() const
    if (!CheckTable(fTable.Data())) return 0;
 
    TTreeSQL* thisvar = const_cast<TTreeSQL*>(this);
+   thisvar->FlushInserts();
 
    // What if the user already started to call GetEntry
    // What about the initial value of fEntries is it really 0?
@@ -737,6 +777,7 @@ Long64_t TTreeSQL::LoadTree(Long64_t entry)
 Long64_t TTreeSQL::PrepEntry(Long64_t entry)
 {
    if (entry < 0 || entry >= fEntries || fServer==0) return 0;
+   FlushInserts();
    fReadEntry = entry;
 
    if(entry == fCurrentEntry) return entry;
@@ -792,6 +833,16 @@ void TTreeSQL::Refresh()
    delete fRow; fRow = 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the maximum number of rows collected by Fill() into one INSERT query.
+/// A value of 1 inserts each row when it is filled.
+
+void TTreeSQL::SetInsertBatchSize(Int_t n)
+{
+   fInsertBatchSize = n < 1 ? 1 : n;
+   if (fNumBatchedRows >= fInsertBatchSize) FlushInserts();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Reset the internal query
 
@@ -806,6 +857,7 @@ void TTreeSQL::ResetQuery()
 
 TTreeSQL::~TTreeSQL()
 {
+   FlushInserts();
    delete fTableInfo;
    delete fResult;
    delete fRow;
@@ -6,6 +6,7 @@
 #include "TFile.h"
 #include "TTree.h"
 #include "TStopwatch.h"
+#include "TSystem.h"
 #include "TTreeReader.h"
 #include "TTreeReaderValue.h"
 #include "TTreeReaderArray.h"
@@ -15,6 +16,8 @@
 
 #include "gtest/gtest.h"
 
+#include <vector>
+
 class BulkApiVariableTest : public ::testing::Test {
 public:
    static constexpr Long64_t fClusterSize = 1e5;
@@ -235,3 +238,61 @@ TEST_F(BulkApiVariableTest, serializedRead)
    printf("Bulk Serialized API: Successful read of all events.\n");
    printf("Bulk Serialized API: Total elapsed time (seconds) for API: %.2f\n", sw.RealTime());
 }
+
+TEST(BulkApiJagged, LeafArrayAndVector)
+{
+   const std::string fileName = "BulkApiTestJagged.root";
+   const Long64_t eventCount = 10000;
+   {
+      TFile hfile(fileName.c_str(), "RECREATE");
+      TTree tree("T", "A ROOT tree of jagged branches.");
+      float f[10];
+      int myLen = 0;
+      std::vector<float> v;
+      tree.Branch("myLen", &myLen, "myLen/I", 32000);
+      tree.Branch("f", &f, "f[myLen]/F", 32000);
+      tree.Branch("v", &v, 32000);
+      float counter = 0;
+      for (Long64_t ev = 0; ev < eventCount; ev++) {
+         myLen = ev % 10;
+         v.clear();
+         for (Int_t idx = 0; idx < myLen; idx++) {
+            f[idx] = counter;
+            v.push_back(counter++);
+         }
+         tree.Fill();
+      }
+      hfile.Write();
+   }
+
+   TFile hfile(fileName.c_str());
+   auto tree = hfile.Get<TTree>("T");
+   ASSERT_NE(nullptr, tree);
+   for (auto name : {"f", "v"}) {
+      auto branch = tree->GetBranch(name);
+      ASSERT_TRUE(branch->GetBulkRead().SupportsJaggedBulkRead());
+      EXPECT_FALSE(tree->GetBranch("myLen")->GetBulkRead().SupportsJaggedBulkRead());
+
+      TBufferFile buf(TBuffer::kWrite, 10000);
+      std::vector<Int_t> offsets;
+      Long64_t evt = 0;
+      float expected = 0;
+      while (evt < eventCount) {
+         auto count = branch->GetBulkRead().GetEntriesJagged(evt, buf, offsets);
+         ASSERT_GT(count, 0);
+         ASSERT_EQ(std::size_t(count + 1), offsets.size());
+         char *contents = buf.GetCurrent();
+         for (Int_t idx = 0; idx < count; idx++) {
+            ASSERT_EQ(Int_t((evt + idx) % 10), offsets[idx + 1] - offsets[idx]);
+            for (Int_t elem = offsets[idx]; elem < offsets[idx + 1]; elem++) {
+               float value;
+               frombuf(contents, &value);
+               ASSERT_EQ(expected++, value);
+            }
+         }
+         evt += count;
+      }
+      EXPECT_EQ(eventCount, evt);
+   }
+   gSystem->Unlink(fileName.c_str());
+}
@@ -1,3 +1,4 @@
+#include "TChain.h"
 #include "TFile.h"
 #include "TROOT.h"
 #include "TSystem.h"
@@ -5,6 +6,9 @@
 
 #include "gtest/gtest.h"
 
+#include <string>
+#include <vector>
+
 #ifdef R__USE_IMT
 
 // ROOT-9668
@@ -28,4 +32,81 @@ TEST(TTreeImplicitMT, flushBaskets)
    gSystem->Unlink(ofileName);
 }
 
+TEST(TTreeImplicitMT, asyncFlush)
+{
+   ROOT::EnableImplicitMT();
+   const auto ofileName = "asyncFlushMT.root";
+   const Long64_t nEntries = 10000;
+   {
+      TFile f(ofileName, "RECREATE");
+      TTree t("t", "t");
+      t.SetAutoFlush(1000);
+      t.SetAsyncFlush(true);
+      Long64_t b1 = 0;
+      std::vector<double> b2;
+      t.Branch("branch1", &b1);
+      t.Branch("branch2", &b2);
+      for (Long64_t i = 0; i < nEntries; ++i) {
+         b1 = i;
+         b2.assign(i % 7, double(i));
+         t.Fill();
+      }
+      t.Write();
+      EXPECT_EQ(10, t.GetBranch("branch1")->GetWriteBasket());
+   }
+
+   TFile f(ofileName);
+   auto t = f.Get<TTree>("t");
+   ASSERT_NE(nullptr, t);
+   EXPECT_EQ(nEntries, t->GetEntries());
+   Long64_t b1 = 0;
+   std::vector<double> *b2 = nullptr;
+   t->SetBranchAddress("branch1", &b1);
+   t->SetBranchAddress("branch2", &b2);
+   for (Long64_t i = 0; i < nEntries; ++i) {
+      t->GetEntry(i);
+      ASSERT_EQ(i, b1);
+      ASSERT_EQ(std::size_t(i % 7), b2->size());
+   }
+   t->ResetBranchAddresses();
+   gSystem->Unlink(ofileName);
+}
+
+TEST(TTreeImplicitMT, chainGetEntries)
+{
+   const std::vector<std::string> fileNames = {"chainGetEntriesMT0.root", "chainGetEntriesMT1.root",
+                                               "chainGetEntriesMT2.root"};
+   Long64_t expected = 0;
+   for (std::size_t i = 0; i < fileNames.size(); ++i) {
+      TFile f(fileNames[i].c_str(), "RECREATE");
+      TTree t("t", "t");
+      Long64_t x = 0;
+      t.Branch("x", &x);
+      for (Long64_t e = 0; e < Long64_t(10 * (i + 1)); ++e) {
+         x = expected++;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   ROOT::EnableImplicitMT();
+   TChain c("t");
+   for (const auto &name : fileNames)
+      c.Add(name.c_str());
+   EXPECT_EQ(expected, c.GetEntries());
+   EXPECT_EQ(10, c.GetTreeOffset()[1]);
+   EXPECT_EQ(30, c.GetTreeOffset()[2]);
+   Long64_t x = -1;
+   c.SetBranchAddress("x", &x);
+   for (Long64_t e = 0; e < expected; ++e) {
+      c.GetEntry(e);
+      EXPECT_EQ(e, x);
+   }
+   c.ResetBranchAddresses();
+   ROOT::DisableImplicitMT();
+
+   for (const auto &name : fileNames)
+      gSystem->Unlink(name.c_str());
+}
+
 #endif // R__USE_IMT
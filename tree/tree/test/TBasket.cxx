@@ -403,3 +403,87 @@ TEST(TBasket, TestSettingIOBits)
    readEntryOffset = reinterpret_cast<Bool_t *>(reinterpret_cast<char *>(basket2) + offset);
    EXPECT_EQ(*readEntryOffset, kTRUE);
 }
+
+TEST(TBasket, RecycleEntryOffset)
+{
+   TMemFile f("tbasket_recycle.root", "CREATE");
+   {
+      TTree t("t", "Tree with many baskets of a branch with entry offsets.");
+      std::vector<Int_t> v;
+      t.Branch("v", &v, 1000);
+      for (Int_t idx = 0; idx < 1000; idx++) {
+         v.assign(3, idx);
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   auto t = f.Get<TTree>("t");
+   ASSERT_NE(t, nullptr);
+   TBranch *br = t->GetBranch("v");
+   ASSERT_NE(br, nullptr);
+   ASSERT_GT(br->GetWriteBasket(), 2);
+
+   // With the default maximum virtual size, the branch reuses its basket and
+   // the basket reuses its entry offset array.
+   TBasket *basket = br->GetBasket(0);
+   ASSERT_NE(basket, nullptr);
+   Int_t *offsets = basket->GetEntryOffset();
+   ASSERT_NE(offsets, nullptr);
+   Int_t nevbuf = basket->GetNevBuf();
+   ASSERT_EQ(basket, br->GetBasket(1));
+   ASSERT_LE(basket->GetNevBuf(), nevbuf);
+   EXPECT_EQ(offsets, basket->GetEntryOffset());
+
+   std::vector<Int_t> *rv = nullptr;
+   t->SetBranchAddress("v", &rv);
+   for (Int_t idx = 0; idx < t->GetEntries(); idx++) {
+      t->GetEntry(idx);
+      ASSERT_EQ(rv->size(), 3u);
+      EXPECT_EQ((*rv)[0], idx);
+      EXPECT_EQ((*rv)[2], idx);
+   }
+   t->ResetBranchAddresses();
+   delete rv;
+}
+
+TEST(TBasket, CompressionDictionary)
+{
+   TMemFile f("tbasket_dict.root", "CREATE", "", 505);
+   {
+      TTree t("t", "Tree with small ZSTD-compressed baskets.");
+      char text[64];
+      t.Branch("text", text, "text/C", 1000);
+      t.GetBranch("text")->SetCompressionDictionary(20, 4096);
+      for (Int_t idx = 0; idx < 5000; idx++) {
+         snprintf(text, sizeof(text), "entry %d of the dictionary test", idx);
+         t.Fill();
+      }
+      EXPECT_FALSE(t.GetBranch("text")->GetCompressionDictionary().empty());
+      t.Write();
+   }
+
+   auto t = f.Get<TTree>("t");
+   ASSERT_NE(t, nullptr);
+   TBranch *br = t->GetBranch("text");
+   ASSERT_NE(br, nullptr);
+   ASSERT_GT(br->GetWriteBasket(), 20);
+   EXPECT_FALSE(br->GetCompressionDictionary().empty());
+
+   TMemFile fclone("tbasket_dict_clone.root", "CREATE", "", 505);
+   TTree *clone = t->CloneTree(-1, "fast");
+   ASSERT_NE(clone, nullptr);
+   EXPECT_EQ(br->GetCompressionDictionary(), clone->GetBranch("text")->GetCompressionDictionary());
+
+   for (TTree *tree : {t, clone}) {
+      char rtext[64];
+      tree->SetBranchAddress("text", rtext);
+      for (Int_t idx = 0; idx < tree->GetEntries(); idx++) {
+         ASSERT_GT(tree->GetEntry(idx), 0);
+         char expected[64];
+         snprintf(expected, sizeof(expected), "entry %d of the dictionary test", idx);
+         ASSERT_STREQ(expected, rtext);
+      }
+      tree->ResetBranchAddresses();
+   }
+}
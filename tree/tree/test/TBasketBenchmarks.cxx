@@ -0,0 +1,98 @@
+#include "Compression.h"
+#include "TBranch.h"
+#include "TFile.h"
+#include "TRandom3.h"
+#include "TTree.h"
+
+#include "benchmark/benchmark.h"
+
+#include <memory>
+#include <set>
+#include <string>
+
+// Fixed dataset: 200000 entries of a float, a double and an array of 16 floats, generated with a fixed seed
+static constexpr Long64_t kNEntries = 200000;
+
+// The benchmark functions are called several times, the file of each compression setting is written once
+static std::string CreateFile(int compression)
+{
+   static std::set<int> created;
+   std::string fileName = "TBasketBenchmarks_" + std::to_string(compression) + ".root";
+   if (!created.insert(compression).second)
+      return fileName;
+
+   TFile file(fileName.c_str(), "RECREATE", "", compression);
+   TTree tree("t", "t");
+   Float_t x;
+   Double_t y;
+   Float_t arr[16];
+   tree.Branch("x", &x);
+   tree.Branch("y", &y);
+   tree.Branch("arr", arr, "arr[16]/F");
+   TRandom3 rnd(42);
+   for (Long64_t i = 0; i < kNEntries; ++i) {
+      x = rnd.Gaus(0, 1);
+      y = rnd.Exp(10);
+      for (auto &a : arr)
+         a = rnd.Uniform(-100, 100);
+      tree.Fill();
+   }
+   tree.Write();
+   return fileName;
+}
+
+// Read all the baskets, i.e. decompress them and copy out the values of each entry
+static void BM_TBasket_ReadEntries(benchmark::State &state)
+{
+   const auto fileName = CreateFile(state.range(0));
+   std::unique_ptr<TFile> file(TFile::Open(fileName.c_str()));
+   auto tree = file->Get<TTree>("t");
+   Float_t x;
+   Double_t y;
+   Float_t arr[16];
+   tree->SetBranchAddress("x", &x);
+   tree->SetBranchAddress("y", &y);
+   tree->SetBranchAddress("arr", arr);
+
+   for (auto _ : state) {
+      for (Long64_t i = 0; i < kNEntries; ++i)
+         tree->GetEntry(i);
+      benchmark::DoNotOptimize(arr);
+   }
+   state.SetItemsProcessed(state.iterations() * kNEntries);
+   state.SetBytesProcessed(state.iterations() * tree->GetTotBytes());
+   state.counters["ratio"] = double(tree->GetTotBytes()) / tree->GetZipBytes();
+}
+BENCHMARK(BM_TBasket_ReadEntries)
+   ->Arg(0)
+   ->Arg(ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault)
+   ->Arg(ROOT::RCompressionSetting::EDefaults::kUseAnalysis)
+   ->Arg(ROOT::RCompressionSetting::EDefaults::kUseGeneralPurpose)
+   ->Arg(ROOT::RCompressionSetting::EDefaults::kUseSmallest)
+   ->Unit(benchmark::kMillisecond);
+
+// Read the baskets of a single branch in bulk, which skips the per-entry overhead of GetEntry
+static void BM_TBasket_ReadBranch(benchmark::State &state)
+{
+   const auto fileName = CreateFile(state.range(0));
+   std::unique_ptr<TFile> file(TFile::Open(fileName.c_str()));
+   auto tree = file->Get<TTree>("t");
+   auto branch = tree->GetBranch("arr");
+
+   for (auto _ : state) {
+      for (Int_t i = 0; i < branch->GetWriteBasket(); ++i) {
+         auto basket = branch->GetBasket(i);
+         benchmark::DoNotOptimize(basket);
+         branch->DropBaskets("all");
+      }
+   }
+   state.SetItemsProcessed(state.iterations() * kNEntries);
+   state.SetBytesProcessed(state.iterations() * branch->GetTotBytes());
+}
+BENCHMARK(BM_TBasket_ReadBranch)
+   ->Arg(0)
+   ->Arg(ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault)
+   ->Arg(ROOT::RCompressionSetting::EDefaults::kUseAnalysis)
+   ->Arg(ROOT::RCompressionSetting::EDefaults::kUseGeneralPurpose)
+   ->Arg(ROOT::RCompressionSetting::EDefaults::kUseSmallest)
+   ->Unit(benchmark::kMillisecond);
@@ -1,10 +1,15 @@
 #include "TFile.h"
 #include "TTree.h"
 #include "TBranch.h"
+#include "TBranchSTL.h"
+#include "TNamed.h"
+#include "TSystem.h"
 #include "TRandom.h"
 
 #include "gtest/gtest.h"
 
+#include <vector>
+
 class TBranchTest : public ::testing::Test {
 protected:
    virtual void SetUp()
@@ -178,3 +183,51 @@ TEST_F(TBranchTest, twoPreviousTest)
    ASSERT_TRUE(branch->GetListOfBaskets()->At(7));
    delete file;
 }
+
+TEST(TBranch, RecycleObjects)
+{
+   const char *fileName = "TBranchRecycleObjects.root";
+   {
+      TFile file(fileName, "RECREATE");
+      TTree tree("tree", "A test tree");
+      std::vector<TNamed *> vec;
+      tree.Branch("vec", &vec, 32000, 199);
+      for (Int_t ev = 0; ev < 10; ev++) {
+         for (Int_t i = 0; i < ev % 3 + 1; ++i)
+            vec.push_back(new TNamed(TString::Format("n%d_%d", ev, i).Data(), "title"));
+         tree.Fill();
+         for (auto named : vec)
+            delete named;
+         vec.clear();
+      }
+      tree.Write();
+   }
+
+   TFile file(fileName);
+   auto tree = file.Get<TTree>("tree");
+   ASSERT_NE(nullptr, tree);
+   auto branch = dynamic_cast<TBranchSTL *>(tree->GetBranch("vec"));
+   ASSERT_NE(nullptr, branch);
+   branch->SetRecycleObjects();
+   EXPECT_TRUE(branch->GetRecycleObjects());
+
+   std::vector<TNamed *> *vec = nullptr;
+   tree->SetBranchAddress("vec", &vec);
+   TNamed *first = nullptr;
+   for (Int_t ev = 0; ev < 10; ev++) {
+      tree->GetEntry(ev);
+      ASSERT_NE(nullptr, vec);
+      ASSERT_EQ(std::size_t(ev % 3 + 1), vec->size());
+      for (Int_t i = 0; i < ev % 3 + 1; ++i)
+         EXPECT_STREQ(TString::Format("n%d_%d", ev, i).Data(), (*vec)[i]->GetName());
+      // The first element of the previous entry is reused
+      if (first)
+         EXPECT_EQ(first, (*vec)[0]);
+      first = (*vec)[0];
+   }
+   tree->ResetBranchAddresses();
+   for (auto named : *vec)
+      delete named;
+   delete vec;
+   gSystem->Unlink(fileName);
+}
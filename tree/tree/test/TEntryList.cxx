@@ -0,0 +1,112 @@
+#include "TEntryList.h"
+
+#include "gtest/gtest.h"
+
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Fill an entry list for tree "t" in file "f.root" with the entries of `entries`
+void Fill(TEntryList &elist, const std::set<Long64_t> &entries)
+{
+   elist.SetTree("t", "f.root");
+   for (auto e : entries)
+      elist.Enter(e);
+   elist.OptimizeStorage();
+}
+
+void ExpectEntries(TEntryList &elist, const std::set<Long64_t> &entries)
+{
+   ASSERT_EQ(Long64_t(entries.size()), elist.GetN());
+   Long64_t i = 0;
+   for (auto e : entries) {
+      EXPECT_EQ(e, elist.GetEntry(i));
+      ++i;
+   }
+   // Random access after the sequential loop
+   i = 0;
+   for (auto e : entries) {
+      if (i % 97 == 0)
+         EXPECT_EQ(e, elist.GetEntry(i));
+      ++i;
+   }
+}
+
+} // anonymous namespace
+
+TEST(TEntryList, AddAndSubtract)
+{
+   // Block 0: dense (bits in one list, "not passing" list in the other),
+   // block 1: sparse in both, block 2: only in one of the lists
+   std::set<Long64_t> entries1, entries2;
+   for (Long64_t e = 0; e < 64000; ++e) {
+      if (e % 2 == 0)
+         entries1.insert(e);
+      if (e % 1000 != 0)
+         entries2.insert(e);
+   }
+   for (Long64_t e = 64000; e < 128000; e += 101)
+      entries1.insert(e);
+   for (Long64_t e = 64000; e < 128000; e += 37)
+      entries2.insert(e);
+   for (Long64_t e = 128000; e < 150000; e += 3)
+      entries1.insert(e);
+
+   std::set<Long64_t> unionEntries(entries1);
+   unionEntries.insert(entries2.begin(), entries2.end());
+   std::set<Long64_t> differenceEntries;
+   for (auto e : entries1) {
+      if (!entries2.count(e))
+         differenceEntries.insert(e);
+   }
+
+   TEntryList elist1, elist2;
+   Fill(elist1, entries1);
+   Fill(elist2, entries2);
+
+   TEntryList sum(elist1);
+   sum.Add(&elist2);
+   ExpectEntries(sum, unionEntries);
+
+   TEntryList difference(elist1);
+   difference.Subtract(&elist2);
+   ExpectEntries(difference, differenceEntries);
+   for (auto e : {0LL, 1000LL, 64000LL, 64000LL + 37 * 101, 128001LL})
+      EXPECT_EQ(differenceEntries.count(e) > 0, difference.Contains(e) > 0);
+
+   // The subtracted list is unchanged
+   ExpectEntries(elist2, entries2);
+}
+
+TEST(TEntryList, ContainsRange)
+{
+   // Block 0: every 10th entry (bits), block 1: sparse (list of passing entries),
+   // block 2: all but a few entries (list of non passing entries), block 3: empty
+   std::set<Long64_t> entries;
+   for (Long64_t e = 0; e < 64000; e += 10)
+      entries.insert(e);
+   for (Long64_t e = 64000; e < 128000; e += 5000)
+      entries.insert(e);
+   for (Long64_t e = 128000; e < 192000; ++e)
+      if (e < 150000 || e > 150100)
+         entries.insert(e);
+   entries.insert(300000);
+
+   TEntryList elist;
+   Fill(elist, entries);
+
+   auto expected = [&entries](Long64_t min, Long64_t max) {
+      auto it = entries.lower_bound(min);
+      return it != entries.end() && *it <= max;
+   };
+   const std::vector<std::pair<Long64_t, Long64_t>> ranges{
+      {0, 0},           {1, 9},           {1, 10},          {11, 19},         {63995, 64005},
+      {64001, 68999},   {64001, 69000},   {100000, 127999}, {128000, 128000}, {150000, 150100},
+      {149999, 150100}, {150050, 150101}, {192000, 299999}, {192000, 300000}, {300001, 400000},
+      {-10, 5},         {10, 5}};
+   for (auto &r : ranges)
+      EXPECT_EQ(expected(r.first, r.second), elist.ContainsRange(r.first, r.second))
+         << "range " << r.first << " - " << r.second;
+}
@@ -0,0 +1,59 @@
+#include "TFile.h"
+#include "TMemFile.h"
+#include "TObjArray.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeCache.h"
+
+#include "gtest/gtest.h"
+
+TEST(TTreeCache, Profile)
+{
+   const auto fileName = "ttreecache_profile.root";
+   {
+      TFile f(fileName, "RECREATE");
+      TTree t("t", "t");
+      int x = 0, y = 0, z = 0;
+      t.Branch("x", &x);
+      t.Branch("y", &y);
+      t.Branch("z", &z);
+      for (int i = 0; i < 1000; ++i) {
+         x = y = z = i;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TMemFile profileFile("ttreecache_profile_sidecar.root", "RECREATE");
+   {
+      TFile f(fileName);
+      auto t = f.Get<TTree>("t");
+      t->SetCacheSize(1000000);
+      int x = 0, z = 0;
+      t->SetBranchAddress("x", &x);
+      t->SetBranchAddress("z", &z);
+      for (Long64_t i = 0; i < t->GetEntries(); ++i) {
+         t->LoadTree(i);
+         t->GetBranch("x")->GetEntry(i);
+         t->GetBranch("z")->GetEntry(i);
+      }
+      auto cache = f.GetCacheRead(t);
+      ASSERT_NE(nullptr, cache);
+      EXPECT_EQ(2, static_cast<TTreeCache *>(cache)->SaveProfile(&profileFile));
+      t->ResetBranchAddresses();
+   }
+
+   TFile f(fileName);
+   auto t = f.Get<TTree>("t");
+   t->SetCacheSize(1000000);
+   auto cache = static_cast<TTreeCache *>(f.GetCacheRead(t));
+   ASSERT_NE(nullptr, cache);
+   EXPECT_EQ(-1, cache->LoadProfile(&profileFile, "nonexistent"));
+   EXPECT_EQ(2, cache->LoadProfile(&profileFile));
+   EXPECT_FALSE(cache->IsLearning());
+   ASSERT_EQ(2, cache->GetCachedBranches()->GetEntriesFast());
+   EXPECT_STREQ("x", cache->GetCachedBranches()->At(0)->GetName());
+   EXPECT_STREQ("z", cache->GetCachedBranches()->At(1)->GetName());
+
+   gSystem->Unlink(fileName);
+}
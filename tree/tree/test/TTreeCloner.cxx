@@ -0,0 +1,99 @@
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Write a tree with branches x (== entry number) and y (== 2 * entry number), with clusters of 100 entries
+void WriteTree(const char *fileName, Long64_t nentries)
+{
+   TFile f(fileName, "RECREATE");
+   TTree t("t", "t");
+   t.SetAutoFlush(100);
+   int x, y;
+   t.Branch("x", &x);
+   t.Branch("y", &y);
+   for (x = 0; x < nentries; ++x) {
+      y = 2 * x;
+      t.Fill();
+   }
+   t.Write();
+}
+
+std::vector<int> ReadX(TTree &t)
+{
+   int x, y;
+   t.SetBranchAddress("x", &x);
+   t.SetBranchAddress("y", &y);
+   std::vector<int> res;
+   for (Long64_t i = 0; i < t.GetEntries(); ++i) {
+      t.GetEntry(i);
+      EXPECT_EQ(2 * x, y);
+      res.push_back(x);
+   }
+   t.ResetBranchAddresses();
+   return res;
+}
+
+} // anonymous namespace
+
+TEST(TTreeCloner, FastPartialCopyEntries)
+{
+   const auto inName = "ttreecloner_partialin.root";
+   const auto outName = "ttreecloner_partialout.root";
+   WriteTree(inName, 1000);
+
+   {
+      TFile in(inName);
+      auto t = in.Get<TTree>("t");
+      TFile out(outName, "RECREATE");
+      std::unique_ptr<TTree> copy(t->CloneTree(0));
+      EXPECT_GT(copy->CopyEntries(t, 537, "fast"), 0);
+      EXPECT_EQ(537, copy->GetEntries());
+      copy->Write();
+   }
+
+   TFile out(outName);
+   auto copy = out.Get<TTree>("t");
+   const auto xs = ReadX(*copy);
+   ASSERT_EQ(537u, xs.size());
+   for (int i = 0; i < 537; ++i)
+      EXPECT_EQ(i, xs[i]);
+
+   gSystem->Unlink(inName);
+   gSystem->Unlink(outName);
+}
+
+TEST(TTreeCloner, FastCopyTreeWithSelection)
+{
+   const auto inName = "ttreecloner_selectionin.root";
+   const auto outName = "ttreecloner_selectionout.root";
+   WriteTree(inName, 1000);
+   const auto selection = "x < 250 || (x >= 420 && x < 730) || x == 900";
+   std::vector<int> expected;
+   for (int x = 0; x < 1000; ++x)
+      if (x < 250 || (x >= 420 && x < 730) || x == 900)
+         expected.push_back(x);
+
+   {
+      TFile in(inName);
+      auto t = in.Get<TTree>("t");
+      TFile out(outName, "RECREATE");
+      std::unique_ptr<TTree> copy(t->CopyTree(selection, "fast"));
+      ASSERT_NE(nullptr, copy);
+      EXPECT_EQ(Long64_t(expected.size()), copy->GetEntries());
+      copy->Write();
+   }
+
+   TFile out(outName);
+   auto copy = out.Get<TTree>("t");
+   EXPECT_EQ(expected, ReadX(*copy));
+
+   gSystem->Unlink(inName);
+   gSystem->Unlink(outName);
+}
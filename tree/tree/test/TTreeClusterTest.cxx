@@ -1,4 +1,5 @@
 #include "TFile.h"
+#include "TMemFile.h"
 #include "TTree.h"
 #include "TBranch.h"
 #include "TRandom.h"
@@ -53,3 +54,73 @@ TEST_F(TTreeClusterTest, countBaskets)
 
    delete file;
 }
+
+TEST(TTreeCluster, adaptiveAutoFlush)
+{
+   TMemFile file("TTreeClusterAdaptive.root", "RECREATE");
+   TTree tree("tree", "A test tree with adaptive autoflush");
+   // 16 doubles: 128 uncompressed bytes per entry, i.e. about 500 entries per cluster of 64000 bytes
+   tree.SetAdaptiveAutoFlush(64000, 1, 3);
+   EXPECT_EQ(64000, tree.GetAdaptiveAutoFlush());
+   Double_t data[16];
+   auto branch = tree.Branch("data", data, "data[16]/D");
+   TRandom random(836);
+   const Long64_t nEntries = 20000;
+   for (Long64_t ev = 0; ev < nEntries; ev++) {
+      for (auto &d : data)
+         d = random.Gaus(100, 7);
+      tree.Fill();
+   }
+   tree.FlushBaskets();
+
+   EXPECT_GT(tree.GetAutoFlush(), 400);
+   EXPECT_LE(tree.GetAutoFlush(), 500);
+
+   // After the tuning clusters, all clusters have the tuned size and are held by few baskets
+   auto clusterIter = tree.GetClusterIterator(nEntries / 2);
+   Long64_t start = clusterIter();
+   Long64_t nClusters = 0;
+   Long64_t lastFull = start;
+   while (clusterIter.GetNextEntry() < nEntries) {
+      EXPECT_EQ(tree.GetAutoFlush(), clusterIter.GetNextEntry() - clusterIter.GetStartEntry());
+      ++nClusters;
+      lastFull = clusterIter.GetNextEntry();
+      clusterIter();
+   }
+   ASSERT_GT(nClusters, 0);
+   Int_t nBaskets = 0;
+   for (Int_t i = 0; i < branch->GetWriteBasket(); ++i) {
+      const Long64_t first = branch->GetBasketEntry()[i];
+      if (first >= start && first < lastFull)
+         ++nBaskets;
+   }
+   EXPECT_LE(nBaskets, 2 * nClusters);
+}
+
+TEST(TTreeCluster, clusterStatistics)
+{
+   TMemFile file("TTreeClusterStatistics.root", "RECREATE");
+   TTree tree("tree", "A tree with per-cluster statistics");
+   tree.SetAutoFlush(100);
+   Int_t x = 0;
+   Float_t y = 0.f;
+   tree.Branch("x", &x);
+   tree.Branch("y", &y);
+   EXPECT_EQ(0, tree.AddClusterStatistics("x"));
+   EXPECT_EQ(-1, tree.AddClusterStatistics("nonexistent"));
+   for (x = 0; x < 250; ++x) {
+      y = -x;
+      tree.Fill();
+   }
+   tree.Write();
+
+   Double_t min, max;
+   EXPECT_EQ(100, tree.GetClusterStatistics("x", 42, min, max));
+   EXPECT_EQ(0., min);
+   EXPECT_EQ(99., max);
+   EXPECT_EQ(250, tree.GetClusterStatistics("x", 249, min, max));
+   EXPECT_EQ(200., min);
+   EXPECT_EQ(249., max);
+   EXPECT_EQ(-1, tree.GetClusterStatistics("x", 250, min, max));
+   EXPECT_EQ(-1, tree.GetClusterStatistics("y", 0, min, max));
+}
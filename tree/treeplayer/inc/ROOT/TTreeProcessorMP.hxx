@@ -27,6 +27,8 @@
 #include "TSelector.h"
 #include "TTreeReader.h"
 #include <algorithm> //std::generate
+#include <deque>
+#include <map>
 #include <numeric> //std::iota
 #include <string>
 #include <type_traits> //std::result_of, std::enable_if
@@ -166,12 +168,18 @@ private:
    template<class T> void Collect(std::vector<T> &reslist);
    template<class T> void HandlePoolCode(MPCodeBufPair &msg, TSocket *sender, std::vector<T> &reslist);
 
+   unsigned EvalNRanges(unsigned nFiles);
    void FixLists(std::vector<TObject*> &lists);
    void Reset();
-   void ReplyToIdle(TSocket *s);
+   bool ReplyToIdle(TSocket *s);
+   bool RetryTask(TSocket *s);
+   unsigned StartTasks();
 
    unsigned fNProcessed; ///< number of arguments already passed to the workers
    unsigned fNToProcess; ///< total number of arguments to pass to the workers
+   std::deque<unsigned> fRetryQueue;         ///< arguments of the failed tasks to pass to the workers again
+   std::map<TSocket *, unsigned> fWorkerTask; ///< the argument of the last task passed to each worker
+   std::map<unsigned, unsigned> fNRetries;   ///< number of times each failed task has been retried
 
    /// A collection of the types of tasks that TTreeProcessorMP can execute.
    /// It is used to interpret in the right way and properly reply to the
@@ -179,7 +187,8 @@ private:
    enum class ETask : unsigned char {
       kNoTask,        ///< no task is being executed
       kProcByRange,   ///< a Process method is being executed and each worker will process a certain range of each file
-      kProcByFile     ///< a Process method is being executed and each worker will process a different file
+      kProcByFile,    ///< a Process method is being executed and each worker will process a different file
+      kProcTreeByRange ///< a Process method is being executed and each worker will process a certain range of the tree
    };
 
    ETask fTaskType = ETask::kNoTask; ///< the kind of task that is being executed, if any
@@ -204,38 +213,25 @@ auto TTreeProcessorMP::Process(const std::vector<std::string>& fileNames, F proc
    //prepare environment
    Reset();
    unsigned nWorkers = GetNWorkers();
+   //each file is split in ranges aligned to its clusters, which are passed to the workers when they are idle
+   unsigned nRanges = EvalNRanges(fileNames.size());
 
    // Check th entry list
    TEntryList *elist = (entries.IsValid()) ? &entries : nullptr;
    //fork
    TMPWorkerTreeFunc<F> worker(procFunc, fileNames, elist, treeName, nWorkers, nToProcess, jFirst);
+   worker.SetNRanges(nRanges);
    bool ok = Fork(worker);
    if(!ok) {
       Error("TTreeProcessorMP::Process", "[E][C] Could not fork. Aborting operation.");
       return nullptr;
    }
 
-
-   if(fileNames.size() < nWorkers) {
-      //TTree entry granularity. For each file, we divide entries equally between workers
-      fTaskType = ETask::kProcByRange;
-      //Tell workers to start processing entries
-      fNToProcess = nWorkers*fileNames.size(); //this is the total number of ranges that will be processed by all workers cumulatively
-      std::vector<unsigned> args(nWorkers);
-      std::iota(args.begin(), args.end(), 0);
-      fNProcessed = Broadcast(MPCode::kProcRange, args);
-      if(fNProcessed < nWorkers)
-         Error("TTreeProcessorMP::Process", "[E][C] There was an error while sending tasks to workers. Some entries might not be processed.");
-   } else {
-      //file granularity. each worker processes one whole file as a single task
-      fTaskType = ETask::kProcByFile;
-      fNToProcess = fileNames.size();
-      std::vector<unsigned> args(nWorkers);
-      std::iota(args.begin(), args.end(), 0);
-      fNProcessed = Broadcast(MPCode::kProcFile, args);
-      if(fNProcessed < nWorkers)
-         Error("TTreeProcessorMP::Process", "[E][C] There was an error while sending tasks to workers. Some entries might not be processed.");
-   }
+   //Tell workers to start processing entries
+   fTaskType = ETask::kProcByRange;
+   fNToProcess = nRanges*fileNames.size(); //this is the total number of ranges that will be processed by all workers cumulatively
+   if(StartTasks() < nWorkers)
+      Error("TTreeProcessorMP::Process", "[E][C] There was an error while sending tasks to workers. Some entries might not be processed.");
 
    //collect results, distribute new tasks
    std::vector<TObject*> reslist;
@@ -308,26 +304,25 @@ auto TTreeProcessorMP::Process(TTree& tree, F procFunc, TEntryList &entries,
    //prepare environment
    Reset();
    unsigned nWorkers = GetNWorkers();
+   //the tree is split in ranges aligned to its clusters, which are passed to the workers when they are idle
+   unsigned nRanges = EvalNRanges(1);
 
    // Check th entry list
    TEntryList *elist = (entries.IsValid()) ? &entries : nullptr;
    //fork
    TMPWorkerTreeFunc<F> worker(procFunc, &tree, elist, nWorkers, nToProcess, jFirst);
+   worker.SetNRanges(nRanges);
    bool ok = Fork(worker);
    if(!ok) {
       Error("TTreeProcessorMP::Process", "[E][C] Could not fork. Aborting operation.");
       return nullptr;
    }
 
-   //divide entries equally between workers
-   fTaskType = ETask::kProcByRange;
+   fTaskType = ETask::kProcTreeByRange;
 
    //tell workers to start processing entries
-   fNToProcess = nWorkers; //this is the total number of ranges that will be processed by all workers cumulatively
-   std::vector<unsigned> args(nWorkers);
-   std::iota(args.begin(), args.end(), 0);
-   fNProcessed = Broadcast(MPCode::kProcTree, args);
-   if(fNProcessed < nWorkers)
+   fNToProcess = nRanges; //this is the total number of ranges that will be processed by all workers cumulatively
+   if(StartTasks() < nWorkers)
       Error("TTreeProcessorMP::Process", "[E][C] There was an error while sending tasks to workers. Some entries might not be processed.");
 
    //collect results, distribute new tasks
@@ -412,8 +407,12 @@ void TTreeProcessorMP::HandlePoolCode(MPCodeBufPair &msg, TSocket *s, std::vecto
       MPSend(s, MPCode::kShutdownOrder);
    } else if(code == MPCode::kProcError) {
       const char *str = ReadBuffer<const char*>(msg.second.get());
-      Error("TTreeProcessorMP::HandlePoolCode", "[E][C] a worker encountered an error: %s\n"
-                                         "Continuing execution ignoring these entries.", str);
+      if (RetryTask(s))
+         Error("TTreeProcessorMP::HandlePoolCode", "[E][C] a worker encountered an error: %s\n"
+                                            "Retrying these entries.", str);
+      else
+         Error("TTreeProcessorMP::HandlePoolCode", "[E][C] a worker encountered an error: %s\n"
+                                            "Continuing execution ignoring these entries.", str);
       ReplyToIdle(s);
       delete [] str;
    } else {
@@ -25,6 +25,7 @@
 #include "ROOT/TThreadedObject.hxx"
 #include "ROOT/TThreadExecutor.hxx"
 
+#include <cstddef> // std::size_t
 #include <functional>
 #include <utility> // std::pair
 #include <vector>
@@ -56,6 +57,8 @@ struct FriendInfo {
    /// Names of the files where each friend is stored. fFriendFileNames[i] is the list of files for friend with
    /// name fFriendNames[i]
    std::vector<std::vector<std::string>> fFriendFileNames;
+   /// Major and minor names of the index of each friend, empty if the friend has no index
+   std::vector<NameAlias> fFriendIndexNames;
 };
 
 class TTreeView {
@@ -99,6 +102,13 @@ private:
    static unsigned int fgMaxTasksPerFilePerWorker;
 
 public:
+   /// The range of entries processed by a task of ProcessTasks
+   struct TTaskRange {
+      std::size_t fIndex;   ///< Index of the task: tasks are numbered in the order of their entries
+      Long64_t fFirstEntry; ///< Number of the first entry of the task in the whole dataset (or in the entry list)
+      Long64_t fEndEntry;   ///< Number of the entry after the last entry of the task
+   };
+
    TTreeProcessorMT(std::string_view filename, std::string_view treename = "", UInt_t nThreads = 0u);
    TTreeProcessorMT(const std::vector<std::string_view> &filenames, std::string_view treename = "",
                     UInt_t nThreads = 0u);
@@ -106,6 +116,8 @@ public:
    TTreeProcessorMT(TTree &tree, UInt_t nThreads = 0u);
 
    void Process(std::function<void(TTreeReader &)> func);
+   void ProcessTasks(std::function<void(TTreeReader &, const TTaskRange &)> func, Long64_t endEntry = -1,
+                     bool inOrder = false);
    static void SetMaxTasksPerFilePerWorker(unsigned int m);
    static unsigned int GetMaxTasksPerFilePerWorker();
 };
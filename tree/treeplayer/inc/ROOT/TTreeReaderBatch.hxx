@@ -0,0 +1,233 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTreeReaderBatch
+#define ROOT_TTreeReaderBatch
+
+#include "TBranch.h"
+#include "TBufferFile.h"
+#include "TDataType.h"
+#include "TTreeReader.h"
+#include "TTreeReaderValue.h"
+
+#include <ROOT/RStringView.hxx>
+#include <ROOT/RVec.hxx>
+
+#include <deque>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+class TDirectory;
+class TTree;
+
+namespace ROOT {
+namespace Experimental {
+
+class TTreeReaderBatch;
+
+namespace Internal {
+
+/** \class ROOT::Experimental::Internal::TTreeReaderBatchValueBase
+Common part of the batch value readers: holds the bulk-read basket of one branch.
+*/
+class TTreeReaderBatchValueBase {
+public:
+   TTreeReaderBatchValueBase(TTreeReaderBatch &reader, std::string_view branchName, EDataType type, Bool_t isJagged);
+   TTreeReaderBatchValueBase(const TTreeReaderBatchValueBase &) = delete;
+   TTreeReaderBatchValueBase &operator=(const TTreeReaderBatchValueBase &) = delete;
+   virtual ~TTreeReaderBatchValueBase();
+
+   ROOT::Internal::TTreeReaderValueBase::ESetupStatus GetSetupStatus() const { return fSetupStatus; }
+   ROOT::Internal::TTreeReaderValueBase::EReadStatus GetReadStatus() const { return fReadStatus; }
+   const std::string &GetBranchName() const { return fBranchName; }
+
+protected:
+   /// Bulk-read the basket of fBranch starting at the tree entry `entry`; returns the number of entries read or -1.
+   virtual Int_t ReadBasket(Long64_t entry) = 0;
+   /// Point the view of the derived class to the `n` entries of the current basket starting at tree entry `entry`.
+   virtual void SetView(Long64_t entry, Int_t n) = 0;
+
+   TBranch *fBranch{nullptr}; ///< Branch of the current tree we are reading
+   TBufferFile fBuffer;       ///< Buffer holding the current basket, in host byte order
+   Long64_t fBasketFirst{-1}; ///< Tree entry of the first entry in fBuffer
+   Int_t fBasketSize{0};      ///< Number of entries in fBuffer
+
+private:
+   void Attach(TTree *tree);
+   Int_t Prepare(Long64_t entry);
+   void MarkTreeReaderUnavailable() { fTreeReader = nullptr; }
+
+   std::string fBranchName;               ///< Name of the branch we read from
+   EDataType fType;                       ///< Type of the values (or of the array elements) we read
+   Bool_t fIsJagged;                      ///< Whether each entry is a variable-size array of values
+   TTreeReaderBatch *fTreeReader{nullptr}; ///< Reader we belong to
+
+   ROOT::Internal::TTreeReaderValueBase::ESetupStatus fSetupStatus{
+      ROOT::Internal::TTreeReaderValueBase::kSetupNotSetup}; ///< Setup status of this data access
+   ROOT::Internal::TTreeReaderValueBase::EReadStatus fReadStatus{
+      ROOT::Internal::TTreeReaderValueBase::kReadNothingYet}; ///< Read status of this data access
+
+   friend class ROOT::Experimental::TTreeReaderBatch;
+};
+
+} // namespace Internal
+
+/** \class ROOT::Experimental::TTreeReaderBatch
+\ingroup treeplayer
+\brief A TTreeReader mode that moves forward through a tree one batch of entries at a time.
+
+Every call to Next() loads the next range of entries that all the registered
+TTreeReaderBatchValue and TTreeReaderBatchArray objects can provide from the
+basket they hold in memory, i.e. batches end at the basket boundaries of the
+branches read. The data is read with the bulk I/O interface of TBranch and exposed
+as ROOT::VecOps::RVec objects viewing the basket memory, no entry-wise
+TBranch::GetEntry call is involved. Without any registered reader, a batch is a
+cluster of the tree.
+
+~~~{.cpp}
+ROOT::Experimental::TTreeReaderBatch reader(tree);
+ROOT::Experimental::TTreeReaderBatchValue<float> pt(reader, "pt");
+ROOT::Experimental::TTreeReaderBatchArray<float> jets(reader, "jets");
+while (reader.Next()) {
+   const auto &ptBatch = *pt;   // reader.GetBatchSize() values
+   for (std::size_t i = 0; i < jets.GetSize(); ++i)
+      auto nJets = jets[i].size();
+}
+~~~
+
+The views are only valid until the next call to Next(). Only branches with a
+single leaf of a fundamental type, fixed-size leaf arrays excepted, are supported
+by TTreeReaderBatchValue; TTreeReaderBatchArray supports leaf arrays with a count
+leaf and `std::vector`s of fundamental types (see TBranch::SupportsJaggedBulkRead).
+Baskets with entry displacements, such as those from TTree::CopyEntries of a
+`std::vector` branch, cannot be bulk-read.
+*/
+class TTreeReaderBatch : public TObject {
+public:
+   TTreeReaderBatch(TTree *tree);
+   TTreeReaderBatch(const char *keyname, TDirectory *dir = nullptr);
+   ~TTreeReaderBatch();
+
+   Bool_t Next();
+
+   /// Return the entry number (in the chain, if the tree is a chain) of the first entry of the current batch.
+   Long64_t GetCurrentEntry() const { return fEntry; }
+   /// Return the number of entries of the current batch.
+   Int_t GetBatchSize() const { return fBatchSize; }
+   TTreeReader::EEntryStatus GetEntryStatus() const { return fEntryStatus; }
+   TTree *GetTree() const { return fTree; }
+
+private:
+   void RegisterValueReader(Internal::TTreeReaderBatchValueBase *reader);
+   void DeregisterValueReader(Internal::TTreeReaderBatchValueBase *reader);
+
+   TTree *fTree{nullptr};      ///< Tree or chain that's read
+   Int_t fTreeNumber{-1};      ///< Number of the tree of a chain the value readers are attached to
+   Long64_t fEntry{-1};        ///< First entry of the current batch
+   Int_t fBatchSize{0};        ///< Number of entries of the current batch
+   TTreeReader::EEntryStatus fEntryStatus{TTreeReader::kEntryNotLoaded}; ///< Status of the most recent Next()
+   std::deque<Internal::TTreeReaderBatchValueBase *> fValues; ///< Readers that use us
+
+   friend class Internal::TTreeReaderBatchValueBase;
+
+   ClassDef(TTreeReaderBatch, 0); // A TTreeReader mode reading whole batches of entries via bulk I/O
+};
+
+/** \class ROOT::Experimental::TTreeReaderBatchValue
+\ingroup treeplayer
+\brief Exposes the values of a branch of fundamental type `T` for all the entries of the current batch.
+*/
+template <typename T>
+class TTreeReaderBatchValue final : public Internal::TTreeReaderBatchValueBase {
+   static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value,
+                 "TTreeReaderBatchValue only supports fundamental types other than bool");
+
+public:
+   TTreeReaderBatchValue(TTreeReaderBatch &reader, std::string_view branchName)
+      : TTreeReaderBatchValueBase(reader, branchName, TDataType::GetType(typeid(T)), kFALSE)
+   {
+   }
+
+   /// Return the values of the entries of the current batch.
+   const ROOT::VecOps::RVec<T> &Get() const { return fView; }
+   const ROOT::VecOps::RVec<T> &operator*() const { return fView; }
+   const ROOT::VecOps::RVec<T> *operator->() const { return &fView; }
+
+protected:
+   Int_t ReadBasket(Long64_t entry) final { return fBranch->GetBulkRead().GetBulkEntries(entry, fBuffer); }
+   void SetView(Long64_t entry, Int_t n) final
+   {
+      ROOT::VecOps::RVec<T> view(reinterpret_cast<T *>(fBuffer.GetCurrent()) + (entry - fBasketFirst), n);
+      std::swap(fView, view);
+   }
+
+private:
+   ROOT::VecOps::RVec<T> fView; ///< View on the basket memory
+};
+
+/** \class ROOT::Experimental::TTreeReaderBatchArray
+\ingroup treeplayer
+\brief Exposes the variable-size arrays of `T` of a branch for all the entries of the current batch.
+*/
+template <typename T>
+class TTreeReaderBatchArray final : public Internal::TTreeReaderBatchValueBase {
+   static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value,
+                 "TTreeReaderBatchArray only supports fundamental types other than bool");
+
+public:
+   TTreeReaderBatchArray(TTreeReaderBatch &reader, std::string_view branchName)
+      : TTreeReaderBatchValueBase(reader, branchName, TDataType::GetType(typeid(T)), kTRUE)
+   {
+   }
+
+   /// Return the number of entries of the current batch.
+   std::size_t GetSize() const { return fSize; }
+   /// Return the elements of all the entries of the current batch as one contiguous array.
+   const ROOT::VecOps::RVec<T> &GetElements() const { return fElements; }
+   /// Return the index in GetElements() of the first element of entry `i` of the batch; `i` can be GetSize().
+   Int_t GetOffset(std::size_t i) const { return fOffsets[fFirst + i] - fOffsets[fFirst]; }
+   /// Return the array of entry `i` of the current batch.
+   ROOT::VecOps::RVec<T> operator[](std::size_t i) const
+   {
+      return ROOT::VecOps::RVec<T>(const_cast<T *>(fElements.data()) + GetOffset(i), GetOffset(i + 1) - GetOffset(i));
+   }
+
+protected:
+   Int_t ReadBasket(Long64_t entry) final
+   {
+      const Int_t n = fBranch->GetBulkRead().GetEntriesJagged(entry, fBuffer, fOffsets);
+      // The elements are in serialized form; swap them to host byte order in place
+      if ((n > 0) && (sizeof(T) > 1) && !fBuffer.ByteSwapBuffer(fOffsets[n], TDataType::GetType(typeid(T))))
+         return -1;
+      return n;
+   }
+   void SetView(Long64_t entry, Int_t n) final
+   {
+      fFirst = entry - fBasketFirst;
+      fSize = n;
+      ROOT::VecOps::RVec<T> view(reinterpret_cast<T *>(fBuffer.GetCurrent()) + fOffsets[fFirst],
+                                 fOffsets[fFirst + n] - fOffsets[fFirst]);
+      std::swap(fElements, view);
+   }
+
+private:
+   ROOT::VecOps::RVec<T> fElements; ///< View on the basket memory holding the elements of the batch
+   std::vector<Int_t> fOffsets;     ///< Element offsets of the entries of the basket
+   Int_t fFirst{0};                 ///< Index in the basket of the first entry of the batch
+   std::size_t fSize{0};            ///< Number of entries of the batch
+};
+
+} // namespace Experimental
+} // namespace ROOT
+
+#endif
@@ -28,6 +28,7 @@
 
 class TBranch;
 class TStreamerElement;
+class TStreamerInfo;
 
 // Note we could protect the arrays more by introducing a class TArrayWrapper<class T> which somehow knows
 // its internal dimensions and check for them ...
@@ -102,6 +103,15 @@ namespace Detail {
       void    *fWhere;    // memory location of the data
       TVirtualCollectionProxy *fCollection; // Handle to the collection containing the data chunk.
 
+      // The types resolved by Setup() for a TBranchElement only depend on the layout of the branch. They are kept
+      // to be reused when the next tree of a chain has the same layout, i.e. the same TStreamerInfo, ID and type.
+      const TStreamerInfo *fLayoutInfo = nullptr;      // TStreamerInfo of the branch at the last Setup()
+      Int_t             fLayoutID = 0;                  // ID of the branch at the last Setup()
+      Int_t             fLayoutType = 0;                // Type of the branch at the last Setup()
+      TClass           *fLayoutClass = nullptr;         // Class of the proxied object resolved by the last Setup()
+      TStreamerElement *fLayoutMemberElement = nullptr; // Element of the proxied data member, if resolved
+      Int_t             fLayoutMemberOffset = 0;        // Offset of the proxied data member, if resolved
+
    public:
       virtual void Print();
 
@@ -45,10 +45,14 @@ public:
    TMPWorkerTree(const TMPWorkerTree &) = delete;
    TMPWorkerTree &operator=(const TMPWorkerTree &) = delete;
 
+   /// Set the number of ranges each file (or the tree) is split into, which defaults to the number of workers
+   void SetNRanges(UInt_t nRanges) { fNRanges = nRanges; }
+
 protected:
 
    void         CloseFile();
    ULong64_t    EvalMaxEntries(ULong64_t maxEntries);
+   void         EvalRange(TTree *tree, Long64_t nEntries, UInt_t rangeN, Long64_t &start, Long64_t &finish);
    void         HandleInput(MPCodeBufPair& msg); ///< Execute instructions received from a MP client
    void Init(int fd, UInt_t workerN);
    Int_t LoadTree(UInt_t code, MPCodeBufPair &msg, Long64_t &start, Long64_t &finish, TEntryList **enl,
@@ -66,6 +70,7 @@ protected:
    TFile *fFile;                        ///< last open file
    TEntryList *fEntryList;              ///< entrylist
    ULong64_t fFirstEntry;               ///< first entry to br processed
+   UInt_t fNRanges;                     ///< number of ranges each file (or the tree) is split into
 
 private:
 
@@ -198,6 +203,12 @@ void TMPWorkerTreeFunc<F>::Process(UInt_t code, MPCodeBufPair &msg)
       return;
    }
 
+   // ranges aligned to clusters can be empty
+   if (start >= finish) {
+      MPSend(GetSocket(), MPCode::kIdling);
+      return;
+   }
+
    // create a TTreeReader that reads this range of entries
    TTreeReader reader(fTree, enl);
 
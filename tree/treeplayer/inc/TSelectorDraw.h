@@ -62,11 +62,15 @@ protected:
    Bool_t         fCleanElist;     //  true if original Tree elist must be saved
    Bool_t         fObjEval;        //  true if fVar1 returns an object (or pointer to).
    Long64_t       fCurrentSubEntry; // Current subentry when fSelectMultiple is true. Used to fill TEntryListArray
+   Bool_t         fJit;            //! true if the formulas are to be compiled (option "jit")
+   TString        fVarExp;         //! Expression of the variables, without the ">>" redirection
+   TString        fSelectionExp;   //! Selection, including the cut of a reapplied entry list
 
 protected:
    virtual void      ClearFormula();
    virtual Bool_t    CompileVariables(const char *varexp="", const char *selection="");
    virtual void      InitArrays(Int_t newsize);
+   void              InitFill();
 
 private:
    TSelectorDraw(const TSelectorDraw&);             // not implemented
@@ -77,6 +81,8 @@ public:
    virtual ~TSelectorDraw();
 
    virtual void      Begin(TTree *tree);
+   virtual Bool_t    CanProcessMT() const;
+   TSelectorDraw    *CreateSlotSelector() const;
    virtual Int_t     GetAction() const {return fAction;}
    virtual Bool_t    GetCleanElist() const {return fCleanElist;}
    virtual Int_t     GetDimension() const {return fDimension;}
@@ -107,6 +113,9 @@ public:
    // See TSelectorDraw::GetVal
    virtual Double_t *GetV4() const   {return GetVal(3);}
    virtual Double_t *GetW() const    {return fW;}
+   virtual Bool_t    InitSlot(TTree *tree);
+   virtual void      FinishSlot();
+   virtual void      MergeSlot(TSelectorDraw &slot);
    virtual Bool_t    Notify();
    virtual Bool_t    Process(Long64_t /*entry*/) { return kFALSE; }
    virtual void      ProcessFill(Long64_t entry);
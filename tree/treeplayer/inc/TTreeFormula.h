@@ -131,6 +131,9 @@ protected:
 
    RealInstanceCache fRealInstanceCache; //! Cache accelerating the GetRealInstance function
 
+   Double_t (*fJitFunction)(const Double_t *) = nullptr; //! Compiled operations of the formula, see EnableJit()
+   std::vector<Int_t> fJitCodes;                         //! Codes of the variables passed to fJitFunction
+
    TTreeFormula(const char *name, const char *formula, TTree *tree, const std::vector<std::string>& aliases);
    void Init(const char *name, const char *formula);
    Bool_t      BranchHasMethod(TLeaf* leaf, TBranch* branch, const char* method,const char* params, Long64_t readentry) const;
@@ -168,6 +171,7 @@ private:
    TTreeFormula& operator=(const TTreeFormula&) = delete;
 
    template<typename T> T GetConstant(Int_t k);
+   Double_t EvalJitted(Int_t instance);
 
 public:
    TTreeFormula();
@@ -182,6 +186,9 @@ public:
    virtual Long64_t       EvalInstance64(Int_t i=0, const char *stringStack[]=0) {return EvalInstance<Long64_t>(i, stringStack); }
    virtual LongDouble_t   EvalInstanceLD(Int_t i=0, const char *stringStack[]=0) {return EvalInstance<LongDouble_t>(i, stringStack); }
 
+           Bool_t      EnableJit(Bool_t enable = kTRUE);
+           Bool_t      IsJitted() const { return fJitFunction != nullptr; }
+
    virtual const char *EvalStringInstance(Int_t i=0);
    virtual void*       EvalObject(Int_t i=0);
    // EvalInstance should be const.  See comment on GetNdata()
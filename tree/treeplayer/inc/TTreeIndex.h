@@ -44,6 +44,8 @@ protected:
    TTreeFormula  *GetMinorFormulaParent(const TTree *parent);
 
 private:
+   Bool_t         FillValuesMT(Long64_t *major, Long64_t *minor);
+
    TTreeIndex(const TTreeIndex&) = delete;            // Not implemented.
    TTreeIndex &operator=(const TTreeIndex&) = delete; // Not implemented.
 
@@ -23,6 +23,8 @@
 
 #include "TVirtualPerfStats.h"
 #include "TString.h"
+#include <map>
+#include <string>
 #include <vector>
 #include <unordered_map>
 
@@ -45,7 +47,19 @@ public:
       UInt_t fMissed = {0};     // Number of times the basket was read directly from the file.
    };
 
+   struct BranchInfo {
+      Long64_t fReadBytes = {0};   // Number of (compressed) bytes of the baskets read.
+      Long64_t fUnzipBytes = {0};  // Number of bytes after decompression of the baskets read.
+      Double_t fReadTime = {0};    // Time spent getting the baskets from the file or the TTreeCache.
+      Double_t fUnzipTime = {0};   // Time spent decompressing the baskets.
+      Double_t fStreamTime = {0};  // Time spent deserializing the entries.
+      UInt_t fCacheHits = {0};     // Number of baskets found in the TTreeCache.
+      UInt_t fCacheMisses = {0};   // Number of baskets read directly from the file.
+      Long64_t fEntries = {0};     // Number of entries deserialized.
+   };
+
    using BasketList_t = std::vector<std::pair<TBranch*, std::vector<size_t>>>;
+   using BranchInfoMap_t = std::map<std::string, BranchInfo>;
 
 protected:
    Int_t         fTreeCacheSize; //TTreeCache buffer size
@@ -74,8 +88,12 @@ protected:
    std::unordered_map<TBranch*, size_t>  fBranchIndexCache; // Cache the index of the branch in the cache's array.
    std::vector<std::vector<BasketInfo> > fBasketsInfo;      // Details on which baskets was used, cached, 'miss-cached' or read uncached.Browse
 
+   BranchInfoMap_t fBranchesInfo;                                        //! Per-branch counters, by branch name
+   std::unordered_map<TBranch*, BranchInfoMap_t::value_type*> fBranchInfoCache; //! Speeds up the lookup in fBranchesInfo
+
    BasketInfo &GetBasketInfo(TBranch *b, size_t basketNumber);
    BasketInfo &GetBasketInfo(size_t bi, size_t basketNumber);
+   BranchInfo &GetOrAddBranchInfo(TBranch *b);
 
 public:
    TTreePerfStats();
@@ -114,6 +132,9 @@ public:
    virtual void     FileReadEvent(TFile *file, Int_t len, Double_t start);
    virtual void     UnzipEvent(TObject *tree, Long64_t pos, Double_t start, Int_t complen, Int_t objlen);
    virtual void     RateEvent(Double_t , Double_t , Long64_t , Long64_t) {}
+   virtual void     BasketReadEvent(TBranch *branch, Int_t nbytes, Double_t start, Bool_t fromCache);
+   virtual void     BasketUnzipEvent(TBranch *branch, Double_t start, Int_t complen, Int_t objlen);
+   virtual void     BranchStreamEvent(TBranch *branch, Double_t start);
 
    virtual void     SaveAs(const char *filename="",Option_t *option="") const;
    virtual void     SavePrimitive(std::ostream &out, Option_t *option = "");
@@ -148,6 +169,11 @@ public:
 
    BasketList_t     GetDuplicateBasketCache() const;
 
+   const BranchInfo *GetBranchInfo(const char *branchname) const;
+   const BranchInfoMap_t &GetBranchesInfo() const { return fBranchesInfo; }
+   virtual void     PrintBranchInfo(Option_t *option = "") const;
+   std::string      GetBranchInfoJSON() const;
+
    ClassDef(TTreePerfStats, 7) // TTree I/O performance measurement
 };
 
@@ -57,6 +57,7 @@ protected:
 protected:
    const   char  *GetNameByIndex(TString &varexp, Int_t *index,Int_t colindex);
    void           DeleteSelectorFromFile();
+   Long64_t       ProcessDrawMT(Long64_t firstentry, Long64_t nentries);
 
 public:
    TTreePlayer();
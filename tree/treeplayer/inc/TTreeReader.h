@@ -28,6 +28,7 @@
 
 #include <deque>
 #include <iterator>
+#include <set>
 #include <unordered_map>
 #include <string>
 
@@ -215,6 +216,12 @@ public:
    /// Restart a Next() loop from entry 0 (of TEntryList index 0 of fEntryList is set).
    void Restart();
 
+   /// Flag the branches that are read only for a small fraction of the entries, e.g.
+   /// downstream of a selective cut. If the TTreeCache unzips baskets in parallel, it
+   /// still prefetches their baskets, but only unzips them when they are needed.
+   /// Must be called before the first entry is loaded.
+   void SetLateBranches(const std::set<std::string> &branchNames) { fLateBranches = branchNames; }
+
    ///\}
 
    EEntryStatus GetEntryStatus() const { return fEntryStatus; }
@@ -303,6 +310,7 @@ private:
    Long64_t fBeginEntry = 0LL; ///< This allows us to propagate the range to the TTreeCache
    Bool_t fProxiesSet = kFALSE; ///< True if the proxies have been set, false otherwise
    Bool_t fSetEntryBaseCallingLoadTree = kFALSE; ///< True if during the LoadTree execution triggered by SetEntryBase.
+   std::set<std::string> fLateBranches; ///< Branches whose baskets are unzipped only when needed, see SetLateBranches()
 
    friend class ROOT::Internal::TTreeReaderValueBase;
    friend class ROOT::Internal::TTreeReaderArrayBase;
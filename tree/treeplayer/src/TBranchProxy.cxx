@@ -312,12 +312,14 @@ Bool_t ROOT::Detail::TBranchProxy::Setup()
       }
 
 
+      bool sameLayout = false;
       if (fWhere && fBranch->IsA()==TBranchElement::Class()) {
 
          TBranchElement* be = ((TBranchElement*)fBranch);
 
          TStreamerInfo * info = be->GetInfo();
          Int_t id = be->GetID();
+         sameLayout = fLayoutClass && info == fLayoutInfo && id == fLayoutID && be->GetType() == fLayoutType;
          if (be->GetType() == 3) {
             fClassName = "TClonesArray";
             fClass = TClonesArray::Class();
@@ -330,7 +332,11 @@ Bool_t ROOT::Detail::TBranchProxy::Setup()
             if ((fIsMember || (be->GetType()!=3 && be->GetType() !=4))
                   && (be->GetType()!=31 && be->GetType()!=41)) {
 
-               if (fClass==TClonesArray::Class()) {
+               if (fClass==TClonesArray::Class() && sameLayout && !strcmp(be->GetClonesName(), fLayoutClass->GetName())) {
+                  // No need to read an entry to find the class of the content of the TClonesArray again
+                  if (!fIsMember) fIsClone = true;
+                  fClass = fLayoutClass;
+               } else if (fClass==TClonesArray::Class()) {
                   Int_t i = be->GetTree()->GetReadEntry();
                   if (i<0) i = 0;
                   be->GetEntry(i);
@@ -355,7 +361,7 @@ Bool_t ROOT::Detail::TBranchProxy::Setup()
             if (fClass) fClassName = fClass->GetName();
          } else {
             fClassName = be->GetClassName();
-            fClass = TClass::GetClass(fClassName);
+            fClass = sameLayout ? fLayoutClass : TClass::GetClass(fClassName);
          }
 
          if (be->GetType()==3) {
@@ -400,6 +406,14 @@ Bool_t ROOT::Detail::TBranchProxy::Setup()
             fWhere = ((unsigned char*)be->GetObject()) + fOffset;
 
          }
+
+         if (!sameLayout) {
+            fLayoutInfo = info;
+            fLayoutID = id;
+            fLayoutType = be->GetType();
+            fLayoutClass = fClass;
+            fLayoutMemberElement = nullptr;
+         }
       } else {
          fClassName = fBranch->GetClassName();
          fClass = TClass::GetClass(fClassName);
@@ -454,13 +468,22 @@ Bool_t ROOT::Detail::TBranchProxy::Setup()
                                   bcount?bcount->GetName():"unknown"));
             }
 
+         } else if (fClass && sameLayout && fLayoutMemberElement) {
+
+            fElement = fLayoutMemberElement;
+            fMemberOffset = fLayoutMemberOffset;
+
          } else if (fClass) {
 
             fElement = (TStreamerElement*)
                fClass->GetStreamerInfo()->GetElements()->FindObject(fDataMember);
-            if (fElement)
+            if (fElement) {
                fMemberOffset = fElement->GetOffset();
-            else {
+               if (fLayoutClass == fClass) {
+                  fLayoutMemberElement = fElement;
+                  fLayoutMemberOffset = fMemberOffset;
+               }
+            } else {
                // Need to compose the proper sub name
 
                TString member;
@@ -32,9 +32,6 @@ ClassImp(ROOT::Internal::TBranchProxyDirector);
 namespace ROOT {
 namespace Internal {
 
-   // Helper function to call Reset on each TBranchProxy
-   void NotifyDirected(Detail::TBranchProxy *x) { x->Notify(); }
-
    // Helper function to call SetReadEntry on all TFriendProxy
    void ResetReadEntry(TFriendProxy *fp) { fp->ResetReadEntry(); }
 
@@ -141,9 +138,9 @@ namespace Internal {
    Bool_t TBranchProxyDirector::Notify() {
       fEntry = -1;
       bool retVal = true;
-      for_each(fDirected.begin(),fDirected.end(),NotifyDirected);
+      // Set up each proxy once for the new tree, even if an earlier one failed.
       for (auto brProxy : fDirected) {
-         retVal = retVal && brProxy->Notify();
+         retVal = brProxy->Notify() && retVal;
       }
       Update update(fTree);
       for_each(fFriends.begin(),fFriends.end(),update);
@@ -15,6 +15,7 @@
 #include "TError.h"
 #include "TMPWorkerTree.h"
 #include "TEnv.h"
+#include <algorithm>
 #include <string>
 
 //////////////////////////////////////////////////////////////////////////
@@ -44,7 +45,7 @@
 /// members must be done _after_ forking by each of the children processes.
 TMPWorkerTree::TMPWorkerTree()
    : TMPWorker(), fFileNames(), fTreeName(), fTree(nullptr), fFile(nullptr), fEntryList(nullptr), fFirstEntry(0),
-     fTreeCache(0), fTreeCacheIsLearning(kFALSE), fUseTreeCache(kTRUE), fCacheSize(-1)
+     fNRanges(0), fTreeCache(0), fTreeCacheIsLearning(kFALSE), fUseTreeCache(kTRUE), fCacheSize(-1)
 {
    Setup();
 }
@@ -52,8 +53,8 @@ TMPWorkerTree::TMPWorkerTree()
 TMPWorkerTree::TMPWorkerTree(const std::vector<std::string> &fileNames, TEntryList *entries,
                              const std::string &treeName, UInt_t nWorkers, ULong64_t maxEntries, ULong64_t firstEntry)
    : TMPWorker(nWorkers, maxEntries), fFileNames(fileNames), fTreeName(treeName), fTree(nullptr), fFile(nullptr),
-     fEntryList(entries), fFirstEntry(firstEntry), fTreeCache(0), fTreeCacheIsLearning(kFALSE), fUseTreeCache(kTRUE),
-     fCacheSize(-1)
+     fEntryList(entries), fFirstEntry(firstEntry), fNRanges(nWorkers), fTreeCache(0), fTreeCacheIsLearning(kFALSE),
+     fUseTreeCache(kTRUE), fCacheSize(-1)
 {
    Setup();
 }
@@ -61,7 +62,7 @@ TMPWorkerTree::TMPWorkerTree(const std::vector<std::string> &fileNames, TEntryLi
 TMPWorkerTree::TMPWorkerTree(TTree *tree, TEntryList *entries, UInt_t nWorkers, ULong64_t maxEntries,
                              ULong64_t firstEntry)
    : TMPWorker(nWorkers, maxEntries), fTree(tree), fFile(nullptr), fEntryList(entries), fFirstEntry(firstEntry),
-     fTreeCache(0), fTreeCacheIsLearning(kFALSE), fUseTreeCache(kTRUE), fCacheSize(-1)
+     fNRanges(nWorkers), fTreeCache(0), fTreeCacheIsLearning(kFALSE), fUseTreeCache(kTRUE), fCacheSize(-1)
 {
    Setup();
 }
@@ -102,10 +103,7 @@ TFile *TMPWorkerTree::OpenFile(const std::string& fileName)
 
    TFile *fp = TFile::Open(fileName.c_str());
    if (fp == nullptr || fp->IsZombie()) {
-      std::stringstream ss;
-      ss << "could not open file " << fileName;
-      std::string errmsg = ss.str();
-      SendError(errmsg, MPCode::kProcError);
+      delete fp;
       return nullptr;
    }
 
@@ -133,13 +131,8 @@ TTree *TMPWorkerTree::RetrieveTree(TFile *fp)
    } else {
       tree = static_cast<TTree*>(fp->Get(fTreeName.c_str()));
    }
-   if (tree == nullptr) {
-      std::stringstream ss;
-      ss << "cannot find tree with name " << fTreeName << " in file " << fp->GetName();
-      std::string errmsg = ss.str();
-      SendError(errmsg, MPCode::kProcError);
+   if (tree == nullptr)
       return nullptr;
-   }
 
    return tree;
 }
@@ -197,6 +190,34 @@ ULong64_t TMPWorkerTree::EvalMaxEntries(ULong64_t maxEntries)
       return maxEntries - (fNWorkers-1)*(maxEntries/fNWorkers);
 }
 
+//////////////////////////////////////////////////////////////////////////
+/// Evaluate the entries range rangeN out of fNRanges of a tree with nEntries entries.
+/// Example: for 21 entries and 4 ranges we want ranges 0-5, 5-10, 10-15, 15-21.
+/// If the tree is given, both ends of the range are moved forward to the start of the next
+/// cluster, so that no cluster is read by two workers: as the same rule is applied to the end
+/// of a range and to the start of the following one, the ranges still cover all entries.
+/// Ranges smaller than a cluster can then be empty.
+
+void TMPWorkerTree::EvalRange(TTree *tree, Long64_t nEntries, UInt_t rangeN, Long64_t &start, Long64_t &finish)
+{
+   start = nEntries * rangeN / fNRanges;
+   finish = (rangeN < fNRanges - 1) ? nEntries * (rangeN + 1) / fNRanges : nEntries;
+   if (!tree)
+      return;
+
+   auto clusterBoundary = [tree, nEntries](Long64_t entry) {
+      if (entry == 0 || entry >= nEntries)
+         return entry;
+      auto clusterIt = tree->GetClusterIterator(entry);
+      Long64_t boundary = clusterIt();
+      if (boundary < entry)
+         boundary = clusterIt.GetNextEntry();
+      return std::min(boundary, nEntries);
+   };
+   start = clusterBoundary(start);
+   finish = clusterBoundary(finish);
+}
+
 //////////////////////////////////////////////////////////////////////////
 /// Generic input handling
 
@@ -243,7 +264,7 @@ void TMPWorkerTreeSel::Process(UInt_t code, MPCodeBufPair &msg)
    TEntryList *enl = 0;
    std::string errmsg;
    if (LoadTree(code, msg, start, finish, &enl, errmsg) != 0) {
-      SendError(errmsg);
+      SendError(errmsg, MPCode::kProcError);
       return;
    }
 
@@ -299,19 +320,6 @@ Int_t TMPWorkerTree::LoadTree(UInt_t code, MPCodeBufPair &msg, Long64_t &start,
       //retrieve the total number of entries ranges processed so far by TPool
       nProcessed = ReadBuffer<UInt_t>(msg.second.get());
 
-      //create entries range
-      //example: for 21 entries, 4 workers we want ranges 0-5, 5-10, 10-15, 15-21
-      //and this worker must take the rangeN-th range
-      Long64_t nEntries = fTree->GetEntries();
-      UInt_t nBunch = nEntries / fNWorkers;
-      UInt_t rangeN = nProcessed % fNWorkers;
-      start = rangeN * nBunch;
-      if (rangeN < (fNWorkers - 1)) {
-         finish = (rangeN+1)*nBunch;
-      } else {
-         finish = nEntries;
-      }
-
       //process tree
       tree = fTree;
       CloseFile(); // May not be needed
@@ -333,6 +341,10 @@ Int_t TMPWorkerTree::LoadTree(UInt_t code, MPCodeBufPair &msg, Long64_t &start,
          }
       }
 
+      //create entries range: this worker must take the rangeN-th range
+      UInt_t rangeN = nProcessed % fNRanges;
+      EvalRange(fTree, fTree->GetEntries(), rangeN, start, finish);
+
    } else {
 
       if (code == MPCode::kProcRange) {
@@ -340,7 +352,7 @@ Int_t TMPWorkerTree::LoadTree(UInt_t code, MPCodeBufPair &msg, Long64_t &start,
          //retrieve the total number of entries ranges processed so far by TPool
          nProcessed = ReadBuffer<UInt_t>(msg.second.get());
          //evaluate the file and the entries range to process
-         fileN = nProcessed / fNWorkers;
+         fileN = nProcessed / fNRanges;
       } else if (code == MPCode::kProcFile) {
          mgroot += "MPCode::kProcFile: ";
          //evaluate the file and the entries range to process
@@ -378,17 +390,9 @@ Int_t TMPWorkerTree::LoadTree(UInt_t code, MPCodeBufPair &msg, Long64_t &start,
 
       //create entries range
       if (code == MPCode::kProcRange) {
-         //example: for 21 entries, 4 workers we want ranges 0-5, 5-10, 10-15, 15-21
-         //and this worker must take the rangeN-th range
-         Long64_t nEntries = tree->GetEntries();
-         UInt_t nBunch = nEntries / fNWorkers;
-         if(nEntries % fNWorkers) nBunch++;
-         UInt_t rangeN = nProcessed % fNWorkers;
-         start = rangeN * nBunch;
-         if(rangeN < (fNWorkers-1))
-            finish = (rangeN+1)*nBunch;
-         else
-            finish = nEntries;
+         //this worker must take the rangeN-th range
+         UInt_t rangeN = nProcessed % fNRanges;
+         EvalRange(tree, tree->GetEntries(), rangeN, start, finish);
       } else {
          start = 0;
          finish = tree->GetEntries();
@@ -402,18 +406,11 @@ Int_t TMPWorkerTree::LoadTree(UInt_t code, MPCodeBufPair &msg, Long64_t &start,
    if (fEntryList && enl) {
       if ((*enl = fEntryList->GetEntryList(fTree->GetName(), TUrl(fFile->GetName()).GetFile()))) {
          // create entries range
-         if (code == MPCode::kProcRange) {
-            // example: for 21 entries, 4 workers we want ranges 0-5, 5-10, 10-15, 15-21
-            // and this worker must take the rangeN-th range
-            ULong64_t nEntries = (*enl)->GetN();
-            UInt_t nBunch = nEntries / fNWorkers;
-            if (nEntries % fNWorkers) nBunch++;
-            UInt_t rangeN = nProcessed % fNWorkers;
-            start = rangeN * nBunch;
-            if (rangeN < (fNWorkers - 1))
-               finish = (rangeN + 1) * nBunch;
-            else
-               finish = nEntries;
+         if (code == MPCode::kProcRange || code == MPCode::kProcTree) {
+            // this worker must take the rangeN-th range of the entries in the list,
+            // which are not aligned to clusters
+            UInt_t rangeN = nProcessed % fNRanges;
+            EvalRange(nullptr, (*enl)->GetN(), rangeN, start, finish);
          } else {
             start = 0;
             finish = (*enl)->GetN();
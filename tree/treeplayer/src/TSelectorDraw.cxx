@@ -35,6 +35,9 @@ A specialized TSelector for TTree::Draw.
 #include "TStyle.h"
 #include "TClass.h"
 #include "TColor.h"
+#include "TList.h"
+#include "TMath.h"
+#include "TVirtualRWMutex.h"
 #include "strlcpy.h"
 
 ClassImp(TSelectorDraw);
@@ -78,6 +81,7 @@ TSelectorDraw::TSelectorDraw()
    fWeight         = 1;
    fCurrentSubEntry = -1;
    fTreeElistArray  = 0;
+   fJit             = kFALSE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -160,6 +164,14 @@ void TSelectorDraw::Begin(TTree *tree)
       opt5d = kTRUE;
       opt.ReplaceAll("gl5d", "");
    }
+   fJit = kFALSE;
+   if (opt.Contains("jit")) {
+      fJit = kTRUE;
+      opt.ReplaceAll("jit", "");
+      // Not a drawing option either
+      Ssiz_t jitPos = fOption.Index("jit", 0, TString::kIgnoreCase);
+      if (jitPos != kNPOS) fOption.Remove(jitPos, 3);
+   }
    TCut realSelection(selection);
    //input list - only TEntryList
    TEntryList *inElist = fTree->GetEntryList();
@@ -477,6 +489,8 @@ void TSelectorDraw::Begin(TTree *tree)
    }
 
    // Decode varexp and selection
+   fVarExp = varexp;
+   fSelectionExp = realSelection.GetTitle();
    if (!CompileVariables(varexp, realSelection.GetTitle())) {
       abrt.Form("Variable compilation failed: {%s,%s}", varexp, realSelection.GetTitle());
       Abort(abrt);
@@ -884,7 +898,7 @@ void TSelectorDraw::Begin(TTree *tree)
          fVar[1]->SetAxis(h3->GetYaxis());
          fVar[2]->SetAxis(h3->GetXaxis());
          fObject = h3;
-         Int_t noscat = strlen(option);
+         Int_t noscat = fOption.Length();
          if (optSame) noscat -= 4;
          if (!noscat && fDimension == 3) {
             fAction = 13;
@@ -908,6 +922,15 @@ void TSelectorDraw::Begin(TTree *tree)
       else            fAction = 6;
    }
    if (varexp) delete[] varexp;
+   InitFill();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare the buffers of the values for the formulas compiled for fTree.
+
+void TSelectorDraw::InitFill()
+{
+   Int_t i;
    for (i = 0; i < fValSize; ++i)
       fVarMultiple[i] = kFALSE;
    fSelectMultiple = kFALSE;
@@ -935,6 +958,105 @@ void TSelectorDraw::Begin(TTree *tree)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if, after Begin(), the entries can be processed by several
+/// slot selectors (see CreateSlotSelector()) whose histograms are merged at the
+/// end, as done by TTreePlayer with implicit multi-threading.
+///
+/// This is the case for the histograms and profiles filled with the values of
+/// the variables, but not for the graphs, the entry lists, the parallel
+/// coordinates and candle plots, the objects evaluated by the formula and the
+/// expressions depending on the entry number.
+
+Bool_t TSelectorDraw::CanProcessMT() const
+{
+   const Int_t action = TMath::Abs(fAction);
+   if (action != 1 && action != 2 && action != 3 && action != 4 && action != 23)
+      return kFALSE;
+   if (fObjEval || fTreeElist || !fObject || !fObject->InheritsFrom(TH1::Class()))
+      return kFALSE;
+   // The 3-D histogram of a scatter plot only defines the axes
+   if (action == 3 && fObject->TestBit(kCanDelete))
+      return kFALSE;
+   for (const TString *expr : {&fVarExp, &fSelectionExp}) {
+      if (expr->Contains("Entry$") || expr->Contains("Entries$"))
+         return kFALSE;
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a selector filling an empty copy of the histogram of this selector,
+/// not attached to any directory, to process a part of the entries in another
+/// thread. The formulas are compiled for the tree of each part by InitSlot().
+/// The limits of the histogram must have been set already, i.e. the action
+/// must not be negative.
+
+TSelectorDraw *TSelectorDraw::CreateSlotSelector() const
+{
+   auto slot = new TSelectorDraw();
+   slot->fAction = fAction;
+   slot->fJit = fJit;
+   slot->fVarExp = fVarExp;
+   slot->fSelectionExp = fSelectionExp;
+   slot->fOption = fOption;
+   TH1 *hist = (TH1 *)fObject->Clone();
+   hist->SetDirectory(nullptr);
+   hist->Reset();
+   slot->fObject = hist;
+   return slot;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compile the formulas of a slot selector for the tree of the entries it is
+/// about to process. The values are buffered up to the estimate of that tree,
+/// which must be the same for all the trees processed by the slot.
+/// Returns kFALSE if the formulas cannot be compiled.
+
+Bool_t TSelectorDraw::InitSlot(TTree *tree)
+{
+   fTree = tree;
+   {
+      R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
+      if (!CompileVariables(fVarExp, fSelectionExp))
+         return kFALSE;
+   }
+   InitFill();
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the histogram of a slot selector with the buffered values and delete
+/// the formulas, before the tree they were compiled for is deleted.
+
+void TSelectorDraw::FinishSlot()
+{
+   if (fNfill) TakeAction();
+   fNfill = 0;
+   {
+      R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
+      ClearFormula();
+   }
+   fTree = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the histogram and the selected rows of a slot selector to this one.
+/// The histogram of the slot selector is deleted.
+
+void TSelectorDraw::MergeSlot(TSelectorDraw &slot)
+{
+   if (slot.fSelectedRows) {
+      TList list;
+      list.Add(slot.fObject);
+      ((TH1 *)fObject)->Merge(&list);
+      fSelectedRows += slot.fSelectedRows;
+   }
+   delete slot.fObject;
+   slot.fObject = nullptr;
+   slot.fSelectedRows = 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Delete internal buffers.
 
@@ -991,6 +1113,7 @@ Bool_t TSelectorDraw::CompileVariables(const char *varexp, const char *selection
          fSelect = 0;
          return kFALSE;
       }
+      if (fJit) fSelect->EnableJit();
    }
 
    // if varexp is empty, take first column by default
@@ -1025,6 +1148,7 @@ Bool_t TSelectorDraw::CompileVariables(const char *varexp, const char *selection
       fVar[i] = new TTreeFormula(TString::Format("Var%i", i + 1), varnames[i].Data(), fTree);
       fVar[i]->SetQuickLoad(kTRUE);
       if(!fVar[i]->GetNdim()) { ClearFormula(); return kFALSE; }
+      if (fJit) fVar[i]->EnableJit();
       fManager->Add(fVar[i]);
    }
    fManager->Sync();
@@ -51,6 +51,9 @@
 #include <cstdlib>
 #include <typeinfo>
 #include <algorithm>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
 
 const Int_t kMaxLen     = 1024;
 
@@ -3929,6 +3932,37 @@ template<> inline LongDouble_t TTreeFormula::GetConstant(Int_t k) {
 }
 template<> inline Long64_t TTreeFormula::GetConstant(Int_t k) { return (Long64_t)GetConstant<LongDouble_t>(k); }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate this treeformula with the function compiled by EnableJit: read the
+/// tree variables used by the formula and pass them to that function.
+
+Double_t TTreeFormula::EvalJitted(Int_t instance)
+{
+   Double_t values[kMAXCODES];
+
+   const Bool_t willLoad = (instance==0 || fNeedLoading); fNeedLoading = kFALSE;
+   if (willLoad) fDidBooleanOptimization = kFALSE;
+
+   for (auto code : fJitCodes) {
+      switch (fLookupType[code]) {
+         case kIndexOfEntry: values[code] = fTree->GetReadEntry(); continue;
+         case kIndexOfLocalEntry: values[code] = fTree->GetTree()->GetReadEntry(); continue;
+         case kEntries:      values[code] = fTree->GetEntries(); continue;
+         case kLocalEntries: values[code] = fTree->GetTree()->GetEntries(); continue;
+         case kLength:       values[code] = fManager->fNdata; continue;
+         case kIteration:    values[code] = instance; continue;
+
+         case kDirect:     { TT_EVAL_INIT_LOOP; values[code] = leaf->GetTypedValue<Double_t>(real_instance); continue; }
+         case kDataMember: { TT_EVAL_INIT_LOOP; values[code] = ((TFormLeafInfo*)fDataMembers.UncheckedAt(code))->
+                                    GetTypedValue<Double_t>(leaf,real_instance); continue; }
+         case kTreeMember: { TREE_EVAL_INIT_LOOP; values[code] = ((TFormLeafInfo*)fDataMembers.UncheckedAt(code))->
+                                    GetTypedValue<Double_t>((TLeaf*)0x0,real_instance); continue; }
+         default: return 0; // EnableJit only accepts the lookup types above.
+      }
+   }
+   return fJitFunction(values);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Evaluate this treeformula.
 
@@ -3938,6 +3972,7 @@ T TTreeFormula::EvalInstance(Int_t instance, const char *stringStackArg[])
 // Note that the redundance and structure in this code is tailored to improve
 // efficiencies.
    if (TestBit(kMissingLeaf)) return 0;
+   if (std::is_same<T, Double_t>::value && fJitFunction) return EvalJitted(instance);
    if (fNoper == 1 && fNcodes > 0) {
 
       switch (fLookupType[0]) {
@@ -4401,6 +4436,207 @@ T TTreeFormula::EvalInstance(Int_t instance, const char *stringStackArg[])
    return tab[0];
 }
 
+namespace {
+
+using TTreeFormulaJitFunc_t = Double_t (*)(const Double_t *);
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compile with the interpreter a function `double f(const double *v)` made of
+/// `body`, or reuse the one compiled before for an identical body.
+
+TTreeFormulaJitFunc_t CompileJitFunction(const std::string &body)
+{
+   R__LOCKGUARD(gInterpreterMutex);
+   static std::unordered_map<std::string, TTreeFormulaJitFunc_t> functions;
+   auto known = functions.find(body);
+   if (known != functions.end())
+      return known->second;
+
+   const std::string name = "ROOT::Internal::TTreeFormulaJit::Eval" + std::to_string(functions.size());
+   std::string code = "#include \"TMath.h\"\n#include <algorithm>\n#include <cmath>\n"
+                      "namespace ROOT { namespace Internal { namespace TTreeFormulaJit {\n"
+                      "double Eval" + std::to_string(functions.size()) + "(const double *v)\n{\n" + body +
+                      "}\n} } }\n";
+   TTreeFormulaJitFunc_t func = nullptr;
+   if (gInterpreter->Declare(code.c_str())) {
+      TInterpreter::EErrorCode error = TInterpreter::kNoError;
+      auto address = gInterpreter->Calc(("(long)&" + name + ";").c_str(), &error);
+      if (error == TInterpreter::kNoError)
+         func = reinterpret_cast<TTreeFormulaJitFunc_t>(address);
+   }
+   // Also remember failures, to not retry them for every formula
+   functions[body] = func;
+   return func;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate this formula with compiled code instead of interpreting its
+/// operations for each entry and instance (or go back to interpreting them if
+/// `enable` is false). This is what the option "jit" of TTree::Draw does.
+///
+/// The operations of the formula are translated into a C++ function of the
+/// values of the tree variables the formula uses, which is compiled once by
+/// the interpreter; EvalInstance() then only reads the variables for the
+/// requested instance, including for arrays, and calls that function.
+/// Identical formulas share the same function.
+///
+/// This is possible for formulas made of numerical leaves and data members,
+/// the special variables Entry$, LocalEntry$, Entries$, LocalEntries$,
+/// Iteration$ and Length$, constants, the arithmetic, comparison, logical and
+/// bitwise operators, and the mathematical functions supported by TFormula
+/// except rndm. Formulas using aliases, strings, graphical cuts, entry lists,
+/// calls to external functions, Sum$, Min$, Max$ and the like, or the
+/// conditional operator are left untouched, as are formulas made of a single
+/// variable that are already evaluated directly. Only the double precision
+/// EvalInstance is compiled; EvalInstance64 and EvalInstanceLD keep
+/// interpreting the formula.
+///
+/// Returns true if the formula is now evaluated by compiled code.
+
+Bool_t TTreeFormula::EnableJit(Bool_t enable /* = kTRUE */)
+{
+   fJitFunction = nullptr;
+   fJitCodes.clear();
+   if (!enable || fNoper < 2 || fAxis || IsString() || !gInterpreter)
+      return kFALSE;
+
+   // Translate the operations into a sequence of temporaries, leaving the rest
+   // to the compiler.
+   std::string body;
+   std::vector<std::string> stack;
+   std::vector<Int_t> codes;
+   Int_t ntmp = 0;
+   Bool_t hasBoolOptimize = kFALSE;
+   auto push = [&](const std::string &expr) {
+      const std::string tmp = "t" + std::to_string(ntmp++);
+      body += "   const double " + tmp + " = " + expr + ";\n";
+      stack.push_back(tmp);
+   };
+
+   for (Int_t i = 0; i < fNoper; ++i) {
+      const Int_t oper = GetOper()[i];
+      const Int_t action = oper >> kTFOperShift;
+      const Int_t param = oper & kTFOperMask;
+
+      if (action == kDefinedVariable) {
+         switch (fLookupType[param]) {
+            case kDirect: case kDataMember: case kTreeMember:
+            case kIndexOfEntry: case kIndexOfLocalEntry: case kEntries: case kLocalEntries:
+            case kLength: case kIteration:
+               break;
+            default: return kFALSE;
+         }
+         if (std::find(codes.begin(), codes.end(), param) == codes.end())
+            codes.push_back(param);
+         push("v[" + std::to_string(param) + "]");
+         continue;
+      }
+      if (action == kConstant) {
+         const Double_t value = GetConstant<Double_t>(param);
+         if (!std::isfinite(value))
+            return kFALSE;
+         push(TString::Format("%a", value).Data()); // hexadecimal literal, exact
+         continue;
+      }
+      // Only skips the evaluation of the right side of a && or ||, see below
+      if (action == kBoolOptimize) {
+         hasBoolOptimize = kTRUE;
+         continue;
+      }
+      if (action == kEnd)
+         break;
+      if (action == kpi) {
+         push("TMath::Pi()");
+         continue;
+      }
+
+      std::string expr;
+      if (stack.empty())
+         return kFALSE;
+      const std::string a = stack.back();
+      switch (action) {
+         case kcos:     expr = "TMath::Cos(" + a + ")"; break;
+         case ksin:     expr = "TMath::Sin(" + a + ")"; break;
+         case ktan:     expr = "TMath::Cos(" + a + ") == 0 ? 0. : TMath::Tan(" + a + ")"; break;
+         case kacos:    expr = "TMath::Abs(" + a + ") > 1 ? 0. : TMath::ACos(" + a + ")"; break;
+         case kasin:    expr = "TMath::Abs(" + a + ") > 1 ? 0. : TMath::ASin(" + a + ")"; break;
+         case katan:    expr = "TMath::ATan(" + a + ")"; break;
+         case kcosh:    expr = "TMath::CosH(" + a + ")"; break;
+         case ksinh:    expr = "TMath::SinH(" + a + ")"; break;
+         case ktanh:    expr = "TMath::CosH(" + a + ") == 0 ? 0. : TMath::TanH(" + a + ")"; break;
+         case kacosh:   expr = a + " < 1 ? 0. : TMath::ACosH(" + a + ")"; break;
+         case kasinh:   expr = "TMath::ASinH(" + a + ")"; break;
+         case katanh:   expr = "TMath::Abs(" + a + ") > 1 ? 0. : TMath::ATanH(" + a + ")"; break;
+         case ksq:      expr = a + " * " + a; break;
+         case ksqrt:    expr = "TMath::Sqrt(TMath::Abs(" + a + "))"; break;
+         case klog:     expr = a + " > 0 ? TMath::Log(" + a + ") : 0."; break;
+         case kexp:     expr = a + " < -700 ? 0. : (" + a + " > 700 ? TMath::Exp(700.) : TMath::Exp(" + a + "))"; break;
+         case klog10:   expr = a + " > 0 ? TMath::Log10(" + a + ") : 0."; break;
+         case kabs:     expr = "TMath::Abs(" + a + ")"; break;
+         case ksign:    expr = a + " < 0 ? -1. : 1."; break;
+         case kint:     expr = "double((long long)" + a + ")"; break;
+         case kSignInv: expr = "-" + a; break;
+         case kNot:     expr = a + " != 0 ? 0. : 1."; break;
+      }
+      if (!expr.empty()) {
+         stack.pop_back();
+         push(expr);
+         continue;
+      }
+
+      if (stack.size() < 2)
+         return kFALSE;
+      const std::string b = stack.back();
+      const std::string l = stack[stack.size() - 2];
+      switch (action) {
+         case kAdd:         expr = l + " + " + b; break;
+         case kSubstract:   expr = l + " - " + b; break;
+         case kMultiply:    expr = l + " * " + b; break;
+         case kDivide:      expr = b + " == 0 ? 0. : " + l + " / " + b; break;
+         case kModulo:      expr = "double((long long)" + l + " % (long long)" + b + ")"; break;
+         case katan2:       expr = "TMath::ATan2(" + l + ", " + b + ")"; break;
+         case kfmod:        expr = "std::fmod(" + l + ", " + b + ")"; break;
+         case kpow:         expr = "TMath::Power(" + l + ", " + b + ")"; break;
+         case kmin:         expr = "std::min(" + l + ", " + b + ")"; break;
+         case kmax:         expr = "std::max(" + l + ", " + b + ")"; break;
+         case kAnd:         expr = l + " != 0 && " + b + " != 0 ? 1. : 0."; break;
+         case kOr:          expr = l + " != 0 || " + b + " != 0 ? 1. : 0."; break;
+         case kEqual:       expr = l + " == " + b + " ? 1. : 0."; break;
+         case kNotEqual:    expr = l + " != " + b + " ? 1. : 0."; break;
+         case kLess:        expr = l + " < " + b + " ? 1. : 0."; break;
+         case kGreater:     expr = l + " > " + b + " ? 1. : 0."; break;
+         case kLessThan:    expr = l + " <= " + b + " ? 1. : 0."; break;
+         case kGreaterThan: expr = l + " >= " + b + " ? 1. : 0."; break;
+         case kBitAnd:      expr = "double((unsigned long long)" + l + " & (unsigned long long)" + b + ")"; break;
+         case kBitOr:       expr = "double((unsigned long long)" + l + " | (unsigned long long)" + b + ")"; break;
+         case kLeftShift:   expr = "double((unsigned long long)" + l + " << (unsigned long long)" + b + ")"; break;
+         case kRightShift:  expr = "double((unsigned long long)" + l + " >> (unsigned long long)" + b + ")"; break;
+         default: return kFALSE; // Not (yet) supported, keep interpreting the formula
+      }
+      stack.pop_back();
+      stack.pop_back();
+      push(expr);
+   }
+   if (stack.size() != 1)
+      return kFALSE;
+   // The compiled function evaluates both sides of && and ||, which gives the same result unless the skipped side
+   // reads an array element beyond the size of the array: the formula then evaluates to 0.
+   if (hasBoolOptimize) {
+      for (auto code : codes) {
+         if (fNdimensions[code])
+            return kFALSE;
+      }
+   }
+   body += "   return " + stack.back() + ";\n";
+
+   fJitFunction = CompileJitFunction(body);
+   if (fJitFunction)
+      fJitCodes = codes;
+   return fJitFunction != nullptr;
+}
+
 // Template instantiations
 template double TTreeFormula::EvalInstance<double> (int, char const**);
 template long double TTreeFormula::EvalInstance<long double> (int, char const**);
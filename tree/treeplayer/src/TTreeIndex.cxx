@@ -19,6 +19,19 @@ A Tree Index with majorname and minorname.
 #include "TTree.h"
 #include "TBuffer.h"
 #include "TMath.h"
+#include "RConfigure.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TTreeProcessorMT.hxx"
+#include "TChain.h"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TTreeReader.h"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#endif
 
 ClassImp(TTreeIndex);
 
@@ -122,6 +135,12 @@ TTreeIndex::TTreeIndex(): TVirtualIndex()
 ///
 /// It is possible to play with different TreeIndex in the same Tree.
 /// see comments in TTree::SetTreeIndex.
+///
+/// ## Parallel build
+///
+/// If implicit multi-threading is enabled (ROOT::EnableImplicitMT()), the
+/// major and minor values of a tree read from a file, or of a chain, are
+/// evaluated in parallel by a TTreeProcessorMT; see FillValuesMT.
 
 TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorname)
            : TVirtualIndex()
@@ -168,34 +187,119 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
    Long64_t *tmp_minor = new Long64_t[fN];
    Long64_t i;
    Long64_t oldEntry = fTree->GetReadEntry();
-   Int_t current = -1;
-   for (i=0;i<fN;i++) {
-      Long64_t centry = fTree->LoadTree(i);
-      if (centry < 0) break;
-      if (fTree->GetTreeNumber() != current) {
-         current = fTree->GetTreeNumber();
-         fMajorFormula->UpdateFormulaLeaves();
-         fMinorFormula->UpdateFormulaLeaves();
+   if (!FillValuesMT(tmp_major, tmp_minor)) {
+      Int_t current = -1;
+      for (i=0;i<fN;i++) {
+         Long64_t centry = fTree->LoadTree(i);
+         if (centry < 0) break;
+         if (fTree->GetTreeNumber() != current) {
+            current = fTree->GetTreeNumber();
+            fMajorFormula->UpdateFormulaLeaves();
+            fMinorFormula->UpdateFormulaLeaves();
+         }
+         tmp_major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
+         tmp_minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
       }
-      tmp_major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
-      tmp_minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
    }
    fIndex = new Long64_t[fN];
    for(i = 0; i < fN; i++) { fIndex[i] = i; }
    std::sort(fIndex, fIndex + fN, IndexSortComparator(tmp_major, tmp_minor) );
    //TMath::Sort(fN,w,fIndex,0);
+   // Release each temporary array as soon as it is copied, to limit the peak memory usage
    fIndexValues = new Long64_t[fN];
-   fIndexValuesMinor = new Long64_t[fN];
    for (i=0;i<fN;i++) {
       fIndexValues[i] = tmp_major[fIndex[i]];
-      fIndexValuesMinor[i] = tmp_minor[fIndex[i]];
    }
-
    delete [] tmp_major;
+   fIndexValuesMinor = new Long64_t[fN];
+   for (i=0;i<fN;i++) {
+      fIndexValuesMinor[i] = tmp_minor[fIndex[i]];
+   }
    delete [] tmp_minor;
    fTree->LoadTree(oldEntry);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the major and minor formulas of all the entries in parallel, one
+/// TTreeProcessorMT task per cluster, and store the values in `major` and
+/// `minor` (indexed by entry number).
+///
+/// This is only done if implicit multi-threading is enabled and the tree (or
+/// all the trees of the chain) can be re-opened from a read-only file, i.e.
+/// not for trees that are still being filled and not for trees with friends.
+/// Returns kFALSE if the values were not filled, in which case the caller
+/// evaluates them sequentially.
+
+Bool_t TTreeIndex::FillValuesMT(Long64_t *major, Long64_t *minor)
+{
+#ifdef R__USE_IMT
+   if (!ROOT::IsImplicitMTEnabled() || (fTree->GetListOfFriends() && fTree->GetListOfFriends()->GetEntries()))
+      return kFALSE;
+
+   // The tasks see the entries of each file of a chain numbered from 0
+   std::map<std::string, Long64_t> fileOffsets;
+   TChain *chain = dynamic_cast<TChain *>(fTree);
+   if (chain) {
+      const auto files = chain->GetListOfFiles();
+      for (Int_t i = 0; i < files->GetEntries(); ++i) {
+         // Several trees of the same file cannot be told apart
+         if (!fileOffsets.emplace(files->At(i)->GetTitle(), chain->GetTreeOffset()[i]).second)
+            return kFALSE;
+      }
+   } else {
+      TFile *file = fTree->GetCurrentFile();
+      if (!file || file->IsWritable() || fTree->GetDirectory() == nullptr)
+         return kFALSE;
+   }
+
+   std::atomic<bool> ok{true};
+   auto fillValues = [&](TTreeReader &reader) {
+      TTree *tree = reader.GetTree();
+      Long64_t offset = 0;
+      if (chain) {
+         auto taskChain = static_cast<TChain *>(tree);
+         offset = fileOffsets[taskChain->GetListOfFiles()->At(0)->GetTitle()];
+      }
+      std::unique_ptr<TTreeFormula> majorFormula, minorFormula;
+      {
+         R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
+         majorFormula.reset(new TTreeFormula("Major", fMajorName.Data(), tree));
+         minorFormula.reset(new TTreeFormula("Minor", fMinorName.Data(), tree));
+      }
+      majorFormula->SetQuickLoad(kTRUE);
+      minorFormula->SetQuickLoad(kTRUE);
+      Int_t current = -1;
+      while (reader.Next()) {
+         if (tree->GetTreeNumber() != current) {
+            current = tree->GetTreeNumber();
+            majorFormula->UpdateFormulaLeaves();
+            minorFormula->UpdateFormulaLeaves();
+         }
+         const Long64_t entry = offset + reader.GetCurrentEntry();
+         if (entry >= fN) {
+            ok = false;
+            return;
+         }
+         major[entry] = (Long64_t) majorFormula->EvalInstance<LongDouble_t>();
+         minor[entry] = (Long64_t) minorFormula->EvalInstance<LongDouble_t>();
+      }
+   };
+
+   try {
+      ROOT::TTreeProcessorMT processor(*fTree);
+      processor.Process(fillValues);
+   } catch (const std::exception &e) {
+      Warning("TreeIndex", "Parallel evaluation of the index values failed (%s), continuing sequentially", e.what());
+      return kFALSE;
+   }
+   return ok;
+#else
+   (void)major;
+   (void)minor;
+   return kFALSE;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Destructor.
 
@@ -67,6 +67,13 @@ The Draw or Print functions print the following information:
  -  ReadRT    = Zipped MBytes per RT second
  -  ReadCP    = Zipped MBytes per CP second
 
+Print("branch") (or PrintBranchInfo) additionally shows, for each branch read,
+the number of compressed and uncompressed bytes, the time spent getting the
+baskets from the file or the TTreeCache, decompressing them and deserializing
+the entries, and how many baskets were found in the TTreeCache. The branches
+are sorted by decreasing total time. The same information is returned as JSON
+by GetBranchInfoJSON and saved by SaveAs("perf.json").
+
  ### NOTE 1 :
 The ReadTotal value indicates the effective number of zipped bytes
 returned to the application. The physical number of bytes read
@@ -97,7 +104,10 @@ The Physical disk speed is DiskIO + DiskIO*ReadExtra/100.
 #include "TDatime.h"
 #include "TMath.h"
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
+#include <mutex>
 
 ClassImp(TTreePerfStats);
 
@@ -314,6 +324,87 @@ void TTreePerfStats::UnzipEvent(TObject * tree, Long64_t /* pos */, Double_t sta
    }
 }
 
+namespace {
+
+/// Serializes the per-branch events, which the TTree IMT tasks send concurrently.
+std::mutex gBranchInfoMutex;
+
+/// Quote a string for JSON.
+std::string QuoteJSON(const std::string &str)
+{
+   std::string res = "\"";
+   for (char c : str) {
+      if (c == '"' || c == '\\')
+         res += '\\';
+      res += c;
+   }
+   return res + "\"";
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the counters of the given branch, creating them if needed.
+/// Must be called with gBranchInfoMutex held.
+
+TTreePerfStats::BranchInfo &TTreePerfStats::GetOrAddBranchInfo(TBranch *br)
+{
+   auto iter = fBranchInfoCache.find(br);
+   // The branches of the next tree of a chain may reuse the address of another branch: check the name too.
+   if (iter != fBranchInfoCache.end() && iter->second->first == br->GetName())
+      return iter->second->second;
+   auto &entry = *fBranchesInfo.emplace(br->GetName(), BranchInfo()).first;
+   fBranchInfoCache[br] = &entry;
+   return entry.second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record the read of a basket of `branch`.
+/// -  nbytes is the length of the compressed basket
+/// -  start is the TimeStamp before the read
+/// -  fromCache is true if the basket was found in the TTreeCache
+
+void TTreePerfStats::BasketReadEvent(TBranch *branch, Int_t nbytes, Double_t start, Bool_t fromCache)
+{
+   Double_t dtime = Double_t(TTimeStamp()) - start;
+   std::lock_guard<std::mutex> lock(gBranchInfoMutex);
+   auto &info = GetOrAddBranchInfo(branch);
+   info.fReadBytes += nbytes;
+   info.fReadTime += dtime;
+   if (fromCache)
+      ++info.fCacheHits;
+   else
+      ++info.fCacheMisses;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record the decompression of a basket of `branch`.
+/// -  start is the TimeStamp before unzip
+/// -  complen is the length of the compressed buffer
+/// -  objlen is the length of the de-compressed buffer
+
+void TTreePerfStats::BasketUnzipEvent(TBranch *branch, Double_t start, Int_t /* complen */, Int_t objlen)
+{
+   Double_t dtime = Double_t(TTimeStamp()) - start;
+   std::lock_guard<std::mutex> lock(gBranchInfoMutex);
+   auto &info = GetOrAddBranchInfo(branch);
+   info.fUnzipBytes += objlen;
+   info.fUnzipTime += dtime;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record the deserialization of an entry of `branch` by TBranch::GetEntry.
+/// -  start is the TimeStamp before the deserialization
+
+void TTreePerfStats::BranchStreamEvent(TBranch *branch, Double_t start)
+{
+   Double_t dtime = Double_t(TTimeStamp()) - start;
+   std::lock_guard<std::mutex> lock(gBranchInfoMutex);
+   auto &info = GetOrAddBranchInfo(branch);
+   info.fStreamTime += dtime;
+   ++info.fEntries;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// When the run is finished this function must be called
 /// to save the current parameters in the file and Tree in this object
@@ -561,6 +652,8 @@ void TTreePerfStats::Print(Option_t * option) const
    }
    if (basket)
       PrintBasketInfo(option);
+   if (opts.Contains("branch"))
+      PrintBranchInfo();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -629,6 +722,85 @@ void TTreePerfStats::PrintBasketInfo(Option_t *option) const
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the counters of the branch `branchname`, or nullptr if it was not read.
+
+const TTreePerfStats::BranchInfo *TTreePerfStats::GetBranchInfo(const char *branchname) const
+{
+   std::lock_guard<std::mutex> lock(gBranchInfoMutex);
+   auto iter = fBranchesInfo.find(branchname);
+   return iter == fBranchesInfo.end() ? nullptr : &iter->second;
+}
+
+namespace {
+
+using BranchInfoEntry_t = const TTreePerfStats::BranchInfoMap_t::value_type *;
+
+/// Return the branches of `infos`, the most expensive (in total time) first.
+std::vector<BranchInfoEntry_t> SortBranchesByTime(const TTreePerfStats::BranchInfoMap_t &infos)
+{
+   std::vector<BranchInfoEntry_t> sorted;
+   for (auto &entry : infos)
+      sorted.push_back(&entry);
+   auto totalTime = [](const TTreePerfStats::BranchInfo &info) {
+      return info.fReadTime + info.fUnzipTime + info.fStreamTime;
+   };
+   std::stable_sort(sorted.begin(), sorted.end(), [&](BranchInfoEntry_t a, BranchInfoEntry_t b) {
+      return totalTime(a->second) > totalTime(b->second);
+   });
+   return sorted;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the per-branch counters, most expensive branch first.
+/// With option "json", print them as JSON, see GetBranchInfoJSON.
+
+void TTreePerfStats::PrintBranchInfo(Option_t *option) const
+{
+   TString opts(option);
+   opts.ToLower();
+   if (opts.Contains("json")) {
+      printf("%s\n", GetBranchInfoJSON().c_str());
+      return;
+   }
+
+   std::lock_guard<std::mutex> lock(gBranchInfoMutex);
+   printf("%-32s %10s %10s %9s %9s %9s %10s %8s %8s\n", "Branch", "Read MB", "Unzip MB", "Read s", "Unzip s",
+          "Stream s", "Entries", "Hits", "Misses");
+   for (auto entry : SortBranchesByTime(fBranchesInfo)) {
+      const BranchInfo &info = entry->second;
+      printf("%-32s %10.3f %10.3f %9.3f %9.3f %9.3f %10lld %8u %8u\n", entry->first.c_str(), 1e-6 * info.fReadBytes,
+             1e-6 * info.fUnzipBytes, info.fReadTime, info.fUnzipTime, info.fStreamTime, info.fEntries,
+             info.fCacheHits, info.fCacheMisses);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the per-branch counters as a JSON array of objects, most expensive
+/// branch first; times are in seconds.
+
+std::string TTreePerfStats::GetBranchInfoJSON() const
+{
+   std::lock_guard<std::mutex> lock(gBranchInfoMutex);
+   std::string json = "[";
+   const char *sep = "\n";
+   for (auto entry : SortBranchesByTime(fBranchesInfo)) {
+      const BranchInfo &info = entry->second;
+      json += sep;
+      json += "  {\"branch\": " + QuoteJSON(entry->first);
+      json += TString::Format(", \"readBytes\": %lld, \"unzipBytes\": %lld", info.fReadBytes, info.fUnzipBytes).Data();
+      json += TString::Format(", \"readTime\": %.9g, \"unzipTime\": %.9g, \"streamTime\": %.9g", info.fReadTime,
+                              info.fUnzipTime, info.fStreamTime).Data();
+      json += TString::Format(", \"entries\": %lld, \"cacheHits\": %u, \"cacheMisses\": %u}", info.fEntries,
+                              info.fCacheHits, info.fCacheMisses).Data();
+      sep = ",\n";
+   }
+   json += "\n]";
+   return json;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Save this object to filename
 
@@ -636,6 +808,15 @@ void TTreePerfStats::SaveAs(const char *filename, Option_t * /*option*/) const
 {
    TTreePerfStats *ps = (TTreePerfStats*)this;
    ps->Finish();
+   if (TString(filename).EndsWith(".json")) {
+      std::ofstream out(filename);
+      if (!out) {
+         Error("SaveAs", "Cannot open %s", filename);
+         return;
+      }
+      out << GetBranchInfoJSON() << std::endl;
+      return;
+   }
    ps->TObject::SaveAs(filename);
 }
 
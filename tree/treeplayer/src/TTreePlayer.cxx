@@ -22,6 +22,7 @@ extra libraries (Histogram, display, etc).
 #include <cstdlib>
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 #include "TROOT.h"
 #include "TSystem.h"
@@ -74,6 +75,7 @@ extra libraries (Histogram, display, etc).
 #include "TRefArrayProxy.h"
 #include "TVirtualMonitoring.h"
 #include "TTreeCache.h"
+#include "TTreeCloner.h"
 #include "TVirtualMutex.h"
 #include "ThreadLocalStorage.h"
 #include "strlcpy.h"
@@ -83,6 +85,15 @@ extra libraries (Histogram, display, etc).
 #include "Fit/BinData.h"
 #include "Fit/UnBinData.h"
 #include "Math/MinimizerOptions.h"
+#include "RConfigure.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TTreeProcessorMT.hxx"
+#include "TTreeReader.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#endif
 
 
 R__EXTERN Foption_t Foption;
@@ -157,10 +168,18 @@ TVirtualIndex *TTreePlayer::BuildIndex(const TTree *T, const char *majorname, co
 /// selected entries.
 ///
 /// -  selection is a standard selection expression (see TTreePlayer::Draw)
-/// -  option is reserved for possible future use
+/// -  option can contain "fast", see below
 /// -  nentries is the number of entries to process (default is all)
 /// -  first is the first entry to process (default is 0)
 ///
+/// With the option "fast", the selection is first evaluated for all the entries,
+/// reading only the branches it uses. The baskets that only hold selected
+/// entries are then copied without being unzipped, as done by CloneTree with
+/// the option "fast", while the other selected entries are copied one by one.
+/// This is much faster when the selected entries come in long consecutive
+/// runs, e.g. when selecting some run numbers of data sorted by run number.
+/// The option can also contain the basket sorting order, see TTreeCloner.
+///
 /// IMPORTANT: The copied tree stays connected with this tree until this tree
 /// is deleted.  In particular, any changes in branch addresses
 /// in this tree are forwarded to the clone trees.  Any changes
@@ -182,9 +201,12 @@ TVirtualIndex *TTreePlayer::BuildIndex(const TTree *T, const char *majorname, co
 ///   T2->Write();
 /// ~~~
 
-TTree *TTreePlayer::CopyTree(const char *selection, Option_t *, Long64_t nentries,
+TTree *TTreePlayer::CopyTree(const char *selection, Option_t *option, Long64_t nentries,
                              Long64_t firstentry)
 {
+   TString opt = option;
+   opt.ToLower();
+   const Bool_t fastClone = opt.Contains("fast");
 
    // we make a copy of the tree header
    TTree *tree = fTree->CloneTree(0);
@@ -217,6 +239,15 @@ TTree *TTreePlayer::CopyTree(const char *selection, Option_t *, Long64_t nentrie
       fFormulaList->Add(select);
    }
 
+   // Runs of consecutive selected entries of one tree, for the fast copy
+   struct RSelectedRun {
+      Long64_t fEntry;      // Entry number of the first entry of the run in fTree
+      Int_t fTreeNumber;    // Tree of the chain holding the run
+      Long64_t fLocalFirst; // First entry of the run in its tree
+      Long64_t fLocalLast;  // Entry after the last entry of the run in its tree
+   };
+   std::vector<RSelectedRun> runs;
+
    //loop on the specified entries
    Int_t tnumber = -1;
    for (entry=firstentry;entry<firstentry+nentries;entry++) {
@@ -236,10 +267,38 @@ TTree *TTreePlayer::CopyTree(const char *selection, Option_t *, Long64_t nentrie
          }
          if (!keep) continue;
       }
+      if (fastClone) {
+         if (!runs.empty() && runs.back().fTreeNumber == tnumber && runs.back().fLocalLast == localEntry)
+            ++runs.back().fLocalLast;
+         else
+            runs.push_back({entryNumber, tnumber, localEntry, localEntry + 1});
+         continue;
+      }
       fTree->GetEntry(entryNumber);
       tree->Fill();
    }
    fFormulaList->Clear();
+
+   // Copy the runs, tree by tree
+   for (std::size_t first = 0, last = 0; first < runs.size(); first = last) {
+      while (last < runs.size() && runs[last].fTreeNumber == runs[first].fTreeNumber)
+         ++last;
+      if (fTree->LoadTree(runs[first].fEntry) < 0)
+         break;
+      TTreeCloner cloner(fTree->GetTree(), tree, option, TTreeCloner::kNoWarnings);
+      if (cloner.IsValid()) {
+         for (std::size_t i = first; i < last; ++i)
+            cloner.AddEntryRange(runs[i].fLocalFirst, runs[i].fLocalLast);
+         cloner.Exec();
+      } else {
+         for (std::size_t i = first; i < last; ++i) {
+            for (Long64_t k = 0; k < runs[i].fLocalLast - runs[i].fLocalFirst; ++k) {
+               fTree->GetEntry(runs[i].fEntry + k);
+               tree->Fill();
+            }
+         }
+      }
+   }
    return tree;
 }
 
@@ -399,6 +458,7 @@ Long64_t TTreePlayer::DrawSelect(const char *varexp0, const char *selection, Opt
    Bool_t optgl5d   = kFALSE;
    Bool_t optnorm   = kFALSE;
    if (opt.Contains("norm")) {optnorm = kTRUE; opt.ReplaceAll("norm",""); opt.ReplaceAll(" ","");}
+   if (opt.Contains("jit")) {opt.ReplaceAll("jit",""); opt.ReplaceAll(" ","");}
    if (opt.Contains("para")) optpara = kTRUE;
    if (opt.Contains("candle")) optcandle = kTRUE;
    if (opt.Contains("gl5d")) optgl5d = kTRUE;
@@ -2283,7 +2343,9 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
       fSelectorUpdate = selector;
       UpdateFormulaLeaves();
 
-      for (entry=firstentry;entry<firstentry+nentries;entry++) {
+      // With implicit multi-threading, TTree::Draw can process (part of) the entries in parallel
+      entry = (selector == fSelector) ? ProcessDrawMT(firstentry, nentries) : firstentry;
+      for (;entry<firstentry+nentries;entry++) {
          entryNumber = fTree->GetEntryNumber(entry);
          if (entryNumber < 0) break;
          if (timer && timer->ProcessEvents()) break;
@@ -2333,6 +2395,132 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
    return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Process the entries of TTree::Draw in parallel with a TTreeProcessorMT, if
+/// implicit multi-threading is enabled and fSelector supports it (see
+/// TSelectorDraw::CanProcessMT()). Each thread fills the histogram of its own
+/// slot selector, with formulas compiled for the tree of each task; these
+/// histograms are merged into the one of fSelector at the end.
+///
+/// If the limits of the histogram are computed from the first entries, these
+/// entries are processed sequentially as in Process(), until the limits are
+/// set. The parallel processing requires a tree in a read-only file or a chain,
+/// without entry list nor friends, and more entries than the estimate of the
+/// tree (see TTree::SetEstimate): otherwise the values of all the entries are
+/// kept by the selector for TTree::GetV1() etc., which the parallel processing
+/// does not do.
+///
+/// Returns the entry from which the remaining entries are to be processed
+/// sequentially, i.e. firstentry if nothing was done and firstentry + nentries
+/// if all the entries were processed.
+
+Long64_t TTreePlayer::ProcessDrawMT(Long64_t firstentry, Long64_t nentries)
+{
+#ifdef R__USE_IMT
+   if (!ROOT::IsImplicitMTEnabled() || nentries <= fTree->GetEstimate() || !fSelector->CanProcessMT())
+      return firstentry;
+   if (fTree->GetEntryList() || fTree->GetEventList() ||
+       (fTree->GetListOfFriends() && fTree->GetListOfFriends()->GetEntries()))
+      return firstentry;
+   TChain *chain = dynamic_cast<TChain *>(fTree);
+   if (!chain) {
+      TFile *file = fTree->GetCurrentFile();
+      if (!file || file->IsWritable() || fTree->GetDirectory() == nullptr)
+         return firstentry;
+   }
+
+   // The limits of the histogram are computed from the first entries
+   const Long64_t lastentry = firstentry + nentries;
+   Long64_t begin = firstentry;
+   for (; begin < lastentry && fSelector->GetAction() < 0; ++begin) {
+      Long64_t localEntry = fTree->LoadTree(begin);
+      if (localEntry < 0)
+         return lastentry;
+      if (fSelector->ProcessCut(localEntry))
+         fSelector->ProcessFill(localEntry);
+   }
+   if (begin >= lastentry)
+      return lastentry;
+
+   // The weight of a tree is not stored with the trees of a chain
+   const Bool_t globalWeight = !chain || chain->TestBit(TChain::kGlobalWeight);
+   const Double_t weight = fTree->GetWeight();
+   const Long64_t estimate = fTree->GetEstimate();
+
+   std::vector<std::unique_ptr<TSelectorDraw>> slots;
+   for (UInt_t i = 0; i < ROOT::GetThreadPoolSize(); ++i)
+      slots.emplace_back(fSelector->CreateSlotSelector());
+   std::vector<TSelectorDraw *> freeSlots;
+   for (auto &slot : slots)
+      freeSlots.push_back(slot.get());
+   std::mutex slotMutex;
+   std::atomic<bool> ok{true};
+
+   auto processTask = [&](TTreeReader &reader, const ROOT::TTreeProcessorMT::TTaskRange &task) {
+      if (task.fEndEntry <= begin || !ok)
+         return;
+      TSelectorDraw *slot = nullptr;
+      {
+         std::lock_guard<std::mutex> lock(slotMutex);
+         if (freeSlots.empty()) {
+            R__WRITE_LOCKGUARD(ROOT::gCoreMutex);
+            slots.emplace_back(fSelector->CreateSlotSelector());
+            freeSlots.push_back(slots.back().get());
+         }
+         slot = freeSlots.back();
+         freeSlots.pop_back();
+      }
+      TTree *tree = reader.GetTree();
+      tree->SetEstimate(estimate);
+      if (globalWeight)
+         tree->SetWeight(weight, "global");
+      if (slot->InitSlot(tree)) {
+         // the entries of the reader can be numbered within one of the files
+         const Long64_t offset = task.fFirstEntry - reader.GetEntriesRange().first;
+         Int_t current = -1;
+         while (reader.Next()) {
+            const Long64_t entry = offset + reader.GetCurrentEntry();
+            if (entry < begin)
+               continue;
+            if (entry >= lastentry)
+               break;
+            if (tree->GetTreeNumber() != current) {
+               current = tree->GetTreeNumber();
+               slot->Notify();
+            }
+            slot->ProcessFill(reader.GetCurrentEntry());
+         }
+      } else {
+         ok = false;
+      }
+      slot->FinishSlot();
+      std::lock_guard<std::mutex> lock(slotMutex);
+      freeSlots.push_back(slot);
+   };
+
+   try {
+      ROOT::TTreeProcessorMT processor(*fTree);
+      processor.ProcessTasks(processTask, lastentry);
+   } catch (const std::exception &e) {
+      Warning("DrawSelect", "Parallel processing failed (%s), continuing sequentially", e.what());
+      ok = false;
+   }
+   if (!ok) {
+      // the entries processed so far by the tasks are processed again sequentially
+      for (auto &slot : slots)
+         delete slot->GetObject();
+      return begin;
+   }
+
+   for (auto &slot : slots)
+      fSelector->MergeSlot(*slot);
+   return lastentry;
+#else
+   (void)nentries;
+   return firstentry;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// cleanup pointers in the player pointing to obj
 
@@ -14,6 +14,8 @@
 #include "ROOT/TTreeProcessorMP.hxx"
 #include "TMPWorkerTree.h"
 
+#include <memory>
+
 //////////////////////////////////////////////////////////////////////////
 ///
 /// \class ROOT::TTreeProcessorMP
@@ -70,6 +72,15 @@
 /// process (e.g. using the process id in the seed). Otherwise several parallel executions
 /// might generate the same sequence of pseudo-random numbers.
 ///
+/// #### Work distribution:
+/// The dataset is split in ranges of entries, which start and end at cluster boundaries: each
+/// worker receives a new range when it is done with the previous one, so that workers reading
+/// slow files or servers do not hold up the whole job. Each file is split so that each worker
+/// processes about 4 ranges, or the value of `MultiProc.TasksPerWorker` in the ROOT
+/// configuration; files are not split if there are enough of them. A range whose processing
+/// fails, e.g. because its file could not be opened, is passed again to a worker up to
+/// `MultiProc.MaxRetries` times (1 by default).
+///
 /// #### Return value:
 /// Methods taking 'F func' return the return type of F.
 /// Methods taking a TSelector return a 'TList *' with the selector output list; the output list
@@ -106,27 +117,26 @@ TList *TTreeProcessorMP::Process(TTree &tree, TSelector &selector, TEntryList &e
    //prepare environment
    Reset();
    UInt_t nWorkers = GetNWorkers();
+   //the tree is split in ranges aligned to its clusters, which are passed to the workers when they are idle
+   UInt_t nRanges = EvalNRanges(1);
    selector.Begin(nullptr);
 
    // Check the entry list
    TEntryList *elist = (entries.IsValid()) ? &entries : nullptr;
    //fork
    TMPWorkerTreeSel worker(selector, &tree, elist, nWorkers, nToProcess / nWorkers, jFirst);
+   worker.SetNRanges(nRanges);
    bool ok = Fork(worker);
    if(!ok) {
       Error("TTreeProcessorMP::Process", "[E][C] Could not fork. Aborting operation");
       return nullptr;
    }
 
-   //divide entries equally between workers
-   fTaskType = ETask::kProcByRange;
+   fTaskType = ETask::kProcTreeByRange;
 
    //tell workers to start processing entries
-   fNToProcess = nWorkers; //this is the total number of ranges that will be processed by all workers cumulatively
-   std::vector<UInt_t> args(nWorkers);
-   std::iota(args.begin(), args.end(), 0);
-   fNProcessed = Broadcast(MPCode::kProcTree, args);
-   if (fNProcessed < nWorkers)
+   fNToProcess = nRanges; //this is the total number of ranges that will be processed by all workers cumulatively
+   if (StartTasks() < nWorkers)
       Error("TTreeProcessorMP::Process", "[E][C] There was an error while sending tasks to workers."
                                    " Some entries might not be processed.");
 
@@ -169,55 +179,36 @@ TList *TTreeProcessorMP::Process(const std::vector<std::string> &fileNames, TSel
    //prepare environment
    Reset();
    UInt_t nWorkers = GetNWorkers();
+   Int_t procByFile = gEnv->GetValue("MultiProc.TestProcByFile", 0);
+   //unless each worker processes whole files, each file is split in ranges aligned to its clusters,
+   //which are passed to the workers when they are idle
+   UInt_t nRanges = procByFile ? nWorkers : EvalNRanges(fileNames.size());
    selector.Begin(nullptr);
 
    // Check the entry list
    TEntryList *elist = (entries.IsValid()) ? &entries : nullptr;
    //fork
    TMPWorkerTreeSel worker(selector, fileNames, elist, treeName, nWorkers, nToProcess, jFirst);
+   worker.SetNRanges(nRanges);
    bool ok = Fork(worker);
    if (!ok) {
       Error("TTreeProcessorMP::Process", "[E][C] Could not fork. Aborting operation");
       return nullptr;
    }
 
-   Int_t procByFile = gEnv->GetValue("MultiProc.TestProcByFile", 0);
-
-   if (procByFile) {
-      if (fileNames.size() < nWorkers) {
-         // TTree entry granularity: for each file, we divide entries equally between workers
-         fTaskType = ETask::kProcByRange;
-         // Tell workers to start processing entries
-         fNToProcess = nWorkers*fileNames.size(); //this is the total number of ranges that will be processed by all workers cumulatively
-         std::vector<UInt_t> args(nWorkers);
-         std::iota(args.begin(), args.end(), 0);
-         fNProcessed = Broadcast(MPCode::kProcRange, args);
-         if (fNProcessed < nWorkers)
-            Error("TTreeProcessorMP::Process", "[E][C] There was an error while sending tasks to workers."
-                                         " Some entries might not be processed");
-      } else {
-         // File granularity: each worker processes one whole file as a single task
-         fTaskType = ETask::kProcByFile;
-         fNToProcess = fileNames.size();
-         std::vector<UInt_t> args(nWorkers);
-         std::iota(args.begin(), args.end(), 0);
-         fNProcessed = Broadcast(MPCode::kProcFile, args);
-         if (fNProcessed < nWorkers)
-            Error("TTreeProcessorMP::Process", "[E][C] There was an error while sending tasks to workers."
-                                         " Some entries might not be processed.");
-      }
+   if (procByFile && fileNames.size() >= nWorkers) {
+      // File granularity: each worker processes one whole file as a single task
+      fTaskType = ETask::kProcByFile;
+      fNToProcess = fileNames.size();
    } else {
-      // TTree entry granularity: for each file, we divide entries equally between workers
+      // TTree entry granularity: each file is split in nRanges ranges
       fTaskType = ETask::kProcByRange;
-      // Tell workers to start processing entries
-      fNToProcess = nWorkers*fileNames.size(); //this is the total number of ranges that will be processed by all workers cumulatively
-      std::vector<UInt_t> args(nWorkers);
-      std::iota(args.begin(), args.end(), 0);
-      fNProcessed = Broadcast(MPCode::kProcRange, args);
-      if (fNProcessed < nWorkers)
-         Error("TTreeProcessorMP::Process", "[E][C] There was an error while sending tasks to workers."
-                                      " Some entries might not be processed.");
+      fNToProcess = nRanges*fileNames.size(); //this is the total number of ranges that will be processed by all workers cumulatively
    }
+   // Tell workers to start processing entries
+   if (StartTasks() < nWorkers)
+      Error("TTreeProcessorMP::Process", "[E][C] There was an error while sending tasks to workers."
+                                   " Some entries might not be processed.");
 
    // collect results, distribute new tasks
    std::vector<TObject*> outLists;
@@ -340,24 +331,93 @@ void TTreeProcessorMP::Reset()
 {
    fNProcessed = 0;
    fNToProcess = 0;
+   fRetryQueue.clear();
+   fWorkerTask.clear();
+   fNRetries.clear();
    fTaskType = ETask::kNoTask;
 }
 
+//////////////////////////////////////////////////////////////////////////
+/// Evaluate the number of ranges each of nFiles files must be split into,
+/// so that each worker processes about MultiProc.TasksPerWorker (4 by default)
+/// ranges. As the ranges are passed to the workers only when they are idle,
+/// workers that draw slow files or servers process fewer of them, instead of
+/// holding up the whole job. Whole files are processed as a single range if
+/// there are enough of them.
+unsigned TTreeProcessorMP::EvalNRanges(unsigned nFiles)
+{
+   const unsigned nTasks = GetNWorkers() * std::max(1, gEnv->GetValue("MultiProc.TasksPerWorker", 4));
+   if (nFiles == 0)
+      return 1;
+   return std::max(1u, (nTasks + nFiles - 1) / nFiles);
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Pass the first task to each worker.
+/// Return the number of workers that received a task.
+unsigned TTreeProcessorMP::StartTasks()
+{
+   TMonitor &mon = GetMonitor();
+   mon.ActivateAll();
+   std::unique_ptr<TList> lp(mon.GetListOfActives());
+   unsigned nStarted = 0;
+   for (auto s : *lp) {
+      if (ReplyToIdle(static_cast<TSocket *>(s)))
+         ++nStarted;
+   }
+   return nStarted;
+}
+
 //////////////////////////////////////////////////////////////////////////
 /// Reply to a worker who is idle.
-/// If still events to process, tell the worker. Otherwise
-/// ask for a result
-void TTreeProcessorMP::ReplyToIdle(TSocket *s)
+/// If still events to process, tell the worker, starting with the tasks that
+/// failed and must be retried. Otherwise ask for a result.
+/// Return true if a task was passed to the worker.
+bool TTreeProcessorMP::ReplyToIdle(TSocket *s)
 {
-   if (fNProcessed < fNToProcess) {
+   unsigned task;
+   if (!fRetryQueue.empty()) {
+      task = fRetryQueue.front();
+      fRetryQueue.pop_front();
+   } else if (fNProcessed < fNToProcess) {
       //we are executing a "greedy worker" task
-      if (fTaskType == ETask::kProcByRange)
-         MPSend(s, MPCode::kProcRange, fNProcessed);
-      else if (fTaskType == ETask::kProcByFile)
-         MPSend(s, MPCode::kProcFile, fNProcessed);
-      ++fNProcessed;
-   } else
+      task = fNProcessed++;
+   } else {
       MPSend(s, MPCode::kSendResult);
+      return false;
+   }
+
+   unsigned code = MPCode::kProcRange;
+   if (fTaskType == ETask::kProcByFile)
+      code = MPCode::kProcFile;
+   else if (fTaskType == ETask::kProcTreeByRange)
+      code = MPCode::kProcTree;
+   if (MPSend(s, code, task) <= 0) {
+      Error("TTreeProcessorMP::ReplyToIdle", "[E][C] Could not send task to worker");
+      fRetryQueue.push_front(task);
+      return false;
+   }
+   fWorkerTask[s] = task;
+   return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// Queue the last task passed to a worker which failed to process it, unless
+/// it was already retried MultiProc.MaxRetries times (1 by default).
+/// Return true if the task will be retried.
+bool TTreeProcessorMP::RetryTask(TSocket *s)
+{
+   auto workerTask = fWorkerTask.find(s);
+   if (workerTask == fWorkerTask.end())
+      return false;
+   const unsigned task = workerTask->second;
+   fWorkerTask.erase(workerTask);
+   const Int_t maxRetries = gEnv->GetValue("MultiProc.MaxRetries", 1);
+   if (Int_t(fNRetries[task]) >= maxRetries)
+      return false;
+   ++fNRetries[task];
+   fRetryQueue.push_back(task);
+   return true;
 }
 
 } // namespace ROOT
@@ -22,10 +22,24 @@ The implementation of ROOT::TTreeProcessorMT parallelizes the processing of the
 each corresponding to a cluster in the TTree. This is possible thanks to the use
 of a ROOT::TThreadedObject, so that each thread works with its own TFile and TTree
 objects.
+
+The subranges of all the input files are scheduled as one pool of tasks, such that
+idle threads can pick up the remaining work of any file. The subranges are balanced
+in size: small clusters of a file are merged and clusters much larger than the
+average task are split (see TTreeProcessorMT::SetMaxTasksPerFilePerWorker). The
+tasks of a file are adjacent in the pool, hence consecutive tasks of a thread
+mostly reuse the file that thread has already opened.
+
+Friend trees with an index (see TTree::BuildIndex) are supported: each thread builds
+the index of its own copy of the friend once, and reuses it for all its tasks.
 */
 
 #include "TROOT.h"
 #include "ROOT/TTreeProcessorMT.hxx"
+#include "TVirtualIndex.h"
+
+#include <atomic>
+#include <numeric> // std::iota
 
 using namespace ROOT;
 
@@ -123,6 +137,46 @@ ConvertToElistClusters(std::vector<std::vector<EntryCluster>> &&clusters, TEntry
    return elistClusters;
 }
 
+/// A range of entries of one of the input files, processed by one task
+struct EntryRange {
+   std::size_t fileIdx;
+   Long64_t start;
+   Long64_t end;
+};
+
+////////////////////////////////////////////////////////////////////////
+/// Turn the clusters of all files into a single list of tasks of about `targetEntries` entries each:
+/// consecutive clusters of a file are merged as long as the result does not exceed the target, and clusters
+/// larger than twice the target are split into ranges of about the target size.
+/// Tasks never span more than one file and the tasks of each file are adjacent and ordered.
+static std::vector<EntryRange>
+MakeEntryRanges(const std::vector<std::vector<EntryCluster>> &clustersPerFile, Long64_t targetEntries)
+{
+   std::vector<EntryRange> ranges;
+   const auto nFiles = clustersPerFile.size();
+   for (auto fileIdx = 0u; fileIdx < nFiles; ++fileIdx) {
+      const auto &clusters = clustersPerFile[fileIdx];
+      const auto nClusters = clusters.size();
+      for (auto i = 0u; i < nClusters;) {
+         const Long64_t start = clusters[i].start;
+         const Long64_t size = clusters[i].end - start;
+         if (size > 2 * targetEntries) {
+            const Long64_t nSplits = (size + targetEntries - 1) / targetEntries;
+            for (Long64_t split = 0; split < nSplits; ++split)
+               ranges.emplace_back(
+                  EntryRange{fileIdx, start + split * size / nSplits, start + (split + 1) * size / nSplits});
+            ++i;
+            continue;
+         }
+         Long64_t end = clusters[i].end;
+         for (++i; i < nClusters && clusters[i].end - start <= targetEntries; ++i)
+            end = clusters[i].end;
+         ranges.emplace_back(EntryRange{fileIdx, start, end});
+      }
+   }
+   return ranges;
+}
+
 // EntryClusters and number of entries per file
 using ClustersAndEntries = std::pair<std::vector<std::vector<EntryCluster>>, std::vector<Long64_t>>;
 
@@ -323,6 +377,11 @@ void TTreeView::MakeChain(const std::vector<std::string> &treeNames, const std::
       for (auto j = 0u; j < nFileNames; ++j)
          frChain->Add(friendFileNames[i][j].c_str(), friendEntries[i][j]);
 
+      // Rebuild the index of an indexed friend: the entries of this thread are matched with the thread's own copy
+      const auto &indexNames = friendInfo.fFriendIndexNames[i];
+      if (!indexNames.first.empty())
+         frChain->BuildIndex(indexNames.first.c_str(), indexNames.second.c_str());
+
       // Make it friends with the main chain
       fChain->AddFriend(frChain.get(), alias.c_str());
       fFriends.emplace_back(std::move(frChain));
@@ -368,6 +427,7 @@ Internal::FriendInfo TTreeProcessorMT::GetFriendInfo(TTree &tree)
 {
    std::vector<Internal::NameAlias> friendNames;
    std::vector<std::vector<std::string>> friendFileNames;
+   std::vector<Internal::NameAlias> friendIndexNames;
 
    const auto friends = tree.GetListOfFriends();
    if (!friends)
@@ -380,6 +440,12 @@ Internal::FriendInfo TTreeProcessorMT::GetFriendInfo(TTree &tree)
       friendFileNames.emplace_back();
       auto &fileNames = friendFileNames.back();
 
+      const auto index = frTree->GetTreeIndex();
+      if (index)
+         friendIndexNames.emplace_back(index->GetMajorName(), index->GetMinorName());
+      else
+         friendIndexNames.emplace_back();
+
       // Check if friend tree/chain has an alias
       const auto alias_c = tree.GetFriendAlias(frTree);
       const std::string alias = alias_c != nullptr ? alias_c : "";
@@ -413,7 +479,7 @@ Internal::FriendInfo TTreeProcessorMT::GetFriendInfo(TTree &tree)
       }
    }
 
-   return Internal::FriendInfo{std::move(friendNames), std::move(friendFileNames)};
+   return Internal::FriendInfo{std::move(friendNames), std::move(friendFileNames), std::move(friendIndexNames)};
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -559,13 +625,28 @@ TTreeProcessorMT::TTreeProcessorMT(TTree &tree, UInt_t nThreads) : TTreeProcesso
 ///
 /// \param[in] func User-defined function that processes a subrange of entries
 void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
+{
+   ProcessTasks([&func](TTreeReader &r, const TTaskRange &) { func(r); });
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// Same as Process, but the user-provided function also receives the position of the range of entries of the task
+/// in the whole dataset. The entry numbers of the TTreeReader can be local to one of the files.
+///
+/// \param[in] func User-defined function that processes a subrange of entries
+/// \param[in] endEntry If not negative, only the tasks with entries before this entry are run; the last of them can
+///                     still process entries from endEntry on
+/// \param[in] inOrder Start the tasks in the order of their entries: each worker takes the next task when it is done
+///                    with the previous one. At any time, the running tasks are then the earliest ones not done yet.
+void TTreeProcessorMT::ProcessTasks(std::function<void(TTreeReader &, const TTaskRange &)> func, Long64_t endEntry,
+                                    bool inOrder)
 {
    const std::vector<Internal::NameAlias> &friendNames = fFriendInfo.fFriendNames;
    const std::vector<std::vector<std::string>> &friendFileNames = fFriendInfo.fFriendFileNames;
 
    // If an entry list or friend trees are present, we need to generate clusters with global entry numbers,
    // so we do it here for all files.
-   // Otherwise we can do it later, concurrently for each file, and clusters will contain local entry numbers.
+   // Otherwise we do it concurrently for each file, and clusters will contain local entry numbers.
    // TODO: in practice we could also find clusters per-file in the case of no friends and a TEntryList with
    // sub-entrylists.
    const bool hasFriends = !friendNames.empty();
@@ -577,6 +658,19 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
       if (hasEntryList)
          clusterAndEntries.first = ConvertToElistClusters(std::move(clusterAndEntries.first), fEntryList, fTreeNames,
                                                           fFileNames, clusterAndEntries.second);
+   } else {
+      // Clusters (with local entry numbers) and number of entries of each file, retrieved concurrently
+      std::vector<std::size_t> fileIdxs(fFileNames.size());
+      std::iota(fileIdxs.begin(), fileIdxs.end(), 0u);
+      auto clustersAndEntriesPerFile = fPool.Map(
+         [this](std::size_t fileIdx) {
+            return MakeClusters({fTreeNames[fileIdx]}, {fFileNames[fileIdx]});
+         },
+         fileIdxs);
+      for (auto &fileClustersAndEntries : clustersAndEntriesPerFile) {
+         clusterAndEntries.first.emplace_back(std::move(fileClustersAndEntries.first[0]));
+         clusterAndEntries.second.emplace_back(fileClustersAndEntries.second[0]);
+      }
    }
 
    const auto &clusters = clusterAndEntries.first;
@@ -586,37 +680,67 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    const auto friendEntries =
       hasFriends ? GetFriendEntries(friendNames, friendFileNames) : std::vector<std::vector<Long64_t>>{};
 
-   // Parent task, spawns tasks that process each of the entry clusters for each input file
-   // TODO: for readability we should have two versions of this lambda, for shouldRetrieveAllClusters == true/false
-   auto processFile = [&](std::size_t fileIdx) {
-      // theseFiles contains either all files or just the single file to process
-      const auto &theseFiles = shouldRetrieveAllClusters ? fFileNames : std::vector<std::string>({fFileNames[fileIdx]});
-      // either all tree names or just the single tree to process
-      const auto &theseTrees = shouldRetrieveAllClusters ? fTreeNames : std::vector<std::string>({fTreeNames[fileIdx]});
-      // Evaluate clusters (with local entry numbers) and number of entries for this file, if needed
-      const auto theseClustersAndEntries =
-         shouldRetrieveAllClusters ? ClustersAndEntries{} : MakeClusters(theseTrees, theseFiles);
-
-      // All clusters for the file to process, either with global or local entry numbers
-      const auto &thisFileClusters = shouldRetrieveAllClusters ? clusters[fileIdx] : theseClustersAndEntries.first[0];
-
-      // Either all number of entries or just the ones for this file
-      const auto &theseEntries =
-         shouldRetrieveAllClusters ? entries : std::vector<Long64_t>({theseClustersAndEntries.second[0]});
-
-      auto processCluster = [&](const EntryCluster &c) {
-         auto r = fTreeView->GetTreeReader(c.start, c.end, theseTrees, theseFiles, fFriendInfo, fEntryList,
-                                           theseEntries, friendEntries);
-         func(*r);
-      };
+   // Build one pool of tasks for all files, with tasks of about the size they would have if all entries
+   // were in a single file with the maximum number of tasks per file.
+   Long64_t nTotalEntries = 0ll;
+   for (const auto &fileClusters : clusters)
+      for (const auto &c : fileClusters)
+         nTotalEntries += c.end - c.start;
+   const Long64_t maxTasks = Long64_t(GetMaxTasksPerFilePerWorker()) * fPool.GetPoolSize();
+   const Long64_t targetEntries = std::max(1ll, nTotalEntries / std::max(1ll, maxTasks));
+   const auto ranges = MakeEntryRanges(clusters, targetEntries);
+
+   // Without friends and entry list, each task builds its chain from the single file it processes
+   // (and the thread-local TTreeView keeps it as long as the thread stays in that file), otherwise from all files.
+   const auto nFiles = fFileNames.size();
+   std::vector<std::vector<std::string>> fileNamesPerFile, treeNamesPerFile;
+   std::vector<std::vector<Long64_t>> entriesPerFile;
+   if (!shouldRetrieveAllClusters) {
+      for (auto i = 0u; i < nFiles; ++i) {
+         fileNamesPerFile.emplace_back(std::vector<std::string>({fFileNames[i]}));
+         treeNamesPerFile.emplace_back(std::vector<std::string>({fTreeNames[i]}));
+         entriesPerFile.emplace_back(std::vector<Long64_t>({entries[i]}));
+      }
+   }
 
-      fPool.Foreach(processCluster, thisFileClusters);
-   };
+   // Position of the tasks in the whole dataset: with clusters retrieved per file, entry numbers are local to a file
+   std::vector<Long64_t> fileOffsets(nFiles, 0ll);
+   if (!shouldRetrieveAllClusters) {
+      for (auto i = 1u; i < nFiles; ++i)
+         fileOffsets[i] = fileOffsets[i - 1] + entries[i - 1];
+   }
+   std::vector<TTaskRange> taskRanges;
+   for (const auto &range : ranges) {
+      const auto offset = fileOffsets[range.fileIdx];
+      if (endEntry >= 0 && range.start + offset >= endEntry)
+         break; // ranges are ordered
+      taskRanges.emplace_back(TTaskRange{taskRanges.size(), range.start + offset, range.end + offset});
+   }
 
-   std::vector<std::size_t> fileIdxs(fFileNames.size());
-   std::iota(fileIdxs.begin(), fileIdxs.end(), 0u);
+   auto processRange = [&](std::size_t taskIdx) {
+      const auto &range = ranges[taskIdx];
+      const auto &theseFiles = shouldRetrieveAllClusters ? fFileNames : fileNamesPerFile[range.fileIdx];
+      const auto &theseTrees = shouldRetrieveAllClusters ? fTreeNames : treeNamesPerFile[range.fileIdx];
+      const auto &theseEntries = shouldRetrieveAllClusters ? entries : entriesPerFile[range.fileIdx];
+      auto r = fTreeView->GetTreeReader(range.start, range.end, theseTrees, theseFiles, fFriendInfo, fEntryList,
+                                        theseEntries, friendEntries);
+      func(*r, taskRanges[taskIdx]);
+   };
 
-   fPool.Foreach(processFile, fileIdxs);
+   const auto nTasks = taskRanges.size();
+   if (inOrder) {
+      std::atomic<std::size_t> nextTask(0u);
+      fPool.Foreach(
+         [&] {
+            for (auto taskIdx = nextTask++; taskIdx < nTasks; taskIdx = nextTask++)
+               processRange(taskIdx);
+         },
+         fPool.GetPoolSize());
+   } else {
+      std::vector<std::size_t> taskIdxs(nTasks);
+      std::iota(taskIdxs.begin(), taskIdxs.end(), 0u);
+      fPool.Foreach(processRange, taskIdxs);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -634,6 +758,11 @@ unsigned int TTreeProcessorMT::GetMaxTasksPerFilePerWorker()
 /// This allows to create a reasonable number of tasks even if any of the
 /// processed files features a bad clustering, for example with a lot of
 /// entries and just a few entries per cluster.
+///
+/// The same value defines the target size of the tasks across all files: the
+/// total number of entries divided by `maxTasksPerFile` times the number of
+/// workers. Consecutive clusters of a file are merged up to this size and
+/// clusters larger than twice this size are split.
 void TTreeProcessorMT::SetMaxTasksPerFilePerWorker(unsigned int maxTasksPerFile)
 {
    fgMaxTasksPerFilePerWorker = maxTasksPerFile;
@@ -15,6 +15,7 @@
 #include "TDirectory.h"
 #include "TEntryList.h"
 #include "TTreeCache.h"
+#include "TTreeCacheUnzip.h"
 #include "TTreeReaderValue.h"
 #include "TFriendProxy.h"
 
@@ -376,8 +377,11 @@ Bool_t TTreeReader::SetProxies() {
             const auto lastEntry = (-1LL == fEndEntry) ? fTree->GetEntriesFast() : fEndEntry;
             fTree->SetCacheEntryRange(fBeginEntry, lastEntry);
          }
+         auto unzipCache = dynamic_cast<TTreeCacheUnzip *>(fTree->GetTree()->GetReadCache(curFile));
          for (auto value: fValues) {
             fTree->AddBranchToCache(value->GetProxy()->GetBranchName(), true);
+            if (unzipCache && fLateBranches.count(value->GetBranchName()))
+               unzipCache->SetUnzipOnDemand(value->GetProxy()->GetBranchName());
          }
          fTree->StopCacheLearningPhase();
       }
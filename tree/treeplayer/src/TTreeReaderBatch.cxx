@@ -0,0 +1,248 @@
+// @(#)root/treeplayer:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2020, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/TTreeReaderBatch.hxx"
+
+#include "TBranch.h"
+#include "TClass.h"
+#include "TDirectory.h"
+#include "TLeaf.h"
+#include "TTree.h"
+#include "TVirtualCollectionProxy.h"
+
+#include <algorithm>
+
+ClassImp(ROOT::Experimental::TTreeReaderBatch);
+
+using namespace ROOT::Experimental;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Construct a batch value reader and register it with the reader object.
+
+Internal::TTreeReaderBatchValueBase::TTreeReaderBatchValueBase(TTreeReaderBatch &reader, std::string_view branchName,
+                                                               EDataType type, Bool_t isJagged)
+   : fBuffer(TBuffer::kWrite, 32 * 1024), fBranchName(branchName), fType(type), fIsJagged(isJagged),
+     fTreeReader(&reader)
+{
+   fTreeReader->RegisterValueReader(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Unregister from the tree reader.
+
+Internal::TTreeReaderBatchValueBase::~TTreeReaderBatchValueBase()
+{
+   if (fTreeReader)
+      fTreeReader->DeregisterValueReader(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Look up the branch in `tree` and check that it can be bulk-read as a value
+/// (or an array of values) of the expected type; sets fSetupStatus accordingly.
+
+void Internal::TTreeReaderBatchValueBase::Attach(TTree *tree)
+{
+   using ROOT::Internal::TTreeReaderValueBase;
+
+   fBranch = nullptr;
+   fBasketFirst = -1;
+   fBasketSize = 0;
+   fSetupStatus = TTreeReaderValueBase::kSetupMissingBranch;
+
+   TBranch *branch = tree->GetBranch(fBranchName.c_str());
+   if (!branch) {
+      Error("TTreeReaderBatchValueBase::Attach()", "The tree does not have a branch called %s", fBranchName.c_str());
+      return;
+   }
+
+   TClass *expectedClass = nullptr;
+   EDataType expectedType = kOther_t;
+   if (branch->GetExpectedType(expectedClass, expectedType)) {
+      fSetupStatus = TTreeReaderValueBase::kSetupInternalError;
+      return;
+   }
+   if (expectedClass) {
+      // std::vector branches report the collection class; compare the element type
+      auto proxy = expectedClass->GetCollectionProxy();
+      expectedType = proxy ? proxy->GetType() : kOther_t;
+   }
+   if (expectedType != fType) {
+      Error("TTreeReaderBatchValueBase::Attach()", "The branch %s does not contain data of type %s",
+            fBranchName.c_str(), TDataType::GetTypeName(fType));
+      fSetupStatus = TTreeReaderValueBase::kSetupMismatch;
+      return;
+   }
+
+   Bool_t supported;
+   if (fIsJagged) {
+      supported = branch->GetBulkRead().SupportsJaggedBulkRead();
+   } else {
+      supported = branch->GetBulkRead().SupportsBulkRead();
+      if (supported) {
+         auto leaf = static_cast<TLeaf *>(branch->GetListOfLeaves()->UncheckedAt(0));
+         supported = !leaf->GetLeafCount() && (leaf->GetLenStatic() == 1);
+      }
+   }
+   if (!supported) {
+      Error("TTreeReaderBatchValueBase::Attach()", "The branch %s cannot be read in batches", fBranchName.c_str());
+      fSetupStatus = TTreeReaderValueBase::kSetupNotACollection;
+      return;
+   }
+
+   fBranch = branch;
+   fSetupStatus = TTreeReaderValueBase::kSetupMatch;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Make sure the basket holding the tree entry `entry` is loaded and return
+/// the number of entries available from `entry` on, or -1 in case of error.
+///
+/// A new basket is only read once the current one is exhausted; as batches
+/// never extend past the end of a loaded basket, `entry` is then the first
+/// entry of the next basket, which is what the bulk I/O interface requires.
+
+Int_t Internal::TTreeReaderBatchValueBase::Prepare(Long64_t entry)
+{
+   if ((fBasketFirst < 0) || (entry < fBasketFirst) || (entry >= fBasketFirst + fBasketSize)) {
+      fBasketSize = ReadBasket(entry);
+      if (fBasketSize <= 0) {
+         fBasketFirst = -1;
+         fBasketSize = 0;
+         fReadStatus = ROOT::Internal::TTreeReaderValueBase::kReadError;
+         return -1;
+      }
+      fBasketFirst = entry;
+   }
+   fReadStatus = ROOT::Internal::TTreeReaderValueBase::kReadSuccess;
+   return fBasketFirst + fBasketSize - entry;
+}
+
+/** \class ROOT::Experimental::TTreeReaderBatch
+A TTreeReader mode that moves forward through a tree one batch of entries at a time.
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+/// Access data from `tree`.
+
+TTreeReaderBatch::TTreeReaderBatch(TTree *tree) : fTree(tree)
+{
+   if (!fTree) {
+      ::Error("TTreeReaderBatch::TTreeReaderBatch", "TTree is NULL!");
+      MakeZombie();
+      fEntryStatus = TTreeReader::kEntryNoTree;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Access data from the tree called `keyname` in the directory `dir`, or in
+/// the current directory if `dir` is `nullptr`.
+
+TTreeReaderBatch::TTreeReaderBatch(const char *keyname, TDirectory *dir /*= nullptr*/)
+{
+   if (!dir)
+      dir = gDirectory;
+   dir->GetObject(keyname, fTree);
+   if (!fTree) {
+      MakeZombie();
+      fEntryStatus = TTreeReader::kEntryNoTree;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Tell all value readers that the tree reader does not exist anymore.
+
+TTreeReaderBatch::~TTreeReaderBatch()
+{
+   for (auto reader : fValues)
+      reader->MarkTreeReaderUnavailable();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Move to the next batch of entries. Returns false if there are no more
+/// entries or in case of error, see GetEntryStatus().
+
+Bool_t TTreeReaderBatch::Next()
+{
+   if (!fTree) {
+      fEntryStatus = TTreeReader::kEntryNoTree;
+      return kFALSE;
+   }
+
+   const Long64_t entry = (fEntry < 0) ? 0 : fEntry + fBatchSize;
+   fBatchSize = 0;
+   const Long64_t localEntry = fTree->LoadTree(entry);
+   if (localEntry < 0) {
+      if (localEntry == -2)
+         fEntryStatus = TTreeReader::kEntryBeyondEnd;
+      else if ((localEntry == -3) || (localEntry == -4))
+         fEntryStatus = TTreeReader::kEntryChainFileError;
+      else
+         fEntryStatus = TTreeReader::kEntryNotFound;
+      return kFALSE;
+   }
+   TTree *tree = fTree->GetTree();
+
+   if (fTree->GetTreeNumber() != fTreeNumber) {
+      fTreeNumber = fTree->GetTreeNumber();
+      for (auto value : fValues)
+         value->Attach(tree);
+   }
+
+   Long64_t last;
+   if (fValues.empty()) {
+      auto clusterIter = tree->GetClusterIterator(localEntry);
+      clusterIter.Next();
+      last = std::min(clusterIter.GetNextEntry(), tree->GetEntries());
+   } else {
+      last = tree->GetEntries();
+      for (auto value : fValues) {
+         if (value->GetSetupStatus() != ROOT::Internal::TTreeReaderValueBase::kSetupMatch) {
+            fEntryStatus = TTreeReader::kEntryBadReader;
+            return kFALSE;
+         }
+         const Int_t nAvailable = value->Prepare(localEntry);
+         if (nAvailable < 0) {
+            Error("Next", "Failed to bulk-read branch %s at entry %lld", value->GetBranchName().c_str(), entry);
+            fEntryStatus = TTreeReader::kEntryBadReader;
+            return kFALSE;
+         }
+         last = std::min(last, localEntry + nAvailable);
+      }
+   }
+
+   fEntry = entry;
+   fBatchSize = last - localEntry;
+   for (auto value : fValues)
+      value->SetView(localEntry, fBatchSize);
+   fEntryStatus = TTreeReader::kEntryValid;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a value reader for this tree. Value readers are attached to the tree
+/// by the first call to Next(); readers created later are not usable.
+
+void TTreeReaderBatch::RegisterValueReader(Internal::TTreeReaderBatchValueBase *reader)
+{
+   fValues.push_back(reader);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove a value reader for this tree.
+
+void TTreeReaderBatch::DeregisterValueReader(Internal::TTreeReaderBatchValueBase *reader)
+{
+   auto iReader = std::find(fValues.begin(), fValues.end(), reader);
+   if (iReader == fValues.end()) {
+      Error("DeregisterValueReader", "Cannot find reader for branch %s", reader->GetBranchName().c_str());
+      return;
+   }
+   fValues.erase(iReader);
+}
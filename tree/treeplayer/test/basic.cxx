@@ -502,3 +502,46 @@ TEST(TTreeReaderBasic, DisappearingBranch)
    gSystem->Unlink("DisappearingBranch0.root");
    gSystem->Unlink("DisappearingBranch1.root");
 }
+
+TEST(TTreeReaderBasic, ChainWithSameLayout)
+{
+   // The proxies reuse the types resolved for the previous file if the next one has the same layout
+   auto createFile = [](const char *fileName, int offset) {
+      TFile f(fileName, "RECREATE");
+      TTree t("t", "t");
+      TNamed named;
+      std::vector<int> vec;
+      t.Branch("named", &named);
+      t.Branch("vec", &vec);
+      for (int i = 0; i < 3; ++i) {
+         named.SetName(std::to_string(offset + i).c_str());
+         vec.assign(i + 1, offset + i);
+         t.Fill();
+      }
+      t.Write();
+      f.Close();
+   };
+   const std::vector<std::string> fileNames{"ChainWithSameLayout0.root", "ChainWithSameLayout1.root",
+                                            "ChainWithSameLayout2.root"};
+   TChain c("t");
+   for (auto i = 0u; i < fileNames.size(); ++i) {
+      createFile(fileNames[i].c_str(), 10 * i);
+      c.Add(fileNames[i].c_str());
+   }
+
+   TTreeReader r(&c);
+   TTreeReaderValue<TNamed> named(r, "named");
+   TTreeReaderArray<int> vec(r, "vec");
+   int nEntries = 0;
+   while (r.Next()) {
+      const int expected = 10 * (nEntries / 3) + nEntries % 3;
+      EXPECT_EQ(std::to_string(expected), named->GetName());
+      ASSERT_EQ(vec.GetSize(), std::size_t(nEntries % 3 + 1));
+      EXPECT_EQ(vec[0], expected);
+      ++nEntries;
+   }
+   EXPECT_EQ(nEntries, 9);
+
+   for (const auto &fileName : fileNames)
+      gSystem->Unlink(fileName.c_str());
+}
@@ -0,0 +1,101 @@
+#include "ROOT/TTreeReaderBatch.hxx"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+TEST(TTreeReaderBatch, ValuesAndArrays)
+{
+   const char *fileName = "TTreeReaderBatch.root";
+   const Long64_t nEntries = 20000;
+   {
+      TFile f(fileName, "RECREATE");
+      TTree t("T", "test tree");
+      float x = 0;
+      Long64_t id = 0;
+      Int_t n = 0;
+      double d[10];
+      std::vector<float> v;
+      t.Branch("x", &x, "x/F");
+      // A smaller basket size than for x, such that the basket boundaries differ
+      t.Branch("id", &id, "id/L", 4000);
+      t.Branch("n", &n, "n/I");
+      t.Branch("d", d, "d[n]/D");
+      t.Branch("v", &v);
+      for (Long64_t i = 0; i < nEntries; ++i) {
+         x = 0.5 * i;
+         id = i;
+         n = i % 7;
+         v.clear();
+         for (Int_t j = 0; j < n; ++j) {
+            d[j] = i + j;
+            v.push_back(j);
+         }
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TFile f(fileName);
+   auto t = f.Get<TTree>("T");
+   ASSERT_NE(nullptr, t);
+
+   ROOT::Experimental::TTreeReaderBatch reader(t);
+   ROOT::Experimental::TTreeReaderBatchValue<float> x(reader, "x");
+   ROOT::Experimental::TTreeReaderBatchValue<Long64_t> id(reader, "id");
+   ROOT::Experimental::TTreeReaderBatchArray<double> d(reader, "d");
+   ROOT::Experimental::TTreeReaderBatchArray<float> v(reader, "v");
+
+   Long64_t expected = 0;
+   int nBatches = 0;
+   while (reader.Next()) {
+      ++nBatches;
+      EXPECT_EQ(expected, reader.GetCurrentEntry());
+      const auto size = reader.GetBatchSize();
+      ASSERT_GT(size, 0);
+      ASSERT_EQ(std::size_t(size), x->size());
+      ASSERT_EQ(std::size_t(size), id->size());
+      ASSERT_EQ(std::size_t(size), d.GetSize());
+      ASSERT_EQ(std::size_t(size), v.GetSize());
+      for (Int_t i = 0; i < size; ++i) {
+         const Long64_t entry = expected + i;
+         EXPECT_FLOAT_EQ(0.5 * entry, (*x)[i]);
+         EXPECT_EQ(entry, (*id)[i]);
+         const auto darr = d[i];
+         const auto varr = v[i];
+         ASSERT_EQ(std::size_t(entry % 7), darr.size());
+         ASSERT_EQ(std::size_t(entry % 7), varr.size());
+         for (std::size_t j = 0; j < darr.size(); ++j) {
+            EXPECT_DOUBLE_EQ(double(entry + j), darr[j]);
+            EXPECT_FLOAT_EQ(float(j), varr[j]);
+         }
+      }
+      expected += size;
+   }
+   EXPECT_EQ(nEntries, expected);
+   EXPECT_GT(nBatches, 1);
+   EXPECT_EQ(TTreeReader::kEntryBeyondEnd, reader.GetEntryStatus());
+
+   gSystem->Unlink(fileName);
+}
+
+TEST(TTreeReaderBatch, TypeMismatch)
+{
+   TFile f("TTreeReaderBatchMismatch.root", "RECREATE");
+   TTree t("T", "test tree");
+   float x = 0;
+   t.Branch("x", &x, "x/F");
+   t.Fill();
+   t.Write();
+
+   ROOT::Experimental::TTreeReaderBatch reader(&t);
+   ROOT::Experimental::TTreeReaderBatchValue<double> xd(reader, "x");
+   EXPECT_FALSE(reader.Next());
+   EXPECT_EQ(TTreeReader::kEntryBadReader, reader.GetEntryStatus());
+   EXPECT_EQ(ROOT::Internal::TTreeReaderValueBase::kSetupMismatch, xd.GetSetupStatus());
+
+   gSystem->Unlink("TTreeReaderBatchMismatch.root");
+}
@@ -0,0 +1,110 @@
+#include "TFile.h"
+#include "TH1D.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeFormula.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+class TTreeFormulaJit : public ::testing::Test {
+protected:
+   static constexpr const char *fFileName = "TTreeFormulaJit.root";
+
+   static void SetUpTestCase()
+   {
+      TFile f(fFileName, "RECREATE");
+      TTree t("T", "test tree");
+      float x = 0;
+      Int_t i = 0;
+      Int_t n = 0;
+      double d[10];
+      t.Branch("x", &x, "x/F");
+      t.Branch("i", &i, "i/I");
+      t.Branch("n", &n, "n/I");
+      t.Branch("d", d, "d[n]/D");
+      for (Int_t e = 0; e < 1000; ++e) {
+         x = 0.25 * e - 100;
+         i = e;
+         n = e % 5;
+         for (Int_t j = 0; j < n; ++j)
+            d[j] = e * 0.5 - j;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   static void TearDownTestCase() { gSystem->Unlink(fFileName); }
+
+   /// Check that the compiled and the interpreted formula agree for every entry and instance.
+   static void Compare(const char *expression, bool expectJit = true)
+   {
+      TFile f(fFileName);
+      auto t = f.Get<TTree>("T");
+      TTreeFormula interpreted("interpreted", expression, t);
+      TTreeFormula jitted("jitted", expression, t);
+      ASSERT_NE(0, interpreted.GetNdim()) << expression;
+      EXPECT_EQ(expectJit, jitted.EnableJit()) << expression;
+      EXPECT_EQ(expectJit, jitted.IsJitted()) << expression;
+      for (Long64_t e = 0; e < t->GetEntries(); ++e) {
+         t->LoadTree(e);
+         const Int_t ndata = interpreted.GetNdata();
+         ASSERT_EQ(ndata, jitted.GetNdata()) << expression;
+         for (Int_t inst = 0; inst < ndata; ++inst)
+            ASSERT_DOUBLE_EQ(interpreted.EvalInstance(inst), jitted.EvalInstance(inst))
+               << expression << " entry " << e << " instance " << inst;
+      }
+   }
+};
+
+TEST_F(TTreeFormulaJit, Arithmetic)
+{
+   Compare("x*x + 3*i - 2.5");
+   Compare("x/(i-500)");
+   Compare("i%7 + (i&12) + (i<<2) - (i>>1)");
+   Compare("-x + abs(x) + sign(x) + int(x/3)");
+}
+
+TEST_F(TTreeFormulaJit, Functions)
+{
+   Compare("sqrt(x) + log(x) + log10(i) + exp(x/10)");
+   Compare("sin(x) + cos(x) + tan(x) + atan2(x, i) + pow(x, 2) + fmod(x, 3)");
+   Compare("acos(x/250) + asin(x/250) + atanh(x/250) + acosh(x) + min(x, i) + max(x, i) + pi");
+}
+
+TEST_F(TTreeFormulaJit, Logical)
+{
+   Compare("x > 0 && i < 600");
+   Compare("x == 0 || !(i >= 600) || i != 3");
+}
+
+TEST_F(TTreeFormulaJit, Arrays)
+{
+   Compare("d*2 + x");
+   Compare("d[1] - Iteration$ + Length$ + Entry$");
+   // The right side of || is skipped for an out-of-range array element: keep interpreting
+   Compare("n < 2 || d[1] > 3", false);
+}
+
+TEST_F(TTreeFormulaJit, NotCompiled)
+{
+   // A single variable is evaluated directly anyway
+   Compare("x", false);
+   Compare("i > 500 ? x : -x", false);
+   Compare("Sum$(d) + 1", false);
+}
+
+TEST_F(TTreeFormulaJit, Draw)
+{
+   TFile f(fFileName);
+   auto t = f.Get<TTree>("T");
+   ASSERT_EQ(t->Draw("x*2 + d>>hinterpreted(100, -200, 600)", "i > 100 && d[0] > 4", "goff"),
+             t->Draw("x*2 + d>>hjitted(100, -200, 600)", "i > 100 && d[0] > 4", "goff jit"));
+   auto hInterpreted = static_cast<TH1D *>(gDirectory->Get("hinterpreted"));
+   auto hJitted = static_cast<TH1D *>(gDirectory->Get("hjitted"));
+   ASSERT_NE(nullptr, hInterpreted);
+   ASSERT_NE(nullptr, hJitted);
+   for (Int_t b = 0; b <= hInterpreted->GetNbinsX() + 1; ++b)
+      EXPECT_EQ(hInterpreted->GetBinContent(b), hJitted->GetBinContent(b));
+}
@@ -0,0 +1,58 @@
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreePerfStats.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+TEST(TTreePerfStats, BranchInfo)
+{
+   const char *fileName = "TTreePerfStatsBranchInfo.root";
+   const Long64_t nEntries = 10000;
+   {
+      TFile f(fileName, "RECREATE");
+      TTree t("T", "test tree");
+      double x = 0;
+      Int_t i = 0;
+      float unread = 0;
+      t.Branch("x", &x, "x/D");
+      t.Branch("i", &i, "i/I");
+      t.Branch("unread", &unread, "unread/F");
+      for (Long64_t e = 0; e < nEntries; ++e) {
+         x = e * 0.5;
+         i = e % 13;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TFile f(fileName);
+   auto t = f.Get<TTree>("T");
+   ASSERT_NE(nullptr, t);
+   t->SetBranchStatus("unread", false);
+   TTreePerfStats ps("ioperf", t);
+   for (Long64_t e = 0; e < nEntries; ++e)
+      t->GetEntry(e);
+
+   for (const char *name : {"x", "i"}) {
+      auto info = ps.GetBranchInfo(name);
+      ASSERT_NE(nullptr, info) << name;
+      EXPECT_EQ(nEntries, info->fEntries) << name;
+      EXPECT_GT(info->fReadBytes, 0) << name;
+      EXPECT_GT(info->fUnzipBytes, 0) << name;
+      EXPECT_GT(info->fCacheHits + info->fCacheMisses, 0u) << name;
+      EXPECT_GE(info->fStreamTime, 0.) << name;
+   }
+   EXPECT_EQ(nullptr, ps.GetBranchInfo("unread"));
+   EXPECT_EQ(2u, ps.GetBranchesInfo().size());
+
+   const std::string json = ps.GetBranchInfoJSON();
+   EXPECT_NE(std::string::npos, json.find("\"branch\": \"x\"")) << json;
+   EXPECT_NE(std::string::npos, json.find("\"branch\": \"i\"")) << json;
+   EXPECT_EQ(std::string::npos, json.find("unread")) << json;
+
+   t->SetPerfStats(nullptr);
+   gSystem->Unlink(fileName);
+}
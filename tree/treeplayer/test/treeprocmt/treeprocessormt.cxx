@@ -6,8 +6,13 @@
 #include <thread>
 #include <utility>
 
+#include <TChain.h>
 #include <TFile.h>
+#include <TH1.h>
+#include <TProfile.h>
+#include <TROOT.h>
 #include <TTree.h>
+#include <TTreeIndex.h>
 #include <TSystem.h>
 #include <TTreeReader.h>
 #include <TTreeReaderValue.h>
@@ -369,6 +374,68 @@ TEST(TreeProcessorMT, ChainWithFriendChain)
    ROOT::DisableImplicitMT();
 }
 
+TEST(TreeProcessorMT, IndexedFriendTree)
+{
+   std::vector<std::string> fileNames = {"IndexedFriendTree_Tree.root", "IndexedFriendTree_Friend.root"};
+   {
+      TFile f(fileNames[0].c_str(), "RECREATE");
+      TTree t("mainTree", "mainTree");
+      int run;
+      t.Branch("run", &run);
+      t.SetAutoFlush(100);
+      for (auto i = 0; i < 1000; ++i) {
+         run = (i * 7) % 100;
+         t.Fill();
+      }
+      t.Write();
+   }
+   {
+      // the friend entries are in a different order than the main entries
+      TFile f(fileNames[1].c_str(), "RECREATE");
+      TTree t("friendTree", "friendTree");
+      int run, w;
+      t.Branch("run", &run);
+      t.Branch("w", &w);
+      for (auto i = 0; i < 100; ++i) {
+         run = 99 - i;
+         w = 10 * run;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   ROOT::EnableImplicitMT(4);
+
+   TChain mainChain("mainTree");
+   mainChain.Add(fileNames[0].c_str());
+   TChain friendChain("friendTree");
+   friendChain.Add(fileNames[1].c_str());
+   friendChain.BuildIndex("run");
+   mainChain.AddFriend(&friendChain);
+
+   std::atomic<int> nEntries(0);
+   std::atomic<int> nMismatches(0);
+   auto procLambda = [&](TTreeReader &r) {
+      TTreeReaderValue<int> run(r, "run");
+      TTreeReaderValue<int> w(r, "w");
+      while (r.Next()) {
+         ++nEntries;
+         if (*w != 10 * *run)
+            ++nMismatches;
+      }
+   };
+
+   ROOT::TTreeProcessorMT tp(mainChain);
+   tp.Process(procLambda);
+
+   EXPECT_EQ(nEntries, 1000);
+   EXPECT_EQ(nMismatches, 0);
+
+   // Clean-up
+   DeleteFiles(fileNames);
+   ROOT::DisableImplicitMT();
+}
+
 TEST(TreeProcessorMT, SetNThreads)
 {
    EXPECT_EQ(ROOT::GetThreadPoolSize(), 0u);
@@ -407,3 +474,163 @@ TEST(TreeProcessorMT, SetNThreads)
       gSystem->Unlink("treeprocmt_setnthreads.root");
    }
 }
+
+TEST(TreeProcessorMT, BuildIndexInParallel)
+{
+   const std::vector<std::string> filenames = {"treeprocmt_buildindex0.root", "treeprocmt_buildindex1.root"};
+   for (auto i = 0u; i < filenames.size(); ++i) {
+      TFile file(filenames[i].c_str(), "recreate");
+      TTree t("t", "t");
+      int run = 0, event = 0;
+      t.Branch("run", &run);
+      t.Branch("event", &event);
+      t.SetAutoFlush(100);
+      for (auto e = 0; e < 1000; ++e) {
+         run = i;
+         // Not sorted within the file
+         event = (e * 7919) % 1000;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   TChain serialChain("t");
+   for (const auto &f : filenames)
+      serialChain.Add(f.c_str());
+   serialChain.BuildIndex("run", "event");
+
+   ROOT::EnableImplicitMT(4);
+   TChain chain("t");
+   for (const auto &f : filenames)
+      chain.Add(f.c_str());
+   // A TTreeIndex on the whole chain rather than the TChainIndex made of per-file indices
+   TTreeIndex index(&chain, "run", "event");
+   TFile file(filenames[1].c_str());
+   auto tree = file.Get<TTree>("t");
+   tree->BuildIndex("run", "event");
+   ROOT::DisableImplicitMT();
+
+   ASSERT_EQ(2000, index.GetN());
+   for (auto i = 0u; i < filenames.size(); ++i) {
+      for (auto e = 0; e < 1000; ++e) {
+         const auto expected = serialChain.GetEntryNumberWithIndex(i, e);
+         ASSERT_GE(expected, 0);
+         EXPECT_EQ(expected, index.GetEntryNumberWithIndex(i, e));
+         if (i == 1)
+            EXPECT_EQ(expected - 1000, tree->GetEntryNumberWithIndex(i, e));
+      }
+   }
+
+   DeleteFiles(filenames);
+}
+
+TEST(TreeProcessorMT, BalancedTasksAcrossFiles)
+{
+   // One file with two large clusters and many small files with a single small cluster each
+   std::vector<std::string> filenames;
+   int v = 0;
+   for (auto i = 0u; i < 11u; ++i) {
+      filenames.emplace_back("treeprocmt_balanced" + std::to_string(i) + ".root");
+      TFile file(filenames.back().c_str(), "recreate");
+      TTree t("t", "t");
+      t.Branch("v", &v);
+      const auto nEntries = i == 0 ? 10000 : 100;
+      t.SetAutoFlush(i == 0 ? 5000 : 100);
+      for (auto e = 0; e < nEntries; ++e) {
+         ++v;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   std::mutex m;
+   std::vector<Long64_t> taskSizes;
+   std::atomic<Long64_t> sum(0);
+   std::atomic<Long64_t> count(0);
+   auto sumValues = [&](TTreeReader &r) {
+      TTreeReaderValue<int> rv(r, "v");
+      Long64_t n = 0;
+      while (r.Next()) {
+         sum += *rv;
+         ++n;
+      }
+      count += n;
+      std::lock_guard<std::mutex> lg(m);
+      taskSizes.emplace_back(n);
+   };
+
+   ROOT::EnableImplicitMT(4);
+   std::vector<std::string_view> fnames(filenames.begin(), filenames.end());
+   ROOT::TTreeProcessorMT proc(fnames, "t");
+   proc.Process(sumValues);
+   ROOT::DisableImplicitMT();
+
+   const Long64_t nTotal = 11000;
+   EXPECT_EQ(nTotal, count.load());
+   EXPECT_EQ(nTotal * (nTotal + 1) / 2, sum.load());
+   // The two clusters of 5000 entries are split into tasks of about the same size as the small files
+   const Long64_t target = nTotal / (4 * ROOT::TTreeProcessorMT::GetMaxTasksPerFilePerWorker());
+   EXPECT_LE(*std::max_element(taskSizes.begin(), taskSizes.end()), 2 * target);
+
+   DeleteFiles(filenames);
+}
+
+TEST(TreeProcessorMT, DrawInParallel)
+{
+   const std::vector<std::string> filenames = {"treeprocmt_draw0.root", "treeprocmt_draw1.root"};
+   for (auto i = 0u; i < filenames.size(); ++i) {
+      TFile file(filenames[i].c_str(), "recreate");
+      TTree t("t", "t");
+      double x = 0;
+      int y = 0;
+      t.Branch("x", &x);
+      t.Branch("y", &y);
+      t.SetAutoFlush(500);
+      for (auto e = 0; e < 5000; ++e) {
+         // The first entries cover the whole range, so that the axes computed from them are not extended
+         x = ((e * 37) % 1000) / 100.;
+         y = e % 7;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   auto draw = [&](const char *suffix) {
+      TChain chain("t");
+      for (const auto &f : filenames)
+         chain.Add(f.c_str());
+      chain.SetEstimate(1000);
+      std::vector<std::unique_ptr<TH1>> histos;
+      std::vector<Long64_t> rows;
+      const std::string fixed = std::string("x>>hfixed") + suffix + "(50,0,10)";
+      rows.push_back(chain.Draw(fixed.c_str(), "y%3==0", "goff"));
+      histos.emplace_back(static_cast<TH1 *>(gROOT->FindObject((std::string("hfixed") + suffix).c_str())));
+      rows.push_back(chain.Draw("x", "y>2", "goff"));
+      histos.emplace_back(static_cast<TH1 *>(chain.GetHistogram()->Clone()));
+      const std::string prof = std::string("x:y>>hprof") + suffix + "(7,0,7)";
+      rows.push_back(chain.Draw(prof.c_str(), "", "prof goff"));
+      histos.emplace_back(static_cast<TH1 *>(gROOT->FindObject((std::string("hprof") + suffix).c_str())));
+      for (auto &h : histos)
+         h->SetDirectory(nullptr);
+      return std::make_pair(std::move(rows), std::move(histos));
+   };
+
+   const auto serial = draw("serial");
+   ROOT::EnableImplicitMT(4);
+   const auto parallel = draw("parallel");
+   ROOT::DisableImplicitMT();
+
+   for (auto i = 0u; i < serial.first.size(); ++i) {
+      EXPECT_EQ(serial.first[i], parallel.first[i]);
+      const TH1 &hs = *serial.second[i];
+      const TH1 &hp = *parallel.second[i];
+      ASSERT_EQ(hs.GetNbinsX(), hp.GetNbinsX());
+      EXPECT_DOUBLE_EQ(hs.GetXaxis()->GetXmin(), hp.GetXaxis()->GetXmin());
+      EXPECT_DOUBLE_EQ(hs.GetXaxis()->GetXmax(), hp.GetXaxis()->GetXmax());
+      EXPECT_DOUBLE_EQ(hs.GetEntries(), hp.GetEntries());
+      for (auto b = 0; b <= hs.GetNbinsX() + 1; ++b)
+         EXPECT_NEAR(hs.GetBinContent(b), hp.GetBinContent(b), 1e-9) << "histogram " << i << " bin " << b;
+   }
+
+   DeleteFiles(filenames);
+}
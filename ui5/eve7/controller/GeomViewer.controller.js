@@ -405,19 +405,43 @@ sap.ui.define(['sap/ui/core/Component',
                return null;
             }
 
+            // flags as in REveRenderData::ECompact_e, each buffer aligned to 4 bytes
+            var fmt = rd.fmt || 0;
+
             if (rd.sz[0]) {
-               rd.vtxBuff = new Float32Array(rd.raw.buffer, off, rd.sz[0]);
-               off += rd.sz[0]*4;
+               if (fmt & 2) {
+                  var qv = new Uint16Array(rd.raw.buffer, off, rd.sz[0]);
+                  rd.vtxBuff = new Float32Array(rd.sz[0]);
+                  for (var i = 0; i < rd.sz[0]; ++i)
+                     rd.vtxBuff[i] = rd.range[i%3] + rd.range[3 + i%3] * qv[i];
+                  off += Math.ceil(rd.sz[0]/2)*4;
+               } else {
+                  rd.vtxBuff = new Float32Array(rd.raw.buffer, off, rd.sz[0]);
+                  off += rd.sz[0]*4;
+               }
             }
 
             if (rd.sz[1]) {
-               rd.nrmBuff = new Float32Array(rd.raw.buffer, off, rd.sz[1]);
-               off += rd.sz[1]*4;
+               if (fmt & 4) {
+                  var qn = new Int8Array(rd.raw.buffer, off, rd.sz[1]);
+                  rd.nrmBuff = new Float32Array(rd.sz[1]);
+                  for (var k = 0; k < rd.sz[1]; ++k)
+                     rd.nrmBuff[k] = qn[k] / 127;
+                  off += Math.ceil(rd.sz[1]/4)*4;
+               } else {
+                  rd.nrmBuff = new Float32Array(rd.raw.buffer, off, rd.sz[1]);
+                  off += rd.sz[1]*4;
+               }
             }
 
             if (rd.sz[2]) {
-               rd.idxBuff = new Uint32Array(rd.raw.buffer, off, rd.sz[2]);
-               off += rd.sz[2]*4;
+               if (fmt & 1) {
+                  rd.idxBuff = new Uint16Array(rd.raw.buffer, off, rd.sz[2]);
+                  off += rd.sz[2]*2;
+               } else {
+                  rd.idxBuff = new Uint32Array(rd.raw.buffer, off, rd.sz[2]);
+                  off += rd.sz[2]*4;
+               }
             }
 
             g = this.creator.makeEveGeometry(rd);